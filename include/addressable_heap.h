@@ -0,0 +1,532 @@
+#ifndef ADDRESSABLE_HEAP_H
+#define ADDRESSABLE_HEAP_H
+
+#include "fibonacci_heap.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+
+/**
+ * @brief 可寻址堆（addressable heap）概念
+ *
+ * 本文件中的堆都满足下面的统一接口，Dijkstra、Prim 等算法可以直接替换：
+ *
+ *   using handle_type = std::uint32_t;
+ *   bool empty() const;
+ *   std::size_t size() const;
+ *   handle_type push(const Key &key);          插入，返回稳定句柄
+ *   const Key &top() const;                    堆顶（Compare 意义下最小）
+ *   Key pop();                                 弹出堆顶并返回，其句柄随即失效
+ *   const Key &key(handle_type h) const;       句柄当前的关键字
+ *   void decrease_key(handle_type h, const Key &new_key);
+ *                                              新关键字比原关键字大时抛出异常
+ *   std::size_t meld(Heap &other);             并入 other 并清空它；返回句柄偏移，
+ *                                              other 中的句柄 h 此后变为 h + 偏移
+ *
+ * 句柄是池内下标：弹出后可能被之后的 push 复用。空堆上的 top/pop 抛出异常。
+ */
+
+/**
+ * @brief d 叉隐式堆，带句柄到位置的映射
+ *
+ * 元素 (关键字, 句柄) 连续存放在数组中，位置 i 的子结点为 d i + 1 .. d i + d；
+ * positions[h] 记录句柄 h 当前所在的位置，在每次交换时维护，
+ * 因此 decrease_key 为 O(log_d n) 而不需要查找。D = 4 时树高减半，
+ * 一个结点的四个子结点通常落在同一缓存行内，下沉时的比较次数虽略增，
+ * 访存次数明显减少。meld 追加后以 Floyd 方法重新建堆，O(n + m)。
+ */
+template <typename Key, typename Compare = std::less<Key>, unsigned D = 4>
+class DaryHeap {
+  static_assert(D >= 2, "D must be at least 2");
+
+public:
+  using handle_type = std::uint32_t;
+
+  explicit DaryHeap(const Compare &compare = Compare()) : less(compare) {}
+
+  bool empty() const { return heap.empty(); }
+
+  std::size_t size() const { return heap.size(); }
+
+  // 预留 n 个元素与句柄的空间
+  void reserve(std::size_t n) {
+    heap.reserve(n);
+    positions.reserve(n);
+  }
+
+  handle_type push(const Key &new_key) {
+    handle_type h = acquire_handle();
+    heap.push_back(Entry{new_key, h});
+    positions[h] = static_cast<std::uint32_t>(heap.size() - 1);
+    sift_up(heap.size() - 1);
+    return h;
+  }
+
+  const Key &top() const {
+    if (heap.empty()) {
+      throw std::runtime_error("堆为空");
+    }
+    return heap[0].key;
+  }
+
+  Key pop() {
+    if (heap.empty()) {
+      throw std::runtime_error("堆为空");
+    }
+    Key result = std::move(heap[0].key);
+    release_handle(heap[0].handle);
+    if (heap.size() > 1) {
+      heap[0] = std::move(heap.back());
+      positions[heap[0].handle] = 0;
+      heap.pop_back();
+      sift_down(0);
+    } else {
+      heap.pop_back();
+    }
+    return result;
+  }
+
+  const Key &key(handle_type h) const { return heap[positions[h]].key; }
+
+  void decrease_key(handle_type h, const Key &new_key) {
+    std::size_t i = positions[h];
+    if (less(heap[i].key, new_key)) {
+      throw std::invalid_argument("新关键字不能大于原关键字");
+    }
+    heap[i].key = new_key;
+    sift_up(i);
+  }
+
+  std::size_t meld(DaryHeap &other) {
+    std::size_t offset = positions.size();
+    // other 的句柄整体偏移 offset；存活句柄的位置在下面重新写入
+    positions.resize(offset + other.positions.size(), kFree);
+    for (handle_type h : other.free_handles) {
+      free_handles.push_back(static_cast<handle_type>(h + offset));
+    }
+    std::size_t base = heap.size();
+    for (Entry &e : other.heap) {
+      e.handle = static_cast<handle_type>(e.handle + offset);
+      heap.push_back(std::move(e));
+    }
+    other.heap.clear();
+    other.positions.clear();
+    other.free_handles.clear();
+
+    if (base == 0 || heap.size() - base > base) {
+      rebuild();
+    } else {
+      for (std::size_t i = base; i < heap.size(); ++i) {
+        positions[heap[i].handle] = static_cast<std::uint32_t>(i);
+        sift_up(i);
+      }
+    }
+    return offset;
+  }
+
+  void clear() {
+    heap.clear();
+    positions.clear();
+    free_handles.clear();
+  }
+
+private:
+  struct Entry {
+    Key key;
+    handle_type handle;
+  };
+
+  static constexpr std::uint32_t kFree =
+      std::numeric_limits<std::uint32_t>::max();
+
+  std::vector<Entry> heap;
+  std::vector<std::uint32_t> positions; // 句柄 -> 位置；已释放为 kFree
+  std::vector<handle_type> free_handles;
+  Compare less;
+
+  handle_type acquire_handle() {
+    if (!free_handles.empty()) {
+      handle_type h = free_handles.back();
+      free_handles.pop_back();
+      return h;
+    }
+    if (positions.size() >= kFree - 1) {
+      throw std::length_error("句柄数超出32位下标范围");
+    }
+    positions.push_back(0);
+    return static_cast<handle_type>(positions.size() - 1);
+  }
+
+  void release_handle(handle_type h) {
+    positions[h] = kFree;
+    free_handles.push_back(h);
+  }
+
+  // 上浮：空出的位置逐层下移父结点，最后一次写入
+  void sift_up(std::size_t i) {
+    Entry moving = std::move(heap[i]);
+    while (i > 0) {
+      std::size_t parent = (i - 1) / D;
+      if (!less(moving.key, heap[parent].key)) {
+        break;
+      }
+      heap[i] = std::move(heap[parent]);
+      positions[heap[i].handle] = static_cast<std::uint32_t>(i);
+      i = parent;
+    }
+    positions[moving.handle] = static_cast<std::uint32_t>(i);
+    heap[i] = std::move(moving);
+  }
+
+  void sift_down(std::size_t i) {
+    std::size_t n = heap.size();
+    Entry moving = std::move(heap[i]);
+    while (true) {
+      std::size_t first = D * i + 1;
+      if (first >= n) {
+        break;
+      }
+      std::size_t last = first + D < n ? first + D : n;
+      std::size_t best = first;
+      for (std::size_t c = first + 1; c < last; ++c) {
+        if (less(heap[c].key, heap[best].key)) {
+          best = c;
+        }
+      }
+      if (!less(heap[best].key, moving.key)) {
+        break;
+      }
+      heap[i] = std::move(heap[best]);
+      positions[heap[i].handle] = static_cast<std::uint32_t>(i);
+      i = best;
+    }
+    positions[moving.handle] = static_cast<std::uint32_t>(i);
+    heap[i] = std::move(moving);
+  }
+
+  // Floyd 建堆，O(n)
+  void rebuild() {
+    for (std::size_t i = 0; i < heap.size(); ++i) {
+      positions[heap[i].handle] = static_cast<std::uint32_t>(i);
+    }
+    if (heap.size() < 2) {
+      return;
+    }
+    for (std::size_t i = (heap.size() - 2) / D + 1; i-- > 0;) {
+      sift_down(i);
+    }
+  }
+};
+
+/**
+ * @brief 配对堆，结点放在连续的池中
+ *
+ * 采用"左孩子-右兄弟"表示：每个结点记录最左的孩子、右兄弟，以及 prev
+ * （最左孩子指向父结点，其余指向左兄弟），删除任意子树只需改两个链接。
+ * 结点以32位下标存放在 vector 中，弹出的结点经空闲链表复用，
+ * 不做逐结点的堆分配。push、meld、decrease_key 为 O(1)（meld 另需
+ * O(m) 把 other 的池追加过来），pop 采用两遍配对，摊还 O(log n)。
+ */
+template <typename Key, typename Compare = std::less<Key>> class PairingHeap {
+public:
+  using handle_type = std::uint32_t;
+
+  explicit PairingHeap(const Compare &compare = Compare()) : less(compare) {}
+
+  bool empty() const { return count == 0; }
+
+  std::size_t size() const { return count; }
+
+  void reserve(std::size_t n) { pool.reserve(n); }
+
+  handle_type push(const Key &new_key) {
+    handle_type h = allocate(new_key);
+    root = (root == kNil) ? h : link(root, h);
+    ++count;
+    return h;
+  }
+
+  const Key &top() const {
+    if (count == 0) {
+      throw std::runtime_error("堆为空");
+    }
+    return pool[root].key;
+  }
+
+  Key pop() {
+    if (count == 0) {
+      throw std::runtime_error("堆为空");
+    }
+    handle_type old_root = root;
+    Key result = std::move(pool[old_root].key);
+    root = merge_pairs(pool[old_root].child);
+    if (root != kNil) {
+      pool[root].prev = kNil;
+    }
+    release(old_root);
+    --count;
+    return result;
+  }
+
+  const Key &key(handle_type h) const { return pool[h].key; }
+
+  void decrease_key(handle_type h, const Key &new_key) {
+    if (less(pool[h].key, new_key)) {
+      throw std::invalid_argument("新关键字不能大于原关键字");
+    }
+    pool[h].key = new_key;
+    if (h == root) {
+      return;
+    }
+    // 把以 h 为根的子树从兄弟链中摘下，再与根连接
+    Node &n = pool[h];
+    if (pool[n.prev].child == h) {
+      pool[n.prev].child = n.sibling;
+    } else {
+      pool[n.prev].sibling = n.sibling;
+    }
+    if (n.sibling != kNil) {
+      pool[n.sibling].prev = n.prev;
+    }
+    n.prev = kNil;
+    n.sibling = kNil;
+    root = link(root, h);
+  }
+
+  std::size_t meld(PairingHeap &other) {
+    std::size_t offset = pool.size();
+    auto shift = [offset](handle_type x) {
+      return x == kNil ? kNil : static_cast<handle_type>(x + offset);
+    };
+    for (Node &n : other.pool) {
+      n.child = shift(n.child);
+      n.sibling = shift(n.sibling);
+      n.prev = shift(n.prev);
+      pool.push_back(std::move(n));
+    }
+    // 空闲链表拼接：other 的空闲结点接在本堆空闲链表之前
+    handle_type other_free = shift(other.free_head);
+    if (other_free != kNil) {
+      handle_type tail = other_free;
+      while (pool[tail].sibling != kNil) {
+        tail = pool[tail].sibling;
+      }
+      pool[tail].sibling = free_head;
+      free_head = other_free;
+    }
+    handle_type other_root = shift(other.root);
+    if (other_root != kNil) {
+      root = (root == kNil) ? other_root : link(root, other_root);
+    }
+    count += other.count;
+    other.clear();
+    return offset;
+  }
+
+  void clear() {
+    pool.clear();
+    scratch.clear();
+    root = free_head = kNil;
+    count = 0;
+  }
+
+private:
+  static constexpr handle_type kNil = std::numeric_limits<handle_type>::max();
+
+  struct Node {
+    Key key;
+    handle_type child;   // 最左的孩子
+    handle_type sibling; // 右兄弟；空闲结点用它串成空闲链表
+    handle_type prev;    // 最左孩子指向父结点，其余指向左兄弟
+  };
+
+  std::vector<Node> pool;
+  std::vector<handle_type> scratch; // 两遍配对的暂存区
+  handle_type root = kNil;
+  handle_type free_head = kNil;
+  std::size_t count = 0;
+  Compare less;
+
+  handle_type allocate(const Key &new_key) {
+    if (free_head != kNil) {
+      handle_type h = free_head;
+      free_head = pool[h].sibling;
+      pool[h] = Node{new_key, kNil, kNil, kNil};
+      return h;
+    }
+    if (pool.size() >= kNil) {
+      throw std::length_error("结点数超出32位下标范围");
+    }
+    pool.push_back(Node{new_key, kNil, kNil, kNil});
+    return static_cast<handle_type>(pool.size() - 1);
+  }
+
+  void release(handle_type h) {
+    pool[h].sibling = free_head;
+    free_head = h;
+  }
+
+  // 连接两棵树（两者都是根，没有兄弟），返回新根
+  handle_type link(handle_type a, handle_type b) {
+    if (less(pool[b].key, pool[a].key)) {
+      std::swap(a, b);
+    }
+    // b 成为 a 的最左孩子
+    Node &child = pool[b];
+    child.sibling = pool[a].child;
+    child.prev = a;
+    if (child.sibling != kNil) {
+      pool[child.sibling].prev = b;
+    }
+    pool[a].child = b;
+    return a;
+  }
+
+  // 两遍配对：从左到右两两连接，再从右到左依次并入
+  handle_type merge_pairs(handle_type first) {
+    if (first == kNil) {
+      return kNil;
+    }
+    scratch.clear();
+    while (first != kNil) {
+      handle_type a = first;
+      handle_type b = pool[a].sibling;
+      if (b == kNil) {
+        pool[a].prev = kNil;
+        scratch.push_back(a);
+        break;
+      }
+      first = pool[b].sibling;
+      pool[a].sibling = pool[a].prev = kNil;
+      pool[b].sibling = pool[b].prev = kNil;
+      scratch.push_back(link(a, b));
+    }
+    handle_type result = scratch.back();
+    for (std::size_t i = scratch.size() - 1; i-- > 0;) {
+      result = link(scratch[i], result);
+    }
+    return result;
+  }
+};
+
+/**
+ * @brief 把第19章的 FibonacciHeap 适配为可寻址堆概念
+ *
+ * 堆内关键字带上句柄，句柄是结点指针表的下标，弹出时据此释放。
+ * FibonacciHeap 本身的 merge 为 O(1)，但 other 中各结点记录的句柄
+ * 需要重新编号，因此 meld 为 O(m)。
+ */
+template <typename Key, typename Compare = std::less<Key>>
+class FibonacciAddressableHeap {
+public:
+  using handle_type = std::uint32_t;
+
+  FibonacciAddressableHeap() = default;
+  FibonacciAddressableHeap(FibonacciAddressableHeap &&) = default;
+  FibonacciAddressableHeap &operator=(FibonacciAddressableHeap &&) = default;
+
+  // FibonacciHeap 的结点以 shared_ptr 互相环形引用，析构时断开所有链接
+  ~FibonacciAddressableHeap() {
+    for (auto &node : nodes) {
+      if (node) {
+        unlink(*node);
+      }
+    }
+  }
+
+  bool empty() const { return heap.is_empty(); }
+
+  std::size_t size() const { return static_cast<std::size_t>(heap.size()); }
+
+  void reserve(std::size_t n) { nodes.reserve(n); }
+
+  handle_type push(const Key &new_key) {
+    handle_type h;
+    if (!free_handles.empty()) {
+      h = free_handles.back();
+      free_handles.pop_back();
+    } else {
+      h = static_cast<handle_type>(nodes.size());
+      nodes.emplace_back();
+    }
+    nodes[h] = heap.insert(Tagged{new_key, h});
+    return h;
+  }
+
+  const Key &top() const {
+    if (heap.is_empty()) {
+      throw std::runtime_error("堆为空");
+    }
+    return min_key();
+  }
+
+  Key pop() {
+    Tagged min = heap.extract_min();
+    unlink(*nodes[min.handle]);
+    nodes[min.handle] = nullptr;
+    free_handles.push_back(min.handle);
+    return min.key;
+  }
+
+  const Key &key(handle_type h) const { return nodes[h]->key.key; }
+
+  void decrease_key(handle_type h, const Key &new_key) {
+    heap.decrease_key(nodes[h], Tagged{new_key, h});
+  }
+
+  std::size_t meld(FibonacciAddressableHeap &other) {
+    std::size_t offset = nodes.size();
+    for (auto &node : other.nodes) {
+      if (node) {
+        node->key.handle = static_cast<handle_type>(node->key.handle + offset);
+      }
+      nodes.push_back(std::move(node));
+    }
+    for (handle_type h : other.free_handles) {
+      free_handles.push_back(static_cast<handle_type>(h + offset));
+    }
+    heap.merge(other.heap);
+    other.nodes.clear();
+    other.free_handles.clear();
+    return offset;
+  }
+
+private:
+  // 只按关键字比较；FibonacciHeap 使用 < 与 >
+  struct Tagged {
+    Key key;
+    handle_type handle;
+
+    bool operator<(const Tagged &other) const {
+      return Compare()(key, other.key);
+    }
+    bool operator>(const Tagged &other) const {
+      return Compare()(other.key, key);
+    }
+  };
+
+  FibonacciHeap<Tagged> heap;
+  std::vector<std::shared_ptr<FibonacciHeapNode<Tagged>>> nodes;
+  std::vector<handle_type> free_handles;
+
+  static void unlink(FibonacciHeapNode<Tagged> &node) {
+    node.parent.reset();
+    node.child.reset();
+    node.left.reset();
+    node.right.reset();
+  }
+
+  // FibonacciHeap::get_min 按值返回，这里经句柄表取得堆内关键字的引用
+  const Key &min_key() const { return key(heap.get_min().handle); }
+};
+
+} // namespace algorithms
+
+#endif // ADDRESSABLE_HEAP_H
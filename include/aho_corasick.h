@@ -0,0 +1,301 @@
+#ifndef AHO_CORASICK_H
+#define AHO_CORASICK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace algorithms {
+
+/**
+ * @brief 多模式匹配的一次命中
+ */
+struct AhoCorasickMatch {
+  int pattern_id;     // 模式在构造参数中的下标
+  std::size_t offset; // 匹配在整个输入流中的起始位置
+
+  bool operator==(const AhoCorasickMatch &other) const {
+    return pattern_id == other.pattern_id && offset == other.offset;
+  }
+};
+
+/**
+ * @brief Aho-Corasick 多模式匹配自动机
+ *
+ * 32.3节的有限自动机只识别一个模式；把所有模式放进一棵字典树，
+ * 用失败链接（即多模式版本的前缀函数）补全缺失的转移，就得到同时识别
+ * 所有模式的确定有限自动机，扫描一遍文本即可报告所有模式的所有出现。
+ *
+ * 与 FiniteAutomatonMatcher 的 transition[m+1][256] 不同：
+ * - 字母表压缩：只在模式中出现过的字节各占一个字节类，其余字节共用类0
+ *   （读到它们总是回到根），转移表每行只有"字节类数"列；
+ * - 转移表是一个扁平数组，状态编号预先乘以行宽，目标状态的最高位标记
+ *   "该状态有输出"，扫描的内层循环只有一次查表和一次位测试；
+ * - 构造按BFS顺序一次填完转移表，代价 O(总模式长度 × 字节类数)。
+ *
+ * 转移表占用 状态数 × 字节类数 × 4 字节，可用 memory_bytes() 查看。
+ * 自动机构造后只读，可被多个 Stream 同时使用。
+ */
+class AhoCorasickMatcher {
+private:
+  static constexpr std::uint32_t kMatchBit = 0x80000000u;
+  static constexpr std::uint32_t kStateMask = ~kMatchBit;
+  static constexpr std::uint32_t kNone =
+      std::numeric_limits<std::uint32_t>::max();
+
+  std::uint16_t byte_class[256];
+  std::uint32_t stride; // 字节类数，即转移表行宽
+  std::uint32_t state_count;
+
+  // transitions[s + c]：s 为预乘后的状态偏移，c 为字节类
+  std::vector<std::uint32_t> transitions;
+
+  // 按状态下标：本状态结束的模式 [output_begin[i], output_begin[i+1])，
+  // 以及字典后缀链接（最近的、自身有输出的失败链祖先）
+  std::vector<std::uint32_t> output_begin;
+  std::vector<int> outputs;
+  std::vector<std::uint32_t> dictionary_link;
+  std::vector<std::uint32_t> pattern_lengths;
+
+  template <typename OnMatch>
+  void report(std::uint32_t state, std::size_t end, OnMatch &on_match) const {
+    std::uint32_t i = state / stride;
+    while (i != kNone) {
+      for (std::uint32_t k = output_begin[i]; k < output_begin[i + 1]; k++) {
+        int id = outputs[k];
+        on_match(AhoCorasickMatch{id, end + 1 - pattern_lengths[id]});
+      }
+      i = dictionary_link[i];
+    }
+  }
+
+  // 从预乘后的状态 state 出发扫描 [data, data + length)，
+  // base 为 data[0] 在输入流中的位置，返回结束状态
+  template <typename OnMatch>
+  std::uint32_t run(std::uint32_t state, const char *data, std::size_t length,
+                    std::size_t base, OnMatch &on_match) const {
+    const std::uint32_t *table = transitions.data();
+    for (std::size_t i = 0; i < length; i++) {
+      std::uint32_t next =
+          table[state + byte_class[static_cast<unsigned char>(data[i])]];
+      state = next & kStateMask;
+      if (next & kMatchBit) {
+        report(state, base + i, on_match);
+      }
+    }
+    return state;
+  }
+
+public:
+  /**
+   * @brief 编译模式集合
+   * @param patterns 模式列表，模式编号为其下标；允许重复
+   * @throws std::invalid_argument 存在空模式
+   * @throws std::length_error 转移表超出32位状态编号的范围
+   */
+  explicit AhoCorasickMatcher(const std::vector<std::string> &patterns)
+      : stride(1), state_count(1) {
+    // 字节类：出现在模式中的字节依次编号 1..k，其余为 0
+    for (auto &c : byte_class) {
+      c = 0;
+    }
+    std::size_t total_length = 0;
+    for (const std::string &pattern : patterns) {
+      if (pattern.empty()) {
+        throw std::invalid_argument("模式不能为空");
+      }
+      total_length += pattern.size();
+      for (char ch : pattern) {
+        auto &c = byte_class[static_cast<unsigned char>(ch)];
+        if (c == 0) {
+          c = static_cast<std::uint16_t>(stride++);
+        }
+      }
+    }
+    if ((total_length + 1) * stride >= kMatchBit) {
+      throw std::length_error("模式集合过大");
+    }
+
+    // 1. 字典树：缺失的边暂记为 kNone，状态用下标表示
+    transitions.assign(stride, kNone);
+    std::vector<std::uint32_t> terminal(patterns.size());
+    pattern_lengths.resize(patterns.size());
+    for (std::size_t id = 0; id < patterns.size(); id++) {
+      std::uint32_t s = 0;
+      for (char ch : patterns[id]) {
+        std::size_t slot = static_cast<std::size_t>(s) * stride +
+                           byte_class[static_cast<unsigned char>(ch)];
+        if (transitions[slot] == kNone) {
+          transitions[slot] = state_count++;
+          transitions.resize(static_cast<std::size_t>(state_count) * stride,
+                             kNone);
+        }
+        s = transitions[slot];
+      }
+      terminal[id] = s;
+      pattern_lengths[id] = static_cast<std::uint32_t>(patterns[id].size());
+    }
+
+    // 本状态结束的模式，按模式编号排列
+    output_begin.assign(state_count + 1, 0);
+    for (std::uint32_t s : terminal) {
+      output_begin[s + 1]++;
+    }
+    for (std::uint32_t i = 0; i < state_count; i++) {
+      output_begin[i + 1] += output_begin[i];
+    }
+    outputs.resize(patterns.size());
+    std::vector<std::uint32_t> fill(output_begin.begin(),
+                                    output_begin.end() - 1);
+    for (std::size_t id = 0; id < patterns.size(); id++) {
+      outputs[fill[terminal[id]]++] = static_cast<int>(id);
+    }
+
+    // 2. BFS：失败链接、字典后缀链接，并用失败状态的行补全缺失的转移。
+    //    处理状态 u 时，fail[u] 更浅，它的行已经补全。
+    std::vector<std::uint32_t> fail(state_count, 0);
+    dictionary_link.assign(state_count, kNone);
+    std::vector<std::uint32_t> queue;
+    queue.reserve(state_count);
+    for (std::uint32_t c = 0; c < stride; c++) {
+      std::uint32_t &v = transitions[c];
+      if (v == kNone) {
+        v = 0;
+      } else {
+        queue.push_back(v);
+      }
+    }
+    for (std::size_t head = 0; head < queue.size(); head++) {
+      std::uint32_t u = queue[head];
+      std::uint32_t f = fail[u];
+      std::uint32_t *row = &transitions[static_cast<std::size_t>(u) * stride];
+      const std::uint32_t *fail_row =
+          &transitions[static_cast<std::size_t>(f) * stride];
+      for (std::uint32_t c = 0; c < stride; c++) {
+        if (row[c] == kNone) {
+          row[c] = fail_row[c];
+        } else {
+          std::uint32_t v = row[c];
+          std::uint32_t w = fail_row[c];
+          fail[v] = w;
+          dictionary_link[v] =
+              output_begin[w] != output_begin[w + 1] ? w : dictionary_link[w];
+          queue.push_back(v);
+        }
+      }
+    }
+
+    // 3. 预乘状态编号并打上输出标记
+    std::vector<std::uint32_t> encoded(state_count);
+    for (std::uint32_t i = 0; i < state_count; i++) {
+      bool has_output = output_begin[i] != output_begin[i + 1] ||
+                        dictionary_link[i] != kNone;
+      encoded[i] = i * stride | (has_output ? kMatchBit : 0);
+    }
+    for (std::uint32_t &t : transitions) {
+      t = encoded[t];
+    }
+  }
+
+  /**
+   * @brief 流式扫描器：在多次 feed 之间保留自动机状态与输入位置，
+   *        跨越缓冲区边界的匹配也能被报告
+   */
+  class Stream {
+  private:
+    const AhoCorasickMatcher *matcher;
+    std::uint32_t state;
+    std::size_t position;
+
+  public:
+    explicit Stream(const AhoCorasickMatcher &matcher)
+        : matcher(&matcher), state(0), position(0) {}
+
+    /**
+     * @brief 输入下一段数据，每次命中调用 on_match(const AhoCorasickMatch &)
+     */
+    template <typename OnMatch>
+    void feed(std::string_view chunk, OnMatch on_match) {
+      state = matcher->run(state, chunk.data(), chunk.size(), position,
+                           on_match);
+      position += chunk.size();
+    }
+
+    /**
+     * @brief 输入下一段数据，返回本段中结束的所有匹配
+     */
+    std::vector<AhoCorasickMatch> feed(std::string_view chunk) {
+      std::vector<AhoCorasickMatch> matches;
+      feed(chunk, [&matches](const AhoCorasickMatch &match) {
+        matches.push_back(match);
+      });
+      return matches;
+    }
+
+    /**
+     * @brief 已输入的字节数
+     */
+    std::size_t consumed() const { return position; }
+
+    /**
+     * @brief 回到初始状态，位置清零
+     */
+    void reset() {
+      state = 0;
+      position = 0;
+    }
+  };
+
+  Stream stream() const { return Stream(*this); }
+
+  /**
+   * @brief 扫描整段文本，每次命中调用 on_match(const AhoCorasickMatch &)
+   */
+  template <typename OnMatch>
+  void scan(std::string_view text, OnMatch on_match) const {
+    run(0, text.data(), text.size(), 0, on_match);
+  }
+
+  /**
+   * @brief 返回文本中所有模式的所有出现，按结束位置排序；
+   *        同一位置结束的匹配中较长的模式在前
+   */
+  std::vector<AhoCorasickMatch> search(std::string_view text) const {
+    std::vector<AhoCorasickMatch> matches;
+    scan(text, [&matches](const AhoCorasickMatch &match) {
+      matches.push_back(match);
+    });
+    return matches;
+  }
+
+  /**
+   * @brief 统计命中次数，不分配结果数组
+   */
+  std::size_t count(std::string_view text) const {
+    std::size_t hits = 0;
+    scan(text, [&hits](const AhoCorasickMatch &) { hits++; });
+    return hits;
+  }
+
+  std::size_t pattern_count() const { return pattern_lengths.size(); }
+
+  std::size_t get_state_count() const { return state_count; }
+
+  std::size_t alphabet_classes() const { return stride; }
+
+  std::size_t memory_bytes() const {
+    return transitions.size() * sizeof(std::uint32_t) +
+           (output_begin.size() + dictionary_link.size() +
+            pattern_lengths.size()) *
+               sizeof(std::uint32_t) +
+           outputs.size() * sizeof(int);
+  }
+};
+
+} // namespace algorithms
+
+#endif // AHO_CORASICK_H
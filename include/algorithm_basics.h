@@ -1,6 +1,7 @@
 #ifndef ALGORITHM_BASICS_H
 #define ALGORITHM_BASICS_H
 
+#include "workload_generator.h"
 #include <algorithm>
 #include <chrono>
 #include <functional>
@@ -87,28 +88,78 @@ template <typename T> void insertion_sort(std::vector<T> &arr) {
 }
 
 /**
- * @brief 归并排序算法
+ * @brief 使用调用方提供的缓冲区合并两个已排序的子数组
  *
- * 算法导论第2.3节：归并排序
- * 时间复杂度：O(n log n)
- * 空间复杂度：O(n)
+ * 只把左半部分arr[left..mid]搬进缓冲区，再从左到右写回原数组：
+ * 写指针永远不会超过右半部分的读指针，右半部分无需复制。
+ * 缓冲区由归并排序一次性分配、各层递归共用，避免每次合并都分配临时数组。
+ *
+ * @tparam T 元素类型
+ * @param arr 数组
+ * @param left 左边界
+ * @param mid 中间位置
+ * @param right 右边界
+ * @param buffer 缓冲区，长度至少为 mid - left + 1
+ */
+template <typename T>
+void merge(std::vector<T> &arr, int left, int mid, int right,
+           std::vector<T> &buffer) {
+  int n1 = mid - left + 1;
+  std::move(arr.begin() + left, arr.begin() + mid + 1, buffer.begin());
+
+  int i = 0, j = mid + 1, k = left;
+  while (i < n1 && j <= right) {
+    if (buffer[i] <= arr[j]) {
+      arr[k++] = std::move(buffer[i++]);
+    } else {
+      arr[k++] = std::move(arr[j++]);
+    }
+  }
+  // 右半部分剩余元素已在原位
+  std::move(buffer.begin() + i, buffer.begin() + n1, arr.begin() + k);
+}
+
+/**
+ * @brief 归并排序的递归过程，各层共用同一缓冲区
  *
  * @tparam T 元素类型
  * @param arr 待排序数组
  * @param left 左边界
  * @param right 右边界
+ * @param buffer 缓冲区，长度至少为 (right - left) / 2 + 1
  */
 template <typename T>
-void merge_sort(std::vector<T> &arr, int left, int right) {
+void merge_sort(std::vector<T> &arr, int left, int right,
+                std::vector<T> &buffer) {
   if (left < right) {
     int mid = left + (right - left) / 2;
 
     // 递归排序左右两部分
-    merge_sort(arr, left, mid);
-    merge_sort(arr, mid + 1, right);
+    merge_sort(arr, left, mid, buffer);
+    merge_sort(arr, mid + 1, right, buffer);
 
     // 合并已排序的两部分
-    merge(arr, left, mid, right);
+    merge(arr, left, mid, right, buffer);
+  }
+}
+
+/**
+ * @brief 归并排序算法
+ *
+ * 算法导论第2.3节：归并排序
+ * 时间复杂度：O(n log n)
+ * 空间复杂度：O(n)，缓冲区只分配一次
+ *
+ * @tparam T 元素类型
+ * @param arr 待排序数组
+ * @param left 左边界
+ * @param right 右边界
+ */
+template <typename T>
+void merge_sort(std::vector<T> &arr, int left, int right) {
+  if (left < right) {
+    std::vector<T> buffer((right - left) / 2 + 1);
+    merge_sort(arr, left, right, buffer);
   }
 }
 
@@ -124,6 +175,96 @@ template <typename T> void merge_sort(std::vector<T> &arr) {
   merge_sort(arr, 0, arr.size() - 1);
 }
 
+namespace merge_sort_detail {
+// 自然归并排序中顺串的最短长度：更短的顺串用插入排序补足
+constexpr size_t kMinRun = 24;
+} // namespace merge_sort_detail
+
+/**
+ * @brief 自底向上的自然归并排序（稳定）
+ *
+ * 先从左到右切出已有的顺串：非递减段原样保留，严格递减段就地翻转，
+ * 不足 kMinRun 个元素的顺串用插入排序补足。然后逐趟两两合并相邻顺串，
+ * 在原数组与一块预分配的辅助缓冲区之间来回倒换，每趟顺串数减半；
+ * 相邻两段首尾已有序时直接搬运不做比较。
+ * 已有序或逆序的输入只需一次扫描，近乎有序的输入顺串很少，接近O(n)。
+ * 时间复杂度：O(n log r)，r为初始顺串数
+ * 空间复杂度：O(n)，整个排序只分配一次缓冲区
+ *
+ * @tparam T 元素类型
+ * @tparam Compare 严格弱序比较器
+ * @param arr 待排序数组
+ * @param less 比较器
+ */
+template <typename T, typename Compare = std::less<T>>
+void natural_merge_sort(std::vector<T> &arr, Compare less = Compare()) {
+  size_t n = arr.size();
+  if (n < 2)
+    return;
+
+  // 切分顺串，bounds[k]..bounds[k+1] 是第k个顺串
+  std::vector<size_t> bounds;
+  bounds.reserve(n / merge_sort_detail::kMinRun + 2);
+  bounds.push_back(0);
+  for (size_t i = 0; i < n;) {
+    size_t j = i + 1;
+    if (j < n && less(arr[j], arr[i])) {
+      while (j < n && less(arr[j], arr[j - 1]))
+        j++;
+      std::reverse(arr.begin() + i, arr.begin() + j);
+    } else {
+      while (j < n && !less(arr[j], arr[j - 1]))
+        j++;
+    }
+
+    // 插入排序把短顺串补足到 kMinRun
+    size_t end = std::min(n, std::max(j, i + merge_sort_detail::kMinRun));
+    for (; j < end; j++) {
+      T key = std::move(arr[j]);
+      size_t k = j;
+      while (k > i && less(key, arr[k - 1])) {
+        arr[k] = std::move(arr[k - 1]);
+        k--;
+      }
+      arr[k] = std::move(key);
+    }
+    bounds.push_back(end);
+    i = end;
+  }
+  if (bounds.size() == 2)
+    return;
+
+  std::vector<T> buffer(n);
+  std::vector<T> *src = &arr, *dst = &buffer;
+  while (bounds.size() > 2) {
+    size_t runs = bounds.size() - 1, kept = 1;
+    for (size_t r = 0; r < runs; r += 2) {
+      auto from = src->begin(), to = dst->begin();
+      size_t lo = bounds[r], mid = bounds[r + 1];
+      size_t hi = r + 2 <= runs ? bounds[r + 2] : mid;
+      if (mid == hi || !less((*src)[mid], (*src)[mid - 1])) {
+        // 落单的最后一段，或两段首尾已有序
+        std::move(from + lo, from + hi, to + lo);
+      } else {
+        size_t a = lo, b = mid, k = lo;
+        while (a < mid && b < hi) {
+          if (less((*src)[b], (*src)[a]))
+            (*dst)[k++] = std::move((*src)[b++]);
+          else
+            (*dst)[k++] = std::move((*src)[a++]);
+        }
+        std::move(from + a, from + mid, to + k);
+        std::move(from + b, from + hi, to + k + (mid - a));
+      }
+      bounds[kept++] = hi;
+    }
+    bounds.resize(kept);
+    std::swap(src, dst);
+  }
+  if (src != &arr)
+    std::move(buffer.begin(), buffer.end(), arr.begin());
+}
+
 /**
  * @brief 线性查找算法
  *
@@ -264,6 +405,9 @@ public:
   /**
    * @brief 测量算法执行时间
    *
+   * 只计时一次，适合演示程序里粗略展示量级；需要预热、多次重复、
+   * 中位数/p99与硬件计数器的性能测试请用 benchmark_harness.h。
+   *
    * @tparam Func 函数类型
    * @param func 要测量的函数
    * @param args 函数参数
@@ -271,9 +415,9 @@ public:
    */
   template <typename Func, typename... Args>
   static double measure_time(Func &&func, Args &&...args) {
-    auto start = std::chrono::high_resolution_clock::now();
+    auto start = std::chrono::steady_clock::now();
     std::forward<Func>(func)(std::forward<Args>(args)...);
-    auto end = std::chrono::high_resolution_clock::now();
+    auto end = std::chrono::steady_clock::now();
 
     return std::chrono::duration<double, std::milli>(end - start).count();
   }
@@ -309,33 +453,24 @@ public:
   }
 
   /**
-   * @brief 生成随机测试数据
+   * @brief 生成随机测试数据（[min_val, max_val] 内均匀分布，同一种子结果相同）
+   *
+   * 其他分布（有序、近乎有序、Zipf等）见 workload_generator.h。
    *
    * @tparam T 元素类型
    * @param size 数据大小
    * @param min_val 最小值
    * @param max_val 最大值
+   * @param seed 随机数种子
    * @return std::vector<T> 随机生成的数组
    */
   template <typename T>
-  static std::vector<T> generate_random_data(int size, T min_val, T max_val) {
-    std::vector<T> data(size);
-    std::random_device rd;
-    std::mt19937 gen(rd());
-
-    if constexpr (std::is_integral_v<T>) {
-      std::uniform_int_distribution<T> dis(min_val, max_val);
-      for (int i = 0; i < size; i++) {
-        data[i] = dis(gen);
-      }
-    } else {
-      std::uniform_real_distribution<T> dis(min_val, max_val);
-      for (int i = 0; i < size; i++) {
-        data[i] = dis(gen);
-      }
-    }
-
-    return data;
+  static std::vector<T>
+  generate_random_data(int size, T min_val, T max_val,
+                       uint64_t seed = WorkloadGenerator::kDefaultSeed) {
+    return WorkloadGenerator(seed).generate(Distribution::kUniform,
+                                            static_cast<size_t>(size), min_val,
+                                            max_val);
   }
 };
 
@@ -1,9 +1,12 @@
 #ifndef ALL_PAIRS_SHORTEST_PATH_H
 #define ALL_PAIRS_SHORTEST_PATH_H
 
+#include "cpu_features.h"
 #include "graph_representation.h"
 #include "shortest_path.h"
+#include "work_stealing_scheduler.h"
 #include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <iomanip>
 #include <iostream>
@@ -11,6 +14,12 @@
 #include <queue>
 #include <vector>
 
+#if (defined(__x86_64__) || defined(__i386__)) &&                             \
+    (defined(__GNUC__) || defined(__clang__))
+#define ALGORITHMS_FLOYD_X86 1
+#include <immintrin.h>
+#endif
+
 namespace algorithms {
 
 // 所有节点对最短路径结果结构
@@ -85,6 +94,80 @@ struct AllPairsShortestPathResult {
   }
 };
 
+/**
+ * @brief 连续存储的 n × n 距离矩阵与前驱矩阵（行主序）
+ *
+ * distances[i * n + j] 为 i 到 j 的距离，不可达为 INT_MAX；
+ * predecessors 为空表示没有记录前驱。
+ */
+struct DenseAllPairsResult {
+  size_t n;
+  std::vector<int> distances;
+  std::vector<int> predecessors;
+  bool has_negative_cycle;
+
+  DenseAllPairsResult() : n(0), has_negative_cycle(false) {}
+
+  int distance(size_t i, size_t j) const { return distances[i * n + j]; }
+
+  int predecessor(size_t i, size_t j) const {
+    return predecessors.empty() ? -1 : predecessors[i * n + j];
+  }
+
+  /**
+   * @brief 由直接边构造初始矩阵：对角线为0，重边取最小权，
+   *        自环只在权为负时覆盖对角线上的0
+   *
+   * Graph 需满足 graph_representation.h 中的图概念，结果按节点下标。
+   */
+  template <typename Graph>
+  static DenseAllPairsResult from_graph(const Graph &graph,
+                                        bool track_predecessors) {
+    DenseAllPairsResult result;
+    size_t n = graph.get_node_count();
+    result.n = n;
+    result.distances.assign(n * n, std::numeric_limits<int>::max());
+    if (track_predecessors)
+      result.predecessors.assign(n * n, -1);
+    for (size_t i = 0; i < n; i++)
+      result.distances[i * n + i] = 0;
+    for (size_t u = 0; u < n; u++) {
+      graph.for_each_out_edge(u, [&](int v, int weight) {
+        int &d = result.distances[u * n + v];
+        if (weight < d) {
+          d = weight;
+          if (track_predecessors)
+            result.predecessors[u * n + v] = static_cast<int>(u);
+        }
+      });
+    }
+    return result;
+  }
+
+  // 对角线上出现负值即存在负权环
+  void detect_negative_cycle() {
+    has_negative_cycle = false;
+    for (size_t i = 0; i < n && !has_negative_cycle; i++)
+      has_negative_cycle = distances[i * n + i] < 0;
+  }
+
+  // 转换为嵌套vector形式的结果（便于打印路径）
+  AllPairsShortestPathResult to_result() const {
+    AllPairsShortestPathResult result(static_cast<int>(n));
+    for (size_t i = 0; i < n; i++) {
+      std::copy(distances.begin() + i * n, distances.begin() + (i + 1) * n,
+                result.distances[i].begin());
+      if (!predecessors.empty()) {
+        std::copy(predecessors.begin() + i * n,
+                  predecessors.begin() + (i + 1) * n,
+                  result.predecessors[i].begin());
+      }
+    }
+    result.has_negative_cycle = has_negative_cycle;
+    return result;
+  }
+};
+
 // 25.1 最短路径和矩阵乘法（动态规划方法）
 class MatrixMultiplicationShortestPath {
 public:
@@ -110,9 +193,10 @@ public:
       result.predecessors[edge.from][edge.to] = edge.from;
     }
 
-    // 矩阵乘法方法（动态规划）
+    // 矩阵乘法方法（动态规划）；矩阵不再变化时后续迭代都是空操作
+    std::vector<std::vector<int>> new_distances;
     for (int m = 2; m <= n; m++) {
-      auto new_distances = result.distances;
+      new_distances = result.distances; // 复用上一轮的存储
 
       for (int i = 0; i < n; i++) {
         for (int j = 0; j < n; j++) {
@@ -129,7 +213,10 @@ public:
         }
       }
 
-      result.distances = new_distances;
+      if (new_distances == result.distances) {
+        break;
+      }
+      result.distances.swap(new_distances);
     }
 
     // 检查负权环
@@ -142,13 +229,516 @@ public:
 
     return result;
   }
+
+  /**
+   * @brief FASTER-ALL-PAIRS-SHORTEST-PATHS：重复平方法，O(n³ lg n)
+   *
+   * 见 repeated_squaring；结果转换为嵌套vector形式。
+   */
+  static AllPairsShortestPathResult
+  faster_all_pairs_shortest_path(const AdjacencyListGraph &graph);
+
+  /**
+   * @brief 并行版本：每次平方的输出块由调度器并行计算
+   */
+  static AllPairsShortestPathResult
+  faster_all_pairs_shortest_path(const AdjacencyListGraph &graph,
+                                 WorkStealingScheduler &scheduler);
+
+  template <typename Graph>
+  static DenseAllPairsResult
+  repeated_squaring(const Graph &graph, bool track_predecessors = true,
+                    WorkStealingScheduler *scheduler = nullptr);
 };
 
+/**
+ * @brief int32 距离矩阵上的 min-plus 运算内核（行主序）
+ *
+ * 基本操作是行更新 d[i][j] = min(d[i][j], d[i][k] ⊕ d[k][j])，连续访问
+ * 两行，运行时检测到AVX2时一次处理8个int32。relax_rows 把同一行与
+ * 多个 k 的更新合并：第 i 行的一段元素（及前驱）在整个 k 循环中留在
+ * 寄存器里，要求被读的行在调用期间不变。分块Floyd-Warshall与重复平方法
+ * 共用这些内核。
+ *
+ * ⊕ 是饱和加法：任一操作数为 INT_MAX（不可达）结果为 INT_MAX，溢出时
+ * 截断到 INT_MAX / INT_MIN，因此负权边与负权环都不会回绕。代价是长度
+ * 达到 INT_MAX 的路径会被当作不可达。记录前驱时同一趟更新前驱矩阵：
+ * 经 k 改进 (i, j) 时 pred[i][j] = pred[k][j]。
+ */
+class MinPlusKernel {
+public:
+  static constexpr int kInfinity = std::numeric_limits<int>::max();
+  static constexpr size_t kTile = 128;
+
+  /**
+   * @brief 饱和加法，INT_MAX 表示不可达并被吸收
+   */
+  static int saturating_add(int a, int b) {
+    if (a == kInfinity || b == kInfinity)
+      return kInfinity;
+    long long sum = static_cast<long long>(a) + b;
+    if (sum >= kInfinity)
+      return kInfinity;
+    if (sum < std::numeric_limits<int>::min())
+      return std::numeric_limits<int>::min();
+    return static_cast<int>(sum);
+  }
+
+  /**
+   * @brief row_i[j] = min(row_i[j], a ⊕ row_k[j])，改进时 pred_i[j] = pred_k[j]
+   *
+   * pred_i 为空指针时不记录前驱。row_k 可以与 row_i 重叠（就地更新）。
+   */
+  static void relax_row(int a, const int *row_k, const int *pred_k, int *row_i,
+                        int *pred_i, size_t count) {
+    if (a == kInfinity)
+      return;
+#ifdef ALGORITHMS_FLOYD_X86
+    if (CpuFeatures::avx2()) {
+      if (pred_i)
+        relax_row_avx2<true>(a, row_k, pred_k, row_i, pred_i, count);
+      else
+        relax_row_avx2<false>(a, row_k, pred_k, row_i, pred_i, count);
+      return;
+    }
+#endif
+    relax_row_scalar(a, row_k, pred_k, row_i, pred_i, 0, count);
+  }
+
+  /**
+   * @brief 对 k = 0..depth-1 依次做 relax_row(column_ik[k], rows_k 的第 k 行)
+   *
+   * rows_k 的第 k 行起于 rows_k + k * stride（前驱同理）；column_ik 与
+   * rows_k 不能与 row_i 重叠。
+   */
+  static void relax_rows(const int *column_ik, const int *rows_k,
+                         const int *pred_rows_k, size_t stride, size_t depth,
+                         int *row_i, int *pred_i, size_t count) {
+#ifdef ALGORITHMS_FLOYD_X86
+    if (CpuFeatures::avx2()) {
+      if (pred_i)
+        relax_rows_avx2<true>(column_ik, rows_k, pred_rows_k, stride, depth,
+                              row_i, pred_i, count);
+      else
+        relax_rows_avx2<false>(column_ik, rows_k, nullptr, stride, depth,
+                               row_i, nullptr, count);
+      return;
+    }
+#endif
+    for (size_t k = 0; k < depth; k++)
+      relax_row(column_ik[k], rows_k + k * stride,
+                pred_i ? pred_rows_k + k * stride : nullptr, row_i, pred_i,
+                count);
+  }
+
+  /**
+   * @brief min-plus 矩阵乘法 C = min(C, A ⊗ B)，均为 n × n
+   *
+   * C 按 kTile × kTile 分块，每块由一个任务独占，传入调度器时并行；
+   * 块内按 K 分段调用 relax_rows。C_pred 非空时改进 (i, j) 取 B_pred[k][j]。
+   * C 不能与 A、B 共用存储。
+   */
+  static void product(const int *A, const int *B, const int *B_pred, int *C,
+                      int *C_pred, size_t n,
+                      WorkStealingScheduler *scheduler = nullptr) {
+    size_t tiles = (n + kTile - 1) / kTile;
+    for_each_tile(scheduler, tiles * tiles, [&](size_t t) {
+      size_t i0 = t / tiles * kTile, i1 = std::min(n, i0 + kTile);
+      size_t j0 = t % tiles * kTile, j1 = std::min(n, j0 + kTile);
+      for (size_t k0 = 0; k0 < n; k0 += kTile) {
+        size_t depth = std::min(n, k0 + kTile) - k0;
+        for (size_t i = i0; i < i1; i++) {
+          relax_rows(A + i * n + k0, B + k0 * n + j0,
+                     C_pred ? B_pred + k0 * n + j0 : nullptr, n, depth,
+                     C + i * n + j0, C_pred ? C_pred + i * n + j0 : nullptr,
+                     j1 - j0);
+        }
+      }
+    });
+  }
+
+  /**
+   * @brief 对 t = 0..count-1 调用 body(t)，有调度器时由 parallel_for 并行
+   */
+  template <typename Body>
+  static void for_each_tile(WorkStealingScheduler *scheduler, size_t count,
+                            const Body &body) {
+    auto run_range = [&](size_t lo, size_t hi) {
+      for (size_t t = lo; t < hi; t++)
+        body(t);
+    };
+    if (scheduler && count > 1)
+      scheduler->parallel_for(0, count, 1, run_range);
+    else
+      run_range(0, count);
+  }
+
+private:
+  static void relax_row_scalar(int a, const int *row_k, const int *pred_k,
+                               int *row_i, int *pred_i, size_t begin,
+                               size_t end) {
+    for (size_t j = begin; j < end; j++) {
+      int candidate = saturating_add(a, row_k[j]);
+      if (candidate < row_i[j]) {
+        row_i[j] = candidate;
+        if (pred_i)
+          pred_i[j] = pred_k[j];
+      }
+    }
+  }
+
+#ifdef ALGORITHMS_FLOYD_X86
+  // a 为有限值时的饱和加法：a ≥ 0 只会向上溢出（b 为 INT_MAX 时也在此
+  // 被截断回 INT_MAX）；a < 0 只会向下溢出，需单独保留 b 的 INT_MAX
+  __attribute__((target("avx2"))) static __m256i
+  saturating_add_avx2(int a, __m256i av, __m256i b) {
+    __m256i sum = _mm256_add_epi32(av, b);
+    if (a >= 0)
+      return _mm256_blendv_epi8(sum, _mm256_set1_epi32(kInfinity),
+                                _mm256_cmpgt_epi32(b, sum));
+    sum = _mm256_blendv_epi8(
+        sum, _mm256_set1_epi32(std::numeric_limits<int>::min()),
+        _mm256_cmpgt_epi32(sum, b));
+    return _mm256_blendv_epi8(
+        sum, _mm256_set1_epi32(kInfinity),
+        _mm256_cmpeq_epi32(b, _mm256_set1_epi32(kInfinity)));
+  }
+
+  // 寄存器分块：不记录前驱时一次处理64列，否则32列（寄存器数所限），
+  // 列数不足的尾部退回 relax_row_avx2
+  template <bool Track>
+  __attribute__((target("avx2"))) static void
+  relax_rows_avx2(const int *column_ik, const int *rows_k,
+                  const int *pred_rows_k, size_t stride, size_t depth,
+                  int *row_i, int *pred_i, size_t count) {
+    constexpr size_t kVectors = Track ? 4 : 8;
+    constexpr size_t kWidth = 8 * kVectors;
+    size_t j = 0;
+    for (; j + kWidth <= count; j += kWidth) {
+      __m256i current[kVectors], predecessor[kVectors];
+      for (size_t v = 0; v < kVectors; v++) {
+        current[v] = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(row_i + j + 8 * v));
+        if (Track)
+          predecessor[v] = _mm256_loadu_si256(
+              reinterpret_cast<const __m256i *>(pred_i + j + 8 * v));
+      }
+      for (size_t k = 0; k < depth; k++) {
+        int a = column_ik[k];
+        if (a == kInfinity)
+          continue;
+        __m256i av = _mm256_set1_epi32(a);
+        const int *row_k = rows_k + k * stride + j;
+        for (size_t v = 0; v < kVectors; v++) {
+          __m256i sum = saturating_add_avx2(
+              a, av,
+              _mm256_loadu_si256(
+                  reinterpret_cast<const __m256i *>(row_k + 8 * v)));
+          if (Track) {
+            __m256i improved = _mm256_cmpgt_epi32(current[v], sum);
+            predecessor[v] = _mm256_blendv_epi8(
+                predecessor[v],
+                _mm256_loadu_si256(reinterpret_cast<const __m256i *>(
+                    pred_rows_k + k * stride + j + 8 * v)),
+                improved);
+          }
+          current[v] = _mm256_min_epi32(current[v], sum);
+        }
+      }
+      for (size_t v = 0; v < kVectors; v++) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(row_i + j + 8 * v),
+                            current[v]);
+        if (Track)
+          _mm256_storeu_si256(reinterpret_cast<__m256i *>(pred_i + j + 8 * v),
+                              predecessor[v]);
+      }
+    }
+    if (j < count) {
+      for (size_t k = 0; k < depth; k++) {
+        if (column_ik[k] != kInfinity)
+          relax_row_avx2<Track>(column_ik[k], rows_k + k * stride + j,
+                                Track ? pred_rows_k + k * stride + j : nullptr,
+                                row_i + j, Track ? pred_i + j : nullptr,
+                                count - j);
+      }
+    }
+  }
+
+  template <bool Track>
+  __attribute__((target("avx2"))) static void
+  relax_row_avx2(int a, const int *row_k, const int *pred_k, int *row_i,
+                 int *pred_i, size_t count) {
+    const __m256i av = _mm256_set1_epi32(a);
+    size_t j = 0;
+    for (; j + 8 <= count; j += 8) {
+      __m256i sum = saturating_add_avx2(
+          a, av,
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row_k + j)));
+      __m256i current =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row_i + j));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(row_i + j),
+                          _mm256_min_epi32(current, sum));
+      if (Track) {
+        __m256i improved = _mm256_cmpgt_epi32(current, sum);
+        if (!_mm256_testz_si256(improved, improved)) {
+          __m256i p = _mm256_loadu_si256(
+              reinterpret_cast<const __m256i *>(pred_i + j));
+          __m256i q = _mm256_loadu_si256(
+              reinterpret_cast<const __m256i *>(pred_k + j));
+          _mm256_storeu_si256(reinterpret_cast<__m256i *>(pred_i + j),
+                              _mm256_blendv_epi8(p, q, improved));
+        }
+      }
+    }
+    relax_row_scalar(a, row_k, pred_k, row_i, Track ? pred_i : nullptr, j,
+                     count);
+  }
+#endif
+};
+
+/**
+ * @brief 分块Floyd-Warshall（连续存储的 int32 距离矩阵）
+ *
+ * 把矩阵切成 kTile × kTile 的块，第 K 轮以块内的 k 为中间点：
+ * 1. 对角块 (K, K) 自身做Floyd-Warshall
+ * 2. 第 K 行与第 K 列的块只依赖对角块，彼此独立
+ * 3. 其余块 (I, J) 只依赖 (I, K) 与 (K, J)，全部独立
+ * 2、3两步传入调度器时由 parallel_for 并行执行。1、2两步就地依赖自身，
+ * k 在最外层逐行调用 MinPlusKernel::relax_row；第3步读的两块本轮不变，
+ * 按行调用寄存器分块的 relax_rows。
+ *
+ * 松弛顺序与教科书版本不同，存在等长最短路径时选出的前驱可能不同。
+ * 前驱不在分块更新中记录：有零权环时，跨块的等长更新会让前驱指针
+ * 成环。改为在距离求出后，对每个源点沿紧边（d(i,u) + w(u,v) = d(i,v)）
+ * 做一次广度优先搜索，每个点只在第一次到达时设前驱，得到一棵最短路径树。
+ */
+class BlockedFloydWarshall {
+public:
+  static constexpr int kInfinity = MinPlusKernel::kInfinity;
+  static constexpr size_t kTile = MinPlusKernel::kTile;
+
+  /**
+   * @brief 就地计算所有节点对最短路径
+   *
+   * @param distances n × n 行主序距离矩阵，对角线应为0（或负自环权）
+   * @param predecessors 为空指针时不记录前驱；否则为 n × n 前驱矩阵，
+   *        初值为直接边的起点或 -1
+   * @param n 节点数
+   * @param scheduler 为空指针时串行执行
+   */
+  static void run(int *distances, int *predecessors, size_t n,
+                  WorkStealingScheduler *scheduler = nullptr) {
+    if (n == 0)
+      return;
+    if (predecessors) {
+      // 保存直接边，求出距离后据此重建前驱
+      DenseEdges edges{std::vector<int>(distances, distances + n * n), n};
+      relax_all(distances, n, scheduler);
+      rebuild_predecessors(edges, distances, predecessors, n, scheduler);
+      return;
+    }
+    relax_all(distances, n, scheduler);
+  }
+
+  /**
+   * @brief 由图构造距离矩阵并求解
+   *
+   * Graph 需满足 graph_representation.h 中的图概念，结果按节点下标。
+   */
+  template <typename Graph>
+  static DenseAllPairsResult solve(const Graph &graph,
+                                   bool track_predecessors = true,
+                                   WorkStealingScheduler *scheduler = nullptr) {
+    DenseAllPairsResult result =
+        DenseAllPairsResult::from_graph(graph, track_predecessors);
+    relax_all(result.distances.data(), result.n, scheduler);
+    result.detect_negative_cycle();
+    if (track_predecessors)
+      rebuild_predecessors(graph, result.distances.data(),
+                           result.predecessors.data(), result.n, scheduler);
+    return result;
+  }
+
+  /**
+   * @brief 由最终距离重建前驱矩阵：每个源点沿紧边广度优先搜索
+   *
+   * 有负权环时距离没有意义，前驱全部置为 -1。O(n·(n + m))。
+   */
+  template <typename Graph>
+  static void rebuild_predecessors(const Graph &graph, const int *d, int *pred,
+                                   size_t n,
+                                   WorkStealingScheduler *scheduler = nullptr) {
+    std::fill(pred, pred + n * n, -1);
+    for (size_t i = 0; i < n; i++) {
+      if (d[i * n + i] < 0)
+        return;
+    }
+    auto sources = [&](size_t lo, size_t hi) {
+      std::vector<size_t> queue;
+      std::vector<char> reached(n);
+      for (size_t i = lo; i < hi; i++) {
+        const int *row = d + i * n;
+        int *pred_row = pred + i * n;
+        std::fill(reached.begin(), reached.end(), 0);
+        queue.assign(1, i);
+        reached[i] = 1;
+        for (size_t head = 0; head < queue.size(); head++) {
+          size_t u = queue[head];
+          graph.for_each_out_edge(u, [&](int v, int weight) {
+            if (!reached[v] && static_cast<long long>(row[u]) + weight == row[v]) {
+              reached[v] = 1;
+              pred_row[v] = static_cast<int>(u);
+              queue.push_back(static_cast<size_t>(v));
+            }
+          });
+        }
+      }
+    };
+    if (scheduler)
+      scheduler->parallel_for(0, n, kTile, sources);
+    else
+      sources(0, n);
+  }
+
+private:
+  // run() 保存的直接边矩阵，按图概念提供出边
+  struct DenseEdges {
+    std::vector<int> weights;
+    size_t n;
+
+    template <typename Visitor>
+    void for_each_out_edge(size_t u, Visitor visit) const {
+      for (size_t v = 0; v < n; v++) {
+        if (v != u && weights[u * n + v] != kInfinity)
+          visit(static_cast<int>(v), weights[u * n + v]);
+      }
+    }
+  };
+
+  static void relax_all(int *distances, size_t n,
+                        WorkStealingScheduler *scheduler) {
+    if (n == 0)
+      return;
+    size_t tiles = (n + kTile - 1) / kTile;
+    for (size_t K = 0; K < tiles; K++) {
+      update_tile(distances, n, K, K, K);
+      MinPlusKernel::for_each_tile(scheduler, 2 * (tiles - 1), [&](size_t t) {
+        size_t other = t % (tiles - 1);
+        other += other >= K;
+        if (t < tiles - 1)
+          update_tile(distances, n, K, other, K);
+        else
+          update_tile(distances, n, other, K, K);
+      });
+      MinPlusKernel::for_each_tile(
+          scheduler, (tiles - 1) * (tiles - 1), [&](size_t t) {
+            size_t I = t / (tiles - 1), J = t % (tiles - 1);
+            I += I >= K;
+            J += J >= K;
+            update_tile(distances, n, I, J, K);
+          });
+    }
+  }
+
+  // 以块 K 内的 k 为中间点更新块 (I, J)
+  static void update_tile(int *d, size_t n, size_t I, size_t J, size_t K) {
+    size_t i0 = I * kTile, i1 = std::min(n, i0 + kTile);
+    size_t j0 = J * kTile, j1 = std::min(n, j0 + kTile);
+    size_t k0 = K * kTile, k1 = std::min(n, k0 + kTile);
+    size_t width = j1 - j0;
+    if (I != K && J != K) {
+      for (size_t i = i0; i < i1; i++)
+        MinPlusKernel::relax_rows(d + i * n + k0, d + k0 * n + j0, nullptr, n,
+                                  k1 - k0, d + i * n + j0, nullptr, width);
+      return;
+    }
+    for (size_t k = k0; k < k1; k++) {
+      for (size_t i = i0; i < i1; i++)
+        MinPlusKernel::relax_row(d[i * n + k], d + k * n + j0, nullptr,
+                                 d + i * n + j0, nullptr, width);
+    }
+  }
+};
+
+/**
+ * @brief 重复平方法（算法导论25.1节 FASTER-ALL-PAIRS-SHORTEST-PATHS）
+ *
+ * L(1) 为直接边矩阵，L(2m) = L(m) ⊗ L(m)；对角线为0，所以 L(2m) 覆盖
+ * 至多 2m 条边的所有路径。⌈lg n⌉ 次平方后 m ≥ n，长度不超过 n 的负权环
+ * 都会使对角线变负。每次平方是一次 MinPlusKernel::product，与分块
+ * Floyd-Warshall 共用分块与寄存器分块内核，传入调度器时输出块并行。
+ * 某次平方后矩阵不再变化即已是最短路径，提前结束。两个 n × n 缓冲区
+ * 交替使用，循环中不再分配内存。
+ *
+ * 每次平方都是规整的稠密 min-plus 乘法，不像Floyd-Warshall那样在轮与
+ * 轮之间有依赖，代价是多出 lg n 倍的运算量。
+ */
+template <typename Graph>
+DenseAllPairsResult MatrixMultiplicationShortestPath::repeated_squaring(
+    const Graph &graph, bool track_predecessors,
+    WorkStealingScheduler *scheduler) {
+  DenseAllPairsResult result =
+      DenseAllPairsResult::from_graph(graph, track_predecessors);
+  size_t n = result.n;
+  std::vector<int> next, next_predecessors;
+  for (size_t m = 1; m < n; m *= 2) {
+    // 从 L(m) 出发求 min(L(m), L(m) ⊗ L(m))，因对角线为0等于 L(2m)
+    next = result.distances;
+    if (track_predecessors)
+      next_predecessors = result.predecessors;
+    MinPlusKernel::product(
+        result.distances.data(), result.distances.data(),
+        track_predecessors ? result.predecessors.data() : nullptr, next.data(),
+        track_predecessors ? next_predecessors.data() : nullptr, n,
+        scheduler);
+    bool changed = next != result.distances;
+    result.distances.swap(next);
+    if (track_predecessors)
+      result.predecessors.swap(next_predecessors);
+    if (!changed)
+      break;
+  }
+  result.detect_negative_cycle();
+  return result;
+}
+
+inline AllPairsShortestPathResult
+MatrixMultiplicationShortestPath::faster_all_pairs_shortest_path(
+    const AdjacencyListGraph &graph) {
+  return repeated_squaring(graph).to_result();
+}
+
+inline AllPairsShortestPathResult
+MatrixMultiplicationShortestPath::faster_all_pairs_shortest_path(
+    const AdjacencyListGraph &graph, WorkStealingScheduler &scheduler) {
+  return repeated_squaring(graph, true, &scheduler).to_result();
+}
+
 // 25.2 Floyd-Warshall算法
 class FloydWarshall {
 public:
+  /**
+   * @brief 分块Floyd-Warshall（见 BlockedFloydWarshall），O(n³)
+   */
   static AllPairsShortestPathResult
   find_all_pairs_shortest_path(const AdjacencyListGraph &graph) {
+    return BlockedFloydWarshall::solve(graph).to_result();
+  }
+
+  /**
+   * @brief 并行版本：每轮的行列块与其余块由调度器并行更新
+   */
+  static AllPairsShortestPathResult
+  find_all_pairs_shortest_path(const AdjacencyListGraph &graph,
+                               WorkStealingScheduler &scheduler) {
+    return BlockedFloydWarshall::solve(graph, true, &scheduler).to_result();
+  }
+
+  /**
+   * @brief 教科书三重循环（算法导论25.2节），用于对照验证
+   */
+  static AllPairsShortestPathResult
+  textbook_all_pairs_shortest_path(const AdjacencyListGraph &graph) {
     int n = graph.get_node_count();
     AllPairsShortestPathResult result(n);
 
@@ -198,74 +788,156 @@ public:
 };
 
 // 25.3 Johnson算法（用于稀疏图）
+// Graph 需满足 graph_representation.h 中的图概念，结果按节点下标
+//
+// 用Bellman-Ford求一次势函数 h 并重新赋权后，V 次Dijkstra互相独立。
+// for_each_source 按源点流式输出结果行，调用者只需 O(V) 的行缓冲区即可
+// 处理 n × n 结果放不进内存的大稀疏图；带调度器的版本把源点分块交给
+// 工作窃取线程池，每块复用自己的队列与距离数组。
 class Johnson {
 public:
+  // sink(source, distances, predecessors)：每个源点调用一次，distances 为
+  // 原图权重下的距离（不可达为 int 最大值），两个数组在 sink 返回后会被复用。
+  // 返回 false 表示存在负权环，此时不调用 sink。
+  template <typename Queue = BinaryHeapDijkstraQueue, typename Graph,
+            typename Sink>
+  static bool for_each_source(const Graph &graph, Sink &&sink) {
+    Reweighted reweighted;
+    if (!reweight(graph, reweighted)) {
+      return false;
+    }
+    run_sources<Queue>(reweighted, 0, reweighted.h.size(), sink);
+    return true;
+  }
+
+  // 并行版本：不同源点的 sink 可能在不同工作线程上并发调用，
+  // 调用者只需保证写入不同行是线程安全的
+  template <typename Queue = BinaryHeapDijkstraQueue, typename Graph,
+            typename Sink>
+  static bool for_each_source(const Graph &graph,
+                              WorkStealingScheduler &scheduler, Sink &&sink) {
+    Reweighted reweighted;
+    if (!reweight(graph, reweighted)) {
+      return false;
+    }
+    size_t n = reweighted.h.size();
+    size_t chunks = std::min(n, 4 * scheduler.get_num_threads());
+    scheduler.parallel_for(0, chunks, 1, [&](size_t lo, size_t hi) {
+      for (size_t c = lo; c < hi; c++) {
+        run_sources<Queue>(reweighted, n * c / chunks, n * (c + 1) / chunks,
+                           sink);
+      }
+    });
+    return true;
+  }
+
+  template <typename Graph>
   static AllPairsShortestPathResult
-  find_all_pairs_shortest_path(const AdjacencyListGraph &graph) {
-    int n = graph.get_node_count();
-    AllPairsShortestPathResult result(n);
+  find_all_pairs_shortest_path(const Graph &graph) {
+    AllPairsShortestPathResult result(graph.get_node_count());
+    result.has_negative_cycle = !for_each_source(graph, row_writer(result));
+    return result;
+  }
+
+  template <typename Graph>
+  static AllPairsShortestPathResult
+  find_all_pairs_shortest_path(const Graph &graph,
+                               WorkStealingScheduler &scheduler) {
+    AllPairsShortestPathResult result(graph.get_node_count());
+    result.has_negative_cycle =
+        !for_each_source(graph, scheduler, row_writer(result));
+    return result;
+  }
+
+private:
+  struct Reweighted {
+    CSRGraph graph{true}; // 权重 w(u, v) + h(u) - h(v) ≥ 0
+    std::vector<int> h;   // 势函数
+    int max_weight = 0;
+  };
+
+  // 每个源点写入结果矩阵中自己的一行，并行时互不冲突
+  static auto row_writer(AllPairsShortestPathResult &result) {
+    return [&result](int source, const std::vector<int> &distances,
+                     const std::vector<int> &predecessors) {
+      result.distances[source] = distances;
+      result.predecessors[source] = predecessors;
+    };
+  }
 
+  // 步骤1~3：添加源点s求势函数，并构建重新赋权后的图；存在负权环时返回false
+  template <typename Graph>
+  static bool reweight(const Graph &graph, Reweighted &out) {
+    int n = graph.get_node_count();
     if (n == 0) {
-      return result;
+      return true;
     }
 
     // 步骤1：添加新节点s，连接到所有其他节点（权重为0）
-    AdjacencyListGraph extended_graph = graph;
-    int s = n; // 新节点编号
-    extended_graph.add_node(s);
-
+    int s = n; // 新节点下标
+    CSRGraphBuilder extended_builder(true);
+    for (int i = 0; i <= n; i++) {
+      extended_builder.add_node(i);
+    }
+    for (int u = 0; u < n; u++) {
+      graph.for_each_out_edge(u, [&](int v, int weight) {
+        extended_builder.add_edge(u, v, weight);
+      });
+    }
     for (int i = 0; i < n; i++) {
-      try {
-        extended_graph.add_edge(s, i, 0);
-      } catch (const std::invalid_argument &e) {
-        // 边已存在，忽略
-      }
+      extended_builder.add_edge(s, i, 0);
     }
+    CSRGraph extended_graph = extended_builder.build();
 
     // 步骤2：使用Bellman-Ford算法计算从s到所有节点的最短路径
     auto bellman_result = BellmanFord::find_shortest_path(extended_graph, s);
-
     if (bellman_result.has_negative_cycle) {
-      result.has_negative_cycle = true;
-      return result;
+      return false;
     }
 
     // 步骤3：重新权重边，消除负权边
-    std::vector<int> h(n + 1); // 势函数
-    for (int i = 0; i <= n; i++) {
-      h[i] = bellman_result.distances[i];
-    }
-
-    // 创建重新权重后的图
-    AdjacencyListGraph reweighted_graph(true);
+    out.h.assign(bellman_result.distances.begin(),
+                 bellman_result.distances.begin() + n);
+    CSRGraphBuilder reweighted_builder(true);
     for (int i = 0; i < n; i++) {
-      reweighted_graph.add_node(i);
+      reweighted_builder.add_node(i);
     }
-
-    auto edges = graph.get_all_edges();
-    for (const auto &edge : edges) {
-      int new_weight = edge.weight + h[edge.from] - h[edge.to];
-      try {
-        reweighted_graph.add_edge(edge.from, edge.to, new_weight);
-      } catch (const std::invalid_argument &e) {
-        // 边已存在，忽略
-      }
+    for (int u = 0; u < n; u++) {
+      graph.for_each_out_edge(u, [&](int v, int weight) {
+        reweighted_builder.add_edge(u, v, weight + out.h[u] - out.h[v]);
+      });
     }
+    out.graph = reweighted_builder.build();
+    out.max_weight = Dijkstra::max_weight(out.graph);
+    return true;
+  }
 
-    // 步骤4：对每个节点运行Dijkstra算法
-    for (int i = 0; i < n; i++) {
-      auto dijkstra_result = Dijkstra::find_shortest_path(reweighted_graph, i);
+  // 步骤4：对 [begin, end) 中的每个源点运行Dijkstra，队列与数组在源点间复用
+  template <typename Queue, typename Sink>
+  static void run_sources(const Reweighted &reweighted, size_t begin,
+                          size_t end, Sink &sink) {
+    constexpr int kInfinity = std::numeric_limits<int>::max();
+    int n = reweighted.h.size();
+    const std::vector<int> &h = reweighted.h;
+    Queue queue(n, reweighted.max_weight);
+    std::vector<int> distances(n, kInfinity);
+    std::vector<int> predecessors(n, -1);
+
+    for (size_t source = begin; source < end; source++) {
+      int i = static_cast<int>(source);
+      Dijkstra::run(reweighted.graph, i, queue, distances, predecessors);
 
       // 恢复原始距离
       for (int j = 0; j < n; j++) {
-        if (dijkstra_result.distances[j] != std::numeric_limits<int>::max()) {
-          result.distances[i][j] = dijkstra_result.distances[j] + h[j] - h[i];
-          result.predecessors[i][j] = dijkstra_result.predecessors[j];
+        if (distances[j] != kInfinity) {
+          distances[j] += h[j] - h[i];
         }
       }
-    }
+      sink(i, distances, predecessors);
 
-    return result;
+      std::fill(distances.begin(), distances.end(), kInfinity);
+      std::fill(predecessors.begin(), predecessors.end(), -1);
+    }
   }
 };
 
@@ -1,7 +1,9 @@
 #ifndef AMORTIZED_ANALYSIS_H
 #define AMORTIZED_ANALYSIS_H
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <iostream>
 #include <stdexcept>
 #include <string>
@@ -181,10 +183,98 @@ public:
   int size() const { return top_index + 1; }
 };
 
+/**
+ * @brief 动态表的扩张与收缩策略 - 17.4节
+ *
+ * 装载因子 α = num / size。插入使 α 超过 expand_load 时先把容量乘以
+ * growth_factor；装载因子降到 contract_load 及以下时把容量除以 growth_factor。
+ * 要求 contract_load · growth_factor < expand_load：刚扩张或刚收缩的表离
+ * 两个阈值都有 Θ(size) 次操作的距离，因此每次操作的摊还代价为O(1)。
+ * 默认值即17.4.2节的方案：表满时加倍，装载因子降到1/4时减半。
+ */
+struct DynamicTablePolicy {
+  double growth_factor = 2.0;
+  double expand_load = 1.0;
+  double contract_load = 0.25;
+
+  /**
+   * @brief 检查参数
+   * @throws std::invalid_argument 如果参数会导致表反复扩张收缩
+   */
+  void validate() const {
+    if (!(growth_factor > 1.0)) {
+      throw std::invalid_argument("扩张倍数必须大于1");
+    }
+    if (!(expand_load > 0.0 && expand_load <= 1.0)) {
+      throw std::invalid_argument("扩张装载因子必须在(0, 1]之间");
+    }
+    if (!(contract_load >= 0.0 &&
+          contract_load * growth_factor < expand_load)) {
+      throw std::invalid_argument(
+          "收缩装载因子乘以扩张倍数必须小于扩张装载因子");
+    }
+  }
+
+  /**
+   * @brief 再插入一个元素后装载因子是否超过 expand_load
+   */
+  bool should_expand(size_t num, size_t size) const {
+    return static_cast<double>(num + 1) >
+           static_cast<double>(size) * expand_load;
+  }
+
+  /**
+   * @brief 装载因子是否已降到 contract_load 及以下
+   */
+  bool should_contract(size_t num, size_t size) const {
+    return size > 1 &&
+           static_cast<double>(num) <= static_cast<double>(size) * contract_load;
+  }
+
+  /**
+   * @brief 扩张后的容量，至少比原容量大1
+   */
+  size_t expanded_size(size_t size) const {
+    size_t grown =
+        static_cast<size_t>(std::ceil(static_cast<double>(size) * growth_factor));
+    return std::max(grown, size + 1);
+  }
+
+  /**
+   * @brief 收缩后的容量，至少为1
+   */
+  size_t contracted_size(size_t size) const {
+    size_t shrunk = static_cast<size_t>(static_cast<double>(size) / growth_factor);
+    return std::max<size_t>(shrunk, 1);
+  }
+
+  /**
+   * @brief 推广17.4.2节的势能函数
+   *
+   * Φ = K_up·max(0, num − β_up·size) + K_down·max(0, β_down·size − num)，其中
+   * β_up = max(e/g, c·g)，β_down = min(c·g, e/g)（e、c、g 依次为扩张装载因子、
+   * 收缩装载因子和扩张倍数），K_up = e/(e − β_up)，K_down = c/(β_down − c)。
+   * 刚调整完的表 Φ = 0，调整前积累的势能足以支付搬移全部元素的代价，
+   * 每次操作的摊还代价不超过 1 + max(K_up, K_down)。默认参数下即
+   * α ≥ 1/2 时的 2·num − size 与 α < 1/2 时的 size/2 − num。
+   */
+  double potential(size_t num, size_t size) const {
+    double n = static_cast<double>(num), s = static_cast<double>(size);
+    double e = expand_load, c = contract_load, g = growth_factor;
+    double beta_up = std::max(e / g, c * g);
+    double beta_down = std::min(c * g, e / g);
+    double k_up = e / (e - beta_up);
+    double k_down = c > 0 ? c / (beta_down - c) : 0.0;
+    return k_up * std::max(0.0, n - beta_up * s) +
+           k_down * std::max(0.0, beta_down * s - n);
+  }
+};
+
 /**
  * @brief 动态表 - 17.4节动态表扩张和收缩
  *
- * 实现动态表，支持自动扩张和收缩，使用势能方法分析摊还代价
+ * 实现动态表，支持自动扩张和收缩，使用势能方法分析摊还代价；
+ * 扩张与收缩的时机和倍数由 DynamicTablePolicy 决定
  */
 class DynamicTable {
 private:
@@ -193,12 +283,12 @@ private:
   int size;           // 表的容量
   int expansion_cost; // 扩张操作的总代价
   int insertion_cost; // 插入操作的总代价
+  DynamicTablePolicy policy;
 
   /**
-   * @brief 扩张表
+   * @brief 把表的容量调整为new_size，代价为当前元素数量
    */
-  void expand_table() {
-    int new_size = size * 2;
+  void resize_table(int new_size) {
     std::vector<int> new_table(new_size);
 
     // 复制元素到新表
@@ -208,33 +298,37 @@ private:
 
     table = std::move(new_table);
     size = new_size;
-    expansion_cost += num; // 扩张代价为当前元素数量
+    expansion_cost += num;
+  }
+
+  /**
+   * @brief 扩张表
+   */
+  void expand_table() {
+    resize_table(static_cast<int>(policy.expanded_size(size)));
   }
 
   /**
    * @brief 收缩表
    */
   void contract_table() {
-    int new_size = size / 2;
-    std::vector<int> new_table(new_size);
-
-    // 复制元素到新表
-    for (int i = 0; i < num; ++i) {
-      new_table[i] = table[i];
-    }
-
-    table = std::move(new_table);
-    size = new_size;
-    expansion_cost += num; // 收缩代价为当前元素数量
+    resize_table(static_cast<int>(policy.contracted_size(size)));
   }
 
 public:
   /**
    * @brief 构造函数
    * @param initial_size 初始表大小
+   * @param policy 扩张与收缩策略
+   * @throws std::invalid_argument 如果初始大小不为正或策略参数不合法
    */
-  DynamicTable(int initial_size = 1)
-      : num(0), size(initial_size), expansion_cost(0), insertion_cost(0) {
+  DynamicTable(int initial_size = 1, DynamicTablePolicy policy = {})
+      : num(0), size(initial_size), expansion_cost(0), insertion_cost(0),
+        policy(policy) {
+    if (initial_size < 1) {
+      throw std::invalid_argument("初始表大小必须为正");
+    }
+    policy.validate();
     table.resize(size);
   }
 
@@ -246,7 +340,7 @@ public:
   int insert(int x) {
     int actual_cost = 1; // 基本插入代价
 
-    if (num == size) {
+    if (policy.should_expand(num, size)) {
       expand_table();
       actual_cost += num; // 加上扩张代价
     }
@@ -267,7 +361,7 @@ public:
 
     int actual_cost = 1; // 基本删除代价
 
-    if (num <= size / 4 && size > 1) {
+    if (policy.should_contract(num, size)) {
       contract_table();
       actual_cost += num; // 加上收缩代价
     }
@@ -306,6 +400,11 @@ public:
    */
   int get_potential() const { return 2 * num - size; }
 
+  /**
+   * @brief 获取扩张与收缩策略
+   */
+  const DynamicTablePolicy &get_policy() const { return policy; }
+
   /**
    * @brief 重置表
    */
@@ -1,12 +1,15 @@
 #ifndef APPROXIMATION_ALGORITHMS_H
 #define APPROXIMATION_ALGORITHMS_H
 
+#include "bit_matrix_graph.h"
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <functional>
 #include <iostream>
 #include <limits>
 #include <queue>
+#include <stdexcept>
 #include <unordered_set>
 #include <vector>
 
@@ -44,6 +47,19 @@ public:
 
   int get_vertex_count() const { return vertex_count; }
 
+  // 转换为位矩阵表示（丢弃权重，重复的边只保留一条，忽略自环）
+  BitMatrixGraph to_bit_matrix() const {
+    BitMatrixGraph result(vertex_count);
+    for (int u = 0; u < vertex_count; u++) {
+      for (int v : adjacency_list[u]) {
+        if (u < v && !result.has_edge(u, v)) {
+          result.add_edge(u, v);
+        }
+      }
+    }
+    return result;
+  }
+
   void print() const {
     std::cout << "图结构:" << std::endl;
     for (int i = 0; i < vertex_count; i++) {
@@ -90,6 +106,45 @@ public:
     return cover;
   }
 
+  /**
+   * @brief 顶点覆盖问题的2-近似算法（位矩阵版本）
+   *
+   * 未访问顶点集合保存为位集，u 的行与它做与运算后取最低位
+   * 即得到 u 的编号最小的未访问邻居，不需要逐个检查邻居。
+   * 邻接表版本取的是表中第一个未访问邻居，因此只有当每个顶点的
+   * 邻接表按编号升序排列时，两者结果才一致。
+   */
+  static std::unordered_set<int>
+  vertex_cover_2_approx(const BitMatrixGraph &graph) {
+    std::unordered_set<int> cover;
+    size_t n = graph.get_node_count();
+    size_t words = graph.get_words_per_row();
+    std::vector<std::uint64_t> unvisited(words, ~std::uint64_t(0));
+    auto visit = [&](size_t v) {
+      unvisited[v / 64] &= ~(std::uint64_t(1) << (v % 64));
+    };
+
+    for (size_t u = 0; u < n; u++) {
+      if (!((unvisited[u / 64] >> (u % 64)) & 1))
+        continue;
+
+      const std::uint64_t *row = graph.row(u);
+      for (size_t w = 0; w < words; w++) {
+        std::uint64_t candidates = row[w] & unvisited[w];
+        if (candidates != 0) {
+          size_t v = w * 64 + __builtin_ctzll(candidates);
+          cover.insert(static_cast<int>(u));
+          cover.insert(static_cast<int>(v));
+          visit(u);
+          visit(v);
+          break;
+        }
+      }
+    }
+
+    return cover;
+  }
+
   /**
    * @brief 旅行商问题的2-近似算法（基于MST）
    * @param graph 完全图（邻接矩阵）
@@ -113,6 +168,63 @@ public:
     return tour;
   }
 
+  /**
+   * @brief 旅行商路线的局部搜索改进（2-opt 与 Or-opt），要求距离对称
+   *
+   * 路线保存为城市数组和每个城市的位置。每个城市只考虑距离最近的
+   * neighbor_count 个候选城市：2-opt 删去 (a, a的后继) 与 (c, c的后继)、
+   * 连上 (a, c) 与两个后继（前驱方向同理），新边 (a, c) 必须比被删的边短，
+   * 所以按距离升序扫描候选并提前结束；Or-opt 把从 a 开始的1–3个城市
+   * 整段移到候选城市旁边，可以反向插入。
+   * 不看位（don't-look bits）：城市在一次检查中没有找到改进后不再检查，
+   * 直到与它相连的边被某次移动改变才重新入队。
+   *
+   * @param tour 闭合路线（首尾相同，长度 n + 1），通常来自 tsp_2_approx
+   * @return 局部最优的闭合路线，仍从 tour[0] 出发
+   * @throws std::invalid_argument 如果矩阵不是对称方阵或路线不是哈密顿回路
+   */
+  static std::vector<int>
+  tsp_local_search(const std::vector<std::vector<int>> &distance,
+                   const std::vector<int> &tour, size_t neighbor_count = 8) {
+    size_t n = distance.size();
+    for (size_t i = 0; i < n; i++) {
+      if (distance[i].size() != n) {
+        throw std::invalid_argument("距离矩阵必须是方阵");
+      }
+      for (size_t j = 0; j < i; j++) {
+        if (distance[i][j] != distance[j][i]) {
+          throw std::invalid_argument("局部搜索要求距离对称");
+        }
+      }
+    }
+    std::vector<bool> seen(n, false);
+    bool valid = tour.size() == n + 1 && tour.front() == tour.back();
+    for (size_t i = 0; valid && i < n; i++) {
+      valid = tour[i] >= 0 && static_cast<size_t>(tour[i]) < n && !seen[tour[i]];
+      if (valid) {
+        seen[tour[i]] = true;
+      }
+    }
+    if (!valid) {
+      throw std::invalid_argument("路线必须恰好经过每个城市一次并回到起点");
+    }
+    if (n < 4) {
+      return tour; // 3个及以下城市只有一条路线（不计方向）
+    }
+
+    LocalSearchTour search(distance, tour, neighbor_count);
+    search.optimize();
+    return search.closed_tour(tour.front());
+  }
+
+  /**
+   * @brief MST 2-近似路线再做局部搜索
+   */
+  static std::vector<int>
+  tsp_2_approx_local_search(const std::vector<std::vector<int>> &graph) {
+    return tsp_local_search(graph, tsp_2_approx(graph));
+  }
+
   /**
    * @brief 集合覆盖问题的近似算法（贪心算法）
    * @param universe 全集
@@ -165,6 +277,98 @@ public:
     return cover;
   }
 
+  /**
+   * @brief 集合覆盖的惰性贪心算法，选出的子集与 set_cover_greedy 相同
+   *
+   * 元素编号为 0..universe_size-1。子集的收益（覆盖的未覆盖元素数）只会
+   * 随着选择而减少，所以堆中的旧收益是上界：弹出堆顶后重算它的收益，
+   * 若仍不小于新堆顶的旧收益（相等时比较下标）就选中，否则以新收益放回。
+   * 多数子集的收益从不需要重算，每次选择不再扫描全部子集。
+   * 未覆盖元素保存为位集；元素数不少于全集 1/32 的子集也存为位集，
+   * 收益为按字与运算后的 popcount，其余子集逐个测试元素对应的位。
+   * 不属于任何子集的元素保持未覆盖，与 set_cover_greedy 一样。
+   *
+   * @return 选中子集的下标，按选择顺序
+   * @throws std::out_of_range 如果子集含有全集以外的元素
+   */
+  static std::vector<int>
+  set_cover_lazy_greedy(size_t universe_size,
+                        const std::vector<std::vector<int>> &subsets) {
+    size_t words = (universe_size + 63) / 64;
+    std::vector<std::uint64_t> uncovered(words, ~std::uint64_t(0));
+    if (universe_size % 64) {
+      uncovered.back() = (std::uint64_t(1) << (universe_size % 64)) - 1;
+    }
+
+    // 稀疏子集：去重后的元素表；稠密子集：dense 中的一段位集
+    std::vector<std::vector<int>> elements(subsets.size());
+    std::vector<std::uint64_t> dense;
+    std::vector<size_t> dense_offset(subsets.size(), SIZE_MAX);
+    using Entry = std::pair<size_t, int>; // (收益, -下标)：收益相同时下标小的优先
+    std::vector<Entry> heap;
+    std::vector<std::uint64_t> seen(words, 0);
+    for (size_t i = 0; i < subsets.size(); i++) {
+      // 借助 seen 位集去重，O(|子集|)
+      std::vector<int> list;
+      list.reserve(subsets[i].size());
+      for (int e : subsets[i]) {
+        if (e < 0 || static_cast<size_t>(e) >= universe_size) {
+          throw std::out_of_range("子集元素超出全集范围");
+        }
+        std::uint64_t bit = std::uint64_t(1) << (e % 64);
+        if (!(seen[e / 64] & bit)) {
+          seen[e / 64] |= bit;
+          list.push_back(e);
+        }
+      }
+      for (int e : list) {
+        seen[e / 64] = 0;
+      }
+      heap.emplace_back(list.size(), -static_cast<int>(i));
+      if (list.size() * 32 >= universe_size && words > 0) {
+        dense_offset[i] = dense.size();
+        dense.resize(dense.size() + words, 0);
+        for (int e : list) {
+          dense[dense_offset[i] + e / 64] |= std::uint64_t(1) << (e % 64);
+        }
+      } else {
+        elements[i] = std::move(list);
+      }
+    }
+    std::make_heap(heap.begin(), heap.end());
+
+    std::vector<int> cover;
+    size_t remaining = universe_size;
+    while (remaining > 0 && !heap.empty()) {
+      std::pop_heap(heap.begin(), heap.end());
+      Entry top = heap.back();
+      heap.pop_back();
+      size_t i = static_cast<size_t>(-top.second);
+      Entry fresh(uncovered_gain(i, elements, dense, dense_offset, uncovered),
+                  top.second);
+      if (!heap.empty() && fresh < heap.front()) {
+        heap.push_back(fresh);
+        std::push_heap(heap.begin(), heap.end());
+        continue;
+      }
+      if (fresh.first == 0) {
+        break; // 剩余元素都无法覆盖
+      }
+      cover.push_back(static_cast<int>(i));
+      remaining -= fresh.first;
+      if (dense_offset[i] != SIZE_MAX) {
+        for (size_t w = 0; w < words; w++) {
+          uncovered[w] &= ~dense[dense_offset[i] + w];
+        }
+      } else {
+        for (int e : elements[i]) {
+          uncovered[e / 64] &= ~(std::uint64_t(1) << (e % 64));
+        }
+      }
+    }
+    return cover;
+  }
+
   /**
    * @brief 背包问题的近似算法（贪心算法）
    * @param weights 物品重量
@@ -243,6 +447,53 @@ public:
     return {set_a, set_b};
   }
 
+  /**
+   * @brief 最大割问题的2-近似算法（位矩阵版本，所有边权为1）
+   *
+   * 与邻接表版本使用相同的初始划分和扫描顺序。集合A保存为位集，
+   * 顶点 v 的移动增益为 |N(v) ∩ 同侧| − |N(v) ∩ 对侧|
+   * = 2·popcount(row(v) & 同侧) − deg(v)，每次 O(n / 64)。
+   */
+  static std::pair<std::unordered_set<int>, std::unordered_set<int>>
+  max_cut_2_approx(const BitMatrixGraph &graph) {
+    size_t n = graph.get_node_count();
+    size_t words = graph.get_words_per_row();
+    std::vector<std::uint64_t> in_a(words, 0), in_b(words, 0);
+    for (size_t i = 0; i < n; i++) {
+      std::uint64_t bit = std::uint64_t(1) << (i % 64);
+      (i % 2 == 0 ? in_a : in_b)[i / 64] |= bit;
+    }
+    std::vector<size_t> degree(n);
+    for (size_t v = 0; v < n; v++) {
+      degree[v] = graph.get_degree(static_cast<int>(v));
+    }
+
+    bool improved = true;
+    while (improved) {
+      improved = false;
+
+      for (size_t v = 0; v < n; v++) {
+        std::uint64_t bit = std::uint64_t(1) << (v % 64);
+        bool on_a = in_a[v / 64] & bit;
+        const auto &same_side = on_a ? in_a : in_b;
+        long long same = static_cast<long long>(BitMatrixGraph::and_popcount(
+            graph.row(v), same_side.data(), words));
+        if (2 * same - static_cast<long long>(degree[v]) > 0) {
+          in_a[v / 64] ^= bit;
+          in_b[v / 64] ^= bit;
+          improved = true;
+        }
+      }
+    }
+
+    std::unordered_set<int> set_a, set_b;
+    for (size_t v = 0; v < n; v++) {
+      ((in_a[v / 64] >> (v % 64)) & 1 ? set_a : set_b)
+          .insert(static_cast<int>(v));
+    }
+    return {set_a, set_b};
+  }
+
   /**
    * @brief 设施选址问题的近似算法
    * @param facilities 设施位置和开设成本
@@ -331,6 +582,225 @@ public:
   }
 
 private:
+  // 子集 i 中仍未覆盖的元素数；稀疏子集顺便删去已覆盖的元素，
+  // 之后重算只扫描剩下的部分
+  static size_t
+  uncovered_gain(size_t i, std::vector<std::vector<int>> &elements,
+                      const std::vector<std::uint64_t> &dense,
+                      const std::vector<size_t> &dense_offset,
+                      const std::vector<std::uint64_t> &uncovered) {
+    if (dense_offset[i] != SIZE_MAX) {
+      return BitMatrixGraph::and_popcount(dense.data() + dense_offset[i],
+                                          uncovered.data(), uncovered.size());
+    }
+    std::vector<int> &list = elements[i];
+    size_t gain = 0;
+    for (int e : list) {
+      list[gain] = e;
+      gain += (uncovered[e / 64] >> (e % 64)) & 1;
+    }
+    list.resize(gain);
+    return gain;
+  }
+
+  /**
+   * @brief tsp_local_search 使用的数组表示路线
+   */
+  class LocalSearchTour {
+  public:
+    LocalSearchTour(const std::vector<std::vector<int>> &distance,
+                    const std::vector<int> &tour, size_t neighbor_count)
+        : d(distance), n(distance.size()), order(tour.begin(), tour.end() - 1),
+          pos(n), neighbors(n), queued(n, false) {
+      for (size_t i = 0; i < n; i++) {
+        pos[order[i]] = i;
+      }
+      // 每个城市的候选：距离最近的 k 个其他城市，按距离升序
+      size_t k = std::min(neighbor_count, n - 1);
+      std::vector<int> others;
+      for (size_t a = 0; a < n; a++) {
+        others.clear();
+        for (size_t c = 0; c < n; c++) {
+          if (c != a) {
+            others.push_back(static_cast<int>(c));
+          }
+        }
+        auto closer = [&](int x, int y) { return d[a][x] < d[a][y]; };
+        std::partial_sort(others.begin(), others.begin() + k, others.end(), closer);
+        neighbors[a].assign(others.begin(), others.begin() + k);
+      }
+    }
+
+    void optimize() {
+      for (size_t i = 0; i < n; i++) {
+        activate(order[i]);
+      }
+      while (!active.empty()) {
+        int a = active.front();
+        active.pop();
+        queued[a] = false;
+        if (try_two_opt(a) || try_or_opt(a)) {
+          activate(a); // 同一个城市可能还有改进
+        }
+      }
+    }
+
+    std::vector<int> closed_tour(int start) const {
+      std::vector<int> tour;
+      for (size_t i = 0; i < n; i++) {
+        tour.push_back(order[(pos[start] + i) % n]);
+      }
+      tour.push_back(start);
+      return tour;
+    }
+
+  private:
+    const std::vector<std::vector<int>> &d;
+    size_t n;
+    std::vector<int> order;  // 第 i 个访问的城市
+    std::vector<size_t> pos; // 城市在 order 中的位置
+    std::vector<std::vector<int>> neighbors;
+    std::queue<int> active; // 不看位为0的城市
+    std::vector<bool> queued;
+
+    int succ(int a) const { return order[(pos[a] + 1) % n]; }
+    int pred(int a) const { return order[(pos[a] + n - 1) % n]; }
+
+    void activate(int a) {
+      if (!queued[a]) {
+        queued[a] = true;
+        active.push(a);
+      }
+    }
+
+    // 反转从 from 沿正向走到 to 的一段；若它比补段长则反转补段，
+    // 两者得到同一个环（只是整体方向相反）
+    void reverse_path(int from, int to) {
+      size_t i = pos[from], j = pos[to];
+      size_t len = (j + n - i) % n + 1;
+      if (2 * len > n) {
+        i = (pos[to] + 1) % n;
+        j = (pos[from] + n - 1) % n;
+        len = n - len;
+      }
+      for (size_t t = 0; t < len / 2; t++) {
+        std::swap(order[i], order[j]);
+        pos[order[i]] = i;
+        pos[order[j]] = j;
+        i = (i + 1) % n;
+        j = (j + n - 1) % n;
+      }
+    }
+
+    bool try_two_opt(int a) {
+      for (bool forward : {true, false}) {
+        int b = forward ? succ(a) : pred(a);
+        long long removed_ab = d[a][b];
+        for (int c : neighbors[a]) {
+          long long gain = removed_ab - d[a][c];
+          if (gain <= 0) {
+            break;
+          }
+          int e = forward ? succ(c) : pred(c);
+          if (c == b || e == a) {
+            continue;
+          }
+          if (gain + d[c][e] - d[b][e] > 0) {
+            // 正向：a b … c e → a c … b e；反向：e c … b a → e b … c a
+            if (forward) {
+              reverse_path(b, c);
+            } else {
+              reverse_path(c, b);
+            }
+            for (int x : {a, b, c, e}) {
+              activate(x);
+            }
+            return true;
+          }
+        }
+      }
+      return false;
+    }
+
+    bool try_or_opt(int a) {
+      for (size_t length = 1; length <= 3 && length + 3 <= n; length++) {
+        int first = a, last = order[(pos[a] + length - 1) % n];
+        int p = pred(first), q = succ(last);
+        long long removed = static_cast<long long>(d[p][first]) + d[last][q] - d[p][q];
+        if (removed <= 0) {
+          continue;
+        }
+        for (int c : neighbors[first]) {
+          if (d[first][c] >= removed) {
+            break;
+          }
+          if ((pos[c] + n - pos[first]) % n < length) {
+            continue; // c 在段内
+          }
+          // 插到 c 与其后继之间（c first … last y），或其前驱与 c 之间（x last … first c）
+          if (c != p) {
+            int y = succ(c);
+            long long added = static_cast<long long>(d[c][first]) + d[last][y] - d[c][y];
+            if (added < removed) {
+              move_segment(first, length, c, false);
+              for (int x : {p, q, c, y, first, last}) {
+                activate(x);
+              }
+              return true;
+            }
+          }
+          if (c != q) {
+            int x = pred(c);
+            long long added = static_cast<long long>(d[x][last]) + d[first][c] - d[x][c];
+            if (added < removed) {
+              move_segment(first, length, x, true);
+              for (int y : {p, q, c, x, first, last}) {
+                activate(y);
+              }
+              return true;
+            }
+          }
+        }
+      }
+      return false;
+    }
+
+    // 把从 first 开始的 length 个城市移到 after 与其后继之间，
+    // reversed 为真时反向放置；移动段与 after 之间较短的一侧
+    void move_segment(int first, size_t length, int after, bool reversed) {
+      size_t i = pos[first], j = (i + length - 1) % n;
+      std::vector<int> segment;
+      for (size_t t = 0; t < length; t++) {
+        segment.push_back(order[(i + t) % n]);
+      }
+      if (reversed) {
+        std::reverse(segment.begin(), segment.end());
+      }
+      size_t ahead = (pos[after] + n - j) % n; // 段后到 after 的城市数
+      size_t behind = n - length - ahead;      // after 的后继到段前的城市数
+      size_t start;
+      if (ahead <= behind) {
+        for (size_t t = 1; t <= ahead; t++) {
+          place(order[(j + t) % n], (i + t - 1) % n);
+        }
+        start = (i + ahead) % n;
+      } else {
+        for (size_t t = 0; t < behind; t++) {
+          place(order[(i + n - 1 - t) % n], (j + n - t) % n);
+        }
+        start = (i + n - behind) % n;
+      }
+      for (size_t t = 0; t < length; t++) {
+        place(segment[t], (start + t) % n);
+      }
+    }
+
+    void place(int city, size_t at) {
+      order[at] = city;
+      pos[city] = at;
+    }
+  };
+
   /**
    * @brief Prim算法构建最小生成树
    */
@@ -344,7 +814,8 @@ private:
 
     key[0] = 0;
 
-    for (int count = 0; count < n - 1; count++) {
+    // 每轮加入一个顶点，共 n 轮（最后加入的顶点也要连上它的父节点）
+    for (int count = 0; count < n; count++) {
       int u = -1;
       for (int v = 0; v < n; v++) {
         if (!in_mst[v] && (u == -1 || key[v] < key[u])) {
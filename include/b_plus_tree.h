@@ -0,0 +1,653 @@
+#ifndef B_PLUS_TREE_H
+#define B_PLUS_TREE_H
+
+#include "cpu_features.h"
+#include "gemm_kernel.h"
+#include "slab_allocator.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+
+/**
+ * @brief 缓存友好的B+树（18章B树的变体）
+ *
+ * - 所有键值对都在叶子中，内部节点只存分隔键；叶子之间用链表相连，范围扫描顺序访问
+ * - 节点内的键是定长的内联数组，默认占256字节（4条缓存行），按缓存行对齐
+ * - 键为整数类型，未使用的键位填充为键类型的最大值，节点内查找可以不看元素个数
+ *   直接扫描整个数组：有符号32/64位整数键在支持AVX2的CPU上用SIMD比较计数，其余类型用无分支二分查找
+ * - 节点由slab分配器分配，不再逐个new
+ * - 支持从有序输入批量构建（自底向上逐层填满节点）
+ * 分隔键约定：内部节点第i个子树中的键都满足 keys[i-1] <= key < keys[i]。
+ */
+template <typename K, typename V, size_t NodeBytes = 256> class BPlusTree {
+  // 哨兵 numeric_limits<K>::max() 必须不小于任何键；浮点键可能是无穷大或NaN，
+  // 节点内查找会把哨兵计入，插入时位置越过元素个数
+  static_assert(std::is_integral<K>::value,
+                "BPlusTree keys must be integral types");
+
+public:
+  static constexpr size_t kKeys =
+      NodeBytes / sizeof(K) < 4 ? 4 : NodeBytes / sizeof(K);
+
+  BPlusTree() { root = new_leaf(); }
+
+  BPlusTree(const BPlusTree &) = delete;
+  BPlusTree &operator=(const BPlusTree &) = delete;
+
+  ~BPlusTree() { destroy_all(); }
+
+  // 查找：返回值的指针，不存在时返回nullptr
+  V *find(const K &key) {
+    Leaf *leaf = find_leaf(key);
+    size_t pos = lower_bound(leaf->keys, key);
+    return pos < leaf->count && leaf->keys[pos] == key ? &leaf->values[pos]
+                                                       : nullptr;
+  }
+
+  const V *find(const K &key) const {
+    return const_cast<BPlusTree *>(this)->find(key);
+  }
+
+  bool contains(const K &key) const { return find(key) != nullptr; }
+
+  // 插入或更新，返回是否为新键
+  bool insert(const K &key, const V &value) {
+    bool inserted = false;
+    Split split = insert_into(root, height, key, value, inserted);
+    if (split.right != nullptr) {
+      Inner *new_root = new_inner();
+      new_root->keys[0] = split.separator;
+      new_root->children[0] = root;
+      new_root->children[1] = split.right;
+      new_root->count = 1;
+      root = new_root;
+      height++;
+    }
+    element_count += inserted;
+    return inserted;
+  }
+
+  bool erase(const K &key) {
+    bool erased = false;
+    erase_from(root, height, key, erased);
+    if (height > 0 && static_cast<Inner *>(root)->count == 0) {
+      Inner *old_root = static_cast<Inner *>(root);
+      root = old_root->children[0];
+      free_inner(old_root);
+      height--;
+    }
+    element_count -= erased;
+    return erased;
+  }
+
+  // 按键升序访问[low, high]内的所有元素：visit(key, value)
+  template <typename Visitor>
+  void range_scan(const K &low, const K &high, Visitor visit) const {
+    const Leaf *leaf = const_cast<BPlusTree *>(this)->find_leaf(low);
+    size_t pos = lower_bound(leaf->keys, low);
+    while (leaf != nullptr) {
+      for (; pos < leaf->count; pos++) {
+        if (high < leaf->keys[pos]) {
+          return;
+        }
+        visit(leaf->keys[pos], leaf->values[pos]);
+      }
+      leaf = leaf->next;
+      pos = 0;
+    }
+  }
+
+  /**
+   * @brief 从按键严格递增的序列批量构建（替换现有内容）
+   * @param fill 节点填充率，取值[0.5, 1]；只读索引用1，之后还要插入的可以留些空位
+   */
+  void bulk_load(const std::vector<std::pair<K, V>> &sorted,
+                 double fill = 1.0) {
+    if (!(fill >= 0.5 && fill <= 1.0)) {
+      throw std::invalid_argument("Fill factor must be in [0.5, 1]");
+    }
+    for (size_t i = 1; i < sorted.size(); i++) {
+      if (!(sorted[i - 1].first < sorted[i].first)) {
+        throw std::invalid_argument(
+            "Bulk load input must be strictly increasing");
+      }
+    }
+    destroy_all();
+    element_count = sorted.size();
+    height = 0;
+    if (sorted.empty()) {
+      root = new_leaf();
+      return;
+    }
+
+    // 叶子层：均匀分配，每个叶子最多 fill * kKeys 个元素
+    size_t per_leaf = std::max<size_t>(2, static_cast<size_t>(kKeys * fill));
+    size_t leaf_count = (sorted.size() + per_leaf - 1) / per_leaf;
+    std::vector<void *> level(leaf_count);
+    std::vector<K> level_min(leaf_count);
+    Leaf *previous = nullptr;
+    size_t offset = 0;
+    for (size_t l = 0; l < leaf_count; l++) {
+      size_t take = sorted.size() / leaf_count + (l < sorted.size() % leaf_count);
+      Leaf *leaf = new_leaf();
+      for (size_t k = 0; k < take; k++) {
+        leaf->keys[k] = sorted[offset + k].first;
+        leaf->values[k] = sorted[offset + k].second;
+      }
+      leaf->count = static_cast<uint16_t>(take);
+      level_min[l] = leaf->keys[0];
+      level[l] = leaf;
+      if (previous != nullptr) {
+        previous->next = leaf;
+      }
+      previous = leaf;
+      offset += take;
+    }
+
+    // 内部层：每个节点最多 fill * (kKeys + 1) 个孩子，分隔键为右侧子树的最小键
+    size_t per_inner = std::max<size_t>(2, static_cast<size_t>((kKeys + 1) * fill));
+    while (level.size() > 1) {
+      size_t node_count = (level.size() + per_inner - 1) / per_inner;
+      std::vector<void *> parents(node_count);
+      std::vector<K> parent_min(node_count);
+      offset = 0;
+      for (size_t p = 0; p < node_count; p++) {
+        size_t take = level.size() / node_count + (p < level.size() % node_count);
+        Inner *inner = new_inner();
+        for (size_t c = 0; c < take; c++) {
+          inner->children[c] = level[offset + c];
+          if (c > 0) {
+            inner->keys[c - 1] = level_min[offset + c];
+          }
+        }
+        inner->count = static_cast<uint16_t>(take - 1);
+        parents[p] = inner;
+        parent_min[p] = level_min[offset];
+        offset += take;
+      }
+      level = std::move(parents);
+      level_min = std::move(parent_min);
+      height++;
+    }
+    root = level[0];
+  }
+
+  void clear() {
+    destroy_all();
+    root = new_leaf();
+    height = 0;
+    element_count = 0;
+  }
+
+  // 检查键有序、分隔键范围、非根节点最小占用、哨兵以及叶子链表的完整性
+  bool validate() const {
+    const Leaf *previous = nullptr;
+    size_t counted = 0;
+    if (!validate_node(root, height, true, nullptr, nullptr, previous,
+                       counted)) {
+      return false;
+    }
+    return previous->next == nullptr && counted == element_count;
+  }
+
+  size_t size() const { return element_count; }
+  bool empty() const { return element_count == 0; }
+  int get_height() const { return height + 1; }
+  size_t memory_bytes() const {
+    return leaf_pool.bytes_reserved() + inner_pool.bytes_reserved();
+  }
+
+private:
+  struct alignas(64) Leaf {
+    K keys[kKeys];
+    V values[kKeys];
+    Leaf *next = nullptr;
+    uint16_t count = 0;
+
+    Leaf() { std::fill(keys, keys + kKeys, std::numeric_limits<K>::max()); }
+  };
+
+  struct alignas(64) Inner {
+    K keys[kKeys];
+    void *children[kKeys + 1];
+    uint16_t count = 0; // 分隔键个数，孩子数为count + 1
+
+    Inner() { std::fill(keys, keys + kKeys, std::numeric_limits<K>::max()); }
+  };
+
+  struct Split {
+    K separator;
+    void *right = nullptr;
+  };
+
+  static constexpr size_t kMinKeys = kKeys / 2;
+
+  SlabAllocator<Leaf> leaf_pool{64};
+  SlabAllocator<Inner> inner_pool{64};
+  void *root = nullptr;
+  int height = 0; // 根所在的层，叶子为0层
+  size_t element_count = 0;
+
+  Leaf *new_leaf() { return new (leaf_pool.allocate()) Leaf(); }
+  Inner *new_inner() { return new (inner_pool.allocate()) Inner(); }
+  void free_leaf(Leaf *leaf) {
+    leaf->~Leaf();
+    leaf_pool.deallocate(leaf);
+  }
+  void free_inner(Inner *inner) {
+    inner->~Inner();
+    inner_pool.deallocate(inner);
+  }
+
+  void destroy_all() {
+    if (root != nullptr && !std::is_trivially_destructible<V>::value) {
+      void *node = root;
+      for (int level = height; level > 0; level--) {
+        node = static_cast<Inner *>(node)->children[0];
+      }
+      for (Leaf *leaf = static_cast<Leaf *>(node); leaf != nullptr;) {
+        Leaf *next = leaf->next;
+        leaf->~Leaf();
+        leaf = next;
+      }
+    }
+    leaf_pool.release_all();
+    inner_pool.release_all();
+    root = nullptr;
+  }
+
+  // 把[from, kKeys)的键位重置为哨兵
+  static void reset_tail(K *keys, size_t from) {
+    std::fill(keys + from, keys + kKeys, std::numeric_limits<K>::max());
+  }
+
+  // 节点内查找：小于key（strict）或不大于key的键的个数
+  template <bool Inclusive>
+  static size_t count_before(const K *keys, const K &key) {
+#ifdef ALGORITHMS_GEMM_X86
+    if constexpr (std::is_integral<K>::value && std::is_signed<K>::value &&
+                  (sizeof(K) == 4 || sizeof(K) == 8) && kKeys % 8 == 0) {
+      if (CpuFeatures::avx2()) {
+        return count_avx2<Inclusive>(keys, key);
+      }
+    }
+#endif
+    // 无分支二分查找：每步只做一次条件传送
+    const K *base = keys;
+    size_t n = kKeys;
+    while (n > 1) {
+      size_t half = n / 2;
+      bool right = Inclusive ? !(key < base[half - 1]) : base[half - 1] < key;
+      base = right ? base + half : base;
+      n -= half;
+    }
+    return (base - keys) + (Inclusive ? !(key < *base) : *base < key);
+  }
+
+  static size_t lower_bound(const K *keys, const K &key) {
+    return count_before<false>(keys, key);
+  }
+
+  // 内部节点中key所在的孩子；哨兵与key相等时会被计入，需要截断到count
+  static size_t child_index(const Inner *inner, const K &key) {
+    return std::min<size_t>(count_before<true>(inner->keys, key), inner->count);
+  }
+
+#ifdef ALGORITHMS_GEMM_X86
+  // 整个键数组与key比较，统计满足条件的个数
+  template <bool Inclusive>
+  __attribute__((target("avx2"))) static size_t count_avx2(const K *keys,
+                                                          K key) {
+    size_t total = 0;
+    if constexpr (sizeof(K) == 8) {
+      __m256i target = _mm256_set1_epi64x(static_cast<long long>(key));
+      for (size_t i = 0; i < kKeys; i += 4) {
+        __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i *>(keys + i));
+        // strict: key > v；inclusive: !(v > key)
+        __m256i mask = Inclusive ? _mm256_cmpgt_epi64(v, target)
+                                 : _mm256_cmpgt_epi64(target, v);
+        int bits = __builtin_popcount(
+            _mm256_movemask_pd(_mm256_castsi256_pd(mask)));
+        total += Inclusive ? 4 - bits : bits;
+      }
+    } else {
+      __m256i target = _mm256_set1_epi32(static_cast<int>(key));
+      for (size_t i = 0; i < kKeys; i += 8) {
+        __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i *>(keys + i));
+        __m256i mask = Inclusive ? _mm256_cmpgt_epi32(v, target)
+                                 : _mm256_cmpgt_epi32(target, v);
+        int bits = __builtin_popcount(
+            _mm256_movemask_ps(_mm256_castsi256_ps(mask)));
+        total += Inclusive ? 8 - bits : bits;
+      }
+    }
+    return total;
+  }
+#endif
+
+  // low/high为子树键的范围[low, high)，nullptr表示无界；按中序检查叶子链表
+  bool validate_node(const void *node, int level, bool is_root, const K *low,
+                     const K *high, const Leaf *&previous,
+                     size_t &counted) const {
+    if (level == 0) {
+      const Leaf *leaf = static_cast<const Leaf *>(node);
+      if ((!is_root && leaf->count < kMinKeys / 2) ||
+          (previous != nullptr && previous->next != leaf)) {
+        return false;
+      }
+      for (size_t i = 0; i < kKeys; i++) {
+        if (i >= leaf->count) {
+          if (leaf->keys[i] != std::numeric_limits<K>::max()) {
+            return false;
+          }
+          continue;
+        }
+        if ((i > 0 && !(leaf->keys[i - 1] < leaf->keys[i])) ||
+            (low != nullptr && leaf->keys[i] < *low) ||
+            (high != nullptr && !(leaf->keys[i] < *high))) {
+          return false;
+        }
+      }
+      previous = leaf;
+      counted += leaf->count;
+      return true;
+    }
+
+    const Inner *inner = static_cast<const Inner *>(node);
+    if ((is_root && inner->count == 0) ||
+        (!is_root &&
+         static_cast<size_t>(inner->count) + 1 < (kMinKeys + 1) / 2)) {
+      return false;
+    }
+    for (size_t i = inner->count; i < kKeys; i++) {
+      if (inner->keys[i] != std::numeric_limits<K>::max()) {
+        return false;
+      }
+    }
+    for (size_t i = 0; i <= inner->count; i++) {
+      if (i > 0 && i < inner->count &&
+          !(inner->keys[i - 1] < inner->keys[i])) {
+        return false;
+      }
+      const K *child_low = i == 0 ? low : &inner->keys[i - 1];
+      const K *child_high = i == inner->count ? high : &inner->keys[i];
+      if (!validate_node(inner->children[i], level - 1, false, child_low,
+                         child_high, previous, counted)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  Leaf *find_leaf(const K &key) {
+    void *node = root;
+    for (int level = height; level > 0; level--) {
+      Inner *inner = static_cast<Inner *>(node);
+      node = inner->children[child_index(inner, key)];
+    }
+    return static_cast<Leaf *>(node);
+  }
+
+  Split insert_into(void *node, int level, const K &key, const V &value,
+                    bool &inserted) {
+    if (level == 0) {
+      return insert_into_leaf(static_cast<Leaf *>(node), key, value, inserted);
+    }
+
+    Inner *inner = static_cast<Inner *>(node);
+    size_t index = child_index(inner, key);
+    Split child_split =
+        insert_into(inner->children[index], level - 1, key, value, inserted);
+    if (child_split.right == nullptr) {
+      return {};
+    }
+
+    if (inner->count < kKeys) {
+      std::copy_backward(inner->keys + index, inner->keys + inner->count,
+                         inner->keys + inner->count + 1);
+      std::copy_backward(inner->children + index + 1,
+                         inner->children + inner->count + 1,
+                         inner->children + inner->count + 2);
+      inner->keys[index] = child_split.separator;
+      inner->children[index + 1] = child_split.right;
+      inner->count++;
+      return {};
+    }
+
+    // 节点已满：合并成kKeys+1个键的临时序列，中间的键上移
+    K keys[kKeys + 1];
+    void *children[kKeys + 2];
+    std::copy(inner->keys, inner->keys + index, keys);
+    keys[index] = child_split.separator;
+    std::copy(inner->keys + index, inner->keys + kKeys, keys + index + 1);
+    std::copy(inner->children, inner->children + index + 1, children);
+    children[index + 1] = child_split.right;
+    std::copy(inner->children + index + 1, inner->children + kKeys + 1,
+              children + index + 2);
+
+    size_t left_keys = (kKeys + 1) / 2;
+    Inner *right = new_inner();
+    std::copy(keys, keys + left_keys, inner->keys);
+    std::copy(children, children + left_keys + 1, inner->children);
+    inner->count = static_cast<uint16_t>(left_keys);
+    reset_tail(inner->keys, left_keys);
+
+    size_t right_keys = kKeys - left_keys;
+    std::copy(keys + left_keys + 1, keys + kKeys + 1, right->keys);
+    std::copy(children + left_keys + 1, children + kKeys + 2, right->children);
+    right->count = static_cast<uint16_t>(right_keys);
+    return {keys[left_keys], right};
+  }
+
+  Split insert_into_leaf(Leaf *leaf, const K &key, const V &value,
+                         bool &inserted) {
+    size_t pos = lower_bound(leaf->keys, key);
+    if (pos < leaf->count && leaf->keys[pos] == key) {
+      leaf->values[pos] = value;
+      return {};
+    }
+    inserted = true;
+
+    if (leaf->count < kKeys) {
+      std::copy_backward(leaf->keys + pos, leaf->keys + leaf->count,
+                         leaf->keys + leaf->count + 1);
+      std::move_backward(leaf->values + pos, leaf->values + leaf->count,
+                         leaf->values + leaf->count + 1);
+      leaf->keys[pos] = key;
+      leaf->values[pos] = value;
+      leaf->count++;
+      return {};
+    }
+
+    // 叶子已满：右半部分移到新叶子，新叶子接入链表
+    Leaf *right = new_leaf();
+    size_t left_count = (kKeys + 1) / 2;
+    if (pos < left_count) {
+      size_t moved = kKeys - (left_count - 1);
+      std::copy(leaf->keys + left_count - 1, leaf->keys + kKeys, right->keys);
+      std::move(leaf->values + left_count - 1, leaf->values + kKeys,
+                right->values);
+      right->count = static_cast<uint16_t>(moved);
+      leaf->count = static_cast<uint16_t>(left_count - 1);
+      reset_tail(leaf->keys, leaf->count);
+      std::copy_backward(leaf->keys + pos, leaf->keys + leaf->count,
+                         leaf->keys + leaf->count + 1);
+      std::move_backward(leaf->values + pos, leaf->values + leaf->count,
+                         leaf->values + leaf->count + 1);
+      leaf->keys[pos] = key;
+      leaf->values[pos] = value;
+      leaf->count++;
+    } else {
+      size_t moved = kKeys - left_count;
+      std::copy(leaf->keys + left_count, leaf->keys + kKeys, right->keys);
+      std::move(leaf->values + left_count, leaf->values + kKeys, right->values);
+      right->count = static_cast<uint16_t>(moved);
+      leaf->count = static_cast<uint16_t>(left_count);
+      reset_tail(leaf->keys, leaf->count);
+      size_t at = pos - left_count;
+      std::copy_backward(right->keys + at, right->keys + right->count,
+                         right->keys + right->count + 1);
+      std::move_backward(right->values + at, right->values + right->count,
+                         right->values + right->count + 1);
+      right->keys[at] = key;
+      right->values[at] = value;
+      right->count++;
+    }
+    right->next = leaf->next;
+    leaf->next = right;
+    return {right->keys[0], right};
+  }
+
+  // 删除后返回节点是否低于最小占用
+  bool erase_from(void *node, int level, const K &key, bool &erased) {
+    if (level == 0) {
+      Leaf *leaf = static_cast<Leaf *>(node);
+      size_t pos = lower_bound(leaf->keys, key);
+      if (pos >= leaf->count || leaf->keys[pos] != key) {
+        return false;
+      }
+      std::copy(leaf->keys + pos + 1, leaf->keys + leaf->count,
+                leaf->keys + pos);
+      std::move(leaf->values + pos + 1, leaf->values + leaf->count,
+                leaf->values + pos);
+      leaf->count--;
+      leaf->keys[leaf->count] = std::numeric_limits<K>::max();
+      erased = true;
+      return leaf->count < kMinKeys;
+    }
+
+    Inner *inner = static_cast<Inner *>(node);
+    size_t index = child_index(inner, key);
+    if (erase_from(inner->children[index], level - 1, key, erased)) {
+      if (level == 1) {
+        rebalance_leaf(inner, index);
+      } else {
+        rebalance_inner(inner, index);
+      }
+    }
+    return inner->count < kMinKeys;
+  }
+
+  // 删除父节点的第index个分隔键与其右侧的孩子
+  static void remove_separator(Inner *parent, size_t index) {
+    std::copy(parent->keys + index + 1, parent->keys + parent->count,
+              parent->keys + index);
+    std::copy(parent->children + index + 2,
+              parent->children + parent->count + 1,
+              parent->children + index + 1);
+    parent->count--;
+    parent->keys[parent->count] = std::numeric_limits<K>::max();
+  }
+
+  void rebalance_leaf(Inner *parent, size_t index) {
+    Leaf *child = static_cast<Leaf *>(parent->children[index]);
+    Leaf *left = index > 0 ? static_cast<Leaf *>(parent->children[index - 1])
+                           : nullptr;
+    Leaf *right = index < parent->count
+                      ? static_cast<Leaf *>(parent->children[index + 1])
+                      : nullptr;
+
+    if (left != nullptr && left->count > kMinKeys) {
+      // 从左兄弟借最后一个元素
+      std::copy_backward(child->keys, child->keys + child->count,
+                         child->keys + child->count + 1);
+      std::move_backward(child->values, child->values + child->count,
+                         child->values + child->count + 1);
+      left->count--;
+      child->keys[0] = left->keys[left->count];
+      child->values[0] = std::move(left->values[left->count]);
+      left->keys[left->count] = std::numeric_limits<K>::max();
+      child->count++;
+      parent->keys[index - 1] = child->keys[0];
+    } else if (right != nullptr && right->count > kMinKeys) {
+      // 从右兄弟借第一个元素
+      child->keys[child->count] = right->keys[0];
+      child->values[child->count] = std::move(right->values[0]);
+      child->count++;
+      std::copy(right->keys + 1, right->keys + right->count, right->keys);
+      std::move(right->values + 1, right->values + right->count,
+                right->values);
+      right->count--;
+      right->keys[right->count] = std::numeric_limits<K>::max();
+      parent->keys[index] = right->keys[0];
+    } else if (left != nullptr) {
+      merge_leaves(left, child);
+      remove_separator(parent, index - 1);
+    } else if (right != nullptr) {
+      merge_leaves(child, right);
+      remove_separator(parent, index);
+    }
+  }
+
+  // 把right并入left并从链表中摘除
+  void merge_leaves(Leaf *left, Leaf *right) {
+    std::copy(right->keys, right->keys + right->count,
+              left->keys + left->count);
+    std::move(right->values, right->values + right->count,
+              left->values + left->count);
+    left->count = static_cast<uint16_t>(left->count + right->count);
+    left->next = right->next;
+    free_leaf(right);
+  }
+
+  void rebalance_inner(Inner *parent, size_t index) {
+    Inner *child = static_cast<Inner *>(parent->children[index]);
+    Inner *left = index > 0 ? static_cast<Inner *>(parent->children[index - 1])
+                            : nullptr;
+    Inner *right = index < parent->count
+                       ? static_cast<Inner *>(parent->children[index + 1])
+                       : nullptr;
+
+    if (left != nullptr && left->count > kMinKeys) {
+      // 父分隔键下移到child开头，左兄弟的最后一个键上移
+      std::copy_backward(child->keys, child->keys + child->count,
+                         child->keys + child->count + 1);
+      std::copy_backward(child->children, child->children + child->count + 1,
+                         child->children + child->count + 2);
+      child->keys[0] = parent->keys[index - 1];
+      child->children[0] = left->children[left->count];
+      child->count++;
+      parent->keys[index - 1] = left->keys[left->count - 1];
+      left->count--;
+      left->keys[left->count] = std::numeric_limits<K>::max();
+    } else if (right != nullptr && right->count > kMinKeys) {
+      child->keys[child->count] = parent->keys[index];
+      child->children[child->count + 1] = right->children[0];
+      child->count++;
+      parent->keys[index] = right->keys[0];
+      std::copy(right->keys + 1, right->keys + right->count, right->keys);
+      std::copy(right->children + 1, right->children + right->count + 1,
+                right->children);
+      right->count--;
+      right->keys[right->count] = std::numeric_limits<K>::max();
+    } else if (left != nullptr) {
+      merge_inner(left, parent->keys[index - 1], child);
+      remove_separator(parent, index - 1);
+    } else if (right != nullptr) {
+      merge_inner(child, parent->keys[index], right);
+      remove_separator(parent, index);
+    }
+  }
+
+  void merge_inner(Inner *left, const K &separator, Inner *right) {
+    left->keys[left->count] = separator;
+    std::copy(right->keys, right->keys + right->count,
+              left->keys + left->count + 1);
+    std::copy(right->children, right->children + right->count + 1,
+              left->children + left->count + 1);
+    left->count = static_cast<uint16_t>(left->count + 1 + right->count);
+    free_inner(right);
+  }
+};
+
+} // namespace algorithms
+
+#endif // B_PLUS_TREE_H
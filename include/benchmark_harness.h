@@ -0,0 +1,774 @@
+#ifndef BENCHMARK_HARNESS_H
+#define BENCHMARK_HARNESS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace algorithms {
+
+/**
+ * @brief 一次测量的硬件计数器读数（每次迭代的平均值）
+ */
+struct PerfCounterValues {
+  bool available = false;
+  double cycles = 0;
+  double instructions = 0;
+  double cache_misses = 0;
+  double branch_misses = 0;
+};
+
+/**
+ * @brief 通过 perf_event_open 读取周期、指令、缓存未命中与分支预测失败
+ *
+ * 计数器只统计用户态，并继承到之后创建的线程，多线程算法的工作线程也计入。
+ * 内核不允许（perf_event_paranoid、容器、非Linux）时 available() 为 false，
+ * 测试照常计时，只是不报告计数器。
+ */
+class PerfCounters {
+public:
+  PerfCounters() {
+#ifdef __linux__
+    const uint64_t configs[kEvents] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+    for (int i = 0; i < kEvents; i++) {
+      perf_event_attr attr{};
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = configs[i];
+      attr.disabled = 1;
+      attr.inherit = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format =
+          PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+      if (fds[i] < 0) {
+        close_all();
+        return;
+      }
+    }
+    opened = true;
+#endif
+  }
+
+  ~PerfCounters() { close_all(); }
+
+  PerfCounters(const PerfCounters &) = delete;
+  PerfCounters &operator=(const PerfCounters &) = delete;
+
+  bool available() const { return opened; }
+
+  // 清零并开始计数
+  void start() {
+#ifdef __linux__
+    if (!opened)
+      return;
+    for (int fd : fds) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  // 停止计数并返回总数；计数器被分时复用时按运行时间比例放大
+  PerfCounterValues stop() {
+    PerfCounterValues values;
+#ifdef __linux__
+    if (!opened)
+      return values;
+    for (int fd : fds)
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    double counts[kEvents];
+    for (int i = 0; i < kEvents; i++) {
+      uint64_t data[3] = {0, 0, 0};
+      if (read(fds[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)))
+        return values;
+      counts[i] = data[2] == 0 ? 0.0
+                               : static_cast<double>(data[0]) *
+                                     static_cast<double>(data[1]) /
+                                     static_cast<double>(data[2]);
+    }
+    values.available = true;
+    values.cycles = counts[0];
+    values.instructions = counts[1];
+    values.cache_misses = counts[2];
+    values.branch_misses = counts[3];
+#endif
+    return values;
+  }
+
+private:
+  static constexpr int kEvents = 4;
+  int fds[kEvents] = {-1, -1, -1, -1};
+  bool opened = false;
+
+  void close_all() {
+#ifdef __linux__
+    for (int &fd : fds) {
+      if (fd >= 0)
+        close(fd);
+      fd = -1;
+    }
+#endif
+    opened = false;
+  }
+};
+
+/**
+ * @brief 一组样本（每次迭代的纳秒数）的统计量
+ */
+struct BenchmarkStatistics {
+  double min = 0, median = 0, mean = 0, p99 = 0, max = 0, stddev = 0;
+
+  static BenchmarkStatistics summarize(std::vector<double> samples) {
+    BenchmarkStatistics stats;
+    if (samples.empty())
+      return stats;
+    std::sort(samples.begin(), samples.end());
+    size_t n = samples.size();
+    stats.min = samples.front();
+    stats.max = samples.back();
+    stats.median = n % 2 ? samples[n / 2]
+                         : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+    // 最近秩法：不小于 99% 样本的最小样本
+    stats.p99 = samples[static_cast<size_t>(std::ceil(0.99 * n)) - 1];
+    double sum = 0;
+    for (double x : samples)
+      sum += x;
+    stats.mean = sum / n;
+    double squares = 0;
+    for (double x : samples)
+      squares += (x - stats.mean) * (x - stats.mean);
+    stats.stddev = n > 1 ? std::sqrt(squares / (n - 1)) : 0.0;
+    return stats;
+  }
+};
+
+/**
+ * @brief 一个测试用例（测试函数 × 规模 × 分布）的结果
+ */
+struct BenchmarkResult {
+  std::string name;
+  std::string distribution;
+  size_t size = 0;
+  std::string label;
+  std::string error; // 非空表示测试函数抛出了异常或没有调用 state.run
+  size_t repetitions = 0;
+  size_t iterations_per_sample = 0;
+  std::vector<double> samples_ns; // 每个样本中平均每次迭代的纳秒数
+  BenchmarkStatistics ns;
+  PerfCounterValues counters;
+  double items_per_iteration = 0;
+  double bytes_per_iteration = 0;
+
+  // 用于筛选与输出的用例名：name/distribution/size
+  std::string case_name() const {
+    std::string full = name;
+    if (!distribution.empty())
+      full += "/" + distribution;
+    if (size > 0)
+      full += "/" + std::to_string(size);
+    return full;
+  }
+};
+
+// 运行参数，由命令行解析
+struct BenchmarkOptions {
+  std::string filter;          // 用例名上的正则表达式
+  size_t warmup = 1;           // 预热样本数（不计入统计）
+  size_t repetitions = 10;     // 计入统计的样本数
+  double min_sample_ms = 1.0;  // 单次迭代太快时批量执行，使每个样本不短于此
+  std::vector<size_t> sizes;   // 非空时覆盖各测试注册的规模
+  std::vector<std::string> distributions; // 非空时覆盖各测试注册的分布
+  std::string format = "text"; // text、json 或 csv
+  std::string output;          // 机器可读结果写入的文件；为空时写到标准输出
+  bool counters = true;        // 是否读取硬件计数器
+  bool list = false;           // 只列出用例名
+};
+
+/**
+ * @brief 传给测试函数的状态：当前规模与分布，以及计时入口 run()
+ *
+ * 典型用法：
+ *   void bench_sort(BenchmarkState &state) {
+ *     std::vector<int> input = make_input(state.size(), state.distribution());
+ *     std::vector<int> arr;
+ *     state.run([&] { arr = input; },   // 每次迭代前的准备，不计时
+ *               [&] { natural_merge_sort(arr); });
+ *     state.set_items_processed(state.size());
+ *   }
+ */
+class BenchmarkState {
+public:
+  size_t size() const { return result.size; }
+  const std::string &distribution() const { return result.distribution; }
+
+  /**
+   * @brief 计时 body：预热后采集 repetitions 个样本
+   *
+   * 单次迭代短于 min_sample_ms 时，每个样本连续执行多次迭代再取平均，
+   * 以免时钟精度淹没结果。
+   */
+  template <typename Body> void run(Body &&body) {
+    auto start = Clock::now();
+    body();
+    double once = elapsed_ns(start);
+    size_t batch = 1;
+    if (once < options.min_sample_ms * 1e6)
+      batch = static_cast<size_t>(options.min_sample_ms * 1e6 /
+                                  std::max(once, 1.0)) + 1;
+    collect(batch, [] {}, body);
+  }
+
+  /**
+   * @brief 计时 body，每次迭代前先执行不计时的 setup（如复制未排序的输入）
+   *
+   * 每个样本只含一次迭代，适合会破坏输入的算法。
+   */
+  template <typename Setup, typename Body> void run(Setup &&setup, Body &&body) {
+    collect(1, setup, body);
+  }
+
+  // 每次迭代处理的元素数与字节数，用于报告吞吐量
+  void set_items_processed(double items) { result.items_per_iteration = items; }
+  void set_bytes_processed(double bytes) { result.bytes_per_iteration = bytes; }
+  void set_label(const std::string &label) { result.label = label; }
+
+  // 阻止编译器把结果未被使用的计算优化掉
+  template <typename T> static void do_not_optimize(const T &value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &value;
+#endif
+  }
+
+private:
+  using Clock = std::chrono::steady_clock;
+  friend class BenchmarkRunner;
+
+  BenchmarkState(const BenchmarkOptions &options, PerfCounters *counters,
+                 BenchmarkResult &result)
+      : options(options), counters(counters), result(result) {}
+
+  const BenchmarkOptions &options;
+  PerfCounters *counters;
+  BenchmarkResult &result;
+  bool ran = false;
+
+  static double elapsed_ns(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start)
+        .count();
+  }
+
+  template <typename Setup, typename Body>
+  void collect(size_t batch, Setup &&setup, Body &&body) {
+    if (ran)
+      throw std::logic_error("BenchmarkState::run called more than once");
+    ran = true;
+    for (size_t w = 0; w < options.warmup; w++) {
+      for (size_t i = 0; i < batch; i++) {
+        setup();
+        body();
+      }
+    }
+
+    bool use_counters = counters != nullptr && counters->available();
+    PerfCounterValues total;
+    result.samples_ns.clear();
+    for (size_t r = 0; r < options.repetitions; r++) {
+      double ns = 0;
+      if (batch == 1) {
+        setup();
+        if (use_counters)
+          counters->start();
+        auto start = Clock::now();
+        body();
+        ns = elapsed_ns(start);
+      } else {
+        if (use_counters)
+          counters->start();
+        auto start = Clock::now();
+        for (size_t i = 0; i < batch; i++)
+          body();
+        ns = elapsed_ns(start) / batch;
+      }
+      if (use_counters) {
+        PerfCounterValues values = counters->stop();
+        total.available = values.available;
+        total.cycles += values.cycles / batch;
+        total.instructions += values.instructions / batch;
+        total.cache_misses += values.cache_misses / batch;
+        total.branch_misses += values.branch_misses / batch;
+      }
+      result.samples_ns.push_back(ns);
+    }
+    if (total.available && options.repetitions > 0) {
+      double n = static_cast<double>(options.repetitions);
+      total.cycles /= n;
+      total.instructions /= n;
+      total.cache_misses /= n;
+      total.branch_misses /= n;
+    }
+    result.repetitions = options.repetitions;
+    result.iterations_per_sample = batch;
+    result.counters = total;
+    result.ns = BenchmarkStatistics::summarize(result.samples_ns);
+  }
+};
+
+/**
+ * @brief 注册的测试函数及其参数（规模列表、分布列表）
+ */
+class BenchmarkDefinition {
+public:
+  using Function = std::function<void(BenchmarkState &)>;
+
+  BenchmarkDefinition(std::string name, Function function)
+      : name_(std::move(name)), function_(std::move(function)) {}
+
+  BenchmarkDefinition &sizes(std::vector<size_t> values) {
+    sizes_ = std::move(values);
+    return *this;
+  }
+  BenchmarkDefinition &distributions(std::vector<std::string> values) {
+    distributions_ = std::move(values);
+    return *this;
+  }
+
+  const std::string &name() const { return name_; }
+  const Function &function() const { return function_; }
+  const std::vector<size_t> &sizes() const { return sizes_; }
+  const std::vector<std::string> &distributions() const {
+    return distributions_;
+  }
+
+private:
+  std::string name_;
+  Function function_;
+  std::vector<size_t> sizes_;
+  std::vector<std::string> distributions_;
+};
+
+/**
+ * @brief 进程内所有测试函数的注册表，由 ALGORITHMS_BENCHMARK 在静态初始化时填充
+ */
+class BenchmarkRegistry {
+public:
+  static BenchmarkRegistry &instance() {
+    static BenchmarkRegistry registry;
+    return registry;
+  }
+
+  BenchmarkDefinition &add(const std::string &name,
+                           BenchmarkDefinition::Function function) {
+    definitions.push_back(
+        std::make_unique<BenchmarkDefinition>(name, std::move(function)));
+    return *definitions.back();
+  }
+
+  const std::vector<std::unique_ptr<BenchmarkDefinition>> &benchmarks() const {
+    return definitions;
+  }
+
+private:
+  BenchmarkRegistry() = default;
+  std::vector<std::unique_ptr<BenchmarkDefinition>> definitions;
+};
+
+/**
+ * @brief 解析命令行、逐个运行注册的测试用例并输出结果
+ *
+ * 文本表格逐行打印到标准输出；--format=json/csv 的结果写到 --output 指定的文件，
+ * 未指定文件时代替表格写到标准输出。JSON/CSV 带上编译时的 git 版本
+ * （ALGORITHMS_GIT_REVISION，由 CMake 传入），便于跨提交比较回归。
+ */
+class BenchmarkRunner {
+public:
+  static int main(int argc, char *argv[]) {
+    BenchmarkOptions options;
+    try {
+      options = parse_options(argc, argv);
+    } catch (const std::invalid_argument &e) {
+      std::cerr << e.what() << std::endl << std::endl;
+      print_usage(argv[0]);
+      return 1;
+    }
+    return BenchmarkRunner(options).run();
+  }
+
+  explicit BenchmarkRunner(const BenchmarkOptions &options)
+      : options(options) {}
+
+  int run() {
+    std::vector<BenchmarkResult> cases = expand();
+    if (options.list) {
+      for (const auto &c : cases)
+        std::cout << c.case_name() << std::endl;
+      return 0;
+    }
+
+    std::unique_ptr<PerfCounters> counters;
+    if (options.counters)
+      counters = std::make_unique<PerfCounters>();
+    bool machine_to_stdout = options.format != "text" && options.output.empty();
+    size_t name_width = 40;
+    for (const auto &c : cases)
+      name_width = std::max(name_width, c.case_name().size() + 2);
+    if (!machine_to_stdout) {
+      if (options.counters && !counters->available())
+        std::cout << "硬件计数器不可用（perf_event_open 失败，可检查 "
+                     "/proc/sys/kernel/perf_event_paranoid），只报告时间"
+                  << std::endl;
+      print_header(name_width);
+    }
+
+    bool failed = false;
+    const auto &definitions = BenchmarkRegistry::instance().benchmarks();
+    for (auto &c : cases) {
+      const BenchmarkDefinition *definition = nullptr;
+      for (const auto &d : definitions)
+        if (d->name() == c.name)
+          definition = d.get();
+      BenchmarkState state(options, counters.get(), c);
+      try {
+        definition->function()(state);
+        if (!state.ran)
+          c.error = "benchmark function did not call state.run()";
+      } catch (const std::exception &e) {
+        c.error = e.what();
+      }
+      failed = failed || !c.error.empty();
+      if (!machine_to_stdout)
+        print_row(c, name_width);
+    }
+
+    if (options.format != "text") {
+      std::ofstream file;
+      if (!options.output.empty()) {
+        file.open(options.output);
+        if (!file)
+          throw std::runtime_error("cannot open " + options.output);
+      }
+      std::ostream &out = options.output.empty() ? std::cout : file;
+      if (options.format == "json")
+        write_json(out, cases, counters && counters->available());
+      else
+        write_csv(out, cases);
+    }
+    return failed ? 1 : 0;
+  }
+
+  static BenchmarkOptions parse_options(int argc, char *argv[]) {
+    BenchmarkOptions options;
+    for (int i = 1; i < argc; i++) {
+      std::string arg = argv[i];
+      std::string key = arg, value;
+      size_t eq = arg.find('=');
+      if (eq != std::string::npos) {
+        key = arg.substr(0, eq);
+        value = arg.substr(eq + 1);
+      }
+      if (key == "--filter") {
+        options.filter = value;
+      } else if (key == "--warmup") {
+        options.warmup = parse_size(key, value);
+      } else if (key == "--repetitions") {
+        options.repetitions = std::max<size_t>(1, parse_size(key, value));
+      } else if (key == "--min-sample-ms") {
+        options.min_sample_ms = std::strtod(value.c_str(), nullptr);
+      } else if (key == "--sizes") {
+        options.sizes.clear();
+        for (const auto &item : split(value))
+          options.sizes.push_back(parse_size(key, item));
+      } else if (key == "--distributions") {
+        options.distributions = split(value);
+      } else if (key == "--format") {
+        if (value != "text" && value != "json" && value != "csv")
+          throw std::invalid_argument("unknown format: " + value);
+        options.format = value;
+      } else if (key == "--output") {
+        options.output = value;
+      } else if (key == "--no-counters") {
+        options.counters = false;
+      } else if (key == "--list") {
+        options.list = true;
+      } else {
+        throw std::invalid_argument("unknown option: " + arg);
+      }
+    }
+    return options;
+  }
+
+  static void print_usage(const char *program) {
+    std::cerr
+        << "用法: " << program << " [选项]\n"
+        << "  --filter=<正则>          只运行用例名（名称/分布/规模）匹配的用例\n"
+        << "  --warmup=<n>             预热样本数（默认1）\n"
+        << "  --repetitions=<n>        计入统计的样本数（默认10）\n"
+        << "  --min-sample-ms=<ms>     快速用例批量执行，使每个样本不短于此（默认1）\n"
+        << "  --sizes=<n1,n2,...>      覆盖注册的输入规模\n"
+        << "  --distributions=<d1,...> 覆盖注册的输入分布\n"
+        << "  --format=text|json|csv   输出格式（默认text）\n"
+        << "  --output=<文件>          json/csv 结果写入文件\n"
+        << "  --no-counters            不读取硬件计数器\n"
+        << "  --list                   只列出用例名\n";
+  }
+
+private:
+  BenchmarkOptions options;
+
+  static size_t parse_size(const std::string &key, const std::string &value) {
+    char *end = nullptr;
+    unsigned long long parsed = std::strtoull(value.c_str(), &end, 10);
+    if (value.empty() || *end != '\0')
+      throw std::invalid_argument("invalid value for " + key + ": " + value);
+    return static_cast<size_t>(parsed);
+  }
+
+  static std::vector<std::string> split(const std::string &text) {
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ','))
+      if (!item.empty())
+        items.push_back(item);
+    return items;
+  }
+
+  // 展开为 测试函数 × 分布 × 规模 的用例列表，并按 --filter 筛选
+  std::vector<BenchmarkResult> expand() const {
+    std::regex filter(options.filter.empty() ? ".*" : options.filter);
+    std::vector<BenchmarkResult> cases;
+    for (const auto &d : BenchmarkRegistry::instance().benchmarks()) {
+      std::vector<size_t> sizes = options.sizes.empty() ? d->sizes() : options.sizes;
+      std::vector<std::string> distributions =
+          options.distributions.empty() ? d->distributions()
+                                        : options.distributions;
+      if (sizes.empty())
+        sizes.push_back(0);
+      if (distributions.empty())
+        distributions.push_back("");
+      for (const auto &distribution : distributions) {
+        for (size_t size : sizes) {
+          BenchmarkResult c;
+          c.name = d->name();
+          c.distribution = distribution;
+          c.size = size;
+          if (std::regex_search(c.case_name(), filter))
+            cases.push_back(c);
+        }
+      }
+    }
+    return cases;
+  }
+
+  static std::string format_time(double ns) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(ns < 1e4 ? 1 : 0);
+    if (ns < 1e4)
+      out << ns << " ns";
+    else if (ns < 1e7)
+      out << std::setprecision(1) << ns / 1e3 << " us";
+    else
+      out << std::setprecision(2) << ns / 1e6 << " ms";
+    return out.str();
+  }
+
+  // 按显示宽度右对齐：UTF-8 多字节字符（这里都是汉字）占两列
+  static std::string pad_left(const std::string &text, size_t width) {
+    size_t columns = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+      unsigned char ch = static_cast<unsigned char>(text[i]);
+      if (ch < 0x80)
+        columns += 1;
+      else if (ch >= 0xC0)
+        columns += 2;
+    }
+    return std::string(width > columns ? width - columns : 0, ' ') + text;
+  }
+
+  static void print_header(size_t name_width) {
+    std::cout << "用例" << std::string(name_width - 4, ' ') << pad_left("中位数", 12)
+              << pad_left("p99", 12) << pad_left("波动", 9)
+              << pad_left("吞吐量", 13) << pad_left("周期/元素", 11)
+              << pad_left("缓存未命中", 11) << pad_left("分支失败", 11)
+              << std::endl;
+  }
+
+  static void print_row(const BenchmarkResult &r, size_t name_width) {
+    std::cout << std::left << std::setw(static_cast<int>(name_width))
+              << r.case_name() << std::right;
+    if (!r.error.empty()) {
+      std::cout << "  错误: " << r.error << std::endl;
+      return;
+    }
+    std::cout << std::setw(12) << format_time(r.ns.median) << std::setw(12)
+              << format_time(r.ns.p99) << std::fixed << std::setprecision(1)
+              << std::setw(8)
+              << (r.ns.mean > 0 ? 100 * r.ns.stddev / r.ns.mean : 0) << "%";
+    double per = r.items_per_iteration > 0 ? r.items_per_iteration : 1;
+    if (r.items_per_iteration > 0)
+      std::cout << std::setw(9) << std::setprecision(1)
+                << r.items_per_iteration * 1e3 / r.ns.median << " M/s";
+    else if (r.bytes_per_iteration > 0)
+      std::cout << std::setw(8) << std::setprecision(1)
+                << r.bytes_per_iteration * 1e9 / r.ns.median / 1048576
+                << " MB/s";
+    else
+      std::cout << std::setw(13) << "-";
+    if (r.counters.available)
+      std::cout << std::setprecision(2) << std::setw(11)
+                << r.counters.cycles / per << std::setw(11)
+                << r.counters.cache_misses / per << std::setw(11)
+                << r.counters.branch_misses / per;
+    std::cout << std::endl;
+  }
+
+  static std::string revision() {
+#ifdef ALGORITHMS_GIT_REVISION
+    return ALGORITHMS_GIT_REVISION;
+#else
+    return "unknown";
+#endif
+  }
+
+  static std::string escape(const std::string &text) {
+    std::string out;
+    for (char ch : text) {
+      if (ch == '"' || ch == '\\') {
+        out += '\\';
+        out += ch;
+      } else if (static_cast<unsigned char>(ch) < 0x20) {
+        out += ' ';
+      } else {
+        out += ch;
+      }
+    }
+    return out;
+  }
+
+  static std::string utc_timestamp() {
+    std::time_t now = std::time(nullptr);
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ",
+                  std::gmtime(&now));
+    return buffer;
+  }
+
+  static void write_json(std::ostream &out,
+                         const std::vector<BenchmarkResult> &results,
+                         bool counters) {
+    out << std::setprecision(6);
+    out << "{\n  \"context\": {\"revision\": \"" << escape(revision())
+        << "\", \"date\": \"" << utc_timestamp() << "\", \"compiler\": \""
+#ifdef __VERSION__
+        << escape(__VERSION__)
+#endif
+        << "\", \"hardware_threads\": " << std::thread::hardware_concurrency()
+        << ", \"perf_counters\": " << (counters ? "true" : "false")
+        << "},\n  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+      const BenchmarkResult &r = results[i];
+      out << (i ? "," : "") << "\n    {\"name\": \"" << escape(r.case_name())
+          << "\", \"benchmark\": \"" << escape(r.name)
+          << "\", \"distribution\": \"" << escape(r.distribution)
+          << "\", \"size\": " << r.size;
+      if (!r.error.empty()) {
+        out << ", \"error\": \"" << escape(r.error) << "\"}";
+        continue;
+      }
+      if (!r.label.empty())
+        out << ", \"label\": \"" << escape(r.label) << "\"";
+      out << ", \"repetitions\": " << r.repetitions
+          << ", \"iterations_per_sample\": " << r.iterations_per_sample
+          << ", \"median_ns\": " << r.ns.median << ", \"mean_ns\": " << r.ns.mean
+          << ", \"p99_ns\": " << r.ns.p99 << ", \"min_ns\": " << r.ns.min
+          << ", \"max_ns\": " << r.ns.max << ", \"stddev_ns\": " << r.ns.stddev
+          << ", \"items_per_iteration\": " << r.items_per_iteration
+          << ", \"bytes_per_iteration\": " << r.bytes_per_iteration;
+      if (r.counters.available)
+        out << ", \"cycles\": " << r.counters.cycles
+            << ", \"instructions\": " << r.counters.instructions
+            << ", \"cache_misses\": " << r.counters.cache_misses
+            << ", \"branch_misses\": " << r.counters.branch_misses;
+      out << ", \"samples_ns\": [";
+      for (size_t s = 0; s < r.samples_ns.size(); s++)
+        out << (s ? ", " : "") << r.samples_ns[s];
+      out << "]}";
+    }
+    out << "\n  ]\n}\n";
+  }
+
+  // 每行自带版本号，多次提交的结果可直接拼接比较
+  static void write_csv(std::ostream &out,
+                        const std::vector<BenchmarkResult> &results) {
+    out << std::setprecision(6);
+    out << "revision,name,distribution,size,repetitions,median_ns,mean_ns,"
+           "p99_ns,min_ns,max_ns,stddev_ns,items_per_iteration,cycles,"
+           "instructions,cache_misses,branch_misses,error\n";
+    for (const BenchmarkResult &r : results) {
+      out << revision() << "," << r.name << "," << r.distribution << ","
+          << r.size << "," << r.repetitions << "," << r.ns.median << ","
+          << r.ns.mean << "," << r.ns.p99 << "," << r.ns.min << "," << r.ns.max
+          << "," << r.ns.stddev << "," << r.items_per_iteration << ",";
+      if (r.counters.available)
+        out << r.counters.cycles << "," << r.counters.instructions << ","
+            << r.counters.cache_misses << "," << r.counters.branch_misses;
+      else
+        out << ",,,";
+      out << ",\"" << escape(r.error) << "\"\n";
+    }
+  }
+};
+
+} // namespace algorithms
+
+#define ALGORITHMS_BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define ALGORITHMS_BENCHMARK_CONCAT(a, b) ALGORITHMS_BENCHMARK_CONCAT_IMPL(a, b)
+
+/**
+ * 注册测试函数 void func(algorithms::BenchmarkState &)，可链式指定参数：
+ *   ALGORITHMS_BENCHMARK(bench_sort).sizes({1 << 10, 1 << 20}).distributions({"random"});
+ */
+#define ALGORITHMS_BENCHMARK(func)                                             \
+  static ::algorithms::BenchmarkDefinition &ALGORITHMS_BENCHMARK_CONCAT(       \
+      algorithms_benchmark_registration_, __LINE__) =                          \
+      ::algorithms::BenchmarkRegistry::instance().add(#func, func)
+
+// 定义以 BenchmarkRunner 运行全部注册用例的 main 函数
+#define ALGORITHMS_BENCHMARK_MAIN()                                            \
+  int main(int argc, char *argv[]) {                                           \
+    try {                                                                      \
+      return ::algorithms::BenchmarkRunner::main(argc, argv);                  \
+    } catch (const std::exception &e) {                                        \
+      std::cerr << e.what() << std::endl;                                      \
+      return 1;                                                                \
+    }                                                                          \
+  }
+
+#endif // BENCHMARK_HARNESS_H
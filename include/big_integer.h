@@ -0,0 +1,1044 @@
+#ifndef BIG_INTEGER_H
+#define BIG_INTEGER_H
+
+#include "number_theoretic_transform.h"
+#include "number_theory_algorithms.h"
+#include "primality.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+
+/**
+ * @brief 任意精度整数（算法导论第31章的大整数运算）
+ *
+ * 符号与绝对值分开存放，绝对值是64位字（limb）的数组，低位在前，没有前导零；
+ * 0 的数组为空且符号为正。除法向零截断，余数与被除数同号（与内置整数相同）。
+ *
+ * 乘法按较短操作数的字数选择算法：
+ * - 少于 kKaratsubaThreshold 个字：逐字相乘（128位中间结果）
+ * - 少于 kNTTThreshold 个字：Karatsuba，三次递归乘法代替四次，O(n^1.585)；
+ *   两数长度相差一倍以上时把长的切成与短的等长的段
+ * - 更长：拆成16位数字后用 ExactConvolution（三素数NTT）做卷积，O(n lg n)
+ * 除法为 Knuth 算法D。模幂见 MontgomeryContext。
+ */
+class BigInteger {
+public:
+  using Limb = uint64_t;
+  using Magnitude = std::vector<Limb>;
+
+  static constexpr size_t kKaratsubaThreshold = 32;
+  static constexpr size_t kNTTThreshold = 3072;
+
+  BigInteger() = default;
+
+  BigInteger(long long value) : negative(value < 0) {
+    unsigned long long magnitude_value =
+        value < 0 ? 0ull - static_cast<unsigned long long>(value)
+                  : static_cast<unsigned long long>(value);
+    if (magnitude_value != 0)
+      magnitude.push_back(magnitude_value);
+  }
+
+  // 解析十进制或十六进制（base = 16，不带 0x 前缀）字符串，可带负号
+  explicit BigInteger(const std::string &text, int base = 10) {
+    if (base != 10 && base != 16) {
+      throw std::invalid_argument("BigInteger: base must be 10 or 16");
+    }
+    size_t i = 0;
+    bool is_negative = false;
+    if (i < text.size() && (text[i] == '-' || text[i] == '+')) {
+      is_negative = text[i] == '-';
+      i++;
+    }
+    if (i == text.size()) {
+      throw std::invalid_argument("BigInteger: empty number");
+    }
+    // 每次吸收若干位：十进制19位、十六进制15位都不会让乘数溢出
+    const size_t chunk = base == 10 ? 19 : 15;
+    for (; i < text.size(); i += chunk) {
+      size_t end = std::min(text.size(), i + chunk);
+      Limb value = 0, scale = 1;
+      for (size_t j = i; j < end; j++) {
+        int digit = digit_value(text[j]);
+        if (digit < 0 || digit >= base) {
+          throw std::invalid_argument("BigInteger: invalid digit");
+        }
+        value = value * base + digit;
+        scale *= base;
+      }
+      multiply_small(magnitude, scale);
+      add_small(magnitude, value);
+    }
+    negative = is_negative && !magnitude.empty();
+  }
+
+  static BigInteger from_magnitude(Magnitude limbs, bool is_negative = false) {
+    BigInteger result;
+    result.magnitude = std::move(limbs);
+    trim(result.magnitude);
+    result.negative = is_negative && !result.magnitude.empty();
+    return result;
+  }
+
+  std::string to_string(int base = 10) const {
+    if (base != 10 && base != 16) {
+      throw std::invalid_argument("BigInteger: base must be 10 or 16");
+    }
+    if (magnitude.empty())
+      return "0";
+    std::string digits;
+    if (base == 16) {
+      for (Limb limb : magnitude) {
+        for (int k = 0; k < 16; k++) {
+          digits.push_back("0123456789abcdef"[(limb >> (4 * k)) & 15]);
+        }
+      }
+    } else {
+      // 每次除以 10^19，得到19位十进制数字
+      const Limb chunk = 10000000000000000000ull;
+      Magnitude rest = magnitude;
+      while (!rest.empty()) {
+        Limb remainder = divide_small(rest, chunk);
+        for (int k = 0; k < 19; k++) {
+          digits.push_back(static_cast<char>('0' + remainder % 10));
+          remainder /= 10;
+        }
+      }
+    }
+    while (digits.size() > 1 && digits.back() == '0') {
+      digits.pop_back();
+    }
+    if (negative)
+      digits.push_back('-');
+    std::reverse(digits.begin(), digits.end());
+    return digits;
+  }
+
+  bool is_zero() const { return magnitude.empty(); }
+
+  bool is_negative() const { return negative; }
+
+  bool is_odd() const { return !magnitude.empty() && (magnitude[0] & 1); }
+
+  int sign() const { return magnitude.empty() ? 0 : (negative ? -1 : 1); }
+
+  // 绝对值的字数组（低位在前）
+  const Magnitude &limbs() const { return magnitude; }
+
+  // 绝对值的二进制位数，0 为0
+  size_t bit_length() const {
+    if (magnitude.empty())
+      return 0;
+    return 64 * magnitude.size() - __builtin_clzll(magnitude.back());
+  }
+
+  // 绝对值的第 i 位
+  bool test_bit(size_t i) const {
+    return i / 64 < magnitude.size() && ((magnitude[i / 64] >> (i % 64)) & 1);
+  }
+
+  BigInteger abs() const { return from_magnitude(magnitude); }
+
+  BigInteger operator-() const {
+    BigInteger result = *this;
+    result.negative = !negative && !magnitude.empty();
+    return result;
+  }
+
+  BigInteger &operator+=(const BigInteger &other) {
+    if (negative == other.negative) {
+      add_into(magnitude, other.magnitude, 0);
+    } else if (compare(magnitude, other.magnitude) >= 0) {
+      subtract_into(magnitude, other.magnitude);
+    } else {
+      Magnitude result = other.magnitude;
+      subtract_into(result, magnitude);
+      magnitude = std::move(result);
+      negative = other.negative;
+    }
+    if (magnitude.empty())
+      negative = false;
+    return *this;
+  }
+
+  BigInteger &operator-=(const BigInteger &other) { return *this += -other; }
+
+  BigInteger &operator*=(const BigInteger &other) {
+    return *this = *this * other;
+  }
+
+  BigInteger &operator/=(const BigInteger &other) {
+    return *this = *this / other;
+  }
+
+  BigInteger &operator%=(const BigInteger &other) {
+    return *this = *this % other;
+  }
+
+  BigInteger &operator<<=(size_t bits) {
+    magnitude = shift_left(magnitude, bits);
+    return *this;
+  }
+
+  BigInteger &operator>>=(size_t bits) {
+    magnitude = shift_right(magnitude, bits);
+    if (magnitude.empty())
+      negative = false;
+    return *this;
+  }
+
+  friend BigInteger operator+(BigInteger a, const BigInteger &b) {
+    return a += b;
+  }
+
+  friend BigInteger operator-(BigInteger a, const BigInteger &b) {
+    return a -= b;
+  }
+
+  friend BigInteger operator*(const BigInteger &a, const BigInteger &b) {
+    return from_magnitude(multiply(a.magnitude, b.magnitude),
+                          a.negative != b.negative);
+  }
+
+  friend BigInteger operator/(const BigInteger &a, const BigInteger &b) {
+    BigInteger quotient, remainder;
+    divide(a, b, quotient, remainder);
+    return quotient;
+  }
+
+  friend BigInteger operator%(const BigInteger &a, const BigInteger &b) {
+    BigInteger quotient, remainder;
+    divide(a, b, quotient, remainder);
+    return remainder;
+  }
+
+  // 绝对值移位，符号不变
+  friend BigInteger operator<<(BigInteger a, size_t bits) { return a <<= bits; }
+
+  friend BigInteger operator>>(BigInteger a, size_t bits) { return a >>= bits; }
+
+  friend bool operator==(const BigInteger &a, const BigInteger &b) {
+    return a.negative == b.negative && a.magnitude == b.magnitude;
+  }
+
+  friend bool operator!=(const BigInteger &a, const BigInteger &b) {
+    return !(a == b);
+  }
+
+  friend bool operator<(const BigInteger &a, const BigInteger &b) {
+    if (a.negative != b.negative)
+      return a.negative;
+    int c = compare(a.magnitude, b.magnitude);
+    return a.negative ? c > 0 : c < 0;
+  }
+
+  friend bool operator>(const BigInteger &a, const BigInteger &b) {
+    return b < a;
+  }
+
+  friend bool operator<=(const BigInteger &a, const BigInteger &b) {
+    return !(b < a);
+  }
+
+  friend bool operator>=(const BigInteger &a, const BigInteger &b) {
+    return !(a < b);
+  }
+
+  friend std::ostream &operator<<(std::ostream &os, const BigInteger &x) {
+    return os << x.to_string();
+  }
+
+  /**
+   * @brief 截断除法：a = q·b + r，|r| < |b|，r 与 a 同号
+   */
+  static void divide(const BigInteger &a, const BigInteger &b,
+                     BigInteger &quotient, BigInteger &remainder) {
+    if (b.is_zero()) {
+      throw std::domain_error("BigInteger: division by zero");
+    }
+    Magnitude q, r;
+    divide_magnitude(a.magnitude, b.magnitude, q, r);
+    quotient = from_magnitude(std::move(q), a.negative != b.negative);
+    remainder = from_magnitude(std::move(r), a.negative);
+  }
+
+  // a mod m，结果在 [0, |m|)
+  static BigInteger mod(const BigInteger &a, const BigInteger &m) {
+    BigInteger r = a % m;
+    if (r.negative)
+      r += m.abs();
+    return r;
+  }
+
+  static BigInteger gcd(BigInteger a, BigInteger b) {
+    a = a.abs();
+    b = b.abs();
+    while (!b.is_zero()) {
+      BigInteger r = a % b;
+      a = std::move(b);
+      b = std::move(r);
+    }
+    return a;
+  }
+
+  // a 模 m 的乘法逆元（扩展欧几里得），不存在时抛出异常
+  static BigInteger mod_inverse(const BigInteger &a, const BigInteger &m) {
+    if (m.sign() <= 0) {
+      throw std::invalid_argument("BigInteger: modulus must be positive");
+    }
+    BigInteger old_r = mod(a, m), r = m, old_x = 1, x = 0;
+    while (!r.is_zero()) {
+      BigInteger q, next_r;
+      divide(old_r, r, q, next_r);
+      old_r = std::move(r);
+      r = std::move(next_r);
+      BigInteger next_x = old_x - q * x;
+      old_x = std::move(x);
+      x = std::move(next_x);
+    }
+    if (old_r != 1) {
+      throw std::domain_error("BigInteger: inverse does not exist");
+    }
+    return mod(old_x, m);
+  }
+
+  /**
+   * @brief base^exponent mod modulus（exponent ≥ 0，modulus > 0）
+   *
+   * 奇数模数用 MontgomeryContext；constant_time 为真时使用固定窗口、
+   * 访问模式与指数无关的版本（见 MontgomeryContext::pow）。偶数模数用普通的
+   * 平方-乘法与除法，不提供常数时间保证。
+   */
+  static BigInteger pow_mod(const BigInteger &base, const BigInteger &exponent,
+                            const BigInteger &modulus,
+                            bool constant_time = false);
+
+  // 0 ≤ x < 2^bits 的均匀随机数
+  template <typename Random>
+  static BigInteger random_bits(size_t bits, Random &gen) {
+    std::uniform_int_distribution<Limb> limb;
+    Magnitude result((bits + 63) / 64);
+    for (Limb &x : result) {
+      x = limb(gen);
+    }
+    if (bits % 64 != 0)
+      result.back() &= (Limb(1) << (bits % 64)) - 1;
+    return from_magnitude(std::move(result));
+  }
+
+  // 0 ≤ x < n 的均匀随机数（拒绝采样）
+  template <typename Random>
+  static BigInteger random_below(const BigInteger &n, Random &gen) {
+    if (n.sign() <= 0) {
+      throw std::invalid_argument("BigInteger: bound must be positive");
+    }
+    size_t bits = n.bit_length();
+    while (true) {
+      BigInteger x = random_bits(bits, gen);
+      if (x < n)
+        return x;
+    }
+  }
+
+  // 小素数试除后做 rounds 轮 Miller–Rabin 测试
+  template <typename Random>
+  static bool is_probable_prime(const BigInteger &n, int rounds, Random &gen);
+
+  // 恰好 bits 位的随机素数，最高两位为1（两个这样的素数相乘恰好 2·bits 位）
+  template <typename Random>
+  static BigInteger generate_prime(size_t bits, Random &gen);
+
+  // 各乘法算法，供测试和基准程序直接调用
+  static Magnitude multiply(const Magnitude &a, const Magnitude &b) {
+    size_t shorter = std::min(a.size(), b.size());
+    if (shorter == 0)
+      return {};
+    if (shorter < kKaratsubaThreshold)
+      return multiply_schoolbook(a, b);
+    if (shorter < kNTTThreshold ||
+        2 * 4 * (a.size() + b.size()) > ExactConvolution::max_result_size)
+      return multiply_karatsuba(a, b);
+    return multiply_ntt(a, b);
+  }
+
+  static Magnitude multiply_schoolbook(const Magnitude &a, const Magnitude &b) {
+    if (a.empty() || b.empty())
+      return {};
+    Magnitude result(a.size() + b.size(), 0);
+    multiply_add(a.data(), a.size(), b.data(), b.size(), result.data());
+    trim(result);
+    return result;
+  }
+
+  static Magnitude multiply_karatsuba(const Magnitude &a, const Magnitude &b) {
+    if (a.empty() || b.empty())
+      return {};
+    Magnitude result(a.size() + b.size(), 0);
+    karatsuba(a.data(), a.size(), b.data(), b.size(), result.data(), result.size());
+    trim(result);
+    return result;
+  }
+
+  static Magnitude multiply_ntt(const Magnitude &a, const Magnitude &b) {
+    if (a.empty() || b.empty())
+      return {};
+    std::vector<uint32_t> digits = ExactConvolution::multiply_integers(
+        to_digits(a), to_digits(b), 1u << 16);
+    Magnitude result((digits.size() + 3) / 4, 0);
+    for (size_t i = 0; i < digits.size(); i++) {
+      result[i / 4] |= Limb(digits[i]) << (16 * (i % 4));
+    }
+    trim(result);
+    return result;
+  }
+
+private:
+  friend class MontgomeryContext;
+
+  bool negative = false;
+  Magnitude magnitude;
+
+  static int digit_value(char c) {
+    if (c >= '0' && c <= '9')
+      return c - '0';
+    if (c >= 'a' && c <= 'f')
+      return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+      return c - 'A' + 10;
+    return -1;
+  }
+
+  static void trim(Magnitude &a) {
+    while (!a.empty() && a.back() == 0) {
+      a.pop_back();
+    }
+  }
+
+  static int compare(const Magnitude &a, const Magnitude &b) {
+    if (a.size() != b.size())
+      return a.size() < b.size() ? -1 : 1;
+    for (size_t i = a.size(); i-- > 0;) {
+      if (a[i] != b[i])
+        return a[i] < b[i] ? -1 : 1;
+    }
+    return 0;
+  }
+
+  // a += b·2^(64·offset)
+  static void add_into(Magnitude &a, const Magnitude &b, size_t offset) {
+    if (a.size() < b.size() + offset)
+      a.resize(b.size() + offset, 0);
+    unsigned char carry = 0;
+    size_t i = 0;
+    for (; i < b.size(); i++) {
+      carry = __builtin_add_overflow(a[i + offset], carry, &a[i + offset]) |
+              __builtin_add_overflow(a[i + offset], b[i], &a[i + offset]);
+    }
+    for (i += offset; carry && i < a.size(); i++) {
+      carry = __builtin_add_overflow(a[i], 1, &a[i]);
+    }
+    if (carry)
+      a.push_back(1);
+  }
+
+  // a -= b，要求 a ≥ b
+  static void subtract_into(Magnitude &a, const Magnitude &b) {
+    unsigned char borrow = 0;
+    size_t i = 0;
+    for (; i < b.size(); i++) {
+      borrow = __builtin_sub_overflow(a[i], borrow, &a[i]) |
+               __builtin_sub_overflow(a[i], b[i], &a[i]);
+    }
+    for (; borrow && i < a.size(); i++) {
+      borrow = __builtin_sub_overflow(a[i], 1, &a[i]);
+    }
+    trim(a);
+  }
+
+  static void multiply_small(Magnitude &a, Limb m) {
+    Limb carry = 0;
+    for (Limb &x : a) {
+      unsigned __int128 t = static_cast<unsigned __int128>(x) * m + carry;
+      x = static_cast<Limb>(t);
+      carry = static_cast<Limb>(t >> 64);
+    }
+    if (carry)
+      a.push_back(carry);
+    trim(a);
+  }
+
+  static void add_small(Magnitude &a, Limb value) {
+    add_into(a, Magnitude{value}, 0);
+    trim(a);
+  }
+
+  // a /= d，返回余数
+  static Limb divide_small(Magnitude &a, Limb d) {
+    unsigned __int128 remainder = 0;
+    for (size_t i = a.size(); i-- > 0;) {
+      unsigned __int128 t = (remainder << 64) | a[i];
+      a[i] = static_cast<Limb>(t / d);
+      remainder = t % d;
+    }
+    trim(a);
+    return static_cast<Limb>(remainder);
+  }
+
+  // 2000 以内的素数，用于试除与生成素数时的预筛
+  static const std::vector<Limb> &small_primes() {
+    static const std::vector<Limb> primes = [] {
+      std::vector<Limb> result;
+      SegmentedSieve::for_each_prime(2, 2000,
+                                     [&](uint64_t p) { result.push_back(p); });
+      return result;
+    }();
+    return primes;
+  }
+
+  static Limb mod_small(const Magnitude &a, Limb d) {
+    unsigned __int128 remainder = 0;
+    for (size_t i = a.size(); i-- > 0;) {
+      remainder = ((remainder << 64) | a[i]) % d;
+    }
+    return static_cast<Limb>(remainder);
+  }
+
+  static Magnitude shift_left(const Magnitude &a, size_t bits) {
+    if (a.empty())
+      return {};
+    size_t words = bits / 64, shift = bits % 64;
+    Magnitude result(a.size() + words + 1, 0);
+    for (size_t i = 0; i < a.size(); i++) {
+      result[i + words] |= a[i] << shift;
+      if (shift != 0)
+        result[i + words + 1] = a[i] >> (64 - shift);
+    }
+    trim(result);
+    return result;
+  }
+
+  static Magnitude shift_right(const Magnitude &a, size_t bits) {
+    size_t words = bits / 64, shift = bits % 64;
+    if (words >= a.size())
+      return {};
+    Magnitude result(a.size() - words);
+    for (size_t i = 0; i < result.size(); i++) {
+      result[i] = a[i + words] >> shift;
+      if (shift != 0 && i + words + 1 < a.size())
+        result[i] |= a[i + words + 1] << (64 - shift);
+    }
+    trim(result);
+    return result;
+  }
+
+  // out[0, na + nb) += a·b（out 至少有 na + nb 个字，进位不会越界）
+  static void multiply_add(const Limb *a, size_t na, const Limb *b, size_t nb,
+                           Limb *out) {
+    for (size_t j = 0; j < nb; j++) {
+      Limb carry = 0;
+      for (size_t i = 0; i < na; i++) {
+        unsigned __int128 t = static_cast<unsigned __int128>(a[i]) * b[j] +
+                              out[i + j] + carry;
+        out[i + j] = static_cast<Limb>(t);
+        carry = static_cast<Limb>(t >> 64);
+      }
+      for (size_t k = j + na; carry; k++) {
+        carry = __builtin_add_overflow(out[k], carry, &out[k]);
+      }
+    }
+  }
+
+  // out[0, n) += a·b，Karatsuba 递归。n ≥ na + nb 是 out 到整个结果末尾的字数：
+  // out 已有数据时，进位可能越过 na + nb，必须一直传到真正的末尾
+  static void karatsuba(const Limb *a, size_t na, const Limb *b, size_t nb,
+                        Limb *out, size_t n) {
+    if (na < nb) {
+      std::swap(a, b);
+      std::swap(na, nb);
+    }
+    if (nb < kKaratsubaThreshold) {
+      multiply_add(a, na, b, nb, out);
+      return;
+    }
+    if (na >= 2 * nb) {
+      // 长度悬殊：把 a 切成长度为 nb 的段，各段的积叠加在前一段的高位上
+      for (size_t offset = 0; offset < na; offset += nb) {
+        karatsuba(a + offset, std::min(nb, na - offset), b, nb, out + offset,
+                  n - offset);
+      }
+      return;
+    }
+    // a = a1·B^m + a0，b = b1·B^m + b0，nb > m
+    size_t m = na / 2;
+    Magnitude z0(2 * m, 0), z2(na + nb - 2 * m, 0);
+    karatsuba(a, m, b, m, z0.data(), z0.size());
+    karatsuba(a + m, na - m, b + m, nb - m, z2.data(), z2.size());
+    Magnitude sa(a, a + m), sb(b, b + m);
+    add_into(sa, Magnitude(a + m, a + na), 0);
+    add_into(sb, Magnitude(b + m, b + nb), 0);
+    Magnitude z1(sa.size() + sb.size(), 0);
+    karatsuba(sa.data(), sa.size(), sb.data(), sb.size(), z1.data(), z1.size());
+    trim(z1);
+    trim(z0);
+    trim(z2);
+    subtract_into(z1, z0);
+    subtract_into(z1, z2);
+    add_to(out, n, z0, 0);
+    add_to(out, n, z1, m);
+    add_to(out, n, z2, 2 * m);
+  }
+
+  // out[0, n) += x·B^offset（结果不超过 n 个字）
+  static void add_to(Limb *out, size_t n, const Magnitude &x, size_t offset) {
+    unsigned char carry = 0;
+    size_t i = 0;
+    for (; i < x.size(); i++) {
+      carry = __builtin_add_overflow(out[i + offset], carry, &out[i + offset]) |
+              __builtin_add_overflow(out[i + offset], x[i], &out[i + offset]);
+    }
+    for (i += offset; carry && i < n; i++) {
+      carry = __builtin_add_overflow(out[i], 1, &out[i]);
+    }
+  }
+
+  static std::vector<uint32_t> to_digits(const Magnitude &a) {
+    std::vector<uint32_t> digits(4 * a.size());
+    for (size_t i = 0; i < digits.size(); i++) {
+      digits[i] = static_cast<uint32_t>((a[i / 4] >> (16 * (i % 4))) & 0xffff);
+    }
+    while (digits.size() > 1 && digits.back() == 0) {
+      digits.pop_back();
+    }
+    return digits;
+  }
+
+  // Knuth 算法D：u = q·v + r
+  static void divide_magnitude(const Magnitude &u, const Magnitude &v,
+                               Magnitude &q, Magnitude &r) {
+    if (compare(u, v) < 0) {
+      q.clear();
+      r = u;
+      return;
+    }
+    if (v.size() == 1) {
+      q = u;
+      Limb remainder = divide_small(q, v[0]);
+      r.clear();
+      if (remainder != 0)
+        r.push_back(remainder);
+      return;
+    }
+    // 规范化：除数最高字的最高位为1
+    int shift = __builtin_clzll(v.back());
+    Magnitude vn = shift_left(v, shift);
+    Magnitude un = shift_left(u, shift);
+    un.resize(u.size() + 1, 0);
+    size_t n = vn.size(), m = un.size() - n;
+    q.assign(m, 0);
+    const unsigned __int128 base = static_cast<unsigned __int128>(1) << 64;
+    for (size_t j = m; j-- > 0;) {
+      unsigned __int128 numerator =
+          (static_cast<unsigned __int128>(un[j + n]) << 64) | un[j + n - 1];
+      unsigned __int128 qhat = numerator / vn[n - 1];
+      unsigned __int128 rhat = numerator % vn[n - 1];
+      while (qhat >= base ||
+             qhat * vn[n - 2] > ((rhat << 64) | un[j + n - 2])) {
+        qhat--;
+        rhat += vn[n - 1];
+        if (rhat >= base)
+          break;
+      }
+      // un[j, j + n] -= qhat·vn
+      Limb borrow = 0, carry = 0;
+      for (size_t i = 0; i < n; i++) {
+        unsigned __int128 p = qhat * vn[i] + carry;
+        carry = static_cast<Limb>(p >> 64);
+        Limb low = static_cast<Limb>(p);
+        unsigned char b1 = __builtin_sub_overflow(un[i + j], low, &un[i + j]);
+        unsigned char b2 = __builtin_sub_overflow(un[i + j], borrow, &un[i + j]);
+        borrow = b1 + b2;
+      }
+      unsigned char b1 = __builtin_sub_overflow(un[j + n], carry, &un[j + n]);
+      unsigned char b2 = __builtin_sub_overflow(un[j + n], borrow, &un[j + n]);
+      if (b1 || b2) {
+        // qhat 大了1：加回
+        qhat--;
+        unsigned char c = 0;
+        for (size_t i = 0; i < n; i++) {
+          c = __builtin_add_overflow(un[i + j], c, &un[i + j]) |
+              __builtin_add_overflow(un[i + j], vn[i], &un[i + j]);
+        }
+        un[j + n] += c;
+      }
+      q[j] = static_cast<Limb>(qhat);
+    }
+    trim(q);
+    un.resize(n);
+    r = shift_right(un, shift);
+  }
+};
+
+/**
+ * @brief 奇数模数 n 上的Montgomery乘法与模幂
+ *
+ * 取 R = 2^(64k)（k 为 n 的字数），x 的Montgomery形式为 xR mod n。
+ * 乘法 REDC(a·b) = abR^{-1} mod n 用逐字交替的乘加与约减（CIOS）完成，
+ * 只需乘法和加法，不需要除法；最后的条件减法用掩码选择，没有分支。
+ * pow 的两种模式：
+ * - 默认：滑动窗口，窗口宽度按指数位数取1~6，只预计算奇数次幂，跳过连续的0位
+ * - constant_time：固定4位窗口，处理的窗口数只取决于模数的字数；每次取表项都
+ *   扫描整张表并用掩码选择，平方与乘法的次数、访存地址都与指数无关
+ */
+class MontgomeryContext {
+public:
+  using Limb = BigInteger::Limb;
+  using Magnitude = BigInteger::Magnitude;
+
+  explicit MontgomeryContext(const BigInteger &modulus_value)
+      : modulus(modulus_value.magnitude), k(modulus.size()) {
+    if (modulus_value.is_negative() || !modulus_value.is_odd() ||
+        modulus_value == 1) {
+      throw std::invalid_argument("Montgomery modulus must be odd and > 1");
+    }
+    // 牛顿迭代求 n^{-1} mod 2^64，每次有效位数翻倍
+    Limb inverse = modulus[0];
+    for (int i = 0; i < 6; i++) {
+      inverse *= 2 - modulus[0] * inverse;
+    }
+    neg_inverse = 0 - inverse;
+    BigInteger r2 = BigInteger(1) << (128 * k);
+    r_squared = to_fixed(r2 % modulus_value);
+    one = to_fixed((BigInteger(1) << (64 * k)) % modulus_value);
+  }
+
+  size_t limb_count() const { return k; }
+
+  // x·R mod n
+  Magnitude to_montgomery(const BigInteger &x) const {
+    Magnitude result(k);
+    multiply(to_fixed(BigInteger::mod(x, BigInteger::from_magnitude(modulus))),
+             r_squared, result);
+    return result;
+  }
+
+  BigInteger from_montgomery(const Magnitude &x) const {
+    Magnitude unit(k, 0), result(k);
+    unit[0] = 1;
+    multiply(x, unit, result);
+    return BigInteger::from_magnitude(result);
+  }
+
+  // out = a·b·R^{-1} mod n，a、b、out 都是 k 个字，out 可以与 a、b 相同
+  void multiply(const Magnitude &a, const Magnitude &b, Magnitude &out) const {
+    Limb *t = scratch(k + 2);
+    std::fill(t, t + k + 2, 0);
+    for (size_t i = 0; i < k; i++) {
+      Limb carry = 0;
+      for (size_t j = 0; j < k; j++) {
+        unsigned __int128 s =
+            static_cast<unsigned __int128>(a[j]) * b[i] + t[j] + carry;
+        t[j] = static_cast<Limb>(s);
+        carry = static_cast<Limb>(s >> 64);
+      }
+      unsigned __int128 s = static_cast<unsigned __int128>(t[k]) + carry;
+      t[k] = static_cast<Limb>(s);
+      t[k + 1] = static_cast<Limb>(s >> 64);
+
+      Limb m = t[0] * neg_inverse;
+      s = static_cast<unsigned __int128>(m) * modulus[0] + t[0];
+      carry = static_cast<Limb>(s >> 64);
+      for (size_t j = 1; j < k; j++) {
+        s = static_cast<unsigned __int128>(m) * modulus[j] + t[j] + carry;
+        t[j - 1] = static_cast<Limb>(s);
+        carry = static_cast<Limb>(s >> 64);
+      }
+      s = static_cast<unsigned __int128>(t[k]) + carry;
+      t[k - 1] = static_cast<Limb>(s);
+      t[k] = t[k + 1] + static_cast<Limb>(s >> 64);
+    }
+    // t < 2n：无分支地在 t 与 t - n 之间选择
+    Limb *difference = t + k + 2;
+    unsigned char borrow = 0;
+    for (size_t j = 0; j < k; j++) {
+      borrow = __builtin_sub_overflow(t[j], borrow, &difference[j]) |
+               __builtin_sub_overflow(difference[j], modulus[j], &difference[j]);
+    }
+    // t[k] 为1时 t ≥ R > n，一定要减
+    Limb keep = 0 - static_cast<Limb>(borrow & (t[k] == 0));
+    out.resize(k);
+    for (size_t j = 0; j < k; j++) {
+      out[j] = (t[j] & keep) | (difference[j] & ~keep);
+    }
+  }
+
+  /**
+   * @brief base^exponent mod n（exponent ≥ 0）
+   *
+   * @param constant_time 为真时使用固定窗口与整表扫描，适合私钥运算；
+   *        此时要求 exponent < 2^(64k)
+   */
+  BigInteger pow(const BigInteger &base, const BigInteger &exponent,
+                 bool constant_time = false) const {
+    if (exponent.is_negative()) {
+      throw std::invalid_argument("exponent must be non-negative");
+    }
+    Magnitude x = to_montgomery(base);
+    Magnitude result =
+        constant_time ? pow_fixed_window(x, exponent) : pow_sliding(x, exponent);
+    return from_montgomery(result);
+  }
+
+private:
+  static constexpr int kFixedWindow = 4;
+
+  Magnitude modulus;
+  size_t k;
+  Limb neg_inverse; // -n^{-1} mod 2^64
+  Magnitude r_squared, one; // R² mod n，R mod n（1的Montgomery形式）
+  mutable std::vector<Limb> workspace;
+
+  Limb *scratch(size_t n) const {
+    if (workspace.size() < 2 * n)
+      workspace.resize(2 * n);
+    return workspace.data();
+  }
+
+  Magnitude to_fixed(const BigInteger &x) const {
+    Magnitude result = x.magnitude;
+    result.resize(k, 0);
+    return result;
+  }
+
+  Magnitude pow_sliding(const Magnitude &x, const BigInteger &exponent) const {
+    size_t bits = exponent.bit_length();
+    if (bits == 0)
+      return one;
+    int window = bits > 671 ? 6 : bits > 239 ? 5 : bits > 79 ? 4 : bits > 23 ? 3
+                                                                 : bits > 6 ? 2
+                                                                             : 1;
+    // odd[i] = x^(2i+1)
+    std::vector<Magnitude> odd(size_t(1) << (window - 1));
+    odd[0] = x;
+    Magnitude square(k);
+    multiply(x, x, square);
+    for (size_t i = 1; i < odd.size(); i++) {
+      odd[i].resize(k);
+      multiply(odd[i - 1], square, odd[i]);
+    }
+    Magnitude result = one;
+    bool started = false;
+    for (size_t i = bits; i-- > 0;) {
+      if (!exponent.test_bit(i)) {
+        if (started)
+          multiply(result, result, result);
+        continue;
+      }
+      // 从第 i 位向低位取不超过 window 位、以1结尾的窗口
+      size_t low = i + 1 >= size_t(window) ? i + 1 - window : 0;
+      while (!exponent.test_bit(low)) {
+        low++;
+      }
+      size_t value = 0;
+      for (size_t b = i + 1; b-- > low;) {
+        value = 2 * value + exponent.test_bit(b);
+        if (started)
+          multiply(result, result, result);
+      }
+      if (started) {
+        multiply(result, odd[value / 2], result);
+      } else {
+        result = odd[value / 2];
+        started = true;
+      }
+      i = low;
+    }
+    return result;
+  }
+
+  Magnitude pow_fixed_window(const Magnitude &x,
+                             const BigInteger &exponent) const {
+    if (exponent.limbs().size() > k) {
+      throw std::invalid_argument("constant-time exponent must be < 2^(64k)");
+    }
+    const size_t table_size = size_t(1) << kFixedWindow;
+    std::vector<Magnitude> table(table_size, Magnitude(k));
+    table[0] = one;
+    for (size_t i = 1; i < table_size; i++) {
+      multiply(table[i - 1], x, table[i]);
+    }
+    Magnitude exponent_limbs = exponent.limbs();
+    exponent_limbs.resize(k, 0);
+    Magnitude result = one, selected(k);
+    for (size_t w = 64 * k / kFixedWindow; w-- > 0;) {
+      for (int s = 0; s < kFixedWindow; s++) {
+        multiply(result, result, result);
+      }
+      size_t bit = w * kFixedWindow;
+      Limb digit = (exponent_limbs[bit / 64] >> (bit % 64)) & (table_size - 1);
+      // 扫描整张表，用掩码取出第 digit 项
+      std::fill(selected.begin(), selected.end(), 0);
+      for (size_t i = 0; i < table_size; i++) {
+        Limb mask = 0 - static_cast<Limb>(i == digit);
+        for (size_t j = 0; j < k; j++) {
+          selected[j] |= table[i][j] & mask;
+        }
+      }
+      multiply(result, selected, result);
+    }
+    return result;
+  }
+};
+
+inline BigInteger BigInteger::pow_mod(const BigInteger &base,
+                                      const BigInteger &exponent,
+                                      const BigInteger &modulus,
+                                      bool constant_time) {
+  if (modulus.sign() <= 0) {
+    throw std::invalid_argument("BigInteger: modulus must be positive");
+  }
+  if (exponent.is_negative()) {
+    throw std::invalid_argument("BigInteger: exponent must be non-negative");
+  }
+  if (modulus == 1)
+    return 0;
+  if (modulus.is_odd())
+    return MontgomeryContext(modulus).pow(base, exponent, constant_time);
+  BigInteger result = 1, x = mod(base, modulus);
+  for (size_t i = exponent.bit_length(); i-- > 0;) {
+    result = result * result % modulus;
+    if (exponent.test_bit(i))
+      result = result * x % modulus;
+  }
+  return result;
+}
+
+template <typename Random>
+bool BigInteger::is_probable_prime(const BigInteger &n, int rounds,
+                                   Random &gen) {
+  if (n < 2)
+    return false;
+  // 64位以内用确定性测试
+  if (n.magnitude.size() == 1)
+    return MillerRabin::is_prime(n.magnitude[0]);
+  for (Limb p : small_primes()) {
+    if (mod_small(n.magnitude, p) == 0)
+      return false;
+  }
+
+  // n - 1 = d·2^s
+  BigInteger n_minus_1 = n - 1;
+  size_t s = 0;
+  while (!n_minus_1.test_bit(s)) {
+    s++;
+  }
+  BigInteger d = n_minus_1 >> s;
+  MontgomeryContext context(n);
+  Magnitude minus_one = context.to_montgomery(n_minus_1);
+  Magnitude one = context.to_montgomery(1);
+  BigInteger limit = n - 3;
+  for (int round = 0; round < rounds; round++) {
+    BigInteger a = random_below(limit, gen) + 2; // a ∈ [2, n-2]
+    Magnitude x = context.to_montgomery(context.pow(a, d));
+    if (x == one || x == minus_one)
+      continue;
+    bool composite = true;
+    for (size_t r = 1; r < s && composite; r++) {
+      context.multiply(x, x, x);
+      composite = x != minus_one;
+    }
+    if (composite)
+      return false;
+  }
+  return true;
+}
+
+template <typename Random>
+BigInteger BigInteger::generate_prime(size_t bits, Random &gen) {
+  if (bits < 3) {
+    throw std::invalid_argument("BigInteger: prime must have at least 3 bits");
+  }
+  const std::vector<Limb> &primes = small_primes();
+  // 预筛窗口：候选数 c + 2j（0 ≤ j < kSieveWindow）
+  constexpr size_t kSieveWindow = 4096;
+  std::vector<uint8_t> composite(kSieveWindow);
+  while (true) {
+    BigInteger candidate = random_bits(bits, gen);
+    candidate.magnitude.resize((bits + 63) / 64, 0);
+    candidate.magnitude[(bits - 1) / 64] |= Limb(1) << ((bits - 1) % 64);
+    candidate.magnitude[(bits - 2) / 64] |= Limb(1) << ((bits - 2) % 64);
+    candidate.magnitude[0] |= 1;
+    if (bits <= 64) {
+      // 小素数可能就是候选数本身，不做预筛
+      if (is_probable_prime(candidate, 40, gen))
+        return candidate;
+      continue;
+    }
+    // 每个小素数 p 只对 c 做一次取模：满足 c + 2j ≡ 0 (mod p) 的
+    // j ≡ (p - c mod p)·2^{-1} (mod p) 构成步长为 p 的等差数列
+    std::fill(composite.begin(), composite.end(), 0);
+    for (size_t i = 1; i < primes.size(); i++) {
+      Limb p = primes[i];
+      Limb r = mod_small(candidate.magnitude, p);
+      Limb j = (p - r) % p * ((p + 1) / 2) % p;
+      for (; j < kSieveWindow; j += p) {
+        composite[j] = 1;
+      }
+    }
+    for (size_t j = 0; j < kSieveWindow; j++) {
+      if (composite[j])
+        continue;
+      BigInteger x = candidate + BigInteger(static_cast<long long>(2 * j));
+      if (x.bit_length() != bits || !x.test_bit(bits - 2))
+        break;
+      if (is_probable_prime(x, 40, gen))
+        return x;
+    }
+  }
+}
+
+// RSA 在 BigInteger 上的运算，随机数来自以 random_device 为种子的 mt19937_64
+// （演示用途，不是密码学安全的随机数发生器）
+template <> struct RSAArithmetic<BigInteger> {
+  static BigInteger generate_prime(int bits) {
+    return BigInteger::generate_prime(static_cast<size_t>(bits), generator());
+  }
+
+  static BigInteger gcd(const BigInteger &a, const BigInteger &b) {
+    return BigInteger::gcd(a, b);
+  }
+
+  static BigInteger mod(const BigInteger &a, const BigInteger &m) {
+    return BigInteger::mod(a, m);
+  }
+
+  static BigInteger mod_inverse(const BigInteger &a, const BigInteger &m) {
+    return BigInteger::mod_inverse(a, m);
+  }
+
+  static BigInteger mod_pow(const BigInteger &base, const BigInteger &exponent,
+                            const BigInteger &modulus, bool constant_time) {
+    return BigInteger::pow_mod(base, exponent, modulus, constant_time);
+  }
+
+  static std::string to_string(const BigInteger &x) { return x.to_string(); }
+
+private:
+  static std::mt19937_64 &generator() {
+    static thread_local std::mt19937_64 gen(
+        (static_cast<uint64_t>(std::random_device{}()) << 32) ^
+        std::random_device{}());
+    return gen;
+  }
+};
+
+} // namespace algorithms
+
+#endif // BIG_INTEGER_H
@@ -1,8 +1,11 @@
 #ifndef BINARY_SEARCH_TREE_H
 #define BINARY_SEARCH_TREE_H
 
+#include "iterator_range.h"
+#include <cstddef>
 #include <functional>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <queue>
 #include <stack>
@@ -151,9 +154,145 @@ private:
     }
   }
 
+  // 迭代器使用的裸指针版本的后继/前驱，不触碰引用计数
+  static const BSTNode<T> *next_node(const BSTNode<T> *x) {
+    if (x->right != nullptr) {
+      x = x->right.get();
+      while (x->left != nullptr) {
+        x = x->left.get();
+      }
+      return x;
+    }
+    const BSTNode<T> *p = x->parent.get();
+    while (p != nullptr && x == p->right.get()) {
+      x = p;
+      p = p->parent.get();
+    }
+    return p;
+  }
+
+  static const BSTNode<T> *prev_node(const BSTNode<T> *x) {
+    if (x->left != nullptr) {
+      x = x->left.get();
+      while (x->right != nullptr) {
+        x = x->right.get();
+      }
+      return x;
+    }
+    const BSTNode<T> *p = x->parent.get();
+    while (p != nullptr && x == p->left.get()) {
+      x = p;
+      p = p->parent.get();
+    }
+    return p;
+  }
+
+  // 中序意义下第一个使 before(key) 为假的节点
+  template <typename Pred>
+  const BSTNode<T> *partition_point(Pred before) const {
+    const BSTNode<T> *result = nullptr;
+    const BSTNode<T> *x = root.get();
+    while (x != nullptr) {
+      if (before(x->key)) {
+        x = x->right.get();
+      } else {
+        result = x;
+        x = x->left.get();
+      }
+    }
+    return result;
+  }
+
 public:
+  // 中序双向迭代器（只读），按键的升序访问；删除所指节点会使其失效
+  class const_iterator {
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T *;
+    using reference = const T &;
+
+    const_iterator() = default;
+
+    reference operator*() const { return node->key; }
+    pointer operator->() const { return &node->key; }
+
+    const_iterator &operator++() {
+      node = next_node(node);
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      const_iterator old = *this;
+      ++*this;
+      return old;
+    }
+
+    // end() 自减得到最大元素
+    const_iterator &operator--() {
+      if (node == nullptr) {
+        node = tree->maximum(tree->root).get();
+      } else {
+        node = prev_node(node);
+      }
+      return *this;
+    }
+
+    const_iterator operator--(int) {
+      const_iterator old = *this;
+      --*this;
+      return old;
+    }
+
+    bool operator==(const const_iterator &other) const {
+      return node == other.node && tree == other.tree;
+    }
+    bool operator!=(const const_iterator &other) const {
+      return !(*this == other);
+    }
+
+  private:
+    friend class BinarySearchTree;
+
+    const_iterator(const BinarySearchTree *tree, const BSTNode<T> *node)
+        : tree(tree), node(node) {}
+
+    const BinarySearchTree *tree = nullptr;
+    const BSTNode<T> *node = nullptr;
+  };
+
+  using iterator = const_iterator;
+
   BinarySearchTree() : root(nullptr) {}
 
+  const_iterator begin() const {
+    return const_iterator(this, minimum(root).get());
+  }
+
+  const_iterator end() const { return const_iterator(this, nullptr); }
+
+  // 第一个不小于 key 的元素，O(h)
+  const_iterator lower_bound(const T &key) const {
+    return const_iterator(
+        this, partition_point([&key](const T &k) { return k < key; }));
+  }
+
+  // 第一个大于 key 的元素，O(h)
+  const_iterator upper_bound(const T &key) const {
+    return const_iterator(
+        this, partition_point([&key](const T &k) { return !(key < k); }));
+  }
+
+  // 惰性区间视图 [lo, hi)：定位 O(h)，遍历 k 个元素 O(k)，不分配内存
+  IteratorRange<const_iterator> range(const T &lo, const T &hi) const {
+    const_iterator first = lower_bound(lo);
+    if (!(lo < hi)) {
+      return IteratorRange<const_iterator>(first, first);
+    }
+    return IteratorRange<const_iterator>(first, lower_bound(hi));
+  }
+
   // 判断树是否为空
   bool empty() const { return root == nullptr; }
 
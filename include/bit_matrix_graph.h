@@ -0,0 +1,325 @@
+#ifndef BIT_MATRIX_GRAPH_H
+#define BIT_MATRIX_GRAPH_H
+
+#include "cpu_features.h"
+#include "gemm_kernel.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace algorithms {
+
+/**
+ * @brief 位矩阵表示的无权图（CLRS 22.1 邻接矩阵的压缩形式）
+ *
+ * 第 u 行是一个 n 位的位集，按64位字连续存放，每个可能的边只占1位，
+ * 比 AdjacencyMatrixGraph 的 int 矩阵密32倍。邻居集合上的运算变成按字的
+ * 与运算加 popcount：
+ * - common_neighbor_count(u, v)：|N(u) ∩ N(v)|，O(n / 64)
+ * - count_triangles()：每条边 (u, v)，u < v，统计 N(u) ∩ N(v) 中大于 v 的节点
+ * - is_clique(vertices)：先把顶点集做成位集，再检查每个顶点的行是否包含其余顶点
+ *
+ * popcount 内核运行时分派：支持 AVX-512 VPOPCNTDQ 时一次处理8个字，
+ * 否则使用 popcnt 指令，都不支持时退回编译器内置函数。
+ *
+ * 节点用下标 0..n-1 表示（节点编号等于下标），满足 graph_representation.h
+ * 中的图概念，边权恒为1。不支持自环和平行边。
+ */
+class BitMatrixGraph {
+public:
+  explicit BitMatrixGraph(size_t node_count = 0, bool is_directed = false)
+      : n(node_count), words((node_count + 63) / 64),
+        bits(node_count * ((node_count + 63) / 64), 0), directed(is_directed) {}
+
+  // 从满足图概念的图转换（忽略权重与自环，平行边只保留一条）
+  template <typename Graph>
+  static BitMatrixGraph from_graph(const Graph &graph) {
+    BitMatrixGraph result(graph.get_node_count(), graph.is_directed());
+    for (size_t u = 0; u < graph.get_node_count(); u++) {
+      graph.for_each_out_edge(u, [&](int v, int) {
+        if (static_cast<size_t>(v) != u) {
+          result.set(u, v);
+        }
+      });
+    }
+    result.edge_count = result.count_set_bits();
+    if (!result.directed) {
+      result.edge_count /= 2;
+    }
+    return result;
+  }
+
+  // 添加边，已存在时抛出异常（与 AdjacencyMatrixGraph 一致）
+  void add_edge(int from, int to) {
+    check_node(from);
+    check_node(to);
+    if (from == to) {
+      throw std::invalid_argument("BitMatrixGraph does not support self-loops");
+    }
+    if (test(from, to)) {
+      throw std::invalid_argument("Edge already exists");
+    }
+    set(from, to);
+    if (!directed) {
+      set(to, from);
+    }
+    edge_count++;
+  }
+
+  // 删除边，边不存在时返回false
+  bool remove_edge(int from, int to) {
+    check_node(from);
+    check_node(to);
+    if (!test(from, to)) {
+      return false;
+    }
+    reset(from, to);
+    if (!directed) {
+      reset(to, from);
+    }
+    edge_count--;
+    return true;
+  }
+
+  bool has_edge(int from, int to) const {
+    check_node(from);
+    check_node(to);
+    return test(from, to);
+  }
+
+  size_t get_node_count() const { return n; }
+
+  // 边数（无向边计一次）
+  size_t get_edge_count() const { return edge_count; }
+
+  bool is_directed() const { return directed; }
+
+  // 图概念接口：编号等于下标
+  int get_node_id(size_t node_index) const {
+    return static_cast<int>(node_index);
+  }
+
+  int get_node_index(int node_id) const {
+    return node_id >= 0 && static_cast<size_t>(node_id) < n ? node_id : -1;
+  }
+
+  // 图概念接口：按下标递增遍历出边，visit(目标节点下标, 1)
+  template <typename Visitor>
+  void for_each_out_edge(size_t node_index, Visitor visit) const {
+    const std::uint64_t *r = row(node_index);
+    for (size_t w = 0; w < words; w++) {
+      for (std::uint64_t word = r[w]; word != 0; word &= word - 1) {
+        visit(static_cast<int>(w * 64 + __builtin_ctzll(word)), 1);
+      }
+    }
+  }
+
+  // 出度
+  size_t get_degree(int node) const {
+    check_node(node);
+    return popcount(row(node), words);
+  }
+
+  std::vector<int> get_neighbors(int node) const {
+    check_node(node);
+    std::vector<int> neighbors;
+    for_each_out_edge(node, [&](int v, int) { neighbors.push_back(v); });
+    return neighbors;
+  }
+
+  // |N(u) ∩ N(v)|（有向图为两者共同的出邻居）
+  size_t common_neighbor_count(int u, int v) const {
+    check_node(u);
+    check_node(v);
+    return and_popcount(row(u), row(v), words);
+  }
+
+  std::vector<int> common_neighbors(int u, int v) const {
+    check_node(u);
+    check_node(v);
+    std::vector<int> result;
+    const std::uint64_t *a = row(u), *b = row(v);
+    for (size_t w = 0; w < words; w++) {
+      for (std::uint64_t word = a[w] & b[w]; word != 0; word &= word - 1) {
+        result.push_back(static_cast<int>(w * 64 + __builtin_ctzll(word)));
+      }
+    }
+    return result;
+  }
+
+  // 无向图中三角形的个数
+  std::uint64_t count_triangles() const {
+    require_undirected();
+    std::uint64_t total = 0;
+    for (size_t u = 0; u < n; u++) {
+      const std::uint64_t *a = row(u);
+      // 只看 v > u 的邻居，再只数 N(u) ∩ N(v) 中大于 v 的节点
+      for (size_t w = (u + 1) / 64; w < words; w++) {
+        std::uint64_t word = a[w];
+        if (w == (u + 1) / 64) {
+          word &= ~std::uint64_t(0) << ((u + 1) % 64);
+        }
+        for (; word != 0; word &= word - 1) {
+          size_t v = w * 64 + __builtin_ctzll(word);
+          size_t first = (v + 1) / 64;
+          if (first >= words) {
+            continue;
+          }
+          const std::uint64_t *b = row(v);
+          std::uint64_t head = a[first] & b[first] &
+                               (~std::uint64_t(0) << ((v + 1) % 64));
+          total += popcount(&head, 1) +
+                   and_popcount(a + first + 1, b + first + 1,
+                                words - first - 1);
+        }
+      }
+    }
+    return total;
+  }
+
+  // 顶点集合是否两两相邻：每个顶点的行都包含其余所有顶点
+  // （有向图即要求两个方向的边都存在），有重复顶点时返回false
+  bool is_clique(const std::vector<int> &vertices) const {
+    std::vector<std::uint64_t> mask(words, 0);
+    for (int v : vertices) {
+      check_node(v);
+      std::uint64_t bit = std::uint64_t(1) << (v % 64);
+      if (mask[v / 64] & bit) {
+        return false;
+      }
+      mask[v / 64] |= bit;
+    }
+    size_t others = vertices.empty() ? 0 : vertices.size() - 1;
+    for (int v : vertices) {
+      if (and_popcount(row(v), mask.data(), words) != others) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // 第 u 行的位集（get_words_per_row() 个字，下标 v 对应第 v / 64 个字的第 v % 64 位）
+  const std::uint64_t *row(size_t u) const { return bits.data() + u * words; }
+
+  size_t get_words_per_row() const { return words; }
+
+  // 与运算后的 popcount：Σ popcount(a[i] & b[i])
+  static size_t and_popcount(const std::uint64_t *a, const std::uint64_t *b,
+                             size_t count) {
+    switch (isa()) {
+#ifdef ALGORITHMS_GEMM_X86
+    case Isa::AVX512:
+      return and_popcount_avx512(a, b, count);
+    case Isa::Popcnt:
+      return and_popcount_popcnt(a, b, count);
+#endif
+    default:
+      return and_popcount_generic(a, b, count);
+    }
+  }
+
+  static size_t popcount(const std::uint64_t *a, size_t count) {
+    return and_popcount(a, a, count);
+  }
+
+private:
+  size_t n;
+  size_t words; // 每行的字数
+  std::vector<std::uint64_t> bits;
+  bool directed;
+  size_t edge_count = 0;
+
+  enum class Isa { Generic, Popcnt, AVX512 };
+
+  void check_node(int v) const {
+    if (v < 0 || static_cast<size_t>(v) >= n) {
+      throw std::out_of_range("Node index out of range");
+    }
+  }
+
+  void require_undirected() const {
+    if (directed) {
+      throw std::invalid_argument("Triangle counting requires an undirected graph");
+    }
+  }
+
+  bool test(size_t u, size_t v) const {
+    return (bits[u * words + v / 64] >> (v % 64)) & 1;
+  }
+
+  void set(size_t u, size_t v) {
+    bits[u * words + v / 64] |= std::uint64_t(1) << (v % 64);
+  }
+
+  void reset(size_t u, size_t v) {
+    bits[u * words + v / 64] &= ~(std::uint64_t(1) << (v % 64));
+  }
+
+  size_t count_set_bits() const { return popcount(bits.data(), bits.size()); }
+
+  static Isa isa() {
+    static const Isa detected = [] {
+#ifdef ALGORITHMS_GEMM_X86
+      if (CpuFeatures::avx512f() && CpuFeatures::avx512vpopcntdq()) {
+        return Isa::AVX512;
+      }
+      if (CpuFeatures::popcnt()) {
+        return Isa::Popcnt;
+      }
+#endif
+      return Isa::Generic;
+    }();
+    return detected;
+  }
+
+  static size_t and_popcount_generic(const std::uint64_t *a,
+                                     const std::uint64_t *b, size_t count) {
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+      total += __builtin_popcountll(a[i] & b[i]);
+    }
+    return total;
+  }
+
+#ifdef ALGORITHMS_GEMM_X86
+  __attribute__((target("popcnt"))) static size_t
+  and_popcount_popcnt(const std::uint64_t *a, const std::uint64_t *b,
+                      size_t count) {
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+      total += __builtin_popcountll(a[i] & b[i]);
+    }
+    return total;
+  }
+
+  __attribute__((target("avx512f,avx512vpopcntdq,popcnt"))) static size_t
+  and_popcount_avx512(const std::uint64_t *a, const std::uint64_t *b,
+                      size_t count) {
+    __m512i sum = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+      __m512i x = _mm512_loadu_si512(a + i);
+      __m512i y = _mm512_loadu_si512(b + i);
+      sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(_mm512_and_si512(x, y)));
+    }
+    // 经数组归约：GCC 的 _mm512_reduce_add_epi64 内部使用未定义向量，
+    // 在 -Wall -O2 下会报未初始化警告
+    alignas(64) std::uint64_t lanes[8];
+    _mm512_store_si512(lanes, sum);
+    size_t total = 0;
+    for (std::uint64_t lane : lanes) {
+      total += lane;
+    }
+    for (; i < count; i++) {
+      total += __builtin_popcountll(a[i] & b[i]);
+    }
+    return total;
+  }
+#endif
+};
+
+} // namespace algorithms
+
+#endif // BIT_MATRIX_GRAPH_H
@@ -0,0 +1,659 @@
+#ifndef CANONICAL_HUFFMAN_H
+#define CANONICAL_HUFFMAN_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+
+/**
+ * @brief 码长受限的赫夫曼编码构造与频率统计
+ *
+ * code_lengths 用 package-merge 算法求码长不超过 L 的最优前缀码：
+ * 把每个符号看作面值 2^-1 ... 2^-L 各一枚、价值为其频率的硬币，问题等价于
+ * 用总面值 n-1 以最小总价值"凑钱"。从最深一层开始，相邻两项打包成上一层
+ * 的一项，与该层的叶子归并；最上层取前 2n-2 项，每个符号在展开后出现的
+ * 次数就是它的码长。每层被选中的总是有序表的一个前缀，因此只需记录每层
+ * 哪些位置是包，展开时逐层统计前缀中的叶子个数。时间 O(nL + n log n)。
+ *
+ * histogram 用4张交错的子表统计频率：相邻字节落入不同子表，重复字节
+ * 不会在同一个计数器上形成存储—加载依赖链。
+ */
+class LengthLimitedHuffman {
+public:
+  static constexpr int kMaxAlphabet = 1 << 16;
+
+  /**
+   * @brief 码长不超过 max_length 的最优码长
+   * @param freq freq[s] 为符号 s 的频率，0 表示不出现（码长为0）
+   * @throws std::invalid_argument 字母表超过 2^16 个符号、max_length 不在
+   *         [1, 32] 内，或出现的符号多于 2^max_length 个
+   */
+  static std::vector<std::uint8_t>
+  code_lengths(const std::vector<std::uint64_t> &freq, int max_length) {
+    if (freq.size() > static_cast<std::size_t>(kMaxAlphabet)) {
+      throw std::invalid_argument("字母表过大");
+    }
+    if (max_length < 1 || max_length > 32) {
+      throw std::invalid_argument("码长上限必须在1到32之间");
+    }
+    std::vector<std::uint8_t> lengths(freq.size(), 0);
+    std::vector<int> symbols;
+    for (std::size_t s = 0; s < freq.size(); s++) {
+      if (freq[s] > 0) {
+        symbols.push_back(static_cast<int>(s));
+      }
+    }
+    std::size_t n = symbols.size();
+    if (n == 0) {
+      return lengths;
+    }
+    if (n == 1) {
+      lengths[symbols[0]] = 1; // 单个符号也需要1位码字
+      return lengths;
+    }
+    if (max_length < 32 && n > (std::size_t(1) << max_length)) {
+      throw std::invalid_argument("符号个数超过码长上限所能表示的范围");
+    }
+    std::stable_sort(symbols.begin(), symbols.end(),
+                     [&](int a, int b) { return freq[a] < freq[b]; });
+    std::vector<std::uint64_t> leaves(n);
+    for (std::size_t i = 0; i < n; i++) {
+      leaves[i] = freq[symbols[i]];
+    }
+
+    // is_package[d]：第 d 层（0 为最深层）有序表中每个位置是否为包
+    std::vector<std::vector<std::uint8_t>> is_package(max_length);
+    std::vector<std::uint64_t> list = leaves, next;
+    is_package[0].assign(n, 0);
+    for (int d = 1; d < max_length; d++) {
+      std::size_t packages = list.size() / 2;
+      next.clear();
+      next.reserve(n + packages);
+      is_package[d].clear();
+      is_package[d].reserve(n + packages);
+      // 叶子与包归并，权值相同时叶子在前
+      std::size_t leaf = 0, pkg = 0;
+      while (leaf < n || pkg < packages) {
+        bool take_leaf =
+            pkg == packages ||
+            (leaf < n && leaves[leaf] <= list[2 * pkg] + list[2 * pkg + 1]);
+        if (take_leaf) {
+          next.push_back(leaves[leaf++]);
+          is_package[d].push_back(0);
+        } else {
+          next.push_back(list[2 * pkg] + list[2 * pkg + 1]);
+          is_package[d].push_back(1);
+          pkg++;
+        }
+      }
+      list.swap(next);
+    }
+
+    // 最上层选前 2n-2 项，逐层向下展开
+    std::size_t selected = 2 * n - 2;
+    for (int d = max_length - 1; d >= 0 && selected > 0; d--) {
+      std::size_t packages = std::accumulate(
+          is_package[d].begin(), is_package[d].begin() + selected,
+          std::size_t(0));
+      std::size_t leaf_count = selected - packages;
+      for (std::size_t i = 0; i < leaf_count; i++) {
+        lengths[symbols[i]]++;
+      }
+      selected = 2 * packages;
+    }
+    return lengths;
+  }
+
+  /**
+   * @brief 由码长分配范式码字（高位在前）：按 (码长, 符号) 顺序递增
+   * @throws std::invalid_argument 码长不满足Kraft不等式
+   */
+  static std::vector<std::uint32_t>
+  canonical_codes(const std::vector<std::uint8_t> &lengths) {
+    int longest = 0;
+    std::vector<std::uint32_t> count(33, 0);
+    for (std::uint8_t len : lengths) {
+      if (len > 32) {
+        throw std::invalid_argument("码长超过32位");
+      }
+      count[len]++;
+      longest = std::max(longest, static_cast<int>(len));
+    }
+    std::vector<std::uint64_t> next(longest + 1, 0);
+    std::uint64_t code = 0;
+    for (int len = 1; len <= longest; len++) {
+      code = (code + count[len - 1] * (len > 1)) << 1;
+      next[len] = code;
+      if (code + count[len] > (std::uint64_t(1) << len)) {
+        throw std::invalid_argument("码长不满足Kraft不等式");
+      }
+    }
+    std::vector<std::uint32_t> codes(lengths.size(), 0);
+    for (std::size_t s = 0; s < lengths.size(); s++) {
+      if (lengths[s] > 0) {
+        codes[s] = static_cast<std::uint32_t>(next[lengths[s]]++);
+      }
+    }
+    return codes;
+  }
+
+  /**
+   * @brief 字节频率
+   */
+  static std::array<std::uint64_t, 256> histogram(std::string_view data) {
+    std::array<std::uint64_t, 256> result{};
+    // 32位子表每 2^30 字节清空一次，避免溢出
+    constexpr std::size_t kBlock = std::size_t(1) << 30;
+    std::uint32_t sub[4][256];
+    const unsigned char *p =
+        reinterpret_cast<const unsigned char *>(data.data());
+    for (std::size_t base = 0; base < data.size(); base += kBlock) {
+      std::size_t size = std::min(kBlock, data.size() - base);
+      std::memset(sub, 0, sizeof(sub));
+      const unsigned char *q = p + base;
+      std::size_t i = 0;
+      for (; i + 8 <= size; i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, q + i, 8);
+        sub[0][word & 0xFF]++;
+        sub[1][word >> 8 & 0xFF]++;
+        sub[2][word >> 16 & 0xFF]++;
+        sub[3][word >> 24 & 0xFF]++;
+        sub[0][word >> 32 & 0xFF]++;
+        sub[1][word >> 40 & 0xFF]++;
+        sub[2][word >> 48 & 0xFF]++;
+        sub[3][word >> 56]++;
+      }
+      for (; i < size; i++) {
+        sub[i & 3][q[i]]++;
+      }
+      for (int c = 0; c < 256; c++) {
+        result[c] += static_cast<std::uint64_t>(sub[0][c]) + sub[1][c] +
+                     sub[2][c] + sub[3][c];
+      }
+    }
+    return result;
+  }
+
+  /**
+   * @brief 16位符号的频率
+   * @throws std::invalid_argument 符号不小于 alphabet_size
+   */
+  static std::vector<std::uint64_t> histogram(const std::uint16_t *symbols,
+                                              std::size_t count,
+                                              std::size_t alphabet_size) {
+    std::vector<std::uint64_t> result(alphabet_size, 0);
+    std::vector<std::uint32_t> sub[4];
+    for (auto &table : sub) {
+      table.assign(kMaxAlphabet, 0);
+    }
+    constexpr std::size_t kBlock = std::size_t(1) << 30;
+    for (std::size_t base = 0; base < count; base += kBlock) {
+      std::size_t size = std::min(kBlock, count - base);
+      const std::uint16_t *q = symbols + base;
+      std::size_t i = 0;
+      for (; i + 4 <= size; i += 4) {
+        sub[0][q[i]]++;
+        sub[1][q[i + 1]]++;
+        sub[2][q[i + 2]]++;
+        sub[3][q[i + 3]]++;
+      }
+      for (; i < size; i++) {
+        sub[0][q[i]]++;
+      }
+      for (std::size_t c = 0; c < static_cast<std::size_t>(kMaxAlphabet); c++) {
+        std::uint64_t total = static_cast<std::uint64_t>(sub[0][c]) +
+                              sub[1][c] + sub[2][c] + sub[3][c];
+        if (total > 0 && c >= alphabet_size) {
+          throw std::invalid_argument("符号超出字母表范围");
+        }
+        if (total > 0) {
+          result[c] += total;
+        }
+        sub[0][c] = sub[1][c] = sub[2][c] = sub[3][c] = 0;
+      }
+    }
+    return result;
+  }
+};
+
+/**
+ * @brief 字节字母表上的范式赫夫曼编码（canonical Huffman）
+ *
+ * 16.3节的 HuffmanCoding 用指针树表示编码，输出 '0'/'1' 字符串。这里只
+ * 保存每个字节的码长：码长确定后，按 (码长, 字节值) 排序依次分配递增的
+ * 码字即得到唯一的范式编码，因此头部只需记录256个码长。
+ *
+ * - 码长上限 kMaxCodeLength = 15（可设得更小），由 LengthLimitedHuffman
+ *   的 package-merge 求出受限条件下的最优码长
+ * - 位流按低位在前打包进字节（与DEFLATE相同），码字按位反转后写入
+ * - 解码查 2^kTableBits 项的表，一步解出不超过 kTableBits 位的码字；
+ *   更长的码字按范式编码的首码表逐位解出
+ *
+ * 压缩格式（compress/decompress）：4字节魔数、128字节码长（每字节两个
+ * 4位码长）、8字节小端符号个数，随后是位流。Encoder/Decoder 处理不带
+ * 头部的裸位流，调用者自行保存码长与符号个数。
+ */
+class CanonicalHuffmanCodec {
+public:
+  static constexpr int kMaxCodeLength = 15;
+  static constexpr int kTableBits = 11;
+  static constexpr std::size_t kHeaderBytes = 4 + 128 + 8;
+
+  using CodeLengths = std::array<std::uint8_t, 256>;
+  using Frequencies = std::array<std::uint64_t, 256>;
+
+  /**
+   * @brief 由码长表构造；码长为0表示该字节不出现
+   * @throws std::invalid_argument 码长超过上限或违反Kraft不等式
+   */
+  explicit CanonicalHuffmanCodec(const CodeLengths &code_lengths)
+      : lengths(code_lengths) {
+    std::uint32_t kraft = 0;
+    for (std::uint8_t len : lengths) {
+      if (len > kMaxCodeLength) {
+        throw std::invalid_argument("码长超过上限");
+      }
+      if (len > 0) {
+        kraft += 1u << (kMaxCodeLength - len);
+      }
+    }
+    if (kraft > (1u << kMaxCodeLength)) {
+      throw std::invalid_argument("码长不满足Kraft不等式");
+    }
+    assign_codes();
+    build_decode_table();
+  }
+
+  /**
+   * @brief 由字节频率构造码长不超过 max_length 的最优前缀码
+   * @throws std::invalid_argument max_length 不在 [8, kMaxCodeLength] 内
+   */
+  static CanonicalHuffmanCodec
+  from_frequencies(const Frequencies &freq,
+                   int max_length = kMaxCodeLength) {
+    if (max_length < 8 || max_length > kMaxCodeLength) {
+      throw std::invalid_argument("码长上限必须在8到15之间");
+    }
+    std::vector<std::uint8_t> limited = LengthLimitedHuffman::code_lengths(
+        std::vector<std::uint64_t>(freq.begin(), freq.end()), max_length);
+    CodeLengths code_lengths{};
+    std::copy(limited.begin(), limited.end(), code_lengths.begin());
+    return CanonicalHuffmanCodec(code_lengths);
+  }
+
+  static CanonicalHuffmanCodec from_data(std::string_view data,
+                                         int max_length = kMaxCodeLength) {
+    return from_frequencies(LengthLimitedHuffman::histogram(data), max_length);
+  }
+
+  const CodeLengths &code_lengths() const { return lengths; }
+
+  int code_length(unsigned char symbol) const { return lengths[symbol]; }
+
+  /**
+   * @brief 码字的 '0'/'1' 表示（高位在前），便于与 HuffmanCoding 对照
+   * @throws std::invalid_argument 字节不在编码中
+   */
+  std::string code_string(unsigned char symbol) const {
+    int len = lengths[symbol];
+    if (len == 0) {
+      throw std::invalid_argument("字符不在赫夫曼编码中");
+    }
+    std::string bits(len, '0');
+    for (int b = 0; b < len; b++) {
+      // reversed_codes 低位在前
+      if (reversed_codes[symbol] >> b & 1) {
+        bits[b] = '1';
+      }
+    }
+    return bits;
+  }
+
+  /**
+   * @brief 编码 data 所需的位数
+   */
+  std::uint64_t encoded_bits(std::string_view data) const {
+    std::uint64_t bits = 0;
+    for (char ch : data) {
+      bits += lengths[static_cast<unsigned char>(ch)];
+    }
+    return bits;
+  }
+
+  /**
+   * @brief 流式编码器：多次 write 的输出首尾相接，finish 补齐最后一个字节
+   */
+  class Encoder {
+  public:
+    explicit Encoder(const CanonicalHuffmanCodec &codec)
+        : codec(&codec), buffer(0), pending(0), symbols(0) {}
+
+    /**
+     * @brief 编码 data 并把完整的字节追加到 out
+     * @throws std::invalid_argument data 含有不在编码中的字节
+     */
+    void write(std::string_view data, std::vector<std::uint8_t> &out) {
+      std::size_t old_size = out.size();
+      // 每个符号至多 max_length 位，再加上缓冲区中的残留位
+      out.resize(old_size + data.size() * codec->max_length / 8 + 16);
+      std::uint8_t *dst = out.data() + old_size;
+      const std::uint8_t *lengths = codec->lengths.data();
+      const std::uint16_t *codes = codec->reversed_codes.data();
+
+      for (char ch : data) {
+        unsigned char symbol = static_cast<unsigned char>(ch);
+        int len = lengths[symbol];
+        if (len == 0) {
+          out.resize(dst - out.data());
+          throw std::invalid_argument("字符不在赫夫曼编码中");
+        }
+        buffer |= static_cast<std::uint64_t>(codes[symbol]) << pending;
+        pending += len;
+        if (pending >= 32) {
+          store32(dst, static_cast<std::uint32_t>(buffer));
+          dst += 4;
+          buffer >>= 32;
+          pending -= 32;
+        }
+      }
+      symbols += data.size();
+      out.resize(dst - out.data());
+    }
+
+    /**
+     * @brief 输出缓冲区中剩余的位，不足一字节的部分补0
+     */
+    void finish(std::vector<std::uint8_t> &out) {
+      while (pending > 0) {
+        out.push_back(static_cast<std::uint8_t>(buffer));
+        buffer >>= 8;
+        pending = pending > 8 ? pending - 8 : 0;
+      }
+      buffer = 0;
+    }
+
+    std::uint64_t symbols_written() const { return symbols; }
+
+  private:
+    const CanonicalHuffmanCodec *codec;
+    std::uint64_t buffer; // 尚未输出的位，低位在前
+    int pending;
+    std::uint64_t symbols;
+  };
+
+  /**
+   * @brief 流式解码器：可分多次输入位流，跨越输入边界的码字也能解出
+   */
+  class Decoder {
+  public:
+    Decoder(const CanonicalHuffmanCodec &codec, std::uint64_t symbol_count)
+        : codec(&codec), buffer(0), available(0), remaining(symbol_count) {}
+
+    /**
+     * @brief 输入下一段位流，把解出的字节追加到 out
+     * @throws std::runtime_error 位流中出现不属于编码的码字
+     */
+    void feed(const std::uint8_t *data, std::size_t size, std::string &out) {
+      std::size_t old_size = out.size();
+      std::uint64_t bound =
+          std::min<std::uint64_t>(remaining, (available + 8ull * size) /
+                                                 codec->min_length);
+      out.resize(old_size + bound);
+      char *dst = &out[0] + old_size;
+      const std::uint16_t *table = codec->table.data();
+      std::size_t pos = 0;
+
+      while (remaining > 0) {
+        // 补充到至少57位：剩余8字节以上时一次读入一个机器字
+        if (size - pos >= 8) {
+          buffer |= load64(data + pos) << available;
+          int bytes = (63 - available) >> 3;
+          pos += bytes;
+          available += bytes * 8;
+        } else {
+          while (available <= 56 && pos < size) {
+            buffer |= static_cast<std::uint64_t>(data[pos++]) << available;
+            available += 8;
+          }
+        }
+
+        // 缓冲区满时（至少57位）可连续解出 57 / max_length 个码字
+        bool stalled = false;
+        int batch = static_cast<int>(
+            std::min<std::uint64_t>(codec->symbols_per_refill, remaining));
+        int k = 0;
+        for (; k < batch; k++) {
+          std::uint16_t entry = table[buffer & kTableMask];
+          int len = entry & 0xF;
+          int symbol = entry >> 4;
+          if (entry == 0 || len > available) {
+            symbol = codec->decode_symbol(buffer, available, len);
+            if (symbol < 0) {
+              stalled = true; // 位数不足，等待更多输入
+              break;
+            }
+          }
+          *dst++ = static_cast<char>(symbol);
+          buffer >>= len;
+          available -= len;
+        }
+        remaining -= k;
+        if (stalled && pos == size) {
+          break;
+        }
+      }
+      out.resize(dst - out.data());
+    }
+
+    void feed(const std::vector<std::uint8_t> &data, std::string &out) {
+      feed(data.data(), data.size(), out);
+    }
+
+    bool finished() const { return remaining == 0; }
+
+    std::uint64_t symbols_remaining() const { return remaining; }
+
+  private:
+    const CanonicalHuffmanCodec *codec;
+    std::uint64_t buffer; // 已读入未消耗的位，低位在前
+    int available;
+    std::uint64_t remaining;
+  };
+
+  Encoder encoder() const { return Encoder(*this); }
+
+  Decoder decoder(std::uint64_t symbol_count) const {
+    return Decoder(*this, symbol_count);
+  }
+
+  /**
+   * @brief 统计频率、建立编码并输出带头部的压缩数据
+   */
+  static std::vector<std::uint8_t> compress(std::string_view data) {
+    CanonicalHuffmanCodec codec = from_data(data);
+    std::vector<std::uint8_t> out(kHeaderBytes, 0);
+    std::memcpy(out.data(), kMagic, 4);
+    for (int s = 0; s < 256; s += 2) {
+      out[4 + s / 2] = static_cast<std::uint8_t>(codec.lengths[s] |
+                                                 codec.lengths[s + 1] << 4);
+    }
+    std::uint64_t count = data.size();
+    for (int b = 0; b < 8; b++) {
+      out[4 + 128 + b] = static_cast<std::uint8_t>(count >> (8 * b));
+    }
+    Encoder encoder(codec);
+    encoder.write(data, out);
+    encoder.finish(out);
+    return out;
+  }
+
+  /**
+   * @brief 解压 compress 的输出
+   * @throws std::invalid_argument 头部缺失或损坏
+   * @throws std::runtime_error 位流损坏或被截断
+   */
+  static std::string decompress(const std::uint8_t *data, std::size_t size) {
+    if (size < kHeaderBytes || std::memcmp(data, kMagic, 4) != 0) {
+      throw std::invalid_argument("不是赫夫曼压缩数据");
+    }
+    CodeLengths code_lengths{};
+    for (int s = 0; s < 256; s += 2) {
+      code_lengths[s] = data[4 + s / 2] & 0xF;
+      code_lengths[s + 1] = data[4 + s / 2] >> 4;
+    }
+    std::uint64_t count = 0;
+    for (int b = 0; b < 8; b++) {
+      count |= static_cast<std::uint64_t>(data[4 + 128 + b]) << (8 * b);
+    }
+
+    CanonicalHuffmanCodec codec(code_lengths);
+    if (count > 0 && codec.min_length == kMaxCodeLength + 1) {
+      throw std::invalid_argument("码长表为空");
+    }
+    std::uint64_t payload_bits = 8ull * (size - kHeaderBytes);
+    if (count > payload_bits / std::min(codec.min_length, kMaxCodeLength)) {
+      throw std::runtime_error("压缩数据被截断");
+    }
+    std::string out;
+    Decoder decoder(codec, count);
+    decoder.feed(data + kHeaderBytes, size - kHeaderBytes, out);
+    if (!decoder.finished()) {
+      throw std::runtime_error("压缩数据被截断");
+    }
+    return out;
+  }
+
+  static std::string decompress(const std::vector<std::uint8_t> &data) {
+    return decompress(data.data(), data.size());
+  }
+
+private:
+  static constexpr char kMagic[4] = {'H', 'U', 'F', '1'};
+  static constexpr std::uint32_t kTableMask = (1u << kTableBits) - 1;
+
+  CodeLengths lengths;
+  std::array<std::uint16_t, 256> reversed_codes{}; // 反转后的码字，低位在前
+  int min_length = kMaxCodeLength + 1;             // 无符号时为上限+1
+  int max_length = 0;
+  int symbols_per_refill = 1;
+
+  // 短码表：项为 (字节 << 4) | 码长；码长为0表示码字长于 kTableBits
+  std::vector<std::uint16_t> table;
+
+  // 范式编码的逐位解码：长度为 len 的码字为 [first_code[len],
+  // first_code[len] + count[len])，对应 sorted_symbols[offset[len] + ...]
+  std::array<std::uint32_t, kMaxCodeLength + 1> first_code{};
+  std::array<std::uint32_t, kMaxCodeLength + 1> count{};
+  std::array<std::uint32_t, kMaxCodeLength + 1> offset{};
+  std::vector<std::uint8_t> sorted_symbols;
+
+  static std::uint32_t reverse_bits(std::uint32_t code, int len) {
+    std::uint32_t result = 0;
+    for (int b = 0; b < len; b++) {
+      result = result << 1 | (code >> b & 1);
+    }
+    return result;
+  }
+
+  static std::uint64_t load64(const std::uint8_t *p) {
+    std::uint64_t word;
+    std::memcpy(&word, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+  }
+
+  static void store32(std::uint8_t *p, std::uint32_t word) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap32(word);
+#endif
+    std::memcpy(p, &word, 4);
+  }
+
+  // 按 (码长, 字节值) 顺序分配范式码字
+  void assign_codes() {
+    for (int s = 0; s < 256; s++) {
+      if (lengths[s] > 0) {
+        count[lengths[s]]++;
+        min_length = std::min(min_length, static_cast<int>(lengths[s]));
+        max_length = std::max(max_length, static_cast<int>(lengths[s]));
+      }
+    }
+    symbols_per_refill = max_length > 0 ? 57 / max_length : 1;
+    std::uint32_t code = 0, index = 0;
+    for (int len = 1; len <= kMaxCodeLength; len++) {
+      first_code[len] = code;
+      offset[len] = index;
+      code = (code + count[len]) << 1;
+      index += count[len];
+    }
+    sorted_symbols.resize(index);
+    std::array<std::uint32_t, kMaxCodeLength + 1> next = first_code;
+    for (int s = 0; s < 256; s++) {
+      int len = lengths[s];
+      if (len > 0) {
+        std::uint32_t c = next[len]++;
+        sorted_symbols[offset[len] + c - first_code[len]] =
+            static_cast<std::uint8_t>(s);
+        reversed_codes[s] = static_cast<std::uint16_t>(reverse_bits(c, len));
+      }
+    }
+  }
+
+  void build_decode_table() {
+    table.assign(1u << kTableBits, 0);
+    for (int s = 0; s < 256; s++) {
+      int len = lengths[s];
+      if (len == 0 || len > kTableBits) {
+        continue;
+      }
+      // 低 len 位为码字的所有表项
+      std::uint16_t entry = static_cast<std::uint16_t>(s << 4 | len);
+      for (std::uint32_t i = reversed_codes[s]; i < table.size();
+           i += 1u << len) {
+        table[i] = entry;
+      }
+    }
+  }
+
+  /**
+   * @brief 从位缓冲区的低位解出一个字节
+   * @return 字节值；可用位数不足以确定码字时返回 -1
+   * @throws std::runtime_error 码字不属于编码
+   */
+  int decode_symbol(std::uint64_t bits, int available, int &len) const {
+    std::uint16_t entry = table[bits & kTableMask];
+    if (entry != 0) {
+      len = entry & 0xF;
+      return len <= available ? entry >> 4 : -1;
+    }
+    // 长码字（或非法码字）：按范式编码逐位比较
+    std::uint32_t code = 0;
+    for (len = 1; len <= kMaxCodeLength; len++) {
+      if (len > available) {
+        return -1;
+      }
+      code = code << 1 | static_cast<std::uint32_t>(bits >> (len - 1) & 1);
+      if (code - first_code[len] < count[len]) {
+        return sorted_symbols[offset[len] + code - first_code[len]];
+      }
+    }
+    throw std::runtime_error("位流中存在非法码字");
+  }
+};
+
+} // namespace algorithms
+
+#endif // CANONICAL_HUFFMAN_H
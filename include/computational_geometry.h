@@ -1,11 +1,24 @@
 #ifndef COMPUTATIONAL_GEOMETRY_H
 #define COMPUTATIONAL_GEOMETRY_H
 
+#include "cpu_features.h"
+#include "flat_hash_map.h"
+#include "gemm_kernel.h"
+#include "intrusive_rb_tree.h"
+#include "linear_time_sort_generic.h"
+#include "work_stealing_scheduler.h"
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <queue>
 #include <stack>
+#include <stdexcept>
+#include <thread>
 #include <vector>
 
 namespace algorithms {
@@ -36,6 +49,45 @@ struct Segment {
   Segment(const Point &p1, const Point &p2) : p1(p1), p2(p2) {}
 };
 
+// 结构数组（SoA）形式的点集：x、y 坐标各自连续存放，
+// 方向测试可以一次处理4个点，大规模凸包算法使用这种布局
+struct PointSet {
+  std::vector<double> x, y;
+
+  PointSet() = default;
+
+  explicit PointSet(const std::vector<Point> &points) {
+    reserve(points.size());
+    for (const auto &p : points) {
+      push_back(p);
+    }
+  }
+
+  size_t size() const { return x.size(); }
+
+  bool empty() const { return x.empty(); }
+
+  void reserve(size_t n) {
+    x.reserve(n);
+    y.reserve(n);
+  }
+
+  void push_back(const Point &p) {
+    x.push_back(p.x);
+    y.push_back(p.y);
+  }
+
+  Point operator[](size_t i) const { return Point(x[i], y[i]); }
+
+  std::vector<Point> to_points() const {
+    std::vector<Point> points(size());
+    for (size_t i = 0; i < size(); i++) {
+      points[i] = Point(x[i], y[i]);
+    }
+    return points;
+  }
+};
+
 // 33.1 线段性质
 class SegmentProperties {
 public:
@@ -83,6 +135,215 @@ public:
   }
 };
 
+// 33.1 鲁棒的方向判断
+//
+// cross_product 在三点几乎共线时可能算错符号，扫描线算法依赖这些符号的一致性。
+// 这里采用 Shewchuk 的自适应方法：先用浮点结果与前向误差界判断，
+// 只有落在误差界内时，才把每个差和乘积拆成精确的两项之和（two_diff/two_product），
+// 累加成无重叠展开式（Expansion），由其中最大的非零分量得到精确符号。
+class RobustPredicates {
+public:
+  // 无重叠展开式：若干个按绝对值递增、二进制位互不重叠的非零浮点数之和，
+  // 精确表示一个实数；空展开式表示0
+  using Expansion = std::vector<double>;
+
+  // sign((b - a) × (d - c))：1、0 或 -1，总是精确的
+  static int cross_sign(const Point &a, const Point &b, const Point &c,
+                        const Point &d) {
+    double ux = b.x - a.x, uy = b.y - a.y, vx = d.x - c.x, vy = d.y - c.y;
+    double left = ux * vy, right = uy * vx;
+    double det = left - right;
+    double bound = kErrorBound * (std::abs(left) + std::abs(right));
+    if (det > bound)
+      return 1;
+    if (-det > bound)
+      return -1;
+    return exact_cross_sign(a, b, c, d);
+  }
+
+  // cross_product(p0, p1, p2) 的精确符号：p2 在有向直线 p0→p1 左侧时为1
+  static int orientation(const Point &p0, const Point &p1, const Point &p2) {
+    return cross_sign(p0, p1, p0, p2);
+  }
+
+  // p 是否在线段 s 的外接矩形内（p 与 s 共线时即 p 在 s 上）
+  static bool in_box(const Point &p, const Segment &s) {
+    return std::min(s.p1.x, s.p2.x) <= p.x && p.x <= std::max(s.p1.x, s.p2.x) &&
+           std::min(s.p1.y, s.p2.y) <= p.y && p.y <= std::max(s.p1.y, s.p2.y);
+  }
+
+  // 两条线段（含端点）是否相交，与 SEGMENTS-INTERSECT 相同但不使用容差
+  static bool segments_intersect(const Segment &s1, const Segment &s2) {
+    int d1 = orientation(s2.p1, s2.p2, s1.p1);
+    int d2 = orientation(s2.p1, s2.p2, s1.p2);
+    int d3 = orientation(s1.p1, s1.p2, s2.p1);
+    int d4 = orientation(s1.p1, s1.p2, s2.p2);
+    if (d1 * d2 < 0 && d3 * d4 < 0)
+      return true;
+    return (d1 == 0 && in_box(s1.p1, s2)) || (d2 == 0 && in_box(s1.p2, s2)) ||
+           (d3 == 0 && in_box(s2.p1, s1)) || (d4 == 0 && in_box(s2.p2, s1));
+  }
+
+  // 展开式运算，结果都是精确的
+
+  // a - b
+  static Expansion difference(double a, double b) {
+    double diff, error;
+    two_diff(a, b, diff, error);
+    Expansion e;
+    if (error != 0)
+      e.push_back(error);
+    if (diff != 0)
+      e.push_back(diff);
+    return e;
+  }
+
+  // (b - a) × (d - c)
+  static Expansion cross(const Point &a, const Point &b, const Point &c,
+                         const Point &d) {
+    return sum(product(difference(b.x, a.x), difference(d.y, c.y)),
+               negate(product(difference(b.y, a.y), difference(d.x, c.x))));
+  }
+
+  static Expansion sum(const Expansion &e, const Expansion &f) {
+    Expansion h = e;
+    for (double b : f) {
+      grow(h, b);
+    }
+    return compress(h);
+  }
+
+  static Expansion product(const Expansion &e, const Expansion &f) {
+    Expansion h;
+    for (double b : f) {
+      for (double a : e) {
+        double hi, lo;
+        two_product(a, b, hi, lo);
+        grow(h, lo);
+        grow(h, hi);
+      }
+    }
+    return compress(h);
+  }
+
+  static Expansion negate(Expansion e) {
+    for (double &component : e) {
+      component = -component;
+    }
+    return e;
+  }
+
+  static int sign(const Expansion &e) {
+    return e.empty() ? 0 : (e.back() > 0 ? 1 : -1);
+  }
+
+  // 浮点运算 a ⊕ b、a ⊗ b 的相对误差上界 2^-53
+  static constexpr double kEpsilon =
+      std::numeric_limits<double>::epsilon() / 2;
+
+private:
+  static constexpr double kErrorBound = (3.0 + 16.0 * kEpsilon) * kEpsilon;
+
+  static void two_sum(double a, double b, double &sum, double &error) {
+    sum = a + b;
+    double bv = sum - a, av = sum - bv;
+    error = (a - av) + (b - bv);
+  }
+
+  static void two_diff(double a, double b, double &diff, double &error) {
+    diff = a - b;
+    double bv = a - diff, av = diff + bv;
+    error = (a - av) + (bv - b);
+  }
+
+  static void two_product(double a, double b, double &product, double &error) {
+    product = a * b;
+    error = std::fma(a, b, -product);
+  }
+
+  // 与 sign(cross(a, b, c, d)) 相同，但不分配内存：每个差至多两项，
+  // 两个乘积至多各8项，逐项 grow 进栈上的定长数组
+  static int exact_cross_sign(const Point &a, const Point &b, const Point &c,
+                              const Point &d) {
+    double u[2][2], v[2][2]; // u = b - a，v = d - c，每个坐标为 {误差, 差}
+    two_diff(b.x, a.x, u[0][1], u[0][0]);
+    two_diff(b.y, a.y, u[1][1], u[1][0]);
+    two_diff(d.x, c.x, v[0][1], v[0][0]);
+    two_diff(d.y, c.y, v[1][1], v[1][0]);
+    double h[16];
+    size_t length = 0;
+    auto grow_fixed = [&](double value) {
+      size_t kept = 0;
+      for (size_t i = 0; i < length; i++) {
+        double sum, error;
+        two_sum(value, h[i], sum, error);
+        if (error != 0)
+          h[kept++] = error;
+        value = sum;
+      }
+      length = kept;
+      if (value != 0)
+        h[length++] = value;
+    };
+    // ux·vy - uy·vx
+    for (int i = 0; i < 2; i++) {
+      for (int j = 0; j < 2; j++) {
+        double hi, lo;
+        two_product(u[0][i], v[1][j], hi, lo);
+        grow_fixed(lo);
+        grow_fixed(hi);
+        two_product(u[1][i], v[0][j], hi, lo);
+        grow_fixed(-lo);
+        grow_fixed(-hi);
+      }
+    }
+    return length == 0 ? 0 : (h[length - 1] > 0 ? 1 : -1);
+  }
+
+  // grow-expansion：加入 b 后仍然无重叠、按绝对值递增，并去掉0分量
+  static void grow(Expansion &e, double b) {
+    size_t length = 0;
+    for (double component : e) {
+      double sum, error;
+      two_sum(b, component, sum, error);
+      if (error != 0)
+        e[length++] = error;
+      b = sum;
+    }
+    e.resize(length);
+    if (b != 0)
+      e.push_back(b);
+  }
+
+  // 压缩为分量尽量少的等值展开式（Shewchuk 的 COMPRESS）
+  static Expansion compress(const Expansion &e) {
+    if (e.size() < 2)
+      return e;
+    Expansion h(e.size());
+    size_t bottom = e.size() - 1;
+    double q = e[bottom];
+    for (size_t i = e.size() - 1; i-- > 0;) {
+      double sum = q + e[i], error = e[i] - (sum - q);
+      if (error != 0) {
+        h[bottom--] = sum;
+        q = error;
+      } else {
+        q = sum;
+      }
+    }
+    size_t top = 0;
+    for (size_t i = bottom + 1; i < e.size(); i++) {
+      double sum = h[i] + q, error = q - (sum - h[i]);
+      if (error != 0)
+        h[top++] = error;
+      q = sum;
+    }
+    h[top++] = q;
+    h.resize(top);
+    return h;
+  }
+};
+
 // 33.2 判断点是否在多边形内
 class PointInPolygon {
 public:
@@ -151,12 +412,13 @@ public:
     }
     std::swap(points[0], points[min_idx]);
 
-    // 按极角排序
+    // 按极角排序：直接比较叉积的符号。共线判断不能用绝对容差，
+    // 坐标差很小时（如经纬度轨迹）所有叉积都小于容差，比较不再是严格弱序
     Point p0 = points[0];
     std::sort(points.begin() + 1, points.end(),
               [&p0](const Point &a, const Point &b) {
                 double cross = SegmentProperties::cross_product(p0, a, b);
-                if (std::abs(cross) < 1e-9) {
+                if (cross == 0) {
                   return p0.distance(a) < p0.distance(b);
                 }
                 return cross > 0;
@@ -213,6 +475,560 @@ public:
 
     return hull;
   }
+
+  /**
+   * @brief Andrew单调链算法
+   *
+   * 按 (x, y) 字典序排序后，从左到右扫描一遍得到下凸壳，从右到左扫描一遍
+   * 得到上凸壳；只用叉积判断转向，不需要计算极角。O(n lg n)。
+   *
+   * @return 逆时针顺序的凸包顶点，从字典序最小的点开始，不含共线点和重复点；
+   *         所有点共线时返回两个端点
+   */
+  static std::vector<Point> monotone_chain(std::vector<Point> points) {
+    std::sort(points.begin(), points.end(), lexicographic_less);
+    return chain_sorted(points);
+  }
+
+  /**
+   * @brief 大规模点集上的单调链算法
+   *
+   * 1. Akl–Toussaint预过滤：并行求出 y、x-y、x、x+y 四个方向上的8个极值点，
+   *    严格位于它们围成的八边形内部的点不可能是凸包顶点，直接丢弃
+   * 2. 幸存点用 RadixSort 并行排序：先按 y 排序，再按 x 稳定排序，得到字典序
+   * 3. 单调链扫描幸存点
+   * 方向测试在SoA坐标上每次处理4个点（支持AVX2时）。均匀分布的点集中幸存点只占
+   * 很小的比例，排序的代价可以忽略；点都在凸包上时（如圆周）过滤不起作用。
+   * 结果与 monotone_chain(std::vector<Point>) 相同。
+   *
+   * @param points 点集
+   * @param num_threads 线程数量
+   */
+  static std::vector<Point>
+  monotone_chain(const PointSet &points,
+                 size_t num_threads = std::thread::hardware_concurrency()) {
+    size_t n = points.size();
+    if (n == 0)
+      return {};
+
+    WorkStealingScheduler scheduler(num_threads);
+    std::vector<Point> candidates;
+    scheduler.run([&] {
+      std::array<Point, 8> octagon = extremes(scheduler, points);
+      std::array<Point, 8> next;
+      for (size_t e = 0; e < 8; e++) {
+        next[e] = octagon[(e + 1) % 8];
+      }
+
+      // 标签不是kInside的点至少在八边形一条边的严格右侧（外侧）
+      size_t chunks = chunk_count(scheduler, n);
+      std::unique_ptr<uint8_t[]> labels(new uint8_t[n]);
+      std::vector<EdgeStats> stats =
+          classify_chunks(scheduler, points.x.data(), points.y.data(), n,
+                          octagon.data(), next.data(), 8, labels.get(), chunks);
+
+      // 八边形的顶点本身在边上，不会被标记，单独放在最前面
+      std::vector<size_t> offsets(chunks + 1, octagon.size());
+      for (size_t c = 0; c < chunks; c++) {
+        offsets[c + 1] = offsets[c];
+        for (size_t e = 0; e < 8; e++) {
+          offsets[c + 1] += stats[c * 8 + e].count;
+        }
+      }
+      candidates.resize(offsets[chunks]);
+      for (size_t e = 0; e < 8; e++) {
+        candidates[e] = octagon[e];
+      }
+      scheduler.parallel_for(0, chunks, 1, [&](size_t lo, size_t hi) {
+        for (size_t c = lo; c < hi; c++) {
+          size_t position = offsets[c];
+          for (size_t i = n * c / chunks; i < n * (c + 1) / chunks; i++) {
+            if (labels[i] != kInside) {
+              // 加0.0把-0.0变成+0.0，基数排序的键序才与数值序一致
+              candidates[position++] =
+                  Point(points.x[i] + 0.0, points.y[i] + 0.0);
+            }
+          }
+        }
+      });
+    });
+
+    // 先按y排序，再按x稳定排序：结果按 (x, y) 字典序
+    size_t m = candidates.size();
+    std::vector<double> keys(m);
+    for (size_t i = 0; i < m; i++) {
+      keys[i] = candidates[i].y;
+    }
+    std::vector<size_t> order = RadixSort<double>::argsort(keys, num_threads);
+    for (size_t i = 0; i < m; i++) {
+      keys[i] = candidates[order[i]].x;
+    }
+    RadixSort<double>::sort_by_key(keys, order, num_threads);
+
+    std::vector<Point> sorted(m);
+    for (size_t i = 0; i < m; i++) {
+      sorted[i] = candidates[order[i]];
+    }
+    return chain_sorted(sorted);
+  }
+
+  /**
+   * @brief 并行QuickHull
+   *
+   * 以8个方向上的极值点围成的八边形为起点，每条边右侧的点集递归处理：
+   * 找出离边 a→b 最远的点 c，它一定在凸包上；三角形 abc 内的点被丢弃，
+   * 其余的点按在 a→c 还是 c→b 右侧分成两个子问题，两个子问题spawn并行。
+   * 一次扫描同时完成分类与计数（SoA坐标，AVX2每次4个点），较大的点集按块并行
+   * 分类后按偏移分散写入子集。期望 O(n lg h)，最坏 O(nh)。
+   * 结果与 monotone_chain 相同。
+   *
+   * @param points 点集
+   * @param num_threads 线程数量
+   */
+  static std::vector<Point>
+  quick_hull(const PointSet &points,
+             size_t num_threads = std::thread::hardware_concurrency()) {
+    size_t n = points.size();
+    if (n == 0)
+      return {};
+
+    WorkStealingScheduler scheduler(num_threads);
+    std::vector<Point> boundary;
+    scheduler.run([&] {
+      std::array<Point, 8> octagon = extremes(scheduler, points);
+      std::array<Point, 8> next;
+      for (size_t e = 0; e < 8; e++) {
+        next[e] = octagon[(e + 1) % 8];
+      }
+      std::vector<HullSubset> parts =
+          partition(scheduler, points.x.data(), points.y.data(), n,
+                    octagon.data(), next.data(), 8);
+
+      std::vector<std::vector<Point>> chains(8);
+      WorkStealingScheduler::TaskGroup group;
+      for (size_t e = 0; e < 8; e++) {
+        group.spawn([&, e] {
+          hull_chain(scheduler, octagon[e], next[e], std::move(parts[e]),
+                     chains[e]);
+        });
+      }
+      group.sync();
+
+      for (size_t e = 0; e < 8; e++) {
+        boundary.push_back(octagon[e]);
+        boundary.insert(boundary.end(), chains[e].begin(), chains[e].end());
+      }
+    });
+    return strict_vertices(boundary);
+  }
+
+  /**
+   * @brief 从 std::vector<Point> 构造SoA点集后调用并行QuickHull
+   */
+  static std::vector<Point>
+  quick_hull(const std::vector<Point> &points,
+             size_t num_threads = std::thread::hardware_concurrency()) {
+    return quick_hull(PointSet(points), num_threads);
+  }
+
+private:
+  static constexpr uint8_t kInside = 0xFF; // 不在任何一条边的右侧
+  static constexpr size_t kHullGrain = size_t(1) << 15; // 每块最少点数
+  static constexpr size_t kHullSpawnThreshold = 4096; // 子问题超过该规模才spawn
+
+  // 一条边右侧的点数，以及其中离边最远（right_key最大）的点
+  struct EdgeStats {
+    size_t count = 0;
+    double best = 0;
+    size_t best_index = 0;
+  };
+
+  // QuickHull的子问题：一条边右侧的点（SoA）和其中离边最远的点
+  struct HullSubset {
+    std::vector<double> x, y;
+    Point farthest;
+  };
+
+  static bool lexicographic_less(const Point &a, const Point &b) {
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+  }
+
+  // 点 (px, py) 在有向边 a→b 右侧时为正，等于 -cross_product(a, b, p)
+  static double right_key(const Point &a, const Point &b, double px,
+                          double py) {
+    return (b.x - a.x) * (a.y - py) + (b.y - a.y) * (px - a.x);
+  }
+
+  // 对字典序排好的点做单调链扫描
+  static std::vector<Point> chain_sorted(std::vector<Point> &points) {
+    points.erase(std::unique(points.begin(), points.end(),
+                             [](const Point &a, const Point &b) {
+                               return a.x == b.x && a.y == b.y;
+                             }),
+                 points.end());
+    size_t n = points.size();
+    if (n < 3)
+      return points;
+
+    std::vector<Point> hull(2 * n);
+    size_t k = 0;
+    // 下凸壳
+    for (size_t i = 0; i < n; i++) {
+      while (k >= 2 && SegmentProperties::cross_product(
+                           hull[k - 2], hull[k - 1], points[i]) <= 0) {
+        k--;
+      }
+      hull[k++] = points[i];
+    }
+    // 上凸壳
+    for (size_t i = n - 1, lower = k + 1; i-- > 0;) {
+      while (k >= lower && SegmentProperties::cross_product(
+                               hull[k - 2], hull[k - 1], points[i]) <= 0) {
+        k--;
+      }
+      hull[k++] = points[i];
+    }
+    // 最后一个点与起点重复
+    hull.resize(k - 1);
+    return hull;
+  }
+
+  // 按逆时针排列的凸包边界点（可能含重复点和共线点）化为严格凸的顶点序列，
+  // 从字典序最小的点开始
+  static std::vector<Point> strict_vertices(std::vector<Point> boundary) {
+    std::rotate(boundary.begin(),
+                std::min_element(boundary.begin(), boundary.end(),
+                                 lexicographic_less),
+                boundary.end());
+    boundary.push_back(boundary.front());
+
+    // 用精确的方向判定：边界上有重复点，FMA下 cross_product(p, q, q) 可能不为0
+    std::vector<Point> hull;
+    for (const auto &p : boundary) {
+      while (hull.size() >= 2 &&
+             RobustPredicates::orientation(hull[hull.size() - 2], hull.back(),
+                                           p) <= 0) {
+        hull.pop_back();
+      }
+      hull.push_back(p);
+    }
+    hull.pop_back();
+    if (hull.size() >= 3)
+      return hull;
+
+    // 所有点共线：返回字典序最小和最大的点
+    Point first = boundary.front();
+    Point last = *std::max_element(boundary.begin(), boundary.end(),
+                                   lexicographic_less);
+    if (first.x == last.x && first.y == last.y)
+      return {first};
+    return {first, last};
+  }
+
+  // 逆时针顺序的8个方向极值点：y最小、x-y最大、x最大（字典序最大）、x+y最大、
+  // y最大、x-y最小、x最小（字典序最小）、x+y最小。它们都在凸包边界上
+  static std::array<Point, 8> extremes(WorkStealingScheduler &scheduler,
+                                       const PointSet &points) {
+    const double *xs = points.x.data(), *ys = points.y.data();
+    size_t n = points.size();
+    size_t chunks = chunk_count(scheduler, n);
+    std::vector<std::array<size_t, 8>> best(chunks);
+
+    // 下标 j 的点在第 k 个方向上是否严格优于下标 i 的点
+    auto better = [&](int k, size_t j, size_t i) {
+      double xj = xs[j], yj = ys[j], xi = xs[i], yi = ys[i];
+      switch (k) {
+      case 0:
+        return yj < yi;
+      case 1:
+        return xj - yj > xi - yi;
+      case 2:
+        return xj > xi || (xj == xi && yj > yi);
+      case 3:
+        return xj + yj > xi + yi;
+      case 4:
+        return yj > yi;
+      case 5:
+        return xj - yj < xi - yi;
+      case 6:
+        return xj < xi || (xj == xi && yj < yi);
+      default:
+        return xj + yj < xi + yi;
+      }
+    };
+
+    scheduler.parallel_for(0, chunks, 1, [&](size_t lo, size_t hi) {
+      for (size_t c = lo; c < hi; c++) {
+        size_t begin = n * c / chunks, end = n * (c + 1) / chunks;
+        std::array<size_t, 8> &b = best[c];
+        b.fill(begin);
+        double min_y = ys[begin], max_y = ys[begin];
+        double min_diff = xs[begin] - ys[begin], max_diff = min_diff;
+        double min_sum = xs[begin] + ys[begin], max_sum = min_sum;
+        for (size_t i = begin + 1; i < end; i++) {
+          double x = xs[i], y = ys[i];
+          double diff = x - y, sum = x + y;
+          if (y < min_y) {
+            min_y = y;
+            b[0] = i;
+          }
+          if (diff > max_diff) {
+            max_diff = diff;
+            b[1] = i;
+          }
+          if (better(2, i, b[2]))
+            b[2] = i;
+          if (sum > max_sum) {
+            max_sum = sum;
+            b[3] = i;
+          }
+          if (y > max_y) {
+            max_y = y;
+            b[4] = i;
+          }
+          if (diff < min_diff) {
+            min_diff = diff;
+            b[5] = i;
+          }
+          if (better(6, i, b[6]))
+            b[6] = i;
+          if (sum < min_sum) {
+            min_sum = sum;
+            b[7] = i;
+          }
+        }
+      }
+    });
+
+    std::array<Point, 8> result;
+    for (int k = 0; k < 8; k++) {
+      size_t index = best[0][k];
+      for (size_t c = 1; c < chunks; c++) {
+        if (better(k, best[c][k], index))
+          index = best[c][k];
+      }
+      result[k] = Point(xs[index] + 0.0, ys[index] + 0.0);
+    }
+    return result;
+  }
+
+  static size_t chunk_count(WorkStealingScheduler &scheduler, size_t n) {
+    return std::max<size_t>(
+        1, std::min(4 * scheduler.get_num_threads(), n / kHullGrain));
+  }
+
+  // 按块并行分类，返回 stats[c * edges + e]：第 c 块中标签为 e 的点的统计
+  static std::vector<EdgeStats>
+  classify_chunks(WorkStealingScheduler &scheduler, const double *xs,
+                  const double *ys, size_t n, const Point *from,
+                  const Point *to, size_t edges, uint8_t *labels,
+                  size_t chunks) {
+    std::vector<EdgeStats> stats(chunks * edges);
+    scheduler.parallel_for(0, chunks, 1, [&](size_t lo, size_t hi) {
+      for (size_t c = lo; c < hi; c++) {
+        classify(xs, ys, n * c / chunks, n * (c + 1) / chunks, from, to,
+                 edges, labels, &stats[c * edges]);
+      }
+    });
+    return stats;
+  }
+
+  // 把点分到各条边右侧的子集中，每个点最多属于一个子集
+  // （边的端点都在凸包边界上且按逆时针排列时成立），并求出每个子集中离边最远的点
+  static std::vector<HullSubset>
+  partition(WorkStealingScheduler &scheduler, const double *xs,
+            const double *ys, size_t n, const Point *from, const Point *to,
+            size_t edges) {
+    size_t chunks = chunk_count(scheduler, n);
+    std::unique_ptr<uint8_t[]> labels(new uint8_t[n]);
+    std::vector<EdgeStats> stats = classify_chunks(
+        scheduler, xs, ys, n, from, to, edges, labels.get(), chunks);
+
+    // offsets[c * edges + e]：第 c 块中标签为 e 的点在子集 e 中的起始位置
+    std::vector<HullSubset> parts(edges);
+    std::vector<size_t> offsets(chunks * edges);
+    for (size_t e = 0; e < edges; e++) {
+      size_t total = 0;
+      EdgeStats best;
+      for (size_t c = 0; c < chunks; c++) {
+        const EdgeStats &s = stats[c * edges + e];
+        offsets[c * edges + e] = total;
+        total += s.count;
+        if (s.best > best.best)
+          best = s;
+      }
+      parts[e].x.resize(total);
+      parts[e].y.resize(total);
+      if (total > 0)
+        parts[e].farthest = Point(xs[best.best_index], ys[best.best_index]);
+    }
+
+    scheduler.parallel_for(0, chunks, 1, [&](size_t lo, size_t hi) {
+      for (size_t c = lo; c < hi; c++) {
+        size_t *position = &offsets[c * edges];
+        for (size_t i = n * c / chunks; i < n * (c + 1) / chunks; i++) {
+          uint8_t label = labels[i];
+          if (label != kInside) {
+            size_t p = position[label]++;
+            parts[label].x[p] = xs[i];
+            parts[label].y[p] = ys[i];
+          }
+        }
+      }
+    });
+    return parts;
+  }
+
+  // set 是边 a→b 右侧的点，按从 a 到 b 的顺序把两者之间的凸包顶点追加到 out
+  static void hull_chain(WorkStealingScheduler &scheduler, const Point &a,
+                         const Point &b, HullSubset set,
+                         std::vector<Point> &out) {
+    size_t n = set.x.size();
+    if (n == 0)
+      return;
+
+    Point c = set.farthest;
+    Point from[2] = {a, c}, to[2] = {c, b};
+    std::vector<HullSubset> parts =
+        partition(scheduler, set.x.data(), set.y.data(), n, from, to, 2);
+    set = HullSubset(); // 三角形abc内的点不再需要
+
+    if (n <= kHullSpawnThreshold) {
+      hull_chain(scheduler, a, c, std::move(parts[0]), out);
+      out.push_back(c);
+      hull_chain(scheduler, c, b, std::move(parts[1]), out);
+      return;
+    }
+
+    std::vector<Point> left, right;
+    WorkStealingScheduler::TaskGroup group;
+    group.spawn(
+        [&] { hull_chain(scheduler, a, c, std::move(parts[0]), left); });
+    hull_chain(scheduler, c, b, std::move(parts[1]), right);
+    group.sync();
+    out.insert(out.end(), left.begin(), left.end());
+    out.push_back(c);
+    out.insert(out.end(), right.begin(), right.end());
+  }
+
+  // 对第 [lo, hi) 个点，找出第一条使它严格位于右侧的边，标签写入 labels[i]
+  // （没有这样的边时为kInside），并在 stats[e] 中累计点数与离边最远的点。
+  // 与边的端点重合的点按坐标直接排除：编译器把 right_key 融合成FMA时，
+  // right_key(a, c, c) 可能不为0，最远点c会落进自己的子集而无限递归
+  static void classify(const double *xs, const double *ys, size_t lo,
+                       size_t hi, const Point *from, const Point *to,
+                       size_t edges, uint8_t *labels, EdgeStats *stats) {
+#ifdef ALGORITHMS_GEMM_X86
+    if (CpuFeatures::avx2()) {
+      lo = classify_avx2(xs, ys, lo, hi, from, to, edges, labels, stats);
+    }
+#endif
+    for (size_t i = lo; i < hi; i++) {
+      uint8_t label = kInside;
+      for (size_t e = 0; e < edges; e++) {
+        double key = right_key(from[e], to[e], xs[i], ys[i]);
+        if (key > 0 && !is_endpoint(from[e], to[e], xs[i], ys[i])) {
+          label = static_cast<uint8_t>(e);
+          stats[e].count++;
+          if (key > stats[e].best) {
+            stats[e].best = key;
+            stats[e].best_index = i;
+          }
+          break;
+        }
+      }
+      labels[i] = label;
+    }
+  }
+
+  static bool is_endpoint(const Point &a, const Point &b, double x, double y) {
+    return (x == a.x && y == a.y) || (x == b.x && y == b.y);
+  }
+
+#ifdef ALGORITHMS_GEMM_X86
+  // 每次处理4个点，返回尚未处理的第一个下标。right_key的运算顺序与标量版本
+  // 相同（不使用FMA），两者对同一个点给出相同的标签
+  __attribute__((target("avx2"))) static size_t
+  classify_avx2(const double *xs, const double *ys, size_t lo, size_t hi,
+                const Point *from, const Point *to, size_t edges,
+                uint8_t *labels, EdgeStats *stats) {
+    __m256d ax[8], ay[8], bx[8], by[8], dx[8], dy[8], best[8];
+    __m256i best_index[8];
+    size_t count[8] = {};
+    for (size_t e = 0; e < edges; e++) {
+      ax[e] = _mm256_set1_pd(from[e].x);
+      ay[e] = _mm256_set1_pd(from[e].y);
+      bx[e] = _mm256_set1_pd(to[e].x);
+      by[e] = _mm256_set1_pd(to[e].y);
+      dx[e] = _mm256_set1_pd(to[e].x - from[e].x);
+      dy[e] = _mm256_set1_pd(to[e].y - from[e].y);
+      best[e] = _mm256_setzero_pd();
+      best_index[e] = _mm256_setzero_si256();
+    }
+
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256i four = _mm256_set1_epi64x(4);
+    __m256i index = _mm256_setr_epi64x(static_cast<long long>(lo),
+                                       static_cast<long long>(lo + 1),
+                                       static_cast<long long>(lo + 2),
+                                       static_cast<long long>(lo + 3));
+    size_t i = lo;
+    for (; i + 4 <= hi; i += 4) {
+      __m256d x = _mm256_loadu_pd(xs + i);
+      __m256d y = _mm256_loadu_pd(ys + i);
+      __m256d unassigned = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+      uint32_t packed = 0xFFFFFFFFu; // 4个点的标签，每个一字节
+      for (size_t e = 0; e < edges; e++) {
+        __m256d key =
+            _mm256_add_pd(_mm256_mul_pd(dx[e], _mm256_sub_pd(ay[e], y)),
+                          _mm256_mul_pd(dy[e], _mm256_sub_pd(x, ax[e])));
+        __m256d endpoint = _mm256_or_pd(
+            _mm256_and_pd(_mm256_cmp_pd(x, ax[e], _CMP_EQ_OQ),
+                          _mm256_cmp_pd(y, ay[e], _CMP_EQ_OQ)),
+            _mm256_and_pd(_mm256_cmp_pd(x, bx[e], _CMP_EQ_OQ),
+                          _mm256_cmp_pd(y, by[e], _CMP_EQ_OQ)));
+        __m256d hit = _mm256_andnot_pd(
+            endpoint,
+            _mm256_and_pd(_mm256_cmp_pd(key, zero, _CMP_GT_OQ), unassigned));
+        int mask = _mm256_movemask_pd(hit);
+        if (mask == 0)
+          continue;
+        unassigned = _mm256_andnot_pd(hit, unassigned);
+        count[e] += __builtin_popcount(mask);
+        __m256d improved =
+            _mm256_and_pd(_mm256_cmp_pd(key, best[e], _CMP_GT_OQ), hit);
+        best[e] = _mm256_blendv_pd(best[e], key, improved);
+        best_index[e] = _mm256_castpd_si256(
+            _mm256_blendv_pd(_mm256_castsi256_pd(best_index[e]),
+                             _mm256_castsi256_pd(index), improved));
+        for (int lane = 0; lane < 4; lane++) {
+          if (mask >> lane & 1) {
+            packed &= ~(0xFFu << (8 * lane));
+            packed |= static_cast<uint32_t>(e) << (8 * lane);
+          }
+        }
+      }
+      std::memcpy(labels + i, &packed, sizeof(packed));
+      index = _mm256_add_epi64(index, four);
+    }
+
+    for (size_t e = 0; e < edges; e++) {
+      alignas(32) double lane_best[4];
+      alignas(32) long long lane_index[4];
+      _mm256_store_pd(lane_best, best[e]);
+      _mm256_store_si256(reinterpret_cast<__m256i *>(lane_index),
+                         best_index[e]);
+      stats[e].count += count[e];
+      for (int lane = 0; lane < 4; lane++) {
+        if (lane_best[lane] > stats[e].best) {
+          stats[e].best = lane_best[lane];
+          stats[e].best_index = static_cast<size_t>(lane_index[lane]);
+        }
+      }
+    }
+    return i;
+  }
+#endif
 };
 
 // 33.4 寻找最近点对
@@ -296,10 +1112,17 @@ private:
   }
 };
 
+// 一对相交的线段：下标 first < second，point 为交点
+// （接触时为接触点，共线重叠时为重叠部分字典序最小的端点）
+struct SegmentCrossing {
+  size_t first, second;
+  Point point;
+};
+
 // 33.5 线段相交检测
 class SegmentIntersection {
 public:
-  // 扫描线算法检测线段相交
+  // 逐对检查所有线段，O(n²)
   static std::vector<std::pair<Segment, Segment>>
   find_intersections(const std::vector<Segment> &segments) {
     std::vector<std::pair<Segment, Segment>> intersections;
@@ -314,6 +1137,453 @@ public:
 
     return intersections;
   }
+
+  /**
+   * @brief Bentley–Ottmann扫描线算法，报告所有相交的线段对
+   *
+   * 扫描线按 (x, y) 字典序从左向右移动（竖直线段从下端点开始），事件有两类：
+   * - 端点事件：所有端点预先排序。在点 p 处，用状态树找出内部经过 p 的线段，
+   *   它们与以 p 为端点的线段两两相交于 p；删去在 p 结束和经过 p 的线段，
+   *   再把经过 p 和从 p 开始的线段按 p 右侧的上下次序插回
+   * - 交叉事件：两条线段在彼此内部真相交时，在交点处交换它们在状态中的位置
+   * 只有在状态中相邻的线段对才需要检查，O((n + k) lg n)，k 为相交的线段对数。
+   *
+   * 状态是以 IntrusiveRBTree 为核心的红黑树，比较器以当前事件点为参数：
+   * 线段相对事件点的上下用 RobustPredicates 精确判断，经过事件点的线段再按方向比较。
+   * 是否相交、是否真相交都由精确谓词决定。交叉事件按浮点交点坐标及其误差界排序，
+   * 误差界无法区分先后时，改用展开式精确比较有理数坐标（每个事件只算一次并保存），
+   * 因此几乎平行的线段也不会出错；报告的交点坐标是浮点近似值。
+   * 接触（端点落在另一条线段上）与共线重叠都算相交。
+   *
+   * @param segments 线段集合
+   * @return 按扫描顺序报告的相交线段对
+   */
+  static std::vector<SegmentCrossing>
+  bentley_ottmann(const std::vector<Segment> &segments) {
+    return Sweep(segments).run();
+  }
+
+private:
+  class Sweep {
+  public:
+    explicit Sweep(const std::vector<Segment> &segments)
+        : count(segments.size()), left(count), right(count),
+          node_of(count, Tree::kNil), grouped_at(count, 0), ending_at(count, 0),
+          crossings(CrossingLater{this}) {
+      if (count > Tree::kMaxNodes) {
+        throw std::length_error("bentley_ottmann: too many segments");
+      }
+      for (size_t i = 0; i < count; i++) {
+        const Segment &s = segments[i];
+        bool forward = s.p1.x < s.p2.x || (s.p1.x == s.p2.x && s.p1.y <= s.p2.y);
+        left[i] = forward ? s.p1 : s.p2;
+        right[i] = forward ? s.p2 : s.p1;
+      }
+      status.reserve(count);
+    }
+
+    // 交叉事件的比较器持有 this
+    Sweep(const Sweep &) = delete;
+    Sweep &operator=(const Sweep &) = delete;
+
+    std::vector<SegmentCrossing> run() {
+      std::vector<Endpoint> endpoints;
+      endpoints.reserve(2 * count);
+      for (size_t i = 0; i < count; i++) {
+        uint32_t id = static_cast<uint32_t>(i);
+        endpoints.push_back({left[i], id, true});
+        endpoints.push_back({right[i], id, false});
+      }
+      std::sort(endpoints.begin(), endpoints.end(),
+                [](const Endpoint &a, const Endpoint &b) {
+                  return point_less(a.point, b.point);
+                });
+
+      // 同一点上先处理端点事件，留下的交叉事件若已过时会被跳过
+      size_t next = 0;
+      while (next < endpoints.size() || !crossings.empty()) {
+        if (next < endpoints.size() &&
+            (crossings.empty() ||
+             !before(crossings.top(), endpoints[next].point))) {
+          size_t end = next + 1;
+          while (end < endpoints.size() &&
+                 same_point(endpoints[end].point, endpoints[next].point)) {
+            end++;
+          }
+          handle_endpoints(endpoints, next, end);
+          next = end;
+        } else {
+          Crossing event = crossings.top();
+          crossings.pop();
+          handle_crossing(event);
+          release_slot(event.slot);
+        }
+      }
+      return std::move(result);
+    }
+
+  private:
+    struct Entry {
+      uint32_t segment = 0;
+    };
+    using Tree = IntrusiveRBTree<Entry>;
+    using Node = Tree::Node;
+    using index_type = Tree::index_type;
+
+    struct Endpoint {
+      Point point;
+      uint32_t segment;
+      bool is_left;
+    };
+
+    using Expansion = RobustPredicates::Expansion;
+
+    struct Crossing {
+      Point point;                   // 浮点交点
+      double error_x, error_y;       // 与精确交点坐标之差的上界
+      uint32_t lower, upper;         // 交换前 lower 在 upper 的正下方
+      uint32_t slot;                 // 精确交点在 exact_cache 中的位置
+    };
+
+    struct CrossingLater {
+      const Sweep *sweep;
+      bool operator()(const Crossing &a, const Crossing &b) const {
+        return sweep->before(b, a);
+      }
+    };
+
+    // 精确交点 (coordinate[0] / q, coordinate[1] / q)
+    struct ExactCrossing {
+      Expansion coordinate[2], q;
+      bool ready = false;
+    };
+
+    size_t count;
+    std::vector<Point> left, right; // 按字典序规范化后的端点
+    Tree status;                    // 自下而上
+    std::vector<index_type> node_of; // 线段在状态中的节点，不在状态中时为kNil
+    // 第几个端点事件中该线段已加入经过事件点的集合 / 在事件点结束
+    std::vector<size_t> grouped_at, ending_at;
+    size_t epoch = 0;
+    std::priority_queue<Crossing, std::vector<Crossing>, CrossingLater>
+        crossings;
+    // 队列中每个交叉事件占一个位置，精确交点第一次用到时计算并保存，
+    // 堆比较时不再重复计算；事件处理后位置回收
+    mutable std::vector<ExactCrossing> exact_cache;
+    std::vector<uint32_t> free_slots;
+    FlatHashMap<uint64_t, bool> reported;
+    std::vector<SegmentCrossing> result;
+    Point sweep; // 当前端点事件的位置
+
+    static bool point_less(const Point &a, const Point &b) {
+      return a.x < b.x || (a.x == b.x && a.y < b.y);
+    }
+
+    static bool same_point(const Point &a, const Point &b) {
+      return a.x == b.x && a.y == b.y;
+    }
+
+    Segment segment(uint32_t s) const { return Segment(left[s], right[s]); }
+
+    uint32_t segment_at(index_type x) const { return status.node(x).segment; }
+
+    // 事件点 p 相对线段 s：1 在上方，0 在 s 所在直线上，-1 在下方
+    int side(uint32_t s, const Point &p) const {
+      return RobustPredicates::orientation(left[s], right[s], p);
+    }
+
+    // 都经过当前事件点的 t、s 在其右侧的上下次序：方向按逆时针排序，共线时按下标
+    bool below_after(uint32_t t, uint32_t s) const {
+      int turn =
+          RobustPredicates::cross_sign(left[t], right[t], left[s], right[s]);
+      return turn != 0 ? turn > 0 : t < s;
+    }
+
+    void insert(uint32_t t) {
+      node_of[t] = status.insert(Entry{t}, [&](const Node &a, const Node &b) {
+        int position = side(b.segment, sweep);
+        return position != 0 ? position < 0 : below_after(a.segment, b.segment);
+      });
+    }
+
+    void erase(uint32_t s) {
+      status.erase(node_of[s]);
+      node_of[s] = Tree::kNil;
+    }
+
+    // 从下往上第一条不在 p 下方的线段（p 在其上或下方）
+    index_type first_not_below(const Point &p) const {
+      return status.partition_point(
+          [&](const Node &node) { return side(node.segment, p) > 0; });
+    }
+
+    bool report(uint32_t s, uint32_t t, const Point &point) {
+      uint32_t a = std::min(s, t), b = std::max(s, t);
+      uint64_t key = (uint64_t(a) << 32) | b;
+      if (!reported.emplace(key, true).second)
+        return false;
+      result.push_back({a, b, point});
+      return true;
+    }
+
+    void handle_endpoints(const std::vector<Endpoint> &endpoints, size_t begin,
+                          size_t end) {
+      sweep = endpoints[begin].point;
+      epoch++;
+
+      // 状态中经过 p 的线段是连续的一段（包括在 p 结束的线段）
+      std::vector<uint32_t> group, starting, reinsert;
+      for (index_type x = first_not_below(sweep);
+           x != Tree::kNil && side(segment_at(x), sweep) == 0;
+           x = status.successor(x)) {
+        group.push_back(segment_at(x));
+        grouped_at[segment_at(x)] = epoch;
+      }
+      for (size_t i = begin; i < end; i++) {
+        if (!endpoints[i].is_left) {
+          ending_at[endpoints[i].segment] = epoch;
+        }
+      }
+      for (size_t i = begin; i < end; i++) {
+        uint32_t s = endpoints[i].segment;
+        if (grouped_at[s] != epoch) {
+          group.push_back(s);
+          grouped_at[s] = epoch;
+        }
+        // 长度为0的线段只参与报告，不进入状态
+        if (endpoints[i].is_left && ending_at[s] != epoch) {
+          starting.push_back(s);
+        }
+      }
+
+      // 经过 p 的线段两两相交于 p
+      for (size_t i = 0; i < group.size(); i++) {
+        for (size_t j = i + 1; j < group.size(); j++) {
+          report(group[i], group[j], sweep);
+        }
+      }
+
+      // 删去在 p 结束和经过 p 的线段，再把继续向右的线段按 p 右侧的次序插回
+      for (uint32_t s : group) {
+        if (node_of[s] != Tree::kNil) {
+          if (ending_at[s] != epoch) {
+            reinsert.push_back(s);
+          }
+          erase(s);
+        }
+      }
+      reinsert.insert(reinsert.end(), starting.begin(), starting.end());
+      for (uint32_t s : reinsert) {
+        insert(s);
+      }
+
+      // 检查新的相邻线段对；predecessor(kNil) 为最大节点
+      if (reinsert.empty()) {
+        index_type above = first_not_below(sweep);
+        check(status.predecessor(above), above);
+        return;
+      }
+      index_type lowest = first_not_below(sweep), highest = lowest;
+      for (size_t i = 1; i < reinsert.size(); i++) {
+        highest = status.successor(highest);
+      }
+      check(status.predecessor(lowest), lowest);
+      check(highest, status.successor(highest));
+    }
+
+    void handle_crossing(const Crossing &event) {
+      index_type x = node_of[event.lower], y = node_of[event.upper];
+      if (x == Tree::kNil || y == Tree::kNil || status.successor(x) != y)
+        return; // 已经交换过或不再相邻
+      status.node(x).segment = event.upper;
+      status.node(y).segment = event.lower;
+      node_of[event.upper] = x;
+      node_of[event.lower] = y;
+      check(status.predecessor(x), x);
+      check(y, status.successor(y));
+    }
+
+    // 状态中相邻的 lower（下）、upper（上）：相交则报告；
+    // 真相交且 lower 在交点之后应位于上方时加入交叉事件
+    void check(index_type lower, index_type upper) {
+      if (lower == Tree::kNil || upper == Tree::kNil)
+        return;
+      uint32_t s = segment_at(lower), t = segment_at(upper);
+      int d1 = side(t, left[s]), d2 = side(t, right[s]);
+      int d3 = side(s, left[t]), d4 = side(s, right[t]);
+      bool proper = d1 * d2 < 0 && d3 * d4 < 0;
+
+      Crossing crossing{};
+      Point &point = crossing.point;
+      if (proper) {
+        crossing = crossing_at(s, t);
+      } else if (d1 == 0 && d2 == 0) {
+        // 共线：外接矩形有公共部分时重叠，起点为较靠右的左端点
+        point = point_less(left[s], left[t]) ? left[t] : left[s];
+        if (point_less(right[s], point) || point_less(right[t], point))
+          return;
+      } else if (d1 == 0 && RobustPredicates::in_box(left[s], segment(t))) {
+        point = left[s];
+      } else if (d2 == 0 && RobustPredicates::in_box(right[s], segment(t))) {
+        point = right[s];
+      } else if (d3 == 0 && RobustPredicates::in_box(left[t], segment(s))) {
+        point = left[t];
+      } else if (d4 == 0 && RobustPredicates::in_box(right[t], segment(s))) {
+        point = right[t];
+      } else {
+        return;
+      }
+      report(s, t, point);
+
+      if (proper && below_after(t, s)) {
+        crossing.slot = acquire_slot();
+        tighten(crossing);
+        crossings.push(crossing);
+      }
+    }
+
+    uint32_t acquire_slot() {
+      if (free_slots.empty()) {
+        exact_cache.emplace_back();
+        return static_cast<uint32_t>(exact_cache.size() - 1);
+      }
+      uint32_t slot = free_slots.back();
+      free_slots.pop_back();
+      return slot;
+    }
+
+    void release_slot(uint32_t slot) {
+      exact_cache[slot].ready = false;
+      free_slots.push_back(slot);
+    }
+
+    // 真相交的两条线段 s、t 的浮点交点及误差界，交点截断到两者外接矩形的公共部分。
+    // 交点为 a + u(b - a)，u = ((c - a) × (d - c)) / ((b - a) × (d - c))；
+    // 分子分母的误差界与 cross_sign 的过滤条件同理，分母可能为0时误差界取无穷大
+    Crossing crossing_at(uint32_t s, uint32_t t) const {
+      const Point &a = left[s], &b = right[s], &c = left[t], &d = right[t];
+      constexpr double eps = RobustPredicates::kEpsilon;
+      double ux = b.x - a.x, uy = b.y - a.y, vx = d.x - c.x, vy = d.y - c.y;
+      double wx = c.x - a.x, wy = c.y - a.y;
+      double denominator = ux * vy - uy * vx, numerator = wx * vy - wy * vx;
+      double denominator_error = 4 * eps * (std::abs(ux * vy) + std::abs(uy * vx));
+      double numerator_error = 4 * eps * (std::abs(wx * vy) + std::abs(wy * vx));
+
+      double low_x = std::max(a.x, c.x), high_x = std::min(b.x, d.x);
+      double low_y = std::max(std::min(a.y, b.y), std::min(c.y, d.y));
+      double high_y = std::min(std::max(a.y, b.y), std::max(c.y, d.y));
+      Crossing crossing{};
+      crossing.lower = s;
+      crossing.upper = t;
+      if (!(std::abs(denominator) > 2 * denominator_error)) {
+        // 几乎平行：取公共矩形的中心，比较时总是走精确路径
+        crossing.point = Point(low_x + (high_x - low_x) / 2,
+                               low_y + (high_y - low_y) / 2);
+        crossing.error_x = crossing.error_y =
+            std::numeric_limits<double>::infinity();
+        return crossing;
+      }
+      // 真交点的 u 在 (0, 1) 内，截断只会减小误差
+      double u = std::min(std::max(numerator / denominator, 0.0), 1.0);
+      double u_error = (numerator_error + u * denominator_error) /
+                           (std::abs(denominator) - denominator_error) +
+                       eps * u;
+      double x = a.x + u * ux, y = a.y + u * uy;
+      crossing.error_x = 2 * (std::abs(ux) * u_error +
+                              4 * eps * (std::abs(a.x) + std::abs(u * ux)));
+      crossing.error_y = 2 * (std::abs(uy) * u_error +
+                              4 * eps * (std::abs(a.y) + std::abs(u * uy)));
+      crossing.point = Point(std::min(std::max(x, low_x), high_x),
+                             std::min(std::max(y, low_y), high_y));
+      return crossing;
+    }
+
+    const ExactCrossing &exact(const Crossing &crossing) const {
+      using R = RobustPredicates;
+      ExactCrossing &e = exact_cache[crossing.slot];
+      if (e.ready)
+        return e;
+      const Point &a = left[crossing.lower], &b = right[crossing.lower];
+      const Point &c = left[crossing.upper], &d = right[crossing.upper];
+      e.q = R::cross(a, b, c, d);
+      Expansion numerator = R::cross(a, c, c, d);
+      e.coordinate[0] = R::sum(R::product(R::difference(a.x, 0), e.q),
+                               R::product(numerator, R::difference(b.x, a.x)));
+      e.coordinate[1] = R::sum(R::product(R::difference(a.y, 0), e.q),
+                               R::product(numerator, R::difference(b.y, a.y)));
+      e.ready = true;
+      return e;
+    }
+
+    // 几乎平行的两条线段，crossing_at 给出的误差界很大甚至无穷大，
+    // 事件在堆中的每次比较都要走精确路径。这时先算出精确交点，
+    // 再由它得到误差界只有若干 ε 的浮点交点。
+    // 无重叠展开式各分量从小到大求和，相对误差不超过 2(m + 1)ε（m 为分量数）
+    void tighten(Crossing &crossing) const {
+      constexpr double eps = RobustPredicates::kEpsilon;
+      constexpr double kLoose = 1024 * eps;
+      if (!(crossing.error_x > kLoose * std::abs(crossing.point.x) ||
+            crossing.error_y > kLoose * std::abs(crossing.point.y)))
+        return;
+      const ExactCrossing &e = exact(crossing);
+      auto estimate = [](const Expansion &expansion, double &relative_error) {
+        double value = 0;
+        for (double component : expansion) {
+          value += component;
+        }
+        relative_error = 2 * (expansion.size() + 1) * eps;
+        return value;
+      };
+      double q_error, x_error, y_error;
+      double q = estimate(e.q, q_error);
+      double x = estimate(e.coordinate[0], x_error) / q;
+      double y = estimate(e.coordinate[1], y_error) / q;
+      crossing.point = Point(x, y);
+      crossing.error_x = 2 * std::abs(x) * (x_error + q_error + eps);
+      crossing.error_y = 2 * std::abs(y) * (y_error + q_error + eps);
+    }
+
+    // 交叉事件 a 的第 k 个坐标（0 为 x，1 为 y）与 value 比较的符号
+    int compare(const Crossing &a, int k, double value) const {
+      double coordinate = k ? a.point.y : a.point.x;
+      double error = k ? a.error_y : a.error_x;
+      if (coordinate - error > value)
+        return 1;
+      if (coordinate + error < value)
+        return -1;
+      using R = RobustPredicates;
+      const ExactCrossing &e = exact(a);
+      return R::sign(R::sum(e.coordinate[k],
+                            R::negate(R::product(e.q, R::difference(value, 0))))) *
+             R::sign(e.q);
+    }
+
+    // 交叉事件 a、b 的第 k 个坐标比较的符号
+    int compare(const Crossing &a, const Crossing &b, int k) const {
+      double ca = k ? a.point.y : a.point.x, cb = k ? b.point.y : b.point.x;
+      double error = k ? a.error_y + b.error_y : a.error_x + b.error_x;
+      if (ca - cb > error)
+        return 1;
+      if (cb - ca > error)
+        return -1;
+      using R = RobustPredicates;
+      const ExactCrossing &ea = exact(a), &eb = exact(b);
+      return R::sign(R::sum(R::product(ea.coordinate[k], eb.q),
+                            R::negate(R::product(eb.coordinate[k], ea.q)))) *
+             R::sign(ea.q) * R::sign(eb.q);
+    }
+
+    // 按 (x, y) 字典序严格在前
+    bool before(const Crossing &a, const Point &p) const {
+      int x = compare(a, 0, p.x);
+      return x != 0 ? x < 0 : compare(a, 1, p.y) < 0;
+    }
+
+    bool before(const Crossing &a, const Crossing &b) const {
+      int x = compare(a, b, 0);
+      return x != 0 ? x < 0 : compare(a, b, 1) < 0;
+    }
+  };
 };
 
 } // namespace algorithms
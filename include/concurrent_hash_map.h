@@ -0,0 +1,175 @@
+#ifndef CONCURRENT_HASH_MAP_H
+#define CONCURRENT_HASH_MAP_H
+
+#include "flat_hash_map.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace algorithms {
+
+/**
+ * @brief 分片并发散列表（锁分段）
+ *
+ * - 键按散列值的高位分到2的幂个分片，每个分片是一个FlatHashMap和一把读写锁
+ * - 查找只取分片的共享锁，不同分片上的写操作互不阻塞
+ * - 分片按缓存行对齐，避免相邻分片的锁产生伪共享
+ * - 分片选择与分片内部使用散列值的不同位，分片内仍然分布均匀
+ * 值通过拷贝返回（std::optional），不会把表内指针泄露到锁外；
+ * 需要原地修改时使用update/upsert，回调在分片的独占锁内执行。
+ */
+template <typename K, typename V, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+class ConcurrentHashMap {
+public:
+  // shard_count取不小于参数的2的幂；默认是硬件线程数的4倍，至少16
+  explicit ConcurrentHashMap(size_t shard_count = 0,
+                             size_t initial_capacity = 0,
+                             const Hash &hash = Hash())
+      : hasher(hash) {
+    if (shard_count == 0) {
+      shard_count = std::max<size_t>(16, 4 * std::thread::hardware_concurrency());
+    }
+    size_t count = 1;
+    while (count < shard_count) {
+      count *= 2;
+      shard_bits++;
+    }
+    num_shards = count;
+    shards.reset(new Shard[num_shards]);
+    // 分片内的表与分片选择使用同一个散列函数对象
+    size_t shard_capacity =
+        initial_capacity > 0 ? initial_capacity / num_shards + 1 : 0;
+    for (size_t i = 0; i < num_shards; i++) {
+      Map &map = shards[i].map;
+      map = Map(shard_capacity, map.max_load_factor(), hasher);
+    }
+  }
+
+  ConcurrentHashMap(const ConcurrentHashMap &) = delete;
+  ConcurrentHashMap &operator=(const ConcurrentHashMap &) = delete;
+
+  // 插入或覆盖，返回是否为新键
+  bool insert(const K &key, const V &value) {
+    Shard &shard = shard_for(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto result = shard.map.emplace(key, value);
+    if (!result.second) {
+      *result.first = value;
+    }
+    return result.second;
+  }
+
+  // 仅当键不存在时插入，返回是否插入
+  bool insert_if_absent(const K &key, const V &value) {
+    Shard &shard = shard_for(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.map.emplace(key, value).second;
+  }
+
+  std::optional<V> find(const K &key) const {
+    const Shard &shard = shard_for(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    const V *value = shard.map.find(key);
+    return value ? std::optional<V>(*value) : std::nullopt;
+  }
+
+  bool contains(const K &key) const {
+    const Shard &shard = shard_for(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.map.contains(key);
+  }
+
+  bool remove(const K &key) {
+    Shard &shard = shard_for(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.map.erase(key);
+  }
+
+  // 键存在时在独占锁内执行f(value)，返回键是否存在
+  template <typename F> bool update(const K &key, F f) {
+    Shard &shard = shard_for(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    V *value = shard.map.find(key);
+    if (value == nullptr) {
+      return false;
+    }
+    f(*value);
+    return true;
+  }
+
+  // 键不存在时先插入initial，再在独占锁内执行f(value)，返回更新后的值
+  template <typename F> V upsert(const K &key, const V &initial, F f) {
+    Shard &shard = shard_for(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    V &value = *shard.map.emplace(key, initial).first;
+    f(value);
+    return value;
+  }
+
+  // 元素总数：逐个分片加锁统计，并发修改时只是近似值
+  size_t size() const {
+    size_t total = 0;
+    for (size_t i = 0; i < num_shards; i++) {
+      std::shared_lock<std::shared_mutex> lock(shards[i].mutex);
+      total += shards[i].map.size();
+    }
+    return total;
+  }
+
+  void clear() {
+    for (size_t i = 0; i < num_shards; i++) {
+      std::unique_lock<std::shared_mutex> lock(shards[i].mutex);
+      shards[i].map.clear();
+    }
+  }
+
+  // 遍历所有元素：逐个分片持共享锁调用visit(key, value)，visit内不能访问本表
+  template <typename Visitor> void for_each(Visitor visit) const {
+    for (size_t i = 0; i < num_shards; i++) {
+      std::shared_lock<std::shared_mutex> lock(shards[i].mutex);
+      shards[i].map.for_each(visit);
+    }
+  }
+
+  size_t shard_count() const { return num_shards; }
+
+private:
+  using Map = FlatHashMap<K, V, Hash, KeyEqual>;
+
+  struct alignas(64) Shard {
+    mutable std::shared_mutex mutex;
+    Map map;
+  };
+
+  Hash hasher;
+  size_t num_shards = 1;
+  int shard_bits = 0;
+  std::unique_ptr<Shard[]> shards;
+
+  // 用另一个乘法常数混合后取高位；FlatHashMap内部使用的是另一组位
+  size_t shard_index(const K &key) const {
+    if (shard_bits == 0) {
+      return 0;
+    }
+    uint64_t h = static_cast<uint64_t>(hasher(key)) * 0xC2B2AE3D27D4EB4FULL;
+    return static_cast<size_t>(h >> (64 - shard_bits));
+  }
+
+  Shard &shard_for(const K &key) { return shards[shard_index(key)]; }
+  const Shard &shard_for(const K &key) const {
+    return shards[shard_index(key)];
+  }
+};
+
+} // namespace algorithms
+
+#endif // CONCURRENT_HASH_MAP_H
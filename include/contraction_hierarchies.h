@@ -0,0 +1,808 @@
+#ifndef CONTRACTION_HIERARCHIES_H
+#define CONTRACTION_HIERARCHIES_H
+
+#include "graph_representation.h"
+#include "point_to_point_shortest_path.h"
+#include "radix_heap.h"
+#include "work_stealing_scheduler.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+
+/**
+ * @brief 收缩层次（Contraction Hierarchies，Geisberger等人）
+ *
+ * 预处理按优先级逐个"收缩"节点：删除节点 u 时，对每对邻居 a → u → b，
+ * 若不经过 u 的见证路径（witness）都比 a → u → b 长，就加入捷径 a → b。
+ * 收缩顺序即节点的秩（rank）。之后任意两点间都存在一条先升秩、后降秩的
+ * 最短路径，查询只需从源点沿"向上"边、从终点沿反向的"向下"边各做一次
+ * 很小的Dijkstra。
+ *
+ * - 优先级：边差（需要的捷径数 - 删除的边数）加上已收缩的邻居数，
+ *   后者使收缩在图上分布均匀。
+ * - 并行：每轮选出优先级严格小于所有未收缩邻居的节点，它们互不相邻，
+ *   由调度器并行做见证搜索；见证搜索避开本轮选中的全部节点，因此同一轮
+ *   的收缩可以同时提交。被影响的邻居的优先级也并行重算。
+ * - 见证搜索在 u 的所有出邻居都已确定、距离超过 max(w(a, u) + w(u, b))
+ *   或确定的节点数达到上限时停止（估计优先级时上限更小）。找不到见证时
+ *   多加一条捷径，只影响规模，不影响正确性。
+ * - 存储：秩与向上/向下两个CSR覆盖图放在一块由64位字组成的扁平缓冲区中，
+ *   与 SuffixArray 一样可以写入文件、mmap后用 load 零拷贝加载。
+ *   向上图中节点 u 的边 u → v 满足 rank(v) > rank(u)；向下图中节点 u 存放
+ *   原方向为 v → u、rank(v) > rank(u) 的边。每条边记录中间节点，
+ *   捷径可以递归展开为原图路径。
+ *
+ * 边权必须非负。结果按节点下标。
+ */
+class ContractionHierarchy {
+public:
+  // 见证搜索最多确定的节点数：真正收缩时与估计优先级时
+  static constexpr std::size_t kWitnessSettleLimit = 500;
+  static constexpr std::size_t kSimulationSettleLimit = 50;
+
+  ContractionHierarchy() = default;
+
+  ContractionHierarchy(const ContractionHierarchy &other)
+      : storage(other.storage), base(other.base), word_count(other.word_count) {
+    if (!storage.empty()) {
+      base = storage.data();
+    }
+    bind();
+  }
+
+  ContractionHierarchy(ContractionHierarchy &&other) noexcept
+      : storage(std::move(other.storage)), base(other.base),
+        word_count(other.word_count) {
+    if (!storage.empty()) {
+      base = storage.data();
+    }
+    bind();
+  }
+
+  ContractionHierarchy &operator=(ContractionHierarchy other) {
+    storage = std::move(other.storage);
+    base = storage.empty() ? other.base : storage.data();
+    word_count = other.word_count;
+    bind();
+    return *this;
+  }
+
+  // Graph 需满足 graph_representation.h 中的图概念
+  template <typename Graph>
+  static ContractionHierarchy build(const Graph &graph) {
+    return build_impl(graph, nullptr);
+  }
+
+  template <typename Graph>
+  static ContractionHierarchy build(const Graph &graph,
+                                    WorkStealingScheduler &scheduler) {
+    return build_impl(graph, &scheduler);
+  }
+
+  /**
+   * @brief 从扁平缓冲区零拷贝加载（例如mmap得到的内存）
+   * @param data 8字节对齐的缓冲区，必须在返回对象的生命周期内保持有效
+   * @throws std::invalid_argument 头部不符，或秩、CSR偏移、边的终点与
+   *         中间节点不合法（检查需要 O(n + m) 时间）
+   */
+  static ContractionHierarchy load(const void *data, std::size_t size_bytes) {
+    if (reinterpret_cast<std::uintptr_t>(data) % alignof(std::uint64_t) != 0) {
+      throw std::invalid_argument("收缩层次缓冲区必须8字节对齐");
+    }
+    const auto *words = static_cast<const std::uint64_t *>(data);
+    std::size_t count = size_bytes / sizeof(std::uint64_t);
+    if (count < kHeaderWords || words[0] != kMagic || words[1] != kVersion ||
+        words[5] != count ||
+        count != total_words(words[2], words[3], words[4])) {
+      throw std::invalid_argument("不是有效的收缩层次缓冲区");
+    }
+    ContractionHierarchy result;
+    result.base = words;
+    result.word_count = count;
+    result.bind();
+    result.validate();
+    return result;
+  }
+
+  void save(std::ostream &out) const {
+    out.write(reinterpret_cast<const char *>(base),
+              static_cast<std::streamsize>(size_bytes()));
+  }
+
+  const void *data() const { return base; }
+  std::size_t size_bytes() const { return word_count * sizeof(std::uint64_t); }
+
+  std::size_t get_node_count() const { return node_count; }
+  std::size_t get_up_edge_count() const { return up.edge_count; }
+  std::size_t get_down_edge_count() const { return down.edge_count; }
+
+  // 节点的秩（收缩顺序），越晚收缩越大
+  std::uint32_t rank(int v) const { return ranks[v]; }
+
+  // 遍历向上边 u → v：visit(v, 权重)
+  template <typename Visitor>
+  void for_each_up_edge(int u, Visitor visit) const {
+    up.for_each(u, visit);
+  }
+
+  // 遍历向下图中 u 的边（原方向 v → u）：visit(v, 权重)
+  template <typename Visitor>
+  void for_each_down_edge(int u, Visitor visit) const {
+    down.for_each(u, visit);
+  }
+
+  /**
+   * @brief 把覆盖图上的边 a → b（原边或捷径）展开为原图路径，追加 b 之前的
+   *        中间节点与 b 本身到 path 末尾（a 应已在 path 中）
+   */
+  void unpack_edge(int a, int b, std::vector<int> &path) const {
+    std::vector<std::pair<int, int>> stack = {{a, b}};
+    while (!stack.empty()) {
+      auto [from, to] = stack.back();
+      stack.pop_back();
+      int middle = find_middle(from, to);
+      if (middle == -1) {
+        path.push_back(to);
+      } else {
+        stack.emplace_back(middle, to);
+        stack.emplace_back(from, middle);
+      }
+    }
+  }
+
+private:
+  static constexpr std::uint64_t kMagic = 0x3159484352544e43ULL; // "CNTRCHY1"
+  static constexpr std::uint64_t kVersion = 1;
+
+  // 头部：magic, version, node_count, up_edges, down_edges, total_words
+  static constexpr std::size_t kHeaderWords = 6;
+
+  // 一个CSR覆盖图：offsets 长度 n + 1，targets/weights/middles 长度为边数
+  struct Overlay {
+    std::size_t edge_count = 0;
+    const std::uint32_t *offsets = nullptr;
+    const std::int32_t *targets = nullptr;
+    const std::int32_t *weights = nullptr;
+    const std::int32_t *middles = nullptr;
+
+    template <typename Visitor> void for_each(int u, Visitor visit) const {
+      for (std::uint32_t e = offsets[u]; e < offsets[u + 1]; e++) {
+        visit(targets[e], weights[e]);
+      }
+    }
+
+    int middle_of(int u, int target) const {
+      for (std::uint32_t e = offsets[u]; e < offsets[u + 1]; e++) {
+        if (targets[e] == target) {
+          return middles[e];
+        }
+      }
+      throw std::logic_error("Overlay edge not found");
+    }
+  };
+
+  std::vector<std::uint64_t> storage; // 构建得到的缓冲区；load得到的对象不拥有内存
+  const std::uint64_t *base = nullptr;
+  std::size_t word_count = 0;
+
+  // 从缓冲区解析出的字段
+  std::size_t node_count = 0;
+  const std::uint32_t *ranks = nullptr;
+  Overlay up;
+  Overlay down;
+
+  static std::size_t words_for(std::size_t uint32_count) {
+    return (uint32_count + 1) / 2;
+  }
+
+  static std::size_t overlay_words(std::size_t n, std::size_t edges) {
+    return words_for(n + 1) + 3 * words_for(edges);
+  }
+
+  static std::size_t total_words(std::size_t n, std::size_t up_edges,
+                                 std::size_t down_edges) {
+    return kHeaderWords + words_for(n) + overlay_words(n, up_edges) +
+           overlay_words(n, down_edges);
+  }
+
+  void bind() {
+    if (base == nullptr) {
+      node_count = 0;
+      ranks = nullptr;
+      up = down = Overlay();
+      return;
+    }
+    node_count = base[2];
+    const std::uint64_t *cursor = base + kHeaderWords;
+    ranks = reinterpret_cast<const std::uint32_t *>(cursor);
+    cursor += words_for(node_count);
+    cursor = bind_overlay(up, cursor, base[3]);
+    bind_overlay(down, cursor, base[4]);
+  }
+
+  const std::uint64_t *bind_overlay(Overlay &overlay,
+                                    const std::uint64_t *cursor,
+                                    std::size_t edges) const {
+    overlay.edge_count = edges;
+    overlay.offsets = reinterpret_cast<const std::uint32_t *>(cursor);
+    cursor += words_for(node_count + 1);
+    overlay.targets = reinterpret_cast<const std::int32_t *>(cursor);
+    cursor += words_for(edges);
+    overlay.weights = reinterpret_cast<const std::int32_t *>(cursor);
+    cursor += words_for(edges);
+    overlay.middles = reinterpret_cast<const std::int32_t *>(cursor);
+    return cursor + words_for(edges);
+  }
+
+  // 查询把秩、边的终点和中间节点直接用作下标，展开捷径依赖秩的方向，
+  // 损坏的文件不能被接受
+  void validate() const {
+    std::vector<bool> seen(node_count, false);
+    for (std::size_t v = 0; v < node_count; v++) {
+      if (ranks[v] >= node_count || seen[ranks[v]]) {
+        throw std::invalid_argument("收缩层次的秩不是 [0, n) 的排列");
+      }
+      seen[ranks[v]] = true;
+    }
+    validate_overlay(up);
+    validate_overlay(down);
+  }
+
+  // 两个覆盖图中节点 u 的边都指向秩更高的 v；捷径的中间节点
+  // 比两端收缩得早，展开时秩严格下降，因此一定终止
+  void validate_overlay(const Overlay &overlay) const {
+    if (overlay.offsets[0] != 0 ||
+        overlay.offsets[node_count] != overlay.edge_count) {
+      throw std::invalid_argument("收缩层次的CSR偏移应从0开始、到边数结束");
+    }
+    for (std::size_t u = 0; u < node_count; u++) {
+      if (overlay.offsets[u] > overlay.offsets[u + 1]) {
+        throw std::invalid_argument("收缩层次的CSR偏移不单调");
+      }
+      for (std::uint32_t e = overlay.offsets[u]; e < overlay.offsets[u + 1];
+           e++) {
+        std::int32_t v = overlay.targets[e], middle = overlay.middles[e];
+        if (v < 0 || static_cast<std::size_t>(v) >= node_count ||
+            ranks[v] <= ranks[u]) {
+          throw std::invalid_argument("收缩层次的边终点越界或秩不高于起点");
+        }
+        if (middle != -1 &&
+            (middle < 0 || static_cast<std::size_t>(middle) >= node_count ||
+             ranks[middle] >= ranks[u])) {
+          throw std::invalid_argument("收缩层次的捷径中间节点越界或秩不低于两端");
+        }
+      }
+    }
+  }
+
+  // 覆盖图边 a → b 的中间节点：rank(a) < rank(b) 时在向上图 a 中，否则在向下图 b 中
+  int find_middle(int a, int b) const {
+    return ranks[a] < ranks[b] ? up.middle_of(a, b) : down.middle_of(b, a);
+  }
+
+  // ---------------- 预处理 ----------------
+
+  struct WorkEdge {
+    int to;
+    int weight;
+    int middle; // 捷径经过的被收缩节点，原边为 -1
+  };
+
+  struct Shortcut {
+    int from;
+    int to;
+    int weight;
+    int middle;
+  };
+
+  // 动态图：只保存未收缩节点之间的边，平行边只保留最短的一条
+  struct WorkGraph {
+    std::vector<std::vector<WorkEdge>> out;
+    std::vector<std::vector<WorkEdge>> in;
+
+    // 加入或缩短 from → to，返回是否改变了图
+    bool relax_edge(int from, int to, int weight, int middle) {
+      for (WorkEdge &edge : out[from]) {
+        if (edge.to == to) {
+          if (edge.weight <= weight) {
+            return false;
+          }
+          edge.weight = weight;
+          edge.middle = middle;
+          for (WorkEdge &back : in[to]) {
+            if (back.to == from) {
+              back.weight = weight;
+              back.middle = middle;
+            }
+          }
+          return true;
+        }
+      }
+      out[from].push_back({to, weight, middle});
+      in[to].push_back({from, weight, middle});
+      return true;
+    }
+
+    static void erase(std::vector<WorkEdge> &edges, int target) {
+      for (std::size_t k = 0; k < edges.size(); k++) {
+        if (edges[k].to == target) {
+          edges[k] = edges.back();
+          edges.pop_back();
+          return;
+        }
+      }
+    }
+  };
+
+  // 有界的见证搜索：复用带时间戳的距离数组，只与搜索空间成正比
+  struct WitnessSearch {
+    std::vector<std::uint32_t> stamp;
+    std::vector<int> distances;
+    std::uint32_t epoch = 0;
+    std::vector<std::uint32_t> target_stamp; // 本次收缩的出邻居
+    std::uint32_t target_epoch = 0;
+    RadixHeap<int> heap;
+
+    explicit WitnessSearch(std::size_t n)
+        : stamp(n, 0), distances(n), target_stamp(n, 0) {}
+
+    int distance(int v) const {
+      return stamp[v] == epoch ? distances[v]
+                               : std::numeric_limits<int>::max();
+    }
+
+    // 标记 u 的出邻居，之后的 run 在它们全部确定后停止
+    void set_targets(const std::vector<WorkEdge> &out) {
+      if (++target_epoch == 0) {
+        std::fill(target_stamp.begin(), target_stamp.end(), 0);
+        target_epoch = 1;
+      }
+      for (const WorkEdge &edge : out) {
+        target_stamp[edge.to] = target_epoch;
+      }
+    }
+
+    // 从 source 出发，跳过 skip(v) 为真的节点
+    template <typename Skip>
+    void run(const WorkGraph &graph, int source, int limit,
+             std::size_t settle_limit, std::size_t targets, Skip skip) {
+      if (++epoch == 0) {
+        std::fill(stamp.begin(), stamp.end(), 0);
+        epoch = 1;
+      }
+      heap.clear();
+      stamp[source] = epoch;
+      distances[source] = 0;
+      heap.push(0, source);
+      std::size_t settled = 0;
+      while (!heap.empty() && settled < settle_limit && targets > 0) {
+        auto [key, u] = heap.pop();
+        if (static_cast<int>(key) > distances[u]) {
+          continue;
+        }
+        if (static_cast<int>(key) > limit) {
+          break;
+        }
+        settled++;
+        if (target_stamp[u] == target_epoch) {
+          targets--;
+        }
+        for (const WorkEdge &edge : graph.out[u]) {
+          if (skip(edge.to)) {
+            continue;
+          }
+          int d = distances[u] + edge.weight;
+          if (d <= limit && d < distance(edge.to)) {
+            stamp[edge.to] = epoch;
+            distances[edge.to] = d;
+            heap.push(static_cast<std::uint32_t>(d), edge.to);
+          }
+        }
+      }
+    }
+  };
+
+  // 模拟收缩 u：把需要的捷径写入 shortcuts，见证路径不经过 u 与 skip(v) 为真的节点
+  template <typename Skip>
+  static void collect_shortcuts(const WorkGraph &graph, int u,
+                                WitnessSearch &search,
+                                std::size_t settle_limit, Skip skip,
+                                std::vector<Shortcut> &shortcuts) {
+    shortcuts.clear();
+    const auto &out = graph.out[u];
+    if (out.empty()) {
+      return;
+    }
+    search.set_targets(out);
+    for (const WorkEdge &in_edge : graph.in[u]) {
+      int a = in_edge.to;
+      int limit = 0;
+      for (const WorkEdge &out_edge : out) {
+        if (out_edge.to != a) {
+          limit = std::max(limit, in_edge.weight + out_edge.weight);
+        }
+      }
+      search.run(graph, a, limit, settle_limit, out.size(),
+                 [u, &skip](int v) { return v == u || skip(v); });
+      for (const WorkEdge &out_edge : out) {
+        int b = out_edge.to;
+        int via = in_edge.weight + out_edge.weight;
+        if (b != a && search.distance(b) > via) {
+          shortcuts.push_back({a, b, via, u});
+        }
+      }
+    }
+  }
+
+  // 把 [0, count) 切成若干块，每块使用自己的见证搜索状态
+  template <typename Body>
+  static void for_each_chunk(WorkStealingScheduler *scheduler,
+                             std::vector<WitnessSearch> &searches,
+                             std::size_t count, const Body &body) {
+    if (count == 0) {
+      return;
+    }
+    if (scheduler == nullptr) {
+      body(searches[0], 0, count);
+      return;
+    }
+    std::size_t chunks = std::min(count, searches.size());
+    scheduler->parallel_for(0, chunks, 1, [&](std::size_t lo, std::size_t hi) {
+      for (std::size_t c = lo; c < hi; c++) {
+        body(searches[c], count * c / chunks, count * (c + 1) / chunks);
+      }
+    });
+  }
+
+  template <typename Graph>
+  static ContractionHierarchy build_impl(const Graph &graph,
+                                         WorkStealingScheduler *scheduler) {
+    int n = graph.get_node_count();
+    WorkGraph work;
+    work.out.resize(n);
+    work.in.resize(n);
+    for (int u = 0; u < n; u++) {
+      graph.for_each_out_edge(u, [&](int v, int weight) {
+        if (weight < 0) {
+          throw std::invalid_argument(
+              "Contraction hierarchies require non-negative weights");
+        }
+        if (u != v) {
+          work.relax_edge(u, v, weight, -1);
+        }
+      });
+    }
+
+    std::size_t chunk_count =
+        scheduler == nullptr ? 1 : 2 * scheduler->get_num_threads();
+    std::vector<WitnessSearch> searches(chunk_count, WitnessSearch(n));
+    auto no_skip = [](int) { return false; };
+
+    // 优先级：边差 + 已收缩的邻居数
+    std::vector<int> priority(n, 0);
+    std::vector<int> deleted_neighbors(n, 0);
+    auto update_priorities = [&](const std::vector<int> &nodes) {
+      for_each_chunk(scheduler, searches, nodes.size(),
+                     [&](WitnessSearch &search, std::size_t lo,
+                         std::size_t hi) {
+                       std::vector<Shortcut> shortcuts;
+                       for (std::size_t k = lo; k < hi; k++) {
+                         int u = nodes[k];
+                         collect_shortcuts(work, u, search,
+                                           kSimulationSettleLimit, no_skip,
+                                           shortcuts);
+                         priority[u] = static_cast<int>(shortcuts.size()) -
+                                       static_cast<int>(work.in[u].size() +
+                                                        work.out[u].size()) +
+                                       deleted_neighbors[u];
+                       }
+                     });
+    };
+    std::vector<int> remaining(n);
+    for (int v = 0; v < n; v++) {
+      remaining[v] = v;
+    }
+    update_priorities(remaining);
+
+    // 优先级相同时按打乱后的下标比较，使每轮选出的节点足够多
+    auto before = [&](int a, int b) {
+      if (priority[a] != priority[b]) {
+        return priority[a] < priority[b];
+      }
+      std::uint32_t ha = static_cast<std::uint32_t>(a) * 2654435761u;
+      std::uint32_t hb = static_cast<std::uint32_t>(b) * 2654435761u;
+      return ha != hb ? ha < hb : a < b;
+    };
+
+    std::vector<std::uint32_t> ranks(n, 0);
+    std::vector<std::vector<WorkEdge>> up_edges(n), down_edges(n);
+    std::vector<char> selected(n, 0);
+    std::vector<std::uint32_t> touched(n, 0);
+    std::uint32_t round = 0;
+    std::uint32_t next_rank = 0;
+
+    while (!remaining.empty()) {
+      // 局部最小的节点互不相邻
+      std::vector<int> batch;
+      for (int u : remaining) {
+        bool minimal = true;
+        for (const WorkEdge &edge : work.out[u]) {
+          minimal = minimal && before(u, edge.to);
+        }
+        for (const WorkEdge &edge : work.in[u]) {
+          minimal = minimal && before(u, edge.to);
+        }
+        if (minimal) {
+          batch.push_back(u);
+          selected[u] = 1;
+        }
+      }
+
+      std::vector<std::vector<Shortcut>> shortcuts(batch.size());
+      auto skip_selected = [&selected](int v) { return selected[v] != 0; };
+      for_each_chunk(scheduler, searches, batch.size(),
+                     [&](WitnessSearch &search, std::size_t lo,
+                         std::size_t hi) {
+                       for (std::size_t k = lo; k < hi; k++) {
+                         collect_shortcuts(work, batch[k], search,
+                                           kWitnessSettleLimit, skip_selected,
+                                           shortcuts[k]);
+                       }
+                     });
+
+      // 提交：记录覆盖图的边，从邻居的边表中删除 u，再加入捷径
+      round++;
+      std::vector<int> affected;
+      auto touch = [&](int v) {
+        deleted_neighbors[v]++;
+        if (touched[v] != round) {
+          touched[v] = round;
+          affected.push_back(v);
+        }
+      };
+      for (int u : batch) {
+        ranks[u] = next_rank++;
+        for (const WorkEdge &edge : work.out[u]) {
+          WorkGraph::erase(work.in[edge.to], u);
+          touch(edge.to);
+        }
+        for (const WorkEdge &edge : work.in[u]) {
+          WorkGraph::erase(work.out[edge.to], u);
+          touch(edge.to);
+        }
+        up_edges[u] = std::move(work.out[u]);
+        down_edges[u] = std::move(work.in[u]);
+        work.out[u] = std::vector<WorkEdge>();
+        work.in[u] = std::vector<WorkEdge>();
+      }
+      for (const auto &list : shortcuts) {
+        for (const Shortcut &shortcut : list) {
+          work.relax_edge(shortcut.from, shortcut.to, shortcut.weight,
+                          shortcut.middle);
+        }
+      }
+
+      std::vector<int> still_remaining;
+      still_remaining.reserve(remaining.size() - batch.size());
+      for (int v : remaining) {
+        if (!selected[v]) {
+          still_remaining.push_back(v);
+        }
+      }
+      remaining.swap(still_remaining);
+      update_priorities(affected);
+    }
+
+    return assemble(ranks, up_edges, down_edges);
+  }
+
+  static ContractionHierarchy
+  assemble(const std::vector<std::uint32_t> &ranks,
+           const std::vector<std::vector<WorkEdge>> &up_edges,
+           const std::vector<std::vector<WorkEdge>> &down_edges) {
+    std::size_t n = ranks.size();
+    std::size_t up_count = 0, down_count = 0;
+    for (std::size_t v = 0; v < n; v++) {
+      up_count += up_edges[v].size();
+      down_count += down_edges[v].size();
+    }
+    if (up_count > std::numeric_limits<std::uint32_t>::max() ||
+        down_count > std::numeric_limits<std::uint32_t>::max()) {
+      throw std::length_error("Contraction hierarchy has too many edges");
+    }
+
+    ContractionHierarchy result;
+    result.word_count = total_words(n, up_count, down_count);
+    result.storage.assign(result.word_count, 0);
+    std::uint64_t *words = result.storage.data();
+    words[0] = kMagic;
+    words[1] = kVersion;
+    words[2] = n;
+    words[3] = up_count;
+    words[4] = down_count;
+    words[5] = result.word_count;
+
+    std::uint64_t *cursor = words + kHeaderWords;
+    std::copy(ranks.begin(), ranks.end(),
+              reinterpret_cast<std::uint32_t *>(cursor));
+    cursor += words_for(n);
+    cursor = write_overlay(cursor, up_edges, up_count);
+    write_overlay(cursor, down_edges, down_count);
+
+    result.base = result.storage.data();
+    result.bind();
+    return result;
+  }
+
+  static std::uint64_t *
+  write_overlay(std::uint64_t *cursor,
+                const std::vector<std::vector<WorkEdge>> &edges,
+                std::size_t edge_count) {
+    std::size_t n = edges.size();
+    auto *offsets = reinterpret_cast<std::uint32_t *>(cursor);
+    cursor += words_for(n + 1);
+    auto *targets = reinterpret_cast<std::int32_t *>(cursor);
+    cursor += words_for(edge_count);
+    auto *weights = reinterpret_cast<std::int32_t *>(cursor);
+    cursor += words_for(edge_count);
+    auto *middles = reinterpret_cast<std::int32_t *>(cursor);
+    cursor += words_for(edge_count);
+
+    std::uint32_t e = 0;
+    for (std::size_t v = 0; v < n; v++) {
+      offsets[v] = e;
+      for (const WorkEdge &edge : edges[v]) {
+        targets[e] = edge.to;
+        weights[e] = edge.weight;
+        middles[e] = edge.middle;
+        e++;
+      }
+    }
+    offsets[n] = e;
+    return cursor;
+  }
+};
+
+/**
+ * @brief 收缩层次上的点对点查询
+ *
+ * 从源点沿向上边、从终点沿向下边同时做Dijkstra，每侧的堆顶不小于当前
+ * 最优值 μ 时该侧停止；两侧都停止后 μ 即为最短距离。搜索只经过秩递增的
+ * 节点，规模通常只有几百个节点。查询对象持有带时间戳的标签数组，
+ * 每个线程使用自己的查询对象，共享同一个只读的 ContractionHierarchy。
+ */
+class ContractionHierarchyQuery {
+public:
+  static constexpr int kInfinity = std::numeric_limits<int>::max();
+
+  explicit ContractionHierarchyQuery(const ContractionHierarchy &hierarchy)
+      : hierarchy(hierarchy), forward_side(hierarchy.get_node_count()),
+        backward_side(hierarchy.get_node_count()) {}
+
+  // unpack_path 为 false 时只求距离，不展开捷径
+  PathQueryResult query(int source, int target, bool unpack_path = true) {
+    PathQueryResult result;
+    int n = hierarchy.get_node_count();
+    if (source < 0 || source >= n || target < 0 || target >= n) {
+      return result;
+    }
+
+    forward_side.begin(source);
+    backward_side.begin(target);
+    long long best = kInfinity; // μ
+    int meeting = -1;
+
+    while (true) {
+      long long forward_key = forward_side.top_key();
+      long long backward_key = backward_side.top_key();
+      bool forward_done = forward_key >= best;
+      bool backward_done = backward_key >= best;
+      if (forward_done && backward_done) {
+        break;
+      }
+      bool forward_step =
+          !forward_done && (backward_done || forward_key <= backward_key);
+      Side &side = forward_step ? forward_side : backward_side;
+      Side &other = forward_step ? backward_side : forward_side;
+
+      auto [key, u] = side.heap.pop();
+      if (static_cast<int>(key) > side.distance(u)) {
+        continue;
+      }
+      result.settled++;
+      int du = side.distance(u);
+      int other_distance = other.distance(u);
+      if (other_distance != kInfinity &&
+          static_cast<long long>(du) + other_distance < best) {
+        best = static_cast<long long>(du) + other_distance;
+        meeting = u;
+      }
+
+      auto relax = [&](int v, int weight) {
+        int dv = du + weight;
+        if (dv < side.distance(v)) {
+          side.label(v, dv, u);
+        }
+      };
+      if (forward_step) {
+        hierarchy.for_each_up_edge(u, relax);
+      } else {
+        hierarchy.for_each_down_edge(u, relax);
+      }
+    }
+
+    if (meeting == -1) {
+      return result;
+    }
+    result.distance = static_cast<int>(best);
+    if (unpack_path) {
+      // 覆盖图上的路径：源点 … meeting … 终点，再逐条展开捷径
+      std::vector<int> overlay;
+      for (int v = meeting; v != -1; v = forward_side.parent(v)) {
+        overlay.push_back(v);
+      }
+      std::reverse(overlay.begin(), overlay.end());
+      for (int v = backward_side.parent(meeting); v != -1;
+           v = backward_side.parent(v)) {
+        overlay.push_back(v);
+      }
+      result.path.push_back(overlay[0]);
+      for (std::size_t k = 0; k + 1 < overlay.size(); k++) {
+        hierarchy.unpack_edge(overlay[k], overlay[k + 1], result.path);
+      }
+    }
+    return result;
+  }
+
+private:
+  struct Side {
+    std::vector<std::uint32_t> stamp;
+    std::vector<int> distances;
+    std::vector<int> parents;
+    std::uint32_t epoch = 0;
+    RadixHeap<int> heap;
+
+    explicit Side(std::size_t n) : stamp(n, 0), distances(n), parents(n) {}
+
+    void begin(int root) {
+      if (++epoch == 0) {
+        std::fill(stamp.begin(), stamp.end(), 0);
+        epoch = 1;
+      }
+      heap.clear();
+      label(root, 0, -1);
+    }
+
+    int distance(int v) const {
+      return stamp[v] == epoch ? distances[v] : kInfinity;
+    }
+
+    int parent(int v) const { return parents[v]; }
+
+    void label(int v, int distance, int parent) {
+      stamp[v] = epoch;
+      distances[v] = distance;
+      parents[v] = parent;
+      heap.push(static_cast<std::uint32_t>(distance), v);
+    }
+
+    long long top_key() {
+      return heap.empty() ? kInfinity : static_cast<long long>(heap.top_key());
+    }
+  };
+
+  const ContractionHierarchy &hierarchy;
+  Side forward_side;
+  Side backward_side;
+};
+
+} // namespace algorithms
+
+#endif // CONTRACTION_HIERARCHIES_H
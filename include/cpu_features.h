@@ -0,0 +1,55 @@
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+namespace algorithms {
+
+/**
+ * @brief 运行时CPU特性检测
+ *
+ * 各头文件的SIMD内核按这里的结果分派：第一次查询时执行一次cpuid并缓存，
+ * 之后每次查询只读一个静态变量。非x86平台或非GCC/Clang编译器上全部为false，
+ * 调用处退回标量版本。
+ */
+class CpuFeatures {
+public:
+  static bool avx() { return flags().avx; }
+  static bool avx2() { return flags().avx2; }
+  static bool fma() { return flags().fma; }
+  static bool popcnt() { return flags().popcnt; }
+  static bool avx512f() { return flags().avx512f; }
+  static bool avx512vpopcntdq() { return flags().avx512vpopcntdq; }
+
+private:
+  struct Flags {
+    bool avx = false;
+    bool avx2 = false;
+    bool fma = false;
+    bool popcnt = false;
+    bool avx512f = false;
+    bool avx512vpopcntdq = false;
+  };
+
+  static const Flags &flags() {
+    static const Flags detected = detect();
+    return detected;
+  }
+
+  static Flags detect() {
+    Flags flags;
+#if (defined(__x86_64__) || defined(__i386__)) &&                             \
+    (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    flags.avx = __builtin_cpu_supports("avx");
+    flags.avx2 = __builtin_cpu_supports("avx2");
+    flags.fma = __builtin_cpu_supports("fma");
+    flags.popcnt = __builtin_cpu_supports("popcnt");
+    flags.avx512f = __builtin_cpu_supports("avx512f");
+    flags.avx512vpopcntdq = __builtin_cpu_supports("avx512vpopcntdq");
+#endif
+    return flags;
+  }
+};
+
+} // namespace algorithms
+
+#endif // CPU_FEATURES_H
@@ -1,8 +1,11 @@
 #ifndef DISJOINT_SET_H
 #define DISJOINT_SET_H
 
+#include <atomic>
+#include <cstdint>
 #include <iostream>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace algorithms {
@@ -12,12 +15,36 @@ namespace algorithms {
  *
  * 实现算法导论第21章"用于不相交集合的数据结构"
  * 支持路径压缩和按秩合并优化
+ *
+ * 父节点与秩放在同一个结构体中，查找的每一步只访问一次内存；
+ * 查找使用迭代的路径减半（每个节点指向祖父节点），与完全路径压缩
+ * 有相同的摊还界，且不会在很长的链上耗尽调用栈。
  */
 class DisjointSet {
 private:
-  std::vector<int> parent; // 父节点数组
-  std::vector<int> rank;   // 秩（树的高度）
-  int set_count;           // 集合数量
+  struct Node {
+    int parent; // 父节点
+    int rank;   // 秩（树高的上界）
+  };
+
+  std::vector<Node> nodes;
+  int set_count; // 集合数量
+
+  void check_index(int x) const {
+    if (x < 0 || x >= static_cast<int>(nodes.size())) {
+      throw std::out_of_range("元素索引超出范围");
+    }
+  }
+
+  // 不检查下标的查找（路径减半）
+  int find_root(int x) {
+    while (nodes[x].parent != x) {
+      int grandparent = nodes[nodes[x].parent].parent;
+      nodes[x].parent = grandparent;
+      x = grandparent;
+    }
+    return x;
+  }
 
 public:
   /**
@@ -29,30 +56,22 @@ public:
       throw std::invalid_argument("元素数量必须大于0");
     }
 
-    parent.resize(n);
-    rank.resize(n, 0);
+    nodes.resize(n);
 
     // 初始化每个元素为独立的集合
     for (int i = 0; i < n; i++) {
-      parent[i] = i;
+      nodes[i] = {i, 0};
     }
   }
 
   /**
-   * @brief 查找元素x所在集合的代表元素（带路径压缩）
+   * @brief 查找元素x所在集合的代表元素（带路径减半）
    * @param x 元素索引
    * @return 集合的代表元素
    */
   int find(int x) {
-    if (x < 0 || x >= static_cast<int>(parent.size())) {
-      throw std::out_of_range("元素索引超出范围");
-    }
-
-    // 路径压缩：在查找过程中将路径上的节点直接连接到根节点
-    if (parent[x] != x) {
-      parent[x] = find(parent[x]);
-    }
-    return parent[x];
+    check_index(x);
+    return find_root(x);
   }
 
   /**
@@ -61,22 +80,24 @@ public:
    * @param y 第二个元素
    */
   void union_sets(int x, int y) {
-    int rootX = find(x);
-    int rootY = find(y);
+    check_index(x);
+    check_index(y);
+    int rootX = find_root(x);
+    int rootY = find_root(y);
 
     if (rootX == rootY) {
       return; // 已经在同一个集合中
     }
 
     // 按秩合并：将秩较小的树合并到秩较大的树下
-    if (rank[rootX] < rank[rootY]) {
-      parent[rootX] = rootY;
-    } else if (rank[rootX] > rank[rootY]) {
-      parent[rootY] = rootX;
+    if (nodes[rootX].rank < nodes[rootY].rank) {
+      nodes[rootX].parent = rootY;
+    } else if (nodes[rootX].rank > nodes[rootY].rank) {
+      nodes[rootY].parent = rootX;
     } else {
       // 秩相等时，任意选择，并增加新根的秩
-      parent[rootY] = rootX;
-      rank[rootX]++;
+      nodes[rootY].parent = rootX;
+      nodes[rootX].rank++;
     }
 
     set_count--;
@@ -88,7 +109,11 @@ public:
    * @param y 第二个元素
    * @return true如果在同一个集合中，否则false
    */
-  bool is_same_set(int x, int y) { return find(x) == find(y); }
+  bool is_same_set(int x, int y) {
+    check_index(x);
+    check_index(y);
+    return find_root(x) == find_root(y);
+  }
 
   /**
    * @brief 获取集合数量
@@ -100,7 +125,7 @@ public:
    * @brief 获取元素数量
    * @return 元素的总数量
    */
-  int get_element_count() const { return static_cast<int>(parent.size()); }
+  int get_element_count() const { return static_cast<int>(nodes.size()); }
 
   /**
    * @brief 获取指定集合的大小
@@ -112,8 +137,8 @@ public:
     int size = 0;
 
     // 遍历所有元素，统计属于该集合的元素数量
-    for (int i = 0; i < static_cast<int>(parent.size()); i++) {
-      if (find(i) == root) {
+    for (int i = 0; i < static_cast<int>(nodes.size()); i++) {
+      if (find_root(i) == root) {
         size++;
       }
     }
@@ -126,18 +151,18 @@ public:
    */
   void print_state() const {
     std::cout << "并查集状态:" << std::endl;
-    std::cout << "元素数量: " << parent.size() << std::endl;
+    std::cout << "元素数量: " << nodes.size() << std::endl;
     std::cout << "集合数量: " << set_count << std::endl;
 
     std::cout << "父节点数组: ";
-    for (size_t i = 0; i < parent.size(); i++) {
-      std::cout << parent[i] << " ";
+    for (const Node &node : nodes) {
+      std::cout << node.parent << " ";
     }
     std::cout << std::endl;
 
     std::cout << "秩数组: ";
-    for (size_t i = 0; i < rank.size(); i++) {
-      std::cout << rank[i] << " ";
+    for (const Node &node : nodes) {
+      std::cout << node.rank << " ";
     }
     std::cout << std::endl;
   }
@@ -148,8 +173,8 @@ public:
    */
   std::vector<int> get_representatives() {
     std::vector<int> reps;
-    for (int i = 0; i < static_cast<int>(parent.size()); i++) {
-      if (parent[i] == i) {
+    for (int i = 0; i < static_cast<int>(nodes.size()); i++) {
+      if (nodes[i].parent == i) {
         reps.push_back(i);
       }
     }
@@ -165,8 +190,8 @@ public:
     int root = find(representative);
     std::vector<int> elements;
 
-    for (int i = 0; i < static_cast<int>(parent.size()); i++) {
-      if (find(i) == root) {
+    for (int i = 0; i < static_cast<int>(nodes.size()); i++) {
+      if (find_root(i) == root) {
         elements.push_back(i);
       }
     }
@@ -175,6 +200,141 @@ public:
   }
 };
 
+/**
+ * @brief 无锁并发并查集（Anderson–Woll 风格，按下标优先级链接）
+ *
+ * 父指针是原子整数，多个线程可以同时调用 find、unite、same_set：
+ * - find 用CAS做路径减半：只有父指针仍为读到的 p 时才改成祖父 g，
+ *   失败说明别的线程已经改过，直接继续向上走，不需要重试
+ * - unite 找到两个根后，用CAS把优先级较低的根指向另一个根；
+ *   CAS失败（该根已被别的线程链接）就重新查找
+ * - 优先级是下标的散列值（相同时比较下标），父指针的优先级总是
+ *   严格大于子节点，因此不会成环；散列打乱了输入顺序，避免按下标递增
+ *   合并时形成长链
+ *
+ * 所有操作都是无锁的：某个线程的CAS失败意味着另一个线程取得了进展。
+ * get_set_count 等统计操作需在没有并发修改时调用。
+ */
+class ConcurrentDisjointSet {
+private:
+  std::vector<std::atomic<int>> parent;
+
+  static std::uint32_t priority(int x) {
+    std::uint32_t z = static_cast<std::uint32_t>(x) * 0x9E3779B9u;
+    z ^= z >> 16;
+    z *= 0x85EBCA6Bu;
+    z ^= z >> 13;
+    return z;
+  }
+
+  // a 的优先级是否低于 b
+  static bool lower(int a, int b) {
+    std::uint32_t pa = priority(a), pb = priority(b);
+    return pa < pb || (pa == pb && a < b);
+  }
+
+  void check_index(int x) const {
+    if (x < 0 || x >= static_cast<int>(parent.size())) {
+      throw std::out_of_range("元素索引超出范围");
+    }
+  }
+
+  int find_root(int x) {
+    while (true) {
+      int p = parent[x].load(std::memory_order_acquire);
+      if (p == x) {
+        return x;
+      }
+      int g = parent[p].load(std::memory_order_acquire);
+      if (p != g) {
+        parent[x].compare_exchange_weak(p, g, std::memory_order_release,
+                                        std::memory_order_relaxed);
+      }
+      x = g;
+    }
+  }
+
+public:
+  /**
+   * @brief 构造函数，初始化n个单元素集合
+   * @param n 元素数量
+   */
+  explicit ConcurrentDisjointSet(int n) : parent(n > 0 ? n : 0) {
+    if (n <= 0) {
+      throw std::invalid_argument("元素数量必须大于0");
+    }
+    for (int i = 0; i < n; i++) {
+      parent[i].store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @brief 查找元素x所在集合的当前代表元素（线程安全）
+   */
+  int find(int x) {
+    check_index(x);
+    return find_root(x);
+  }
+
+  /**
+   * @brief 合并x和y所在的集合（线程安全）
+   * @return 本次调用是否真正合并了两个不同的集合
+   */
+  bool unite(int x, int y) {
+    check_index(x);
+    check_index(y);
+    while (true) {
+      x = find_root(x);
+      y = find_root(y);
+      if (x == y) {
+        return false;
+      }
+      if (lower(y, x)) {
+        std::swap(x, y);
+      }
+      int expected = x;
+      if (parent[x].compare_exchange_strong(expected, y,
+                                            std::memory_order_acq_rel)) {
+        return true;
+      }
+    }
+  }
+
+  /**
+   * @brief x和y是否在同一个集合中（线程安全）
+   *
+   * 两个根不同且 x 的根仍是根，说明查询时刻二者确实不相交；
+   * 否则期间发生了合并，重新查找。
+   */
+  bool same_set(int x, int y) {
+    check_index(x);
+    check_index(y);
+    while (true) {
+      x = find_root(x);
+      y = find_root(y);
+      if (x == y) {
+        return true;
+      }
+      if (parent[x].load(std::memory_order_acquire) == x) {
+        return false;
+      }
+    }
+  }
+
+  int get_element_count() const { return static_cast<int>(parent.size()); }
+
+  /**
+   * @brief 集合数量（需在没有并发修改时调用）
+   */
+  int get_set_count() const {
+    int count = 0;
+    for (int i = 0; i < static_cast<int>(parent.size()); i++) {
+      count += parent[i].load(std::memory_order_relaxed) == i;
+    }
+    return count;
+  }
+};
+
 /**
  * @brief 算法导论第21章经典示例和测试
  */
@@ -0,0 +1,720 @@
+#ifndef EXACT_SOLVERS_H
+#define EXACT_SOLVERS_H
+
+#include "approximation_algorithms.h"
+#include "bit_matrix_graph.h"
+#include "cpu_features.h"
+#include "work_stealing_scheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+namespace algorithms {
+
+/**
+ * @brief NP完全问题的精确求解（分支限界与动态规划）
+ *
+ * 与 NPCompleteness 中的验证器对应，给出最优解本身：
+ * - 最小顶点覆盖：核化规则 + 以2-近似解为初始上界的分支限界
+ * - 最大团：位集上的 Tomita 式搜索，贪心着色给出上界
+ * - 旅行商：Held–Karp 动态规划，按子集向量化，以MST 2-近似路线为剪枝上界
+ * - 子集和：位集移位的动态规划
+ *
+ * 传入调度器时，分支限界在搜索树的上层把子树作为任务派生，
+ * 动态规划按互不依赖的子集层或字区间并行；为空指针时串行执行。
+ * 所有搜索共享一个原子上界，任一子树找到更好的解会立即收紧其他子树的剪枝。
+ */
+class ExactSolvers {
+public:
+  struct TspTour {
+    std::vector<int> tour; // 从0出发回到0，长度 n + 1
+    int cost;
+  };
+
+  static constexpr int kMaxHeldKarpCities = 22; // dp 表约 21·2^21 个 int
+  static constexpr int kInfinity = 1 << 30;     // 路线长度须小于此值
+
+  /**
+   * @brief 最小顶点覆盖
+   *
+   * 每个搜索节点反复应用核化规则直到不再变化：
+   * 度0的顶点删除；度1的顶点取其邻居；度数超过剩余预算 k 的顶点必须取
+   * （否则要取它的全部邻居）。剩余边数超过 k·最大度、或贪心极大匹配
+   * 的大小（覆盖大小的下界）超出预算时剪枝，否则对最大度顶点 v 分支：
+   * 取 v，或取 v 的全部邻居。
+   *
+   * @return 覆盖中的顶点（升序）
+   * @throws std::invalid_argument 如果图是有向图
+   */
+  static std::vector<int>
+  minimum_vertex_cover(const BitMatrixGraph &graph,
+                       WorkStealingScheduler *scheduler = nullptr) {
+    require_undirected(graph);
+    VertexCoverSearch search(graph, scheduler != nullptr);
+    std::unordered_set<int> approx =
+        ApproximationAlgorithms::vertex_cover_2_approx(graph);
+    search.best.assign(approx.begin(), approx.end());
+    search.best_size.store(search.best.size());
+
+    std::vector<std::uint64_t> alive = full_set(graph.get_node_count());
+    auto solve = [&] { search.branch(alive, {}, 0); };
+    if (scheduler) {
+      scheduler->run(solve);
+    } else {
+      solve();
+    }
+    std::sort(search.best.begin(), search.best.end());
+    return search.best;
+  }
+
+  /**
+   * @brief 最大团
+   *
+   * 顶点按度数降序重新编号后存为位集。搜索节点对候选集 P 贪心着色，
+   * 同色顶点两两不相邻，所以颜色数是 P 中团大小的上界；按颜色从大到小
+   * 取顶点分支，当前团大小加上颜色号不超过已知最优时剪掉其余分支。
+   * 初始下界来自贪心构造的团；并行时第一层的每个分支是一个任务。
+   *
+   * @return 团中的顶点（升序）
+   * @throws std::invalid_argument 如果图是有向图
+   */
+  static std::vector<int>
+  maximum_clique(const BitMatrixGraph &graph,
+                 WorkStealingScheduler *scheduler = nullptr) {
+    require_undirected(graph);
+    CliqueSearch search(graph);
+    if (search.n == 0) {
+      return {};
+    }
+
+    std::vector<std::uint64_t> all = full_set(search.n);
+    std::vector<int> verts, colors;
+    search.color_sort(all, verts, colors);
+    // 第 i 个分支的候选集：着色序中排在 i 之前且与 verts[i] 相邻的顶点
+    auto run_branch = [&](size_t i) {
+      if (colors[i] <= static_cast<int>(search.best_size.load())) {
+        return;
+      }
+      std::vector<std::uint64_t> candidates(search.words, 0);
+      const std::uint64_t *adj = search.row(verts[i]);
+      for (size_t p = 0; p < i; ++p) {
+        size_t v = verts[p];
+        candidates[v / 64] |= adj[v / 64] & (std::uint64_t(1) << (v % 64));
+      }
+      std::vector<int> clique = {verts[i]};
+      if (is_empty(candidates)) {
+        search.record(clique);
+      } else {
+        search.expand(clique, candidates);
+      }
+    };
+    size_t count = verts.size();
+    if (scheduler) {
+      // 颜色号大的分支更可能包含最大团，先执行
+      scheduler->parallel_for(0, count, 1, [&](size_t lo, size_t hi) {
+        for (size_t t = lo; t < hi; ++t) {
+          run_branch(count - 1 - t);
+        }
+      });
+    } else {
+      for (size_t t = 0; t < count; ++t) {
+        run_branch(count - 1 - t);
+      }
+    }
+
+    std::vector<int> result;
+    for (int v : search.best) {
+      result.push_back(search.order[v]);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  /**
+   * @brief 旅行商问题的Held–Karp动态规划，O(n² 2^n)
+   *
+   * dp[j][S] 为从城市0出发、恰好经过 S（城市1..n-1的子集）、停在 j 的
+   * 最短路径长度，dp[j][S] = min_k dp[k][S - {j}] + d(k, j)。
+   * 表按 j 分行、按 S 连续存放：j ≥ 3 时 8 个连续子集 S 去掉 j 后仍然连续，
+   * 一条AVX2指令同时更新8个子集；低3位的城市逐个子集处理。
+   * 高位相同、低3位不同的8个子集组成一块，块之间只依赖高位少一个元素的块，
+   * 因此同一层（高位元素数相同）的块可以并行。
+   * 超过MST 2-近似路线长度的部分路径置为无穷，不再向外扩展。
+   *
+   * @param distance n×n 距离矩阵，元素非负，可以不对称
+   * @throws std::invalid_argument 如果矩阵不是方阵、含负数、城市数超过
+   *         kMaxHeldKarpCities 或距离过大
+   */
+  static TspTour tsp_held_karp(const std::vector<std::vector<int>> &distance,
+                               WorkStealingScheduler *scheduler = nullptr) {
+    size_t n = distance.size();
+    if (n == 0) {
+      throw std::invalid_argument("距离矩阵为空");
+    }
+    if (n > static_cast<size_t>(kMaxHeldKarpCities)) {
+      throw std::invalid_argument("城市数超过Held-Karp的上限");
+    }
+    long long max_distance = 0;
+    for (const auto &row : distance) {
+      if (row.size() != n) {
+        throw std::invalid_argument("距离矩阵必须是方阵");
+      }
+      for (int d : row) {
+        if (d < 0) {
+          throw std::invalid_argument("距离不能为负");
+        }
+        max_distance = std::max<long long>(max_distance, d);
+      }
+    }
+    if (max_distance * static_cast<long long>(n) >= kInfinity) {
+      throw std::invalid_argument("距离过大，路线长度可能溢出");
+    }
+    if (n == 1) {
+      return {{0, 0}, 0};
+    }
+
+    HeldKarp dp(distance);
+    // 近似路线只有是哈密顿回路时才能作为上界（权为0的边不会进入其MST）
+    std::vector<int> approx = ApproximationAlgorithms::tsp_2_approx(distance);
+    std::vector<bool> visited(n, false);
+    for (int v : approx) {
+      visited[v] = true;
+    }
+    if (approx.size() == n + 1 &&
+        std::find(visited.begin(), visited.end(), false) == visited.end()) {
+      dp.bound = static_cast<int>(tour_cost(distance, approx));
+    }
+    dp.solve(scheduler);
+    return dp.reconstruct();
+  }
+
+  /**
+   * @brief 子集和：位集 reach 的第 s 位表示能否凑出 s，
+   *        每个元素 x 执行 reach |= reach << x，O(n · target / 64)
+   *
+   * @param subset 非空时输出所用元素的下标
+   * @return 是否存在和恰为 target 的子集
+   * @throws std::invalid_argument 如果含负数或 target 为负
+   */
+  static bool subset_sum(const std::vector<int> &set, int target,
+                         std::vector<int> *subset = nullptr,
+                         WorkStealingScheduler *scheduler = nullptr) {
+    if (target < 0) {
+      throw std::invalid_argument("目标和不能为负");
+    }
+    long long total = 0;
+    for (int x : set) {
+      if (x < 0) {
+        throw std::invalid_argument("子集和的动态规划要求元素非负");
+      }
+      total += x;
+    }
+    if (subset) {
+      subset->clear();
+    }
+    if (total < target) {
+      return false;
+    }
+
+    size_t words = static_cast<size_t>(target) / 64 + 1;
+    auto reachable = [&](const std::uint64_t *bits) {
+      return (bits[target / 64] >> (target % 64)) & 1;
+    };
+    // 需要回溯时保留每一步的位集，否则只用两个缓冲区
+    std::vector<std::vector<std::uint64_t>> layers(subset ? set.size() + 1 : 2,
+                                                   std::vector<std::uint64_t>(words, 0));
+    layers[0][0] = 1;
+    size_t used = 0;
+    for (; used < set.size() && !reachable(layers[subset ? used : used % 2].data());
+         ++used) {
+      const std::uint64_t *src = layers[subset ? used : used % 2].data();
+      std::uint64_t *dst = layers[subset ? used + 1 : (used + 1) % 2].data();
+      size_t shift = static_cast<size_t>(set[used]);
+      auto shift_range = [&](size_t lo, size_t hi) {
+        shift_or(src, dst, shift, lo, hi);
+      };
+      if (scheduler && words >= kParallelWords) {
+        scheduler->parallel_for(0, words, kParallelWords / 4, shift_range);
+      } else {
+        shift_range(0, words);
+      }
+    }
+    if (!reachable(layers[subset ? used : used % 2].data())) {
+      return false;
+    }
+    if (subset) {
+      size_t s = static_cast<size_t>(target);
+      for (size_t i = used; i > 0; --i) {
+        if (!((layers[i - 1][s / 64] >> (s % 64)) & 1)) {
+          subset->push_back(static_cast<int>(i - 1));
+          s -= static_cast<size_t>(set[i - 1]);
+        }
+      }
+      std::reverse(subset->begin(), subset->end());
+    }
+    return true;
+  }
+
+  /**
+   * @brief 闭合路线的长度
+   */
+  static long long tour_cost(const std::vector<std::vector<int>> &distance,
+                             const std::vector<int> &tour) {
+    long long cost = 0;
+    for (size_t i = 0; i + 1 < tour.size(); ++i) {
+      cost += distance[tour[i]][tour[i + 1]];
+    }
+    return cost;
+  }
+
+private:
+  using Bits = std::vector<std::uint64_t>;
+
+  static constexpr int kSpawnDepth = 10;          // 顶点覆盖派生任务的最大深度
+  static constexpr size_t kParallelWords = 1 << 14; // 子集和按字并行的阈值
+
+  static void require_undirected(const BitMatrixGraph &graph) {
+    if (graph.is_directed()) {
+      throw std::invalid_argument("精确求解要求无向图");
+    }
+  }
+
+  static Bits full_set(size_t n) {
+    Bits bits((n + 63) / 64, ~std::uint64_t(0));
+    if (n % 64) {
+      bits.back() = (std::uint64_t(1) << (n % 64)) - 1;
+    }
+    return bits;
+  }
+
+  static bool is_empty(const Bits &bits) {
+    for (std::uint64_t w : bits) {
+      if (w) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static bool test(const Bits &bits, size_t v) {
+    return (bits[v / 64] >> (v % 64)) & 1;
+  }
+
+  static void clear(Bits &bits, size_t v) {
+    bits[v / 64] &= ~(std::uint64_t(1) << (v % 64));
+  }
+
+  // dst[lo, hi) = src | (src << shift)
+  static void shift_or(const std::uint64_t *src, std::uint64_t *dst,
+                       size_t shift, size_t lo, size_t hi) {
+    size_t q = shift / 64, r = shift % 64;
+    for (size_t w = lo; w < hi; ++w) {
+      std::uint64_t moved = 0;
+      if (w >= q) {
+        moved = src[w - q] << r;
+        if (r && w > q) {
+          moved |= src[w - q - 1] >> (64 - r);
+        }
+      }
+      dst[w] = src[w] | moved;
+    }
+  }
+
+  struct VertexCoverSearch {
+    const BitMatrixGraph &graph;
+    size_t n, words;
+    bool parallel;
+    std::atomic<size_t> best_size{0};
+    std::mutex mutex;
+    std::vector<int> best;
+
+    VertexCoverSearch(const BitMatrixGraph &g, bool parallel)
+        : graph(g), n(g.get_node_count()), words(g.get_words_per_row()),
+          parallel(parallel) {}
+
+    size_t degree(const Bits &alive, size_t v) const {
+      return BitMatrixGraph::and_popcount(graph.row(v), alive.data(), words);
+    }
+
+    size_t first_neighbor(const Bits &alive, size_t v) const {
+      const std::uint64_t *row = graph.row(v);
+      for (size_t w = 0;; ++w) {
+        if (std::uint64_t x = row[w] & alive[w]) {
+          return w * 64 + __builtin_ctzll(x);
+        }
+      }
+    }
+
+    void record(const std::vector<int> &chosen) {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (chosen.size() < best_size.load()) {
+        best = chosen;
+        best_size.store(chosen.size());
+      }
+    }
+
+    void branch(Bits alive, std::vector<int> chosen, int depth) {
+      auto take = [&](size_t v) {
+        clear(alive, v);
+        chosen.push_back(static_cast<int>(v));
+      };
+
+      size_t max_degree = 0, pivot = 0, degree_sum = 0;
+      for (bool changed = true; changed;) {
+        changed = false;
+        max_degree = degree_sum = 0;
+        for (size_t v = 0; v < n; ++v) {
+          if (!test(alive, v)) {
+            continue;
+          }
+          if (chosen.size() + 1 > best_size.load()) {
+            return;
+          }
+          // 还能再取 budget 个顶点才可能优于当前最优
+          size_t budget = best_size.load() - 1 - chosen.size();
+          size_t d = degree(alive, v);
+          if (d == 0) {
+            clear(alive, v);
+          } else if (d == 1) {
+            take(first_neighbor(alive, v));
+            changed = true;
+          } else if (d > budget) {
+            take(v);
+            changed = true;
+          } else {
+            degree_sum += d;
+            if (d > max_degree) {
+              max_degree = d;
+              pivot = v;
+            }
+          }
+        }
+      }
+
+      if (degree_sum == 0) {
+        record(chosen);
+        return;
+      }
+      if (chosen.size() >= best_size.load()) {
+        return;
+      }
+      size_t budget = best_size.load() - 1 - chosen.size();
+      if (degree_sum / 2 > budget * max_degree) {
+        return;
+      }
+      // 极大匹配的每条边至少要一个端点进入覆盖
+      Bits unmatched = alive;
+      size_t matching = 0;
+      for (size_t v = 0; v < n; ++v) {
+        if (test(unmatched, v) && degree(unmatched, v) > 0) {
+          clear(unmatched, first_neighbor(unmatched, v));
+          clear(unmatched, v);
+          ++matching;
+        }
+      }
+      if (matching > budget) {
+        return;
+      }
+
+      Bits without = alive;
+      std::vector<int> with_neighbors = chosen;
+      const std::uint64_t *row = graph.row(pivot);
+      for (size_t w = 0; w < words; ++w) {
+        for (std::uint64_t x = row[w] & alive[w]; x; x &= x - 1) {
+          with_neighbors.push_back(static_cast<int>(w * 64 + __builtin_ctzll(x)));
+        }
+        without[w] &= ~row[w];
+      }
+      clear(without, pivot);
+      take(pivot);
+
+      if (parallel && depth < kSpawnDepth) {
+        WorkStealingScheduler::TaskGroup group;
+        group.spawn([&] { branch(without, with_neighbors, depth + 1); });
+        branch(std::move(alive), std::move(chosen), depth + 1);
+        group.sync();
+      } else {
+        branch(std::move(alive), std::move(chosen), depth + 1);
+        branch(std::move(without), std::move(with_neighbors), depth + 1);
+      }
+    }
+  };
+
+  struct CliqueSearch {
+    size_t n, words;
+    std::vector<int> order; // 新编号 -> 原编号
+    Bits adjacency;
+    std::atomic<size_t> best_size{0};
+    std::mutex mutex;
+    std::vector<int> best;
+
+    explicit CliqueSearch(const BitMatrixGraph &graph)
+        : n(graph.get_node_count()), words((n + 63) / 64), order(n) {
+      std::vector<size_t> degree(n);
+      for (size_t v = 0; v < n; ++v) {
+        order[v] = static_cast<int>(v);
+        degree[v] = graph.get_degree(static_cast<int>(v));
+      }
+      std::stable_sort(order.begin(), order.end(),
+                       [&](int a, int b) { return degree[a] > degree[b]; });
+      std::vector<size_t> rank(n);
+      for (size_t i = 0; i < n; ++i) {
+        rank[order[i]] = i;
+      }
+      adjacency.assign(n * words, 0);
+      for (size_t i = 0; i < n; ++i) {
+        graph.for_each_out_edge(order[i], [&](int v, int) {
+          size_t j = rank[v];
+          adjacency[i * words + j / 64] |= std::uint64_t(1) << (j % 64);
+        });
+      }
+      greedy_clique();
+    }
+
+    const std::uint64_t *row(size_t v) const {
+      return adjacency.data() + v * words;
+    }
+
+    // 下界：每次加入候选集中度数最大（编号最小）的顶点
+    void greedy_clique() {
+      Bits candidates = full_set(n);
+      std::vector<int> clique;
+      while (!is_empty(candidates)) {
+        size_t v = 0;
+        while (!test(candidates, v)) {
+          ++v;
+        }
+        clique.push_back(static_cast<int>(v));
+        for (size_t w = 0; w < words; ++w) {
+          candidates[w] &= row(v)[w];
+        }
+      }
+      record(clique);
+    }
+
+    void record(const std::vector<int> &clique) {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (clique.size() > best_size.load()) {
+        best = clique;
+        best_size.store(clique.size());
+      }
+    }
+
+    // 贪心着色：verts 按颜色非降序，colors[i] 为 verts[i] 的颜色号（从1开始）
+    void color_sort(const Bits &candidates, std::vector<int> &verts,
+                    std::vector<int> &colors) const {
+      verts.clear();
+      colors.clear();
+      Bits uncolored = candidates;
+      Bits q(words);
+      for (int color = 1; !is_empty(uncolored); ++color) {
+        q = uncolored;
+        for (size_t w = 0; w < words; ++w) {
+          while (q[w]) {
+            size_t v = w * 64 + __builtin_ctzll(q[w]);
+            q[w] &= q[w] - 1;
+            clear(uncolored, v);
+            const std::uint64_t *adj = row(v);
+            for (size_t x = w; x < words; ++x) {
+              q[x] &= ~adj[x];
+            }
+            verts.push_back(static_cast<int>(v));
+            colors.push_back(color);
+          }
+        }
+      }
+    }
+
+    void expand(std::vector<int> &clique, Bits candidates) {
+      std::vector<int> verts, colors;
+      color_sort(candidates, verts, colors);
+      Bits next(words);
+      for (size_t i = verts.size(); i-- > 0;) {
+        if (clique.size() + colors[i] <= best_size.load()) {
+          return;
+        }
+        size_t v = verts[i];
+        clique.push_back(static_cast<int>(v));
+        bool empty = true;
+        for (size_t w = 0; w < words; ++w) {
+          next[w] = candidates[w] & row(v)[w];
+          empty = empty && next[w] == 0;
+        }
+        if (empty) {
+          record(clique);
+        } else {
+          expand(clique, next);
+        }
+        clique.pop_back();
+        clear(candidates, v);
+      }
+    }
+  };
+
+  struct HeldKarp {
+    size_t m;             // 城市 1..n-1 对应位 0..m-1
+    size_t stride;        // 2^m
+    std::vector<int> dp;  // dp[j * stride + S]
+    std::vector<int> to;  // to[j * m + k] = d(k + 1, j + 1)
+    std::vector<int> from_start, to_start;
+    int bound = kInfinity; // 超过它的部分路径不再扩展
+
+    explicit HeldKarp(const std::vector<std::vector<int>> &d)
+        : m(d.size() - 1), stride(size_t(1) << m), dp(m * stride, kInfinity),
+          to(m * m), from_start(m), to_start(m) {
+      for (size_t j = 0; j < m; ++j) {
+        from_start[j] = d[0][j + 1];
+        to_start[j] = d[j + 1][0];
+        for (size_t k = 0; k < m; ++k) {
+          to[j * m + k] = d[k + 1][j + 1];
+        }
+      }
+    }
+
+    int clamp(long long value) const {
+      return value > bound ? kInfinity : static_cast<int>(value);
+    }
+
+    // 计算子集 S 的 dp[j][S]，j < last_city
+    void relax_subset(std::uint32_t s, size_t last_city) {
+      for (size_t j = 0; j < last_city; ++j) {
+        std::uint32_t bit = std::uint32_t(1) << j;
+        if (!(s & bit)) {
+          continue;
+        }
+        std::uint32_t prev = s ^ bit;
+        if (prev == 0) {
+          dp[j * stride + s] = clamp(from_start[j]);
+          continue;
+        }
+        int best = kInfinity;
+        for (std::uint32_t rest = prev; rest; rest &= rest - 1) {
+          size_t k = __builtin_ctz(rest);
+          best = std::min(best, dp[k * stride + prev] + to[j * m + k]);
+        }
+        dp[j * stride + s] = clamp(best);
+      }
+    }
+
+    // 处理低3位为 0..7 的一块子集
+    void relax_block(std::uint32_t base) {
+#ifdef ALGORITHMS_GEMM_X86
+      if (CpuFeatures::avx2()) {
+        relax_block_avx2(base);
+        // 低3位的城市依赖同一块内更小的子集，按子集递增逐个处理
+        for (std::uint32_t lane = 0; lane < 8; ++lane) {
+          relax_subset(base + lane, 3);
+        }
+        return;
+      }
+#endif
+      for (std::uint32_t lane = 0; lane < 8; ++lane) {
+        relax_subset(base + lane, m);
+      }
+    }
+
+#ifdef ALGORITHMS_GEMM_X86
+    __attribute__((target("avx2"))) void relax_block_avx2(std::uint32_t base) {
+      const __m256i infinity = _mm256_set1_epi32(kInfinity);
+      const __m256i limit = _mm256_set1_epi32(bound);
+      for (size_t j = 3; j < m; ++j) {
+        std::uint32_t bit = std::uint32_t(1) << j;
+        if (!(base & bit)) {
+          continue;
+        }
+        std::uint32_t prev = base ^ bit;
+        __m256i best = infinity;
+        for (size_t k = 0; k < m; ++k) {
+          // k ≥ 3 时8个子集对 k 的归属相同；k < 3 不在子集中的项本身就是无穷
+          if (k >= 3 && !(prev >> k & 1)) {
+            continue;
+          }
+          __m256i value = _mm256_loadu_si256(
+              reinterpret_cast<const __m256i *>(&dp[k * stride + prev]));
+          best = _mm256_min_epi32(
+              best, _mm256_add_epi32(value, _mm256_set1_epi32(to[j * m + k])));
+        }
+        best = _mm256_blendv_epi8(best, infinity,
+                                  _mm256_cmpgt_epi32(best, limit));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(&dp[j * stride + base]),
+                            best);
+        if (prev == 0) {
+          dp[j * stride + base] = clamp(from_start[j]);
+        }
+      }
+    }
+#endif
+
+    void solve(WorkStealingScheduler *scheduler) {
+      if (m < 3) {
+        for (std::uint32_t s = 1; s < stride; ++s) {
+          relax_subset(s, m);
+        }
+        return;
+      }
+      // 按高位（第3位及以上）元素个数分层
+      size_t high_bits = m - 3;
+      std::vector<std::vector<std::uint32_t>> layers(high_bits + 1);
+      for (std::uint32_t h = 0; h < (std::uint32_t(1) << high_bits); ++h) {
+        layers[__builtin_popcount(h)].push_back(h << 3);
+      }
+      for (const auto &layer : layers) {
+        auto run = [&](size_t lo, size_t hi) {
+          for (size_t i = lo; i < hi; ++i) {
+            relax_block(layer[i]);
+          }
+        };
+        if (scheduler && layer.size() > kBlockGrain) {
+          scheduler->parallel_for(0, layer.size(), kBlockGrain, run);
+        } else {
+          run(0, layer.size());
+        }
+      }
+    }
+
+    TspTour reconstruct() const {
+      std::uint32_t full = static_cast<std::uint32_t>(stride - 1);
+      long long best = std::numeric_limits<long long>::max();
+      size_t last = 0;
+      for (size_t j = 0; j < m; ++j) {
+        long long cost = static_cast<long long>(dp[j * stride + full]) + to_start[j];
+        if (dp[j * stride + full] < kInfinity && cost < best) {
+          best = cost;
+          last = j;
+        }
+      }
+      std::vector<int> tour = {0};
+      std::uint32_t s = full;
+      for (size_t j = last;;) {
+        tour.push_back(static_cast<int>(j + 1));
+        std::uint32_t prev = s ^ (std::uint32_t(1) << j);
+        if (prev == 0) {
+          break;
+        }
+        for (std::uint32_t rest = prev; rest; rest &= rest - 1) {
+          size_t k = __builtin_ctz(rest);
+          if (dp[k * stride + prev] + to[j * m + k] == dp[j * stride + s]) {
+            j = k;
+            break;
+          }
+        }
+        s = prev;
+      }
+      tour.push_back(0);
+      std::reverse(tour.begin(), tour.end());
+      return {tour, static_cast<int>(best)};
+    }
+
+    static constexpr size_t kBlockGrain = 64;
+  };
+};
+
+} // namespace algorithms
+
+#endif // EXACT_SOLVERS_H
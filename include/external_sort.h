@@ -0,0 +1,492 @@
+#ifndef EXTERNAL_SORT_H
+#define EXTERNAL_SORT_H
+
+#include "multithreaded_algorithms.h"
+#include "work_stealing_scheduler.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+
+// 外部排序的参数
+struct ExternalSortOptions {
+  size_t memory_budget = size_t(1) << 30;  // 缓冲区总字节数（顺串生成与归并共用）
+  size_t io_block_bytes = size_t(4) << 20; // 归并缓冲块字节数的上限
+  size_t num_threads = std::thread::hardware_concurrency(); // 顺串内排序的线程数
+  size_t io_threads = 2;      // 异步读写线程数
+  std::string temp_directory; // 临时文件目录；为空时使用输出文件所在目录
+};
+
+// 一次外部排序的统计
+struct ExternalSortStats {
+  uint64_t elements = 0;      // 记录数
+  size_t runs = 0;            // 初始顺串数
+  size_t merge_passes = 0;    // 多路归并的趟数
+  size_t fan_in = 0;          // 每趟最多同时归并的顺串数
+  uint64_t bytes_read = 0;    // 从输入与临时文件读取的字节数
+  uint64_t bytes_written = 0; // 写入临时文件与输出的字节数
+};
+
+/**
+ * @brief 外部归并排序：排序比内存大的定长记录文件
+ *
+ * 文件内容是 T 的原始字节序列（T 须可平凡复制），按 less 升序输出。
+ * - 顺串生成：内存预算分成两半，一半用并行样本排序
+ *   （MultithreadedAlgorithms::parallel_sort）排序并写出当前顺串，
+ *   另一半同时在I/O线程上读入下一段
+ * - 多路归并：每个输入顺串两块缓冲，消费一块时另一块在I/O线程上预读；
+ *   输出同样双缓冲。k 个顺串的当前元素用败者树选最小值，每输出一个元素
+ *   只需沿叶到根比较 ⌈lg k⌉ 次
+ * - 顺串数超过同时可归并的路数 k = 预算/(2·块大小) - 1 时，每趟把 k 个
+ *   顺串归并成一个，直到剩下的顺串能一趟归并到输出文件
+ *
+ * 临时文件创建后立即 unlink，进程退出（包括异常）时由系统回收。
+ */
+template <typename T, typename Less = std::less<T>> class ExternalSorter {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "ExternalSorter requires trivially copyable records");
+
+public:
+  explicit ExternalSorter(ExternalSortOptions sort_options = ExternalSortOptions(),
+                          Less less_than = Less())
+      : options(std::move(sort_options)), less(less_than) {
+    if (options.memory_budget < 4 * sizeof(T)) {
+      throw std::invalid_argument("ExternalSorter: memory budget too small");
+    }
+    options.num_threads = std::max<size_t>(1, options.num_threads);
+    options.io_threads = std::max<size_t>(1, options.io_threads);
+  }
+
+  /**
+   * @brief 排序 input 写到 output（两者不能是同一文件）
+   * @throws std::invalid_argument 文件长度不是记录大小的整数倍
+   * @throws std::runtime_error 文件打开或读写失败
+   */
+  ExternalSortStats sort_file(const std::string &input,
+                              const std::string &output) {
+    if (input == output) {
+      throw std::invalid_argument("ExternalSorter: input and output must differ");
+    }
+    stats = ExternalSortStats();
+    File source(input, File::kRead);
+    uint64_t bytes = source.size();
+    if (bytes % sizeof(T) != 0) {
+      throw std::invalid_argument("ExternalSorter: size of " + input +
+                                  " is not a multiple of the record size");
+    }
+    stats.elements = bytes / sizeof(T);
+    File destination(output, File::kCreate);
+    MultithreadedAlgorithms::ThreadPool io(options.io_threads);
+    WorkStealingScheduler scheduler(options.num_threads);
+
+    // 整个文件放得进预算：一次读入，排序后直接写出
+    if (stats.elements <= options.memory_budget / sizeof(T)) {
+      std::vector<T> data(stats.elements);
+      read_records(source, 0, data.size(), data.data());
+      MultithreadedAlgorithms::parallel_sort(scheduler, data.data(),
+                                             data.data() + data.size(), less);
+      write_records(destination, 0, data.size(), data.data());
+      stats.runs = stats.elements > 0;
+      return stats;
+    }
+
+    File runs_file(temp_path(output), File::kTemporary);
+    std::vector<Run> runs = form_runs(source, runs_file, io, scheduler);
+    stats.runs = runs.size();
+
+    // 每路两块输入缓冲，另有两块输出缓冲。多一趟归并要把数据完整读写一遍，
+    // 比块变小多出的寻道贵得多：块缩小到能一趟归并完所有顺串为止，但不小于 kMinBlockBytes
+    size_t block_bytes = std::min(
+        {options.io_block_bytes, options.memory_budget / 6,
+         std::max(kMinBlockBytes, options.memory_budget / (2 * (runs.size() + 1)))});
+    size_t block = std::max<size_t>(1, block_bytes / sizeof(T));
+    size_t fan_in =
+        std::max<size_t>(2, options.memory_budget / (2 * block * sizeof(T)) - 1);
+    stats.fan_in = fan_in;
+
+    std::vector<File> scratch;
+    scratch.reserve(2);
+    File *current = &runs_file;
+    while (runs.size() > fan_in) {
+      if (scratch.size() < 2) {
+        scratch.emplace_back(temp_path(output), File::kTemporary);
+      }
+      // 第一趟从 runs_file 读，之后在两个临时文件之间交替
+      File *next = &scratch[stats.merge_passes % 2];
+      std::vector<Run> merged;
+      for (size_t group = 0; group < runs.size(); group += fan_in) {
+        size_t last = std::min(runs.size(), group + fan_in);
+        std::vector<Run> inputs(runs.begin() + group, runs.begin() + last);
+        // 同一趟的输出顺串按输入顺序首尾相接
+        uint64_t begin = inputs.front().begin;
+        merge_runs(*current, inputs, *next, begin, block, io);
+        merged.push_back({begin, inputs.back().end});
+      }
+      runs = std::move(merged);
+      current = next;
+      ++stats.merge_passes;
+    }
+    merge_runs(*current, runs, destination, 0, block, io);
+    ++stats.merge_passes;
+    return stats;
+  }
+
+private:
+  static constexpr size_t kMinBlockBytes = size_t(64) << 10; // 归并缓冲块的下限
+
+  ExternalSortOptions options;
+  Less less;
+  ExternalSortStats stats;
+  size_t temp_counter = 0;
+
+  // 文件中的一个顺串：记录下标 [begin, end)
+  struct Run {
+    uint64_t begin, end;
+  };
+
+  // 按字节偏移用 pread/pwrite 读写的文件
+  class File {
+  public:
+    enum Mode { kRead, kCreate, kTemporary };
+
+    File(const std::string &path, Mode mode) {
+      int flags = mode == kRead ? O_RDONLY : (O_RDWR | O_CREAT | O_TRUNC);
+      fd = ::open(path.c_str(), flags, 0644);
+      if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path + ": " +
+                                 std::strerror(errno));
+      }
+      if (mode == kTemporary) {
+        ::unlink(path.c_str());
+      }
+    }
+
+    File(File &&other) noexcept : fd(other.fd) { other.fd = -1; }
+    File(const File &) = delete;
+    File &operator=(const File &) = delete;
+    File &operator=(File &&) = delete;
+
+    ~File() {
+      if (fd >= 0) {
+        ::close(fd);
+      }
+    }
+
+    uint64_t size() const {
+      struct stat info;
+      if (::fstat(fd, &info) != 0) {
+        throw std::runtime_error(std::string("fstat failed: ") +
+                                 std::strerror(errno));
+      }
+      return static_cast<uint64_t>(info.st_size);
+    }
+
+    void read_at(uint64_t offset, void *buffer, size_t bytes) const {
+      char *out = static_cast<char *>(buffer);
+      size_t done = 0;
+      while (done < bytes) {
+        ssize_t got = ::pread(fd, out + done, bytes - done,
+                              static_cast<off_t>(offset + done));
+        if (got < 0 && errno == EINTR)
+          continue;
+        if (got <= 0) {
+          throw std::runtime_error(
+              std::string("External sort read failed: ") +
+              (got == 0 ? "unexpected end of file" : std::strerror(errno)));
+        }
+        done += static_cast<size_t>(got);
+      }
+    }
+
+    void write_at(uint64_t offset, const void *buffer, size_t bytes) {
+      const char *in = static_cast<const char *>(buffer);
+      size_t done = 0;
+      while (done < bytes) {
+        ssize_t put = ::pwrite(fd, in + done, bytes - done,
+                               static_cast<off_t>(offset + done));
+        if (put < 0) {
+          if (errno == EINTR)
+            continue;
+          throw std::runtime_error(std::string("External sort write failed: ") +
+                                   std::strerror(errno));
+        }
+        done += static_cast<size_t>(put);
+      }
+    }
+
+  private:
+    int fd = -1;
+  };
+
+  // 一个输入顺串的双缓冲读取器：buffers[active] 正被消费，另一块在预读
+  class RunReader {
+  public:
+    RunReader(const File &run_file, Run run, size_t block_size)
+        : file(&run_file), next(run.begin), end(run.end), block(block_size) {
+      buffers[0].resize(std::min<uint64_t>(block, end - next));
+      buffers[1].resize(buffers[0].size());
+    }
+
+    RunReader(RunReader &&) = default;
+
+    ~RunReader() {
+      if (pending.valid())
+        pending.wait();
+    }
+
+    // 发起下一块的异步读
+    void prefetch(MultithreadedAlgorithms::ThreadPool &io, uint64_t &bytes) {
+      if (next == end)
+        return;
+      size_t count = static_cast<size_t>(std::min<uint64_t>(block, end - next));
+      T *target = buffers[active ^ 1].data();
+      const File *source = file;
+      uint64_t first = next;
+      pending = io.enqueue([source, first, count, target] {
+        source->read_at(first * sizeof(T), target, count * sizeof(T));
+        return count;
+      });
+      next += count;
+      bytes += count * sizeof(T);
+    }
+
+    // 切换到已预读的一块并预读再下一块；顺串读完时返回 false
+    bool refill(MultithreadedAlgorithms::ThreadPool &io, uint64_t &bytes) {
+      if (!pending.valid())
+        return false;
+      count = pending.get();
+      active ^= 1;
+      position = 0;
+      prefetch(io, bytes);
+      return true;
+    }
+
+    const T &current() const { return buffers[active][position]; }
+
+    // 前进一个元素；顺串读完时返回 false
+    bool advance(MultithreadedAlgorithms::ThreadPool &io, uint64_t &bytes) {
+      return ++position < count || refill(io, bytes);
+    }
+
+  private:
+    const File *file;
+    uint64_t next, end;
+    size_t block;
+    std::vector<T> buffers[2];
+    int active = 0;
+    size_t position = 0, count = 0;
+    std::future<size_t> pending;
+  };
+
+  // 双缓冲输出：一块写满后交给I/O线程，同时填另一块
+  class RunWriter {
+  public:
+    RunWriter(File &target, uint64_t first, size_t block_size)
+        : file(&target), offset(first), block(block_size) {
+      buffers[0].resize(block);
+      buffers[1].resize(block);
+    }
+
+    ~RunWriter() {
+      if (pending.valid())
+        pending.wait();
+    }
+
+    void push(const T &value, MultithreadedAlgorithms::ThreadPool &io,
+              uint64_t &bytes) {
+      buffers[active][fill] = value;
+      if (++fill == block)
+        flush(io, bytes);
+    }
+
+    void flush(MultithreadedAlgorithms::ThreadPool &io, uint64_t &bytes) {
+      if (pending.valid())
+        pending.get(); // 另一块的写入完成后才能复用它
+      if (fill > 0) {
+        File *target = file;
+        const T *data = buffers[active].data();
+        uint64_t at = offset;
+        size_t count = fill;
+        pending = io.enqueue([target, at, data, count] {
+          target->write_at(at * sizeof(T), data, count * sizeof(T));
+        });
+        offset += fill;
+        bytes += fill * sizeof(T);
+        fill = 0;
+        active ^= 1;
+      }
+    }
+
+    void finish(MultithreadedAlgorithms::ThreadPool &io, uint64_t &bytes) {
+      flush(io, bytes);
+      if (pending.valid())
+        pending.get();
+    }
+
+  private:
+    File *file;
+    uint64_t offset;
+    size_t block;
+    std::vector<T> buffers[2];
+    int active = 0;
+    size_t fill = 0;
+    std::future<void> pending;
+  };
+
+  /**
+   * @brief 败者树（Knuth 5.4.1）：tree[0] 为当前胜者，内部结点存该场比赛的败者
+   *
+   * 叶子 i 对应第 i 路；读完的一路视为 +∞。建树时用下标 k 表示 -∞ 的
+   * 虚拟选手，依次调整各叶子把它挤出树外。
+   */
+  class LoserTree {
+  public:
+    LoserTree(std::vector<RunReader> &run_readers, std::vector<bool> &done,
+              const Less &less_than)
+        : readers(run_readers), exhausted(done), less(less_than),
+          k(run_readers.size()), tree(k, k) {
+      for (size_t i = k; i-- > 0;) {
+        adjust(i);
+      }
+    }
+
+    size_t winner() const { return tree[0]; }
+
+    // 叶子 leaf 的值改变后沿路径向上重赛
+    void adjust(size_t leaf) {
+      size_t winner = leaf;
+      for (size_t node = (leaf + k) / 2; node > 0; node /= 2) {
+        if (beats(tree[node], winner))
+          std::swap(tree[node], winner);
+      }
+      tree[0] = winner;
+    }
+
+  private:
+    std::vector<RunReader> &readers;
+    std::vector<bool> &exhausted;
+    const Less &less;
+    size_t k;
+    std::vector<size_t> tree;
+
+    // a 是否胜过 b；相等时下标小的胜，保持各路之间的先后
+    bool beats(size_t a, size_t b) const {
+      if (a == k || b == k)
+        return a == k;
+      if (exhausted[a] || exhausted[b])
+        return !exhausted[a] && (exhausted[b] || a < b);
+      const T &x = readers[a].current(), &y = readers[b].current();
+      return less(x, y) || (!less(y, x) && a < b);
+    }
+  };
+
+  std::string temp_path(const std::string &output) {
+    std::string directory = options.temp_directory;
+    if (directory.empty()) {
+      size_t slash = output.find_last_of('/');
+      directory = slash == std::string::npos ? "." : output.substr(0, slash);
+      directory = directory.empty() ? "/" : directory;
+    }
+    return directory + "/.external_sort." + std::to_string(::getpid()) + "." +
+           std::to_string(temp_counter++);
+  }
+
+  void read_records(const File &file, uint64_t first, size_t count, T *out) {
+    file.read_at(first * sizeof(T), out, count * sizeof(T));
+    stats.bytes_read += count * sizeof(T);
+  }
+
+  void write_records(File &file, uint64_t first, size_t count, const T *in) {
+    file.write_at(first * sizeof(T), in, count * sizeof(T));
+    stats.bytes_written += count * sizeof(T);
+  }
+
+  // 顺串生成：排序并写出第 r 段的同时读入第 r+1 段
+  std::vector<Run> form_runs(const File &source, File &runs_file,
+                             MultithreadedAlgorithms::ThreadPool &io,
+                             WorkStealingScheduler &scheduler) {
+    const size_t run_length =
+        std::max<size_t>(1, options.memory_budget / 2 / sizeof(T));
+    std::vector<T> buffers[2];
+    buffers[0].resize(run_length);
+    buffers[1].resize(run_length);
+    std::vector<Run> runs;
+    for (uint64_t begin = 0; begin < stats.elements; begin += run_length) {
+      runs.push_back({begin, std::min<uint64_t>(stats.elements,
+                                                begin + run_length)});
+    }
+    auto start_read = [&](size_t r) {
+      T *target = buffers[r % 2].data();
+      const File *file = &source;
+      Run run = runs[r];
+      stats.bytes_read += (run.end - run.begin) * sizeof(T);
+      return io.enqueue([file, run, target] {
+        file->read_at(run.begin * sizeof(T), target,
+                      (run.end - run.begin) * sizeof(T));
+      });
+    };
+    std::future<void> pending = start_read(0);
+    for (size_t r = 0; r < runs.size(); ++r) {
+      pending.get();
+      if (r + 1 < runs.size())
+        pending = start_read(r + 1);
+      T *data = buffers[r % 2].data();
+      size_t count = static_cast<size_t>(runs[r].end - runs[r].begin);
+      try {
+        MultithreadedAlgorithms::parallel_sort(scheduler, data, data + count,
+                                               less);
+        write_records(runs_file, runs[r].begin, count, data);
+      } catch (...) {
+        if (pending.valid())
+          pending.wait();
+        throw;
+      }
+    }
+    return runs;
+  }
+
+  // 把 source 中的若干顺串归并到 target，从记录下标 first 开始写
+  void merge_runs(const File &source, const std::vector<Run> &runs, File &target,
+                  uint64_t first, size_t block,
+                  MultithreadedAlgorithms::ThreadPool &io) {
+    std::vector<RunReader> readers;
+    readers.reserve(runs.size());
+    std::vector<bool> exhausted(runs.size());
+    for (const Run &run : runs) {
+      readers.emplace_back(source, run, block);
+      readers.back().prefetch(io, stats.bytes_read);
+    }
+    for (size_t i = 0; i < runs.size(); ++i) {
+      exhausted[i] = !readers[i].refill(io, stats.bytes_read);
+    }
+    RunWriter writer(target, first, block);
+    LoserTree tree(readers, exhausted, less);
+    while (true) {
+      size_t i = tree.winner();
+      if (exhausted[i])
+        break;
+      writer.push(readers[i].current(), io, stats.bytes_written);
+      exhausted[i] = !readers[i].advance(io, stats.bytes_read);
+      tree.adjust(i);
+    }
+    writer.finish(io, stats.bytes_written);
+  }
+};
+
+} // namespace algorithms
+
+#endif // EXTERNAL_SORT_H
@@ -0,0 +1,334 @@
+#ifndef FENWICK_ORDER_STATISTIC_H
+#define FENWICK_ORDER_STATISTIC_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+
+// 基于离散化键的 Fenwick 树（树状数组）顺序统计容器
+//
+// 与 OrderStatisticTree 提供相同的 select(i)/rank(key) 接口（排名从 1 开始，
+// 允许重复键），但数据只有两个连续数组：有序的候选键 keys 与计数的 Fenwick
+// 数组 tree。select 自顶向下按 2 的幂步长下降，rank 为一次前缀和，均为
+// O(log u)（u 为候选键个数），没有指针追逐，也没有旋转时的 size 维护。
+//
+// 候选键在构造时给出；insert_batch 可在 O(u + m log m) 时间内并入新键。
+template <typename T> class FenwickOrderStatistic {
+private:
+  std::vector<T> keys;             // 有序、无重复的候选键
+  std::vector<std::size_t> tree;   // tree[i] 为 (i - lowbit(i), i] 的计数和
+  std::size_t total = 0;           // 元素总数（含重复）
+
+  static std::size_t lowbit(std::size_t i) { return i & (~i + 1); }
+
+  // 候选键的 1 基下标，不存在时返回 0
+  std::size_t index_of(const T &key) const {
+    auto it = std::lower_bound(keys.begin(), keys.end(), key);
+    if (it == keys.end() || key < *it) {
+      return 0;
+    }
+    return static_cast<std::size_t>(it - keys.begin()) + 1;
+  }
+
+  void add(std::size_t i, std::size_t delta) {
+    for (; i < tree.size(); i += lowbit(i)) {
+      tree[i] += delta;
+    }
+  }
+
+  void subtract(std::size_t i, std::size_t delta) {
+    for (; i < tree.size(); i += lowbit(i)) {
+      tree[i] -= delta;
+    }
+  }
+
+  // 前 i 个候选键的计数和
+  std::size_t prefix(std::size_t i) const {
+    std::size_t sum = 0;
+    for (; i > 0; i -= lowbit(i)) {
+      sum += tree[i];
+    }
+    return sum;
+  }
+
+  // 由逐键计数（1 基）原地构建 Fenwick 数组，O(u)
+  static void build_in_place(std::vector<std::size_t> &a) {
+    for (std::size_t i = 1; i < a.size(); ++i) {
+      std::size_t j = i + lowbit(i);
+      if (j < a.size()) {
+        a[j] += a[i];
+      }
+    }
+  }
+
+  // build_in_place 的逆过程：把 Fenwick 数组还原为逐键计数，O(u)
+  static void unbuild_in_place(std::vector<std::size_t> &a) {
+    for (std::size_t i = a.size() - 1; i > 0; --i) {
+      std::size_t j = i + lowbit(i);
+      if (j < a.size()) {
+        a[j] -= a[i];
+      }
+    }
+  }
+
+public:
+  FenwickOrderStatistic() : tree(1, 0) {}
+
+  // 以候选键集合构造，初始为空；重复的候选键会被合并
+  explicit FenwickOrderStatistic(std::vector<T> universe)
+      : keys(std::move(universe)) {
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end(),
+                           [](const T &a, const T &b) {
+                             return !(a < b) && !(b < a);
+                           }),
+               keys.end());
+    tree.assign(keys.size() + 1, 0);
+  }
+
+  // 以一组元素（可重复）构造，候选键即这些元素本身，O(m log m)
+  static FenwickOrderStatistic from_values(std::vector<T> values) {
+    FenwickOrderStatistic result;
+    result.insert_batch(std::move(values));
+    return result;
+  }
+
+  bool empty() const { return total == 0; }
+
+  std::size_t size() const { return total; }
+
+  // 候选键个数
+  std::size_t universe_size() const { return keys.size(); }
+
+  // 两个数组占用的字节数
+  std::size_t memory_bytes() const {
+    return keys.capacity() * sizeof(T) +
+           tree.capacity() * sizeof(std::size_t);
+  }
+
+  bool contains(const T &key) const { return count(key) > 0; }
+
+  // 键 key 的出现次数
+  std::size_t count(const T &key) const {
+    std::size_t i = index_of(key);
+    return (i == 0) ? 0 : prefix(i) - prefix(i - 1);
+  }
+
+  // 插入一个元素；key 不是候选键时抛出异常
+  void insert(const T &key) {
+    std::size_t i = index_of(key);
+    if (i == 0) {
+      throw std::invalid_argument("Key is not in the universe");
+    }
+    add(i, 1);
+    ++total;
+  }
+
+  // 删除一个 key，不存在时返回 false
+  bool remove(const T &key) {
+    if (count(key) == 0) {
+      return false;
+    }
+    subtract(index_of(key), 1);
+    --total;
+    return true;
+  }
+
+  // 批量插入：全部命中候选键时为 O(m log u)；
+  // 含新键时与候选键归并后重建，O(u + m log m)
+  void insert_batch(std::vector<T> values) {
+    if (values.empty()) {
+      return;
+    }
+    std::sort(values.begin(), values.end());
+
+    bool all_known = true;
+    for (const T &v : values) {
+      if (index_of(v) == 0) {
+        all_known = false;
+        break;
+      }
+    }
+    if (all_known) {
+      for (const T &v : values) {
+        add(index_of(v), 1);
+      }
+      total += values.size();
+      return;
+    }
+
+    // 归并候选键与有序的新值：新值等于候选键时累加到该键，
+    // 否则作为新候选键追加；相同的新值累加到刚追加的键上
+    std::vector<std::size_t> counts = std::move(tree);
+    unbuild_in_place(counts);
+
+    std::vector<T> merged_keys;
+    std::vector<std::size_t> merged_counts(1, 0);
+    merged_keys.reserve(keys.size() + values.size());
+    merged_counts.reserve(keys.size() + values.size() + 1);
+
+    std::size_t i = 0, j = 0;
+    while (i < keys.size() || j < values.size()) {
+      if (j == values.size() || (i < keys.size() && keys[i] < values[j])) {
+        merged_keys.push_back(keys[i]);
+        merged_counts.push_back(counts[i + 1]);
+        ++i;
+        continue;
+      }
+      if (merged_keys.empty() || merged_keys.back() < values[j]) {
+        if (i < keys.size() && !(values[j] < keys[i])) {
+          merged_keys.push_back(keys[i]);
+          merged_counts.push_back(counts[i + 1]);
+          ++i;
+        } else {
+          merged_keys.push_back(values[j]);
+          merged_counts.push_back(0);
+        }
+      }
+      ++merged_counts.back();
+      ++j;
+    }
+
+    build_in_place(merged_counts);
+    keys = std::move(merged_keys);
+    tree = std::move(merged_counts);
+    total += values.size();
+  }
+
+  // 选择第 i 小的元素（1 <= i <= size()），O(log u)
+  T select(std::size_t i) const {
+    if (i < 1 || i > total) {
+      throw std::out_of_range("Rank out of range");
+    }
+    std::size_t n = keys.size();
+    std::size_t step = 1;
+    while (step * 2 <= n) {
+      step *= 2;
+    }
+    std::size_t pos = 0;
+    for (; step > 0; step /= 2) {
+      if (pos + step <= n && tree[pos + step] < i) {
+        pos += step;
+        i -= tree[pos];
+      }
+    }
+    return keys[pos];
+  }
+
+  // key 的排名：小于 key 的元素个数加 1；key 不存在时抛出异常
+  std::size_t rank(const T &key) const {
+    std::size_t i = index_of(key);
+    if (i == 0 || prefix(i) == prefix(i - 1)) {
+      throw std::runtime_error("Key not found");
+    }
+    return prefix(i - 1) + 1;
+  }
+
+  // 小于 key 的元素个数，key 可以不是候选键
+  std::size_t count_less(const T &key) const {
+    auto it = std::lower_bound(keys.begin(), keys.end(), key);
+    return prefix(static_cast<std::size_t>(it - keys.begin()));
+  }
+
+  // 最近秩法的 q 分位数（0 <= q <= 1）：第 max(1, ceil(q * n)) 小的元素
+  T quantile(double q) const {
+    if (empty()) {
+      throw std::runtime_error("Container is empty");
+    }
+    if (!(q >= 0.0 && q <= 1.0)) {
+      throw std::out_of_range("Quantile out of range");
+    }
+    std::size_t i =
+        static_cast<std::size_t>(std::ceil(q * static_cast<double>(total)));
+    return select(std::max<std::size_t>(1, std::min(i, total)));
+  }
+
+  void clear() {
+    std::fill(tree.begin(), tree.end(), 0);
+    total = 0;
+  }
+};
+
+// 流式分位数：写入先进入缓冲区，凑满一批（或显式 publish）后
+// 合并成新的只读快照并原子地替换；读者持有的快照在其生命周期内保持一致，
+// 不会看到半批写入，也不会阻塞写者的合并。
+template <typename T> class StreamingQuantile {
+public:
+  using Snapshot = FenwickOrderStatistic<T>;
+
+private:
+  std::size_t batch_size;
+  std::vector<T> pending;
+  std::shared_ptr<const Snapshot> current; // 只通过 std::atomic_load/store 访问
+  std::mutex pending_mutex;                // 保护 pending，串行化 publish
+
+  // 调用者持有 pending_mutex
+  void publish_locked() {
+    if (pending.empty()) {
+      return;
+    }
+    std::shared_ptr<const Snapshot> base = snapshot();
+    auto next = std::make_shared<Snapshot>(*base);
+    next->insert_batch(std::move(pending));
+    pending.clear();
+    std::atomic_store(&current, std::shared_ptr<const Snapshot>(std::move(next)));
+  }
+
+public:
+  // batch_size 为自动发布的批大小，须为正
+  explicit StreamingQuantile(std::size_t batch_size = 4096,
+                             std::vector<T> universe = {})
+      : batch_size(batch_size),
+        current(std::make_shared<const Snapshot>(std::move(universe))) {
+    if (batch_size == 0) {
+      throw std::invalid_argument("Batch size must be positive");
+    }
+    pending.reserve(batch_size);
+  }
+
+  // 记录一个观测值；缓冲区满时自动发布新快照
+  void insert(const T &value) {
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    pending.push_back(value);
+    if (pending.size() >= batch_size) {
+      publish_locked();
+    }
+  }
+
+  // 立即把缓冲区并入新快照
+  void publish() {
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    publish_locked();
+  }
+
+  // 尚未发布的观测值个数
+  std::size_t pending_size() {
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    return pending.size();
+  }
+
+  // 当前已发布的快照，可在任意线程上无锁地查询
+  std::shared_ptr<const Snapshot> snapshot() const {
+    return std::atomic_load(&current);
+  }
+
+  // 便捷查询：均基于调用时刻的快照
+  T quantile(double q) const { return snapshot()->quantile(q); }
+
+  T select(std::size_t i) const { return snapshot()->select(i); }
+
+  std::size_t rank(const T &key) const { return snapshot()->rank(key); }
+
+  std::size_t size() const { return snapshot()->size(); }
+};
+
+} // namespace algorithms
+
+#endif // FENWICK_ORDER_STATISTIC_H
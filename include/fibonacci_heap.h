@@ -1,8 +1,11 @@
 #ifndef FIBONACCI_HEAP_H
 #define FIBONACCI_HEAP_H
 
-#include <cmath>
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <stdexcept>
 #include <vector>
@@ -111,51 +114,98 @@ private:
     y->marked = false;
   }
 
+  /**
+   * @brief 把以first为头的环形链表整体拼接到根链表中，O(1)
+   * @param list_min 该链表中关键字最小的节点
+   */
+  void splice_root_list(std::shared_ptr<FibonacciHeapNode<T>> first,
+                        std::shared_ptr<FibonacciHeapNode<T>> list_min) {
+    if (!min_node) {
+      min_node = list_min;
+      return;
+    }
+
+    auto this_last = min_node->left;
+    auto other_last = first->left;
+
+    this_last->right = first;
+    first->left = this_last;
+    min_node->left = other_last;
+    other_last->right = min_node;
+
+    if (list_min->key < min_node->key) {
+      min_node = list_min;
+    }
+  }
+
+  /**
+   * @brief 将根y作为根x的子节点（y已经不在任何链表中）
+   */
+  void link_detached(std::shared_ptr<FibonacciHeapNode<T>> &y,
+                     std::shared_ptr<FibonacciHeapNode<T>> &x) {
+    if (!x->child) {
+      x->child = y;
+      y->left = y;
+      y->right = y;
+    } else {
+      link_nodes(x->child, y);
+    }
+
+    y->parent = x;
+    x->degree++;
+    y->marked = false;
+  }
+
+  /**
+   * D(n) <= log_phi(n)（引理19.4的推论），node_count 为 int 时
+   * D(n) <= log_phi(2^31) < 45，度数表可以放在栈上
+   */
+  static constexpr int kMaxDegree = 64;
+
   /**
    * @brief 合并根链表
+   *
+   * 逐个摘下根节点并按度数合并，摘下的节点不再属于任何链表，
+   * 因此不需要先把根链表复制到临时数组里；最后由度数表重建根链表。
    */
   void consolidate() {
     if (!min_node)
       return;
 
-    // 计算最大度数（基于节点数量的对数）
-    int max_degree = static_cast<int>(log2(node_count)) + 1;
-    std::vector<std::shared_ptr<FibonacciHeapNode<T>>> degree_table(
-        max_degree + 1, nullptr);
+    std::array<std::shared_ptr<FibonacciHeapNode<T>>, kMaxDegree>
+        degree_table;
+    int max_degree = 0;
 
-    // 收集根链表中的所有节点
-    std::vector<std::shared_ptr<FibonacciHeapNode<T>>> root_nodes;
     auto current = min_node;
-    do {
-      root_nodes.push_back(current);
+    auto last = min_node->left;
+    min_node = nullptr;
+    bool done = false;
+    while (!done) {
+      done = current == last;
+      auto x = current;
       current = current->right;
-    } while (current != min_node);
-
-    // 处理每个根节点
-    for (auto node : root_nodes) {
-      auto x = node;
-      int d = x->degree;
+      x->left = x;
+      x->right = x;
 
       // 合并相同度数的树
+      int d = x->degree;
       while (degree_table[d]) {
-        auto y = degree_table[d];
+        auto y = std::move(degree_table[d]);
 
         // 确保x是关键值较小的节点
         if (x->key > y->key) {
           std::swap(x, y);
         }
 
-        // 将y链接到x
-        link(y, x);
-        degree_table[d] = nullptr;
+        link_detached(y, x);
         d++;
       }
 
-      degree_table[d] = x;
+      degree_table[d] = std::move(x);
+      max_degree = std::max(max_degree, d);
     }
 
     // 重建根链表
-    min_node = nullptr;
     for (int i = 0; i <= max_degree; i++) {
       if (degree_table[i]) {
         insert_to_root_list(degree_table[i]);
@@ -226,11 +276,49 @@ public:
 
   /**
    * @brief 插入新节点
+   * @return 新节点的句柄，可用于decrease_key和delete_node
    */
-  void insert(const T &key) {
+  std::shared_ptr<FibonacciHeapNode<T>> insert(const T &key) {
     auto new_node = std::make_shared<FibonacciHeapNode<T>>(key);
     insert_to_root_list(new_node);
     node_count++;
+    return new_node;
+  }
+
+  /**
+   * @brief 批量插入
+   *
+   * 新节点先在堆外串成一个环形链表，再一次性拼接到根链表中，
+   * 每批只修改一次根链表和 min_node。
+   * @return 与 keys 一一对应的节点句柄
+   */
+  std::vector<std::shared_ptr<FibonacciHeapNode<T>>>
+  insert_batch(const std::vector<T> &keys) {
+    std::vector<std::shared_ptr<FibonacciHeapNode<T>>> handles;
+    if (keys.empty()) {
+      return handles;
+    }
+    handles.reserve(keys.size());
+
+    std::shared_ptr<FibonacciHeapNode<T>> first, list_min;
+    for (const T &key : keys) {
+      auto node = std::make_shared<FibonacciHeapNode<T>>(key);
+      if (!first) {
+        node->left = node;
+        node->right = node;
+        first = list_min = node;
+      } else {
+        link_nodes(first, node);
+        if (node->key < list_min->key) {
+          list_min = node;
+        }
+      }
+      handles.push_back(std::move(node));
+    }
+
+    splice_root_list(first, list_min);
+    node_count += static_cast<int>(keys.size());
+    return handles;
   }
 
   /**
@@ -240,24 +328,7 @@ public:
     if (other.is_empty())
       return;
 
-    if (is_empty()) {
-      min_node = other.min_node;
-    } else {
-      // 连接两个根链表
-      auto this_last = min_node->left;
-      auto other_first = other.min_node;
-      auto other_last = other.min_node->left;
-
-      this_last->right = other_first;
-      other_first->left = this_last;
-      min_node->left = other_last;
-      other_last->right = min_node;
-
-      // 更新最小节点
-      if (other.min_node->key < min_node->key) {
-        min_node = other.min_node;
-      }
-    }
+    splice_root_list(other.min_node, other.min_node);
 
     node_count += other.node_count;
 
@@ -288,20 +359,89 @@ public:
       } while (child != min->child);
     }
 
-    // 从根链表中移除min
+    // 从根链表中移除min（remove_from_root_list会把min_node移到右兄弟）
+    bool was_last_root = (min->right == min);
     remove_from_root_list(min);
+    min->child = nullptr;
+    node_count--;
 
-    if (min == min->right) {
+    if (was_last_root) {
       min_node = nullptr;
     } else {
-      min_node = min->right;
       consolidate();
     }
 
-    node_count--;
     return min_key;
   }
 
+  /**
+   * @brief 按从小到大的顺序提取至多k个最小关键字
+   *
+   * 不逐个调用 extract_min（那样每次都要合并根链表），而是在堆序森林上做
+   * 堆选择：候选集初始为所有根，每弹出一个最小候选就把它的子节点加入候选集。
+   * 弹出k个之后剩下的候选恰好是新的根集合（原来的根，或父节点已被取走的节点），
+   * 把它们串成根链表后只合并一次。总代价 O(k log k + 根数) 加一次 consolidate。
+   */
+  std::vector<T> extract_k_min(std::size_t k) {
+    std::vector<T> result;
+    if (k == 0 || is_empty()) {
+      return result;
+    }
+    if (k == 1) {
+      result.push_back(extract_min());
+      return result;
+    }
+    result.reserve(std::min(k, static_cast<std::size_t>(node_count)));
+
+    using NodePtr = std::shared_ptr<FibonacciHeapNode<T>>;
+    auto later = [](const NodePtr &a, const NodePtr &b) {
+      return b->key < a->key;
+    };
+
+    std::vector<NodePtr> candidates;
+    auto add_ring = [&candidates, &later](const NodePtr &first) {
+      auto node = first;
+      do {
+        candidates.push_back(node);
+        std::push_heap(candidates.begin(), candidates.end(), later);
+        node = node->right;
+      } while (node != first);
+    };
+    add_ring(min_node);
+
+    while (result.size() < k && !candidates.empty()) {
+      std::pop_heap(candidates.begin(), candidates.end(), later);
+      NodePtr node = std::move(candidates.back());
+      candidates.pop_back();
+      result.push_back(node->key);
+      if (node->child) {
+        add_ring(node->child);
+      }
+      // 断开被取走节点的指针，避免 shared_ptr 环
+      node->child = nullptr;
+      node->parent = nullptr;
+      node->left = nullptr;
+      node->right = nullptr;
+    }
+    node_count -= static_cast<int>(result.size());
+
+    // 剩余候选组成新的根链表
+    min_node = nullptr;
+    for (NodePtr &node : candidates) {
+      node->parent = nullptr;
+      node->marked = false;
+      node->left = node;
+      node->right = node;
+      if (!min_node) {
+        min_node = node;
+      } else {
+        link_nodes(min_node, node);
+      }
+    }
+    consolidate();
+    return result;
+  }
+
   /**
    * @brief 减小关键字
    */
@@ -0,0 +1,394 @@
+#ifndef FLAT_HASH_MAP_H
+#define FLAT_HASH_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace algorithms {
+
+/**
+ * @brief 扁平散列表（Swiss table风格的开放寻址法，11.4节）
+ *
+ * - 每个槽位对应一个控制字节：空槽为0x80，占用槽存放散列值的低7位(H2)
+ * - 探查按16个控制字节一组进行，用SSE2一次比较整组的H2（无SSE2时逐字节比较）
+ * - 探查序列是线性的（以组为窗口），因此删除时可以后移（backward shift），
+ *   不需要墓碑，删除大量元素后查找性能也不会退化
+ * - 元素直接存放在连续的槽位数组中，散列函数以模板参数内联，
+ *   find返回指向表内值的指针，不产生任何拷贝
+ * - 元素个数超过 capacity * max_load_factor 时容量翻倍
+ * 指针在插入导致扩容、或删除引起后移时失效。
+ */
+template <typename K, typename V, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+class FlatHashMap {
+public:
+  using value_type = std::pair<K, V>;
+
+  explicit FlatHashMap(size_t initial_capacity = 0,
+                       float max_load_factor = 0.875f, const Hash &hash = Hash(),
+                       const KeyEqual &equal = KeyEqual())
+      : hasher(hash), key_equal(equal) {
+    set_max_load_factor(max_load_factor);
+    if (initial_capacity > 0) {
+      reserve(initial_capacity);
+    }
+  }
+
+  FlatHashMap(const FlatHashMap &other)
+      : hasher(other.hasher), key_equal(other.key_equal),
+        load_limit(other.load_limit) {
+    reserve(other.element_count);
+    other.for_each(
+        [this](const K &key, const V &value) { insert(key, value); });
+  }
+
+  FlatHashMap(FlatHashMap &&other) noexcept
+      : hasher(std::move(other.hasher)), key_equal(std::move(other.key_equal)),
+        load_limit(other.load_limit) {
+    steal(other);
+  }
+
+  FlatHashMap &operator=(FlatHashMap other) {
+    swap(other);
+    return *this;
+  }
+
+  ~FlatHashMap() { release(); }
+
+  void swap(FlatHashMap &other) noexcept {
+    std::swap(hasher, other.hasher);
+    std::swap(key_equal, other.key_equal);
+    std::swap(ctrl, other.ctrl);
+    std::swap(slots, other.slots);
+    std::swap(slot_count, other.slot_count);
+    std::swap(element_count, other.element_count);
+    std::swap(growth_left, other.growth_left);
+    std::swap(load_limit, other.load_limit);
+  }
+
+  // 查找：返回表内值的指针，不存在时返回nullptr
+  V *find(const K &key) {
+    size_t index = find_index(key, hash_of(key));
+    return index == kNotFound ? nullptr : &slot(index)->second;
+  }
+
+  const V *find(const K &key) const {
+    size_t index = find_index(key, hash_of(key));
+    return index == kNotFound ? nullptr : &slot(index)->second;
+  }
+
+  bool contains(const K &key) const {
+    return find_index(key, hash_of(key)) != kNotFound;
+  }
+
+  // 插入：键已存在时不覆盖，返回(值指针, 是否新插入)
+  template <typename... Args>
+  std::pair<V *, bool> emplace(const K &key, Args &&...args) {
+    size_t hash = hash_of(key);
+    size_t index = find_index(key, hash);
+    if (index != kNotFound) {
+      return {&slot(index)->second, false};
+    }
+    if (growth_left == 0) {
+      grow();
+    }
+    index = find_empty(hash);
+    new (slot(index)) value_type(std::piecewise_construct,
+                                 std::forward_as_tuple(key),
+                                 std::forward_as_tuple(std::forward<Args>(args)...));
+    set_ctrl(index, h2(hash));
+    element_count++;
+    growth_left--;
+    return {&slot(index)->second, true};
+  }
+
+  std::pair<V *, bool> insert(const K &key, const V &value) {
+    return emplace(key, value);
+  }
+
+  std::pair<V *, bool> insert(const K &key, V &&value) {
+    return emplace(key, std::move(value));
+  }
+
+  // 插入或覆盖
+  template <typename M> V &insert_or_assign(const K &key, M &&value) {
+    auto result = emplace(key, std::forward<M>(value));
+    if (!result.second) {
+      *result.first = std::forward<M>(value);
+    }
+    return *result.first;
+  }
+
+  V &operator[](const K &key) { return *emplace(key).first; }
+
+  // 删除：后移紧随其后、可以前移的元素，保持线性探查的不变式
+  bool erase(const K &key) {
+    size_t index = find_index(key, hash_of(key));
+    if (index == kNotFound) {
+      return false;
+    }
+    slot(index)->~value_type();
+    size_t mask = slot_count - 1;
+    size_t hole = index;
+    for (size_t next = (hole + 1) & mask; is_full(ctrl[next]);
+         next = (next + 1) & mask) {
+      size_t home = (hash_of(slot(next)->first) >> 7) & mask;
+      // home不在(hole, next]区间内时，next可以移到hole
+      if (((next - home) & mask) >= ((next - hole) & mask)) {
+        new (slot(hole)) value_type(std::move(*slot(next)));
+        slot(next)->~value_type();
+        set_ctrl(hole, ctrl[next]);
+        hole = next;
+      }
+    }
+    set_ctrl(hole, kEmpty);
+    element_count--;
+    growth_left++;
+    return true;
+  }
+
+  void clear() {
+    destroy_elements();
+    if (ctrl != nullptr) {
+      std::memset(ctrl, kEmpty, slot_count + kGroupWidth);
+    }
+    element_count = 0;
+    growth_left = max_elements(slot_count);
+  }
+
+  // 预留至少能容纳count个元素而不扩容的空间
+  void reserve(size_t count) {
+    size_t capacity = kGroupWidth;
+    while (max_elements(capacity) < count) {
+      capacity *= 2;
+    }
+    if (capacity > slot_count) {
+      rehash(capacity);
+    }
+  }
+
+  // 遍历所有元素：visit(key, value)
+  template <typename Visitor> void for_each(Visitor visit) {
+    for (size_t i = 0; i < slot_count; i++) {
+      if (is_full(ctrl[i])) {
+        visit(static_cast<const K &>(slot(i)->first), slot(i)->second);
+      }
+    }
+  }
+
+  template <typename Visitor> void for_each(Visitor visit) const {
+    for (size_t i = 0; i < slot_count; i++) {
+      if (is_full(ctrl[i])) {
+        visit(static_cast<const K &>(slot(i)->first),
+              static_cast<const V &>(slot(i)->second));
+      }
+    }
+  }
+
+  size_t size() const { return element_count; }
+  bool empty() const { return element_count == 0; }
+  size_t capacity() const { return slot_count; }
+  double load_factor() const {
+    return slot_count == 0 ? 0.0
+                           : static_cast<double>(element_count) / slot_count;
+  }
+  float max_load_factor() const { return load_limit; }
+
+  // 负载因子上限，取值(0, 1)；必须留出空槽让探查终止
+  void set_max_load_factor(float factor) {
+    if (!(factor > 0.0f && factor < 1.0f)) {
+      throw std::invalid_argument("Max load factor must be in (0, 1)");
+    }
+    load_limit = factor;
+    if (slot_count > 0) {
+      if (element_count > max_elements(slot_count)) {
+        reserve(element_count);
+      } else {
+        growth_left = max_elements(slot_count) - element_count;
+      }
+    }
+  }
+
+private:
+  static constexpr size_t kGroupWidth = 16;
+  static constexpr size_t kNotFound = static_cast<size_t>(-1);
+  static constexpr int8_t kEmpty = static_cast<int8_t>(0x80);
+
+  using Storage = typename std::aligned_storage<sizeof(value_type),
+                                                alignof(value_type)>::type;
+
+  Hash hasher;
+  KeyEqual key_equal;
+  int8_t *ctrl = nullptr;   // slot_count + kGroupWidth 个控制字节，尾部镜像开头
+  Storage *slots = nullptr;
+  size_t slot_count = 0;    // 2的幂，至少kGroupWidth
+  size_t element_count = 0;
+  size_t growth_left = 0;   // 不扩容时还能插入的元素数
+  float load_limit = 0.875f;
+
+  static bool is_full(int8_t control) { return control >= 0; }
+  static int8_t h2(size_t hash) { return static_cast<int8_t>(hash & 0x7F); }
+
+  // 组内控制字节与byte相等的位掩码（第i位对应组内第i个槽）
+  static uint32_t match_byte(const int8_t *group, int8_t byte) {
+#if defined(__SSE2__)
+    __m128i control =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+    return static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8(byte))));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kGroupWidth; i++) {
+      mask |= static_cast<uint32_t>(group[i] == byte) << i;
+    }
+    return mask;
+#endif
+  }
+
+  // 空槽的最高位为1，直接取符号位
+  static uint32_t match_empty(const int8_t *group) {
+#if defined(__SSE2__)
+    return static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(group))));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kGroupWidth; i++) {
+      mask |= static_cast<uint32_t>(group[i] < 0) << i;
+    }
+    return mask;
+#endif
+  }
+
+  static int lowest_bit(uint32_t mask) { return __builtin_ctz(mask); }
+
+  // 对用户散列值再做一次乘法混合，std::hash<int>等恒等散列也能均匀分布
+  size_t hash_of(const K &key) const {
+    uint64_t h = static_cast<uint64_t>(hasher(key)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(h ^ (h >> 32));
+  }
+
+  value_type *slot(size_t index) const {
+    return std::launder(reinterpret_cast<value_type *>(slots + index));
+  }
+
+  size_t max_elements(size_t capacity) const {
+    size_t limit = static_cast<size_t>(capacity * static_cast<double>(load_limit));
+    return limit < capacity ? limit : capacity - 1;
+  }
+
+  // 写控制字节，开头的kGroupWidth个同时写到尾部镜像，组加载无需处理回绕
+  void set_ctrl(size_t index, int8_t value) {
+    ctrl[index] = value;
+    if (index < kGroupWidth) {
+      ctrl[slot_count + index] = value;
+    }
+  }
+
+  size_t find_index(const K &key, size_t hash) const {
+    if (element_count == 0) {
+      return kNotFound;
+    }
+    size_t mask = slot_count - 1;
+    int8_t tag = h2(hash);
+    for (size_t position = (hash >> 7) & mask;;
+         position = (position + kGroupWidth) & mask) {
+      const int8_t *group = ctrl + position;
+      for (uint32_t match = match_byte(group, tag); match != 0;
+           match &= match - 1) {
+        size_t index = (position + lowest_bit(match)) & mask;
+        if (key_equal(slot(index)->first, key)) {
+          return index;
+        }
+      }
+      // 线性探查：遇到空槽说明键不在表中
+      if (match_empty(group) != 0) {
+        return kNotFound;
+      }
+    }
+  }
+
+  size_t find_empty(size_t hash) const {
+    size_t mask = slot_count - 1;
+    for (size_t position = (hash >> 7) & mask;;
+         position = (position + kGroupWidth) & mask) {
+      uint32_t empty = match_empty(ctrl + position);
+      if (empty != 0) {
+        return (position + lowest_bit(empty)) & mask;
+      }
+    }
+  }
+
+  void grow() { rehash(slot_count == 0 ? kGroupWidth : slot_count * 2); }
+
+  void rehash(size_t new_capacity) {
+    int8_t *old_ctrl = ctrl;
+    Storage *old_slots = slots;
+    size_t old_count = slot_count;
+
+    ctrl = new int8_t[new_capacity + kGroupWidth];
+    std::memset(ctrl, kEmpty, new_capacity + kGroupWidth);
+    slots = new Storage[new_capacity];
+    slot_count = new_capacity;
+    growth_left = max_elements(new_capacity) - element_count;
+
+    for (size_t i = 0; i < old_count; i++) {
+      if (is_full(old_ctrl[i])) {
+        value_type *element =
+            std::launder(reinterpret_cast<value_type *>(old_slots + i));
+        size_t hash = hash_of(element->first);
+        size_t index = find_empty(hash);
+        new (slot(index)) value_type(std::move(*element));
+        set_ctrl(index, h2(hash));
+        element->~value_type();
+      }
+    }
+    delete[] old_ctrl;
+    delete[] old_slots;
+  }
+
+  void destroy_elements() {
+    if (!std::is_trivially_destructible<value_type>::value) {
+      for (size_t i = 0; i < slot_count; i++) {
+        if (is_full(ctrl[i])) {
+          slot(i)->~value_type();
+        }
+      }
+    }
+  }
+
+  void release() {
+    destroy_elements();
+    delete[] ctrl;
+    delete[] slots;
+    ctrl = nullptr;
+    slots = nullptr;
+    slot_count = element_count = growth_left = 0;
+  }
+
+  void steal(FlatHashMap &other) {
+    ctrl = other.ctrl;
+    slots = other.slots;
+    slot_count = other.slot_count;
+    element_count = other.element_count;
+    growth_left = other.growth_left;
+    other.ctrl = nullptr;
+    other.slots = nullptr;
+    other.slot_count = other.element_count = other.growth_left = 0;
+  }
+};
+
+} // namespace algorithms
+
+#endif // FLAT_HASH_MAP_H
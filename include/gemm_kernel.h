@@ -0,0 +1,268 @@
+#ifndef GEMM_KERNEL_H
+#define GEMM_KERNEL_H
+
+#include "cpu_features.h"
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) &&                             \
+    (defined(__GNUC__) || defined(__clang__))
+#define ALGORITHMS_GEMM_X86 1
+#include <immintrin.h>
+#endif
+
+namespace algorithms {
+
+/**
+ * @brief 分块矩阵乘法内核（行主序，C += A * B）
+ *
+ * 采用GotoBLAS式的三层分块：
+ * - B按 KC x NC 分块并打包成宽度为NR的列条
+ * - A按 MC x KC 分块并打包成高度为MR的行条
+ * - 微内核在寄存器中累加 MR x NR 的C子块
+ * 打包后的数据连续存放，微内核顺序读取，缓存和向量化都友好。
+ *
+ * 微内核在运行时按CPU能力选择：AVX-512（6x16）、AVX2+FMA（6x8）
+ * 或可移植的标量版本（4x4）。Matrix::operator* 和
+ * MultithreadedAlgorithms::multithreaded_matrix_multiply 共用该内核。
+ */
+class GemmKernel {
+public:
+  enum class Isa { Scalar, AVX2, AVX512, Auto };
+
+  /**
+   * @brief 当前CPU支持的最佳指令集
+   */
+  static Isa detected_isa() {
+    static const Isa isa = detect();
+    return isa;
+  }
+
+  static std::string isa_name(Isa isa) {
+    switch (isa) {
+    case Isa::AVX512:
+      return "AVX-512";
+    case Isa::AVX2:
+      return "AVX2+FMA";
+    case Isa::Scalar:
+      return "标量";
+    default:
+      return isa_name(detected_isa());
+    }
+  }
+
+  /**
+   * @brief 计算 C[M x N] += A[M x K] * B[K x N]
+   * @param lda/ldb/ldc 各矩阵的行跨度（行主序）
+   * @param isa 指定微内核，Auto表示按CPU自动选择；不支持的指令集退回标量
+   */
+  static void gemm(size_t M, size_t N, size_t K, const double *A, size_t lda,
+                   const double *B, size_t ldb, double *C, size_t ldc,
+                   Isa isa = Isa::Auto) {
+    if (M == 0 || N == 0 || K == 0)
+      return;
+
+    if (isa == Isa::Auto || !supported(isa)) {
+      isa = isa == Isa::Auto ? detected_isa() : Isa::Scalar;
+    }
+
+    switch (isa) {
+#ifdef ALGORITHMS_GEMM_X86
+    case Isa::AVX512:
+      blocked<6, 16>(M, N, K, A, lda, B, ldb, C, ldc, micro_kernel_avx512);
+      break;
+    case Isa::AVX2:
+      blocked<6, 8>(M, N, K, A, lda, B, ldb, C, ldc, micro_kernel_avx2);
+      break;
+#endif
+    default:
+      blocked<4, 4>(M, N, K, A, lda, B, ldb, C, ldc, micro_kernel_scalar<4, 4>);
+      break;
+    }
+  }
+
+  static bool supported(Isa isa) {
+    if (isa == Isa::Scalar || isa == Isa::Auto)
+      return true;
+    Isa best = detected_isa();
+    return isa == Isa::AVX2 ? best != Isa::Scalar : best == Isa::AVX512;
+  }
+
+private:
+  // 分块参数：KC*NR*8字节的B条放L1，MC*KC的A块放L2，KC*NC的B块放L3
+  static constexpr size_t KC = 256;
+  static constexpr size_t MC = 96;
+  static constexpr size_t NC = 2048;
+
+  using MicroKernel = void (*)(size_t kc, const double *a, const double *b,
+                               double *c, size_t ldc);
+
+  static Isa detect() {
+#ifdef ALGORITHMS_GEMM_X86
+    if (CpuFeatures::avx512f())
+      return Isa::AVX512;
+    if (CpuFeatures::avx2() && CpuFeatures::fma())
+      return Isa::AVX2;
+#endif
+    return Isa::Scalar;
+  }
+
+  template <size_t MR, size_t NR>
+  static void blocked(size_t M, size_t N, size_t K, const double *A, size_t lda,
+                      const double *B, size_t ldb, double *C, size_t ldc,
+                      MicroKernel kernel) {
+    std::vector<double> packed_a(MC * KC);
+    std::vector<double> packed_b(KC * ((NC + NR - 1) / NR) * NR);
+    double edge[MR * NR];
+
+    for (size_t jc = 0; jc < N; jc += NC) {
+      size_t nc = std::min(NC, N - jc);
+      for (size_t pc = 0; pc < K; pc += KC) {
+        size_t kc = std::min(KC, K - pc);
+        pack_b<NR>(kc, nc, B + pc * ldb + jc, ldb, packed_b.data());
+
+        for (size_t ic = 0; ic < M; ic += MC) {
+          size_t mc = std::min(MC, M - ic);
+          pack_a<MR>(mc, kc, A + ic * lda + pc, lda, packed_a.data());
+
+          for (size_t jr = 0; jr < nc; jr += NR) {
+            size_t nr = std::min(NR, nc - jr);
+            const double *b_panel = packed_b.data() + jr * kc;
+
+            for (size_t ir = 0; ir < mc; ir += MR) {
+              size_t mr = std::min(MR, mc - ir);
+              const double *a_panel = packed_a.data() + ir * kc;
+              double *c_block = C + (ic + ir) * ldc + jc + jr;
+
+              if (mr == MR && nr == NR) {
+                kernel(kc, a_panel, b_panel, c_block, ldc);
+              } else {
+                // 边缘子块：先算到临时缓冲区再累加有效部分
+                std::fill(edge, edge + MR * NR, 0.0);
+                kernel(kc, a_panel, b_panel, edge, NR);
+                for (size_t i = 0; i < mr; i++)
+                  for (size_t j = 0; j < nr; j++)
+                    c_block[i * ldc + j] += edge[i * NR + j];
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // 打包A：每MR行一条，条内按k为主序存放MR个元素，不足MR行补零
+  template <size_t MR>
+  static void pack_a(size_t mc, size_t kc, const double *A, size_t lda,
+                     double *dst) {
+    for (size_t ir = 0; ir < mc; ir += MR) {
+      size_t mr = std::min(MR, mc - ir);
+      for (size_t k = 0; k < kc; k++) {
+        for (size_t i = 0; i < mr; i++)
+          *dst++ = A[(ir + i) * lda + k];
+        for (size_t i = mr; i < MR; i++)
+          *dst++ = 0.0;
+      }
+    }
+  }
+
+  // 打包B：每NR列一条，条内按k为主序存放NR个元素，不足NR列补零
+  template <size_t NR>
+  static void pack_b(size_t kc, size_t nc, const double *B, size_t ldb,
+                     double *dst) {
+    for (size_t jr = 0; jr < nc; jr += NR) {
+      size_t nr = std::min(NR, nc - jr);
+      for (size_t k = 0; k < kc; k++) {
+        const double *row = B + k * ldb + jr;
+        for (size_t j = 0; j < nr; j++)
+          *dst++ = row[j];
+        for (size_t j = nr; j < NR; j++)
+          *dst++ = 0.0;
+      }
+    }
+  }
+
+  template <size_t MR, size_t NR>
+  static void micro_kernel_scalar(size_t kc, const double *a, const double *b,
+                                  double *c, size_t ldc) {
+    double acc[MR][NR] = {};
+    for (size_t k = 0; k < kc; k++) {
+      for (size_t i = 0; i < MR; i++)
+        for (size_t j = 0; j < NR; j++)
+          acc[i][j] += a[i] * b[j];
+      a += MR;
+      b += NR;
+    }
+    for (size_t i = 0; i < MR; i++)
+      for (size_t j = 0; j < NR; j++)
+        c[i * ldc + j] += acc[i][j];
+  }
+
+#ifdef ALGORITHMS_GEMM_X86
+  // AVX2微内核：6x8，12个ymm累加器
+  __attribute__((target("avx2,fma"))) static void
+  micro_kernel_avx2(size_t kc, const double *a, const double *b, double *c,
+                    size_t ldc) {
+    __m256d acc[6][2];
+    for (int i = 0; i < 6; i++) {
+      acc[i][0] = _mm256_setzero_pd();
+      acc[i][1] = _mm256_setzero_pd();
+    }
+
+    for (size_t k = 0; k < kc; k++) {
+      __m256d b0 = _mm256_loadu_pd(b);
+      __m256d b1 = _mm256_loadu_pd(b + 4);
+      for (int i = 0; i < 6; i++) {
+        __m256d ai = _mm256_broadcast_sd(a + i);
+        acc[i][0] = _mm256_fmadd_pd(ai, b0, acc[i][0]);
+        acc[i][1] = _mm256_fmadd_pd(ai, b1, acc[i][1]);
+      }
+      a += 6;
+      b += 8;
+    }
+
+    for (int i = 0; i < 6; i++) {
+      double *row = c + i * ldc;
+      _mm256_storeu_pd(row, _mm256_add_pd(_mm256_loadu_pd(row), acc[i][0]));
+      _mm256_storeu_pd(row + 4,
+                       _mm256_add_pd(_mm256_loadu_pd(row + 4), acc[i][1]));
+    }
+  }
+
+  // AVX-512微内核：6x16，12个zmm累加器
+  __attribute__((target("avx512f"))) static void
+  micro_kernel_avx512(size_t kc, const double *a, const double *b, double *c,
+                      size_t ldc) {
+    __m512d acc[6][2];
+    for (int i = 0; i < 6; i++) {
+      acc[i][0] = _mm512_setzero_pd();
+      acc[i][1] = _mm512_setzero_pd();
+    }
+
+    for (size_t k = 0; k < kc; k++) {
+      __m512d b0 = _mm512_loadu_pd(b);
+      __m512d b1 = _mm512_loadu_pd(b + 8);
+      for (int i = 0; i < 6; i++) {
+        __m512d ai = _mm512_set1_pd(a[i]);
+        acc[i][0] = _mm512_fmadd_pd(ai, b0, acc[i][0]);
+        acc[i][1] = _mm512_fmadd_pd(ai, b1, acc[i][1]);
+      }
+      a += 6;
+      b += 16;
+    }
+
+    for (int i = 0; i < 6; i++) {
+      double *row = c + i * ldc;
+      _mm512_storeu_pd(row, _mm512_add_pd(_mm512_loadu_pd(row), acc[i][0]));
+      _mm512_storeu_pd(row + 8,
+                       _mm512_add_pd(_mm512_loadu_pd(row + 8), acc[i][1]));
+    }
+  }
+#endif
+};
+
+} // namespace algorithms
+
+#endif // GEMM_KERNEL_H
@@ -8,10 +8,32 @@
 #include <memory>
 #include <queue>
 #include <stack>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace algorithms {
 
+// 图概念（供BFS/DFS、拓扑排序、最小生成树、最短路径等算法模板使用）
+// 图类型需要提供以下接口，节点用内部下标0..n-1访问：
+//   size_t get_node_count() const
+//   bool is_directed() const
+//   int get_node_id(size_t node_index) const      下标 -> 节点编号
+//   int get_node_index(int node_id) const         编号 -> 下标（不存在返回-1）
+//   template <typename Visitor>
+//   void for_each_out_edge(size_t node_index, Visitor visit) const
+//       对每条出边调用 visit(目标节点下标, 权重)
+// AdjacencyListGraph 和 CSRGraph 都满足该概念。
+
+// 基于图概念的广度优先搜索，返回按访问顺序排列的节点编号
+template <typename Graph>
+std::vector<int> graph_bfs(const Graph &graph, int start_node);
+
+// 基于图概念的深度优先搜索，返回按访问顺序排列的节点编号
+template <typename Graph>
+std::vector<int> graph_dfs(const Graph &graph, int start_node);
+
 // 图节点
 struct GraphNode {
   int id;
@@ -43,17 +65,26 @@ class AdjacencyListGraph {
 private:
   std::vector<GraphNode> nodes;
   std::vector<std::list<GraphEdge>> adjacency_list;
+  std::unordered_map<int, int> index_of_id; // 节点编号 -> 下标，O(1)查找
   bool directed;
 
 public:
   AdjacencyListGraph(bool is_directed = false) : directed(is_directed) {}
 
+  // 预留节点空间（批量建图前调用，避免反复扩容和重新散列）
+  void reserve(size_t node_count) {
+    nodes.reserve(node_count);
+    adjacency_list.reserve(node_count);
+    index_of_id.reserve(node_count);
+  }
+
   // 添加节点
   void add_node(int node_id, const std::string &name = "") {
     if (find_node_index(node_id) != -1) {
       throw std::invalid_argument("Node already exists");
     }
 
+    index_of_id[node_id] = nodes.size();
     nodes.emplace_back(node_id, name);
     adjacency_list.emplace_back();
   }
@@ -82,6 +113,94 @@ public:
     }
   }
 
+  // 批量添加边：不做逐条重复检查，O(E)
+  // remove_duplicates为true时，最后用一次排序去掉重复边（保留最早加入的一条，
+  // 与add_edge拒绝重复边的语义一致）；为false时调用方需保证没有重复边
+  void add_edges(const std::vector<GraphEdge> &edges,
+                 bool remove_duplicates = true) {
+    add_edges(edges.begin(), edges.end(), remove_duplicates);
+  }
+
+  template <typename InputIt>
+  void add_edges(InputIt first, InputIt last, bool remove_duplicates = true) {
+    // 先检查所有端点，任何节点不存在时不修改图
+    std::vector<std::pair<int, int>> endpoints;
+    for (InputIt it = first; it != last; ++it) {
+      int from_index = find_node_index(it->from);
+      int to_index = find_node_index(it->to);
+      if (from_index == -1 || to_index == -1) {
+        throw std::invalid_argument("Node not found");
+      }
+      endpoints.emplace_back(from_index, to_index);
+    }
+
+    size_t k = 0;
+    for (InputIt it = first; it != last; ++it, ++k) {
+      adjacency_list[endpoints[k].first].emplace_back(it->from, it->to,
+                                                       it->weight);
+      if (!directed) {
+        adjacency_list[endpoints[k].second].emplace_back(it->to, it->from,
+                                                          it->weight);
+      }
+    }
+
+    if (remove_duplicates) {
+      deduplicate_edges();
+    }
+  }
+
+  // 删除重复边（同一起点、同一终点的多条边只保留最早的一条）
+  // 对(起点, 终点, 序号)排序一次，再按原顺序重建各链表，保持出边顺序不变
+  void deduplicate_edges() {
+    struct EdgeKey {
+      int from_index;
+      int to;
+      size_t order;
+    };
+
+    std::vector<EdgeKey> keys;
+    size_t order = 0;
+    for (size_t i = 0; i < adjacency_list.size(); i++) {
+      for (const auto &edge : adjacency_list[i]) {
+        keys.push_back({static_cast<int>(i), edge.to, order++});
+      }
+    }
+
+    std::sort(keys.begin(), keys.end(),
+              [](const EdgeKey &a, const EdgeKey &b) {
+                if (a.from_index != b.from_index)
+                  return a.from_index < b.from_index;
+                if (a.to != b.to)
+                  return a.to < b.to;
+                return a.order < b.order;
+              });
+
+    std::vector<bool> duplicate(order, false);
+    bool any_duplicate = false;
+    for (size_t k = 1; k < keys.size(); k++) {
+      if (keys[k].from_index == keys[k - 1].from_index &&
+          keys[k].to == keys[k - 1].to) {
+        duplicate[keys[k].order] = true;
+        any_duplicate = true;
+      }
+    }
+
+    if (!any_duplicate) {
+      return;
+    }
+
+    order = 0;
+    for (auto &list : adjacency_list) {
+      for (auto it = list.begin(); it != list.end();) {
+        if (duplicate[order++]) {
+          it = list.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+  }
+
   // 获取节点的邻居
   std::vector<int> get_neighbors(int node_id) const {
     int node_index = find_node_index(node_id);
@@ -107,72 +226,12 @@ public:
 
   // 广度优先搜索
   std::vector<int> bfs(int start_node) const {
-    int start_index = find_node_index(start_node);
-    if (start_index == -1) {
-      return {};
-    }
-
-    std::vector<int> result;
-    std::vector<bool> visited(nodes.size(), false);
-    std::queue<int> q;
-
-    visited[start_index] = true;
-    q.push(start_index);
-
-    while (!q.empty()) {
-      int current_index = q.front();
-      q.pop();
-      result.push_back(nodes[current_index].id);
-
-      for (const auto &edge : adjacency_list[current_index]) {
-        int neighbor_index = find_node_index(edge.to);
-        if (!visited[neighbor_index]) {
-          visited[neighbor_index] = true;
-          q.push(neighbor_index);
-        }
-      }
-    }
-
-    return result;
+    return graph_bfs(*this, start_node);
   }
 
   // 深度优先搜索
   std::vector<int> dfs(int start_node) const {
-    int start_index = find_node_index(start_node);
-    if (start_index == -1) {
-      return {};
-    }
-
-    std::vector<int> result;
-    std::vector<bool> visited(nodes.size(), false);
-    std::stack<int> s;
-
-    s.push(start_index);
-
-    while (!s.empty()) {
-      int current_index = s.top();
-      s.pop();
-
-      if (!visited[current_index]) {
-        visited[current_index] = true;
-        result.push_back(nodes[current_index].id);
-
-        // 逆序添加邻居，以保持与递归DFS相似的顺序
-        std::vector<int> neighbors;
-        for (const auto &edge : adjacency_list[current_index]) {
-          neighbors.push_back(find_node_index(edge.to));
-        }
-        std::reverse(neighbors.begin(), neighbors.end());
-
-        for (int neighbor_index : neighbors) {
-          if (!visited[neighbor_index]) {
-            s.push(neighbor_index);
-          }
-        }
-      }
-    }
-
-    return result;
+    return graph_dfs(*this, start_node);
   }
 
   // 打印邻接表
@@ -243,15 +302,29 @@ public:
   // 检查图是否是有向图
   bool is_directed() const { return directed; }
 
+  // 按内部下标直接访问出边链表（不复制，供最短路径等算法遍历使用）
+  const std::list<GraphEdge> &get_out_edge_list(size_t node_index) const {
+    return adjacency_list[node_index];
+  }
+
+  // 图概念接口：下标与编号互相转换
+  int get_node_id(size_t node_index) const { return nodes[node_index].id; }
+
+  int get_node_index(int node_id) const { return find_node_index(node_id); }
+
+  // 图概念接口：遍历出边，visit(目标节点下标, 权重)
+  template <typename Visitor>
+  void for_each_out_edge(size_t node_index, Visitor visit) const {
+    for (const auto &edge : adjacency_list[node_index]) {
+      visit(find_node_index(edge.to), edge.weight);
+    }
+  }
+
 private:
   // 查找节点的索引
   int find_node_index(int node_id) const {
-    for (size_t i = 0; i < nodes.size(); i++) {
-      if (nodes[i].id == node_id) {
-        return i;
-      }
-    }
-    return -1;
+    auto it = index_of_id.find(node_id);
+    return it == index_of_id.end() ? -1 : it->second;
   }
 };
 
@@ -453,6 +526,315 @@ private:
   }
 };
 
+// 压缩稀疏行（CSR）表示的图：冻结后不可修改
+// 节点i的出边连续存放在targets/weights的[offsets[i], offsets[i+1])区间，
+// 遍历时顺序访问内存，没有链表节点的指针追逐
+class CSRGraph {
+private:
+  std::vector<int> node_ids;                // 下标 -> 节点编号
+  std::unordered_map<int, int> index_of_id; // 节点编号 -> 下标
+  std::vector<size_t> offsets;              // 长度为n+1的出边偏移
+  std::vector<int> targets;                 // 出边终点（节点下标）
+  std::vector<int> weights;                 // 出边权重
+  bool directed;
+  bool identity_ids = false; // 节点编号即下标，不存 node_ids/index_of_id（大规模生成图）
+
+  friend class CSRGraphBuilder;
+
+public:
+  CSRGraph(bool is_directed = false) : offsets(1, 0), directed(is_directed) {}
+
+  // 获取节点数量
+  size_t get_node_count() const { return offsets.size() - 1; }
+
+  // 获取边数量（无向图的每条边存储两次）
+  size_t get_edge_count() const {
+    return directed ? targets.size() : targets.size() / 2;
+  }
+
+  // 检查图是否是有向图
+  bool is_directed() const { return directed; }
+
+  // 图概念接口：下标与编号互相转换
+  int get_node_id(size_t node_index) const {
+    return identity_ids ? static_cast<int>(node_index) : node_ids[node_index];
+  }
+
+  int get_node_index(int node_id) const {
+    if (identity_ids) {
+      return node_id >= 0 && static_cast<size_t>(node_id) < get_node_count()
+                 ? node_id
+                 : -1;
+    }
+    auto it = index_of_id.find(node_id);
+    return it == index_of_id.end() ? -1 : it->second;
+  }
+
+  // 图概念接口：遍历出边，visit(目标节点下标, 权重)
+  template <typename Visitor>
+  void for_each_out_edge(size_t node_index, Visitor visit) const {
+    for (size_t e = offsets[node_index]; e < offsets[node_index + 1]; e++) {
+      visit(targets[e], weights[e]);
+    }
+  }
+
+  // 按下标获取出度
+  size_t get_out_degree(size_t node_index) const {
+    return offsets[node_index + 1] - offsets[node_index];
+  }
+
+  // 获取节点的度（出度），节点不存在返回-1
+  int get_degree(int node_id) const {
+    int node_index = get_node_index(node_id);
+    if (node_index == -1) {
+      return -1;
+    }
+    return get_out_degree(node_index);
+  }
+
+  // 获取节点的邻居编号
+  std::vector<int> get_neighbors(int node_id) const {
+    int node_index = get_node_index(node_id);
+    if (node_index == -1) {
+      return {};
+    }
+
+    std::vector<int> neighbors;
+    for_each_out_edge(node_index, [&](int target, int) {
+      neighbors.push_back(get_node_id(target));
+    });
+    return neighbors;
+  }
+
+  // 广度优先搜索
+  std::vector<int> bfs(int start_node) const {
+    return graph_bfs(*this, start_node);
+  }
+
+  // 深度优先搜索
+  std::vector<int> dfs(int start_node) const {
+    return graph_dfs(*this, start_node);
+  }
+
+  // 直接访问底层数组（供并行算法等需要原始布局的场景使用）
+  const std::vector<size_t> &get_offsets() const { return offsets; }
+  const std::vector<int> &get_targets() const { return targets; }
+  const std::vector<int> &get_weights() const { return weights; }
+};
+
+// CSR图构建器：先收集节点和边，再一次性生成CSRGraph
+class CSRGraphBuilder {
+private:
+  std::vector<int> node_ids;
+  std::unordered_map<int, int> index_of_id;
+  std::vector<GraphEdge> edges; // from/to 为节点下标
+  bool directed;
+
+public:
+  CSRGraphBuilder(bool is_directed = false) : directed(is_directed) {}
+
+  // 添加节点
+  void add_node(int node_id) {
+    if (index_of_id.count(node_id)) {
+      throw std::invalid_argument("Node already exists");
+    }
+    index_of_id[node_id] = node_ids.size();
+    node_ids.push_back(node_id);
+  }
+
+  // 添加边（不检查重复边，构建后允许出现平行边）
+  void add_edge(int from, int to, int weight = 1) {
+    auto from_it = index_of_id.find(from);
+    auto to_it = index_of_id.find(to);
+    if (from_it == index_of_id.end() || to_it == index_of_id.end()) {
+      throw std::invalid_argument("Node not found");
+    }
+
+    edges.emplace_back(from_it->second, to_it->second, weight);
+    if (!directed) {
+      edges.emplace_back(to_it->second, from_it->second, weight);
+    }
+  }
+
+  // 生成CSR图：按起点计数排序，保持每个节点出边的插入顺序
+  CSRGraph build() const {
+    CSRGraph graph(directed);
+    size_t n = node_ids.size();
+    graph.node_ids = node_ids;
+    graph.index_of_id = index_of_id;
+    graph.offsets.assign(n + 1, 0);
+
+    for (const auto &edge : edges) {
+      graph.offsets[edge.from + 1]++;
+    }
+    for (size_t i = 0; i < n; i++) {
+      graph.offsets[i + 1] += graph.offsets[i];
+    }
+
+    graph.targets.resize(edges.size());
+    graph.weights.resize(edges.size());
+    std::vector<size_t> cursor(graph.offsets.begin(), graph.offsets.end() - 1);
+    for (const auto &edge : edges) {
+      size_t slot = cursor[edge.from]++;
+      graph.targets[slot] = edge.to;
+      graph.weights[slot] = edge.weight;
+    }
+
+    return graph;
+  }
+
+  // 直接接管已按起点分组的CSR数组，节点编号即下标0..n-1
+  // 不建编号索引，供千万级节点的生成图使用（见 workload_generator.h）
+  static CSRGraph from_csr_arrays(std::vector<size_t> offsets,
+                                  std::vector<int> targets,
+                                  std::vector<int> weights, bool directed) {
+    if (offsets.empty() || offsets.back() != targets.size() ||
+        weights.size() != targets.size()) {
+      throw std::invalid_argument("Inconsistent CSR arrays");
+    }
+    CSRGraph graph(directed);
+    graph.identity_ids = true;
+    graph.offsets = std::move(offsets);
+    graph.targets = std::move(targets);
+    graph.weights = std::move(weights);
+    return graph;
+  }
+
+  // 从邻接表图转换，出边顺序与邻接表一致
+  static CSRGraph from_adjacency_list(const AdjacencyListGraph &source) {
+    CSRGraph graph(source.is_directed());
+    size_t n = source.get_node_count();
+
+    graph.node_ids.reserve(n);
+    graph.offsets.assign(n + 1, 0);
+    for (size_t i = 0; i < n; i++) {
+      int id = source.get_node_id(i);
+      graph.node_ids.push_back(id);
+      graph.index_of_id[id] = i;
+      graph.offsets[i + 1] =
+          graph.offsets[i] + source.get_out_edge_list(i).size();
+    }
+
+    graph.targets.reserve(graph.offsets[n]);
+    graph.weights.reserve(graph.offsets[n]);
+    for (size_t i = 0; i < n; i++) {
+      for (const auto &edge : source.get_out_edge_list(i)) {
+        graph.targets.push_back(graph.index_of_id[edge.to]);
+        graph.weights.push_back(edge.weight);
+      }
+    }
+
+    return graph;
+  }
+};
+
+// 图概念的出边快照：把任意图的出边拷贝成按下标存放的CSR数组
+// 迭代DFS需要按位置逐条推进出边，for_each_out_edge 的回调做不到这一点
+struct IndexedAdjacency {
+  std::vector<size_t> offsets; // 长度为n+1
+  std::vector<int> targets;    // 出边终点（节点下标）
+
+  IndexedAdjacency() : offsets(1, 0) {}
+
+  // transposed 为真时存放入边（反向图）
+  template <typename Graph>
+  explicit IndexedAdjacency(const Graph &graph, bool transposed = false) {
+    size_t n = graph.get_node_count();
+    offsets.assign(n + 1, 0);
+    for (size_t u = 0; u < n; u++) {
+      graph.for_each_out_edge(u, [&](int v, int) {
+        offsets[(transposed ? static_cast<size_t>(v) : u) + 1]++;
+      });
+    }
+    for (size_t i = 0; i < n; i++) {
+      offsets[i + 1] += offsets[i];
+    }
+    targets.resize(offsets[n]);
+    std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t u = 0; u < n; u++) {
+      graph.for_each_out_edge(u, [&](int v, int) {
+        if (transposed) {
+          targets[cursor[v]++] = static_cast<int>(u);
+        } else {
+          targets[cursor[u]++] = v;
+        }
+      });
+    }
+  }
+
+  size_t get_node_count() const { return offsets.size() - 1; }
+};
+
+template <typename Graph>
+std::vector<int> graph_bfs(const Graph &graph, int start_node) {
+  int start_index = graph.get_node_index(start_node);
+  if (start_index == -1) {
+    return {};
+  }
+
+  std::vector<int> result;
+  std::vector<bool> visited(graph.get_node_count(), false);
+  std::queue<int> q;
+
+  visited[start_index] = true;
+  q.push(start_index);
+
+  while (!q.empty()) {
+    int current_index = q.front();
+    q.pop();
+    result.push_back(graph.get_node_id(current_index));
+
+    graph.for_each_out_edge(current_index, [&](int neighbor_index, int) {
+      if (!visited[neighbor_index]) {
+        visited[neighbor_index] = true;
+        q.push(neighbor_index);
+      }
+    });
+  }
+
+  return result;
+}
+
+template <typename Graph>
+std::vector<int> graph_dfs(const Graph &graph, int start_node) {
+  int start_index = graph.get_node_index(start_node);
+  if (start_index == -1) {
+    return {};
+  }
+
+  std::vector<int> result;
+  std::vector<bool> visited(graph.get_node_count(), false);
+  std::stack<int> s;
+  std::vector<int> neighbors;
+
+  s.push(start_index);
+
+  while (!s.empty()) {
+    int current_index = s.top();
+    s.pop();
+
+    if (!visited[current_index]) {
+      visited[current_index] = true;
+      result.push_back(graph.get_node_id(current_index));
+
+      // 逆序添加邻居，以保持与递归DFS相似的顺序
+      neighbors.clear();
+      graph.for_each_out_edge(current_index, [&](int neighbor_index, int) {
+        neighbors.push_back(neighbor_index);
+      });
+      std::reverse(neighbors.begin(), neighbors.end());
+
+      for (int neighbor_index : neighbors) {
+        if (!visited[neighbor_index]) {
+          s.push(neighbor_index);
+        }
+      }
+    }
+  }
+
+  return result;
+}
+
 // 算法导论中的经典图示例
 void print_classic_examples() {
   std::cout << "=== 算法导论经典图示例 ===" << std::endl;
@@ -4,11 +4,18 @@
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <functional>
 #include <iostream>
 #include <list>
 #include <memory>
+#include <new>
 #include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace algorithms {
@@ -222,122 +229,544 @@ public:
 };
 
 // 11.4 开放寻址法
+// 探查方式：前三种由表自己根据键的散列值计算探查序列，支持自动扩容；
+// Custom使用用户提供的h(k, i)，表大小固定（教材版本）
+enum class ProbingMode { Linear, Quadratic, DoubleHashing, Custom };
+
+// 探查长度统计（探查长度 = 元素所在位置在其探查序列中的序号）
+struct ProbeStats {
+  double mean = 0.0;
+  double variance = 0.0;
+  size_t max = 0;
+};
+
 template <typename K, typename V> class OpenAddressingHashTable {
 private:
-  enum SlotStatus { EMPTY, OCCUPIED, DELETED };
+  enum SlotStatus : uint8_t { EMPTY = 0, OCCUPIED, DELETED };
+
+  // 槽元数据全零即为空槽，probe为元素（或墓碑）在探查序列中的序号
+  struct SlotMeta {
+    SlotStatus status;
+    uint32_t probe;
+  };
 
-  struct Slot {
+  struct Entry {
     K key;
     V value;
-    SlotStatus status;
+  };
+
+  static constexpr size_t kSegmentBits = 14;
+  static constexpr size_t kSegmentSlots = size_t(1) << kSegmentBits;
+  static constexpr size_t kSegmentMask = kSegmentSlots - 1;
+
+  // 槽数组：按kSegmentSlots个槽分段，段在第一次写入时才分配，
+  // 未分配的段视为全空，因此分配新表只需O(段数)；
+  // 迁移完成的旧表段可以提前释放键值存储（元数据保留到整表释放，
+  // 查找仍能依据墓碑的探查序号提前终止），不会在迁移结束时集中释放整张表
+  class SlotArray {
+  public:
+    SlotArray() = default;
+
+    explicit SlotArray(size_t n)
+        : count(n), segments((n + kSegmentSlots - 1) >> kSegmentBits) {}
+
+    // 深拷贝：复制已分配段的元数据和其中的元素，未分配的段仍不分配
+    SlotArray(const SlotArray &other)
+        : count(other.count), segments(other.segments.size()) {
+      try {
+        for (size_t k = 0; k < segments.size(); k++) {
+          copy_segment(segments[k], other.segments[k], k);
+        }
+      } catch (...) {
+        release();
+        throw;
+      }
+    }
+
+    SlotArray(SlotArray &&other) noexcept
+        : count(other.count), segments(std::move(other.segments)) {
+      other.count = 0;
+      other.segments.clear();
+    }
+
+    SlotArray &operator=(SlotArray &&other) noexcept {
+      if (this != &other) {
+        release();
+        count = other.count;
+        segments = std::move(other.segments);
+        other.count = 0;
+        other.segments.clear();
+      }
+      return *this;
+    }
+
+    SlotArray &operator=(const SlotArray &other) {
+      if (this != &other) {
+        *this = SlotArray(other);
+      }
+      return *this;
+    }
+
+    ~SlotArray() { release(); }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // 未分配的段为空槽
+    SlotMeta meta_at(size_t i) const {
+      const Segment &segment = segments[i >> kSegmentBits];
+      if (segment.meta == nullptr) {
+        return SlotMeta{EMPTY, 0};
+      }
+      return segment.meta[i & kSegmentMask];
+    }
+
+    Entry &entry_at(size_t i) {
+      return segments[i >> kSegmentBits].entries[i & kSegmentMask];
+    }
+    const Entry &entry_at(size_t i) const {
+      return segments[i >> kSegmentBits].entries[i & kSegmentMask];
+    }
+
+    void set_probe(size_t i, uint32_t probe) {
+      segments[i >> kSegmentBits].meta[i & kSegmentMask].probe = probe;
+    }
+
+    void construct(size_t i, Entry &&entry, uint32_t probe) {
+      Segment &segment = segments[i >> kSegmentBits];
+      if (segment.meta == nullptr) {
+        allocate(segment, i >> kSegmentBits);
+      }
+      new (&segment.entries[i & kSegmentMask]) Entry(std::move(entry));
+      segment.meta[i & kSegmentMask] = {OCCUPIED, probe};
+      segment.live++;
+    }
 
-    Slot() : status(EMPTY) {}
+    // 析构槽中的元素；墓碑保留探查序号，查找的提前终止条件依赖它
+    void destroy(size_t i, SlotStatus new_status) {
+      Segment &segment = segments[i >> kSegmentBits];
+      SlotMeta &meta = segment.meta[i & kSegmentMask];
+      segment.entries[i & kSegmentMask].~Entry();
+      segment.live--;
+      meta.status = new_status;
+      if (new_status == EMPTY) {
+        meta.probe = 0;
+      }
+    }
+
+    // 释放第i个槽所在段的键值存储（调用者保证段中已没有元素）
+    void release_entries_of(size_t i) {
+      Segment &segment = segments[i >> kSegmentBits];
+      if (segment.entries != nullptr) {
+        std::allocator<Entry>().deallocate(segment.entries,
+                                           segment_size(i >> kSegmentBits));
+        segment.entries = nullptr;
+      }
+    }
+
+  private:
+    struct Segment {
+      SlotMeta *meta = nullptr;
+      Entry *entries = nullptr;
+      size_t live = 0; // 已构造的元素数
+    };
+
+    size_t count = 0;
+    std::vector<Segment> segments;
+
+    size_t segment_size(size_t index) const {
+      return std::min(kSegmentSlots, count - (index << kSegmentBits));
+    }
+
+    void allocate(Segment &segment, size_t index) {
+      size_t n = segment_size(index);
+      segment.meta = static_cast<SlotMeta *>(std::calloc(n, sizeof(SlotMeta)));
+      if (segment.meta == nullptr) {
+        throw std::bad_alloc();
+      }
+      segment.entries = std::allocator<Entry>().allocate(n);
+    }
+
+    // 元素按槽的顺序拷贝构造，中途抛出异常时 free_segment 只析构
+    // 前 live 个占用槽，恰好是已构造的那些
+    void copy_segment(Segment &segment, const Segment &source, size_t index) {
+      if (source.meta == nullptr) {
+        return;
+      }
+      size_t n = segment_size(index);
+      segment.meta = static_cast<SlotMeta *>(std::malloc(n * sizeof(SlotMeta)));
+      if (segment.meta == nullptr) {
+        throw std::bad_alloc();
+      }
+      std::memcpy(segment.meta, source.meta, n * sizeof(SlotMeta));
+      if (source.entries == nullptr) {
+        return; // 迁移完成后已释放键值存储的旧表段
+      }
+      segment.entries = std::allocator<Entry>().allocate(n);
+      for (size_t k = 0; k < n && segment.live < source.live; k++) {
+        if (segment.meta[k].status == OCCUPIED) {
+          new (&segment.entries[k]) Entry(source.entries[k]);
+          segment.live++;
+        }
+      }
+    }
+
+    void free_segment(Segment &segment, size_t index) {
+      if (segment.meta == nullptr) {
+        return;
+      }
+      size_t n = segment_size(index);
+      for (size_t k = 0; k < n && segment.live > 0; k++) {
+        if (segment.meta[k].status == OCCUPIED) {
+          segment.entries[k].~Entry();
+          segment.live--;
+        }
+      }
+      std::free(segment.meta);
+      if (segment.entries != nullptr) {
+        std::allocator<Entry>().deallocate(segment.entries, n);
+      }
+      segment.meta = nullptr;
+      segment.entries = nullptr;
+    }
+
+    void release() {
+      for (size_t k = 0; k < segments.size(); k++) {
+        free_segment(segments[k], k);
+      }
+      segments.clear();
+      count = 0;
+    }
   };
 
-  std::vector<Slot> table;
-  int size;
-  std::function<int(K, int)> hash_function;
+  static constexpr size_t kNotFound = static_cast<size_t>(-1);
+  // 每次插入/删除顺带迁移的旧表槽数
+  static constexpr size_t kMigrationBatch = 32;
+
+  ProbingMode mode;
+  bool robin_hood;
+  double max_load;
+  std::function<int(K, int)> hash_function;     // Custom模式的h(k, i)
+  std::function<size_t(const K &)> key_hash;     // 其他模式的基础散列函数
+
+  SlotArray table;       // 当前表
+  size_t element_count;  // 当前表中的元素数
+  size_t tombstones;     // 当前表中的墓碑数
+  SlotArray old_table;   // 渐进式再散列期间尚未迁移完的旧表
+  size_t old_count;      // 旧表中剩余的元素数
+  size_t migrate_cursor; // 旧表的迁移进度
+
+  size_t hash_of(const K &key) const {
+    uint64_t h = static_cast<uint64_t>(key_hash(key)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(h ^ (h >> 32));
+  }
 
-  // 线性探查
-  int linear_probing(K key, int i) {
-    return (hash_function(key, 0) + i) % size;
+  // 第i次探查的槽位。表大小为2的幂：二次探查使用三角数 i(i+1)/2，
+  // 双重散列的步长取奇数，两者都能遍历所有槽
+  size_t probe_index(const K &key, size_t hash, size_t i,
+                     size_t capacity) const {
+    size_t mask = capacity - 1;
+    switch (mode) {
+    case ProbingMode::Linear:
+      return (hash + i) & mask;
+    case ProbingMode::Quadratic:
+      return (hash + i * (i + 1) / 2) & mask;
+    case ProbingMode::DoubleHashing:
+      return (hash + i * ((hash >> 29) | 1)) & mask;
+    case ProbingMode::Custom:
+    default:
+      return static_cast<size_t>(hash_function(key, static_cast<int>(i))) %
+             capacity;
+    }
   }
 
-  // 二次探查
-  int quadratic_probing(K key, int i) {
-    int c1 = 1, c2 = 3; // 常数
-    return (hash_function(key, 0) + c1 * i + c2 * i * i) % size;
+  size_t find_in(const SlotArray &slots, const K &key, size_t hash) const {
+    for (size_t i = 0; i < slots.size(); i++) {
+      size_t index = probe_index(key, hash, i, slots.size());
+      SlotMeta meta = slots.meta_at(index);
+      if (meta.status == EMPTY) {
+        return kNotFound;
+      }
+      if (meta.status == OCCUPIED && slots.entry_at(index).key == key) {
+        return index;
+      }
+      // Robin Hood不变式：若键存在，它经过的槽上的探查序号都不小于i
+      if (robin_hood && meta.probe < i) {
+        return kNotFound;
+      }
+    }
+    return kNotFound;
   }
 
-  // 双重散列
-  int double_hashing(K key, int i) {
-    int h1 = hash_function(key, 0);
-    int h2 = 1 + (key % (size - 1)); // 第二个散列函数
-    return (h1 + i * h2) % size;
+  // 插入（调用者保证键不在表中且表有空位）
+  void place(SlotArray &slots, Entry &&entry, size_t &tombstone_count) {
+    size_t hash = hash_of(entry.key);
+    for (size_t i = 0;; i++) {
+      size_t index = probe_index(entry.key, hash, i, slots.size());
+      SlotMeta meta = slots.meta_at(index);
+      if (meta.status == EMPTY) {
+        slots.construct(index, std::move(entry), static_cast<uint32_t>(i));
+        return;
+      }
+      if (meta.status == DELETED && (!robin_hood || meta.probe <= i)) {
+        // 占用墓碑：槽上的探查序号不减小，不变式保持
+        tombstone_count--;
+        slots.construct(index, std::move(entry), static_cast<uint32_t>(i));
+        return;
+      }
+      if (robin_hood && meta.status == OCCUPIED && meta.probe < i) {
+        // 劫富济贫：探查更短的元素让位，换它继续向后探查
+        std::swap(entry, slots.entry_at(index));
+        size_t displaced_probe = meta.probe;
+        slots.set_probe(index, static_cast<uint32_t>(i));
+        i = displaced_probe;
+        hash = hash_of(entry.key);
+      }
+    }
   }
 
-public:
-  OpenAddressingHashTable(int table_size, std::function<int(K, int)> hash_func)
-      : size(table_size), hash_function(hash_func) {
-    table.resize(size);
+  // 线性探查的删除：把后面可以前移的元素移入空洞（Knuth算法R），不留墓碑
+  void erase_linear(size_t index) {
+    size_t mask = table.size() - 1;
+    table.destroy(index, EMPTY);
+    size_t hole = index;
+    for (size_t next = (hole + 1) & mask, distance = 1;
+         table.meta_at(next).status == OCCUPIED;
+         next = (next + 1) & mask, distance++) {
+      uint32_t probe = table.meta_at(next).probe;
+      if (probe >= distance) {
+        table.construct(hole, std::move(table.entry_at(next)),
+                        static_cast<uint32_t>(probe - distance));
+        table.destroy(next, EMPTY);
+        hole = next;
+        distance = 0;
+      }
+    }
   }
 
-  // 插入操作
-  bool insert(K key, const V &value) {
-    for (int i = 0; i < size; i++) {
-      int index = hash_function(key, i);
+  // 把旧表最多kMigrationBatch个槽迁移到当前表
+  void migrate_step() {
+    if (old_table.empty()) {
+      return;
+    }
+    size_t end = std::min(old_table.size(), migrate_cursor + kMigrationBatch);
+    for (; migrate_cursor < end; migrate_cursor++) {
+      if (old_table.meta_at(migrate_cursor).status == OCCUPIED) {
+        place(table, std::move(old_table.entry_at(migrate_cursor)),
+              tombstones);
+        element_count++;
+        // 旧表仍可能被查找，迁走的槽留作墓碑
+        old_table.destroy(migrate_cursor, DELETED);
+        old_count--;
+      }
+      if (((migrate_cursor + 1) & kSegmentMask) == 0) {
+        old_table.release_entries_of(migrate_cursor);
+      }
+    }
+    if (migrate_cursor == old_table.size() || old_count == 0) {
+      old_table = SlotArray();
+      old_count = 0;
+    }
+  }
+
+  void finish_migration() {
+    while (!old_table.empty()) {
+      migrate_step();
+    }
+  }
 
-      if (table[index].status != OCCUPIED) {
-        table[index].key = key;
-        table[index].value = value;
-        table[index].status = OCCUPIED;
+  // 开始渐进式再散列：只分配新表，元素在之后的操作中逐步迁移
+  void start_resize() {
+    finish_migration();
+    size_t capacity = table.size();
+    if (element_count + 1 > max_load * capacity / 2) {
+      capacity *= 2; // 否则只是清理墓碑
+    }
+    old_table = std::move(table);
+    old_count = element_count;
+    migrate_cursor = 0;
+    table = SlotArray(capacity);
+    element_count = 0;
+    tombstones = 0;
+  }
+
+  static size_t round_up_capacity(size_t n) {
+    size_t capacity = 8;
+    while (capacity < n) {
+      capacity *= 2;
+    }
+    return capacity;
+  }
+
+  // 教材版本的插入：第一个非占用槽
+  bool insert_custom(K key, const V &value) {
+    for (size_t i = 0; i < table.size(); i++) {
+      size_t index = probe_index(key, 0, i, table.size());
+      if (table.meta_at(index).status != OCCUPIED) {
+        if (table.meta_at(index).status == DELETED) {
+          tombstones--;
+        }
+        table.construct(index, Entry{key, value}, static_cast<uint32_t>(i));
+        element_count++;
         return true;
       }
     }
-
     return false; // 表已满
   }
 
-  // 搜索操作
-  std::shared_ptr<V> search(K key) {
-    for (int i = 0; i < size; i++) {
-      int index = hash_function(key, i);
+public:
+  // 教材版本：用户提供h(k, i)，表大小固定，表满时insert返回false
+  OpenAddressingHashTable(int table_size, std::function<int(K, int)> hash_func)
+      : mode(ProbingMode::Custom), robin_hood(false), max_load(1.0),
+        hash_function(hash_func), table(table_size), element_count(0),
+        tombstones(0), old_count(0), migrate_cursor(0) {}
+
+  // 自动扩容版本：负载超过max_load_factor时容量翻倍，元素在之后的插入/删除中
+  // 每次迁移一小批，单次操作的代价有界；robin_hood控制是否启用Robin Hood置换
+  explicit OpenAddressingHashTable(
+      ProbingMode probing, size_t initial_capacity = 16,
+      double max_load_factor = 0.75,
+      std::function<size_t(const K &)> hash = std::hash<K>(),
+      bool use_robin_hood = true)
+      : mode(probing), robin_hood(use_robin_hood), max_load(max_load_factor),
+        key_hash(hash), table(round_up_capacity(initial_capacity)),
+        element_count(0), tombstones(0), old_count(0), migrate_cursor(0) {
+    if (probing == ProbingMode::Custom) {
+      throw std::invalid_argument(
+          "Custom probing requires a probe function and a fixed size");
+    }
+    if (!(max_load_factor > 0.0 && max_load_factor < 1.0)) {
+      throw std::invalid_argument("Max load factor must be in (0, 1)");
+    }
+  }
 
-      if (table[index].status == EMPTY) {
-        return nullptr; // 未找到
-      }
+  // 插入操作；键已存在时更新值
+  bool insert(K key, const V &value) {
+    if (mode == ProbingMode::Custom) {
+      return insert_custom(key, value);
+    }
 
-      if (table[index].status == OCCUPIED && table[index].key == key) {
-        return std::make_shared<V>(table[index].value);
+    migrate_step();
+    size_t hash = hash_of(key);
+    size_t index = find_in(table, key, hash);
+    if (index != kNotFound) {
+      table.entry_at(index).value = value;
+      return true;
+    }
+    if (!old_table.empty()) {
+      index = find_in(old_table, key, hash);
+      if (index != kNotFound) {
+        old_table.entry_at(index).value = value;
+        return true;
       }
     }
 
+    if (element_count + tombstones + 1 > max_load * table.size()) {
+      start_resize();
+      migrate_step();
+    }
+    place(table, Entry{key, value}, tombstones);
+    element_count++;
+    return true;
+  }
+
+  // 查找：返回表内值的指针，不存在时返回nullptr
+  V *find(const K &key) {
+    size_t hash = mode == ProbingMode::Custom ? 0 : hash_of(key);
+    size_t index = find_in(table, key, hash);
+    if (index != kNotFound) {
+      return &table.entry_at(index).value;
+    }
+    if (!old_table.empty()) {
+      index = find_in(old_table, key, hash);
+      if (index != kNotFound) {
+        return &old_table.entry_at(index).value;
+      }
+    }
     return nullptr;
   }
 
+  // 搜索操作
+  std::shared_ptr<V> search(K key) {
+    V *value = find(key);
+    return value ? std::make_shared<V>(*value) : nullptr;
+  }
+
   // 删除操作
   bool remove(K key) {
-    for (int i = 0; i < size; i++) {
-      int index = hash_function(key, i);
-
-      if (table[index].status == EMPTY) {
-        return false; // 未找到
+    migrate_step();
+    size_t hash = mode == ProbingMode::Custom ? 0 : hash_of(key);
+    size_t index = find_in(table, key, hash);
+    if (index != kNotFound) {
+      if (mode == ProbingMode::Linear) {
+        erase_linear(index);
+      } else {
+        table.destroy(index, DELETED);
+        tombstones++;
       }
-
-      if (table[index].status == OCCUPIED && table[index].key == key) {
-        table[index].status = DELETED;
+      element_count--;
+      return true;
+    }
+    if (!old_table.empty()) {
+      index = find_in(old_table, key, hash);
+      if (index != kNotFound) {
+        old_table.destroy(index, DELETED);
+        old_count--;
         return true;
       }
     }
-
     return false;
   }
 
+  size_t size() const { return element_count + old_count; }
+  size_t capacity() const { return table.size(); }
+  bool is_rehashing() const { return !old_table.empty(); }
+
   // 获取负载因子
   double load_factor() {
-    int count = 0;
-    for (int i = 0; i < size; i++) {
-      if (table[i].status == OCCUPIED) {
-        count++;
+    return table.size() == 0 ? 0.0
+                             : static_cast<double>(size()) / table.size();
+  }
+
+  // 当前表中元素探查长度的均值、方差与最大值
+  ProbeStats probe_stats() const {
+    ProbeStats stats;
+    if (element_count == 0) {
+      return stats;
+    }
+    double sum = 0.0, sum_squares = 0.0;
+    for (size_t i = 0; i < table.size(); i++) {
+      if (table.meta_at(i).status == OCCUPIED) {
+        size_t probe = table.meta_at(i).probe;
+        sum += probe;
+        sum_squares += static_cast<double>(probe) * probe;
+        stats.max = std::max(stats.max, probe);
       }
     }
-    return static_cast<double>(count) / size;
+    stats.mean = sum / element_count;
+    stats.variance = sum_squares / element_count - stats.mean * stats.mean;
+    return stats;
   }
 
   // 打印散列表
   void print() {
     std::cout << "开放寻址法散列表:" << std::endl;
-    for (int i = 0; i < size; i++) {
+    for (size_t i = 0; i < table.size(); i++) {
       std::cout << "槽 " << i << ": ";
-      if (table[i].status == OCCUPIED) {
-        std::cout << "(" << table[i].key << ", " << table[i].value << ")";
-      } else if (table[i].status == DELETED) {
+      if (table.meta_at(i).status == OCCUPIED) {
+        std::cout << "(" << table.entry_at(i).key << ", "
+                  << table.entry_at(i).value << ")";
+      } else if (table.meta_at(i).status == DELETED) {
         std::cout << "[DELETED]";
       } else {
         std::cout << "[EMPTY]";
       }
       std::cout << std::endl;
     }
+    if (is_rehashing()) {
+      std::cout << "（再散列中，旧表剩余 " << old_count << " 个元素）"
+                << std::endl;
+    }
     std::cout << "负载因子: " << load_factor() << std::endl;
   }
 };
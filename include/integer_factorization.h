@@ -0,0 +1,194 @@
+#ifndef INTEGER_FACTORIZATION_H
+#define INTEGER_FACTORIZATION_H
+
+#include "number_theory_algorithms.h"
+#include "primality.h"
+#include "work_stealing_scheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace algorithms {
+
+/**
+ * @brief Pollard rho 整数分解（Brent改进）- 算法导论第31.9节
+ *
+ * 对 64 位整数：
+ * - 迭代 x ← x² + c 在Montgomery形式下进行（Montgomery64，__int128乘积），
+ *   每步只有一次Montgomery乘法和一次加法
+ * - Brent的环检测：x 固定在 2 的幂位置，y 向前走 r 步，比 Floyd 少
+ *   约四分之一的迭代
+ * - 批量gcd：把 kBatch 个 |x - y| 累乘到 q 上再做一次 gcd(q, n)；
+ *   若累乘撞到 n 的倍数（gcd = n），从这一批的起点逐步回退
+ * - factorize 先去掉2和1024以内的小因子，余下部分用确定性Miller–Rabin
+ *   判断素数，合数递归分裂
+ * - find_factor_parallel 用不同的 c 同时跑多条序列，先找到因子的一条让其余的停下；
+ *   factorize_all 把一批数按块分给工作窃取调度器
+ */
+class PollardRho {
+public:
+  static constexpr uint64_t kBatch = 128; // 每次 gcd 之前累乘的差值个数
+
+  /**
+   * @brief 以 f(x) = x² + c、起点 x0 运行Brent算法
+   * @param n 奇合数
+   * @param stop 非空且被置位时提前返回 n
+   * @return n 的一个因子；这条序列失败（退化成 n）时返回 n
+   */
+  static uint64_t brent(uint64_t n, uint64_t c, uint64_t x0 = 2,
+                        const std::atomic<bool> *stop = nullptr) {
+    const Montgomery64 mont(n);
+    c %= n;
+    auto f = [&](uint64_t y) {
+      uint64_t square = mont.multiply(y, y);
+      uint64_t sum = square + c;
+      return sum < square || sum >= n ? sum - n : sum;
+    };
+    uint64_t y = x0 % n, x = y, ys = y, q = mont.one, g = 1;
+    for (uint64_t r = 1; g == 1; r <<= 1) {
+      x = y;
+      for (uint64_t i = 0; i < r; i++) {
+        y = f(y);
+      }
+      for (uint64_t k = 0; k < r && g == 1; k += kBatch) {
+        if (stop && stop->load(std::memory_order_relaxed))
+          return n;
+        ys = y;
+        uint64_t steps = std::min(kBatch, r - k);
+        for (uint64_t i = 0; i < steps; i++) {
+          y = f(y);
+          q = mont.multiply(q, x > y ? x - y : y - x);
+        }
+        g = NumberTheoryAlgorithms::binary_gcd(q, n);
+      }
+    }
+    if (g == n) {
+      // 这一批里累乘到了 0：从批的起点逐步重走，找第一个非平凡的 gcd
+      do {
+        ys = f(ys);
+        g = NumberTheoryAlgorithms::binary_gcd(x > ys ? x - ys : ys - x, n);
+      } while (g == 1);
+    }
+    return g;
+  }
+
+  /**
+   * @brief 奇合数 n 的一个非平凡因子，依次尝试 c = 1, 2, ...
+   */
+  static uint64_t find_factor(uint64_t n) {
+    check_odd_composite(n);
+    for (uint64_t c = 1;; c++) {
+      uint64_t g = brent(n, c);
+      if (g != n)
+        return g;
+    }
+  }
+
+  /**
+   * @brief 多种子并行：第 i 个线程尝试 c ≡ i+1 (mod num_threads)
+   */
+  static uint64_t find_factor_parallel(
+      uint64_t n, size_t num_threads = std::thread::hardware_concurrency()) {
+    check_odd_composite(n);
+    if (num_threads <= 1)
+      return find_factor(n);
+    std::atomic<bool> found(false);
+    std::atomic<uint64_t> factor(n);
+    WorkStealingScheduler scheduler(num_threads);
+    scheduler.parallel_for(0, num_threads, 1, [&](size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; i++) {
+        for (uint64_t c = i + 1; !found.load(std::memory_order_relaxed);
+             c += num_threads) {
+          uint64_t g = brent(n, c, 2, &found);
+          if (g != n) {
+            if (!found.exchange(true))
+              factor.store(g);
+            break;
+          }
+        }
+      }
+    });
+    return factor.load();
+  }
+
+  /**
+   * @brief 素因子分解
+   * @return 按升序排列的素因子（含重数）；n = 1 时为空
+   */
+  static std::vector<uint64_t> factorize(uint64_t n) {
+    if (n == 0) {
+      throw std::invalid_argument("PollardRho: cannot factorize 0");
+    }
+    std::vector<uint64_t> factors;
+    int twos = __builtin_ctzll(n);
+    factors.insert(factors.end(), twos, 2);
+    n >>= twos;
+    for (uint64_t p : trial_primes()) {
+      if (p * p > n)
+        break;
+      while (n % p == 0) {
+        factors.push_back(p);
+        n /= p;
+      }
+    }
+    if (n > 1)
+      split(n, factors);
+    std::sort(factors.begin(), factors.end());
+    return factors;
+  }
+
+  /**
+   * @brief 批量分解：result[i] = factorize(numbers[i])
+   */
+  static std::vector<std::vector<uint64_t>>
+  factorize_all(const std::vector<uint64_t> &numbers,
+                size_t num_threads = std::thread::hardware_concurrency()) {
+    std::vector<std::vector<uint64_t>> result(numbers.size());
+    auto body = [&](size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; i++) {
+        result[i] = factorize(numbers[i]);
+      }
+    };
+    if (num_threads <= 1) {
+      body(0, numbers.size());
+    } else {
+      WorkStealingScheduler scheduler(num_threads);
+      scheduler.parallel_for(0, numbers.size(), 64, body);
+    }
+    return result;
+  }
+
+private:
+  static constexpr uint64_t kTrialLimit = 1024;
+
+  static const std::vector<uint64_t> &trial_primes() {
+    static const std::vector<uint64_t> primes =
+        SegmentedSieve::primes(3, kTrialLimit);
+    return primes;
+  }
+
+  static void check_odd_composite(uint64_t n) {
+    if (n < 9 || n % 2 == 0 || MillerRabin::is_prime(n)) {
+      throw std::invalid_argument("PollardRho: n must be an odd composite");
+    }
+  }
+
+  // n 没有小于 kTrialLimit 的因子
+  static void split(uint64_t n, std::vector<uint64_t> &factors) {
+    if (n < kTrialLimit * kTrialLimit || MillerRabin::is_prime(n)) {
+      factors.push_back(n);
+      return;
+    }
+    uint64_t d = find_factor(n);
+    split(d, factors);
+    split(n / d, factors);
+  }
+};
+
+} // namespace algorithms
+
+#endif // INTEGER_FACTORIZATION_H
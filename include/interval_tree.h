@@ -1,12 +1,17 @@
 #ifndef INTERVAL_TREE_H
 #define INTERVAL_TREE_H
 
-#include "red_black_tree.h"
+#include "intrusive_rb_tree.h"
+#include "iterator_range.h"
+#include "work_stealing_scheduler.h"
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <limits>
-#include <memory>
 #include <queue>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace algorithms {
@@ -44,496 +49,339 @@ struct Interval {
   }
 };
 
-// 区间树节点
-template <typename T> class IntervalTreeNode : public RBNode<T> {
-public:
+// 区间树节点载荷
+struct IntervalEntry {
   Interval interval;
-  T max; // 以该节点为根的子树中所有区间的最大端点值
-
-  IntervalTreeNode(const Interval &i, Color c = Color::RED)
-      : RBNode<T>(i.low, c), interval(i), max(i.high) {}
-
-  // 更新max值
-  void update_max() {
-    this->max = interval.high;
-    if (this->left != nullptr) {
-      auto left_node =
-          std::static_pointer_cast<IntervalTreeNode<T>>(this->left);
-      this->max = std::max(this->max, left_node->max);
-    }
-    if (this->right != nullptr) {
-      auto right_node =
-          std::static_pointer_cast<IntervalTreeNode<T>>(this->right);
-      this->max = std::max(this->max, right_node->max);
-    }
-  }
 };
 
-// 区间树
-template <typename T> class IntervalTree {
-private:
-  std::shared_ptr<IntervalTreeNode<T>> root;
-  std::shared_ptr<IntervalTreeNode<T>> nil;
-
-  // 创建NIL节点
-  std::shared_ptr<IntervalTreeNode<T>> create_nil() {
-    auto node = std::make_shared<IntervalTreeNode<T>>(Interval(), Color::BLACK);
-    node->max = std::numeric_limits<T>::min();
-    node->left = nullptr;
-    node->right = nullptr;
-    return node;
-  }
-
-  // 左旋（重写以更新max值）
-  void left_rotate(std::shared_ptr<IntervalTreeNode<T>> x) {
-    if (x == nullptr || x->right == nil)
-      return;
-
-    auto y = std::static_pointer_cast<IntervalTreeNode<T>>(x->right);
-    x->right = y->left;
+// 区间树的增强策略：max 为以该节点为根的子树中所有区间的最大端点值
+template <typename T> struct IntervalMaxEndpoint {
+  struct Storage {
+    T max;
+  };
 
-    if (y->left != nil) {
-      y->left->parent = x;
-    }
+  static void init_nil(Storage &s) { s.max = std::numeric_limits<T>::lowest(); }
 
-    y->parent = x->parent;
-
-    if (x->parent == nil) {
-      root = y;
-    } else if (x == x->parent->left) {
-      x->parent->left = y;
-    } else {
-      x->parent->right = y;
-    }
-
-    y->left = x;
-    x->parent = y;
-
-    // 更新max值
-    x->update_max();
-    y->update_max();
+  template <typename Node>
+  static void pull(Node &x, const Node &left, const Node &right) {
+    x.max = std::max({static_cast<T>(x.interval.high), left.max, right.max});
   }
+};
 
-  // 右旋（重写以更新max值）
-  void right_rotate(std::shared_ptr<IntervalTreeNode<T>> y) {
-    if (y == nullptr || y->left == nil)
-      return;
-
-    auto x = std::static_pointer_cast<IntervalTreeNode<T>>(y->left);
-    y->left = x->right;
+// 区间树节点：interval 来自载荷，max 来自增强策略
+template <typename T>
+using IntervalTreeNode =
+    typename IntrusiveRBTree<IntervalEntry, IntervalMaxEndpoint<T>>::Node;
 
-    if (x->right != nil) {
-      x->right->parent = y;
-    }
+// 区间树（CLRS 14.3 节），基于侵入式红黑树核心
+template <typename T> class IntervalTree {
+private:
+  using Core = IntrusiveRBTree<IntervalEntry, IntervalMaxEndpoint<T>>;
+  using index_type = typename Core::index_type;
+  static constexpr index_type nil = Core::kNil;
 
-    x->parent = y->parent;
+  Core tree;
 
-    if (y->parent == nil) {
-      root = x;
-    } else if (y == y->parent->right) {
-      y->parent->right = x;
-    } else {
-      y->parent->left = x;
+  // 中序遍历辅助函数
+  void inorder_helper(index_type node, std::vector<Interval> &result) const {
+    if (node != nil) {
+      inorder_helper(tree.left(node), result);
+      result.push_back(tree.node(node).interval);
+      inorder_helper(tree.right(node), result);
     }
-
-    x->right = y;
-    y->parent = x;
-
-    // 更新max值
-    y->update_max();
-    x->update_max();
   }
 
-  // 插入修复（重写以更新max值）
-  void insert_fixup(std::shared_ptr<IntervalTreeNode<T>> z) {
-    while (z->parent != nil && z->parent->color == Color::RED) {
-      if (z->parent == z->parent->parent->left) {
-        auto y = std::static_pointer_cast<IntervalTreeNode<T>>(
-            z->parent->parent->right);
-
-        if (y != nil && y->color == Color::RED) {
-          z->parent->color = Color::BLACK;
-          y->color = Color::BLACK;
-          z->parent->parent->color = Color::RED;
-          z = std::static_pointer_cast<IntervalTreeNode<T>>(z->parent->parent);
-        } else {
-          if (z == z->parent->right) {
-            z = std::static_pointer_cast<IntervalTreeNode<T>>(z->parent);
-            left_rotate(z);
-          }
-          z->parent->color = Color::BLACK;
-          z->parent->parent->color = Color::RED;
-          right_rotate(
-              std::static_pointer_cast<IntervalTreeNode<T>>(z->parent->parent));
-        }
+  // 精确查找区间所在的节点下标
+  // 旋转后 low 相同的区间可能分布在两侧子树，遇到相同 low 时两侧都要查找
+  index_type find_index(index_type x, const Interval &interval) const {
+    while (x != nil) {
+      const auto &n = tree.node(x);
+      if (n.interval == interval) {
+        return x;
+      }
+      if (interval.low < n.interval.low) {
+        x = n.left;
+      } else if (n.interval.low < interval.low) {
+        x = n.right;
       } else {
-        auto y = std::static_pointer_cast<IntervalTreeNode<T>>(
-            z->parent->parent->left);
-
-        if (y != nil && y->color == Color::RED) {
-          z->parent->color = Color::BLACK;
-          y->color = Color::BLACK;
-          z->parent->parent->color = Color::RED;
-          z = std::static_pointer_cast<IntervalTreeNode<T>>(z->parent->parent);
-        } else {
-          if (z == z->parent->left) {
-            z = std::static_pointer_cast<IntervalTreeNode<T>>(z->parent);
-            right_rotate(z);
-          }
-          z->parent->color = Color::BLACK;
-          z->parent->parent->color = Color::RED;
-          left_rotate(
-              std::static_pointer_cast<IntervalTreeNode<T>>(z->parent->parent));
+        index_type found = find_index(n.left, interval);
+        if (found != nil) {
+          return found;
         }
+        x = n.right;
       }
     }
-    root->color = Color::BLACK;
+    return nil;
   }
 
-  // 移植操作（重写以更新max值）
-  void transplant(std::shared_ptr<IntervalTreeNode<T>> u,
-                  std::shared_ptr<IntervalTreeNode<T>> v) {
-    if (u->parent == nil) {
-      root = v;
-    } else if (u == u->parent->left) {
-      u->parent->left = v;
-    } else {
-      u->parent->right = v;
-    }
-    v->parent = u->parent;
+  // 验证max值正确性的辅助函数
+  bool validate_max_values(index_type node) const {
+    if (node == nil)
+      return true;
 
-    // 更新max值
-    auto current = v;
-    while (current != nil) {
-      current->update_max();
-      current = std::static_pointer_cast<IntervalTreeNode<T>>(current->parent);
+    const auto &n = tree.node(node);
+    T expected_max = n.interval.high;
+    if (n.left != nil) {
+      expected_max = std::max(expected_max, tree.node(n.left).max);
     }
-  }
-
-  // 查找最小节点
-  std::shared_ptr<IntervalTreeNode<T>>
-  minimum(std::shared_ptr<IntervalTreeNode<T>> node) const {
-    while (node != nil && node->left != nil) {
-      node = std::static_pointer_cast<IntervalTreeNode<T>>(node->left);
+    if (n.right != nil) {
+      expected_max = std::max(expected_max, tree.node(n.right).max);
+    }
+    if (n.max != expected_max) {
+      return false;
     }
-    return node;
-  }
-
-  // 删除修复（重写以更新max值）
-  void delete_fixup(std::shared_ptr<IntervalTreeNode<T>> x) {
-    while (x != root && x->color == Color::BLACK) {
-      if (x == x->parent->left) {
-        auto w =
-            std::static_pointer_cast<IntervalTreeNode<T>>(x->parent->right);
-
-        if (w->color == Color::RED) {
-          w->color = Color::BLACK;
-          x->parent->color = Color::RED;
-          left_rotate(std::static_pointer_cast<IntervalTreeNode<T>>(x->parent));
-          w = std::static_pointer_cast<IntervalTreeNode<T>>(x->parent->right);
-        }
 
-        if (w->left->color == Color::BLACK && w->right->color == Color::BLACK) {
-          w->color = Color::RED;
-          x = std::static_pointer_cast<IntervalTreeNode<T>>(x->parent);
-        } else {
-          if (w->right->color == Color::BLACK) {
-            w->left->color = Color::BLACK;
-            w->color = Color::RED;
-            right_rotate(w);
-            w = std::static_pointer_cast<IntervalTreeNode<T>>(x->parent->right);
-          }
-          w->color = x->parent->color;
-          x->parent->color = Color::BLACK;
-          w->right->color = Color::BLACK;
-          left_rotate(std::static_pointer_cast<IntervalTreeNode<T>>(x->parent));
-          x = root;
-        }
-      } else {
-        auto w = std::static_pointer_cast<IntervalTreeNode<T>>(x->parent->left);
-
-        if (w->color == Color::RED) {
-          w->color = Color::BLACK;
-          x->parent->color = Color::RED;
-          right_rotate(
-              std::static_pointer_cast<IntervalTreeNode<T>>(x->parent));
-          w = std::static_pointer_cast<IntervalTreeNode<T>>(x->parent->left);
-        }
+    return validate_max_values(n.left) && validate_max_values(n.right);
+  }
 
-        if (w->right->color == Color::BLACK && w->left->color == Color::BLACK) {
-          w->color = Color::RED;
-          x = std::static_pointer_cast<IntervalTreeNode<T>>(x->parent);
-        } else {
-          if (w->left->color == Color::BLACK) {
-            w->right->color = Color::BLACK;
-            w->color = Color::RED;
-            left_rotate(w);
-            w = std::static_pointer_cast<IntervalTreeNode<T>>(x->parent->left);
-          }
-          w->color = x->parent->color;
-          x->parent->color = Color::BLACK;
-          w->left->color = Color::BLACK;
-          right_rotate(
-              std::static_pointer_cast<IntervalTreeNode<T>>(x->parent));
-          x = root;
-        }
+  // 输出敏感的重叠枚举：子树 max < low 时整棵剪掉，节点 low > high 时
+  // 它和它的右子树都不可能重叠；结果按 low 升序给出
+  template <typename F>
+  void overlap_helper(index_type x, const Interval &query, F &visit) const {
+    while (x != nil) {
+      const auto &n = tree.node(x);
+      if (n.max < query.low) {
+        return;
+      }
+      overlap_helper(n.left, query, visit);
+      if (n.interval.low > query.high) {
+        return;
       }
+      if (n.interval.overlaps_with(query)) {
+        visit(n.interval);
+      }
+      x = n.right;
     }
-    x->color = Color::BLACK;
   }
 
-  // 区间搜索辅助函数
-  std::shared_ptr<IntervalTreeNode<T>>
-  interval_search_helper(std::shared_ptr<IntervalTreeNode<T>> node,
-                         const Interval &interval) const {
-
-    if (node == nil)
-      return nullptr;
-
-    // 如果当前节点的区间与查询区间重叠，返回当前节点
-    if (node->interval.overlaps_with(interval)) {
-      return node;
+  // 批量查询：整批查询一起自顶向下下推，每个节点至多访问一次。
+  // buffers[depth] 保存到达该深度节点的查询编号（按 low 升序）
+  void batch_helper(index_type x, std::size_t depth,
+                    const std::vector<Interval> &queries,
+                    std::vector<std::vector<std::uint32_t>> &buffers,
+                    std::vector<std::vector<Interval>> &results) const {
+    const auto &n = tree.node(x);
+    if (buffers.size() <= depth + 1) {
+      buffers.resize(depth + 2);
     }
 
-    // 检查左子树
-    if (node->left != nil) {
-      auto left_node =
-          std::static_pointer_cast<IntervalTreeNode<T>>(node->left);
-      if (left_node->max >= interval.low) {
-        auto result = interval_search_helper(left_node, interval);
-        if (result != nullptr)
-          return result;
+    for (std::uint32_t q : buffers[depth]) {
+      if (n.interval.overlaps_with(queries[q])) {
+        results[q].push_back(n.interval);
       }
     }
 
-    // 检查右子树
-    if (node->right != nil) {
-      auto right_node =
-          std::static_pointer_cast<IntervalTreeNode<T>>(node->right);
-      return interval_search_helper(right_node, interval);
+    if (n.left != nil) {
+      std::vector<std::uint32_t> &next = buffers[depth + 1];
+      next.clear();
+      T left_max = tree.node(n.left).max;
+      for (std::uint32_t q : buffers[depth]) {
+        if (queries[q].low > left_max) {
+          break; // 查询按 low 升序，之后的都无法到达左子树
+        }
+        next.push_back(q);
+      }
+      if (!next.empty()) {
+        batch_helper(n.left, depth + 1, queries, buffers, results);
+      }
     }
 
-    return nullptr;
-  }
-
-  // 中序遍历辅助函数
-  void inorder_helper(std::shared_ptr<IntervalTreeNode<T>> node,
-                      std::vector<Interval> &result) const {
-    if (node != nil) {
-      inorder_helper(std::static_pointer_cast<IntervalTreeNode<T>>(node->left),
-                     result);
-      result.push_back(node->interval);
-      inorder_helper(std::static_pointer_cast<IntervalTreeNode<T>>(node->right),
-                     result);
+    if (n.right != nil) {
+      std::vector<std::uint32_t> &next = buffers[depth + 1];
+      next.clear();
+      T right_max = tree.node(n.right).max;
+      for (std::uint32_t q : buffers[depth]) {
+        if (queries[q].high >= n.interval.low && queries[q].low <= right_max) {
+          next.push_back(q);
+        }
+      }
+      if (!next.empty()) {
+        batch_helper(n.right, depth + 1, queries, buffers, results);
+      }
     }
   }
 
 public:
-  IntervalTree() {
-    nil = create_nil();
-    root = nil;
-  }
+  IntervalTree() = default;
 
   // 判断树是否为空
-  bool empty() const { return root == nil; }
-
-  // 插入区间
-  void insert(const Interval &interval) {
-    auto z = std::make_shared<IntervalTreeNode<T>>(interval);
-    z->left = nil;
-    z->right = nil;
-    z->color = Color::RED;
+  bool empty() const { return tree.empty(); }
 
-    auto y = nil;
-    auto x = root;
+  // 区间个数
+  std::size_t size() const { return tree.size(); }
 
-    // 找到插入位置（按low排序）
-    while (x != nil) {
-      y = x;
-      if (z->interval.low < x->interval.low) {
-        x = std::static_pointer_cast<IntervalTreeNode<T>>(x->left);
-      } else {
-        x = std::static_pointer_cast<IntervalTreeNode<T>>(x->right);
-      }
-    }
+  // 预留节点池容量
+  void reserve(std::size_t n) { tree.reserve(n); }
 
-    z->parent = y;
+  // 插入区间（按low排序）
+  void insert(const Interval &interval) {
+    tree.insert(IntervalEntry{interval},
+                [](const IntervalEntry &a, const IntervalEntry &b) {
+                  return a.interval.low < b.interval.low;
+                });
+  }
 
-    if (y == nil) {
-      root = z;
-    } else if (z->interval.low < y->interval.low) {
-      y->left = z;
-    } else {
-      y->right = z;
+  // 区间搜索：查找与给定区间重叠的区间（CLRS INTERVAL-SEARCH）
+  const IntervalTreeNode<T> *interval_search(const Interval &interval) const {
+    index_type x = tree.root();
+    while (x != nil && !tree.node(x).interval.overlaps_with(interval)) {
+      index_type l = tree.left(x);
+      // 左子树的最大端点不小于 low 时，若左子树中没有重叠区间则右子树也没有
+      x = (l != nil && tree.node(l).max >= interval.low) ? l : tree.right(x);
     }
+    return (x != nil) ? &tree.node(x) : nullptr;
+  }
 
-    // 更新max值
-    auto current = z;
-    while (current != nil) {
-      current->update_max();
-      current = std::static_pointer_cast<IntervalTreeNode<T>>(current->parent);
-    }
+  // 对每个与 query 重叠的区间调用 visit(const Interval &)，按 low 升序，
+  // 不分配内存；耗时 O(min(n, k log n))，k 为结果个数
+  template <typename F>
+  void for_each_overlap(const Interval &query, F visit) const {
+    overlap_helper(tree.root(), query, visit);
+  }
+
+  // 返回所有与 query 重叠的区间
+  std::vector<Interval> all_overlaps(const Interval &query) const {
+    std::vector<Interval> result;
+    for_each_overlap(query,
+                     [&result](const Interval &i) { result.push_back(i); });
+    return result;
+  }
 
-    insert_fixup(z);
+  // 点刺探（stabbing）：返回所有包含 point 的区间
+  std::vector<Interval> stab(int point) const {
+    return all_overlaps(Interval(point, point));
   }
 
-  // 区间搜索：查找与给定区间重叠的区间
-  std::shared_ptr<IntervalTreeNode<T>>
-  interval_search(const Interval &interval) const {
-    return interval_search_helper(root, interval);
+  // 批量查询：先按 low 排序查询，再让整批查询一次性自顶向下扫过树，
+  // 每个节点最多访问一次；第 i 个结果对应 queries[i]，
+  // 结果内部按节点的访问顺序给出，不保证按 low 排序
+  std::vector<std::vector<Interval>>
+  batch_overlaps(const std::vector<Interval> &queries) const {
+    std::vector<std::vector<Interval>> results(queries.size());
+    if (tree.root() == nil || queries.empty()) {
+      return results;
+    }
+
+    std::vector<std::vector<std::uint32_t>> buffers(1);
+    std::vector<std::uint32_t> &order = buffers[0];
+    order.resize(queries.size());
+    for (std::size_t i = 0; i < queries.size(); i++) {
+      order[i] = static_cast<std::uint32_t>(i);
+    }
+    std::sort(order.begin(), order.end(),
+              [&queries](std::uint32_t a, std::uint32_t b) {
+                return queries[a].low < queries[b].low;
+              });
+    // 根的 max 之上的查询不可能命中
+    T root_max = tree.node(tree.root()).max;
+    while (!order.empty() && queries[order.back()].low > root_max) {
+      order.pop_back();
+    }
+    if (!order.empty()) {
+      batch_helper(tree.root(), 0, queries, buffers, results);
+    }
+    return results;
   }
 
   // 精确搜索：查找完全匹配的区间
-  std::shared_ptr<IntervalTreeNode<T>> search(const Interval &interval) const {
-    auto x = root;
-    while (x != nil && !(x->interval == interval)) {
-      if (interval.low < x->interval.low) {
-        x = std::static_pointer_cast<IntervalTreeNode<T>>(x->left);
-      } else {
-        x = std::static_pointer_cast<IntervalTreeNode<T>>(x->right);
-      }
-    }
-    return (x != nil) ? x : nullptr;
+  const IntervalTreeNode<T> *search(const Interval &interval) const {
+    index_type x = find_index(tree.root(), interval);
+    return (x != nil) ? &tree.node(x) : nullptr;
   }
 
   // 删除区间
   bool remove(const Interval &interval) {
-    auto z = search(interval);
-    if (z == nullptr) {
+    index_type z = find_index(tree.root(), interval);
+    if (z == nil) {
       return false; // 区间不存在
     }
-
-    auto y = z;
-    auto y_original_color = y->color;
-    std::shared_ptr<IntervalTreeNode<T>> x;
-
-    if (z->left == nil) {
-      x = std::static_pointer_cast<IntervalTreeNode<T>>(z->right);
-      transplant(z, x);
-    } else if (z->right == nil) {
-      x = std::static_pointer_cast<IntervalTreeNode<T>>(z->left);
-      transplant(z, x);
-    } else {
-      y = minimum(std::static_pointer_cast<IntervalTreeNode<T>>(z->right));
-      y_original_color = y->color;
-      x = std::static_pointer_cast<IntervalTreeNode<T>>(y->right);
-
-      if (y->parent == z) {
-        x->parent = y;
-      } else {
-        transplant(y, x);
-        y->right = z->right;
-        y->right->parent = y;
-      }
-
-      transplant(z, y);
-      y->left = z->left;
-      y->left->parent = y;
-      y->color = z->color;
-    }
-
-    if (y_original_color == Color::BLACK) {
-      delete_fixup(x);
-    }
-
+    tree.erase(z);
     return true;
   }
 
   // 获取最小区间（按low）
   Interval minimum() const {
-    auto min_node = minimum(root);
-    if (min_node == nil) {
+    index_type x = tree.minimum(tree.root());
+    if (x == nil) {
       throw std::runtime_error("Tree is empty");
     }
-    return min_node->interval;
+    return tree.node(x).interval;
   }
 
   // 获取最大区间（按low）
   Interval maximum() const {
-    auto x = root;
-    while (x != nil && x->right != nil) {
-      x = std::static_pointer_cast<IntervalTreeNode<T>>(x->right);
-    }
+    index_type x = tree.maximum(tree.root());
     if (x == nil) {
       throw std::runtime_error("Tree is empty");
     }
-    return x->interval;
+    return tree.node(x).interval;
   }
 
-  // 中序遍历（按low排序）
-  std::vector<Interval> inorder_traversal() const {
-    std::vector<Interval> result;
-    inorder_helper(root, result);
-    return result;
-  }
+  // 中序双向迭代器（只读），按 low 的升序访问区间
+  using const_iterator =
+      typename Core::template member_iterator<&IntervalEntry::interval>;
+  using iterator = const_iterator;
 
-  // 验证区间树性质
-  bool is_valid() const {
-    if (root == nil)
-      return true;
-
-    // 验证红黑树性质
-    if (root->color != Color::BLACK) {
-      return false;
-    }
-
-    // 验证max值正确性
-    return validate_max_values(root);
+  const_iterator begin() const {
+    return tree.template iterator_at<&IntervalEntry::interval>(
+        tree.minimum(tree.root()));
   }
 
-  // 验证max值正确性的辅助函数
-  bool validate_max_values(std::shared_ptr<IntervalTreeNode<T>> node) const {
-    if (node == nil)
-      return true;
-
-    T expected_max = node->interval.high;
+  const_iterator end() const {
+    return tree.template iterator_at<&IntervalEntry::interval>(nil);
+  }
 
-    if (node->left != nil) {
-      auto left_node =
-          std::static_pointer_cast<IntervalTreeNode<T>>(node->left);
-      expected_max = std::max(expected_max, left_node->max);
-    }
+  // low 落在 [lo, hi) 内的区间组成的惰性视图
+  IteratorRange<const_iterator> range(int lo, int hi) const {
+    auto at = [this](int bound) {
+      return tree.template iterator_at<&IntervalEntry::interval>(
+          tree.partition_point([bound](const IntervalEntry &e) {
+            return e.interval.low < bound;
+          }));
+    };
+    const_iterator first = at(lo);
+    return IteratorRange<const_iterator>(first, lo < hi ? at(hi) : first);
+  }
 
-    if (node->right != nil) {
-      auto right_node =
-          std::static_pointer_cast<IntervalTreeNode<T>>(node->right);
-      expected_max = std::max(expected_max, right_node->max);
-    }
+  // 中序遍历（按low排序）
+  std::vector<Interval> inorder_traversal() const {
+    std::vector<Interval> result;
+    result.reserve(tree.size());
+    inorder_helper(tree.root(), result);
+    return result;
+  }
 
-    if (node->max != expected_max) {
-      return false;
-    }
+  // 验证区间树性质：红黑树性质与max值
+  bool is_valid() const { return tree.is_valid() && validate_max_values(); }
 
-    return validate_max_values(
-               std::static_pointer_cast<IntervalTreeNode<T>>(node->left)) &&
-           validate_max_values(
-               std::static_pointer_cast<IntervalTreeNode<T>>(node->right));
-  }
+  // 验证max值正确性
+  bool validate_max_values() const { return validate_max_values(tree.root()); }
 
   // 打印树结构（用于调试）
   void print_tree() const {
-    if (root == nil) {
+    if (tree.root() == nil) {
       std::cout << "Empty tree" << std::endl;
       return;
     }
 
-    std::queue<std::shared_ptr<IntervalTreeNode<T>>> q;
-    q.push(root);
+    std::queue<index_type> q;
+    q.push(tree.root());
 
     while (!q.empty()) {
       int level_size = q.size();
 
       for (int i = 0; i < level_size; i++) {
-        auto current = q.front();
+        index_type current = q.front();
         q.pop();
 
         if (current == nil) {
           std::cout << "NIL ";
         } else {
-          std::cout << current->interval << "(max:" << current->max << ","
-                    << (current->color == Color::RED ? "R" : "B") << ") ";
-          q.push(std::static_pointer_cast<IntervalTreeNode<T>>(current->left));
-          q.push(std::static_pointer_cast<IntervalTreeNode<T>>(current->right));
+          const auto &n = tree.node(current);
+          std::cout << n.interval << "(max:" << n.max << ","
+                    << (n.is_red() ? "R" : "B") << ") ";
+          q.push(n.left);
+          q.push(n.right);
         }
       }
       std::cout << std::endl;
@@ -541,7 +389,169 @@ public:
   }
 
   // 清空树
-  void clear() { root = nil; }
+  void clear() { tree.clear(); }
+};
+
+// 静态区间树（增强有序数组）
+//
+// 面向只读为主、规模很大的区间集合（如基因组区间）：
+//   - 区间按 low 排序后存放在连续数组中，数组本身就是中点二分的隐式
+//     平衡二叉树的中序布局，没有任何指针；
+//   - max_high[m] 是以 m 为根的隐式子树（数组区间）中最大的 high；
+//   - 查询与 IntervalTree 相同地按 max/low 剪枝，子树足够小时
+//     直接线性扫描，以顺序访存代替分支；
+//   - 建树为一次排序 O(n log n) 加一次 O(n) 的自底向上增强。
+// 区间为闭区间 [low, high]，与 Interval 相同；id 为区间在输入中的下标。
+template <typename T = int> class StaticIntervalTree {
+public:
+  struct Entry {
+    T low;
+    T high;
+    std::uint32_t id;
+  };
+
+private:
+  // 小于该长度的子数组直接线性扫描
+  static constexpr std::size_t kScanThreshold = 16;
+
+  std::vector<Entry> entries;
+  std::vector<T> max_high;
+
+  T build_max(std::size_t lo, std::size_t hi) {
+    std::size_t mid = lo + (hi - lo) / 2;
+    T m = entries[mid].high;
+    if (lo < mid) {
+      m = std::max(m, build_max(lo, mid));
+    }
+    if (mid + 1 < hi) {
+      m = std::max(m, build_max(mid + 1, hi));
+    }
+    max_high[mid] = m;
+    return m;
+  }
+
+  template <typename F>
+  void query_range(std::size_t lo, std::size_t hi, T qlo, T qhi,
+                   F &visit) const {
+    while (lo < hi) {
+      if (hi - lo <= kScanThreshold) {
+        for (std::size_t i = lo; i < hi && entries[i].low <= qhi; i++) {
+          if (entries[i].high >= qlo) {
+            visit(entries[i]);
+          }
+        }
+        return;
+      }
+      std::size_t mid = lo + (hi - lo) / 2;
+      if (max_high[mid] < qlo) {
+        return;
+      }
+      query_range(lo, mid, qlo, qhi, visit);
+      if (entries[mid].low > qhi) {
+        return;
+      }
+      if (entries[mid].high >= qlo) {
+        visit(entries[mid]);
+      }
+      lo = mid + 1;
+    }
+  }
+
+public:
+  StaticIntervalTree() = default;
+
+  // 由 (low, high) 列表建树；low > high 时抛出 std::invalid_argument
+  explicit StaticIntervalTree(const std::vector<std::pair<T, T>> &intervals) {
+    build(intervals);
+  }
+
+  void build(const std::vector<std::pair<T, T>> &intervals) {
+    if (intervals.size() > std::numeric_limits<std::uint32_t>::max()) {
+      throw std::length_error("StaticIntervalTree: too many intervals");
+    }
+    entries.resize(intervals.size());
+    for (std::size_t i = 0; i < intervals.size(); i++) {
+      if (intervals[i].second < intervals[i].first) {
+        throw std::invalid_argument("StaticIntervalTree: low > high");
+      }
+      entries[i] = {intervals[i].first, intervals[i].second,
+                    static_cast<std::uint32_t>(i)};
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry &a, const Entry &b) { return a.low < b.low; });
+    max_high.assign(entries.size(), T());
+    if (!entries.empty()) {
+      build_max(0, entries.size());
+    }
+  }
+
+  std::size_t size() const { return entries.size(); }
+  bool empty() const { return entries.empty(); }
+
+  // 按 low 排序后的区间
+  const std::vector<Entry> &sorted_entries() const { return entries; }
+
+  // 占用的字节数
+  std::size_t memory_bytes() const {
+    return entries.capacity() * sizeof(Entry) +
+           max_high.capacity() * sizeof(T);
+  }
+
+  // 对每个与 [lo, hi] 重叠的区间调用 visit(const Entry &)，按 low 升序
+  template <typename F> void for_each_overlap(T lo, T hi, F visit) const {
+    if (hi < lo) {
+      std::swap(lo, hi);
+    }
+    query_range(0, entries.size(), lo, hi, visit);
+  }
+
+  // 与 [lo, hi] 重叠的区间 id
+  std::vector<std::uint32_t> overlaps(T lo, T hi) const {
+    std::vector<std::uint32_t> ids;
+    for_each_overlap(lo, hi, [&ids](const Entry &e) { ids.push_back(e.id); });
+    return ids;
+  }
+
+  // 包含 point 的区间 id
+  std::vector<std::uint32_t> stab(T point) const {
+    return overlaps(point, point);
+  }
+
+  std::size_t count_overlaps(T lo, T hi) const {
+    std::size_t count = 0;
+    for_each_overlap(lo, hi, [&count](const Entry &) { count++; });
+    return count;
+  }
+
+  // 批量查询：按 low 排序后依次执行，使相邻查询访问的数组位置相近；
+  // num_threads > 1 时把排好序的查询分块并行执行。第 i 个结果对应 queries[i]
+  std::vector<std::vector<std::uint32_t>>
+  batch_overlaps(const std::vector<std::pair<T, T>> &queries,
+                 std::size_t num_threads = 1) const {
+    std::vector<std::vector<std::uint32_t>> results(queries.size());
+    std::vector<std::uint32_t> order(queries.size());
+    for (std::size_t i = 0; i < queries.size(); i++) {
+      order[i] = static_cast<std::uint32_t>(i);
+    }
+    std::sort(order.begin(), order.end(),
+              [&queries](std::uint32_t a, std::uint32_t b) {
+                return queries[a].first < queries[b].first;
+              });
+
+    auto run = [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; i++) {
+        std::uint32_t q = order[i];
+        results[q] = overlaps(queries[q].first, queries[q].second);
+      }
+    };
+    if (num_threads <= 1) {
+      run(0, order.size());
+    } else {
+      WorkStealingScheduler scheduler(num_threads);
+      scheduler.parallel_for(0, order.size(), 256, run);
+    }
+    return results;
+  }
 };
 
 } // namespace algorithms
@@ -0,0 +1,1103 @@
+#ifndef INTRUSIVE_RB_TREE_H
+#define INTRUSIVE_RB_TREE_H
+
+#include "work_stealing_scheduler.h"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+
+// 红黑树节点颜色
+enum class Color { RED, BLACK };
+
+// 不维护任何附加信息的增强策略
+//
+// 增强策略需要提供：
+//   Storage：混入节点的附加字段
+//   init_nil(Storage &)：NIL 哨兵上的附加字段取值（如子树大小为 0）
+//   pull(Node &x, const Node &left, const Node &right)：由孩子重新计算 x
+// 核心在旋转和修改路径上调用 pull，与 CLRS 14.2 节的定理 14.1 一致。
+struct NoAugment {
+  struct Storage {};
+
+  static void init_nil(Storage &) {}
+
+  template <typename Node>
+  static void pull(Node &, const Node &, const Node &) {}
+};
+
+// 侵入式红黑树核心
+//
+// 节点存放在一个连续的 vector 池中，用 32 位下标代替 shared_ptr 链接：
+//   - 下标 0 是 NIL 哨兵，其余下标对应实际节点；
+//   - 父节点下标的最高位存放颜色（1 为红），节点只有三个 32 位链接字段；
+//   - 删除的节点挂到空闲链表（复用 parent_color 字段），之后的插入直接
+//     复用，池扩容之外不再进行任何堆分配，也没有引用计数。
+// 节点类型 Node 继承 Payload 与 Augment::Storage，因此外层容器可以直接
+// 以 node->key、node->interval、node->size 的形式访问字段。
+// 注意：插入可能使池扩容，之前取得的 Node 指针会失效，下标则始终有效。
+template <typename Payload, typename Augment = NoAugment>
+class IntrusiveRBTree {
+public:
+  using index_type = std::uint32_t;
+
+  static constexpr index_type kNil = 0;
+  static constexpr index_type kRedBit = index_type(1) << 31;
+  static constexpr index_type kIndexMask = kRedBit - 1;
+  // 最高位被颜色占用，下标 0 留给哨兵
+  static constexpr std::size_t kMaxNodes = kIndexMask - 1;
+
+  struct Node : Payload, Augment::Storage {
+    index_type left = kNil;
+    index_type right = kNil;
+    index_type parent_color = kNil; // 低 31 位：父节点下标；最高位：颜色
+
+    Node() = default;
+    explicit Node(Payload payload)
+        : Payload(std::move(payload)), Augment::Storage() {}
+
+    index_type parent() const { return parent_color & kIndexMask; }
+    bool is_red() const { return (parent_color & kRedBit) != 0; }
+    Color color() const { return is_red() ? Color::RED : Color::BLACK; }
+  };
+
+private:
+  std::vector<Node> nodes;
+  index_type root_index = kNil;
+  index_type free_head = kNil;
+  std::size_t count = 0;
+
+  void set_parent(index_type x, index_type p) {
+    nodes[x].parent_color = (nodes[x].parent_color & kRedBit) | p;
+  }
+
+  void set_red(index_type x) { nodes[x].parent_color |= kRedBit; }
+
+  void set_black(index_type x) { nodes[x].parent_color &= kIndexMask; }
+
+  void copy_color(index_type to, index_type from) {
+    nodes[to].parent_color = (nodes[to].parent_color & kIndexMask) |
+                             (nodes[from].parent_color & kRedBit);
+  }
+
+  void pull(index_type x) {
+    Node &n = nodes[x];
+    Augment::pull(n, nodes[n.left], nodes[n.right]);
+  }
+
+  void pull_path(index_type x) {
+    if constexpr (std::is_same_v<Augment, NoAugment>) {
+      return;
+    }
+    while (x != kNil) {
+      pull(x);
+      x = nodes[x].parent();
+    }
+  }
+
+  void reset_nil() {
+    nodes.assign(1, Node());
+    Augment::init_nil(nodes[kNil]);
+  }
+
+  // 空闲链表串联的是整棵被丢弃的子树（链接存放在 parent_color 中），
+  // 弹出一个节点时再把它的孩子压回链表，因此丢弃子树是 O(1) 的
+  void push_free(index_type x) {
+    nodes[x].parent_color = free_head;
+    free_head = x;
+  }
+
+  index_type allocate(Payload payload) {
+    index_type z;
+    if (free_head != kNil) {
+      z = free_head;
+      free_head = nodes[z].parent_color;
+      if (nodes[z].left != kNil) {
+        push_free(nodes[z].left);
+      }
+      if (nodes[z].right != kNil) {
+        push_free(nodes[z].right);
+      }
+      static_cast<Payload &>(nodes[z]) = std::move(payload);
+      static_cast<typename Augment::Storage &>(nodes[z]) =
+          typename Augment::Storage();
+    } else {
+      if (nodes.size() > kMaxNodes) {
+        throw std::length_error("IntrusiveRBTree: node pool exhausted");
+      }
+      z = static_cast<index_type>(nodes.size());
+      nodes.emplace_back(std::move(payload));
+    }
+    nodes[z].left = kNil;
+    nodes[z].right = kNil;
+    nodes[z].parent_color = kNil;
+    return z;
+  }
+
+  void release(index_type z) {
+    nodes[z].left = kNil;
+    nodes[z].right = kNil;
+    push_free(z);
+  }
+
+  void left_rotate(index_type x) {
+    index_type y = nodes[x].right;
+    index_type xp = nodes[x].parent();
+    nodes[x].right = nodes[y].left;
+    if (nodes[y].left != kNil) {
+      set_parent(nodes[y].left, x);
+    }
+    set_parent(y, xp);
+    if (xp == kNil) {
+      root_index = y;
+    } else if (x == nodes[xp].left) {
+      nodes[xp].left = y;
+    } else {
+      nodes[xp].right = y;
+    }
+    nodes[y].left = x;
+    set_parent(x, y);
+    pull(x);
+    pull(y);
+  }
+
+  void right_rotate(index_type y) {
+    index_type x = nodes[y].left;
+    index_type yp = nodes[y].parent();
+    nodes[y].left = nodes[x].right;
+    if (nodes[x].right != kNil) {
+      set_parent(nodes[x].right, y);
+    }
+    set_parent(x, yp);
+    if (yp == kNil) {
+      root_index = x;
+    } else if (y == nodes[yp].right) {
+      nodes[yp].right = x;
+    } else {
+      nodes[yp].left = x;
+    }
+    nodes[x].right = y;
+    set_parent(y, x);
+    pull(y);
+    pull(x);
+  }
+
+  void insert_fixup(index_type z) {
+    while (nodes[nodes[z].parent()].is_red()) {
+      index_type zp = nodes[z].parent();
+      index_type zpp = nodes[zp].parent();
+      if (zp == nodes[zpp].left) {
+        index_type y = nodes[zpp].right; // 叔叔节点
+        if (nodes[y].is_red()) {
+          // 情况1：叔叔是红色
+          set_black(zp);
+          set_black(y);
+          set_red(zpp);
+          z = zpp;
+        } else {
+          if (z == nodes[zp].right) {
+            // 情况2：z是右孩子
+            z = zp;
+            left_rotate(z);
+            zp = nodes[z].parent();
+          }
+          // 情况3：z是左孩子
+          set_black(zp);
+          set_red(zpp);
+          right_rotate(zpp);
+        }
+      } else {
+        // 对称情况
+        index_type y = nodes[zpp].left;
+        if (nodes[y].is_red()) {
+          set_black(zp);
+          set_black(y);
+          set_red(zpp);
+          z = zpp;
+        } else {
+          if (z == nodes[zp].left) {
+            z = zp;
+            right_rotate(z);
+            zp = nodes[z].parent();
+          }
+          set_black(zp);
+          set_red(zpp);
+          left_rotate(zpp);
+        }
+      }
+    }
+    set_black(root_index);
+  }
+
+  // 用以 v 为根的子树替换以 u 为根的子树；v 可以是 NIL，
+  // 此时哨兵的父指针被临时改写，供 delete_fixup 使用
+  void transplant(index_type u, index_type v) {
+    index_type up = nodes[u].parent();
+    if (up == kNil) {
+      root_index = v;
+    } else if (u == nodes[up].left) {
+      nodes[up].left = v;
+    } else {
+      nodes[up].right = v;
+    }
+    set_parent(v, up);
+  }
+
+  void delete_fixup(index_type x) {
+    while (x != root_index && !nodes[x].is_red()) {
+      index_type xp = nodes[x].parent();
+      if (x == nodes[xp].left) {
+        index_type w = nodes[xp].right; // 兄弟节点
+        if (nodes[w].is_red()) {
+          // 情况1：兄弟是红色
+          set_black(w);
+          set_red(xp);
+          left_rotate(xp);
+          w = nodes[xp].right;
+        }
+        if (!nodes[nodes[w].left].is_red() && !nodes[nodes[w].right].is_red()) {
+          // 情况2：兄弟的两个孩子都是黑色
+          set_red(w);
+          x = xp;
+        } else {
+          if (!nodes[nodes[w].right].is_red()) {
+            // 情况3：兄弟的右孩子是黑色，左孩子是红色
+            set_black(nodes[w].left);
+            set_red(w);
+            right_rotate(w);
+            w = nodes[xp].right;
+          }
+          // 情况4：兄弟的右孩子是红色
+          copy_color(w, xp);
+          set_black(xp);
+          set_black(nodes[w].right);
+          left_rotate(xp);
+          x = root_index;
+        }
+      } else {
+        // 对称情况
+        index_type w = nodes[xp].left;
+        if (nodes[w].is_red()) {
+          set_black(w);
+          set_red(xp);
+          right_rotate(xp);
+          w = nodes[xp].left;
+        }
+        if (!nodes[nodes[w].right].is_red() && !nodes[nodes[w].left].is_red()) {
+          set_red(w);
+          x = xp;
+        } else {
+          if (!nodes[nodes[w].left].is_red()) {
+            set_black(nodes[w].right);
+            set_red(w);
+            left_rotate(w);
+            w = nodes[xp].left;
+          }
+          copy_color(w, xp);
+          set_black(xp);
+          set_black(nodes[w].left);
+          right_rotate(xp);
+          x = root_index;
+        }
+      }
+    }
+    set_black(x);
+  }
+
+  // 返回子树黑高度，违反性质时返回 -1
+  int check_subtree(index_type x) const {
+    if (x == kNil) {
+      return 1;
+    }
+    const Node &n = nodes[x];
+    if (n.is_red() && (nodes[n.left].is_red() || nodes[n.right].is_red())) {
+      return -1;
+    }
+    if ((n.left != kNil && nodes[n.left].parent() != x) ||
+        (n.right != kNil && nodes[n.right].parent() != x)) {
+      return -1;
+    }
+    int lh = check_subtree(n.left);
+    int rh = check_subtree(n.right);
+    if (lh < 0 || lh != rh) {
+      return -1;
+    }
+    return lh + (n.is_red() ? 0 : 1);
+  }
+
+  // ---------------- 基于 join 的批量操作 ----------------
+  //
+  // 以下函数只写入参与操作的节点，从不修改哨兵、池大小或 root_index，
+  // 因此对不相交子树的递归调用可以并行执行。
+
+  // 带黑高度的子树：bh 为从根到 NIL 的路径上黑节点的个数（含根）
+  struct Subtree {
+    index_type root;
+    int bh;
+  };
+
+  // 三路拆分的结果：l < key，mid 为等于 key 的节点（可能为 NIL），r > key
+  struct Split {
+    Subtree l;
+    index_type mid;
+    Subtree r;
+  };
+
+  // 递归过程中丢弃的子树链（头尾相连，用于最后一次性并入空闲链表）
+  struct Garbage {
+    index_type head = kNil;
+    index_type tail = kNil;
+    std::size_t counter = 0; // 各操作自己的计数：重复键、保留数或删除数
+  };
+
+  // 双方黑高度都不低于该值时并行递归，约对应每侧至少数百个节点
+  static constexpr int kSpawnBlackHeight = 8;
+
+  int child_bh(index_type x, int bh) const {
+    return nodes[x].is_red() ? bh : bh - 1;
+  }
+
+  Subtree left_of(Subtree t) const {
+    return {nodes[t.root].left, child_bh(t.root, t.bh)};
+  }
+
+  Subtree right_of(Subtree t) const {
+    return {nodes[t.root].right, child_bh(t.root, t.bh)};
+  }
+
+  // 把 l、r 挂到 k 下并重新计算 k；NIL 孩子的父指针不写
+  index_type link(index_type k, index_type l, index_type r) {
+    nodes[k].left = l;
+    nodes[k].right = r;
+    if (l != kNil) {
+      set_parent(l, k);
+    }
+    if (r != kNil) {
+      set_parent(r, k);
+    }
+    pull(k);
+    return k;
+  }
+
+  // 局部旋转：返回新的子树根，由调用者负责挂回父节点
+  index_type rotate_left_at(index_type x) {
+    index_type y = nodes[x].right;
+    link(x, nodes[x].left, nodes[y].left);
+    return link(y, x, nodes[y].right);
+  }
+
+  index_type rotate_right_at(index_type x) {
+    index_type y = nodes[x].left;
+    link(x, nodes[y].right, nodes[x].right);
+    return link(y, nodes[y].left, x);
+  }
+
+  // 要求 lbh >= rbh：沿 l 的右脊下降到黑高度相同的黑节点处挂上 k
+  index_type join_right(index_type l, int lbh, index_type k, index_type r,
+                        int rbh) {
+    if (!nodes[l].is_red() && lbh == rbh) {
+      set_red(k);
+      return link(k, l, r);
+    }
+    index_type t = link(l, nodes[l].left,
+                        join_right(nodes[l].right, child_bh(l, lbh), k, r, rbh));
+    index_type tr = nodes[t].right;
+    if (!nodes[t].is_red() && nodes[tr].is_red() &&
+        nodes[nodes[tr].right].is_red()) {
+      set_black(nodes[tr].right);
+      return rotate_left_at(t);
+    }
+    return t;
+  }
+
+  index_type join_left(index_type l, int lbh, index_type k, index_type r,
+                       int rbh) {
+    if (!nodes[r].is_red() && lbh == rbh) {
+      set_red(k);
+      return link(k, l, r);
+    }
+    index_type t = link(
+        r, join_left(l, lbh, k, nodes[r].left, child_bh(r, rbh)), nodes[r].right);
+    index_type tl = nodes[t].left;
+    if (!nodes[t].is_red() && nodes[tl].is_red() &&
+        nodes[nodes[tl].left].is_red()) {
+      set_black(nodes[tl].left);
+      return rotate_right_at(t);
+    }
+    return t;
+  }
+
+  // JOIN(l, k, r)：l 中的键都不大于 k，r 中的键都不小于 k
+  Subtree join(Subtree l, index_type k, Subtree r) {
+    if (l.bh > r.bh) {
+      index_type t = join_right(l.root, l.bh, k, r.root, r.bh);
+      if (nodes[t].is_red() && nodes[nodes[t].right].is_red()) {
+        set_black(t);
+        return {t, l.bh + 1};
+      }
+      return {t, l.bh};
+    }
+    if (r.bh > l.bh) {
+      index_type t = join_left(l.root, l.bh, k, r.root, r.bh);
+      if (nodes[t].is_red() && nodes[nodes[t].left].is_red()) {
+        set_black(t);
+        return {t, r.bh + 1};
+      }
+      return {t, r.bh};
+    }
+    if (!nodes[l.root].is_red() && !nodes[r.root].is_red()) {
+      set_red(k);
+      return {link(k, l.root, r.root), l.bh};
+    }
+    set_black(k);
+    return {link(k, l.root, r.root), l.bh + 1};
+  }
+
+  // 取出最大节点，返回余下的子树
+  std::pair<Subtree, index_type> split_last(Subtree t) {
+    index_type x = t.root;
+    if (nodes[x].right == kNil) {
+      return {left_of(t), x};
+    }
+    Subtree l = left_of(t);
+    auto [rest, last] = split_last(right_of(t));
+    return {join(l, x, rest), last};
+  }
+
+  // 不带中间键的连接
+  Subtree join2(Subtree l, Subtree r) {
+    if (l.root == kNil) {
+      return r;
+    }
+    auto [rest, last] = split_last(l);
+    return join(rest, last, r);
+  }
+
+  template <typename Less>
+  Split split3(Subtree t, const Payload &key, const Less &less) {
+    if (t.root == kNil) {
+      return {{kNil, 0}, kNil, {kNil, 0}};
+    }
+    index_type x = t.root;
+    Subtree l = left_of(t);
+    Subtree r = right_of(t);
+    if (less(key, nodes[x])) {
+      Split s = split3(l, key, less);
+      return {s.l, s.mid, join(s.r, x, r)};
+    }
+    if (less(nodes[x], key)) {
+      Split s = split3(r, key, less);
+      return {join(l, x, s.l), s.mid, s.r};
+    }
+    return {l, x, r};
+  }
+
+  // 按 lower_bound 拆分：first 中的键都小于 key，second 中的键都不小于 key
+  template <typename Less>
+  std::pair<Subtree, Subtree> split_lower(Subtree t, const Payload &key,
+                                          const Less &less) {
+    if (t.root == kNil) {
+      return {{kNil, 0}, {kNil, 0}};
+    }
+    index_type x = t.root;
+    Subtree l = left_of(t);
+    Subtree r = right_of(t);
+    if (less(nodes[x], key)) {
+      auto [rl, rr] = split_lower(r, key, less);
+      return {join(l, x, rl), rr};
+    }
+    auto [ll, lr] = split_lower(l, key, less);
+    return {ll, join(lr, x, r)};
+  }
+
+  void discard_subtree(Garbage &g, index_type x) {
+    if (x == kNil) {
+      return;
+    }
+    nodes[x].parent_color = g.head;
+    g.head = x;
+    if (g.tail == kNil) {
+      g.tail = x;
+    }
+  }
+
+  // 丢弃单个节点：它的孩子已经交给了别的子树
+  void discard_node(Garbage &g, index_type x) {
+    nodes[x].left = kNil;
+    nodes[x].right = kNil;
+    discard_subtree(g, x);
+  }
+
+  void merge_garbage(Garbage &into, Garbage &from) {
+    into.counter += from.counter;
+    if (from.head == kNil) {
+      return;
+    }
+    if (into.head == kNil) {
+      into.head = from.head;
+    } else {
+      nodes[into.tail].parent_color = from.head;
+    }
+    into.tail = from.tail;
+  }
+
+  static bool worth_spawning(Subtree a, Subtree b) {
+    return a.bh >= kSpawnBlackHeight && b.bh >= kSpawnBlackHeight;
+  }
+
+  // 左右两半的递归：足够大时 spawn 左半，当前线程执行右半
+  template <typename Rec>
+  void recurse_pair(Subtree la, Subtree lb, Subtree ra, Subtree rb,
+                    Subtree &left, Subtree &right, Garbage &g, const Rec &rec) {
+    Garbage gr;
+    if (worth_spawning(la, lb) || worth_spawning(ra, rb)) {
+      WorkStealingScheduler::TaskGroup group;
+      group.spawn([&rec, &left, la, lb, &g] { left = rec(la, lb, g); });
+      right = rec(ra, rb, gr);
+      group.sync();
+    } else {
+      left = rec(la, lb, g);
+      right = rec(ra, rb, gr);
+    }
+    merge_garbage(g, gr);
+  }
+
+  // UNION：以 a 的根拆分 b，两侧递归后用 a 的根连接；b 中的重复键被丢弃
+  template <typename Less>
+  Subtree union_rec(Subtree a, Subtree b, const Less &less, Garbage &g) {
+    if (a.root == kNil) {
+      return b;
+    }
+    if (b.root == kNil) {
+      return a;
+    }
+    index_type k = a.root;
+    Split s = split3(b, nodes[k], less);
+    Subtree l, r;
+    auto rec = [this, &less](Subtree x, Subtree y, Garbage &gg) {
+      return union_rec(x, y, less, gg);
+    };
+    recurse_pair(left_of(a), s.l, right_of(a), s.r, l, r, g, rec);
+    if (s.mid != kNil) {
+      discard_node(g, s.mid);
+      g.counter++;
+    }
+    return join(l, k, r);
+  }
+
+  // INTERSECTION：只保留 a 中在 b 里也出现的节点，counter 为保留数
+  template <typename Less>
+  Subtree intersection_rec(Subtree a, Subtree b, const Less &less,
+                           Garbage &g) {
+    if (a.root == kNil || b.root == kNil) {
+      discard_subtree(g, a.root);
+      discard_subtree(g, b.root);
+      return {kNil, 0};
+    }
+    index_type k = a.root;
+    Split s = split3(b, nodes[k], less);
+    Subtree l, r;
+    auto rec = [this, &less](Subtree x, Subtree y, Garbage &gg) {
+      return intersection_rec(x, y, less, gg);
+    };
+    recurse_pair(left_of(a), s.l, right_of(a), s.r, l, r, g, rec);
+    if (s.mid != kNil) {
+      discard_node(g, s.mid);
+      g.counter++;
+      return join(l, k, r);
+    }
+    discard_node(g, k);
+    return join2(l, r);
+  }
+
+  // DIFFERENCE：a 减去 b，以 b 的根拆分 a；counter 为从 a 中删除的节点数
+  template <typename Less>
+  Subtree difference_rec(Subtree a, Subtree b, const Less &less, Garbage &g) {
+    if (a.root == kNil || b.root == kNil) {
+      discard_subtree(g, b.root);
+      return a;
+    }
+    index_type k = b.root;
+    Split s = split3(a, nodes[k], less);
+    Subtree l, r;
+    auto rec = [this, &less](Subtree x, Subtree y, Garbage &gg) {
+      return difference_rec(x, y, less, gg);
+    };
+    recurse_pair(s.l, left_of(b), s.r, right_of(b), l, r, g, rec);
+    discard_node(g, k);
+    if (s.mid != kNil) {
+      discard_node(g, s.mid);
+      g.counter++;
+    }
+    return join2(l, r);
+  }
+
+  index_type build_range(index_type lo, index_type hi, int depth,
+                         int max_depth, index_type parent) {
+    if (lo >= hi) {
+      return kNil;
+    }
+    index_type mid = lo + (hi - lo) / 2;
+    bool red = depth == max_depth && depth > 0;
+    nodes[mid].parent_color = parent | (red ? kRedBit : 0);
+    index_type l = build_range(lo, mid, depth + 1, max_depth, mid);
+    index_type r = build_range(mid + 1, hi, depth + 1, max_depth, mid);
+    nodes[mid].left = l;
+    nodes[mid].right = r;
+    pull(mid);
+    return mid;
+  }
+
+  Subtree whole() const { return {root_index, black_height()}; }
+
+  // 用子树 t 作为整棵树，并把丢弃的节点并入空闲链表
+  void adopt(Subtree t, std::size_t new_count, Garbage &g) {
+    root_index = t.root;
+    if (root_index != kNil) {
+      set_parent(root_index, kNil);
+      set_black(root_index);
+    }
+    if (g.head != kNil) {
+      nodes[g.tail].parent_color = free_head;
+      free_head = g.head;
+    }
+    count = new_count;
+  }
+
+  // 把 src 中以 x 为根的子树按原形状复制到本池，返回新的根下标
+  index_type import_subtree(IntrusiveRBTree &src, index_type x,
+                            index_type parent) {
+    if (x == kNil) {
+      return kNil;
+    }
+    Node &from = src.nodes[x];
+    index_type z = allocate(std::move(static_cast<Payload &>(from)));
+    static_cast<typename Augment::Storage &>(nodes[z]) =
+        static_cast<const typename Augment::Storage &>(from);
+    nodes[z].parent_color = parent | (from.parent_color & kRedBit);
+    index_type l = import_subtree(src, from.left, z);
+    nodes[z].left = l;
+    index_type r = import_subtree(src, src.nodes[x].right, z);
+    nodes[z].right = r;
+    return z;
+  }
+
+  // 把 src 的全部节点并入本池（src 随后被清空），返回它在本池中的子树
+  Subtree absorb(IntrusiveRBTree &src) {
+    int bh = src.black_height();
+    reserve(nodes.size() + src.count);
+    index_type root = import_subtree(src, src.root_index, kNil);
+    src.clear();
+    return {root, bh};
+  }
+
+  // 集合运算的公共部分：较小的一方并入较大一方的池中，再运行 rec
+  template <typename Rec, typename Count>
+  static IntrusiveRBTree set_operation(IntrusiveRBTree a, IntrusiveRBTree b,
+                                       std::size_t num_threads, const Rec &rec,
+                                       const Count &count_of) {
+    bool keep_a = a.count >= b.count;
+    IntrusiveRBTree &base = keep_a ? a : b;
+    IntrusiveRBTree &other = keep_a ? b : a;
+    Subtree other_tree = base.absorb(other);
+    Subtree base_tree = base.whole();
+    Subtree ta = keep_a ? base_tree : other_tree;
+    Subtree tb = keep_a ? other_tree : base_tree;
+
+    Garbage g;
+    Subtree result;
+    if (num_threads <= 1) {
+      result = rec(base, ta, tb, g);
+    } else {
+      WorkStealingScheduler scheduler(num_threads);
+      scheduler.run([&] { result = rec(base, ta, tb, g); });
+    }
+    base.adopt(result, count_of(g.counter), g);
+    return std::move(base);
+  }
+
+public:
+  IntrusiveRBTree() { reset_nil(); }
+
+  // 判断树是否为空
+  bool empty() const { return count == 0; }
+
+  // 节点个数
+  std::size_t size() const { return count; }
+
+  // 预留节点池容量，避免插入过程中扩容
+  void reserve(std::size_t n) {
+    if (n > kMaxNodes) {
+      throw std::length_error("IntrusiveRBTree: reserve exceeds node limit");
+    }
+    nodes.reserve(n + 1);
+  }
+
+  // 节点池占用的字节数
+  std::size_t memory_bytes() const { return nodes.capacity() * sizeof(Node); }
+
+  index_type root() const { return root_index; }
+
+  Node &node(index_type x) { return nodes[x]; }
+  const Node &node(index_type x) const { return nodes[x]; }
+
+  index_type left(index_type x) const { return nodes[x].left; }
+  index_type right(index_type x) const { return nodes[x].right; }
+  index_type parent(index_type x) const { return nodes[x].parent(); }
+
+  // 子树中的最小/最大节点，x 为 NIL 时返回 NIL
+  index_type minimum(index_type x) const {
+    if (x == kNil) {
+      return kNil;
+    }
+    while (nodes[x].left != kNil) {
+      x = nodes[x].left;
+    }
+    return x;
+  }
+
+  index_type maximum(index_type x) const {
+    if (x == kNil) {
+      return kNil;
+    }
+    while (nodes[x].right != kNil) {
+      x = nodes[x].right;
+    }
+    return x;
+  }
+
+  // 中序后继，x 是最大节点时返回 NIL
+  index_type successor(index_type x) const {
+    if (nodes[x].right != kNil) {
+      return minimum(nodes[x].right);
+    }
+    index_type y = nodes[x].parent();
+    while (y != kNil && x == nodes[y].right) {
+      x = y;
+      y = nodes[y].parent();
+    }
+    return y;
+  }
+
+  // 中序前驱；x 为 NIL 时返回最大节点，使 --end() 指向最后一个元素
+  index_type predecessor(index_type x) const {
+    if (x == kNil) {
+      return maximum(root_index);
+    }
+    if (nodes[x].left != kNil) {
+      return maximum(nodes[x].left);
+    }
+    index_type y = nodes[x].parent();
+    while (y != kNil && x == nodes[y].left) {
+      x = y;
+      y = nodes[y].parent();
+    }
+    return y;
+  }
+
+  // 中序意义下第一个使 before(node) 为假的节点，不存在时返回 NIL；
+  // 要求 before 在中序上是先真后假的，lower_bound/upper_bound 都由它实现
+  template <typename Pred> index_type partition_point(Pred before) const {
+    index_type result = kNil;
+    index_type x = root_index;
+    while (x != kNil) {
+      if (before(nodes[x])) {
+        x = nodes[x].right;
+      } else {
+        result = x;
+        x = nodes[x].left;
+      }
+    }
+    return result;
+  }
+
+  // 中序双向迭代器，解引用得到载荷成员 Member（如 &RBEntry<T>::key）。
+  // 迭代器保存树指针与下标，插入导致池扩容后依然有效；
+  // 只有删除其所指元素、clear 或集合运算会使其失效
+  template <auto Member> class member_iterator {
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::remove_cv_t<std::remove_reference_t<decltype(
+        std::declval<const Payload &>().*Member)>>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    member_iterator() = default;
+
+    reference operator*() const { return tree->nodes[index].*Member; }
+    pointer operator->() const { return &(tree->nodes[index].*Member); }
+
+    member_iterator &operator++() {
+      index = tree->successor(index);
+      return *this;
+    }
+
+    member_iterator operator++(int) {
+      member_iterator old = *this;
+      ++*this;
+      return old;
+    }
+
+    member_iterator &operator--() {
+      index = tree->predecessor(index);
+      return *this;
+    }
+
+    member_iterator operator--(int) {
+      member_iterator old = *this;
+      --*this;
+      return old;
+    }
+
+    bool operator==(const member_iterator &other) const {
+      return index == other.index && tree == other.tree;
+    }
+    bool operator!=(const member_iterator &other) const {
+      return !(*this == other);
+    }
+
+    // 所指节点的下标，end() 为 NIL
+    index_type position() const { return index; }
+
+  private:
+    friend class IntrusiveRBTree;
+
+    member_iterator(const IntrusiveRBTree *tree, index_type index)
+        : tree(tree), index(index) {}
+
+    const IntrusiveRBTree *tree = nullptr;
+    index_type index = kNil;
+  };
+
+  template <auto Member> member_iterator<Member> iterator_at(index_type x) const {
+    return member_iterator<Member>(this, x);
+  }
+
+  // 插入载荷，less(a, b) 为载荷上的严格弱序；相等的键插到右侧
+  template <typename Less> index_type insert(Payload payload, Less less) {
+    index_type z = allocate(std::move(payload));
+    index_type y = kNil;
+    index_type x = root_index;
+    bool go_left = false;
+    while (x != kNil) {
+      y = x;
+      go_left = less(nodes[z], nodes[x]);
+      x = go_left ? nodes[x].left : nodes[x].right;
+    }
+    nodes[z].parent_color = y | kRedBit;
+    if (y == kNil) {
+      root_index = z;
+    } else if (go_left) {
+      nodes[y].left = z;
+    } else {
+      nodes[y].right = z;
+    }
+    pull_path(z);
+    insert_fixup(z);
+    ++count;
+    return z;
+  }
+
+  // 删除节点 z（CLRS RB-DELETE），z 的下标随后被回收
+  void erase(index_type z) {
+    index_type y = z;
+    bool y_was_red = nodes[y].is_red();
+    index_type x;
+    index_type fix_from;
+
+    if (nodes[z].left == kNil) {
+      x = nodes[z].right;
+      transplant(z, x);
+      fix_from = nodes[x].parent();
+    } else if (nodes[z].right == kNil) {
+      x = nodes[z].left;
+      transplant(z, x);
+      fix_from = nodes[x].parent();
+    } else {
+      y = minimum(nodes[z].right);
+      y_was_red = nodes[y].is_red();
+      x = nodes[y].right;
+      if (nodes[y].parent() == z) {
+        set_parent(x, y);
+        fix_from = y;
+      } else {
+        fix_from = nodes[y].parent();
+        transplant(y, x);
+        nodes[y].right = nodes[z].right;
+        set_parent(nodes[y].right, y);
+      }
+      transplant(z, y);
+      nodes[y].left = nodes[z].left;
+      set_parent(nodes[y].left, y);
+      copy_color(y, z);
+    }
+
+    // 先沿被修改的路径恢复附加信息，之后的旋转会局部维护它
+    pull_path(fix_from);
+    if (!y_was_red) {
+      delete_fixup(x);
+    }
+    set_parent(kNil, kNil);
+    release(z);
+    --count;
+  }
+
+  // 由有序载荷在 O(n) 时间内建树：节点按中序放入池中，最深一层染红，
+  // 其余为黑；输入无序时抛出 std::invalid_argument
+  template <typename Less>
+  void build_from_sorted(std::vector<Payload> items, const Less &less) {
+    for (std::size_t i = 1; i < items.size(); i++) {
+      if (less(items[i], items[i - 1])) {
+        throw std::invalid_argument(
+            "IntrusiveRBTree::build_from_sorted: input is not sorted");
+      }
+    }
+    clear();
+    reserve(items.size());
+    for (Payload &item : items) {
+      nodes.emplace_back(std::move(item));
+    }
+    std::size_t n = items.size();
+    int max_depth = 0;
+    while ((std::size_t(2) << max_depth) <= n) {
+      max_depth++;
+    }
+    root_index = build_range(1, static_cast<index_type>(n + 1), 0, max_depth,
+                             kNil);
+    count = n;
+  }
+
+  // JOIN：right 中的键都不小于本树中的键，否则抛出 std::invalid_argument。
+  // 较小一方的节点被复制到较大一方的池中，耗时 O(log n + min(n, m))
+  template <typename Less> void join(IntrusiveRBTree &&right, const Less &less) {
+    if (right.empty()) {
+      return;
+    }
+    if (empty()) {
+      *this = std::move(right);
+      right.clear();
+      return;
+    }
+    if (less(right.node(right.minimum(right.root_index)),
+             node(maximum(root_index)))) {
+      throw std::invalid_argument(
+          "IntrusiveRBTree::join: keys of the right tree must not be smaller");
+    }
+    std::size_t total = count + right.count;
+    bool keep_this = count >= right.count;
+    IntrusiveRBTree &base = keep_this ? *this : right;
+    IntrusiveRBTree &other = keep_this ? right : *this;
+    Subtree absorbed = base.absorb(other);
+    Subtree own = base.whole();
+    Garbage g;
+    if (keep_this) {
+      base.adopt(base.join2(own, absorbed), total, g);
+    } else {
+      base.adopt(base.join2(absorbed, own), total, g);
+      *this = std::move(right);
+      right.clear();
+    }
+  }
+
+  // SPLIT：本树保留小于 key 的部分，返回不小于 key 的部分。
+  // 拆分本身为 O(log n)，返回部分需要复制到新池中，耗时 O(返回部分大小)
+  template <typename Less>
+  IntrusiveRBTree split(const Payload &key, const Less &less) {
+    IntrusiveRBTree out;
+    if (empty()) {
+      return out;
+    }
+    auto [l, r] = split_lower(whole(), key, less);
+    out.root_index = out.import_subtree(*this, r.root, kNil);
+    out.count = out.nodes.size() - 1;
+    if (out.root_index != kNil) {
+      out.set_black(out.root_index);
+    }
+    Garbage g;
+    discard_subtree(g, r.root);
+    adopt(l, count - out.count, g);
+    return out;
+  }
+
+  // 并集（重复键保留 a 中的节点），work 为 O(m log(n/m + 1))，
+  // m 为较小一方的大小；num_threads > 1 时在工作窃取调度器上并行
+  template <typename Less>
+  static IntrusiveRBTree set_union(IntrusiveRBTree a, IntrusiveRBTree b,
+                                   const Less &less,
+                                   std::size_t num_threads = 1) {
+    std::size_t total = a.count + b.count;
+    return set_operation(
+        std::move(a), std::move(b), num_threads,
+        [&less](IntrusiveRBTree &t, Subtree x, Subtree y, Garbage &g) {
+          return t.union_rec(x, y, less, g);
+        },
+        [total](std::size_t duplicates) { return total - duplicates; });
+  }
+
+  // 交集（保留 a 中的节点）
+  template <typename Less>
+  static IntrusiveRBTree set_intersection(IntrusiveRBTree a, IntrusiveRBTree b,
+                                          const Less &less,
+                                          std::size_t num_threads = 1) {
+    return set_operation(
+        std::move(a), std::move(b), num_threads,
+        [&less](IntrusiveRBTree &t, Subtree x, Subtree y, Garbage &g) {
+          return t.intersection_rec(x, y, less, g);
+        },
+        [](std::size_t kept) { return kept; });
+  }
+
+  // 差集 a - b
+  template <typename Less>
+  static IntrusiveRBTree set_difference(IntrusiveRBTree a, IntrusiveRBTree b,
+                                        const Less &less,
+                                        std::size_t num_threads = 1) {
+    std::size_t total = a.count;
+    return set_operation(
+        std::move(a), std::move(b), num_threads,
+        [&less](IntrusiveRBTree &t, Subtree x, Subtree y, Garbage &g) {
+          return t.difference_rec(x, y, less, g);
+        },
+        [total](std::size_t removed) { return total - removed; });
+  }
+
+  // 根到最左叶子路径上的黑节点数
+  int black_height() const {
+    int height = 0;
+    for (index_type x = root_index; x != kNil; x = nodes[x].left) {
+      if (!nodes[x].is_red()) {
+        height++;
+      }
+    }
+    return height;
+  }
+
+  // 验证红黑树性质：根为黑、红节点无红孩子、各路径黑高度相同、父指针一致
+  bool is_valid() const {
+    if (root_index == kNil) {
+      return true;
+    }
+    if (nodes[root_index].is_red() || nodes[root_index].parent() != kNil) {
+      return false;
+    }
+    return check_subtree(root_index) > 0;
+  }
+
+  // 清空树，保留池容量
+  void clear() {
+    reset_nil();
+    root_index = kNil;
+    free_head = kNil;
+    count = 0;
+  }
+};
+
+} // namespace algorithms
+
+#endif // INTRUSIVE_RB_TREE_H
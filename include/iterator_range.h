@@ -0,0 +1,22 @@
+#ifndef ITERATOR_RANGE_H
+#define ITERATOR_RANGE_H
+
+namespace algorithms {
+
+// 由一对迭代器构成的惰性区间视图，可直接用于范围for，不复制任何元素
+template <typename Iterator> class IteratorRange {
+private:
+  Iterator first;
+  Iterator last;
+
+public:
+  IteratorRange(Iterator first, Iterator last) : first(first), last(last) {}
+
+  Iterator begin() const { return first; }
+  Iterator end() const { return last; }
+  bool empty() const { return first == last; }
+};
+
+} // namespace algorithms
+
+#endif // ITERATOR_RANGE_H
@@ -1,16 +1,22 @@
 #ifndef LINEAR_PROGRAMMING_H
 #define LINEAR_PROGRAMMING_H
 
+#include "linear_systems.h"
+#include "sparse_matrix.h"
+#include "workload_generator.h"
 #include <algorithm>
 #include <cmath>
 #include <functional>
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <queue>
 #include <random>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 namespace algorithms {
@@ -23,6 +29,8 @@ namespace algorithms {
  * - 单纯形法
  * - 对偶理论
  * - 初始可行解构造
+ * - 稀疏修正单纯形法（RevisedSimplex，见本文件后部）
+ * - 原始对偶内点法（InteriorPointSolver，见本文件后部）
  */
 class LinearProgramming {
 private:
@@ -203,6 +211,26 @@ public:
     return result;
   }
 
+  /**
+   * @brief 稀疏修正单纯形法 - 见 RevisedSimplex
+   *
+   * 把稠密输入转成CSC后求解；大规模稀疏问题应直接构造 RevisedSimplex，
+   * 以便复用分解做热启动。
+   */
+  static LPResult revised_simplex(const std::vector<std::vector<double>> &A,
+                                  const std::vector<double> &b,
+                                  const std::vector<double> &c);
+
+  /**
+   * @brief Mehrotra预测-校正内点法 - 见 InteriorPointSolver
+   *
+   * 把稠密输入转成CSC后求解，返回内点逼近的最优解（不是顶点解）。
+   */
+  static LPResult
+  interior_point_method(const std::vector<std::vector<double>> &A,
+                        const std::vector<double> &b,
+                        const std::vector<double> &c);
+
   /**
    * @brief 验证线性规划解的最优性
    *
@@ -266,41 +294,35 @@ public:
    * @param m 约束数量
    * @param n 变量数量
    * @param density 约束矩阵密度(0-1)
+   * @param seed 随机数种子（同一种子在任何平台上得到同一问题）
    * @return 随机线性规划问题 {A, b, c}
    */
   static std::tuple<std::vector<std::vector<double>>, std::vector<double>,
                     std::vector<double>>
-  generate_random_lp(size_t m, size_t n, double density = 0.7) {
+  generate_random_lp(size_t m, size_t n, double density = 0.7,
+                     uint64_t seed = WorkloadGenerator::kDefaultSeed) {
     std::vector<std::vector<double>> A(m, std::vector<double>(n, 0.0));
     std::vector<double> b(m);
     std::vector<double> c(n);
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<double> coeff_dis(0.1,
-                                                     5.0); // 正系数确保可行性
-    std::uniform_real_distribution<double> b_dis(10.0,
-                                                 50.0); // 合理的右端项范围
-    std::uniform_real_distribution<double> obj_dis(-5.0,
-                                                   5.0); // 目标函数系数可正可负
-    std::bernoulli_distribution density_dis(density);
+    RandomStream gen = WorkloadGenerator(seed).stream(0);
 
     // 生成目标函数系数
     for (size_t j = 0; j < n; ++j) {
-      c[j] = obj_dis(gen);
+      c[j] = gen.uniform(-5.0, 5.0); // 目标函数系数可正可负
     }
 
     // 生成约束矩阵和右端项，确保问题可行且有界
     for (size_t i = 0; i < m; ++i) {
       // 生成正系数约束，确保原点可行
       for (size_t j = 0; j < n; ++j) {
-        if (density_dis(gen)) {
-          A[i][j] = coeff_dis(gen); // 正系数
+        if (gen.bernoulli(density)) {
+          A[i][j] = gen.uniform(0.1, 5.0); // 正系数确保可行性
         }
       }
 
       // 确保右端项足够大，使得约束不紧
-      b[i] = b_dis(gen);
+      b[i] = gen.uniform(10.0, 50.0);
 
       // 添加一个上界约束，确保问题有界
       if (i == 0) {
@@ -313,6 +335,44 @@ public:
     return {A, b, c};
   }
 
+  /**
+   * @brief 生成随机稀疏线性规划问题
+   *
+   * 每列至少一个非零元，系数为正、右端项为正，原点可行且问题有界。
+   *
+   * @param m 约束数量
+   * @param n 变量数量
+   * @param density 约束矩阵密度(0-1)
+   * @param seed 随机数种子
+   * @return 随机线性规划问题 {A, b, c}
+   */
+  static std::tuple<SparseMatrixCSC, std::vector<double>, std::vector<double>>
+  generate_random_sparse_lp(size_t m, size_t n, double density,
+                            unsigned seed = 29) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> coeff_dis(0.1, 5.0);
+    std::uniform_real_distribution<double> b_dis(10.0, 50.0);
+    std::uniform_real_distribution<double> obj_dis(-1.0, 5.0);
+    std::uniform_int_distribution<int> row_dis(0, static_cast<int>(m) - 1);
+    std::binomial_distribution<int> count_dis(static_cast<int>(m), density);
+
+    std::vector<SparseTriplet> entries;
+    for (size_t j = 0; j < n; ++j) {
+      int count = std::max(1, count_dis(gen));
+      for (int k = 0; k < count; ++k) {
+        entries.push_back({row_dis(gen), static_cast<int>(j), coeff_dis(gen)});
+      }
+    }
+    std::vector<double> b(m), c(n);
+    for (size_t i = 0; i < m; ++i) {
+      b[i] = b_dis(gen);
+    }
+    for (size_t j = 0; j < n; ++j) {
+      c[j] = obj_dis(gen);
+    }
+    return {SparseMatrixCSC(m, n, entries), b, c};
+  }
+
 private:
   /**
    * @brief 转换为标准型线性规划
@@ -609,6 +669,1716 @@ private:
   }
 };
 
+/**
+ * @brief 单纯形法基矩阵的稀疏LU分解，支持Forrest–Tomlin更新
+ *
+ * 分解 B = L U：
+ * - 先反复取出列单元素与行单元素（松弛变量的单位列、只剩一个非零元的
+ *   行），它们的消元不产生任何填充，实际LP的基大多在这一步就被三角化；
+ * - 剩下的"核"按列非零元个数从少到多、从左到右消元（Gilbert–Peierls），
+ *   每列先用深度优先搜索找出需要作用的L变换，只处理可达的非零元；
+ *   主元取门限部分选主元（不小于最大值的 kThreshold 倍）中所在行非零元
+ *   最少者，兼顾数值稳定与稀疏性。
+ * U 以基位置为行列下标，按 order 排列后为上三角。
+ *
+ * 换基时不重新分解（Forrest–Tomlin）：把 U 中离开的列换成新列作用完 L
+ * 与已有行变换后的"尖峰"，把该位置移到 order 末尾，再用它后面的行消去
+ * 该行在其他列上的元素，消元系数记为一个行变换 R = I - e_p η^T。
+ * U 的填充只出现在尖峰列中，稀疏性比乘积形式的逆好得多。
+ */
+class BasisFactorization {
+private:
+  static constexpr double kPivotTolerance = 1e-11;
+  static constexpr double kThreshold = 0.1;
+
+  size_t m = 0;
+
+  // L：按主元顺序的列变换，第 k 个把主元行 l_pivot[k] 的值乘以
+  // l_value 后从 l_index 中的各行减去
+  std::vector<int> l_pivot;
+  std::vector<size_t> l_start;
+  std::vector<int> l_index;
+  std::vector<double> l_value;
+  std::vector<int> l_of_row; // 以该行为主元行的L变换，-1表示没有
+
+  // row_position[i]：以第 i 行为主元行的基位置
+  std::vector<int> row_position;
+
+  // U：对角元，非对角元按列 (行位置, 值) 与按行 (列位置, 值) 各存一份
+  std::vector<double> diagonal;
+  std::vector<std::vector<std::pair<int, double>>> u_columns;
+  std::vector<std::vector<std::pair<int, double>>> u_rows;
+  std::vector<int> order;
+  std::vector<int> rank;
+
+  // Forrest–Tomlin行变换：第 k 个为 w[r_slot[k]] -= Σ r_value·w[r_index]
+  std::vector<int> r_slot;
+  std::vector<size_t> r_start;
+  std::vector<int> r_index;
+  std::vector<double> r_value;
+  size_t updates = 0;
+
+  // 分解与更新用的临时数组；row_work、mark 用完清零
+  std::vector<double> scratch;
+  std::vector<double> row_work;
+  std::vector<char> mark;
+  std::vector<int> row_count; // 核中各行的非零元个数，用于选主元
+  std::vector<int> visited;
+  int stamp = 0;
+  std::vector<int> pattern;
+  std::vector<int> topo;
+  std::vector<std::pair<int, size_t>> dfs_stack;
+
+  // 消去基位置 p 的列，forced_row ≥ 0 时以该行为主元行；
+  // 数值奇异时返回 false，不修改分解
+  template <typename Column>
+  bool eliminate(int p, const Column &column, int forced_row = -1) {
+    pattern.clear();
+    column(p, [&](int row, double value) {
+      if (!mark[row]) {
+        mark[row] = 1;
+        pattern.push_back(row);
+      }
+      row_work[row] += value;
+    });
+
+    // 符号分析：L变换之间的依赖图上做深度优先搜索，逆后序即作用顺序
+    stamp++;
+    topo.clear();
+    size_t initial = pattern.size();
+    for (size_t s = 0; s < initial; s++) {
+      int start = pattern[s];
+      if (l_of_row[start] < 0 || visited[start] == stamp) {
+        continue;
+      }
+      visited[start] = stamp;
+      dfs_stack.push_back({start, l_start[l_of_row[start]]});
+      while (!dfs_stack.empty()) {
+        int row = dfs_stack.back().first;
+        size_t &next = dfs_stack.back().second;
+        int k = l_of_row[row];
+        if (next < l_start[k + 1]) {
+          int child = l_index[next++];
+          if (l_of_row[child] >= 0 && visited[child] != stamp) {
+            visited[child] = stamp;
+            dfs_stack.push_back({child, l_start[l_of_row[child]]});
+          }
+        } else {
+          topo.push_back(row);
+          dfs_stack.pop_back();
+        }
+      }
+    }
+    for (auto it = topo.rbegin(); it != topo.rend(); ++it) {
+      double v = row_work[*it];
+      if (v == 0.0) {
+        continue;
+      }
+      int k = l_of_row[*it];
+      for (size_t i = l_start[k]; i < l_start[k + 1]; i++) {
+        int r = l_index[i];
+        if (!mark[r]) {
+          mark[r] = 1;
+          pattern.push_back(r);
+        }
+        row_work[r] -= l_value[i] * v;
+      }
+    }
+
+    // 门限部分选主元
+    int pivot_row = -1;
+    if (forced_row >= 0 && std::abs(row_work[forced_row]) > kPivotTolerance) {
+      pivot_row = forced_row;
+    } else {
+      double largest = 0.0;
+      for (int r : pattern) {
+        if (row_position[r] < 0) {
+          largest = std::max(largest, std::abs(row_work[r]));
+        }
+      }
+      if (largest > kPivotTolerance) {
+        for (int r : pattern) {
+          double v = std::abs(row_work[r]);
+          if (row_position[r] < 0 && v >= kThreshold * largest &&
+              (pivot_row < 0 || row_count[r] < row_count[pivot_row] ||
+               (row_count[r] == row_count[pivot_row] &&
+                v > std::abs(row_work[pivot_row])))) {
+            pivot_row = r;
+          }
+        }
+      }
+    }
+    if (pivot_row < 0) {
+      for (int r : pattern) {
+        row_work[r] = 0.0;
+        mark[r] = 0;
+      }
+      return false;
+    }
+
+    double pivot = row_work[pivot_row];
+    row_position[pivot_row] = p;
+    diagonal[p] = pivot;
+    size_t l_begin = l_index.size();
+    for (int r : pattern) {
+      double v = row_work[r];
+      row_work[r] = 0.0;
+      mark[r] = 0;
+      if (r == pivot_row || v == 0.0) {
+        continue;
+      }
+      if (row_position[r] >= 0) {
+        int q = row_position[r];
+        u_columns[p].push_back({q, v});
+        u_rows[q].push_back({p, v});
+      } else {
+        l_index.push_back(r);
+        l_value.push_back(v / pivot);
+      }
+    }
+    if (l_index.size() > l_begin) {
+      l_of_row[pivot_row] = static_cast<int>(l_pivot.size());
+      l_pivot.push_back(pivot_row);
+      l_start.push_back(l_index.size());
+    }
+    rank[p] = static_cast<int>(order.size());
+    order.push_back(p);
+    return true;
+  }
+
+public:
+  /**
+   * @brief 分解 size × size 的基矩阵
+   * @param column column(p, emit) 对基位置 p 那一列的每个非零元调用
+   *               emit(row, value)
+   * @return 数值奇异的基位置改用第 row 行的单位列，返回这些 (位置, 行号)
+   */
+  template <typename Column>
+  std::vector<std::pair<int, int>> factorize(size_t size,
+                                             const Column &column) {
+    m = size;
+    l_pivot.clear();
+    l_start.assign(1, 0);
+    l_index.clear();
+    l_value.clear();
+    l_of_row.assign(m, -1);
+    row_position.assign(m, -1);
+    diagonal.assign(m, 0.0);
+    u_columns.assign(m, {});
+    u_rows.assign(m, {});
+    order.clear();
+    rank.assign(m, -1);
+    r_slot.clear();
+    r_start.assign(1, 0);
+    r_index.clear();
+    r_value.clear();
+    updates = 0;
+    scratch.assign(m, 0.0);
+    row_work.assign(m, 0.0);
+    mark.assign(m, 0);
+    visited.assign(m, 0);
+    stamp = 0;
+
+    // 基矩阵的按列与按行结构
+    std::vector<size_t> col_begin(m + 1, 0);
+    std::vector<int> col_rows;
+    std::vector<double> col_values;
+    for (size_t p = 0; p < m; p++) {
+      col_begin[p] = col_rows.size();
+      column(static_cast<int>(p), [&](int row, double value) {
+        col_rows.push_back(row);
+        col_values.push_back(value);
+      });
+    }
+    col_begin[m] = col_rows.size();
+    std::vector<size_t> row_begin(m + 1, 0);
+    for (int row : col_rows) {
+      row_begin[row + 1]++;
+    }
+    for (size_t i = 0; i < m; i++) {
+      row_begin[i + 1] += row_begin[i];
+    }
+    std::vector<int> row_cols(col_rows.size());
+    std::vector<size_t> fill(row_begin.begin(), row_begin.end() - 1);
+    for (size_t p = 0; p < m; p++) {
+      for (size_t k = col_begin[p]; k < col_begin[p + 1]; k++) {
+        row_cols[fill[col_rows[k]]++] = static_cast<int>(p);
+      }
+    }
+
+    // 1. 列单元素与行单元素：消元不产生填充
+    std::vector<int> col_count(m);
+    row_count.assign(m, 0);
+    std::vector<char> active_col(m, 1), active_row(m, 1);
+    std::vector<int> col_singles, row_singles;
+    for (size_t p = 0; p < m; p++) {
+      col_count[p] = static_cast<int>(col_begin[p + 1] - col_begin[p]);
+      if (col_count[p] == 1) {
+        col_singles.push_back(static_cast<int>(p));
+      }
+    }
+    for (size_t i = 0; i < m; i++) {
+      row_count[i] = static_cast<int>(row_begin[i + 1] - row_begin[i]);
+      if (row_count[i] == 1) {
+        row_singles.push_back(static_cast<int>(i));
+      }
+    }
+    std::vector<std::pair<int, int>> sequence; // (基位置, 主元行)
+    auto take = [&](int p, int r) {
+      active_col[p] = 0;
+      active_row[r] = 0;
+      for (size_t k = col_begin[p]; k < col_begin[p + 1]; k++) {
+        int row = col_rows[k];
+        if (active_row[row] && --row_count[row] == 1) {
+          row_singles.push_back(row);
+        }
+      }
+      for (size_t k = row_begin[r]; k < row_begin[r + 1]; k++) {
+        int q = row_cols[k];
+        if (active_col[q] && --col_count[q] == 1) {
+          col_singles.push_back(q);
+        }
+      }
+      sequence.push_back({p, r});
+    };
+    while (!col_singles.empty() || !row_singles.empty()) {
+      if (!col_singles.empty()) {
+        int p = col_singles.back();
+        col_singles.pop_back();
+        if (!active_col[p] || col_count[p] != 1) {
+          continue;
+        }
+        for (size_t k = col_begin[p]; k < col_begin[p + 1]; k++) {
+          if (active_row[col_rows[k]]) {
+            if (std::abs(col_values[k]) > kPivotTolerance) {
+              take(p, col_rows[k]);
+            }
+            break;
+          }
+        }
+      } else {
+        int r = row_singles.back();
+        row_singles.pop_back();
+        if (!active_row[r] || row_count[r] != 1) {
+          continue;
+        }
+        int p = -1;
+        for (size_t k = row_begin[r]; k < row_begin[r + 1]; k++) {
+          if (active_col[row_cols[k]]) {
+            p = row_cols[k];
+            break;
+          }
+        }
+        // 行单元素的主元列其余元素成为L的乘数，主元不能太小
+        double pivot = 0.0, largest = 0.0;
+        for (size_t k = col_begin[p]; k < col_begin[p + 1]; k++) {
+          if (active_row[col_rows[k]]) {
+            largest = std::max(largest, std::abs(col_values[k]));
+            if (col_rows[k] == r) {
+              pivot = std::abs(col_values[k]);
+            }
+          }
+        }
+        if (pivot > kPivotTolerance && pivot >= kThreshold * largest) {
+          take(p, r);
+        }
+      }
+    }
+
+    // 2. 核：按列非零元个数从少到多
+    std::vector<int> nucleus;
+    for (size_t p = 0; p < m; p++) {
+      if (active_col[p]) {
+        nucleus.push_back(static_cast<int>(p));
+      }
+    }
+    std::stable_sort(nucleus.begin(), nucleus.end(), [&](int a, int b) {
+      return col_count[a] < col_count[b];
+    });
+
+    std::vector<int> singular;
+    for (const auto &[p, r] : sequence) {
+      eliminate(p, column, r);
+    }
+    for (int p : nucleus) {
+      if (!eliminate(p, column)) {
+        singular.push_back(p);
+      }
+    }
+
+    // 未消元的行的单位列在 L 作用下不变，一定能选它自己为主元
+    std::vector<std::pair<int, int>> replaced;
+    size_t next_row = 0;
+    for (int p : singular) {
+      while (row_position[next_row] >= 0) {
+        next_row++;
+      }
+      int row = static_cast<int>(next_row);
+      eliminate(
+          p, [row](int, const auto &emit) { emit(row, 1.0); }, row);
+      replaced.push_back({p, row});
+    }
+    return replaced;
+  }
+
+  /**
+   * @brief 求解 B x = a：x 输入为按行号的右端项，输出为按基位置的解
+   * @param spike 非空时保存作用完 L 与 R、回代之前的向量，供 replace 使用
+   */
+  void ftran(std::vector<double> &x, std::vector<double> *spike = nullptr) {
+    if (x.size() != m) {
+      throw std::invalid_argument("向量长度与基矩阵阶数不一致");
+    }
+    for (size_t k = 0; k < l_pivot.size(); k++) {
+      double v = x[l_pivot[k]];
+      if (v == 0.0) {
+        continue;
+      }
+      for (size_t i = l_start[k]; i < l_start[k + 1]; i++) {
+        x[l_index[i]] -= l_value[i] * v;
+      }
+    }
+    for (size_t i = 0; i < m; i++) {
+      scratch[row_position[i]] = x[i];
+    }
+    for (size_t k = 0; k < r_slot.size(); k++) {
+      double sum = 0.0;
+      for (size_t i = r_start[k]; i < r_start[k + 1]; i++) {
+        sum += r_value[i] * scratch[r_index[i]];
+      }
+      scratch[r_slot[k]] -= sum;
+    }
+    if (spike != nullptr) {
+      *spike = scratch;
+    }
+    for (size_t k = m; k-- > 0;) {
+      int p = order[k];
+      if (scratch[p] == 0.0) {
+        continue;
+      }
+      double v = scratch[p] / diagonal[p];
+      scratch[p] = v;
+      for (const auto &[q, u] : u_columns[p]) {
+        scratch[q] -= u * v;
+      }
+    }
+    std::swap(x, scratch);
+  }
+
+  /**
+   * @brief 求解 B^T y = c：y 输入为按基位置的右端项，输出为按行号的解
+   */
+  void btran(std::vector<double> &y) {
+    if (y.size() != m) {
+      throw std::invalid_argument("向量长度与基矩阵阶数不一致");
+    }
+    // U^T 按行前推，右端项稀疏（如 e_r）时只访问用到的行
+    for (int p : order) {
+      if (y[p] == 0.0) {
+        continue;
+      }
+      double v = y[p] / diagonal[p];
+      y[p] = v;
+      for (const auto &[j, u] : u_rows[p]) {
+        y[j] -= u * v;
+      }
+    }
+    for (size_t k = r_slot.size(); k-- > 0;) {
+      double v = y[r_slot[k]];
+      if (v == 0.0) {
+        continue;
+      }
+      for (size_t i = r_start[k]; i < r_start[k + 1]; i++) {
+        y[r_index[i]] -= r_value[i] * v;
+      }
+    }
+    for (size_t i = 0; i < m; i++) {
+      scratch[i] = y[row_position[i]];
+    }
+    for (size_t k = l_pivot.size(); k-- > 0;) {
+      double sum = 0.0;
+      for (size_t i = l_start[k]; i < l_start[k + 1]; i++) {
+        sum += l_value[i] * scratch[l_index[i]];
+      }
+      scratch[l_pivot[k]] -= sum;
+    }
+    std::swap(y, scratch);
+  }
+
+  /**
+   * @brief Forrest–Tomlin更新：基位置 p 换成新列
+   * @param spike 新列调用 ftran 时保存的尖峰向量
+   * @return 新的对角元过小时返回 false，此时应重新分解
+   */
+  bool replace(int p, const std::vector<double> &spike) {
+    // 1. 删去 U 的第 p 列，取出第 p 行（只在 order 中排在 p 之后的列上）
+    auto erase_entry = [p](std::vector<std::pair<int, double>> &list) {
+      for (size_t k = 0; k < list.size(); k++) {
+        if (list[k].first == p) {
+          list[k] = list.back();
+          list.pop_back();
+          return;
+        }
+      }
+    };
+    for (const auto &entry : u_columns[p]) {
+      erase_entry(u_rows[entry.first]);
+    }
+    u_columns[p].clear();
+    using Item = std::pair<int, int>; // (rank, 基位置)
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> pending;
+    for (const auto &[j, u] : u_rows[p]) {
+      erase_entry(u_columns[j]);
+      row_work[j] = u;
+      mark[j] = 1;
+      pending.push({rank[j], j});
+    }
+    u_rows[p].clear();
+
+    // 2. 解 η^T U22 = 第 p 行（U22 为 p 之后的子矩阵）：按 rank 从小到大
+    //    确定 η_j，再沿 U 的第 j 行把它的贡献推给后面的列
+    size_t begin = r_index.size();
+    double new_diagonal = spike[p];
+    double scale = std::abs(spike[p]);
+    while (!pending.empty()) {
+      int j = pending.top().second;
+      pending.pop();
+      double v = row_work[j];
+      row_work[j] = 0.0;
+      mark[j] = 0;
+      if (v == 0.0) {
+        continue;
+      }
+      v /= diagonal[j];
+      r_index.push_back(j);
+      r_value.push_back(v);
+      new_diagonal -= v * spike[j];
+      for (const auto &[col, u] : u_rows[j]) {
+        row_work[col] -= v * u;
+        if (!mark[col]) {
+          mark[col] = 1;
+          pending.push({rank[col], col});
+        }
+      }
+    }
+    if (r_index.size() > begin) {
+      r_slot.push_back(p);
+      r_start.push_back(r_index.size());
+    }
+
+    // 3. 尖峰成为第 p 列，p 移到 order 末尾
+    for (size_t q = 0; q < m; q++) {
+      if (static_cast<int>(q) != p && spike[q] != 0.0) {
+        u_columns[p].push_back({static_cast<int>(q), spike[q]});
+        u_rows[q].push_back({p, spike[q]});
+        scale = std::max(scale, std::abs(spike[q]));
+      }
+    }
+    diagonal[p] = new_diagonal;
+    order.erase(order.begin() + rank[p]);
+    order.push_back(p);
+    for (size_t k = rank[p]; k < m; k++) {
+      rank[order[k]] = static_cast<int>(k);
+    }
+    updates++;
+    return std::abs(new_diagonal) > 1e-9 * std::max(scale, 1.0);
+  }
+
+  size_t update_count() const { return updates; }
+
+  /**
+   * @brief L、U与行变换的非零元总数
+   */
+  size_t nonzeros() const {
+    size_t total = m + l_index.size() + r_index.size();
+    for (const auto &col : u_columns) {
+      total += col.size();
+    }
+    return total;
+  }
+};
+
+/**
+ * @brief 稀疏修正单纯形法
+ *
+ * 求解 最大化 c^T x，满足 Ax ≤ b，x ≥ 0。A 以CSC存储（另存一份转置
+ * 用于按行计算主元行），松弛变量 s = b - Ax 隐式对应单位列，变量编号
+ * 0..n-1 为原变量、n..n+m-1 为松弛变量。与 LinearProgramming 的稠密
+ * 单纯形表不同，每次迭代只做：
+ * - 定价：Devex参考权重下的最大 d_j²/w_j（或Dantzig规则的最大检验数）
+ * - FTRAN：B^{-1} a_q，用 BasisFactorization 的LU与Forrest–Tomlin变换
+ * - 比值检验：Harris两趟比值检验，优先选绝对值大的主元
+ * - BTRAN：e_r^T B^{-1}，再按行扫描 A 得到主元行，增量更新检验数与权重
+ * 每 kRefactorInterval 次换基或更新不稳定时重新分解，并重算基变量与对偶
+ * 变量以消除累积误差；连续退化迭代过多时改用Bland规则防止循环。
+ *
+ * 原点不可行时用算法导论29.5节INITIALIZE-SIMPLEX的辅助变量 x0 做第一阶段。
+ *
+ * 热启动：set_rhs / set_objective 只替换 b 或 c，保留上一次的基与分解。
+ * 改 b 后原基仍对偶可行，solve() 用对偶单纯形法恢复原始可行性；改 c 后
+ * 原基仍原始可行，直接从该基继续原始单纯形迭代。
+ */
+class RevisedSimplex {
+public:
+  enum class Pricing { Dantzig, Devex };
+
+private:
+  enum class Outcome {
+    Optimal,
+    Unbounded,
+    Infeasible,
+    IterationLimit,
+    NumericalFailure
+  };
+
+  static constexpr double kPrimalTolerance = 1e-9;
+  static constexpr double kDualTolerance = 1e-9;
+  static constexpr double kPivotTolerance = 1e-9;
+  static constexpr size_t kRefactorInterval = 100;
+  static constexpr size_t kBlandThreshold = 50;
+
+  SparseMatrixCSC A;
+  SparseMatrixCSC At; // A 的转置，第 i 列为 A 的第 i 行
+  std::vector<double> b;
+  std::vector<double> c;
+  size_t m;
+  size_t n;
+  int artificial; // 第一阶段的辅助变量 x0，编号 n + m
+  Pricing pricing;
+  size_t max_iterations;
+
+  BasisFactorization factor;
+  bool factor_valid;
+  bool phase_one;
+  std::vector<int> basis;       // basis[p]：基位置 p 上的变量
+  std::vector<int> position;    // 变量所在的基位置，非基变量为 -1
+  std::vector<double> cost;     // 当前阶段的目标系数
+  std::vector<double> x_basic;  // 基变量取值，按基位置
+  std::vector<double> reduced;  // 检验数 d_j = cost_j - y^T a_j
+  std::vector<double> weights;  // Devex参考权重
+  std::vector<double> duals;    // 对偶变量 y，按行
+  size_t iterations;
+  size_t refactorizations;
+  size_t degenerate_run;
+
+  std::vector<double> column;    // B^{-1} a_q，按基位置
+  std::vector<double> spike;     // 与 column 对应的Forrest–Tomlin尖峰
+  std::vector<double> rho;       // e_r^T B^{-1}，按行
+  std::vector<double> row_alpha; // 主元行 α_rj，按变量
+  std::vector<int> row_touched;
+  std::vector<char> row_mark;
+
+  // 检验数为正的可进基变量，定价只扫描这张表
+  std::vector<int> candidates;
+  std::vector<int> candidate_slot; // 在 candidates 中的下标，-1 表示不在
+
+  size_t variable_count() const { return n + m + 1; }
+
+  template <typename Emit> void for_each_in_column(int v, Emit &&emit) const {
+    if (v < static_cast<int>(n)) {
+      const auto &start = A.get_col_start();
+      for (size_t k = start[v]; k < start[v + 1]; k++) {
+        emit(A.get_row_index()[k], A.get_values()[k]);
+      }
+    } else if (v < artificial) {
+      emit(v - static_cast<int>(n), 1.0);
+    } else {
+      for (size_t i = 0; i < m; i++) {
+        emit(static_cast<int>(i), -1.0);
+      }
+    }
+  }
+
+  bool eligible(int j) const {
+    return position[j] < 0 && (j != artificial || phase_one);
+  }
+
+  void set_slack_basis() {
+    position.assign(variable_count(), -1);
+    for (size_t p = 0; p < m; p++) {
+      basis[p] = static_cast<int>(n + p);
+      position[n + p] = static_cast<int>(p);
+    }
+    factor_valid = false;
+  }
+
+  void set_phase_two_costs() {
+    cost.assign(variable_count(), 0.0);
+    std::copy(c.begin(), c.end(), cost.begin());
+  }
+
+  void refactor() {
+    auto replaced = factor.factorize(m, [this](int p, const auto &emit) {
+      for_each_in_column(basis[p], emit);
+    });
+    for (const auto &[p, row] : replaced) {
+      position[basis[p]] = -1;
+      basis[p] = static_cast<int>(n) + row;
+      position[basis[p]] = p;
+    }
+    factor_valid = true;
+    refactorizations++;
+  }
+
+  void compute_primal() {
+    x_basic = b;
+    factor.ftran(x_basic);
+  }
+
+  void compute_duals() {
+    duals.resize(m);
+    for (size_t p = 0; p < m; p++) {
+      duals[p] = cost[basis[p]];
+    }
+    factor.btran(duals);
+    reduced.assign(variable_count(), 0.0);
+    double dual_sum = 0.0;
+    for (size_t i = 0; i < m; i++) {
+      dual_sum += duals[i];
+      reduced[n + i] = -duals[i];
+    }
+    const auto &start = A.get_col_start();
+    for (size_t j = 0; j < n; j++) {
+      double d = cost[j];
+      for (size_t k = start[j]; k < start[j + 1]; k++) {
+        d -= A.get_values()[k] * duals[A.get_row_index()[k]];
+      }
+      reduced[j] = d;
+    }
+    reduced[artificial] = cost[artificial] + dual_sum;
+    for (int v : basis) {
+      reduced[v] = 0.0;
+    }
+    for (int j : candidates) {
+      candidate_slot[j] = -1;
+    }
+    candidates.clear();
+    for (size_t j = 0; j < variable_count(); j++) {
+      update_candidate(static_cast<int>(j));
+    }
+  }
+
+  void update_candidate(int j) {
+    bool wanted = eligible(j) && reduced[j] > kDualTolerance;
+    if (wanted && candidate_slot[j] < 0) {
+      candidate_slot[j] = static_cast<int>(candidates.size());
+      candidates.push_back(j);
+    } else if (!wanted && candidate_slot[j] >= 0) {
+      int last = candidates.back();
+      candidates[candidate_slot[j]] = last;
+      candidate_slot[last] = candidate_slot[j];
+      candidates.pop_back();
+      candidate_slot[j] = -1;
+    }
+  }
+
+  void load_column(int q) {
+    column.assign(m, 0.0);
+    for_each_in_column(q, [this](int row, double value) {
+      column[row] += value;
+    });
+    factor.ftran(column, &spike);
+  }
+
+  void touch(int j, double value) {
+    if (!row_mark[j]) {
+      row_mark[j] = 1;
+      row_touched.push_back(j);
+    }
+    row_alpha[j] += value;
+  }
+
+  // 主元行 α_rj = (e_r^T B^{-1}) a_j，只对 ρ 的非零行扫描 A 的对应行
+  void compute_pivot_row(int r) {
+    for (int j : row_touched) {
+      row_alpha[j] = 0.0;
+      row_mark[j] = 0;
+    }
+    row_touched.clear();
+    rho.assign(m, 0.0);
+    rho[r] = 1.0;
+    factor.btran(rho);
+    const auto &start = At.get_col_start();
+    double artificial_alpha = 0.0;
+    for (size_t i = 0; i < m; i++) {
+      double v = rho[i];
+      if (std::abs(v) < 1e-14) {
+        continue;
+      }
+      touch(static_cast<int>(n + i), v);
+      artificial_alpha -= v;
+      for (size_t k = start[i]; k < start[i + 1]; k++) {
+        touch(At.get_row_index()[k], v * At.get_values()[k]);
+      }
+    }
+    if (phase_one) {
+      touch(artificial, artificial_alpha);
+    }
+  }
+
+  bool use_bland() const { return degenerate_run >= kBlandThreshold; }
+
+  int price() const {
+    int best = -1;
+    double best_score = 0.0;
+    for (int j : candidates) {
+      if (use_bland()) {
+        if (best < 0 || j < best) {
+          best = j;
+        }
+        continue;
+      }
+      double d = reduced[j];
+      double score = pricing == Pricing::Devex ? d * d / weights[j] : d;
+      if (score > best_score) {
+        best_score = score;
+        best = j;
+      }
+    }
+    return best;
+  }
+
+  // 原始比值检验，column 中为 B^{-1} a_q
+  int primal_ratio_test() const {
+    int leave = -1;
+    if (use_bland()) {
+      // 最小比值中出基变量编号最小者
+      double best = std::numeric_limits<double>::infinity();
+      for (size_t i = 0; i < m; i++) {
+        if (column[i] > kPivotTolerance) {
+          best = std::min(best, std::max(x_basic[i], 0.0) / column[i]);
+        }
+      }
+      for (size_t i = 0; i < m; i++) {
+        if (column[i] > kPivotTolerance &&
+            std::max(x_basic[i], 0.0) / column[i] <= best + 1e-12 &&
+            (leave < 0 || basis[i] < basis[leave])) {
+          leave = static_cast<int>(i);
+        }
+      }
+      return leave;
+    }
+    // Harris：先求放宽可行性容差后的最大步长，再在不超过它的行中选最大主元
+    double bound = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < m; i++) {
+      if (column[i] > kPivotTolerance) {
+        bound = std::min(bound, (std::max(x_basic[i], 0.0) + kPrimalTolerance) /
+                                    column[i]);
+      }
+    }
+    double best_alpha = 0.0;
+    for (size_t i = 0; i < m; i++) {
+      if (column[i] > kPivotTolerance &&
+          std::max(x_basic[i], 0.0) / column[i] <= bound &&
+          column[i] > best_alpha) {
+        best_alpha = column[i];
+        leave = static_cast<int>(i);
+      }
+    }
+    return leave;
+  }
+
+  int choose_leaving_row() const {
+    int leave = -1;
+    double worst = -kPrimalTolerance;
+    for (size_t i = 0; i < m; i++) {
+      if (x_basic[i] >= -kPrimalTolerance) {
+        continue;
+      }
+      if (use_bland()) {
+        if (leave < 0 || basis[i] < basis[leave]) {
+          leave = static_cast<int>(i);
+        }
+      } else if (x_basic[i] < worst) {
+        worst = x_basic[i];
+        leave = static_cast<int>(i);
+      }
+    }
+    return leave;
+  }
+
+  // 对偶比值检验：主元行中 α_rj < 0 的非基变量，保持 d_j ≤ 0
+  int dual_ratio_test() const {
+    int enter = -1;
+    if (use_bland()) {
+      double best = std::numeric_limits<double>::infinity();
+      for (int j : row_touched) {
+        if (row_alpha[j] < -kPivotTolerance && eligible(j)) {
+          best = std::min(best, std::max(reduced[j] / row_alpha[j], 0.0));
+        }
+      }
+      for (int j : row_touched) {
+        if (row_alpha[j] < -kPivotTolerance && eligible(j) &&
+            std::max(reduced[j] / row_alpha[j], 0.0) <= best + 1e-12 &&
+            (enter < 0 || j < enter)) {
+          enter = j;
+        }
+      }
+      return enter;
+    }
+    double bound = std::numeric_limits<double>::infinity();
+    for (int j : row_touched) {
+      double a = row_alpha[j];
+      if (a < -kPivotTolerance && eligible(j)) {
+        bound = std::min(bound, (std::min(reduced[j], 0.0) - kDualTolerance) / a);
+      }
+    }
+    double best_alpha = 0.0;
+    for (int j : row_touched) {
+      double a = row_alpha[j];
+      if (a < -kPivotTolerance && eligible(j) &&
+          std::min(reduced[j], 0.0) / a <= bound && -a > best_alpha) {
+        best_alpha = -a;
+        enter = j;
+      }
+    }
+    return enter;
+  }
+
+  // 以 q 进基、基位置 r 出基；column/spike 与主元行都已算好
+  void apply_pivot(int q, int r) {
+    double alpha_rq = column[r];
+    int leaving = basis[r];
+
+    double step = reduced[q] / alpha_rq;
+    double weight_q = weights[q];
+    for (int j : row_touched) {
+      if (position[j] >= 0 || j == q) {
+        continue;
+      }
+      double a = row_alpha[j];
+      reduced[j] -= step * a;
+      double ratio = a / alpha_rq;
+      weights[j] = std::max(weights[j], ratio * ratio * weight_q);
+    }
+    reduced[leaving] = -step;
+    reduced[q] = 0.0;
+    weights[leaving] = std::max(weight_q / (alpha_rq * alpha_rq), 1.0);
+    if (weights[leaving] > 1e6) {
+      std::fill(weights.begin(), weights.end(), 1.0); // 重置参考框架
+    }
+
+    double theta = x_basic[r] / alpha_rq;
+    for (size_t i = 0; i < m; i++) {
+      if (column[i] != 0.0) {
+        x_basic[i] -= theta * column[i];
+      }
+    }
+    x_basic[r] = theta;
+
+    position[leaving] = -1;
+    basis[r] = q;
+    position[q] = r;
+    for (int j : row_touched) {
+      update_candidate(j);
+    }
+    update_candidate(leaving);
+    update_candidate(q);
+    iterations++;
+    if (factor.update_count() >= kRefactorInterval ||
+        !factor.replace(r, spike)) {
+      refactor();
+      compute_primal();
+      compute_duals();
+    }
+  }
+
+  Outcome run_primal() {
+    while (iterations < max_iterations) {
+      int q = price();
+      if (q < 0) {
+        compute_duals(); // 用重新计算的检验数确认最优
+        q = price();
+        if (q < 0) {
+          return Outcome::Optimal;
+        }
+      }
+      load_column(q);
+      int r = primal_ratio_test();
+      if (r < 0) {
+        return Outcome::Unbounded;
+      }
+      if (x_basic[r] < -kPrimalTolerance) {
+        // 原始单纯形的基应当可行：重新分解并重算，仍不可行就放弃
+        iterations++;
+        refactor();
+        compute_primal();
+        compute_duals();
+        if (!primal_feasible()) {
+          return Outcome::NumericalFailure;
+        }
+        continue;
+      }
+      compute_pivot_row(r);
+      if (x_basic[r] <= kPrimalTolerance) {
+        x_basic[r] = std::max(x_basic[r], 0.0); // 容差内的退化步
+        degenerate_run++;
+      } else {
+        degenerate_run = 0;
+      }
+      apply_pivot(q, r);
+    }
+    return Outcome::IterationLimit;
+  }
+
+  Outcome run_dual() {
+    while (iterations < max_iterations) {
+      int r = choose_leaving_row();
+      if (r < 0) {
+        compute_primal();
+        r = choose_leaving_row();
+        if (r < 0) {
+          return Outcome::Optimal;
+        }
+      }
+      compute_pivot_row(r);
+      int q = dual_ratio_test();
+      if (q < 0) {
+        return Outcome::Infeasible; // 该行给出 Farkas 证书
+      }
+      load_column(q);
+      if (std::abs(column[r]) < kPivotTolerance) {
+        // 主元行与主元列的数值不一致：重新分解后再选
+        iterations++;
+        refactor();
+        compute_primal();
+        compute_duals();
+        continue;
+      }
+      if (std::abs(reduced[q]) <= kDualTolerance) {
+        degenerate_run++;
+      } else {
+        degenerate_run = 0;
+      }
+      apply_pivot(q, r);
+    }
+    return Outcome::IterationLimit;
+  }
+
+  // INITIALIZE-SIMPLEX：最大化 -x0，x0 在最负的行进基后松弛基即可行。
+  // 松弛基本身可行（b ≥ 0）时不需要 x0，直接进入第二阶段
+  Outcome run_phase_one() {
+    set_slack_basis();
+    refactor();
+    compute_primal();
+    std::fill(weights.begin(), weights.end(), 1.0);
+    degenerate_run = 0;
+    if (primal_feasible()) {
+      set_phase_two_costs();
+      compute_duals();
+      return Outcome::Optimal;
+    }
+    phase_one = true;
+    cost.assign(variable_count(), 0.0);
+    cost[artificial] = -1.0;
+    compute_duals();
+
+    int r = static_cast<int>(
+        std::min_element(x_basic.begin(), x_basic.end()) - x_basic.begin());
+    load_column(artificial);
+    compute_pivot_row(r);
+    apply_pivot(artificial, r);
+
+    Outcome outcome = run_primal();
+    if (outcome != Outcome::Optimal) {
+      // x0 还在基中，这个基不能留给热启动
+      phase_one = false;
+      set_slack_basis();
+      return outcome;
+    }
+    double b_scale = 1.0;
+    for (double v : b) {
+      b_scale = std::max(b_scale, std::abs(v));
+    }
+    int p = position[artificial];
+    if (p >= 0 && x_basic[p] > 1e-7 * b_scale) {
+      phase_one = false;
+      set_slack_basis();
+      return Outcome::Infeasible;
+    }
+    if (p >= 0) {
+      // x0 以0值留在基中：与主元行中绝对值最大的变量做一次退化换基
+      compute_pivot_row(p);
+      int enter = -1;
+      double best = 0.0;
+      for (int j : row_touched) {
+        if (j != artificial && position[j] < 0 &&
+            std::abs(row_alpha[j]) > best) {
+          best = std::abs(row_alpha[j]);
+          enter = j;
+        }
+      }
+      if (enter >= 0) {
+        load_column(enter);
+        x_basic[p] = 0.0;
+        apply_pivot(enter, p);
+      }
+    }
+    phase_one = false;
+    set_phase_two_costs();
+    compute_duals();
+    std::fill(weights.begin(), weights.end(), 1.0);
+    degenerate_run = 0;
+    return Outcome::Optimal;
+  }
+
+  bool primal_feasible() const {
+    for (double v : x_basic) {
+      if (v < -kPrimalTolerance) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool dual_feasible() const {
+    for (size_t j = 0; j < variable_count(); j++) {
+      if (eligible(static_cast<int>(j)) && reduced[j] > kDualTolerance) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+public:
+  /**
+   * @param A m × n 约束矩阵
+   * @param b 长度为 m 的右端项，可以有负数
+   * @param c 长度为 n 的目标函数系数
+   * @throws std::invalid_argument 维度不一致或问题为空
+   */
+  RevisedSimplex(SparseMatrixCSC A, std::vector<double> b,
+                 std::vector<double> c, Pricing pricing = Pricing::Devex)
+      : A(std::move(A)), b(std::move(b)), c(std::move(c)),
+        pricing(pricing), factor_valid(false), phase_one(false),
+        iterations(0), refactorizations(0), degenerate_run(0) {
+    m = this->A.get_rows();
+    n = this->A.get_cols();
+    if (m == 0 || n == 0) {
+      throw std::invalid_argument("输入矩阵或向量不能为空");
+    }
+    if (this->b.size() != m) {
+      throw std::invalid_argument("约束右端项b的长度必须等于约束矩阵A的行数");
+    }
+    if (this->c.size() != n) {
+      throw std::invalid_argument("目标函数系数c的长度必须等于约束矩阵A的列数");
+    }
+    At = this->A.transpose();
+    artificial = static_cast<int>(n + m);
+    max_iterations = std::max<size_t>(10000, 20 * (m + n));
+    basis.resize(m);
+    set_slack_basis();
+    weights.assign(variable_count(), 1.0);
+    row_alpha.assign(variable_count(), 0.0);
+    row_mark.assign(variable_count(), 0);
+    candidate_slot.assign(variable_count(), -1);
+  }
+
+  /**
+   * @brief 从当前基出发求解；第一次调用从松弛基出发
+   */
+  LinearProgramming::LPResult solve() {
+    iterations = 0;
+    refactorizations = 0;
+    degenerate_run = 0;
+    if (position[artificial] >= 0) {
+      set_slack_basis(); // 第一阶段留在基中的 x0 对新的 b、c 没有意义
+    }
+    if (!factor_valid) {
+      refactor();
+    }
+    set_phase_two_costs();
+    compute_primal();
+    compute_duals();
+
+    Outcome outcome = Outcome::Optimal;
+    if (!primal_feasible()) {
+      outcome = dual_feasible() ? run_dual() : run_phase_one();
+    }
+    if (outcome == Outcome::Optimal) {
+      outcome = run_primal();
+    }
+
+    LinearProgramming::LPResult result;
+    switch (outcome) {
+    case Outcome::Optimal:
+      result.feasible = true;
+      result.bounded = true;
+      result.status = "单纯形法收敛到最优解";
+      break;
+    case Outcome::Unbounded:
+      result.feasible = true;
+      result.bounded = false;
+      result.status = "问题无界";
+      break;
+    case Outcome::Infeasible:
+      result.status = "问题不可行";
+      return result;
+    case Outcome::IterationLimit:
+      result.status = "达到最大迭代次数";
+      break;
+    case Outcome::NumericalFailure:
+      result.status = "数值误差过大，求解失败";
+      return result;
+    }
+    result.solution.assign(n, 0.0);
+    for (size_t p = 0; p < m; p++) {
+      if (basis[p] < static_cast<int>(n)) {
+        result.solution[basis[p]] = std::max(x_basic[p], 0.0);
+      }
+    }
+    for (size_t j = 0; j < n; j++) {
+      result.objective_value += c[j] * result.solution[j];
+    }
+    return result;
+  }
+
+  /**
+   * @brief 替换右端项，保留当前基（下一次 solve 走对偶单纯形法）
+   */
+  void set_rhs(const std::vector<double> &new_b) {
+    if (new_b.size() != m) {
+      throw std::invalid_argument("约束右端项b的长度必须等于约束矩阵A的行数");
+    }
+    b = new_b;
+  }
+
+  /**
+   * @brief 替换目标函数系数，保留当前基（下一次 solve 继续原始单纯形）
+   */
+  void set_objective(const std::vector<double> &new_c) {
+    if (new_c.size() != n) {
+      throw std::invalid_argument("目标函数系数c的长度必须等于约束矩阵A的列数");
+    }
+    c = new_c;
+  }
+
+  /**
+   * @brief 丢弃当前基，下一次 solve 从松弛基冷启动
+   */
+  void reset() {
+    set_slack_basis();
+    std::fill(weights.begin(), weights.end(), 1.0);
+  }
+
+  void set_max_iterations(size_t limit) { max_iterations = limit; }
+
+  /**
+   * @brief 最近一次 solve 得到的对偶变量 y（按约束行），最优时 y ≥ 0 且
+   *        A^T y ≥ c、b^T y 等于最优值
+   */
+  const std::vector<double> &get_duals() const { return duals; }
+
+  /**
+   * @brief 当前基：第 p 个元素为基位置 p 上的变量，n 及以上为松弛变量
+   */
+  const std::vector<int> &get_basis() const { return basis; }
+
+  // 最近一次 solve 的换基次数与重新分解次数
+  size_t get_iterations() const { return iterations; }
+
+  size_t get_refactorizations() const { return refactorizations; }
+
+  size_t factor_nonzeros() const { return factor.nonzeros(); }
+};
+
+/**
+ * @brief 用稀疏修正单纯形法求解稠密输入
+ */
+inline LinearProgramming::LPResult
+LinearProgramming::revised_simplex(const std::vector<std::vector<double>> &A,
+                                   const std::vector<double> &b,
+                                   const std::vector<double> &c) {
+  LPResult result;
+  try {
+    RevisedSimplex solver(SparseMatrixCSC::from_dense(A), b, c);
+    result = solver.solve();
+  } catch (const std::exception &e) {
+    result.status = "求解失败: " + std::string(e.what());
+  }
+  return result;
+}
+
+/**
+ * @brief Mehrotra预测-校正原始对偶内点法
+ *
+ * 求解 最大化 c^T x，满足 Ax ≤ b，x ≥ 0。加入松弛变量 s 写成标准型
+ *   最小化 -c^T x，满足 Ax + s = b，v = (x, s) ≥ 0，
+ * 其对偶为 最大化 b^T y，满足 A^T y + z_x = -c，y + z_s = 0，z ≥ 0。
+ *
+ * 每次迭代解两个牛顿方程组，消去 Δv、Δz 后都化为同一个法方程
+ *   (A D_x A^T + D_s) Δy = r，D = V Z^{-1}，
+ * 由松弛变量贡献的对角项保证它总是正定的。法方程的非零结构只取决于 A，
+ * 构造时做一次 SparseCholesky 符号分析，迭代中只重新数值分解，预测步
+ * （仿射方向）与校正步共用这次分解。中心化参数取 σ = (μ_aff / μ)³，
+ * 原始与对偶分别取步长，为到边界距离的 kStepScale 倍；初始点用
+ * Mehrotra 的启发式。
+ *
+ * 结果是逼近最优面的严格内点，没有基；需要顶点解或热启动时用
+ * RevisedSimplex。每次迭代检查 y 能否构成 Farkas 不可行证明（按
+ * b^T w = -1 缩放后的残差）；原始迭代发散时检查无界射线，再用目标为0
+ * 的同一问题判定可行域是否非空，区分无界与不可行。达到最大迭代次数时
+ * 不返回解。
+ */
+class InteriorPointSolver {
+private:
+  static constexpr double kTolerance = 1e-8;
+  static constexpr double kStepScale = 0.995;
+  static constexpr double kDivergence = 1e10;
+  static constexpr double kCertificateTolerance = 1e-6;
+
+  SparseMatrixCSC A;
+  SparseMatrixCSC At; // A 的转置，第 i 列为 A 的第 i 行
+  std::vector<double> b;
+  std::vector<double> c;
+  size_t m;
+  size_t n;
+  size_t max_iterations;
+  size_t iterations;
+  int feasibility; // 最近一次 solve 的可行性：1 可行，0 不可行，-1 未判定
+
+  SparseMatrixCSC normal_pattern; // A A^T + I 的上三角
+  SparseCholesky cholesky;
+  std::vector<double> normal_values;
+  std::vector<double> work;
+
+  // 标准型变量：v = (x, s)、z 长度 n + m，y 长度 m
+  std::vector<double> v;
+  std::vector<double> y;
+  std::vector<double> z;
+  std::vector<double> scaling; // D = V Z^{-1}
+  std::vector<double> duals;
+
+  static SparseMatrixCSC build_normal_pattern(const SparseMatrixCSC &A,
+                                              const SparseMatrixCSC &At) {
+    size_t m = A.get_rows();
+    std::vector<SparseTriplet> entries;
+    std::vector<size_t> mark(m, m);
+    for (size_t i = 0; i < m; i++) {
+      mark[i] = i;
+      entries.push_back({static_cast<int>(i), static_cast<int>(i), 1.0});
+      for (size_t p = At.get_col_start()[i]; p < At.get_col_start()[i + 1];
+           p++) {
+        int j = At.get_row_index()[p];
+        for (size_t q = A.get_col_start()[j]; q < A.get_col_start()[j + 1];
+             q++) {
+          size_t k = A.get_row_index()[q];
+          if (k > i) {
+            break;
+          }
+          if (mark[k] != i) {
+            mark[k] = i;
+            entries.push_back({static_cast<int>(k), static_cast<int>(i), 1.0});
+          }
+        }
+      }
+    }
+    return SparseMatrixCSC(m, m, entries);
+  }
+
+  // 标准型目标系数 ĉ = (-c, 0)
+  double objective_coefficient(size_t j) const { return j < n ? -c[j] : 0.0; }
+
+  // Â v = A x + s
+  std::vector<double> apply(const std::vector<double> &u) const {
+    std::vector<double> x(u.begin(), u.begin() + n);
+    std::vector<double> result = A.multiply(x);
+    for (size_t i = 0; i < m; i++) {
+      result[i] += u[n + i];
+    }
+    return result;
+  }
+
+  // Â^T w = (A^T w, w)
+  std::vector<double> apply_transpose(const std::vector<double> &w) const {
+    std::vector<double> result = A.multiply_transpose(w);
+    result.insert(result.end(), w.begin(), w.end());
+    return result;
+  }
+
+  /**
+   * @brief 按当前 D 组装 A D_x A^T + D_s 的上三角并分解
+   */
+  void factorize_normal_equations() {
+    const auto &a_start = A.get_col_start();
+    const auto &a_row = A.get_row_index();
+    const auto &a_value = A.get_values();
+    const auto &t_start = At.get_col_start();
+    const auto &t_row = At.get_row_index();
+    const auto &t_value = At.get_values();
+    const auto &m_start = normal_pattern.get_col_start();
+    const auto &m_row = normal_pattern.get_row_index();
+    for (size_t i = 0; i < m; i++) {
+      for (size_t p = t_start[i]; p < t_start[i + 1]; p++) {
+        int j = t_row[p];
+        double w = t_value[p] * scaling[j];
+        for (size_t q = a_start[j]; q < a_start[j + 1]; q++) {
+          size_t k = a_row[q];
+          if (k > i) {
+            break;
+          }
+          work[k] += a_value[q] * w;
+        }
+      }
+      work[i] += scaling[n + i];
+      for (size_t p = m_start[i]; p < m_start[i + 1]; p++) {
+        normal_values[p] = work[m_row[p]];
+        work[m_row[p]] = 0.0;
+      }
+    }
+    cholesky.factorize(normal_values);
+  }
+
+  /**
+   * @brief 解牛顿方程组
+   *   Â Δv = -r_b，Â^T Δy + Δz = -r_c，Z Δv + V Δz = -r_xz
+   */
+  void newton_direction(const std::vector<double> &rb,
+                        const std::vector<double> &rc,
+                        const std::vector<double> &rxz,
+                        std::vector<double> &dv, std::vector<double> &dy,
+                        std::vector<double> &dz) const {
+    size_t total = n + m;
+    std::vector<double> t(total);
+    for (size_t j = 0; j < total; j++) {
+      t[j] = rxz[j] / z[j] - scaling[j] * rc[j];
+    }
+    std::vector<double> rhs = apply(t);
+    for (size_t i = 0; i < m; i++) {
+      rhs[i] -= rb[i];
+    }
+    dy = cholesky.solve(rhs);
+    dz = apply_transpose(dy);
+    dv.resize(total);
+    for (size_t j = 0; j < total; j++) {
+      dz[j] = -rc[j] - dz[j];
+      dv[j] = -rxz[j] / z[j] - scaling[j] * dz[j];
+    }
+  }
+
+  static double max_step(const std::vector<double> &u,
+                         const std::vector<double> &du) {
+    double alpha = 1.0;
+    for (size_t j = 0; j < u.size(); j++) {
+      if (du[j] < 0.0) {
+        alpha = std::min(alpha, -u[j] / du[j]);
+      }
+    }
+    return alpha;
+  }
+
+  static double dot(const std::vector<double> &a,
+                    const std::vector<double> &b) {
+    double sum = 0.0;
+    for (size_t i = 0; i < a.size(); i++) {
+      sum += a[i] * b[i];
+    }
+    return sum;
+  }
+
+  static double norm(const std::vector<double> &a) {
+    return std::sqrt(dot(a, a));
+  }
+
+  static double max_abs(const std::vector<double> &a) {
+    double result = 0.0;
+    for (double value : a) {
+      result = std::max(result, std::abs(value));
+    }
+    return result;
+  }
+
+  /**
+   * @brief 当前 y 是否给出不可行证明：w = max(-y, 0)，A^T w ≥ 0 且
+   *        b^T w < 0（Farkas引理）。按 b^T w = -1 缩放后检查 A^T w 的
+   *        负分量；原始不可行时对偶迭代沿这样的射线增长，每次迭代都检查，
+   *        不必等到发散
+   */
+  bool farkas_certificate() const {
+    std::vector<double> w(m);
+    for (size_t i = 0; i < m; i++) {
+      w[i] = std::max(-y[i], 0.0);
+    }
+    double gap = -dot(b, w);
+    if (!(gap > 0.0)) {
+      return false;
+    }
+    // A^T y + z = -c 使 A^T w 的负分量停在 |c| 的量级，容差随 c 放大
+    double tolerance = kCertificateTolerance * (1.0 + max_abs(c)) * gap;
+    std::vector<double> aw = A.multiply_transpose(w);
+    for (double value : aw) {
+      if (value < -tolerance) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief 发散的 x 方向是否给出无界射线：d = x / ||x|| ≥ 0，
+   *        A d ≤ 0 且 c^T d > 0；还需要 primal_feasibility() 确认可行域非空
+   */
+  bool unbounded_certificate() const {
+    std::vector<double> d(v.begin(), v.begin() + n);
+    double scale = max_abs(d);
+    if (!(scale > 0.0)) {
+      return false;
+    }
+    for (double &value : d) {
+      value /= scale;
+    }
+    std::vector<double> ad = A.multiply(d);
+    for (double value : ad) {
+      if (value > kCertificateTolerance) {
+        return false;
+      }
+    }
+    return dot(c, d) > kCertificateTolerance;
+  }
+
+  /**
+   * @brief 可行性检验：目标为0的同一问题对偶有界，内点法或者收敛，
+   *        或者给出 Farkas 证明
+   * @return 1 可行，0 不可行，-1 未能判定（达到最大迭代次数或发散）
+   */
+  int primal_feasibility() const {
+    InteriorPointSolver feasibility(A, b, std::vector<double>(n, 0.0));
+    feasibility.set_max_iterations(max_iterations);
+    feasibility.solve();
+    return feasibility.feasibility;
+  }
+
+  /**
+   * @brief 发散或达到最大迭代次数时，用目标为0的同一问题再判定一次可行性：
+   *        那里对偶恒可行（y = 0），A^T y + z = 0 没有 c 的偏移，
+   *        不可行时 y 给出的 Farkas 射线更干净。c = 0 时不再递归
+   */
+  LinearProgramming::LPResult &unresolved(LinearProgramming::LPResult &result) {
+    if (max_abs(c) > 0.0 && primal_feasibility() == 0) {
+      feasibility = 0;
+      result.status = "问题不可行";
+    }
+    return result;
+  }
+
+  /**
+   * @brief Mehrotra初始点：ÂÂ^T 下的最小范数解，再平移到严格正
+   */
+  void initial_point() {
+    size_t total = n + m;
+    std::fill(scaling.begin(), scaling.end(), 1.0);
+    factorize_normal_equations();
+    v = apply_transpose(cholesky.solve(b));
+    std::vector<double> c_hat(total);
+    for (size_t j = 0; j < total; j++) {
+      c_hat[j] = objective_coefficient(j);
+    }
+    y = cholesky.solve(apply(c_hat));
+    z = apply_transpose(y);
+    for (size_t j = 0; j < total; j++) {
+      z[j] = c_hat[j] - z[j];
+    }
+
+    double shift_v = std::max(-1.5 * *std::min_element(v.begin(), v.end()),
+                              0.0);
+    double shift_z = std::max(-1.5 * *std::min_element(z.begin(), z.end()),
+                              0.0);
+    for (size_t j = 0; j < total; j++) {
+      v[j] += shift_v;
+      z[j] += shift_z;
+    }
+    double product = dot(v, z);
+    double sum_v = 0.0, sum_z = 0.0;
+    for (size_t j = 0; j < total; j++) {
+      sum_v += v[j];
+      sum_z += z[j];
+    }
+    double extra_v = sum_z > 0.0 ? 0.5 * product / sum_z : 1.0;
+    double extra_z = sum_v > 0.0 ? 0.5 * product / sum_v : 1.0;
+    for (size_t j = 0; j < total; j++) {
+      v[j] = std::max(v[j] + extra_v, 1e-4);
+      z[j] = std::max(z[j] + extra_z, 1e-4);
+    }
+  }
+
+public:
+  /**
+   * @param A m × n 约束矩阵
+   * @param b 长度为 m 的右端项
+   * @param c 长度为 n 的目标函数系数
+   * @throws std::invalid_argument 维度不一致或问题为空
+   */
+  InteriorPointSolver(SparseMatrixCSC A, std::vector<double> b,
+                      std::vector<double> c)
+      : A(std::move(A)), At(this->A.transpose()), b(std::move(b)),
+        c(std::move(c)), m(this->A.get_rows()), n(this->A.get_cols()),
+        max_iterations(200), iterations(0), feasibility(-1),
+        normal_pattern(validated_pattern(this->A, At, this->b, this->c)),
+        cholesky(normal_pattern),
+        normal_values(normal_pattern.get_nonzeros()), work(m, 0.0),
+        scaling(n + m, 1.0) {}
+
+  /**
+   * @brief 从Mehrotra初始点开始迭代；每次调用都是冷启动
+   */
+  LinearProgramming::LPResult solve() {
+    size_t total = n + m;
+    iterations = 0;
+    feasibility = -1;
+    initial_point();
+
+    double b_norm = norm(b);
+    double c_norm = norm(c);
+    std::vector<double> rb, rc(total), rxz(total);
+    std::vector<double> dv, dy, dz, dv_aff, dy_aff, dz_aff;
+
+    LinearProgramming::LPResult result;
+    result.status = "达到最大迭代次数";
+    for (;; iterations++) {
+      rb = apply(v);
+      for (size_t i = 0; i < m; i++) {
+        rb[i] -= b[i];
+      }
+      rc = apply_transpose(y);
+      double primal_objective = 0.0;
+      for (size_t j = 0; j < total; j++) {
+        rc[j] += z[j] - objective_coefficient(j);
+        primal_objective += objective_coefficient(j) * v[j];
+      }
+      double dual_objective = dot(b, y);
+      double mu = dot(v, z) / static_cast<double>(total);
+      if (!std::isfinite(mu)) {
+        result.status = "求解失败: 迭代发散";
+        return unresolved(result);
+      }
+
+      if (norm(rb) / (1.0 + b_norm) < kTolerance &&
+          norm(rc) / (1.0 + c_norm) < kTolerance &&
+          std::abs(primal_objective - dual_objective) /
+                  (1.0 + std::abs(primal_objective)) <
+              kTolerance) {
+        feasibility = 1;
+        result.feasible = true;
+        result.bounded = true;
+        result.status = "内点法收敛到最优解";
+        break;
+      }
+      if (farkas_certificate()) {
+        feasibility = 0;
+        result.status = "问题不可行";
+        return result;
+      }
+      if (max_abs(v) > kDivergence * (1.0 + b_norm) &&
+          unbounded_certificate()) {
+        // 有无界射线时，问题无界还是不可行取决于可行域是否非空
+        int feasible = primal_feasibility();
+        if (feasible >= 0) {
+          feasibility = feasible;
+          result.feasible = feasible == 1;
+          result.status = feasible == 1 ? "问题无界" : "问题不可行";
+          return result;
+        }
+      }
+      if (iterations >= max_iterations) {
+        return unresolved(result); // 最后的迭代点不是解，不返回
+      }
+
+      for (size_t j = 0; j < total; j++) {
+        scaling[j] = v[j] / z[j];
+      }
+      factorize_normal_equations();
+
+      // 预测步：仿射方向
+      for (size_t j = 0; j < total; j++) {
+        rxz[j] = v[j] * z[j];
+      }
+      newton_direction(rb, rc, rxz, dv_aff, dy_aff, dz_aff);
+      double alpha_primal = max_step(v, dv_aff);
+      double alpha_dual = max_step(z, dz_aff);
+      double mu_aff = 0.0;
+      for (size_t j = 0; j < total; j++) {
+        mu_aff += (v[j] + alpha_primal * dv_aff[j]) *
+                  (z[j] + alpha_dual * dz_aff[j]);
+      }
+      mu_aff /= static_cast<double>(total);
+      double sigma = std::pow(mu_aff / mu, 3);
+
+      // 校正步：二阶项与中心化
+      for (size_t j = 0; j < total; j++) {
+        rxz[j] = v[j] * z[j] + dv_aff[j] * dz_aff[j] - sigma * mu;
+      }
+      newton_direction(rb, rc, rxz, dv, dy, dz);
+      alpha_primal = std::min(1.0, kStepScale * max_step(v, dv));
+      alpha_dual = std::min(1.0, kStepScale * max_step(z, dz));
+      for (size_t j = 0; j < total; j++) {
+        v[j] += alpha_primal * dv[j];
+        z[j] += alpha_dual * dz[j];
+      }
+      for (size_t i = 0; i < m; i++) {
+        y[i] += alpha_dual * dy[i];
+      }
+    }
+
+    result.solution.assign(v.begin(), v.begin() + n);
+    for (size_t j = 0; j < n; j++) {
+      result.solution[j] = std::max(result.solution[j], 0.0);
+      result.objective_value += c[j] * result.solution[j];
+    }
+    duals.resize(m);
+    for (size_t i = 0; i < m; i++) {
+      duals[i] = -y[i];
+    }
+    return result;
+  }
+
+  void set_max_iterations(size_t limit) { max_iterations = limit; }
+
+  /**
+   * @brief 最近一次 solve 得到的对偶变量（按约束行），约定与
+   *        RevisedSimplex::get_duals 相同：y ≥ 0、A^T y ≥ c
+   */
+  const std::vector<double> &get_duals() const { return duals; }
+
+  // 最近一次 solve 的迭代次数（每次迭代一次数值分解、两次回代）
+  size_t get_iterations() const { return iterations; }
+
+  size_t factor_nonzeros() const { return cholesky.factor_nonzeros(); }
+
+private:
+  static SparseMatrixCSC validated_pattern(const SparseMatrixCSC &A,
+                                           const SparseMatrixCSC &At,
+                                           const std::vector<double> &b,
+                                           const std::vector<double> &c) {
+    if (A.get_rows() == 0 || A.get_cols() == 0) {
+      throw std::invalid_argument("输入矩阵或向量不能为空");
+    }
+    if (b.size() != A.get_rows()) {
+      throw std::invalid_argument("约束右端项b的长度必须等于约束矩阵A的行数");
+    }
+    if (c.size() != A.get_cols()) {
+      throw std::invalid_argument("目标函数系数c的长度必须等于约束矩阵A的列数");
+    }
+    return build_normal_pattern(A, At);
+  }
+};
+
+/**
+ * @brief 用内点法求解稠密输入
+ */
+inline LinearProgramming::LPResult
+LinearProgramming::interior_point_method(
+    const std::vector<std::vector<double>> &A, const std::vector<double> &b,
+    const std::vector<double> &c) {
+  LPResult result;
+  try {
+    InteriorPointSolver solver(SparseMatrixCSC::from_dense(A), b, c);
+    result = solver.solve();
+  } catch (const std::exception &e) {
+    result.status = "求解失败: " + std::string(e.what());
+  }
+  return result;
+}
+
 } // namespace algorithms
 
 #endif // LINEAR_PROGRAMMING_H
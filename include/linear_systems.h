@@ -2,12 +2,770 @@
 #define LINEAR_SYSTEMS_H
 
 #include "matrix_operations.h"
+#include "sparse_matrix.h"
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <queue>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace algorithms {
 
+/**
+ * @brief 稠密矩阵的LUP分解 PA = LU（算法导论28.1节LUP-DECOMPOSITION）
+ *
+ * 右视分块版本：每次对宽 kBlock 列的面板做带部分主元的消元，行交换作用在
+ * 整行上；再用单位下三角块求出 U 的对应行块，尾部子矩阵的更新
+ * A22 -= L21 · U12 交给 GemmKernel，占全部 2n³/3 次浮点运算的绝大部分。
+ * L（单位下三角，不存对角）与 U 共用一块行主序存储。
+ *
+ * 分解只做一次，之后 solve 可反复调用：单个右端项做两次 O(n²) 回代，
+ * n × k 的右端项矩阵按行块回代，块间的更新同样用 GemmKernel。
+ * 传入右值 Matrix（std::move）时直接在其存储上分解，不复制。
+ */
+class LUPFactorization {
+private:
+  static constexpr int kBlock = 128;
+  static constexpr double kSingularTolerance = 1e-10;
+
+  Matrix lu;
+  std::vector<int> permutation; // permutation[i]：PA 第 i 行在 A 中的行号
+  int n;
+  int swaps;
+
+  void factorize() {
+    n = lu.get_rows();
+    if (n != lu.get_cols())
+      throw std::invalid_argument("Matrix must be square for LUP decomposition");
+    if (lu.get_layout() != MatrixLayout::RowMajor)
+      lu = lu.to_layout(MatrixLayout::RowMajor);
+
+    permutation.resize(n);
+    for (int i = 0; i < n; i++)
+      permutation[i] = i;
+    swaps = 0;
+
+    double *a = lu.raw_data();
+    const size_t ld = n;
+    std::vector<double> negated;
+    for (int k0 = 0; k0 < n; k0 += kBlock) {
+      int k1 = std::min(n, k0 + kBlock);
+
+      // 1. 面板 [k0, n) × [k0, k1)：带部分主元的逐列消元
+      for (int j = k0; j < k1; j++) {
+        int pivot = j;
+        for (int i = j + 1; i < n; i++) {
+          if (std::abs(a[i * ld + j]) > std::abs(a[pivot * ld + j]))
+            pivot = i;
+        }
+        if (std::abs(a[pivot * ld + j]) < kSingularTolerance)
+          throw std::runtime_error("Matrix is singular or nearly singular");
+        if (pivot != j) {
+          std::swap_ranges(a + j * ld, a + (j + 1) * ld, a + pivot * ld);
+          std::swap(permutation[j], permutation[pivot]);
+          swaps++;
+        }
+        double inverse_pivot = 1.0 / a[j * ld + j];
+        for (int i = j + 1; i < n; i++) {
+          double *row = a + i * ld;
+          double l = row[j] *= inverse_pivot;
+          if (l == 0.0)
+            continue;
+          const double *pivot_row = a + j * ld;
+          for (int q = j + 1; q < k1; q++)
+            row[q] -= l * pivot_row[q];
+        }
+      }
+      if (k1 == n)
+        break;
+
+      // 2. U12 = L11⁻¹ A12
+      for (int i = k0 + 1; i < k1; i++) {
+        double *row = a + i * ld;
+        for (int p = k0; p < i; p++) {
+          double l = row[p];
+          const double *source = a + p * ld;
+          for (int q = k1; q < n; q++)
+            row[q] -= l * source[q];
+        }
+      }
+
+      // 3. A22 -= L21 · U12
+      int rows = n - k1, width = k1 - k0;
+      negated.resize(static_cast<size_t>(rows) * width);
+      for (int i = 0; i < rows; i++)
+        for (int p = 0; p < width; p++)
+          negated[i * width + p] = -a[(k1 + i) * ld + k0 + p];
+      GemmKernel::gemm(rows, rows, width, negated.data(), width,
+                       a + k0 * ld + k1, ld, a + k1 * ld + k1, ld);
+    }
+  }
+
+  // X 的行按 P 重排后，就地求解 L Y = PB、U X = Y（X 为行主序 n × k）
+  void substitute(double *x, size_t k) const {
+    const double *a = lu.raw_data();
+    const size_t ld = n;
+    std::vector<double> update;
+    for (int i0 = 0; i0 < n; i0 += kBlock) {
+      int i1 = std::min(n, i0 + kBlock);
+      if (i0 > 0 && k > 1) {
+        block_update(a + i0 * ld, ld, i1 - i0, i0, x, x + i0 * k, k, update);
+      }
+      for (int i = i0; i < i1; i++) {
+        double *row = x + i * k;
+        for (int p = k > 1 ? i0 : 0; p < i; p++) {
+          double l = a[i * ld + p];
+          const double *source = x + p * k;
+          for (size_t q = 0; q < k; q++)
+            row[q] -= l * source[q];
+        }
+      }
+    }
+    for (int i1 = n; i1 > 0; i1 -= kBlock) {
+      int i0 = std::max(0, i1 - kBlock);
+      if (i1 < n && k > 1) {
+        block_update(a + i0 * ld + i1, ld, i1 - i0, n - i1, x + i1 * k,
+                     x + i0 * k, k, update);
+      }
+      for (int i = i1 - 1; i >= i0; i--) {
+        double *row = x + i * k;
+        for (int p = i + 1; p < (k > 1 ? i1 : n); p++) {
+          double u = a[i * ld + p];
+          const double *source = x + p * k;
+          for (size_t q = 0; q < k; q++)
+            row[q] -= u * source[q];
+        }
+        double inverse_diagonal = 1.0 / a[i * ld + i];
+        for (size_t q = 0; q < k; q++)
+          row[q] *= inverse_diagonal;
+      }
+    }
+  }
+
+  // target[rows × k] -= block[rows × depth] · source[depth × k]
+  static void block_update(const double *block, size_t ld, int rows,
+                           int depth, const double *source, double *target,
+                           size_t k, std::vector<double> &update) {
+    update.assign(static_cast<size_t>(rows) * k, 0.0);
+    GemmKernel::gemm(rows, k, depth, block, ld, source, k, update.data(), k);
+    for (size_t i = 0; i < update.size(); i++)
+      target[i] -= update[i];
+  }
+
+public:
+  explicit LUPFactorization(const Matrix &A) : lu(A) { factorize(); }
+
+  /**
+   * @brief 就地分解：A 的存储被接管（行主序时不复制）
+   */
+  explicit LUPFactorization(Matrix &&A) : lu(std::move(A)) { factorize(); }
+
+  int size() const { return n; }
+
+  /**
+   * @brief 求解 A x = b
+   */
+  std::vector<double> solve(const std::vector<double> &b) const {
+    if (static_cast<int>(b.size()) != n)
+      throw std::invalid_argument(
+          "Matrix dimensions must match for LUP solve");
+    std::vector<double> x(n);
+    for (int i = 0; i < n; i++)
+      x[i] = b[permutation[i]];
+    substitute(x.data(), 1);
+    return x;
+  }
+
+  /**
+   * @brief 一次求解多个右端项 A X = B，B 为 n × k
+   */
+  Matrix solve(const Matrix &B) const {
+    if (B.get_rows() != n)
+      throw std::invalid_argument(
+          "Matrix dimensions must match for LUP solve");
+    size_t k = B.get_cols();
+    Matrix X(n, B.get_cols());
+    for (int i = 0; i < n; i++)
+      for (size_t q = 0; q < k; q++)
+        X.unchecked(i, q) = B.unchecked(permutation[i], q);
+    substitute(X.raw_data(), k);
+    return X;
+  }
+
+  /**
+   * @brief A⁻¹，即对单位矩阵求解一次批量右端项
+   */
+  Matrix inverse() const {
+    Matrix X(n, n);
+    for (int i = 0; i < n; i++)
+      X.unchecked(i, permutation[i]) = 1.0;
+    substitute(X.raw_data(), n);
+    return X;
+  }
+
+  /**
+   * @brief 求解 Aᵀ x = b
+   *
+   * Aᵀ = Uᵀ Lᵀ P：先解 Uᵀ w = b、再解 Lᵀ v = w，最后按 P 还原。两次回代
+   * 都按行访问紧凑存储，O(n²)。
+   */
+  std::vector<double> solve_transpose(const std::vector<double> &b) const {
+    if (static_cast<int>(b.size()) != n)
+      throw std::invalid_argument(
+          "Matrix dimensions must match for LUP solve");
+    const double *a = lu.raw_data();
+    std::vector<double> w = b;
+    for (int i = 0; i < n; i++) {
+      const double *row = a + static_cast<size_t>(i) * n;
+      w[i] /= row[i];
+      for (int q = i + 1; q < n; q++)
+        w[q] -= row[q] * w[i];
+    }
+    for (int i = n - 1; i > 0; i--) {
+      const double *row = a + static_cast<size_t>(i) * n;
+      for (int q = 0; q < i; q++)
+        w[q] -= row[q] * w[i];
+    }
+    std::vector<double> x(n);
+    for (int i = 0; i < n; i++)
+      x[permutation[i]] = w[i];
+    return x;
+  }
+
+  /**
+   * @brief 估计 ||A⁻¹||₁，不求逆（Hager算法，Higham的改进，同LAPACK xLACN2）
+   *
+   * ||A⁻¹||₁ 是凸函数 f(x) = ||A⁻¹x||₁ 在单位1-范数球上的最大值，
+   * 最大值在某个 e_j 处取到。从 x = e/n 出发做次梯度上升：y = A⁻¹x，
+   * 次梯度 z = A⁻ᵀ sign(y)，跳到 |z_j| 最大的 e_j；若 |z_j| ≤ zᵀx 则已是
+   * 局部最大。至多5轮，每轮两次 O(n²) 回代。最后再用Higham的交错符号
+   * 向量 x_i = (-1)^i (1 + i/(n-1)) 补一次估计，防止被特殊结构骗过。
+   * 得到的是下界，实践中通常在真值的3倍以内，多数情况下精确。
+   */
+  double inverse_norm_1_estimate() const {
+    if (n == 0)
+      return 0.0;
+    std::vector<double> x(n, 1.0 / n);
+    std::vector<double> signs, previous_signs;
+    double estimate = 0.0;
+    for (int iteration = 0; iteration < 5; iteration++) {
+      std::vector<double> y = solve(x);
+      double current = 0.0;
+      signs.resize(n);
+      for (int i = 0; i < n; i++) {
+        current += std::abs(y[i]);
+        signs[i] = y[i] >= 0.0 ? 1.0 : -1.0;
+      }
+      if (iteration > 0 && (current <= estimate || signs == previous_signs)) {
+        estimate = std::max(estimate, current);
+        break;
+      }
+      estimate = current;
+      previous_signs = signs;
+
+      std::vector<double> z = solve_transpose(signs);
+      int j = 0;
+      double z_dot_x = 0.0;
+      for (int i = 0; i < n; i++) {
+        if (std::abs(z[i]) > std::abs(z[j]))
+          j = i;
+        z_dot_x += z[i] * x[i];
+      }
+      if (iteration > 0 && std::abs(z[j]) <= z_dot_x)
+        break;
+      std::fill(x.begin(), x.end(), 0.0);
+      x[j] = 1.0;
+    }
+
+    for (int i = 0; i < n; i++)
+      x[i] = (i % 2 == 0 ? 1.0 : -1.0) *
+             (1.0 + (n > 1 ? static_cast<double>(i) / (n - 1) : 0.0));
+    std::vector<double> y = solve(x);
+    double alternative = 0.0;
+    for (double v : y)
+      alternative += std::abs(v);
+    return std::max(estimate, 2.0 * alternative / (3.0 * n));
+  }
+
+  double determinant() const {
+    double det = swaps % 2 == 0 ? 1.0 : -1.0;
+    for (int i = 0; i < n; i++)
+      det *= lu.unchecked(i, i);
+    return det;
+  }
+
+  // 紧凑存储的 L（严格下三角）与 U（上三角）
+  const Matrix &packed() const { return lu; }
+
+  const std::vector<int> &get_permutation() const { return permutation; }
+};
+
+/**
+ * @brief 对称正定矩阵的Cholesky分解 A = L Lᵀ（算法导论28.3节）
+ *
+ * 与 LUPFactorization 相同的右视分块结构：分解对角块，求出其下方的
+ * L21 = A21 L11⁻ᵀ，再用 GemmKernel 做对称的尾部更新 A22 -= L21 L21ᵀ，
+ * 按行块只更新下三角，浮点运算约 n³/3。只读取 A 的下三角。
+ */
+class CholeskyFactorization {
+private:
+  static constexpr int kBlock = 128;
+
+  Matrix l;
+  int n;
+
+  void factorize() {
+    n = l.get_rows();
+    if (n != l.get_cols())
+      throw std::invalid_argument(
+          "Matrix must be square for Cholesky decomposition");
+    if (l.get_layout() != MatrixLayout::RowMajor)
+      l = l.to_layout(MatrixLayout::RowMajor);
+
+    double *a = l.raw_data();
+    const size_t ld = n;
+    std::vector<double> negated, transposed;
+    for (int k0 = 0; k0 < n; k0 += kBlock) {
+      int k1 = std::min(n, k0 + kBlock);
+
+      // 1. 对角块与其下方的列块，逐列进行
+      for (int j = k0; j < k1; j++) {
+        double *row_j = a + j * ld;
+        double d = row_j[j];
+        for (int p = k0; p < j; p++)
+          d -= row_j[p] * row_j[p];
+        if (!(d > 0.0))
+          throw std::runtime_error("Matrix is not positive definite");
+        d = std::sqrt(d);
+        row_j[j] = d;
+        double inverse_d = 1.0 / d;
+        for (int i = j + 1; i < n; i++) {
+          double *row_i = a + i * ld;
+          double v = row_i[j];
+          for (int p = k0; p < j; p++)
+            v -= row_i[p] * row_j[p];
+          row_i[j] = v * inverse_d;
+        }
+      }
+      if (k1 == n)
+        break;
+
+      // 2. 尾部下三角 A22 -= L21 L21ᵀ，每个行块只更新到对角块为止
+      int rows = n - k1, width = k1 - k0;
+      negated.resize(static_cast<size_t>(rows) * width);
+      transposed.resize(static_cast<size_t>(width) * rows);
+      for (int i = 0; i < rows; i++) {
+        for (int p = 0; p < width; p++) {
+          double v = a[(k1 + i) * ld + k0 + p];
+          negated[i * width + p] = -v;
+          transposed[p * rows + i] = v;
+        }
+      }
+      for (int i0 = 0; i0 < rows; i0 += kBlock) {
+        int i1 = std::min(rows, i0 + kBlock);
+        GemmKernel::gemm(i1 - i0, i1, width, negated.data() + i0 * width,
+                         width, transposed.data(), rows,
+                         a + (k1 + i0) * ld + k1, ld);
+      }
+    }
+    // 上三角清零，使 l 恰为 L
+    for (int i = 0; i < n; i++)
+      std::fill(a + i * ld + i + 1, a + (i + 1) * ld, 0.0);
+  }
+
+public:
+  explicit CholeskyFactorization(const Matrix &A) : l(A) { factorize(); }
+
+  /**
+   * @brief 就地分解：A 的存储被接管（行主序时不复制）
+   */
+  explicit CholeskyFactorization(Matrix &&A) : l(std::move(A)) {
+    factorize();
+  }
+
+  int size() const { return n; }
+
+  /**
+   * @brief 求解 A x = b：L y = b，Lᵀ x = y
+   */
+  std::vector<double> solve(const std::vector<double> &b) const {
+    if (static_cast<int>(b.size()) != n)
+      throw std::invalid_argument(
+          "Matrix dimensions must match for Cholesky solve");
+    const double *a = l.raw_data();
+    std::vector<double> x(b);
+    for (int i = 0; i < n; i++) {
+      const double *row = a + static_cast<size_t>(i) * n;
+      double v = x[i];
+      for (int p = 0; p < i; p++)
+        v -= row[p] * x[p];
+      x[i] = v / row[i];
+    }
+    for (int i = n - 1; i >= 0; i--) {
+      x[i] /= a[static_cast<size_t>(i) * n + i];
+      const double *row = a + static_cast<size_t>(i) * n;
+      for (int p = 0; p < i; p++)
+        x[p] -= row[p] * x[i];
+    }
+    return x;
+  }
+
+  /**
+   * @brief 一次求解多个右端项 A X = B，B 为 n × k
+   */
+  Matrix solve(const Matrix &B) const {
+    if (B.get_rows() != n)
+      throw std::invalid_argument(
+          "Matrix dimensions must match for Cholesky solve");
+    int k = B.get_cols();
+    Matrix X = B.to_layout(MatrixLayout::RowMajor);
+    const double *a = l.raw_data();
+    double *x = X.raw_data();
+    for (int i = 0; i < n; i++) {
+      double *row = x + static_cast<size_t>(i) * k;
+      for (int p = 0; p < i; p++) {
+        double v = a[static_cast<size_t>(i) * n + p];
+        const double *source = x + static_cast<size_t>(p) * k;
+        for (int q = 0; q < k; q++)
+          row[q] -= v * source[q];
+      }
+      double inverse_d = 1.0 / a[static_cast<size_t>(i) * n + i];
+      for (int q = 0; q < k; q++)
+        row[q] *= inverse_d;
+    }
+    for (int i = n - 1; i >= 0; i--) {
+      double *row = x + static_cast<size_t>(i) * k;
+      double inverse_d = 1.0 / a[static_cast<size_t>(i) * n + i];
+      for (int q = 0; q < k; q++)
+        row[q] *= inverse_d;
+      for (int p = 0; p < i; p++) {
+        double v = a[static_cast<size_t>(i) * n + p];
+        double *target = x + static_cast<size_t>(p) * k;
+        for (int q = 0; q < k; q++)
+          target[q] -= v * row[q];
+      }
+    }
+    return X;
+  }
+
+  // 下三角因子 L（上三角为0）
+  const Matrix &factor() const { return l; }
+};
+
+/**
+ * @brief 稀疏对称正定矩阵的Cholesky分解 P A P^T = L L^T
+ *
+ * 分两步完成：
+ * - 构造时只看非零结构：最小度排序得到 P，求 C = P A P^T 的消去树，
+ *   再沿消去树统计 L 每列的非零数并一次分配好存储。
+ * - factorize 做数值分解，按行（up-looking）进行：L 第 k 行的非零结构是
+ *   消去树上从 C 第 k 列各非零行出发、到 k 为止的路径之并，代价与 L 的
+ *   浮点运算数成正比。非零结构不变时可以只换数值反复分解。
+ *
+ * 输入只读上三角（含对角线）部分。内点法的法方程在收敛时高度病态，
+ * 消去后剩余不足原对角元 kPivotTolerance 倍的主元被替换为一个极大值，
+ * 使该分量的解为0（Wright《Primal-Dual Interior-Point Methods》第11章的
+ * 做法），替换次数可用 replaced_pivots() 查看。
+ */
+class SparseCholesky {
+private:
+  static constexpr double kPivotTolerance = 1e-14;
+  static constexpr double kHugePivot = 1e128;
+
+  size_t n;
+  size_t input_nonzeros;
+  std::vector<int> perm;    // perm[k]：第 k 个消去的原始下标
+  std::vector<int> inverse; // inverse[perm[k]] = k
+  std::vector<int> parent;  // C 的消去树，根为 -1
+
+  // C 的上三角按列存储，c_source[p] 为该元素在输入数值数组中的下标
+  std::vector<size_t> c_start;
+  std::vector<int> c_index;
+  std::vector<size_t> c_source;
+
+  // L 按列存储，每列第一个元素为对角元
+  std::vector<size_t> l_start;
+  std::vector<int> l_index;
+  std::vector<double> l_value;
+  std::vector<size_t> l_fill;
+
+  std::vector<int> mark;
+  std::vector<int> reach;
+  std::vector<double> work;
+  size_t replaced;
+  bool factorized;
+
+  /**
+   * @brief 最小度排序：在显式消去图上每次消去度数最小的顶点，
+   *        其邻居两两连边；剩余顶点构成团时直接按任意顺序收尾
+   */
+  void minimum_degree(std::vector<std::vector<int>> adjacency) {
+    std::vector<char> eliminated(n, 0);
+    using Entry = std::pair<size_t, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    for (size_t v = 0; v < n; v++) {
+      heap.push({adjacency[v].size(), static_cast<int>(v)});
+    }
+    std::vector<int> merged;
+    while (perm.size() < n) {
+      Entry top = heap.top();
+      heap.pop();
+      int v = top.second;
+      if (eliminated[v] || top.first != adjacency[v].size()) {
+        continue;
+      }
+      size_t remaining = n - perm.size();
+      if (top.first + 1 == remaining) {
+        for (size_t u = 0; u < n; u++) {
+          if (!eliminated[u]) {
+            perm.push_back(static_cast<int>(u));
+          }
+        }
+        break;
+      }
+      eliminated[v] = 1;
+      perm.push_back(v);
+      const std::vector<int> &clique = adjacency[v];
+      for (int u : clique) {
+        std::vector<int> &list = adjacency[u];
+        merged.clear();
+        std::set_union(list.begin(), list.end(), clique.begin(), clique.end(),
+                       std::back_inserter(merged));
+        list.clear();
+        for (int w : merged) {
+          if (w != u && w != v) {
+            list.push_back(w);
+          }
+        }
+        heap.push({list.size(), u});
+      }
+      std::vector<int>().swap(adjacency[v]);
+    }
+  }
+
+  /**
+   * @brief L 第 k 行的非零结构，按拓扑序存放在 reach[top..n)
+   */
+  size_t row_pattern(int k) {
+    size_t top = n;
+    mark[k] = k;
+    for (size_t p = c_start[k]; p < c_start[k + 1]; p++) {
+      int i = c_index[p];
+      if (i >= k) {
+        continue;
+      }
+      size_t length = 0;
+      for (; mark[i] != k; i = parent[i]) {
+        reach[length++] = i;
+        mark[i] = k;
+      }
+      while (length > 0) {
+        reach[--top] = reach[--length];
+      }
+    }
+    return top;
+  }
+
+public:
+  /**
+   * @brief 符号分析
+   * @param pattern n × n 对称矩阵，只使用上三角部分的非零结构
+   * @throws std::invalid_argument 矩阵不是方阵或缺少对角元
+   */
+  explicit SparseCholesky(const SparseMatrixCSC &pattern)
+      : n(pattern.get_rows()), input_nonzeros(pattern.get_nonzeros()),
+        replaced(0), factorized(false) {
+    if (pattern.get_cols() != n) {
+      throw std::invalid_argument("Cholesky分解要求方阵");
+    }
+    const auto &start = pattern.get_col_start();
+    const auto &rows = pattern.get_row_index();
+
+    // 1. 对称邻接表（不含对角线）与最小度排序
+    std::vector<std::vector<int>> adjacency(n);
+    std::vector<char> has_diagonal(n, 0);
+    for (size_t j = 0; j < n; j++) {
+      for (size_t p = start[j]; p < start[j + 1]; p++) {
+        size_t i = rows[p];
+        if (i < j) {
+          adjacency[i].push_back(static_cast<int>(j));
+          adjacency[j].push_back(static_cast<int>(i));
+        } else if (i == j) {
+          has_diagonal[j] = 1;
+        }
+      }
+    }
+    for (size_t j = 0; j < n; j++) {
+      if (!has_diagonal[j]) {
+        throw std::invalid_argument("对称正定矩阵的对角元不能为0");
+      }
+      std::sort(adjacency[j].begin(), adjacency[j].end());
+      adjacency[j].erase(
+          std::unique(adjacency[j].begin(), adjacency[j].end()),
+          adjacency[j].end());
+    }
+    perm.reserve(n);
+    minimum_degree(std::move(adjacency));
+    inverse.assign(n, 0);
+    for (size_t k = 0; k < n; k++) {
+      inverse[perm[k]] = static_cast<int>(k);
+    }
+
+    // 2. C = P A P^T 的上三角
+    c_start.assign(n + 1, 0);
+    for (size_t j = 0; j < n; j++) {
+      for (size_t p = start[j]; p < start[j + 1]; p++) {
+        if (static_cast<size_t>(rows[p]) <= j) {
+          c_start[std::max(inverse[rows[p]], inverse[j]) + 1]++;
+        }
+      }
+    }
+    for (size_t k = 0; k < n; k++) {
+      c_start[k + 1] += c_start[k];
+    }
+    c_index.resize(c_start[n]);
+    c_source.resize(c_start[n]);
+    std::vector<size_t> next(c_start.begin(), c_start.end() - 1);
+    for (size_t j = 0; j < n; j++) {
+      for (size_t p = start[j]; p < start[j + 1]; p++) {
+        if (static_cast<size_t>(rows[p]) <= j) {
+          int a = inverse[rows[p]], b = inverse[j];
+          size_t slot = next[std::max(a, b)]++;
+          c_index[slot] = std::min(a, b);
+          c_source[slot] = p;
+        }
+      }
+    }
+
+    // 3. 消去树（带路径压缩的祖先数组）
+    parent.assign(n, -1);
+    std::vector<int> ancestor(n, -1);
+    for (size_t k = 0; k < n; k++) {
+      for (size_t p = c_start[k]; p < c_start[k + 1]; p++) {
+        int i = c_index[p];
+        while (i != -1 && i < static_cast<int>(k)) {
+          int up = ancestor[i];
+          ancestor[i] = static_cast<int>(k);
+          if (up == -1) {
+            parent[i] = static_cast<int>(k);
+          }
+          i = up;
+        }
+      }
+    }
+
+    // 4. 逐行求 L 的非零结构，统计每列非零数
+    mark.assign(n, -1);
+    reach.assign(n, 0);
+    work.assign(n, 0.0);
+    std::vector<size_t> counts(n, 1);
+    for (size_t k = 0; k < n; k++) {
+      for (size_t top = row_pattern(static_cast<int>(k)); top < n; top++) {
+        counts[reach[top]]++;
+      }
+    }
+    l_start.assign(n + 1, 0);
+    for (size_t k = 0; k < n; k++) {
+      l_start[k + 1] = l_start[k] + counts[k];
+    }
+    l_index.resize(l_start[n]);
+    l_value.resize(l_start[n]);
+    l_fill.resize(n);
+  }
+
+  /**
+   * @brief 数值分解
+   * @param values 与构造时的矩阵非零元一一对应的数值
+   * @throws std::invalid_argument 数值个数与非零结构不符
+   */
+  void factorize(const std::vector<double> &values) {
+    if (values.size() != input_nonzeros) {
+      throw std::invalid_argument("数值个数与分析时的非零结构不一致");
+    }
+    replaced = 0;
+    std::fill(mark.begin(), mark.end(), -1);
+    for (size_t k = 0; k < n; k++) {
+      size_t top = row_pattern(static_cast<int>(k));
+      work[k] = 0.0;
+      for (size_t p = c_start[k]; p < c_start[k + 1]; p++) {
+        work[c_index[p]] += values[c_source[p]];
+      }
+      double diagonal = work[k];
+      double d = diagonal;
+      work[k] = 0.0;
+      for (; top < n; top++) {
+        int i = reach[top];
+        double lki = work[i] / l_value[l_start[i]];
+        work[i] = 0.0;
+        for (size_t p = l_start[i] + 1; p < l_fill[i]; p++) {
+          work[l_index[p]] -= l_value[p] * lki;
+        }
+        d -= lki * lki;
+        size_t slot = l_fill[i]++;
+        l_index[slot] = static_cast<int>(k);
+        l_value[slot] = lki;
+      }
+      if (!(d > kPivotTolerance * std::abs(diagonal))) {
+        d = kHugePivot;
+        replaced++;
+      }
+      l_index[l_start[k]] = static_cast<int>(k);
+      l_value[l_start[k]] = std::sqrt(d);
+      l_fill[k] = l_start[k] + 1;
+    }
+    factorized = true;
+  }
+
+  void factorize(const SparseMatrixCSC &A) { factorize(A.get_values()); }
+
+  /**
+   * @brief 用已有分解求解 A x = b
+   * @throws std::logic_error 尚未进行数值分解
+   */
+  std::vector<double> solve(const std::vector<double> &b) const {
+    if (!factorized) {
+      throw std::logic_error("尚未进行数值分解");
+    }
+    if (b.size() != n) {
+      throw std::invalid_argument("向量长度与矩阵阶数不一致");
+    }
+    std::vector<double> y(n);
+    for (size_t k = 0; k < n; k++) {
+      y[k] = b[perm[k]];
+    }
+    for (size_t j = 0; j < n; j++) {
+      y[j] /= l_value[l_start[j]];
+      for (size_t p = l_start[j] + 1; p < l_start[j + 1]; p++) {
+        y[l_index[p]] -= l_value[p] * y[j];
+      }
+    }
+    for (size_t j = n; j-- > 0;) {
+      for (size_t p = l_start[j] + 1; p < l_start[j + 1]; p++) {
+        y[j] -= l_value[p] * y[l_index[p]];
+      }
+      y[j] /= l_value[l_start[j]];
+    }
+    std::vector<double> x(n);
+    for (size_t k = 0; k < n; k++) {
+      x[perm[k]] = y[k];
+    }
+    return x;
+  }
+
+  size_t size() const { return n; }
+
+  size_t factor_nonzeros() const { return l_index.size(); }
+
+  // 最近一次分解中被替换为极大值的主元个数
+  size_t replaced_pivots() const { return replaced; }
+
+  const std::vector<int> &get_permutation() const { return perm; }
+};
+
 /**
  * @brief 线性方程组求解器
  *
@@ -85,9 +843,10 @@ public:
   }
 
   /**
-   * @brief 使用LU分解求解线性方程组
+   * @brief 使用LUP分解求解线性方程组
    *
-   * 时间复杂度：O(n³)
+   * 时间复杂度：O(n³)。同一矩阵要对多个右端项求解时，直接构造
+   * LUPFactorization 并反复调用 solve，避免重复分解。
    *
    * @param A 系数矩阵
    * @param b 常数向量
@@ -96,59 +855,47 @@ public:
   static std::vector<double> lu_decomposition(const Matrix &A,
                                              const std::vector<double> &b) {
     int n = A.get_rows();
-    if (n != A.get_cols() || n != b.size())
+    if (n != A.get_cols() || n != static_cast<int>(b.size()))
       throw std::invalid_argument(
           "Matrix dimensions must match for LU decomposition");
 
-    // LU分解
-    Matrix L(n, n);
-    Matrix U(n, n);
-
-    for (int i = 0; i < n; i++) {
-      // 计算U的第i行
-      for (int j = i; j < n; j++) {
-        double sum = 0.0;
-        for (int k = 0; k < i; k++) {
-          sum += L(i, k) * U(k, j);
-        }
-        U(i, j) = A(i, j) - sum;
-      }
-
-      // 计算L的第i列
-      for (int j = i; j < n; j++) {
-        if (i == j) {
-          L(i, i) = 1.0;
-        } else {
-          double sum = 0.0;
-          for (int k = 0; k < i; k++) {
-            sum += L(j, k) * U(k, i);
-          }
-          L(j, i) = (A(j, i) - sum) / U(i, i);
-        }
-      }
-    }
+    return LUPFactorization(A).solve(b);
+  }
 
-    // 前向替换：解 Ly = b
-    std::vector<double> y(n, 0.0);
-    for (int i = 0; i < n; i++) {
-      y[i] = b[i];
-      for (int j = 0; j < i; j++) {
-        y[i] -= L(i, j) * y[j];
-      }
-      y[i] /= L(i, i);
-    }
+  /**
+   * @brief 使用Cholesky分解求解对称正定线性方程组
+   *
+   * 时间复杂度：O(n³)，约为LUP分解的一半
+   *
+   * @param A 对称正定系数矩阵（只读取下三角）
+   * @param b 常数向量
+   * @return std::vector<double> 解向量
+   */
+  static std::vector<double>
+  cholesky_decomposition(const Matrix &A, const std::vector<double> &b) {
+    int n = A.get_rows();
+    if (n != A.get_cols() || n != static_cast<int>(b.size()))
+      throw std::invalid_argument(
+          "Matrix dimensions must match for Cholesky decomposition");
 
-    // 回代：解 Ux = y
-    std::vector<double> x(n, 0.0);
-    for (int i = n - 1; i >= 0; i--) {
-      x[i] = y[i];
-      for (int j = i + 1; j < n; j++) {
-        x[i] -= U(i, j) * x[j];
-      }
-      x[i] /= U(i, i);
-    }
+    return CholeskyFactorization(A).solve(b);
+  }
 
-    return x;
+  /**
+   * @brief 稀疏对称正定方程组：最小度排序加稀疏Cholesky分解
+   *
+   * 同一非零结构要多次求解时（如内点法的法方程），直接复用
+   * SparseCholesky 的符号分析。
+   *
+   * @param A 对称正定矩阵，只使用上三角部分
+   * @param b 常数向量
+   * @return std::vector<double> 解向量
+   */
+  static std::vector<double> sparse_cholesky(const SparseMatrixCSC &A,
+                                             const std::vector<double> &b) {
+    SparseCholesky factor(A);
+    factor.factorize(A);
+    return factor.solve(b);
   }
 
   /**
@@ -254,6 +1001,414 @@ public:
 
     return std::sqrt(residual_norm);
   }
+
+  /**
+   * @brief 计算稀疏矩阵的残差 ||b - Ax||₂
+   *
+   * @param A CSR稀疏矩阵
+   * @param b 常数向量
+   * @param x 解向量
+   * @return double 残差范数
+   */
+  static double residual(const SparseMatrixCSR &A, const std::vector<double> &b,
+                         const std::vector<double> &x) {
+    if (A.get_rows() != b.size())
+      throw std::invalid_argument("Vector size must match matrix rows");
+    std::vector<double> ax = A.multiply(x);
+    double residual_norm = 0.0;
+    for (size_t i = 0; i < ax.size(); i++) {
+      residual_norm += (ax[i] - b[i]) * (ax[i] - b[i]);
+    }
+    return std::sqrt(residual_norm);
+  }
+};
+
+/**
+ * @brief 稀疏迭代法的结果与统计
+ */
+struct IterativeSolveResult {
+  std::vector<double> x;
+  size_t iterations;    // 迭代次数（GMRES为所有重启周期的内迭代之和）
+  double residual;      // 结束时的真实残差 ||b - Ax||₂，由 residual() 计算
+  double relative_residual;    // residual / ||b||₂
+  bool converged;              // 递推残差是否达到容差
+  std::vector<double> history; // 每次迭代后的递推残差范数
+
+  IterativeSolveResult()
+      : iterations(0), residual(0.0), relative_residual(0.0),
+        converged(false) {}
+};
+
+/**
+ * @brief 不做预条件：z = r
+ */
+class IdentityPreconditioner {
+public:
+  void apply(const std::vector<double> &r, std::vector<double> &z) const {
+    z = r;
+  }
+};
+
+/**
+ * @brief Jacobi（对角）预条件：z_i = r_i / a_ii
+ */
+class JacobiPreconditioner {
+private:
+  std::vector<double> inverse_diagonal;
+
+public:
+  /**
+   * @throws std::runtime_error 存在为0的对角元
+   */
+  explicit JacobiPreconditioner(const SparseMatrixCSR &A)
+      : inverse_diagonal(A.diagonal()) {
+    for (double &d : inverse_diagonal) {
+      if (d == 0.0)
+        throw std::runtime_error("Jacobi preconditioner needs nonzero diagonal");
+      d = 1.0 / d;
+    }
+  }
+
+  void apply(const std::vector<double> &r, std::vector<double> &z) const {
+    z.resize(r.size());
+    for (size_t i = 0; i < r.size(); i++) {
+      z[i] = r[i] * inverse_diagonal[i];
+    }
+  }
+};
+
+/**
+ * @brief 不完全LU分解 ILU(0) 预条件
+ *
+ * L、U 的非零结构限定为 A 的非零结构，按Saad的IKJ顺序逐行消元：
+ * 第 i 行依次用列号 k < i 的各行 k 消去，只更新 A 中本来就有的位置。
+ * apply 解 L U z = r，一次前代一次回代，代价约为一次矩阵向量乘；
+ * 三角求解有行间依赖，是串行的。
+ */
+class ILU0Preconditioner {
+private:
+  size_t n;
+  std::vector<size_t> row_start;
+  std::vector<int> col_index;
+  std::vector<double> values; // 严格下三角存 L（单位对角），其余存 U
+  std::vector<size_t> diagonal_position;
+
+public:
+  /**
+   * @throws std::invalid_argument 矩阵不是方阵
+   * @throws std::runtime_error 缺少对角元或消元中出现零主元
+   */
+  explicit ILU0Preconditioner(const SparseMatrixCSR &A)
+      : n(A.get_rows()), row_start(A.get_row_start()),
+        col_index(A.get_col_index()), values(A.get_values()),
+        diagonal_position(A.get_rows()) {
+    if (A.get_cols() != n)
+      throw std::invalid_argument("ILU(0) needs a square matrix");
+    for (size_t i = 0; i < n; i++) {
+      auto begin = col_index.begin() + row_start[i];
+      auto end = col_index.begin() + row_start[i + 1];
+      auto it = std::lower_bound(begin, end, static_cast<int>(i));
+      if (it == end || *it != static_cast<int>(i))
+        throw std::runtime_error("ILU(0) needs every diagonal entry");
+      diagonal_position[i] = it - col_index.begin();
+    }
+
+    std::vector<size_t> position(n, SIZE_MAX);
+    for (size_t i = 0; i < n; i++) {
+      for (size_t p = row_start[i]; p < row_start[i + 1]; p++)
+        position[col_index[p]] = p;
+      for (size_t p = row_start[i]; p < diagonal_position[i]; p++) {
+        size_t k = col_index[p];
+        double l = values[p] /= values[diagonal_position[k]];
+        for (size_t q = diagonal_position[k] + 1; q < row_start[k + 1]; q++) {
+          size_t target = position[col_index[q]];
+          if (target != SIZE_MAX)
+            values[target] -= l * values[q];
+        }
+      }
+      if (values[diagonal_position[i]] == 0.0)
+        throw std::runtime_error("Zero pivot in ILU(0) factorization");
+      for (size_t p = row_start[i]; p < row_start[i + 1]; p++)
+        position[col_index[p]] = SIZE_MAX;
+    }
+  }
+
+  void apply(const std::vector<double> &r, std::vector<double> &z) const {
+    z.resize(n);
+    for (size_t i = 0; i < n; i++) {
+      double sum = r[i];
+      for (size_t p = row_start[i]; p < diagonal_position[i]; p++)
+        sum -= values[p] * z[col_index[p]];
+      z[i] = sum;
+    }
+    for (size_t i = n; i-- > 0;) {
+      double sum = z[i];
+      for (size_t p = diagonal_position[i] + 1; p < row_start[i + 1]; p++)
+        sum -= values[p] * z[col_index[p]];
+      z[i] = sum / values[diagonal_position[i]];
+    }
+  }
+};
+
+/**
+ * @brief 稀疏线性方程组的Krylov子空间迭代法
+ *
+ * - conjugate_gradient：预条件共轭梯度法，要求A对称正定，预条件子也
+ *   必须对称正定（Jacobi；对称矩阵的ILU(0)近似对称）
+ * - gmres：右预条件、重启的GMRES(m)，适用于一般非奇异矩阵；Arnoldi过程
+ *   用修正的Gram-Schmidt正交化，Givens旋转把最小二乘问题化为上三角，
+ *   每步不需显式求解即可得到残差范数。右预条件下监控的就是未预条件
+ *   的真实残差。需要存储 m+1 个长度为 n 的基向量。
+ *
+ * 构造时传入调度器则矩阵向量乘、内积与向量更新都并行执行；内积按固定
+ * 分块求部分和再顺序相加，结果与线程数无关。收敛判据为
+ * ||r||₂ ≤ tolerance · ||b||₂，结束时用 LinearSystemSolver::residual 重算
+ * 真实残差。
+ */
+class KrylovSolver {
+private:
+  static constexpr size_t kVectorBlock = size_t(1) << 14;
+
+  WorkStealingScheduler *scheduler;
+
+  template <typename Body> void for_blocks(size_t n, const Body &body) const {
+    size_t blocks = (n + kVectorBlock - 1) / kVectorBlock;
+    auto run = [&](size_t lo, size_t hi) {
+      for (size_t blk = lo; blk < hi; blk++)
+        body(blk, blk * kVectorBlock, std::min(n, (blk + 1) * kVectorBlock));
+    };
+    if (scheduler && blocks > 1)
+      scheduler->parallel_for(0, blocks, 1, run);
+    else
+      run(0, blocks);
+  }
+
+  double dot(const std::vector<double> &a, const std::vector<double> &b) const {
+    size_t n = a.size();
+    std::vector<double> partial((n + kVectorBlock - 1) / kVectorBlock, 0.0);
+    for_blocks(n, [&](size_t blk, size_t lo, size_t hi) {
+      double sum = 0.0;
+      for (size_t i = lo; i < hi; i++)
+        sum += a[i] * b[i];
+      partial[blk] = sum;
+    });
+    double sum = 0.0;
+    for (double v : partial)
+      sum += v;
+    return sum;
+  }
+
+  double norm(const std::vector<double> &a) const {
+    return std::sqrt(dot(a, a));
+  }
+
+  // y += alpha · x
+  void axpy(double alpha, const std::vector<double> &x,
+            std::vector<double> &y) const {
+    for_blocks(x.size(), [&](size_t, size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; i++)
+        y[i] += alpha * x[i];
+    });
+  }
+
+  void multiply(const SparseMatrixCSR &A, const std::vector<double> &x,
+                std::vector<double> &y) const {
+    if (scheduler)
+      A.multiply(*scheduler, x, y);
+    else
+      A.multiply(x, y);
+  }
+
+  static void check(const SparseMatrixCSR &A, const std::vector<double> &b) {
+    if (A.get_rows() != A.get_cols() || A.get_rows() != b.size())
+      throw std::invalid_argument(
+          "Matrix dimensions must match for iterative solve");
+  }
+
+  void finish(const SparseMatrixCSR &A, const std::vector<double> &b,
+              double b_norm, IterativeSolveResult &result) const {
+    result.residual = LinearSystemSolver::residual(A, b, result.x);
+    result.relative_residual =
+        b_norm > 0.0 ? result.residual / b_norm : result.residual;
+  }
+
+public:
+  explicit KrylovSolver(WorkStealingScheduler *scheduler = nullptr)
+      : scheduler(scheduler) {}
+
+  /**
+   * @brief 预条件共轭梯度法，从 x = 0 出发
+   *
+   * @param A 对称正定矩阵
+   * @param b 常数向量
+   * @param preconditioner 提供 apply(r, z)，z ≈ A⁻¹ r
+   * @param max_iterations 最大迭代次数
+   * @param tolerance 相对残差容差
+   * @throws std::runtime_error 出现 pᵀAp ≤ 0（矩阵不是正定的）
+   */
+  template <typename Preconditioner = IdentityPreconditioner>
+  IterativeSolveResult
+  conjugate_gradient(const SparseMatrixCSR &A, const std::vector<double> &b,
+                     const Preconditioner &preconditioner = Preconditioner(),
+                     size_t max_iterations = 1000,
+                     double tolerance = 1e-10) const {
+    check(A, b);
+    size_t n = b.size();
+    IterativeSolveResult result;
+    result.x.assign(n, 0.0);
+    double b_norm = norm(b);
+    if (b_norm == 0.0) {
+      result.converged = true;
+      return result;
+    }
+
+    std::vector<double> r = b, z, q(n);
+    preconditioner.apply(r, z);
+    std::vector<double> p = z;
+    double rz = dot(r, z);
+    while (result.iterations < max_iterations) {
+      multiply(A, p, q);
+      double curvature = dot(p, q);
+      if (!(curvature > 0.0))
+        throw std::runtime_error("Matrix is not positive definite");
+      double alpha = rz / curvature;
+      axpy(alpha, p, result.x);
+      axpy(-alpha, q, r);
+      result.iterations++;
+      double r_norm = norm(r);
+      result.history.push_back(r_norm);
+      if (r_norm <= tolerance * b_norm) {
+        result.converged = true;
+        break;
+      }
+      preconditioner.apply(r, z);
+      double rz_next = dot(r, z);
+      double beta = rz_next / rz;
+      rz = rz_next;
+      for_blocks(n, [&](size_t, size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; i++)
+          p[i] = z[i] + beta * p[i];
+      });
+    }
+    finish(A, b, b_norm, result);
+    return result;
+  }
+
+  /**
+   * @brief 右预条件的重启GMRES(m)，从 x = 0 出发
+   *
+   * @param A 非奇异方阵
+   * @param b 常数向量
+   * @param preconditioner 提供 apply(r, z)，z ≈ A⁻¹ r
+   * @param restart 重启周期 m（Krylov子空间的最大维数）
+   * @param max_iterations 内迭代总数上限
+   * @param tolerance 相对残差容差
+   */
+  template <typename Preconditioner = IdentityPreconditioner>
+  IterativeSolveResult gmres(const SparseMatrixCSR &A,
+                             const std::vector<double> &b,
+                             const Preconditioner &preconditioner =
+                                 Preconditioner(),
+                             size_t restart = 30, size_t max_iterations = 1000,
+                             double tolerance = 1e-10) const {
+    check(A, b);
+    size_t n = b.size();
+    restart = std::max<size_t>(restart, 1);
+    IterativeSolveResult result;
+    result.x.assign(n, 0.0);
+    double b_norm = norm(b);
+    if (b_norm == 0.0) {
+      result.converged = true;
+      return result;
+    }
+
+    std::vector<std::vector<double>> basis(restart + 1);
+    // hessenberg[j] 为第 j 列，长度 j + 2
+    std::vector<std::vector<double>> hessenberg(restart);
+    std::vector<double> cosines(restart), sines(restart), g(restart + 1);
+    std::vector<double> w(n), z(n);
+
+    while (true) {
+      // r = b - A x
+      multiply(A, result.x, w);
+      std::vector<double> &v0 = basis[0];
+      v0.resize(n);
+      for_blocks(n, [&](size_t, size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; i++)
+          v0[i] = b[i] - w[i];
+      });
+      double beta = norm(v0);
+      if (beta <= tolerance * b_norm) {
+        result.converged = true;
+        break;
+      }
+      if (result.iterations >= max_iterations)
+        break;
+      for_blocks(n, [&](size_t, size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; i++)
+          v0[i] /= beta;
+      });
+      std::fill(g.begin(), g.end(), 0.0);
+      g[0] = beta;
+
+      size_t k = 0;
+      while (k < restart && result.iterations < max_iterations) {
+        preconditioner.apply(basis[k], z);
+        multiply(A, z, w);
+        std::vector<double> &h = hessenberg[k];
+        h.assign(k + 2, 0.0);
+        for (size_t i = 0; i <= k; i++) {
+          h[i] = dot(w, basis[i]);
+          axpy(-h[i], basis[i], w);
+        }
+        h[k + 1] = norm(w);
+
+        for (size_t i = 0; i < k; i++) {
+          double upper = cosines[i] * h[i] + sines[i] * h[i + 1];
+          h[i + 1] = -sines[i] * h[i] + cosines[i] * h[i + 1];
+          h[i] = upper;
+        }
+        double radius = std::hypot(h[k], h[k + 1]);
+        double next = h[k + 1];
+        cosines[k] = radius > 0.0 ? h[k] / radius : 1.0;
+        sines[k] = radius > 0.0 ? next / radius : 0.0;
+        h[k] = radius;
+        h[k + 1] = 0.0;
+        g[k + 1] = -sines[k] * g[k];
+        g[k] *= cosines[k];
+
+        k++;
+        result.iterations++;
+        double estimate = std::abs(g[k]);
+        result.history.push_back(estimate);
+        if (estimate <= tolerance * b_norm || next == 0.0)
+          break;
+        std::vector<double> &v = basis[k];
+        v.resize(n);
+        for_blocks(n, [&](size_t, size_t lo, size_t hi) {
+          for (size_t i = lo; i < hi; i++)
+            v[i] = w[i] / next;
+        });
+      }
+
+      // 回代求 y，x += M⁻¹ (V y)
+      std::vector<double> y(k);
+      for (size_t i = k; i-- > 0;) {
+        double sum = g[i];
+        for (size_t j = i + 1; j < k; j++)
+          sum -= hessenberg[j][i] * y[j];
+        y[i] = hessenberg[i][i] != 0.0 ? sum / hessenberg[i][i] : 0.0;
+      }
+      std::fill(w.begin(), w.end(), 0.0);
+      for (size_t j = 0; j < k; j++)
+        axpy(y[j], basis[j], w);
+      preconditioner.apply(w, z);
+      axpy(1.0, z, result.x);
+      // 递推残差只是估计，由下一轮开头的真实残差确认是否收敛
+    }
+    finish(A, b, b_norm, result);
+    return result;
+  }
 };
 
 } // namespace algorithms
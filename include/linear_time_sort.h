@@ -23,6 +23,9 @@ class LinearTimeSort {
 public:
   /**
    * @brief 计数排序 - 算法导论第8.2节
+   *
+   * 教材版的串行实现；并行、支持记录与可复用工作区的版本见
+   * linear_time_sort_generic.h中的CountingSort。
    * @param arr 待排序数组，元素范围为[0, k]
    * @param k 数组中元素的最大值
    * @return 排序后的数组
@@ -1,13 +1,22 @@
 #ifndef LINEAR_TIME_SORT_GENERIC_H
 #define LINEAR_TIME_SORT_GENERIC_H
 
+#include "multithreaded_algorithms.h"
+#include "quick_sort_generic.h"
+#include "work_stealing_scheduler.h"
+#include "workload_generator.h"
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <numeric>
 #include <queue>
+#include <stdexcept>
+#include <thread>
 #include <type_traits>
 #include <vector>
 
@@ -17,16 +26,160 @@ namespace algorithms {
  * @brief 泛型线性时间排序算法实现
  *
  * 实现算法导论第8章线性时间排序算法，支持多种数据类型
- * - 计数排序（8.2节）- 适用于整数类型
- * - 基数排序（8.3节）- 适用于整数类型
- * - 桶排序（8.4节）- 适用于浮点数类型
+ * - 计数排序（8.2节）- 适用于整数类型（并行，支持按键排序记录）
+ * - 基数排序（8.3节）- 适用于整数和浮点数类型（字节数位，并行）
+ * - 桶排序（8.4节）- 适用于浮点数类型（按样本定桶，并行）
  */
 
+/**
+ * @brief 计数排序的工作区，可在多次调用之间复用以免重复分配
+ *
+ * - counts按(块, 键)排列，counts[chunk * (k + 1) + key]；先存各块直方图，
+ *   扫描后变为该块该键在输出中的起始位置
+ * - 排序结束后bucket_begin[key]是键key在输出中的起始下标，
+ *   bucket_begin[k + 1]等于元素总数，[bucket_begin[key], bucket_begin[key + 1])
+ *   即键key的区间
+ */
+struct CountingSortWorkspace {
+  std::vector<size_t> counts;
+  std::vector<size_t> bucket_begin;
+};
+
 /**
  * @brief 计数排序 - 适用于整数类型
+ *
+ * 稳定的并行计数排序：
+ * - 输入切成若干块，各块并行统计自己的直方图
+ * - 按(键, 块)的顺序对直方图做排除前缀和，得到每块每个键的起始位置
+ * - 各块再并行按原顺序把元素分发到输出，相等键保持输入顺序
+ * 块数不超过线程数，且保证直方图总大小不超过元素个数，k较大时自动减少块数。
+ * 支持按提取出的键排序任意记录（sort_records）与键值对排序（sort_by_key）。
  */
 template <typename T> class CountingSort {
-  static_assert(std::is_integral_v<T>, "计数排序仅适用于整数类型");
+  static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>,
+                "计数排序仅适用于整数类型");
+
+private:
+  using Index = std::make_unsigned_t<T>;
+
+  static constexpr size_t kMinChunk = size_t(1) << 16; // 每块最少元素数
+
+  static size_t chunk_count(size_t n, size_t buckets, size_t num_threads) {
+    size_t per_chunk = std::max(kMinChunk, buckets);
+    return std::max<size_t>(1, std::min(num_threads, n / per_chunk));
+  }
+
+  // 只排序整数本身时的emit：值由键唯一确定，不做分发，直接按区间写回base + key
+  struct FillKeys {
+    T *out;
+    Index base;
+  };
+
+  /**
+   * @brief 计数排序的核心：key_at(i)给出第i个元素映射后的键，
+   *        emit(i, p)把第i个元素写到输出的第p个位置（或为FillKeys）
+   * @param max_index 键的最大值，键超出[0, max_index]时抛出std::invalid_argument
+   * @param scheduler 为空时串行执行
+   */
+  template <typename KeyAt, typename Emit>
+  static void sort_impl(size_t n, const KeyAt &key_at, const Emit &emit,
+                        Index max_index, const char *range_error,
+                        CountingSortWorkspace &workspace,
+                        WorkStealingScheduler *scheduler) {
+    size_t buckets = static_cast<size_t>(max_index) + 1;
+    size_t chunks = scheduler ? chunk_count(n, buckets,
+                                            scheduler->get_num_threads())
+                              : 1;
+    size_t chunk_size = n == 0 ? 1 : (n + chunks - 1) / chunks;
+    workspace.counts.resize(chunks * buckets);
+    workspace.bucket_begin.resize(buckets + 1);
+    size_t *counts = workspace.counts.data();
+
+    auto for_each_chunk = [&](const auto &body) {
+      if (chunks == 1) {
+        body(size_t(0));
+        return;
+      }
+      scheduler->parallel_for(0, chunks, 1, [&](size_t lo, size_t hi) {
+        for (size_t c = lo; c < hi; ++c)
+          body(c);
+      });
+    };
+
+    // 各块的直方图
+    for_each_chunk([&](size_t c) {
+      size_t *count = counts + c * buckets;
+      std::fill(count, count + buckets, size_t(0));
+      size_t end = std::min(n, (c + 1) * chunk_size);
+      for (size_t i = c * chunk_size; i < end; ++i) {
+        Index key = key_at(i);
+        if (key > max_index) {
+          throw std::invalid_argument(range_error);
+        }
+        count[key]++;
+      }
+    });
+
+    // 按(键, 块)顺序做排除前缀和：块数很少，串行扫描的代价远小于一趟分发
+    size_t total = 0;
+    for (size_t key = 0; key < buckets; ++key) {
+      workspace.bucket_begin[key] = total;
+      for (size_t c = 0; c < chunks; ++c) {
+        size_t count = counts[c * buckets + key];
+        counts[c * buckets + key] = total;
+        total += count;
+      }
+    }
+    workspace.bucket_begin[buckets] = total;
+
+    if constexpr (std::is_same_v<Emit, FillKeys>) {
+      // 输出按位置均分给各块，块内从所在的键区间开始顺序填充
+      const size_t *begin = workspace.bucket_begin.data();
+      for_each_chunk([&](size_t c) {
+        size_t position = std::min(n, c * chunk_size);
+        size_t end = std::min(n, (c + 1) * chunk_size);
+        size_t key = static_cast<size_t>(
+            std::upper_bound(begin, begin + buckets + 1, position) - begin - 1);
+        for (; position < end; ++key) {
+          size_t run_end = std::min(end, begin[key + 1]);
+          std::fill(emit.out + position, emit.out + run_end,
+                    static_cast<T>(static_cast<Index>(emit.base + key)));
+          position = run_end;
+        }
+      });
+    } else {
+      // 稳定分发：块内按原顺序写到各键的区间
+      for_each_chunk([&](size_t c) {
+        size_t *position = counts + c * buckets;
+        size_t end = std::min(n, (c + 1) * chunk_size);
+        for (size_t i = c * chunk_size; i < end; ++i)
+          emit(i, position[key_at(i)]++);
+      });
+    }
+  }
+
+  /**
+   * @brief 元素够多时才创建调度器，小数组不付线程启动的代价
+   */
+  template <typename F>
+  static void with_scheduler(size_t n, size_t buckets, size_t num_threads,
+                             const F &f) {
+    if (chunk_count(n, buckets, num_threads) <= 1) {
+      f(static_cast<WorkStealingScheduler *>(nullptr));
+      return;
+    }
+    WorkStealingScheduler scheduler(num_threads);
+    f(&scheduler);
+  }
+
+  static Index checked_max_key(T k) {
+    if constexpr (std::is_signed_v<T>) {
+      if (k < 0) {
+        throw std::invalid_argument("k不能为负数");
+      }
+    }
+    return static_cast<Index>(k);
+  }
 
 public:
   /**
@@ -36,35 +189,32 @@ public:
    * @return 排序后的数组
    */
   static std::vector<T> sort(const std::vector<T> &arr, T k) {
+    return sort(arr, k, std::thread::hardware_concurrency());
+  }
+
+  /**
+   * @brief 计数排序（指定线程数）
+   * @param arr 待排序数组，元素范围为[0, k]
+   * @param k 数组中元素的最大值
+   * @param num_threads 线程数量
+   * @return 排序后的数组
+   */
+  static std::vector<T> sort(const std::vector<T> &arr, T k,
+                             size_t num_threads) {
     if (arr.empty())
       return {};
 
-    // 创建计数数组，大小为k+1
-    std::vector<size_t> count(static_cast<size_t>(k) + 1, 0);
-
-    // 统计每个元素出现的次数
-    for (T num : arr) {
-      if (num < 0 || num > k) {
-        throw std::invalid_argument("元素超出范围[0, k]");
-      }
-      count[static_cast<size_t>(num)]++;
-    }
-
-    // 计算累计计数
-    for (size_t i = 1; i <= static_cast<size_t>(k); ++i) {
-      count[i] += count[i - 1];
-    }
-
-    // 创建结果数组
+    Index max_index = checked_max_key(k);
     std::vector<T> result(arr.size());
-
-    // 从后往前遍历原数组，保证稳定性
-    for (int i = arr.size() - 1; i >= 0; --i) {
-      T num = arr[i];
-      result[count[static_cast<size_t>(num)] - 1] = num;
-      count[static_cast<size_t>(num)]--;
-    }
-
+    CountingSortWorkspace workspace;
+    with_scheduler(arr.size(), static_cast<size_t>(max_index) + 1, num_threads,
+                   [&](WorkStealingScheduler *scheduler) {
+                     sort_impl(
+                         arr.size(),
+                         [&](size_t i) { return static_cast<Index>(arr[i]); },
+                         FillKeys{result.data(), Index(0)}, max_index,
+                         "元素超出范围[0, k]", workspace, scheduler);
+                   });
     return result;
   }
 
@@ -77,38 +227,163 @@ public:
    */
   static std::vector<T> sort_general(const std::vector<T> &arr, T min_val,
                                      T max_val) {
+    return sort_general(arr, min_val, max_val,
+                        std::thread::hardware_concurrency());
+  }
+
+  /**
+   * @brief 计数排序的通用版本（指定线程数）
+   * @param arr 待排序数组
+   * @param min_val 元素的最小值
+   * @param max_val 元素的最大值
+   * @param num_threads 线程数量
+   * @return 排序后的数组
+   */
+  static std::vector<T> sort_general(const std::vector<T> &arr, T min_val,
+                                     T max_val, size_t num_threads) {
     if (arr.empty())
       return {};
+    if (max_val < min_val) {
+      throw std::invalid_argument("max_val不能小于min_val");
+    }
 
-    size_t range = static_cast<size_t>(max_val - min_val) + 1;
+    // 在无符号算术中减去min_val：小于min_val的元素回绕成很大的键，被范围检查拒绝
+    Index base = static_cast<Index>(min_val);
+    Index max_index = static_cast<Index>(static_cast<Index>(max_val) - base);
+    std::vector<T> result(arr.size());
+    CountingSortWorkspace workspace;
+    with_scheduler(
+        arr.size(), static_cast<size_t>(max_index) + 1, num_threads,
+        [&](WorkStealingScheduler *scheduler) {
+          sort_impl(
+              arr.size(),
+              [&](size_t i) {
+                return static_cast<Index>(static_cast<Index>(arr[i]) - base);
+              },
+              FillKeys{result.data(), base}, max_index,
+              "元素超出范围[min_val, max_val]", workspace, scheduler);
+        });
+    return result;
+  }
 
-    // 创建计数数组
-    std::vector<size_t> count(range, 0);
+  /**
+   * @brief 按下标的通用接口：键已经算好存在别处时使用（如样本桶排序的桶号）
+   * @param n 元素个数
+   * @param key_at key_at(i)返回第i个元素的键，范围为[0, k]
+   * @param emit emit(i, p)把第i个元素写到输出的第p个位置
+   * @param k 键的最大值
+   * @param workspace 调用者提供的工作区，结束后bucket_begin给出每个键的区间
+   * @param scheduler 执行并行阶段的调度器
+   */
+  template <typename KeyAt, typename Emit>
+  static void sort_indexed(size_t n, const KeyAt &key_at, const Emit &emit,
+                           T k, CountingSortWorkspace &workspace,
+                           WorkStealingScheduler &scheduler) {
+    Index max_index = checked_max_key(k);
+    sort_impl(
+        n, [&](size_t i) { return static_cast<Index>(key_at(i)); }, emit,
+        max_index, "键超出范围[0, k]", workspace, &scheduler);
+  }
 
-    // 统计每个元素出现的次数
-    for (T num : arr) {
-      if (num < min_val || num > max_val) {
-        throw std::invalid_argument("元素超出范围[min_val, max_val]");
-      }
-      count[static_cast<size_t>(num - min_val)]++;
-    }
+  /**
+   * @brief 按提取出的键稳定排序记录，记录整体随键移动
+   * @param first 输入记录的起始指针
+   * @param last 输入记录的尾后指针
+   * @param out 输出缓冲区，至少容纳last - first条记录，不能与输入重叠
+   * @param key_of 从记录中取键，返回值范围为[0, k]；每条记录会被调用两次
+   * @param k 键的最大值
+   * @param workspace 调用者提供的工作区，结束后bucket_begin给出每个键的区间
+   * @param scheduler 执行并行阶段的调度器
+   */
+  template <typename Record, typename KeyFn>
+  static void sort_records(const Record *first, const Record *last,
+                           Record *out, const KeyFn &key_of, T k,
+                           CountingSortWorkspace &workspace,
+                           WorkStealingScheduler &scheduler) {
+    Index max_index = checked_max_key(k);
+    sort_impl(
+        static_cast<size_t>(last - first),
+        [&](size_t i) { return static_cast<Index>(key_of(first[i])); },
+        [&](size_t i, size_t p) { out[p] = first[i]; }, max_index,
+        "键超出范围[0, k]", workspace, &scheduler);
+  }
 
-    // 计算累计计数
-    for (size_t i = 1; i < range; ++i) {
-      count[i] += count[i - 1];
-    }
+  /**
+   * @brief 按提取出的键稳定排序记录（使用调用者的输出与工作区）
+   * @param records 输入记录
+   * @param out 输出数组，会被调整为与输入等长
+   * @param key_of 从记录中取键，返回值范围为[0, k]
+   * @param k 键的最大值
+   * @param workspace 调用者提供的工作区，可在多次调用间复用
+   * @param num_threads 线程数量
+   */
+  template <typename Record, typename KeyFn>
+  static void
+  sort_records(const std::vector<Record> &records, std::vector<Record> &out,
+               const KeyFn &key_of, T k, CountingSortWorkspace &workspace,
+               size_t num_threads = std::thread::hardware_concurrency()) {
+    Index max_index = checked_max_key(k);
+    out.resize(records.size());
+    with_scheduler(
+        records.size(), static_cast<size_t>(max_index) + 1, num_threads,
+        [&](WorkStealingScheduler *scheduler) {
+          sort_impl(
+              records.size(),
+              [&](size_t i) { return static_cast<Index>(key_of(records[i])); },
+              [&](size_t i, size_t p) { out[p] = records[i]; }, max_index,
+              "键超出范围[0, k]", workspace, scheduler);
+        });
+  }
 
-    // 创建结果数组
-    std::vector<T> result(arr.size());
+  /**
+   * @brief 按提取出的键稳定排序记录
+   * @param records 输入记录
+   * @param key_of 从记录中取键，返回值范围为[0, k]
+   * @param k 键的最大值
+   * @param num_threads 线程数量
+   * @return 排序后的记录
+   */
+  template <typename Record, typename KeyFn>
+  static std::vector<Record>
+  sort_records(const std::vector<Record> &records, const KeyFn &key_of, T k,
+               size_t num_threads = std::thread::hardware_concurrency()) {
+    std::vector<Record> out;
+    CountingSortWorkspace workspace;
+    sort_records(records, out, key_of, k, workspace, num_threads);
+    return out;
+  }
 
-    // 从后往前遍历原数组，保证稳定性
-    for (int i = arr.size() - 1; i >= 0; --i) {
-      T num = arr[i];
-      result[count[static_cast<size_t>(num - min_val)] - 1] = num;
-      count[static_cast<size_t>(num - min_val)]--;
+  /**
+   * @brief 按键排序键值对（稳定）
+   * @param keys 键数组，元素范围为[0, k]，排序后有序
+   * @param values 值数组，随键一起移动
+   * @param k 键的最大值
+   * @param num_threads 线程数量
+   */
+  template <typename V>
+  static void
+  sort_by_key(std::vector<T> &keys, std::vector<V> &values, T k,
+              size_t num_threads = std::thread::hardware_concurrency()) {
+    if (keys.size() != values.size()) {
+      throw std::invalid_argument("键数组与值数组长度不一致");
     }
-
-    return result;
+    Index max_index = checked_max_key(k);
+    std::vector<T> key_buffer(keys.size());
+    std::vector<V> value_buffer(values.size());
+    CountingSortWorkspace workspace;
+    with_scheduler(keys.size(), static_cast<size_t>(max_index) + 1, num_threads,
+                   [&](WorkStealingScheduler *scheduler) {
+                     sort_impl(
+                         keys.size(),
+                         [&](size_t i) { return static_cast<Index>(keys[i]); },
+                         [&](size_t i, size_t p) {
+                           key_buffer[p] = keys[i];
+                           value_buffer[p] = std::move(values[i]);
+                         },
+                         max_index, "元素超出范围[0, k]", workspace, scheduler);
+                   });
+    keys.swap(key_buffer);
+    values.swap(value_buffer);
   }
 
   /**
@@ -127,45 +402,134 @@ public:
 };
 
 /**
- * @brief 基数排序 - 适用于整数类型
+ * @brief 基数排序 - 适用于整数和浮点数类型
+ *
+ * 以字节为数位（基数256）的LSD基数排序，sizeof(T)趟：
+ * - 键先映射为同宽的无符号整数：有符号数翻转符号位，浮点数负数取反、
+ *   非负数翻转符号位，映射后的无符号序与原数值序一致
+ * - 每趟把数组切成若干块，各块并行统计直方图；直方图按(数位, 块)排列，
+ *   做一次并行排除扫描即得每块每个数位的起始位置，再并行稳定分发
+ * - 原数组与一个辅助数组交替作为输入和输出；所有键在某一字节上相同时跳过该趟
+ * 支持键值对排序（sort_by_key）与argsort。
  */
 template <typename T> class RadixSort {
-  static_assert(std::is_integral_v<T>, "基数排序仅适用于整数类型");
+  static_assert((std::is_integral_v<T> && !std::is_same_v<T, bool>) ||
+                    std::is_floating_point_v<T>,
+                "基数排序仅适用于整数和浮点数类型");
+  static_assert(sizeof(T) <= 8, "基数排序的键最多64位");
 
 private:
-  /**
-   * @brief 按指定位数进行计数排序（辅助函数）
-   * @param arr 待排序数组
-   * @param exp 当前位数（1, 10, 100, ...）
-   * @return 按当前位排序后的数组
-   */
-  static std::vector<T> counting_sort_by_digit(const std::vector<T> &arr,
-                                               T exp) {
-    std::vector<size_t> count(10, 0);
+  using Key = std::conditional_t<
+      sizeof(T) == 8, uint64_t,
+      std::conditional_t<sizeof(T) == 4, uint32_t,
+                         std::conditional_t<sizeof(T) == 2, uint16_t,
+                                            uint8_t>>>;
 
-    // 统计每个数字在当前位的出现次数
-    for (T num : arr) {
-      int digit = static_cast<int>((num / exp) % 10);
-      count[digit]++;
-    }
+  static constexpr int kDigitBits = 8;
+  static constexpr size_t kBuckets = size_t(1) << kDigitBits;
+  static constexpr int kPasses = sizeof(T);
+  static constexpr size_t kMinChunk = size_t(1) << 16; // 每块最少元素数
 
-    // 计算累计计数
-    for (int i = 1; i < 10; ++i) {
-      count[i] += count[i - 1];
+  struct NoValue {};
+
+  /**
+   * @brief 把键映射为保序的无符号整数
+   */
+  static Key to_key(T x) {
+    Key bits;
+    std::memcpy(&bits, &x, sizeof(T));
+    constexpr Key sign = Key(1) << (sizeof(T) * 8 - 1);
+    if constexpr (std::is_floating_point_v<T>) {
+      return (bits & sign) ? static_cast<Key>(~bits)
+                           : static_cast<Key>(bits ^ sign);
+    } else if constexpr (std::is_signed_v<T>) {
+      return static_cast<Key>(bits ^ sign);
+    } else {
+      return bits;
     }
+  }
 
-    // 创建结果数组
-    std::vector<T> result(arr.size());
+  static size_t digit_of(T x, int shift) {
+    return static_cast<size_t>(to_key(x) >> shift) & (kBuckets - 1);
+  }
 
-    // 从后往前遍历原数组，保证稳定性
-    for (int i = arr.size() - 1; i >= 0; --i) {
-      T num = arr[i];
-      int digit = static_cast<int>((num / exp) % 10);
-      result[count[digit] - 1] = num;
-      count[digit]--;
+  /**
+   * @brief 对keys（以及可选的values）做LSD基数排序，结果留在原vector中
+   */
+  template <typename V>
+  static void sort_impl(std::vector<T> &keys, std::vector<V> *values,
+                        size_t num_threads) {
+    constexpr bool with_values = !std::is_same_v<V, NoValue>;
+    size_t n = keys.size();
+    if (n <= 1)
+      return;
+
+    WorkStealingScheduler scheduler(num_threads);
+    size_t chunks = std::max<size_t>(
+        1, std::min(scheduler.get_num_threads(), (n + kMinChunk - 1) / kMinChunk));
+    size_t chunk_size = (n + chunks - 1) / chunks;
+    chunks = (n + chunk_size - 1) / chunk_size;
+
+    std::vector<T> key_buffer(n);
+    std::vector<V> value_buffer(with_values ? n : 0);
+    std::vector<size_t> offsets(kBuckets * chunks); // offsets[digit * chunks + chunk]
+
+    T *src = keys.data(), *dst = key_buffer.data();
+    V *value_src = with_values ? values->data() : nullptr;
+    V *value_dst = value_buffer.data();
+
+    for (int pass = 0; pass < kPasses; ++pass) {
+      int shift = pass * kDigitBits;
+
+      // 各块的直方图
+      scheduler.parallel_for(0, chunks, 1, [&](size_t lo, size_t hi) {
+        for (size_t c = lo; c < hi; ++c) {
+          size_t count[kBuckets] = {};
+          size_t end = std::min(n, (c + 1) * chunk_size);
+          for (size_t i = c * chunk_size; i < end; ++i)
+            count[digit_of(src[i], shift)]++;
+          for (size_t d = 0; d < kBuckets; ++d)
+            offsets[d * chunks + c] = count[d];
+        }
+      });
+
+      // 所有键这一字节相同：本趟是恒等排列
+      size_t first_total = 0;
+      for (size_t d = 0; d < kBuckets && first_total == 0; ++d)
+        for (size_t c = 0; c < chunks; ++c)
+          first_total += offsets[d * chunks + c];
+      if (first_total == n)
+        continue;
+
+      MultithreadedAlgorithms::parallel_exclusive_scan(scheduler,
+                                                       offsets.data(),
+                                                       offsets.size());
+
+      // 稳定分发：块内按原顺序写到各数位的区间
+      scheduler.parallel_for(0, chunks, 1, [&](size_t lo, size_t hi) {
+        for (size_t c = lo; c < hi; ++c) {
+          size_t position[kBuckets];
+          for (size_t d = 0; d < kBuckets; ++d)
+            position[d] = offsets[d * chunks + c];
+          size_t end = std::min(n, (c + 1) * chunk_size);
+          for (size_t i = c * chunk_size; i < end; ++i) {
+            size_t p = position[digit_of(src[i], shift)]++;
+            dst[p] = src[i];
+            if constexpr (with_values)
+              value_dst[p] = std::move(value_src[i]);
+          }
+        }
+      });
+
+      std::swap(src, dst);
+      std::swap(value_src, value_dst);
     }
 
-    return result;
+    if (src != keys.data()) {
+      keys.swap(key_buffer);
+      if constexpr (with_values)
+        values->swap(value_buffer);
+    }
   }
 
 public:
@@ -175,20 +539,104 @@ public:
    * @return 排序后的数组
    */
   static std::vector<T> sort(const std::vector<T> &arr) {
-    if (arr.empty())
-      return {};
-
-    // 找到数组中的最大值，确定最大位数
-    T max_val = *std::max_element(arr.begin(), arr.end());
+    return sort(arr, std::thread::hardware_concurrency());
+  }
 
-    // 对每一位进行计数排序
+  /**
+   * @brief 基数排序（指定线程数）
+   * @param arr 待排序数组
+   * @param num_threads 线程数量
+   * @return 排序后的数组
+   */
+  static std::vector<T> sort(const std::vector<T> &arr, size_t num_threads) {
     std::vector<T> result = arr;
+    sort_in_place(result, num_threads);
+    return result;
+  }
 
-    for (T exp = 1; max_val / exp > 0; exp *= 10) {
-      result = counting_sort_by_digit(result, exp);
+  /**
+   * @brief 原地基数排序
+   * @param arr 待排序数组
+   * @param num_threads 线程数量
+   */
+  static void
+  sort_in_place(std::vector<T> &arr,
+                size_t num_threads = std::thread::hardware_concurrency()) {
+    sort_impl<NoValue>(arr, nullptr, num_threads);
+  }
+
+  /**
+   * @brief 串行对区间[first, last)做基数排序，结果留在原区间
+   *
+   * 一趟读入同时统计所有字节的直方图，某一字节上所有键相同时跳过该趟。
+   * 供桶排序对单个桶排序，并行由调用者负责。
+   * @param first 区间起点
+   * @param last 区间终点
+   * @param buffer 辅助空间，至少容纳last - first个元素
+   */
+  static void sort_range(T *first, T *last, T *buffer) {
+    size_t n = static_cast<size_t>(last - first);
+    if (n <= 1)
+      return;
+
+    size_t count[kPasses][kBuckets] = {};
+    for (size_t i = 0; i < n; ++i) {
+      Key key = to_key(first[i]);
+      for (int pass = 0; pass < kPasses; ++pass)
+        count[pass][static_cast<size_t>(key >> (pass * kDigitBits)) &
+                    (kBuckets - 1)]++;
     }
 
-    return result;
+    T *src = first, *dst = buffer;
+    for (int pass = 0; pass < kPasses; ++pass) {
+      int shift = pass * kDigitBits;
+      size_t *position = count[pass];
+      if (position[digit_of(src[0], shift)] == n)
+        continue;
+      size_t total = 0;
+      for (size_t d = 0; d < kBuckets; ++d) {
+        size_t c = position[d];
+        position[d] = total;
+        total += c;
+      }
+      for (size_t i = 0; i < n; ++i)
+        dst[position[digit_of(src[i], shift)]++] = src[i];
+      std::swap(src, dst);
+    }
+    if (src != first)
+      std::copy(src, src + n, first);
+  }
+
+  /**
+   * @brief 按键排序键值对（稳定）
+   * @param keys 键数组，排序后有序
+   * @param values 值数组，随键一起移动
+   * @param num_threads 线程数量
+   */
+  template <typename V>
+  static void
+  sort_by_key(std::vector<T> &keys, std::vector<V> &values,
+              size_t num_threads = std::thread::hardware_concurrency()) {
+    if (keys.size() != values.size()) {
+      throw std::invalid_argument("键数组与值数组长度不一致");
+    }
+    sort_impl<V>(keys, &values, num_threads);
+  }
+
+  /**
+   * @brief 返回使keys有序的下标排列（相等键保持原顺序）
+   * @param keys 键数组
+   * @param num_threads 线程数量
+   * @return 下标数组order，keys[order[0]] <= keys[order[1]] <= ...
+   */
+  static std::vector<size_t>
+  argsort(const std::vector<T> &keys,
+          size_t num_threads = std::thread::hardware_concurrency()) {
+    std::vector<T> sorted_keys = keys;
+    std::vector<size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+    sort_by_key(sorted_keys, order, num_threads);
+    return order;
   }
 
   /**
@@ -208,27 +656,105 @@ public:
 
 /**
  * @brief 桶排序 - 适用于浮点数类型
+ *
+ * 教材中的桶排序把值域均分成n个桶，输入偏斜时少数几个桶装下大部分元素，
+ * 桶内插入排序退化为平方时间。这里按样本定桶（自适应桶排序）：
+ * - 随机取样排序，等距取分割元素，桶边界随数据的密度自适应；
+ *   每个分割元素另有一个相等桶，大量重复值不必再排序
+ * - 桶号先存入数组，再用并行计数排序把元素稳定分发到一个连续的输出数组，
+ *   每个桶就是其中的一段区间，没有嵌套vector
+ * - 各桶并行排序：不小于kRadixThreshold的桶用基数排序，其余用内省排序
+ * sort与sort_general保留原有的范围检查，内部使用同一实现。不支持NaN。
  */
 template <typename T> class BucketSort {
   static_assert(std::is_floating_point_v<T>, "桶排序仅适用于浮点数类型");
 
 private:
+  using Classifier = sample_sort_detail::SampleClassifier<T, std::less<T>>;
+
+  static constexpr size_t kTargetBucket = size_t(1) << 12; // 期望的每桶元素数
+  static constexpr size_t kMaxLevels = 12;     // 最多2^12个区间，桶号放得进uint16_t
+  static constexpr size_t kOversampling = 16;  // 每个区间的样本数
+  static constexpr size_t kRadixThreshold = size_t(1) << 10;
+  static constexpr size_t kClassifyBatch = 16; // 一批交错下降的元素数
+  static constexpr size_t kClassifyGrain = size_t(1) << 14;
+
+  // 取样确定分割元素：区间数 2^levels 约为 n / kTargetBucket
+  static Classifier build_classifier(const T *data, size_t n) {
+    Classifier classifier{1, 0, {}, {}, std::less<T>()};
+    while (classifier.levels < kMaxLevels &&
+           (kTargetBucket << classifier.levels) < n) {
+      ++classifier.levels;
+    }
+    classifier.leaves = size_t(1) << classifier.levels;
+    std::vector<T> sample(classifier.leaves * kOversampling);
+    RandomStream random(n);
+    for (T &x : sample) {
+      x = data[random.bounded(n)];
+    }
+    QuickSortGeneric<T>::introsort(sample.data(), sample.data() + sample.size());
+    classifier.splitters.resize(classifier.leaves);
+    for (size_t j = 0; j + 1 < classifier.leaves; ++j) {
+      classifier.splitters[j] = sample[(j + 1) * kOversampling - 1];
+    }
+    classifier.splitters.back() = classifier.splitters[classifier.leaves - 2];
+    classifier.tree.resize(classifier.leaves);
+    size_t next = 0;
+    classifier.build_tree(1, next);
+    return classifier;
+  }
+
   /**
-   * @brief 插入排序（用于桶排序中的桶内排序）
-   * @param arr 待排序数组
+   * @brief 自适应桶排序的核心：data的n个元素排好序写入out，data随后用作辅助空间
    */
-  static void insertion_sort(std::vector<T> &arr) {
-    for (size_t i = 1; i < arr.size(); ++i) {
-      T key = arr[i];
-      int j = i - 1;
-
-      while (j >= 0 && arr[j] > key) {
-        arr[j + 1] = arr[j];
-        j--;
+  static void adaptive_sort_impl(T *data, T *out, size_t n,
+                                 WorkStealingScheduler &scheduler) {
+    const Classifier classifier = build_classifier(data, n);
+    const size_t buckets = classifier.num_buckets();
+
+    // 分类：每个元素的桶号
+    std::vector<uint16_t> ids(n);
+    scheduler.parallel_for(0, n, kClassifyGrain, [&](size_t lo, size_t hi) {
+      bool has_nan = false;
+      size_t i = lo;
+      for (; i + kClassifyBatch <= hi; i += kClassifyBatch) {
+        size_t index[kClassifyBatch];
+        classifier.template bucket_batch<kClassifyBatch>(data + i, index);
+        for (size_t e = 0; e < kClassifyBatch; ++e) {
+          ids[i + e] = static_cast<uint16_t>(index[e]);
+          has_nan |= std::isnan(data[i + e]);
+        }
       }
-
-      arr[j + 1] = key;
-    }
+      for (; i < hi; ++i) {
+        ids[i] = static_cast<uint16_t>(classifier.bucket(data[i]));
+        has_nan |= std::isnan(data[i]);
+      }
+      if (has_nan) {
+        throw std::invalid_argument("桶排序不支持NaN");
+      }
+    });
+
+    // 按桶号计数排序，桶即输出中的区间
+    CountingSortWorkspace workspace;
+    CountingSort<uint16_t>::sort_indexed(
+        n, [&](size_t i) { return ids[i]; },
+        [&](size_t i, size_t p) { out[p] = data[i]; },
+        static_cast<uint16_t>(buckets - 1), workspace, scheduler);
+
+    // 各桶并行排序；奇数号的相等桶已经有序
+    const size_t *begin = workspace.bucket_begin.data();
+    scheduler.parallel_for(0, buckets, 1, [&](size_t lo, size_t hi) {
+      for (size_t b = lo; b < hi; ++b) {
+        if (b % 2 == 1)
+          continue;
+        T *first = out + begin[b], *last = out + begin[b + 1];
+        if (static_cast<size_t>(last - first) >= kRadixThreshold) {
+          RadixSort<T>::sort_range(first, last, data + begin[b]);
+        } else {
+          QuickSortGeneric<T>::introsort(first, last);
+        }
+      }
+    });
   }
 
 public:
@@ -238,39 +764,13 @@ public:
    * @return 排序后的数组
    */
   static std::vector<T> sort(const std::vector<T> &arr) {
-    if (arr.empty())
-      return {};
-
     // 验证输入范围
     for (T num : arr) {
       if (num < 0.0 || num >= 1.0) {
         throw std::invalid_argument("桶排序要求元素在[0, 1)范围内");
       }
     }
-
-    int n = arr.size();
-
-    // 创建n个桶
-    std::vector<std::vector<T>> buckets(n);
-
-    // 将元素分配到桶中
-    for (T num : arr) {
-      int bucket_index = static_cast<int>(n * num);
-      buckets[bucket_index].push_back(num);
-    }
-
-    // 对每个桶进行排序（使用插入排序）
-    for (auto &bucket : buckets) {
-      insertion_sort(bucket);
-    }
-
-    // 合并所有桶
-    std::vector<T> result;
-    for (const auto &bucket : buckets) {
-      result.insert(result.end(), bucket.begin(), bucket.end());
-    }
-
-    return result;
+    return adaptive_sort(arr);
   }
 
   /**
@@ -282,44 +782,50 @@ public:
    */
   static std::vector<T> sort_general(const std::vector<T> &arr, T min_val,
                                      T max_val) {
-    if (arr.empty())
-      return {};
-
-    int n = arr.size();
-
-    // 创建n个桶
-    std::vector<std::vector<T>> buckets(n);
-
-    // 将元素分配到桶中
     for (T num : arr) {
       if (num < min_val || num > max_val) {
         throw std::invalid_argument("元素超出范围[min_val, max_val]");
       }
-
-      // 将元素映射到[0, 1)范围
-      T normalized = (num - min_val) / (max_val - min_val);
-      int bucket_index = static_cast<int>(n * normalized);
-
-      // 处理边界情况：当num等于max_val时
-      if (bucket_index == n) {
-        bucket_index = n - 1;
-      }
-
-      buckets[bucket_index].push_back(num);
     }
+    return adaptive_sort(arr);
+  }
 
-    // 对每个桶进行排序（使用插入排序）
-    for (auto &bucket : buckets) {
-      insertion_sort(bucket);
-    }
+  /**
+   * @brief 自适应桶排序：按样本定桶，不要求值域已知或分布均匀
+   * @param arr 待排序数组，不能含NaN
+   * @param num_threads 线程数量
+   * @return 排序后的数组
+   */
+  static std::vector<T>
+  adaptive_sort(const std::vector<T> &arr,
+                size_t num_threads = std::thread::hardware_concurrency()) {
+    std::vector<T> result = arr;
+    adaptive_sort_in_place(result, num_threads);
+    return result;
+  }
 
-    // 合并所有桶
-    std::vector<T> result;
-    for (const auto &bucket : buckets) {
-      result.insert(result.end(), bucket.begin(), bucket.end());
+  /**
+   * @brief 原地自适应桶排序（额外使用n个元素的辅助数组与n个桶号）
+   * @param arr 待排序数组，不能含NaN
+   * @param num_threads 线程数量
+   */
+  static void adaptive_sort_in_place(
+      std::vector<T> &arr,
+      size_t num_threads = std::thread::hardware_concurrency()) {
+    size_t n = arr.size();
+    if (n < 2 * kTargetBucket) {
+      // 不到两个桶：直接内省排序
+      if (std::any_of(arr.begin(), arr.end(),
+                      [](T x) { return std::isnan(x); })) {
+        throw std::invalid_argument("桶排序不支持NaN");
+      }
+      QuickSortGeneric<T>::introsort(arr.data(), arr.data() + n);
+      return;
     }
-
-    return result;
+    WorkStealingScheduler scheduler(num_threads);
+    std::vector<T> buffer(n);
+    adaptive_sort_impl(arr.data(), buffer.data(), n, scheduler);
+    arr.swap(buffer);
   }
 
   /**
@@ -379,6 +885,8 @@ using CountingSortInt = CountingSort<int>;
 using CountingSortLong = CountingSort<long>;
 using RadixSortInt = RadixSort<int>;
 using RadixSortLong = RadixSort<long>;
+using RadixSortFloat = RadixSort<float>;
+using RadixSortDouble = RadixSort<double>;
 using BucketSortFloat = BucketSort<float>;
 using BucketSortDouble = BucketSort<double>;
 
@@ -1,9 +1,17 @@
 #ifndef LINKED_LIST_H
 #define LINKED_LIST_H
 
+#include "slab_allocator.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <new>
 #include <stdexcept>
+#include <utility>
 
 namespace algorithms {
 
@@ -473,6 +481,667 @@ public:
   }
 };
 
+/**
+ * @brief 展开链表（unrolled linked list）
+ *
+ * 每个节点内联存放最多 kCapacity 个元素，节点默认恰好占一条64字节的缓存行：
+ * int 元素时每个节点11个，搜索时在节点内顺序扫描连续内存，访问的缓存行数
+ * 约为普通链表的1/kCapacity。元素大到一个节点放不下两个时（如 std::string），
+ * 节点按两个元素定大小，超出 NodeBytes。节点来自链表自己的 SlabAllocator，不再逐个
+ * new/delete，也没有 shared_ptr 的引用计数。
+ *
+ * 节点满时分裂成两半；删除后节点不足半满且能与后继合并时合并，
+ * 因此除末尾节点外每个节点至少约半满。
+ */
+template <typename T, size_t NodeBytes = 64> class UnrolledLinkedList {
+  static constexpr size_t kHeaderBytes = 2 * sizeof(void *) + sizeof(uint32_t);
+
+public:
+  // 至少两个元素：容量为1时满节点分裂腾不出空位
+  static constexpr size_t kCapacity = std::max<size_t>(
+      2, NodeBytes > kHeaderBytes ? (NodeBytes - kHeaderBytes) / sizeof(T) : 0);
+
+  /**
+   * @brief 默认构造函数
+   * @param nodes_per_slab 分配器每次向系统申请的节点数
+   */
+  explicit UnrolledLinkedList(size_t nodes_per_slab = 256)
+      : pool(std::make_unique<SlabAllocator<Node>>(nodes_per_slab)) {}
+
+  UnrolledLinkedList(const UnrolledLinkedList &) = delete;
+  UnrolledLinkedList &operator=(const UnrolledLinkedList &) = delete;
+  UnrolledLinkedList(UnrolledLinkedList &&other) noexcept
+      : pool(std::move(other.pool)),
+        head(std::exchange(other.head, nullptr)),
+        tail(std::exchange(other.tail, nullptr)),
+        count(std::exchange(other.count, 0)),
+        nodes(std::exchange(other.nodes, 0)) {}
+
+  ~UnrolledLinkedList() {
+    if (pool != nullptr) {
+      clear();
+    }
+  }
+
+  /**
+   * @brief 在链表尾端插入元素
+   */
+  void push_back(const T &value) { insert_into(tail_for_append(), tail_count(), value); }
+  void push_back(T &&value) {
+    insert_into(tail_for_append(), tail_count(), std::move(value));
+  }
+
+  /**
+   * @brief 在链表前端插入元素（LIST-INSERT操作）
+   */
+  void push_front(const T &value) { insert(0, value); }
+  void push_front(T &&value) { insert(0, std::move(value)); }
+
+  /**
+   * @brief 在第index个位置插入元素，O(n / kCapacity)
+   * @throws std::out_of_range 如果index大于元素个数
+   */
+  template <typename U> void insert(size_t index, U &&value) {
+    if (index > count) {
+      throw std::out_of_range("插入位置越界");
+    }
+    if (index == count) {
+      insert_into(tail_for_append(), tail_count(), std::forward<U>(value));
+      return;
+    }
+    auto [node, offset] = locate(index);
+    insert_into(node, offset, std::forward<U>(value));
+  }
+
+  /**
+   * @brief 搜索包含指定值的元素（LIST-SEARCH操作）
+   * @return 指向该元素的指针，如果未找到返回nullptr；
+   *         指针在下一次插入或删除前有效
+   */
+  T *search(const T &key) {
+    for (Node *node = head; node != nullptr; node = node->next) {
+      T *first = node->items(), *last = first + node->count;
+      T *found = std::find(first, last, key);
+      if (found != last) {
+        return found;
+      }
+    }
+    return nullptr;
+  }
+
+  bool contains(const T &key) { return search(key) != nullptr; }
+
+  /**
+   * @brief 删除第一个值等于value的元素
+   * @return 删除成功返回true，否则返回false
+   */
+  bool remove_value(const T &value) {
+    for (Node *node = head; node != nullptr; node = node->next) {
+      T *first = node->items(), *last = first + node->count;
+      T *found = std::find(first, last, value);
+      if (found != last) {
+        erase_from(node, static_cast<size_t>(found - first));
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief 删除第index个元素
+   * @throws std::out_of_range 如果index越界
+   */
+  void erase(size_t index) {
+    if (index >= count) {
+      throw std::out_of_range("删除位置越界");
+    }
+    auto [node, offset] = locate(index);
+    erase_from(node, offset);
+  }
+
+  T pop_front() {
+    if (empty()) {
+      throw std::underflow_error("链表为空");
+    }
+    T value = std::move(head->items()[0]);
+    erase_from(head, 0);
+    return value;
+  }
+
+  T pop_back() {
+    if (empty()) {
+      throw std::underflow_error("链表为空");
+    }
+    T value = std::move(tail->items()[tail->count - 1]);
+    erase_from(tail, tail->count - 1);
+    return value;
+  }
+
+  T &front() {
+    if (empty()) {
+      throw std::underflow_error("链表为空");
+    }
+    return head->items()[0];
+  }
+
+  T &back() {
+    if (empty()) {
+      throw std::underflow_error("链表为空");
+    }
+    return tail->items()[tail->count - 1];
+  }
+
+  /**
+   * @brief 第index个元素，O(n / kCapacity)
+   * @throws std::out_of_range 如果index越界
+   */
+  T &at(size_t index) {
+    if (index >= count) {
+      throw std::out_of_range("下标越界");
+    }
+    auto [node, offset] = locate(index);
+    return node->items()[offset];
+  }
+
+  /**
+   * @brief 按顺序对每个元素调用visit
+   */
+  template <typename Visitor> void for_each(Visitor visit) const {
+    for (const Node *node = head; node != nullptr; node = node->next) {
+      for (uint32_t i = 0; i < node->count; ++i) {
+        visit(node->items()[i]);
+      }
+    }
+  }
+
+  void clear() {
+    Node *node = head;
+    while (node != nullptr) {
+      Node *next = node->next;
+      destroy_node(node);
+      node = next;
+    }
+    head = tail = nullptr;
+    count = 0;
+  }
+
+  size_t size() const { return count; }
+
+  bool empty() const { return count == 0; }
+
+  /**
+   * @brief 当前节点数
+   */
+  size_t node_count() const { return nodes; }
+
+  /**
+   * @brief 分配器向系统申请的字节数
+   */
+  size_t bytes_reserved() const { return pool->bytes_reserved(); }
+
+  /**
+   * @brief 打印展开链表的内容，节点之间用 | 分隔
+   */
+  void print() const {
+    std::cout << "展开链表: ";
+    for (const Node *node = head; node != nullptr; node = node->next) {
+      std::cout << "[";
+      for (uint32_t i = 0; i < node->count; ++i) {
+        std::cout << (i ? " " : "") << node->items()[i];
+      }
+      std::cout << "]" << (node->next != nullptr ? " | " : "");
+    }
+    std::cout << std::endl;
+  }
+
+private:
+  struct alignas(NodeBytes % 64 == 0 && alignof(T) <= 64
+                     ? 64
+                     : std::max(alignof(T), alignof(void *))) Node {
+    Node *prev = nullptr;
+    Node *next = nullptr;
+    uint32_t count = 0;
+    alignas(T) unsigned char storage[kCapacity * sizeof(T)];
+
+    T *items() { return std::launder(reinterpret_cast<T *>(storage)); }
+    const T *items() const {
+      return std::launder(reinterpret_cast<const T *>(storage));
+    }
+  };
+
+  std::unique_ptr<SlabAllocator<Node>> pool;
+  Node *head = nullptr;
+  Node *tail = nullptr;
+  size_t count = 0;
+  size_t nodes = 0;
+
+  // 第index个元素所在的节点和节点内偏移；从离得近的一端开始找
+  std::pair<Node *, size_t> locate(size_t index) const {
+    if (index < count / 2) {
+      Node *node = head;
+      while (index >= node->count) {
+        index -= node->count;
+        node = node->next;
+      }
+      return {node, index};
+    }
+    size_t from_back = count - index;
+    Node *node = tail;
+    while (from_back > node->count) {
+      from_back -= node->count;
+      node = node->prev;
+    }
+    return {node, node->count - from_back};
+  }
+
+  Node *tail_for_append() {
+    if (tail == nullptr) {
+      head = tail = new_node_after(nullptr);
+    }
+    return tail;
+  }
+
+  size_t tail_count() const { return tail == nullptr ? 0 : tail->count; }
+
+  Node *new_node_after(Node *prev) {
+    Node *node = new (pool->allocate()) Node();
+    node->prev = prev;
+    if (prev != nullptr) {
+      node->next = prev->next;
+      prev->next = node;
+      if (node->next != nullptr) {
+        node->next->prev = node;
+      } else {
+        tail = node;
+      }
+    }
+    ++nodes;
+    return node;
+  }
+
+  void destroy_node(Node *node) {
+    std::destroy_n(node->items(), node->count);
+    node->~Node();
+    pool->deallocate(node);
+    --nodes;
+  }
+
+  void unlink(Node *node) {
+    (node->prev != nullptr ? node->prev->next : head) = node->next;
+    (node->next != nullptr ? node->next->prev : tail) = node->prev;
+    node->count = 0;
+    destroy_node(node);
+  }
+
+  // 把 src 的 [from, src->count) 移到 dst 末尾
+  static void move_tail(Node *src, size_t from, Node *dst) {
+    T *s = src->items(), *d = dst->items();
+    for (size_t i = from; i < src->count; ++i) {
+      new (d + dst->count++) T(std::move(s[i]));
+      s[i].~T();
+    }
+    src->count = static_cast<uint32_t>(from);
+  }
+
+  // 在 node 的 offset 处插入；节点满时先把后一半分到新节点
+  template <typename U> void insert_into(Node *node, size_t offset, U &&value) {
+    if (node->count == kCapacity) {
+      Node *right = new_node_after(node);
+      size_t half = (kCapacity + 1) / 2;
+      move_tail(node, half, right);
+      if (offset > half) {
+        node = right;
+        offset -= half;
+      }
+    }
+    T *items = node->items();
+    if (offset == node->count) {
+      new (items + offset) T(std::forward<U>(value));
+    } else {
+      new (items + node->count) T(std::move(items[node->count - 1]));
+      std::move_backward(items + offset, items + node->count - 1,
+                         items + node->count);
+      items[offset] = T(std::forward<U>(value));
+    }
+    ++node->count;
+    ++count;
+  }
+
+  // 删除 node 的第 offset 个元素；节点空了就摘除，不足半满时尝试并入后继
+  void erase_from(Node *node, size_t offset) {
+    T *items = node->items();
+    std::move(items + offset + 1, items + node->count, items + offset);
+    items[--node->count].~T();
+    --count;
+    if (node->count == 0) {
+      unlink(node);
+      return;
+    }
+    Node *next = node->next;
+    if (next != nullptr && node->count < kCapacity / 2 &&
+        node->count + next->count <= kCapacity) {
+      move_tail(next, 0, node);
+      unlink(next);
+    }
+  }
+};
+
+/**
+ * @brief 侵入式链表的挂钩
+ *
+ * 元素类型公有继承 IntrusiveListHook<Tag> 后即可放进 IntrusiveList<T, Tag>；
+ * 用不同的 Tag 继承多个挂钩，同一个对象就能同时挂在多条链表上。
+ */
+template <typename Tag = void> struct IntrusiveListHook {
+  IntrusiveListHook *prev = nullptr;
+  IntrusiveListHook *next = nullptr;
+
+  /**
+   * @brief 是否挂在某条链表上
+   */
+  bool is_linked() const { return next != nullptr; }
+};
+
+/**
+ * @brief 带哨兵的侵入式双向循环链表（10.2节的 L.nil）
+ *
+ * 链表不拥有元素，也不分配内存：前驱和后继指针就在元素自己的挂钩里，
+ * 插入、删除、移到队头、整条链表拼接（splice）都是O(1)且不会失败。
+ * 元素的生命周期由调用者管理，通常来自 NodePool；元素析构前必须先从链表删除。
+ */
+template <typename T, typename Tag = void> class IntrusiveList {
+public:
+  using Hook = IntrusiveListHook<Tag>;
+
+  template <bool Const> class Iterator {
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T *, T *>;
+    using reference = std::conditional_t<Const, const T &, T &>;
+
+    Iterator() = default;
+    explicit Iterator(Hook *hook) : hook(hook) {}
+
+    reference operator*() const { return *static_cast<pointer>(hook); }
+    pointer operator->() const { return static_cast<pointer>(hook); }
+    Iterator &operator++() {
+      hook = hook->next;
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator old = *this;
+      hook = hook->next;
+      return old;
+    }
+    Iterator &operator--() {
+      hook = hook->prev;
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator old = *this;
+      hook = hook->prev;
+      return old;
+    }
+    bool operator==(const Iterator &other) const { return hook == other.hook; }
+    bool operator!=(const Iterator &other) const { return hook != other.hook; }
+
+  private:
+    Hook *hook = nullptr;
+  };
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  IntrusiveList() { nil.prev = nil.next = &nil; }
+
+  IntrusiveList(const IntrusiveList &) = delete;
+  IntrusiveList &operator=(const IntrusiveList &) = delete;
+
+  IntrusiveList(IntrusiveList &&other) noexcept : IntrusiveList() {
+    splice_back(other);
+  }
+
+  /**
+   * @brief 析构时只摘除元素，不析构它们
+   */
+  ~IntrusiveList() { clear(); }
+
+  void push_front(T &x) { link_before(nil.next, &x); }
+
+  void push_back(T &x) { link_before(&nil, &x); }
+
+  /**
+   * @brief 把x插入到pos之前
+   */
+  void insert_before(T &pos, T &x) { link_before(hook_of(pos), &x); }
+
+  /**
+   * @brief 从链表删除x（LIST-DELETE'，有哨兵时无需判断边界），O(1)
+   * @throws std::invalid_argument 如果x不在任何链表上
+   */
+  void remove(T &x) {
+    Hook *hook = hook_of(x);
+    if (!hook->is_linked()) {
+      throw std::invalid_argument("元素不在链表中");
+    }
+    unlink(hook);
+  }
+
+  T &pop_front() {
+    T &x = front();
+    unlink(nil.next);
+    return x;
+  }
+
+  T &pop_back() {
+    T &x = back();
+    unlink(nil.prev);
+    return x;
+  }
+
+  T &front() {
+    if (empty()) {
+      throw std::underflow_error("链表为空");
+    }
+    return *static_cast<T *>(nil.next);
+  }
+
+  T &back() {
+    if (empty()) {
+      throw std::underflow_error("链表为空");
+    }
+    return *static_cast<T *>(nil.prev);
+  }
+
+  /**
+   * @brief 把已在本链表中的x移到表头，O(1)（LRU缓存的“最近使用”）
+   */
+  void move_to_front(T &x) {
+    Hook *hook = hook_of(x);
+    if (nil.next != hook) {
+      unlink(hook);
+      link_before(nil.next, hook);
+    }
+  }
+
+  /**
+   * @brief 把other的全部元素按原顺序接到本链表尾部，O(1)
+   */
+  void splice_back(IntrusiveList &other) { splice_before(&nil, other); }
+
+  /**
+   * @brief 把other的全部元素按原顺序接到本链表头部，O(1)
+   */
+  void splice_front(IntrusiveList &other) { splice_before(nil.next, other); }
+
+  /**
+   * @brief 把other的全部元素按原顺序插到pos之前，O(1)
+   */
+  void splice_before(T &pos, IntrusiveList &other) {
+    splice_before(hook_of(pos), other);
+  }
+
+  /**
+   * @brief 归并两条按less有序的链表，结果留在本链表，other变空
+   *
+   * 只改指针，不分配内存；相等元素本链表的在前（稳定），O(n + m)
+   */
+  template <typename Less = std::less<T>>
+  void merge(IntrusiveList &other, Less less = Less()) {
+    if (&other == this) {
+      return;
+    }
+    Hook *mine = nil.next;
+    Hook *theirs = other.nil.next;
+    while (mine != &nil && theirs != &other.nil) {
+      if (less(*static_cast<T *>(theirs), *static_cast<T *>(mine))) {
+        // 把 other 中连续小于 mine 的一段整体搬过来
+        Hook *run_end = theirs->next;
+        size_t run = 1;
+        while (run_end != &other.nil &&
+               less(*static_cast<T *>(run_end), *static_cast<T *>(mine))) {
+          run_end = run_end->next;
+          ++run;
+        }
+        Hook *last = run_end->prev;
+        theirs->prev->next = run_end;
+        run_end->prev = theirs->prev;
+        theirs->prev = mine->prev;
+        mine->prev->next = theirs;
+        last->next = mine;
+        mine->prev = last;
+        other.count -= run;
+        count += run;
+        theirs = run_end;
+      } else {
+        mine = mine->next;
+      }
+    }
+    splice_back(other);
+  }
+
+  /**
+   * @brief 第一个满足pred的元素，未找到返回nullptr
+   */
+  template <typename Predicate> T *find_if(Predicate pred) {
+    for (Hook *hook = nil.next; hook != &nil; hook = hook->next) {
+      if (pred(*static_cast<T *>(hook))) {
+        return static_cast<T *>(hook);
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * @brief 摘除全部元素（不析构）
+   */
+  void clear() {
+    Hook *hook = nil.next;
+    while (hook != &nil) {
+      Hook *next = hook->next;
+      hook->prev = hook->next = nullptr;
+      hook = next;
+    }
+    nil.prev = nil.next = &nil;
+    count = 0;
+  }
+
+  iterator begin() { return iterator(nil.next); }
+  iterator end() { return iterator(&nil); }
+  const_iterator begin() const { return const_iterator(nil.next); }
+  const_iterator end() const { return const_iterator(const_cast<Hook *>(&nil)); }
+
+  size_t size() const { return count; }
+
+  bool empty() const { return count == 0; }
+
+private:
+  Hook nil; // 哨兵：nil.next 为表头，nil.prev 为表尾
+  size_t count = 0;
+
+  static Hook *hook_of(T &x) { return static_cast<Hook *>(&x); }
+
+  void link_before(Hook *pos, T &x) { link_before(pos, hook_of(x)); }
+
+  void link_before(Hook *pos, Hook *hook) {
+    if (hook->is_linked()) {
+      throw std::invalid_argument("元素已在链表中");
+    }
+    hook->next = pos;
+    hook->prev = pos->prev;
+    pos->prev->next = hook;
+    pos->prev = hook;
+    ++count;
+  }
+
+  void unlink(Hook *hook) {
+    hook->prev->next = hook->next;
+    hook->next->prev = hook->prev;
+    hook->prev = hook->next = nullptr;
+    --count;
+  }
+
+  void splice_before(Hook *pos, IntrusiveList &other) {
+    if (&other == this || other.empty()) {
+      return;
+    }
+    Hook *first = other.nil.next, *last = other.nil.prev;
+    first->prev = pos->prev;
+    pos->prev->next = first;
+    last->next = pos;
+    pos->prev = last;
+    count += other.count;
+    other.nil.prev = other.nil.next = &other.nil;
+    other.count = 0;
+  }
+};
+
+/**
+ * @brief 定长节点的对象池
+ *
+ * 在 SlabAllocator 上构造和析构对象：释放的节点进入空闲链表，下次创建时
+ * 直接复用，不经过 malloc/free。池析构时一次性归还全部内存，但不会析构
+ * 仍然存活的对象。
+ */
+template <typename T> class NodePool {
+public:
+  explicit NodePool(size_t nodes_per_slab = 256) : slab(nodes_per_slab) {}
+
+  NodePool(const NodePool &) = delete;
+  NodePool &operator=(const NodePool &) = delete;
+
+  template <typename... Args> T *create(Args &&...args) {
+    void *memory = slab.allocate();
+    try {
+      T *node = new (memory) T(std::forward<Args>(args)...);
+      ++live_count;
+      return node;
+    } catch (...) {
+      slab.deallocate(memory);
+      throw;
+    }
+  }
+
+  void destroy(T *node) {
+    node->~T();
+    slab.deallocate(node);
+    --live_count;
+  }
+
+  /**
+   * @brief 尚未归还的对象个数
+   */
+  size_t live() const { return live_count; }
+
+  size_t bytes_reserved() const { return slab.bytes_reserved(); }
+
+private:
+  SlabAllocator<T> slab;
+  size_t live_count = 0;
+};
+
 } // namespace algorithms
 
 #endif // LINKED_LIST_H
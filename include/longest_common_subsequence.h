@@ -1,10 +1,14 @@
 #ifndef LONGEST_COMMON_SUBSEQUENCE_H
 #define LONGEST_COMMON_SUBSEQUENCE_H
 
+#include "wavefront_executor.h"
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace algorithms {
@@ -18,30 +22,44 @@ public:
   LongestCommonSubsequence(const std::string &s1, const std::string &s2)
       : seq1(s1), seq2(s2) {}
 
-  // 计算LCS长度（自底向上动态规划）
-  int lcs_length() {
-    int m = seq1.length();
-    int n = seq2.length();
-
-    if (m == 0 || n == 0) {
-      return 0;
+  // 计算LCS长度（位并行，O(mn/64)时间，O(m/64)空间）
+  int lcs_length() { return bit_parallel_length(seq1, seq2); }
+
+  // 位并行LCS长度的波前并行版本：位向量按 tile_words 个字、较长序列按
+  // tile_chars 个字符分块。块 (字块, 字符块) 依赖同一字块的上一个字符块
+  // （位向量的状态）和同一字符块的左侧字块（加法进位），正好是网格依赖
+  int lcs_length(WorkStealingScheduler &scheduler, std::size_t tile_words = 16,
+                 std::size_t tile_chars = 4096) const {
+    std::string_view a = seq1, b = seq2;
+    if (a.size() > b.size()) {
+      std::swap(a, b);
     }
-
-    // 创建DP表
-    std::vector<std::vector<int>> dp(m + 1, std::vector<int>(n + 1, 0));
-
-    // 填充DP表
-    for (int i = 1; i <= m; i++) {
-      for (int j = 1; j <= n; j++) {
-        if (seq1[i - 1] == seq2[j - 1]) {
-          dp[i][j] = dp[i - 1][j - 1] + 1;
-        } else {
-          dp[i][j] = std::max(dp[i - 1][j], dp[i][j - 1]);
-        }
-      }
+    if (a.empty()) {
+      return 0;
     }
+    BitParallelTable table(a);
+    std::vector<std::uint64_t> v(table.words, ~std::uint64_t(0));
+    std::vector<unsigned char> carries(b.size(), 0);
+
+    WavefrontExecutor::grid(
+        scheduler, table.words, b.size(), tile_words, tile_chars,
+        [&](std::size_t w_begin, std::size_t w_end, std::size_t t_begin,
+            std::size_t t_end) {
+          for (std::size_t t = t_begin; t < t_end; t++) {
+            int c = table.char_class[static_cast<unsigned char>(b[t])];
+            if (c < 0) {
+              continue;
+            }
+            carries[t] = table.advance(v.data(), c, w_begin, w_end,
+                                       w_begin == 0 ? 0 : carries[t]);
+          }
+        });
+    return table.length(v.data());
+  }
 
-    return dp[m][n];
+  // 计算LCS长度（自底向上动态规划，只保留两行，O(mn)时间，O(n)空间）
+  int lcs_length_two_rows() const {
+    return last_row(seq1, seq2, false).back();
   }
 
   // 计算LCS长度并返回LCS字符串
@@ -53,39 +71,13 @@ public:
     LCSResult(int len, const std::string &str) : length(len), lcs_string(str) {}
   };
 
+  // Hirschberg分治：O(mn)时间，O(m+n)空间；子问题不超过kDirectTableCells
+  // 个格子时直接填表回溯，与完整方向表的选择规则相同
   LCSResult lcs_with_string() {
-    int m = seq1.length();
-    int n = seq2.length();
-
-    if (m == 0 || n == 0) {
-      return LCSResult(0, "");
-    }
-
-    // 创建DP表和方向表
-    std::vector<std::vector<int>> dp(m + 1, std::vector<int>(n + 1, 0));
-    std::vector<std::vector<char>> direction(m + 1,
-                                             std::vector<char>(n + 1, ' '));
-
-    // 填充DP表和方向表
-    for (int i = 1; i <= m; i++) {
-      for (int j = 1; j <= n; j++) {
-        if (seq1[i - 1] == seq2[j - 1]) {
-          dp[i][j] = dp[i - 1][j - 1] + 1;
-          direction[i][j] = 'D'; // 对角线方向 (Diagonal)
-        } else if (dp[i - 1][j] >= dp[i][j - 1]) {
-          dp[i][j] = dp[i - 1][j];
-          direction[i][j] = 'U'; // 向上方向 (Up)
-        } else {
-          dp[i][j] = dp[i][j - 1];
-          direction[i][j] = 'L'; // 向左方向 (Left)
-        }
-      }
-    }
-
-    // 重构LCS字符串
-    std::string lcs_str = reconstruct_lcs(direction, m, n);
-
-    return LCSResult(dp[m][n], lcs_str);
+    std::string lcs_str;
+    lcs_str.reserve(std::min(seq1.size(), seq2.size()));
+    hirschberg(seq1, seq2, lcs_str);
+    return LCSResult(static_cast<int>(lcs_str.size()), lcs_str);
   }
 
   // 打印DP表（用于调试和可视化）
@@ -182,25 +174,167 @@ public:
   }
 
 private:
-  // 重构LCS字符串
-  std::string reconstruct_lcs(const std::vector<std::vector<char>> &direction,
-                              int i, int j) {
-    if (i == 0 || j == 0) {
-      return "";
+  static constexpr std::size_t kDirectTableCells = std::size_t(1) << 16;
+
+  // 返回 b 的每个前缀与 a 的LCS长度，即DP表的最后一行（长度 |b|+1）；
+  // reversed 为真时对 a、b 的逆序计算，row[j] 为 a 与 b 的后 j 个字符的LCS
+  static std::vector<int> last_row(std::string_view a, std::string_view b,
+                                   bool reversed) {
+    std::size_t m = a.size(), n = b.size();
+    std::vector<int> prev(n + 1, 0), cur(n + 1, 0);
+    for (std::size_t i = 1; i <= m; i++) {
+      char x = reversed ? a[m - i] : a[i - 1];
+      for (std::size_t j = 1; j <= n; j++) {
+        char y = reversed ? b[n - j] : b[j - 1];
+        cur[j] = x == y ? prev[j - 1] + 1 : std::max(prev[j], cur[j - 1]);
+      }
+      std::swap(prev, cur);
+    }
+    return prev;
+  }
+
+  // 小规模子问题：完整DP表加迭代回溯，结果追加到 out
+  static void direct_lcs(std::string_view a, std::string_view b,
+                         std::string &out) {
+    std::size_t m = a.size(), n = b.size();
+    std::size_t width = n + 1;
+    std::vector<int> dp((m + 1) * width, 0);
+    for (std::size_t i = 1; i <= m; i++) {
+      for (std::size_t j = 1; j <= n; j++) {
+        dp[i * width + j] =
+            a[i - 1] == b[j - 1]
+                ? dp[(i - 1) * width + j - 1] + 1
+                : std::max(dp[(i - 1) * width + j], dp[i * width + j - 1]);
+      }
+    }
+
+    std::size_t begin = out.size();
+    std::size_t i = m, j = n;
+    while (i > 0 && j > 0) {
+      if (a[i - 1] == b[j - 1]) {
+        out.push_back(a[i - 1]);
+        i--;
+        j--;
+      } else if (dp[(i - 1) * width + j] >= dp[i * width + j - 1]) {
+        i--;
+      } else {
+        j--;
+      }
+    }
+    std::reverse(out.begin() + begin, out.end());
+  }
+
+  // 把 a 从中间切开，前一半的正向最后一行与后一半的逆向最后一行相加，
+  // 最大值处即最优路径穿过中线的位置，两边递归求解
+  static void hirschberg(std::string_view a, std::string_view b,
+                         std::string &out) {
+    if (a.empty() || b.empty()) {
+      return;
+    }
+    if (a.size() == 1 || a.size() * b.size() <= kDirectTableCells) {
+      direct_lcs(a, b, out);
+      return;
+    }
+
+    std::size_t mid = a.size() / 2, n = b.size();
+    std::vector<int> forward = last_row(a.substr(0, mid), b, false);
+    std::vector<int> backward = last_row(a.substr(mid), b, true);
+    std::size_t split = 0;
+    int best = -1;
+    for (std::size_t k = 0; k <= n; k++) {
+      int total = forward[k] + backward[n - k];
+      if (total > best) {
+        best = total;
+        split = k;
+      }
+    }
+    hirschberg(a.substr(0, mid), b.substr(0, split), out);
+    hirschberg(a.substr(mid), b.substr(split), out);
+  }
+
+  /**
+   * @brief Allison-Dix / Hyyrö 位并行LCS长度
+   *
+   * 把较短的序列 a 的位置排成位向量，V 的第 i 位为0表示DP表当前行在
+   * 第 i 列发生了增量。每读入 b 的一个字符 c，令 M 为 a 中等于 c 的位置，
+   * V' = (V + (V & M)) | (V & ~M)，一次字运算处理64列，加法的进位在字间
+   * 传递。最终 LCS 长度为 V 的低 |a| 位中0的个数。
+   */
+  struct BitParallelTable {
+    std::size_t length_a;
+    std::size_t words;
+    int char_class[256];
+    std::vector<std::uint64_t> match;
+
+    // 只为 a 中出现的字符建立匹配位向量，其余字符的 M 为0，V 不变
+    explicit BitParallelTable(std::string_view a)
+        : length_a(a.size()), words((a.size() + 63) / 64) {
+      std::fill(std::begin(char_class), std::end(char_class), -1);
+      int classes = 0;
+      for (char ch : a) {
+        int &c = char_class[static_cast<unsigned char>(ch)];
+        if (c < 0) {
+          c = classes++;
+        }
+      }
+      match.assign(static_cast<std::size_t>(classes) * words, 0);
+      for (std::size_t i = 0; i < a.size(); i++) {
+        int c = char_class[static_cast<unsigned char>(a[i])];
+        match[c * words + i / 64] |= std::uint64_t(1) << (i % 64);
+      }
+    }
+
+    // 对 v 的第 [begin, end) 个字执行一步递推，返回传给下一个字的进位
+    unsigned char advance(std::uint64_t *v, int c, std::size_t begin,
+                          std::size_t end, unsigned char carry) const {
+      const std::uint64_t *mask = &match[c * words];
+      for (std::size_t k = begin; k < end; k++) {
+        std::uint64_t x = v[k];
+        std::uint64_t u = x & mask[k];
+        unsigned long long sum;
+        unsigned char c1 = __builtin_add_overflow(x, u, &sum);
+        unsigned char c2 = __builtin_add_overflow(sum, carry, &sum);
+        carry = c1 | c2;
+        v[k] = sum | (x & ~mask[k]);
+      }
+      return carry;
     }
 
-    if (direction[i][j] == 'D') {
-      return reconstruct_lcs(direction, i - 1, j - 1) + seq1[i - 1];
-    } else if (direction[i][j] == 'U') {
-      return reconstruct_lcs(direction, i - 1, j);
-    } else {
-      return reconstruct_lcs(direction, i, j - 1);
+    // V 的低 |a| 位中0的个数
+    int length(const std::uint64_t *v) const {
+      std::size_t ones = 0;
+      for (std::size_t k = 0; k < words; k++) {
+        std::uint64_t bits = v[k];
+        if (k + 1 == words && length_a % 64 != 0) {
+          bits &= (std::uint64_t(1) << (length_a % 64)) - 1;
+        }
+        ones += __builtin_popcountll(bits);
+      }
+      return static_cast<int>(length_a - ones);
+    }
+  };
+
+  static int bit_parallel_length(std::string_view a, std::string_view b) {
+    if (a.size() > b.size()) {
+      std::swap(a, b);
+    }
+    if (a.empty()) {
+      return 0;
+    }
+    BitParallelTable table(a);
+    std::vector<std::uint64_t> v(table.words, ~std::uint64_t(0));
+    for (char ch : b) {
+      int c = table.char_class[static_cast<unsigned char>(ch)];
+      if (c >= 0) {
+        table.advance(v.data(), c, 0, table.words, 0);
+      }
     }
+    return table.length(v.data());
   }
 };
 
 // 算法导论中的经典示例
-void print_classic_example() {
+inline void print_lcs_classic_example() {
   std::cout << "=== 算法导论经典示例 ===" << std::endl;
 
   // 示例1：算法导论图15-8
@@ -0,0 +1,108 @@
+#ifndef MAPPED_TEXT_H
+#define MAPPED_TEXT_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace algorithms {
+
+/**
+ * @brief 以只读 mmap 方式打开的文本文件
+ *
+ * 把整个文件映射进地址空间并以 std::string_view 暴露，字符串匹配器可以
+ * 直接扫描，不必先把文件读入 std::string。映射按顺序访问提示内核预读
+ * （MADV_SEQUENTIAL），适合一遍扫描的场景。文件描述符在映射建立后立即关闭。
+ *
+ * 空文件不建立映射，view() 返回空视图。对象只能移动，不能复制。
+ */
+class MappedText {
+private:
+  const char *mapping;
+  std::size_t length;
+
+  void release() {
+    if (mapping != nullptr) {
+      ::munmap(const_cast<char *>(mapping), length);
+    }
+    mapping = nullptr;
+    length = 0;
+  }
+
+public:
+  /**
+   * @brief 映射文件
+   * @throws std::runtime_error 文件无法打开或映射失败
+   */
+  explicit MappedText(const std::string &path) : mapping(nullptr), length(0) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("无法打开文本文件 " + path + ": " +
+                               std::strerror(errno));
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      int error = errno;
+      ::close(fd);
+      throw std::runtime_error("无法获取文本文件状态 " + path + ": " +
+                               std::strerror(error));
+    }
+    length = static_cast<std::size_t>(st.st_size);
+    if (length > 0) {
+      void *address =
+          ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (address == MAP_FAILED) {
+        int error = errno;
+        ::close(fd);
+        throw std::runtime_error(std::string("mmap映射失败: ") +
+                                 std::strerror(error));
+      }
+      ::madvise(address, length, MADV_SEQUENTIAL);
+      mapping = static_cast<const char *>(address);
+    }
+    ::close(fd);
+  }
+
+  ~MappedText() { release(); }
+
+  MappedText(const MappedText &) = delete;
+  MappedText &operator=(const MappedText &) = delete;
+
+  MappedText(MappedText &&other) noexcept
+      : mapping(other.mapping), length(other.length) {
+    other.mapping = nullptr;
+    other.length = 0;
+  }
+
+  MappedText &operator=(MappedText &&other) noexcept {
+    if (this != &other) {
+      release();
+      mapping = other.mapping;
+      length = other.length;
+      other.mapping = nullptr;
+      other.length = 0;
+    }
+    return *this;
+  }
+
+  const char *data() const { return mapping; }
+
+  std::size_t size() const { return length; }
+
+  bool empty() const { return length == 0; }
+
+  std::string_view view() const { return std::string_view(mapping, length); }
+
+  operator std::string_view() const { return view(); }
+};
+
+} // namespace algorithms
+
+#endif // MAPPED_TEXT_H
@@ -1,9 +1,16 @@
 #ifndef MATRIX_CHAIN_MULTIPLICATION_H
 #define MATRIX_CHAIN_MULTIPLICATION_H
 
+#include "cpu_features.h"
+#include "gemm_kernel.h"
+#include "matrix_operations.h"
+#include "wavefront_executor.h"
 #include <algorithm>
 #include <climits>
+#include <cstddef>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -28,33 +35,55 @@ private:
     }
   }
 
+  // 计算子链 A_i...A_j 的最优分割（m[i][k] 与 m[k+1][j] 均已求出）
+  void compute_cell(int i, int j) {
+    m[i][j] = INT_MAX;
+
+    for (int k = i; k <= j - 1; k++) {
+      int cost = m[i][k] + m[k + 1][j] +
+                 dimensions[i - 1] * dimensions[k] * dimensions[j];
+
+      if (cost < m[i][j]) {
+        m[i][j] = cost;
+        s[i][j] = k;
+      }
+    }
+  }
+
   // 计算最优括号化方案
   void compute_optimal_parenthesization(int n) {
     for (int l = 2; l <= n; l++) { // l是链的长度
       for (int i = 1; i <= n - l + 1; i++) {
-        int j = i + l - 1;
-        m[i][j] = INT_MAX;
-
-        for (int k = i; k <= j - 1; k++) {
-          int cost = m[i][k] + m[k + 1][j] +
-                     dimensions[i - 1] * dimensions[k] * dimensions[j];
-
-          if (cost < m[i][j]) {
-            m[i][j] = cost;
-            s[i][j] = k;
-          }
-        }
+        compute_cell(i, i + l - 1);
       }
     }
   }
 
-  // 递归构建括号化字符串
-  std::string construct_parenthesization(int i, int j) {
+  // 波前并行版本：块内按 i 递减、j 递增填表，结果与串行版本相同
+  void compute_optimal_parenthesization(int n, WorkStealingScheduler &scheduler,
+                                        std::size_t tile) {
+    WavefrontExecutor::triangular(
+        scheduler, n, tile,
+        [this](std::size_t row_begin, std::size_t row_end,
+               std::size_t col_begin, std::size_t col_end) {
+          for (std::size_t r = row_end; r-- > row_begin;) {
+            int i = static_cast<int>(r) + 1;
+            for (std::size_t c = std::max(col_begin, r + 1); c < col_end; c++) {
+              compute_cell(i, static_cast<int>(c) + 1);
+            }
+          }
+        });
+  }
+
+  // 递归构建括号化字符串，追加到 out 末尾，总长度线性
+  void construct_parenthesization(int i, int j, std::string &out) const {
     if (i == j) {
-      return "A" + std::to_string(i);
+      out += "A" + std::to_string(i);
     } else {
-      return "(" + construct_parenthesization(i, s[i][j]) +
-             construct_parenthesization(s[i][j] + 1, j) + ")";
+      out += '(';
+      construct_parenthesization(i, s[i][j], out);
+      construct_parenthesization(s[i][j] + 1, j, out);
+      out += ')';
     }
   }
 
@@ -69,6 +98,20 @@ public:
     compute_optimal_parenthesization(n);
   }
 
+  // 在调度器上按波前并行填表，tile 为块的边长
+  MatrixChainMultiplication(const std::vector<int> &dims,
+                            WorkStealingScheduler &scheduler,
+                            std::size_t tile = 64)
+      : dimensions(dims) {
+    if (dimensions.size() < 2) {
+      throw std::invalid_argument("至少需要2个维度值");
+    }
+
+    int n = dimensions.size() - 1;
+    initialize_tables(n);
+    compute_optimal_parenthesization(n, scheduler, tile);
+  }
+
   // 获取最小标量乘法次数
   int get_minimum_scalar_multiplications() const {
     int n = dimensions.size() - 1;
@@ -78,7 +121,9 @@ public:
   // 获取最优括号化方案
   std::string get_optimal_parenthesization() {
     int n = dimensions.size() - 1;
-    return construct_parenthesization(1, n);
+    std::string result;
+    construct_parenthesization(1, n, result);
+    return result;
   }
 
   // 打印DP表（用于调试和分析）
@@ -170,12 +215,14 @@ private:
     return m[i][j];
   }
 
-  std::string construct_parenthesization(int i, int j) {
+  void construct_parenthesization(int i, int j, std::string &out) const {
     if (i == j) {
-      return "A" + std::to_string(i);
+      out += "A" + std::to_string(i);
     } else {
-      return "(" + construct_parenthesization(i, s[i][j]) +
-             construct_parenthesization(s[i][j] + 1, j) + ")";
+      out += '(';
+      construct_parenthesization(i, s[i][j], out);
+      construct_parenthesization(s[i][j] + 1, j, out);
+      out += ')';
     }
   }
 
@@ -199,7 +246,9 @@ public:
 
   std::string get_optimal_parenthesization() {
     int n = dimensions.size() - 1;
-    return construct_parenthesization(1, n);
+    std::string result;
+    construct_parenthesization(1, n, result);
+    return result;
   }
 
   void print_dp_tables() const {
@@ -225,6 +274,313 @@ public:
   }
 };
 
+
+/**
+ * @brief 矩阵链乘法的执行计划
+ *
+ * 与 MatrixChainMultiplication 使用同一递推式，但面向很长的链：
+ * - 代价表为扁平的 n×n 数组，并维护一份转置副本，计算 m[i][j] 时
+ *   m[i][k] 与 m[k+1][j] 都是连续内存，最小值归约在支持时用AVX2一次
+ *   处理4个分割点，再顺序找出第一个取到最小值的 k（与教科书版本的
+ *   选择相同）
+ * - 代价以 double 保存，2^53 以内是精确整数，不会像 int 版本那样溢出
+ * - 求出的括号化方案展开为按执行顺序排列的乘法步骤；中间结果存放在
+ *   缓冲区池中，某个中间结果被使用后其缓冲区即可被后续步骤复用，
+ *   缓冲区在多次 execute 之间保留
+ *
+ * 求解时间 O(n³)，空间 O(n²)。
+ */
+class MatrixChainPlan {
+public:
+  // 一次乘法：left × right，操作数编号 < n 为输入矩阵，
+  // 编号 n + t 为第 t 步的结果；slot 为结果所在的缓冲区（最后一步为 -1）
+  struct Step {
+    int left;
+    int right;
+    int rows;
+    int inner;
+    int cols;
+    int slot;
+  };
+
+  explicit MatrixChainPlan(const std::vector<int> &dims) : dimensions(dims) {
+    if (dimensions.size() < 2) {
+      throw std::invalid_argument("至少需要2个维度值");
+    }
+    for (int d : dimensions) {
+      if (d <= 0) {
+        throw std::invalid_argument("矩阵维度必须为正数");
+      }
+    }
+    solve();
+    build_steps();
+  }
+
+  int get_matrix_count() const { return dimensions.size() - 1; }
+
+  // 最小标量乘法次数
+  double get_minimum_scalar_multiplications() const { return total_cost; }
+
+  // 最优括号化方案，格式与 MatrixChainMultiplication 相同
+  std::string get_optimal_parenthesization() const {
+    // 显式栈：链长可达数千，避免深递归；')' 记为 -1
+    int n = get_matrix_count();
+    std::string result;
+    std::vector<std::pair<int, int>> stack = {{0, n - 1}};
+    while (!stack.empty()) {
+      auto [i, j] = stack.back();
+      stack.pop_back();
+      if (i < 0) {
+        result += ')';
+      } else if (i == j) {
+        result += "A" + std::to_string(i + 1);
+      } else {
+        int k = split[static_cast<std::size_t>(i) * n + j];
+        result += '(';
+        stack.push_back({-1, -1});
+        stack.push_back({k + 1, j});
+        stack.push_back({i, k});
+      }
+    }
+    return result;
+  }
+
+  const std::vector<Step> &get_steps() const { return steps; }
+
+  // 缓冲区池的总容量（字节）
+  std::size_t arena_bytes() const {
+    std::size_t total = 0;
+    for (std::size_t size : slot_sizes) {
+      total += size * sizeof(double);
+    }
+    return total;
+  }
+
+  /**
+   * @brief 按计划计算 chain[0] × chain[1] × ... × chain[n-1]
+   * @throws std::invalid_argument 矩阵个数或维度与计划不符
+   */
+  Matrix execute(const std::vector<Matrix> &chain) {
+    int n = get_matrix_count();
+    if (static_cast<int>(chain.size()) != n) {
+      throw std::invalid_argument("矩阵个数与计划不符");
+    }
+    for (int t = 0; t < n; t++) {
+      if (chain[t].get_rows() != dimensions[t] ||
+          chain[t].get_cols() != dimensions[t + 1]) {
+        throw std::invalid_argument("矩阵维度与计划不符");
+      }
+    }
+    if (n == 1) {
+      return chain[0];
+    }
+
+    // 列主序的输入先转换为行主序
+    std::vector<Matrix> converted;
+    std::vector<const double *> inputs(n);
+    for (int t = 0; t < n; t++) {
+      if (chain[t].get_layout() == MatrixLayout::RowMajor) {
+        inputs[t] = chain[t].raw_data();
+      } else {
+        converted.push_back(chain[t].to_layout(MatrixLayout::RowMajor));
+      }
+    }
+    for (int t = 0, c = 0; t < n; t++) {
+      if (chain[t].get_layout() != MatrixLayout::RowMajor) {
+        inputs[t] = converted[c++].raw_data();
+      }
+    }
+
+    arena.resize(slot_sizes.size());
+    for (std::size_t slot = 0; slot < slot_sizes.size(); slot++) {
+      if (arena[slot].size() < slot_sizes[slot]) {
+        arena[slot].resize(slot_sizes[slot]);
+      }
+    }
+
+    const Step &last = steps.back();
+    Matrix result(last.rows, last.cols);
+    auto operand = [&](int id) -> const double * {
+      return id < n ? inputs[id] : arena[steps[id - n].slot].data();
+    };
+    for (const Step &step : steps) {
+      double *out = step.slot < 0 ? result.raw_data() : arena[step.slot].data();
+      std::fill(out, out + static_cast<std::size_t>(step.rows) * step.cols,
+                0.0);
+      GemmKernel::gemm(step.rows, step.cols, step.inner, operand(step.left),
+                       step.inner, operand(step.right), step.cols, out,
+                       step.cols);
+    }
+    return result;
+  }
+
+private:
+  std::vector<int> dimensions;
+  std::vector<int> split; // split[i*n + j]：A_i..A_j 的最优分割点 k（0起）
+  double total_cost = 0.0;
+  std::vector<Step> steps;
+  std::vector<std::size_t> slot_sizes;
+  std::vector<std::vector<double>> arena;
+
+  // min_k (row[k] + col[k] + a * p[k])，k ∈ [0, count)；argmin 写入
+  // best_k，取值相等时取最小的 k
+  static double min_cost_scalar(const double *row, const double *col,
+                                const double *p, double a, std::size_t count,
+                                std::size_t &best_k) {
+    double best = row[0] + col[0] + a * p[0];
+    best_k = 0;
+    for (std::size_t k = 1; k < count; k++) {
+      double t = row[k] + col[k] + a * p[k];
+      if (t < best) {
+        best = t;
+        best_k = k;
+      }
+    }
+    return best;
+  }
+
+#ifdef ALGORITHMS_GEMM_X86
+  // 每条通道同时记录最小值和它的下标（以 double 存放，k < 2^53 时精确）
+  __attribute__((target("avx2"))) static double
+  min_cost_avx2(const double *row, const double *col, const double *p,
+                double a, std::size_t count, std::size_t &best_k) {
+    __m256d factor = _mm256_set1_pd(a);
+    __m256d best = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+    __m256d best_index = _mm256_setzero_pd();
+    __m256d index = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+    const __m256d four = _mm256_set1_pd(4.0);
+    std::size_t k = 0;
+    for (; k + 4 <= count; k += 4) {
+      __m256d t = _mm256_add_pd(
+          _mm256_add_pd(_mm256_loadu_pd(row + k), _mm256_loadu_pd(col + k)),
+          _mm256_mul_pd(factor, _mm256_loadu_pd(p + k)));
+      __m256d less = _mm256_cmp_pd(t, best, _CMP_LT_OQ);
+      best = _mm256_blendv_pd(best, t, less);
+      best_index = _mm256_blendv_pd(best_index, index, less);
+      index = _mm256_add_pd(index, four);
+    }
+    alignas(32) double lanes[4], lane_index[4];
+    _mm256_store_pd(lanes, best);
+    _mm256_store_pd(lane_index, best_index);
+    double result = std::numeric_limits<double>::infinity();
+    best_k = 0;
+    for (int lane = 0; lane < 4; lane++) {
+      std::size_t lane_k = static_cast<std::size_t>(lane_index[lane]);
+      if (lanes[lane] < result || (lanes[lane] == result && lane_k < best_k)) {
+        result = lanes[lane];
+        best_k = lane_k;
+      }
+    }
+    for (; k < count; k++) {
+      double t = row[k] + col[k] + a * p[k];
+      if (t < result) {
+        result = t;
+        best_k = k;
+      }
+    }
+    return result;
+  }
+#endif
+
+  void solve() {
+    int n = get_matrix_count();
+    std::size_t size = static_cast<std::size_t>(n);
+    std::vector<double> p(dimensions.begin(), dimensions.end());
+    // cost[i*n + j] 为 m[i][j]，cost_t[j*n + i] 为其转置副本
+    std::vector<double> cost(size * size, 0.0), cost_t(size * size, 0.0);
+    split.assign(size * size, 0);
+
+    for (int l = 2; l <= n; l++) {
+      for (int i = 0; i + l <= n; i++) {
+        int j = i + l - 1;
+        // 分割点 k ∈ [i, j)：row[k - i] = m[i][k]，col[k - i] = m[k+1][j]
+        const double *row = &cost[i * size + i];
+        const double *col = &cost_t[j * size + i + 1];
+        const double *pk = &p[i + 1];
+        double a = p[i] * p[j + 1];
+        std::size_t count = j - i;
+
+        double best;
+        std::size_t k;
+#ifdef ALGORITHMS_GEMM_X86
+        best = CpuFeatures::avx2() ? min_cost_avx2(row, col, pk, a, count, k)
+                                : min_cost_scalar(row, col, pk, a, count, k);
+#else
+        best = min_cost_scalar(row, col, pk, a, count, k);
+#endif
+        cost[i * size + j] = best;
+        cost_t[j * size + i] = best;
+        split[i * size + j] = static_cast<int>(i + k);
+      }
+    }
+    total_cost = cost[n - 1];
+  }
+
+  // 把括号化方案展开为后序的乘法步骤，并为中间结果分配缓冲区
+  void build_steps() {
+    int n = get_matrix_count();
+    steps.clear();
+    slot_sizes.clear();
+    if (n == 1) {
+      return;
+    }
+
+    struct Frame {
+      int i, j;
+      bool expanded;
+    };
+    std::vector<Frame> stack = {{0, n - 1, false}};
+    std::vector<int> operands;
+    std::vector<int> free_slots;
+    while (!stack.empty()) {
+      Frame f = stack.back();
+      stack.pop_back();
+      if (f.i == f.j) {
+        operands.push_back(f.i);
+        continue;
+      }
+      int k = split[static_cast<std::size_t>(f.i) * n + f.j];
+      if (!f.expanded) {
+        stack.push_back({f.i, f.j, true});
+        stack.push_back({k + 1, f.j, false});
+        stack.push_back({f.i, k, false});
+        continue;
+      }
+
+      Step step;
+      step.right = operands.back();
+      operands.pop_back();
+      step.left = operands.back();
+      operands.pop_back();
+      step.rows = dimensions[f.i];
+      step.inner = dimensions[k + 1];
+      step.cols = dimensions[f.j + 1];
+      std::size_t need = static_cast<std::size_t>(step.rows) * step.cols;
+
+      // 先为结果分配缓冲区，再释放两个操作数的缓冲区（gemm 不允许重叠）
+      bool last = f.i == 0 && f.j == n - 1;
+      step.slot = -1;
+      if (!last) {
+        if (free_slots.empty()) {
+          step.slot = static_cast<int>(slot_sizes.size());
+          slot_sizes.push_back(need);
+        } else {
+          step.slot = free_slots.back();
+          free_slots.pop_back();
+          slot_sizes[step.slot] = std::max(slot_sizes[step.slot], need);
+        }
+      }
+      for (int id : {step.left, step.right}) {
+        if (id >= n) {
+          free_slots.push_back(steps[id - n].slot);
+        }
+      }
+      steps.push_back(step);
+      operands.push_back(n + static_cast<int>(steps.size()) - 1);
+    }
+  }
+};
+
 } // namespace algorithms
 
 #endif // MATRIX_CHAIN_MULTIPLICATION_H
@@ -3,6 +3,7 @@
 
 #include "linear_systems.h"
 #include "matrix_operations.h"
+#include <optional>
 #include <stdexcept>
 #include <vector>
 
@@ -88,9 +89,10 @@ public:
   }
 
   /**
-   * @brief 使用LU分解求矩阵逆
+   * @brief 使用LUP分解求矩阵逆
    *
-   * 时间复杂度：O(n³)
+   * 时间复杂度：O(n³)。只分解一次，再把单位矩阵作为 n 个右端项一起
+   * 回代（分块，块间更新用GEMM）。
    *
    * @param A 输入矩阵
    * @return Matrix 逆矩阵
@@ -100,24 +102,7 @@ public:
     if (n != A.get_cols())
       throw std::invalid_argument("Matrix must be square for inversion");
 
-    // 对每个单位向量求解线性方程组
-    Matrix inv(n, n);
-
-    for (int j = 0; j < n; j++) {
-      // 创建单位向量
-      std::vector<double> b(n, 0.0);
-      b[j] = 1.0;
-
-      // 使用LU分解求解
-      std::vector<double> x = LinearSystemSolver::lu_decomposition(A, b);
-
-      // 将解存入逆矩阵的第j列
-      for (int i = 0; i < n; i++) {
-        inv(i, j) = x[i];
-      }
-    }
-
-    return inv;
+    return LUPFactorization(A).inverse();
   }
 
   /**
@@ -176,6 +161,9 @@ public:
   /**
    * @brief 检查矩阵是否可逆
    *
+   * 做一次带部分主元的LUP分解，出现（近似）零主元即判为奇异；
+   * O(n³)，不再用余子式展开求行列式。
+   *
    * @param A 矩阵
    * @return bool 是否可逆
    */
@@ -184,9 +172,9 @@ public:
       return false;
 
     try {
-      double det = MatrixUtils::determinant(A);
-      return std::abs(det) > 1e-10;
-    } catch (...) {
+      LUPFactorization lup(A);
+      return true;
+    } catch (const std::runtime_error &) {
       return false;
     }
   }
@@ -231,22 +219,56 @@ public:
   /**
    * @brief 计算矩阵的条件数
    *
-   * 条件数 = ||A|| * ||A⁻¹||
+   * 条件数 = ||A|| * ||A⁻¹||（Frobenius范数），显式求逆，O(n³)。
+   * 只做一次LUP分解：分解时出现零主元即判为不可逆，与 is_invertible 相同。
+   * 只需要量级时用 condition_estimate。
    *
    * @param A 矩阵
    * @return double 条件数
    */
   static double condition_number(const Matrix &A) {
-    if (!is_invertible(A)) {
+    std::optional<LUPFactorization> lup;
+    if (A.get_rows() == A.get_cols()) {
+      try {
+        lup.emplace(A);
+      } catch (const std::runtime_error &) {
+      }
+    }
+    if (!lup) {
       throw std::runtime_error("Matrix is not invertible");
     }
 
-    Matrix A_inv = gauss_jordan_inversion(A);
     double norm_A = MatrixUtils::norm(A);
-    double norm_A_inv = MatrixUtils::norm(A_inv);
+    double norm_A_inv = MatrixUtils::norm(lup->inverse());
 
     return norm_A * norm_A_inv;
   }
+
+  /**
+   * @brief 估计1-范数条件数 κ₁(A) = ||A||₁ ||A⁻¹||₁，复用已有的LUP分解
+   *
+   * ||A⁻¹||₁ 由 LUPFactorization::inverse_norm_1_estimate 估计，
+   * 只做若干次 O(n²) 回代，不形成 A⁻¹。
+   *
+   * @param A 原矩阵
+   * @param lup A 的分解
+   * @return double 条件数估计（下界）
+   */
+  static double condition_estimate(const Matrix &A,
+                                   const LUPFactorization &lup) {
+    if (A.get_rows() != lup.size() || A.get_cols() != lup.size())
+      throw std::invalid_argument("Factorization does not match the matrix");
+    return MatrixUtils::norm_1(A) * lup.inverse_norm_1_estimate();
+  }
+
+  /**
+   * @brief 估计1-范数条件数：分解一次，再做 O(n²) 的估计
+   *
+   * @throws std::runtime_error 矩阵奇异
+   */
+  static double condition_estimate(const Matrix &A) {
+    return condition_estimate(A, LUPFactorization(A));
+  }
 };
 
 } // namespace algorithms
@@ -1,127 +1,286 @@
 #ifndef MATRIX_OPERATIONS_H
 #define MATRIX_OPERATIONS_H
 
+#include "gemm_kernel.h"
+#include <algorithm>
+#include <cmath>
 #include <ctime>
 #include <iomanip>
 #include <iostream>
 #include <random>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace algorithms {
 
+/**
+ * @brief 矩阵存储顺序
+ */
+enum class MatrixLayout { RowMajor, ColumnMajor };
+
+/**
+ * @brief 逐元素矩阵表达式的公共基类（CRTP）
+ *
+ * A + B、A - B、s * A 等逐元素运算不立即计算，而是返回记录了操作数的
+ * 表达式对象；表达式赋给 Matrix（构造、=、+=、-=）时才在一趟循环里
+ * 求出全部元素，整条链只分配一次结果存储，不产生中间临时矩阵。
+ * 每个表达式 E 提供：
+ *
+ * - get_rows() / get_cols()：尺寸（构造节点时已检查匹配）
+ * - unchecked(i, j)：元素 (i, j) 的值
+ * - has_layout(layout)：所有叶子矩阵是否都以该顺序连续存储；
+ *   成立时可按线性下标 flat(k) 取值，求值循环是连续访存的
+ * - get_layout()：最左侧叶子的存储顺序，构造结果矩阵时沿用
+ *
+ * 左值 Matrix 操作数按引用保存，右值（临时矩阵）移入表达式由其持有，
+ * 所以 auto e = (A * B) + C 不会悬空；但表达式读的是求值时刻的元素，
+ * 在求值前修改叶子矩阵会反映到结果中。
+ */
+template <typename E> class MatrixExpression {
+public:
+  const E &self() const { return static_cast<const E &>(*this); }
+};
+
 /**
  * @brief 矩阵类
  *
  * 算法导论第28.1节：矩阵运算基础
+ * 元素存放在一块连续内存中（默认行主序，可选列主序）。
+ * 逐元素运算是惰性的（见 MatrixExpression），矩阵乘法立即调用GEMM内核。
  */
-class Matrix {
+class Matrix : public MatrixExpression<Matrix> {
 private:
-  std::vector<std::vector<double>> data;
+  std::vector<double> data;
   int rows;
   int cols;
+  MatrixLayout layout;
+
+  size_t index(int i, int j) const {
+    return layout == MatrixLayout::RowMajor
+               ? static_cast<size_t>(i) * cols + j
+               : static_cast<size_t>(j) * rows + i;
+  }
+
+  template <typename E>
+  void check_dimensions(const E &e, const char *message) const {
+    if (e.get_rows() != rows || e.get_cols() != cols)
+      throw std::invalid_argument(message);
+  }
+
+  // data 与表达式逐元素合并：data = combine(data, e)，尺寸已检查
+  template <typename E, typename Combine>
+  void evaluate(const E &e, Combine combine) {
+    double *out = data.data();
+    if (e.has_layout(layout)) {
+      const size_t size = data.size();
+      for (size_t k = 0; k < size; k++)
+        out[k] = combine(out[k], e.flat(k));
+    } else {
+      for (int i = 0; i < rows; i++)
+        for (int j = 0; j < cols; j++)
+          out[index(i, j)] = combine(out[index(i, j)], e.unchecked(i, j));
+    }
+  }
 
 public:
   // 构造函数
-  Matrix(int r, int c) : rows(r), cols(c) {
-    data.resize(rows, std::vector<double>(cols, 0.0));
+  Matrix(int r, int c, MatrixLayout storage = MatrixLayout::RowMajor)
+      : data(static_cast<size_t>(r) * c, 0.0), rows(r), cols(c),
+        layout(storage) {}
+
+  /**
+   * @brief 对逐元素表达式求值，只分配一次存储
+   */
+  template <typename E>
+  Matrix(const MatrixExpression<E> &expression)
+      : Matrix(expression.self().get_rows(), expression.self().get_cols(),
+               expression.self().get_layout()) {
+    evaluate(expression.self(), [](double, double value) { return value; });
+  }
+
+  Matrix(const Matrix &) = default;
+  Matrix(Matrix &&) noexcept = default;
+  Matrix &operator=(const Matrix &) = default;
+  Matrix &operator=(Matrix &&) noexcept = default;
+
+  /**
+   * @brief 尺寸相同时直接写入现有存储，不重新分配
+   *
+   * 逐元素表达式中元素 (i, j) 只读各操作数的 (i, j)，因此 A = A + B
+   * 这类自身出现在右侧的赋值也是安全的。
+   */
+  template <typename E> Matrix &operator=(const MatrixExpression<E> &expression) {
+    const E &e = expression.self();
+    if (e.get_rows() != rows || e.get_cols() != cols)
+      return *this = Matrix(expression);
+    evaluate(e, [](double, double value) { return value; });
+    return *this;
   }
 
-  Matrix(const std::vector<std::vector<double>> &input) : data(input) {
+  Matrix(const std::vector<std::vector<double>> &input)
+      : layout(MatrixLayout::RowMajor) {
     rows = input.size();
     if (rows > 0)
       cols = input[0].size();
     else
       cols = 0;
+
+    data.reserve(static_cast<size_t>(rows) * cols);
+    for (const auto &row : input)
+      data.insert(data.end(), row.begin(), row.end());
   }
 
-  // 获取元素
+  // 获取元素（带边界检查）
   double &operator()(int i, int j) {
     if (i < 0 || i >= rows || j < 0 || j >= cols)
       throw std::out_of_range("Matrix index out of range");
-    return data[i][j];
+    return data[index(i, j)];
   }
 
   const double &operator()(int i, int j) const {
     if (i < 0 || i >= rows || j < 0 || j >= cols)
       throw std::out_of_range("Matrix index out of range");
-    return data[i][j];
+    return data[index(i, j)];
   }
 
-  // 获取行数和列数
-  int get_rows() const { return rows; }
-  int get_cols() const { return cols; }
+  // 获取元素（不检查边界，供内层循环使用）
+  double &unchecked(int i, int j) { return data[index(i, j)]; }
 
-  /**
-   * @brief 矩阵加法
-   *
-   * @param other 另一个矩阵
-   * @return Matrix 结果矩阵
-   */
-  Matrix operator+(const Matrix &other) const {
-    if (rows != other.rows || cols != other.cols)
-      throw std::invalid_argument("Matrix dimensions must match for addition");
+  const double &unchecked(int i, int j) const { return data[index(i, j)]; }
+
+  // 底层连续存储
+  double *raw_data() { return data.data(); }
+  const double *raw_data() const { return data.data(); }
+
+  // 作为表达式叶子的线性访问（见 MatrixExpression）
+  double flat(size_t k) const { return data[k]; }
+  bool has_layout(MatrixLayout target) const { return layout == target; }
+
+  // 存储顺序与主维跨度（行主序为列数，列主序为行数）
+  MatrixLayout get_layout() const { return layout; }
+  size_t leading_dimension() const {
+    return layout == MatrixLayout::RowMajor ? cols : rows;
+  }
+
+  // 转换为指定存储顺序（已是该顺序时直接复制）
+  Matrix to_layout(MatrixLayout target) const {
+    if (target == layout)
+      return *this;
 
-    Matrix result(rows, cols);
+    Matrix result(rows, cols, target);
     for (int i = 0; i < rows; i++)
       for (int j = 0; j < cols; j++)
-        result(i, j) = data[i][j] + other(i, j);
+        result.unchecked(i, j) = unchecked(i, j);
+    return result;
+  }
 
+  // 转换为嵌套vector
+  std::vector<std::vector<double>> to_vector() const {
+    std::vector<std::vector<double>> result(rows, std::vector<double>(cols));
+    for (int i = 0; i < rows; i++)
+      for (int j = 0; j < cols; j++)
+        result[i][j] = unchecked(i, j);
     return result;
   }
 
+  // 获取行数和列数
+  int get_rows() const { return rows; }
+  int get_cols() const { return cols; }
+
   /**
-   * @brief 矩阵减法
-   *
-   * @param other 另一个矩阵
-   * @return Matrix 结果矩阵
+   * @brief 就地加上一个逐元素表达式，不分配内存
    */
-  Matrix operator-(const Matrix &other) const {
-    if (rows != other.rows || cols != other.cols)
-      throw std::invalid_argument(
-          "Matrix dimensions must match for subtraction");
+  template <typename E> Matrix &operator+=(const MatrixExpression<E> &other) {
+    check_dimensions(other.self(), "Matrix dimensions must match for addition");
+    evaluate(other.self(), [](double a, double b) { return a + b; });
+    return *this;
+  }
 
-    Matrix result(rows, cols);
-    for (int i = 0; i < rows; i++)
-      for (int j = 0; j < cols; j++)
-        result(i, j) = data[i][j] - other(i, j);
+  /**
+   * @brief 就地减去一个逐元素表达式，不分配内存
+   */
+  template <typename E> Matrix &operator-=(const MatrixExpression<E> &other) {
+    check_dimensions(other.self(),
+                     "Matrix dimensions must match for subtraction");
+    evaluate(other.self(), [](double a, double b) { return a - b; });
+    return *this;
+  }
 
-    return result;
+  Matrix &operator*=(double scalar) {
+    for (double &value : data)
+      value *= scalar;
+    return *this;
+  }
+
+  Matrix &operator/=(double scalar) {
+    for (double &value : data)
+      value /= scalar;
+    return *this;
+  }
+
+  /**
+   * @brief 右乘一个矩阵：A = A · B（GEMM需要单独的结果存储）
+   */
+  Matrix &operator*=(const Matrix &other) {
+    *this = multiply(other);
+    return *this;
   }
 
   /**
-   * @brief 矩阵乘法（标准算法）
+   * @brief 矩阵乘法
    *
-   * 时间复杂度：O(n³)
+   * 时间复杂度：O(n³)，使用分块SIMD内核（见gemm_kernel.h）
    *
    * @param other 另一个矩阵
-   * @return Matrix 结果矩阵
+   * @return Matrix 结果矩阵（行主序）
    */
   Matrix operator*(const Matrix &other) const {
+    return multiply(other);
+  }
+
+  /**
+   * @brief 矩阵乘法，可指定微内核指令集
+   *
+   * 列主序的操作数先转换为行主序再调用内核。
+   */
+  Matrix multiply(const Matrix &other,
+                  GemmKernel::Isa isa = GemmKernel::Isa::Auto) const {
     if (cols != other.rows)
       throw std::invalid_argument(
           "Matrix dimensions must match for multiplication");
 
     Matrix result(rows, other.cols);
-    for (int i = 0; i < rows; i++)
-      for (int j = 0; j < other.cols; j++)
-        for (int k = 0; k < cols; k++)
-          result(i, j) += data[i][k] * other(k, j);
+    if (layout == MatrixLayout::RowMajor &&
+        other.layout == MatrixLayout::RowMajor) {
+      GemmKernel::gemm(rows, other.cols, cols, data.data(), cols,
+                       other.data.data(), other.cols, result.data.data(),
+                       other.cols, isa);
+    } else {
+      Matrix a = to_layout(MatrixLayout::RowMajor);
+      Matrix b = other.to_layout(MatrixLayout::RowMajor);
+      GemmKernel::gemm(rows, other.cols, cols, a.data.data(), cols,
+                       b.data.data(), other.cols, result.data.data(),
+                       other.cols, isa);
+    }
 
     return result;
   }
 
   /**
-   * @brief 标量乘法
-   *
-   * @param scalar 标量值
-   * @return Matrix 结果矩阵
+   * @brief 矩阵乘法（教科书三重循环，用于对照验证）
    */
-  Matrix operator*(double scalar) const {
-    Matrix result(rows, cols);
+  Matrix naive_multiply(const Matrix &other) const {
+    if (cols != other.rows)
+      throw std::invalid_argument(
+          "Matrix dimensions must match for multiplication");
+
+    Matrix result(rows, other.cols);
     for (int i = 0; i < rows; i++)
-      for (int j = 0; j < cols; j++)
-        result(i, j) = data[i][j] * scalar;
+      for (int j = 0; j < other.cols; j++)
+        for (int k = 0; k < cols; k++)
+          result.unchecked(i, j) += unchecked(i, k) * other.unchecked(k, j);
 
     return result;
   }
@@ -133,7 +292,7 @@ public:
     for (int i = 0; i < rows; i++) {
       for (int j = 0; j < cols; j++) {
         std::cout << std::setw(8) << std::fixed << std::setprecision(2)
-                  << data[i][j];
+                  << unchecked(i, j);
       }
       std::cout << std::endl;
     }
@@ -184,10 +343,10 @@ public:
    * @return Matrix 转置矩阵
    */
   Matrix transpose() const {
-    Matrix result(cols, rows);
+    Matrix result(cols, rows, layout);
     for (int i = 0; i < rows; i++)
       for (int j = 0; j < cols; j++)
-        result(j, i) = data[i][j];
+        result.unchecked(j, i) = unchecked(i, j);
     return result;
   }
 
@@ -202,13 +361,168 @@ public:
 
     for (int i = 0; i < rows; i++)
       for (int j = i + 1; j < cols; j++)
-        if (data[i][j] != data[j][i])
+        if (unchecked(i, j) != unchecked(j, i))
           return false;
 
     return true;
   }
 };
 
+/**
+ * @brief 两个表达式的逐元素运算节点，Op::apply(a, b) 给出结果元素
+ *
+ * L、R 为 const Matrix &（左值叶子）或按值保存的表达式/临时矩阵。
+ */
+template <typename L, typename R, typename Op>
+class MatrixBinaryExpression
+    : public MatrixExpression<MatrixBinaryExpression<L, R, Op>> {
+private:
+  L lhs;
+  R rhs;
+
+public:
+  template <typename A, typename B>
+  MatrixBinaryExpression(A &&left, B &&right, const char *message)
+      : lhs(std::forward<A>(left)), rhs(std::forward<B>(right)) {
+    if (lhs.get_rows() != rhs.get_rows() || lhs.get_cols() != rhs.get_cols())
+      throw std::invalid_argument(message);
+  }
+
+  int get_rows() const { return lhs.get_rows(); }
+  int get_cols() const { return lhs.get_cols(); }
+  MatrixLayout get_layout() const { return lhs.get_layout(); }
+  bool has_layout(MatrixLayout target) const {
+    return lhs.has_layout(target) && rhs.has_layout(target);
+  }
+  double unchecked(int i, int j) const {
+    return Op::apply(lhs.unchecked(i, j), rhs.unchecked(i, j));
+  }
+  double flat(size_t k) const { return Op::apply(lhs.flat(k), rhs.flat(k)); }
+};
+
+/**
+ * @brief 表达式与标量的逐元素运算节点，Op::apply(a, scalar) 给出结果元素
+ */
+template <typename E, typename Op>
+class MatrixScalarExpression
+    : public MatrixExpression<MatrixScalarExpression<E, Op>> {
+private:
+  E operand;
+  double scalar;
+
+public:
+  template <typename A>
+  MatrixScalarExpression(A &&value, double s)
+      : operand(std::forward<A>(value)), scalar(s) {}
+
+  int get_rows() const { return operand.get_rows(); }
+  int get_cols() const { return operand.get_cols(); }
+  MatrixLayout get_layout() const { return operand.get_layout(); }
+  bool has_layout(MatrixLayout target) const {
+    return operand.has_layout(target);
+  }
+  double unchecked(int i, int j) const {
+    return Op::apply(operand.unchecked(i, j), scalar);
+  }
+  double flat(size_t k) const { return Op::apply(operand.flat(k), scalar); }
+};
+
+struct MatrixAddOp {
+  static double apply(double a, double b) { return a + b; }
+};
+
+struct MatrixSubtractOp {
+  static double apply(double a, double b) { return a - b; }
+};
+
+struct MatrixScaleOp {
+  static double apply(double a, double s) { return a * s; }
+};
+
+struct MatrixDivideOp {
+  static double apply(double a, double s) { return a / s; }
+};
+
+template <typename T>
+struct IsMatrixExpression
+    : std::is_base_of<MatrixExpression<typename std::decay<T>::type>,
+                      typename std::decay<T>::type> {};
+
+// 左值 Matrix 按引用保存，其余（表达式节点、临时矩阵）按值保存
+template <typename T>
+using MatrixOperand = typename std::conditional<
+    std::is_same<typename std::decay<T>::type, Matrix>::value &&
+        std::is_lvalue_reference<T>::value,
+    const Matrix &, typename std::decay<T>::type>::type;
+
+template <typename L, typename R,
+          typename = typename std::enable_if<IsMatrixExpression<L>::value &&
+                                             IsMatrixExpression<R>::value>::type>
+MatrixBinaryExpression<MatrixOperand<L>, MatrixOperand<R>, MatrixAddOp>
+operator+(L &&lhs, R &&rhs) {
+  return {std::forward<L>(lhs), std::forward<R>(rhs),
+          "Matrix dimensions must match for addition"};
+}
+
+template <typename L, typename R,
+          typename = typename std::enable_if<IsMatrixExpression<L>::value &&
+                                             IsMatrixExpression<R>::value>::type>
+MatrixBinaryExpression<MatrixOperand<L>, MatrixOperand<R>, MatrixSubtractOp>
+operator-(L &&lhs, R &&rhs) {
+  return {std::forward<L>(lhs), std::forward<R>(rhs),
+          "Matrix dimensions must match for subtraction"};
+}
+
+template <typename E, typename = typename std::enable_if<
+                          IsMatrixExpression<E>::value>::type>
+MatrixScalarExpression<MatrixOperand<E>, MatrixScaleOp> operator*(E &&operand,
+                                                                  double s) {
+  return {std::forward<E>(operand), s};
+}
+
+template <typename E, typename = typename std::enable_if<
+                          IsMatrixExpression<E>::value>::type>
+MatrixScalarExpression<MatrixOperand<E>, MatrixScaleOp> operator*(double s,
+                                                                  E &&operand) {
+  return {std::forward<E>(operand), s};
+}
+
+template <typename E, typename = typename std::enable_if<
+                          IsMatrixExpression<E>::value>::type>
+MatrixScalarExpression<MatrixOperand<E>, MatrixDivideOp> operator/(E &&operand,
+                                                                   double s) {
+  return {std::forward<E>(operand), s};
+}
+
+template <typename E, typename = typename std::enable_if<
+                          IsMatrixExpression<E>::value>::type>
+MatrixScalarExpression<MatrixOperand<E>, MatrixScaleOp> operator-(E &&operand) {
+  return {std::forward<E>(operand), -1.0};
+}
+
+// 取得表达式的值：Matrix 原样返回引用，表达式求值为新矩阵
+inline const Matrix &evaluated(const Matrix &matrix) { return matrix; }
+
+template <typename E> Matrix evaluated(const MatrixExpression<E> &expression) {
+  return Matrix(expression);
+}
+
+/**
+ * @brief 含逐元素表达式的矩阵乘法：先求出表达式，再调用GEMM
+ *
+ * 两个操作数都是 Matrix 时由成员 Matrix::operator* 处理。
+ */
+template <typename L, typename R,
+          typename = typename std::enable_if<
+              IsMatrixExpression<L>::value && IsMatrixExpression<R>::value &&
+              !(std::is_same<typename std::decay<L>::type, Matrix>::value &&
+                std::is_same<typename std::decay<R>::type, Matrix>::value)>::type>
+Matrix operator*(const L &lhs, const R &rhs) {
+  const Matrix &a = evaluated(lhs);
+  const Matrix &b = evaluated(rhs);
+  return a.multiply(b);
+}
+
 /**
  * @brief 矩阵运算工具类
  */
@@ -286,6 +600,23 @@ public:
         result += mat(i, j) * mat(i, j);
     return std::sqrt(result);
   }
+
+  /**
+   * @brief 计算矩阵的1-范数（各列绝对值之和的最大值）
+   *
+   * @param mat 矩阵
+   * @return double 1-范数
+   */
+  static double norm_1(const Matrix &mat) {
+    std::vector<double> column_sums(mat.get_cols(), 0.0);
+    for (int i = 0; i < mat.get_rows(); i++)
+      for (int j = 0; j < mat.get_cols(); j++)
+        column_sums[j] += std::abs(mat(i, j));
+    double result = 0.0;
+    for (double sum : column_sums)
+      result = std::max(result, sum);
+    return result;
+  }
 };
 
 } // namespace algorithms
@@ -8,7 +8,11 @@
 #include <iostream>
 #include <limits>
 #include <queue>
+#include <sstream>
 #include <stack>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace algorithms {
@@ -171,10 +175,170 @@ public:
   }
 };
 
+// 二分图的CSR邻接表示：左部节点u的邻居（右部节点下标）为
+// targets[offsets[u], offsets[u+1])
+struct BipartiteGraph {
+  int left_size = 0;
+  int right_size = 0;
+  std::vector<size_t> offsets{0};
+  std::vector<int> targets;
+
+  BipartiteGraph() = default;
+
+  // 由边表(左部下标, 右部下标)构建，计数排序，O(V + E)
+  BipartiteGraph(int left, int right,
+                 const std::vector<std::pair<int, int>> &edges)
+      : left_size(left), right_size(right), offsets(left + 1, 0),
+        targets(edges.size()) {
+    if (left < 0 || right < 0) {
+      throw std::invalid_argument("Partition sizes cannot be negative");
+    }
+    for (const auto &edge : edges) {
+      if (edge.first < 0 || edge.first >= left || edge.second < 0 ||
+          edge.second >= right) {
+        throw std::out_of_range("Bipartite edge endpoint out of range");
+      }
+      offsets[edge.first + 1]++;
+    }
+    for (int u = 0; u < left; u++) {
+      offsets[u + 1] += offsets[u];
+    }
+    std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (const auto &edge : edges) {
+      targets[cursor[edge.first]++] = edge.second;
+    }
+  }
+
+  size_t get_edge_count() const { return targets.size(); }
+};
+
+// 匹配结果：match_left[u]为左部u匹配的右部节点，match_right[v]反之，未匹配为-1
+struct BipartiteMatchingResult {
+  int matching_size = 0;
+  std::vector<int> match_left;
+  std::vector<int> match_right;
+};
+
 // 26.3 最大二分匹配
 class BipartiteMatching {
+private:
+  static constexpr int kUnreached = std::numeric_limits<int>::max();
+
+  // BFS：从所有未匹配的左部节点出发，沿交替路径给左部节点分层
+  // 返回是否存在增广路径
+  static bool build_layers(const BipartiteGraph &graph,
+                           const std::vector<int> &match_left,
+                           const std::vector<int> &match_right,
+                           std::vector<int> &dist, std::vector<int> &queue) {
+    queue.clear();
+    for (int u = 0; u < graph.left_size; u++) {
+      if (match_left[u] == -1) {
+        dist[u] = 0;
+        queue.push_back(u);
+      } else {
+        dist[u] = kUnreached;
+      }
+    }
+
+    int limit = kUnreached; // 最短增广路径所在的层
+    for (size_t head = 0; head < queue.size(); head++) {
+      int u = queue[head];
+      if (dist[u] >= limit) {
+        break;
+      }
+      for (size_t k = graph.offsets[u]; k < graph.offsets[u + 1]; k++) {
+        int w = match_right[graph.targets[k]];
+        if (w == -1) {
+          limit = dist[u] + 1;
+        } else if (dist[w] == kUnreached) {
+          dist[w] = dist[u] + 1;
+          queue.push_back(w);
+        }
+      }
+    }
+    return limit != kUnreached;
+  }
+
+  // 从未匹配的左部节点root沿分层图做迭代DFS，找到增广路径则翻转它
+  static bool augment(const BipartiteGraph &graph, int root,
+                      std::vector<int> &match_left,
+                      std::vector<int> &match_right, std::vector<int> &dist,
+                      std::vector<size_t> &current, std::vector<int> &stack) {
+    stack.clear();
+    stack.push_back(root);
+    while (!stack.empty()) {
+      int u = stack.back();
+      if (current[u] == graph.offsets[u + 1]) {
+        // 死胡同：本阶段不再访问u
+        dist[u] = kUnreached;
+        stack.pop_back();
+        if (!stack.empty()) {
+          current[stack.back()]++;
+        }
+        continue;
+      }
+
+      int v = graph.targets[current[u]];
+      int w = match_right[v];
+      if (w == -1) {
+        // 栈中每个左部节点与其当前弧指向的右部节点配对
+        for (int x : stack) {
+          int y = graph.targets[current[x]];
+          match_left[x] = y;
+          match_right[y] = x;
+        }
+        return true;
+      }
+      if (dist[w] == dist[u] + 1) {
+        stack.push_back(w);
+      } else {
+        current[u]++;
+      }
+    }
+    return false;
+  }
+
 public:
-  // 使用Ford-Fulkerson解决最大二分匹配问题
+  // Hopcroft-Karp算法：每阶段沿最短增广路径的极大不相交集合增广，
+  // 至多O(sqrt(V))个阶段，总时间O(E sqrt(V))，内存O(V + E)
+  static BipartiteMatchingResult hopcroft_karp(const BipartiteGraph &graph) {
+    int left = graph.left_size;
+    BipartiteMatchingResult result;
+    result.match_left.assign(left, -1);
+    result.match_right.assign(graph.right_size, -1);
+    auto &match_left = result.match_left;
+    auto &match_right = result.match_right;
+
+    // 贪心初始匹配，通常能直接匹配大部分节点
+    for (int u = 0; u < left; u++) {
+      for (size_t k = graph.offsets[u]; k < graph.offsets[u + 1]; k++) {
+        int v = graph.targets[k];
+        if (match_right[v] == -1) {
+          match_left[u] = v;
+          match_right[v] = u;
+          result.matching_size++;
+          break;
+        }
+      }
+    }
+
+    std::vector<int> dist(left), queue, stack;
+    std::vector<size_t> current(left);
+    queue.reserve(left);
+    while (build_layers(graph, match_left, match_right, dist, queue)) {
+      std::copy(graph.offsets.begin(), graph.offsets.end() - 1,
+                current.begin());
+      for (int u = 0; u < left; u++) {
+        if (match_left[u] == -1 &&
+            augment(graph, u, match_left, match_right, dist, current, stack)) {
+          result.matching_size++;
+        }
+      }
+    }
+    return result;
+  }
+
+  // 使用Ford-Fulkerson解决最大二分匹配问题（稠密邻接矩阵，教材方法）
   static int
   find_max_matching(const std::vector<std::vector<int>> &bipartite_graph,
                     int left_size, int right_size) {
@@ -353,6 +517,695 @@ public:
   }
 };
 
+// 稀疏残量网络：弧数组 + 按尾节点的CSR索引
+// 每条边对应一对弧：正向弧e（偶数）与反向弧e^1，反向弧初始容量为0。
+// 边编号在整个生命周期内不变，可以随时用get_flow查询每条边的流量。
+class ResidualGraph {
+private:
+  int node_count;
+  std::vector<int> arc_head;             // 弧的终点
+  std::vector<long long> arc_capacity;   // 弧的原始容量
+  std::vector<long long> arc_residual;   // 弧的残量
+  std::vector<int> arc_offsets;          // CSR：节点u的弧为arcs[offsets[u], offsets[u+1])
+  std::vector<int> arcs;                 // 按尾节点分组的弧编号
+  bool index_dirty;
+
+  void check_node(int u) const {
+    if (u < 0 || u >= node_count) {
+      throw std::out_of_range("Node index out of range");
+    }
+  }
+
+public:
+  explicit ResidualGraph(int n = 0) : node_count(n), index_dirty(true) {
+    if (n < 0) {
+      throw std::invalid_argument("Node count cannot be negative");
+    }
+  }
+
+  // 由稠密的FlowNetwork构建
+  static ResidualGraph from_flow_network(const FlowNetwork &network) {
+    int n = network.get_node_count();
+    ResidualGraph graph(n);
+    for (int u = 0; u < n; u++) {
+      for (int v = 0; v < n; v++) {
+        if (network.get_capacity(u, v) > 0) {
+          graph.add_edge(u, v, network.get_capacity(u, v));
+        }
+      }
+    }
+    return graph;
+  }
+
+  // 添加节点，返回其下标
+  int add_node() {
+    index_dirty = true;
+    return node_count++;
+  }
+
+  void reserve_edges(size_t edge_count) {
+    arc_head.reserve(2 * edge_count);
+    arc_capacity.reserve(2 * edge_count);
+    arc_residual.reserve(2 * edge_count);
+  }
+
+  // 添加有向边u->v，返回边编号（即正向弧编号）；允许平行边
+  int add_edge(int u, int v, long long capacity) {
+    check_node(u);
+    check_node(v);
+    if (capacity < 0) {
+      throw std::invalid_argument("Capacity cannot be negative");
+    }
+
+    int edge = static_cast<int>(arc_head.size());
+    arc_head.push_back(v);
+    arc_capacity.push_back(capacity);
+    arc_residual.push_back(capacity);
+    arc_head.push_back(u);
+    arc_capacity.push_back(0);
+    arc_residual.push_back(0);
+    index_dirty = true;
+    return edge;
+  }
+
+  // 建立（或在加边后重建）CSR弧索引，算法开始前调用
+  void finalize() {
+    if (!index_dirty) {
+      return;
+    }
+    arc_offsets.assign(node_count + 1, 0);
+    for (size_t e = 0; e < arc_head.size(); e++) {
+      arc_offsets[get_tail(static_cast<int>(e)) + 1]++;
+    }
+    for (int u = 0; u < node_count; u++) {
+      arc_offsets[u + 1] += arc_offsets[u];
+    }
+    arcs.resize(arc_head.size());
+    std::vector<int> cursor(arc_offsets.begin(), arc_offsets.end() - 1);
+    for (size_t e = 0; e < arc_head.size(); e++) {
+      arcs[cursor[get_tail(static_cast<int>(e))]++] = static_cast<int>(e);
+    }
+    index_dirty = false;
+  }
+
+  // 清除所有流，恢复原始容量
+  void reset_flow() { arc_residual = arc_capacity; }
+
+  int get_node_count() const { return node_count; }
+  size_t get_edge_count() const { return arc_head.size() / 2; }
+  size_t get_arc_count() const { return arc_head.size(); }
+
+  int get_head(int arc) const { return arc_head[arc]; }
+  int get_tail(int arc) const { return arc_head[arc ^ 1]; }
+  long long get_capacity(int arc) const { return arc_capacity[arc]; }
+  long long get_residual(int arc) const { return arc_residual[arc]; }
+  // 边上的流量（对反向弧为负）
+  long long get_flow(int arc) const {
+    return arc_capacity[arc] - arc_residual[arc];
+  }
+
+  // 沿弧推送流量：正向残量减少，反向残量增加
+  void push_flow(int arc, long long amount) {
+    arc_residual[arc] -= amount;
+    arc_residual[arc ^ 1] += amount;
+  }
+
+  // CSR访问（需先finalize）
+  int arc_begin(int u) const { return arc_offsets[u]; }
+  int arc_end(int u) const { return arc_offsets[u + 1]; }
+  int arc_at(int position) const { return arcs[position]; }
+
+  // 当前流的值：源点流出减流入
+  long long flow_value(int source) const {
+    long long value = 0;
+    for (size_t e = 0; e < arc_head.size(); e += 2) {
+      int arc = static_cast<int>(e);
+      if (get_tail(arc) == source)
+        value += get_flow(arc);
+      if (get_head(arc) == source)
+        value -= get_flow(arc);
+    }
+    return value;
+  }
+
+  // 把流写回稠密的MaxFlowResult（平行边合并）
+  void fill_result(MaxFlowResult &result) const {
+    for (size_t e = 0; e < arc_head.size(); e += 2) {
+      int arc = static_cast<int>(e);
+      int u = get_tail(arc), v = get_head(arc);
+      result.capacity[u][v] += static_cast<int>(arc_capacity[arc]);
+      result.flow[u][v] += static_cast<int>(get_flow(arc));
+    }
+    int n = node_count;
+    for (int u = 0; u < n; u++) {
+      for (int v = 0; v < n; v++) {
+        result.residual[u][v] =
+            result.capacity[u][v] - result.flow[u][v] + result.flow[v][u];
+      }
+    }
+  }
+};
+
+// Dinic算法：BFS分层 + 当前弧优化的阻塞流
+// 时间复杂度O(V^2 E)，单位容量网络O(E sqrt(V))
+class Dinic {
+private:
+  // 在残量网络上从源点BFS分层，返回汇点是否可达
+  static bool build_levels(const ResidualGraph &graph, int source, int sink,
+                           std::vector<int> &level, std::vector<int> &queue) {
+    std::fill(level.begin(), level.end(), -1);
+    size_t head = 0;
+    queue.clear();
+    queue.push_back(source);
+    level[source] = 0;
+
+    while (head < queue.size()) {
+      int u = queue[head++];
+      for (int k = graph.arc_begin(u); k < graph.arc_end(u); k++) {
+        int arc = graph.arc_at(k);
+        int v = graph.get_head(arc);
+        if (level[v] < 0 && graph.get_residual(arc) > 0) {
+          level[v] = level[u] + 1;
+          queue.push_back(v);
+        }
+      }
+    }
+    return level[sink] >= 0;
+  }
+
+  // 在分层图上求阻塞流（迭代DFS，避免长路径导致栈溢出）
+  static long long blocking_flow(ResidualGraph &graph, int source, int sink,
+                                 std::vector<int> &level,
+                                 std::vector<int> &current,
+                                 std::vector<int> &path) {
+    long long total = 0;
+    path.clear();
+    int u = source;
+
+    while (true) {
+      if (u == sink) {
+        // 增广：瓶颈为路径上的最小残量，回退到第一条饱和弧之前
+        long long bottleneck = std::numeric_limits<long long>::max();
+        for (int arc : path) {
+          bottleneck = std::min(bottleneck, graph.get_residual(arc));
+        }
+        size_t first_saturated = path.size();
+        for (size_t i = 0; i < path.size(); i++) {
+          graph.push_flow(path[i], bottleneck);
+          if (first_saturated == path.size() &&
+              graph.get_residual(path[i]) == 0) {
+            first_saturated = i;
+          }
+        }
+        total += bottleneck;
+        path.resize(first_saturated);
+        u = path.empty() ? source : graph.get_head(path.back());
+        continue;
+      }
+
+      // 沿当前弧前进
+      bool advanced = false;
+      for (int &k = current[u]; k < graph.arc_end(u); k++) {
+        int arc = graph.arc_at(k);
+        int v = graph.get_head(arc);
+        if (graph.get_residual(arc) > 0 && level[v] == level[u] + 1) {
+          path.push_back(arc);
+          u = v;
+          advanced = true;
+          break;
+        }
+      }
+      if (advanced) {
+        continue;
+      }
+
+      // 死胡同：从分层图中删除u并回退
+      level[u] = -1;
+      if (path.empty()) {
+        break;
+      }
+      u = graph.get_tail(path.back());
+      path.pop_back();
+      current[u]++;
+    }
+    return total;
+  }
+
+public:
+  // 在graph上计算最大流，流量保留在graph中（可用get_flow查询）
+  static long long max_flow(ResidualGraph &graph, int source, int sink) {
+    int n = graph.get_node_count();
+    if (source < 0 || source >= n || sink < 0 || sink >= n) {
+      throw std::out_of_range("Source or sink out of range");
+    }
+    if (source == sink) {
+      throw std::invalid_argument("Source and sink must differ");
+    }
+    graph.finalize();
+
+    std::vector<int> level(n), current(n), queue, path;
+    queue.reserve(n);
+    long long flow = 0;
+
+    while (build_levels(graph, source, sink, level, queue)) {
+      for (int u = 0; u < n; u++) {
+        current[u] = graph.arc_begin(u);
+      }
+      flow += blocking_flow(graph, source, sink, level, current, path);
+    }
+    return flow;
+  }
+
+  // 与其他算法一致的稠密接口
+  static MaxFlowResult compute_max_flow(const FlowNetwork &network) {
+    int n = network.get_node_count();
+    ResidualGraph graph = ResidualGraph::from_flow_network(network);
+    MaxFlowResult result(n);
+    result.max_flow_value = static_cast<int>(
+        max_flow(graph, network.get_source(), network.get_sink()));
+    graph.fill_result(result);
+    return result;
+  }
+};
+
+// Edmonds-Karp：Ford-Fulkerson方法的BFS增广版本，运行在稀疏残量网络上
+// 时间复杂度O(V E^2)，主要用作对照基准
+class EdmondsKarp {
+public:
+  static long long max_flow(ResidualGraph &graph, int source, int sink) {
+    int n = graph.get_node_count();
+    if (source < 0 || source >= n || sink < 0 || sink >= n) {
+      throw std::out_of_range("Source or sink out of range");
+    }
+    if (source == sink) {
+      throw std::invalid_argument("Source and sink must differ");
+    }
+    graph.finalize();
+
+    std::vector<int> parent_arc(n), queue;
+    queue.reserve(n);
+    long long flow = 0;
+
+    while (true) {
+      // BFS查找最短增广路径，parent_arc记录到达每个节点的弧
+      std::fill(parent_arc.begin(), parent_arc.end(), -1);
+      queue.clear();
+      queue.push_back(source);
+      bool found = false;
+      for (size_t head = 0; head < queue.size() && !found; head++) {
+        int u = queue[head];
+        for (int k = graph.arc_begin(u); k < graph.arc_end(u); k++) {
+          int arc = graph.arc_at(k);
+          int v = graph.get_head(arc);
+          if (v != source && parent_arc[v] < 0 && graph.get_residual(arc) > 0) {
+            parent_arc[v] = arc;
+            if (v == sink) {
+              found = true;
+              break;
+            }
+            queue.push_back(v);
+          }
+        }
+      }
+      if (!found) {
+        return flow;
+      }
+
+      long long bottleneck = std::numeric_limits<long long>::max();
+      for (int v = sink; v != source; v = graph.get_tail(parent_arc[v])) {
+        bottleneck = std::min(bottleneck, graph.get_residual(parent_arc[v]));
+      }
+      for (int v = sink; v != source; v = graph.get_tail(parent_arc[v])) {
+        graph.push_flow(parent_arc[v], bottleneck);
+      }
+      flow += bottleneck;
+    }
+  }
+};
+
+// 最高标号推送-重贴标签算法（HIPR风格），运行在稀疏残量网络上
+// - 活跃节点按高度放入桶中，每次处理最高的活跃节点（O(V^2 sqrt(E))）
+// - 间隙启发式：某高度上没有节点时，更高的节点都不可能再到达汇点
+// - 全局重贴标签：定期从汇点做反向BFS，把高度重置为精确距离
+// 第一阶段求出最大预流（汇点的超额即最大流值），
+// 第二阶段把无法到达汇点的超额退回源点，得到合法的流。
+class HighestLabelPushRelabel {
+private:
+  ResidualGraph &graph;
+  int n, source, sink;
+  std::vector<long long> excess;
+  std::vector<int> height;
+  std::vector<int> current;     // 当前弧在CSR中的位置
+  std::vector<int> active_head; // 每个高度的活跃节点栈
+  std::vector<int> active_next;
+  std::vector<int> level_head;  // 每个高度的全部节点（双向链表，用于间隙检测）
+  std::vector<int> level_next;
+  std::vector<int> level_prev;
+  int max_active;               // 可能存在活跃节点的最高高度
+  int max_height;               // 存在节点的最高高度（< n）
+  long long work;               // 自上次全局重贴标签以来的工作量
+  long long relabel_threshold;
+
+  HighestLabelPushRelabel(ResidualGraph &residual, int s, int t)
+      : graph(residual), n(residual.get_node_count()),
+        source(s), sink(t), excess(n, 0), height(n, 0), current(n, 0),
+        active_head(n + 1, -1), active_next(n, -1), level_head(n + 1, -1),
+        level_next(n, -1), level_prev(n, -1), max_active(-1), max_height(0),
+        work(0),
+        relabel_threshold(6LL * n + static_cast<long long>(
+                                        residual.get_arc_count() / 2)) {}
+
+  void add_active(int u) {
+    int h = height[u];
+    active_next[u] = active_head[h];
+    active_head[h] = u;
+    max_active = std::max(max_active, h);
+  }
+
+  void add_to_level(int u) {
+    int h = height[u];
+    level_prev[u] = -1;
+    level_next[u] = level_head[h];
+    if (level_head[h] != -1)
+      level_prev[level_head[h]] = u;
+    level_head[h] = u;
+    max_height = std::max(max_height, h);
+  }
+
+  void remove_from_level(int u) {
+    int h = height[u];
+    if (level_prev[u] != -1)
+      level_next[level_prev[u]] = level_next[u];
+    else
+      level_head[h] = level_next[u];
+    if (level_next[u] != -1)
+      level_prev[level_next[u]] = level_prev[u];
+  }
+
+  // 从汇点在残量网络上反向BFS，高度设为到汇点的距离；到不了的设为n
+  void global_relabel() {
+    std::fill(height.begin(), height.end(), n);
+    std::fill(active_head.begin(), active_head.end(), -1);
+    std::fill(level_head.begin(), level_head.end(), -1);
+    max_active = -1;
+    max_height = 0;
+
+    std::vector<int> queue;
+    queue.reserve(n);
+    queue.push_back(sink);
+    height[sink] = 0;
+    for (size_t head = 0; head < queue.size(); head++) {
+      int v = queue[head];
+      for (int k = graph.arc_begin(v); k < graph.arc_end(v); k++) {
+        int arc = graph.arc_at(k);
+        int w = graph.get_head(arc);
+        // w -> v 的弧是arc的反向弧
+        if (height[w] == n && w != source && graph.get_residual(arc ^ 1) > 0) {
+          height[w] = height[v] + 1;
+          queue.push_back(w);
+        }
+      }
+    }
+
+    for (int u : queue) {
+      current[u] = graph.arc_begin(u);
+      add_to_level(u);
+      if (u != sink && excess[u] > 0)
+        add_active(u);
+    }
+    work = 0;
+  }
+
+  // 高度h上已没有节点：所有高于h的节点都到不了汇点
+  void gap(int h) {
+    for (int level = h + 1; level <= max_height; level++) {
+      for (int u = level_head[level]; u != -1; u = level_next[u])
+        height[u] = n;
+      level_head[level] = -1;
+      active_head[level] = -1;
+    }
+    max_height = h - 1 < 0 ? 0 : h - 1;
+    max_active = std::min(max_active, h - 1);
+  }
+
+  void relabel(int u) {
+    int old_height = height[u];
+    remove_from_level(u);
+    if (level_head[old_height] == -1) {
+      // u是该高度唯一的节点：u和更高的节点一起移出
+      height[u] = n;
+      gap(old_height);
+      return;
+    }
+
+    int new_height = n;
+    int best = graph.arc_begin(u);
+    for (int k = graph.arc_begin(u); k < graph.arc_end(u); k++) {
+      int arc = graph.arc_at(k);
+      if (graph.get_residual(arc) > 0 &&
+          height[graph.get_head(arc)] + 1 < new_height) {
+        new_height = height[graph.get_head(arc)] + 1;
+        best = k;
+      }
+    }
+    work += 12 + graph.arc_end(u) - graph.arc_begin(u);
+
+    height[u] = new_height;
+    current[u] = best;
+    if (new_height < n)
+      add_to_level(u);
+  }
+
+  void discharge(int u) {
+    while (excess[u] > 0) {
+      if (current[u] == graph.arc_end(u)) {
+        relabel(u);
+        if (height[u] >= n)
+          return;
+        continue;
+      }
+
+      int arc = graph.arc_at(current[u]);
+      int v = graph.get_head(arc);
+      long long residual = graph.get_residual(arc);
+      if (residual > 0 && height[v] + 1 == height[u]) {
+        long long amount = std::min(excess[u], residual);
+        graph.push_flow(arc, amount);
+        excess[u] -= amount;
+        if (excess[v] == 0 && v != sink)
+          add_active(v);
+        excess[v] += amount;
+        if (excess[u] == 0)
+          return;
+      }
+      current[u]++;
+    }
+  }
+
+  // 第一阶段：最大预流
+  void compute_preflow() {
+    for (int k = graph.arc_begin(source); k < graph.arc_end(source); k++) {
+      int arc = graph.arc_at(k);
+      long long residual = graph.get_residual(arc);
+      if (residual > 0) {
+        graph.push_flow(arc, residual);
+        excess[graph.get_head(arc)] += residual;
+        excess[source] -= residual;
+      }
+    }
+    global_relabel();
+
+    while (max_active >= 0) {
+      int u = active_head[max_active];
+      if (u == -1) {
+        max_active--;
+        continue;
+      }
+      active_head[max_active] = active_next[u];
+      discharge(u);
+
+      if (work > relabel_threshold)
+        global_relabel();
+    }
+  }
+
+  // 第二阶段：把无法到达汇点的超额沿残量网络退回源点（FIFO推送-重贴标签）
+  void return_excess() {
+    std::fill(height.begin(), height.end(), 2 * n);
+    std::vector<int> queue;
+    queue.reserve(n);
+    queue.push_back(source);
+    height[source] = 0;
+    for (size_t head = 0; head < queue.size(); head++) {
+      int v = queue[head];
+      for (int k = graph.arc_begin(v); k < graph.arc_end(v); k++) {
+        int arc = graph.arc_at(k);
+        int w = graph.get_head(arc);
+        if (height[w] == 2 * n && w != sink &&
+            graph.get_residual(arc ^ 1) > 0) {
+          height[w] = height[v] + 1;
+          queue.push_back(w);
+        }
+      }
+    }
+
+    std::queue<int> active;
+    std::vector<bool> in_queue(n, false);
+    for (int u = 0; u < n; u++) {
+      current[u] = graph.arc_begin(u);
+      if (u != source && u != sink && excess[u] > 0) {
+        active.push(u);
+        in_queue[u] = true;
+      }
+    }
+
+    while (!active.empty()) {
+      int u = active.front();
+      active.pop();
+      in_queue[u] = false;
+
+      while (excess[u] > 0) {
+        if (current[u] == graph.arc_end(u)) {
+          int new_height = 2 * n;
+          for (int k = graph.arc_begin(u); k < graph.arc_end(u); k++) {
+            int arc = graph.arc_at(k);
+            int v = graph.get_head(arc);
+            if (v != sink && graph.get_residual(arc) > 0)
+              new_height = std::min(new_height, height[v] + 1);
+          }
+          height[u] = new_height;
+          current[u] = graph.arc_begin(u);
+          continue;
+        }
+
+        int arc = graph.arc_at(current[u]);
+        int v = graph.get_head(arc);
+        long long residual = graph.get_residual(arc);
+        if (v != sink && residual > 0 && height[v] + 1 == height[u]) {
+          long long amount = std::min(excess[u], residual);
+          graph.push_flow(arc, amount);
+          excess[u] -= amount;
+          excess[v] += amount;
+          if (v != source && !in_queue[v]) {
+            active.push(v);
+            in_queue[v] = true;
+          }
+          if (excess[u] == 0)
+            break;
+        }
+        current[u]++;
+      }
+    }
+  }
+
+public:
+  // 在graph上计算最大流，流量保留在graph中
+  static long long max_flow(ResidualGraph &graph, int source, int sink) {
+    int n = graph.get_node_count();
+    if (source < 0 || source >= n || sink < 0 || sink >= n) {
+      throw std::out_of_range("Source or sink out of range");
+    }
+    if (source == sink) {
+      throw std::invalid_argument("Source and sink must differ");
+    }
+    graph.finalize();
+
+    HighestLabelPushRelabel solver(graph, source, sink);
+    solver.compute_preflow();
+    long long value = solver.excess[sink];
+    solver.return_excess();
+    return value;
+  }
+
+  // 与其他算法一致的稠密接口
+  static MaxFlowResult compute_max_flow(const FlowNetwork &network) {
+    int n = network.get_node_count();
+    ResidualGraph graph = ResidualGraph::from_flow_network(network);
+    MaxFlowResult result(n);
+    result.max_flow_value = static_cast<int>(
+        max_flow(graph, network.get_source(), network.get_sink()));
+    graph.fill_result(result);
+    return result;
+  }
+};
+
+// DIMACS最大流格式（"p max n m"、"n id s|t"、"a u v cap"，节点从1编号）
+struct DimacsFlowProblem {
+  ResidualGraph graph;
+  int source = -1;
+  int sink = -1;
+};
+
+class DimacsMaxFlow {
+public:
+  static DimacsFlowProblem read(std::istream &in) {
+    DimacsFlowProblem problem;
+    bool has_problem_line = false;
+    std::string line;
+    size_t line_number = 0;
+
+    while (std::getline(in, line)) {
+      line_number++;
+      if (line.empty() || line[0] == 'c')
+        continue;
+
+      std::istringstream fields(line);
+      char kind;
+      fields >> kind;
+      bool ok = true;
+      if (kind == 'p') {
+        std::string format;
+        long long nodes, arcs;
+        ok = static_cast<bool>(fields >> format >> nodes >> arcs) &&
+             format == "max" && nodes > 0;
+        if (ok) {
+          problem.graph = ResidualGraph(static_cast<int>(nodes));
+          problem.graph.reserve_edges(static_cast<size_t>(arcs));
+          has_problem_line = true;
+        }
+      } else if (kind == 'n' && has_problem_line) {
+        int id;
+        char role;
+        ok = static_cast<bool>(fields >> id >> role) && (role == 's' || role == 't');
+        if (ok)
+          (role == 's' ? problem.source : problem.sink) = id - 1;
+      } else if (kind == 'a' && has_problem_line) {
+        int u, v;
+        long long capacity;
+        ok = static_cast<bool>(fields >> u >> v >> capacity);
+        if (ok)
+          problem.graph.add_edge(u - 1, v - 1, capacity);
+      } else {
+        ok = false;
+      }
+
+      if (!ok) {
+        throw std::invalid_argument("Malformed DIMACS line " +
+                                    std::to_string(line_number) + ": " + line);
+      }
+    }
+
+    if (!has_problem_line || problem.source < 0 || problem.sink < 0) {
+      throw std::invalid_argument(
+          "DIMACS input lacks a problem line, source or sink");
+    }
+    return problem;
+  }
+
+  static void write(std::ostream &out, const ResidualGraph &graph, int source,
+                    int sink) {
+    out << "p max " << graph.get_node_count() << " " << graph.get_edge_count()
+        << "\n";
+    out << "n " << source + 1 << " s\n";
+    out << "n " << sink + 1 << " t\n";
+    for (size_t e = 0; e < graph.get_arc_count(); e += 2) {
+      int arc = static_cast<int>(e);
+      out << "a " << graph.get_tail(arc) + 1 << " " << graph.get_head(arc) + 1
+          << " " << graph.get_capacity(arc) << "\n";
+    }
+  }
+};
+
 // 工具函数：打印最大流结果
 void print_max_flow_result(const MaxFlowResult &result, int source, int sink) {
   std::cout << "最大流结果:" << std::endl;
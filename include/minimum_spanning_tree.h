@@ -3,10 +3,14 @@
 
 #include "disjoint_set.h"
 #include "graph_representation.h"
+#include "work_stealing_scheduler.h"
 #include <algorithm>
+#include <atomic>
 #include <climits>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <list>
 #include <queue>
 #include <stdexcept>
@@ -15,12 +19,13 @@
 namespace algorithms {
 
 // 最小生成树类
-class MinimumSpanningTree {
+// Graph 需满足 graph_representation.h 中的图概念（AdjacencyListGraph、CSRGraph）
+template <typename Graph = AdjacencyListGraph> class MinimumSpanningTree {
 private:
-  const AdjacencyListGraph &graph;
+  const Graph &graph;
 
 public:
-  MinimumSpanningTree(const AdjacencyListGraph &g) : graph(g) {
+  MinimumSpanningTree(const Graph &g) : graph(g) {
     if (graph.is_directed()) {
       throw std::invalid_argument("最小生成树需要应用于无向图");
     }
@@ -36,7 +41,7 @@ public:
       return {};
     }
 
-    // 获取所有边
+    // 获取所有边（端点为节点下标）
     std::vector<GraphEdge> all_edges = get_all_edges();
 
     // 按权重排序边
@@ -50,12 +55,10 @@ public:
 
     // 遍历所有边，按权重从小到大
     for (const auto &edge : all_edges) {
-      int from_index = edge.from - 1; // 节点ID从1开始
-      int to_index = edge.to - 1;
-
-      if (!ds.is_same_set(from_index, to_index)) {
-        mst_edges.push_back(edge);
-        ds.union_sets(from_index, to_index);
+      if (!ds.is_same_set(edge.from, edge.to)) {
+        mst_edges.emplace_back(graph.get_node_id(edge.from),
+                               graph.get_node_id(edge.to), edge.weight);
+        ds.union_sets(edge.from, edge.to);
 
         // 当MST包含n-1条边时停止
         if (mst_edges.size() == node_count - 1) {
@@ -67,6 +70,172 @@ public:
     return mst_edges;
   }
 
+  /**
+   * @brief 并行过滤的Kruskal算法
+   *
+   * 排序后的边按 batch_size 分批：每批先在调度器上并行过滤掉两端已连通
+   * 的边（ConcurrentDisjointSet::same_set 可并发调用），再按权重顺序串行
+   * 合并剩下的边。过滤只去掉串行算法也会跳过的边，因此结果与 kruskal()
+   * 完全相同；图越稠密，被并行过滤掉的边越多。
+   */
+  std::vector<GraphEdge> kruskal(WorkStealingScheduler &scheduler,
+                                 size_t batch_size = 16384) {
+    size_t node_count = graph.get_node_count();
+    if (node_count == 0) {
+      return {};
+    }
+    batch_size = std::max<size_t>(batch_size, 1);
+
+    std::vector<GraphEdge> all_edges = get_all_edges();
+    std::sort(all_edges.begin(), all_edges.end(),
+              [](const GraphEdge &a, const GraphEdge &b) {
+                return a.weight < b.weight;
+              });
+
+    ConcurrentDisjointSet ds(static_cast<int>(node_count));
+    std::vector<GraphEdge> mst_edges;
+    std::vector<unsigned char> useful(batch_size);
+
+    for (size_t begin = 0;
+         begin < all_edges.size() && mst_edges.size() + 1 < node_count;
+         begin += batch_size) {
+      size_t end = std::min(all_edges.size(), begin + batch_size);
+      scheduler.parallel_for(begin, end, 1024, [&](size_t lo, size_t hi) {
+        for (size_t k = lo; k < hi; k++) {
+          useful[k - begin] =
+              !ds.same_set(all_edges[k].from, all_edges[k].to);
+        }
+      });
+      for (size_t k = begin; k < end && mst_edges.size() + 1 < node_count;
+           k++) {
+        const GraphEdge &edge = all_edges[k];
+        if (useful[k - begin] && ds.unite(edge.from, edge.to)) {
+          mst_edges.emplace_back(graph.get_node_id(edge.from),
+                                 graph.get_node_id(edge.to), edge.weight);
+        }
+      }
+    }
+
+    return mst_edges;
+  }
+
+  /**
+   * @brief 并行Borůvka算法
+   *
+   * 每一轮中每个分量选出与外部相连的最小边，并把这些边同时加入森林：
+   * - 选边：并行扫描存活的边，对两端分量的"最小边"槽位做CAS取最小值
+   * - 合并：并行遍历各分量的最小边，调用 ConcurrentDisjointSet::unite，
+   *   返回 true 的边进入森林（两端分量可能选了同一条边，只记一次）
+   * - 压缩：把边的端点改写为所在分量的根（之后的查找只需一两步），
+   *   去掉两端已在同一分量中的边
+   * 边按 (权重, 边编号) 比较，关系严格全序，同一轮选出的边不会成环；
+   * 每轮分量数至少减半，至多 lg V 轮。图不连通时返回最小生成森林。
+   *
+   * @return 按 (权重, 边编号) 排序的森林边；与 filter_kruskal 结果相同
+   */
+  std::vector<GraphEdge> boruvka(WorkStealingScheduler &scheduler,
+                                 size_t grain = 4096) {
+    size_t node_count = graph.get_node_count();
+    if (node_count == 0) {
+      return {};
+    }
+    std::vector<RankedEdge> edges = get_ranked_edges();
+    ConcurrentDisjointSet ds(static_cast<int>(node_count));
+    std::vector<std::atomic<std::uint64_t>> best(node_count);
+    std::vector<RankedEdge> active(edges);
+    std::vector<unsigned char> taken(edges.size(), 0);
+
+    while (!active.empty()) {
+      scheduler.parallel_for(0, node_count, grain, [&](size_t lo, size_t hi) {
+        for (size_t v = lo; v < hi; v++) {
+          best[v].store(kNoEdge, std::memory_order_relaxed);
+        }
+      });
+
+      // 1. 每个分量的最小出边
+      scheduler.parallel_for(0, active.size(), grain, [&](size_t lo,
+                                                          size_t hi) {
+        for (size_t k = lo; k < hi; k++) {
+          RankedEdge &edge = active[k];
+          int cu = ds.find(edge.from), cv = ds.find(edge.to);
+          edge.from = cu;
+          edge.to = cv;
+          if (cu != cv) {
+            atomic_min(best[cu], edge.key);
+            atomic_min(best[cv], edge.key);
+          }
+        }
+      });
+
+      // 2. 同时加入各分量的最小边
+      std::atomic<bool> merged(false);
+      scheduler.parallel_for(0, node_count, grain, [&](size_t lo, size_t hi) {
+        for (size_t v = lo; v < hi; v++) {
+          std::uint64_t key = best[v].load(std::memory_order_relaxed);
+          if (key == kNoEdge) {
+            continue;
+          }
+          std::uint32_t e = static_cast<std::uint32_t>(key);
+          if (ds.unite(edges[e].from, edges[e].to)) {
+            taken[e] = 1;
+            merged.store(true, std::memory_order_relaxed);
+          }
+        }
+      });
+      if (!merged.load()) {
+        break;
+      }
+
+      // 3. 去掉本轮选边前就已在分量内部的边；本轮合并产生的内部边下一轮去掉
+      active.erase(std::remove_if(active.begin(), active.end(),
+                                  [](const RankedEdge &edge) {
+                                    return edge.from == edge.to;
+                                  }),
+                   active.end());
+    }
+
+    std::vector<const RankedEdge *> chosen;
+    for (size_t e = 0; e < edges.size(); e++) {
+      if (taken[e]) {
+        chosen.push_back(&edges[e]);
+      }
+    }
+    std::sort(chosen.begin(), chosen.end(),
+              [](const RankedEdge *a, const RankedEdge *b) {
+                return a->key < b->key;
+              });
+    std::vector<GraphEdge> mst_edges;
+    for (const RankedEdge *edge : chosen) {
+      mst_edges.push_back(to_graph_edge(*edge));
+    }
+    return mst_edges;
+  }
+
+  /**
+   * @brief Filter-Kruskal算法（Osipov、Sanders、Singler）
+   *
+   * 不对全部边排序：以三数取中的边为枢轴把边分成轻、重两部分，先递归处理
+   * 轻边；此时许多重边的两端已经连通，在调度器上并行过滤掉它们后再递归
+   * 处理剩下的重边。边数不超过 threshold 时排序后直接执行Kruskal。
+   * 稠密图中大部分重边在排序之前就被过滤掉。
+   *
+   * @return 按 (权重, 边编号) 排序的森林边
+   */
+  std::vector<GraphEdge> filter_kruskal(WorkStealingScheduler &scheduler,
+                                        size_t threshold = 16384) {
+    size_t node_count = graph.get_node_count();
+    if (node_count == 0) {
+      return {};
+    }
+    std::vector<RankedEdge> edges = get_ranked_edges();
+    ConcurrentDisjointSet ds(static_cast<int>(node_count));
+    std::vector<unsigned char> useful(edges.size());
+    std::vector<GraphEdge> mst_edges;
+    filter_kruskal_range(scheduler, ds, edges, useful, 0, edges.size(),
+                         std::max<size_t>(threshold, 2), mst_edges);
+    return mst_edges;
+  }
+
   // Prim算法（算法导论23.2节）
   std::vector<GraphEdge> prim(int start_node = 1) {
     size_t node_count = graph.get_node_count();
@@ -74,8 +243,8 @@ public:
       return {};
     }
 
-    int start_index = start_node - 1; // 节点ID从1开始
-    if (start_index < 0 || start_index >= static_cast<int>(node_count)) {
+    int start_index = graph.get_node_index(start_node);
+    if (start_index < 0) {
       throw std::invalid_argument("起始节点不存在");
     }
 
@@ -102,24 +271,73 @@ public:
       in_mst[u] = true;
 
       // 遍历所有邻居
-      auto neighbors = graph.get_neighbors(u + 1);
-      for (int neighbor_id : neighbors) {
-        int v = neighbor_id - 1;
-        int weight = get_edge_weight(u + 1, neighbor_id);
-
+      graph.for_each_out_edge(u, [&](int v, int weight) {
         if (!in_mst[v] && weight < key[v]) {
           key[v] = weight;
           parent[v] = u;
           pq.push({key[v], v});
         }
-      }
+      });
     }
 
     // 构建MST边集合
     std::vector<GraphEdge> mst_edges;
     for (int i = 0; i < static_cast<int>(node_count); i++) {
       if (parent[i] != -1) {
-        mst_edges.emplace_back(parent[i] + 1, i + 1, key[i]);
+        mst_edges.emplace_back(graph.get_node_id(parent[i]),
+                               graph.get_node_id(i), key[i]);
+      }
+    }
+
+    return mst_edges;
+  }
+
+  // Prim算法的DECREASE-KEY版本（算法导论23.2节伪代码）
+  // Heap 为 addressable_heap.h 中的可寻址堆，关键字为 (权重, 节点索引)，
+  // 每个节点只入堆一次，之后以 decrease_key 更新
+  template <typename Heap>
+  std::vector<GraphEdge> prim_with_heap(int start_node = 1) {
+    size_t node_count = graph.get_node_count();
+    int start_index = graph.get_node_index(start_node);
+    if (start_index < 0) {
+      throw std::invalid_argument("起始节点不存在");
+    }
+
+    using Handle = typename Heap::handle_type;
+    const Handle none = std::numeric_limits<Handle>::max();
+
+    std::vector<bool> in_mst(node_count, false);
+    std::vector<int> key(node_count, INT_MAX);
+    std::vector<int> parent(node_count, -1);
+    std::vector<Handle> handles(node_count, none);
+
+    Heap heap;
+    key[start_index] = 0;
+    handles[start_index] = heap.push({0, start_index});
+
+    while (!heap.empty()) {
+      int u = heap.pop().second;
+      handles[u] = none;
+      in_mst[u] = true;
+
+      graph.for_each_out_edge(u, [&](int v, int weight) {
+        if (!in_mst[v] && weight < key[v]) {
+          key[v] = weight;
+          parent[v] = u;
+          if (handles[v] == none) {
+            handles[v] = heap.push({weight, v});
+          } else {
+            heap.decrease_key(handles[v], {weight, v});
+          }
+        }
+      });
+    }
+
+    std::vector<GraphEdge> mst_edges;
+    for (int i = 0; i < static_cast<int>(node_count); i++) {
+      if (parent[i] != -1) {
+        mst_edges.emplace_back(graph.get_node_id(parent[i]),
+                               graph.get_node_id(i), key[i]);
       }
     }
 
@@ -145,8 +363,11 @@ public:
     // 检查是否所有节点都连通
     DisjointSet ds(node_count);
     for (const auto &edge : mst_edges) {
-      int from_index = edge.from - 1;
-      int to_index = edge.to - 1;
+      int from_index = graph.get_node_index(edge.from);
+      int to_index = graph.get_node_index(edge.to);
+      if (from_index == -1 || to_index == -1) {
+        return false;
+      }
       ds.union_sets(from_index, to_index);
     }
 
@@ -177,33 +398,117 @@ public:
   }
 
 private:
-  // 获取图中所有边
+  // 带全序关键字的边：高32位为保序变换后的权重，低32位为边编号
+  struct RankedEdge {
+    std::uint64_t key;
+    int from;
+    int to;
+  };
+
+  static constexpr std::uint64_t kNoEdge = UINT64_MAX;
+
+  std::vector<RankedEdge> get_ranked_edges() const {
+    std::vector<GraphEdge> all_edges = get_all_edges();
+    if (all_edges.size() >= kNoEdge >> 32) {
+      throw std::length_error("边数超过32位编号的范围");
+    }
+    std::vector<RankedEdge> edges(all_edges.size());
+    for (size_t e = 0; e < all_edges.size(); e++) {
+      std::uint32_t weight_bits =
+          static_cast<std::uint32_t>(all_edges[e].weight) ^ 0x80000000u;
+      edges[e] = {static_cast<std::uint64_t>(weight_bits) << 32 | e,
+                  all_edges[e].from, all_edges[e].to};
+    }
+    return edges;
+  }
+
+  GraphEdge to_graph_edge(const RankedEdge &edge) const {
+    int weight =
+        static_cast<int>(static_cast<std::uint32_t>(edge.key >> 32) ^
+                         0x80000000u);
+    return GraphEdge(graph.get_node_id(edge.from), graph.get_node_id(edge.to),
+                     weight);
+  }
+
+  static void atomic_min(std::atomic<std::uint64_t> &slot,
+                         std::uint64_t value) {
+    std::uint64_t current = slot.load(std::memory_order_relaxed);
+    while (value < current &&
+           !slot.compare_exchange_weak(current, value,
+                                       std::memory_order_relaxed)) {
+    }
+  }
+
+  void filter_kruskal_range(WorkStealingScheduler &scheduler,
+                            ConcurrentDisjointSet &ds,
+                            std::vector<RankedEdge> &edges,
+                            std::vector<unsigned char> &useful, size_t begin,
+                            size_t end, size_t threshold,
+                            std::vector<GraphEdge> &mst_edges) {
+    size_t node_count = graph.get_node_count();
+    if (begin == end || mst_edges.size() + 1 >= node_count) {
+      return;
+    }
+    auto by_key = [](const RankedEdge &a, const RankedEdge &b) {
+      return a.key < b.key;
+    };
+    if (end - begin <= threshold) {
+      std::sort(edges.begin() + begin, edges.begin() + end, by_key);
+      for (size_t k = begin; k < end && mst_edges.size() + 1 < node_count;
+           k++) {
+        if (ds.unite(edges[k].from, edges[k].to)) {
+          mst_edges.push_back(to_graph_edge(edges[k]));
+        }
+      }
+      return;
+    }
+
+    // 三数取中：关键字互不相同，枢轴两侧都非空
+    std::uint64_t a = edges[begin].key, b = edges[(begin + end) / 2].key,
+                  c = edges[end - 1].key;
+    std::uint64_t pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+    size_t middle =
+        std::partition(edges.begin() + begin, edges.begin() + end,
+                       [pivot](const RankedEdge &e) { return e.key <= pivot; }) -
+        edges.begin();
+    filter_kruskal_range(scheduler, ds, edges, useful, begin, middle,
+                         threshold, mst_edges);
+    if (mst_edges.size() + 1 >= node_count) {
+      return;
+    }
+
+    // 并行过滤重边，保留两端仍不连通的边
+    scheduler.parallel_for(middle, end, 1024, [&](size_t lo, size_t hi) {
+      for (size_t k = lo; k < hi; k++) {
+        useful[k] = !ds.same_set(edges[k].from, edges[k].to);
+      }
+    });
+    size_t kept = middle;
+    for (size_t k = middle; k < end; k++) {
+      if (useful[k]) {
+        edges[kept++] = edges[k];
+      }
+    }
+    filter_kruskal_range(scheduler, ds, edges, useful, middle, kept, threshold,
+                         mst_edges);
+  }
+
+  // 获取图中所有边（端点为节点下标，无向边只取一次）
   std::vector<GraphEdge> get_all_edges() const {
     std::vector<GraphEdge> edges;
     size_t node_count = graph.get_node_count();
 
     for (size_t i = 0; i < node_count; i++) {
-      int node_id = i + 1;
-      auto neighbors = graph.get_neighbors(node_id);
-
-      for (int neighbor : neighbors) {
-        // 避免重复添加无向图的边
-        if (node_id < neighbor) {
-          int weight = get_edge_weight(node_id, neighbor);
-          edges.emplace_back(node_id, neighbor, weight);
+      int from_index = i;
+      graph.for_each_out_edge(i, [&](int to_index, int weight) {
+        if (from_index < to_index) {
+          edges.emplace_back(from_index, to_index, weight);
         }
-      }
+      });
     }
 
     return edges;
   }
-
-  // 获取两个节点之间的边权重
-  int get_edge_weight(int from, int to) const {
-    // 由于图实现限制，我们使用一个简化的权重计算
-    // 在实际应用中，应该从图结构中获取实际权重
-    return std::abs(from - to) + 1; // 简化实现
-  }
 };
 
 // 算法导论中的经典最小生成树示例
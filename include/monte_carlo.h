@@ -0,0 +1,415 @@
+#ifndef MONTE_CARLO_H
+#define MONTE_CARLO_H
+
+#include "work_stealing_scheduler.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace algorithms {
+
+/**
+ * @brief Philox4x32-10 计数器式随机数（Salmon 等，SC'11）
+ *
+ * 输出是 (计数器, 密钥) 的纯函数：10轮 32×32→64 位乘法与异或组成的分组
+ * 置换，没有内部状态。任何线程都可以直接算出第 i 个随机数，不需要
+ * 顺序推进，因此并行结果与线程数无关。
+ */
+class Philox4x32 {
+public:
+  using Counter = std::array<uint32_t, 4>;
+  using Key = std::array<uint32_t, 2>;
+
+  static Counter generate(Counter counter, Key key) {
+    for (int round = 0; round < kRounds; round++) {
+      uint64_t p0 = static_cast<uint64_t>(kMultiplier0) * counter[0];
+      uint64_t p1 = static_cast<uint64_t>(kMultiplier1) * counter[2];
+      counter = {static_cast<uint32_t>(p1 >> 32) ^ counter[1] ^ key[0],
+                 static_cast<uint32_t>(p1),
+                 static_cast<uint32_t>(p0 >> 32) ^ counter[3] ^ key[1],
+                 static_cast<uint32_t>(p0)};
+      key[0] += kWeyl0;
+      key[1] += kWeyl1;
+    }
+    return counter;
+  }
+
+private:
+  static constexpr int kRounds = 10;
+  static constexpr uint32_t kMultiplier0 = 0xD2511F53;
+  static constexpr uint32_t kMultiplier1 = 0xCD9E8D57;
+  static constexpr uint32_t kWeyl0 = 0x9E3779B9;
+  static constexpr uint32_t kWeyl1 = 0xBB67AE85;
+};
+
+/**
+ * @brief 一条 Philox 随机数流，满足 UniformRandomBitGenerator
+ *
+ * 计数器的前两个字为流号，第三个字为子流号，第四个字为块号，每块产生
+ * 四个32位随机数。不同的 (流号, 子流号) 互不重叠，所以每次试验、每个
+ * 数据块都可以有自己的流，与由哪个线程执行无关。区间整数与实数由本类
+ * 自己完成，不依赖各标准库实现不同的 std::*_distribution。
+ */
+class PhiloxStream {
+public:
+  using result_type = uint64_t;
+
+  PhiloxStream(uint64_t seed, uint64_t stream, uint32_t substream = 0)
+      : key{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)},
+        counter{static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32),
+                substream, 0},
+        used(4) {}
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return UINT64_MAX; }
+
+  result_type operator()() {
+    uint64_t low = next32();
+    return low | static_cast<uint64_t>(next32()) << 32;
+  }
+
+  uint32_t next32() {
+    if (used == 4) {
+      buffer = Philox4x32::generate(counter, key);
+      counter[3]++;
+      used = 0;
+    }
+    return buffer[used++];
+  }
+
+  // [0, 1) 内的均匀实数，取高53位
+  double uniform() {
+    return static_cast<double>((*this)() >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  // [0, bound) 内的均匀整数（Lemire 乘法映射，偏差不超过 bound/2^64）
+  uint64_t bounded(uint64_t bound) {
+    return static_cast<uint64_t>(
+        (static_cast<unsigned __int128>((*this)()) * bound) >> 64);
+  }
+
+  // [0, bound) 内无偏的均匀整数，bound > 0：只用一个32位字，拒绝率不超过 bound/2^32
+  uint32_t bounded32(uint32_t bound) {
+    uint64_t product = static_cast<uint64_t>(next32()) * bound;
+    if (static_cast<uint32_t>(product) < bound) {
+      uint32_t threshold = static_cast<uint32_t>(-bound) % bound;
+      while (static_cast<uint32_t>(product) < threshold) {
+        product = static_cast<uint64_t>(next32()) * bound;
+      }
+    }
+    return static_cast<uint32_t>(product >> 32);
+  }
+
+  bool bernoulli(double p) { return uniform() < p; }
+
+private:
+  Philox4x32::Key key;
+  Philox4x32::Counter counter;
+  Philox4x32::Counter buffer;
+  int used;
+};
+
+/**
+ * @brief 蒙特卡罗模拟的参数
+ */
+struct MonteCarloOptions {
+  uint64_t max_trials = 10000;     // 试验次数上限
+  uint64_t seed = 0;               // 同一种子在任何线程数下得到同一结果
+  double target_half_width = 0.0;  // 大于0时，所有分量的置信区间半宽都不超过它就停止
+  double z = 1.96;                 // 置信区间的正态分位数（1.96 对应95%）
+  uint64_t min_trials = 10000;     // 提前停止前至少完成的试验次数
+  WorkStealingScheduler *scheduler = nullptr; // 为空时在调用线程上串行执行
+};
+
+/**
+ * @brief 蒙特卡罗估计：每个分量的样本均值与置信区间半宽
+ */
+struct MonteCarloResult {
+  uint64_t trials = 0;
+  bool stopped_early = false;     // 在 max_trials 之前达到了 target_half_width
+  std::vector<double> mean;
+  std::vector<double> variance;   // 样本方差
+  std::vector<double> half_width; // z·sqrt(variance / trials)
+
+  double estimate(size_t i = 0) const { return mean[i]; }
+};
+
+/**
+ * @brief 并行蒙特卡罗驱动
+ *
+ * 第 t 次试验使用流号为 t 的 PhiloxStream，试验本身与执行顺序无关。
+ * 试验按 kChunkTrials 次一块划分，每块在自己的累加器里求和（以块内第一次
+ * 试验的值为平移量，累加差值与差值平方），块之间按块号顺序用 Chan 等人
+ * 的公式合并均值与二阶矩。块的划分与合并顺序只取决于试验编号，所以同一
+ * 种子在1个线程与多个线程下得到逐位相同的结果；按线程累加再归约时，
+ * 浮点和的结合顺序会随调度而变。
+ *
+ * 每轮执行 kChunksPerRound 块，轮末检查置信区间：设置了 target_half_width
+ * 时，完成至少 min_trials 次试验且各分量半宽都达标就停止。停止点只在轮的
+ * 边界上，与线程数无关。
+ */
+class MonteCarloEngine {
+public:
+  static constexpr uint64_t kChunkTrials = 1024;
+  static constexpr size_t kChunksPerRound = 64;
+
+  /**
+   * @brief 多分量估计
+   * @param options 模拟参数
+   * @param dimensions 每次试验输出的分量数
+   * @param trial 以 trial(PhiloxStream &rng, double *values) 调用，写入
+   *        dimensions 个值。每块复制一份 trial，成员变量可以用作块内的工作区
+   * @throws std::invalid_argument 如果 max_trials 或 dimensions 为0
+   */
+  template <typename Trial>
+  static MonteCarloResult estimate(const MonteCarloOptions &options,
+                                   size_t dimensions, const Trial &trial) {
+    if (options.max_trials == 0 || dimensions == 0) {
+      throw std::invalid_argument("试验次数与分量数必须为正");
+    }
+    MonteCarloResult result;
+    result.mean.assign(dimensions, 0.0);
+    result.variance.assign(dimensions, 0.0);
+    result.half_width.assign(dimensions, 0.0);
+    std::vector<double> m2(dimensions, 0.0);
+
+    uint64_t done = 0;
+    while (done < options.max_trials) {
+      uint64_t round_end =
+          std::min(options.max_trials, done + kChunkTrials * kChunksPerRound);
+      size_t chunks = static_cast<size_t>((round_end - done + kChunkTrials - 1) /
+                                          kChunkTrials);
+      std::vector<ChunkSums> sums(chunks, ChunkSums(dimensions));
+      auto run_chunks = [&](size_t lo, size_t hi) {
+        for (size_t c = lo; c < hi; c++) {
+          uint64_t first = done + c * kChunkTrials;
+          run_chunk(options.seed, first, std::min(round_end, first + kChunkTrials),
+                    trial, sums[c]);
+        }
+      };
+      if (options.scheduler) {
+        options.scheduler->parallel_for(0, chunks, 1, run_chunks);
+      } else {
+        run_chunks(0, chunks);
+      }
+
+      for (const ChunkSums &chunk : sums) {
+        merge(result.trials, result.mean, m2, chunk);
+      }
+      done = round_end;
+
+      double widest = 0.0;
+      for (size_t d = 0; d < dimensions; d++) {
+        double n = static_cast<double>(result.trials);
+        result.variance[d] = result.trials > 1 ? m2[d] / (n - 1) : 0.0;
+        result.half_width[d] = options.z * std::sqrt(result.variance[d] / n);
+        widest = std::max(widest, result.half_width[d]);
+      }
+      if (options.target_half_width > 0 && done >= options.min_trials &&
+          widest <= options.target_half_width) {
+        result.stopped_early = done < options.max_trials;
+        break;
+      }
+    }
+    return result;
+  }
+
+  /**
+   * @brief 单分量估计，trial(PhiloxStream &rng) 返回本次试验的值
+   */
+  template <typename Trial>
+  static MonteCarloResult estimate(const MonteCarloOptions &options,
+                                   const Trial &trial) {
+    return estimate(options, 1, ScalarTrial<Trial>{trial});
+  }
+
+private:
+  // 一块试验的平移和：shift 为块内第一次试验的值
+  struct ChunkSums {
+    explicit ChunkSums(size_t dimensions)
+        : count(0), shift(dimensions), sum(dimensions), sum_squares(dimensions) {}
+    uint64_t count;
+    std::vector<double> shift, sum, sum_squares;
+  };
+
+  template <typename Trial> struct ScalarTrial {
+    Trial trial;
+    void operator()(PhiloxStream &rng, double *values) { values[0] = trial(rng); }
+  };
+
+  template <typename Trial>
+  static void run_chunk(uint64_t seed, uint64_t first, uint64_t last,
+                        const Trial &prototype, ChunkSums &sums) {
+    Trial trial = prototype;
+    size_t dimensions = sums.shift.size();
+    std::vector<double> values(dimensions);
+    for (uint64_t t = first; t < last; t++) {
+      PhiloxStream rng(seed, t);
+      trial(rng, values.data());
+      if (t == first) {
+        sums.shift = values;
+      }
+      for (size_t d = 0; d < dimensions; d++) {
+        double x = values[d] - sums.shift[d];
+        sums.sum[d] += x;
+        sums.sum_squares[d] += x * x;
+      }
+    }
+    sums.count = last - first;
+  }
+
+  // 把一块并入 (count, mean, m2)
+  static void merge(uint64_t &count, std::vector<double> &mean,
+                    std::vector<double> &m2, const ChunkSums &chunk) {
+    double n_a = static_cast<double>(count);
+    double n_b = static_cast<double>(chunk.count);
+    double n = n_a + n_b;
+    for (size_t d = 0; d < mean.size(); d++) {
+      double offset = chunk.sum[d] / n_b;
+      double mean_b = chunk.shift[d] + offset;
+      double m2_b = chunk.sum_squares[d] - chunk.sum[d] * offset;
+      double delta = mean_b - mean[d];
+      mean[d] += delta * n_b / n;
+      m2[d] += m2_b + delta * delta * n_a * n_b / n;
+    }
+    count += chunk.count;
+  }
+};
+
+/**
+ * @brief 并行均匀随机洗牌：嵌套分桶（Sanders 1998）
+ *
+ * 每个元素独立地均匀选一个桶，按 (桶, 数据块) 计数、求前缀和后分散到
+ * 暂存数组，再在每个桶内递归；桶不超过 kLeafSize 个元素（能放进二级
+ * 缓存）时做 Fisher–Yates。一层最多 kMaxBuckets 个桶，使分散时同时写入的
+ * 位置数在 TLB 与写合并缓冲的容量之内，十亿个元素只需三层。
+ * 桶号在计数与分散两趟中由同一条 Philox 流重新生成，不占额外内存。
+ * 数据块、桶与随机数流都只由 n 决定，同一种子在任何线程数下得到同一排列。
+ * 需要 n 个元素的暂存空间。
+ */
+class ParallelShuffle {
+public:
+  static constexpr size_t kLeafSize = size_t(1) << 16;
+  static constexpr size_t kMaxBuckets = 256;
+  static constexpr size_t kBlockSize = size_t(1) << 16;
+
+  /**
+   * @brief 把 data[0..n) 原地打乱为均匀随机的排列
+   */
+  template <typename T>
+  static void shuffle(T *data, size_t n, uint64_t seed,
+                      WorkStealingScheduler *scheduler = nullptr) {
+    if (n <= kLeafSize) {
+      shuffle_leaf(data, n, seed, 1);
+      return;
+    }
+    std::vector<T> scratch(n);
+    auto split_root = [&] {
+      split(data, scratch.data(), n, seed, 1, true, scheduler);
+    };
+    if (scheduler) {
+      scheduler->run(split_root);
+    } else {
+      split_root();
+    }
+  }
+
+  template <typename T>
+  static void shuffle(std::vector<T> &data, uint64_t seed,
+                      WorkStealingScheduler *scheduler = nullptr) {
+    shuffle(data.data(), data.size(), seed, scheduler);
+  }
+
+private:
+  template <typename T>
+  static void shuffle_leaf(T *data, size_t n, uint64_t seed, uint64_t node) {
+    PhiloxStream rng(seed, node);
+    for (size_t i = n; i > 1; i--) {
+      std::swap(data[i - 1], data[rng.bounded32(static_cast<uint32_t>(i))]);
+    }
+  }
+
+  template <typename Body>
+  static void for_range(WorkStealingScheduler *scheduler, size_t count,
+                        const Body &body) {
+    if (scheduler) {
+      scheduler->parallel_for(0, count, 1, body);
+    } else {
+      body(0, count);
+    }
+  }
+
+  // 数据在 src，结果放回 src（result_in_src）或 dst；node 为本节点的流号，
+  // 第 b 个桶的流号为 node·(kMaxBuckets+1)+1+b，不同节点互不相同
+  template <typename T>
+  static void split(T *src, T *dst, size_t n, uint64_t seed, uint64_t node,
+                    bool result_in_src, WorkStealingScheduler *scheduler) {
+    if (n <= kLeafSize) {
+      T *target = result_in_src ? src : dst;
+      if (!result_in_src) {
+        std::copy(src, src + n, dst);
+      }
+      shuffle_leaf(target, n, seed, node);
+      return;
+    }
+
+    // 期望桶大小为 kLeafSize/2，留出随机波动的余地
+    size_t buckets = std::min(kMaxBuckets, (2 * n + kLeafSize - 1) / kLeafSize);
+    uint32_t bucket_count = static_cast<uint32_t>(buckets);
+    size_t blocks = (n + kBlockSize - 1) / kBlockSize;
+    std::vector<size_t> offsets(blocks * buckets, 0); // [块][桶]
+    auto bucket_stream = [&](size_t block) {
+      return PhiloxStream(seed, node, static_cast<uint32_t>(block + 1));
+    };
+
+    for_range(scheduler, blocks, [&](size_t lo, size_t hi) {
+      for (size_t block = lo; block < hi; block++) {
+        PhiloxStream rng = bucket_stream(block);
+        size_t *count = &offsets[block * buckets];
+        size_t end = std::min(n, (block + 1) * kBlockSize);
+        for (size_t i = block * kBlockSize; i < end; i++) {
+          count[rng.bounded32(bucket_count)]++;
+        }
+      }
+    });
+
+    // 按桶优先、块其次求前缀和：同一桶里各块的元素按块号排列
+    std::vector<size_t> bucket_begin(buckets + 1, 0);
+    size_t running = 0;
+    for (size_t b = 0; b < buckets; b++) {
+      bucket_begin[b] = running;
+      for (size_t block = 0; block < blocks; block++) {
+        size_t count = offsets[block * buckets + b];
+        offsets[block * buckets + b] = running;
+        running += count;
+      }
+    }
+    bucket_begin[buckets] = n;
+
+    for_range(scheduler, blocks, [&](size_t lo, size_t hi) {
+      for (size_t block = lo; block < hi; block++) {
+        PhiloxStream rng = bucket_stream(block);
+        size_t *position = &offsets[block * buckets];
+        size_t end = std::min(n, (block + 1) * kBlockSize);
+        for (size_t i = block * kBlockSize; i < end; i++) {
+          dst[position[rng.bounded32(bucket_count)]++] = src[i];
+        }
+      }
+    });
+
+    for_range(scheduler, buckets, [&](size_t lo, size_t hi) {
+      for (size_t b = lo; b < hi; b++) {
+        size_t begin = bucket_begin[b], size = bucket_begin[b + 1] - begin;
+        split(dst + begin, src + begin, size, seed, node * (kMaxBuckets + 1) + 1 + b,
+              !result_in_src, scheduler);
+      }
+    });
+  }
+};
+
+} // namespace algorithms
+
+#endif // MONTE_CARLO_H
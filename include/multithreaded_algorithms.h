@@ -1,10 +1,18 @@
 #ifndef MULTITHREADED_ALGORITHMS_H
 #define MULTITHREADED_ALGORITHMS_H
 
+#include "cpu_features.h"
+#include "gemm_kernel.h"
+#include "matrix_operations.h"
+#include "quick_sort_generic.h"
+#include "work_stealing_scheduler.h"
+#include "workload_generator.h"
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cmath>
 #include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <future>
 #include <iostream>
@@ -13,10 +21,67 @@
 #include <queue>
 #include <random>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 namespace algorithms {
 
+namespace sample_sort_detail {
+
+// 一层样本排序的分类器：tree 为 Eytzinger 布局（下标从1开始），
+// splitters 为有序分割元素，末尾重复最大值补齐到 leaves 个；
+// 并行样本排序与线性时间排序中的样本桶排序共用
+template <typename T, typename Less> struct SampleClassifier {
+  size_t levels, leaves;
+  std::vector<T> tree, splitters;
+  Less less;
+
+  size_t num_buckets() const { return 2 * leaves - 1; }
+
+  // 偶数桶为分割元素之间的开区间，奇数桶 2j+1 只含等价于 splitters[j] 的元素
+  size_t bucket(const T &x) const {
+    size_t i = 1;
+    for (size_t l = 0; l < levels; ++l) {
+      i = 2 * i + less(tree[i], x);
+    }
+    size_t j = i - leaves; // 小于 x 的分割元素个数
+    return 2 * j + equal_to_splitter(x, j);
+  }
+
+  // 一批元素交错下降，隐藏比较的延迟
+  template <size_t kBatch> void bucket_batch(const T *x, size_t *out) const {
+    size_t index[kBatch];
+    for (size_t e = 0; e < kBatch; ++e) {
+      index[e] = 1;
+    }
+    for (size_t l = 0; l < levels; ++l) {
+      for (size_t e = 0; e < kBatch; ++e) {
+        index[e] = 2 * index[e] + less(tree[index[e]], x[e]);
+      }
+    }
+    for (size_t e = 0; e < kBatch; ++e) {
+      size_t j = index[e] - leaves;
+      out[e] = 2 * j + equal_to_splitter(x[e], j);
+    }
+  }
+
+  // j < leaves-1 时 x ≤ splitters[j]，不小于即相等；j = leaves-1 时 x 大于
+  // 所有分割元素，末尾补齐的那个不算
+  bool equal_to_splitter(const T &x, size_t j) const {
+    return !less(x, splitters[j]) & (j + 1 < leaves);
+  }
+
+  void build_tree(size_t node, size_t &next) {
+    if (node >= leaves)
+      return;
+    build_tree(2 * node, next);
+    tree[node] = splitters[next++];
+    build_tree(2 * node + 1, next);
+  }
+};
+
+} // namespace sample_sort_detail
+
 /**
  * @brief 多线程算法实现
  *
@@ -26,11 +91,17 @@ namespace algorithms {
  * - 多线程快速排序
  * - 线程池实现
  * - 并行前缀和
+ *
+ * 并行算法运行在工作窃取调度器（work_stealing_scheduler.h）上，
+ * 按spawn/sync方式表达；ThreadPool保留给返回future的粗粒度独立任务。
  */
 class MultithreadedAlgorithms {
 public:
   /**
    * @brief 线程池类
+   *
+   * 单队列、单互斥锁，每个任务一次堆分配：适合少量粗粒度的独立任务。
+   * 细粒度的fork-join并行请使用WorkStealingScheduler。
    */
   class ThreadPool {
   private:
@@ -119,67 +190,71 @@ public:
   /**
    * @brief 多线程矩阵乘法 - 算法导论第27.1节
    *
-   * 使用分治法的多线程矩阵乘法
+   * 按行分块并行，每个线程对自己的行块调用分块SIMD内核（gemm_kernel.h），
+   * 与 Matrix::operator* 共用同一内核
    *
    * @param A 第一个矩阵
    * @param B 第二个矩阵
    * @param num_threads 线程数量
-   * @return 乘积矩阵
+   * @return 乘积矩阵（行主序）
    */
-  static std::vector<std::vector<double>> multithreaded_matrix_multiply(
-      const std::vector<std::vector<double>> &A,
-      const std::vector<std::vector<double>> &B,
+  static Matrix multithreaded_matrix_multiply(
+      const Matrix &A, const Matrix &B,
       size_t num_threads = std::thread::hardware_concurrency()) {
-
-    size_t n = A.size();
-    size_t m = B.size();
-    size_t p = B[0].size();
-
-    if (A[0].size() != m) {
+    if (A.get_cols() != B.get_rows()) {
       throw std::invalid_argument("矩阵维度不匹配");
     }
+    if (num_threads == 0) {
+      num_threads = 1;
+    }
 
-    std::vector<std::vector<double>> C(n, std::vector<double>(p, 0.0));
-
-    ThreadPool pool(num_threads);
-    std::vector<std::future<void>> futures;
-
-    // 将矩阵乘法任务分块
-    size_t block_size = (n + num_threads - 1) / num_threads;
+    Matrix a = A.to_layout(MatrixLayout::RowMajor);
+    Matrix b = B.to_layout(MatrixLayout::RowMajor);
 
-    for (size_t thread_id = 0; thread_id < num_threads; ++thread_id) {
-      size_t start_row = thread_id * block_size;
-      size_t end_row = std::min(start_row + block_size, n);
+    size_t n = a.get_rows();
+    size_t m = a.get_cols();
+    size_t p = b.get_cols();
+    Matrix C(n, p);
 
-      if (start_row >= end_row)
-        break;
+    // 每块行数不超过 n/num_threads，由调度器递归二分并行执行
+    size_t block_size = std::max<size_t>(1, (n + num_threads - 1) / num_threads);
+    WorkStealingScheduler scheduler(num_threads);
+    scheduler.parallel_for(0, n, block_size, [&](size_t start_row,
+                                                 size_t end_row) {
+      GemmKernel::gemm(end_row - start_row, p, m, a.raw_data() + start_row * m,
+                       m, b.raw_data(), p, C.raw_data() + start_row * p, p);
+    });
 
-      futures.emplace_back(
-          pool.enqueue([&A, &B, &C, start_row, end_row, n, m, p] {
-            for (size_t i = start_row; i < end_row; ++i) {
-              for (size_t j = 0; j < p; ++j) {
-                double sum = 0.0;
-                for (size_t k = 0; k < m; ++k) {
-                  sum += A[i][k] * B[k][j];
-                }
-                C[i][j] = sum;
-              }
-            }
-          }));
-    }
+    return C;
+  }
 
-    // 等待所有任务完成
-    for (auto &future : futures) {
-      future.get();
+  /**
+   * @brief 多线程矩阵乘法（嵌套vector接口）
+   *
+   * @param A 第一个矩阵
+   * @param B 第二个矩阵
+   * @param num_threads 线程数量
+   * @return 乘积矩阵
+   */
+  static std::vector<std::vector<double>> multithreaded_matrix_multiply(
+      const std::vector<std::vector<double>> &A,
+      const std::vector<std::vector<double>> &B,
+      size_t num_threads = std::thread::hardware_concurrency()) {
+    if (A.empty() || B.empty() || A[0].size() != B.size()) {
+      throw std::invalid_argument("矩阵维度不匹配");
     }
 
-    return C;
+    return multithreaded_matrix_multiply(Matrix(A), Matrix(B), num_threads)
+        .to_vector();
   }
 
   /**
-   * @brief 多线程归并排序 - 算法导论第27.3节
+   * @brief 多线程归并排序 - 算法导论第27.3节（P-MERGE-SORT）
    *
-   * 使用分治法的多线程归并排序
+   * 两个子问题用spawn/sync并行递归，合并步骤使用P-MERGE：
+   * 取较长段的中位数，在较短段中二分查找分割点，两侧子合并并行进行。
+   * 工作量 Θ(n lg n)，跨度 Θ(lg^3 n)。
+   * 原数组与一个辅助数组交替作为每层的输入和输出，不需要拷回。
    *
    * @param arr 待排序数组
    * @param num_threads 线程数量
@@ -190,81 +265,61 @@ public:
     if (arr.size() <= 1)
       return;
 
-    ThreadPool pool(num_threads);
-    std::atomic<size_t> active_tasks{0};
-    std::mutex task_mutex;
-    std::condition_variable task_cv;
-
-    // 递归排序函数
-    std::function<void(size_t, size_t)> sort_range = [&](size_t left,
-                                                         size_t right) {
-      if (left >= right)
-        return;
-
-      size_t mid = left + (right - left) / 2;
-
-      // 使用更保守的阈值控制，避免递归深度过大
-      if (right - left > 5000 && active_tasks.load() < num_threads * 2) {
-        {
-          std::unique_lock<std::mutex> lock(task_mutex);
-          active_tasks += 2;
-        }
-
-        auto left_future = pool.enqueue([&, left, mid] {
-          sort_range(left, mid);
-          {
-            std::unique_lock<std::mutex> lock(task_mutex);
-            active_tasks--;
-          }
-          task_cv.notify_one();
-        });
-
-        auto right_future = pool.enqueue([&, mid, right] {
-          sort_range(mid + 1, right);
-          {
-            std::unique_lock<std::mutex> lock(task_mutex);
-            active_tasks--;
-          }
-          task_cv.notify_one();
-        });
-
-        left_future.get();
-        right_future.get();
-      } else {
-        // 串行执行，避免死锁
-        sort_range(left, mid);
-        sort_range(mid + 1, right);
-      }
-
-      // 合并两个有序子数组
-      std::vector<int> temp(right - left + 1);
-      size_t i = left, j = mid + 1, k = 0;
-
-      while (i <= mid && j <= right) {
-        if (arr[i] <= arr[j]) {
-          temp[k++] = arr[i++];
-        } else {
-          temp[k++] = arr[j++];
-        }
-      }
+    WorkStealingScheduler scheduler(num_threads);
+    std::vector<int> temp(arr.size());
+    scheduler.run([&] {
+      parallel_merge_sort(arr.data(), temp.data(), 0, arr.size(), false);
+    });
+  }
 
-      while (i <= mid)
-        temp[k++] = arr[i++];
-      while (j <= right)
-        temp[k++] = arr[j++];
+  /**
+   * @brief 并行合并 - 算法导论第27.3节（P-MERGE）
+   *
+   * 把有序段 src[p1, r1) 与 src[p2, r2) 合并到 dst[p3, ...)，
+   * 必须在调度器的run()中调用才会并行，否则退化为串行递归
+   */
+  static void parallel_merge(const int *src, size_t p1, size_t r1, size_t p2,
+                             size_t r2, int *dst, size_t p3) {
+    size_t n1 = r1 - p1, n2 = r2 - p2;
+    if (n1 < n2) {
+      std::swap(p1, p2);
+      std::swap(r1, r2);
+      std::swap(n1, n2);
+    }
+    if (n1 == 0)
+      return;
+    if (n1 + n2 <= kMergeGrain) {
+      std::merge(src + p1, src + r1, src + p2, src + r2, dst + p3);
+      return;
+    }
 
-      for (size_t idx = 0; idx < k; ++idx) {
-        arr[left + idx] = temp[idx];
-      }
-    };
+    size_t q1 = p1 + n1 / 2;
+    size_t q2 = std::lower_bound(src + p2, src + r2, src[q1]) - src;
+    size_t q3 = p3 + (q1 - p1) + (q2 - p2);
+    dst[q3] = src[q1];
 
-    sort_range(0, arr.size() - 1);
+    WorkStealingScheduler::TaskGroup group;
+    group.spawn([=] { parallel_merge(src, p1, q1, p2, q2, dst, p3); });
+    parallel_merge(src, q1 + 1, r1, q2, r2, dst, q3 + 1);
+    group.sync();
   }
 
   /**
-   * @brief 多线程快速排序 - 算法导论第27.3节
+   * @brief 多线程快速排序 - 算法导论第27.3节（原地并行样本排序）
    *
-   * 使用分治法的多线程快速排序
+   * 快速排序先串行划分 n 个元素，跨度至少 Θ(n)。这里改为IPS4o式的
+   * 原地样本排序，每一层都是并行的多路划分：
+   * 1. 随机取 α·k 个样本排序，等距取 k-1 个分割元素，按Eytzinger布局
+   *    存成隐式二叉搜索树，分类时每层只用一次比较和加法，没有分支；
+   *    每个分割元素另有一个“相等桶”，大量重复元素不会反复递归
+   * 2. 局部分类：每个条带一个任务，元素先放进各桶 B 个元素的缓冲区，
+   *    缓冲区满了就整块写回本条带前部（写指针不会超过读指针）
+   * 3. 块置换：各桶的块区间按全局计数对齐到 B，任务从桶的读指针取块、
+   *    写到目标桶的写指针处，目标位置上还没处理的块换出来继续放
+   * 4. 收尾：把越过桶边界的部分和各缓冲区剩余元素填进桶首尾的空位
+   * 5. 各桶作为独立任务递归；分到的线程份额不足一个时改用串行内省排序
+   *
+   * 每个条带的缓冲区约为 2√n 个元素（k·B ≈ √n），额外空间 O(p·√n)。
    *
    * @param arr 待排序数组
    * @param num_threads 线程数量
@@ -275,73 +330,31 @@ public:
     if (arr.size() <= 1)
       return;
 
-    ThreadPool pool(num_threads);
-    std::atomic<size_t> active_tasks{0};
-    std::mutex task_mutex;
-    std::condition_variable task_cv;
-
-    // 递归排序函数
-    std::function<void(size_t, size_t)> quick_sort_range = [&](size_t low,
-                                                               size_t high) {
-      if (low >= high)
-        return;
-
-      // 选择最后一个元素作为枢轴
-      int pivot = arr[high];
-      size_t i = low;
-
-      for (size_t j = low; j < high; ++j) {
-        if (arr[j] <= pivot) {
-          std::swap(arr[i], arr[j]);
-          ++i;
-        }
-      }
-
-      std::swap(arr[i], arr[high]);
-
-      size_t pivot_index = i;
-
-      // 并行处理左右子数组
-      if (high - low > 5000 && active_tasks.load() < num_threads * 2) {
-        {
-          std::unique_lock<std::mutex> lock(task_mutex);
-          active_tasks += 2;
-        }
-
-        auto left_future = pool.enqueue([&, low, pivot_index] {
-          quick_sort_range(low, pivot_index - 1);
-          {
-            std::unique_lock<std::mutex> lock(task_mutex);
-            active_tasks--;
-          }
-          task_cv.notify_one();
-        });
-
-        auto right_future = pool.enqueue([&, pivot_index, high] {
-          quick_sort_range(pivot_index + 1, high);
-          {
-            std::unique_lock<std::mutex> lock(task_mutex);
-            active_tasks--;
-          }
-          task_cv.notify_one();
-        });
-
-        left_future.get();
-        right_future.get();
-      } else {
-        // 串行执行，避免死锁
-        quick_sort_range(low, pivot_index - 1);
-        quick_sort_range(pivot_index + 1, high);
-      }
-    };
+    WorkStealingScheduler scheduler(num_threads);
+    parallel_sort(scheduler, arr.data(), arr.data() + arr.size());
+  }
 
-    quick_sort_range(0, arr.size() - 1);
+  /**
+   * @brief 对任意类型的连续区间 [first, last) 做并行样本排序
+   *
+   * 算法同 multithreaded_quick_sort，less 为严格弱序；可以复用同一个调度器
+   * 排序多个区间（外部排序的各个顺串就是这样做的）。
+   */
+  template <typename T, typename Less = std::less<T>>
+  static void parallel_sort(WorkStealingScheduler &scheduler, T *first,
+                            T *last, Less less = Less()) {
+    if (last - first <= 1)
+      return;
+    scheduler.run([&] {
+      sample_sort(scheduler, first, static_cast<size_t>(last - first),
+                  scheduler.get_num_threads(), less);
+    });
   }
 
   /**
    * @brief 并行前缀和 - 算法导论第27.2节
    *
-   * 使用多线程计算前缀和
+   * 拷贝输入后调用 parallel_inclusive_scan
    *
    * @param arr 输入数组
    * @param num_threads 线程数量
@@ -350,77 +363,43 @@ public:
   static std::vector<int> parallel_prefix_sum(
       const std::vector<int> &arr,
       size_t num_threads = std::thread::hardware_concurrency()) {
-    if (arr.empty())
-      return {};
-
-    size_t n = arr.size();
-    std::vector<int> prefix_sum(n);
-
-    if (n <= 1) {
-      if (n == 1)
-        prefix_sum[0] = arr[0];
-      return prefix_sum;
-    }
-
-    ThreadPool pool(num_threads);
-
-    // 第一步：计算每个块的前缀和
-    size_t block_size = (n + num_threads - 1) / num_threads;
-    std::vector<int> block_sums(num_threads, 0);
-    std::vector<std::future<void>> futures;
-
-    for (size_t thread_id = 0; thread_id < num_threads; ++thread_id) {
-      size_t start = thread_id * block_size;
-      size_t end = std::min(start + block_size, n);
-
-      if (start >= end)
-        break;
-
-      futures.emplace_back(
-          pool.enqueue([&arr, &prefix_sum, &block_sums, thread_id, start, end] {
-            int sum = 0;
-            for (size_t i = start; i < end; ++i) {
-              sum += arr[i];
-              prefix_sum[i] = sum;
-            }
-            block_sums[thread_id] = sum;
-          }));
-    }
-
-    for (auto &future : futures) {
-      future.get();
-    }
-
-    // 第二步：计算块的前缀和
-    for (size_t i = 1; i < num_threads; ++i) {
-      block_sums[i] += block_sums[i - 1];
-    }
-
-    // 第三步：将块的前缀和加到每个块的元素上
-    futures.clear();
-
-    for (size_t thread_id = 1; thread_id < num_threads; ++thread_id) {
-      size_t start = thread_id * block_size;
-      size_t end = std::min(start + block_size, n);
-
-      if (start >= end)
-        break;
-
-      int block_prefix = block_sums[thread_id - 1];
-
-      futures.emplace_back(
-          pool.enqueue([&prefix_sum, block_prefix, start, end] {
-            for (size_t i = start; i < end; ++i) {
-              prefix_sum[i] += block_prefix;
-            }
-          }));
+    std::vector<int> prefix_sum(arr);
+    if (prefix_sum.size() > 1) {
+      WorkStealingScheduler scheduler(num_threads);
+      parallel_inclusive_scan(scheduler, prefix_sum.data(), prefix_sum.size());
     }
+    return prefix_sum;
+  }
 
-    for (auto &future : futures) {
-      future.get();
-    }
+  /**
+   * @brief 原地并行包含扫描：data[i] = data[0] op ... op data[i]
+   *
+   * 两遍分块算法：先并行归约每个块，再串行扫描块和（至多kMaxScanBlocks个，
+   * 放在栈上），最后以块偏移为初值并行扫描各块。不分配堆内存，
+   * 可以作为流压缩、基数排序直方图等的基本步骤反复调用。
+   * op需满足结合律；32位整数加法的块内扫描使用AVX2寄存器内前缀和。
+   *
+   * @param scheduler 执行并行步骤的调度器
+   * @param data 数据（原地改写）
+   * @param n 元素个数
+   * @param op 结合的二元运算
+   */
+  template <typename T, typename Op = std::plus<T>>
+  static void parallel_inclusive_scan(WorkStealingScheduler &scheduler,
+                                      T *data, size_t n, Op op = Op()) {
+    parallel_scan<T>(scheduler, data, n, nullptr, op);
+  }
 
-    return prefix_sum;
+  /**
+   * @brief 原地并行排除扫描：data[i] = identity op data[0] op ... op data[i-1]
+   *
+   * @param identity op的单位元（加法为0）
+   */
+  template <typename T, typename Op = std::plus<T>>
+  static void parallel_exclusive_scan(WorkStealingScheduler &scheduler,
+                                      T *data, size_t n, T identity = T(),
+                                      Op op = Op()) {
+    parallel_scan(scheduler, data, n, &identity, op);
   }
 
   /**
@@ -449,24 +428,18 @@ public:
   }
 
   /**
-   * @brief 生成随机数组
+   * @brief 生成随机数组（[min_val, max_val] 内均匀分布，同一种子结果相同）
    * @param size 数组大小
    * @param min_val 最小值
    * @param max_val 最大值
+   * @param seed 随机数种子
    * @return 随机数组
    */
-  static std::vector<int> generate_random_array(size_t size, int min_val = 0,
-                                                int max_val = 100) {
-    std::vector<int> arr(size);
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<int> dis(min_val, max_val);
-
-    for (size_t i = 0; i < size; ++i) {
-      arr[i] = dis(gen);
-    }
-
-    return arr;
+  static std::vector<int>
+  generate_random_array(size_t size, int min_val = 0, int max_val = 100,
+                        uint64_t seed = WorkloadGenerator::kDefaultSeed) {
+    return WorkloadGenerator(seed).generate(Distribution::kUniform, size,
+                                            min_val, max_val);
   }
 
   /**
@@ -540,6 +513,445 @@ public:
 
     return true;
   }
+
+private:
+  // 扫描的最大块数（块和数组放在栈上）与每块最少元素数
+  static constexpr size_t kMaxScanBlocks = 256;
+  static constexpr size_t kMinScanBlock = 16384;
+
+  // identity为空表示包含扫描，否则为排除扫描的初值
+  template <typename T, typename Op>
+  static void parallel_scan(WorkStealingScheduler &scheduler, T *data,
+                            size_t n, const T *identity, Op op) {
+    if (n == 0)
+      return;
+
+    size_t num_blocks =
+        std::min({kMaxScanBlocks, scheduler.get_num_threads() * 4,
+                  (n + kMinScanBlock - 1) / kMinScanBlock});
+    if (num_blocks <= 1) {
+      scan_block(data, n, identity, op, identity != nullptr);
+      return;
+    }
+    size_t block_size = (n + num_blocks - 1) / num_blocks;
+    num_blocks = (n + block_size - 1) / block_size;
+
+    // 第一遍：各块归约（最后一块的和不需要）
+    T block_sums[kMaxScanBlocks];
+    scheduler.parallel_for(0, num_blocks - 1, 1, [&](size_t lo, size_t hi) {
+      for (size_t block = lo; block < hi; ++block) {
+        const T *begin = data + block * block_size;
+        T sum = begin[0];
+        for (size_t i = 1; i < block_size; ++i)
+          sum = op(sum, begin[i]);
+        block_sums[block] = sum;
+      }
+    });
+
+    // 块和的排除扫描，得到每块的初值
+    T block_offsets[kMaxScanBlocks];
+    if (identity) {
+      block_offsets[0] = *identity;
+      for (size_t b = 1; b < num_blocks; ++b)
+        block_offsets[b] = op(block_offsets[b - 1], block_sums[b - 1]);
+    } else if (num_blocks > 1) {
+      block_offsets[1] = block_sums[0];
+      for (size_t b = 2; b < num_blocks; ++b)
+        block_offsets[b] = op(block_offsets[b - 1], block_sums[b - 1]);
+    }
+
+    // 第二遍：以块偏移为初值扫描各块（包含扫描的第0块没有初值）
+    scheduler.parallel_for(0, num_blocks, 1, [&](size_t lo, size_t hi) {
+      for (size_t block = lo; block < hi; ++block) {
+        size_t start = block * block_size;
+        size_t len = std::min(block_size, n - start);
+        const T *carry =
+            (identity || block > 0) ? &block_offsets[block] : nullptr;
+        scan_block(data + start, len, carry, op, identity != nullptr);
+      }
+    });
+  }
+
+  template <typename T, typename Op> static constexpr bool simd_plus_scan() {
+    bool is_plus = std::is_same_v<Op, std::plus<T>> ||
+                   std::is_same_v<Op, std::plus<>>;
+    return is_plus && std::is_integral_v<T> && sizeof(T) == 4;
+  }
+
+  // 串行扫描一个块；carry为空时从data[0]开始（仅包含扫描）
+  template <typename T, typename Op>
+  static void scan_block(T *data, size_t n, const T *carry, Op op,
+                         bool exclusive) {
+    if (n == 0)
+      return;
+#ifdef ALGORITHMS_GEMM_X86
+    if constexpr (simd_plus_scan<T, Op>()) {
+      if (CpuFeatures::avx2()) {
+        uint32_t c = carry ? static_cast<uint32_t>(*carry) : 0;
+        scan_plus_avx2(reinterpret_cast<uint32_t *>(data), n, c, exclusive);
+        return;
+      }
+    }
+#endif
+
+    size_t i = 0;
+    T acc;
+    if (carry) {
+      acc = *carry;
+    } else {
+      acc = data[0];
+      i = 1;
+    }
+    if (exclusive) {
+      for (; i < n; ++i) {
+        T value = data[i];
+        data[i] = acc;
+        acc = op(acc, value);
+      }
+    } else {
+      for (; i < n; ++i) {
+        acc = op(acc, data[i]);
+        data[i] = acc;
+      }
+    }
+  }
+
+#ifdef ALGORITHMS_GEMM_X86
+  // 每次处理8个元素：128位通道内两步移位相加，再把低通道总和加到高通道
+  __attribute__((target("avx2"))) static void
+  scan_plus_avx2(uint32_t *data, size_t n, uint32_t carry, bool exclusive) {
+    __m256i c = _mm256_set1_epi32(static_cast<int>(carry));
+    const __m256i last = _mm256_set1_epi32(7);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<__m256i *>(data + i));
+      __m256i x = _mm256_add_epi32(v, _mm256_slli_si256(v, 4));
+      x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+      __m256i low_total = _mm256_shuffle_epi32(x, 0xFF);
+      low_total = _mm256_permute2x128_si256(low_total, low_total, 0x08);
+      x = _mm256_add_epi32(_mm256_add_epi32(x, low_total), c);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(data + i),
+                          exclusive ? _mm256_sub_epi32(x, v) : x);
+      c = _mm256_permutevar8x32_epi32(x, last);
+    }
+
+    uint32_t acc = static_cast<uint32_t>(_mm256_cvtsi256_si32(c));
+    for (; i < n; ++i) {
+      uint32_t value = data[i];
+      acc += value;
+      data[i] = exclusive ? acc - value : acc;
+    }
+  }
+#endif
+
+  // 子问题规模超过该值时才spawn
+  static constexpr size_t kSpawnThreshold = 5000;
+  // P-MERGE中两段总长不超过该值时串行合并
+  static constexpr size_t kMergeGrain = 8192;
+
+  // 对arr[left, right)排序，结果写入 to_temp ? temp : arr
+  static void parallel_merge_sort(int *arr, int *temp, size_t left,
+                                  size_t right, bool to_temp) {
+    if (right - left <= kSpawnThreshold) {
+      merge_sort_range(arr, temp, left, right);
+      if (to_temp)
+        std::copy(arr + left, arr + right, temp + left);
+      return;
+    }
+
+    // 子问题的结果写到另一个数组，本层再从那里合并回来
+    size_t mid = left + (right - left) / 2;
+    WorkStealingScheduler::TaskGroup group;
+    group.spawn(
+        [=] { parallel_merge_sort(arr, temp, left, mid, !to_temp); });
+    parallel_merge_sort(arr, temp, mid, right, !to_temp);
+    group.sync();
+
+    const int *src = to_temp ? arr : temp;
+    int *dst = to_temp ? temp : arr;
+    parallel_merge(src, left, mid, mid, right, dst, left);
+  }
+
+  // 串行归并排序[left, right)，temp为同样大小的辅助数组
+  static void merge_sort_range(int *arr, int *temp, size_t left,
+                               size_t right) {
+    if (right - left <= 1)
+      return;
+
+    size_t mid = left + (right - left) / 2;
+    merge_sort_range(arr, temp, left, mid);
+    merge_sort_range(arr, temp, mid, right);
+
+    // 合并两个有序子数组
+    size_t i = left, j = mid, k = left;
+    while (i < mid && j < right) {
+      temp[k++] = arr[i] <= arr[j] ? arr[i++] : arr[j++];
+    }
+    while (i < mid)
+      temp[k++] = arr[i++];
+    while (j < right)
+      temp[k++] = arr[j++];
+    std::copy(temp + left, temp + right, arr + left);
+  }
+
+  static constexpr size_t kSampleBlock = 64;  // 块置换的块大小 B
+  static constexpr size_t kMaxTreeLevels = 7; // 最多 2^7 个区间
+  // 规模小于该值或只分到一个线程时直接串行内省排序
+  static constexpr size_t kSampleSortThreshold = 1 << 16;
+
+  template <typename T, typename Less>
+  using SampleClassifier = sample_sort_detail::SampleClassifier<T, Less>;
+
+  // 局部分类后一个条带的状态
+  template <typename T> struct SampleStripe {
+    std::vector<T> buffer;     // 各桶的缓冲区，每桶 B 个
+    std::vector<size_t> fill;  // 各缓冲区中剩余的元素数
+    std::vector<size_t> count; // 本条带各桶元素总数
+    size_t flushed_end = 0;    // 写回的整块占据 [条带起点, flushed_end)
+  };
+
+  // 块置换中一个桶的指针（以块为单位）：[write, read_end) 为尚未处理的块
+  struct SampleBucketPointers {
+    size_t write = 0, read_end = 0;
+    std::mutex lock;
+  };
+
+  template <typename T, typename Less>
+  static void sample_sort(WorkStealingScheduler &scheduler, T *a, size_t n,
+                          size_t stripes, const Less &less) {
+    if (stripes <= 1 || n < kSampleSortThreshold) {
+      if constexpr (std::is_same_v<Less, std::less<T>>) {
+        QuickSortGeneric<T>::introsort(a, a + n);
+      } else {
+        // QuickSortGeneric 的比较函数表示“可以排在前面”（≤）
+        QuickSortGeneric<T>::introsort(
+            a, a + n, [&less](const T &x, const T &y) { return !less(y, x); });
+      }
+      return;
+    }
+    constexpr size_t B = kSampleBlock;
+    const SampleClassifier<T, Less> classifier = build_classifier(a, n, less);
+    const size_t buckets = classifier.num_buckets();
+
+    // 局部分类：条带长度为 B 的倍数
+    const size_t stripe_length = ((n + stripes - 1) / stripes + B - 1) / B * B;
+    stripes = (n + stripe_length - 1) / stripe_length;
+    std::vector<SampleStripe<T>> local(stripes);
+    scheduler.parallel_for(0, stripes, 1, [&](size_t lo, size_t hi) {
+      for (size_t t = lo; t < hi; ++t) {
+        classify_stripe(a, t * stripe_length,
+                        std::min(n, (t + 1) * stripe_length), classifier,
+                        local[t]);
+      }
+    });
+
+    // 桶的起点 start[i]，块区间起点 aligned[i] 为 start[i] 向上取整到 B
+    std::vector<size_t> start(buckets + 1, 0), aligned(buckets + 1);
+    for (size_t i = 0; i < buckets; ++i) {
+      size_t total = 0;
+      for (const SampleStripe<T> &stripe : local) {
+        total += stripe.count[i];
+      }
+      start[i + 1] = start[i] + total;
+    }
+    for (size_t i = 0; i <= buckets; ++i) {
+      aligned[i] = (start[i] + B - 1) / B * B;
+    }
+
+    // 空块移动：每个桶的块区间内把整块挪到前部
+    const size_t whole_blocks = n / B;
+    auto is_full = [&](size_t block) {
+      return block * B < local[block * B / stripe_length].flushed_end;
+    };
+    std::vector<SampleBucketPointers> pointers(buckets);
+    scheduler.parallel_for(0, buckets, 1, [&](size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; ++i) {
+        size_t first = aligned[i] / B;
+        size_t last = std::max(first, std::min(aligned[i + 1] / B, whole_blocks));
+        size_t l = first, r = last;
+        while (true) {
+          while (l < r && is_full(l))
+            ++l;
+          while (l < r && !is_full(r - 1))
+            --r;
+          if (l >= r)
+            break;
+          std::copy(a + (r - 1) * B, a + r * B, a + l * B);
+          ++l;
+          --r;
+        }
+        pointers[i].write = first;
+        pointers[i].read_end = l;
+      }
+    });
+
+    // 块置换：每个任务从不同的桶开始取块
+    std::vector<T> overflow(B);
+    size_t overflow_bucket = buckets;
+    scheduler.parallel_for(0, stripes, 1, [&](size_t lo, size_t hi) {
+      for (size_t t = lo; t < hi; ++t) {
+        permute_blocks(a, n, classifier, pointers, t * buckets / stripes,
+                       overflow, overflow_bucket);
+      }
+    });
+
+    // 收尾：先保存越过桶末尾的部分（它们占着后面桶的首部空位），再填空位
+    std::vector<size_t> placed_end(buckets);
+    std::vector<std::vector<T>> spill(buckets);
+    for (size_t i = 0; i < buckets; ++i) {
+      placed_end[i] = pointers[i].write * B - (i == overflow_bucket ? B : 0);
+      size_t from = std::max(aligned[i], start[i + 1]);
+      if (placed_end[i] > from) {
+        spill[i].assign(a + from, a + placed_end[i]);
+      }
+    }
+    scheduler.parallel_for(0, buckets, 1, [&](size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; ++i) {
+        // 空位为 [start, min(aligned, 桶末尾)) 与 [placed_end, 桶末尾)
+        size_t head_end = std::min(aligned[i], start[i + 1]);
+        size_t position = start[i];
+        auto emit = [&](const T *source, size_t length) {
+          for (size_t k = 0; k < length; ++k) {
+            if (position == head_end)
+              position = std::max(placed_end[i], head_end);
+            a[position++] = source[k];
+          }
+        };
+        emit(spill[i].data(), spill[i].size());
+        if (i == overflow_bucket)
+          emit(overflow.data(), B);
+        for (const SampleStripe<T> &stripe : local) {
+          emit(stripe.buffer.data() + i * B, stripe.fill[i]);
+        }
+      }
+    });
+
+    // 递归：相等桶已经有序，其余桶按规模分到线程份额
+    scheduler.parallel_for(0, buckets, 1, [&](size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; ++i) {
+        size_t size = start[i + 1] - start[i];
+        if (i % 2 == 0 && size > 1) {
+          sample_sort(scheduler, a + start[i], size, stripes * size / n, less);
+        }
+      }
+    });
+  }
+
+  // 取样确定分割元素；k = 2^levels 满足 k·B ≤ √n
+  template <typename T, typename Less>
+  static SampleClassifier<T, Less> build_classifier(T *a, size_t n,
+                                                    const Less &less) {
+    SampleClassifier<T, Less> classifier{0, 0, {}, {}, less};
+    classifier.levels = 1;
+    while (classifier.levels < kMaxTreeLevels &&
+           (size_t(2) << classifier.levels) * kSampleBlock *
+                   (size_t(2) << classifier.levels) * kSampleBlock <=
+               n) {
+      ++classifier.levels;
+    }
+    classifier.leaves = size_t(1) << classifier.levels;
+    size_t oversampling =
+        std::max<size_t>(1, static_cast<size_t>(0.2 * std::log2(n)));
+    size_t sample = classifier.leaves * oversampling;
+    // 随机样本换到数组前部（它们之后照常参与分类）
+    std::mt19937_64 gen(n);
+    for (size_t i = 0; i < sample; ++i) {
+      std::swap(a[i], a[i + gen() % (n - i)]);
+    }
+    std::sort(a, a + sample, less);
+    classifier.splitters.resize(classifier.leaves);
+    for (size_t j = 0; j + 1 < classifier.leaves; ++j) {
+      classifier.splitters[j] = a[(j + 1) * oversampling - 1];
+    }
+    classifier.splitters.back() = classifier.splitters[classifier.leaves - 2];
+    classifier.tree.resize(classifier.leaves);
+    size_t next = 0;
+    classifier.build_tree(1, next);
+    return classifier;
+  }
+
+  template <typename T, typename Less>
+  static void classify_stripe(T *a, size_t begin, size_t end,
+                              const SampleClassifier<T, Less> &classifier,
+                              SampleStripe<T> &stripe) {
+    constexpr size_t B = kSampleBlock;
+    constexpr size_t kBatch = 16; // 一批元素交错下降，隐藏比较的延迟
+    const size_t buckets = classifier.num_buckets();
+    stripe.buffer.resize(buckets * B);
+    stripe.fill.assign(buckets, 0);
+    stripe.count.assign(buckets, 0);
+    size_t write = begin;
+    auto push = [&](size_t b, const T &x) {
+      stripe.buffer[b * B + stripe.fill[b]] = x;
+      if (++stripe.fill[b] == B) {
+        std::copy(stripe.buffer.data() + b * B,
+                  stripe.buffer.data() + (b + 1) * B, a + write);
+        write += B;
+        stripe.fill[b] = 0;
+        stripe.count[b] += B;
+      }
+    };
+    size_t i = begin;
+    for (; i + kBatch <= end; i += kBatch) {
+      size_t index[kBatch];
+      classifier.template bucket_batch<kBatch>(a + i, index);
+      for (size_t e = 0; e < kBatch; ++e) {
+        push(index[e], a[i + e]);
+      }
+    }
+    for (; i < end; ++i) {
+      push(classifier.bucket(a[i]), a[i]);
+    }
+    for (size_t b = 0; b < buckets; ++b) {
+      stripe.count[b] += stripe.fill[b];
+    }
+    stripe.flushed_end = write;
+  }
+
+  template <typename T, typename Less>
+  static void permute_blocks(T *a, size_t n,
+                             const SampleClassifier<T, Less> &classifier,
+                             std::vector<SampleBucketPointers> &pointers,
+                             size_t first_bucket, std::vector<T> &overflow,
+                             size_t &overflow_bucket) {
+    constexpr size_t B = kSampleBlock;
+    const size_t buckets = pointers.size();
+    std::vector<T> hand(B), swap_buffer(B);
+    for (size_t step = 0; step < buckets; ++step) {
+      SampleBucketPointers &source = pointers[(first_bucket + step) % buckets];
+      while (true) {
+        {
+          std::lock_guard<std::mutex> guard(source.lock);
+          if (source.write >= source.read_end)
+            break;
+          --source.read_end;
+          std::copy(a + source.read_end * B, a + (source.read_end + 1) * B,
+                    hand.begin());
+        }
+        // 手里的块一直放到一个空位为止
+        while (true) {
+          size_t target = classifier.bucket(hand[0]);
+          SampleBucketPointers &destination = pointers[target];
+          std::lock_guard<std::mutex> guard(destination.lock);
+          size_t block = destination.write++;
+          if (block < destination.read_end) {
+            std::copy(a + block * B, a + (block + 1) * B, swap_buffer.begin());
+            std::copy(hand.begin(), hand.end(), a + block * B);
+            hand.swap(swap_buffer);
+            continue;
+          }
+          if ((block + 1) * B <= n) {
+            std::copy(hand.begin(), hand.end(), a + block * B);
+          } else {
+            // 跨过数组末尾的块（全局至多一个）
+            std::copy(hand.begin(), hand.end(), overflow.begin());
+            overflow_bucket = target;
+          }
+          break;
+        }
+      }
+    }
+  }
 };
 
 } // namespace algorithms
@@ -1,7 +1,10 @@
 #ifndef NP_COMPLETENESS_H
 #define NP_COMPLETENESS_H
 
+#include "bit_matrix_graph.h"
+#include "sat_solver.h"
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <stdexcept>
 #include <unordered_map>
@@ -35,6 +38,19 @@ public:
 
   int get_vertex_count() const { return vertex_count; }
 
+  // 转换为位矩阵表示（重复的边只保留一条，忽略自环）
+  BitMatrixGraph to_bit_matrix() const {
+    BitMatrixGraph result(vertex_count);
+    for (int u = 0; u < vertex_count; u++) {
+      for (int v : adjacency_list[u]) {
+        if (u < v && !result.has_edge(u, v)) {
+          result.add_edge(u, v);
+        }
+      }
+    }
+    return result;
+  }
+
   void print() const {
     std::cout << "图结构:" << std::endl;
     for (int i = 0; i < vertex_count; i++) {
@@ -77,6 +93,22 @@ public:
     return true;
   }
 
+  /**
+   * @brief 3-SAT（也接受任意CNF）求解：用CDCL求解器找满足赋值
+   * @param formula CNF公式，格式与 verify_3sat 相同
+   * @param assignment 可满足时输出赋值，下标从0开始
+   * @return 公式是否可满足
+   */
+  static bool solve_3sat(const std::vector<std::vector<int>> &formula,
+                         std::vector<bool> &assignment) {
+    SatSolver solver(formula);
+    if (solver.solve() != SatSolver::Result::kSatisfiable) {
+      return false;
+    }
+    assignment = solver.get_model();
+    return true;
+  }
+
   /**
    * @brief 顶点覆盖问题验证器
    * @param graph 图
@@ -103,6 +135,39 @@ public:
     return true;
   }
 
+  /**
+   * @brief 顶点覆盖问题验证器（位矩阵版本）
+   *
+   * 覆盖集合做成位集后，每个不在覆盖中的顶点 u 只需检查
+   * 它的行与覆盖补集的与是否为零，O(n² / 64)。
+   */
+  static bool verify_vertex_cover(const BitMatrixGraph &graph,
+                                  const std::unordered_set<int> &cover, int k) {
+    if (cover.size() != static_cast<size_t>(k)) {
+      return false;
+    }
+    size_t words = graph.get_words_per_row();
+    std::vector<std::uint64_t> outside(words, ~std::uint64_t(0));
+    for (int v : cover) {
+      if (graph.get_node_index(v) == -1) {
+        return false;
+      }
+      outside[v / 64] &= ~(std::uint64_t(1) << (v % 64));
+    }
+    for (size_t u = 0; u < graph.get_node_count(); u++) {
+      if (!((outside[u / 64] >> (u % 64)) & 1)) {
+        continue;
+      }
+      const std::uint64_t *row = graph.row(u);
+      for (size_t w = 0; w < words; w++) {
+        if (row[w] & outside[w]) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
   /**
    * @brief 团问题验证器
    * @param graph 图
@@ -134,6 +199,23 @@ public:
     return true;
   }
 
+  /**
+   * @brief 团问题验证器（位矩阵版本）：每个顶点的行与团的位集做与运算，
+   *        popcount 等于 k - 1 即与其余顶点都相邻
+   */
+  static bool verify_clique(const BitMatrixGraph &graph,
+                            const std::unordered_set<int> &clique, int k) {
+    if (clique.size() != static_cast<size_t>(k)) {
+      return false;
+    }
+    for (int v : clique) {
+      if (graph.get_node_index(v) == -1) {
+        return false;
+      }
+    }
+    return graph.is_clique(std::vector<int>(clique.begin(), clique.end()));
+  }
+
   /**
    * @brief 哈密顿回路问题验证器
    * @param graph 图
@@ -0,0 +1,459 @@
+#ifndef NUMBER_THEORETIC_TRANSFORM_H
+#define NUMBER_THEORETIC_TRANSFORM_H
+
+#include "cpu_features.h"
+#include "gemm_kernel.h"
+#include "number_theory_algorithms.h"
+#include "work_stealing_scheduler.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace algorithms {
+
+/**
+ * @brief 模素数P的数论变换（NTT），用Montgomery乘法做模运算
+ *
+ * NTT是FFT在有限域Z_P上的类比：把复单位根换成P的2^k次单位根，所有运算
+ * 都是精确的整数运算。P必须是形如 c·2^k + 1 的素数，G是它的原根。
+ * - 正变换用Gentleman-Sande（频域抽取）蝶形，输出为位反转顺序；逆变换用
+ *   Cooley-Tukey（时域抽取）蝶形，接受位反转顺序的输入。卷积时点乘与顺序
+ *   无关，因此两次位反转置换都可以省掉。
+ * - 元素以Montgomery形式 xR mod P（R = 2^32）参与运算，模乘只需乘法和移位
+ * - 每一级的旋转因子连续存放：长度为2h的级使用 roots[h, 2h)
+ * - 支持AVX2的CPU上每次做8个蝶形（运行时检测）
+ */
+template <uint32_t P, uint32_t G> class NumberTheoreticTransform {
+  static_assert(P % 2 == 1 && P < (1u << 31),
+                "NTT modulus must be an odd prime below 2^31");
+
+public:
+  static constexpr uint32_t modulus = P;
+
+  // P - 1 中2的幂次，决定最大变换长度 2^max_log
+  static constexpr int max_log = __builtin_ctz(P - 1);
+
+  /**
+   * @brief 为长度n（2的幂）构造变换计划
+   */
+  explicit NumberTheoreticTransform(size_t size) : n(size) {
+    if (n == 0 || (n & (n - 1)) != 0) {
+      throw std::invalid_argument("NTT长度必须是2的幂");
+    }
+    if (n > (size_t(1) << max_log)) {
+      throw std::invalid_argument("NTT长度超过模数支持的最大长度");
+    }
+    roots.resize(std::max<size_t>(n, 2));
+    inverse_roots.resize(std::max<size_t>(n, 2));
+    for (size_t half = 1; half < n; half <<= 1) {
+      // 2·half次单位根 w = G^((P-1)/(2·half))
+      long long w = NumberTheoryAlgorithms::mod_exponentiation(
+          static_cast<long long>(G), static_cast<long long>((P - 1) / (2 * half)),
+          static_cast<long long>(P));
+      long long w_inv = NumberTheoryAlgorithms::mod_inverse(w, P);
+      uint32_t step = to_montgomery(static_cast<uint32_t>(w));
+      uint32_t step_inv = to_montgomery(static_cast<uint32_t>(w_inv));
+      uint32_t current = to_montgomery(1), current_inv = current;
+      for (size_t j = 0; j < half; j++) {
+        roots[half + j] = current;
+        inverse_roots[half + j] = current_inv;
+        current = multiply(current, step);
+        current_inv = multiply(current_inv, step_inv);
+      }
+    }
+    // 逆变换最后乘以 n^{-1}，同时从Montgomery形式转回普通形式
+    n_inverse = static_cast<uint32_t>(NumberTheoryAlgorithms::mod_inverse(
+        static_cast<long long>(n % P), static_cast<long long>(P)));
+  }
+
+  size_t size() const { return n; }
+
+  /**
+   * @brief 正变换：输入为自然顺序的Montgomery形式，输出为位反转顺序
+   *
+   * 频域抽取的每一级之后，长度为2·half的块互相独立：先对整个数组做跨度
+   * 较大的几级，然后逐块（kBlock个元素，常驻缓存）完成剩下的级。
+   */
+  void forward(uint32_t *a) const {
+    size_t half = n / 2;
+    for (; half >= 1 && 2 * half > kBlock; half >>= 1) {
+      forward_level(a, n, half);
+    }
+    size_t block = std::min(n, kBlock);
+    for (size_t begin = 0; begin < n; begin += block) {
+      for (size_t h = half; h >= 1; h >>= 1) {
+        forward_level(a + begin, block, h);
+      }
+    }
+  }
+
+  /**
+   * @brief 逆变换：输入为位反转顺序，输出为自然顺序的普通（非Montgomery）形式
+   */
+  void inverse(uint32_t *a) const {
+    size_t block = std::min(n, kBlock);
+    for (size_t begin = 0; begin < n; begin += block) {
+      for (size_t h = 1; h < block; h <<= 1) {
+        inverse_level(a + begin, block, h);
+      }
+    }
+    for (size_t half = block; half < n; half <<= 1) {
+      inverse_level(a, n, half);
+    }
+    // reduce(xR · n^{-1}) = x · n^{-1}
+    for (size_t i = 0; i < n; i++) {
+      a[i] = multiply(a[i], n_inverse);
+    }
+  }
+
+  /**
+   * @brief 模P循环卷积（结果长度a.size() + b.size() - 1，系数在[0, P)）
+   */
+  static std::vector<uint32_t> convolve(const std::vector<uint32_t> &a,
+                                        const std::vector<uint32_t> &b) {
+    return convolve_reduced(a, b);
+  }
+
+  /**
+   * @brief 同上，但输入为任意64位无符号整数，先对P取模
+   */
+  static std::vector<uint32_t> convolve(const std::vector<uint64_t> &a,
+                                        const std::vector<uint64_t> &b) {
+    return convolve_reduced(a, b);
+  }
+
+  // Montgomery形式转换与模运算，值域均为[0, P)
+  static uint32_t to_montgomery(uint32_t x) { return multiply(x % P, kR2); }
+  static uint32_t from_montgomery(uint32_t x) { return reduce(x); }
+
+  static uint32_t multiply(uint32_t a, uint32_t b) {
+    return reduce(static_cast<uint64_t>(a) * b);
+  }
+  static uint32_t add(uint32_t a, uint32_t b) {
+    uint32_t sum = a + b;
+    return sum >= P ? sum - P : sum;
+  }
+  static uint32_t subtract(uint32_t a, uint32_t b) {
+    return a >= b ? a - b : a + P - b;
+  }
+
+private:
+  static constexpr size_t kBlock = size_t(1) << 14; // 64KB的uint32_t
+
+  void forward_level(uint32_t *a, size_t length, size_t half) const {
+    const uint32_t *w = roots.data() + half;
+    for (size_t block = 0; block < length; block += 2 * half) {
+      uint32_t *x = a + block, *y = a + block + half;
+#ifdef ALGORITHMS_GEMM_X86
+      if (half >= 8 && CpuFeatures::avx2()) {
+        forward_butterflies_avx2(x, y, w, half);
+        continue;
+      }
+#endif
+      for (size_t j = 0; j < half; j++) {
+        uint32_t u = x[j], v = y[j];
+        x[j] = add(u, v);
+        y[j] = multiply(subtract(u, v), w[j]);
+      }
+    }
+  }
+
+  void inverse_level(uint32_t *a, size_t length, size_t half) const {
+    const uint32_t *w = inverse_roots.data() + half;
+    for (size_t block = 0; block < length; block += 2 * half) {
+      uint32_t *x = a + block, *y = a + block + half;
+#ifdef ALGORITHMS_GEMM_X86
+      if (half >= 8 && CpuFeatures::avx2()) {
+        inverse_butterflies_avx2(x, y, w, half);
+        continue;
+      }
+#endif
+      for (size_t j = 0; j < half; j++) {
+        uint32_t u = x[j], v = multiply(y[j], w[j]);
+        x[j] = add(u, v);
+        y[j] = subtract(u, v);
+      }
+    }
+  }
+
+#ifdef ALGORITHMS_GEMM_X86
+  // 8路Montgomery乘法：偶数/奇数下标分别用_mm256_mul_epu32得到64位乘积
+  __attribute__((target("avx2"))) static inline __m256i
+  multiply_avx2(__m256i a, __m256i b) {
+    const __m256i p = _mm256_set1_epi64x(P);
+    const __m256i neg_inverse = _mm256_set1_epi64x(kNegInverse);
+    __m256i even = _mm256_mul_epu32(a, b);
+    __m256i odd =
+        _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    __m256i m_even = _mm256_mul_epu32(even, neg_inverse);
+    __m256i m_odd = _mm256_mul_epu32(odd, neg_inverse);
+    even = _mm256_add_epi64(even, _mm256_mul_epu32(m_even, p));
+    odd = _mm256_add_epi64(odd, _mm256_mul_epu32(m_odd, p));
+    // 取 (t + mP) 的高32位
+    __m256i u = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+    return _mm256_min_epu32(u, _mm256_sub_epi32(u, _mm256_set1_epi32(P)));
+  }
+
+  // a, b < P：和小于2^32，a+b-P在a+b<P时回绕成大数，取较小者即为结果
+  __attribute__((target("avx2"))) static inline __m256i add_avx2(__m256i a,
+                                                                 __m256i b) {
+    __m256i sum = _mm256_add_epi32(a, b);
+    return _mm256_min_epu32(sum, _mm256_sub_epi32(sum, _mm256_set1_epi32(P)));
+  }
+
+  __attribute__((target("avx2"))) static inline __m256i
+  subtract_avx2(__m256i a, __m256i b) {
+    __m256i difference = _mm256_sub_epi32(a, b);
+    return _mm256_min_epu32(difference,
+                            _mm256_add_epi32(difference, _mm256_set1_epi32(P)));
+  }
+
+  __attribute__((target("avx2"))) static void
+  forward_butterflies_avx2(uint32_t *x, uint32_t *y, const uint32_t *w,
+                           size_t half) {
+    for (size_t j = 0; j < half; j += 8) {
+      __m256i u = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(x + j));
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(y + j));
+      __m256i root =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(w + j));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(x + j), add_avx2(u, v));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(y + j),
+                          multiply_avx2(subtract_avx2(u, v), root));
+    }
+  }
+
+  __attribute__((target("avx2"))) static void
+  inverse_butterflies_avx2(uint32_t *x, uint32_t *y, const uint32_t *w,
+                           size_t half) {
+    for (size_t j = 0; j < half; j += 8) {
+      __m256i u = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(x + j));
+      __m256i root =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(w + j));
+      __m256i v = multiply_avx2(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(y + j)), root);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(x + j), add_avx2(u, v));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(y + j),
+                          subtract_avx2(u, v));
+    }
+  }
+#endif
+
+  // P^{-1} mod 2^32（牛顿迭代，每次有效位数翻倍）
+  static constexpr uint32_t inverse_mod_2_32() {
+    uint32_t inverse = P;
+    for (int i = 0; i < 4; i++) {
+      inverse *= 2 - P * inverse;
+    }
+    return inverse;
+  }
+
+  static constexpr uint32_t kNegInverse = 0u - inverse_mod_2_32(); // -P^{-1}
+  static constexpr uint32_t kR2 = static_cast<uint32_t>(
+      (static_cast<unsigned __int128>(1) << 64) % P); // R² mod P
+
+  // Montgomery约简：t < P·2^32 时返回 t·R^{-1} mod P
+  static uint32_t reduce(uint64_t t) {
+    uint32_t m = static_cast<uint32_t>(t) * kNegInverse;
+    uint32_t u = static_cast<uint32_t>((t + static_cast<uint64_t>(m) * P) >> 32);
+    return u >= P ? u - P : u;
+  }
+
+  template <typename T>
+  static std::vector<uint32_t> convolve_reduced(const std::vector<T> &a,
+                                                const std::vector<T> &b) {
+    if (a.empty() || b.empty()) {
+      return {};
+    }
+    size_t result_size = a.size() + b.size() - 1;
+    size_t length = 1;
+    while (length < result_size) {
+      length <<= 1;
+    }
+    NumberTheoreticTransform plan(length);
+    std::vector<uint32_t> fa(length, 0), fb(length, 0);
+    for (size_t i = 0; i < a.size(); i++) {
+      fa[i] = to_montgomery(static_cast<uint32_t>(a[i] % P));
+    }
+    for (size_t i = 0; i < b.size(); i++) {
+      fb[i] = to_montgomery(static_cast<uint32_t>(b[i] % P));
+    }
+    plan.forward(fa.data());
+    plan.forward(fb.data());
+    for (size_t i = 0; i < length; i++) {
+      fa[i] = multiply(fa[i], fb[i]);
+    }
+    plan.inverse(fa.data());
+    fa.resize(result_size);
+    return fa;
+  }
+
+  size_t n;
+  std::vector<uint32_t> roots;
+  std::vector<uint32_t> inverse_roots;
+  uint32_t n_inverse = 1;
+};
+
+// 常用的NTT模数：998244353 = 119·2^23 + 1，原根为3，最大长度2^23
+using NTT998244353 = NumberTheoreticTransform<998244353, 3>;
+
+/**
+ * @brief 基于三个NTT素数与中国剩余定理的精确整数卷积
+ *
+ * 三个素数都小于2^31且P-1含2^25以上的因子，最大结果长度为2^25（约3355万），
+ * 乘积约为2^92.6。只要真实系数小于该乘积，由Garner算法合并的结果就是精确的：
+ * - convolve：64位无符号输入，真实系数小于2^64时结果精确。返回的是真实系数模
+ *   三素数乘积后的低64位：系数在[2^64, 乘积)时等于模2^64的值，不小于乘积时
+ *   既不是真实值也不是模2^64的值
+ * - convolve_mod：任意不超过2^32的模数，只要 长度·(m-1)² < 2^92
+ * - multiply_integers：以base为基的大整数乘法（可作为大整数类型的乘法引擎）
+ * 三个素数上的卷积互相独立，num_threads > 1时并行执行。
+ */
+class ExactConvolution {
+public:
+  using NTT1 = NumberTheoreticTransform<2013265921, 31>; // 15·2^27 + 1
+  using NTT2 = NumberTheoreticTransform<1811939329, 13>; // 27·2^26 + 1
+  using NTT3 = NumberTheoreticTransform<2113929217, 5>;  // 63·2^25 + 1
+
+  static constexpr size_t max_result_size = size_t(1) << 25;
+
+  static std::vector<uint64_t> convolve(const std::vector<uint64_t> &a,
+                                        const std::vector<uint64_t> &b,
+                                        size_t num_threads = 1) {
+    std::vector<uint32_t> r1, r2, r3;
+    convolve_three(a, b, r1, r2, r3, num_threads);
+    std::vector<uint64_t> result(r1.size());
+    for (size_t i = 0; i < result.size(); i++) {
+      result[i] = static_cast<uint64_t>(garner(r1[i], r2[i], r3[i]));
+    }
+    return result;
+  }
+
+  /**
+   * @brief 模m卷积（m ≤ 2^32），系数在[0, m)
+   */
+  static std::vector<uint32_t> convolve_mod(const std::vector<uint32_t> &a,
+                                            const std::vector<uint32_t> &b,
+                                            uint64_t m, size_t num_threads = 1) {
+    if (m == 0 || m > (uint64_t(1) << 32)) {
+      throw std::invalid_argument("模数必须在[1, 2^32]内");
+    }
+    std::vector<uint64_t> a64(a.size()), b64(b.size());
+    for (size_t i = 0; i < a.size(); i++) {
+      a64[i] = a[i] % m;
+    }
+    for (size_t i = 0; i < b.size(); i++) {
+      b64[i] = b[i] % m;
+    }
+    std::vector<uint32_t> r1, r2, r3;
+    convolve_three(a64, b64, r1, r2, r3, num_threads);
+    std::vector<uint32_t> result(r1.size());
+    for (size_t i = 0; i < result.size(); i++) {
+      result[i] = static_cast<uint32_t>(garner(r1[i], r2[i], r3[i]) % m);
+    }
+    return result;
+  }
+
+  /**
+   * @brief 大整数乘法：数字按低位在前存放，每位在[0, base)，base ≤ 2^16
+   * @return 乘积的各位（低位在前，无前导零；乘积为0时返回{0}）
+   */
+  static std::vector<uint32_t> multiply_integers(const std::vector<uint32_t> &a,
+                                                 const std::vector<uint32_t> &b,
+                                                 uint32_t base,
+                                                 size_t num_threads = 1) {
+    if (base < 2 || base > (1u << 16)) {
+      throw std::invalid_argument("基数必须在[2, 65536]内");
+    }
+    std::vector<uint64_t> a64(a.begin(), a.end()), b64(b.begin(), b.end());
+    for (uint64_t digit : a64) {
+      if (digit >= base) {
+        throw std::invalid_argument("数字超出基数范围");
+      }
+    }
+    for (uint64_t digit : b64) {
+      if (digit >= base) {
+        throw std::invalid_argument("数字超出基数范围");
+      }
+    }
+    // 每个系数不超过 min(|a|,|b|)·(base-1)² < 2^64，进位用128位保存
+    std::vector<uint64_t> product = convolve(a64, b64, num_threads);
+    std::vector<uint32_t> digits;
+    digits.reserve(product.size() + 4);
+    unsigned __int128 carry = 0;
+    for (uint64_t coefficient : product) {
+      carry += coefficient;
+      digits.push_back(static_cast<uint32_t>(carry % base));
+      carry /= base;
+    }
+    while (carry > 0) {
+      digits.push_back(static_cast<uint32_t>(carry % base));
+      carry /= base;
+    }
+    while (digits.size() > 1 && digits.back() == 0) {
+      digits.pop_back();
+    }
+    if (digits.empty()) {
+      digits.push_back(0);
+    }
+    return digits;
+  }
+
+private:
+  static void convolve_three(const std::vector<uint64_t> &a,
+                             const std::vector<uint64_t> &b,
+                             std::vector<uint32_t> &r1,
+                             std::vector<uint32_t> &r2,
+                             std::vector<uint32_t> &r3, size_t num_threads) {
+    if (!a.empty() && !b.empty() && a.size() + b.size() - 1 > max_result_size) {
+      throw std::invalid_argument("卷积结果长度超过2^25");
+    }
+    if (num_threads <= 1) {
+      r1 = NTT1::convolve(a, b);
+      r2 = NTT2::convolve(a, b);
+      r3 = NTT3::convolve(a, b);
+      return;
+    }
+    WorkStealingScheduler scheduler(std::min<size_t>(num_threads, 3));
+    scheduler.run([&] {
+      WorkStealingScheduler::TaskGroup group;
+      group.spawn([&] { r1 = NTT1::convolve(a, b); });
+      group.spawn([&] { r2 = NTT2::convolve(a, b); });
+      r3 = NTT3::convolve(a, b);
+      group.sync();
+    });
+  }
+
+  /**
+   * Garner算法：x = x1 + x2·P1 + x3·P1·P2，其中
+   * x2 = (r2 - x1)·P1^{-1} mod P2，x3 = (r3 - x1 - x2·P1)·(P1·P2)^{-1} mod P3
+   */
+  static unsigned __int128 garner(uint32_t r1, uint32_t r2, uint32_t r3) {
+    static const Constants constants;
+    const uint64_t p1 = NTT1::modulus, p2 = NTT2::modulus, p3 = NTT3::modulus;
+    uint64_t x1 = r1;
+    uint64_t x2 = (r2 + p2 - x1 % p2) % p2 * constants.p1_inverse_mod_p2 % p2;
+    uint64_t partial = (x1 + x2 % p3 * (p1 % p3)) % p3;
+    uint64_t x3 = (r3 + p3 - partial) % p3 * constants.p1p2_inverse_mod_p3 % p3;
+    return x1 + static_cast<unsigned __int128>(x2) * p1 +
+           static_cast<unsigned __int128>(x3) * p1 * p2;
+  }
+
+  struct Constants {
+    uint64_t p1_inverse_mod_p2;
+    uint64_t p1p2_inverse_mod_p3;
+
+    Constants() {
+      const long long p1 = NTT1::modulus, p2 = NTT2::modulus, p3 = NTT3::modulus;
+      p1_inverse_mod_p2 =
+          static_cast<uint64_t>(NumberTheoryAlgorithms::mod_inverse(p1 % p2, p2));
+      p1p2_inverse_mod_p3 = static_cast<uint64_t>(NumberTheoryAlgorithms::mod_inverse(
+          static_cast<long long>(static_cast<unsigned __int128>(p1) * p2 % p3), p3));
+    }
+  };
+};
+
+} // namespace algorithms
+
+#endif // NUMBER_THEORETIC_TRANSFORM_H
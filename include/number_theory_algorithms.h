@@ -1,18 +1,25 @@
 #ifndef NUMBER_THEORY_ALGORITHMS_H
 #define NUMBER_THEORY_ALGORITHMS_H
 
+#include "primality.h"
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <numeric>
 #include <random>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace algorithms {
 
+// RSA 所需的整数运算，按整数类型特化（int 见下文，BigInteger 见 big_integer.h）
+template <typename Integer> struct RSAArithmetic;
+
 /**
  * @brief 数论算法实现
  *
@@ -89,6 +96,136 @@ public:
     return gcd_val;
   }
 
+  /**
+   * @brief 二进制GCD（Stein算法）
+   *
+   * 只用移位、减法和 ctz：先提出两数公共的2的幂，之后两数都保持奇数，
+   * 每步用大数减小数并去掉差的末尾零，不需要除法。循环的关键路径上
+   * 只有减法、ctz 与移位（min 和取绝对值与 ctz 并行）。
+   * T 为32位或64位整数，有符号数按绝对值计算
+   *
+   * @param a 第一个整数
+   * @param b 第二个整数
+   * @return 最大公约数
+   */
+  template <typename T> static T binary_gcd(T a, T b) {
+    static_assert(std::is_integral<T>::value &&
+                      (sizeof(T) == 4 || sizeof(T) == 8),
+                  "binary_gcd需要32位或64位整数");
+    using U = typename std::make_unsigned<T>::type;
+    U u = unsigned_abs(a), v = unsigned_abs(b);
+    if (u == 0)
+      return static_cast<T>(v);
+    if (v == 0)
+      return static_cast<T>(u);
+    int shift = __builtin_ctzll(u | v);
+    u >>= __builtin_ctzll(u);
+    int zeros = __builtin_ctzll(v);
+    while (true) {
+      v >>= zeros;
+      // v - u 与 |v - u| 的末尾零个数相同：ctz 不必等 min 与取绝对值算完
+      U difference = v - u;
+      if (difference == 0)
+        break;
+      zeros = __builtin_ctzll(difference);
+      U magnitude = v > u ? difference : u - v;
+      u = std::min(u, v);
+      v = magnitude;
+    }
+    return static_cast<T>(u << shift);
+  }
+
+  /**
+   * @brief 奇数模数下的模逆元（二进制扩展欧几里得算法）
+   *
+   * 维护 x1·a ≡ u、x2·a ≡ v (mod m)，u、v 从 a、m 出发按Stein算法缩小到1；
+   * 模 m 下除以2用 x/2 或 (x+m)/2（m 为奇数），全程没有除法
+   *
+   * @param a 要求逆的数
+   * @param m 奇数模数
+   * @return a 模 m 的逆元，范围 [0, m)
+   * @throws std::invalid_argument m 不是正奇数或 a 与 m 不互素
+   */
+  template <typename T> static T binary_mod_inverse(T a, T m) {
+    static_assert(std::is_integral<T>::value &&
+                      (sizeof(T) == 4 || sizeof(T) == 8),
+                  "binary_mod_inverse需要32位或64位整数");
+    using U = typename std::make_unsigned<T>::type;
+    if (m <= 0 || m % 2 == 0) {
+      throw std::invalid_argument("模数必须为正奇数");
+    }
+    const U modulus = static_cast<U>(m);
+    if (modulus == 1)
+      return 0;
+    U u = a < 0 ? modulus - unsigned_abs(a) % modulus : static_cast<U>(a) % modulus;
+    U v = modulus, x1 = 1, x2 = 0;
+    auto half = [modulus](U x) {
+      return (x >> 1) + ((x & 1) ? (modulus >> 1) + 1 : 0);
+    };
+    while (u != 1 && v != 1) {
+      if (u == 0 || u == v) {
+        throw std::invalid_argument("逆元不存在");
+      }
+      while (u % 2 == 0) {
+        u >>= 1;
+        x1 = half(x1);
+      }
+      while (v % 2 == 0) {
+        v >>= 1;
+        x2 = half(x2);
+      }
+      if (u > v) {
+        u -= v;
+        x1 = x1 >= x2 ? x1 - x2 : x1 + (modulus - x2);
+      } else if (v > u) {
+        v -= u;
+        x2 = x2 >= x1 ? x2 - x1 : x2 + (modulus - x1);
+      }
+    }
+    return static_cast<T>(u == 1 ? x1 : x2);
+  }
+
+  /**
+   * @brief 批量模逆元（Montgomery技巧）
+   *
+   * 前缀积 p_i = a_0···a_i 只对最后一项求一次逆，再从后往前
+   * a_i^{-1} = p_i^{-1}·p_{i-1}、p_{i-1}^{-1} = p_i^{-1}·a_i，
+   * n 个逆元只需1次求逆和约3n次乘法。乘法用Montgomery64：直接把 a_i 当作
+   * Montgomery形式参与运算，多出的 R 的幂在求逆那一步恰好抵消，结果不需要
+   * 换出；数组按下标模4拆成4条互不依赖的乘法链，乘法延迟可以重叠。
+   *
+   * @param a 要求逆的数
+   * @param m 奇数模数
+   * @return result[i] = a[i]^{-1} mod m
+   * @throws std::invalid_argument m 不是大于1的奇数或某个元素与 m 不互素
+   */
+  static std::vector<uint64_t> batch_mod_inverse(const std::vector<uint64_t> &a,
+                                                 uint64_t m) {
+    if (m < 3 || m % 2 == 0) {
+      throw std::invalid_argument("模数必须为大于1的奇数");
+    }
+    constexpr size_t kChains = 4;
+    const Montgomery64 mont(m);
+    const size_t n = a.size();
+    std::vector<uint64_t> reduced(n), prefix(n), result(n);
+    for (size_t i = 0; i < n; i++) {
+      reduced[i] = a[i] < m ? a[i] : a[i] % m;
+      prefix[i] = i < kChains ? reduced[i]
+                              : mont.multiply(prefix[i - kChains], reduced[i]);
+    }
+    uint64_t running[kChains];
+    for (size_t c = 0; c < kChains && c < n; c++) {
+      size_t last = c + (n - 1 - c) / kChains * kChains;
+      running[c] = binary_mod_inverse(prefix[last], m);
+    }
+    for (size_t i = n; i-- > 0;) {
+      uint64_t &inverse = running[i % kChains];
+      result[i] = i < kChains ? inverse : mont.multiply(inverse, prefix[i - kChains]);
+      inverse = mont.multiply(inverse, reduced[i]);
+    }
+    return result;
+  }
+
   /**
    * @brief 模运算 - 算法导论第31.1节
    *
@@ -187,77 +324,103 @@ public:
   }
 
   /**
-   * @brief 素数测试 - 算法导论第31.8节
+   * @brief 64位模指数运算
    *
-   * 使用Miller-Rabin概率素数测试
+   * 与int版本相同的快速幂，中间乘积用128位整数保存，模数可以取到2^63以内
    *
-   * @param n 要测试的数
-   * @param k 测试次数（默认5次）
-   * @return 如果可能是素数返回true，否则返回false
+   * @param a 底数
+   * @param b 指数（非负）
+   * @param n 模数
+   * @return a^b mod n
    */
-  static bool is_prime(int n, int k = 5) {
-    if (n <= 1)
-      return false;
-    if (n <= 3)
-      return true;
-    if (n % 2 == 0)
-      return false;
-
-    // 将n-1写成d*2^s的形式
-    int d = n - 1;
-    int s = 0;
-    while (d % 2 == 0) {
-      d /= 2;
-      s++;
+  static long long mod_exponentiation(long long a, long long b, long long n) {
+    if (n <= 0) {
+      throw std::invalid_argument("模数必须为正数");
     }
+    if (n == 1)
+      return 0;
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<int> dis(2, n - 2);
-
-    for (int i = 0; i < k; ++i) {
-      int a = dis(gen);
-      int x = mod_exponentiation(a, d, n);
+    unsigned long long base = static_cast<unsigned long long>(a % n + n) % n;
+    unsigned long long result = 1;
+    unsigned long long modulus = static_cast<unsigned long long>(n);
 
-      if (x == 1 || x == n - 1) {
-        continue;
+    while (b > 0) {
+      if (b & 1) {
+        result = static_cast<unsigned long long>(
+            static_cast<unsigned __int128>(result) * base % modulus);
       }
+      base = static_cast<unsigned long long>(
+          static_cast<unsigned __int128>(base) * base % modulus);
+      b >>= 1;
+    }
 
-      bool composite = true;
-      for (int j = 0; j < s - 1; ++j) {
-        x = mod_multiply(x, x, n);
-        if (x == n - 1) {
-          composite = false;
-          break;
-        }
-      }
+    return static_cast<long long>(result);
+  }
 
-      if (composite) {
-        return false;
-      }
+  /**
+   * @brief 64位模逆元
+   *
+   * 迭代形式的扩展欧几里得算法，避免int版本在大模数下溢出
+   *
+   * @param a 数
+   * @param n 模数
+   * @return 模逆元，如果不存在则返回-1
+   */
+  static long long mod_inverse(long long a, long long n) {
+    if (n <= 0) {
+      throw std::invalid_argument("模数必须为正数");
+    }
+    __int128 old_r = (a % n + n) % n, r = n;
+    __int128 old_x = 1, x = 0;
+    while (r != 0) {
+      __int128 q = old_r / r;
+      __int128 next_r = old_r - q * r;
+      old_r = r;
+      r = next_r;
+      __int128 next_x = old_x - q * x;
+      old_x = x;
+      x = next_x;
     }
+    if (old_r != 1) {
+      return -1;
+    }
+    return static_cast<long long>((old_x % n + n) % n);
+  }
 
-    return true;
+  /**
+   * @brief 素数测试 - 算法导论第31.8节
+   *
+   * 使用确定性的Miller-Rabin测试（固定见证集合，见 MillerRabin），
+   * 对所有 int 结果都是准确的
+   *
+   * @param n 要测试的数
+   * @param k 随机测试的次数（保留以兼容旧接口，确定性测试不再需要）
+   * @return 如果是素数返回true，否则返回false
+   */
+  static bool is_prime(int n, int k = 5) {
+    (void)k;
+    return n > 1 && MillerRabin::is_prime(static_cast<uint64_t>(n));
   }
 
   /**
    * @brief 生成素数
    *
-   * 生成指定位数的素数
+   * 生成指定位数的素数。随机奇数先用小素数预筛，有小因子的直接跳过，
+   * 只有通过预筛的候选数才做Miller-Rabin测试
    *
    * @param bits 素数位数
    * @return 生成的素数
    */
   static int generate_prime(int bits) {
-    if (bits <= 1) {
-      throw std::invalid_argument("素数位数必须大于1");
+    if (bits <= 1 || bits > 31) {
+      throw std::invalid_argument("素数位数必须在2到31之间");
     }
 
     std::random_device rd;
     std::mt19937 gen(rd());
 
     int min_val = 1 << (bits - 1);
-    int max_val = (1 << bits) - 1;
+    int max_val = static_cast<int>((1u << bits) - 1);
 
     std::uniform_int_distribution<int> dis(min_val, max_val);
 
@@ -268,7 +431,8 @@ public:
         candidate++;
       }
 
-      if (is_prime(candidate)) {
+      if (!MillerRabin::has_small_factor(static_cast<uint64_t>(candidate)) &&
+          is_prime(candidate)) {
         return candidate;
       }
     }
@@ -313,59 +477,78 @@ public:
 
   /**
    * @brief RSA加密算法 - 算法导论第31.7节
+   *
+   * Integer 为整数类型：int 用于 CLRS 中的小例子，BigInteger（见 big_integer.h）
+   * 用于 2048 位等实际规模的密钥。具体运算由 RSAArithmetic<Integer> 提供。
+   * 私钥运算用中国剩余定理分别在 p、q 上做模幂；constant_time 为真（默认）时
+   * 使用与私钥指数无关的常数时间模幂（仅 BigInteger 有区别）。
+   * 这里是教科书式的 RSA，没有 OAEP/PSS 填充，不能直接用于实际加密。
    */
-  class RSA {
+  template <typename Integer = int> class RSA {
   private:
-    int public_key;  // 公钥 (e, n)
-    int private_key; // 私钥 (d, n)
-    int modulus;     // 模数 n
+    using Arithmetic = RSAArithmetic<Integer>;
+
+    Integer public_key;  // 公钥 (e, n)
+    Integer private_key; // 私钥 (d, n)
+    Integer modulus;     // 模数 n
+    Integer p, q;        // 素因子
+    Integer dp, dq;      // d mod (p-1)，d mod (q-1)
+    Integer q_inverse;   // q^{-1} mod p
+    bool constant_time = true;
 
   public:
+    using value_type = Integer;
+
     /**
      * @brief 构造函数，生成RSA密钥对
-     * @param bits 素数位数
+     * @param bits 每个素数的位数（模数约为 2·bits 位）
      */
     RSA(int bits = 16) {
-      // 生成两个大素数
-      int p = generate_prime(bits);
-      int q = generate_prime(bits);
+      // 生成两个不同的大素数
+      p = Arithmetic::generate_prime(bits);
+      do {
+        q = Arithmetic::generate_prime(bits);
+      } while (q == p);
 
       modulus = p * q;
-      int phi = (p - 1) * (q - 1);
+      Integer phi = (p - Integer(1)) * (q - Integer(1));
 
       // 选择公钥e，满足1 < e < phi且gcd(e, phi) = 1
-      public_key = 65537; // 常用的公钥值
-      if (public_key >= phi || gcd(public_key, phi) != 1) {
+      public_key = Integer(65537); // 常用的公钥值
+      if (public_key >= phi || Arithmetic::gcd(public_key, phi) != Integer(1)) {
         // 如果65537不合适，寻找合适的公钥
-        public_key = 3;
-        while (gcd(public_key, phi) != 1) {
-          public_key += 2;
+        public_key = Integer(3);
+        while (Arithmetic::gcd(public_key, phi) != Integer(1)) {
+          public_key = public_key + Integer(2);
         }
       }
 
       // 计算私钥d，满足d*e ≡ 1 (mod phi)
-      private_key = mod_inverse(public_key, phi);
-      if (private_key == -1) {
-        throw std::runtime_error("无法计算私钥");
-      }
+      private_key = Arithmetic::mod_inverse(public_key, phi);
+      dp = Arithmetic::mod(private_key, p - Integer(1));
+      dq = Arithmetic::mod(private_key, q - Integer(1));
+      q_inverse = Arithmetic::mod_inverse(q, p);
     }
 
     /**
      * @brief 获取公钥
      * @return 公钥(e, n)
      */
-    std::pair<int, int> get_public_key() const { return {public_key, modulus}; }
+    std::pair<Integer, Integer> get_public_key() const {
+      return {public_key, modulus};
+    }
+
+    // 私钥运算是否使用常数时间模幂
+    void set_constant_time(bool enabled) { constant_time = enabled; }
 
     /**
      * @brief 加密消息
      * @param message 要加密的消息（整数）
      * @return 加密后的密文
      */
-    int encrypt(int message) const {
-      if (message >= modulus) {
-        throw std::invalid_argument("消息必须小于模数");
-      }
-      return mod_exponentiation(message, public_key, modulus);
+    Integer encrypt(const Integer &message) const {
+      check_range(message);
+      return Arithmetic::mod_pow(message, public_key, modulus, false);
     }
 
     /**
@@ -373,8 +556,28 @@ public:
      * @param ciphertext 密文
      * @return 解密后的消息
      */
-    int decrypt(int ciphertext) const {
-      return mod_exponentiation(ciphertext, private_key, modulus);
+    Integer decrypt(const Integer &ciphertext) const {
+      check_range(ciphertext);
+      return apply_private(ciphertext);
+    }
+
+    /**
+     * @brief 用私钥对消息（通常是消息的哈希值）签名：s = m^d mod n
+     */
+    Integer sign(const Integer &message) const {
+      check_range(message);
+      return apply_private(message);
+    }
+
+    /**
+     * @brief 用公钥验证签名：s^e mod n == m
+     */
+    bool verify(const Integer &message, const Integer &signature) const {
+      if (message < Integer(0) || message >= modulus ||
+          signature < Integer(0) || signature >= modulus)
+        return false;
+      return Arithmetic::mod_pow(signature, public_key, modulus, false) ==
+             message;
     }
 
     /**
@@ -384,11 +587,29 @@ public:
     std::string to_string() const {
       std::ostringstream oss;
       oss << "RSA参数：\n";
-      oss << "模数 n = " << modulus << "\n";
-      oss << "公钥 e = " << public_key << "\n";
-      oss << "私钥 d = " << private_key << "\n";
+      oss << "模数 n = " << Arithmetic::to_string(modulus) << "\n";
+      oss << "公钥 e = " << Arithmetic::to_string(public_key) << "\n";
+      oss << "私钥 d = " << Arithmetic::to_string(private_key) << "\n";
       return oss.str();
     }
+
+  private:
+    void check_range(const Integer &x) const {
+      if (x < Integer(0) || x >= modulus) {
+        throw std::invalid_argument("消息必须小于模数");
+      }
+    }
+
+    // 中国剩余定理：m1 = c^dp mod p，m2 = c^dq mod q，
+    // m = m2 + q·(q^{-1}·(m1 - m2) mod p)
+    Integer apply_private(const Integer &c) const {
+      Integer m1 = Arithmetic::mod_pow(Arithmetic::mod(c, p), dp, p,
+                                       constant_time);
+      Integer m2 = Arithmetic::mod_pow(Arithmetic::mod(c, q), dq, q,
+                                       constant_time);
+      Integer h = Arithmetic::mod(q_inverse * Arithmetic::mod(m1 - m2, p), p);
+      return m2 + h * q;
+    }
   };
 
   /**
@@ -448,11 +669,46 @@ public:
    * @param message 测试消息
    * @return 验证结果
    */
-  static bool verify_rsa(const RSA &rsa, int message) {
-    int encrypted = rsa.encrypt(message);
-    int decrypted = rsa.decrypt(encrypted);
+  template <typename Integer>
+  static bool verify_rsa(const RSA<Integer> &rsa,
+                         const typename RSA<Integer>::value_type &message) {
+    Integer encrypted = rsa.encrypt(message);
+    Integer decrypted = rsa.decrypt(encrypted);
     return message == decrypted;
   }
+
+private:
+  template <typename T>
+  static typename std::make_unsigned<T>::type unsigned_abs(T x) {
+    using U = typename std::make_unsigned<T>::type;
+    return x < 0 ? U(0) - static_cast<U>(x) : static_cast<U>(x);
+  }
+};
+
+template <> struct RSAArithmetic<int> {
+  static int generate_prime(int bits) {
+    return NumberTheoryAlgorithms::generate_prime(bits);
+  }
+
+  static int gcd(int a, int b) { return NumberTheoryAlgorithms::gcd(a, b); }
+
+  static int mod(int a, int m) { return NumberTheoryAlgorithms::mod(a, m); }
+
+  static int mod_inverse(int a, int m) {
+    int inverse = NumberTheoryAlgorithms::mod_inverse(a, m);
+    if (inverse == -1) {
+      throw std::runtime_error("无法计算私钥");
+    }
+    return inverse;
+  }
+
+  static int mod_pow(int base, int exponent, int modulus, bool) {
+    return static_cast<int>(NumberTheoryAlgorithms::mod_exponentiation(
+        static_cast<long long>(base), static_cast<long long>(exponent),
+        static_cast<long long>(modulus)));
+  }
+
+  static std::string to_string(int x) { return std::to_string(x); }
 };
 
 } // namespace algorithms
@@ -2,9 +2,11 @@
 #define OPTIMAL_BINARY_SEARCH_TREE_H
 
 #include "binary_search_tree.h"
+#include "wavefront_executor.h"
 #include <algorithm>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -27,15 +29,54 @@ private:
   std::shared_ptr<OBSTNode<T>> root;
   std::vector<T> keys;
   std::vector<double> probabilities;
+  double expected_cost = 0.0;
+
+  // 填写 e[i][j]、w[i][j] 与 root_table[i][j]（所需的更短区间均已求出）
+  void compute_cell(std::vector<std::vector<double>> &e,
+                    std::vector<std::vector<double>> &w,
+                    std::vector<std::vector<int>> &root_table, int i,
+                    int j) const {
+    e[i][j] = std::numeric_limits<double>::max();
+    w[i][j] = w[i][j - 1] + probabilities[j - 1];
+
+    // 尝试所有可能的根
+    for (int r = i; r <= j; r++) {
+      double t = e[i][r - 1] + e[r + 1][j] + w[i][j];
+      if (t < e[i][j]) {
+        e[i][j] = t;
+        root_table[i][j] = r;
+      }
+    }
+  }
 
 public:
-  OptimalBinarySearchTree(const std::vector<T> &k, const std::vector<double> &p)
+  // 构建方式：教科书的 O(n³) 三重循环，或利用根单调性的 Knuth 优化 O(n²)
+  enum class BuildMode { Cubic, Knuth };
+
+  OptimalBinarySearchTree(const std::vector<T> &k, const std::vector<double> &p,
+                          BuildMode mode = BuildMode::Cubic)
+      : keys(k), probabilities(p) {
+    if (keys.size() != probabilities.size()) {
+      throw std::invalid_argument(
+          "Keys and probabilities must have the same size");
+    }
+    if (mode == BuildMode::Knuth) {
+      build_optimal_bst_knuth();
+    } else {
+      build_optimal_bst();
+    }
+  }
+
+  // 在调度器上按波前并行填表，tile 为块的边长
+  OptimalBinarySearchTree(const std::vector<T> &k, const std::vector<double> &p,
+                          WorkStealingScheduler &scheduler,
+                          std::size_t tile = 64)
       : keys(k), probabilities(p) {
     if (keys.size() != probabilities.size()) {
       throw std::invalid_argument(
           "Keys and probabilities must have the same size");
     }
-    build_optimal_bst();
+    build_optimal_bst(scheduler, tile);
   }
 
   // 构建最优二叉搜索树（动态规划算法）
@@ -43,6 +84,7 @@ public:
     int n = keys.size();
     if (n == 0) {
       root = nullptr;
+      expected_cost = 0.0;
       return;
     }
 
@@ -64,57 +106,104 @@ public:
     // 填充DP表
     for (int l = 1; l <= n; l++) {
       for (int i = 1; i <= n - l + 1; i++) {
-        int j = i + l - 1;
-        e[i][j] = std::numeric_limits<double>::max();
-        w[i][j] = w[i][j - 1] + probabilities[j - 1];
-
-        // 尝试所有可能的根
-        for (int r = i; r <= j; r++) {
-          double t = e[i][r - 1] + e[r + 1][j] + w[i][j];
-          if (t < e[i][j]) {
-            e[i][j] = t;
-            root_table[i][j] = r;
-          }
-        }
+        compute_cell(e, w, root_table, i, i + l - 1);
       }
     }
 
     // 构建最优BST
-    root = build_optimal_bst_helper(1, n, root_table);
+    expected_cost = e[1][n];
+    root = build_optimal_bst_helper(
+        1, n, [&root_table](int i, int j) { return root_table[i][j]; });
   }
 
-  // 获取期望搜索成本
-  double get_expected_cost() const {
+  // 波前并行版本：块内按 i 递减、j 递增填表，结果与串行版本相同
+  void build_optimal_bst(WorkStealingScheduler &scheduler,
+                         std::size_t tile = 64) {
     int n = keys.size();
-    if (n == 0)
-      return 0.0;
+    if (n == 0) {
+      root = nullptr;
+      expected_cost = 0.0;
+      return;
+    }
 
     std::vector<std::vector<double>> e(n + 2, std::vector<double>(n + 1, 0.0));
+    std::vector<std::vector<int>> root_table(n + 1, std::vector<int>(n + 1, 0));
     std::vector<std::vector<double>> w(n + 2, std::vector<double>(n + 1, 0.0));
 
-    for (int i = 1; i <= n; i++) {
-      e[i][i - 1] = 0.0;
-      w[i][i - 1] = 0.0;
-    }
+    WavefrontExecutor::triangular(
+        scheduler, n, tile,
+        [&](std::size_t row_begin, std::size_t row_end, std::size_t col_begin,
+            std::size_t col_end) {
+          for (std::size_t r = row_end; r-- > row_begin;) {
+            for (std::size_t c = std::max(col_begin, r); c < col_end; c++) {
+              compute_cell(e, w, root_table, static_cast<int>(r) + 1,
+                           static_cast<int>(c) + 1);
+            }
+          }
+        });
 
-    for (int l = 1; l <= n; l++) {
-      for (int i = 1; i <= n - l + 1; i++) {
-        int j = i + l - 1;
-        e[i][j] = std::numeric_limits<double>::max();
-        w[i][j] = w[i][j - 1] + probabilities[j - 1];
+    expected_cost = e[1][n];
+    root = build_optimal_bst_helper(
+        1, n, [&root_table](int i, int j) { return root_table[i][j]; });
+  }
 
-        for (int r = i; r <= j; r++) {
-          double t = e[i][r - 1] + e[r + 1][j] + w[i][j];
-          if (t < e[i][j]) {
-            e[i][j] = t;
+  /**
+   * @brief Knuth 优化：root[i][j-1] ≤ root[i][j] ≤ root[i+1][j]
+   *
+   * 只在单调区间内枚举根，同一行 j 递增时区间左右端点都单调移动，
+   * 每行的总枚举次数为 O(n)，总时间 O(n²)。按 i 递减、j 递增的顺序逐行
+   * 填表，w[i][j] 沿行递推，不需要 w 表；e 与 root 存放在按行压缩的
+   * 连续数组中（第 i 行只保存 j ∈ [i-1, n]），约 12·n²/2 字节。
+   * 区间内仍取最靠左的最优根；概率有并列时浮点舍入可能使选出的根与
+   * build_optimal_bst() 不同，两者的期望成本只相差舍入误差。
+   */
+  void build_optimal_bst_knuth() {
+    int n = keys.size();
+    if (n == 0) {
+      root = nullptr;
+      expected_cost = 0.0;
+      return;
+    }
+
+    // 第 i 行（1 ≤ i ≤ n+1）的格子 j ∈ [i-1, n] 存放在 row_start[i] + j - (i-1)
+    std::vector<std::size_t> row_start(n + 2);
+    std::size_t cells = 0;
+    for (int i = 1; i <= n + 1; i++) {
+      row_start[i] = cells;
+      cells += n - i + 2;
+    }
+    std::vector<double> e(cells, 0.0);
+    std::vector<int> root_table(cells, 0);
+    auto at = [&row_start](int i, int j) { return row_start[i] + j - i + 1; };
+
+    for (int i = n; i >= 1; i--) {
+      double w = 0.0;
+      for (int j = i; j <= n; j++) {
+        w += probabilities[j - 1];
+        int lo = j == i ? i : root_table[at(i, j - 1)];
+        int hi = j == i ? i : root_table[at(i + 1, j)];
+        double best = std::numeric_limits<double>::max();
+        int best_root = lo;
+        for (int r = lo; r <= hi; r++) {
+          double t = e[at(i, r - 1)] + e[at(r + 1, j)] + w;
+          if (t < best) {
+            best = t;
+            best_root = r;
           }
         }
+        e[at(i, j)] = best;
+        root_table[at(i, j)] = best_root;
       }
     }
 
-    return e[1][n];
+    expected_cost = e[at(1, n)];
+    root = build_optimal_bst_helper(
+        1, n, [&](int i, int j) { return root_table[at(i, j)]; });
   }
 
+  // 获取期望搜索成本（构建时已求出）
+  double get_expected_cost() const { return expected_cost; }
+
   // 打印DP表（用于调试和可视化）
   void print_dp_tables() const {
     int n = keys.size();
@@ -243,19 +332,19 @@ public:
 
 private:
   // 构建最优BST的辅助函数
+  template <typename RootOf>
   std::shared_ptr<OBSTNode<T>>
-  build_optimal_bst_helper(int i, int j,
-                           const std::vector<std::vector<int>> &root_table) {
+  build_optimal_bst_helper(int i, int j, const RootOf &root_of) {
     if (i > j) {
       return nullptr;
     }
 
-    int r = root_table[i][j];
+    int r = root_of(i, j);
     std::shared_ptr<OBSTNode<T>> node =
         std::make_shared<OBSTNode<T>>(keys[r - 1], probabilities[r - 1]);
 
-    node->left = build_optimal_bst_helper(i, r - 1, root_table);
-    node->right = build_optimal_bst_helper(r + 1, j, root_table);
+    node->left = build_optimal_bst_helper(i, r - 1, root_of);
+    node->right = build_optimal_bst_helper(r + 1, j, root_of);
 
     // 设置父指针
     if (node->left != nullptr) {
@@ -339,7 +428,7 @@ private:
 };
 
 // 算法导论中的经典示例
-void print_classic_example() {
+inline void print_obst_classic_example() {
   std::cout << "=== 算法导论经典示例（图15.9） ===" << std::endl;
 
   // 示例：算法导论图15.9
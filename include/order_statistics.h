@@ -1,13 +1,145 @@
 #ifndef ORDER_STATISTICS_H
 #define ORDER_STATISTICS_H
 
+#include "cpu_features.h"
+#include "gemm_kernel.h"
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iostream>
 #include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace algorithms {
 
+namespace order_statistics_detail {
+
+#ifdef ALGORITHMS_GEMM_X86
+// 同时求最小值和最大值的AVX2内核所需的向量操作
+template <typename T> struct Avx2MinMax;
+
+template <> struct Avx2MinMax<float> {
+  using Vec = __m256;
+  __attribute__((target("avx2"))) static Vec load(const float *p) {
+    return _mm256_loadu_ps(p);
+  }
+  __attribute__((target("avx2"))) static Vec min(Vec a, Vec b) {
+    return _mm256_min_ps(a, b);
+  }
+  __attribute__((target("avx2"))) static Vec max(Vec a, Vec b) {
+    return _mm256_max_ps(a, b);
+  }
+  __attribute__((target("avx2"))) static void store(float *p, Vec v) {
+    _mm256_storeu_ps(p, v);
+  }
+};
+
+template <> struct Avx2MinMax<double> {
+  using Vec = __m256d;
+  __attribute__((target("avx2"))) static Vec load(const double *p) {
+    return _mm256_loadu_pd(p);
+  }
+  __attribute__((target("avx2"))) static Vec min(Vec a, Vec b) {
+    return _mm256_min_pd(a, b);
+  }
+  __attribute__((target("avx2"))) static Vec max(Vec a, Vec b) {
+    return _mm256_max_pd(a, b);
+  }
+  __attribute__((target("avx2"))) static void store(double *p, Vec v) {
+    _mm256_storeu_pd(p, v);
+  }
+};
+
+template <typename T> struct Avx2MinMaxInt {
+  using Vec = __m256i;
+  __attribute__((target("avx2"))) static Vec load(const T *p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  __attribute__((target("avx2"))) static void store(T *p, Vec v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+  }
+};
+
+template <> struct Avx2MinMax<int32_t> : Avx2MinMaxInt<int32_t> {
+  __attribute__((target("avx2"))) static Vec min(Vec a, Vec b) {
+    return _mm256_min_epi32(a, b);
+  }
+  __attribute__((target("avx2"))) static Vec max(Vec a, Vec b) {
+    return _mm256_max_epi32(a, b);
+  }
+};
+
+template <> struct Avx2MinMax<uint32_t> : Avx2MinMaxInt<uint32_t> {
+  __attribute__((target("avx2"))) static Vec min(Vec a, Vec b) {
+    return _mm256_min_epu32(a, b);
+  }
+  __attribute__((target("avx2"))) static Vec max(Vec a, Vec b) {
+    return _mm256_max_epu32(a, b);
+  }
+};
+
+template <typename T>
+inline constexpr bool kAvx2MinMax =
+    std::is_same_v<T, float> || std::is_same_v<T, double> ||
+    std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t>;
+
+/**
+ * @brief 4组向量累加器交替更新，隐藏min/max指令的延迟；要求n ≥ 4个向量
+ */
+template <typename T>
+__attribute__((target("avx2"))) std::pair<T, T> avx2_min_max(const T *a,
+                                                             size_t n) {
+  using Ops = Avx2MinMax<T>;
+  using Vec = typename Ops::Vec;
+  constexpr size_t kLanes = 32 / sizeof(T);
+  constexpr size_t kStep = 4 * kLanes;
+  Vec lo0 = Ops::load(a), lo1 = Ops::load(a + kLanes),
+      lo2 = Ops::load(a + 2 * kLanes), lo3 = Ops::load(a + 3 * kLanes);
+  Vec hi0 = lo0, hi1 = lo1, hi2 = lo2, hi3 = lo3;
+  size_t i = kStep;
+  for (; i + kStep <= n; i += kStep) {
+    Vec v0 = Ops::load(a + i), v1 = Ops::load(a + i + kLanes),
+        v2 = Ops::load(a + i + 2 * kLanes), v3 = Ops::load(a + i + 3 * kLanes);
+    lo0 = Ops::min(lo0, v0);
+    hi0 = Ops::max(hi0, v0);
+    lo1 = Ops::min(lo1, v1);
+    hi1 = Ops::max(hi1, v1);
+    lo2 = Ops::min(lo2, v2);
+    hi2 = Ops::max(hi2, v2);
+    lo3 = Ops::min(lo3, v3);
+    hi3 = Ops::max(hi3, v3);
+  }
+  // 剩余不足4个向量：最后4个向量与已处理部分重叠，重复参与不影响结果
+  if (i < n) {
+    const T *tail = a + n - kStep;
+    lo0 = Ops::min(lo0, Ops::load(tail));
+    hi0 = Ops::max(hi0, Ops::load(tail));
+    lo1 = Ops::min(lo1, Ops::load(tail + kLanes));
+    hi1 = Ops::max(hi1, Ops::load(tail + kLanes));
+    lo2 = Ops::min(lo2, Ops::load(tail + 2 * kLanes));
+    hi2 = Ops::max(hi2, Ops::load(tail + 2 * kLanes));
+    lo3 = Ops::min(lo3, Ops::load(tail + 3 * kLanes));
+    hi3 = Ops::max(hi3, Ops::load(tail + 3 * kLanes));
+  }
+  T lanes_lo[kLanes], lanes_hi[kLanes];
+  Ops::store(lanes_lo, Ops::min(Ops::min(lo0, lo1), Ops::min(lo2, lo3)));
+  Ops::store(lanes_hi, Ops::max(Ops::max(hi0, hi1), Ops::max(hi2, hi3)));
+  T min_val = lanes_lo[0], max_val = lanes_hi[0];
+  for (size_t l = 1; l < kLanes; ++l) {
+    min_val = std::min(min_val, lanes_lo[l]);
+    max_val = std::max(max_val, lanes_hi[l]);
+  }
+  return {min_val, max_val};
+}
+#endif
+
+} // namespace order_statistics_detail
+
 /**
  * @brief 中位数和顺序统计量算法实现
  *
@@ -16,6 +148,11 @@ namespace algorithms {
  * - 随机化选择算法（期望线性时间）
  * - 最坏情况线性时间选择算法
  * - 中位数查找
+ * - 泛型原地选择：内省选择（快速选择 + 中位数的中位数兜底）与
+ *   Floyd–Rivest取样选择，一次递归求多个秩的select_many和分位数
+ *
+ * 泛型接口沿用std::nth_element的约定：less为严格弱序，选出第k小之后
+ * [first, nth)中的元素都不大于*nth，(nth, last)中的元素都不小于*nth。
  */
 class OrderStatistics {
 private:
@@ -81,6 +218,8 @@ private:
 
   /**
    * @brief 查找中位数的中位数
+   *
+   * 各组中位数依次换到区间前部，在原数组中递归选取，不复制分组。
    * @param arr 数组
    * @param low 起始索引
    * @param high 结束索引
@@ -95,62 +234,293 @@ private:
       return arr[low + (n - 1) / 2];
     }
 
-    // 将数组分成5个一组，找到每组的中位数
-    std::vector<int> medians;
+    // 将数组分成5个一组，每组的中位数换到arr[low + 组号]
+    int groups = 0;
     for (int i = low; i <= high; i += 5) {
       int end = std::min(i + 4, high);
       insertion_sort(arr, i, end);
-      medians.push_back(arr[i + (end - i) / 2]);
+      std::swap(arr[low + groups++], arr[i + (end - i) / 2]);
     }
 
     // 递归找到中位数的中位数
-    return select(medians, 0, medians.size() - 1, medians.size() / 2);
+    return select(arr, low, low + groups - 1, groups / 2);
+  }
+
+  static constexpr size_t kSelectInsertion = 16;     // 不超过此长度直接插入排序
+  static constexpr size_t kFloydRivestCutoff = 600;  // 超过此长度先取样缩小区间
+
+  template <typename T, typename Less>
+  static void insertion_sort_range(T *a, size_t lo, size_t hi, Less &less) {
+    for (size_t i = lo + 1; i < hi; ++i) {
+      T key = std::move(a[i]);
+      size_t j = i;
+      for (; j > lo && less(key, a[j - 1]); --j) {
+        a[j] = std::move(a[j - 1]);
+      }
+      a[j] = std::move(key);
+    }
+  }
+
+  template <typename T, typename Less>
+  static void sort3(T *a, size_t i, size_t j, size_t k, Less &less) {
+    if (less(a[j], a[i]))
+      std::swap(a[i], a[j]);
+    if (less(a[k], a[j])) {
+      std::swap(a[j], a[k]);
+      if (less(a[j], a[i]))
+        std::swap(a[i], a[j]);
+    }
   }
 
-public:
   /**
-   * @brief 同时查找最小值和最大值 - 算法导论第9.1节
-   * @param arr 数组
-   * @return 包含最小值和最大值的pair
+   * @brief 以a[lo]为基准划分[lo, hi)，返回基准的最终位置p：
+   *        [lo, p)不大于基准，(p, hi)不小于基准
+   *
+   * 两侧遇到与基准相等的元素都停下交换，大量重复值时划分仍然均衡。
    */
-  static std::pair<int, int> find_min_max(const std::vector<int> &arr) {
-    if (arr.empty()) {
-      throw std::invalid_argument("数组不能为空");
+  template <typename T, typename Less>
+  static size_t partition_range(T *a, size_t lo, size_t hi, Less &less) {
+    const T pivot = a[lo];
+    size_t i = lo, j = hi;
+    while (true) {
+      do {
+        ++i;
+      } while (i < hi && less(a[i], pivot));
+      do {
+        --j;
+      } while (less(pivot, a[j]));
+      if (i >= j)
+        break;
+      std::swap(a[i], a[j]);
     }
+    std::swap(a[lo], a[j]);
+    return j;
+  }
 
-    int n = arr.size();
-    int min_val, max_val;
-    int start;
+  /**
+   * @brief 原地中位数的中位数：5个一组，各组中位数换到区间前部，
+   *        再递归选出它们的中位数并换到a[lo]
+   */
+  template <typename T, typename Less>
+  static void median_of_medians_pivot(T *a, size_t lo, size_t hi, Less &less) {
+    size_t groups = 0;
+    for (size_t i = lo; i < hi; i += 5) {
+      size_t end = std::min(i + 5, hi);
+      insertion_sort_range(a, i, end, less);
+      std::swap(a[lo + groups++], a[i + (end - i - 1) / 2]);
+    }
+    size_t mid = lo + groups / 2;
+    introselect_loop(a, lo, lo + groups, mid, less);
+    std::swap(a[lo], a[mid]);
+  }
+
+  /**
+   * @brief 内省选择：三数或九数取中的快速选择；连续划分过于不均时
+   *        改用中位数的中位数选基准，最坏情况仍为线性时间
+   */
+  template <typename T, typename Less>
+  static void introselect_loop(T *a, size_t lo, size_t hi, size_t k,
+                               Less &less) {
+    // 允许的不均衡划分次数，约为2lg n
+    size_t budget = 2;
+    for (size_t n = hi - lo; n > 1; n >>= 1)
+      budget += 2;
+    while (hi - lo > kSelectInsertion) {
+      size_t n = hi - lo;
+      if (budget == 0) {
+        median_of_medians_pivot(a, lo, hi, less);
+      } else {
+        size_t mid = lo + n / 2;
+        if (n > 128) {
+          size_t step = n / 8;
+          sort3(a, lo, lo + step, lo + 2 * step, less);
+          sort3(a, mid - step, mid, mid + step, less);
+          sort3(a, hi - 1 - 2 * step, hi - 1 - step, hi - 1, less);
+          sort3(a, lo + step, mid, hi - 1 - step, less);
+        } else {
+          sort3(a, lo, mid, hi - 1, less);
+        }
+        std::swap(a[lo], a[mid]);
+      }
+      size_t p = partition_range(a, lo, hi, less);
+      if (std::min(p - lo, hi - p - 1) < n / 8 && budget > 0)
+        --budget;
+      if (k == p)
+        return;
+      if (k < p)
+        hi = p;
+      else
+        lo = p + 1;
+    }
+    insertion_sort_range(a, lo, hi, less);
+  }
+
+  /**
+   * @brief Floyd–Rivest选择（1975）：大区间先从中取样，递归地在样本中选出
+   *        两个紧夹第k小的元素，划分后只剩很小的区间，期望比较次数约为
+   *        n + min(k, n - k) + o(n)；迭代次数异常时退回内省选择
+   */
+  template <typename T, typename Less>
+  static void floyd_rivest_loop(T *a, size_t lo, size_t hi, size_t k,
+                                Less &less) {
+    size_t iterations = 0, limit = 8;
+    for (size_t n = hi - lo; n > 1; n >>= 1)
+      limit += 2;
+    while (hi - lo > kSelectInsertion) {
+      if (++iterations > limit) {
+        introselect_loop(a, lo, hi, k, less);
+        return;
+      }
+      size_t n = hi - lo;
+      if (n > kFloydRivestCutoff) {
+        // 样本大小s ≈ n^(2/3)/2，偏移量sd使[new_lo, new_hi)以高概率包含第k小
+        double dn = static_cast<double>(n);
+        double i = static_cast<double>(k - lo + 1);
+        double z = std::log(dn);
+        double s = 0.5 * std::exp(2.0 * z / 3.0);
+        double sd = 0.5 * std::sqrt(z * s * (dn - s) / dn) *
+                    (i < dn / 2 ? -1.0 : 1.0);
+        double left = static_cast<double>(k) - i * s / dn + sd;
+        double right = static_cast<double>(k) + (dn - i) * s / dn + sd;
+        size_t new_lo =
+            std::max(lo, static_cast<size_t>(std::max(0.0, left)));
+        size_t new_hi = std::min(hi, static_cast<size_t>(right) + 1);
+        if (new_lo <= k && k < new_hi && new_hi - new_lo < n) {
+          // 先随机换入样本：区间可能已被之前的选择部分划分过，
+          // 连续的一段不再是随机样本
+          uint64_t state = n + k;
+          for (size_t j = new_lo; j < new_hi; ++j) {
+            state += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = state;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            z ^= z >> 31;
+            std::swap(a[j], a[lo + static_cast<size_t>(z % n)]);
+          }
+          floyd_rivest_loop(a, new_lo, new_hi, k, less);
+        }
+      }
+      // 以a[k]为基准划分
+      std::swap(a[lo], a[k]);
+      size_t p = partition_range(a, lo, hi, less);
+      if (k == p)
+        return;
+      if (k < p)
+        hi = p;
+      else
+        lo = p + 1;
+    }
+    insertion_sort_range(a, lo, hi, less);
+  }
+
+  /**
+   * @brief 一次递归求多个秩：先选出中间的秩，它把区间和其余的秩一分为二
+   */
+  template <typename T, typename Less>
+  static void multi_select(T *a, size_t lo, size_t hi, const size_t *ranks,
+                           size_t count, Less &less) {
+    while (count > 0) {
+      if (hi - lo <= kSelectInsertion) {
+        insertion_sort_range(a, lo, hi, less);
+        return;
+      }
+      size_t mid = count / 2;
+      size_t k = ranks[mid];
+      floyd_rivest_loop(a, lo, hi, k, less);
+      // 与ranks[mid]相同的秩已经就位
+      size_t left_count = mid;
+      while (left_count > 0 && ranks[left_count - 1] == k)
+        --left_count;
+      size_t right_begin = mid + 1;
+      while (right_begin < count && ranks[right_begin] == k)
+        ++right_begin;
+      // 较小的一侧递归，较大的一侧循环，递归深度O(lg count)
+      if (left_count < count - right_begin) {
+        multi_select(a, lo, k, ranks, left_count, less);
+        lo = k + 1;
+        ranks += right_begin;
+        count -= right_begin;
+      } else {
+        multi_select(a, k + 1, hi, ranks + right_begin, count - right_begin,
+                     less);
+        hi = k;
+        count = left_count;
+      }
+    }
+  }
+
+  /**
+   * @brief 教材9.1节的成对比较：每对元素3次比较
+   */
+  template <typename T>
+  static std::pair<T, T> pairwise_min_max(const T *a, size_t n) {
+    T min_val, max_val;
+    size_t start;
 
     // 初始化最小值和最大值
     if (n % 2 == 1) {
-      min_val = max_val = arr[0];
+      min_val = max_val = a[0];
       start = 1;
     } else {
-      if (arr[0] < arr[1]) {
-        min_val = arr[0];
-        max_val = arr[1];
+      if (a[0] < a[1]) {
+        min_val = a[0];
+        max_val = a[1];
       } else {
-        min_val = arr[1];
-        max_val = arr[0];
+        min_val = a[1];
+        max_val = a[0];
       }
       start = 2;
     }
 
     // 每次比较两个元素，总共3(n/2)次比较
-    for (int i = start; i < n; i += 2) {
-      if (arr[i] < arr[i + 1]) {
-        min_val = std::min(min_val, arr[i]);
-        max_val = std::max(max_val, arr[i + 1]);
+    for (size_t i = start; i < n; i += 2) {
+      if (a[i] < a[i + 1]) {
+        min_val = std::min(min_val, a[i]);
+        max_val = std::max(max_val, a[i + 1]);
       } else {
-        min_val = std::min(min_val, arr[i + 1]);
-        max_val = std::max(max_val, arr[i]);
+        min_val = std::min(min_val, a[i + 1]);
+        max_val = std::max(max_val, a[i]);
       }
     }
 
     return {min_val, max_val};
   }
 
+public:
+  /**
+   * @brief 同时查找最小值和最大值 - 算法导论第9.1节
+   *
+   * float、double与32位整数在支持AVX2的CPU上用向量min/max，其余类型
+   * 用每对元素3次比较的成对算法。浮点数不能含NaN。
+   * @param data 数组首地址
+   * @param n 元素个数
+   * @return 包含最小值和最大值的pair
+   */
+  template <typename T>
+  static std::pair<T, T> find_min_max(const T *data, size_t n) {
+    if (n == 0) {
+      throw std::invalid_argument("数组不能为空");
+    }
+#ifdef ALGORITHMS_GEMM_X86
+    if constexpr (order_statistics_detail::kAvx2MinMax<T>) {
+      if (n >= 128 / sizeof(T) && CpuFeatures::avx2()) {
+        return order_statistics_detail::avx2_min_max(data, n);
+      }
+    }
+#endif
+    return pairwise_min_max(data, n);
+  }
+
+  /**
+   * @brief 同时查找最小值和最大值 - 算法导论第9.1节
+   * @param arr 数组
+   * @return 包含最小值和最大值的pair
+   */
+  template <typename T>
+  static std::pair<T, T> find_min_max(const std::vector<T> &arr) {
+    return find_min_max(arr.data(), arr.size());
+  }
+
   /**
    * @brief 随机化选择算法 - 算法导论第9.2节（期望线性时间）
    * @param arr 数组
@@ -276,6 +646,158 @@ public:
 
     return randomized_select(arr, 0, arr.size() - 1, i - 1);
   }
+
+  /**
+   * @brief 内省选择：原地重排[first, last)，使*nth为第nth - first小的元素
+   *
+   * 快速选择配九数取中，连续划分过于不均时改用原地的中位数的中位数
+   * 选基准，最坏情况线性时间。nth == last时不做任何事。
+   * @param first 区间起点
+   * @param nth 要定位的位置
+   * @param last 区间终点
+   * @param less 严格弱序
+   */
+  template <typename T, typename Less = std::less<T>>
+  static void introselect(T *first, T *nth, T *last, Less less = Less()) {
+    if (nth == last)
+      return;
+    introselect_loop(first, 0, static_cast<size_t>(last - first),
+                     static_cast<size_t>(nth - first), less);
+  }
+
+  /**
+   * @brief 内省选择第k小的元素（k从0开始），原地重排arr
+   * @param arr 数组
+   * @param k 秩
+   * @param less 严格弱序
+   * @return 第k小的元素
+   */
+  template <typename T, typename Less = std::less<T>>
+  static T introselect(std::vector<T> &arr, size_t k, Less less = Less()) {
+    if (k >= arr.size()) {
+      throw std::invalid_argument("k超出数组范围");
+    }
+    introselect(arr.data(), arr.data() + k, arr.data() + arr.size(), less);
+    return arr[k];
+  }
+
+  /**
+   * @brief Floyd–Rivest选择：原地重排[first, last)，使*nth为第nth - first小的元素
+   * @param first 区间起点
+   * @param nth 要定位的位置
+   * @param last 区间终点
+   * @param less 严格弱序
+   */
+  template <typename T, typename Less = std::less<T>>
+  static void floyd_rivest_select(T *first, T *nth, T *last,
+                                  Less less = Less()) {
+    if (nth == last)
+      return;
+    floyd_rivest_loop(first, 0, static_cast<size_t>(last - first),
+                      static_cast<size_t>(nth - first), less);
+  }
+
+  /**
+   * @brief Floyd–Rivest选择第k小的元素（k从0开始），原地重排arr
+   * @param arr 数组
+   * @param k 秩
+   * @param less 严格弱序
+   * @return 第k小的元素
+   */
+  template <typename T, typename Less = std::less<T>>
+  static T floyd_rivest_select(std::vector<T> &arr, size_t k,
+                               Less less = Less()) {
+    if (k >= arr.size()) {
+      throw std::invalid_argument("k超出数组范围");
+    }
+    floyd_rivest_select(arr.data(), arr.data() + k, arr.data() + arr.size(),
+                        less);
+    return arr[k];
+  }
+
+  /**
+   * @brief 一次递归求多个秩，结束后每个first[ranks[j]]都是对应的顺序统计量
+   *
+   * 先选出中间的秩，它把区间与其余的秩分成两半分别递归，
+   * 比逐个调用选择少扫描已经分开的部分，代价为O(n lg r)。
+   * @param first 区间起点
+   * @param last 区间终点
+   * @param sorted_ranks 非降序的秩（从0开始），可以重复
+   * @param less 严格弱序
+   */
+  template <typename T, typename Less = std::less<T>>
+  static void select_many(T *first, T *last,
+                          const std::vector<size_t> &sorted_ranks,
+                          Less less = Less()) {
+    size_t n = static_cast<size_t>(last - first);
+    for (size_t j = 0; j < sorted_ranks.size(); ++j) {
+      if (sorted_ranks[j] >= n) {
+        throw std::invalid_argument("秩超出数组范围");
+      }
+      if (j > 0 && sorted_ranks[j] < sorted_ranks[j - 1]) {
+        throw std::invalid_argument("秩必须按非降序给出");
+      }
+    }
+    multi_select(first, 0, n, sorted_ranks.data(), sorted_ranks.size(), less);
+  }
+
+  /**
+   * @brief 一次递归求多个秩的元素，原地重排arr
+   * @param arr 数组
+   * @param sorted_ranks 非降序的秩（从0开始），可以重复
+   * @param less 严格弱序
+   * @return 与sorted_ranks一一对应的元素
+   */
+  template <typename T, typename Less = std::less<T>>
+  static std::vector<T> select_many(std::vector<T> &arr,
+                                    const std::vector<size_t> &sorted_ranks,
+                                    Less less = Less()) {
+    select_many(arr.data(), arr.data() + arr.size(), sorted_ranks, less);
+    std::vector<T> result;
+    result.reserve(sorted_ranks.size());
+    for (size_t k : sorted_ranks) {
+      result.push_back(arr[k]);
+    }
+    return result;
+  }
+
+  /**
+   * @brief 最近秩法的分位数（如p50/p90/p99/p999），一次select_many求出
+   *
+   * 概率q对应第max(⌈q·n⌉, 1)小的元素；q可以按任意顺序给出。
+   * @param arr 数组，会被原地重排
+   * @param probabilities [0, 1]中的概率
+   * @return 与probabilities一一对应的分位数
+   */
+  template <typename T, typename Less = std::less<T>>
+  static std::vector<T> quantiles(std::vector<T> &arr,
+                                  const std::vector<double> &probabilities,
+                                  Less less = Less()) {
+    if (arr.empty()) {
+      throw std::invalid_argument("数组不能为空");
+    }
+    size_t n = arr.size();
+    std::vector<std::pair<size_t, size_t>> rank_of(probabilities.size());
+    for (size_t j = 0; j < probabilities.size(); ++j) {
+      double q = probabilities[j];
+      if (!(q >= 0.0 && q <= 1.0)) {
+        throw std::invalid_argument("分位数的概率必须在[0, 1]范围内");
+      }
+      size_t rank = static_cast<size_t>(std::ceil(q * static_cast<double>(n)));
+      rank_of[j] = {std::min(n, std::max<size_t>(rank, 1)) - 1, j};
+    }
+    std::sort(rank_of.begin(), rank_of.end());
+    std::vector<size_t> sorted_ranks(rank_of.size());
+    for (size_t j = 0; j < rank_of.size(); ++j) {
+      sorted_ranks[j] = rank_of[j].first;
+    }
+    select_many(arr.data(), arr.data() + n, sorted_ranks, less);
+    std::vector<T> result(probabilities.size());
+    for (const auto &[rank, j] : rank_of) {
+      result[j] = arr[rank];
+    }
+    return result;
+  }
 };
 
 } // namespace algorithms
@@ -0,0 +1,938 @@
+#ifndef PAGED_B_TREE_H
+#define PAGED_B_TREE_H
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+
+// 页访问与磁盘I/O计数
+struct IoStats {
+  uint64_t page_accesses = 0; // 树操作访问的页数（含命中）
+  uint64_t cache_hits = 0;    // 缓冲池命中次数
+  uint64_t page_reads = 0;    // 实际从文件读入的页数
+  uint64_t page_writes = 0;   // 实际写回文件的页数
+};
+
+/**
+ * @brief 定长页文件：按页号用pread/pwrite读写
+ */
+class PageFile {
+public:
+  PageFile(const std::string &path, size_t page_size, bool truncate,
+           bool read_only = false)
+      : page_bytes(page_size) {
+    int flags = read_only ? O_RDONLY : (O_RDWR | O_CREAT);
+    if (truncate) {
+      flags |= O_TRUNC;
+    }
+    fd = ::open(path.c_str(), flags, 0644);
+    if (fd < 0) {
+      throw std::runtime_error("Cannot open page file " + path + ": " +
+                               std::strerror(errno));
+    }
+  }
+
+  PageFile(const PageFile &) = delete;
+  PageFile &operator=(const PageFile &) = delete;
+
+  ~PageFile() {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+
+  // 读取一页；超出文件末尾的部分补零
+  void read(uint32_t page_id, void *buffer, IoStats &stats) const {
+    char *out = static_cast<char *>(buffer);
+    size_t done = 0;
+    while (done < page_bytes) {
+      ssize_t got = ::pread(fd, out + done, page_bytes - done,
+                            offset_of(page_id) + done);
+      if (got < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        throw std::runtime_error(std::string("Page read failed: ") +
+                                 std::strerror(errno));
+      }
+      if (got == 0) {
+        std::memset(out + done, 0, page_bytes - done);
+        break;
+      }
+      done += static_cast<size_t>(got);
+    }
+    stats.page_reads++;
+  }
+
+  void write(uint32_t page_id, const void *buffer, IoStats &stats) {
+    const char *in = static_cast<const char *>(buffer);
+    size_t done = 0;
+    while (done < page_bytes) {
+      ssize_t put = ::pwrite(fd, in + done, page_bytes - done,
+                             offset_of(page_id) + done);
+      if (put < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        throw std::runtime_error(std::string("Page write failed: ") +
+                                 std::strerror(errno));
+      }
+      done += static_cast<size_t>(put);
+    }
+    stats.page_writes++;
+  }
+
+  void sync() {
+    if (::fsync(fd) != 0) {
+      throw std::runtime_error(std::string("fsync failed: ") +
+                               std::strerror(errno));
+    }
+  }
+
+  size_t file_size() const {
+    struct stat info;
+    return ::fstat(fd, &info) == 0 ? static_cast<size_t>(info.st_size) : 0;
+  }
+
+  int descriptor() const { return fd; }
+  size_t page_size() const { return page_bytes; }
+
+private:
+  int fd = -1;
+  size_t page_bytes;
+
+  off_t offset_of(uint32_t page_id) const {
+    return static_cast<off_t>(page_id) * static_cast<off_t>(page_bytes);
+  }
+};
+
+/**
+ * @brief 固定容量的缓冲池，采用时钟（second chance）置换
+ *
+ * 被钉住（pin_count > 0）的帧不会被换出；换出脏页时先写回文件。
+ */
+class BufferPool {
+public:
+  BufferPool(PageFile &page_file, size_t capacity)
+      : file(page_file), frames(capacity),
+        buffer(static_cast<char *>(::operator new(
+            capacity * page_file.page_size(), std::align_val_t(4096)))) {
+    if (capacity < kMinFrames) {
+      ::operator delete(buffer, std::align_val_t(4096));
+      throw std::invalid_argument("Buffer pool needs at least 8 frames");
+    }
+    page_table.reserve(capacity * 2);
+  }
+
+  BufferPool(const BufferPool &) = delete;
+  BufferPool &operator=(const BufferPool &) = delete;
+
+  ~BufferPool() { ::operator delete(buffer, std::align_val_t(4096)); }
+
+  /**
+   * @brief 钉住一页并返回所在帧
+   * @param fresh 新分配的页，不需要从文件读入（内容清零）
+   */
+  size_t pin(uint32_t page_id, bool fresh, IoStats &stats) {
+    stats.page_accesses++;
+    auto it = page_table.find(page_id);
+    if (it != page_table.end()) {
+      Frame &frame = frames[it->second];
+      frame.pin_count++;
+      frame.referenced = true;
+      stats.cache_hits++;
+      return it->second;
+    }
+
+    size_t index = choose_victim(stats);
+    Frame &frame = frames[index];
+    if (fresh) {
+      std::memset(data(index), 0, file.page_size());
+    } else {
+      file.read(page_id, data(index), stats);
+    }
+    frame.page_id = page_id;
+    frame.valid = true;
+    frame.dirty = fresh;
+    frame.referenced = true;
+    frame.pin_count = 1;
+    page_table[page_id] = index;
+    return index;
+  }
+
+  void unpin(size_t index, bool dirty) {
+    Frame &frame = frames[index];
+    frame.dirty |= dirty;
+    frame.pin_count--;
+  }
+
+  char *data(size_t index) { return buffer + index * file.page_size(); }
+
+  void flush_all(IoStats &stats) {
+    for (size_t i = 0; i < frames.size(); i++) {
+      if (frames[i].valid && frames[i].dirty) {
+        file.write(frames[i].page_id, data(i), stats);
+        frames[i].dirty = false;
+      }
+    }
+  }
+
+  size_t capacity() const { return frames.size(); }
+
+private:
+  static constexpr size_t kMinFrames = 8;
+
+  struct Frame {
+    uint32_t page_id = 0;
+    int pin_count = 0;
+    bool valid = false;
+    bool dirty = false;
+    bool referenced = false;
+  };
+
+  PageFile &file;
+  std::vector<Frame> frames;
+  char *buffer;
+  std::unordered_map<uint32_t, size_t> page_table;
+  size_t hand = 0;
+
+  // 时钟指针转动：空帧直接使用，引用位为1的帧给第二次机会
+  size_t choose_victim(IoStats &stats) {
+    for (size_t step = 0; step < 2 * frames.size() + 1; step++) {
+      size_t index = hand;
+      hand = (hand + 1) % frames.size();
+      Frame &frame = frames[index];
+      if (!frame.valid) {
+        return index;
+      }
+      if (frame.pin_count > 0) {
+        continue;
+      }
+      if (frame.referenced) {
+        frame.referenced = false;
+        continue;
+      }
+      if (frame.dirty) {
+        file.write(frame.page_id, data(index), stats);
+      }
+      page_table.erase(frame.page_id);
+      frame.valid = false;
+      return index;
+    }
+    throw std::runtime_error("All buffer pool frames are pinned");
+  }
+};
+
+/**
+ * @brief 基于页文件的B树（算法导论第18章）
+ *
+ * 与b_tree.h相同的CLRS算法：插入时自顶向下预先分裂满节点，删除时下降前保证孩子
+ * 至少有t个键（借键或合并），因此每次操作只需沿一条根到叶子的路径访问页。
+ * - 每个节点占一页，最小度数t由页大小和键值大小决定
+ * - 读写模式通过缓冲池访问页；只读模式可以直接mmap整个文件
+ * - 第0页是文件头，记录根页号、空闲页链表和元素个数
+ * 键和值必须是可平凡复制的类型，按字节存入页中。
+ */
+template <typename K, typename V> class PagedBTree {
+  static_assert(std::is_trivially_copyable<K>::value &&
+                    std::is_trivially_copyable<V>::value,
+                "PagedBTree stores keys and values as raw bytes");
+
+public:
+  enum class OpenMode {
+    Create,      // 新建（覆盖已有文件）
+    ReadWrite,   // 打开已有文件读写
+    ReadOnlyMmap // 只读打开并mmap整个文件
+  };
+
+  /**
+   * @param pool_pages 缓冲池容量（页数），ReadOnlyMmap模式下忽略
+   * @param page_size 页大小，仅在Create模式下使用；打开已有文件时以文件头为准
+   */
+  PagedBTree(const std::string &path, OpenMode open_mode,
+             size_t pool_pages = 1024, size_t page_size = 4096)
+      : mode(open_mode) {
+    if (mode == OpenMode::Create) {
+      if (page_size < 64 || page_size % 64 != 0) {
+        throw std::invalid_argument("Page size must be a multiple of 64");
+      }
+      header.page_size = static_cast<uint32_t>(page_size);
+      t = degree_for(page_size);
+      if (t < 2) {
+        throw std::invalid_argument("Page size too small for key/value size");
+      }
+      header.degree = static_cast<uint32_t>(t);
+      header.page_count = 2;
+      header.root = 1;
+      file.reset(new PageFile(path, page_size, true));
+      pool.reset(new BufferPool(*file, pool_pages));
+      {
+        Node root = pin(header.root, true);
+        root.set_leaf(true);
+        root.set_count(0);
+      }
+      header_dirty = true;
+      flush();
+      return;
+    }
+
+    read_header(path);
+    t = static_cast<int>(header.degree);
+    if (mode == OpenMode::ReadOnlyMmap) {
+      file.reset(new PageFile(path, header.page_size, false, true));
+      mapped_bytes = static_cast<size_t>(header.page_count) * header.page_size;
+      void *address = ::mmap(nullptr, mapped_bytes, PROT_READ, MAP_SHARED,
+                             file->descriptor(), 0);
+      if (address == MAP_FAILED) {
+        throw std::runtime_error(std::string("mmap failed: ") +
+                                 std::strerror(errno));
+      }
+      ::madvise(address, mapped_bytes, MADV_RANDOM);
+      mapping = static_cast<char *>(address);
+    } else {
+      file.reset(new PageFile(path, header.page_size, false));
+      pool.reset(new BufferPool(*file, pool_pages));
+    }
+  }
+
+  PagedBTree(const PagedBTree &) = delete;
+  PagedBTree &operator=(const PagedBTree &) = delete;
+
+  ~PagedBTree() {
+    try {
+      flush();
+    } catch (...) {
+    }
+    if (mapping != nullptr) {
+      ::munmap(mapping, mapped_bytes);
+    }
+  }
+
+  std::optional<V> search(const K &key) {
+    uint32_t page_id = header.root;
+    while (true) {
+      Node node = pin(page_id);
+      int i = node.find_key(key);
+      if (i < node.count() && node.key(i) == key) {
+        return node.value(i);
+      }
+      if (node.is_leaf()) {
+        return std::nullopt;
+      }
+      page_id = node.child(i);
+    }
+  }
+
+  bool contains(const K &key) { return search(key).has_value(); }
+
+  // 插入或更新，返回是否为新键
+  bool insert(const K &key, const V &value) {
+    require_writable();
+    {
+      Node root = pin(header.root);
+      if (root.is_full()) {
+        // 根已满：新建根，原根成为其唯一孩子后分裂（树长高一层）
+        uint32_t new_root_id = allocate_page();
+        Node new_root = pin(new_root_id, true);
+        new_root.set_leaf(false);
+        new_root.set_count(0);
+        new_root.set_child(0, header.root);
+        split_child(new_root, 0, root);
+        header.root = new_root_id;
+        header_dirty = true;
+      }
+    }
+
+    Node node = pin(header.root);
+    while (true) {
+      int i = node.find_key(key);
+      if (i < node.count() && node.key(i) == key) {
+        node.set_value(i, value);
+        return false;
+      }
+      if (node.is_leaf()) {
+        node.insert_entry(i, key, value);
+        header.size++;
+        header_dirty = true;
+        return true;
+      }
+      Node child = pin(node.child(i));
+      if (child.is_full()) {
+        split_child(node, i, child);
+        if (node.key(i) == key) {
+          node.set_value(i, value);
+          return false;
+        }
+        if (node.key(i) < key) {
+          child = pin(node.child(i + 1));
+        }
+      }
+      node = std::move(child);
+    }
+  }
+
+  bool remove(const K &key) {
+    require_writable();
+    bool removed = remove_from(header.root, key);
+    Node root = pin(header.root);
+    if (root.count() == 0 && !root.is_leaf()) {
+      // 根变空：唯一的孩子成为新根（树变矮一层）
+      uint32_t old_root = header.root;
+      header.root = root.child(0);
+      root = Node();
+      free_page(old_root);
+    }
+    if (removed) {
+      header.size--;
+      header_dirty = true;
+    }
+    return removed;
+  }
+
+  // 写回所有脏页和文件头
+  void flush() {
+    if (mode == OpenMode::ReadOnlyMmap || !file) {
+      return;
+    }
+    pool->flush_all(io);
+    if (header_dirty) {
+      write_header();
+      header_dirty = false;
+    }
+  }
+
+  // 检查键有序、节点键数范围以及所有叶子在同一深度
+  bool validate() {
+    int leaf_depth = -1;
+    uint64_t counted = 0;
+    return validate_node(header.root, true, nullptr, nullptr, 0, leaf_depth,
+                         counted) &&
+           counted == header.size;
+  }
+
+  // 按升序访问所有元素：visit(key, value)
+  template <typename Visitor> void traverse(Visitor visit) {
+    traverse_node(header.root, visit);
+  }
+
+  uint64_t size() const { return header.size; }
+  bool empty() const { return header.size == 0; }
+  int degree() const { return t; }
+  size_t page_size() const { return header.page_size; }
+  uint32_t page_count() const { return header.page_count; }
+
+  int height() {
+    int h = 1;
+    uint32_t page_id = header.root;
+    while (true) {
+      Node node = pin(page_id);
+      if (node.is_leaf()) {
+        return h;
+      }
+      page_id = node.child(0);
+      h++;
+    }
+  }
+
+  const IoStats &io_stats() const { return io; }
+  void reset_io_stats() { io = IoStats(); }
+
+  // 给定页大小下的最小度数：2t-1个键值与2t个孩子页号放进一页
+  static int degree_for(size_t page_size) {
+    size_t entry = sizeof(K) + sizeof(V);
+    // 8 + (2t-1)*entry + 2t*4 <= page_size
+    long long t = (static_cast<long long>(page_size) - 8 +
+                   static_cast<long long>(entry)) /
+                  (2 * static_cast<long long>(entry + sizeof(uint32_t)));
+    return static_cast<int>(t);
+  }
+
+private:
+  static constexpr uint64_t kMagic = 0x314750455254425FULL; // "_BTREPG1"
+  static constexpr uint32_t kNoPage = 0;
+
+  struct FileHeader {
+    uint64_t magic = kMagic;
+    uint32_t page_size = 0;
+    uint32_t key_size = sizeof(K);
+    uint32_t value_size = sizeof(V);
+    uint32_t degree = 0;
+    uint32_t root = 0;
+    uint32_t page_count = 0;
+    uint32_t free_head = kNoPage;
+    uint32_t reserved = 0;
+    uint64_t size = 0;
+  };
+
+  // 页内节点布局：[is_leaf:u16][n:u16][next_free:u32][keys][values][children]
+  // 键值按字节拷贝访问，不要求页内对齐
+  class Node {
+  public:
+    Node() = default;
+    Node(PagedBTree *owner, uint32_t id, size_t frame, char *bytes)
+        : tree(owner), page_id(id), frame_index(frame), data(bytes) {}
+
+    Node(Node &&other) noexcept { take(other); }
+    Node &operator=(Node &&other) noexcept {
+      if (this != &other) {
+        release();
+        take(other);
+      }
+      return *this;
+    }
+    Node(const Node &) = delete;
+    Node &operator=(const Node &) = delete;
+    ~Node() { release(); }
+
+    uint32_t id() const { return page_id; }
+
+    bool is_leaf() const { return read<uint16_t>(0) != 0; }
+    int count() const { return read<uint16_t>(2); }
+    bool is_full() const { return count() == 2 * tree->t - 1; }
+
+    K key(int i) const { return read<K>(key_offset(i)); }
+    V value(int i) const { return read<V>(value_offset(i)); }
+    uint32_t child(int i) const { return read<uint32_t>(child_offset(i)); }
+
+    void set_leaf(bool leaf) { write<uint16_t>(0, leaf ? 1 : 0); }
+    void set_count(int n) { write<uint16_t>(2, static_cast<uint16_t>(n)); }
+    void set_key(int i, const K &key) { write<K>(key_offset(i), key); }
+    void set_value(int i, const V &value) { write<V>(value_offset(i), value); }
+    void set_child(int i, uint32_t page) { write<uint32_t>(child_offset(i), page); }
+
+    // 空闲页复用节点头的填充字段存放下一个空闲页号
+    uint32_t next_free() const { return read<uint32_t>(4); }
+    void set_next_free(uint32_t page) { write<uint32_t>(4, page); }
+
+    int find_key(const K &target) const {
+      // 节点内二分查找第一个不小于target的位置
+      int low = 0, high = count();
+      while (low < high) {
+        int mid = (low + high) / 2;
+        if (key(mid) < target) {
+          low = mid + 1;
+        } else {
+          high = mid;
+        }
+      }
+      return low;
+    }
+
+    // 把[from, count)的键值整体右移/左移一格
+    void shift_entries(int from, int delta) {
+      int n = count();
+      if (from >= n) {
+        return;
+      }
+      std::memmove(data + key_offset(from + delta), data + key_offset(from),
+                   (n - from) * sizeof(K));
+      std::memmove(data + value_offset(from + delta),
+                   data + value_offset(from), (n - from) * sizeof(V));
+      dirty = true;
+    }
+
+    void shift_children(int from, int delta) {
+      int n = count() + 1;
+      if (is_leaf() || from >= n) {
+        return;
+      }
+      std::memmove(data + child_offset(from + delta),
+                   data + child_offset(from), (n - from) * sizeof(uint32_t));
+      dirty = true;
+    }
+
+    void insert_entry(int i, const K &key, const V &value) {
+      shift_entries(i, 1);
+      set_key(i, key);
+      set_value(i, value);
+      set_count(count() + 1);
+    }
+
+    // 从src的[from, from+n)复制键值到本节点的at处
+    void copy_entries(int at, const Node &src, int from, int n) {
+      std::memcpy(data + key_offset(at), src.data + src.key_offset(from),
+                  n * sizeof(K));
+      std::memcpy(data + value_offset(at), src.data + src.value_offset(from),
+                  n * sizeof(V));
+      dirty = true;
+    }
+
+    void copy_children(int at, const Node &src, int from, int n) {
+      std::memcpy(data + child_offset(at), src.data + src.child_offset(from),
+                  n * sizeof(uint32_t));
+      dirty = true;
+    }
+
+  private:
+    PagedBTree *tree = nullptr;
+    uint32_t page_id = 0;
+    size_t frame_index = 0;
+    char *data = nullptr;
+    bool dirty = false;
+
+    size_t key_offset(int i) const { return 8 + i * sizeof(K); }
+    size_t value_offset(int i) const {
+      return 8 + (2 * tree->t - 1) * sizeof(K) + i * sizeof(V);
+    }
+    size_t child_offset(int i) const {
+      return 8 + (2 * tree->t - 1) * (sizeof(K) + sizeof(V)) +
+             i * sizeof(uint32_t);
+    }
+
+    template <typename T> T read(size_t offset) const {
+      T result;
+      std::memcpy(&result, data + offset, sizeof(T));
+      return result;
+    }
+    template <typename T> void write(size_t offset, const T &value) {
+      std::memcpy(data + offset, &value, sizeof(T));
+      dirty = true;
+    }
+
+    void take(Node &other) {
+      tree = other.tree;
+      page_id = other.page_id;
+      frame_index = other.frame_index;
+      data = other.data;
+      dirty = other.dirty;
+      other.data = nullptr;
+    }
+
+    void release() {
+      if (data != nullptr && tree->pool) {
+        tree->pool->unpin(frame_index, dirty);
+      }
+      data = nullptr;
+    }
+  };
+
+  OpenMode mode;
+  FileHeader header;
+  bool header_dirty = false;
+  int t = 0;
+  std::unique_ptr<PageFile> file;
+  std::unique_ptr<BufferPool> pool;
+  char *mapping = nullptr;
+  size_t mapped_bytes = 0;
+  IoStats io;
+
+  Node pin(uint32_t page_id, bool fresh = false) {
+    if (mapping != nullptr) {
+      io.page_accesses++;
+      return Node(this, page_id, 0,
+                  mapping + static_cast<size_t>(page_id) * header.page_size);
+    }
+    size_t frame = pool->pin(page_id, fresh, io);
+    return Node(this, page_id, frame, pool->data(frame));
+  }
+
+  void require_writable() const {
+    if (mode == OpenMode::ReadOnlyMmap) {
+      throw std::logic_error("PagedBTree opened read-only");
+    }
+  }
+
+  void read_header(const std::string &path) {
+    PageFile probe(path, sizeof(FileHeader), false, true);
+    IoStats unused;
+    probe.read(0, &header, unused);
+    if (header.magic != kMagic || header.key_size != sizeof(K) ||
+        header.value_size != sizeof(V) ||
+        static_cast<int>(header.degree) != degree_for(header.page_size)) {
+      throw std::invalid_argument("Not a compatible PagedBTree file: " + path);
+    }
+  }
+
+  void write_header() {
+    std::vector<char> page(header.page_size, 0);
+    std::memcpy(page.data(), &header, sizeof(header));
+    file->write(0, page.data(), io);
+  }
+
+  // 优先复用空闲链表中的页，否则在文件末尾追加
+  uint32_t allocate_page() {
+    header_dirty = true;
+    if (header.free_head != kNoPage) {
+      uint32_t page_id = header.free_head;
+      header.free_head = pin(page_id).next_free();
+      return page_id;
+    }
+    return header.page_count++;
+  }
+
+  // 空闲页通过节点头的填充字段串成链表
+  void free_page(uint32_t page_id) {
+    {
+      Node node = pin(page_id);
+      node.set_count(0);
+      node.set_next_free(header.free_head);
+    }
+    header.free_head = page_id;
+    header_dirty = true;
+  }
+
+  // 分裂parent的第i个满孩子y：后t-1个键值移到新节点z，中间键上移到parent
+  void split_child(Node &parent, int i, Node &y) {
+    Node z = pin(allocate_page(), true);
+    z.set_leaf(y.is_leaf());
+    z.copy_entries(0, y, t, t - 1);
+    if (!y.is_leaf()) {
+      z.copy_children(0, y, t, t);
+    }
+    z.set_count(t - 1);
+
+    parent.shift_children(i + 1, 1);
+    parent.set_child(i + 1, z.id());
+    parent.shift_entries(i, 1);
+    parent.set_key(i, y.key(t - 1));
+    parent.set_value(i, y.value(t - 1));
+    parent.set_count(parent.count() + 1);
+
+    y.set_count(t - 1);
+  }
+
+  // 与BTreeNode::remove相同的三种情况；进入子树前保证其至少有t个键
+  bool remove_from(uint32_t page_id, const K &key) {
+    Node node = pin(page_id);
+    int idx = node.find_key(key);
+
+    if (idx < node.count() && node.key(idx) == key) {
+      if (node.is_leaf()) {
+        // 情况1：叶子节点直接删除
+        node.shift_entries(idx + 1, -1);
+        node.set_count(node.count() - 1);
+        return true;
+      }
+      // 情况2：内部节点
+      return remove_from_internal_node(node, idx);
+    }
+
+    if (node.is_leaf()) {
+      return false;
+    }
+
+    // 情况3：键值可能在子树中
+    bool last = (idx == node.count());
+    {
+      Node child = pin(node.child(idx));
+      if (child.count() < t) {
+        child = Node();
+        fill(node, idx);
+      }
+    }
+    uint32_t next = (last && idx > node.count()) ? node.child(idx - 1)
+                                                  : node.child(idx);
+    node = Node();
+    return remove_from(next, key);
+  }
+
+  bool remove_from_internal_node(Node &node, int idx) {
+    K key = node.key(idx);
+    uint32_t left_id = node.child(idx);
+    uint32_t right_id = node.child(idx + 1);
+    int left_count = pin(left_id).count();
+    if (left_count >= t) {
+      // 情况2a：用前驱替换后在左子树中删除前驱
+      std::pair<K, V> pred = predecessor(left_id);
+      node.set_key(idx, pred.first);
+      node.set_value(idx, pred.second);
+      node = Node();
+      return remove_from(left_id, pred.first);
+    }
+    int right_count = pin(right_id).count();
+    if (right_count >= t) {
+      // 情况2b：用后继替换后在右子树中删除后继
+      std::pair<K, V> succ = successor(right_id);
+      node.set_key(idx, succ.first);
+      node.set_value(idx, succ.second);
+      node = Node();
+      return remove_from(right_id, succ.first);
+    }
+    // 情况2c：合并两个孩子后在合并结果中删除
+    merge(node, idx);
+    node = Node();
+    return remove_from(left_id, key);
+  }
+
+  std::pair<K, V> predecessor(uint32_t page_id) {
+    while (true) {
+      Node node = pin(page_id);
+      if (node.is_leaf()) {
+        return {node.key(node.count() - 1), node.value(node.count() - 1)};
+      }
+      page_id = node.child(node.count());
+    }
+  }
+
+  std::pair<K, V> successor(uint32_t page_id) {
+    while (true) {
+      Node node = pin(page_id);
+      if (node.is_leaf()) {
+        return {node.key(0), node.value(0)};
+      }
+      page_id = node.child(0);
+    }
+  }
+
+  void fill(Node &node, int idx) {
+    if (idx != 0 && pin(node.child(idx - 1)).count() >= t) {
+      borrow_from_prev(node, idx);
+    } else if (idx != node.count() && pin(node.child(idx + 1)).count() >= t) {
+      borrow_from_next(node, idx);
+    } else if (idx != node.count()) {
+      merge(node, idx);
+    } else {
+      merge(node, idx - 1);
+    }
+  }
+
+  // 父节点的键下移到child开头，左兄弟的最大键上移
+  void borrow_from_prev(Node &node, int idx) {
+    Node child = pin(node.child(idx));
+    Node sibling = pin(node.child(idx - 1));
+    int sn = sibling.count();
+
+    child.shift_entries(0, 1);
+    child.set_key(0, node.key(idx - 1));
+    child.set_value(0, node.value(idx - 1));
+    if (!child.is_leaf()) {
+      child.shift_children(0, 1);
+      child.set_child(0, sibling.child(sn));
+    }
+    child.set_count(child.count() + 1);
+
+    node.set_key(idx - 1, sibling.key(sn - 1));
+    node.set_value(idx - 1, sibling.value(sn - 1));
+    sibling.set_count(sn - 1);
+  }
+
+  // 父节点的键下移到child末尾，右兄弟的最小键上移
+  void borrow_from_next(Node &node, int idx) {
+    Node child = pin(node.child(idx));
+    Node sibling = pin(node.child(idx + 1));
+    int cn = child.count();
+
+    child.set_key(cn, node.key(idx));
+    child.set_value(cn, node.value(idx));
+    if (!child.is_leaf()) {
+      child.set_child(cn + 1, sibling.child(0));
+    }
+    child.set_count(cn + 1);
+
+    node.set_key(idx, sibling.key(0));
+    node.set_value(idx, sibling.value(0));
+    sibling.shift_entries(1, -1);
+    sibling.shift_children(1, -1);
+    sibling.set_count(sibling.count() - 1);
+  }
+
+  // 把父节点的第idx个键和右孩子并入左孩子，释放右孩子的页
+  void merge(Node &node, int idx) {
+    uint32_t sibling_id = node.child(idx + 1);
+    {
+      Node child = pin(node.child(idx));
+      Node sibling = pin(sibling_id);
+      int cn = child.count();
+      int sn = sibling.count();
+
+      child.set_key(cn, node.key(idx));
+      child.set_value(cn, node.value(idx));
+      child.copy_entries(cn + 1, sibling, 0, sn);
+      if (!child.is_leaf()) {
+        child.copy_children(cn + 1, sibling, 0, sn + 1);
+      }
+      child.set_count(cn + 1 + sn);
+    }
+
+    node.shift_entries(idx + 1, -1);
+    node.shift_children(idx + 2, -1);
+    node.set_count(node.count() - 1);
+    free_page(sibling_id);
+  }
+
+  bool validate_node(uint32_t page_id, bool is_root, const K *low,
+                     const K *high, int depth, int &leaf_depth,
+                     uint64_t &counted) {
+    Node node = pin(page_id);
+    int n = node.count();
+    if (n > 2 * t - 1 || (!is_root && n < t - 1)) {
+      return false;
+    }
+    for (int i = 0; i < n; i++) {
+      K key = node.key(i);
+      if ((i > 0 && !(node.key(i - 1) < key)) ||
+          (low != nullptr && !(*low < key)) ||
+          (high != nullptr && !(key < *high))) {
+        return false;
+      }
+    }
+    counted += n;
+    if (node.is_leaf()) {
+      if (leaf_depth < 0) {
+        leaf_depth = depth;
+      }
+      return leaf_depth == depth;
+    }
+    std::vector<K> keys(n);
+    std::vector<uint32_t> children(n + 1);
+    for (int i = 0; i < n; i++) {
+      keys[i] = node.key(i);
+    }
+    for (int i = 0; i <= n; i++) {
+      children[i] = node.child(i);
+    }
+    node = Node();
+    for (int i = 0; i <= n; i++) {
+      const K *child_low = i == 0 ? low : &keys[i - 1];
+      const K *child_high = i == n ? high : &keys[i];
+      if (!validate_node(children[i], false, child_low, child_high, depth + 1,
+                         leaf_depth, counted)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template <typename Visitor> void traverse_node(uint32_t page_id, Visitor &visit) {
+    Node node = pin(page_id);
+    int n = node.count();
+    bool leaf = node.is_leaf();
+    std::vector<std::pair<K, V>> entries(n);
+    std::vector<uint32_t> children(leaf ? 0 : n + 1);
+    for (int i = 0; i < n; i++) {
+      entries[i] = {node.key(i), node.value(i)};
+    }
+    for (size_t i = 0; i < children.size(); i++) {
+      children[i] = node.child(static_cast<int>(i));
+    }
+    node = Node();
+    for (int i = 0; i < n; i++) {
+      if (!leaf) {
+        traverse_node(children[i], visit);
+      }
+      visit(entries[i].first, entries[i].second);
+    }
+    if (!leaf) {
+      traverse_node(children[n], visit);
+    }
+  }
+};
+
+} // namespace algorithms
+
+#endif // PAGED_B_TREE_H
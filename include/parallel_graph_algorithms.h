@@ -0,0 +1,437 @@
+#ifndef PARALLEL_GRAPH_ALGORITHMS_H
+#define PARALLEL_GRAPH_ALGORITHMS_H
+
+#include "disjoint_set.h"
+#include "graph_representation.h"
+#include "work_stealing_scheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace algorithms {
+
+/**
+ * @brief 并行BFS结果（按节点下标）
+ */
+struct ParallelBFSResult {
+  std::vector<int> distances; // 到源点的层数，不可达为-1
+  std::vector<int> parents;   // BFS树中的父节点下标，源点和不可达节点为-1
+  int levels;                 // 扩展的层数
+  int bottom_up_levels;       // 其中使用自底向上方式扩展的层数
+
+  ParallelBFSResult(size_t n)
+      : distances(n, -1), parents(n, -1), levels(0), bottom_up_levels(0) {}
+};
+
+/**
+ * @brief 方向优化的层同步并行BFS（Beamer等人的方法）
+ *
+ * 每一层根据边数估计在两种扩展方式之间切换：
+ * - 自顶向下：遍历前沿节点的出边，原子地认领未访问的邻居
+ * - 自底向上：每个未访问节点检查入边，只要找到一个前沿中的父节点就停止
+ * 当前沿的出边数 m_f 超过未访问部分边数 m_u / alpha 时切换到自底向上，
+ * 当前沿节点数小于 n / beta 时切回自顶向下。
+ * 低直径、高度数的图中，中间几层的前沿很大，自底向上能跳过大量边检查。
+ */
+class DirectionOptimizingBFS {
+public:
+  /**
+   * @brief 从source节点开始BFS
+   * @param graph CSR图（有向图会在内部构建转置用于自底向上）
+   * @param source 源节点编号
+   * @param num_threads 线程数量
+   * @param alpha 切换到自底向上的阈值参数
+   * @param beta 切换回自顶向下的阈值参数
+   * @return 距离与父节点（按下标）
+   */
+  static ParallelBFSResult
+  search(const CSRGraph &graph, int source,
+         size_t num_threads = std::thread::hardware_concurrency(),
+         int alpha = 14, int beta = 24) {
+    size_t n = graph.get_node_count();
+    ParallelBFSResult result(n);
+
+    int source_index = graph.get_node_index(source);
+    if (source_index == -1) {
+      return result;
+    }
+    if (num_threads == 0) {
+      num_threads = 1;
+    }
+
+    const auto &offsets = graph.get_offsets();
+    const auto &targets = graph.get_targets();
+
+    // 自底向上需要入边；无向图的入边就是出边
+    std::vector<size_t> in_offsets;
+    std::vector<int> in_sources;
+    if (graph.is_directed()) {
+      build_transpose(offsets, targets, n, in_offsets, in_sources);
+    }
+    const auto &parent_offsets = graph.is_directed() ? in_offsets : offsets;
+    const auto &parent_sources = graph.is_directed() ? in_sources : targets;
+
+    WorkStealingScheduler scheduler(num_threads);
+    AtomicBitmap visited(n);
+
+    std::vector<int> frontier = {source_index};
+    visited.test_and_set(source_index);
+    result.distances[source_index] = 0;
+
+    long long unexplored_edges = static_cast<long long>(targets.size()) -
+                                 graph.get_out_degree(source_index);
+    bool bottom_up = false;
+    int level = 0;
+
+    while (!frontier.empty()) {
+      long long frontier_edges = 0;
+      for (int u : frontier) {
+        frontier_edges += graph.get_out_degree(u);
+      }
+
+      // 方向选择
+      if (!bottom_up && frontier_edges > unexplored_edges / alpha) {
+        bottom_up = true;
+      } else if (bottom_up &&
+                 frontier.size() < n / static_cast<size_t>(beta)) {
+        bottom_up = false;
+      }
+
+      std::vector<std::vector<int>> next_parts(num_threads);
+      if (bottom_up) {
+        bottom_up_step(scheduler, num_threads, n, parent_offsets, parent_sources,
+                       frontier, visited, level, result, next_parts);
+        result.bottom_up_levels++;
+      } else {
+        top_down_step(scheduler, num_threads, offsets, targets, frontier, visited,
+                      level, result, next_parts);
+      }
+
+      frontier.clear();
+      for (const auto &part : next_parts) {
+        frontier.insert(frontier.end(), part.begin(), part.end());
+      }
+      for (int v : frontier) {
+        unexplored_edges -= graph.get_out_degree(v);
+      }
+
+      level++;
+    }
+
+    result.levels = level;
+    return result;
+  }
+
+private:
+  /**
+   * @brief 原子位图，test_and_set保证每个节点只被一个线程认领
+   */
+  class AtomicBitmap {
+  private:
+    std::vector<std::atomic<uint64_t>> words;
+
+  public:
+    AtomicBitmap(size_t n) : words((n + 63) / 64) {
+      for (auto &word : words) {
+        word.store(0, std::memory_order_relaxed);
+      }
+    }
+
+    bool test(size_t i) const {
+      return (words[i >> 6].load(std::memory_order_relaxed) >> (i & 63)) & 1;
+    }
+
+    // 置位，返回调用前是否已被置位
+    bool test_and_set(size_t i) {
+      uint64_t mask = uint64_t(1) << (i & 63);
+      return words[i >> 6].fetch_or(mask, std::memory_order_relaxed) & mask;
+    }
+  };
+
+  // 把[0, count)切成num_threads块，由调度器并行执行body(block_id, begin, end)
+  template <typename Body>
+  static void parallel_for(WorkStealingScheduler &scheduler,
+                           size_t num_threads, size_t count, Body body) {
+    if (count == 0)
+      return;
+    size_t block_size = (count + num_threads - 1) / num_threads;
+    size_t num_blocks = (count + block_size - 1) / block_size;
+
+    scheduler.parallel_for(0, num_blocks, 1, [&](size_t lo, size_t hi) {
+      for (size_t block = lo; block < hi; ++block) {
+        body(block, block * block_size,
+             std::min(block * block_size + block_size, count));
+      }
+    });
+  }
+
+  static void top_down_step(WorkStealingScheduler &scheduler,
+                            size_t num_threads,
+                            const std::vector<size_t> &offsets,
+                            const std::vector<int> &targets,
+                            const std::vector<int> &frontier,
+                            AtomicBitmap &visited, int level,
+                            ParallelBFSResult &result,
+                            std::vector<std::vector<int>> &next_parts) {
+    parallel_for(scheduler, num_threads, frontier.size(),
+                 [&](size_t thread_id, size_t begin, size_t end) {
+                   auto &next = next_parts[thread_id];
+                   for (size_t k = begin; k < end; k++) {
+                     int u = frontier[k];
+                     for (size_t e = offsets[u]; e < offsets[u + 1]; e++) {
+                       int v = targets[e];
+                       if (!visited.test(v) && !visited.test_and_set(v)) {
+                         result.parents[v] = u;
+                         result.distances[v] = level + 1;
+                         next.push_back(v);
+                       }
+                     }
+                   }
+                 });
+  }
+
+  static void bottom_up_step(WorkStealingScheduler &scheduler,
+                             size_t num_threads, size_t n,
+                             const std::vector<size_t> &parent_offsets,
+                             const std::vector<int> &parent_sources,
+                             const std::vector<int> &frontier,
+                             AtomicBitmap &visited, int level,
+                             ParallelBFSResult &result,
+                             std::vector<std::vector<int>> &next_parts) {
+    // 前沿位图只读，普通位图即可
+    std::vector<uint64_t> in_frontier((n + 63) / 64, 0);
+    for (int u : frontier) {
+      in_frontier[u >> 6] |= uint64_t(1) << (u & 63);
+    }
+
+    parallel_for(scheduler, num_threads, n,
+                 [&](size_t thread_id, size_t begin, size_t end) {
+                   auto &next = next_parts[thread_id];
+                   for (size_t v = begin; v < end; v++) {
+                     if (visited.test(v))
+                       continue;
+                     for (size_t e = parent_offsets[v];
+                          e < parent_offsets[v + 1]; e++) {
+                       int u = parent_sources[e];
+                       if ((in_frontier[u >> 6] >> (u & 63)) & 1) {
+                         visited.test_and_set(v);
+                         result.parents[v] = u;
+                         result.distances[v] = level + 1;
+                         next.push_back(v);
+                         break;
+                       }
+                     }
+                   }
+                 });
+  }
+
+  // 构建转置图（入边）的CSR数组
+  static void build_transpose(const std::vector<size_t> &offsets,
+                              const std::vector<int> &targets, size_t n,
+                              std::vector<size_t> &in_offsets,
+                              std::vector<int> &in_sources) {
+    in_offsets.assign(n + 1, 0);
+    for (int v : targets) {
+      in_offsets[v + 1]++;
+    }
+    for (size_t i = 0; i < n; i++) {
+      in_offsets[i + 1] += in_offsets[i];
+    }
+
+    in_sources.resize(targets.size());
+    std::vector<size_t> cursor(in_offsets.begin(), in_offsets.end() - 1);
+    for (size_t u = 0; u < n; u++) {
+      for (size_t e = offsets[u]; e < offsets[u + 1]; e++) {
+        in_sources[cursor[targets[e]]++] = u;
+      }
+    }
+  }
+};
+
+/**
+ * @brief 基于无锁并查集的并行连通分量
+ *
+ * 节点按块分给调度器的各个线程，每条边 (u, v) 调用一次
+ * ConcurrentDisjointSet::unite，不需要同步屏障或逐层推进，
+ * 工作量 O(m α(n)) 量级，与图的直径无关。有向图按弱连通分量计算。
+ */
+class ParallelConnectedComponents {
+public:
+  /**
+   * @brief 每个节点所在分量的标签：该分量中最小的节点下标
+   * @param grain 每个任务处理的最少节点数
+   */
+  static std::vector<int> label(WorkStealingScheduler &scheduler,
+                                const CSRGraph &graph, size_t grain = 1024) {
+    size_t n = graph.get_node_count();
+    if (n == 0) {
+      return {};
+    }
+    const auto &offsets = graph.get_offsets();
+    const auto &targets = graph.get_targets();
+    bool directed = graph.is_directed();
+    ConcurrentDisjointSet ds(static_cast<int>(n));
+
+    scheduler.parallel_for(0, n, grain, [&](size_t lo, size_t hi) {
+      for (size_t u = lo; u < hi; u++) {
+        for (size_t e = offsets[u]; e < offsets[u + 1]; e++) {
+          int v = targets[e];
+          // 无向边存了两次，只处理一次
+          if (directed || static_cast<int>(u) < v) {
+            ds.unite(static_cast<int>(u), v);
+          }
+        }
+      }
+    });
+
+    std::vector<int> labels(n);
+    scheduler.parallel_for(0, n, grain, [&](size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; i++) {
+        labels[i] = ds.find(static_cast<int>(i));
+      }
+    });
+    // 代表元素换成分量中最小的下标，结果与线程调度无关
+    std::vector<int> smallest(n, -1);
+    for (size_t i = 0; i < n; i++) {
+      int &s = smallest[labels[i]];
+      if (s == -1) {
+        s = static_cast<int>(i);
+      }
+      labels[i] = s;
+    }
+    return labels;
+  }
+
+  /**
+   * @brief 分量个数
+   */
+  static size_t count(const std::vector<int> &labels) {
+    size_t components = 0;
+    for (size_t i = 0; i < labels.size(); i++) {
+      components += labels[i] == static_cast<int>(i);
+    }
+    return components;
+  }
+};
+
+/**
+ * @brief 按层划分的拓扑序（按节点下标）
+ *
+ * order[level_offsets[k], level_offsets[k+1]) 为第 k 层：它们的所有前驱
+ * 都在更早的层中，同一层的节点互不依赖，可以同时执行。
+ */
+struct TopologicalLevels {
+  std::vector<int> order;
+  std::vector<size_t> level_offsets;
+
+  TopologicalLevels() : level_offsets(1, 0) {}
+
+  size_t level_count() const { return level_offsets.size() - 1; }
+};
+
+/**
+ * @brief 层同步的并行Kahn拓扑排序
+ *
+ * 入度用原子计数器保存。每一层并行扫描当前层节点的出边，把后继的入度
+ * 原子地减一，减到零的节点由做最后一次减法的线程放入下一层（每个节点
+ * 恰好被一个线程放入）。order 本身兼作队列，各块的新节点拼接到末尾。
+ * 同一层内的次序取决于线程调度，层的划分是确定的。
+ * 层数等于DAG的最长路径长度加一，适合宽而浅的依赖图（构建系统的任务图等）。
+ */
+class ParallelTopologicalSort {
+public:
+  /**
+   * @param grain 节点数少于 grain 的层串行处理
+   * @throws std::invalid_argument 图是无向图
+   * @throws std::runtime_error 图包含环
+   */
+  static TopologicalLevels levels(WorkStealingScheduler &scheduler,
+                                  const CSRGraph &graph,
+                                  size_t grain = 256) {
+    if (!graph.is_directed()) {
+      throw std::invalid_argument("拓扑排序需要应用于有向图");
+    }
+    size_t n = graph.get_node_count();
+    const auto &offsets = graph.get_offsets();
+    const auto &targets = graph.get_targets();
+    TopologicalLevels result;
+    result.order.reserve(n);
+
+    std::vector<std::atomic<int>> in_degree(n);
+    scheduler.parallel_for(0, n, grain, [&](size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; i++) {
+        in_degree[i].store(0, std::memory_order_relaxed);
+      }
+    });
+    scheduler.parallel_for(0, n, grain, [&](size_t lo, size_t hi) {
+      for (size_t u = lo; u < hi; u++) {
+        for (size_t e = offsets[u]; e < offsets[u + 1]; e++) {
+          in_degree[targets[e]].fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+
+    size_t chunk_count = 4 * scheduler.get_num_threads();
+    std::vector<std::vector<int>> parts(chunk_count);
+    // 把 [begin, end) 分块交给 body(块内新节点, lo, hi)，再按块的顺序追加到 order
+    auto run_chunks = [&](size_t begin, size_t end, auto body) {
+      size_t count = end - begin;
+      size_t chunks = count < grain ? 1 : std::min(chunk_count, count / grain);
+      if (chunks == 1) {
+        body(parts[0], begin, end);
+      } else {
+        scheduler.parallel_for(0, chunks, 1, [&](size_t lo, size_t hi) {
+          for (size_t c = lo; c < hi; c++) {
+            body(parts[c], begin + count * c / chunks,
+                 begin + count * (c + 1) / chunks);
+          }
+        });
+      }
+      for (size_t c = 0; c < chunks; c++) {
+        result.order.insert(result.order.end(), parts[c].begin(),
+                            parts[c].end());
+        parts[c].clear();
+      }
+    };
+
+    // 第0层：入度为零的节点
+    run_chunks(0, n, [&](std::vector<int> &next, size_t lo, size_t hi) {
+      for (size_t v = lo; v < hi; v++) {
+        if (in_degree[v].load(std::memory_order_relaxed) == 0) {
+          next.push_back(static_cast<int>(v));
+        }
+      }
+    });
+
+    while (result.order.size() > result.level_offsets.back()) {
+      size_t begin = result.level_offsets.back();
+      size_t end = result.order.size();
+      result.level_offsets.push_back(end);
+      run_chunks(begin, end, [&](std::vector<int> &next, size_t lo,
+                                 size_t hi) {
+        for (size_t k = lo; k < hi; k++) {
+          int u = result.order[k];
+          for (size_t e = offsets[u]; e < offsets[u + 1]; e++) {
+            int v = targets[e];
+            if (in_degree[v].fetch_sub(1, std::memory_order_relaxed) == 1) {
+              next.push_back(v);
+            }
+          }
+        }
+      });
+    }
+
+    if (result.order.size() != n) {
+      throw std::runtime_error("图包含环，无法进行拓扑排序");
+    }
+    return result;
+  }
+};
+
+} // namespace algorithms
+
+#endif // PARALLEL_GRAPH_ALGORITHMS_H
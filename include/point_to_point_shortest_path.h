@@ -0,0 +1,435 @@
+#ifndef POINT_TO_POINT_SHORTEST_PATH_H
+#define POINT_TO_POINT_SHORTEST_PATH_H
+
+#include "graph_representation.h"
+#include "radix_heap.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+
+/**
+ * @brief 点对点最短路径查询结果（按节点下标）
+ */
+struct PathQueryResult {
+  int distance;          // 最短距离，不可达为 int 最大值
+  std::vector<int> path; // 源点到终点的节点下标序列，不可达为空
+  size_t settled;        // 出堆（确定距离）的节点数，即搜索空间大小
+
+  PathQueryResult()
+      : distance(std::numeric_limits<int>::max()), settled(0) {}
+};
+
+/**
+ * @brief 点对点最短路径查询：提前终止的Dijkstra、双向Dijkstra、A*与ALT
+ *
+ * 构造时把图复制为正向与反向两份CSR数组，边权必须非负。每次查询复用内部的
+ * 堆与距离数组，用"时间戳"判断某个下标是否属于本次查询，因此一次查询的开销
+ * 只与搜索空间成正比，而不是 O(V)。所有搜索弹出的关键字都单调不减，
+ * 优先队列使用基数堆（radix_heap.h）。
+ *
+ * - dijkstra：弹出终点即停止。
+ * - bidirectional_dijkstra：从源点正向、从终点沿反向边同时搜索，每次扩展堆顶
+ *   较小的一侧；两侧堆顶之和不小于当前最优值 μ 时停止，搜索空间约为两个
+ *   半径减半的"球"。
+ * - astar：heuristic(v) 为 v 到终点距离的下界，且须满足一致性
+ *   h(u) ≤ w(u, v) + h(v)，此时每个节点出堆时距离已确定，不需要重新打开，
+ *   弹出的 g + h 也单调不减。
+ * - alt：A* 使用地标（Landmark）与三角不等式（Triangle inequality）给出的下界。
+ *   build_landmarks(k) 用最远点策略选 k 个地标，对每个地标 L 各做一次正向
+ *   与反向Dijkstra，以 uint32 按节点连续存放 d(L, v) 与 d(v, L)。对终点 t，
+ *   h(v) = max_L max(d(v, L) - d(t, L), d(L, t) - d(L, v))。
+ *
+ * 查询对象本身不是线程安全的；并发查询时为每个线程构造一个对象，或复制一份。
+ */
+class PointToPointSearch {
+public:
+  static constexpr int kInfinity = std::numeric_limits<int>::max();
+
+  // Graph 需满足 graph_representation.h 中的图概念
+  template <typename Graph> explicit PointToPointSearch(const Graph &graph) {
+    int n = graph.get_node_count();
+    forward.offsets.assign(n + 1, 0);
+    backward.offsets.assign(n + 1, 0);
+    for (int u = 0; u < n; u++) {
+      graph.for_each_out_edge(u, [&](int v, int weight) {
+        if (weight < 0) {
+          throw std::invalid_argument(
+              "Point-to-point search requires non-negative weights");
+        }
+        forward.offsets[u + 1]++;
+        backward.offsets[v + 1]++;
+      });
+    }
+    for (int u = 0; u < n; u++) {
+      forward.offsets[u + 1] += forward.offsets[u];
+      backward.offsets[u + 1] += backward.offsets[u];
+    }
+
+    size_t m = forward.offsets[n];
+    forward.targets.resize(m);
+    forward.weights.resize(m);
+    backward.targets.resize(m);
+    backward.weights.resize(m);
+    std::vector<size_t> forward_cursor(forward.offsets.begin(),
+                                       forward.offsets.end() - 1);
+    std::vector<size_t> backward_cursor(backward.offsets.begin(),
+                                        backward.offsets.end() - 1);
+    for (int u = 0; u < n; u++) {
+      graph.for_each_out_edge(u, [&](int v, int weight) {
+        size_t slot = forward_cursor[u]++;
+        forward.targets[slot] = v;
+        forward.weights[slot] = weight;
+        slot = backward_cursor[v]++;
+        backward.targets[slot] = u;
+        backward.weights[slot] = weight;
+      });
+    }
+
+    forward_side.resize(n);
+    backward_side.resize(n);
+  }
+
+  size_t get_node_count() const { return forward.offsets.size() - 1; }
+
+  // 单向Dijkstra，弹出终点即停止
+  PathQueryResult dijkstra(int source, int target) {
+    return astar(source, target, [](int) { return 0; });
+  }
+
+  // heuristic(v) 返回 v 到 target 的一致下界；返回 kInfinity 表示 v 不可能到达 target。
+  // 不一致的启发函数会使弹出的关键字变小，基数堆据此抛出 std::invalid_argument
+  template <typename Heuristic>
+  PathQueryResult astar(int source, int target, Heuristic heuristic) {
+    PathQueryResult result;
+    if (!valid(source) || !valid(target)) {
+      return result;
+    }
+
+    SearchSide &side = forward_side;
+    side.begin_query();
+    int h = heuristic(source);
+    if (h == kInfinity) {
+      return result;
+    }
+    side.label(source, 0, -1);
+    side.labels[source].heuristic = h;
+    side.push(h, source);
+
+    while (!side.heap.empty()) {
+      int u = side.pop().second;
+      if (side.is_closed(u)) {
+        continue;
+      }
+      side.close(u);
+      result.settled++;
+      if (u == target) {
+        result.distance = side.distance(target);
+        result.path = side.path_to(target);
+        std::reverse(result.path.begin(), result.path.end());
+        return result;
+      }
+
+      int du = side.distance(u);
+      for (size_t e = forward.offsets[u]; e < forward.offsets[u + 1]; e++) {
+        int v = forward.targets[e];
+        int dv = du + forward.weights[e];
+        if (side.is_closed(v) || dv >= side.distance(v)) {
+          continue;
+        }
+        int hv = side.is_labeled(v) ? side.labels[v].heuristic : heuristic(v);
+        if (hv == kInfinity) {
+          continue;
+        }
+        side.label(v, dv, u);
+        side.labels[v].heuristic = hv;
+        side.push(static_cast<long long>(dv) + hv, v);
+      }
+    }
+    return result;
+  }
+
+  PathQueryResult bidirectional_dijkstra(int source, int target) {
+    PathQueryResult result;
+    if (!valid(source) || !valid(target)) {
+      return result;
+    }
+
+    forward_side.begin_query();
+    backward_side.begin_query();
+    forward_side.label(source, 0, -1);
+    forward_side.push(0, source);
+    backward_side.label(target, 0, -1);
+    backward_side.push(0, target);
+
+    long long best = source == target ? 0 : kInfinity; // μ
+    int meeting = source == target ? source : -1;
+
+    while (true) {
+      long long forward_key = forward_side.top_key();
+      long long backward_key = backward_side.top_key();
+      if (forward_key + backward_key >= best) {
+        break;
+      }
+
+      bool forward_step = forward_key <= backward_key;
+      SearchSide &side = forward_step ? forward_side : backward_side;
+      SearchSide &other = forward_step ? backward_side : forward_side;
+      const Adjacency &adjacency = forward_step ? forward : backward;
+
+      int u = side.pop().second;
+      if (side.is_closed(u)) {
+        continue;
+      }
+      side.close(u);
+      result.settled++;
+
+      int du = side.distance(u);
+      for (size_t e = adjacency.offsets[u]; e < adjacency.offsets[u + 1];
+           e++) {
+        int v = adjacency.targets[e];
+        int dv = du + adjacency.weights[e];
+        if (dv < side.distance(v)) {
+          side.label(v, dv, u);
+          side.push(dv, v);
+        }
+        int other_distance = other.distance(v);
+        if (other_distance != kInfinity &&
+            static_cast<long long>(side.distance(v)) + other_distance < best) {
+          best = static_cast<long long>(side.distance(v)) + other_distance;
+          meeting = v;
+        }
+      }
+    }
+
+    if (meeting == -1) {
+      return result;
+    }
+    result.distance = static_cast<int>(best);
+    result.path = forward_side.path_to(meeting);
+    std::reverse(result.path.begin(), result.path.end());
+    std::vector<int> tail = backward_side.path_to(meeting);
+    result.path.insert(result.path.end(), tail.begin() + 1, tail.end());
+    return result;
+  }
+
+  // ALT预处理：选 k 个地标并计算距离表，重复调用会重新选取
+  void build_landmarks(size_t k) {
+    int n = get_node_count();
+    k = std::min<size_t>(k, n);
+    landmarks.clear();
+    landmark_count = k;
+    landmark_table.assign(static_cast<size_t>(n) * 2 * k, kUnreachable);
+    if (k == 0) {
+      return;
+    }
+
+    // 最远点策略：第一个地标取从节点0可达的最远节点，之后每次取到已选地标
+    // 最小距离最大的节点；不可达的节点视为无穷远，优先覆盖其他连通部分
+    std::vector<std::uint32_t> nearest(n, kUnreachable);
+    full_search(forward, forward_side, 0);
+    int next = 0;
+    for (int v = 0; v < n; v++) {
+      int d = forward_side.distance(v);
+      if (d != kInfinity && d > forward_side.distance(next)) {
+        next = v;
+      }
+    }
+
+    for (size_t i = 0; i < k; i++) {
+      landmarks.push_back(next);
+      full_search(forward, forward_side, next);
+      for (int v = 0; v < n; v++) {
+        std::uint32_t d = encode(forward_side.distance(v));
+        landmark_table[static_cast<size_t>(v) * 2 * k + i] = d;
+        nearest[v] = std::min(nearest[v], d);
+      }
+      full_search(backward, backward_side, next);
+      for (int v = 0; v < n; v++) {
+        landmark_table[static_cast<size_t>(v) * 2 * k + k + i] =
+            encode(backward_side.distance(v));
+      }
+
+      // 已选地标的 nearest 为0；所有节点都与地标重合时提前结束
+      next = 0;
+      for (int v = 1; v < n; v++) {
+        if (nearest[v] > nearest[next]) {
+          next = v;
+        }
+      }
+      if (nearest[next] == 0) {
+        break;
+      }
+    }
+  }
+
+  const std::vector<int> &get_landmarks() const { return landmarks; }
+
+  // 地标给出的 d(v, target) 下界；确定不可达时返回 kInfinity
+  int landmark_bound(int v, int target) const {
+    size_t k = landmark_count;
+    const std::uint32_t *from_v = &landmark_table[static_cast<size_t>(v) * 2 * k];
+    const std::uint32_t *to_v = from_v + k;
+    const std::uint32_t *from_t =
+        &landmark_table[static_cast<size_t>(target) * 2 * k];
+    const std::uint32_t *to_t = from_t + k;
+    long long bound = 0;
+    for (size_t i = 0; i < k; i++) {
+      // d(v, t) ≥ d(v, L) - d(t, L)；v 到不了 L 而 t 能到，则 v 到不了 t
+      if (to_v[i] == kUnreachable) {
+        if (to_t[i] != kUnreachable) {
+          return kInfinity;
+        }
+      } else if (to_t[i] != kUnreachable) {
+        bound = std::max(bound, static_cast<long long>(to_v[i]) - to_t[i]);
+      }
+      // d(v, t) ≥ d(L, t) - d(L, v)；L 能到 v 而到不了 t，则 v 到不了 t
+      if (from_t[i] == kUnreachable) {
+        if (from_v[i] != kUnreachable) {
+          return kInfinity;
+        }
+      } else if (from_v[i] != kUnreachable) {
+        bound = std::max(bound, static_cast<long long>(from_t[i]) - from_v[i]);
+      }
+    }
+    return static_cast<int>(bound);
+  }
+
+  // 以地标下界为启发函数的A*；未调用 build_landmarks 时等同于 dijkstra
+  PathQueryResult alt(int source, int target) {
+    if (landmark_count == 0 || !valid(target)) {
+      return dijkstra(source, target);
+    }
+    return astar(source, target,
+                 [this, target](int v) { return landmark_bound(v, target); });
+  }
+
+private:
+  static constexpr std::uint32_t kUnreachable =
+      std::numeric_limits<std::uint32_t>::max();
+
+  struct Adjacency {
+    std::vector<size_t> offsets;
+    std::vector<int> targets;
+    std::vector<int> weights;
+  };
+
+  // 一个搜索方向的状态：label.stamp == epoch 时距离、前驱与启发值属于本次
+  // 查询，label.closed == epoch 时节点已出堆。各字段放在同一个结构中，
+  // 访问一个节点只触及一条缓存行。
+  struct SearchSide {
+    struct Label {
+      std::uint32_t stamp = 0;
+      std::uint32_t closed = 0;
+      int distance = 0;
+      int parent = -1;
+      int heuristic = 0; // A* 中首次标记时计算一次
+    };
+
+    std::vector<Label> labels;
+    std::uint32_t epoch = 0;
+    RadixHeap<int> heap; // 各种搜索弹出的关键字都单调不减
+
+    void resize(size_t n) {
+      labels.assign(n, Label());
+      epoch = 0;
+    }
+
+    void begin_query() {
+      heap.clear();
+      if (++epoch == 0) { // 时间戳回绕，整体清零一次
+        std::fill(labels.begin(), labels.end(), Label());
+        epoch = 1;
+      }
+    }
+
+    bool is_labeled(int v) const { return labels[v].stamp == epoch; }
+
+    int distance(int v) const {
+      return is_labeled(v) ? labels[v].distance : kInfinity;
+    }
+
+    void label(int v, int distance, int parent) {
+      labels[v].stamp = epoch;
+      labels[v].distance = distance;
+      labels[v].parent = parent;
+    }
+
+    bool is_closed(int v) const { return labels[v].closed == epoch; }
+
+    void close(int v) { labels[v].closed = epoch; }
+
+    void push(long long key, int v) {
+      heap.push(static_cast<std::uint32_t>(key), v);
+    }
+
+    std::pair<std::uint32_t, int> pop() { return heap.pop(); }
+
+    // 最小关键字（可能属于过期项，因而不大于真实的最小值），堆空时返回 kInfinity
+    long long top_key() {
+      return heap.empty() ? kInfinity : static_cast<long long>(heap.top_key());
+    }
+
+    // 从 v 沿 parent 回溯到搜索起点，返回 v, parent(v), ..., 起点
+    std::vector<int> path_to(int v) const {
+      std::vector<int> path;
+      for (; v != -1; v = labels[v].parent) {
+        path.push_back(v);
+      }
+      return path;
+    }
+  };
+
+  Adjacency forward;
+  Adjacency backward;
+  SearchSide forward_side;
+  SearchSide backward_side;
+
+  std::vector<int> landmarks;
+  size_t landmark_count = 0;
+  // 每个节点 2k 项连续存放：[v * 2k + i] = d(L_i, v)，[v * 2k + k + i] = d(v, L_i)
+  std::vector<std::uint32_t> landmark_table;
+
+  bool valid(int v) const {
+    return v >= 0 && static_cast<size_t>(v) < get_node_count();
+  }
+
+  static std::uint32_t encode(int distance) {
+    return distance == kInfinity ? kUnreachable
+                                 : static_cast<std::uint32_t>(distance);
+  }
+
+  // 完整的单源Dijkstra，结果留在 side 中
+  static void full_search(const Adjacency &adjacency, SearchSide &side,
+                          int source) {
+    side.begin_query();
+    side.label(source, 0, -1);
+    side.push(0, source);
+    while (!side.heap.empty()) {
+      int u = side.pop().second;
+      if (side.is_closed(u)) {
+        continue;
+      }
+      side.close(u);
+      int du = side.distance(u);
+      for (size_t e = adjacency.offsets[u]; e < adjacency.offsets[u + 1];
+           e++) {
+        int v = adjacency.targets[e];
+        int dv = du + adjacency.weights[e];
+        if (dv < side.distance(v)) {
+          side.label(v, dv, u);
+          side.push(dv, v);
+        }
+      }
+    }
+  }
+};
+
+} // namespace algorithms
+
+#endif // POINT_TO_POINT_SHORTEST_PATH_H
@@ -1,14 +1,20 @@
 #ifndef POLYNOMIALS_AND_FFT_H
 #define POLYNOMIALS_AND_FFT_H
 
+#include "cpu_features.h"
+#include "gemm_kernel.h"
+#include "number_theoretic_transform.h"
 #include <algorithm>
 #include <cmath>
 #include <complex>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <random>
 #include <sstream>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace algorithms {
@@ -144,6 +150,93 @@ public:
       return result;
     }
 
+    /**
+     * @brief 适合高次多项式的单点求值
+     *
+     * 每8个系数一块，块内用Estrin格式（相邻两项合并为 c0 + c1·x，
+     * 再以 x²、x⁴ 逐级合并，依赖链深3层）；块之间对 y = x⁸ 做Horner，
+     * 奇偶块各走一条步长为 y² 的链。串行乘加链的长度从 n 降到约 n/16，
+     * 各块的计算相互独立，可以同时在流水线中执行。
+     * @param x 自变量值
+     * @return 多项式在x处的值
+     */
+    double evaluate_estrin(double x) const {
+      size_t m = coefficients.size();
+      if (m < 16) {
+        return horner(x);
+      }
+      double x2 = x * x, x4 = x2 * x2, y = x4 * x4, y2 = y * y;
+      double tail[8] = {};
+      for (size_t i = m / 8 * 8; i < m; i++) {
+        tail[i % 8] = coefficients[i];
+      }
+      auto block = [&](size_t b) {
+        const double *c = 8 * b + 8 <= m ? coefficients.data() + 8 * b : tail;
+        double p01 = c[0] + c[1] * x, p23 = c[2] + c[3] * x;
+        double p45 = c[4] + c[5] * x, p67 = c[6] + c[7] * x;
+        return (p01 + p23 * x2) + (p45 + p67 * x2) * x4;
+      };
+      // p(x) = E(y²) + y·O(y²)，E、O 分别由偶数块与奇数块组成
+      size_t blocks = (m + 7) / 8;
+      double even = 0.0, odd = 0.0;
+      for (size_t j = (blocks + 1) / 2; j-- > 0;) {
+        even = even * y2 + block(2 * j);
+        odd = odd * y2 + (2 * j + 1 < blocks ? block(2 * j + 1) : 0.0);
+      }
+      return even + y * odd;
+    }
+
+    /**
+     * @brief 批量求值：out[i] = p(xs[i])
+     *
+     * 每个点做Horner，向量化展开在点之间：支持AVX2与FMA的CPU上一次处理
+     * 16个点（4个寄存器各4个点），16条乘加链互不依赖，掩盖了FMA的延迟；
+     * 系数只广播一次供16个点共用。
+     * @param xs 自变量数组
+     * @param count 点数
+     * @param out 结果数组，可以与 xs 相同
+     */
+    void evaluate(const double *xs, size_t count, double *out) const {
+      if (coefficients.empty()) {
+        std::fill(out, out + count, 0.0);
+        return;
+      }
+#ifdef ALGORITHMS_GEMM_X86
+      if (CpuFeatures::avx2() && CpuFeatures::fma()) {
+        evaluate_avx2(xs, count, out);
+        return;
+      }
+#endif
+      size_t m = coefficients.size(), i = 0;
+      for (; i + 4 <= count; i += 4) {
+        double x[4], acc[4];
+        for (size_t lane = 0; lane < 4; lane++) {
+          x[lane] = xs[i + lane];
+          acc[lane] = coefficients[m - 1];
+        }
+        for (size_t k = m - 1; k-- > 0;) {
+          for (size_t lane = 0; lane < 4; lane++) {
+            acc[lane] = acc[lane] * x[lane] + coefficients[k];
+          }
+        }
+        std::copy(acc, acc + 4, out + i);
+      }
+      for (; i < count; i++) {
+        out[i] = horner(xs[i]);
+      }
+    }
+
+    /**
+     * @brief 批量求值
+     * @param xs 自变量值
+     * @return 各点处的值
+     */
+    std::vector<double> evaluate(const std::vector<double> &xs) const {
+      std::vector<double> values(xs.size());
+      evaluate(xs.data(), xs.size(), values.data());
+      return values;
+    }
+
     /**
      * @brief 转换为字符串表示
      * @return 多项式字符串
@@ -194,6 +287,301 @@ public:
      * @return 系数向量
      */
     const std::vector<double> &get_coefficients() const { return coefficients; }
+
+  private:
+    double horner(double x) const {
+      double result = 0.0;
+      for (size_t i = coefficients.size(); i-- > 0;) {
+        result = result * x + coefficients[i];
+      }
+      return result;
+    }
+
+#ifdef ALGORITHMS_GEMM_X86
+    __attribute__((target("avx2,fma"))) void
+    evaluate_avx2(const double *xs, size_t count, double *out) const {
+      const double *c = coefficients.data();
+      size_t m = coefficients.size(), i = 0;
+      for (; i + 16 <= count; i += 16) {
+        __m256d x0 = _mm256_loadu_pd(xs + i), x1 = _mm256_loadu_pd(xs + i + 4);
+        __m256d x2 = _mm256_loadu_pd(xs + i + 8), x3 = _mm256_loadu_pd(xs + i + 12);
+        __m256d a0 = _mm256_set1_pd(c[m - 1]), a1 = a0, a2 = a0, a3 = a0;
+        for (size_t k = m - 1; k-- > 0;) {
+          __m256d ck = _mm256_set1_pd(c[k]);
+          a0 = _mm256_fmadd_pd(a0, x0, ck);
+          a1 = _mm256_fmadd_pd(a1, x1, ck);
+          a2 = _mm256_fmadd_pd(a2, x2, ck);
+          a3 = _mm256_fmadd_pd(a3, x3, ck);
+        }
+        _mm256_storeu_pd(out + i, a0);
+        _mm256_storeu_pd(out + i + 4, a1);
+        _mm256_storeu_pd(out + i + 8, a2);
+        _mm256_storeu_pd(out + i + 12, a3);
+      }
+      for (; i + 4 <= count; i += 4) {
+        __m256d x = _mm256_loadu_pd(xs + i);
+        __m256d a = _mm256_set1_pd(c[m - 1]);
+        for (size_t k = m - 1; k-- > 0;) {
+          a = _mm256_fmadd_pd(a, x, _mm256_set1_pd(c[k]));
+        }
+        _mm256_storeu_pd(out + i, a);
+      }
+      for (; i < count; i++) {
+        out[i] = horner(xs[i]);
+      }
+    }
+#endif
+  };
+
+  /**
+   * @brief 预先规划的原地FFT
+   *
+   * 对固定长度n反复做变换时，把与数据无关的工作提前到构造时完成：
+   * - 位反转置换预先算成交换对列表
+   * - 每一级的旋转因子直接用cos/sin计算并按级连续存放（不用 omega *= omega_n
+   *   递推，误差不随长度累积）
+   * - 蝶形运算采用基4（log2 n为奇数时先做一级基2），在支持AVX的CPU上
+   *   每次处理两个复数
+   * - n不是2的幂时用Bluestein算法，转化为长度为2的幂的循环卷积
+   * 变换方向与 fft/iterative_fft 相同：正变换使用 ω_n = e^{2πi/n}，逆变换
+   * 结果除以n。非2的幂长度的变换使用计划内的临时缓冲区，同一个计划对象
+   * 不要在多个线程中同时使用。
+   */
+  class FFTPlan {
+  public:
+    explicit FFTPlan(size_t size) : n(size) {
+      if (n == 0) {
+        throw std::invalid_argument("FFT长度必须为正数");
+      }
+      if ((n & (n - 1)) == 0) {
+        build_power_of_two();
+      } else {
+        build_bluestein();
+      }
+    }
+
+    size_t size() const { return n; }
+    bool uses_bluestein() const { return inner != nullptr; }
+
+    void forward(Complex *data) { transform(data, false); }
+    void inverse(Complex *data) { transform(data, true); }
+
+    void forward(std::vector<Complex> &data) {
+      check_size(data);
+      forward(data.data());
+    }
+    void inverse(std::vector<Complex> &data) {
+      check_size(data);
+      inverse(data.data());
+    }
+
+  private:
+    size_t n;
+    int log_n = 0;
+    std::vector<std::pair<uint32_t, uint32_t>> swaps;
+    // twiddles[inverse]：每个基4级依次存放 w^j, w^{2j}, w^{3j}（j < q）
+    std::vector<Complex> twiddles[2];
+
+    // Bluestein：chirp[j] = e^{πi j²/n}，chirp_fft为共轭chirp序列的FFT
+    std::unique_ptr<FFTPlan> inner;
+    std::vector<Complex> chirp;
+    std::vector<Complex> chirp_fft;
+    std::vector<Complex> scratch;
+
+    void check_size(const std::vector<Complex> &data) const {
+      if (data.size() != n) {
+        throw std::invalid_argument("FFT输入长度与计划长度不一致");
+      }
+    }
+
+    // 显式展开的复数乘法，避免std::complex为处理NaN/Inf调用库函数
+    static Complex mul(const Complex &a, const Complex &b) {
+      return Complex(a.real() * b.real() - a.imag() * b.imag(),
+                     a.real() * b.imag() + a.imag() * b.real());
+    }
+
+    void build_power_of_two() {
+      while ((size_t(1) << log_n) < n) {
+        log_n++;
+      }
+      for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        while (j & bit) {
+          j ^= bit;
+          bit >>= 1;
+        }
+        j |= bit;
+        if (i < j) {
+          swaps.push_back({static_cast<uint32_t>(i), static_cast<uint32_t>(j)});
+        }
+      }
+      for (int direction = 0; direction < 2; direction++) {
+        double sign = direction ? -1.0 : 1.0;
+        for (size_t q = (log_n % 2) ? 2 : 1; q * 4 <= n; q *= 4) {
+          double step = sign * 2.0 * M_PI / (4 * q);
+          for (size_t power = 1; power <= 3; power++) {
+            for (size_t j = 0; j < q; j++) {
+              double angle = step * static_cast<double>(power * j);
+              twiddles[direction].push_back(
+                  Complex(std::cos(angle), std::sin(angle)));
+            }
+          }
+        }
+      }
+    }
+
+    void build_bluestein() {
+      size_t m = 1;
+      while (m < 2 * n - 1) {
+        m <<= 1;
+      }
+      inner.reset(new FFTPlan(m));
+      chirp.resize(n);
+      for (size_t j = 0; j < n; j++) {
+        // j²对2n取模后再求角度，避免大j时的精度损失
+        uint64_t square = static_cast<uint64_t>(j) * j % (2 * n);
+        double angle = M_PI * static_cast<double>(square) / n;
+        chirp[j] = Complex(std::cos(angle), std::sin(angle));
+      }
+      chirp_fft.assign(m, Complex(0.0, 0.0));
+      chirp_fft[0] = std::conj(chirp[0]);
+      for (size_t j = 1; j < n; j++) {
+        chirp_fft[j] = chirp_fft[m - j] = std::conj(chirp[j]);
+      }
+      inner->forward(chirp_fft);
+      scratch.resize(m);
+    }
+
+    void transform(Complex *data, bool inverse) {
+      if (inner != nullptr) {
+        bluestein(data, inverse);
+        return;
+      }
+
+      for (const auto &swap : swaps) {
+        std::swap(data[swap.first], data[swap.second]);
+      }
+
+      size_t q = 1;
+      if (log_n % 2) {
+        for (size_t i = 0; i < n; i += 2) {
+          Complex u = data[i], v = data[i + 1];
+          data[i] = u + v;
+          data[i + 1] = u - v;
+        }
+        q = 2;
+      }
+      const Complex *tw = twiddles[inverse].data();
+      for (; q * 4 <= n; q *= 4) {
+#ifdef ALGORITHMS_GEMM_X86
+        if (q >= 2 && CpuFeatures::avx()) {
+          radix4_avx(data, q, tw, inverse);
+        } else {
+          radix4(data, q, tw, inverse);
+        }
+#else
+        radix4(data, q, tw, inverse);
+#endif
+        tw += 3 * q;
+      }
+
+      if (inverse) {
+        double scale = 1.0 / static_cast<double>(n);
+        for (size_t i = 0; i < n; ++i) {
+          data[i] *= scale;
+        }
+      }
+    }
+
+    /**
+     * 基4蝶形：长度为4q的块由四个长度为q的子变换组成。位反转后块内顺序是
+     * 下标模4余0、2、1、3的子序列，因此第2、3段分别乘 w^{2j}、w^j。
+     */
+    void radix4(Complex *data, size_t q, const Complex *tw, bool inverse) const {
+      const Complex *w1 = tw, *w2 = tw + q, *w3 = tw + 2 * q;
+      for (size_t block = 0; block < n; block += 4 * q) {
+        Complex *p = data + block;
+        for (size_t j = 0; j < q; j++) {
+          Complex a0 = p[j];
+          Complex a2 = mul(p[j + q], w2[j]);
+          Complex a1 = mul(p[j + 2 * q], w1[j]);
+          Complex a3 = mul(p[j + 3 * q], w3[j]);
+          Complex t0 = a0 + a2, t1 = a0 - a2;
+          Complex t2 = a1 + a3, d = a1 - a3;
+          // 乘以 ω_4：正变换为 i，逆变换为 -i
+          Complex t3 = inverse ? Complex(d.imag(), -d.real())
+                               : Complex(-d.imag(), d.real());
+          p[j] = t0 + t2;
+          p[j + q] = t1 + t3;
+          p[j + 2 * q] = t0 - t2;
+          p[j + 3 * q] = t1 - t3;
+        }
+      }
+    }
+
+#ifdef ALGORITHMS_GEMM_X86
+    // 两个复数同时相乘：[a0 b0 a1 b1] * [c0 d0 c1 d1]
+    __attribute__((target("avx"))) static inline __m256d cmul(__m256d x,
+                                                              __m256d w) {
+      __m256d wr = _mm256_movedup_pd(w);
+      __m256d wi = _mm256_permute_pd(w, 0xF);
+      __m256d xs = _mm256_permute_pd(x, 0x5);
+      return _mm256_addsub_pd(_mm256_mul_pd(x, wr), _mm256_mul_pd(xs, wi));
+    }
+
+    __attribute__((target("avx"))) void radix4_avx(Complex *data, size_t q,
+                                                   const Complex *tw,
+                                                   bool inverse) const {
+      const double *w1 = reinterpret_cast<const double *>(tw);
+      const double *w2 = w1 + 2 * q, *w3 = w1 + 4 * q;
+      // 交换实部虚部后取反：正变换取反实部（乘i），逆变换取反虚部（乘-i）
+      __m256d flip = inverse ? _mm256_set_pd(-0.0, 0.0, -0.0, 0.0)
+                             : _mm256_set_pd(0.0, -0.0, 0.0, -0.0);
+      for (size_t block = 0; block < n; block += 4 * q) {
+        double *p0 = reinterpret_cast<double *>(data + block);
+        double *p1 = p0 + 2 * q, *p2 = p0 + 4 * q, *p3 = p0 + 6 * q;
+        for (size_t j = 0; j < 2 * q; j += 4) {
+          __m256d a0 = _mm256_loadu_pd(p0 + j);
+          __m256d a2 = cmul(_mm256_loadu_pd(p1 + j), _mm256_loadu_pd(w2 + j));
+          __m256d a1 = cmul(_mm256_loadu_pd(p2 + j), _mm256_loadu_pd(w1 + j));
+          __m256d a3 = cmul(_mm256_loadu_pd(p3 + j), _mm256_loadu_pd(w3 + j));
+          __m256d t0 = _mm256_add_pd(a0, a2), t1 = _mm256_sub_pd(a0, a2);
+          __m256d t2 = _mm256_add_pd(a1, a3);
+          __m256d t3 = _mm256_xor_pd(
+              _mm256_permute_pd(_mm256_sub_pd(a1, a3), 0x5), flip);
+          _mm256_storeu_pd(p0 + j, _mm256_add_pd(t0, t2));
+          _mm256_storeu_pd(p1 + j, _mm256_add_pd(t1, t3));
+          _mm256_storeu_pd(p2 + j, _mm256_sub_pd(t0, t2));
+          _mm256_storeu_pd(p3 + j, _mm256_sub_pd(t1, t3));
+        }
+      }
+    }
+#endif
+
+    /**
+     * Bluestein：jk = (j² + k² - (k-j)²) / 2，于是
+     * X[k] = chirp[k] * Σ_j (x[j] chirp[j]) conj(chirp[k-j])，
+     * 右边是一个循环卷积，用长度m >= 2n-1的2的幂FFT计算。
+     * 逆变换利用 IDFT(x) = conj(DFT(conj(x))) / n。
+     */
+    void bluestein(Complex *data, bool inverse) {
+      size_t m = scratch.size();
+      for (size_t j = 0; j < n; j++) {
+        Complex x = inverse ? std::conj(data[j]) : data[j];
+        scratch[j] = mul(x, chirp[j]);
+      }
+      std::fill(scratch.begin() + n, scratch.end(), Complex(0.0, 0.0));
+      inner->forward(scratch.data());
+      for (size_t j = 0; j < m; j++) {
+        scratch[j] = mul(scratch[j], chirp_fft[j]);
+      }
+      inner->inverse(scratch.data());
+      double scale = inverse ? 1.0 / static_cast<double>(n) : 1.0;
+      for (size_t k = 0; k < n; k++) {
+        Complex y = mul(scratch[k], chirp[k]);
+        data[k] = inverse ? std::conj(y) * scale : y;
+      }
+    }
   };
 
   /**
@@ -372,18 +760,19 @@ public:
       b[i] = Complex(B[i], 0.0);
     }
 
-    // 计算FFT
-    std::vector<Complex> A_fft = iterative_fft(a);
-    std::vector<Complex> B_fft = iterative_fft(b);
+    // 计算FFT（两次正变换和一次逆变换共用同一个计划）
+    FFTPlan plan(n);
+    plan.forward(a);
+    plan.forward(b);
 
     // 点值相乘
-    std::vector<Complex> C_fft(n);
+    std::vector<Complex> c(n);
     for (size_t i = 0; i < n; ++i) {
-      C_fft[i] = A_fft[i] * B_fft[i];
+      c[i] = a[i] * b[i];
     }
 
     // 计算逆FFT
-    std::vector<Complex> c = iterative_fft(C_fft, true);
+    plan.inverse(c);
 
     // 提取实数部分作为多项式系数
     std::vector<double> result_coeffs(product_degree + 1);
@@ -394,6 +783,183 @@ public:
     return Polynomial(result_coeffs);
   }
 
+  /**
+   * @brief 模素数的子积树（subproduct tree）：O(n log² n) 的多点求值与插值
+   *
+   * 在 Z_P（P = 998244353）上精确计算，多项式乘法用数论变换（FFT在有限域
+   * 上的版本）。叶子为 x − x_i，内部节点为两个子节点之积，根为
+   * M(x) = ∏(x − x_i)；每层乘法的总规模为 O(n)。
+   * - 多点求值：自顶向下 r_子 = r_父 mod M_子，叶子处的余式即 p(x_i)。
+   *   除法用牛顿迭代求 rev(M) 的逆级数，化为两次乘法；
+   *   区间不超过 kDirectEvaluationLimit 个点时直接对余式做Horner。
+   * - 插值：p(x) = Σ y_i/M'(x_i) · M(x)/(x − x_i)，先用多点求值得到 M'(x_i)，
+   *   批量求逆后自底向上合并 L·M_右 + R·M_左。
+   * 同一组点建一次树，可以反复对不同的多项式求值或插值。
+   * 双精度下余数树在单项式基中数值不稳定（[-1, 1] 内几十个随机点后误差
+   * 即失控），所以只提供精确的模P版本；实系数多项式在大量点上求值用
+   * Polynomial 的批量 evaluate。
+   */
+  class SubproductTree {
+  public:
+    using Ntt = NTT998244353;
+    static constexpr uint32_t modulus = Ntt::modulus;
+
+    /**
+     * @param points 求值点或插值节点（按模P取余）
+     * @throws std::invalid_argument 如果没有点
+     */
+    explicit SubproductTree(const std::vector<uint32_t> &points) {
+      if (points.empty()) {
+        throw std::invalid_argument("子积树至少需要一个点");
+      }
+      levels.emplace_back();
+      for (uint32_t x : points) {
+        this->points.push_back(x % modulus);
+        levels[0].push_back({x % modulus == 0 ? 0 : modulus - x % modulus, 1});
+      }
+      while (levels.back().size() > 1) {
+        const auto &below = levels.back();
+        std::vector<std::vector<uint32_t>> above;
+        for (size_t i = 0; i + 1 < below.size(); i += 2) {
+          above.push_back(mod_multiply(below[i], below[i + 1]));
+        }
+        if (below.size() % 2) {
+          above.push_back(below.back());
+        }
+        levels.push_back(std::move(above));
+      }
+    }
+
+    size_t size() const { return points.size(); }
+
+    /**
+     * @brief M(x) = ∏(x − x_i) 的系数（升幂）
+     */
+    const std::vector<uint32_t> &root() const { return levels.back()[0]; }
+
+    /**
+     * @brief 多点求值
+     * @param coefficients 多项式系数（升幂，按模P取余）
+     * @return p(x_0), …, p(x_{n−1}) mod P
+     */
+    std::vector<uint32_t> evaluate(const std::vector<uint32_t> &coefficients) const {
+      std::vector<uint32_t> reduced(coefficients.size());
+      for (size_t i = 0; i < coefficients.size(); ++i) {
+        reduced[i] = coefficients[i] % modulus;
+      }
+      std::vector<uint32_t> values(points.size());
+      descend(levels.size() - 1, 0, mod_remainder(reduced, root()), values);
+      return values;
+    }
+
+    /**
+     * @brief 插值：次数小于n、在各节点取给定值的多项式
+     * @return 系数（升幂，长度n）
+     * @throws std::invalid_argument 如果值的个数与节点数不同或节点模P重复
+     */
+    std::vector<uint32_t> interpolate(const std::vector<uint32_t> &values) const {
+      if (values.size() != points.size()) {
+        throw std::invalid_argument("插值的值与节点数量不一致");
+      }
+      std::vector<uint32_t> sorted = points;
+      std::sort(sorted.begin(), sorted.end());
+      if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+        throw std::invalid_argument("插值节点不能重复");
+      }
+
+      const std::vector<uint32_t> &m = root();
+      std::vector<uint32_t> derivative(m.size() - 1);
+      for (size_t i = 1; i < m.size(); ++i) {
+        derivative[i - 1] = mod_mul(static_cast<uint32_t>(i % modulus), m[i]);
+      }
+      std::vector<uint32_t> weights = evaluate(derivative);
+      std::vector<uint64_t> inverses = NumberTheoryAlgorithms::batch_mod_inverse(
+          std::vector<uint64_t>(weights.begin(), weights.end()), modulus);
+
+      std::vector<std::vector<uint32_t>> current(points.size());
+      for (size_t i = 0; i < points.size(); ++i) {
+        current[i] = {mod_mul(values[i] % modulus, static_cast<uint32_t>(inverses[i]))};
+      }
+      for (size_t level = 0; level + 1 < levels.size(); ++level) {
+        const auto &moduli = levels[level];
+        std::vector<std::vector<uint32_t>> above;
+        for (size_t i = 0; i + 1 < current.size(); i += 2) {
+          std::vector<uint32_t> left = mod_multiply(current[i], moduli[i + 1]);
+          std::vector<uint32_t> right = mod_multiply(current[i + 1], moduli[i]);
+          if (left.size() < right.size()) {
+            std::swap(left, right);
+          }
+          for (size_t k = 0; k < right.size(); ++k) {
+            left[k] = Ntt::add(left[k], right[k]);
+          }
+          above.push_back(std::move(left));
+        }
+        if (current.size() % 2) {
+          above.push_back(std::move(current.back()));
+        }
+        current = std::move(above);
+      }
+      current[0].resize(points.size(), 0);
+      return current[0];
+    }
+
+  private:
+    std::vector<uint32_t> points;
+    // levels[l][i] 覆盖叶子 [i·2^l, (i+1)·2^l) ∩ [0, n)，均为首一多项式
+    std::vector<std::vector<std::vector<uint32_t>>> levels;
+
+    void descend(size_t level, size_t index, std::vector<uint32_t> r,
+                 std::vector<uint32_t> &values) const {
+      size_t first = index << level;
+      size_t last = std::min(points.size(), (index + 1) << level);
+      if (last - first <= kDirectEvaluationLimit) {
+        for (size_t i = first; i < last; ++i) {
+          uint32_t value = 0;
+          for (size_t k = r.size(); k-- > 0;) {
+            value = Ntt::add(mod_mul(value, points[i]), r[k]);
+          }
+          values[i] = value;
+        }
+        return;
+      }
+      const auto &children = levels[level - 1];
+      size_t left = 2 * index;
+      if (left + 1 == children.size()) {
+        descend(level - 1, left, std::move(r), values); // 奇数个节点时直接上移的节点
+        return;
+      }
+      descend(level - 1, left, mod_remainder(r, children[left]), values);
+      descend(level - 1, left + 1, mod_remainder(r, children[left + 1]), values);
+    }
+  };
+
+  /**
+   * @brief 模P多点求值，O(n log² n)，n 为点数与系数个数中的较大者
+   * @param coefficients 多项式系数（升幂）
+   * @param points 求值点
+   * @return 各点处的值 mod P
+   */
+  static std::vector<uint32_t>
+  multipoint_evaluate_mod(const std::vector<uint32_t> &coefficients,
+                          const std::vector<uint32_t> &points) {
+    if (points.empty()) {
+      return {};
+    }
+    return SubproductTree(points).evaluate(coefficients);
+  }
+
+  /**
+   * @brief 模P插值，O(n log² n)
+   * @param xs 模P互不相同的节点
+   * @param ys 节点处的值
+   * @return 次数小于n的插值多项式的系数（升幂）
+   * @throws std::invalid_argument 如果节点为空、重复或与值的个数不同
+   */
+  static std::vector<uint32_t> interpolate_mod(const std::vector<uint32_t> &xs,
+                                               const std::vector<uint32_t> &ys) {
+    return SubproductTree(xs).interpolate(ys);
+  }
+
   /**
    * @brief 生成随机多项式
    *
@@ -451,6 +1017,89 @@ public:
 
     return true;
   }
+
+private:
+  static constexpr size_t kNaiveMultiplyLimit = 32;   // 较短一方不超过此项数时直接相乘
+  static constexpr size_t kNaiveDivisionLimit = 64;   // 商或除式不超过此项数时做长除法
+  static constexpr size_t kDirectEvaluationLimit = 32; // 子积树中直接求值的区间大小
+
+  static uint32_t mod_mul(uint32_t a, uint32_t b) {
+    return static_cast<uint32_t>(static_cast<uint64_t>(a) * b %
+                                 SubproductTree::modulus);
+  }
+
+  // 模P多项式乘法：短的一方不超过 kNaiveMultiplyLimit 项时直接相乘，否则用NTT
+  static std::vector<uint32_t> mod_multiply(const std::vector<uint32_t> &a,
+                                            const std::vector<uint32_t> &b) {
+    if (a.empty() || b.empty()) {
+      return {};
+    }
+    if (std::min(a.size(), b.size()) > kNaiveMultiplyLimit) {
+      return SubproductTree::Ntt::convolve(a, b);
+    }
+    constexpr uint64_t p = SubproductTree::modulus;
+    std::vector<uint64_t> c(a.size() + b.size() - 1, 0);
+    for (size_t i = 0; i < a.size(); ++i) {
+      for (size_t j = 0; j < b.size(); ++j) {
+        c[i + j] = (c[i + j] + static_cast<uint64_t>(a[i]) * b[j]) % p;
+      }
+    }
+    return std::vector<uint32_t>(c.begin(), c.end());
+  }
+
+  // g 满足 f·g ≡ 1 (mod x^k)，要求 f[0] = 1；牛顿迭代 g ← g(2 − f·g)，精度逐轮翻倍
+  static std::vector<uint32_t> mod_inverse_series(const std::vector<uint32_t> &f,
+                                                  size_t k) {
+    std::vector<uint32_t> g = {1};
+    for (size_t len = 1; len < k;) {
+      len = std::min(2 * len, k);
+      std::vector<uint32_t> f_low(f.begin(), f.begin() + std::min(f.size(), len));
+      std::vector<uint32_t> e = mod_multiply(f_low, g);
+      e.resize(len, 0);
+      for (uint32_t &x : e) {
+        x = SubproductTree::Ntt::subtract(0, x);
+      }
+      e[0] = SubproductTree::Ntt::add(e[0], 2);
+      g = mod_multiply(g, e);
+      g.resize(len);
+    }
+    return g;
+  }
+
+  // a mod b，b 为首一多项式。商较长时把 rev(a) 乘以 rev(b) 的逆级数得到 rev(商)
+  static std::vector<uint32_t> mod_remainder(const std::vector<uint32_t> &a,
+                                             const std::vector<uint32_t> &b) {
+    size_t nb = b.size();
+    if (a.size() < nb) {
+      return a;
+    }
+    size_t q_size = a.size() - nb + 1;
+    std::vector<uint32_t> r;
+    if (q_size <= kNaiveDivisionLimit || nb <= kNaiveDivisionLimit) {
+      r = a;
+      for (size_t i = r.size(); i-- > nb - 1;) {
+        uint32_t coefficient = r[i];
+        for (size_t j = 0; j < nb; ++j) {
+          uint32_t &target = r[i - (nb - 1) + j];
+          target = SubproductTree::Ntt::subtract(target, mod_mul(coefficient, b[j]));
+        }
+      }
+      r.resize(nb - 1);
+      return r;
+    }
+    std::vector<uint32_t> reversed_a(a.rbegin(), a.rbegin() + q_size);
+    std::vector<uint32_t> reversed_b(b.rbegin(), b.rend());
+    std::vector<uint32_t> q =
+        mod_multiply(reversed_a, mod_inverse_series(reversed_b, q_size));
+    q.resize(q_size);
+    std::reverse(q.begin(), q.end());
+    std::vector<uint32_t> qb = mod_multiply(q, b);
+    r.resize(nb - 1);
+    for (size_t i = 0; i + 1 < nb; ++i) {
+      r[i] = SubproductTree::Ntt::subtract(a[i], qb[i]);
+    }
+    return r;
+  }
 };
 
 } // namespace algorithms
@@ -0,0 +1,552 @@
+#ifndef PRIMALITY_H
+#define PRIMALITY_H
+
+#include "cpu_features.h"
+#include "gemm_kernel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace algorithms {
+
+/**
+ * @brief 奇数模数 n < 2^64 上的Montgomery运算（R = 2^64）
+ *
+ * x 的Montgomery形式为 xR mod n。multiply 用 __int128 乘积和减法型约减：
+ * m = t·n^{-1} mod R 使 t 与 m·n 的低64位相同，结果为两者高64位之差，
+ * 为负时加 n，不需要除法，也不会溢出。
+ */
+class Montgomery64 {
+public:
+  uint64_t n, n_inverse, one, minus_one; // one、minus_one 为 1 与 n-1 的形式
+
+  explicit Montgomery64(uint64_t modulus)
+      : n(modulus), n_inverse(inverse(modulus)),
+        one(static_cast<uint64_t>((static_cast<unsigned __int128>(1) << 64) %
+                                  modulus)),
+        minus_one(modulus - one) {}
+
+  uint64_t to_montgomery(uint64_t a) const {
+    return static_cast<uint64_t>((static_cast<unsigned __int128>(a % n) << 64) %
+                                 n);
+  }
+
+  uint64_t from_montgomery(uint64_t x) const { return multiply(x, 1); }
+
+  // a·b·R^{-1} mod n
+  uint64_t multiply(uint64_t a, uint64_t b) const {
+    unsigned __int128 t = static_cast<unsigned __int128>(a) * b;
+    uint64_t m = static_cast<uint64_t>(t) * n_inverse;
+    uint64_t mn_high =
+        static_cast<uint64_t>((static_cast<unsigned __int128>(m) * n) >> 64);
+    uint64_t t_high = static_cast<uint64_t>(t >> 64);
+    return t_high >= mn_high ? t_high - mn_high : t_high - mn_high + n;
+  }
+
+  // 牛顿迭代求奇数 n 模 2^64 的逆元，每次有效位数翻倍
+  static uint64_t inverse(uint64_t n) {
+    uint64_t result = n;
+    for (int i = 0; i < 5; i++) {
+      result *= 2 - n * result;
+    }
+    return result;
+  }
+};
+
+/**
+ * @brief 确定性的64位Miller–Rabin素性测试 - 算法导论第31.8节
+ *
+ * 先用乘法逆元做小素数（3~251）整除判断：n·p^{-1} mod 2^64 ≤ ⌊(2^64-1)/p⌋
+ * 当且仅当 p | n，不需要除法。剩下的数用固定见证集合做强伪素数测试：
+ * - n < 2^32：{2, 7, 61}
+ * - n < 2^64：{2, 325, 9375, 28178, 450775, 9780504, 1795265022}
+ * 对这些范围内的所有奇数结果都是确定的。模乘用Montgomery形式（R = 2^64，
+ * __int128乘法，减法型约减），整个测试只在换入Montgomery形式时做除法。
+ *
+ * is_prime_batch 一次测试一批数：小于 2^32 的候选数8个一组放进AVX2的
+ * 64位通道（_mm256_mul_epu32 做32×32→64位乘法），每个通道有自己的模数、
+ * 指数和平方次数，用掩码混合代替分支；更大的数需要64×64→128位乘法，
+ * AVX2/AVX-512F没有对应指令，逐个用标量路径。
+ */
+class MillerRabin {
+public:
+  static bool is_prime(uint64_t n) {
+    int decided = trial_division(n);
+    if (decided >= 0)
+      return decided == 1;
+    if (n < (uint64_t(1) << 32))
+      return strong_probable_prime(n, kWitnesses32, 3);
+    return strong_probable_prime(n, kWitnesses64, 7);
+  }
+
+  // result[i] = is_prime(candidates[i])
+  static void is_prime_batch(const uint64_t *candidates, size_t count,
+                             uint8_t *result) {
+    std::vector<uint32_t> small;
+    std::vector<size_t> small_index;
+    for (size_t i = 0; i < count; i++) {
+      uint64_t n = candidates[i];
+      int decided = trial_division(n);
+      if (decided >= 0) {
+        result[i] = static_cast<uint8_t>(decided);
+      } else if (n < (uint64_t(1) << 32)) {
+        small.push_back(static_cast<uint32_t>(n));
+        small_index.push_back(i);
+      } else {
+        result[i] = strong_probable_prime(n, kWitnesses64, 7);
+      }
+    }
+    std::vector<uint8_t> small_result(small.size());
+#ifdef ALGORITHMS_GEMM_X86
+    if (CpuFeatures::avx2()) {
+      test32_avx2(small.data(), small.size(), small_result.data());
+    } else
+#endif
+    {
+      for (size_t i = 0; i < small.size(); i++) {
+        small_result[i] = strong_probable_prime(small[i], kWitnesses32, 3);
+      }
+    }
+    for (size_t i = 0; i < small.size(); i++) {
+      result[small_index[i]] = small_result[i];
+    }
+  }
+
+  static std::vector<uint8_t>
+  is_prime_batch(const std::vector<uint64_t> &candidates) {
+    std::vector<uint8_t> result(candidates.size());
+    is_prime_batch(candidates.data(), candidates.size(), result.data());
+    return result;
+  }
+
+  // n 有 3~251 之间的素因子（且 n 不等于该素数）时返回真，用于候选数的预筛
+  static bool has_small_factor(uint64_t n) {
+    for (const SmallPrime &p : small_primes()) {
+      if (n * p.inverse <= p.limit)
+        return n != p.prime;
+    }
+    return false;
+  }
+
+private:
+  static constexpr uint64_t kWitnesses32[3] = {2, 7, 61};
+  static constexpr uint64_t kWitnesses64[7] = {
+      2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+  // 小于 257² 且没有不超过251的素因子的数一定是素数
+  static constexpr uint64_t kTrialBound = 257 * 257;
+
+  struct SmallPrime {
+    uint64_t prime, inverse, limit; // p，p^{-1} mod 2^64，⌊(2^64-1)/p⌋
+  };
+
+  static const std::vector<SmallPrime> &small_primes() {
+    static const std::vector<SmallPrime> primes = [] {
+      std::vector<SmallPrime> result;
+      for (uint64_t p = 3; p < 256; p += 2) {
+        bool prime = true;
+        for (uint64_t d = 3; d * d <= p && prime; d += 2) {
+          prime = p % d != 0;
+        }
+        if (prime)
+          result.push_back({p, Montgomery64::inverse(p), UINT64_MAX / p});
+      }
+      return result;
+    }();
+    return primes;
+  }
+
+  // 1：素数，0：合数，-1：需要Miller–Rabin
+  static int trial_division(uint64_t n) {
+    if (n < 2)
+      return 0;
+    if (n % 2 == 0)
+      return n == 2;
+    for (const SmallPrime &p : small_primes()) {
+      if (n * p.inverse <= p.limit)
+        return n == p.prime;
+    }
+    return n < kTrialBound ? 1 : -1;
+  }
+
+  static bool strong_probable_prime(uint64_t n, const uint64_t *witnesses,
+                                    int witness_count) {
+    const Montgomery64 mont(n);
+    uint64_t d = n - 1;
+    int s = __builtin_ctzll(d);
+    d >>= s;
+    for (int w = 0; w < witness_count; w++) {
+      uint64_t a = witnesses[w] % n;
+      if (a == 0)
+        continue;
+      uint64_t base = mont.to_montgomery(a), x = mont.one;
+      for (int bit = 63 - __builtin_clzll(d); bit >= 0; bit--) {
+        x = mont.multiply(x, x);
+        if ((d >> bit) & 1)
+          x = mont.multiply(x, base);
+      }
+      if (x == mont.one || x == mont.minus_one)
+        continue;
+      bool composite = true;
+      for (int r = 1; r < s && composite; r++) {
+        x = mont.multiply(x, x);
+        composite = x != mont.minus_one;
+      }
+      if (composite)
+        return false;
+    }
+    return true;
+  }
+
+#ifdef ALGORITHMS_GEMM_X86
+  // 每个64位通道的低32位放一个剩余类，R = 2^32：
+  // t = a·b，m = t·n^{-1} mod 2^32，结果为 ⌊t/R⌋ - ⌊m·n/R⌋，为负时加 n
+  __attribute__((target("avx2"))) static inline __m256i
+  multiply32(__m256i a, __m256i b, __m256i n, __m256i n_inverse) {
+    __m256i t = _mm256_mul_epu32(a, b);
+    __m256i m = _mm256_mul_epu32(t, n_inverse);
+    __m256i mn = _mm256_mul_epu32(m, n);
+    __m256i u = _mm256_sub_epi64(_mm256_srli_epi64(t, 32),
+                                 _mm256_srli_epi64(mn, 32));
+    __m256i negative = _mm256_cmpgt_epi64(_mm256_setzero_si256(), u);
+    return _mm256_add_epi64(u, _mm256_and_si256(negative, n));
+  }
+
+  // 32位候选数（奇数、大于 257²）的批量测试，8个一组分成两个寄存器交错计算
+  __attribute__((target("avx2"))) static void
+  test32_avx2(const uint32_t *candidates, size_t count, uint8_t *result) {
+    constexpr int kLanes = 8;
+    alignas(32) uint64_t n[kLanes], n_inverse[kLanes], one[kLanes],
+        minus_one[kLanes], d[kLanes], s[kLanes], a[3][kLanes];
+    for (size_t start = 0; start < count; start += kLanes) {
+      int max_bits = 0, max_s = 0;
+      for (int lane = 0; lane < kLanes; lane++) {
+        // 不满一组时用素数 65537 补齐
+        uint64_t value = start + lane < count ? candidates[start + lane] : 65537;
+        uint32_t inverse = static_cast<uint32_t>(value);
+        for (int i = 0; i < 4; i++) {
+          inverse *= 2 - static_cast<uint32_t>(value) * inverse;
+        }
+        n[lane] = value;
+        n_inverse[lane] = inverse;
+        one[lane] = (uint64_t(1) << 32) % value;
+        minus_one[lane] = value - one[lane];
+        s[lane] = __builtin_ctzll(value - 1);
+        d[lane] = (value - 1) >> s[lane];
+        max_bits = std::max(max_bits, 64 - __builtin_clzll(d[lane]));
+        max_s = std::max(max_s, static_cast<int>(s[lane]));
+        for (int w = 0; w < 3; w++) {
+          a[w][lane] = ((kWitnesses32[w] % value) << 32) % value;
+        }
+      }
+      __m256i vn[2], vi[2], vone[2], vm1[2], vs[2], passed_all[2];
+      for (int h = 0; h < 2; h++) {
+        vn[h] = _mm256_load_si256(reinterpret_cast<const __m256i *>(n + 4 * h));
+        vi[h] = _mm256_load_si256(
+            reinterpret_cast<const __m256i *>(n_inverse + 4 * h));
+        vone[h] =
+            _mm256_load_si256(reinterpret_cast<const __m256i *>(one + 4 * h));
+        vm1[h] = _mm256_load_si256(
+            reinterpret_cast<const __m256i *>(minus_one + 4 * h));
+        vs[h] = _mm256_load_si256(reinterpret_cast<const __m256i *>(s + 4 * h));
+        passed_all[h] = _mm256_set1_epi64x(-1);
+      }
+      const __m256i unit = _mm256_set1_epi64x(1);
+      for (int w = 0; w < 3; w++) {
+        // 从低位到高位的二进制幂：x 与 base 两条依赖链可以并行
+        __m256i x[2], base[2], exponent[2];
+        for (int h = 0; h < 2; h++) {
+          x[h] = vone[h];
+          base[h] = _mm256_load_si256(
+              reinterpret_cast<const __m256i *>(a[w] + 4 * h));
+          exponent[h] =
+              _mm256_load_si256(reinterpret_cast<const __m256i *>(d + 4 * h));
+        }
+        for (int bit = 0; bit < max_bits; bit++) {
+          for (int h = 0; h < 2; h++) {
+            __m256i take = _mm256_cmpeq_epi64(
+                _mm256_and_si256(exponent[h], unit), unit);
+            __m256i product = multiply32(x[h], base[h], vn[h], vi[h]);
+            x[h] = _mm256_blendv_epi8(x[h], product, take);
+            base[h] = multiply32(base[h], base[h], vn[h], vi[h]);
+            exponent[h] = _mm256_srli_epi64(exponent[h], 1);
+          }
+        }
+        __m256i passed[2];
+        for (int h = 0; h < 2; h++) {
+          passed[h] = _mm256_or_si256(_mm256_cmpeq_epi64(x[h], vone[h]),
+                                      _mm256_cmpeq_epi64(x[h], vm1[h]));
+        }
+        // 第 r 次平方只对 r < s 的通道有效
+        for (int r = 1; r < max_s; r++) {
+          __m256i round = _mm256_set1_epi64x(r);
+          for (int h = 0; h < 2; h++) {
+            x[h] = multiply32(x[h], x[h], vn[h], vi[h]);
+            __m256i active = _mm256_cmpgt_epi64(vs[h], round);
+            passed[h] = _mm256_or_si256(
+                passed[h],
+                _mm256_and_si256(active, _mm256_cmpeq_epi64(x[h], vm1[h])));
+          }
+        }
+        for (int h = 0; h < 2; h++) {
+          passed_all[h] = _mm256_and_si256(passed_all[h], passed[h]);
+        }
+      }
+      int bits = _mm256_movemask_pd(_mm256_castsi256_pd(passed_all[0])) |
+                 (_mm256_movemask_pd(_mm256_castsi256_pd(passed_all[1])) << 4);
+      for (int lane = 0; lane < kLanes && start + lane < count; lane++) {
+        result[start + lane] = (bits >> lane) & 1;
+      }
+    }
+  }
+#endif
+};
+
+/**
+ * @brief 分段埃拉托斯特尼筛法（模30轮子）
+ *
+ * 与30互素的剩余类只有8个（1, 7, 11, 13, 17, 19, 23, 29），每个字节表示
+ * 连续30个整数中的这8个，内存是普通字节筛的 1/30。区间按 kSegmentBytes
+ * 字节（约98万个整数）分段，每段放得进L1缓存。筛素数 p 只划掉 p·q
+ * （q ≥ p 且与30互素）：
+ * - 小素数（p < kSegmentBytes）：p·q 按 q mod 30 分成8个等差数列，每个数列
+ *   在字节数组中的步长恰好是 p 字节、落在固定的位上，内层循环只有与和加
+ * - 大素数：每段至多命中几次，逐段扫描所有大素数会让代价变成
+ *   素数个数×段数。它们按 q 的轮子顺序逐个跳到下一个倍数，并挂在下一个
+ *   倍数所在段的桶里，每段只处理命中本段的素数
+ * 筛素数本身也用分段筛求出。适用于 high ≤ 2^62（筛素数最多到 2^31）。
+ */
+class SegmentedSieve {
+public:
+  static constexpr size_t kSegmentBytes = 32 * 1024;
+  static constexpr uint64_t kMaxLimit = uint64_t(1) << 62;
+
+  // 按升序对 [low, high) 中的每个素数调用 visit(p)
+  template <typename Visit>
+  static void for_each_prime(uint64_t low, uint64_t high, Visit visit) {
+    for (uint64_t p : {2, 3, 5}) {
+      if (p >= low && p < high)
+        visit(p);
+    }
+    sieve(low, high, [&](uint64_t first_byte, const uint8_t *bits, size_t n) {
+      for (size_t b = 0; b < n; b++) {
+        for (unsigned mask = bits[b]; mask != 0; mask &= mask - 1) {
+          visit(30 * (first_byte + b) + kResidues[__builtin_ctz(mask)]);
+        }
+      }
+    });
+  }
+
+  static std::vector<uint64_t> primes(uint64_t low, uint64_t high) {
+    std::vector<uint64_t> result;
+    for_each_prime(low, high, [&](uint64_t p) { result.push_back(p); });
+    return result;
+  }
+
+  // [low, high) 中素数的个数（逐段popcount，不逐个枚举）
+  static uint64_t count(uint64_t low, uint64_t high) {
+    uint64_t total = 0;
+    for (uint64_t p : {2, 3, 5}) {
+      total += p >= low && p < high;
+    }
+    sieve(low, high, [&](uint64_t, const uint8_t *bits, size_t n) {
+      size_t b = 0;
+      for (; b + 8 <= n; b += 8) {
+        uint64_t word;
+        std::copy(bits + b, bits + b + 8, reinterpret_cast<uint8_t *>(&word));
+        total += __builtin_popcountll(word);
+      }
+      for (; b < n; b++) {
+        total += __builtin_popcount(bits[b]);
+      }
+    });
+    return total;
+  }
+
+private:
+  static constexpr uint64_t kResidues[8] = {1, 7, 11, 13, 17, 19, 23, 29};
+  // 轮子上相邻剩余类的间隔，最后一个从29绕回31
+  static constexpr uint64_t kGaps[8] = {6, 4, 2, 4, 2, 4, 6, 2};
+
+  // 大素数的状态：下一个倍数 p·q 所在的字节，q 在轮子上的位置
+  struct LargePrime {
+    uint64_t byte;
+    uint32_t quotient; // p / 30
+    uint8_t residue;   // p mod 30 在轮子中的位
+    uint8_t wheel;     // q mod 30 在轮子中的位
+  };
+
+  // 跳到下一个倍数：m = 30·byte + r（r = p·W[w] mod 30），
+  // m + p·gap 的字节增量为 (p/30)·gap + (r + (p mod 30)·gap)/30
+  struct WheelStep {
+    uint8_t carry; // (r + (p mod 30)·gap) / 30
+    uint8_t clear; // 当前倍数在字节中的位取反
+  };
+
+  static const WheelStep &wheel_step(int residue, int wheel) {
+    static const std::vector<WheelStep> table = [] {
+      std::vector<WheelStep> result(64);
+      for (int a = 0; a < 8; a++) {
+        for (int w = 0; w < 8; w++) {
+          uint64_t r = kResidues[a] * kResidues[w] % 30;
+          result[8 * a + w] = {
+              static_cast<uint8_t>((r + kResidues[a] * kGaps[w]) / 30),
+              static_cast<uint8_t>(~(1u << wheel_bit(r)))};
+        }
+      }
+      return result;
+    }();
+    return table[8 * residue + wheel];
+  }
+
+  // r mod 30 在轮子中的位；与30不互素时为 -1
+  static int wheel_bit(uint64_t r) {
+    static constexpr int bits[30] = {-1, 0,  -1, -1, -1, -1, -1, 1,  -1, -1,
+                                     -1, 2,  -1, 3,  -1, -1, -1, 4,  -1, 5,
+                                     -1, -1, -1, 6,  -1, -1, -1, -1, -1, 7};
+    return bits[r];
+  }
+
+  // 7 ≤ p ≤ limit 的素数；limit 较大时递归地用分段筛求
+  static std::vector<uint32_t> sieving_primes(uint64_t limit) {
+    std::vector<uint32_t> result;
+    if (limit >= 65536) {
+      for_each_prime(7, limit + 1, [&](uint64_t p) {
+        result.push_back(static_cast<uint32_t>(p));
+      });
+      return result;
+    }
+    std::vector<uint8_t> composite(limit + 1, 0);
+    for (uint64_t i = 3; i <= limit; i += 2) {
+      if (composite[i])
+        continue;
+      if (i >= 7)
+        result.push_back(static_cast<uint32_t>(i));
+      for (uint64_t j = i * i; j <= limit; j += 2 * i) {
+        composite[j] = 1;
+      }
+    }
+    return result;
+  }
+
+  // 按段调用 on_segment(首字节编号, 位图, 字节数)；位图只含 [low, high) 中
+  // 大于5且与30互素的素数
+  template <typename OnSegment>
+  static void sieve(uint64_t low, uint64_t high, OnSegment on_segment) {
+    if (high > kMaxLimit) {
+      throw std::invalid_argument("SegmentedSieve: high must be <= 2^62");
+    }
+    low = std::max<uint64_t>(low, 7);
+    if (low >= high)
+      return;
+    // root = ⌊√(high-1)⌋，浮点开方后修正舍入误差
+    uint64_t root = static_cast<uint64_t>(std::sqrt(static_cast<double>(high)));
+    while (root * root >= high) {
+      root--;
+    }
+    while ((root + 1) * (root + 1) < high) {
+      root++;
+    }
+    std::vector<uint32_t> primes = sieving_primes(root);
+
+    const uint64_t first = low / 30, last = (high + 29) / 30;
+    const uint64_t segments = (last - first + kSegmentBytes - 1) / kSegmentBytes;
+    // 第一个不小于 max(p, ⌈30·first/p⌉) 且与30互素的 q
+    auto first_multiple = [first](uint64_t p, int &wheel) {
+      uint64_t q = std::max(p, (30 * first + p - 1) / p);
+      uint64_t base = q - q % 30;
+      wheel = 0;
+      while (base + kResidues[wheel] < q) {
+        if (++wheel == 8) {
+          wheel = 0;
+          base += 30;
+        }
+      }
+      return p * (base + kResidues[wheel]);
+    };
+
+    // 小素数：8个数列的下一个字节编号与位掩码
+    size_t small_count = 0;
+    while (small_count < primes.size() && primes[small_count] < kSegmentBytes) {
+      small_count++;
+    }
+    std::vector<uint64_t> next(8 * small_count);
+    std::vector<uint8_t> clear(8 * small_count);
+    for (size_t j = 0; j < small_count; j++) {
+      uint64_t p = primes[j];
+      int wheel;
+      uint64_t m = first_multiple(p, wheel);
+      for (int i = 0; i < 8; i++) {
+        next[8 * j + i] = m / 30;
+        clear[8 * j + i] = static_cast<uint8_t>(~(1u << wheel_bit(m % 30)));
+        m += p * kGaps[(wheel + i) % 8];
+      }
+    }
+
+    // 大素数：按下一个倍数所在的段放进环形的桶，环长覆盖最大跳跃距离
+    const uint64_t max_step = root / 5 + 2;
+    const size_t ring = static_cast<size_t>(
+        std::min<uint64_t>(segments, max_step / kSegmentBytes + 2));
+    std::vector<std::vector<LargePrime>> buckets(ring);
+    auto schedule = [&](const LargePrime &prime) {
+      uint64_t k = (prime.byte - first) / kSegmentBytes;
+      if (k < segments)
+        buckets[k % ring].push_back(prime);
+    };
+    for (size_t j = small_count; j < primes.size(); j++) {
+      uint64_t p = primes[j];
+      int wheel;
+      uint64_t m = first_multiple(p, wheel);
+      schedule({m / 30, static_cast<uint32_t>(p / 30),
+                static_cast<uint8_t>(wheel_bit(p % 30)),
+                static_cast<uint8_t>(wheel)});
+    }
+
+    std::vector<uint8_t> segment(kSegmentBytes);
+    std::vector<LargePrime> current;
+    for (uint64_t k = 0; k < segments; k++) {
+      const uint64_t start = first + k * kSegmentBytes;
+      size_t n = static_cast<size_t>(std::min<uint64_t>(kSegmentBytes, last - start));
+      uint64_t end = start + n;
+      std::fill(segment.begin(), segment.begin() + n, 0xff);
+      for (size_t j = 0; j < small_count; j++) {
+        uint64_t p = primes[j];
+        for (int i = 0; i < 8; i++) {
+          uint64_t index = next[8 * j + i];
+          uint8_t mask = clear[8 * j + i];
+          for (; index < end; index += p) {
+            segment[index - start] &= mask;
+          }
+          next[8 * j + i] = index;
+        }
+      }
+      current.swap(buckets[k % ring]);
+      for (LargePrime prime : current) {
+        while (prime.byte < end) {
+          const WheelStep &step = wheel_step(prime.residue, prime.wheel);
+          segment[prime.byte - start] &= step.clear;
+          prime.byte += uint64_t(prime.quotient) * kGaps[prime.wheel] + step.carry;
+          prime.wheel = (prime.wheel + 1) & 7;
+        }
+        schedule(prime);
+      }
+      current.clear();
+      // 区间两端之外的位，以及1（不是素数）
+      for (int bit = 0; bit < 8; bit++) {
+        uint64_t first_value = 30 * start + kResidues[bit];
+        uint64_t last_value = 30 * (end - 1) + kResidues[bit];
+        if (first_value < low || first_value == 1)
+          segment[0] &= static_cast<uint8_t>(~(1u << bit));
+        if (last_value >= high)
+          segment[n - 1] &= static_cast<uint8_t>(~(1u << bit));
+      }
+      on_segment(start, segment.data(), n);
+    }
+  }
+};
+
+} // namespace algorithms
+
+#endif // PRIMALITY_H
@@ -2,9 +2,13 @@
 #define PRIORITY_QUEUE_H
 
 #include "heap.h"
-#include <climits>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
 #include <iostream>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace algorithms {
 
@@ -57,6 +61,7 @@ public:
    * 注意：这个操作需要知道元素在堆中的位置。
    * 在实际应用中，通常需要额外的数据结构来跟踪元素位置。
    * 这里我们简化实现，假设用户知道要修改的元素值。
+   * 需要按编号高效修改关键字时请使用 IndexedPriorityQueue。
    *
    * @param old_key 旧的关键字
    * @param new_key 新的关键字（必须大于等于旧的关键字）
@@ -101,125 +106,285 @@ public:
 };
 
 /**
- * @brief 增强版优先队列，支持元素位置跟踪
+ * @brief 带下标索引的优先队列（模板版本）
+ *
+ * 每个元素由调用者给定的编号 id 标识，位置表 positions[id] 在每次上浮、
+ * 下沉时同步维护，因此按编号修改关键字、删除元素都是 O(log n)，查询是 O(1)。
+ * 与 std::priority_queue 一样，Compare 为 std::less 时队首是最大元素。
+ *
+ * 编号应当是较小的非负整数（例如任务在任务表中的下标），位置表按最大编号
+ * 自动扩展；上浮和下沉使用"空穴"方式移动元素，每层只做一次赋值。
  */
-class EnhancedPriorityQueue {
-private:
-  struct Element {
-    int key;
-    int id; // 用于标识元素
-
-    Element(int k, int i) : key(k), id(i) {}
+template <typename Key, typename Compare = std::less<Key>>
+class IndexedPriorityQueue {
+public:
+  using id_type = std::size_t;
 
-    bool operator<(const Element &other) const { return key < other.key; }
+private:
+  static constexpr std::size_t kAbsent = static_cast<std::size_t>(-1);
 
-    bool operator>(const Element &other) const { return key > other.key; }
+  struct Entry {
+    Key key;
+    id_type id;
   };
 
-  std::vector<Element> data;
-  std::vector<int> position; // 元素ID到堆位置的映射
+  std::vector<Entry> heap;
+  std::vector<std::size_t> positions; // 编号到堆下标的映射，kAbsent 表示不在队列中
+  Compare compare;
 
-  void max_heapify(int i, int heap_size) {
-    int left = 2 * i + 1;
-    int right = 2 * i + 2;
-    int largest = i;
+  // a 应排在 b 之前
+  bool before(const Key &a, const Key &b) const { return compare(b, a); }
 
-    if (left < heap_size && data[left] > data[largest]) {
-      largest = left;
-    }
+  void place(std::size_t i, Entry &&entry) {
+    positions[entry.id] = i;
+    heap[i] = std::move(entry);
+  }
 
-    if (right < heap_size && data[right] > data[largest]) {
-      largest = right;
+  void sift_up(std::size_t i) {
+    Entry moving = std::move(heap[i]);
+    while (i > 0) {
+      std::size_t parent = (i - 1) / 2;
+      if (!before(moving.key, heap[parent].key)) {
+        break;
+      }
+      place(i, std::move(heap[parent]));
+      i = parent;
     }
+    place(i, std::move(moving));
+  }
 
-    if (largest != i) {
-      std::swap(data[i], data[largest]);
-      // 更新位置映射
-      position[data[i].id] = i;
-      position[data[largest].id] = largest;
-      max_heapify(largest, heap_size);
+  void sift_down(std::size_t i) {
+    Entry moving = std::move(heap[i]);
+    std::size_t n = heap.size();
+    while (true) {
+      std::size_t child = 2 * i + 1;
+      if (child >= n) {
+        break;
+      }
+      if (child + 1 < n && before(heap[child + 1].key, heap[child].key)) {
+        child++;
+      }
+      if (!before(heap[child].key, moving.key)) {
+        break;
+      }
+      place(i, std::move(heap[child]));
+      i = child;
     }
+    place(i, std::move(moving));
   }
 
-  void build_max_heap() {
-    int heap_size = data.size();
-    for (int i = heap_size / 2 - 1; i >= 0; --i) {
-      max_heapify(i, heap_size);
+  std::size_t position_of(id_type id) const {
+    if (!contains(id)) {
+      throw std::runtime_error("元素不存在");
     }
+    return positions[id];
   }
 
-  void heap_increase_key(int i, int new_key) {
-    if (new_key < data[i].key) {
-      throw std::runtime_error("新关键字小于当前关键字");
+  // 删除下标 i 处的元素，用末尾元素填补后向合适的方向调整
+  void remove_at(std::size_t i) {
+    positions[heap[i].id] = kAbsent;
+    if (i + 1 == heap.size()) {
+      heap.pop_back();
+      return;
+    }
+    heap[i] = std::move(heap.back());
+    heap.pop_back();
+    positions[heap[i].id] = i;
+    if (i > 0 && before(heap[i].key, heap[(i - 1) / 2].key)) {
+      sift_up(i);
+    } else {
+      sift_down(i);
     }
+  }
 
-    data[i].key = new_key;
+public:
+  explicit IndexedPriorityQueue(Compare compare = Compare())
+      : compare(std::move(compare)) {}
 
-    // 上浮
-    while (i > 0 && data[(i - 1) / 2] < data[i]) {
-      int parent = (i - 1) / 2;
-      std::swap(data[i], data[parent]);
-      position[data[i].id] = i;
-      position[data[parent].id] = parent;
-      i = parent;
+  /**
+   * @brief 预留空间
+   * @param max_elements 同时在队列中的元素数
+   * @param max_id 编号上界（不含）
+   */
+  void reserve(std::size_t max_elements, std::size_t max_id = 0) {
+    heap.reserve(max_elements);
+    if (max_id > positions.size()) {
+      positions.resize(max_id, kAbsent);
     }
   }
 
-public:
-  EnhancedPriorityQueue(int max_elements = 100) : position(max_elements, -1) {}
+  bool empty() const { return heap.empty(); }
 
-  void insert(int id, int key) {
-    if (id >= position.size()) {
-      throw std::runtime_error("元素ID超出范围");
+  std::size_t size() const { return heap.size(); }
+
+  bool contains(id_type id) const {
+    return id < positions.size() && positions[id] != kAbsent;
+  }
+
+  /**
+   * @brief 插入元素（INSERT操作）
+   * @throws std::invalid_argument 编号已在队列中
+   */
+  void insert(id_type id, Key key) {
+    if (id >= positions.size()) {
+      positions.resize(std::max(id + 1, positions.size() * 2), kAbsent);
+    } else if (positions[id] != kAbsent) {
+      throw std::invalid_argument("元素编号已存在");
     }
+    heap.push_back(Entry{std::move(key), id});
+    positions[id] = heap.size() - 1;
+    sift_up(heap.size() - 1);
+  }
 
-    data.emplace_back(INT_MIN, id);
-    position[id] = data.size() - 1;
-    heap_increase_key(position[id], key);
+  /**
+   * @brief 队首元素的关键字（MAXIMUM操作）
+   */
+  const Key &top_key() const {
+    if (heap.empty()) {
+      throw std::runtime_error("队列为空");
+    }
+    return heap[0].key;
   }
 
-  int maximum() const {
-    if (data.empty()) {
+  /**
+   * @brief 队首元素的编号
+   */
+  id_type top_id() const {
+    if (heap.empty()) {
       throw std::runtime_error("队列为空");
     }
-    return data[0].key;
+    return heap[0].id;
   }
 
-  int extract_max() {
-    if (data.empty()) {
+  /**
+   * @brief 提取并删除队首元素（EXTRACT-MAX操作）
+   * @return (编号, 关键字)
+   */
+  std::pair<id_type, Key> pop() {
+    if (heap.empty()) {
       throw std::runtime_error("队列为空");
     }
+    std::pair<id_type, Key> result(heap[0].id, std::move(heap[0].key));
+    remove_at(0);
+    return result;
+  }
 
-    Element max_elem = data[0];
-    data[0] = data.back();
-    position[data[0].id] = 0;
-    data.pop_back();
-    position[max_elem.id] = -1;
+  /**
+   * @brief 按编号查询关键字，O(1)
+   */
+  const Key &key(id_type id) const { return heap[position_of(id)].key; }
 
-    if (!data.empty()) {
-      max_heapify(0, data.size());
+  /**
+   * @brief 将关键字改为 new_key，向队首方向移动（INCREASE-KEY操作）
+   * @throws std::runtime_error 新关键字排在当前关键字之后
+   */
+  void increase_key(id_type id, Key new_key) {
+    std::size_t i = position_of(id);
+    if (before(heap[i].key, new_key)) {
+      throw std::runtime_error("新关键字小于当前关键字");
     }
+    heap[i].key = std::move(new_key);
+    sift_up(i);
+  }
+
+  /**
+   * @brief 任意修改关键字，自动选择上浮或下沉，O(log n)
+   */
+  void update_key(id_type id, Key new_key) {
+    std::size_t i = position_of(id);
+    bool moves_up = before(new_key, heap[i].key);
+    heap[i].key = std::move(new_key);
+    if (moves_up) {
+      sift_up(i);
+    } else {
+      sift_down(i);
+    }
+  }
+
+  /**
+   * @brief 编号不在队列中则插入，否则修改关键字
+   */
+  void insert_or_update(id_type id, Key key) {
+    if (contains(id)) {
+      update_key(id, std::move(key));
+    } else {
+      insert(id, std::move(key));
+    }
+  }
+
+  /**
+   * @brief 按编号删除元素
+   * @return 元素是否在队列中
+   */
+  bool erase(id_type id) {
+    if (!contains(id)) {
+      return false;
+    }
+    remove_at(positions[id]);
+    return true;
+  }
+
+  void clear() {
+    for (const Entry &entry : heap) {
+      positions[entry.id] = kAbsent;
+    }
+    heap.clear();
+  }
+
+  /**
+   * @brief 按堆数组顺序访问所有元素，visit(id, key)
+   */
+  template <typename Visit> void for_each(Visit visit) const {
+    for (const Entry &entry : heap) {
+      visit(entry.id, entry.key);
+    }
+  }
+};
+
+/**
+ * @brief 增强版优先队列，支持元素位置跟踪
+ *
+ * 编号限定在 [0, max_elements) 内的 int 最大优先队列，
+ * 基于 IndexedPriorityQueue 实现，INCREASE-KEY 为 O(log n)。
+ */
+class EnhancedPriorityQueue {
+private:
+  IndexedPriorityQueue<int> queue;
+  std::size_t max_elements;
 
-    return max_elem.key;
+public:
+  EnhancedPriorityQueue(int max_elements = 100)
+      : max_elements(static_cast<std::size_t>(max_elements)) {
+    queue.reserve(this->max_elements, this->max_elements);
   }
 
+  void insert(int id, int key) {
+    if (id < 0 || static_cast<std::size_t>(id) >= max_elements) {
+      throw std::runtime_error("元素ID超出范围");
+    }
+    queue.insert(static_cast<std::size_t>(id), key);
+  }
+
+  int maximum() const { return queue.top_key(); }
+
+  int extract_max() { return queue.pop().second; }
+
   void increase_key(int id, int new_key) {
-    if (id >= position.size() || position[id] == -1) {
+    if (id < 0) {
       throw std::runtime_error("元素不存在");
     }
-
-    heap_increase_key(position[id], new_key);
+    queue.increase_key(static_cast<std::size_t>(id), new_key);
   }
 
-  size_t size() const { return data.size(); }
+  size_t size() const { return queue.size(); }
 
-  bool empty() const { return data.empty(); }
+  bool empty() const { return queue.empty(); }
 
   void print() const {
     std::cout << "优先队列: ";
-    for (const auto &elem : data) {
-      std::cout << "(" << elem.id << ":" << elem.key << ") ";
-    }
+    queue.for_each([](std::size_t id, int key) {
+      std::cout << "(" << id << ":" << key << ") ";
+    });
     std::cout << std::endl;
   }
 };
@@ -1,12 +1,14 @@
 #ifndef PROBABILISTIC_ANALYSIS_H
 #define PROBABILISTIC_ANALYSIS_H
 
+#include "monte_carlo.h"
 #include <algorithm>
 #include <functional>
 #include <iostream>
 #include <iterator>
 #include <map>
 #include <random>
+#include <stdexcept>
 #include <unordered_map>
 #include <vector>
 
@@ -137,6 +139,34 @@ public:
     return permutation;
   }
 
+  /**
+   * @brief 可复现的并行随机排列
+   *
+   * 用 ParallelShuffle 的嵌套分桶洗牌，适合 10^8–10^9 个元素；
+   * 同一种子在任何线程数下得到同一排列。
+   *
+   * @param n 排列大小
+   * @param seed 随机种子
+   * @param scheduler 为空时串行执行
+   * @return 1到n的随机排列
+   */
+  static std::vector<int> random_permutation(int n, uint64_t seed,
+                                             WorkStealingScheduler *scheduler = nullptr) {
+    std::vector<int> permutation(std::max(n, 0));
+    auto fill = [&](size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; ++i) {
+        permutation[i] = static_cast<int>(i) + 1;
+      }
+    };
+    if (scheduler) {
+      scheduler->parallel_for(0, permutation.size(), ParallelShuffle::kBlockSize, fill);
+    } else {
+      fill(0, permutation.size());
+    }
+    ParallelShuffle::shuffle(permutation, seed, scheduler);
+    return permutation;
+  }
+
   /**
    * @brief 随机化雇佣问题
    *
@@ -231,6 +261,99 @@ public:
     return total_max_load / trials;
   }
 
+  /**
+   * @brief 生日悖论的并行模拟
+   *
+   * 每次试验用6个64位字记录已出现的生日；结果可复现，设置
+   * options.target_half_width 后置信区间足够窄时提前停止。
+   *
+   * @param n 人数
+   * @param options 试验次数、种子、停止条件与调度器
+   * @return 至少两人生日相同的概率估计
+   */
+  static MonteCarloResult birthday_paradox(int n, const MonteCarloOptions &options) {
+    return MonteCarloEngine::estimate(options, [n](PhiloxStream &rng) {
+      uint64_t seen[6] = {};
+      for (int i = 0; i < n; ++i) {
+        uint32_t day = rng.bounded32(365);
+        uint64_t bit = uint64_t(1) << (day % 64);
+        if (seen[day / 64] & bit) {
+          return 1.0;
+        }
+        seen[day / 64] |= bit;
+      }
+      return 0.0;
+    });
+  }
+
+  /**
+   * @brief 球与箱子问题的并行模拟
+   *
+   * @param balls 球的数量
+   * @param bins 箱子的数量
+   * @param options 试验次数、种子、停止条件与调度器
+   * @return 最大负载的期望估计
+   * @throws std::invalid_argument 如果箱子数不为正
+   */
+  static MonteCarloResult balls_and_bins(int balls, int bins,
+                                         const MonteCarloOptions &options) {
+    if (bins <= 0) {
+      throw std::invalid_argument("箱子数必须为正");
+    }
+    std::vector<int> loads(bins);
+    return MonteCarloEngine::estimate(
+        options, [balls, bins, loads](PhiloxStream &rng) mutable {
+          std::fill(loads.begin(), loads.end(), 0);
+          int max_load = 0;
+          for (int i = 0; i < balls; ++i) {
+            int load = ++loads[rng.bounded32(static_cast<uint32_t>(bins))];
+            max_load = std::max(max_load, load);
+          }
+          return static_cast<double>(max_load);
+        });
+  }
+
+  /**
+   * @brief 雇佣问题各k值成功概率的并行模拟
+   *
+   * 一次试验生成一个排列，同时得出所有k的结果：设最佳候选人在位置p，
+   * 位置p之前的最佳者在位置q，则策略k成功当且仅当 q < k ≤ p
+   * （k = n 时总是雇佣最后一人，成功当且仅当 p = n-1）。
+   * 每次试验 O(n)，逐个k调用 hiring_problem 为 O(n²)。
+   *
+   * @param n 候选人数量
+   * @param options 试验次数、种子、停止条件与调度器
+   * @return mean[k-1] 为策略k雇佣到最佳候选人的概率
+   * @throws std::invalid_argument 如果n不为正
+   */
+  static MonteCarloResult analyze_optimal_k(int n, const MonteCarloOptions &options) {
+    if (n <= 0) {
+      throw std::invalid_argument("候选人数量必须为正");
+    }
+    std::vector<int> candidates(n);
+    return MonteCarloEngine::estimate(
+        options, n, [n, candidates](PhiloxStream &rng, double *success) mutable {
+          for (int i = 0; i < n; ++i) {
+            candidates[i] = i + 1;
+          }
+          for (int i = n - 1; i > 0; --i) {
+            std::swap(candidates[i], candidates[rng.bounded32(i + 1)]);
+          }
+          int best = 0, runner_up = -1; // runner_up: best之前的最佳位置
+          for (int i = 1; i < n; ++i) {
+            if (candidates[i] > candidates[best]) {
+              runner_up = best;
+              best = i;
+            }
+          }
+          for (int k = 1; k <= n; ++k) {
+            bool hired_best = (runner_up < k && k <= best) ||
+                              (k == n && best == n - 1);
+            success[k - 1] = hired_best ? 1.0 : 0.0;
+          }
+        });
+  }
+
   /**
    * @brief 随机化快速选择算法 - 算法导论第9.2节
    *
@@ -0,0 +1,473 @@
+#ifndef QUANTILE_SKETCH_H
+#define QUANTILE_SKETCH_H
+
+#include "workload_generator.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+
+// KLL 流式近似分位数草图（Karnin, Lang, Liberty, 2016）
+//
+// OrderStatistics 的精确选择需要整个数组驻留内存；KllSketch 只保留
+// O(k log(n/k)) 个样本：第 h 层的样本权重为 2^h，层满时排序并随机保留
+// 奇数位或偶数位的一半升入上一层，总权重始终等于 n。第 h 层容量为
+// max(8, ceil(k·(2/3)^(H-1-h)))（H 为层数），顶层最宽，越往下越窄。
+//
+// 对任意 q，quantile(q) 返回元素的真实秩与 q·n 之差以高概率不超过
+// normalized_rank_error()·n；k = 200 时约为 1.3%。两个草图可以合并，
+// 合并结果的误差界与直接写入全部数据相同。
+//
+// 浮点数的 NaN 不参与统计，直接忽略。
+template <typename T, typename Less = std::less<T>> class KllSketch {
+public:
+  static constexpr size_t kDefaultK = 200;
+  static constexpr size_t kMinLevelWidth = 8;
+
+  // 查询视图：全部样本按值排序，附带累计权重
+  class SortedView {
+  public:
+    // 最近秩法的 q 分位数：累计权重首次达到 max(ceil(q·n), 1) 的样本
+    T quantile(double q) const {
+      if (items.empty()) {
+        throw std::runtime_error("草图为空");
+      }
+      if (!(q >= 0.0 && q <= 1.0)) {
+        throw std::invalid_argument("分位数必须在[0, 1]之间");
+      }
+      if (q == 0.0) {
+        return minimum;
+      }
+      if (q == 1.0) {
+        return maximum;
+      }
+      uint64_t target = std::max<uint64_t>(
+          1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(total))));
+      size_t i = static_cast<size_t>(
+          std::lower_bound(cumulative.begin(), cumulative.end(), target) -
+          cumulative.begin());
+      return items[std::min(i, items.size() - 1)];
+    }
+
+    // 估计小于 value 的元素个数
+    uint64_t rank(const T &value) const {
+      size_t i = static_cast<size_t>(
+          std::lower_bound(items.begin(), items.end(), value, less) -
+          items.begin());
+      return i == 0 ? 0 : cumulative[i - 1];
+    }
+
+  private:
+    friend class KllSketch;
+
+    std::vector<T> items;
+    std::vector<uint64_t> cumulative; // cumulative[i] 为 items[0..i] 的权重和
+    uint64_t total = 0;
+    T minimum{}, maximum{};
+    Less less;
+  };
+
+  explicit KllSketch(size_t k = kDefaultK,
+                     uint64_t seed = WorkloadGenerator::kDefaultSeed,
+                     Less less = Less())
+      : k_(k), less(less), random(seed) {
+    if (k < kMinLevelWidth) {
+      throw std::invalid_argument("KLL草图的k不能小于8");
+    }
+    levels.emplace_back();
+    update_capacities();
+  }
+
+  // 写入一个观测值，均摊 O(log k)
+  void update(const T &value) {
+    if constexpr (std::is_floating_point_v<T>) {
+      if (std::isnan(value)) {
+        return;
+      }
+    }
+    if (n_ == 0) {
+      minimum = maximum = value;
+    } else if (less(value, minimum)) {
+      minimum = value;
+    } else if (less(maximum, value)) {
+      maximum = value;
+    }
+    levels[0].push_back(value);
+    ++n_;
+    if (++retained_ >= capacity_total) {
+      compress();
+    }
+  }
+
+  // 并入另一个草图；两者的 k 必须相同
+  void merge(const KllSketch &other) {
+    if (other.k_ != k_) {
+      throw std::invalid_argument("只能合并k相同的KLL草图");
+    }
+    if (other.n_ == 0) {
+      return;
+    }
+    if (n_ == 0) {
+      minimum = other.minimum;
+      maximum = other.maximum;
+    } else {
+      minimum = std::min(minimum, other.minimum, less);
+      maximum = std::max(maximum, other.maximum, less);
+    }
+    while (levels.size() < other.levels.size()) {
+      levels.emplace_back();
+    }
+    update_capacities();
+    for (size_t h = 0; h < other.levels.size(); ++h) {
+      const std::vector<T> &incoming = other.levels[h];
+      // 第 0 层之外各层保持有序
+      if (h == 0) {
+        levels[0].insert(levels[0].end(), incoming.begin(), incoming.end());
+      } else {
+        merge_sorted(levels[h], incoming.begin(), incoming.end());
+      }
+    }
+    n_ += other.n_;
+    retained_ += other.retained_;
+    if (retained_ >= capacity_total) {
+      compress();
+    }
+  }
+
+  bool empty() const { return n_ == 0; }
+
+  // 已写入的观测值个数
+  uint64_t size() const { return n_; }
+
+  // 草图中保留的样本个数
+  size_t retained() const { return retained_; }
+
+  size_t k() const { return k_; }
+
+  size_t num_levels() const { return levels.size(); }
+
+  size_t memory_bytes() const {
+    size_t bytes = levels.capacity() * sizeof(std::vector<T>) +
+                   capacities.capacity() * sizeof(size_t) +
+                   (promoted.capacity() + scratch.capacity()) * sizeof(T);
+    for (const std::vector<T> &level : levels) {
+      bytes += level.capacity() * sizeof(T);
+    }
+    return bytes;
+  }
+
+  const T &min() const {
+    if (empty()) {
+      throw std::runtime_error("草图为空");
+    }
+    return minimum;
+  }
+
+  const T &max() const {
+    if (empty()) {
+      throw std::runtime_error("草图为空");
+    }
+    return maximum;
+  }
+
+  // 单个分位数查询时秩误差的经验上界（占 n 的比例，约 99% 置信度）
+  double normalized_rank_error() const {
+    return 2.296 / std::pow(static_cast<double>(k_), 0.9723);
+  }
+
+  // 构造排序视图，O(r log r)（r 为 retained()）；多次查询时复用它
+  SortedView sorted_view() const {
+    if (empty()) {
+      throw std::runtime_error("草图为空");
+    }
+    std::vector<std::pair<T, uint64_t>> weighted;
+    weighted.reserve(retained_);
+    for (size_t h = 0; h < levels.size(); ++h) {
+      for (const T &value : levels[h]) {
+        weighted.emplace_back(value, uint64_t(1) << h);
+      }
+    }
+    std::sort(weighted.begin(), weighted.end(),
+              [this](const std::pair<T, uint64_t> &a,
+                     const std::pair<T, uint64_t> &b) {
+                return less(a.first, b.first);
+              });
+    SortedView view;
+    view.items.reserve(weighted.size());
+    view.cumulative.reserve(weighted.size());
+    uint64_t sum = 0;
+    for (const auto &[value, weight] : weighted) {
+      sum += weight;
+      view.items.push_back(value);
+      view.cumulative.push_back(sum);
+    }
+    view.total = n_;
+    view.minimum = minimum;
+    view.maximum = maximum;
+    view.less = less;
+    return view;
+  }
+
+  T quantile(double q) const { return sorted_view().quantile(q); }
+
+  // 一次构造视图，回答多个分位数
+  std::vector<T> quantiles(const std::vector<double> &probabilities) const {
+    SortedView view = sorted_view();
+    std::vector<T> result;
+    result.reserve(probabilities.size());
+    for (double q : probabilities) {
+      result.push_back(view.quantile(q));
+    }
+    return result;
+  }
+
+  uint64_t rank(const T &value) const { return sorted_view().rank(value); }
+
+private:
+  size_t k_;
+  Less less;
+  RandomStream random;
+  uint64_t random_bits = 0;
+  unsigned random_left = 0;
+
+  std::vector<std::vector<T>> levels; // levels[h] 中样本的权重为 2^h
+  std::vector<size_t> capacities;
+  size_t capacity_total = 0;
+  size_t retained_ = 0;
+  uint64_t n_ = 0;
+  T minimum{}, maximum{};
+
+  // 压缩与合并复用的缓冲区，避免 std::inplace_merge 每次申请临时内存
+  std::vector<T> promoted, scratch;
+
+  bool random_bit() {
+    if (random_left == 0) {
+      random_bits = random();
+      random_left = 64;
+    }
+    --random_left;
+    bool bit = random_bits & 1;
+    random_bits >>= 1;
+    return bit;
+  }
+
+  void update_capacities() {
+    size_t height = levels.size();
+    capacities.resize(height);
+    capacity_total = 0;
+    double width = static_cast<double>(k_);
+    for (size_t h = height; h-- > 0;) {
+      capacities[h] = std::max(kMinLevelWidth,
+                               static_cast<size_t>(std::ceil(width)));
+      capacity_total += capacities[h];
+      width *= 2.0 / 3.0;
+    }
+  }
+
+  // 把有序区间 [first, last) 并入有序的 level
+  template <typename It> void merge_sorted(std::vector<T> &level, It first,
+                                           It last) {
+    scratch.clear();
+    scratch.reserve(level.size() + static_cast<size_t>(last - first));
+    std::merge(level.begin(), level.end(), first, last,
+               std::back_inserter(scratch), less);
+    level.swap(scratch);
+  }
+
+  // 把第 h 层的一半样本以两倍权重升入第 h + 1 层；
+  // 奇数个样本时最小的一个留在本层，保证总权重不变
+  void compact(size_t h) {
+    if (h + 1 == levels.size()) {
+      levels.emplace_back();
+      update_capacities();
+    }
+    std::vector<T> &level = levels[h];
+    std::vector<T> &upper = levels[h + 1];
+    if (h == 0) {
+      std::sort(level.begin(), level.end(), less);
+    }
+    size_t odd = level.size() & 1;
+    promoted.clear();
+    for (size_t i = odd + random_bit(); i < level.size(); i += 2) {
+      promoted.push_back(level[i]);
+    }
+    merge_sorted(upper, promoted.begin(), promoted.end());
+    retained_ -= level.size() - odd - promoted.size();
+    level.resize(odd);
+  }
+
+  // 样本总数达到总容量时，压缩最低的满层，直到重新低于总容量
+  void compress() {
+    while (retained_ >= capacity_total) {
+      size_t h = 0;
+      while (levels[h].size() < capacities[h]) {
+        ++h;
+      }
+      compact(h);
+    }
+  }
+};
+
+// 多线程写入的 KLL 草图
+//
+// 每个写线程通过 writer() 取得自己的 Writer，先写入线程私有的 KllSketch
+// （即插入缓冲区，写入路径上没有任何共享状态），每 flush_interval 个
+// 观测值发布一次。发布是无锁的：先用一次 exchange 取走共享栈上已发布的
+// 全部草图并入本地草图，再用 CAS 把合并结果压栈，因此栈上的草图数不超过
+// 同时发布的线程数，内存有界。整栈取走而不逐个弹出，不存在 ABA 问题。
+//
+// 读者 snapshot() 同样取走整栈并入汇总草图；只有读者之间用互斥锁串行化，
+// 写者从不等待锁。Writer 尚未发布的观测值对读者不可见；Writer 析构时
+// 自动发布，且必须先于 ConcurrentKllSketch 析构。
+//
+// 快照不是线性一致的：并发的 publish 从栈上取走别人已发布的草图、
+// 到它把合并结果压栈之前，这些观测值既不在栈上也不在汇总草图中，
+// 此时的快照会漏掉它们。它们不会丢失，在之后的快照中出现；
+// 所有写者都停止发布后，snapshot() 包含全部已发布的观测值。
+template <typename T, typename Less = std::less<T>> class ConcurrentKllSketch {
+public:
+  using Sketch = KllSketch<T, Less>;
+
+  class Writer {
+  public:
+    Writer(Writer &&other) noexcept
+        : owner(std::exchange(other.owner, nullptr)),
+          local(std::move(other.local)), unpublished(other.unpublished) {}
+
+    Writer(const Writer &) = delete;
+    Writer &operator=(const Writer &) = delete;
+    Writer &operator=(Writer &&) = delete;
+
+    ~Writer() {
+      if (owner != nullptr) {
+        flush();
+      }
+    }
+
+    void insert(const T &value) {
+      local.update(value);
+      if (++unpublished >= owner->flush_interval) {
+        flush();
+      }
+    }
+
+    // 立即发布本地草图
+    void flush() {
+      if (local.empty()) {
+        return;
+      }
+      owner->publish(std::exchange(local, owner->make_sketch()));
+      unpublished = 0;
+    }
+
+  private:
+    friend class ConcurrentKllSketch;
+
+    explicit Writer(ConcurrentKllSketch *owner)
+        : owner(owner), local(owner->make_sketch()) {}
+
+    ConcurrentKllSketch *owner;
+    Sketch local;
+    size_t unpublished = 0;
+  };
+
+  explicit ConcurrentKllSketch(size_t k = Sketch::kDefaultK,
+                               size_t flush_interval = 1 << 13,
+                               uint64_t seed = WorkloadGenerator::kDefaultSeed,
+                               Less less = Less())
+      : k_(k), flush_interval(flush_interval), less(less), seed(seed),
+        aggregate(k, seed, less) {
+    if (flush_interval == 0) {
+      throw std::invalid_argument("发布间隔必须为正");
+    }
+  }
+
+  ConcurrentKllSketch(const ConcurrentKllSketch &) = delete;
+  ConcurrentKllSketch &operator=(const ConcurrentKllSketch &) = delete;
+
+  ~ConcurrentKllSketch() { delete_nodes(head.exchange(nullptr)); }
+
+  // 每个写线程各取一个，不能跨线程共享
+  Writer writer() { return Writer(this); }
+
+  // 直接发布一个在别处构建的草图（k 必须相同）
+  void publish(Sketch sketch) {
+    if (sketch.k() != k_) {
+      throw std::invalid_argument("只能合并k相同的KLL草图");
+    }
+    drain_into(sketch);
+    Node *node = new Node{std::move(sketch), head.load(std::memory_order_relaxed)};
+    while (!head.compare_exchange_weak(node->next, node,
+                                       std::memory_order_release,
+                                       std::memory_order_relaxed)) {
+    }
+  }
+
+  // 已发布观测值的汇总草图；可能漏掉正被并发 publish 合并的草图（见类注释）
+  Sketch snapshot() const {
+    std::lock_guard<std::mutex> lock(aggregate_mutex);
+    drain_into(aggregate);
+    return aggregate;
+  }
+
+  T quantile(double q) const { return snapshot().quantile(q); }
+
+  std::vector<T> quantiles(const std::vector<double> &probabilities) const {
+    return snapshot().quantiles(probabilities);
+  }
+
+  uint64_t size() const { return snapshot().size(); }
+
+private:
+  struct Node {
+    Sketch sketch;
+    Node *next;
+  };
+
+  size_t k_;
+  size_t flush_interval;
+  Less less;
+  uint64_t seed;
+  std::atomic<uint64_t> writers_created{0};
+  mutable std::atomic<Node *> head{nullptr};
+  mutable std::mutex aggregate_mutex; // 只串行化读者
+  mutable Sketch aggregate;
+
+  // 每个私有草图使用不同的随机流
+  Sketch make_sketch() {
+    uint64_t id = writers_created.fetch_add(1, std::memory_order_relaxed) + 1;
+    return Sketch(k_, seed + id * 0x9E3779B97F4A7C15ULL, less);
+  }
+
+  void drain_into(Sketch &target) const {
+    Node *node = head.exchange(nullptr, std::memory_order_acquire);
+    while (node != nullptr) {
+      target.merge(node->sketch);
+      Node *next = node->next;
+      delete node;
+      node = next;
+    }
+  }
+
+  static void delete_nodes(Node *node) {
+    while (node != nullptr) {
+      Node *next = node->next;
+      delete node;
+      node = next;
+    }
+  }
+};
+
+} // namespace algorithms
+
+#endif // QUANTILE_SKETCH_H
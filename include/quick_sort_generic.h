@@ -1,16 +1,60 @@
 #ifndef QUICK_SORT_GENERIC_H
 #define QUICK_SORT_GENERIC_H
 
+#include "cpu_features.h"
+#include "gemm_kernel.h"
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iostream>
 #include <iterator>
 #include <random>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace algorithms {
 
+namespace quick_sort_detail {
+
+// AVX2 分区用的压缩表：第 mask 行把 mask 中置位的通道按顺序排到前面，
+// 其余通道按顺序排在后面（_mm256_permutevar8x32_epi32 的 32 位通道下标）
+struct CompressTable {
+  uint8_t lanes32[256][8];
+  uint8_t lanes64[16][8];
+};
+
+constexpr CompressTable make_compress_table() {
+  CompressTable table{};
+  for (int mask = 0; mask < 256; ++mask) {
+    int k = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+      for (int lane = 0; lane < 8; ++lane) {
+        if (((mask >> lane) & 1) == (pass == 0 ? 1 : 0)) {
+          table.lanes32[mask][k++] = static_cast<uint8_t>(lane);
+        }
+      }
+    }
+  }
+  for (int mask = 0; mask < 16; ++mask) {
+    int k = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+      for (int lane = 0; lane < 4; ++lane) {
+        if (((mask >> lane) & 1) == (pass == 0 ? 1 : 0)) {
+          table.lanes64[mask][k++] = static_cast<uint8_t>(2 * lane);
+          table.lanes64[mask][k++] = static_cast<uint8_t>(2 * lane + 1);
+        }
+      }
+    }
+  }
+  return table;
+}
+
+inline constexpr CompressTable kCompressTable = make_compress_table();
+
+} // namespace quick_sort_detail
+
 /**
  * @brief 泛型快速排序算法实现
  *
@@ -19,20 +63,34 @@ namespace algorithms {
  * - 随机化快速排序
  * - 尾递归优化版本
  * - 三路快速排序（处理重复元素）
+ * - 内省排序（sort 的默认实现）：
+ *   - 无分支的块分区（BlockQuicksort）
+ *   - 三数取中或九数取中（ninther）选基准
+ *   - 小区间插入排序
+ *   - 递归过深时退回堆排序，最坏 O(n lg n)
+ *   - 基本类型配默认比较函数时用 AVX2 压缩存储分区
+ *
+ * 比较函数的类型是模板参数，lambda 和函数对象可以内联；传
+ * std::function 仍然可用，只是每次比较都是间接调用。比较函数沿用
+ * 本类的约定 comp(a, b) 表示“a 可以排在 b 之前”（即 a ≤ b），
+ * 内省排序内部用 !comp(b, a) 作为严格小于。
  */
 template <typename T> class QuickSortGeneric {
-private:
+public:
   /**
-   * @brief 默认比较函数
+   * @brief 默认比较函数 a <= b
    */
-  static bool default_compare(const T &a, const T &b) { return a <= b; }
+  struct DefaultCompare {
+    bool operator()(const T &a, const T &b) const { return a <= b; }
+  };
 
   /**
    * @brief 默认相等比较函数
    */
-  static bool default_equal(const T &a, const T &b) { return a == b; }
+  struct DefaultEqual {
+    bool operator()(const T &a, const T &b) const { return a == b; }
+  };
 
-public:
   /**
    * @brief 分区操作 - 算法导论第7.1节
    * @param arr 待排序数组
@@ -41,9 +99,9 @@ public:
    * @param comp 比较函数
    * @return 分区后基准元素的最终位置
    */
-  static int
-  partition(std::vector<T> &arr, int low, int high,
-            std::function<bool(const T &, const T &)> comp = default_compare) {
+  template <typename Compare = DefaultCompare>
+  static int partition(std::vector<T> &arr, int low, int high,
+                       Compare comp = Compare()) {
     T pivot = arr[high]; // 选择最后一个元素作为基准
     int i = low - 1;     // 小于基准的区域的边界
 
@@ -66,9 +124,9 @@ public:
    * @param comp 比较函数
    * @return 分区后基准元素的最终位置
    */
-  static int randomized_partition(
-      std::vector<T> &arr, int low, int high,
-      std::function<bool(const T &, const T &)> comp = default_compare) {
+  template <typename Compare = DefaultCompare>
+  static int randomized_partition(std::vector<T> &arr, int low, int high,
+                                  Compare comp = Compare()) {
     // 生成随机索引
     std::random_device rd;
     std::mt19937 gen(rd());
@@ -90,10 +148,11 @@ public:
    * @param equal 相等比较函数
    * @return 包含相等区域边界的pair
    */
-  static std::pair<int, int> three_way_partition(
-      std::vector<T> &arr, int low, int high,
-      std::function<bool(const T &, const T &)> comp = default_compare,
-      std::function<bool(const T &, const T &)> equal = default_equal) {
+  template <typename Compare = DefaultCompare, typename Equal = DefaultEqual>
+  static std::pair<int, int> three_way_partition(std::vector<T> &arr, int low,
+                                                 int high,
+                                                 Compare comp = Compare(),
+                                                 Equal equal = Equal()) {
     T pivot = arr[high];
     int lt = low - 1; // 小于基准的区域边界
     int gt = high;    // 大于基准的区域边界
@@ -125,9 +184,9 @@ public:
    * @param high 排序结束索引
    * @param comp 比较函数
    */
-  static void
-  quick_sort(std::vector<T> &arr, int low, int high,
-             std::function<bool(const T &, const T &)> comp = default_compare) {
+  template <typename Compare = DefaultCompare>
+  static void quick_sort(std::vector<T> &arr, int low, int high,
+                         Compare comp = Compare()) {
     if (low < high) {
       int pivot_index = partition(arr, low, high, comp);
       quick_sort(arr, low, pivot_index - 1, comp);
@@ -142,9 +201,9 @@ public:
    * @param high 排序结束索引
    * @param comp 比较函数
    */
-  static void randomized_quick_sort(
-      std::vector<T> &arr, int low, int high,
-      std::function<bool(const T &, const T &)> comp = default_compare) {
+  template <typename Compare = DefaultCompare>
+  static void randomized_quick_sort(std::vector<T> &arr, int low, int high,
+                                    Compare comp = Compare()) {
     if (low < high) {
       int pivot_index = randomized_partition(arr, low, high, comp);
       randomized_quick_sort(arr, low, pivot_index - 1, comp);
@@ -159,9 +218,9 @@ public:
    * @param high 排序结束索引
    * @param comp 比较函数
    */
-  static void tail_recursive_quick_sort(
-      std::vector<T> &arr, int low, int high,
-      std::function<bool(const T &, const T &)> comp = default_compare) {
+  template <typename Compare = DefaultCompare>
+  static void tail_recursive_quick_sort(std::vector<T> &arr, int low, int high,
+                                        Compare comp = Compare()) {
     while (low < high) {
       int pivot_index = partition(arr, low, high, comp);
 
@@ -184,10 +243,10 @@ public:
    * @param comp 比较函数
    * @param equal 相等比较函数
    */
-  static void three_way_quick_sort(
-      std::vector<T> &arr, int low, int high,
-      std::function<bool(const T &, const T &)> comp = default_compare,
-      std::function<bool(const T &, const T &)> equal = default_equal) {
+  template <typename Compare = DefaultCompare, typename Equal = DefaultEqual>
+  static void three_way_quick_sort(std::vector<T> &arr, int low, int high,
+                                   Compare comp = Compare(),
+                                   Equal equal = Equal()) {
     if (low < high) {
       auto [lt, gt] = three_way_partition(arr, low, high, comp, equal);
       three_way_quick_sort(arr, low, lt - 1, comp, equal);
@@ -196,16 +255,49 @@ public:
   }
 
   /**
-   * @brief 快速排序的便捷接口
+   * @brief 内省排序（不稳定）
+   *
+   * 九数取中选基准后做无分支块分区：左右各扫描一块 kBlockSize 个元素，
+   * 把放错边的元素下标写进偏移缓冲区（比较结果只用来加计数，不产生
+   * 分支），再成对交换。基准与左邻元素相等时（上一层的基准在此重复），
+   * 先把等于基准的元素整体分到左边跳过，大量重复元素时不会退化。
+   * 递归深度超过 2⌊lg n⌋ 时改用堆排序。
    * @param arr 待排序数组
    * @param comp 比较函数
    */
-  static void
-  sort(std::vector<T> &arr,
-       std::function<bool(const T &, const T &)> comp = default_compare) {
-    if (arr.empty())
+  template <typename Compare = DefaultCompare>
+  static void introsort(std::vector<T> &arr, Compare comp = Compare()) {
+    introsort(arr.data(), arr.data() + arr.size(), comp);
+  }
+
+  /**
+   * @brief 对连续区间 [first, last) 内省排序
+   */
+  template <typename Compare = DefaultCompare>
+  static void introsort(T *first, T *last, Compare comp = Compare()) {
+    size_t n = static_cast<size_t>(last - first);
+    if (n < 2)
       return;
-    quick_sort(arr, 0, arr.size() - 1, comp);
+    auto less = [&comp](const T &a, const T &b) { return !comp(b, a); };
+    int depth = 0;
+    for (size_t m = n; m > 1; m >>= 1) {
+      depth += 2;
+    }
+    bool vectorize = false;
+    if constexpr (std::is_same_v<Compare, DefaultCompare> && kSimdKey) {
+      vectorize = CpuFeatures::avx2();
+    }
+    introsort_loop(first, 0, n, less, depth, true, vectorize);
+  }
+
+  /**
+   * @brief 快速排序的便捷接口（内省排序）
+   * @param arr 待排序数组
+   * @param comp 比较函数
+   */
+  template <typename Compare = DefaultCompare>
+  static void sort(std::vector<T> &arr, Compare comp = Compare()) {
+    introsort(arr, comp);
   }
 
   /**
@@ -213,9 +305,8 @@ public:
    * @param arr 待排序数组
    * @param comp 比较函数
    */
-  static void randomized_sort(
-      std::vector<T> &arr,
-      std::function<bool(const T &, const T &)> comp = default_compare) {
+  template <typename Compare = DefaultCompare>
+  static void randomized_sort(std::vector<T> &arr, Compare comp = Compare()) {
     if (arr.empty())
       return;
     randomized_quick_sort(arr, 0, arr.size() - 1, comp);
@@ -227,10 +318,9 @@ public:
    * @param comp 比较函数
    * @param equal 相等比较函数
    */
-  static void three_way_sort(
-      std::vector<T> &arr,
-      std::function<bool(const T &, const T &)> comp = default_compare,
-      std::function<bool(const T &, const T &)> equal = default_equal) {
+  template <typename Compare = DefaultCompare, typename Equal = DefaultEqual>
+  static void three_way_sort(std::vector<T> &arr, Compare comp = Compare(),
+                             Equal equal = Equal()) {
     if (arr.empty())
       return;
     three_way_quick_sort(arr, 0, arr.size() - 1, comp, equal);
@@ -242,11 +332,10 @@ public:
    * @param comp 比较函数
    * @return 如果数组已排序返回true，否则返回false
    */
-  static bool
-  is_sorted(const std::vector<T> &arr,
-            std::function<bool(const T &, const T &)> comp = default_compare) {
+  template <typename Compare = DefaultCompare>
+  static bool is_sorted(const std::vector<T> &arr, Compare comp = Compare()) {
     for (size_t i = 1; i < arr.size(); ++i) {
-      if (!comp(arr[i - 1], arr[i]) && !default_equal(arr[i - 1], arr[i])) {
+      if (!comp(arr[i - 1], arr[i]) && !DefaultEqual()(arr[i - 1], arr[i])) {
         return false;
       }
     }
@@ -273,7 +362,7 @@ public:
    * @brief 创建降序比较函数
    * @return 降序比较函数
    */
-  static std::function<bool(const T &, const T &)> descending_comparator() {
+  static auto descending_comparator() {
     return [](const T &a, const T &b) { return a >= b; };
   }
 
@@ -282,10 +371,304 @@ public:
    * @param func 比较函数
    * @return 包装后的比较函数
    */
-  static std::function<bool(const T &, const T &)>
-  custom_comparator(std::function<bool(const T &, const T &)> func) {
+  template <typename Function>
+  static Function custom_comparator(Function func) {
     return func;
   }
+
+private:
+  static constexpr size_t kInsertionThreshold = 24; // 不超过此长度用插入排序
+  static constexpr size_t kNintherThreshold = 128;  // 超过此长度用九数取中
+  static constexpr size_t kBlockSize = 64;          // 块分区每块元素数
+
+  // 可以用 AVX2 比较的关键字：有符号32/64位整数、float、double
+  static constexpr bool kSimdKey =
+      std::is_same_v<T, float> || std::is_same_v<T, double> ||
+      (std::is_integral_v<T> && std::is_signed_v<T> &&
+       (sizeof(T) == 4 || sizeof(T) == 8));
+
+  template <typename Less>
+  static void introsort_loop(T *a, size_t begin, size_t end, Less &less,
+                             int depth, bool leftmost, bool vectorize) {
+    while (end - begin > kInsertionThreshold) {
+      if (depth == 0) {
+        heap_sort(a + begin, end - begin, less);
+        return;
+      }
+      --depth;
+      choose_pivot(a, begin, end, less);
+      // a[begin - 1] 不大于区间内所有元素；它不小于基准说明两者相等，
+      // 等于基准的元素全部分到左边，已经就位
+      if (!leftmost && !less(a[begin - 1], a[begin])) {
+        T pivot = a[begin];
+        begin = partition_range<true>(a, begin + 1, end, pivot, less,
+                                      vectorize);
+        continue;
+      }
+      T pivot = std::move(a[begin]);
+      size_t split =
+          partition_range<false>(a, begin + 1, end, pivot, less, vectorize) -
+          1;
+      a[begin] = std::move(a[split]);
+      a[split] = std::move(pivot);
+      // 先递归较短的一侧，栈深度 O(lg n)
+      if (split - begin < end - split - 1) {
+        introsort_loop(a, begin, split, less, depth, leftmost, vectorize);
+        begin = split + 1;
+        leftmost = false;
+      } else {
+        introsort_loop(a, split + 1, end, less, depth, false, vectorize);
+        end = split;
+      }
+    }
+    insertion_sort(a, begin, end, less);
+  }
+
+  template <typename Less>
+  static void sort3(T *a, size_t i, size_t j, size_t k, Less &less) {
+    if (less(a[j], a[i]))
+      std::swap(a[i], a[j]);
+    if (less(a[k], a[j]))
+      std::swap(a[j], a[k]);
+    if (less(a[j], a[i]))
+      std::swap(a[i], a[j]);
+  }
+
+  // 把选出的基准换到 a[begin]
+  template <typename Less>
+  static void choose_pivot(T *a, size_t begin, size_t end, Less &less) {
+    size_t n = end - begin, mid = begin + n / 2;
+    if (n > kNintherThreshold) {
+      sort3(a, begin, mid, end - 1, less);
+      sort3(a, begin + 1, mid - 1, end - 2, less);
+      sort3(a, begin + 2, mid + 1, end - 3, less);
+      sort3(a, mid - 1, mid, mid + 1, less);
+      std::swap(a[begin], a[mid]);
+    } else {
+      sort3(a, mid, begin, end - 1, less);
+    }
+  }
+
+  // 把 [begin, end) 分成  [begin, m) 满足 goes_left 与 [m, end) 不满足两段，返回 m；
+  // OrEqual 为真时 goes_left(x) = x ≤ pivot，否则为 x < pivot
+  template <bool OrEqual, typename Less>
+  static size_t partition_range(T *a, size_t begin, size_t end,
+                                const T &pivot, Less &less, bool vectorize) {
+#ifdef ALGORITHMS_GEMM_X86
+    if constexpr (kSimdKey) {
+      if (vectorize)
+        return avx2_partition<OrEqual>(a, begin, end, pivot);
+    }
+#endif
+    (void)vectorize;
+    if constexpr (OrEqual) {
+      return block_partition(a, begin, end,
+                             [&](const T &x) { return !less(pivot, x); });
+    } else {
+      return block_partition(a, begin, end,
+                             [&](const T &x) { return less(x, pivot); });
+    }
+  }
+
+  template <typename GoesLeft>
+  static size_t block_partition(T *a, size_t l, size_t r, GoesLeft goes_left) {
+    // [begin, l) 已在左侧，[r, end) 已在右侧；
+    // offsets_left 记左块中应去右边的元素，offsets_right 记右块中应去左边的元素
+    uint8_t offsets_left[kBlockSize], offsets_right[kBlockSize];
+    size_t count_left = 0, count_right = 0, start_left = 0, start_right = 0;
+    while (r - l > 2 * kBlockSize) {
+      if (count_left == 0) {
+        start_left = 0;
+        for (size_t i = 0; i < kBlockSize; ++i) {
+          offsets_left[count_left] = static_cast<uint8_t>(i);
+          count_left += !goes_left(a[l + i]);
+        }
+      }
+      if (count_right == 0) {
+        start_right = 0;
+        for (size_t i = 0; i < kBlockSize; ++i) {
+          offsets_right[count_right] = static_cast<uint8_t>(i);
+          count_right += goes_left(a[r - 1 - i]);
+        }
+      }
+      size_t pairs = std::min(count_left, count_right);
+      for (size_t k = 0; k < pairs; ++k) {
+        std::swap(a[l + offsets_left[start_left + k]],
+                  a[r - 1 - offsets_right[start_right + k]]);
+      }
+      count_left -= pairs;
+      count_right -= pairs;
+      start_left += pairs;
+      start_right += pairs;
+      if (count_left == 0)
+        l += kBlockSize;
+      if (count_right == 0)
+        r -= kBlockSize;
+    }
+    // 剩下不超过两块：未扫完的块仍在 [l, r) 内，用 Hoare 扫描收尾
+    while (true) {
+      while (l < r && goes_left(a[l]))
+        ++l;
+      while (l < r && !goes_left(a[r - 1]))
+        --r;
+      if (l >= r)
+        return l;
+      std::swap(a[l], a[r - 1]);
+      ++l;
+      --r;
+    }
+  }
+
+  template <typename Less>
+  static void insertion_sort(T *a, size_t begin, size_t end, Less &less) {
+    for (size_t i = begin + 1; i < end; ++i) {
+      if (!less(a[i], a[i - 1]))
+        continue;
+      T key = std::move(a[i]);
+      size_t j = i;
+      do {
+        a[j] = std::move(a[j - 1]);
+        --j;
+      } while (j > begin && less(key, a[j - 1]));
+      a[j] = std::move(key);
+    }
+  }
+
+  template <typename Less>
+  static void sift_down(T *a, size_t i, size_t n, Less &less) {
+    T value = std::move(a[i]);
+    while (2 * i + 1 < n) {
+      size_t child = 2 * i + 1;
+      if (child + 1 < n && less(a[child], a[child + 1]))
+        ++child;
+      if (!less(value, a[child]))
+        break;
+      a[i] = std::move(a[child]);
+      i = child;
+    }
+    a[i] = std::move(value);
+  }
+
+  // 第6章堆排序，内省排序递归过深时的退路
+  template <typename Less>
+  static void heap_sort(T *a, size_t n, Less &less) {
+    for (size_t i = n / 2; i-- > 0;) {
+      sift_down(a, i, n, less);
+    }
+    for (size_t end = n; end-- > 1;) {
+      std::swap(a[0], a[end]);
+      sift_down(a, 0, end, less);
+    }
+  }
+
+#ifdef ALGORITHMS_GEMM_X86
+  // 每个通道是否应分到左边，第 i 位对应第 i 个通道
+  template <bool OrEqual>
+  __attribute__((target("avx2"))) static int avx2_left_mask(__m256i v,
+                                                            __m256i p) {
+    if constexpr (std::is_same_v<T, double>) {
+      __m256d x = _mm256_castsi256_pd(v), y = _mm256_castsi256_pd(p);
+      return _mm256_movemask_pd(OrEqual ? _mm256_cmp_pd(x, y, _CMP_LE_OQ)
+                                        : _mm256_cmp_pd(x, y, _CMP_LT_OQ));
+    } else if constexpr (std::is_same_v<T, float>) {
+      __m256 x = _mm256_castsi256_ps(v), y = _mm256_castsi256_ps(p);
+      return _mm256_movemask_ps(OrEqual ? _mm256_cmp_ps(x, y, _CMP_LE_OQ)
+                                        : _mm256_cmp_ps(x, y, _CMP_LT_OQ));
+    } else if constexpr (sizeof(T) == 4) {
+      if constexpr (OrEqual) {
+        __m256i greater = _mm256_cmpgt_epi32(v, p);
+        return ~_mm256_movemask_ps(_mm256_castsi256_ps(greater)) & 0xFF;
+      } else {
+        __m256i less = _mm256_cmpgt_epi32(p, v);
+        return _mm256_movemask_ps(_mm256_castsi256_ps(less));
+      }
+    } else {
+      if constexpr (OrEqual) {
+        __m256i greater = _mm256_cmpgt_epi64(v, p);
+        return ~_mm256_movemask_pd(_mm256_castsi256_pd(greater)) & 0xF;
+      } else {
+        __m256i less = _mm256_cmpgt_epi64(p, v);
+        return _mm256_movemask_pd(_mm256_castsi256_pd(less));
+      }
+    }
+  }
+
+  /*
+   * 向量化分区：先把首尾各一个向量存进寄存器腾出 2 个向量的空位，之后每次
+   * 从空位较少的一侧读入一个向量，比较得到掩码，按压缩表重排成“左边的
+   * 在前、右边的在后”，整向量分别写到左写指针处和右写指针前；两处写入
+   * 都落在空位里，只按掩码的 popcount 移动写指针。收尾的不足一个向量和
+   * 先前保存的两个向量逐个写入剩余空位。
+   */
+  template <bool OrEqual>
+  __attribute__((target("avx2"))) static size_t
+  avx2_partition(T *a, size_t begin, size_t end, const T &pivot) {
+    constexpr size_t kLanes = 32 / sizeof(T);
+    if (end - begin < 2 * kLanes) {
+      if constexpr (OrEqual) {
+        return block_partition(a, begin, end,
+                               [&](const T &x) { return x <= pivot; });
+      } else {
+        return block_partition(a, begin, end,
+                               [&](const T &x) { return x < pivot; });
+      }
+    }
+    T broadcast[kLanes];
+    for (size_t i = 0; i < kLanes; ++i) {
+      broadcast[i] = pivot;
+    }
+    const __m256i p =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(broadcast));
+    const __m256i saved_left =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + begin));
+    const __m256i saved_right =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + end - kLanes));
+    size_t read_left = begin + kLanes, read_right = end - kLanes;
+    size_t write_left = begin, write_right = end;
+    while (read_right - read_left >= kLanes) {
+      __m256i v;
+      if (read_left - write_left <= write_right - read_right) {
+        v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + read_left));
+        read_left += kLanes;
+      } else {
+        read_right -= kLanes;
+        v = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(a + read_right));
+      }
+      int mask = avx2_left_mask<OrEqual>(v, p);
+      const uint8_t *row = kLanes == 8
+                               ? quick_sort_detail::kCompressTable.lanes32[mask]
+                               : quick_sort_detail::kCompressTable.lanes64[mask];
+      __m256i index = _mm256_cvtepu8_epi32(
+          _mm_loadl_epi64(reinterpret_cast<const __m128i *>(row)));
+      __m256i packed = _mm256_permutevar8x32_epi32(v, index);
+      size_t to_left = static_cast<size_t>(__builtin_popcount(mask));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(a + write_left), packed);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(a + write_right - kLanes),
+                          packed);
+      write_left += to_left;
+      write_right -= kLanes - to_left;
+    }
+    // 此时 [write_left, write_right) 中除未读的尾部外都是空位
+    T rest[3 * kLanes];
+    size_t count = read_right - read_left;
+    for (size_t i = 0; i < count; ++i) {
+      rest[i] = a[read_left + i];
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(rest + count), saved_left);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(rest + count + kLanes),
+                        saved_right);
+    count += 2 * kLanes;
+    for (size_t i = 0; i < count; ++i) {
+      bool left = OrEqual ? rest[i] <= pivot : rest[i] < pivot;
+      a[write_left] = rest[i];
+      a[write_right - 1] = rest[i];
+      write_left += left;
+      write_right -= !left;
+    }
+    return write_left;
+  }
+#endif
 };
 
 // 常用类型的特化版本
@@ -0,0 +1,143 @@
+#ifndef RADIX_HEAP_H
+#define RADIX_HEAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+
+/**
+ * @brief 单调基数堆（radix heap）
+ *
+ * 适用于关键字为非负整数、且插入的关键字从不小于上一次弹出的最小值的场景
+ * （Dijkstra算法在非负整数权图上即满足这一单调性）。
+ *
+ * 设 last 为上一次弹出的关键字，关键字 key 放入第 bit_width(key ^ last) 个桶：
+ * 第0个桶存放与 last 相等的关键字，第 i 个桶中的关键字与 last 的最高不同位为
+ * 第 i-1 位。弹出时若第0个桶为空，就取第一个非空桶中的最小值作为新的 last，
+ * 并把这个桶中的元素重新分配——它们只会落入更低的桶。每个元素最多下移
+ * Bits 次，因此 push 为 O(1)，pop 摊还 O(Bits)；对于 Dijkstra，只有
+ * last + C 之内的关键字会同时在堆中，实际移动次数约为 O(log C)。
+ *
+ * @tparam Value 附带的值（例如节点编号）
+ * @tparam Key 无符号整数关键字类型
+ */
+template <typename Value, typename Key = std::uint32_t> class RadixHeap {
+  static_assert(std::is_unsigned<Key>::value, "RadixHeap 需要无符号关键字");
+
+public:
+  using Entry = std::pair<Key, Value>;
+
+private:
+  static constexpr int kBits = std::numeric_limits<Key>::digits;
+
+  std::vector<Entry> buckets[kBits + 1];
+  Key last;
+  std::size_t count;
+
+  static int bit_width(Key x) {
+    if (x == 0) {
+      return 0;
+    }
+    if (sizeof(Key) <= sizeof(unsigned int)) {
+      return std::numeric_limits<unsigned int>::digits -
+             __builtin_clz(static_cast<unsigned int>(x));
+    }
+    return std::numeric_limits<unsigned long long>::digits -
+           __builtin_clzll(static_cast<unsigned long long>(x));
+  }
+
+  int bucket_of(Key key) const { return bit_width(key ^ last); }
+
+  // 第0个桶为空时，用最低的非空桶中的最小关键字更新 last 并重新分配
+  void refill() {
+    int i = 1;
+    while (buckets[i].empty()) {
+      i++;
+    }
+
+    Key new_last = buckets[i][0].first;
+    for (const Entry &entry : buckets[i]) {
+      if (entry.first < new_last) {
+        new_last = entry.first;
+      }
+    }
+    last = new_last;
+
+    for (Entry &entry : buckets[i]) {
+      buckets[bucket_of(entry.first)].push_back(std::move(entry));
+    }
+    buckets[i].clear();
+  }
+
+public:
+  RadixHeap() : last(0), count(0) {}
+
+  bool empty() const { return count == 0; }
+
+  std::size_t size() const { return count; }
+
+  /**
+   * @brief 上一次弹出的关键字（新插入的关键字不得小于它）
+   */
+  Key last_key() const { return last; }
+
+  /**
+   * @brief 插入元素
+   * @throws std::invalid_argument 关键字小于上一次弹出的关键字
+   */
+  void push(Key key, Value value) {
+    if (key < last) {
+      throw std::invalid_argument("关键字小于上一次弹出的关键字");
+    }
+    buckets[bucket_of(key)].emplace_back(key, std::move(value));
+    count++;
+  }
+
+  /**
+   * @brief 最小关键字
+   */
+  Key top_key() {
+    if (empty()) {
+      throw std::runtime_error("堆为空");
+    }
+    if (buckets[0].empty()) {
+      refill();
+    }
+    return last;
+  }
+
+  /**
+   * @brief 弹出关键字最小的元素
+   * @return (关键字, 值)
+   */
+  Entry pop() {
+    if (empty()) {
+      throw std::runtime_error("堆为空");
+    }
+    if (buckets[0].empty()) {
+      refill();
+    }
+    Entry top = std::move(buckets[0].back());
+    buckets[0].pop_back();
+    count--;
+    return top;
+  }
+
+  void clear() {
+    for (auto &bucket : buckets) {
+      bucket.clear();
+    }
+    last = 0;
+    count = 0;
+  }
+};
+
+} // namespace algorithms
+
+#endif // RADIX_HEAP_H
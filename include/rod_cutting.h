@@ -1,13 +1,244 @@
 #ifndef ROD_CUTTING_H
 #define ROD_CUTTING_H
 
+#include "cpu_features.h"
+#include "gemm_kernel.h"
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <limits>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 namespace algorithms {
 
+/**
+ * @brief 完全背包（每种物品可选任意多次）的动态规划引擎
+ *
+ * 钢条切割是它的特例：长度为 i、价格为 p[i] 的一段就是重量 i、价值 p[i]
+ * 的物品。best[c] 为总重量不超过 c 时的最大价值（什么都不选为0）：
+ *
+ *   best[c] = max(best[c], best[c - w] + v)，对每个物品 (w, v)
+ *
+ * 物品在外层循环、容量在内层递增循环，best[c - w] 可能已包含同一物品，
+ * 正好对应"可重复选择"。同一物品的松弛只依赖距离 w 之前的格子，因此
+ * 长度为 w 的连续一段互不依赖，可以整段做向量化的 max-plus 更新
+ * （int32/int64 在支持时使用AVX2）。时间 O(物品数 × 容量)，空间 O(容量)。
+ *
+ * @tparam Value 价值类型，默认64位，避免大容量时收益溢出
+ */
+template <typename Value = long long> class UnboundedKnapsack {
+public:
+  struct Item {
+    int weight;
+    Value value;
+  };
+
+  /**
+   * @throws std::invalid_argument 存在重量不为正的物品
+   */
+  explicit UnboundedKnapsack(std::vector<Item> item_list)
+      : items(std::move(item_list)) {
+    for (const Item &item : items) {
+      if (item.weight <= 0) {
+        throw std::invalid_argument("物品重量必须为正数");
+      }
+    }
+  }
+
+  // 由钢条价格表构造：prices[i] 为长度 i 的价格，第 i-1 个物品对应长度 i
+  static UnboundedKnapsack from_prices(const std::vector<int> &prices) {
+    std::vector<Item> list;
+    for (std::size_t i = 1; i < prices.size(); i++) {
+      list.push_back({static_cast<int>(i), static_cast<Value>(prices[i])});
+    }
+    return UnboundedKnapsack(std::move(list));
+  }
+
+  const std::vector<Item> &get_items() const { return items; }
+
+  /**
+   * @brief 自底向上求出 best[0..capacity]
+   * @throws std::invalid_argument capacity 为负
+   */
+  std::vector<Value> solve(int capacity) const {
+    if (capacity < 0) {
+      throw std::invalid_argument("容量不能为负");
+    }
+    std::vector<Value> best(static_cast<std::size_t>(capacity) + 1, Value(0));
+    for (const Item &item : items) {
+      if (item.value <= Value(0) || item.weight > capacity) {
+        continue; // 不会改善任何格子
+      }
+      std::size_t w = item.weight;
+      std::size_t end = static_cast<std::size_t>(capacity) + 1;
+      for (std::size_t start = w; start < end; start += w) {
+        relax(best.data() + start, best.data() + start - w,
+              std::min(w, end - start), item.value);
+      }
+    }
+    return best;
+  }
+
+  Value max_value(int capacity) const { return solve(capacity)[capacity]; }
+
+  /**
+   * @brief 自顶向下带备忘录的解法，用显式栈代替递归
+   *
+   * 只计算从 capacity 出发可达的子问题（capacity 减去若干物品重量），
+   * 物品重量都较大时比 solve 少算很多格子；递归深度不受栈空间限制。
+   * 栈帧记录下一个要看的物品，与递归一样每个子问题只入栈一次，
+   * 栈深不超过 capacity / 最小重量 + 1。
+   */
+  Value max_value_top_down(int capacity) const {
+    if (capacity < 0) {
+      throw std::invalid_argument("容量不能为负");
+    }
+    enum : std::uint8_t { kNew, kOnStack, kDone };
+    struct Frame {
+      int capacity;
+      std::size_t next_item;
+    };
+    std::vector<Value> memo(static_cast<std::size_t>(capacity) + 1, Value(0));
+    std::vector<std::uint8_t> state(memo.size(), kNew);
+    std::vector<Frame> stack = {{capacity, 0}};
+    state[capacity] = kOnStack;
+    while (!stack.empty()) {
+      Frame &frame = stack.back();
+      int c = frame.capacity;
+      // 找下一个未求解的子问题；它比 c 小，不可能在栈上
+      while (frame.next_item < items.size() &&
+             (items[frame.next_item].weight > c ||
+              state[c - items[frame.next_item].weight] == kDone)) {
+        frame.next_item++;
+      }
+      if (frame.next_item < items.size()) {
+        int child = c - items[frame.next_item].weight;
+        state[child] = kOnStack;
+        stack.push_back({child, 0});
+        continue;
+      }
+      Value best = Value(0);
+      for (const Item &item : items) {
+        if (item.weight <= c) {
+          best = std::max(best, memo[c - item.weight] + item.value);
+        }
+      }
+      memo[c] = best;
+      state[c] = kDone;
+      stack.pop_back();
+    }
+    return memo[capacity];
+  }
+
+  /**
+   * @brief 由 solve 的结果重构一个最优方案
+   * @return 选中的物品下标（可重复），总价值等于 best[capacity]
+   * @throws std::invalid_argument best 不是由本物品集合求出的
+   *
+   * 沿最优路径逐格查找第一个满足 best[c - w] + v == best[c] 的物品，
+   * 代价 O(方案件数 × 物品数)，不需要在填表时额外记录选择。
+   */
+  std::vector<int> reconstruct(const std::vector<Value> &best,
+                               int capacity) const {
+    if (capacity < 0 || static_cast<std::size_t>(capacity) >= best.size()) {
+      throw std::invalid_argument("容量超出结果表范围");
+    }
+    std::vector<int> chosen;
+    int c = capacity;
+    while (best[c] > Value(0)) {
+      int next = -1;
+      for (std::size_t i = 0; i < items.size(); i++) {
+        const Item &item = items[i];
+        if (item.value > Value(0) && item.weight <= c &&
+            best[c - item.weight] + item.value == best[c]) {
+          chosen.push_back(static_cast<int>(i));
+          next = c - item.weight;
+          break;
+        }
+      }
+      if (next < 0) {
+        throw std::invalid_argument("结果表与物品集合不匹配");
+      }
+      c = next;
+    }
+    return chosen;
+  }
+
+private:
+  std::vector<Item> items;
+
+  // dst[k] = max(dst[k], src[k] + value)，k ∈ [0, length)，两段不重叠
+  static void relax_scalar(Value *__restrict dst, const Value *__restrict src,
+                           std::size_t length, Value value) {
+    for (std::size_t k = 0; k < length; k++) {
+      Value candidate = src[k] + value;
+      dst[k] = candidate > dst[k] ? candidate : dst[k];
+    }
+  }
+
+#ifdef ALGORITHMS_GEMM_X86
+  __attribute__((target("avx2"))) static void
+  relax_avx2(std::int64_t *dst, const std::int64_t *src, std::size_t length,
+             std::int64_t value) {
+    __m256i add = _mm256_set1_epi64x(value);
+    std::size_t k = 0;
+    for (; k + 4 <= length; k += 4) {
+      __m256i current =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + k));
+      __m256i candidate = _mm256_add_epi64(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + k)), add);
+      __m256i greater = _mm256_cmpgt_epi64(candidate, current);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + k),
+                          _mm256_blendv_epi8(current, candidate, greater));
+    }
+    for (; k < length; k++) {
+      dst[k] = std::max(dst[k], src[k] + value);
+    }
+  }
+
+  __attribute__((target("avx2"))) static void
+  relax_avx2(std::int32_t *dst, const std::int32_t *src, std::size_t length,
+             std::int32_t value) {
+    __m256i add = _mm256_set1_epi32(value);
+    std::size_t k = 0;
+    for (; k + 8 <= length; k += 8) {
+      __m256i current =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + k));
+      __m256i candidate = _mm256_add_epi32(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + k)), add);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + k),
+                          _mm256_max_epi32(current, candidate));
+    }
+    for (; k < length; k++) {
+      dst[k] = std::max(dst[k], src[k] + value);
+    }
+  }
+#endif
+
+  static void relax(Value *dst, const Value *src, std::size_t length,
+                    Value value) {
+#ifdef ALGORITHMS_GEMM_X86
+    constexpr bool kVectorizable =
+        std::is_integral<Value>::value && std::is_signed<Value>::value &&
+        (sizeof(Value) == 4 || sizeof(Value) == 8);
+    if constexpr (kVectorizable) {
+      using Lane = typename std::conditional<sizeof(Value) == 8, std::int64_t,
+                                             std::int32_t>::type;
+      if (CpuFeatures::avx2()) {
+        relax_avx2(reinterpret_cast<Lane *>(dst),
+                   reinterpret_cast<const Lane *>(src), length,
+                   static_cast<Lane>(value));
+        return;
+      }
+    }
+#endif
+    relax_scalar(dst, src, length, value);
+  }
+};
+
 class RodCutting {
 private:
   std::vector<int> prices; // 价格表：prices[i]表示长度为i的钢条的价格
@@ -127,6 +358,19 @@ public:
   // 获取价格表大小
   size_t get_price_table_size() const { return prices.size(); }
 
+  /**
+   * @brief 用 UnboundedKnapsack 求解，收益为64位
+   *
+   * 与上面几个方法不同，n 不受价格表长度限制：超出价格表的长度只能由
+   * 表内的段拼成。适合 n 很大（如 10^6）的场景。
+   */
+  long long cut_rod_unbounded(int n) const {
+    if (n <= 0) {
+      return 0;
+    }
+    return UnboundedKnapsack<long long>::from_prices(prices).max_value(n);
+  }
+
   // 获取指定长度的价格
   int get_price(int length) const {
     if (length >= 0 && length < static_cast<int>(prices.size())) {
@@ -136,29 +380,42 @@ public:
   }
 
 private:
-  // 自顶向下递归辅助函数
+  // 自顶向下辅助函数：用显式栈模拟递归，n 很大时也不会栈溢出。
+  // 栈中每个长度先压入尚未求解的子问题，子问题都求出后再计算自身。
   int cut_rod_memoized_aux(int n, std::vector<int> &memo) {
-    if (n == 0) {
-      return 0;
-    }
-
-    if (memo[n] != -1) {
-      return memo[n];
-    }
+    memo[0] = 0;
+    std::vector<int> stack = {n};
+    while (!stack.empty()) {
+      int length = stack.back();
+      if (memo[length] != -1) {
+        stack.pop_back();
+        continue;
+      }
 
-    int max_val = std::numeric_limits<int>::min();
+      bool ready = true;
+      for (int i = 1; i <= length; i++) {
+        if (memo[length - i] == -1) {
+          stack.push_back(length - i);
+          ready = false;
+          break; // 子问题 length-1 求出后，更短的子问题也都已求出
+        }
+      }
+      if (!ready) {
+        continue;
+      }
 
-    for (int i = 1; i <= n; i++) {
-      if (i < static_cast<int>(prices.size())) {
-        max_val =
-            std::max(max_val, prices[i] + cut_rod_memoized_aux(n - i, memo));
-      } else {
-        max_val = std::max(max_val, cut_rod_memoized_aux(n - i, memo));
+      int max_val = std::numeric_limits<int>::min();
+      for (int i = 1; i <= length; i++) {
+        if (i < static_cast<int>(prices.size())) {
+          max_val = std::max(max_val, prices[i] + memo[length - i]);
+        } else {
+          max_val = std::max(max_val, memo[length - i]);
+        }
       }
+      memo[length] = max_val;
+      stack.pop_back();
     }
-
-    memo[n] = max_val;
-    return max_val;
+    return memo[n];
   }
 };
 
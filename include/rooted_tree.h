@@ -2,10 +2,14 @@
 #define ROOTED_TREE_H
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <queue>
 #include <stack>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace algorithms {
@@ -338,6 +342,239 @@ private:
   }
 };
 
+/**
+ * @brief 冻结的数组式有根树
+ *
+ * 从 RootedTree 一次性构建，之后只读。节点按先序编号为 0..n-1（根为0），
+ * 父节点、左孩子右兄弟、深度、子树大小、高度都存放在并行数组里，
+ * 按编号直接下标访问，不再逐个追踪 shared_ptr。
+ *
+ * 先序编号使得每棵子树恰好占据连续区间 [v, v + subtree_size(v))，
+ * 因此祖先判断是两次比较。欧拉序（DFS 进入每个节点以及从每个孩子返回时
+ * 各记录一次，共 2n - 1 项）上的稀疏表把 LCA 化为 O(1) 的区间最小值：
+ * 两个节点首次出现位置之间的节点都在 LCA 的子树内，而 LCA 在其中先序编号
+ * 最小，所以表里直接比较编号，不必再查深度。预处理 O(n lg n)。
+ */
+template <typename T> class PackedRootedTree {
+public:
+  static constexpr int kNone = -1;
+
+  /**
+   * @brief 从指针式有根树构建；用显式栈做DFS，深树也不会栈溢出
+   */
+  explicit PackedRootedTree(const RootedTree<T> &tree) {
+    auto root = tree.get_root();
+    if (root == nullptr) {
+      return;
+    }
+
+    struct Frame {
+      const TreeNode<T> *node;
+      int id;
+      size_t next_child;
+      int last_child;
+    };
+    std::vector<Frame> stack;
+    auto enter = [&](const TreeNode<T> *node, int parent_id, int depth_value) {
+      int id = static_cast<int>(values.size());
+      values.push_back(node->data);
+      parents.push_back(parent_id);
+      first_children.push_back(kNone);
+      next_siblings.push_back(kNone);
+      depths.push_back(depth_value);
+      sizes.push_back(1);
+      heights.push_back(0);
+      first_occurrence.push_back(static_cast<int>(euler.size()));
+      euler.push_back(id);
+      stack.push_back({node, id, 0, kNone});
+      return id;
+    };
+
+    enter(root.get(), kNone, 0);
+    while (!stack.empty()) {
+      Frame &frame = stack.back();
+      if (frame.next_child < frame.node->children.size()) {
+        const TreeNode<T> *child =
+            frame.node->children[frame.next_child++].get();
+        int parent_id = frame.id;
+        int previous = frame.last_child;
+        int child_id = enter(child, parent_id, depths[parent_id] + 1);
+        // enter 可能使 stack 重新分配，frame 引用失效，这里按下标回写
+        stack[stack.size() - 2].last_child = child_id;
+        if (previous == kNone) {
+          first_children[parent_id] = child_id;
+        } else {
+          next_siblings[previous] = child_id;
+        }
+        continue;
+      }
+      int id = frame.id;
+      stack.pop_back();
+      sizes[id] = static_cast<int>(values.size()) - id;
+      int parent_id = parents[id];
+      if (parent_id != kNone) {
+        heights[parent_id] = std::max(heights[parent_id], heights[id] + 1);
+        euler.push_back(parent_id);
+      }
+    }
+
+    build_sparse_table();
+  }
+
+  int size() const { return static_cast<int>(values.size()); }
+
+  bool empty() const { return values.empty(); }
+
+  /**
+   * @brief 根节点编号，空树返回kNone
+   */
+  int root() const { return empty() ? kNone : 0; }
+
+  const T &value(int v) const { return values[check(v)]; }
+
+  int parent(int v) const { return parents[check(v)]; }
+
+  /**
+   * @brief 左孩子，没有孩子返回kNone
+   */
+  int first_child(int v) const { return first_children[check(v)]; }
+
+  /**
+   * @brief 右兄弟，没有兄弟返回kNone
+   */
+  int next_sibling(int v) const { return next_siblings[check(v)]; }
+
+  bool is_leaf(int v) const { return first_children[check(v)] == kNone; }
+
+  int depth(int v) const { return depths[check(v)]; }
+
+  int height(int v) const { return heights[check(v)]; }
+
+  /**
+   * @brief 整棵树的高度，空树为-1（与 RootedTree::height 一致）
+   */
+  int height() const { return empty() ? -1 : heights[0]; }
+
+  int subtree_size(int v) const { return sizes[check(v)]; }
+
+  /**
+   * @brief DFS进入v的时间（即先序编号）
+   */
+  int entry_time(int v) const { return check(v); }
+
+  /**
+   * @brief DFS离开v的时间：v的子树中最后一个节点的先序编号
+   */
+  int exit_time(int v) const { return check(v) + sizes[v] - 1; }
+
+  /**
+   * @brief u是否为v的祖先（包括u == v），O(1)
+   */
+  bool is_ancestor(int u, int v) const {
+    check(u);
+    check(v);
+    return u <= v && v < u + sizes[u];
+  }
+
+  /**
+   * @brief 最近公共祖先，O(1)
+   */
+  int lca(int u, int v) const {
+    int l = first_occurrence[check(u)];
+    int r = first_occurrence[check(v)];
+    if (l > r) {
+      std::swap(l, r);
+    }
+    int level = floor_log2(static_cast<unsigned>(r - l + 1));
+    return std::min(sparse[level][l], sparse[level][r - (1 << level) + 1]);
+  }
+
+  /**
+   * @brief u和v之间路径的边数，O(1)
+   */
+  int distance(int u, int v) const {
+    return depths[check(u)] + depths[check(v)] - 2 * depths[lca(u, v)];
+  }
+
+  /**
+   * @brief 先序中第一个值为value的节点，未找到返回kNone
+   */
+  int find(const T &value) const {
+    auto it = std::find(values.begin(), values.end(), value);
+    return it == values.end() ? kNone
+                              : static_cast<int>(it - values.begin());
+  }
+
+  /**
+   * @brief 按顺序对v的每个孩子调用visit
+   */
+  template <typename Visitor> void for_each_child(int v, Visitor visit) const {
+    for (int c = first_children[check(v)]; c != kNone; c = next_siblings[c]) {
+      visit(c);
+    }
+  }
+
+  /**
+   * @brief 先序遍历结果即值数组本身
+   */
+  const std::vector<T> &preorder() const { return values; }
+
+  /**
+   * @brief 欧拉序（节点编号，长度 2n - 1）
+   */
+  const std::vector<int> &euler_tour() const { return euler; }
+
+  /**
+   * @brief 各数组与稀疏表占用的字节数（不含T内部的堆内存）
+   */
+  size_t memory_bytes() const {
+    size_t bytes = values.size() * sizeof(T) +
+                   (parents.size() + first_children.size() +
+                    next_siblings.size() + depths.size() + sizes.size() +
+                    heights.size() + first_occurrence.size() + euler.size()) *
+                       sizeof(int);
+    for (const auto &level : sparse) {
+      bytes += level.size() * sizeof(int);
+    }
+    return bytes;
+  }
+
+private:
+  std::vector<T> values;
+  std::vector<int> parents;
+  std::vector<int> first_children;
+  std::vector<int> next_siblings;
+  std::vector<int> depths;
+  std::vector<int> sizes;
+  std::vector<int> heights;
+  std::vector<int> first_occurrence; // 每个节点在欧拉序中首次出现的位置
+  std::vector<int> euler;
+  std::vector<std::vector<int>> sparse; // sparse[k][i] = min(euler[i, i + 2^k))
+
+  static int floor_log2(unsigned x) { return 31 - __builtin_clz(x); }
+
+  int check(int v) const {
+    if (v < 0 || v >= size()) {
+      throw std::out_of_range("节点编号越界");
+    }
+    return v;
+  }
+
+  void build_sparse_table() {
+    int m = static_cast<int>(euler.size());
+    sparse.assign(1, euler);
+    for (int k = 1; (1 << k) <= m; ++k) {
+      const std::vector<int> &prev = sparse[k - 1];
+      int half = 1 << (k - 1);
+      std::vector<int> level(m - (1 << k) + 1);
+      for (int i = 0; i < static_cast<int>(level.size()); ++i) {
+        level[i] = std::min(prev[i], prev[i + half]);
+      }
+      sparse.push_back(std::move(level));
+    }
+  }
+};
+
 /**
  * @brief 二叉树节点结构（有根树的特例）
  */
@@ -0,0 +1,646 @@
+#ifndef SAT_SOLVER_H
+#define SAT_SOLVER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+
+/**
+ * @brief CDCL（冲突驱动子句学习）SAT求解器
+ *
+ * 公式格式与 NPCompleteness::verify_3sat 相同：每个子句是一组非零整数，
+ * k 表示变量 x_k，-k 表示 ¬x_k（变量从1开始编号），子句长度不限于3。
+ *
+ * - 子句竞技场：所有子句连续存放在一个 uint32_t 数组里，子句用偏移量引用，
+ *   没有逐子句的堆分配
+ * - 双观察文字：每个子句只观察前两个文字，只有被观察的文字变假时才访问该子句；
+ *   观察表里附带一个“阻塞文字”，它为真时连子句本身都不必读取
+ * - VSIDS：冲突中出现的变量增加活跃度，活跃度按几何级数衰减，
+ *   决策时用二叉堆取活跃度最高的未赋值变量，极性沿用上次的取值（相位保存）
+ * - 子句学习：第一唯一蕴含点（1-UIP）学习子句，去掉被其他文字蕴含的冗余文字，
+ *   非时序回跳
+ * - 重启：Luby 序列；重启回到第0层时按 LBD 删除一半学习子句并压缩竞技场
+ *
+ * 同一个求解器可以在 solve 之后继续 add_clause 再次求解。
+ */
+class SatSolver {
+public:
+  enum class Result { kSatisfiable, kUnsatisfiable, kUnknown };
+
+  struct Statistics {
+    uint64_t decisions = 0;
+    uint64_t propagations = 0;
+    uint64_t conflicts = 0;
+    uint64_t restarts = 0;
+    uint64_t learnt_clauses = 0;
+    uint64_t deleted_clauses = 0;
+  };
+
+  SatSolver() = default;
+
+  /**
+   * @brief 用CNF公式构造
+   * @throws std::invalid_argument 如果子句中含有文字0
+   */
+  explicit SatSolver(const std::vector<std::vector<int>> &formula) {
+    for (const auto &clause : formula) {
+      add_clause(clause);
+    }
+  }
+
+  /**
+   * @brief 新建一个变量
+   * @return 变量编号（从1开始）
+   */
+  int new_variable() {
+    int v = num_variables();
+    values.push_back(0);
+    values.push_back(0);
+    levels.push_back(0);
+    reasons.push_back(kNoClause);
+    polarity.push_back(1);
+    seen.push_back(0);
+    activity.push_back(0.0);
+    level_stamp.push_back(0);
+    watches.emplace_back();
+    watches.emplace_back();
+    order.grow(v + 1);
+    order.insert(v, activity);
+    return v + 1;
+  }
+
+  int num_variables() const { return static_cast<int>(levels.size()); }
+
+  /**
+   * @brief 当前保存的子句数（原始子句与学习子句，不含单位子句）
+   */
+  size_t num_clauses() const { return original_count + learnt_count; }
+
+  /**
+   * @brief 添加一个子句；变量不够时自动新建
+   * @return 如果公式已经确定不可满足返回false
+   * @throws std::invalid_argument 如果子句中含有文字0
+   */
+  bool add_clause(const std::vector<int> &clause) {
+    if (!ok) {
+      return false;
+    }
+    cancel_until(0);
+    std::vector<uint32_t> lits;
+    lits.reserve(clause.size());
+    for (int x : clause) {
+      if (x == 0) {
+        throw std::invalid_argument("文字不能为0");
+      }
+      while (std::abs(x) > num_variables()) {
+        new_variable();
+      }
+      lits.push_back(to_lit(x));
+    }
+    std::sort(lits.begin(), lits.end());
+    lits.erase(std::unique(lits.begin(), lits.end()), lits.end());
+
+    // 去掉第0层已为假的文字；有文字为真或同时含 x 与 ¬x 则子句恒真
+    size_t j = 0;
+    for (size_t i = 0; i < lits.size(); ++i) {
+      if (values[lits[i]] == kTrue ||
+          (i + 1 < lits.size() && lits[i + 1] == (lits[i] ^ 1))) {
+        return true;
+      }
+      if (values[lits[i]] != kFalse) {
+        lits[j++] = lits[i];
+      }
+    }
+    lits.resize(j);
+
+    if (lits.empty()) {
+      ok = false;
+    } else if (lits.size() == 1) {
+      assign(lits[0], kNoClause);
+      ok = propagate() == kNoClause;
+    } else {
+      attach(store(lits, false, 0));
+      ++original_count;
+    }
+    return ok;
+  }
+
+  /**
+   * @brief 求解
+   * @param conflict_limit 冲突次数上限，0表示不限；达到上限返回kUnknown
+   */
+  Result solve(uint64_t conflict_limit = 0) {
+    if (!ok) {
+      return Result::kUnsatisfiable;
+    }
+    uint64_t start = stats.conflicts;
+    for (uint64_t round = 0;; ++round) {
+      uint64_t budget = kRestartUnit * luby(round);
+      if (conflict_limit != 0) {
+        uint64_t used = stats.conflicts - start;
+        if (used >= conflict_limit) {
+          cancel_until(0);
+          return Result::kUnknown;
+        }
+        budget = std::min(budget, conflict_limit - used);
+      }
+      Result result = search(budget);
+      if (result == Result::kSatisfiable) {
+        model.assign(num_variables(), false);
+        for (int v = 0; v < num_variables(); ++v) {
+          model[v] = values[2 * v] == kTrue;
+        }
+        cancel_until(0);
+        return result;
+      }
+      if (result == Result::kUnsatisfiable) {
+        ok = false;
+        return result;
+      }
+      ++stats.restarts;
+      if (learnt_count >= max_learnts) {
+        reduce_database();
+      }
+    }
+  }
+
+  /**
+   * @brief 最近一次满足时变量的取值
+   * @param var 变量编号（从1开始）
+   */
+  bool value(int var) const {
+    if (var < 1 || var > static_cast<int>(model.size())) {
+      throw std::out_of_range("变量编号越界");
+    }
+    return model[var - 1];
+  }
+
+  /**
+   * @brief 最近一次满足时的完整赋值，下标从0开始，可直接交给 verify_3sat
+   */
+  const std::vector<bool> &get_model() const { return model; }
+
+  const Statistics &statistics() const { return stats; }
+
+private:
+  static constexpr uint32_t kNoClause = UINT32_MAX;
+  static constexpr int8_t kTrue = 1;
+  static constexpr int8_t kFalse = -1;
+  static constexpr uint32_t kLearntBit = 1u << 31;
+  static constexpr uint32_t kDeletedBit = 1u << 30;
+  static constexpr uint32_t kSizeMask = kDeletedBit - 1;
+  static constexpr uint32_t kHeaderWords = 2; // [大小|标志] [LBD]
+  static constexpr uint64_t kRestartUnit = 100;
+  static constexpr double kVarDecay = 0.95;
+
+  struct Watcher {
+    uint32_t clause;
+    uint32_t blocker;
+  };
+
+  // 按活跃度排序的变量大根堆，支持增大键值
+  class VarOrder {
+  public:
+    void grow(int n) { position.resize(n, -1); }
+
+    bool contains(int v) const { return position[v] >= 0; }
+
+    bool empty() const { return heap.empty(); }
+
+    void insert(int v, const std::vector<double> &act) {
+      position[v] = static_cast<int>(heap.size());
+      heap.push_back(v);
+      sift_up(position[v], act);
+    }
+
+    void increased(int v, const std::vector<double> &act) {
+      if (contains(v)) {
+        sift_up(position[v], act);
+      }
+    }
+
+    int pop(const std::vector<double> &act) {
+      int top = heap[0];
+      position[top] = -1;
+      int last = heap.back();
+      heap.pop_back();
+      if (!heap.empty()) {
+        heap[0] = last;
+        position[last] = 0;
+        sift_down(0, act);
+      }
+      return top;
+    }
+
+  private:
+    std::vector<int> heap;
+    std::vector<int> position;
+
+    void sift_up(int i, const std::vector<double> &act) {
+      int v = heap[i];
+      while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (act[heap[parent]] >= act[v]) {
+          break;
+        }
+        heap[i] = heap[parent];
+        position[heap[i]] = i;
+        i = parent;
+      }
+      heap[i] = v;
+      position[v] = i;
+    }
+
+    void sift_down(int i, const std::vector<double> &act) {
+      int v = heap[i];
+      int n = static_cast<int>(heap.size());
+      for (;;) {
+        int child = 2 * i + 1;
+        if (child >= n) {
+          break;
+        }
+        if (child + 1 < n && act[heap[child + 1]] > act[heap[child]]) {
+          ++child;
+        }
+        if (act[heap[child]] <= act[v]) {
+          break;
+        }
+        heap[i] = heap[child];
+        position[heap[i]] = i;
+        i = child;
+      }
+      heap[i] = v;
+      position[v] = i;
+    }
+  };
+
+  // 文字编码：变量 v（从0开始）的正文字为 2v，负文字为 2v + 1
+  std::vector<uint32_t> arena;
+  std::vector<std::vector<Watcher>> watches; // watches[l]：观察文字 l 的子句
+  std::vector<int8_t> values;                // 按文字索引
+  std::vector<int> levels;
+  std::vector<uint32_t> reasons;
+  std::vector<uint8_t> polarity; // 1 表示上次取假
+  std::vector<uint8_t> seen;
+  std::vector<double> activity;
+  std::vector<uint64_t> level_stamp = std::vector<uint64_t>(1, 0); // 按决策层
+  std::vector<uint32_t> to_clear;
+  std::vector<uint32_t> trail;
+  std::vector<size_t> trail_lim;
+  std::vector<bool> model;
+  VarOrder order;
+  size_t qhead = 0;
+  double var_inc = 1.0;
+  uint64_t stamp = 0;
+  size_t original_count = 0;
+  size_t learnt_count = 0;
+  size_t max_learnts = 4000;
+  bool ok = true;
+  Statistics stats;
+
+  static uint32_t to_lit(int x) {
+    return 2 * static_cast<uint32_t>(std::abs(x) - 1) + (x < 0 ? 1 : 0);
+  }
+
+  static int var_of(uint32_t lit) { return static_cast<int>(lit >> 1); }
+
+  uint32_t clause_size(uint32_t c) const { return arena[c] & kSizeMask; }
+
+  bool is_learnt(uint32_t c) const { return (arena[c] & kLearntBit) != 0; }
+
+  uint32_t *literals(uint32_t c) { return &arena[c + kHeaderWords]; }
+
+  int decision_level() const { return static_cast<int>(trail_lim.size()); }
+
+  // 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, 1, 1, 2, 4, 8, ...
+  static uint64_t luby(uint64_t i) {
+    uint64_t size = 1, seq = 0;
+    while (size < i + 1) {
+      ++seq;
+      size = 2 * size + 1;
+    }
+    while (size - 1 != i) {
+      size = (size - 1) >> 1;
+      --seq;
+      i %= size;
+    }
+    return uint64_t(1) << seq;
+  }
+
+  uint32_t store(const std::vector<uint32_t> &lits, bool learnt, uint32_t lbd) {
+    uint32_t c = static_cast<uint32_t>(arena.size());
+    arena.push_back(static_cast<uint32_t>(lits.size()) |
+                    (learnt ? kLearntBit : 0));
+    arena.push_back(lbd);
+    arena.insert(arena.end(), lits.begin(), lits.end());
+    return c;
+  }
+
+  void attach(uint32_t c) {
+    uint32_t *lits = literals(c);
+    watches[lits[0]].push_back({c, lits[1]});
+    watches[lits[1]].push_back({c, lits[0]});
+  }
+
+  void assign(uint32_t lit, uint32_t reason) {
+    int v = var_of(lit);
+    values[lit] = kTrue;
+    values[lit ^ 1] = kFalse;
+    levels[v] = decision_level();
+    reasons[v] = reason;
+    trail.push_back(lit);
+  }
+
+  void cancel_until(int level) {
+    if (decision_level() <= level) {
+      return;
+    }
+    for (size_t i = trail.size(); i-- > trail_lim[level];) {
+      uint32_t lit = trail[i];
+      int v = var_of(lit);
+      values[lit] = values[lit ^ 1] = 0;
+      reasons[v] = kNoClause;
+      polarity[v] = lit & 1;
+      if (!order.contains(v)) {
+        order.insert(v, activity);
+      }
+    }
+    trail.resize(trail_lim[level]);
+    trail_lim.resize(level);
+    qhead = trail.size();
+  }
+
+  /**
+   * @brief 单位传播；返回冲突子句，无冲突返回kNoClause
+   */
+  uint32_t propagate() {
+    uint32_t conflict = kNoClause;
+    while (qhead < trail.size()) {
+      uint32_t false_lit = trail[qhead++] ^ 1;
+      std::vector<Watcher> &ws = watches[false_lit];
+      ++stats.propagations;
+      size_t i = 0, j = 0, n = ws.size();
+      while (i < n) {
+        Watcher w = ws[i++];
+        if (values[w.blocker] == kTrue) {
+          ws[j++] = w;
+          continue;
+        }
+        uint32_t *lits = literals(w.clause);
+        if (lits[0] == false_lit) {
+          std::swap(lits[0], lits[1]);
+        }
+        uint32_t first = lits[0];
+        if (first != w.blocker && values[first] == kTrue) {
+          ws[j++] = {w.clause, first};
+          continue;
+        }
+        // 找一个不为假的文字接替被观察的 lits[1]
+        uint32_t size = clause_size(w.clause);
+        bool moved = false;
+        for (uint32_t k = 2; k < size; ++k) {
+          if (values[lits[k]] != kFalse) {
+            std::swap(lits[1], lits[k]);
+            watches[lits[1]].push_back({w.clause, first});
+            moved = true;
+            break;
+          }
+        }
+        if (moved) {
+          continue;
+        }
+        ws[j++] = {w.clause, first};
+        if (values[first] == kFalse) {
+          conflict = w.clause;
+          qhead = trail.size();
+          while (i < n) {
+            ws[j++] = ws[i++];
+          }
+        } else {
+          assign(first, w.clause);
+        }
+      }
+      ws.resize(j);
+    }
+    return conflict;
+  }
+
+  void bump(int v) {
+    if ((activity[v] += var_inc) > 1e100) {
+      for (double &a : activity) {
+        a *= 1e-100;
+      }
+      var_inc *= 1e-100;
+    }
+    order.increased(v, activity);
+  }
+
+  /**
+   * @brief 1-UIP冲突分析
+   * @param learnt 输出学习子句，learnt[0] 为回跳后被蕴含的文字
+   * @return 回跳层
+   */
+  int analyze(uint32_t conflict, std::vector<uint32_t> &learnt) {
+    learnt.assign(1, 0);
+    int pending = 0;
+    uint32_t p = 0;
+    bool have_p = false;
+    size_t index = trail.size();
+    do {
+      uint32_t size = clause_size(conflict);
+      uint32_t *lits = literals(conflict);
+      // 蕴含 p 的原因子句中 lits[0] 就是 p 本身
+      for (uint32_t k = have_p ? 1 : 0; k < size; ++k) {
+        int v = var_of(lits[k]);
+        if (!seen[v] && levels[v] > 0) {
+          seen[v] = 1;
+          bump(v);
+          if (levels[v] >= decision_level()) {
+            ++pending;
+          } else {
+            learnt.push_back(lits[k]);
+          }
+        }
+      }
+      while (!seen[var_of(trail[--index])]) {
+      }
+      p = trail[index];
+      have_p = true;
+      conflict = reasons[var_of(p)];
+      seen[var_of(p)] = 0;
+      --pending;
+    } while (pending > 0);
+    learnt[0] = p ^ 1;
+
+    // 去掉原因子句的其余文字都已在学习子句中（或在第0层）的文字
+    to_clear.assign(learnt.begin() + 1, learnt.end());
+    size_t j = 1;
+    for (size_t i = 1; i < learnt.size(); ++i) {
+      uint32_t reason = reasons[var_of(learnt[i])];
+      bool redundant = reason != kNoClause;
+      if (redundant) {
+        uint32_t size = clause_size(reason);
+        uint32_t *lits = literals(reason);
+        for (uint32_t k = 1; k < size && redundant; ++k) {
+          int v = var_of(lits[k]);
+          redundant = seen[v] || levels[v] == 0;
+        }
+      }
+      if (!redundant) {
+        learnt[j++] = learnt[i];
+      }
+    }
+    learnt.resize(j);
+    for (uint32_t lit : to_clear) {
+      seen[var_of(lit)] = 0;
+    }
+
+    var_inc /= kVarDecay;
+
+    if (learnt.size() == 1) {
+      return 0;
+    }
+    size_t max_i = 1;
+    for (size_t i = 2; i < learnt.size(); ++i) {
+      if (levels[var_of(learnt[i])] > levels[var_of(learnt[max_i])]) {
+        max_i = i;
+      }
+    }
+    std::swap(learnt[1], learnt[max_i]);
+    return levels[var_of(learnt[1])];
+  }
+
+  // 学习子句涉及的不同决策层数（LBD），越小越有用
+  uint32_t literal_block_distance(const std::vector<uint32_t> &lits) {
+    ++stamp;
+    uint32_t count = 0;
+    for (uint32_t lit : lits) {
+      int level = levels[var_of(lit)];
+      if (level_stamp[level] != stamp) {
+        level_stamp[level] = stamp;
+        ++count;
+      }
+    }
+    return count;
+  }
+
+  Result search(uint64_t budget) {
+    std::vector<uint32_t> learnt;
+    uint64_t conflicts = 0;
+    for (;;) {
+      uint32_t conflict = propagate();
+      if (conflict != kNoClause) {
+        ++stats.conflicts;
+        ++conflicts;
+        if (decision_level() == 0) {
+          return Result::kUnsatisfiable;
+        }
+        int back_level = analyze(conflict, learnt);
+        cancel_until(back_level);
+        if (learnt.size() == 1) {
+          assign(learnt[0], kNoClause);
+        } else {
+          uint32_t c = store(learnt, true, literal_block_distance(learnt));
+          attach(c);
+          assign(learnt[0], c);
+          ++learnt_count;
+          ++stats.learnt_clauses;
+        }
+        continue;
+      }
+      if (conflicts >= budget) {
+        cancel_until(0);
+        return Result::kUnknown;
+      }
+      int next = -1;
+      while (!order.empty()) {
+        int v = order.pop(activity);
+        if (values[2 * v] == 0) {
+          next = v;
+          break;
+        }
+      }
+      if (next < 0) {
+        return Result::kSatisfiable;
+      }
+      ++stats.decisions;
+      trail_lim.push_back(trail.size());
+      assign(2 * static_cast<uint32_t>(next) + polarity[next], kNoClause);
+    }
+  }
+
+  /**
+   * @brief 在第0层删除一半学习子句，并丢掉已被第0层赋值满足的子句
+   *
+   * LBD ≤ 2 的学习子句总是保留；其余按 LBD 从大到小删除一半。
+   * 在第0层做，不存在被当作原因引用的子句；压缩竞技场后重建观察表。
+   */
+  void reduce_database() {
+    std::vector<std::pair<uint32_t, uint32_t>> candidates; // (LBD, 子句)
+    for (uint32_t c = 0; c < arena.size();
+         c += kHeaderWords + clause_size(c)) {
+      if (is_learnt(c) && arena[c + 1] > 2) {
+        candidates.emplace_back(arena[c + 1], c);
+      }
+    }
+    // LBD 相同时偏移量大的（更新的）排在前面，优先保留
+    std::sort(candidates.begin(), candidates.end(),
+              [](const auto &a, const auto &b) {
+                return a.first != b.first ? a.first < b.first
+                                          : a.second > b.second;
+              });
+    for (size_t i = candidates.size() / 2; i < candidates.size(); ++i) {
+      arena[candidates[i].second] |= kDeletedBit;
+    }
+
+    std::vector<uint32_t> compacted;
+    compacted.reserve(arena.size());
+    original_count = learnt_count = 0;
+    for (uint32_t c = 0; c < arena.size();) {
+      uint32_t size = clause_size(c);
+      uint32_t next = c + kHeaderWords + size;
+      bool satisfied = false;
+      for (uint32_t k = 0; k < size && !satisfied; ++k) {
+        satisfied = values[arena[c + kHeaderWords + k]] == kTrue;
+      }
+      if ((arena[c] & kDeletedBit) != 0 || satisfied) {
+        ++stats.deleted_clauses;
+      } else {
+        (is_learnt(c) ? learnt_count : original_count)++;
+        compacted.insert(compacted.end(), arena.begin() + c,
+                         arena.begin() + next);
+      }
+      c = next;
+    }
+    arena.swap(compacted);
+
+    for (auto &ws : watches) {
+      ws.clear();
+    }
+    for (int v = 0; v < num_variables(); ++v) {
+      reasons[v] = kNoClause;
+    }
+    for (uint32_t c = 0; c < arena.size();
+         c += kHeaderWords + clause_size(c)) {
+      // 第0层为假的文字不能被观察，把未赋值的文字换到前两位
+      uint32_t size = clause_size(c);
+      uint32_t *lits = literals(c);
+      for (uint32_t front = 0, k = 0; front < 2 && k < size; ++k) {
+        if (values[lits[k]] == 0) {
+          std::swap(lits[front++], lits[k]);
+        }
+      }
+      attach(c);
+    }
+    max_learnts += max_learnts / 10;
+  }
+};
+
+} // namespace algorithms
+
+#endif // SAT_SOLVER_H
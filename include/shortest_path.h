@@ -1,14 +1,21 @@
 #ifndef SHORTEST_PATH_H
 #define SHORTEST_PATH_H
 
+#include "addressable_heap.h"
+#include "fibonacci_heap.h"
 #include "graph_representation.h"
+#include "radix_heap.h"
+#include "work_stealing_scheduler.h"
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <queue>
 #include <stack>
+#include <stdexcept>
 #include <vector>
 
 namespace algorithms {
@@ -25,9 +32,11 @@ struct ShortestPathResult {
 };
 
 // 24.1 Bellman-Ford算法
+// Graph 需满足 graph_representation.h 中的图概念，source与结果均按节点下标
 class BellmanFord {
 public:
-  static ShortestPathResult find_shortest_path(const AdjacencyListGraph &graph,
+  template <typename Graph>
+  static ShortestPathResult find_shortest_path(const Graph &graph,
                                                int source) {
     int n = graph.get_node_count();
     ShortestPathResult result(n);
@@ -40,27 +49,86 @@ public:
     // 初始化距离
     result.distances[source] = 0;
 
-    // 获取所有边
-    std::vector<GraphEdge> edges = graph.get_all_edges();
-
-    // 松弛操作 |V| - 1 次
+    // 松弛操作 |V| - 1 次，某一轮没有任何更新时距离已收敛，提前结束
     for (int i = 1; i < n; i++) {
-      for (const auto &edge : edges) {
-        if (result.distances[edge.from] != std::numeric_limits<int>::max() &&
-            result.distances[edge.from] + edge.weight <
-                result.distances[edge.to]) {
-          result.distances[edge.to] = result.distances[edge.from] + edge.weight;
-          result.predecessors[edge.to] = edge.from;
+      bool changed = false;
+      for (int u = 0; u < n; u++) {
+        if (result.distances[u] == std::numeric_limits<int>::max()) {
+          continue;
         }
+        graph.for_each_out_edge(u, [&](int v, int weight) {
+          if (result.distances[u] + weight < result.distances[v]) {
+            result.distances[v] = result.distances[u] + weight;
+            result.predecessors[v] = u;
+            changed = true;
+          }
+        });
+      }
+      if (!changed) {
+        break;
       }
     }
 
     // 检查负权环
-    for (const auto &edge : edges) {
-      if (result.distances[edge.from] != std::numeric_limits<int>::max() &&
-          result.distances[edge.from] + edge.weight <
-              result.distances[edge.to]) {
-        result.has_negative_cycle = true;
+    for (int u = 0; u < n && !result.has_negative_cycle; u++) {
+      if (result.distances[u] == std::numeric_limits<int>::max()) {
+        continue;
+      }
+      graph.for_each_out_edge(u, [&](int v, int weight) {
+        if (result.distances[u] + weight < result.distances[v]) {
+          result.has_negative_cycle = true;
+        }
+      });
+    }
+
+    return result;
+  }
+};
+
+// Bellman-Ford的队列实现（SPFA）：只有距离刚被降低的节点才需要再次松弛出边，
+// 用FIFO队列保存这些节点。cnt[v] 记录当前最短路径的边数，达到 |V| 时路径上
+// 必有重复节点，说明从源点可达负权环。最坏 O(VE)，稀疏图上通常接近 O(E)。
+class SPFA {
+public:
+  template <typename Graph>
+  static ShortestPathResult find_shortest_path(const Graph &graph,
+                                               int source) {
+    int n = graph.get_node_count();
+    ShortestPathResult result(n);
+
+    // 检查空图或无效源节点
+    if (n == 0 || source < 0 || source >= n) {
+      return result;
+    }
+
+    std::vector<int> edge_count(n, 0);
+    std::vector<char> in_queue(n, 0);
+    std::queue<int> queue;
+    result.distances[source] = 0;
+    queue.push(source);
+    in_queue[source] = 1;
+
+    while (!queue.empty()) {
+      int u = queue.front();
+      queue.pop();
+      in_queue[u] = 0;
+
+      graph.for_each_out_edge(u, [&](int v, int weight) {
+        if (result.has_negative_cycle ||
+            result.distances[u] + weight >= result.distances[v]) {
+          return;
+        }
+        result.distances[v] = result.distances[u] + weight;
+        result.predecessors[v] = u;
+        edge_count[v] = edge_count[u] + 1;
+        if (edge_count[v] >= n) {
+          result.has_negative_cycle = true;
+        } else if (!in_queue[v]) {
+          queue.push(v);
+          in_queue[v] = 1;
+        }
+      });
+      if (result.has_negative_cycle) {
         break;
       }
     }
@@ -130,79 +198,391 @@ public:
   }
 };
 
+// Dijkstra算法使用的优先队列策略
+// 每种队列提供统一接口：
+//   Queue(int node_count, int max_weight)  构造
+//   bool empty() const
+//   void push(int node, int dist)          插入节点或降低其关键字
+//   std::pair<int, int> pop()              弹出(距离, 节点)，距离单调不减
+//   void reset()                           队列弹空后重置单调状态，供下一个源点复用
+// 允许队列返回过期项（距离大于当前最短距离），由Dijkstra负责跳过。
+
+// 二叉堆队列：重复插入代替DECREASE-KEY，O((V+E) lg V)
+class BinaryHeapDijkstraQueue {
+private:
+  using Entry = std::pair<int, int>; // (distance, node)
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+
+public:
+  BinaryHeapDijkstraQueue(int /*node_count*/, int /*max_weight*/) {}
+
+  bool empty() const { return heap.empty(); }
+
+  void push(int node, int dist) { heap.push({dist, node}); }
+
+  Entry pop() {
+    Entry top = heap.top();
+    heap.pop();
+    return top;
+  }
+
+  void reset() {}
+};
+
+// 斐波那契堆队列：真正的DECREASE-KEY，O(E + V lg V)（19章）
+class FibonacciHeapDijkstraQueue {
+private:
+  using Entry = std::pair<int, int>; // (distance, node)
+  FibonacciHeap<Entry> heap;
+  std::vector<std::shared_ptr<FibonacciHeapNode<Entry>>> handles;
+
+public:
+  FibonacciHeapDijkstraQueue(int node_count, int /*max_weight*/)
+      : handles(node_count, nullptr) {}
+
+  bool empty() const { return heap.is_empty(); }
+
+  void push(int node, int dist) {
+    if (handles[node]) {
+      heap.decrease_key(handles[node], {dist, node});
+    } else {
+      handles[node] = heap.insert({dist, node});
+    }
+  }
+
+  Entry pop() {
+    Entry top = heap.extract_min();
+    handles[top.second] = nullptr;
+    return top;
+  }
+
+  void reset() {}
+};
+
+// 可寻址堆队列：Heap 为 addressable_heap.h 中的任意可寻址堆，
+// 已在堆中的节点再次 push 时做 DECREASE-KEY，堆中不会出现过期项
+template <typename Heap> class AddressableHeapDijkstraQueue {
+private:
+  using Entry = std::pair<int, int>; // (distance, node)
+  using Handle = typename Heap::handle_type;
+  static constexpr Handle kNone = std::numeric_limits<Handle>::max();
+
+  Heap heap;
+  std::vector<Handle> handles;
+
+public:
+  AddressableHeapDijkstraQueue(int node_count, int /*max_weight*/)
+      : handles(node_count, kNone) {
+    heap.reserve(node_count);
+  }
+
+  bool empty() const { return heap.empty(); }
+
+  void push(int node, int dist) {
+    if (handles[node] != kNone) {
+      heap.decrease_key(handles[node], {dist, node});
+    } else {
+      handles[node] = heap.push({dist, node});
+    }
+  }
+
+  Entry pop() {
+    Entry top = heap.pop();
+    handles[top.second] = kNone;
+    return top;
+  }
+
+  void reset() {}
+};
+
+using BinaryAddressableDijkstraQueue =
+    AddressableHeapDijkstraQueue<DaryHeap<std::pair<int, int>, std::less<>, 2>>;
+using FourAryHeapDijkstraQueue =
+    AddressableHeapDijkstraQueue<DaryHeap<std::pair<int, int>, std::less<>, 4>>;
+using PairingHeapDijkstraQueue =
+    AddressableHeapDijkstraQueue<PairingHeap<std::pair<int, int>>>;
+using FibonacciAddressableDijkstraQueue =
+    AddressableHeapDijkstraQueue<FibonacciAddressableHeap<std::pair<int, int>>>;
+
+// 桶队列（Dial算法）：适用于最大权重C较小的整数权重图，O(V*C + E)
+// 所有队列中的距离都落在[d, d + C]内，因此C+1个循环桶即可
+class BucketDijkstraQueue {
+private:
+  std::vector<std::vector<int>> buckets;
+  size_t pending;  // 桶中的元素数（含过期项）
+  int current;     // 当前最小距离
+
+public:
+  BucketDijkstraQueue(int /*node_count*/, int max_weight)
+      : buckets(static_cast<size_t>(max_weight) + 1), pending(0), current(0) {
+  }
+
+  bool empty() const { return pending == 0; }
+
+  void push(int node, int dist) {
+    buckets[dist % buckets.size()].push_back(node);
+    pending++;
+  }
+
+  std::pair<int, int> pop() {
+    while (buckets[current % buckets.size()].empty()) {
+      current++;
+    }
+    auto &bucket = buckets[current % buckets.size()];
+    int node = bucket.back();
+    bucket.pop_back();
+    pending--;
+    return {current, node};
+  }
+
+  void reset() { current = 0; }
+};
+
+// 基数堆队列：利用Dijkstra弹出距离单调不减，整数距离按与上次弹出值的
+// 最高不同位分桶，push O(1)，pop 摊还 O(log C)；与桶队列不同，空间与最大权重无关
+class RadixHeapDijkstraQueue {
+private:
+  RadixHeap<int> heap;
+
+public:
+  RadixHeapDijkstraQueue(int /*node_count*/, int /*max_weight*/) {}
+
+  bool empty() const { return heap.empty(); }
+
+  void push(int node, int dist) {
+    heap.push(static_cast<std::uint32_t>(dist), node);
+  }
+
+  std::pair<int, int> pop() {
+    auto top = heap.pop();
+    return {static_cast<int>(top.first), top.second};
+  }
+
+  void reset() { heap.clear(); }
+};
+
 // 24.3 Dijkstra算法
+// Graph 需满足图概念，source与结果均按节点下标（与BellmanFord一致），边权必须非负
 class Dijkstra {
 public:
-  static ShortestPathResult find_shortest_path(const AdjacencyListGraph &graph,
+  template <typename Queue = BinaryHeapDijkstraQueue, typename Graph>
+  static ShortestPathResult find_shortest_path(const Graph &graph,
                                                int source) {
     int n = graph.get_node_count();
     ShortestPathResult result(n);
 
-    // 使用最小堆（优先队列）
-    using Pair = std::pair<int, int>; // (distance, node)
-    std::priority_queue<Pair, std::vector<Pair>, std::greater<Pair>> pq;
+    // 检查空图或无效源节点
+    if (n == 0 || source < 0 || source >= n) {
+      return result;
+    }
 
-    // 初始化
-    result.distances[source] = 0;
-    pq.push({0, source});
+    Queue queue(n, max_weight(graph));
+    run(graph, source, queue, result.distances, result.predecessors);
+    return result;
+  }
+
+  // 检查非负权重并求最大权重（桶队列需要）
+  template <typename Graph> static int max_weight(const Graph &graph) {
+    int max_weight = 0;
+    int n = graph.get_node_count();
+    for (int u = 0; u < n; u++) {
+      graph.for_each_out_edge(u, [&](int, int weight) {
+        if (weight < 0) {
+          throw std::invalid_argument("Dijkstra requires non-negative weights");
+        }
+        max_weight = std::max(max_weight, weight);
+      });
+    }
+    return max_weight;
+  }
 
-    while (!pq.empty()) {
-      auto [dist, u] = pq.top();
-      pq.pop();
+  // 在调用者提供的缓冲区上运行一次Dijkstra，便于多个源点复用队列与数组：
+  // distances 须全为 int 最大值、predecessors 须全为 -1，queue 须为空，
+  // 返回时队列已弹空并被 reset。边权的非负性由调用者用 max_weight 检查。
+  template <typename Queue, typename Graph>
+  static void run(const Graph &graph, int source, Queue &queue,
+                  std::vector<int> &distances,
+                  std::vector<int> &predecessors) {
+    distances[source] = 0;
+    queue.push(source, 0);
+
+    while (!queue.empty()) {
+      auto [dist, u] = queue.pop();
 
       // 如果当前距离不是最短距离，跳过
-      if (dist > result.distances[u])
+      if (dist > distances[u])
         continue;
 
-      // 松弛u的所有出边（简化实现）
-      // 这里使用一个简单的测试图
-      if (u == 0) {
-        if (result.distances[0] + 10 < result.distances[1]) {
-          result.distances[1] = result.distances[0] + 10;
-          result.predecessors[1] = 0;
-          pq.push({result.distances[1], 1});
-        }
-        if (result.distances[0] + 5 < result.distances[2]) {
-          result.distances[2] = result.distances[0] + 5;
-          result.predecessors[2] = 0;
-          pq.push({result.distances[2], 2});
+      // 松弛u的所有出边
+      graph.for_each_out_edge(u, [&, dist = dist, u = u](int v, int weight) {
+        int new_dist = dist + weight;
+        if (new_dist < distances[v]) {
+          distances[v] = new_dist;
+          predecessors[v] = u;
+          queue.push(v, new_dist);
         }
-      }
-      if (u == 1) {
-        if (result.distances[1] + 1 < result.distances[2]) {
-          result.distances[2] = result.distances[1] + 1;
-          result.predecessors[2] = 1;
-          pq.push({result.distances[2], 2});
-        }
-        if (result.distances[1] + 2 < result.distances[3]) {
-          result.distances[3] = result.distances[1] + 2;
-          result.predecessors[3] = 1;
-          pq.push({result.distances[3], 3});
+      });
+    }
+    queue.reset();
+  }
+};
+
+// Δ-步进（Meyer与Sanders）：并行单源最短路径，边权必须非负
+//
+// 按 ⌊d/Δ⌋ 把待处理节点放入桶中，从小到大处理桶：反复并行松弛当前桶中
+// 节点的轻边（w ≤ Δ，可能落回当前桶），桶清空后再一次性松弛这一轮取出
+// 过的节点的重边。Δ = 1 时接近Dijkstra（工作量最小、并行度最低），
+// Δ ≥ 最大权重时退化为按轮同步的Bellman-Ford（并行度最高、重复松弛最多）。
+// delta ≤ 0 时取 max_weight / 平均出度。
+//
+// 距离与前驱打包成一个64位原子量，用CAS做"严格变小才更新"的原子取最小，
+// 两者始终一致；距离与线程调度无关，等长路径之间前驱的选择可能不同。
+// 待处理节点的距离都落在 [iΔ, iΔ + max_weight] 内，桶数组循环使用。
+class DeltaStepping {
+public:
+  template <typename Graph>
+  static ShortestPathResult find_shortest_path(const Graph &graph, int source,
+                                               WorkStealingScheduler &scheduler,
+                                               int delta = 0) {
+    int n = graph.get_node_count();
+    ShortestPathResult result(n);
+
+    // 检查空图或无效源节点
+    if (n == 0 || source < 0 || source >= n) {
+      return result;
+    }
+
+    long long edges = 0;
+    int max_weight = 0;
+    for (int u = 0; u < n; u++) {
+      graph.for_each_out_edge(u, [&](int, int weight) {
+        if (weight < 0) {
+          throw std::invalid_argument(
+              "Delta-stepping requires non-negative weights");
         }
+        max_weight = std::max(max_weight, weight);
+        edges++;
+      });
+    }
+    if (delta <= 0) {
+      long long degree = std::max(1LL, edges / n);
+      delta = static_cast<int>(std::max(1LL, max_weight / degree));
+    }
+
+    std::vector<std::atomic<std::uint64_t>> state(n);
+    for (auto &entry : state) {
+      entry.store(pack(kInfinity, -1), std::memory_order_relaxed);
+    }
+    state[source].store(pack(0, -1), std::memory_order_relaxed);
+
+    size_t bucket_count = static_cast<size_t>(max_weight / delta) + 2;
+    std::vector<std::vector<int>> buckets(bucket_count);
+    buckets[0].push_back(source);
+    size_t pending = 1;
+
+    size_t chunk_limit = 4 * scheduler.get_num_threads();
+    std::vector<std::vector<int>> improved(chunk_limit);
+    std::vector<int> frontier, settled;
+    std::vector<long long> frontier_round(n, -1), settled_round(n, -1);
+    long long round = 0;
+
+    // 并行松弛 nodes 中每个节点的轻边或重边，被降低的节点按新距离入桶
+    auto relax = [&](const std::vector<int> &nodes, bool light) {
+      if (nodes.empty()) {
+        return;
       }
-      if (u == 2) {
-        if (result.distances[2] + 9 < result.distances[3]) {
-          result.distances[3] = result.distances[2] + 9;
-          result.predecessors[3] = 2;
-          pq.push({result.distances[3], 3});
+      size_t chunks = std::min(nodes.size(), chunk_limit);
+      scheduler.parallel_for(0, chunks, 1, [&](size_t lo, size_t hi) {
+        for (size_t c = lo; c < hi; c++) {
+          std::vector<int> &out = improved[c];
+          size_t begin = nodes.size() * c / chunks;
+          size_t end = nodes.size() * (c + 1) / chunks;
+          for (size_t k = begin; k < end; k++) {
+            int u = nodes[k];
+            int du = distance_of(state[u].load(std::memory_order_relaxed));
+            graph.for_each_out_edge(u, [&](int v, int weight) {
+              if ((weight <= delta) == light &&
+                  try_improve(state[v], du + weight, u)) {
+                out.push_back(v);
+              }
+            });
+          }
         }
-        if (result.distances[2] + 2 < result.distances[4]) {
-          result.distances[4] = result.distances[2] + 2;
-          result.predecessors[4] = 2;
-          pq.push({result.distances[4], 4});
+      });
+      for (size_t c = 0; c < chunks; c++) {
+        for (int v : improved[c]) {
+          int dv = distance_of(state[v].load(std::memory_order_relaxed));
+          buckets[static_cast<size_t>(dv / delta) % bucket_count].push_back(v);
+          pending++;
         }
+        improved[c].clear();
       }
-      if (u == 3) {
-        if (result.distances[3] + 6 < result.distances[4]) {
-          result.distances[4] = result.distances[3] + 6;
-          result.predecessors[4] = 3;
-          pq.push({result.distances[4], 4});
+    };
+
+    for (size_t i = 0; pending > 0; i++) {
+      std::vector<int> &bucket = buckets[i % bucket_count];
+      settled.clear();
+      while (!bucket.empty()) {
+        // 取出当前桶，丢弃已移到更小距离的过期项与重复项
+        frontier.clear();
+        round++;
+        for (int v : bucket) {
+          int dv = distance_of(state[v].load(std::memory_order_relaxed));
+          if (static_cast<size_t>(dv / delta) == i &&
+              frontier_round[v] != round) {
+            frontier_round[v] = round;
+            frontier.push_back(v);
+            if (settled_round[v] != static_cast<long long>(i)) {
+              settled_round[v] = i;
+              settled.push_back(v);
+            }
+          }
         }
+        pending -= bucket.size();
+        bucket.clear();
+        relax(frontier, true);
       }
+      relax(settled, false);
     }
 
+    for (int v = 0; v < n; v++) {
+      std::uint64_t entry = state[v].load(std::memory_order_relaxed);
+      result.distances[v] = distance_of(entry);
+      result.predecessors[v] = predecessor_of(entry);
+    }
     return result;
   }
+
+private:
+  static constexpr int kInfinity = std::numeric_limits<int>::max();
+
+  // 高32位为距离，低32位为前驱下标（-1存为全1）
+  static std::uint64_t pack(int distance, int predecessor) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(distance))
+            << 32) |
+           static_cast<std::uint32_t>(predecessor);
+  }
+
+  static int distance_of(std::uint64_t entry) {
+    return static_cast<int>(entry >> 32);
+  }
+
+  static int predecessor_of(std::uint64_t entry) {
+    return static_cast<int>(static_cast<std::uint32_t>(entry));
+  }
+
+  // 距离严格变小时原子地写入 (distance, predecessor)，返回是否更新
+  static bool try_improve(std::atomic<std::uint64_t> &entry, int distance,
+                          int predecessor) {
+    std::uint64_t current = entry.load(std::memory_order_relaxed);
+    while (distance < distance_of(current)) {
+      if (entry.compare_exchange_weak(current, pack(distance, predecessor),
+                                      std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
 };
 
 // 24.4 差分约束和最短路径
@@ -0,0 +1,81 @@
+#ifndef SLAB_ALLOCATOR_H
+#define SLAB_ALLOCATOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace algorithms {
+
+/**
+ * @brief 定长对象的slab分配器
+ *
+ * 每次向系统申请一整块（slab）放下多个对象，释放的对象串成空闲链表复用。
+ * 对象按alignof(T)对齐，同一slab内的对象连续存放。
+ */
+template <typename T> class SlabAllocator {
+public:
+  explicit SlabAllocator(size_t objects_per_slab = 256)
+      : per_slab(std::max<size_t>(1, objects_per_slab)) {}
+
+  SlabAllocator(const SlabAllocator &) = delete;
+  SlabAllocator &operator=(const SlabAllocator &) = delete;
+
+  ~SlabAllocator() { release_all(); }
+
+  // 返回未构造的对象存储
+  void *allocate() {
+    if (free_list != nullptr) {
+      FreeNode *node = free_list;
+      free_list = node->next;
+      return node;
+    }
+    if (slabs.empty() || used_in_slab == per_slab) {
+      slabs.push_back(static_cast<Storage *>(::operator new(
+          per_slab * sizeof(Storage), std::align_val_t(alignof(Storage)))));
+      used_in_slab = 0;
+    }
+    return &slabs.back()[used_in_slab++];
+  }
+
+  // 归还（已析构的）对象存储
+  void deallocate(void *pointer) {
+    FreeNode *node = static_cast<FreeNode *>(pointer);
+    node->next = free_list;
+    free_list = node;
+  }
+
+  // 一次性释放所有slab（调用者负责先析构仍存活的对象）
+  void release_all() {
+    for (Storage *slab : slabs) {
+      ::operator delete(slab, std::align_val_t(alignof(Storage)));
+    }
+    slabs.clear();
+    free_list = nullptr;
+    used_in_slab = 0;
+  }
+
+  size_t bytes_reserved() const {
+    return slabs.size() * per_slab * sizeof(Storage);
+  }
+
+private:
+  struct FreeNode {
+    FreeNode *next;
+  };
+  struct alignas(alignof(T) > alignof(FreeNode) ? alignof(T)
+                                                  : alignof(FreeNode)) Storage {
+    unsigned char bytes[sizeof(T) > sizeof(FreeNode) ? sizeof(T)
+                                                     : sizeof(FreeNode)];
+  };
+
+  size_t per_slab;
+  std::vector<Storage *> slabs;
+  size_t used_in_slab = 0;
+  FreeNode *free_list = nullptr;
+};
+
+} // namespace algorithms
+
+#endif // SLAB_ALLOCATOR_H
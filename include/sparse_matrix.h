@@ -0,0 +1,381 @@
+#ifndef SPARSE_MATRIX_H
+#define SPARSE_MATRIX_H
+
+#include "work_stealing_scheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+
+/**
+ * @brief 稀疏矩阵的一个非零元 (row, col, value)
+ */
+struct SparseTriplet {
+  int row;
+  int col;
+  double value;
+};
+
+/**
+ * @brief 按列压缩存储（CSC）的稀疏矩阵
+ *
+ * 第 j 列的非零元位于 [col_start[j], col_start[j+1])，行号在列内严格递增。
+ * 转置矩阵的CSC即原矩阵的按行压缩（CSR），需要按行访问时用 transpose()。
+ */
+class SparseMatrixCSC {
+private:
+  size_t rows;
+  size_t cols;
+  std::vector<size_t> col_start;
+  std::vector<int> row_index;
+  std::vector<double> values;
+
+public:
+  SparseMatrixCSC() : rows(0), cols(0), col_start(1, 0) {}
+
+  /**
+   * @brief 由三元组构造，重复位置的值相加，结果为0的元素被丢弃
+   * @throws std::out_of_range 行号或列号越界
+   */
+  SparseMatrixCSC(size_t rows, size_t cols,
+                  const std::vector<SparseTriplet> &entries)
+      : rows(rows), cols(cols), col_start(cols + 1, 0) {
+    for (const SparseTriplet &e : entries) {
+      if (e.row < 0 || static_cast<size_t>(e.row) >= rows || e.col < 0 ||
+          static_cast<size_t>(e.col) >= cols) {
+        throw std::out_of_range("非零元的位置超出矩阵范围");
+      }
+      col_start[e.col + 1]++;
+    }
+    for (size_t j = 0; j < cols; j++) {
+      col_start[j + 1] += col_start[j];
+    }
+    std::vector<size_t> fill(col_start.begin(), col_start.end() - 1);
+    std::vector<int> rows_tmp(entries.size());
+    std::vector<double> values_tmp(entries.size());
+    for (const SparseTriplet &e : entries) {
+      size_t k = fill[e.col]++;
+      rows_tmp[k] = e.row;
+      values_tmp[k] = e.value;
+    }
+
+    // 列内按行号排序并合并重复元素
+    std::vector<size_t> perm;
+    size_t out = 0;
+    for (size_t j = 0; j < cols; j++) {
+      size_t begin = col_start[j], end = col_start[j + 1];
+      perm.resize(end - begin);
+      for (size_t k = begin; k < end; k++) {
+        perm[k - begin] = k;
+      }
+      std::sort(perm.begin(), perm.end(), [&](size_t a, size_t b) {
+        return rows_tmp[a] < rows_tmp[b];
+      });
+      col_start[j] = out;
+      for (size_t k = 0; k < perm.size();) {
+        int row = rows_tmp[perm[k]];
+        double sum = 0.0;
+        for (; k < perm.size() && rows_tmp[perm[k]] == row; k++) {
+          sum += values_tmp[perm[k]];
+        }
+        if (sum != 0.0) {
+          row_index.push_back(row);
+          values.push_back(sum);
+          out++;
+        }
+      }
+    }
+    col_start[cols] = out;
+  }
+
+  /**
+   * @brief 由稠密矩阵构造，绝对值不超过 drop_tolerance 的元素视为0
+   */
+  static SparseMatrixCSC
+  from_dense(const std::vector<std::vector<double>> &dense,
+             double drop_tolerance = 0.0) {
+    size_t rows = dense.size();
+    size_t cols = rows == 0 ? 0 : dense[0].size();
+    std::vector<SparseTriplet> entries;
+    for (size_t i = 0; i < rows; i++) {
+      if (dense[i].size() != cols) {
+        throw std::invalid_argument("稠密矩阵各行长度必须相同");
+      }
+      for (size_t j = 0; j < cols; j++) {
+        if (std::abs(dense[i][j]) > drop_tolerance) {
+          entries.push_back(
+              {static_cast<int>(i), static_cast<int>(j), dense[i][j]});
+        }
+      }
+    }
+    return SparseMatrixCSC(rows, cols, entries);
+  }
+
+  size_t get_rows() const { return rows; }
+  size_t get_cols() const { return cols; }
+  size_t get_nonzeros() const { return row_index.size(); }
+
+  const std::vector<size_t> &get_col_start() const { return col_start; }
+  const std::vector<int> &get_row_index() const { return row_index; }
+  const std::vector<double> &get_values() const { return values; }
+
+  /**
+   * @brief 转置，O(rows + cols + nnz)；结果即原矩阵的CSR
+   */
+  SparseMatrixCSC transpose() const {
+    SparseMatrixCSC t;
+    t.rows = cols;
+    t.cols = rows;
+    t.col_start.assign(rows + 1, 0);
+    t.row_index.resize(row_index.size());
+    t.values.resize(values.size());
+    for (int i : row_index) {
+      t.col_start[i + 1]++;
+    }
+    for (size_t i = 0; i < rows; i++) {
+      t.col_start[i + 1] += t.col_start[i];
+    }
+    std::vector<size_t> fill(t.col_start.begin(), t.col_start.end() - 1);
+    for (size_t j = 0; j < cols; j++) {
+      for (size_t k = col_start[j]; k < col_start[j + 1]; k++) {
+        size_t slot = fill[row_index[k]]++;
+        t.row_index[slot] = static_cast<int>(j);
+        t.values[slot] = values[k];
+      }
+    }
+    return t;
+  }
+
+  /**
+   * @brief y = A x
+   */
+  std::vector<double> multiply(const std::vector<double> &x) const {
+    if (x.size() != cols) {
+      throw std::invalid_argument("向量长度与矩阵列数不一致");
+    }
+    std::vector<double> y(rows, 0.0);
+    for (size_t j = 0; j < cols; j++) {
+      if (x[j] == 0.0) {
+        continue;
+      }
+      for (size_t k = col_start[j]; k < col_start[j + 1]; k++) {
+        y[row_index[k]] += values[k] * x[j];
+      }
+    }
+    return y;
+  }
+
+  /**
+   * @brief x = A^T y
+   */
+  std::vector<double> multiply_transpose(const std::vector<double> &y) const {
+    if (y.size() != rows) {
+      throw std::invalid_argument("向量长度与矩阵行数不一致");
+    }
+    std::vector<double> x(cols, 0.0);
+    for (size_t j = 0; j < cols; j++) {
+      double sum = 0.0;
+      for (size_t k = col_start[j]; k < col_start[j + 1]; k++) {
+        sum += values[k] * y[row_index[k]];
+      }
+      x[j] = sum;
+    }
+    return x;
+  }
+
+  std::vector<std::vector<double>> to_dense() const {
+    std::vector<std::vector<double>> dense(rows, std::vector<double>(cols));
+    for (size_t j = 0; j < cols; j++) {
+      for (size_t k = col_start[j]; k < col_start[j + 1]; k++) {
+        dense[row_index[k]][j] = values[k];
+      }
+    }
+    return dense;
+  }
+};
+
+/**
+ * @brief 按行压缩存储（CSR）的稀疏矩阵，面向迭代法中的矩阵向量乘
+ *
+ * 第 i 行的非零元位于 [row_start[i], row_start[i+1])，列号在行内严格递增。
+ * y = A x 逐行计算，每行只写 y[i]，行与行之间没有写冲突，可以直接并行。
+ * 构造时按非零元个数把行切成约 kChunkNonzeros 个非零元一块，并行乘法以块
+ * 为单位交给调度器，行长不均匀时各线程的工作量也大致相同。
+ */
+class SparseMatrixCSR {
+private:
+  static constexpr size_t kChunkNonzeros = size_t(1) << 15;
+
+  size_t rows;
+  size_t cols;
+  std::vector<size_t> row_start;
+  std::vector<int> col_index;
+  std::vector<double> values;
+  std::vector<size_t> chunk_start; // 每块的首行，末尾为 rows
+
+  // 转置后的CSC即CSR
+  void adopt(const SparseMatrixCSC &transposed) {
+    rows = transposed.get_cols();
+    cols = transposed.get_rows();
+    row_start = transposed.get_col_start();
+    col_index = transposed.get_row_index();
+    values = transposed.get_values();
+    build_chunks();
+  }
+
+  void build_chunks() {
+    chunk_start.assign(1, 0);
+    size_t next = kChunkNonzeros;
+    for (size_t i = 0; i < rows; i++) {
+      if (row_start[i + 1] >= next) {
+        chunk_start.push_back(i + 1);
+        next = row_start[i + 1] + kChunkNonzeros;
+      }
+    }
+    if (chunk_start.back() != rows) {
+      chunk_start.push_back(rows);
+    }
+  }
+
+  void multiply_rows(const double *x, double *y, size_t begin,
+                     size_t end) const {
+    for (size_t i = begin; i < end; i++) {
+      double sum = 0.0;
+      for (size_t k = row_start[i]; k < row_start[i + 1]; k++) {
+        sum += values[k] * x[col_index[k]];
+      }
+      y[i] = sum;
+    }
+  }
+
+public:
+  SparseMatrixCSR() : rows(0), cols(0), row_start(1, 0), chunk_start(1, 0) {}
+
+  /**
+   * @brief 由三元组构造，重复位置的值相加，结果为0的元素被丢弃
+   * @throws std::out_of_range 行号或列号越界
+   */
+  SparseMatrixCSR(size_t rows, size_t cols,
+                  const std::vector<SparseTriplet> &entries) {
+    std::vector<SparseTriplet> swapped(entries.size());
+    for (size_t k = 0; k < entries.size(); k++) {
+      swapped[k] = {entries[k].col, entries[k].row, entries[k].value};
+    }
+    adopt(SparseMatrixCSC(cols, rows, swapped));
+  }
+
+  /**
+   * @brief 直接接管按行生成好的CSR数组（如PDE网格逐行生成），不排序不复制
+   * @throws std::invalid_argument 数组长度不符、行指针不单调或行内列号
+   *         不严格递增
+   * @throws std::out_of_range 列号越界
+   */
+  SparseMatrixCSR(size_t rows, size_t cols, std::vector<size_t> row_start,
+                  std::vector<int> col_index, std::vector<double> values)
+      : rows(rows), cols(cols), row_start(std::move(row_start)),
+        col_index(std::move(col_index)), values(std::move(values)) {
+    if (this->row_start.size() != rows + 1 || this->row_start[0] != 0 ||
+        this->row_start[rows] != this->col_index.size() ||
+        this->values.size() != this->col_index.size()) {
+      throw std::invalid_argument("CSR数组长度不一致");
+    }
+    for (size_t i = 0; i < rows; i++) {
+      if (this->row_start[i] > this->row_start[i + 1]) {
+        throw std::invalid_argument("CSR行指针必须单调不减");
+      }
+      for (size_t k = this->row_start[i]; k < this->row_start[i + 1]; k++) {
+        int j = this->col_index[k];
+        if (j < 0 || static_cast<size_t>(j) >= cols) {
+          throw std::out_of_range("非零元的位置超出矩阵范围");
+        }
+        if (k > this->row_start[i] && this->col_index[k - 1] >= j) {
+          throw std::invalid_argument("CSR行内列号必须严格递增");
+        }
+      }
+    }
+    build_chunks();
+  }
+
+  explicit SparseMatrixCSR(const SparseMatrixCSC &A) { adopt(A.transpose()); }
+
+  static SparseMatrixCSR
+  from_dense(const std::vector<std::vector<double>> &dense,
+             double drop_tolerance = 0.0) {
+    return SparseMatrixCSR(SparseMatrixCSC::from_dense(dense, drop_tolerance));
+  }
+
+  size_t get_rows() const { return rows; }
+  size_t get_cols() const { return cols; }
+  size_t get_nonzeros() const { return col_index.size(); }
+
+  const std::vector<size_t> &get_row_start() const { return row_start; }
+  const std::vector<int> &get_col_index() const { return col_index; }
+  const std::vector<double> &get_values() const { return values; }
+
+  /**
+   * @brief 对角元，缺失的位置为0
+   * @throws std::invalid_argument 矩阵不是方阵
+   */
+  std::vector<double> diagonal() const {
+    if (rows != cols) {
+      throw std::invalid_argument("只有方阵才有对角元");
+    }
+    std::vector<double> d(rows, 0.0);
+    for (size_t i = 0; i < rows; i++) {
+      for (size_t k = row_start[i]; k < row_start[i + 1]; k++) {
+        if (static_cast<size_t>(col_index[k]) == i) {
+          d[i] = values[k];
+        }
+      }
+    }
+    return d;
+  }
+
+  /**
+   * @brief y = A x
+   */
+  std::vector<double> multiply(const std::vector<double> &x) const {
+    std::vector<double> y(rows);
+    multiply(x, y);
+    return y;
+  }
+
+  /**
+   * @brief y = A x，写入已有的 y，不分配内存
+   */
+  void multiply(const std::vector<double> &x, std::vector<double> &y) const {
+    if (x.size() != cols) {
+      throw std::invalid_argument("向量长度与矩阵列数不一致");
+    }
+    y.resize(rows);
+    multiply_rows(x.data(), y.data(), 0, rows);
+  }
+
+  /**
+   * @brief 并行 y = A x：按非零元均分的行块由调度器执行
+   */
+  void multiply(WorkStealingScheduler &scheduler,
+                const std::vector<double> &x, std::vector<double> &y) const {
+    if (x.size() != cols) {
+      throw std::invalid_argument("向量长度与矩阵列数不一致");
+    }
+    y.resize(rows);
+    const double *in = x.data();
+    double *out = y.data();
+    scheduler.parallel_for(0, chunk_start.size() - 1, 1,
+                           [&](size_t lo, size_t hi) {
+                             for (size_t c = lo; c < hi; c++) {
+                               multiply_rows(in, out, chunk_start[c],
+                                             chunk_start[c + 1]);
+                             }
+                           });
+  }
+};
+
+} // namespace algorithms
+
+#endif // SPARSE_MATRIX_H
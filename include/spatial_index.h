@@ -0,0 +1,901 @@
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include "computational_geometry.h"
+#include "work_stealing_scheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+
+// 轴对齐矩形，默认构造为空矩形
+struct Box {
+  double min_x = std::numeric_limits<double>::infinity();
+  double min_y = std::numeric_limits<double>::infinity();
+  double max_x = -std::numeric_limits<double>::infinity();
+  double max_y = -std::numeric_limits<double>::infinity();
+
+  Box() = default;
+
+  Box(double min_x, double min_y, double max_x, double max_y)
+      : min_x(min_x), min_y(min_y), max_x(max_x), max_y(max_y) {}
+
+  static Box of(const Point &p) { return Box(p.x, p.y, p.x, p.y); }
+
+  static Box of(const Segment &s) {
+    return Box(std::min(s.p1.x, s.p2.x), std::min(s.p1.y, s.p2.y),
+               std::max(s.p1.x, s.p2.x), std::max(s.p1.y, s.p2.y));
+  }
+
+  bool empty() const { return min_x > max_x || min_y > max_y; }
+
+  void expand(const Box &other) {
+    min_x = std::min(min_x, other.min_x);
+    min_y = std::min(min_y, other.min_y);
+    max_x = std::max(max_x, other.max_x);
+    max_y = std::max(max_y, other.max_y);
+  }
+
+  bool intersects(const Box &other) const {
+    return min_x <= other.max_x && other.min_x <= max_x &&
+           min_y <= other.max_y && other.min_y <= max_y;
+  }
+
+  bool contains(const Point &p) const {
+    return min_x <= p.x && p.x <= max_x && min_y <= p.y && p.y <= max_y;
+  }
+
+  bool contains(const Box &other) const {
+    return min_x <= other.min_x && other.max_x <= max_x &&
+           min_y <= other.min_y && other.max_y <= max_y;
+  }
+
+  Point center() const {
+    return Point(min_x + (max_x - min_x) / 2, min_y + (max_y - min_y) / 2);
+  }
+
+  // 点到矩形的距离的平方，点在矩形内时为0
+  double distance_squared(const Point &p) const {
+    double dx = std::max({min_x - p.x, 0.0, p.x - max_x});
+    double dy = std::max({min_y - p.y, 0.0, p.y - max_y});
+    return dx * dx + dy * dy;
+  }
+};
+
+// 查询点到索引元素的距离的平方
+class SpatialDistance {
+public:
+  static double squared(const Point &q, const Point &p) {
+    double dx = p.x - q.x, dy = p.y - q.y;
+    return dx * dx + dy * dy;
+  }
+
+  // 到线段上最近点（q 在线段所在直线上的投影，截断到两端点之间）
+  static double squared(const Point &q, const Segment &s) {
+    double dx = s.p2.x - s.p1.x, dy = s.p2.y - s.p1.y;
+    double length = dx * dx + dy * dy;
+    if (length == 0)
+      return squared(q, s.p1);
+    double t = ((q.x - s.p1.x) * dx + (q.y - s.p1.y) * dy) / length;
+    t = std::min(std::max(t, 0.0), 1.0);
+    return squared(q, Point(s.p1.x + t * dx, s.p1.y + t * dy));
+  }
+};
+
+/**
+ * @brief 批量构建的静态k-d树
+ *
+ * 每次沿外接矩形较长的一边，用 nth_element 按中位数把点分成两半，
+ * 不超过 leaf_size 个点时成为叶子。点按树的顺序重排后连续存放，
+ * 每个节点记录子树的外接矩形，查询用矩形而不是分割线剪枝。
+ * - nearest(q, k)：k个最近点，深度优先，先进入较近的孩子，O(lg n + k) 期望
+ * - within_radius(q, r)：距离不超过 r 的点
+ * - in_box(box)：落在矩形内的点，整棵子树都在矩形内时直接输出
+ * 查询结果是输入中的下标。
+ */
+class KDTree {
+public:
+  explicit KDTree(const std::vector<Point> &points, size_t leaf_size = 16)
+      : index(points.size()) {
+    if (points.size() > std::numeric_limits<uint32_t>::max()) {
+      throw std::length_error("KDTree: too many points");
+    }
+    leaf_size = std::max<size_t>(leaf_size, 1);
+    std::iota(index.begin(), index.end(), size_t(0));
+    if (!points.empty()) {
+      build(points, 0, points.size(), leaf_size);
+    }
+    coordinates.reserve(points.size());
+    for (size_t i : index) {
+      coordinates.push_back(points[i]);
+    }
+  }
+
+  size_t size() const { return index.size(); }
+
+  // 按距离从近到远（距离相同时按下标）的 k 个最近点
+  std::vector<size_t> nearest(const Point &q, size_t k) const {
+    std::vector<std::pair<double, size_t>> heap; // 最大堆，堆顶为当前第k近
+    if (k == 0 || nodes.empty())
+      return {};
+    std::vector<uint32_t> stack = {0};
+    while (!stack.empty()) {
+      const Node &node = nodes[stack.back()];
+      stack.pop_back();
+      if (heap.size() == k && node.box.distance_squared(q) > heap.front().first)
+        continue;
+      if (node.left == kLeaf) {
+        for (uint32_t i = node.begin; i < node.end; i++) {
+          std::pair<double, size_t> candidate(
+              SpatialDistance::squared(q, coordinates[i]), index[i]);
+          if (heap.size() < k) {
+            heap.push_back(candidate);
+            std::push_heap(heap.begin(), heap.end());
+          } else if (candidate < heap.front()) {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back() = candidate;
+            std::push_heap(heap.begin(), heap.end());
+          }
+        }
+        continue;
+      }
+      // 较近的孩子后入栈、先访问
+      uint32_t near = node.left, far = node.right;
+      if (nodes[far].box.distance_squared(q) <
+          nodes[near].box.distance_squared(q)) {
+        std::swap(near, far);
+      }
+      stack.push_back(far);
+      stack.push_back(near);
+    }
+    std::sort_heap(heap.begin(), heap.end());
+    std::vector<size_t> result;
+    result.reserve(heap.size());
+    for (const auto &entry : heap) {
+      result.push_back(entry.second);
+    }
+    return result;
+  }
+
+  // 与 q 的距离不超过 radius 的点，顺序不定
+  std::vector<size_t> within_radius(const Point &q, double radius) const {
+    std::vector<size_t> result;
+    double limit = radius * radius;
+    visit(
+        [&](const Box &box) { return box.distance_squared(q) <= limit; },
+        [&](const Box &box) {
+          return std::max(SpatialDistance::squared(
+                              q, Point(box.min_x, box.min_y)),
+                          SpatialDistance::squared(
+                              q, Point(box.max_x, box.max_y))) <= limit &&
+                 std::max(SpatialDistance::squared(
+                              q, Point(box.min_x, box.max_y)),
+                          SpatialDistance::squared(
+                              q, Point(box.max_x, box.min_y))) <= limit;
+        },
+        [&](uint32_t i) {
+          return SpatialDistance::squared(q, coordinates[i]) <= limit;
+        },
+        result);
+    return result;
+  }
+
+  // 落在矩形 box 内（含边界）的点，顺序不定
+  std::vector<size_t> in_box(const Box &box) const {
+    std::vector<size_t> result;
+    visit([&](const Box &node) { return box.intersects(node); },
+          [&](const Box &node) { return box.contains(node); },
+          [&](uint32_t i) { return box.contains(coordinates[i]); }, result);
+    return result;
+  }
+
+private:
+  static constexpr uint32_t kLeaf = std::numeric_limits<uint32_t>::max();
+
+  struct Node {
+    Box box;
+    uint32_t begin, end;  // 子树的点在 coordinates 中的范围
+    uint32_t left, right; // 叶子的 left 为 kLeaf
+  };
+
+  std::vector<size_t> index;       // 树中第 i 个点在输入中的下标
+  std::vector<Point> coordinates;  // 按树的顺序排列的点
+  std::vector<Node> nodes;         // nodes[0] 为根
+
+  uint32_t build(const std::vector<Point> &points, size_t begin, size_t end,
+                 size_t leaf_size) {
+    uint32_t id = static_cast<uint32_t>(nodes.size());
+    nodes.push_back({Box(), static_cast<uint32_t>(begin),
+                     static_cast<uint32_t>(end), kLeaf, kLeaf});
+    Box box;
+    for (size_t i = begin; i < end; i++) {
+      box.expand(Box::of(points[index[i]]));
+    }
+    nodes[id].box = box;
+    if (end - begin <= leaf_size)
+      return id;
+
+    bool by_x = box.max_x - box.min_x >= box.max_y - box.min_y;
+    size_t mid = begin + (end - begin) / 2;
+    std::nth_element(index.begin() + begin, index.begin() + mid,
+                     index.begin() + end, [&](size_t a, size_t b) {
+                       return by_x ? points[a].x < points[b].x
+                                   : points[a].y < points[b].y;
+                     });
+    uint32_t left = build(points, begin, mid, leaf_size);
+    uint32_t right = build(points, mid, end, leaf_size);
+    nodes[id].left = left;
+    nodes[id].right = right;
+    return id;
+  }
+
+  // 范围查询的公共遍历：可能相交的子树才进入，整棵子树都满足时直接输出
+  template <typename MayMatch, typename AllMatch, typename Match>
+  void visit(MayMatch may_match, AllMatch all_match, Match match,
+             std::vector<size_t> &result) const {
+    if (nodes.empty())
+      return;
+    std::vector<uint32_t> stack = {0};
+    while (!stack.empty()) {
+      const Node &node = nodes[stack.back()];
+      stack.pop_back();
+      if (!may_match(node.box))
+        continue;
+      if (all_match(node.box)) {
+        result.insert(result.end(), index.begin() + node.begin,
+                      index.begin() + node.end);
+      } else if (node.left == kLeaf) {
+        for (uint32_t i = node.begin; i < node.end; i++) {
+          if (match(i))
+            result.push_back(index[i]);
+        }
+      } else {
+        stack.push_back(node.right);
+        stack.push_back(node.left);
+      }
+    }
+  }
+};
+
+/**
+ * @brief STR（Sort-Tile-Recursive）批量装载的静态R树，元素为 Point 或 Segment
+ *
+ * 装载：设共有 P = ⌈n / B⌉ 个叶子（B 为节点容量），按外接矩形中心的 x 排序后
+ * 切成 ⌈√P⌉ 条竖带，每条带内再按中心的 y 排序，连续每 B 个成为一个节点；
+ * 对上一层的节点重复这一过程，直到只剩根。除每层最后一个节点外，节点都是满的，
+ * 同一节点的孩子连续存放。
+ * - in_box(box)：外接矩形与 box 相交的元素（对点即落在 box 内）
+ * - nearest(q, k)：按到元素的真实距离的 k 个最近元素，用最小堆按距离逐个展开
+ *   节点（best-first），距离相同时先展开节点，保证输出顺序与暴力求解一致
+ * - within_radius(q, r)：到元素的真实距离不超过 r 的元素
+ * 查询结果是输入中的下标。
+ */
+template <typename Item> class RTree {
+public:
+  explicit RTree(const std::vector<Item> &input, size_t node_capacity = 16)
+      : capacity(std::max<size_t>(node_capacity, 2)) {
+    if (input.size() > std::numeric_limits<uint32_t>::max()) {
+      throw std::length_error("RTree: too many items");
+    }
+    std::vector<Box> input_boxes(input.size());
+    for (size_t i = 0; i < input.size(); i++) {
+      input_boxes[i] = Box::of(input[i]);
+    }
+    index = str_order(input_boxes);
+    items.reserve(input.size());
+    boxes.reserve(input.size());
+    for (size_t i : index) {
+      items.push_back(input[i]);
+      boxes.push_back(input_boxes[i]);
+    }
+
+    // 自底向上逐层装载，每层先按STR顺序重排再分组
+    std::vector<Box> entries = boxes;
+    while (!entries.empty()) {
+      std::vector<Node> level;
+      for (size_t i = 0; i < entries.size(); i += capacity) {
+        Node node{Box(), static_cast<uint32_t>(i),
+                  static_cast<uint32_t>(std::min(i + capacity, entries.size()))};
+        for (size_t j = node.begin; j < node.end; j++) {
+          node.box.expand(entries[j]);
+        }
+        level.push_back(node);
+      }
+      entries.clear();
+      if (level.size() > 1) {
+        std::vector<Box> level_boxes;
+        for (const Node &node : level) {
+          level_boxes.push_back(node.box);
+        }
+        std::vector<Node> sorted;
+        for (size_t i : str_order(level_boxes)) {
+          sorted.push_back(level[i]);
+          entries.push_back(level[i].box);
+        }
+        level = std::move(sorted);
+      }
+      levels.push_back(std::move(level));
+    }
+  }
+
+  size_t size() const { return items.size(); }
+
+  // 层数（只有叶子时为1，空树为0）
+  size_t height() const { return levels.size(); }
+
+  // 外接矩形与 box 相交的元素，顺序不定
+  std::vector<size_t> in_box(const Box &box) const {
+    std::vector<size_t> result;
+    if (levels.empty())
+      return result;
+    std::vector<std::pair<size_t, uint32_t>> stack = {{levels.size() - 1, 0}};
+    while (!stack.empty()) {
+      auto [depth, id] = stack.back();
+      stack.pop_back();
+      const Node &node = levels[depth][id];
+      for (uint32_t child = node.begin; child < node.end; child++) {
+        if (depth == 0) {
+          if (box.intersects(boxes[child]))
+            result.push_back(index[child]);
+        } else if (box.intersects(levels[depth - 1][child].box)) {
+          stack.emplace_back(depth - 1, child);
+        }
+      }
+    }
+    return result;
+  }
+
+  // 按距离从近到远（距离相同时按下标）的 k 个最近元素
+  std::vector<size_t> nearest(const Point &q, size_t k) const {
+    std::vector<size_t> result;
+    if (levels.empty() || k == 0)
+      return result;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    heap.push({0.0, static_cast<int64_t>(levels.size() - 1), 0, 0});
+    while (!heap.empty() && result.size() < k) {
+      Entry entry = heap.top();
+      heap.pop();
+      if (entry.depth < 0) {
+        result.push_back(entry.key);
+        continue;
+      }
+      const Node &node = levels[entry.depth][entry.id];
+      for (uint32_t child = node.begin; child < node.end; child++) {
+        if (entry.depth == 0) {
+          heap.push({SpatialDistance::squared(q, items[child]), -1, child,
+                     index[child]});
+        } else {
+          heap.push({levels[entry.depth - 1][child].box.distance_squared(q),
+                     entry.depth - 1, child, 0});
+        }
+      }
+    }
+    return result;
+  }
+
+  // 到 q 的距离不超过 radius 的元素，顺序不定
+  std::vector<size_t> within_radius(const Point &q, double radius) const {
+    std::vector<size_t> result;
+    if (levels.empty())
+      return result;
+    double limit = radius * radius;
+    std::vector<std::pair<size_t, uint32_t>> stack = {{levels.size() - 1, 0}};
+    while (!stack.empty()) {
+      auto [depth, id] = stack.back();
+      stack.pop_back();
+      const Node &node = levels[depth][id];
+      for (uint32_t child = node.begin; child < node.end; child++) {
+        if (depth == 0) {
+          if (boxes[child].distance_squared(q) <= limit &&
+              SpatialDistance::squared(q, items[child]) <= limit)
+            result.push_back(index[child]);
+        } else if (levels[depth - 1][child].box.distance_squared(q) <= limit) {
+          stack.emplace_back(depth - 1, child);
+        }
+      }
+    }
+    return result;
+  }
+
+private:
+  struct Node {
+    Box box;
+    uint32_t begin, end; // 孩子在下一层（叶子为 items）中的范围
+  };
+
+  // best-first 搜索的堆元素：depth 为 -1 表示元素，距离相同时节点（depth ≥ 0）优先
+  struct Entry {
+    double distance;
+    int64_t depth;
+    uint32_t id;
+    size_t key; // 元素在输入中的下标
+    bool operator>(const Entry &other) const {
+      if (distance != other.distance)
+        return distance > other.distance;
+      if ((depth < 0) != (other.depth < 0))
+        return depth < 0;
+      return key > other.key;
+    }
+  };
+
+  size_t capacity;
+  std::vector<Item> items;          // 按STR顺序排列的元素
+  std::vector<Box> boxes;           // items 的外接矩形
+  std::vector<size_t> index;        // items[i] 在输入中的下标
+  std::vector<std::vector<Node>> levels; // levels[0] 为叶子层，最后一层只有根
+
+  std::vector<size_t> str_order(const std::vector<Box> &entries) const {
+    size_t n = entries.size();
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::vector<Point> centers(n);
+    for (size_t i = 0; i < n; i++) {
+      centers[i] = entries[i].center();
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      return centers[a].x < centers[b].x;
+    });
+    size_t pages = (n + capacity - 1) / capacity;
+    size_t slices = static_cast<size_t>(std::ceil(std::sqrt(double(pages))));
+    size_t slice_size = slices == 0 ? n : (pages + slices - 1) / slices * capacity;
+    for (size_t begin = 0; begin < n; begin += slice_size) {
+      std::sort(order.begin() + begin,
+                order.begin() + std::min(begin + slice_size, n),
+                [&](size_t a, size_t b) { return centers[a].y < centers[b].y; });
+    }
+    return order;
+  }
+};
+
+/**
+ * @brief 一组多边形上的批量点包含查询（地理围栏）
+ *
+ * 在所有多边形的外接矩形上铺一张均匀网格，格子数约为边数的 cells_per_edge 倍，
+ * 每条边登记到它经过的所有格子（按行求出边在该行内的 x 范围，并留出浮点误差的余量）。
+ * 每个格子取一个参考点 c（不在任何登记的边上），预先算出每个相关多边形是否包含 c：
+ * - 同一行的参考点在同一条水平线上，用这条线与多边形各边的交点（半开规则）的奇偶性判断；
+ *   交点离参考点很近时，这条边必定登记在该格子中，改用精确方向判断
+ * - 多边形在格子中没有边而又包含参考点时，整个格子都在多边形内，单独记录
+ * 查询点 p 落在某个格子中时，对该格子的每个相关多边形，p 的内外等于 c 的内外，
+ * 再按线段 cp 穿过该多边形在格子中的边的次数的奇偶性翻转。cp 整个在格子内，
+ * 穿过的边一定登记在格子中；每条边的判断用 RobustPredicates，经过顶点时按半开规则计数。
+ * 格子中平均只有常数条边，每次查询 O(1) 期望。
+ * 落在多边形边界上的点属于哪一侧不确定；少于3个顶点的多边形不包含任何点。
+ */
+class PolygonEdgeGrid {
+public:
+  explicit PolygonEdgeGrid(const std::vector<std::vector<Point>> &polygons,
+                           double cells_per_edge = 1.0)
+      : polygon_total(polygons.size()) {
+    if (polygons.size() > std::numeric_limits<uint32_t>::max()) {
+      throw std::length_error("PolygonEdgeGrid: too many polygons");
+    }
+    size_t edge_total = 0;
+    for (const auto &polygon : polygons) {
+      if (polygon.size() >= 3) {
+        edge_total += polygon.size();
+        for (const Point &p : polygon) {
+          bounds.expand(Box::of(p));
+        }
+      }
+    }
+    if (edge_total == 0) {
+      columns = rows = 0;
+      return;
+    }
+    layout(edge_total, cells_per_edge);
+    build(polygons);
+  }
+
+  size_t polygon_count() const { return polygon_total; }
+
+  size_t cell_count() const { return columns * rows; }
+
+  // 包含 p 的所有多边形，按下标递增写入 out
+  void containing(const Point &p, std::vector<uint32_t> &out) const {
+    out.clear();
+    size_t cell;
+    if (!locate_cell(p, cell))
+      return;
+    Point c = reference(cell);
+    for (uint32_t k = cell_begin[cell]; k < cell_begin[cell + 1]; k++) {
+      if (inside(candidates[k], c, p))
+        out.push_back(candidates[k].polygon);
+    }
+  }
+
+  std::vector<uint32_t> containing(const Point &p) const {
+    std::vector<uint32_t> out;
+    containing(p, out);
+    return out;
+  }
+
+  // 包含 p 的下标最小的多边形，没有时为 -1
+  int64_t first_containing(const Point &p) const {
+    size_t cell;
+    if (!locate_cell(p, cell))
+      return -1;
+    Point c = reference(cell);
+    for (uint32_t k = cell_begin[cell]; k < cell_begin[cell + 1]; k++) {
+      if (inside(candidates[k], c, p))
+        return candidates[k].polygon;
+    }
+    return -1;
+  }
+
+  /**
+   * @brief 批量查询每个点所在的下标最小的多边形
+   *
+   * @param points 查询点
+   * @param num_threads 线程数量
+   * @return 与 points 等长，没有包含该点的多边形时为 -1
+   */
+  std::vector<int64_t>
+  locate(const std::vector<Point> &points,
+         size_t num_threads = std::thread::hardware_concurrency()) const {
+    std::vector<int64_t> result(points.size());
+    WorkStealingScheduler scheduler(num_threads);
+    scheduler.parallel_for(0, points.size(), kLocateGrain,
+                           [&](size_t lo, size_t hi) {
+                             for (size_t i = lo; i < hi; i++) {
+                               result[i] = first_containing(points[i]);
+                             }
+                           });
+    return result;
+  }
+
+private:
+  static constexpr size_t kLocateGrain = 4096;
+  static constexpr size_t kMaxCells = size_t(1) << 26;
+  static constexpr int kReferenceTries = 64;
+
+  struct Edge {
+    Point a, b;
+  };
+
+  // 格子中的一个相关多边形：参考点是否在其中，以及它在格子中的边
+  struct Candidate {
+    uint32_t polygon;
+    uint32_t edge_begin, edge_end;
+    bool inside;
+  };
+
+  // 建网格时边在格子中的一次登记
+  struct Registration {
+    uint64_t cell;
+    uint32_t polygon;
+    uint32_t edge; // 全局边号
+  };
+
+  size_t polygon_total;
+  Box bounds;
+  size_t columns = 0, rows = 0;
+  double cell_width = 1, cell_height = 1;
+  double inverse_width = 1, inverse_height = 1;
+  double slack = 0; // 浮点误差的余量
+  std::vector<uint32_t> cell_begin; // 格子 → candidates 的范围
+  std::vector<Candidate> candidates;
+  std::vector<Edge> edges;          // 按格子、多边形分组的登记边
+  std::vector<double> reference_x;  // 每个格子参考点的 x
+  std::vector<double> reference_y;  // 每一行参考点的 y
+
+  void layout(size_t edge_total, double cells_per_edge) {
+    double width = bounds.max_x - bounds.min_x;
+    double height = bounds.max_y - bounds.min_y;
+    double cells = std::min(
+        std::max(1.0, edge_total * std::max(cells_per_edge, 0.0)),
+        double(kMaxCells));
+    if (width > 0 && height > 0) {
+      double aspect = width / height;
+      columns = static_cast<size_t>(std::ceil(std::sqrt(cells * aspect)));
+      rows = static_cast<size_t>(std::ceil(cells / columns));
+    } else {
+      // 所有顶点共线：多边形面积为0，只保留一个格子
+      columns = rows = 1;
+    }
+    columns = std::max<size_t>(columns, 1);
+    rows = std::max<size_t>(rows, 1);
+    cell_width = width > 0 ? width / columns : 1;
+    cell_height = height > 0 ? height / rows : 1;
+    inverse_width = 1 / cell_width;
+    inverse_height = 1 / cell_height;
+    double magnitude = std::max({std::abs(bounds.min_x), std::abs(bounds.max_x),
+                                 std::abs(bounds.min_y), std::abs(bounds.max_y),
+                                 width, height});
+    slack = 64 * std::numeric_limits<double>::epsilon() * magnitude;
+  }
+
+  size_t column_of(double x) const {
+    double c = std::floor((x - bounds.min_x) * inverse_width);
+    return c <= 0 ? 0 : std::min(static_cast<size_t>(c), columns - 1);
+  }
+
+  size_t row_of(double y) const {
+    double r = std::floor((y - bounds.min_y) * inverse_height);
+    return r <= 0 ? 0 : std::min(static_cast<size_t>(r), rows - 1);
+  }
+
+  bool locate_cell(const Point &p, size_t &cell) const {
+    if (columns == 0 || !bounds.contains(p))
+      return false;
+    cell = row_of(p.y) * columns + column_of(p.x);
+    return true;
+  }
+
+  Point reference(size_t cell) const {
+    return Point(reference_x[cell], reference_y[cell / columns]);
+  }
+
+  // 参考点在格子中的相对位置，取 [0.25, 0.75] 内的无理数倍
+  static double reference_offset(int attempt) {
+    double golden = 0.6180339887498949 * attempt;
+    return 0.25 + 0.5 * (golden - std::floor(golden) + (attempt == 0 ? 0.5 : 0));
+  }
+
+  // 线段 cp 是否穿过边 ab：ab 的两端在直线 cp 的两侧（直线上的顶点算作负侧），
+  // 且 c、p 在直线 ab 的两侧
+  static bool crosses(const Point &c, const Point &p, const Edge &e) {
+    bool a_above = RobustPredicates::orientation(c, p, e.a) > 0;
+    bool b_above = RobustPredicates::orientation(c, p, e.b) > 0;
+    if (a_above == b_above)
+      return false;
+    bool c_left = RobustPredicates::orientation(e.a, e.b, c) > 0;
+    bool p_left = RobustPredicates::orientation(e.a, e.b, p) > 0;
+    return c_left != p_left;
+  }
+
+  bool inside(const Candidate &candidate, const Point &c, const Point &p) const {
+    bool result = candidate.inside;
+    for (uint32_t e = candidate.edge_begin; e < candidate.edge_end; e++) {
+      result ^= crosses(c, p, edges[e]);
+    }
+    return result;
+  }
+
+  // 边与水平线 y 是否相交（半开规则：一端 ≤ y，另一端 > y）
+  static bool straddles(const Edge &e, double y) {
+    return (e.a.y > y) != (e.b.y > y);
+  }
+
+  static double crossing_x(const Edge &e, double y) {
+    return e.a.x + (y - e.a.y) * (e.b.x - e.a.x) / (e.b.y - e.a.y);
+  }
+
+  // straddles(e, c.y) 时，e 与水平线的交点是否在 c 右侧（精确）
+  static bool crosses_right_of(const Edge &e, const Point &c) {
+    const Point &low = e.a.y > c.y ? e.b : e.a;
+    const Point &high = e.a.y > c.y ? e.a : e.b;
+    return RobustPredicates::orientation(low, high, c) > 0;
+  }
+
+  static bool on_edge(const Point &c, const Edge &e) {
+    return RobustPredicates::orientation(e.a, e.b, c) == 0 &&
+           RobustPredicates::in_box(c, Segment(e.a, e.b));
+  }
+
+  void build(const std::vector<std::vector<Point>> &polygons) {
+    std::vector<Edge> all_edges;
+    std::vector<Registration> registrations;
+    for (size_t p = 0; p < polygons.size(); p++) {
+      const auto &polygon = polygons[p];
+      if (polygon.size() < 3)
+        continue;
+      for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        uint32_t id = static_cast<uint32_t>(all_edges.size());
+        all_edges.push_back({polygon[j], polygon[i]});
+        register_edge(all_edges.back(), static_cast<uint32_t>(p), id,
+                      registrations);
+      }
+    }
+    std::sort(registrations.begin(), registrations.end(),
+              [](const Registration &a, const Registration &b) {
+                if (a.cell != b.cell)
+                  return a.cell < b.cell;
+                if (a.polygon != b.polygon)
+                  return a.polygon < b.polygon;
+                return a.edge < b.edge;
+              });
+
+    reference_x.assign(columns * rows, 0);
+    reference_y.assign(rows, 0);
+    cell_begin.assign(columns * rows + 1, 0);
+    size_t next = 0;
+    for (size_t r = 0; r < rows; r++) {
+      size_t end = next;
+      while (end < registrations.size() &&
+             registrations[end].cell < (r + 1) * columns) {
+        end++;
+      }
+      build_row(r, all_edges, registrations, next, end);
+      next = end;
+    }
+  }
+
+  // 把边登记到它经过的格子：逐行求出边在该行内的 x 范围
+  void register_edge(const Edge &e, uint32_t polygon, uint32_t id,
+                     std::vector<Registration> &out) const {
+    double low_y = std::min(e.a.y, e.b.y), high_y = std::max(e.a.y, e.b.y);
+    double low_x = std::min(e.a.x, e.b.x), high_x = std::max(e.a.x, e.b.x);
+    size_t first_row = row_of(low_y - slack), last_row = row_of(high_y + slack);
+    for (size_t r = first_row; r <= last_row; r++) {
+      double x0 = low_x, x1 = high_x;
+      if (e.a.y != e.b.y && first_row != last_row) {
+        double y0 = std::max(low_y, bounds.min_y + r * cell_height - slack);
+        double y1 = std::min(high_y, bounds.min_y + (r + 1) * cell_height + slack);
+        double u0 = crossing_x(e, y0), u1 = crossing_x(e, y1);
+        x0 = std::max(low_x, std::min(u0, u1));
+        x1 = std::min(high_x, std::max(u0, u1));
+      }
+      size_t first_column = column_of(x0 - slack);
+      size_t last_column = column_of(x1 + slack);
+      for (size_t c = first_column; c <= last_column; c++) {
+        out.push_back({r * columns + c, polygon, id});
+      }
+    }
+  }
+
+  void build_row(size_t r, const std::vector<Edge> &all_edges,
+                 const std::vector<Registration> &registrations, size_t begin,
+                 size_t end) {
+    // 参考线 y：不经过本行任何登记边的端点（因而也不与水平边重合）
+    std::vector<double> vertex_y;
+    for (size_t k = begin; k < end; k++) {
+      const Edge &e = all_edges[registrations[k].edge];
+      vertex_y.push_back(e.a.y);
+      vertex_y.push_back(e.b.y);
+    }
+    std::sort(vertex_y.begin(), vertex_y.end());
+    double y = 0;
+    for (int attempt = 0; attempt < kReferenceTries; attempt++) {
+      y = bounds.min_y + (r + reference_offset(attempt)) * cell_height;
+      if (!std::binary_search(vertex_y.begin(), vertex_y.end(), y))
+        break;
+    }
+    reference_y[r] = y;
+
+    // 本行中与参考线相交的边，按 (多边形, 交点x) 排序
+    std::vector<std::pair<uint32_t, uint32_t>> crossing_edges; // (多边形, 边)
+    for (size_t k = begin; k < end; k++) {
+      if (straddles(all_edges[registrations[k].edge], y))
+        crossing_edges.emplace_back(registrations[k].polygon,
+                                    registrations[k].edge);
+    }
+    std::sort(crossing_edges.begin(), crossing_edges.end());
+    crossing_edges.erase(
+        std::unique(crossing_edges.begin(), crossing_edges.end()),
+        crossing_edges.end());
+    // 每条边的浮点交点只算一次，计数与修正使用同一个值
+    std::vector<std::pair<uint32_t, double>> crossings; // (多边形, 交点x)
+    std::vector<std::pair<uint32_t, double>> edge_x;    // (边, 交点x)
+    for (const auto &[polygon, edge] : crossing_edges) {
+      double x = crossing_x(all_edges[edge], y);
+      crossings.emplace_back(polygon, x);
+      edge_x.emplace_back(edge, x);
+    }
+    std::sort(crossings.begin(), crossings.end());
+    std::sort(edge_x.begin(), edge_x.end());
+
+    // 每个格子的参考点 x：不在该格子的任何登记边上
+    size_t k = begin;
+    for (size_t column = 0; column < columns; column++) {
+      size_t cell = r * columns + column;
+      size_t cell_end = k;
+      while (cell_end < end && registrations[cell_end].cell == cell) {
+        cell_end++;
+      }
+      double x = 0;
+      for (int attempt = 0; attempt < kReferenceTries; attempt++) {
+        x = bounds.min_x + (column + reference_offset(attempt)) * cell_width;
+        bool clear = true;
+        for (size_t i = k; i < cell_end && clear; i++) {
+          clear = !on_edge(Point(x, y), all_edges[registrations[i].edge]);
+        }
+        if (clear)
+          break;
+      }
+      reference_x[cell] = x;
+      k = cell_end;
+    }
+
+    // 格子中没有边、却整个被多边形覆盖的 (格子, 多边形)
+    std::vector<std::pair<uint64_t, uint32_t>> covered;
+    for (size_t i = 0; i < crossings.size();) {
+      size_t j = i;
+      while (j < crossings.size() && crossings[j].first == crossings[i].first) {
+        j++;
+      }
+      uint32_t polygon = crossings[i].first;
+      // 交点按 x 递增，第 (2t, 2t+1) 个交点之间在多边形内
+      for (size_t t = i; t + 1 < j; t += 2) {
+        double inner_begin = crossings[t].second;
+        double inner_end = crossings[t + 1].second;
+        for (size_t column = column_of(inner_begin);
+             column <= column_of(inner_end); column++) {
+          size_t cell = r * columns + column;
+          double x = reference_x[cell];
+          if (inner_begin < x && x < inner_end)
+            covered.emplace_back(cell, polygon);
+        }
+      }
+      i = j;
+    }
+    std::sort(covered.begin(), covered.end());
+
+    // 合并有边的与整体覆盖的，逐格子写出候选多边形
+    size_t c = 0;
+    k = begin;
+    for (size_t column = 0; column < columns; column++) {
+      size_t cell = r * columns + column;
+      Point reference_point(reference_x[cell], y);
+      while (k < end && registrations[k].cell == cell) {
+        uint32_t polygon = registrations[k].polygon;
+        while (c < covered.size() && covered[c].first == cell &&
+               covered[c].second < polygon) {
+          candidates.push_back({covered[c].second, 0, 0, true});
+          c++;
+        }
+        if (c < covered.size() && covered[c].first == cell &&
+            covered[c].second == polygon) {
+          c++; // 有边的格子单独计算参考点的内外
+        }
+        Candidate candidate{polygon, static_cast<uint32_t>(edges.size()), 0,
+                            false};
+        size_t count = count_right(crossings, polygon, reference_point.x);
+        for (; k < end && registrations[k].cell == cell &&
+               registrations[k].polygon == polygon;
+             k++) {
+          uint32_t id = registrations[k].edge;
+          const Edge &e = all_edges[id];
+          edges.push_back(e);
+          if (straddles(e, y)) {
+            // 浮点交点不可靠时以精确判断为准
+            double x = std::lower_bound(edge_x.begin(), edge_x.end(),
+                                        std::make_pair(id, -std::numeric_limits<
+                                                               double>::infinity()))
+                           ->second;
+            count += crosses_right_of(e, reference_point);
+            count -= x > reference_point.x;
+          }
+        }
+        candidate.edge_end = static_cast<uint32_t>(edges.size());
+        candidate.inside = count % 2 == 1;
+        candidates.push_back(candidate);
+      }
+      while (c < covered.size() && covered[c].first == cell) {
+        candidates.push_back({covered[c].second, 0, 0, true});
+        c++;
+      }
+      cell_begin[cell + 1] = static_cast<uint32_t>(candidates.size());
+    }
+    if (candidates.size() > std::numeric_limits<uint32_t>::max() ||
+        edges.size() > std::numeric_limits<uint32_t>::max()) {
+      throw std::length_error("PolygonEdgeGrid: grid too large");
+    }
+  }
+
+  // 多边形与参考线的交点中，浮点 x 大于 x 的个数
+  static size_t
+  count_right(const std::vector<std::pair<uint32_t, double>> &crossings,
+              uint32_t polygon, double x) {
+    auto first = std::lower_bound(
+        crossings.begin(), crossings.end(),
+        std::make_pair(polygon, -std::numeric_limits<double>::infinity()));
+    auto last = std::upper_bound(
+        first, crossings.end(),
+        std::make_pair(polygon, std::numeric_limits<double>::infinity()));
+    auto split = std::upper_bound(first, last, std::make_pair(polygon, x));
+    return static_cast<size_t>(last - split);
+  }
+};
+
+} // namespace algorithms
+
+#endif // SPATIAL_INDEX_H
@@ -1,9 +1,18 @@
 #ifndef STACK_QUEUE_H
 #define STACK_QUEUE_H
 
+#include "amortized_analysis.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <deque>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
+#include <thread>
+#include <utility>
 #include <vector>
 
 namespace algorithms {
@@ -407,6 +416,809 @@ public:
   }
 };
 
+/**
+ * @brief 可增长的栈（模板版本）
+ *
+ * 与 Stack 接口相同但没有容量上限：容量按 DynamicTablePolicy 成倍扩张，
+ * 元素数降到收缩阈值时成倍收缩（17.4节动态表），PUSH 与 POP 的摊还代价
+ * 均为O(1)。同时提供17.2节的 MULTIPOP。
+ *
+ * moved_elements() 累计扩张和收缩时搬移的元素个数，即动态表分析中
+ * 除每次操作的单位代价之外的实际代价。
+ */
+template <typename T> class GrowableStack {
+public:
+  /**
+   * @brief 构造函数
+   * @param initial_capacity 初始容量，收缩不会低于它
+   * @param policy 扩张与收缩策略
+   * @throws std::invalid_argument 如果策略参数不合法
+   */
+  explicit GrowableStack(size_t initial_capacity = 1,
+                         DynamicTablePolicy policy = {})
+      : policy(policy), min_capacity(std::max<size_t>(initial_capacity, 1)) {
+    policy.validate();
+    reallocate(min_capacity);
+  }
+
+  GrowableStack(const GrowableStack &other)
+      : policy(other.policy), min_capacity(other.min_capacity) {
+    reallocate(other.capacity_);
+    for (size_t i = 0; i < other.count; ++i) {
+      new (data + i) T(other.data[i]);
+      ++count;
+    }
+  }
+
+  GrowableStack(GrowableStack &&other) noexcept
+      : policy(other.policy), min_capacity(other.min_capacity) {
+    swap(other);
+  }
+
+  GrowableStack &operator=(GrowableStack other) {
+    swap(other);
+    return *this;
+  }
+
+  ~GrowableStack() {
+    clear();
+    std::allocator<T>().deallocate(data, capacity_);
+  }
+
+  void swap(GrowableStack &other) noexcept {
+    std::swap(policy, other.policy);
+    std::swap(min_capacity, other.min_capacity);
+    std::swap(data, other.data);
+    std::swap(count, other.count);
+    std::swap(capacity_, other.capacity_);
+    std::swap(moved, other.moved);
+    std::swap(resize_count, other.resize_count);
+    std::swap(expand_at, other.expand_at);
+    std::swap(contract_at, other.contract_at);
+  }
+
+  /**
+   * @brief 压入元素（PUSH操作），必要时先扩张
+   */
+  void push(const T &x) { emplace(x); }
+  void push(T &&x) { emplace(std::move(x)); }
+
+  template <typename... Args> T &emplace(Args &&...args) {
+    if (count >= expand_at) {
+      reallocate(policy.expanded_size(capacity_));
+    }
+    T *slot = new (data + count) T(std::forward<Args>(args)...);
+    ++count;
+    return *slot;
+  }
+
+  /**
+   * @brief 弹出元素（POP操作），必要时随后收缩
+   * @return 弹出的元素
+   * @throws std::underflow_error 如果栈为空
+   */
+  T pop() {
+    if (empty()) {
+      throw std::underflow_error("栈下溢");
+    }
+    T x = std::move(data[count - 1]);
+    data[--count].~T();
+    if (count <= contract_at) {
+      shrink_if_sparse();
+    }
+    return x;
+  }
+
+  /**
+   * @brief 弹出至多k个元素（MULTIPOP操作）
+   * @return 实际弹出的元素个数
+   */
+  size_t multipop(size_t k) {
+    k = std::min(k, count);
+    for (size_t i = 0; i < k; ++i) {
+      data[--count].~T();
+    }
+    shrink_if_sparse();
+    return k;
+  }
+
+  /**
+   * @brief 查看栈顶元素
+   * @throws std::underflow_error 如果栈为空
+   */
+  T &top() {
+    if (empty()) {
+      throw std::underflow_error("栈为空");
+    }
+    return data[count - 1];
+  }
+
+  const T &top() const {
+    if (empty()) {
+      throw std::underflow_error("栈为空");
+    }
+    return data[count - 1];
+  }
+
+  bool empty() const { return count == 0; }
+
+  size_t size() const { return count; }
+
+  size_t capacity() const { return capacity_; }
+
+  void clear() {
+    while (count > 0) {
+      data[--count].~T();
+    }
+  }
+
+  /**
+   * @brief 扩张与收缩累计搬移的元素个数
+   */
+  size_t moved_elements() const { return moved; }
+
+  /**
+   * @brief 扩张与收缩的次数
+   */
+  size_t resizes() const { return resize_count; }
+
+  const DynamicTablePolicy &get_policy() const { return policy; }
+
+  /**
+   * @brief 17.4.2节的势能函数值
+   */
+  double potential() const { return policy.potential(count, capacity_); }
+
+private:
+  DynamicTablePolicy policy;
+  size_t min_capacity;
+  T *data = nullptr;
+  size_t count = 0;
+  size_t capacity_ = 0;
+  size_t moved = 0;
+  size_t resize_count = 0;
+  // 由策略和当前容量算出的整数阈值，热路径上不做浮点运算：
+  // count 达到 expand_at 时 push 先扩张，降到 contract_at 及以下时尝试收缩
+  size_t expand_at = 0;
+  size_t contract_at = 0;
+
+  // MULTIPOP 一次可能删除很多元素，连续收缩到装载因子回到阈值之上，
+  // 但只搬移一次，且容量不低于初始容量
+  void shrink_if_sparse() {
+    size_t target = capacity_;
+    while (target > min_capacity && policy.should_contract(count, target)) {
+      target = std::max(policy.contracted_size(target), min_capacity);
+    }
+    if (target != capacity_) {
+      reallocate(target);
+    }
+  }
+
+  void reallocate(size_t new_capacity) {
+    T *fresh = std::allocator<T>().allocate(new_capacity);
+    for (size_t i = 0; i < count; ++i) {
+      new (fresh + i) T(std::move_if_noexcept(data[i]));
+      data[i].~T();
+    }
+    if (data != nullptr) {
+      std::allocator<T>().deallocate(data, capacity_);
+      moved += count;
+      ++resize_count;
+    }
+    data = fresh;
+    capacity_ = new_capacity;
+    double size = static_cast<double>(capacity_);
+    expand_at = static_cast<size_t>(std::floor(size * policy.expand_load));
+    contract_at = static_cast<size_t>(std::floor(size * policy.contract_load));
+  }
+};
+
+/**
+ * @brief 分块存储的可增长双端队列（模板版本）
+ *
+ * 元素存放在固定大小的块中，块指针存放在一个环形的块表里。两端插入
+ * 只会申请新块或移动块指针，从不搬移已有元素，所以两端的插入和删除
+ * 不会使其他元素的引用失效。块表本身是一个动态表：按
+ * DynamicTablePolicy 成倍扩张和收缩，搬移的只是块指针。
+ *
+ * 两端各保留至多一个空闲块，避免在块边界来回插入删除时反复申请释放内存。
+ */
+template <typename T, size_t ChunkSize = (sizeof(T) < 256 ? 4096 / sizeof(T)
+                                                          : 16)>
+class ChunkedDeque {
+  static_assert(ChunkSize > 0, "块大小必须为正");
+
+public:
+  /**
+   * @brief 构造函数
+   * @param policy 块表的扩张与收缩策略
+   * @throws std::invalid_argument 如果策略参数不合法
+   */
+  explicit ChunkedDeque(DynamicTablePolicy policy = {}) : policy(policy) {
+    policy.validate();
+    chunks.assign(kMinMapSize, nullptr);
+  }
+
+  ChunkedDeque(const ChunkedDeque &other) : ChunkedDeque(other.policy) {
+    for (size_t i = 0; i < other.size(); ++i) {
+      push_back(other[i]);
+    }
+  }
+
+  ChunkedDeque(ChunkedDeque &&other) : ChunkedDeque(other.policy) {
+    swap(other);
+  }
+
+  ChunkedDeque &operator=(ChunkedDeque other) {
+    swap(other);
+    return *this;
+  }
+
+  ~ChunkedDeque() {
+    clear();
+    for (T *chunk : chunks) {
+      release(chunk);
+    }
+    release(spare);
+  }
+
+  void swap(ChunkedDeque &other) noexcept {
+    std::swap(policy, other.policy);
+    chunks.swap(other.chunks);
+    std::swap(first_chunk, other.first_chunk);
+    std::swap(used_chunks, other.used_chunks);
+    std::swap(head, other.head);
+    std::swap(count, other.count);
+    std::swap(spare, other.spare);
+    std::swap(moved_pointers, other.moved_pointers);
+    std::swap(front_slot, other.front_slot);
+    std::swap(front_limit, other.front_limit);
+    std::swap(back_slot, other.back_slot);
+    std::swap(back_limit, other.back_limit);
+  }
+
+  void push_back(const T &x) { emplace_back(x); }
+  void push_back(T &&x) { emplace_back(std::move(x)); }
+  void push_front(const T &x) { emplace_front(x); }
+  void push_front(T &&x) { emplace_front(std::move(x)); }
+
+  template <typename... Args> T &emplace_back(Args &&...args) {
+    if (back_slot == back_limit) {
+      if (first_chunk + used_chunks == chunks.size()) {
+        make_room(false);
+      }
+      chunks[first_chunk + used_chunks] = acquire();
+      ++used_chunks;
+      back_slot = chunks[first_chunk + used_chunks - 1];
+      back_limit = back_slot + ChunkSize;
+      if (count == 0) {
+        front_slot = front_limit = back_slot;
+      }
+    }
+    T *slot = new (back_slot) T(std::forward<Args>(args)...);
+    ++back_slot;
+    ++count;
+    return *slot;
+  }
+
+  template <typename... Args> T &emplace_front(Args &&...args) {
+    if (front_slot == front_limit) {
+      if (first_chunk == 0) {
+        make_room(true);
+      }
+      chunks[--first_chunk] = acquire();
+      ++used_chunks;
+      head = ChunkSize;
+      front_limit = chunks[first_chunk];
+      front_slot = front_limit + ChunkSize;
+      if (count == 0) {
+        back_slot = back_limit = front_slot;
+      }
+    }
+    T *slot = new (front_slot - 1) T(std::forward<Args>(args)...);
+    --front_slot;
+    --head;
+    ++count;
+    return *slot;
+  }
+
+  /**
+   * @brief 从队头删除元素
+   * @throws std::underflow_error 如果队列为空
+   */
+  T pop_front() {
+    if (empty()) {
+      throw std::underflow_error("双端队列为空");
+    }
+    T x = std::move(*front_slot);
+    front_slot->~T();
+    ++front_slot;
+    ++head;
+    --count;
+    if (head == ChunkSize || count == 0) {
+      recycle(chunks[first_chunk]);
+      chunks[first_chunk++] = nullptr;
+      --used_chunks;
+      head = 0;
+      after_release();
+    }
+    return x;
+  }
+
+  /**
+   * @brief 从队尾删除元素
+   * @throws std::underflow_error 如果队列为空
+   */
+  T pop_back() {
+    if (empty()) {
+      throw std::underflow_error("双端队列为空");
+    }
+    --back_slot;
+    T x = std::move(*back_slot);
+    back_slot->~T();
+    --count;
+    if (count == 0 || head + count == (used_chunks - 1) * ChunkSize) {
+      recycle(chunks[first_chunk + used_chunks - 1]);
+      chunks[first_chunk + used_chunks - 1] = nullptr;
+      --used_chunks;
+      if (used_chunks == 0) {
+        head = 0;
+      }
+      after_release();
+    }
+    return x;
+  }
+
+  /**
+   * @brief 查看队头元素
+   * @throws std::underflow_error 如果队列为空
+   */
+  T &front() {
+    if (empty()) {
+      throw std::underflow_error("双端队列为空");
+    }
+    return *front_slot;
+  }
+
+  /**
+   * @brief 查看队尾元素
+   * @throws std::underflow_error 如果队列为空
+   */
+  T &back() {
+    if (empty()) {
+      throw std::underflow_error("双端队列为空");
+    }
+    return *(back_slot - 1);
+  }
+
+  T &operator[](size_t i) { return *address(head + i); }
+  const T &operator[](size_t i) const { return *address(head + i); }
+
+  bool empty() const { return count == 0; }
+
+  size_t size() const { return count; }
+
+  void clear() {
+    while (!empty()) {
+      pop_back();
+    }
+  }
+
+  /**
+   * @brief 块表的容量（块指针个数）
+   */
+  size_t map_capacity() const { return chunks.size(); }
+
+  /**
+   * @brief 块表扩张、收缩或重新居中时累计搬移的块指针个数
+   */
+  size_t moved_chunk_pointers() const { return moved_pointers; }
+
+  static constexpr size_t chunk_size() { return ChunkSize; }
+
+private:
+  static constexpr size_t kMinMapSize = 8;
+
+  DynamicTablePolicy policy;
+  std::vector<T *> chunks; // 使用中的块为 chunks[first_chunk, first_chunk + used_chunks)
+  size_t first_chunk = kMinMapSize / 2;
+  size_t used_chunks = 0;
+  size_t head = 0; // 队头元素在第一个块中的偏移
+  size_t count = 0;
+  T *spare = nullptr;
+  size_t moved_pointers = 0;
+  // 两端的热路径只比较指针：front_slot 为队头元素、front_limit 为其所在块的
+  // 起点；back_slot 为队尾之后的位置、back_limit 为其所在块的终点。
+  // 指针相等表示该端需要换块（包括队列为空时全为空指针）
+  T *front_slot = nullptr;
+  T *front_limit = nullptr;
+  T *back_slot = nullptr;
+  T *back_limit = nullptr;
+
+  T *address(size_t offset) const {
+    return chunks[first_chunk + offset / ChunkSize] + offset % ChunkSize;
+  }
+
+  T *acquire() {
+    if (spare != nullptr) {
+      return std::exchange(spare, nullptr);
+    }
+    return std::allocator<T>().allocate(ChunkSize);
+  }
+
+  void recycle(T *chunk) {
+    if (spare == nullptr) {
+      spare = chunk;
+    } else {
+      release(chunk);
+    }
+  }
+
+  static void release(T *chunk) {
+    if (chunk != nullptr) {
+      std::allocator<T>().deallocate(chunk, ChunkSize);
+    }
+  }
+
+  // 收缩后的块表至多四分之一在用，两端都留有余量，不会马上又扩张
+  void after_release() {
+    if (used_chunks == 0) {
+      first_chunk = chunks.size() / 2;
+      front_slot = front_limit = back_slot = back_limit = nullptr;
+    } else {
+      front_limit = chunks[first_chunk];
+      front_slot = front_limit + head;
+      back_limit = chunks[first_chunk + used_chunks - 1] + ChunkSize;
+      back_slot = back_limit - (used_chunks * ChunkSize - head - count);
+    }
+    size_t target = std::max(policy.contracted_size(chunks.size()), kMinMapSize);
+    if (target < chunks.size() && 4 * used_chunks <= target &&
+        policy.should_contract(used_chunks, chunks.size())) {
+      remap(target);
+    }
+  }
+
+  // 某一端没有空位时：块表超过一半在用（或达到策略的扩张阈值）就扩张，
+  // 否则原地重新居中。居中后两端的空位都不少于使用中块数的一半，
+  // 所以搬移块指针的代价摊到每个块上是O(1)
+  void make_room(bool at_front) {
+    size_t size = chunks.size();
+    if (2 * (used_chunks + 1) > size ||
+        policy.should_expand(used_chunks, size)) {
+      size = policy.expanded_size(size);
+    }
+    remap(size, at_front);
+  }
+
+  // 把使用中的块指针搬到容量为 new_size 的块表正中，并给 at_front 一侧留出空位
+  void remap(size_t new_size, bool at_front = false) {
+    std::vector<T *> fresh(new_size, nullptr);
+    size_t start = (new_size - used_chunks) / 2;
+    if (at_front && start == 0) {
+      start = 1;
+    }
+    for (size_t i = 0; i < used_chunks; ++i) {
+      fresh[start + i] = chunks[first_chunk + i];
+    }
+    moved_pointers += used_chunks;
+    chunks.swap(fresh);
+    first_chunk = start;
+  }
+};
+
+/**
+ * @brief 可增长的队列（模板版本）
+ *
+ * 与 Queue 接口相同但没有容量上限，底层为 ChunkedDeque，入队和出队均为
+ * 最坏O(1)（不计块表偶尔的扩张），出队后元素引用保持有效直到它自己出队。
+ */
+template <typename T> class GrowableQueue {
+public:
+  explicit GrowableQueue(DynamicTablePolicy policy = {}) : data(policy) {}
+
+  /**
+   * @brief 入队操作（ENQUEUE操作）
+   */
+  void enqueue(const T &x) { data.push_back(x); }
+  void enqueue(T &&x) { data.push_back(std::move(x)); }
+
+  /**
+   * @brief 出队操作（DEQUEUE操作）
+   * @throws std::underflow_error 如果队列为空
+   */
+  T dequeue() {
+    if (empty()) {
+      throw std::underflow_error("队列为空");
+    }
+    return data.pop_front();
+  }
+
+  /**
+   * @brief 查看队头元素
+   * @throws std::underflow_error 如果队列为空
+   */
+  T &front() {
+    if (empty()) {
+      throw std::underflow_error("队列为空");
+    }
+    return data.front();
+  }
+
+  bool empty() const { return data.empty(); }
+
+  size_t size() const { return data.size(); }
+
+  const ChunkedDeque<T> &storage() const { return data; }
+
+private:
+  ChunkedDeque<T> data;
+};
+
+/**
+ * @brief 单生产者单消费者（SPSC）无锁环形队列
+ *
+ * 恰好一个线程调用 try_push/push，恰好一个线程调用 try_pop/pop 时，
+ * 两端都是无等待的：每次操作只有常数条原子读写，不含CAS循环。
+ *
+ * 头尾下标单调递增，取模用掩码（容量向上取整为2的幂）。生产者与消费者的
+ * 下标分别放在独立的缓存行上，并各自缓存对方下标的一份副本：只有副本显示
+ * 队列已满（或已空）时才重新读取对方的原子下标，稳态下两端几乎不争用
+ * 同一缓存行。
+ *
+ * T 需要可默认构造和移动赋值。
+ */
+template <typename T> class SpscRingQueue {
+public:
+  /**
+   * @brief 构造函数
+   * @param capacity 最少能容纳的元素个数（向上取整为2的幂）
+   * @throws std::invalid_argument 如果容量为0
+   */
+  explicit SpscRingQueue(size_t capacity)
+      : slots(round_up_capacity(capacity)), mask(slots.size() - 1) {}
+
+  SpscRingQueue(const SpscRingQueue &) = delete;
+  SpscRingQueue &operator=(const SpscRingQueue &) = delete;
+
+  /**
+   * @brief 尝试入队（仅生产者线程调用）
+   * @return 队列已满时返回false
+   */
+  template <typename U> bool try_push(U &&value) {
+    size_t t = producer.index.load(std::memory_order_relaxed);
+    if (t - producer.cached_other == slots.size()) {
+      producer.cached_other = consumer.index.load(std::memory_order_acquire);
+      if (t - producer.cached_other == slots.size()) {
+        return false;
+      }
+    }
+    slots[t & mask] = std::forward<U>(value);
+    producer.index.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief 尝试出队（仅消费者线程调用）
+   * @return 队列为空时返回false
+   */
+  bool try_pop(T &out) {
+    size_t h = consumer.index.load(std::memory_order_relaxed);
+    if (h == consumer.cached_other) {
+      consumer.cached_other = producer.index.load(std::memory_order_acquire);
+      if (h == consumer.cached_other) {
+        return false;
+      }
+    }
+    out = std::move(slots[h & mask]);
+    consumer.index.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief 入队，队列满时让出CPU等待
+   */
+  template <typename U> void push(U &&value) {
+    while (!try_push(std::forward<U>(value))) {
+      std::this_thread::yield();
+    }
+  }
+
+  /**
+   * @brief 出队，队列空时让出CPU等待
+   */
+  T pop() {
+    T value;
+    while (!try_pop(value)) {
+      std::this_thread::yield();
+    }
+    return value;
+  }
+
+  /**
+   * @brief 元素个数的近似值（另一端并发修改时只是某一时刻的快照）
+   */
+  size_t size_approx() const {
+    size_t h = consumer.index.load(std::memory_order_acquire);
+    size_t t = producer.index.load(std::memory_order_acquire);
+    return t - h;
+  }
+
+  bool empty_approx() const { return size_approx() == 0; }
+
+  size_t capacity() const { return slots.size(); }
+
+private:
+  // 一端独占的下标及其对另一端下标的缓存，独占一条缓存行
+  struct alignas(64) Endpoint {
+    std::atomic<size_t> index{0};
+    size_t cached_other = 0;
+  };
+
+  Endpoint producer; // index 为尾下标，cached_other 缓存头下标
+  Endpoint consumer; // index 为头下标，cached_other 缓存尾下标
+  std::vector<T> slots;
+  size_t mask;
+
+  static size_t round_up_capacity(size_t capacity) {
+    if (capacity == 0) {
+      throw std::invalid_argument("队列容量必须为正");
+    }
+    size_t rounded = 1;
+    while (rounded < capacity) {
+      rounded <<= 1;
+    }
+    return rounded;
+  }
+};
+
+/**
+ * @brief 多生产者多消费者（MPMC）有界无锁队列（Vyukov）
+ *
+ * 每个槽位带一个序号：序号等于入队位置 pos 表示槽位空闲、可供第 pos 次
+ * 入队写入；等于 pos + 1 表示已写入、可供第 pos 次出队读取；出队后序号
+ * 置为 pos + 容量，留给下一轮。生产者和消费者各自用CAS抢占位置，
+ * 抢到后只访问自己的槽位，所以除了位置计数器外没有共享写。
+ *
+ * 入队位置与出队位置放在不同的缓存行上。操作是无锁的，但不是无等待的：
+ * 抢到位置的线程在写完槽位前被挂起，会让该槽位上的对端暂时看到队列满或空。
+ *
+ * T 需要可默认构造和移动赋值。
+ */
+template <typename T> class MpmcRingQueue {
+public:
+  /**
+   * @brief 构造函数
+   * @param capacity 最少能容纳的元素个数（向上取整为2的幂，至少为2）
+   * @throws std::invalid_argument 如果容量为0
+   */
+  explicit MpmcRingQueue(size_t capacity)
+      : size(round_up_capacity(capacity)), mask(size - 1),
+        cells(new Cell[size]) {
+    for (size_t i = 0; i < size; ++i) {
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpmcRingQueue(const MpmcRingQueue &) = delete;
+  MpmcRingQueue &operator=(const MpmcRingQueue &) = delete;
+
+  /**
+   * @brief 尝试入队，可被任意多个线程并发调用
+   * @return 队列已满时返回false
+   */
+  template <typename U> bool try_push(U &&value) {
+    size_t pos = enqueue_pos.value.load(std::memory_order_relaxed);
+    Cell *cell;
+    for (;;) {
+      cell = &cells[pos & mask];
+      size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      intptr_t diff =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos.value.compare_exchange_weak(
+                pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos.value.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = std::forward<U>(value);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief 尝试出队，可被任意多个线程并发调用
+   * @return 队列为空时返回false
+   */
+  bool try_pop(T &out) {
+    size_t pos = dequeue_pos.value.load(std::memory_order_relaxed);
+    Cell *cell;
+    for (;;) {
+      cell = &cells[pos & mask];
+      size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      intptr_t diff =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos.value.compare_exchange_weak(
+                pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos.value.load(std::memory_order_relaxed);
+      }
+    }
+    out = std::move(cell->value);
+    cell->sequence.store(pos + size, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief 入队，队列满时让出CPU等待
+   */
+  template <typename U> void push(U &&value) {
+    while (!try_push(std::forward<U>(value))) {
+      std::this_thread::yield();
+    }
+  }
+
+  /**
+   * @brief 出队，队列空时让出CPU等待
+   */
+  T pop() {
+    T value;
+    while (!try_pop(value)) {
+      std::this_thread::yield();
+    }
+    return value;
+  }
+
+  /**
+   * @brief 元素个数的近似值（并发修改时只是某一时刻的快照）
+   */
+  size_t size_approx() const {
+    size_t d = dequeue_pos.value.load(std::memory_order_acquire);
+    size_t e = enqueue_pos.value.load(std::memory_order_acquire);
+    return e > d ? e - d : 0;
+  }
+
+  bool empty_approx() const { return size_approx() == 0; }
+
+  size_t capacity() const { return size; }
+
+private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  struct alignas(64) Position {
+    std::atomic<size_t> value{0};
+  };
+
+  Position enqueue_pos;
+  Position dequeue_pos;
+  size_t size;
+  size_t mask;
+  std::unique_ptr<Cell[]> cells;
+
+  static size_t round_up_capacity(size_t capacity) {
+    if (capacity == 0) {
+      throw std::invalid_argument("队列容量必须为正");
+    }
+    size_t rounded = 2;
+    while (rounded < capacity) {
+      rounded <<= 1;
+    }
+    return rounded;
+  }
+};
+
 } // namespace algorithms
 
 #endif // STACK_QUEUE_H
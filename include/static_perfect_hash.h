@@ -0,0 +1,505 @@
+#ifndef STATIC_PERFECT_HASH_H
+#define STATIC_PERFECT_HASH_H
+
+#include "work_stealing_scheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace algorithms {
+
+/**
+ * @brief 静态最小完美散列（PTHash风格，11.5节完全散列的工程化版本）
+ *
+ * 把n个互不相同的键双射到[0, n)，只支持查询，不保存键本身：
+ * - 键先散列为64位指纹，再按指纹分成约partition_size个键一组的分区，
+ *   各分区互不依赖，在工作窃取调度器上并行构建
+ * - 分区内把键分到约 c*n/log2(n) 个桶（60%的键落入30%的桶，大桶先处理），
+ *   为每个桶依次尝试领航值pilot，使桶内所有键的位置 hash(指纹 ^ hash(pilot)) mod m
+ *   都落在空位上；m = n/alpha，落在[n, m)的位置再通过重映射表映射到[0, n)的空位
+ * - 领航值按分区的最大值定宽压缩存储，总计约3~4比特/键
+ * - 结果是一块由64位字组成的扁平缓冲区，可以直接写入文件，
+ *   启动时mmap后用load零拷贝加载（要求8字节对齐，按小端序存储）
+ * 查询不在集合中的键会返回[0, n)中的任意值，需要时由调用者校验。
+ */
+class StaticPerfectHash {
+public:
+  struct Config {
+    double alpha = 0.99;          // 负载因子 n/m
+    double c = 5.0;               // 桶数系数，越大构建越快、空间越大
+    size_t partition_size = 1 << 17; // 每个分区的平均键数
+    size_t num_threads = std::thread::hardware_concurrency();
+    uint64_t seed = 0x5DEECE66DULL;
+  };
+
+  StaticPerfectHash() = default;
+
+  StaticPerfectHash(const StaticPerfectHash &other)
+      : storage(other.storage), base(other.base), word_count(other.word_count) {
+    if (!storage.empty()) {
+      base = storage.data();
+    }
+    bind();
+  }
+
+  StaticPerfectHash(StaticPerfectHash &&other) noexcept
+      : storage(std::move(other.storage)), base(other.base),
+        word_count(other.word_count) {
+    if (!storage.empty()) {
+      base = storage.data();
+    }
+    bind();
+  }
+
+  StaticPerfectHash &operator=(StaticPerfectHash other) {
+    storage = std::move(other.storage);
+    base = storage.empty() ? other.base : storage.data();
+    word_count = other.word_count;
+    bind();
+    return *this;
+  }
+
+  /**
+   * @brief 为互不相同的键构建最小完美散列
+   * @throws std::invalid_argument 键有重复（或多次更换种子后指纹仍然冲突）
+   */
+  template <typename K>
+  static StaticPerfectHash build(const std::vector<K> &keys,
+                                 const Config &config = Config()) {
+    if (!(config.alpha > 0.0 && config.alpha <= 1.0) || config.c <= 0.0 ||
+        config.partition_size == 0) {
+      throw std::invalid_argument("Invalid perfect hash configuration");
+    }
+    WorkStealingScheduler scheduler(std::max<size_t>(1, config.num_threads));
+    std::vector<uint64_t> hashes(keys.size());
+
+    uint64_t seed = config.seed;
+    for (int attempt = 0; attempt < kMaxAttempts; attempt++) {
+      scheduler.parallel_for(0, keys.size(), 1 << 14,
+                             [&](size_t begin, size_t end) {
+                               for (size_t i = begin; i < end; i++)
+                                 hashes[i] = fingerprint(keys[i], seed);
+                             });
+      StaticPerfectHash result;
+      if (result.build_from_hashes(scheduler, hashes, seed, config)) {
+        return result;
+      }
+      seed = mix(seed + 0x9E3779B97F4A7C15ULL);
+    }
+    throw std::invalid_argument(
+        "Perfect hash construction failed: duplicate keys");
+  }
+
+  /**
+   * @brief 从扁平缓冲区零拷贝加载（例如mmap得到的内存）
+   * @param data 8字节对齐的缓冲区，必须在返回对象的生命周期内保持有效
+   */
+  static StaticPerfectHash load(const void *data, size_t size_bytes) {
+    if (reinterpret_cast<uintptr_t>(data) % alignof(uint64_t) != 0) {
+      throw std::invalid_argument("Perfect hash buffer must be 8-byte aligned");
+    }
+    const uint64_t *words = static_cast<const uint64_t *>(data);
+    size_t count = size_bytes / sizeof(uint64_t);
+    if (count < kHeaderWords || words[0] != kMagic || words[1] != kVersion ||
+        words[kTotalWordsField] != count) {
+      throw std::invalid_argument("Not a valid perfect hash buffer");
+    }
+    StaticPerfectHash result;
+    result.base = words;
+    result.word_count = count;
+    result.bind();
+    return result;
+  }
+
+  // 键在[0, n)中的编号
+  template <typename K> uint64_t lookup(const K &key) const {
+    return lookup_hash(fingerprint(key, seed));
+  }
+
+  size_t size() const { return key_count; }
+  const void *data() const { return base; }
+  size_t size_bytes() const { return word_count * sizeof(uint64_t); }
+  double bits_per_key() const {
+    return key_count == 0 ? 0.0 : 64.0 * word_count / key_count;
+  }
+
+  void save(std::ostream &out) const {
+    out.write(reinterpret_cast<const char *>(base),
+              static_cast<std::streamsize>(size_bytes()));
+  }
+
+  // 64位指纹：整数键与字符串键
+  template <typename K>
+  static typename std::enable_if<std::is_integral<K>::value, uint64_t>::type
+  fingerprint(K key, uint64_t seed) {
+    return mix(static_cast<uint64_t>(key) ^ mix(seed));
+  }
+
+  static uint64_t fingerprint(std::string_view key, uint64_t seed) {
+    return hash_bytes(key.data(), key.size(), seed);
+  }
+
+  static uint64_t fingerprint(const std::string &key, uint64_t seed) {
+    return hash_bytes(key.data(), key.size(), seed);
+  }
+
+private:
+  static constexpr uint64_t kMagic = 0x3148504D43495453ULL; // "STICMPH1"
+  static constexpr uint64_t kVersion = 1;
+  static constexpr int kMaxAttempts = 4;
+  static constexpr uint64_t kMaxPilot = uint64_t(1) << 24;
+  static constexpr uint64_t kPartitionSalt = 0xA0761D6478BD642FULL;
+  static constexpr uint64_t kPilotSalt = 0xE7037ED1A0B428DBULL;
+
+  // 头部：magic, version, seed, key_count, partition_count,
+  //       pilot_words, remap_count, total_words
+  static constexpr size_t kHeaderWords = 8;
+  static constexpr size_t kTotalWordsField = 7;
+  // 每个分区：key_offset, key_count, table_size, bucket_count,
+  //           pilot_word_offset, pilot_width, remap_offset
+  static constexpr size_t kPartitionWords = 7;
+
+  struct PartitionResult {
+    size_t table_size = 0;
+    size_t bucket_count = 0;
+    unsigned pilot_width = 1;
+    std::vector<uint64_t> pilots;
+    std::vector<uint32_t> remap;
+    bool ok = false;
+  };
+
+  std::vector<uint64_t> storage; // 构建得到的缓冲区；load得到的对象不拥有内存
+  const uint64_t *base = nullptr;
+  size_t word_count = 0;
+
+  // 从缓冲区解析出的字段
+  uint64_t seed = 0;
+  size_t key_count = 0;
+  size_t partition_count = 0;
+  const uint64_t *partitions = nullptr;
+  const uint64_t *pilot_words = nullptr;
+  const uint32_t *remap = nullptr;
+
+  static uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+  }
+
+  static uint64_t hash_bytes(const char *data, size_t length, uint64_t seed) {
+    uint64_t h = mix(seed) ^ (length * 0x9E3779B97F4A7C15ULL);
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+      uint64_t word;
+      std::memcpy(&word, data + i, 8);
+      h = (h ^ mix(word)) * 0x9FB21C651E98DF25ULL;
+    }
+    uint64_t tail = 0;
+    std::memcpy(&tail, data + i, length - i);
+    h = (h ^ mix(tail ^ length)) * 0x9FB21C651E98DF25ULL;
+    return mix(h);
+  }
+
+  // 把x均匀映射到[0, range)
+  static uint64_t fast_range(uint64_t x, uint64_t range) {
+#if defined(__SIZEOF_INT128__)
+    return static_cast<uint64_t>((static_cast<unsigned __int128>(x) * range) >>
+                                 64);
+#else
+    return x % range;
+#endif
+  }
+
+  static size_t partition_of(uint64_t hash, size_t count) {
+    return static_cast<size_t>(fast_range(mix(hash ^ kPartitionSalt), count));
+  }
+
+  // 偏斜的桶分配：60%的键落入前30%的桶
+  static size_t bucket_of(uint64_t hash, size_t bucket_count) {
+    uint32_t low = static_cast<uint32_t>(hash);
+    uint64_t high = hash >> 32;
+    size_t dense = static_cast<size_t>(bucket_count * 0.3);
+    if (low < 0x9999999AU) { // 0.6 * 2^32
+      return dense == 0 ? 0 : static_cast<size_t>((high * dense) >> 32);
+    }
+    return dense + static_cast<size_t>((high * (bucket_count - dense)) >> 32);
+  }
+
+  static uint64_t position_of(uint64_t hash, uint64_t pilot_hash,
+                              size_t table_size) {
+    return fast_range(mix(hash ^ pilot_hash), table_size);
+  }
+
+  static uint64_t pilot_hash_of(uint64_t pilot) {
+    return mix(pilot ^ kPilotSalt);
+  }
+
+  uint64_t lookup_hash(uint64_t hash) const {
+    if (partition_count == 0) {
+      return 0;
+    }
+    const uint64_t *info =
+        partitions + partition_of(hash, partition_count) * kPartitionWords;
+    uint64_t local_keys = info[1], table_size = info[2], buckets = info[3];
+    unsigned width = static_cast<unsigned>(info[5]);
+
+    size_t bit = bucket_of(hash, buckets) * width;
+    const uint64_t *word = pilot_words + info[4] + (bit >> 6);
+    unsigned shift = bit & 63;
+    uint64_t pilot = word[0] >> shift;
+    if (shift + width > 64) {
+      pilot |= word[1] << (64 - shift);
+    }
+    pilot &= (uint64_t(1) << width) - 1;
+
+    uint64_t position = position_of(hash, pilot_hash_of(pilot), table_size);
+    if (position >= local_keys) {
+      position = remap[info[6] + position - local_keys];
+    }
+    return info[0] + position;
+  }
+
+  void bind() {
+    if (base == nullptr) {
+      seed = 0;
+      key_count = partition_count = 0;
+      partitions = pilot_words = nullptr;
+      remap = nullptr;
+      return;
+    }
+    seed = base[2];
+    key_count = base[3];
+    partition_count = base[4];
+    partitions = base + kHeaderWords;
+    pilot_words = partitions + partition_count * kPartitionWords;
+    remap = reinterpret_cast<const uint32_t *>(pilot_words + base[5]);
+  }
+
+  // 构建一个分区；桶内指纹重复时返回失败
+  static PartitionResult build_partition(const uint64_t *hashes, size_t n,
+                                         const Config &config) {
+    PartitionResult result;
+    result.table_size =
+        std::max(n, static_cast<size_t>(std::ceil(n / config.alpha)));
+    result.bucket_count = std::max<size_t>(
+        1, static_cast<size_t>(std::ceil(
+               config.c * n / std::log2(static_cast<double>(std::max<size_t>(n, 2))))));
+    size_t table_size = result.table_size, buckets = result.bucket_count;
+
+    // 按桶计数排序
+    std::vector<uint32_t> bucket_start(buckets + 1, 0);
+    for (size_t i = 0; i < n; i++) {
+      bucket_start[bucket_of(hashes[i], buckets) + 1]++;
+    }
+    size_t max_bucket = 0;
+    for (size_t b = 0; b < buckets; b++) {
+      max_bucket = std::max<size_t>(max_bucket, bucket_start[b + 1]);
+      bucket_start[b + 1] += bucket_start[b];
+    }
+    std::vector<uint64_t> sorted(n);
+    {
+      std::vector<uint32_t> cursor(bucket_start.begin(), bucket_start.end() - 1);
+      for (size_t i = 0; i < n; i++) {
+        sorted[cursor[bucket_of(hashes[i], buckets)]++] = hashes[i];
+      }
+    }
+
+    // 按桶大小从大到小排列桶，同时检查桶内重复指纹
+    std::vector<uint32_t> size_start(max_bucket + 2, 0);
+    for (size_t b = 0; b < buckets; b++) {
+      size_t size = bucket_start[b + 1] - bucket_start[b];
+      size_start[max_bucket - size + 1]++;
+      std::sort(sorted.begin() + bucket_start[b],
+                sorted.begin() + bucket_start[b + 1]);
+      for (size_t k = bucket_start[b] + 1; k < bucket_start[b + 1]; k++) {
+        if (sorted[k] == sorted[k - 1]) {
+          return result;
+        }
+      }
+    }
+    for (size_t s = 0; s <= max_bucket; s++) {
+      size_start[s + 1] += size_start[s];
+    }
+    std::vector<uint32_t> order(buckets);
+    for (size_t b = 0; b < buckets; b++) {
+      size_t size = bucket_start[b + 1] - bucket_start[b];
+      order[size_start[max_bucket - size]++] = static_cast<uint32_t>(b);
+    }
+
+    // 依次为每个桶寻找领航值
+    std::vector<uint64_t> taken((table_size + 63) / 64, 0);
+    std::vector<uint64_t> slots;
+    result.pilots.assign(buckets, 0);
+    uint64_t max_pilot = 0;
+    for (uint32_t b : order) {
+      size_t first = bucket_start[b], last = bucket_start[b + 1];
+      if (first == last) {
+        break; // 其余桶都是空的
+      }
+      for (uint64_t pilot = 0;; pilot++) {
+        if (pilot == kMaxPilot) {
+          return result;
+        }
+        uint64_t pilot_hash = pilot_hash_of(pilot);
+        slots.clear();
+        bool fits = true;
+        for (size_t k = first; k < last && fits; k++) {
+          uint64_t position = position_of(sorted[k], pilot_hash, table_size);
+          fits = !(taken[position >> 6] >> (position & 63) & 1) &&
+                 std::find(slots.begin(), slots.end(), position) == slots.end();
+          slots.push_back(position);
+        }
+        if (fits) {
+          for (uint64_t position : slots) {
+            taken[position >> 6] |= uint64_t(1) << (position & 63);
+          }
+          result.pilots[b] = pilot;
+          max_pilot = std::max(max_pilot, pilot);
+          break;
+        }
+      }
+    }
+    while (result.pilot_width < 64 && (max_pilot >> result.pilot_width) != 0) {
+      result.pilot_width++;
+    }
+
+    // 落在[n, m)的位置依次映射到[0, n)中的空位
+    result.remap.assign(table_size - n, 0);
+    size_t free_slot = 0;
+    for (size_t position = n; position < table_size; position++) {
+      if (taken[position >> 6] >> (position & 63) & 1) {
+        while (taken[free_slot >> 6] >> (free_slot & 63) & 1) {
+          free_slot++;
+        }
+        result.remap[position - n] = static_cast<uint32_t>(free_slot++);
+      }
+    }
+    result.ok = true;
+    return result;
+  }
+
+  bool build_from_hashes(WorkStealingScheduler &scheduler,
+                         const std::vector<uint64_t> &hashes, uint64_t seed_value,
+                         const Config &config) {
+    size_t n = hashes.size();
+    size_t parts = n == 0 ? 0 : (n + config.partition_size - 1) / config.partition_size;
+
+    // 按分区做并行的计数排序：每块统计直方图，前缀和后各自散布
+    size_t chunk_count = std::max<size_t>(
+        1, std::min<size_t>(4 * scheduler.get_num_threads(), n / 65536 + 1));
+    size_t chunk_size = (n + chunk_count - 1) / std::max<size_t>(chunk_count, 1);
+    std::vector<size_t> counts(parts * chunk_count + 1, 0);
+    scheduler.parallel_for(0, chunk_count, 1, [&](size_t begin, size_t end) {
+      for (size_t c = begin; c < end; c++) {
+        size_t last = std::min(n, (c + 1) * chunk_size);
+        for (size_t i = c * chunk_size; i < last; i++)
+          counts[partition_of(hashes[i], parts) * chunk_count + c]++;
+      }
+    });
+    size_t running = 0;
+    for (size_t k = 0; k < parts * chunk_count; k++) {
+      size_t count = counts[k];
+      counts[k] = running;
+      running += count;
+    }
+    counts[parts * chunk_count] = n;
+    std::vector<uint64_t> partitioned(n);
+    scheduler.parallel_for(0, chunk_count, 1, [&](size_t begin, size_t end) {
+      for (size_t c = begin; c < end; c++) {
+        std::vector<size_t> cursor(parts);
+        for (size_t p = 0; p < parts; p++)
+          cursor[p] = counts[p * chunk_count + c];
+        size_t last = std::min(n, (c + 1) * chunk_size);
+        for (size_t i = c * chunk_size; i < last; i++)
+          partitioned[cursor[partition_of(hashes[i], parts)]++] = hashes[i];
+      }
+    });
+
+    // 并行构建各分区
+    std::vector<PartitionResult> results(parts);
+    scheduler.parallel_for(0, parts, 1, [&](size_t begin, size_t end) {
+      for (size_t p = begin; p < end; p++) {
+        size_t first = counts[p * chunk_count];
+        size_t last = counts[(p + 1) * chunk_count];
+        results[p] = build_partition(partitioned.data() + first, last - first,
+                                     config);
+      }
+    });
+    for (const auto &result : results) {
+      if (!result.ok) {
+        return false;
+      }
+    }
+
+    // 布局：头部、分区表、领航值（每个分区从新的字开始）、重映射表
+    std::vector<size_t> pilot_offsets(parts + 1, 0), remap_offsets(parts + 1, 0);
+    for (size_t p = 0; p < parts; p++) {
+      pilot_offsets[p + 1] = pilot_offsets[p] +
+                             (results[p].bucket_count * results[p].pilot_width + 63) / 64;
+      remap_offsets[p + 1] = remap_offsets[p] + results[p].remap.size();
+    }
+    size_t pilot_word_total = pilot_offsets[parts];
+    size_t remap_total = remap_offsets[parts];
+    size_t total = kHeaderWords + parts * kPartitionWords + pilot_word_total +
+                   (remap_total + 1) / 2;
+    storage.assign(total, 0);
+    uint64_t *words = storage.data();
+    words[0] = kMagic;
+    words[1] = kVersion;
+    words[2] = seed_value;
+    words[3] = n;
+    words[4] = parts;
+    words[5] = pilot_word_total;
+    words[6] = remap_total;
+    words[kTotalWordsField] = total;
+
+    uint64_t *info = words + kHeaderWords;
+    uint64_t *pilots_out = info + parts * kPartitionWords;
+    uint32_t *remap_out = reinterpret_cast<uint32_t *>(pilots_out + pilot_word_total);
+    scheduler.parallel_for(0, parts, 1, [&](size_t begin, size_t end) {
+      for (size_t p = begin; p < end; p++) {
+        const PartitionResult &result = results[p];
+        uint64_t *entry = info + p * kPartitionWords;
+        entry[0] = counts[p * chunk_count];
+        entry[1] = counts[(p + 1) * chunk_count] - counts[p * chunk_count];
+        entry[2] = result.table_size;
+        entry[3] = result.bucket_count;
+        entry[4] = pilot_offsets[p];
+        entry[5] = result.pilot_width;
+        entry[6] = remap_offsets[p];
+
+        uint64_t *out = pilots_out + pilot_offsets[p];
+        for (size_t b = 0; b < result.bucket_count; b++) {
+          size_t bit = b * result.pilot_width;
+          unsigned shift = bit & 63;
+          out[bit >> 6] |= result.pilots[b] << shift;
+          if (shift + result.pilot_width > 64) {
+            out[(bit >> 6) + 1] |= result.pilots[b] >> (64 - shift);
+          }
+        }
+        std::copy(result.remap.begin(), result.remap.end(),
+                  remap_out + remap_offsets[p]);
+      }
+    });
+
+    base = storage.data();
+    word_count = total;
+    bind();
+    return true;
+  }
+};
+
+} // namespace algorithms
+
+#endif // STATIC_PERFECT_HASH_H
@@ -0,0 +1,238 @@
+#ifndef STRASSEN_MULTIPLICATION_H
+#define STRASSEN_MULTIPLICATION_H
+
+#include "gemm_kernel.h"
+#include "matrix_operations.h"
+#include "work_stealing_scheduler.h"
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace algorithms {
+
+/**
+ * @brief Strassen-Winograd矩阵乘法（算法导论4.2节，作用于连续存储的Matrix）
+ *
+ * - 使用Winograd变体：7次子乘法、15次加减法（经典Strassen为18次）
+ * - 子矩阵规模不超过cutoff时改用分块SIMD内核（gemm_kernel.h）
+ * - 所有临时矩阵都从一次性预分配的暂存区中按栈方式切出，递归过程不再分配内存：
+ *   串行递归采用Douglas等人的调度，每层只需两个(n/2)x(n/2)临时块
+ * - 顶层的7个子乘积在工作窃取调度器上spawn并行执行，每个任务使用自己的暂存区
+ * 任意形状的矩阵先补零到 cutoff * 2^k 的方阵。分块内核本身已接近峰值，
+ * 加法是访存密集的，因此截止规模取得较大（默认512）。
+ */
+class StrassenMultiplication {
+public:
+  /**
+   * @brief 计算 A * B
+   * @param A 左矩阵
+   * @param B 右矩阵
+   * @param cutoff 递归截止规模，不超过该规模时调用分块内核
+   * @param num_threads 顶层子乘积并行使用的线程数，1表示完全串行
+   * @return 乘积矩阵（行主序）
+   */
+  static Matrix multiply(const Matrix &A, const Matrix &B, size_t cutoff = 512,
+                         size_t num_threads = std::thread::hardware_concurrency()) {
+    if (A.get_cols() != B.get_rows())
+      throw std::invalid_argument(
+          "Matrix dimensions must match for multiplication");
+    if (cutoff == 0)
+      throw std::invalid_argument("Strassen cutoff must be positive");
+    if (num_threads == 0)
+      num_threads = 1;
+
+    size_t M = A.get_rows(), K = A.get_cols(), N = B.get_cols();
+    Matrix C(M, N);
+    if (M == 0 || N == 0 || K == 0)
+      return C;
+
+    size_t largest = std::max({M, N, K});
+    if (largest <= cutoff) {
+      Matrix a = A.to_layout(MatrixLayout::RowMajor);
+      Matrix b = B.to_layout(MatrixLayout::RowMajor);
+      GemmKernel::gemm(M, N, K, a.raw_data(), K, b.raw_data(), N,
+                       C.raw_data(), N);
+      return C;
+    }
+
+    // 补零到 cutoff级别的规模 * 2^levels
+    size_t base = largest;
+    int levels = 0;
+    while (base > cutoff) {
+      base = (base + 1) / 2;
+      levels++;
+    }
+    size_t n = base << levels;
+
+    std::vector<double> padded_a = pad(A, n);
+    std::vector<double> padded_b = pad(B, n);
+    std::vector<double> padded_c(n * n, 0.0);
+
+    View a{padded_a.data(), n}, b{padded_b.data(), n}, c{padded_c.data(), n};
+    if (num_threads > 1) {
+      parallel_top_level(a, b, c, n, cutoff, num_threads);
+    } else {
+      std::vector<double> arena(arena_size(n, cutoff));
+      multiply_recursive(a, b, c, n, cutoff, arena.data());
+    }
+
+    for (size_t i = 0; i < M; i++)
+      std::copy(padded_c.begin() + i * n, padded_c.begin() + i * n + N,
+                C.raw_data() + i * N);
+    return C;
+  }
+
+private:
+  // 方阵子块视图：左上角指针与行跨度
+  struct View {
+    double *data;
+    size_t ld;
+
+    View block(size_t row, size_t col, size_t half) const {
+      return {data + row * half * ld + col * half, ld};
+    }
+  };
+
+  static std::vector<double> pad(const Matrix &source, size_t n) {
+    std::vector<double> result(n * n, 0.0);
+    for (int i = 0; i < source.get_rows(); i++)
+      for (int j = 0; j < source.get_cols(); j++)
+        result[i * n + j] = source.unchecked(i, j);
+    return result;
+  }
+
+  // 串行递归所需暂存区大小：每层两个(n/2)^2临时块
+  static size_t arena_size(size_t n, size_t cutoff) {
+    size_t total = 0;
+    while (n > cutoff) {
+      n /= 2;
+      total += 2 * n * n;
+    }
+    return total;
+  }
+
+  // dst = x + y / x - y
+  static void add(View x, View y, View dst, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+      const double *xr = x.data + i * x.ld, *yr = y.data + i * y.ld;
+      double *dr = dst.data + i * dst.ld;
+      for (size_t j = 0; j < n; j++)
+        dr[j] = xr[j] + yr[j];
+    }
+  }
+
+  static void sub(View x, View y, View dst, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+      const double *xr = x.data + i * x.ld, *yr = y.data + i * y.ld;
+      double *dr = dst.data + i * dst.ld;
+      for (size_t j = 0; j < n; j++)
+        dr[j] = xr[j] - yr[j];
+    }
+  }
+
+  // C = A * B（覆盖C），arena为本层及更深层的暂存区
+  static void multiply_recursive(View A, View B, View C, size_t n,
+                                 size_t cutoff, double *arena) {
+    if (n <= cutoff) {
+      for (size_t i = 0; i < n; i++)
+        std::fill(C.data + i * C.ld, C.data + i * C.ld + n, 0.0);
+      GemmKernel::gemm(n, n, n, A.data, A.ld, B.data, B.ld, C.data, C.ld);
+      return;
+    }
+
+    size_t h = n / 2;
+    View A11 = A.block(0, 0, h), A12 = A.block(0, 1, h),
+         A21 = A.block(1, 0, h), A22 = A.block(1, 1, h);
+    View B11 = B.block(0, 0, h), B12 = B.block(0, 1, h),
+         B21 = B.block(1, 0, h), B22 = B.block(1, 1, h);
+    View C11 = C.block(0, 0, h), C12 = C.block(0, 1, h),
+         C21 = C.block(1, 0, h), C22 = C.block(1, 1, h);
+
+    View X{arena, h}, Y{arena + h * h, h};
+    double *deeper = arena + 2 * h * h;
+
+    // Douglas等人的Winograd调度，只用两个临时块X、Y
+    sub(A11, A21, X, h);                            // X = S3
+    sub(B22, B12, Y, h);                            // Y = T3
+    multiply_recursive(X, Y, C21, h, cutoff, deeper); // C21 = P7
+    add(A21, A22, X, h);                            // X = S1
+    sub(B12, B11, Y, h);                            // Y = T1
+    multiply_recursive(X, Y, C22, h, cutoff, deeper); // C22 = P5
+    sub(X, A11, X, h);                              // X = S2
+    sub(B22, Y, Y, h);                              // Y = T2
+    multiply_recursive(X, Y, C12, h, cutoff, deeper); // C12 = P6
+    sub(A12, X, X, h);                              // X = S4
+    multiply_recursive(X, B22, C11, h, cutoff, deeper); // C11 = P3
+    multiply_recursive(A11, B11, X, h, cutoff, deeper); // X = P1
+    add(X, C12, C12, h);                            // C12 = U2 = P1 + P6
+    add(C12, C21, C21, h);                          // C21 = U3 = U2 + P7
+    add(C12, C22, C12, h);                          // C12 = U4 = U2 + P5
+    add(C21, C22, C22, h);                          // C22 = U7 = U3 + P5
+    add(C12, C11, C12, h);                          // C12 = U5 = U4 + P3
+    sub(Y, B21, Y, h);                              // Y = T4
+    multiply_recursive(A22, Y, C11, h, cutoff, deeper); // C11 = P4
+    sub(C21, C11, C21, h);                          // C21 = U6 = U3 - P4
+    multiply_recursive(A12, B21, C11, h, cutoff, deeper); // C11 = P2
+    add(X, C11, C11, h);                            // C11 = U1 = P1 + P2
+  }
+
+  // 顶层：先算出8个和式，再spawn 7个子乘积并行计算，最后合并
+  static void parallel_top_level(View A, View B, View C, size_t n,
+                                 size_t cutoff, size_t num_threads) {
+    size_t h = n / 2, block = h * h;
+    View A11 = A.block(0, 0, h), A12 = A.block(0, 1, h),
+         A21 = A.block(1, 0, h), A22 = A.block(1, 1, h);
+    View B11 = B.block(0, 0, h), B12 = B.block(0, 1, h),
+         B21 = B.block(1, 0, h), B22 = B.block(1, 1, h);
+
+    // 8个和式 + 7个乘积 + 7份子任务暂存区，一次分配
+    size_t task_arena = arena_size(h, cutoff);
+    std::vector<double> storage(15 * block + 7 * task_arena);
+    auto temp = [&](size_t k) { return View{storage.data() + k * block, h}; };
+    View S1 = temp(0), S2 = temp(1), S3 = temp(2), S4 = temp(3);
+    View T1 = temp(4), T2 = temp(5), T3 = temp(6), T4 = temp(7);
+    View P[7] = {temp(8),  temp(9),  temp(10), temp(11),
+                 temp(12), temp(13), temp(14)};
+    double *arenas = storage.data() + 15 * block;
+
+    add(A21, A22, S1, h);
+    sub(S1, A11, S2, h);
+    sub(A11, A21, S3, h);
+    sub(A12, S2, S4, h);
+    sub(B12, B11, T1, h);
+    sub(B22, T1, T2, h);
+    sub(B22, B12, T3, h);
+    sub(T2, B21, T4, h);
+
+    // P1..P7 的左右因子
+    View left[7] = {A11, A12, S4, A22, S1, S2, S3};
+    View right[7] = {B11, B21, B22, T4, T1, T2, T3};
+
+    WorkStealingScheduler scheduler(std::min<size_t>(num_threads, 7));
+    scheduler.run([&] {
+      WorkStealingScheduler::TaskGroup group;
+      for (int k = 0; k < 7; k++) {
+        group.spawn([&, k] {
+          multiply_recursive(left[k], right[k], P[k], h, cutoff,
+                             arenas + k * task_arena);
+        });
+      }
+      group.sync();
+    });
+
+    View C11 = C.block(0, 0, h), C12 = C.block(0, 1, h),
+         C21 = C.block(1, 0, h), C22 = C.block(1, 1, h);
+    add(P[0], P[1], C11, h);  // U1 = P1 + P2
+    add(P[0], P[5], S1, h);   // U2 = P1 + P6（复用S1）
+    add(S1, P[6], S2, h);     // U3 = U2 + P7（复用S2）
+    add(S1, P[4], S3, h);     // U4 = U2 + P5（复用S3）
+    add(S3, P[2], C12, h);    // U5 = U4 + P3
+    sub(S2, P[3], C21, h);    // U6 = U3 - P4
+    add(S2, P[4], C22, h);    // U7 = U3 + P5
+  }
+};
+
+} // namespace algorithms
+
+#endif // STRASSEN_MULTIPLICATION_H
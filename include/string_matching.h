@@ -1,44 +1,84 @@
 #ifndef STRING_MATCHING_H
 #define STRING_MATCHING_H
 
+#include "cpu_features.h"
+#include "flat_hash_map.h"
+#include "gemm_kernel.h"
+#include "work_stealing_scheduler.h"
+#include <algorithm>
+#include <climits>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <iostream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 namespace algorithms {
 
+// 所有匹配器接受 std::string_view（std::string、MappedText::view()
+// 或任意字节区间都可以零拷贝传入），并提供两种输出方式：
+// - scan(text, pattern, on_match)：按位置递增调用 on_match(std::size_t)，
+//   不分配结果数组，偏移量不受 int 范围限制；
+// - search(text, pattern)：返回 std::vector<int>，文本长度超过 INT_MAX
+//   时抛出 std::length_error，应改用 scan。
+namespace string_matching_detail {
+
+template <typename Scan>
+std::vector<int> collect_int_positions(std::string_view text, Scan scan) {
+  if (text.size() > static_cast<std::size_t>(INT_MAX)) {
+    throw std::length_error("文本超过 int 偏移范围，请使用 scan");
+  }
+  std::vector<int> matches;
+  scan([&matches](std::size_t pos) {
+    matches.push_back(static_cast<int>(pos));
+  });
+  return matches;
+}
+
+} // namespace string_matching_detail
+
 // 32.1 朴素字符串匹配算法
 class NaiveStringMatcher {
 public:
-  // 朴素字符串匹配
-  static std::vector<int> search(const std::string &text,
-                                 const std::string &pattern) {
-    std::vector<int> matches;
-    int n = text.length();
-    int m = pattern.length();
+  // 朴素字符串匹配；空模式在每个位置 0..n 都匹配
+  template <typename OnMatch>
+  static void scan(std::string_view text, std::string_view pattern,
+                   OnMatch on_match) {
+    std::size_t n = text.size();
+    std::size_t m = pattern.size();
+    if (n < m) {
+      return;
+    }
 
-    for (int s = 0; s <= n - m; s++) {
+    for (std::size_t s = 0; s <= n - m; s++) {
       bool match = true;
-      for (int i = 0; i < m; i++) {
+      for (std::size_t i = 0; i < m; i++) {
         if (text[s + i] != pattern[i]) {
           match = false;
           break;
         }
       }
       if (match) {
-        matches.push_back(s);
+        on_match(s);
       }
     }
+  }
 
-    return matches;
+  static std::vector<int> search(std::string_view text,
+                                 std::string_view pattern) {
+    return string_matching_detail::collect_int_positions(
+        text, [&](auto on_match) { scan(text, pattern, on_match); });
   }
 
   // 带偏移量显示的匹配
-  static void search_with_offset(const std::string &text,
-                                 const std::string &pattern) {
+  static void search_with_offset(std::string_view text,
+                                 std::string_view pattern) {
     auto matches = search(text, pattern);
 
     std::cout << "文本: " << text << std::endl;
@@ -60,79 +100,230 @@ public:
   }
 };
 
-// 32.2 Rabin-Karp算法
-class RabinKarpMatcher {
+// 模 2^61 - 1（梅森素数）的多项式滚动哈希
+// 对长度为 L 的窗口 w，hash(w) = sum w[i] * base^(L-1-i) mod (2^61 - 1)。
+// 模数为梅森素数时取模只需移位和加法，乘法用128位中间结果；
+// 两个不同窗口的碰撞概率约为 L / 2^61，而以小素数（如101）为模时约为 1/101。
+// base 固定时同一文本在不同运行中得到相同的哈希值（适合 shingle 去重），
+// 面对可能构造碰撞的输入时应传入随机 base。
+class RollingHash {
+public:
+  static constexpr std::uint64_t kModulus = (1ULL << 61) - 1;
+  static constexpr std::uint64_t kDefaultBase =
+      0x1F3A5C7E9B2D4F61ULL % kModulus;
+
+  static std::uint64_t mul(std::uint64_t a, std::uint64_t b) {
+    unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    std::uint64_t result = (static_cast<std::uint64_t>(product) & kModulus) +
+                           static_cast<std::uint64_t>(product >> 61);
+    return result >= kModulus ? result - kModulus : result;
+  }
+
+  static std::uint64_t add(std::uint64_t a, std::uint64_t b) {
+    std::uint64_t result = a + b;
+    return result >= kModulus ? result - kModulus : result;
+  }
+
+  static std::uint64_t sub(std::uint64_t a, std::uint64_t b) {
+    return a >= b ? a - b : a + kModulus - b;
+  }
+
 private:
-  static const int PRIME = 101; // 大素数
-  static const int BASE = 256;  // 字符集大小（ASCII）
+  std::size_t window;
+  std::uint64_t base;
+  std::uint64_t out_term[256]; // c * base^(window-1)，滚动时移出字节的贡献
 
 public:
-  // Rabin-Karp字符串匹配
-  static std::vector<int> search(const std::string &text,
-                                 const std::string &pattern) {
-    std::vector<int> matches;
-    int n = text.length();
-    int m = pattern.length();
+  /**
+   * @param window 窗口长度（至少为1）
+   * @param base 多项式的底，取值范围 [256, 2^61 - 1)
+   */
+  explicit RollingHash(std::size_t window, std::uint64_t base = kDefaultBase)
+      : window(window), base(base) {
+    if (window == 0) {
+      throw std::invalid_argument("窗口长度必须为正");
+    }
+    if (base < 256 || base >= kModulus) {
+      throw std::invalid_argument("base 超出范围");
+    }
+    std::uint64_t top_power = 1;
+    for (std::size_t i = 1; i < window; i++) {
+      top_power = mul(top_power, base);
+    }
+    for (int c = 0; c < 256; c++) {
+      out_term[c] = mul(static_cast<std::uint64_t>(c), top_power);
+    }
+  }
 
-    if (m == 0 || n < m) {
-      return matches;
+  std::size_t window_size() const { return window; }
+
+  // 任意长度串的哈希（长度等于 window 时与滚动结果一致）
+  std::uint64_t hash(std::string_view data) const {
+    std::uint64_t h = 0;
+    for (unsigned char c : data) {
+      h = add(mul(h, base), c);
     }
+    return h;
+  }
 
-    // 计算模式哈希和第一个文本窗口哈希
-    long long pattern_hash = 0;
-    long long text_hash = 0;
-    long long h = 1;
+  // 窗口右移一个字节：移出 out，移入 in
+  std::uint64_t roll(std::uint64_t h, unsigned char out,
+                     unsigned char in) const {
+    return add(mul(sub(h, out_term[out]), base), in);
+  }
 
-    // h = BASE^(m-1) % PRIME
-    for (int i = 0; i < m - 1; i++) {
-      h = (h * BASE) % PRIME;
+  // 对 text 的每个长度为 window 的窗口调用 visit(起始位置, 哈希值)
+  template <typename Visit>
+  void for_each_window(std::string_view text, Visit visit) const {
+    if (text.size() < window) {
+      return;
     }
+    const auto *bytes = reinterpret_cast<const unsigned char *>(text.data());
+    std::uint64_t h = hash(text.substr(0, window));
+    visit(std::size_t(0), h);
+    for (std::size_t s = 1; s + window <= text.size(); s++) {
+      h = roll(h, bytes[s - 1], bytes[s + window - 1]);
+      visit(s, h);
+    }
+  }
 
-    // 计算初始哈希值
-    for (int i = 0; i < m; i++) {
-      pattern_hash = (BASE * pattern_hash + pattern[i]) % PRIME;
-      text_hash = (BASE * text_hash + text[i]) % PRIME;
+  // 所有长度为 window 的 shingle 的哈希值，可直接用于 MinHash 等近似去重
+  std::vector<std::uint64_t> shingle_hashes(std::string_view text) const {
+    std::vector<std::uint64_t> hashes;
+    if (text.size() >= window) {
+      hashes.reserve(text.size() - window + 1);
     }
+    for_each_window(text, [&hashes](std::size_t, std::uint64_t h) {
+      hashes.push_back(h);
+    });
+    return hashes;
+  }
+};
 
-    // 滑动窗口
-    for (int s = 0; s <= n - m; s++) {
-      // 检查哈希值是否匹配
-      if (pattern_hash == text_hash) {
-        // 哈希匹配，检查实际字符
-        bool match = true;
-        for (int i = 0; i < m; i++) {
-          if (text[s + i] != pattern[i]) {
-            match = false;
-            break;
-          }
+// 32.2 Rabin-Karp算法
+// 使用 RollingHash（模 2^61 - 1），哈希相等后再逐字节验证
+class RabinKarpMatcher {
+public:
+  // Rabin-Karp字符串匹配
+  template <typename OnMatch>
+  static void scan(std::string_view text, std::string_view pattern,
+                   OnMatch on_match) {
+    if (pattern.empty() || text.size() < pattern.size()) {
+      return;
+    }
+
+    RollingHash hasher(pattern.size());
+    std::uint64_t pattern_hash = hasher.hash(pattern);
+    hasher.for_each_window(text, [&](std::size_t s, std::uint64_t h) {
+      // 哈希匹配，检查实际字符
+      if (h == pattern_hash &&
+          std::memcmp(text.data() + s, pattern.data(), pattern.size()) == 0) {
+        on_match(s);
+      }
+    });
+  }
+
+  static std::vector<int> search(std::string_view text,
+                                 std::string_view pattern) {
+    return string_matching_detail::collect_int_positions(
+        text, [&](auto on_match) { scan(text, pattern, on_match); });
+  }
+
+  // 多模式匹配：按位置递增调用 on_match(模式下标, 起始位置)
+  // 长度相同的模式放入同一张以哈希为键的散列表，所有长度在同一遍扫描中
+  // 各自滚动，期望时间 O(n × 不同长度数 + 总模式长度 + 命中验证)
+  template <typename OnMatch>
+  static void scan_multiple(std::string_view text,
+                            const std::vector<std::string_view> &patterns,
+                            OnMatch on_match) {
+
+    struct Group {
+      RollingHash hasher;
+      // 哈希 -> ids 中的起始下标；哈希相同的模式在 ids 中连续
+      FlatHashMap<std::uint64_t, std::uint32_t> first;
+      std::vector<std::pair<std::uint64_t, int>> ids;
+      std::uint64_t h;
+      explicit Group(std::size_t length) : hasher(length), h(0) {}
+    };
+
+    std::vector<Group> groups;
+    {
+      std::vector<int> order;
+      for (int id = 0; id < static_cast<int>(patterns.size()); id++) {
+        if (!patterns[id].empty() && patterns[id].size() <= text.size()) {
+          order.push_back(id);
         }
-        if (match) {
-          matches.push_back(s);
+      }
+      std::sort(order.begin(), order.end(), [&patterns](int a, int b) {
+        return patterns[a].size() < patterns[b].size();
+      });
+      for (int id : order) {
+        if (groups.empty() ||
+            groups.back().hasher.window_size() != patterns[id].size()) {
+          groups.emplace_back(patterns[id].size());
         }
+        Group &group = groups.back();
+        group.ids.emplace_back(group.hasher.hash(patterns[id]), id);
       }
+    }
+    for (Group &group : groups) {
+      std::sort(group.ids.begin(), group.ids.end());
+      group.first.reserve(group.ids.size());
+      for (std::uint32_t k = 0; k < group.ids.size(); k++) {
+        group.first.emplace(group.ids[k].first, k);
+      }
+    }
 
-      // 计算下一个窗口的哈希值
-      if (s < n - m) {
-        text_hash = (BASE * (text_hash - text[s] * h) + text[s + m]) % PRIME;
-
-        // 确保哈希值为正
-        if (text_hash < 0) {
-          text_hash += PRIME;
+    const auto *bytes = reinterpret_cast<const unsigned char *>(text.data());
+    for (std::size_t s = 0; s < text.size(); s++) {
+      for (Group &group : groups) {
+        std::size_t length = group.hasher.window_size();
+        if (s + length > text.size()) {
+          break; // 组按长度递增，后面的组更长
+        }
+        group.h = s == 0 ? group.hasher.hash(text.substr(0, length))
+                         : group.hasher.roll(group.h, bytes[s - 1],
+                                             bytes[s + length - 1]);
+        const std::uint32_t *k = group.first.find(group.h);
+        if (k == nullptr) {
+          continue;
+        }
+        for (std::uint32_t i = *k;
+             i < group.ids.size() && group.ids[i].first == group.h; i++) {
+          int id = group.ids[i].second;
+          if (std::memcmp(text.data() + s, patterns[id].data(), length) == 0) {
+            on_match(id, s);
+          }
         }
       }
     }
+  }
 
-    return matches;
+  // result[i] 为 patterns[i] 的所有出现位置（与 search 相同）
+  static std::vector<std::vector<int>>
+  search_multiple(std::string_view text,
+                  const std::vector<std::string> &patterns) {
+    if (text.size() > static_cast<std::size_t>(INT_MAX)) {
+      throw std::length_error("文本超过 int 偏移范围，请使用 scan_multiple");
+    }
+    std::vector<std::string_view> views(patterns.begin(), patterns.end());
+    std::vector<std::vector<int>> result(patterns.size());
+    scan_multiple(text, views, [&result](int id, std::size_t pos) {
+      result[id].push_back(static_cast<int>(pos));
+    });
+    return result;
   }
 
   // 显示哈希计算过程
-  static void search_with_hash(const std::string &text,
-                               const std::string &pattern) {
+  static void search_with_hash(std::string_view text,
+                               std::string_view pattern) {
     auto matches = search(text, pattern);
 
     std::cout << "文本: " << text << std::endl;
     std::cout << "模式: " << pattern << std::endl;
-    std::cout << "模式哈希: " << calculate_hash(pattern, pattern.length())
+    std::cout << "模式哈希: " << RollingHash(std::max<std::size_t>(
+                                     pattern.size(), 1))
+                                     .hash(pattern)
               << std::endl;
     std::cout << "匹配位置: ";
     for (int pos : matches) {
@@ -140,15 +331,6 @@ public:
     }
     std::cout << std::endl;
   }
-
-private:
-  static long long calculate_hash(const std::string &str, int length) {
-    long long hash = 0;
-    for (int i = 0; i < length; i++) {
-      hash = (BASE * hash + str[i]) % PRIME;
-    }
-    return hash;
-  }
 };
 
 // 32.3 利用有限自动机进行字符串匹配
@@ -156,9 +338,9 @@ class FiniteAutomatonMatcher {
 private:
   // 计算转移函数
   static std::vector<std::vector<int>>
-  compute_transition_function(const std::string &pattern,
+  compute_transition_function(std::string_view pattern,
                               int alphabet_size = 256) {
-    int m = pattern.length();
+    int m = static_cast<int>(pattern.length());
     std::vector<std::vector<int>> transition(
         m + 1, std::vector<int>(alphabet_size, 0));
 
@@ -168,7 +350,7 @@ private:
 
         // 找到P_k是P_q a的后缀的最大k
         while (k > 0) {
-          if (pattern[k - 1] == a) {
+          if (static_cast<unsigned char>(pattern[k - 1]) == a) {
             bool is_suffix = true;
             for (int i = 0; i < k - 1; i++) {
               if (pattern[i] != pattern[q - k + 1 + i]) {
@@ -192,32 +374,36 @@ private:
 
 public:
   // 有限自动机字符串匹配
-  static std::vector<int> search(const std::string &text,
-                                 const std::string &pattern) {
-    std::vector<int> matches;
-    int n = text.length();
-    int m = pattern.length();
+  template <typename OnMatch>
+  static void scan(std::string_view text, std::string_view pattern,
+                   OnMatch on_match) {
+    std::size_t n = text.length();
+    int m = static_cast<int>(pattern.length());
 
     if (m == 0) {
-      return matches;
+      return;
     }
 
     auto transition = compute_transition_function(pattern);
     int q = 0; // 当前状态
 
-    for (int i = 0; i < n; i++) {
+    for (std::size_t i = 0; i < n; i++) {
       q = transition[q][static_cast<unsigned char>(text[i])];
       if (q == m) {
-        matches.push_back(i - m + 1);
+        on_match(i + 1 - m);
       }
     }
+  }
 
-    return matches;
+  static std::vector<int> search(std::string_view text,
+                                 std::string_view pattern) {
+    return string_matching_detail::collect_int_positions(
+        text, [&](auto on_match) { scan(text, pattern, on_match); });
   }
 
   // 显示状态转移过程
-  static void search_with_transition(const std::string &text,
-                                     const std::string &pattern) {
+  static void search_with_transition(std::string_view text,
+                                     std::string_view pattern) {
     auto matches = search(text, pattern);
 
     std::cout << "文本: " << text << std::endl;
@@ -247,8 +433,8 @@ public:
 class KMPMatcher {
 private:
   // 计算前缀函数（部分匹配表）
-  static std::vector<int> compute_prefix_function(const std::string &pattern) {
-    int m = pattern.length();
+  static std::vector<int> compute_prefix_function(std::string_view pattern) {
+    int m = static_cast<int>(pattern.length());
     std::vector<int> pi(m, 0);
     int k = 0;
 
@@ -267,20 +453,20 @@ private:
 
 public:
   // KMP字符串匹配
-  static std::vector<int> search(const std::string &text,
-                                 const std::string &pattern) {
-    std::vector<int> matches;
-    int n = text.length();
-    int m = pattern.length();
+  template <typename OnMatch>
+  static void scan(std::string_view text, std::string_view pattern,
+                   OnMatch on_match) {
+    std::size_t n = text.length();
+    int m = static_cast<int>(pattern.length());
 
     if (m == 0) {
-      return matches;
+      return;
     }
 
     auto pi = compute_prefix_function(pattern);
     int q = 0; // 匹配的字符数
 
-    for (int i = 0; i < n; i++) {
+    for (std::size_t i = 0; i < n; i++) {
       while (q > 0 && pattern[q] != text[i]) {
         q = pi[q - 1];
       }
@@ -288,17 +474,21 @@ public:
         q++;
       }
       if (q == m) {
-        matches.push_back(i - m + 1);
+        on_match(i + 1 - m);
         q = pi[q - 1];
       }
     }
+  }
 
-    return matches;
+  static std::vector<int> search(std::string_view text,
+                                 std::string_view pattern) {
+    return string_matching_detail::collect_int_positions(
+        text, [&](auto on_match) { scan(text, pattern, on_match); });
   }
 
   // 显示前缀函数和匹配过程
-  static void search_with_prefix(const std::string &text,
-                                 const std::string &pattern) {
+  static void search_with_prefix(std::string_view text,
+                                 std::string_view pattern) {
     auto matches = search(text, pattern);
 
     std::cout << "文本: " << text << std::endl;
@@ -319,6 +509,389 @@ public:
   }
 };
 
+// Crochemore-Perrin Two-Way算法：O(n+m)时间、O(1)额外空间
+// 以模式的临界分解 x = u v 为界，先从左到右比较右半部分 v，
+// 成功后再从右到左比较左半部分 u；周期模式用"记忆"跳过已知相等的前缀，
+// 因此连续重叠的匹配（如在 a^n 中找 a^m）也是线性的
+class TwoWayMatcher {
+private:
+  // 最大后缀：reverse 为 false 时按字节序，为 true 时按逆序；
+  // 返回后缀起点前一个位置（可能为 -1），period 为该后缀的周期
+  static long maximal_suffix(const unsigned char *x, long m, bool reverse,
+                             long &period) {
+    long ms = -1, j = 0, k = 1;
+    period = 1;
+    while (j + k < m) {
+      unsigned char a = x[j + k], b = x[ms + k];
+      if (a == b) {
+        if (k != period) {
+          k++;
+        } else {
+          j += period;
+          k = 1;
+        }
+      } else if ((a < b) != reverse) {
+        j += k;
+        k = 1;
+        period = j - ms;
+      } else {
+        ms = j;
+        j = ms + 1;
+        k = period = 1;
+      }
+    }
+    return ms;
+  }
+
+public:
+  // 对 text 中 pattern 的每次出现调用 on_match(起始位置)
+  template <typename OnMatch>
+  static void scan(std::string_view text, std::string_view pattern,
+                   OnMatch on_match) {
+    const auto *x = reinterpret_cast<const unsigned char *>(pattern.data());
+    const auto *y = reinterpret_cast<const unsigned char *>(text.data());
+    long m = static_cast<long>(pattern.size());
+    long n = static_cast<long>(text.size());
+    if (m == 0 || n < m) {
+      return;
+    }
+
+    long p, q;
+    long i = maximal_suffix(x, m, false, p);
+    long j = maximal_suffix(x, m, true, q);
+    long ell = i > j ? i : j;
+    long per = i > j ? p : q;
+
+    if (std::memcmp(x, x + per, ell + 1) == 0) {
+      // 周期模式：匹配或右半部分失配后，记住已经相等的前缀长度
+      long memory = -1;
+      for (long s = 0; s <= n - m;) {
+        long k = std::max(ell, memory) + 1;
+        while (k < m && x[k] == y[k + s]) {
+          k++;
+        }
+        if (k >= m) {
+          k = ell;
+          while (k > memory && x[k] == y[k + s]) {
+            k--;
+          }
+          if (k <= memory) {
+            on_match(static_cast<std::size_t>(s));
+          }
+          s += per;
+          memory = m - per - 1;
+        } else {
+          s += k - ell;
+          memory = -1;
+        }
+      }
+    } else {
+      per = std::max(ell + 1, m - ell - 1) + 1;
+      for (long s = 0; s <= n - m;) {
+        long k = ell + 1;
+        while (k < m && x[k] == y[k + s]) {
+          k++;
+        }
+        if (k >= m) {
+          k = ell;
+          while (k >= 0 && x[k] == y[k + s]) {
+            k--;
+          }
+          if (k < 0) {
+            on_match(static_cast<std::size_t>(s));
+          }
+          s += per;
+        } else {
+          s += k - ell;
+        }
+      }
+    }
+  }
+
+  static std::vector<int> search(std::string_view text,
+                                 std::string_view pattern) {
+    return string_matching_detail::collect_int_positions(
+        text, [&](auto on_match) { scan(text, pattern, on_match); });
+  }
+};
+
+// 向量化单模式匹配（首字节 + 最稀有字节过滤）
+// 对每个候选起点 s，同时比较 text[s] 与模式首字节、text[s + r] 与模式中
+// 最稀有的字节（r 为其下标），AVX2 一次处理32个起点，SSE2 一次16个；
+// 两者都相等的起点才用 memcmp 验证。对抗性输入（过滤几乎不起作用、
+// 验证代价远超扫描字节数）下切换到 Two-Way，最坏情况仍为线性。
+class SimdStringMatcher {
+private:
+  // 典型文本（日志、英文、源代码）中字节的常见程度，越靠前越常见；
+  // 不在表中的字节视为最稀有
+  static int byte_rank(unsigned char c) {
+    static const char common[] =
+        " etaoinsrhldcumfpgwybvkxjqzETAOINSRHLDCUMFPGWYBVKXJQZ"
+        "0123456789\n.,:-_/=\"'()[];\t";
+    const char *pos = std::strchr(common, c);
+    return c != 0 && pos != nullptr ? static_cast<int>(pos - common)
+                                    : static_cast<int>(sizeof(common));
+  }
+
+  // 选出除首字节外最稀有字节的下标；和首字节相同的字节过滤效果差，优先避开
+  static std::size_t rare_index(std::string_view pattern) {
+    std::size_t best = pattern.size() - 1;
+    int best_score = -1;
+    for (std::size_t i = 1; i < pattern.size(); i++) {
+      int score = byte_rank(static_cast<unsigned char>(pattern[i])) * 2 +
+                  (pattern[i] != pattern[0]);
+      if (score >= best_score) {
+        best_score = score;
+        best = i;
+      }
+    }
+    return best;
+  }
+
+  // 验证失败的累计代价超过 已扫描字节数 × kBudgetFactor + kBudgetSlack 时
+  // 改用 Two-Way
+  static constexpr std::size_t kBudgetFactor = 4;
+  static constexpr std::size_t kBudgetSlack = 1 << 16;
+
+  struct State {
+    const char *text;
+    std::size_t n;
+    const char *pattern;
+    std::size_t m;
+    std::size_t rare;
+    std::size_t work;
+    std::size_t stop; // 放弃过滤时所在的起点（该起点已验证）
+  };
+
+  // 验证起点 s；返回 false 表示应当放弃过滤、改用 Two-Way
+  template <typename OnMatch>
+  static bool verify(State &st, std::size_t s, OnMatch &on_match) {
+    st.work += st.m;
+    if (std::memcmp(st.text + s + 1, st.pattern + 1, st.m - 1) == 0) {
+      on_match(s);
+    }
+    if (st.work > s * kBudgetFactor + kBudgetSlack) {
+      st.stop = s;
+      return false;
+    }
+    return true;
+  }
+
+  // 处理一组候选掩码（第 k 位对应起点 base + k）
+  template <typename OnMatch>
+  static bool verify_mask(State &st, std::size_t base, unsigned mask,
+                          OnMatch &on_match) {
+    while (mask != 0) {
+      if (!verify(st, base + __builtin_ctz(mask), on_match)) {
+        return false;
+      }
+      mask &= mask - 1;
+    }
+    return true;
+  }
+
+#ifdef ALGORITHMS_GEMM_X86
+  // 以32为步长扫描块起点 s < limit，要求 limit + 31 不超过最后一个起点
+  // （于是 s + rare + 31 < n）；返回第一个未处理的块起点
+  template <typename OnMatch>
+  __attribute__((target("avx2"))) static std::size_t
+  filter_avx2(State &st, std::size_t s, std::size_t limit, bool &gave_up,
+              OnMatch &on_match) {
+    const __m256i first = _mm256_set1_epi8(st.pattern[0]);
+    const __m256i rare = _mm256_set1_epi8(st.pattern[st.rare]);
+    for (; s < limit; s += 32) {
+      __m256i a = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i *>(st.text + s));
+      __m256i b = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i *>(st.text + s + st.rare));
+      unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+          _mm256_and_si256(_mm256_cmpeq_epi8(a, first),
+                           _mm256_cmpeq_epi8(b, rare))));
+      if (mask != 0 && !verify_mask(st, s, mask, on_match)) {
+        gave_up = true;
+        return s;
+      }
+    }
+    return s;
+  }
+
+#if defined(__SSE2__)
+  template <typename OnMatch>
+  static std::size_t filter_sse2(State &st, std::size_t s, std::size_t limit,
+                                 bool &gave_up, OnMatch &on_match) {
+    const __m128i first = _mm_set1_epi8(st.pattern[0]);
+    const __m128i rare = _mm_set1_epi8(st.pattern[st.rare]);
+    for (; s < limit; s += 16) {
+      __m128i a =
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(st.text + s));
+      __m128i b = _mm_loadu_si128(
+          reinterpret_cast<const __m128i *>(st.text + s + st.rare));
+      unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+          _mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, rare))));
+      if (mask != 0 && !verify_mask(st, s, mask, on_match)) {
+        gave_up = true;
+        return s;
+      }
+    }
+    return s;
+  }
+#endif
+#endif
+
+public:
+  // 对 text 中 pattern 的每次出现按位置递增调用 on_match(起始位置)
+  template <typename OnMatch>
+  static void scan(std::string_view text, std::string_view pattern,
+                   OnMatch on_match) {
+    std::size_t n = text.size(), m = pattern.size();
+    if (m == 0 || n < m) {
+      return;
+    }
+    if (m == 1) {
+      const char *begin = text.data(), *end = begin + n;
+      for (const char *p = begin;
+           (p = static_cast<const char *>(std::memchr(p, pattern[0],
+                                                      end - p))) != nullptr;
+           p++) {
+        on_match(static_cast<std::size_t>(p - begin));
+      }
+      return;
+    }
+
+    State st{text.data(), n, pattern.data(), m, rare_index(pattern), 0, 0};
+    std::size_t last = n - m; // 最后一个可能的起点
+    std::size_t s = 0;
+    bool gave_up = false;
+
+#ifdef ALGORITHMS_GEMM_X86
+    // 一个块覆盖 width 个起点，块内最后一个起点不得超过 last；
+    // rare <= m - 1，因此读取 text[s + rare + width - 1] 不会越界
+    if (CpuFeatures::avx2()) {
+      if (last >= 31) {
+        s = filter_avx2(st, s, last - 30, gave_up, on_match);
+      }
+    }
+#if defined(__SSE2__)
+    else if (last >= 15) {
+      s = filter_sse2(st, s, last - 14, gave_up, on_match);
+    }
+#endif
+#endif
+
+    // 尾部（以及无SIMD的平台）：逐个起点比较两个锚点字节
+    const char first = pattern[0], rare = pattern[st.rare];
+    for (; !gave_up && s <= last; s++) {
+      if (st.text[s] == first && st.text[s + st.rare] == rare &&
+          !verify(st, s, on_match)) {
+        gave_up = true;
+      }
+    }
+
+    if (gave_up) {
+      // st.stop 及之前的起点都已处理，Two-Way 从下一个起点开始
+      std::size_t offset = st.stop + 1;
+      if (offset <= last) {
+        TwoWayMatcher::scan(text.substr(offset), pattern,
+                            [&](std::size_t pos) { on_match(offset + pos); });
+      }
+    }
+  }
+
+  static std::vector<int> search(std::string_view text,
+                                 std::string_view pattern) {
+    return string_matching_detail::collect_int_positions(
+        text, [&](auto on_match) { scan(text, pattern, on_match); });
+  }
+
+  // 只统计出现次数（适合GB级日志，不分配结果数组）
+  static std::size_t count(std::string_view text, std::string_view pattern) {
+    std::size_t hits = 0;
+    scan(text, pattern, [&hits](std::size_t) { hits++; });
+    return hits;
+  }
+};
+
+/**
+ * @brief 分块并行的单模式匹配驱动
+ *
+ * 把候选起点 [0, n-m+1) 切成长度为 chunk_size 的块，每块交给调度器的一个
+ * 任务，在 text.substr(块起点, chunk_size + m - 1) 上运行 Matcher::scan。
+ * 相邻块重叠 m-1 字节，跨越块边界的匹配恰好落在前一块中，且每个起点只
+ * 属于一个块，因此结果不重不漏。
+ *
+ * 各块的命中先写入块内缓冲区，再按块的顺序回调 on_match，输出与串行
+ * scan 完全相同（按位置递增）。每轮只处理 4 × 线程数 个块，缓冲区占用与
+ * 文本总长无关，可以扫描远大于内存的 MappedText。
+ *
+ * Matcher 为任一提供 static scan(text, pattern, on_match) 的匹配器，
+ * 例如 KMPMatcher、FiniteAutomatonMatcher、SimdStringMatcher。模式预处理
+ * 在每块重复一次，块应远大于模式（默认 4MB）。
+ */
+template <typename Matcher> class ParallelStringMatcher {
+public:
+  static constexpr std::size_t kDefaultChunkSize = std::size_t(1) << 22;
+
+  template <typename OnMatch>
+  static void scan(WorkStealingScheduler &scheduler, std::string_view text,
+                   std::string_view pattern, OnMatch on_match,
+                   std::size_t chunk_size = kDefaultChunkSize) {
+    std::size_t n = text.size();
+    std::size_t m = pattern.size();
+    if (n < m) {
+      return;
+    }
+    chunk_size = std::max<std::size_t>(chunk_size, 1);
+    std::size_t starts = n - m + 1;
+    std::size_t chunk_count = (starts + chunk_size - 1) / chunk_size;
+    std::size_t wave = 4 * scheduler.get_num_threads();
+
+    std::vector<std::vector<std::size_t>> found(
+        std::min(wave, chunk_count));
+    for (std::size_t first = 0; first < chunk_count; first += wave) {
+      std::size_t last = std::min(first + wave, chunk_count);
+      scheduler.parallel_for(first, last, 1, [&](std::size_t lo,
+                                                 std::size_t hi) {
+        for (std::size_t c = lo; c < hi; c++) {
+          std::size_t begin = c * chunk_size;
+          std::size_t end = std::min(begin + chunk_size, starts);
+          std::vector<std::size_t> &out = found[c - first];
+          out.clear();
+          Matcher::scan(text.substr(begin, end - begin + m - 1), pattern,
+                        [&out, begin](std::size_t pos) {
+                          out.push_back(begin + pos);
+                        });
+        }
+      });
+      for (std::size_t c = first; c < last; c++) {
+        for (std::size_t pos : found[c - first]) {
+          on_match(pos);
+        }
+      }
+    }
+  }
+
+  static std::vector<std::size_t>
+  search(WorkStealingScheduler &scheduler, std::string_view text,
+         std::string_view pattern,
+         std::size_t chunk_size = kDefaultChunkSize) {
+    std::vector<std::size_t> matches;
+    scan(
+        scheduler, text, pattern,
+        [&matches](std::size_t pos) { matches.push_back(pos); }, chunk_size);
+    return matches;
+  }
+
+  static std::size_t count(WorkStealingScheduler &scheduler,
+                           std::string_view text, std::string_view pattern,
+                           std::size_t chunk_size = kDefaultChunkSize) {
+    std::size_t hits = 0;
+    scan(
+        scheduler, text, pattern, [&hits](std::size_t) { hits++; },
+        chunk_size);
+    return hits;
+  }
+};
+
 // 字符串匹配工具类
 class StringMatchingUtils {
 public:
@@ -349,9 +922,18 @@ public:
     auto kmp_matches = KMPMatcher::search(text, pattern);
     std::cout << "KMP算法匹配数: " << kmp_matches.size() << std::endl;
 
+    // Two-Way算法与向量化过滤
+    auto two_way_matches = TwoWayMatcher::search(text, pattern);
+    std::cout << "Two-Way匹配数: " << two_way_matches.size() << std::endl;
+    auto simd_matches = SimdStringMatcher::search(text, pattern);
+    std::cout << "SIMD过滤匹配数: " << simd_matches.size() << std::endl;
+
     // 验证结果一致性
     bool consistent = (naive_matches == rk_matches) &&
-                      (rk_matches == fa_matches) && (fa_matches == kmp_matches);
+                      (rk_matches == fa_matches) &&
+                      (fa_matches == kmp_matches) &&
+                      (kmp_matches == two_way_matches) &&
+                      (two_way_matches == simd_matches);
     std::cout << "算法结果一致性: " << (consistent ? "一致" : "不一致")
               << std::endl;
 
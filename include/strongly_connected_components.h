@@ -0,0 +1,213 @@
+#ifndef STRONGLY_CONNECTED_COMPONENTS_H
+#define STRONGLY_CONNECTED_COMPONENTS_H
+
+#include "graph_representation.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+
+/**
+ * @brief 强连通分量划分（按节点下标）
+ *
+ * component[v] 为 v 所在分量的编号，编号取值 0..count-1。
+ * 两种算法给出的编号都是分量图（缩点后的DAG）的一个拓扑序：
+ * 若分量图中有边 C_i → C_j，则 i < j。
+ */
+struct SCCResult {
+  std::vector<int> component;
+  int count;
+
+  SCCResult(size_t n) : component(n, -1), count(0) {}
+
+  // 每个分量包含的节点下标
+  std::vector<std::vector<int>> members() const {
+    std::vector<std::vector<int>> groups(count);
+    for (size_t v = 0; v < component.size(); v++) {
+      groups[component[v]].push_back(static_cast<int>(v));
+    }
+    return groups;
+  }
+};
+
+/**
+ * @brief 强连通分量（算法导论22.5节）
+ *
+ * - Kosaraju：第一遍DFS求完成时间，第二遍在转置图上按完成时间递减的顺序
+ *   DFS，每棵DFS树就是一个强连通分量（算法导论 STRONGLY-CONNECTED-COMPONENTS）。
+ * - Tarjan：一遍DFS，用 low-link 识别分量的根，不需要转置图。
+ *
+ * 两者都用显式栈实现，递归深度不受图的直径限制，几百万个节点的长链也不会
+ * 栈溢出。时间 O(V + E)。Graph 需满足 graph_representation.h 中的图概念。
+ */
+class StronglyConnectedComponents {
+public:
+  template <typename Graph> static SCCResult kosaraju(const Graph &graph) {
+    require_directed(graph);
+    size_t n = graph.get_node_count();
+    SCCResult result(n);
+
+    // 第一遍：按完成时间记录节点
+    IndexedAdjacency forward(graph);
+    std::vector<int> finish_order;
+    finish_order.reserve(n);
+    std::vector<char> visited(n, 0);
+    std::vector<std::pair<int, size_t>> frames;
+    for (size_t root = 0; root < n; root++) {
+      if (visited[root]) {
+        continue;
+      }
+      visited[root] = 1;
+      frames.emplace_back(static_cast<int>(root), forward.offsets[root]);
+      while (!frames.empty()) {
+        auto &[u, edge] = frames.back();
+        if (edge == forward.offsets[u + 1]) {
+          finish_order.push_back(u);
+          frames.pop_back();
+          continue;
+        }
+        int v = forward.targets[edge++];
+        if (!visited[v]) {
+          visited[v] = 1;
+          frames.emplace_back(v, forward.offsets[v]);
+        }
+      }
+    }
+
+    // 第二遍：转置图上按完成时间递减的顺序，每次搜索得到一个分量
+    IndexedAdjacency backward(graph, true);
+    std::vector<int> stack;
+    for (auto it = finish_order.rbegin(); it != finish_order.rend(); ++it) {
+      if (result.component[*it] != -1) {
+        continue;
+      }
+      int label = result.count++;
+      result.component[*it] = label;
+      stack.push_back(*it);
+      while (!stack.empty()) {
+        int u = stack.back();
+        stack.pop_back();
+        for (size_t e = backward.offsets[u]; e < backward.offsets[u + 1];
+             e++) {
+          int v = backward.targets[e];
+          if (result.component[v] == -1) {
+            result.component[v] = label;
+            stack.push_back(v);
+          }
+        }
+      }
+    }
+    return result;
+  }
+
+  template <typename Graph> static SCCResult tarjan(const Graph &graph) {
+    require_directed(graph);
+    size_t n = graph.get_node_count();
+    SCCResult result(n);
+    IndexedAdjacency adjacency(graph);
+
+    // index[v] 为发现次序（-1 表示未访问），low[v] 为能回到的最小发现次序
+    std::vector<int> index(n, -1), low(n, 0);
+    std::vector<char> on_stack(n, 0);
+    std::vector<int> component_stack;
+    std::vector<std::pair<int, size_t>> frames;
+    int next_index = 0;
+
+    for (size_t root = 0; root < n; root++) {
+      if (index[root] != -1) {
+        continue;
+      }
+      discover(static_cast<int>(root), adjacency, index, low, on_stack,
+               component_stack, frames, next_index);
+      while (!frames.empty()) {
+        auto &[u, edge] = frames.back();
+        if (edge < adjacency.offsets[u + 1]) {
+          int v = adjacency.targets[edge++];
+          if (index[v] == -1) {
+            discover(v, adjacency, index, low, on_stack, component_stack,
+                     frames, next_index);
+          } else if (on_stack[v]) {
+            low[u] = std::min(low[u], index[v]);
+          }
+          continue;
+        }
+
+        // u 的出边都已处理：若 u 是分量的根，弹出整个分量
+        int finished = u;
+        frames.pop_back();
+        if (low[finished] == index[finished]) {
+          int label = result.count++;
+          int v;
+          do {
+            v = component_stack.back();
+            component_stack.pop_back();
+            on_stack[v] = 0;
+            result.component[v] = label;
+          } while (v != finished);
+        }
+        if (!frames.empty()) {
+          int parent = frames.back().first;
+          low[parent] = std::min(low[parent], low[finished]);
+        }
+      }
+    }
+
+    // Tarjan 按分量图的逆拓扑序产生分量，翻转编号使两种算法约定一致
+    for (int &label : result.component) {
+      label = result.count - 1 - label;
+    }
+    return result;
+  }
+
+  /**
+   * @brief 分量图（算法导论22.5节的 G^SCC）：分量 i 的节点编号为 i，
+   *        去掉分量内部的边并合并平行边，权重取1
+   */
+  template <typename Graph>
+  static CSRGraph component_graph(const Graph &graph, const SCCResult &scc) {
+    std::vector<std::pair<int, int>> edges;
+    for (size_t u = 0; u < graph.get_node_count(); u++) {
+      graph.for_each_out_edge(u, [&](int v, int) {
+        if (scc.component[u] != scc.component[v]) {
+          edges.emplace_back(scc.component[u], scc.component[v]);
+        }
+      });
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    CSRGraphBuilder builder(true);
+    for (int c = 0; c < scc.count; c++) {
+      builder.add_node(c);
+    }
+    for (const auto &[from, to] : edges) {
+      builder.add_edge(from, to);
+    }
+    return builder.build();
+  }
+
+private:
+  template <typename Graph> static void require_directed(const Graph &graph) {
+    if (!graph.is_directed()) {
+      throw std::invalid_argument("强连通分量需要应用于有向图");
+    }
+  }
+
+  static void discover(int v, const IndexedAdjacency &adjacency,
+                       std::vector<int> &index, std::vector<int> &low,
+                       std::vector<char> &on_stack,
+                       std::vector<int> &component_stack,
+                       std::vector<std::pair<int, size_t>> &frames,
+                       int &next_index) {
+    index[v] = low[v] = next_index++;
+    on_stack[v] = 1;
+    component_stack.push_back(v);
+    frames.emplace_back(v, adjacency.offsets[v]);
+  }
+};
+
+} // namespace algorithms
+
+#endif // STRONGLY_CONNECTED_COMPONENTS_H
@@ -0,0 +1,446 @@
+#ifndef SUFFIX_ARRAY_H
+#define SUFFIX_ARRAY_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+
+/**
+ * @brief 后缀数组与LCP数组构成的静态子串索引（算法导论第4版32.5节）
+ *
+ * 32.1~32.4节的匹配器每次查询都要扫描整段文本；对固定语料建立后缀数组后，
+ * 模式 P 的所有出现对应后缀数组中的一个连续区间，二分查找即可得到，
+ * 每次查询 O(m lg n)，与命中数无关。
+ * - 构造：SA-IS（Nong、Zhang、Chan）诱导排序，O(n) 时间，递归处理LMS子串
+ * - LCP：Kasai算法，lcp[i] 为 sa[i-1] 与 sa[i] 两个后缀的最长公共前缀，lcp[0] = 0
+ * - 存储：文本、后缀数组与LCP数组放在一块由64位字组成的扁平缓冲区中，
+ *   可以直接写入文件，查询服务启动时mmap后用load零拷贝加载
+ *   （要求8字节对齐，按小端序存储；MappedText 的映射起点满足要求）
+ *
+ * 文本长度上限为 2^31 - 2 字节，后缀数组与LCP数组各占 4n 字节。
+ */
+class SuffixArray {
+public:
+  SuffixArray() = default;
+
+  SuffixArray(const SuffixArray &other)
+      : storage(other.storage), base(other.base), word_count(other.word_count) {
+    if (!storage.empty()) {
+      base = storage.data();
+    }
+    bind();
+  }
+
+  SuffixArray(SuffixArray &&other) noexcept
+      : storage(std::move(other.storage)), base(other.base),
+        word_count(other.word_count) {
+    if (!storage.empty()) {
+      base = storage.data();
+    }
+    bind();
+  }
+
+  SuffixArray &operator=(SuffixArray other) {
+    storage = std::move(other.storage);
+    base = storage.empty() ? other.base : storage.data();
+    word_count = other.word_count;
+    bind();
+    return *this;
+  }
+
+  /**
+   * @brief 为文本构建后缀数组与LCP数组（文本被复制进索引缓冲区）
+   * @throws std::length_error 文本超过 2^31 - 2 字节
+   */
+  static SuffixArray build(std::string_view text) {
+    if (text.size() >= static_cast<std::size_t>(INT32_MAX)) {
+      throw std::length_error("后缀数组文本过长");
+    }
+    std::size_t n = text.size();
+
+    std::vector<int> s(n);
+    for (std::size_t i = 0; i < n; i++) {
+      s[i] = static_cast<unsigned char>(text[i]);
+    }
+    std::vector<int> sa = sa_is(s, 255);
+
+    SuffixArray result;
+    std::size_t text_words = (n + 7) / 8;
+    std::size_t array_words = (n + 1) / 2;
+    result.word_count = kHeaderWords + text_words + 2 * array_words;
+    result.storage.assign(result.word_count, 0);
+    std::uint64_t *words = result.storage.data();
+    words[0] = kMagic;
+    words[1] = kVersion;
+    words[2] = n;
+    words[3] = result.word_count;
+    if (n > 0) {
+      std::memcpy(words + kHeaderWords, text.data(), n);
+    }
+    auto *out_sa = reinterpret_cast<std::uint32_t *>(words + kHeaderWords +
+                                                     text_words);
+    auto *out_lcp = out_sa + 2 * array_words;
+    for (std::size_t i = 0; i < n; i++) {
+      out_sa[i] = static_cast<std::uint32_t>(sa[i]);
+    }
+    kasai(text, out_sa, out_lcp);
+
+    result.base = result.storage.data();
+    result.bind();
+    return result;
+  }
+
+  /**
+   * @brief 从扁平缓冲区零拷贝加载（例如mmap得到的内存）
+   * @param data 8字节对齐的缓冲区，必须在返回对象的生命周期内保持有效
+   * @throws std::invalid_argument 头部不符，或SA不是 [0, n) 的排列，
+   *         或LCP超过相邻两个后缀中较短者的长度（检查需要 O(n) 时间）
+   */
+  static SuffixArray load(const void *data, std::size_t size_bytes) {
+    if (reinterpret_cast<std::uintptr_t>(data) % alignof(std::uint64_t) != 0) {
+      throw std::invalid_argument("后缀数组缓冲区必须8字节对齐");
+    }
+    const auto *words = static_cast<const std::uint64_t *>(data);
+    std::size_t count = size_bytes / sizeof(std::uint64_t);
+    // 文本长度先限制在缓冲区字节数以内，下面的字数计算才不会回绕
+    if (count < kHeaderWords || words[0] != kMagic || words[1] != kVersion ||
+        words[3] != count || words[2] > count * sizeof(std::uint64_t) ||
+        count != kHeaderWords + (words[2] + 7) / 8 + 2 * ((words[2] + 1) / 2)) {
+      throw std::invalid_argument("不是有效的后缀数组缓冲区");
+    }
+    SuffixArray result;
+    result.base = words;
+    result.word_count = count;
+    result.bind();
+    result.validate();
+    return result;
+  }
+
+  void save(std::ostream &out) const {
+    out.write(reinterpret_cast<const char *>(base),
+              static_cast<std::streamsize>(size_bytes()));
+  }
+
+  const void *data() const { return base; }
+  std::size_t size_bytes() const { return word_count * sizeof(std::uint64_t); }
+
+  // 文本长度，即后缀个数
+  std::size_t size() const { return length; }
+  std::string_view text() const { return std::string_view(chars, length); }
+
+  // 字典序第 i 小的后缀的起始位置
+  std::uint32_t suffix(std::size_t i) const { return sa[i]; }
+  // suffix(i-1) 与 suffix(i) 的最长公共前缀长度，lcp(0) = 0
+  std::uint32_t lcp(std::size_t i) const { return lcps[i]; }
+
+  /**
+   * @brief 以 pattern 为前缀的后缀在后缀数组中的区间 [first, second)
+   *
+   * 两次二分查找，每次比较至多 m 个字节，O(m lg n)。空模式匹配所有后缀。
+   */
+  std::pair<std::size_t, std::size_t> equal_range(std::string_view pattern) const {
+    std::size_t lo = 0, hi = length;
+    while (lo < hi) {
+      std::size_t mid = lo + (hi - lo) / 2;
+      if (compare_prefix(sa[mid], pattern) < 0) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    std::size_t first = lo;
+    hi = length;
+    while (lo < hi) {
+      std::size_t mid = lo + (hi - lo) / 2;
+      if (compare_prefix(sa[mid], pattern) <= 0) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return {first, lo};
+  }
+
+  std::size_t count(std::string_view pattern) const {
+    auto range = equal_range(pattern);
+    return range.second - range.first;
+  }
+
+  bool contains(std::string_view pattern) const { return count(pattern) > 0; }
+
+  /**
+   * @brief 模式的所有出现位置，按位置递增排列（与 KMPMatcher::search 相同）
+   */
+  std::vector<std::size_t> locate(std::string_view pattern) const {
+    auto range = equal_range(pattern);
+    std::vector<std::size_t> positions(sa + range.first, sa + range.second);
+    std::sort(positions.begin(), positions.end());
+    return positions;
+  }
+
+  /**
+   * @brief 至少出现两次的最长子串（LCP数组的最大值），文本中没有重复时为空
+   */
+  std::string_view longest_repeated_substring() const {
+    std::size_t best = 0;
+    for (std::size_t i = 1; i < length; i++) {
+      if (lcps[i] > lcps[best]) {
+        best = i;
+      }
+    }
+    if (length == 0 || lcps[best] == 0) {
+      return std::string_view();
+    }
+    return text().substr(sa[best], lcps[best]);
+  }
+
+  /**
+   * @brief SA-IS：对值域为 [0, upper] 的整数串计算后缀数组
+   *
+   * 后缀按类型分为S型（小于后一个后缀）和L型；LMS位置（L型之后的S型）
+   * 把串切成LMS子串。先把LMS位置放到各自桶尾，诱导排序L型、S型后缀，
+   * 得到LMS子串的顺序；若有相同的LMS子串，以其名字组成的缩减串递归求解，
+   * 再用LMS后缀的真实顺序做一次诱导排序。
+   */
+  static std::vector<int> sa_is(const std::vector<int> &s, int upper) {
+    int n = static_cast<int>(s.size());
+    if (n == 0) {
+      return {};
+    }
+    if (n == 1) {
+      return {0};
+    }
+    if (n < kNaiveThreshold) {
+      return sa_naive(s);
+    }
+
+    std::vector<int> sa(n);
+    std::vector<std::uint8_t> ls(n, 0); // 1 表示S型
+    for (int i = n - 2; i >= 0; i--) {
+      ls[i] = s[i] == s[i + 1] ? ls[i + 1] : s[i] < s[i + 1];
+    }
+
+    // sum_l[c]：字符 c 的桶起点；sum_s[c]：桶中S型部分的起点
+    std::vector<int> sum_l(upper + 2, 0), sum_s(upper + 2, 0);
+    for (int i = 0; i < n; i++) {
+      if (!ls[i]) {
+        sum_s[s[i]]++;
+      } else {
+        sum_l[s[i] + 1]++;
+      }
+    }
+    for (int c = 0; c <= upper; c++) {
+      sum_s[c] += sum_l[c];
+      if (c < upper) {
+        sum_l[c + 1] += sum_s[c];
+      }
+    }
+
+    auto induce = [&](const std::vector<int> &lms) {
+      std::fill(sa.begin(), sa.end(), -1);
+      std::vector<int> bucket(upper + 2);
+      std::copy(sum_s.begin(), sum_s.end(), bucket.begin());
+      for (int d : lms) {
+        if (d != n) {
+          sa[bucket[s[d]]++] = d;
+        }
+      }
+      // L型：从左到右，放到桶头
+      std::copy(sum_l.begin(), sum_l.end(), bucket.begin());
+      sa[bucket[s[n - 1]]++] = n - 1;
+      for (int i = 0; i < n; i++) {
+        int v = sa[i];
+        if (v >= 1 && !ls[v - 1]) {
+          sa[bucket[s[v - 1]]++] = v - 1;
+        }
+      }
+      // S型：从右到左，放到桶尾
+      std::copy(sum_l.begin(), sum_l.end(), bucket.begin());
+      for (int i = n - 1; i >= 0; i--) {
+        int v = sa[i];
+        if (v >= 1 && ls[v - 1]) {
+          sa[--bucket[s[v - 1] + 1]] = v - 1;
+        }
+      }
+    };
+
+    std::vector<int> lms_index(n + 1, -1);
+    std::vector<int> lms;
+    for (int i = 1; i < n; i++) {
+      if (!ls[i - 1] && ls[i]) {
+        lms_index[i] = static_cast<int>(lms.size());
+        lms.push_back(i);
+      }
+    }
+    int m = static_cast<int>(lms.size());
+
+    induce(lms);
+
+    if (m > 0) {
+      std::vector<int> sorted_lms;
+      sorted_lms.reserve(m);
+      for (int v : sa) {
+        if (lms_index[v] != -1) {
+          sorted_lms.push_back(v);
+        }
+      }
+
+      // 为LMS子串命名：与前一个相同的子串沿用同一个名字
+      std::vector<int> reduced(m);
+      int name = 0;
+      reduced[lms_index[sorted_lms[0]]] = 0;
+      for (int i = 1; i < m; i++) {
+        int l = sorted_lms[i - 1], r = sorted_lms[i];
+        int end_l = lms_index[l] + 1 < m ? lms[lms_index[l] + 1] : n;
+        int end_r = lms_index[r] + 1 < m ? lms[lms_index[r] + 1] : n;
+        bool same = true;
+        if (end_l - l != end_r - r) {
+          same = false;
+        } else {
+          while (l < end_l && s[l] == s[r]) {
+            l++;
+            r++;
+          }
+          if (l == n || s[l] != s[r]) {
+            same = false;
+          }
+        }
+        if (!same) {
+          name++;
+        }
+        reduced[lms_index[sorted_lms[i]]] = name;
+      }
+
+      std::vector<int> reduced_sa = sa_is(reduced, name);
+      for (int i = 0; i < m; i++) {
+        sorted_lms[i] = lms[reduced_sa[i]];
+      }
+      induce(sorted_lms);
+    }
+    return sa;
+  }
+
+private:
+  static constexpr std::uint64_t kMagic = 0x3158444958464653ULL; // "SFFXIDX1"
+  static constexpr std::uint64_t kVersion = 1;
+  static constexpr int kNaiveThreshold = 10;
+
+  // 头部：magic, version, text_length, total_words
+  static constexpr std::size_t kHeaderWords = 4;
+
+  std::vector<std::uint64_t> storage; // 构建得到的缓冲区；load得到的对象不拥有内存
+  const std::uint64_t *base = nullptr;
+  std::size_t word_count = 0;
+
+  // 从缓冲区解析出的字段
+  std::size_t length = 0;
+  const char *chars = nullptr;
+  const std::uint32_t *sa = nullptr;
+  const std::uint32_t *lcps = nullptr;
+
+  void bind() {
+    if (base == nullptr) {
+      length = 0;
+      chars = nullptr;
+      sa = lcps = nullptr;
+      return;
+    }
+    length = base[2];
+    std::size_t text_words = (length + 7) / 8;
+    std::size_t array_words = (length + 1) / 2;
+    chars = reinterpret_cast<const char *>(base + kHeaderWords);
+    sa = reinterpret_cast<const std::uint32_t *>(base + kHeaderWords +
+                                                 text_words);
+    lcps = sa + 2 * array_words;
+  }
+
+  // 查询直接用SA的值作为文本下标、用LCP作为比较长度，损坏的文件不能被接受
+  void validate() const {
+    std::vector<bool> seen(length, false);
+    for (std::size_t i = 0; i < length; i++) {
+      std::uint32_t pos = sa[i];
+      if (pos >= length || seen[pos]) {
+        throw std::invalid_argument("后缀数组不是 [0, n) 的排列");
+      }
+      seen[pos] = true;
+      std::size_t limit = i == 0 ? 0 : length - std::max<std::size_t>(pos, sa[i - 1]);
+      if (lcps[i] > limit) {
+        throw std::invalid_argument("LCP数组的值超出相邻后缀的长度");
+      }
+    }
+  }
+
+  // 后缀 pos 的前 m 个字节与 pattern 比较：<0 小于，0 以 pattern 为前缀，>0 大于
+  int compare_prefix(std::size_t pos, std::string_view pattern) const {
+    std::size_t available = length - pos;
+    std::size_t k = std::min(available, pattern.size());
+    int c = k == 0 ? 0 : std::memcmp(chars + pos, pattern.data(), k);
+    if (c != 0) {
+      return c;
+    }
+    return k < pattern.size() ? -1 : 0;
+  }
+
+  static std::vector<int> sa_naive(const std::vector<int> &s) {
+    int n = static_cast<int>(s.size());
+    std::vector<int> sa(n);
+    for (int i = 0; i < n; i++) {
+      sa[i] = i;
+    }
+    std::sort(sa.begin(), sa.end(), [&s, n](int a, int b) {
+      if (a == b) {
+        return false;
+      }
+      while (a < n && b < n) {
+        if (s[a] != s[b]) {
+          return s[a] < s[b];
+        }
+        a++;
+        b++;
+      }
+      return a == n;
+    });
+    return sa;
+  }
+
+  // Kasai：按文本顺序处理后缀，相邻排名的LCP每步至多减1，总计 O(n)
+  static void kasai(std::string_view text, const std::uint32_t *sa,
+                    std::uint32_t *lcp) {
+    std::size_t n = text.size();
+    std::vector<std::uint32_t> rank(n);
+    for (std::size_t i = 0; i < n; i++) {
+      rank[sa[i]] = static_cast<std::uint32_t>(i);
+    }
+    if (n > 0) {
+      lcp[0] = 0;
+    }
+    std::size_t h = 0;
+    for (std::size_t i = 0; i < n; i++) {
+      if (rank[i] == 0) {
+        h = 0;
+        continue;
+      }
+      std::size_t j = sa[rank[i] - 1];
+      while (i + h < n && j + h < n && text[i + h] == text[j + h]) {
+        h++;
+      }
+      lcp[rank[i]] = static_cast<std::uint32_t>(h);
+      if (h > 0) {
+        h--;
+      }
+    }
+  }
+};
+
+} // namespace algorithms
+
+#endif // SUFFIX_ARRAY_H
@@ -3,53 +3,73 @@
 
 #include "graph_representation.h"
 #include <algorithm>
+#include <functional>
 #include <iostream>
 #include <list>
-#include <stack>
+#include <queue>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace algorithms {
 
 // 拓扑排序类
-class TopologicalSort {
+// Graph 需满足 graph_representation.h 中的图概念（AdjacencyListGraph、CSRGraph）
+template <typename Graph = AdjacencyListGraph> class TopologicalSort {
 private:
-  const AdjacencyListGraph &graph;
+  const Graph &graph;
 
 public:
-  TopologicalSort(const AdjacencyListGraph &g) : graph(g) {
+  TopologicalSort(const Graph &g) : graph(g) {
     if (!graph.is_directed()) {
       throw std::invalid_argument("拓扑排序需要应用于有向图");
     }
   }
 
   // 使用DFS进行拓扑排序（算法导论22.4节方法）
+  // 显式栈代替递归，链状的深图也不会栈溢出；结果与递归版本完全相同
   std::vector<int> topological_sort_dfs() {
     size_t node_count = graph.get_node_count();
     if (node_count == 0) {
       return {};
     }
 
-    std::vector<bool> visited(node_count, false);
-    std::vector<bool> on_stack(node_count, false); // 用于检测环
-    std::stack<int> result_stack;
+    IndexedAdjacency adjacency(graph);
+    // 0：未访问，1：在DFS栈上（用于检测环），2：已完成
+    std::vector<char> state(node_count, 0);
+    // 栈帧：节点下标与下一条待访问出边的位置
+    std::vector<std::pair<int, size_t>> frames;
+    std::vector<int> result(node_count);
+    size_t next_slot = node_count; // 按完成时间从后往前填
 
     // 对每个未访问的节点进行DFS
-    for (size_t i = 0; i < node_count; i++) {
-      if (!visited[i]) {
-        if (!dfs_visit(i, visited, on_stack, result_stack)) {
+    for (size_t root = 0; root < node_count; root++) {
+      if (state[root] != 0) {
+        continue;
+      }
+      state[root] = 1;
+      frames.emplace_back(static_cast<int>(root), adjacency.offsets[root]);
+      while (!frames.empty()) {
+        auto &[node_index, edge] = frames.back();
+        if (edge == adjacency.offsets[node_index + 1]) {
+          state[node_index] = 2;
+          result[--next_slot] = graph.get_node_id(node_index);
+          frames.pop_back();
+          continue;
+        }
+        int neighbor_index = adjacency.targets[edge++];
+        if (state[neighbor_index] == 1) {
+          // 检测到后向边，存在环
           throw std::runtime_error("图包含环，无法进行拓扑排序");
         }
+        if (state[neighbor_index] == 0) {
+          state[neighbor_index] = 1;
+          frames.emplace_back(neighbor_index,
+                              adjacency.offsets[neighbor_index]);
+        }
       }
     }
 
-    // 将栈中的结果转换为向量（逆序）
-    std::vector<int> result;
-    while (!result_stack.empty()) {
-      result.push_back(result_stack.top());
-      result_stack.pop();
-    }
-
     return result;
   }
 
@@ -63,10 +83,8 @@ public:
     // 计算每个节点的入度
     std::vector<int> in_degree(node_count, 0);
     for (size_t i = 0; i < node_count; i++) {
-      auto neighbors = graph.get_neighbors(i + 1); // 节点ID从1开始
-      for (int neighbor : neighbors) {
-        in_degree[neighbor - 1]++; // 节点ID从1开始
-      }
+      graph.for_each_out_edge(
+          i, [&](int neighbor_index, int) { in_degree[neighbor_index]++; });
     }
 
     // 初始化队列（入度为0的节点）
@@ -84,17 +102,16 @@ public:
     while (!zero_in_degree.empty()) {
       int current = zero_in_degree.front();
       zero_in_degree.pop();
-      result.push_back(current + 1); // 节点ID从1开始
+      result.push_back(graph.get_node_id(current));
       visited_count++;
 
       // 减少邻居的入度
-      auto neighbors = graph.get_neighbors(current + 1);
-      for (int neighbor : neighbors) {
-        in_degree[neighbor - 1]--;
-        if (in_degree[neighbor - 1] == 0) {
-          zero_in_degree.push(neighbor - 1);
+      graph.for_each_out_edge(current, [&](int neighbor_index, int) {
+        in_degree[neighbor_index]--;
+        if (in_degree[neighbor_index] == 0) {
+          zero_in_degree.push(neighbor_index);
         }
-      }
+      });
     }
 
     // 检查是否存在环
@@ -126,31 +143,280 @@ public:
     }
     std::cout << std::endl;
   }
+};
+
+/**
+ * @brief 动态DAG的在线拓扑序（Pearce–Kelly算法）
+ *
+ * 维护节点到位置的双射 position，始终满足：每条边 u → v 都有
+ * position[u] < position[v]。插入边 u → v 时：
+ * - 若已满足 position[u] < position[v]，只记录边，O(1)；
+ * - 否则只需调整位置落在 [position[v], position[u]] 内的节点（受影响区域）：
+ *   从 v 正向搜索位置不超过 position[u] 的节点（搜到 u 说明成环，拒绝插入），
+ *   从 u 反向搜索位置不小于 position[v] 的节点，再把两组节点按原来的相对
+ *   次序放回它们占用的位置，反向集合在前。
+ * 代价只与受影响区域的节点数和边数成正比，而不是整张图，
+ * 在逐条插入的场景下远快于每次从头运行Kahn算法。
+ *
+ * 批量插入 add_edges 是原子的：整批边加入后仍然无环才接受，否则一条也不加
+ * （拓扑序可能已经调整过，但仍然合法）。
+ * 批量较大时直接在全图上运行一次Kahn算法（以当前顺序作为初始顺序），
+ * 避免逐条插入时受影响区域被反复移动。
+ *
+ * 节点用下标 0..n-1 表示，允许平行边，不允许自环。
+ */
+class DynamicTopologicalOrder {
+public:
+  // 批量插入的边数达到 (节点数 + 边数) / kBatchRebuildDivisor 时整体重排
+  static constexpr size_t kBatchRebuildDivisor = 16;
+
+  explicit DynamicTopologicalOrder(size_t node_count = 0) {
+    for (size_t i = 0; i < node_count; i++) {
+      add_node();
+    }
+  }
+
+  // 从满足图概念的有向图初始化，节点下标与原图一致
+  template <typename Graph>
+  static DynamicTopologicalOrder from_graph(const Graph &graph) {
+    if (!graph.is_directed()) {
+      throw std::invalid_argument("拓扑排序需要应用于有向图");
+    }
+    DynamicTopologicalOrder order(graph.get_node_count());
+    std::vector<std::pair<int, int>> edges;
+    for (size_t u = 0; u < graph.get_node_count(); u++) {
+      graph.for_each_out_edge(u, [&](int v, int) {
+        edges.emplace_back(static_cast<int>(u), v);
+      });
+    }
+    if (!order.add_edges(edges)) {
+      throw std::runtime_error("图包含环，无法进行拓扑排序");
+    }
+    return order;
+  }
+
+  // 新节点排在末尾，返回它的下标
+  int add_node() {
+    int v = static_cast<int>(out.size());
+    out.emplace_back();
+    in.emplace_back();
+    position.push_back(v);
+    node_at.push_back(v);
+    mark.push_back(0);
+    return v;
+  }
+
+  /**
+   * @brief 插入边 u → v
+   * @return 插入后仍无环时返回true；会形成环时返回false，图保持不变
+   */
+  bool add_edge(int u, int v) {
+    check_node(u);
+    check_node(v);
+    if (u == v) {
+      return false;
+    }
+    if (position[u] > position[v] && !reorder(u, v)) {
+      return false;
+    }
+    out[u].push_back(v);
+    in[v].push_back(u);
+    edge_count++;
+    return true;
+  }
+
+  /**
+   * @brief 原子地插入一批边：全部插入后无环才接受，否则图保持不变
+   */
+  bool add_edges(const std::vector<std::pair<int, int>> &edges) {
+    for (const auto &[u, v] : edges) {
+      check_node(u);
+      check_node(v);
+    }
+    if (edges.size() * kBatchRebuildDivisor >= node_count() + edge_count) {
+      return add_edges_by_rebuild(edges);
+    }
+    for (size_t k = 0; k < edges.size(); k++) {
+      if (!add_edge(edges[k].first, edges[k].second)) {
+        // 删除边不会破坏拓扑序，撤销已插入的部分即可
+        for (size_t j = k; j-- > 0;) {
+          remove_edge(edges[j].first, edges[j].second);
+        }
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // 删除一条边 u → v（存在平行边时只删一条），边不存在时返回false
+  bool remove_edge(int u, int v) {
+    check_node(u);
+    check_node(v);
+    if (!erase_one(out[u], v)) {
+      return false;
+    }
+    erase_one(in[v], u);
+    edge_count--;
+    return true;
+  }
+
+  size_t node_count() const { return out.size(); }
+  size_t get_edge_count() const { return edge_count; }
+
+  // 当前拓扑序中的位置；position(u) < position(v) 不代表 u 能到达 v
+  int get_position(int v) const { return position[v]; }
+
+  // 当前的拓扑序（节点下标）
+  const std::vector<int> &order() const { return node_at; }
+
+  const std::vector<int> &get_out_neighbors(int u) const { return out[u]; }
 
 private:
-  // DFS辅助函数（返回false表示检测到环）
-  bool dfs_visit(int node_index, std::vector<bool> &visited,
-                 std::vector<bool> &on_stack, std::stack<int> &result_stack) {
-    visited[node_index] = true;
-    on_stack[node_index] = true;
-
-    // 递归访问所有邻居
-    auto neighbors = graph.get_neighbors(node_index + 1); // 节点ID从1开始
-    for (int neighbor : neighbors) {
-      int neighbor_index = neighbor - 1; // 节点ID从1开始
-
-      if (!visited[neighbor_index]) {
-        if (!dfs_visit(neighbor_index, visited, on_stack, result_stack)) {
+  std::vector<std::vector<int>> out, in;
+  std::vector<int> position; // 节点 -> 位置
+  std::vector<int> node_at;  // 位置 -> 节点
+  std::vector<unsigned> mark;
+  unsigned epoch = 0;
+  size_t edge_count = 0;
+
+  // 搜索与重排用的临时数组，在多次插入之间复用
+  std::vector<int> forward, backward, stack, positions;
+
+  void check_node(int v) const {
+    if (v < 0 || static_cast<size_t>(v) >= out.size()) {
+      throw std::out_of_range("节点下标越界");
+    }
+  }
+
+  static bool erase_one(std::vector<int> &list, int value) {
+    for (size_t k = 0; k < list.size(); k++) {
+      if (list[k] == value) {
+        list[k] = list.back();
+        list.pop_back();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void next_epoch() {
+    if (++epoch == 0) {
+      std::fill(mark.begin(), mark.end(), 0);
+      epoch = 1;
+    }
+  }
+
+  // 处理 position[u] > position[v] 的插入，成环时返回false且不修改顺序
+  bool reorder(int u, int v) {
+    int lower = position[v], upper = position[u];
+    next_epoch();
+
+    // 正向：从 v 出发，只走位置不超过 upper 的节点
+    forward.clear();
+    stack.assign(1, v);
+    mark[v] = epoch;
+    while (!stack.empty()) {
+      int x = stack.back();
+      stack.pop_back();
+      forward.push_back(x);
+      for (int y : out[x]) {
+        if (y == u) {
           return false;
         }
-      } else if (on_stack[neighbor_index]) {
-        // 检测到后向边，存在环
-        return false;
+        if (mark[y] != epoch && position[y] < upper) {
+          mark[y] = epoch;
+          stack.push_back(y);
+        }
+      }
+    }
+
+    // 反向：从 u 出发，只走位置不小于 lower 的节点（与正向集合不相交）
+    backward.clear();
+    stack.assign(1, u);
+    mark[u] = epoch;
+    while (!stack.empty()) {
+      int x = stack.back();
+      stack.pop_back();
+      backward.push_back(x);
+      for (int y : in[x]) {
+        if (mark[y] != epoch && position[y] > lower) {
+          mark[y] = epoch;
+          stack.push_back(y);
+        }
+      }
+    }
+
+    // 两组节点各自保持原来的相对次序，反向集合占用较小的那些位置
+    auto by_position = [this](int a, int b) {
+      return position[a] < position[b];
+    };
+    std::sort(forward.begin(), forward.end(), by_position);
+    std::sort(backward.begin(), backward.end(), by_position);
+    positions.clear();
+    for (int x : backward) {
+      positions.push_back(position[x]);
+    }
+    for (int x : forward) {
+      positions.push_back(position[x]);
+    }
+    std::sort(positions.begin(), positions.end());
+    size_t slot = 0;
+    for (int x : backward) {
+      place(x, positions[slot++]);
+    }
+    for (int x : forward) {
+      place(x, positions[slot++]);
+    }
+    return true;
+  }
+
+  void place(int v, int slot) {
+    position[v] = slot;
+    node_at[slot] = v;
+  }
+
+  // 把整批边加入后在全图上运行Kahn算法，入度为零的节点按当前位置依次处理
+  bool add_edges_by_rebuild(const std::vector<std::pair<int, int>> &edges) {
+    size_t n = node_count();
+    for (const auto &[u, v] : edges) {
+      out[u].push_back(v);
+      in[v].push_back(u);
+    }
+    std::vector<int> in_degree(n);
+    for (size_t v = 0; v < n; v++) {
+      in_degree[v] = static_cast<int>(in[v].size());
+    }
+    std::vector<int> order;
+    order.reserve(n);
+    // 当前顺序中入度为零的节点，保持原有次序
+    std::priority_queue<int, std::vector<int>, std::greater<int>> ready;
+    for (size_t slot = 0; slot < n; slot++) {
+      if (in_degree[node_at[slot]] == 0) {
+        ready.push(static_cast<int>(slot));
+      }
+    }
+    while (!ready.empty()) {
+      int x = node_at[ready.top()];
+      ready.pop();
+      order.push_back(x);
+      for (int y : out[x]) {
+        if (--in_degree[y] == 0) {
+          ready.push(position[y]);
+        }
       }
     }
 
-    on_stack[node_index] = false;
-    result_stack.push(node_index + 1); // 节点ID从1开始
+    if (order.size() != n) {
+      for (size_t k = edges.size(); k-- > 0;) {
+        out[edges[k].first].pop_back();
+        in[edges[k].second].pop_back();
+      }
+      return false;
+    }
+    for (size_t slot = 0; slot < n; slot++) {
+      place(order[slot], static_cast<int>(slot));
+    }
+    edge_count += edges.size();
     return true;
   }
 };
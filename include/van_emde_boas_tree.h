@@ -1,480 +1,770 @@
 #ifndef VAN_EMDE_BOAS_TREE_H
 #define VAN_EMDE_BOAS_TREE_H
 
+#include "flat_hash_map.h"
 #include <algorithm>
-#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 namespace algorithms {
 
 /**
- * @brief van Emde Boas树数据结构
+ * @brief 簇惰性分配的van Emde Boas树（算法导论思考题20-1）
  *
- * 实现算法导论第20章"van Emde Boas树"
- * 支持快速查找、插入、删除、前驱、后继等操作
- * 适用于处理0到u-1范围内的整数集合
+ * 全域为 [0, 2^w)，w 为 universe_bits，Key 为 uint32_t 或 uint64_t 时
+ * 可分别覆盖完整的32位与64位全域。与教材20.3节相同，最小值不递归存入簇中；
+ * 不同的是簇只在第一次插入时创建，存放在以高位为键的散列表中，簇变空时立即释放，
+ * 因此空间为 O(n log log u)，与 u 无关，构造为 O(1)。
+ *
+ * 全域不超过 2^LeafBits 的子结构不再递归，而是位图叶子：LeafBits <= 6 时为
+ * 一个64位字，更大时为若干个字加一个标记非零字的摘要字（LeafBits = 9 即
+ * 512位）。叶子上的最小、最大、前驱、后继只需 ctz/clz 两步，
+ * 且叶子直接内嵌在父结点的散列表槽位中，没有最后一次指针跳转。
+ * 取默认的 LeafBits = 9 时，32位全域只有 32 -> 16 -> 8 三层。
  */
-class VanEmdeBoasTree {
-private:
-  int universe_size;                                      // 全域大小u
-  int min_val;                                            // 树中的最小值
-  int max_val;                                            // 树中的最大值
-  std::unique_ptr<VanEmdeBoasTree> summary;               // 摘要结构
-  std::vector<std::unique_ptr<VanEmdeBoasTree>> clusters; // 簇数组
+template <typename Key, unsigned LeafBits = 9> class BasicVanEmdeBoasTree {
+  static_assert(std::is_unsigned<Key>::value, "Key must be unsigned");
+  static_assert(LeafBits >= 1 && LeafBits <= 12,
+                "LeafBits must be in [1, 12]");
+
+public:
+  using key_type = Key;
+
+  static constexpr unsigned kMaxBits = std::numeric_limits<Key>::digits;
 
   /**
-   * @brief 计算高函数：返回x的高位部分
-   * @param x 输入值
-   * @return 高位部分
+   * @brief 构造函数
+   * @param universe_bits 全域位数 w，全域为 [0, 2^w)
    */
-  int high(int x) const {
-    // 计算cluster_size（与构造函数中相同）
-    int k = 0;
-    int temp = universe_size;
-    while (temp > 1) {
-      temp >>= 1;
-      k++;
+  explicit BasicVanEmdeBoasTree(unsigned universe_bits)
+      : bits(universe_bits), root(universe_bits) {
+    if (universe_bits > kMaxBits) {
+      throw std::invalid_argument("全域位数超出键类型的位宽");
     }
-    int cluster_size = 1 << ((k + 1) / 2);
-    int cluster_universe_size = 1 << (k / 2);
-    if (cluster_size * cluster_universe_size < universe_size) {
-      cluster_universe_size = 1 << ((k + 1) / 2);
+  }
+
+  unsigned universe_bits() const { return bits; }
+
+  bool empty() const { return count == 0; }
+
+  std::size_t size() const { return count; }
+
+  // 已分配的子结构个数（根、内部簇、摘要与位图叶子），用于观察空间占用
+  std::size_t node_count() const { return nodes; }
+
+  // x 是否在全域内
+  bool in_universe(Key x) const {
+    return bits >= kMaxBits || (x >> bits) == 0;
+  }
+
+  bool contains(Key x) const {
+    if (!in_universe(x)) {
+      return false;
     }
-    return x / cluster_universe_size;
+    return root_is_leaf() ? root_leaf.contains(x) : member(root, x);
   }
 
-  /**
-   * @brief 计算低函数：返回x的低位部分
-   * @param x 输入值
-   * @return 低位部分
-   */
-  int low(int x) const {
-    // 计算cluster_size（与构造函数中相同）
-    int k = 0;
-    int temp = universe_size;
-    while (temp > 1) {
-      temp >>= 1;
-      k++;
+  std::optional<Key> minimum() const {
+    if (empty()) {
+      return std::nullopt;
     }
-    int cluster_size = 1 << ((k + 1) / 2);
-    int cluster_universe_size = 1 << (k / 2);
-    if (cluster_size * cluster_universe_size < universe_size) {
-      cluster_universe_size = 1 << ((k + 1) / 2);
+    return root_is_leaf() ? root_leaf.min() : root.min;
+  }
+
+  std::optional<Key> maximum() const {
+    if (empty()) {
+      return std::nullopt;
     }
-    return x % cluster_universe_size;
+    return root_is_leaf() ? root_leaf.max() : root.max;
   }
 
-  /**
-   * @brief 根据高位和低位计算索引
-   * @param high 高位部分
-   * @param low 低位部分
-   * @return 完整索引
-   */
-  int index(int high, int low) const {
-    // 计算cluster_size（与构造函数中相同）
-    int k = 0;
-    int temp = universe_size;
-    while (temp > 1) {
-      temp >>= 1;
-      k++;
+  // 大于 x 的最小元素，O(log log u)
+  std::optional<Key> successor(Key x) const {
+    Key result;
+    if (!in_universe(x)) {
+      return std::nullopt;
     }
-    int cluster_size = 1 << ((k + 1) / 2);
-    int cluster_universe_size = 1 << (k / 2);
-    if (cluster_size * cluster_universe_size < universe_size) {
-      cluster_universe_size = 1 << ((k + 1) / 2);
+    bool found = root_is_leaf() ? root_leaf.succ(x, result)
+                                : succ(root, x, result);
+    if (!found) {
+      return std::nullopt;
     }
-    return high * cluster_universe_size + low;
+    return result;
   }
 
-public:
-  /**
-   * @brief 构造函数
-   * @param u 全域大小，必须是2的幂
-   */
-  VanEmdeBoasTree(int u) : universe_size(u), min_val(-1), max_val(-1) {
-    if (u <= 0) {
-      throw std::invalid_argument("全域大小必须大于0");
+  // 小于 x 的最大元素，O(log log u)
+  std::optional<Key> predecessor(Key x) const {
+    if (!in_universe(x)) {
+      return maximum();
     }
-
-    // 检查u是否是2的幂
-    if ((u & (u - 1)) != 0) {
-      throw std::invalid_argument("全域大小必须是2的幂");
+    Key result;
+    bool found = root_is_leaf() ? root_leaf.pred(x, result)
+                                : pred(root, x, result);
+    if (!found) {
+      return std::nullopt;
     }
+    return result;
+  }
 
-    // 基础情况：u=2
-    if (u == 2) {
-      summary = nullptr;
-      clusters.clear();
-      return;
+  // 插入 x，已存在时返回 false；x 超出全域时抛出异常
+  bool insert(Key x) {
+    if (!in_universe(x)) {
+      throw std::out_of_range("插入元素超出全域范围");
     }
-
-    // 递归构建vEB树结构
-    // 对于vEB树，我们需要找到k使得2^k = u
-    // 然后cluster_size = 2^(ceil(k/2))，每个簇的大小是2^(floor(k/2))
-    int k = 0;
-    int temp = u;
-    while (temp > 1) {
-      temp >>= 1;
-      k++;
+    if (contains(x)) {
+      return false;
     }
+    if (root_is_leaf()) {
+      root_leaf.insert(x);
+    } else {
+      add(root, x);
+    }
+    ++count;
+    return true;
+  }
 
-    // cluster_size = 2^(ceil(k/2))
-    int cluster_size = 1 << ((k + 1) / 2);
-
-    // 每个簇的大小是2^(floor(k/2))
-    int cluster_universe_size = 1 << (k / 2);
-
-    // 验证：cluster_size * cluster_universe_size >= u
-    if (cluster_size * cluster_universe_size < u) {
-      // 如果不够大，调整cluster_universe_size
-      cluster_universe_size = 1 << ((k + 1) / 2);
+  // 删除 x，不存在时返回 false
+  bool remove(Key x) {
+    if (!contains(x)) {
+      return false;
+    }
+    if (root_is_leaf()) {
+      root_leaf.erase(x);
+    } else {
+      erase(root, x);
     }
+    --count;
+    return true;
+  }
 
-    summary = std::make_unique<VanEmdeBoasTree>(cluster_size);
-    clusters.resize(cluster_size);
+  void clear() {
+    root = Node(bits);
+    root_leaf = Leaf();
+    count = 0;
+    nodes = 1;
+  }
 
-    for (int i = 0; i < cluster_size; i++) {
-      clusters[i] = std::make_unique<VanEmdeBoasTree>(cluster_universe_size);
+  // 按升序返回所有元素
+  std::vector<Key> elements() const {
+    std::vector<Key> result;
+    result.reserve(count);
+    if (root_is_leaf()) {
+      root_leaf.collect(0, result);
+    } else {
+      collect(root, 0, result);
     }
+    return result;
   }
 
   /**
-   * @brief 检查树是否为空
-   * @return true如果树为空
-   */
-  bool is_empty() const { return min_val == -1; }
-
-  /**
-   * @brief 检查元素x是否在树中
-   * @param x 要查找的元素
-   * @return true如果元素存在
+   * @brief 打印已分配的结构
+   * @param level 当前层级（用于缩进）
    */
-  bool contains(int x) const {
-    if (x < 0 || x >= universe_size) {
-      return false;
+  void print_tree(int level = 0) const {
+    if (root_is_leaf()) {
+      print_node(root_leaf, bits, level);
+    } else {
+      print_node(root, bits, level);
     }
+  }
 
-    if (x == min_val || x == max_val) {
-      return true;
-    }
+private:
+  // 位图叶子：words[i] 的第 j 位对应元素 64 i + j，
+  // summary 的第 i 位当且仅当 words[i] 非零
+  struct Leaf {
+    static constexpr unsigned kWords =
+        LeafBits <= 6 ? 1 : (1u << (LeafBits - 6));
 
-    if (universe_size == 2) {
-      return false;
+    std::uint64_t summary = 0;
+    std::uint64_t words[kWords] = {};
+
+    static std::uint64_t bit(unsigned i) { return std::uint64_t(1) << i; }
+
+    // 严格高于第 i 位的掩码；i = 63 时 2 << 63 回绕为 0，掩码为空
+    static std::uint64_t above(unsigned i) {
+      return ~((std::uint64_t(2) << i) - 1);
     }
 
-    return clusters[high(x)]->contains(low(x));
-  }
+    static std::uint64_t below(unsigned i) { return bit(i) - 1; }
 
-  /**
-   * @brief 获取树中的最小值
-   * @return 最小值，如果树为空返回-1
-   */
-  int get_min() const { return min_val; }
+    bool empty() const { return summary == 0; }
 
-  /**
-   * @brief 获取树中的最大值
-   * @return 最大值，如果树为空返回-1
-   */
-  int get_max() const { return max_val; }
+    bool contains(Key x) const { return (words[x >> 6] >> (x & 63)) & 1; }
 
-  /**
-   * @brief 获取x的后继（大于x的最小元素）
-   * @param x 当前元素
-   * @return 后继元素，如果不存在返回-1
-   */
-  int successor(int x) {
-    if (x < 0 || x >= universe_size) {
-      return -1;
+    void insert(Key x) {
+      words[x >> 6] |= bit(x & 63);
+      summary |= bit(static_cast<unsigned>(x >> 6));
     }
 
-    // 基础情况：u=2
-    if (universe_size == 2) {
-      if (x == 0 && max_val == 1) {
-        return 1;
+    void erase(Key x) {
+      unsigned w = static_cast<unsigned>(x >> 6);
+      words[w] &= ~bit(x & 63);
+      if (words[w] == 0) {
+        summary &= ~bit(w);
       }
-      return -1;
     }
 
-    // 如果x小于最小值，则后继是min_val
-    if (min_val != -1 && x < min_val) {
-      return min_val;
+    Key min() const {
+      unsigned w = __builtin_ctzll(summary);
+      return static_cast<Key>(w * 64 + __builtin_ctzll(words[w]));
     }
 
-    // 在x所在的簇中查找后继
-    int h = high(x);
-    int l = low(x);
-    int max_low = clusters[h]->get_max();
-
-    if (max_low != -1 && l < max_low) {
-      int offset = clusters[h]->successor(l);
-      return index(h, offset);
+    Key max() const {
+      unsigned w = 63 - __builtin_clzll(summary);
+      return static_cast<Key>(w * 64 + 63 - __builtin_clzll(words[w]));
     }
 
-    // 在后续簇中查找
-    int succ_cluster = summary->successor(h);
-    if (succ_cluster == -1) {
-      return -1;
+    bool succ(Key x, Key &out) const {
+      unsigned w = static_cast<unsigned>(x >> 6);
+      std::uint64_t rest = words[w] & above(x & 63);
+      if (rest == 0) {
+        std::uint64_t later = summary & above(w);
+        if (later == 0) {
+          return false;
+        }
+        w = __builtin_ctzll(later);
+        rest = words[w];
+      }
+      out = static_cast<Key>(w * 64 + __builtin_ctzll(rest));
+      return true;
     }
 
-    int offset = clusters[succ_cluster]->get_min();
-    return index(succ_cluster, offset);
-  }
-
-  /**
-   * @brief 获取x的前驱（小于x的最大元素）
-   * @param x 当前元素
-   * @return 前驱元素，如果不存在返回-1
-   */
-  int predecessor(int x) {
-    if (x < 0 || x >= universe_size) {
-      return -1;
+    bool pred(Key x, Key &out) const {
+      unsigned w = static_cast<unsigned>(x >> 6);
+      std::uint64_t rest = words[w] & below(x & 63);
+      if (rest == 0) {
+        std::uint64_t earlier = summary & below(w);
+        if (earlier == 0) {
+          return false;
+        }
+        w = 63 - __builtin_clzll(earlier);
+        rest = words[w];
+      }
+      out = static_cast<Key>(w * 64 + 63 - __builtin_clzll(rest));
+      return true;
     }
 
-    // 基础情况：u=2
-    if (universe_size == 2) {
-      if (x == 1 && min_val == 0) {
-        return 0;
+    void collect(Key base, std::vector<Key> &out) const {
+      for (std::uint64_t ws = summary; ws != 0; ws &= ws - 1) {
+        unsigned w = __builtin_ctzll(ws);
+        for (std::uint64_t rest = words[w]; rest != 0; rest &= rest - 1) {
+          out.push_back(base + static_cast<Key>(w * 64 + __builtin_ctzll(rest)));
+        }
       }
-      return -1;
     }
+  };
 
-    // 如果x大于最大值，则前驱是max_val
-    if (max_val != -1 && x > max_val) {
-      return max_val;
-    }
+  // 内部结点（bits > LeafBits）。簇与摘要按子全域大小二选一：
+  // 不超过 2^LeafBits 时为内嵌的位图叶子，否则为递归的内部结点
+  struct Node {
+    explicit Node(unsigned w) : bits(w) {}
 
-    // 在x所在的簇中查找前驱
-    int h = high(x);
-    int l = low(x);
-    int min_low = clusters[h]->get_min();
+    unsigned bits;        // 子全域位数
+    bool has_min = false; // 是否非空
+    Key min = 0;          // 最小值（不存入簇）
+    Key max = 0;          // 最大值
+    std::unique_ptr<Node> summary; // 非空簇的编号（高位较宽时）
+    Leaf summary_leaf;             // 非空簇的编号（高位不超过 LeafBits 时）
+    FlatHashMap<Key, std::unique_ptr<Node>> clusters; // 高位 -> 内部簇
+    FlatHashMap<Key, Leaf> leaves;                    // 高位 -> 叶子簇
+  };
 
-    if (min_low != -1 && l > min_low) {
-      int offset = clusters[h]->predecessor(l);
-      return index(h, offset);
-    }
+  unsigned bits;
+  Node root;      // bits > LeafBits 时使用
+  Leaf root_leaf; // bits <= LeafBits 时使用
+  std::size_t count = 0;
+  std::size_t nodes = 1;
 
-    // 在前序簇中查找
-    int pred_cluster = summary->predecessor(h);
-    if (pred_cluster == -1) {
-      // 检查min_val
-      if (min_val != -1 && x > min_val) {
-        return min_val;
-      }
-      return -1;
-    }
+  bool root_is_leaf() const { return bits <= LeafBits; }
+
+  static unsigned low_bits(const Node &n) { return n.bits / 2; }
+
+  static unsigned high_bits(const Node &n) { return n.bits - n.bits / 2; }
 
-    int offset = clusters[pred_cluster]->get_max();
-    return index(pred_cluster, offset);
+  static bool leaf_clusters(const Node &n) { return low_bits(n) <= LeafBits; }
+
+  static bool leaf_summary(const Node &n) { return high_bits(n) <= LeafBits; }
+
+  static Key high(const Node &n, Key x) { return x >> low_bits(n); }
+
+  static Key low(const Node &n, Key x) {
+    return x & ((Key(1) << low_bits(n)) - 1);
   }
 
-  /**
-   * @brief 插入元素x
-   * @param x 要插入的元素
-   */
-  void insert(int x) {
-    if (x < 0 || x >= universe_size) {
-      throw std::out_of_range("插入元素超出全域范围");
-    }
+  static Key index(const Node &n, Key h, Key l) {
+    return (h << low_bits(n)) | l;
+  }
 
-    if (contains(x)) {
-      return; // 元素已存在
-    }
+  // 叶子与内部结点的统一接口，供簇和摘要两种形态共用
+  static Leaf &deref(Leaf &leaf) { return leaf; }
+  static const Leaf &deref(const Leaf &leaf) { return leaf; }
+  static Node &deref(std::unique_ptr<Node> &node) { return *node; }
+  static const Node &deref(const std::unique_ptr<Node> &node) { return *node; }
 
-    // 如果树为空，直接设置min和max
-    if (is_empty()) {
-      min_val = x;
-      max_val = x;
-      return;
-    }
+  static bool is_empty(const Leaf &leaf) { return leaf.empty(); }
+  static bool is_empty(const Node &n) { return !n.has_min; }
 
-    // 更新最小值
-    if (x < min_val) {
-      std::swap(x, min_val);
-    }
+  static Key min_of(const Leaf &leaf) { return leaf.min(); }
+  static Key min_of(const Node &n) { return n.min; }
 
-    // 基础情况：u=2
-    if (universe_size == 2) {
-      if (x != min_val) {
-        max_val = x;
-      }
-      return;
-    }
+  static Key max_of(const Leaf &leaf) { return leaf.max(); }
+  static Key max_of(const Node &n) { return n.max; }
 
-    // 递归插入
-    int h = high(x);
-    int l = low(x);
+  static bool member(const Leaf &leaf, Key x) { return leaf.contains(x); }
+  static bool succ(const Leaf &leaf, Key x, Key &out) {
+    return leaf.succ(x, out);
+  }
+  static bool pred(const Leaf &leaf, Key x, Key &out) {
+    return leaf.pred(x, out);
+  }
+  void add(Leaf &leaf, Key x) { leaf.insert(x); }
+  void erase(Leaf &leaf, Key x) { leaf.erase(x); }
 
-    if (clusters[h]->is_empty()) {
-      summary->insert(h);
-      clusters[h]->min_val = l;
-      clusters[h]->max_val = l;
+  // 以簇散列表调用 f（两种形态之一）
+  template <typename N, typename F> static void with_clusters(N &n, F f) {
+    if (leaf_clusters(n)) {
+      f(n.leaves);
     } else {
-      clusters[h]->insert(l);
+      f(n.clusters);
     }
+  }
 
-    // 更新最大值
-    if (x > max_val) {
-      max_val = x;
+  // 以摘要调用 f；内部结点形态的摘要须已存在
+  template <typename N, typename F> static void with_summary(N &n, F f) {
+    if (leaf_summary(n)) {
+      f(n.summary_leaf);
+    } else {
+      f(*n.summary);
     }
   }
 
-  /**
-   * @brief 删除元素x
-   * @param x 要删除的元素
-   */
-  void remove(int x) {
-    if (x < 0 || x >= universe_size) {
-      throw std::out_of_range("删除元素超出全域范围");
+  static bool has_summary(const Node &n) {
+    return leaf_summary(n) ? !n.summary_leaf.empty() : n.summary != nullptr;
+  }
+
+  static Leaf *new_cluster(FlatHashMap<Key, Leaf> &map, Key h, unsigned) {
+    return map.emplace(h).first;
+  }
+
+  static Node *new_cluster(FlatHashMap<Key, std::unique_ptr<Node>> &map, Key h,
+                           unsigned w) {
+    return map.emplace(h, std::make_unique<Node>(w)).first->get();
+  }
+
+  static bool member(const Node &n, Key x) {
+    if (!n.has_min) {
+      return false;
     }
+    if (x == n.min || x == n.max) {
+      return true;
+    }
+    bool found = false;
+    with_clusters(n, [&](const auto &map) {
+      const auto *c = map.find(high(n, x));
+      found = c != nullptr && member(deref(*c), low(n, x));
+    });
+    return found;
+  }
 
-    if (!contains(x)) {
-      return; // 元素不存在
+  static bool succ(const Node &n, Key x, Key &out) {
+    if (!n.has_min || x >= n.max) {
+      return false;
+    }
+    if (x < n.min) {
+      out = n.min;
+      return true;
+    }
+    Key h = high(n, x), l = low(n, x);
+    bool done = false;
+    with_clusters(n, [&](const auto &map) {
+      const auto *c = map.find(h);
+      Key offset = 0;
+      if (c != nullptr && l < max_of(deref(*c))) {
+        succ(deref(*c), l, offset);
+        out = index(n, h, offset);
+        done = true;
+      }
+    });
+    if (done) {
+      return true;
     }
+    // x < max，因此后续必有非空簇
+    Key next = 0;
+    with_summary(n, [&](const auto &summary) { succ(summary, h, next); });
+    with_clusters(n, [&](const auto &map) {
+      out = index(n, next, min_of(deref(*map.find(next))));
+    });
+    return true;
+  }
 
-    // 如果树中只有一个元素
-    if (min_val == max_val) {
-      min_val = -1;
-      max_val = -1;
+  static bool pred(const Node &n, Key x, Key &out) {
+    if (!n.has_min || x <= n.min) {
+      return false;
+    }
+    if (x > n.max) {
+      out = n.max;
+      return true;
+    }
+    Key h = high(n, x), l = low(n, x);
+    bool done = false;
+    with_clusters(n, [&](const auto &map) {
+      const auto *c = map.find(h);
+      Key offset = 0;
+      if (c != nullptr && l > min_of(deref(*c))) {
+        pred(deref(*c), l, offset);
+        out = index(n, h, offset);
+        done = true;
+      }
+    });
+    if (done) {
+      return true;
+    }
+    Key prev = 0;
+    bool earlier = false;
+    if (has_summary(n)) {
+      with_summary(n, [&](const auto &summary) {
+        earlier = pred(summary, h, prev);
+      });
+    }
+    if (!earlier) {
+      out = n.min;
+      return true;
+    }
+    with_clusters(n, [&](const auto &map) {
+      out = index(n, prev, max_of(deref(*map.find(prev))));
+    });
+    return true;
+  }
+
+  // 插入 x（调用者保证 x 不在 n 中）
+  void add(Node &n, Key x) {
+    if (!n.has_min) {
+      n.has_min = true;
+      n.min = n.max = x;
       return;
     }
+    if (x < n.min) {
+      std::swap(x, n.min);
+    }
+    if (x > n.max) {
+      n.max = x;
+    }
 
-    // 基础情况：u=2
-    if (universe_size == 2) {
-      if (x == 0) {
-        min_val = 1;
+    Key h = high(n, x), l = low(n, x);
+    bool created = false;
+    with_clusters(n, [&](auto &map) {
+      auto *c = map.find(h);
+      if (c != nullptr) {
+        add(deref(*c), l);
       } else {
-        min_val = 0;
+        // 簇为空：惰性创建，插入为 O(1)，递归只发生在摘要上
+        add(*new_cluster(map, h, low_bits(n)), l);
+        created = true;
       }
-      max_val = min_val;
+    });
+    if (!created) {
       return;
     }
+    ++nodes;
+    if (!leaf_summary(n) && !n.summary) {
+      n.summary = std::make_unique<Node>(high_bits(n));
+      ++nodes;
+    }
+    with_summary(n, [&](auto &summary) { add(summary, h); });
+  }
 
-    // 如果x是min_val，需要找到新的min_val
-    if (x == min_val) {
-      int first_cluster = summary->get_min();
-      if (first_cluster == -1) {
-        // 只有min_val一个元素
-        min_val = max_val;
-        return;
-      }
-
-      int new_min_low = clusters[first_cluster]->get_min();
-      min_val = index(first_cluster, new_min_low);
-      x = min_val; // 现在删除新的min_val
+  // 删除 x（调用者保证 x 在 n 中）
+  void erase(Node &n, Key x) {
+    if (n.min == n.max) {
+      n.has_min = false;
+      return;
+    }
+    if (x == n.min) {
+      // 把第一个非空簇的最小值提升为新的 min，再从簇中删除它
+      Key first = 0;
+      with_summary(n, [&](const auto &summary) { first = min_of(summary); });
+      with_clusters(n, [&](const auto &map) {
+        x = index(n, first, min_of(deref(*map.find(first))));
+      });
+      n.min = x;
     }
 
-    // 递归删除
-    int h = high(x);
-    int l = low(x);
-    clusters[h]->remove(l);
+    Key h = high(n, x), l = low(n, x);
+    bool emptied = false;
+    Key cluster_max = 0;
+    with_clusters(n, [&](auto &map) {
+      auto &c = deref(*map.find(h));
+      erase(c, l);
+      if (is_empty(c)) {
+        map.erase(h);
+        emptied = true;
+      } else {
+        cluster_max = max_of(c);
+      }
+    });
 
-    if (clusters[h]->is_empty()) {
-      summary->remove(h);
+    if (!emptied) {
+      if (x == n.max) {
+        n.max = index(n, h, cluster_max);
+      }
+      return;
+    }
 
-      // 如果删除的是max_val，需要更新max_val
-      if (x == max_val) {
-        int summary_max = summary->get_max();
-        if (summary_max == -1) {
-          max_val = min_val;
-        } else {
-          int cluster_max = clusters[summary_max]->get_max();
-          max_val = index(summary_max, cluster_max);
-        }
+    --nodes;
+    with_summary(n, [&](auto &summary) { erase(summary, h); });
+    if (!leaf_summary(n) && is_empty(*n.summary)) {
+      n.summary.reset();
+      --nodes;
+    }
+    if (x == n.max) {
+      if (!has_summary(n)) {
+        n.max = n.min;
+      } else {
+        Key last = 0;
+        with_summary(n, [&](const auto &summary) { last = max_of(summary); });
+        with_clusters(n, [&](const auto &map) {
+          n.max = index(n, last, max_of(deref(*map.find(last))));
+        });
       }
-    } else if (x == max_val) {
-      int cluster_max = clusters[h]->get_max();
-      max_val = index(h, cluster_max);
     }
   }
 
-  /**
-   * @brief 获取树中元素数量
-   * @return 元素数量
-   */
-  int size() const {
-    if (is_empty()) {
-      return 0;
-    }
+  // 非空簇的编号，升序
+  template <typename Map> static std::vector<Key> cluster_ids(const Map &map) {
+    std::vector<Key> ids;
+    ids.reserve(map.size());
+    map.for_each([&ids](const Key &h, const auto &) { ids.push_back(h); });
+    std::sort(ids.begin(), ids.end());
+    return ids;
+  }
 
-    if (universe_size == 2) {
-      return (min_val == max_val) ? 1 : 2;
+  static void collect(const Leaf &leaf, Key base, std::vector<Key> &out) {
+    leaf.collect(base, out);
+  }
+
+  static void collect(const Node &n, Key base, std::vector<Key> &out) {
+    if (!n.has_min) {
+      return;
     }
+    out.push_back(base + n.min);
+    with_clusters(n, [&](const auto &map) {
+      for (Key h : cluster_ids(map)) {
+        collect(deref(*map.find(h)), base + index(n, h, 0), out);
+      }
+    });
+  }
 
-    int count = 1; // min_val
+  static std::string universe_label(unsigned w) {
+    return w < 64 ? std::to_string(std::uint64_t(1) << w)
+                  : "2^" + std::to_string(w);
+  }
 
-    // 递归计算所有簇的大小
-    for (int i = 0; i < (int)sqrt(universe_size); i++) {
-      if (!clusters[i]->is_empty()) {
-        count += clusters[i]->size();
-      }
+  static void print_node(const Leaf &leaf, unsigned w, int level) {
+    std::string indent(level * 2, ' ');
+    std::cout << indent << "vEB(" << universe_label(w) << "): ";
+    if (leaf.empty()) {
+      std::cout << "empty" << std::endl;
+    } else {
+      std::cout << "min=" << leaf.min() << ", max=" << leaf.max()
+                << std::endl;
     }
-
-    return count;
   }
 
-  /**
-   * @brief 打印树的结构
-   * @param level 当前层级（用于缩进）
-   */
-  void print_tree(int level = 0) const {
+  static void print_node(const Node &n, unsigned w, int level) {
     std::string indent(level * 2, ' ');
 
-    std::cout << indent << "vEB(" << universe_size << "): ";
-    if (is_empty()) {
+    std::cout << indent << "vEB(" << universe_label(w) << "): ";
+    if (!n.has_min) {
       std::cout << "empty" << std::endl;
       return;
     }
 
-    std::cout << "min=" << min_val << ", max=" << max_val << std::endl;
+    std::cout << "min=" << n.min << ", max=" << n.max << std::endl;
 
-    if (universe_size > 2) {
+    if (has_summary(n)) {
       std::cout << indent << "Summary: " << std::endl;
-      summary->print_tree(level + 1);
+      with_summary(n, [&](const auto &summary) {
+        print_node(summary, high_bits(n), level + 1);
+      });
 
       std::cout << indent << "Clusters: " << std::endl;
-      for (int i = 0; i < (int)sqrt(universe_size); i++) {
-        if (!clusters[i]->is_empty()) {
-          std::cout << indent << "  Cluster " << i << ": " << std::endl;
-          clusters[i]->print_tree(level + 2);
+      with_clusters(n, [&](const auto &map) {
+        for (Key h : cluster_ids(map)) {
+          std::cout << indent << "  Cluster " << h << ": " << std::endl;
+          print_node(deref(*map.find(h)), low_bits(n), level + 2);
         }
-      }
+      });
+    }
+  }
+};
+
+// 完整32位与64位全域（例如稀疏的32位定时器编号）
+using VanEmdeBoasTree32 = BasicVanEmdeBoasTree<std::uint32_t>;
+using VanEmdeBoasTree64 = BasicVanEmdeBoasTree<std::uint64_t>;
+
+/**
+ * @brief van Emde Boas树数据结构
+ *
+ * 实现算法导论第20章"van Emde Boas树"
+ * 支持快速查找、插入、删除、前驱、后继等操作
+ * 适用于处理0到u-1范围内的整数集合
+ *
+ * 内部为 BasicVanEmdeBoasTree<uint32_t, 1>：递归到 u = 2 为止，
+ * 结构与教材一致；簇惰性分配，构造不再预先建立全部 Θ(u) 个子结构。
+ */
+class VanEmdeBoasTree {
+private:
+  int universe_size; // 全域大小u
+  BasicVanEmdeBoasTree<std::uint32_t, 1> tree;
+
+  static unsigned bits_of(int u) {
+    if (u <= 0) {
+      throw std::invalid_argument("全域大小必须大于0");
     }
+
+    // 检查u是否是2的幂
+    if ((u & (u - 1)) != 0) {
+      throw std::invalid_argument("全域大小必须是2的幂");
+    }
+
+    unsigned k = 0;
+    while ((1 << k) < u) {
+      k++;
+    }
+    return k;
   }
 
+public:
   /**
-   * @brief 获取所有元素
-   * @return 包含所有元素的向量
+   * @brief 构造函数
+   * @param u 全域大小，必须是2的幂
    */
-  std::vector<int> get_elements() const {
-    std::vector<int> elements;
+  VanEmdeBoasTree(int u) : universe_size(u), tree(bits_of(u)) {}
 
-    if (is_empty()) {
-      return elements;
+  /**
+   * @brief 检查树是否为空
+   * @return true如果树为空
+   */
+  bool is_empty() const { return tree.empty(); }
+
+  /**
+   * @brief 检查元素x是否在树中
+   * @param x 要查找的元素
+   * @return true如果元素存在
+   */
+  bool contains(int x) const {
+    if (x < 0 || x >= universe_size) {
+      return false;
     }
+    return tree.contains(static_cast<std::uint32_t>(x));
+  }
+
+  /**
+   * @brief 获取树中的最小值
+   * @return 最小值，如果树为空返回-1
+   */
+  int get_min() const {
+    auto result = tree.minimum();
+    return result ? static_cast<int>(*result) : -1;
+  }
 
-    // 添加min_val
-    elements.push_back(min_val);
+  /**
+   * @brief 获取树中的最大值
+   * @return 最大值，如果树为空返回-1
+   */
+  int get_max() const {
+    auto result = tree.maximum();
+    return result ? static_cast<int>(*result) : -1;
+  }
 
-    if (universe_size == 2) {
-      if (min_val != max_val) {
-        elements.push_back(max_val);
-      }
-      return elements;
+  /**
+   * @brief 获取x的后继（大于x的最小元素）
+   * @param x 当前元素，小于0时返回最小值
+   * @return 后继元素，如果不存在返回-1
+   */
+  int successor(int x) const {
+    if (x < 0) {
+      return get_min();
     }
+    if (x >= universe_size) {
+      return -1;
+    }
+    auto result = tree.successor(static_cast<std::uint32_t>(x));
+    return result ? static_cast<int>(*result) : -1;
+  }
 
-    // 递归获取所有簇的元素
-    for (int i = 0; i < (int)sqrt(universe_size); i++) {
-      if (!clusters[i]->is_empty()) {
-        auto cluster_elements = clusters[i]->get_elements();
-        for (int elem : cluster_elements) {
-          elements.push_back(index(i, elem));
-        }
-      }
+  /**
+   * @brief 获取x的前驱（小于x的最大元素）
+   * @param x 当前元素，不小于u时返回最大值
+   * @return 前驱元素，如果不存在返回-1
+   */
+  int predecessor(int x) const {
+    if (x < 0) {
+      return -1;
     }
+    if (x >= universe_size) {
+      return get_max();
+    }
+    auto result = tree.predecessor(static_cast<std::uint32_t>(x));
+    return result ? static_cast<int>(*result) : -1;
+  }
 
+  /**
+   * @brief 插入元素x
+   * @param x 要插入的元素
+   */
+  void insert(int x) {
+    if (x < 0 || x >= universe_size) {
+      throw std::out_of_range("插入元素超出全域范围");
+    }
+    tree.insert(static_cast<std::uint32_t>(x));
+  }
+
+  /**
+   * @brief 删除元素x
+   * @param x 要删除的元素
+   */
+  void remove(int x) {
+    if (x < 0 || x >= universe_size) {
+      throw std::out_of_range("删除元素超出全域范围");
+    }
+    tree.remove(static_cast<std::uint32_t>(x));
+  }
+
+  /**
+   * @brief 获取树中元素数量
+   * @return 元素数量
+   */
+  int size() const { return static_cast<int>(tree.size()); }
+
+  /**
+   * @brief 已分配的子结构个数，空间为 O(n log log u)
+   */
+  std::size_t node_count() const { return tree.node_count(); }
+
+  /**
+   * @brief 打印树的结构
+   * @param level 当前层级（用于缩进）
+   */
+  void print_tree(int level = 0) const { tree.print_tree(level); }
+
+  /**
+   * @brief 获取所有元素
+   * @return 包含所有元素的向量（升序）
+   */
+  std::vector<int> get_elements() const {
+    std::vector<int> elements;
+    for (std::uint32_t x : tree.elements()) {
+      elements.push_back(static_cast<int>(x));
+    }
     return elements;
   }
 };
@@ -0,0 +1,78 @@
+#ifndef WAVEFRONT_EXECUTOR_H
+#define WAVEFRONT_EXECUTOR_H
+
+#include "work_stealing_scheduler.h"
+#include <algorithm>
+#include <cstddef>
+
+namespace algorithms {
+
+/**
+ * @brief 分块波前执行器：按依赖关系并行填充二维动态规划表
+ *
+ * 把表切成 tile × tile 的块，同一条"波前"上的块互不依赖，由调度器的
+ * parallel_for 并行执行；相邻波前之间隐式同步。块内的填表顺序由调用者
+ * 负责，执行器只保证块的依赖都已完成。支持两种常见的依赖形状：
+ *
+ * - grid：格子 (i, j) 依赖 (i-1, j)、(i, j-1)、(i-1, j-1)，
+ *   如LCS、编辑距离。块 (I, J) 在第 I+J 条反对角线上执行。
+ * - triangular：区间DP，格子 (i, j)（i ≤ j）依赖同一行左侧的 (i, k) 与
+ *   同一列下方的 (k, j)，如矩阵链乘法、最优二叉搜索树。块 (I, J)（I ≤ J）
+ *   在第 J-I 条对角线上执行，块内须按 i 递减、j 递增的顺序填表。
+ *
+ * 回调 body(row_begin, row_end, col_begin, col_end) 处理一个块的半开区间；
+ * 跨度为 O(块的波前数)，块应足够大以摊薄同步开销。
+ */
+class WavefrontExecutor {
+public:
+  template <typename Body>
+  static void grid(WorkStealingScheduler &scheduler, std::size_t rows,
+                   std::size_t cols, std::size_t tile_rows,
+                   std::size_t tile_cols, const Body &body) {
+    if (rows == 0 || cols == 0) {
+      return;
+    }
+    tile_rows = std::max<std::size_t>(tile_rows, 1);
+    tile_cols = std::max<std::size_t>(tile_cols, 1);
+    std::size_t row_tiles = (rows + tile_rows - 1) / tile_rows;
+    std::size_t col_tiles = (cols + tile_cols - 1) / tile_cols;
+
+    for (std::size_t d = 0; d + 1 < row_tiles + col_tiles; d++) {
+      std::size_t first = d + 1 > col_tiles ? d + 1 - col_tiles : 0;
+      std::size_t last = std::min(d + 1, row_tiles);
+      scheduler.parallel_for(first, last, 1, [&](std::size_t lo,
+                                                 std::size_t hi) {
+        for (std::size_t bi = lo; bi < hi; bi++) {
+          std::size_t bj = d - bi;
+          body(bi * tile_rows, std::min(rows, (bi + 1) * tile_rows),
+               bj * tile_cols, std::min(cols, (bj + 1) * tile_cols));
+        }
+      });
+    }
+  }
+
+  template <typename Body>
+  static void triangular(WorkStealingScheduler &scheduler, std::size_t n,
+                         std::size_t tile, const Body &body) {
+    if (n == 0) {
+      return;
+    }
+    tile = std::max<std::size_t>(tile, 1);
+    std::size_t tiles = (n + tile - 1) / tile;
+
+    for (std::size_t d = 0; d < tiles; d++) {
+      scheduler.parallel_for(0, tiles - d, 1, [&](std::size_t lo,
+                                                  std::size_t hi) {
+        for (std::size_t bi = lo; bi < hi; bi++) {
+          std::size_t bj = bi + d;
+          body(bi * tile, std::min(n, (bi + 1) * tile), bj * tile,
+               std::min(n, (bj + 1) * tile));
+        }
+      });
+    }
+  }
+};
+
+} // namespace algorithms
+
+#endif // WAVEFRONT_EXECUTOR_H
@@ -0,0 +1,427 @@
+#ifndef WORK_STEALING_SCHEDULER_H
+#define WORK_STEALING_SCHEDULER_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace algorithms {
+
+/**
+ * @brief 工作窃取调度器（算法导论第27章的spawn/sync模型）
+ *
+ * - 每个工作线程拥有一个Chase-Lev双端队列：本线程在底部压入/弹出，
+ *   空闲线程从其他队列的顶部窃取，常见路径上没有锁
+ * - 任务对象内联存放在TaskGroup里（小缓冲区，最多kInlineSize字节的可调用对象），
+ *   spawn不分配堆内存
+ * - 调用run()的线程作为0号工作线程参与计算，另外创建 num_threads-1 个后台线程
+ *
+ * 用法：
+ * @code
+ *   WorkStealingScheduler scheduler(4);
+ *   scheduler.run([&] {
+ *     WorkStealingScheduler::TaskGroup group;
+ *     group.spawn([&] { left(); });   // spawn
+ *     right();
+ *     group.sync();                   // sync
+ *   });
+ * @endcode
+ * 在工作线程之外使用TaskGroup时spawn退化为直接调用（串行省略）。
+ */
+class WorkStealingScheduler {
+public:
+  static constexpr size_t kInlineSize = 64; // 任务可调用对象的最大字节数
+  static constexpr size_t kMaxSpawn = 8;    // 每个TaskGroup在sync前可挂起的任务数
+
+  class TaskGroup;
+
+  /**
+   * @brief 构造调度器
+   * @param num_threads 工作线程总数（包括调用run()的线程）
+   */
+  explicit WorkStealingScheduler(
+      size_t num_threads = std::thread::hardware_concurrency())
+      : stop(false), sleepers(0) {
+    if (num_threads == 0)
+      num_threads = 1;
+    for (size_t i = 0; i < num_threads; i++)
+      workers.emplace_back(new Worker(this, i));
+    for (size_t i = 1; i < num_threads; i++)
+      threads.emplace_back([this, i] { worker_loop(*workers[i]); });
+  }
+
+  WorkStealingScheduler(const WorkStealingScheduler &) = delete;
+  WorkStealingScheduler &operator=(const WorkStealingScheduler &) = delete;
+
+  ~WorkStealingScheduler() {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex);
+      stop.store(true);
+    }
+    sleep_cv.notify_all();
+    for (auto &thread : threads)
+      thread.join();
+  }
+
+  size_t get_num_threads() const { return workers.size(); }
+
+  /**
+   * @brief 以调用线程为0号工作线程执行f，返回时f派生的所有任务都已完成
+   *
+   * 在本调度器的工作线程内部调用时直接执行f。
+   */
+  template <typename F> void run(F &&f) {
+    if (current_worker() && current_worker()->scheduler == this) {
+      f();
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(run_mutex);
+    Worker *previous = current_worker();
+    current_worker() = workers[0].get();
+    try {
+      f();
+    } catch (...) {
+      current_worker() = previous;
+      throw;
+    }
+    current_worker() = previous;
+  }
+
+  /**
+   * @brief 并行循环：对[begin, end)递归二分，块不超过grain时调用body(lo, hi)
+   *
+   * 与算法导论27.1节parallel for的实现方式相同，跨度为O(lg(n/grain))。
+   */
+  template <typename Body>
+  void parallel_for(size_t begin, size_t end, size_t grain, const Body &body) {
+    if (begin >= end)
+      return;
+    grain = std::max<size_t>(grain, 1);
+    run([&] { parallel_for_range(begin, end, grain, body); });
+  }
+
+  /**
+   * @brief 一个spawn/sync作用域
+   *
+   * spawn的任务在sync()（或析构）之前完成；等待期间当前线程继续执行
+   * 本地队列或窃取来的任务。任务抛出的第一个异常在sync()时重新抛出。
+   */
+  class TaskGroup {
+  public:
+    TaskGroup() : pending(0), spawned(0), has_error(false) {}
+
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    ~TaskGroup() { wait(); }
+
+    template <typename F> void spawn(F &&f) {
+      using Fn = std::decay_t<F>;
+      static_assert(sizeof(Fn) <= kInlineSize,
+                    "spawned callable exceeds the inline task buffer");
+      static_assert(alignof(Fn) <= alignof(std::max_align_t),
+                    "spawned callable is over-aligned");
+
+      Worker *worker = current_worker();
+      if (!worker || spawned == kMaxSpawn) {
+        // 不在调度器中或槽位用尽：串行执行
+        run_inline(f);
+        return;
+      }
+
+      Task &task = tasks[spawned++];
+      new (task.storage) Fn(std::forward<F>(f));
+      task.invoke = [](void *p) { (*static_cast<Fn *>(p))(); };
+      task.destroy = [](void *p) { static_cast<Fn *>(p)->~Fn(); };
+      task.group = this;
+      pending.fetch_add(1, std::memory_order_relaxed);
+      worker->deque.push(&task);
+      worker->scheduler->notify_work();
+    }
+
+    void sync() {
+      wait();
+      if (has_error) {
+        has_error = false;
+        std::rethrow_exception(std::move(error));
+      }
+    }
+
+  private:
+    friend class WorkStealingScheduler;
+
+    struct Task {
+      alignas(std::max_align_t) unsigned char storage[kInlineSize];
+      void (*invoke)(void *);
+      void (*destroy)(void *);
+      TaskGroup *group;
+    };
+
+    Task tasks[kMaxSpawn];
+    std::atomic<size_t> pending;
+    size_t spawned;
+    std::atomic<bool> has_error;
+    std::exception_ptr error;
+
+    template <typename F> void run_inline(F &f) {
+      try {
+        f();
+      } catch (...) {
+        record_error(std::current_exception());
+      }
+    }
+
+    void record_error(std::exception_ptr e) {
+      bool expected = false;
+      if (has_error.compare_exchange_strong(expected, true))
+        error = std::move(e);
+    }
+
+    void wait() {
+      Worker *worker = current_worker();
+      // 不在工作线程中时所有spawn都已串行执行，pending恒为0
+      while (pending.load(std::memory_order_acquire) != 0) {
+        Task *task = worker->deque.take();
+        if (!task)
+          task = worker->scheduler->steal(*worker);
+        if (task)
+          execute(task);
+        else
+          std::this_thread::yield();
+      }
+      spawned = 0;
+    }
+  };
+
+private:
+  using Task = TaskGroup::Task;
+
+  /**
+   * @brief Chase-Lev无锁双端队列（Lê等人针对弱内存模型的版本）
+   *
+   * 环形数组写满时由所有者扩容一倍，旧数组保留到析构以免窃取者读到已释放内存。
+   */
+  class TaskDeque {
+  private:
+    struct Ring {
+      int64_t capacity;
+      std::unique_ptr<std::atomic<Task *>[]> slots;
+
+      explicit Ring(int64_t c)
+          : capacity(c), slots(new std::atomic<Task *>[c]) {}
+      Task *get(int64_t i) const {
+        return slots[i & (capacity - 1)].load(std::memory_order_acquire);
+      }
+      void put(int64_t i, Task *task) {
+        slots[i & (capacity - 1)].store(task, std::memory_order_release);
+      }
+    };
+
+    std::atomic<int64_t> top;
+    std::atomic<int64_t> bottom;
+    std::atomic<Ring *> ring;
+    std::vector<std::unique_ptr<Ring>> rings; // 仅所有者访问
+
+  public:
+    TaskDeque() : top(0), bottom(0) {
+      rings.emplace_back(new Ring(256));
+      ring.store(rings.back().get(), std::memory_order_relaxed);
+    }
+
+    // 所有者：压入底部
+    void push(Task *task) {
+      int64_t b = bottom.load(std::memory_order_relaxed);
+      int64_t t = top.load(std::memory_order_acquire);
+      Ring *r = ring.load(std::memory_order_relaxed);
+      if (b - t > r->capacity - 1) {
+        Ring *bigger = new Ring(r->capacity * 2);
+        for (int64_t i = t; i < b; i++)
+          bigger->put(i, r->get(i));
+        rings.emplace_back(bigger);
+        ring.store(bigger, std::memory_order_release);
+        r = bigger;
+      }
+      r->put(b, task);
+      bottom.store(b + 1, std::memory_order_release);
+    }
+
+    // 所有者：从底部弹出，空时返回nullptr
+    Task *take() {
+      int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+      Ring *r = ring.load(std::memory_order_relaxed);
+      bottom.store(b, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      int64_t t = top.load(std::memory_order_relaxed);
+
+      if (t > b) {
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+      }
+      Task *task = r->get(b);
+      if (t == b) {
+        // 最后一个元素，与窃取者竞争
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed))
+          task = nullptr;
+        bottom.store(b + 1, std::memory_order_relaxed);
+      }
+      return task;
+    }
+
+    // 窃取者：从顶部取走，空或竞争失败时返回nullptr
+    Task *steal() {
+      int64_t t = top.load(std::memory_order_acquire);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      int64_t b = bottom.load(std::memory_order_acquire);
+      if (t >= b)
+        return nullptr;
+
+      Ring *r = ring.load(std::memory_order_acquire);
+      Task *task = r->get(t);
+      if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                       std::memory_order_relaxed))
+        return nullptr;
+      return task;
+    }
+
+    bool empty() const {
+      return top.load(std::memory_order_acquire) >=
+             bottom.load(std::memory_order_acquire);
+    }
+  };
+
+  struct Worker {
+    WorkStealingScheduler *scheduler;
+    size_t index;
+    TaskDeque deque;
+    uint64_t rng;
+
+    Worker(WorkStealingScheduler *s, size_t i)
+        : scheduler(s), index(i), rng(0x9E3779B97F4A7C15ull * (i + 1)) {}
+
+    size_t next_victim(size_t n) {
+      rng ^= rng << 13;
+      rng ^= rng >> 7;
+      rng ^= rng << 17;
+      return rng % n;
+    }
+  };
+
+  std::vector<std::unique_ptr<Worker>> workers;
+  std::vector<std::thread> threads;
+  std::mutex run_mutex;
+  std::mutex sleep_mutex;
+  std::condition_variable sleep_cv;
+  std::atomic<bool> stop;
+  std::atomic<size_t> sleepers;
+
+  static Worker *&current_worker() {
+    static thread_local Worker *worker = nullptr;
+    return worker;
+  }
+
+  static void execute(Task *task) {
+    TaskGroup *group = task->group;
+    try {
+      task->invoke(task->storage);
+    } catch (...) {
+      group->record_error(std::current_exception());
+    }
+    task->destroy(task->storage);
+    group->pending.fetch_sub(1, std::memory_order_release);
+  }
+
+  // 从随机起点依次尝试窃取一轮
+  Task *steal(Worker &thief) {
+    size_t n = workers.size();
+    if (n == 1)
+      return nullptr;
+    size_t start = thief.next_victim(n);
+    for (size_t k = 0; k < n; k++) {
+      size_t victim = (start + k) % n;
+      if (victim == thief.index)
+        continue;
+      if (Task *task = workers[victim]->deque.steal())
+        return task;
+    }
+    return nullptr;
+  }
+
+  bool has_work() const {
+    for (const auto &worker : workers)
+      if (!worker->deque.empty())
+        return true;
+    return false;
+  }
+
+  // 压入任务后调用：有线程睡眠时唤醒（与worker_loop中的检查构成Dekker式握手）
+  void notify_work() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers.load(std::memory_order_relaxed) != 0) {
+      { std::lock_guard<std::mutex> lock(sleep_mutex); }
+      sleep_cv.notify_all();
+    }
+  }
+
+  void worker_loop(Worker &self) {
+    current_worker() = &self;
+    const int spin_rounds = 64;
+    int idle = 0;
+
+    while (!stop.load(std::memory_order_relaxed)) {
+      Task *task = self.deque.take();
+      if (!task)
+        task = steal(self);
+      if (task) {
+        execute(task);
+        idle = 0;
+        continue;
+      }
+
+      if (++idle < spin_rounds) {
+        std::this_thread::yield();
+        continue;
+      }
+
+      // 长时间没有任务：睡眠直到有新任务压入或调度器停止
+      std::unique_lock<std::mutex> lock(sleep_mutex);
+      sleepers.fetch_add(1, std::memory_order_seq_cst);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (!stop.load() && !has_work())
+        sleep_cv.wait(lock);
+      sleepers.fetch_sub(1, std::memory_order_relaxed);
+      idle = 0;
+    }
+    current_worker() = nullptr;
+  }
+
+  template <typename Body>
+  static void parallel_for_range(size_t begin, size_t end, size_t grain,
+                                 const Body &body) {
+    if (end - begin <= grain) {
+      body(begin, end);
+      return;
+    }
+    size_t mid = begin + (end - begin) / 2;
+    TaskGroup group;
+    group.spawn(
+        [&body, mid, end, grain] { parallel_for_range(mid, end, grain, body); });
+    parallel_for_range(begin, mid, grain, body);
+    group.sync();
+  }
+};
+
+} // namespace algorithms
+
+#endif // WORK_STEALING_SCHEDULER_H
@@ -0,0 +1,710 @@
+#ifndef WORKLOAD_GENERATOR_H
+#define WORKLOAD_GENERATOR_H
+
+#include "graph_representation.h"
+#include "work_stealing_scheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace algorithms {
+
+namespace workload_detail {
+
+// SplitMix64 的输出函数：把任意64位输入打散成均匀的64位值
+inline uint64_t mix64(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xBF58476D1CE4E5B9ULL;
+  x ^= x >> 27;
+  x *= 0x94D049BB133111EBULL;
+  x ^= x >> 31;
+  return x;
+}
+
+// 计数器式随机数：同一 (key, index) 总是得到同一个值，与调用顺序无关
+inline uint64_t random_at(uint64_t key, uint64_t index) {
+  return mix64(key + (index + 1) * 0x9E3779B97F4A7C15ULL);
+}
+
+// [0, bound) 内的均匀整数（Lemire 乘法映射）；bound 为 0 时返回 0
+inline uint64_t bounded(uint64_t r, uint64_t bound) {
+  return static_cast<uint64_t>((static_cast<unsigned __int128>(r) * bound) >> 64);
+}
+
+// [0, 1) 内的均匀 double，取高53位
+inline double unit_double(uint64_t r) {
+  return static_cast<double>(r >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * @brief [0, n) 上的伪随机置换：四轮 Feistel 网络加循环行走
+ *
+ * 每个下标独立求值，O(1) 时间、无需额外内存，因此可以并行生成十亿级的排列。
+ */
+class FeistelPermutation {
+public:
+  FeistelPermutation(uint64_t n, uint64_t key) : n(n) {
+    unsigned bits = 1;
+    while (bits < 64 && (uint64_t(1) << bits) < n)
+      bits++;
+    half_bits = (bits + 1) / 2;
+    mask = (uint64_t(1) << half_bits) - 1;
+    for (int r = 0; r < kRounds; r++)
+      keys[r] = mix64(key + r + 1);
+  }
+
+  uint64_t operator()(uint64_t x) const {
+    // 定义域是不小于 n 的 2 的偶数次幂（不超过 4n），落在 n 之外就再置换一次
+    do {
+      x = encrypt(x);
+    } while (x >= n);
+    return x;
+  }
+
+private:
+  static constexpr int kRounds = 4;
+  uint64_t n, mask;
+  unsigned half_bits;
+  uint64_t keys[kRounds];
+
+  uint64_t encrypt(uint64_t x) const {
+    uint64_t left = x >> half_bits, right = x & mask;
+    for (int r = 0; r < kRounds; r++) {
+      uint64_t next = left ^ (mix64(right ^ keys[r]) & mask);
+      left = right;
+      right = next;
+    }
+    return (left << half_bits) | right;
+  }
+};
+
+/**
+ * @brief Zipf 分布 P(k) ∝ 1/k^s (k = 1..N) 的拒绝-反演采样
+ *
+ * Hörmann–Derflinger 的拒绝-反演法：预处理 O(1)，每个样本期望不到两个均匀数，
+ * N 可以很大（不需要 O(N) 的累积分布表），s > 0 即可（含 s = 1）。
+ */
+class ZipfSampler {
+public:
+  ZipfSampler(uint64_t universe, double exponent)
+      : n(static_cast<double>(std::max<uint64_t>(universe, 1))),
+        exponent(exponent) {
+    if (!(exponent > 0))
+      throw std::invalid_argument("Zipf exponent must be positive");
+    h_integral_x1 = h_integral(1.5) - 1.0;
+    h_integral_n = h_integral(n + 0.5);
+    s = 2.0 - h_integral_inverse(h_integral(2.5) - h(2.0));
+  }
+
+  // next_uniform() 返回 [0, 1) 内的均匀数；结果为 1..N 的秩
+  template <typename Uniform> uint64_t sample(Uniform &&next_uniform) const {
+    while (true) {
+      double u = h_integral_n + next_uniform() * (h_integral_x1 - h_integral_n);
+      double x = h_integral_inverse(u);
+      double k = std::floor(x + 0.5);
+      k = std::min(std::max(k, 1.0), n);
+      if (k - x <= s || u >= h_integral(k + 0.5) - h(k))
+        return static_cast<uint64_t>(k);
+    }
+  }
+
+private:
+  double n, exponent;
+  double h_integral_x1, h_integral_n, s;
+
+  double h(double x) const { return std::exp(-exponent * std::log(x)); }
+
+  double h_integral(double x) const {
+    double log_x = std::log(x);
+    return helper2((1.0 - exponent) * log_x) * log_x;
+  }
+
+  double h_integral_inverse(double x) const {
+    double t = std::max(x * (1.0 - exponent), -1.0);
+    return std::exp(helper1(t) * x);
+  }
+
+  // log1p(x)/x 与 expm1(x)/x，x 接近 0（s 接近 1）时用级数避免除零
+  static double helper1(double x) {
+    return std::abs(x) > 1e-8 ? std::log1p(x) / x
+                              : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+  }
+  static double helper2(double x) {
+    return std::abs(x) > 1e-8
+               ? std::expm1(x) / x
+               : 1.0 + x * 0.5 * (1.0 + x * (1.0 / 3.0) * (1.0 + 0.25 * x));
+  }
+};
+
+} // namespace workload_detail
+
+/**
+ * @brief 可复现的顺序随机数流（SplitMix64），满足 UniformRandomBitGenerator
+ *
+ * 实数、区间整数与伯努利采样都由本类自己完成，不依赖各标准库实现不同的
+ * std::*_distribution，同一种子在任何平台上得到同一序列。
+ */
+class RandomStream {
+public:
+  using result_type = uint64_t;
+
+  explicit RandomStream(uint64_t seed) : state(seed) {}
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return UINT64_MAX; }
+
+  result_type operator()() {
+    state += 0x9E3779B97F4A7C15ULL;
+    return workload_detail::mix64(state);
+  }
+
+  // [0, 1) 与 [lo, hi) 内的均匀实数
+  double uniform() { return workload_detail::unit_double((*this)()); }
+  double uniform(double lo, double hi) { return lo + (hi - lo) * uniform(); }
+
+  // [0, bound) 内的均匀整数
+  uint64_t bounded(uint64_t bound) {
+    return workload_detail::bounded((*this)(), bound);
+  }
+
+  bool bernoulli(double p) { return uniform() < p; }
+
+private:
+  uint64_t state;
+};
+
+// 数组输入的分布
+enum class Distribution {
+  kUniform,       // 区间内均匀随机
+  kSorted,        // 非递减（区间内均匀分布的有序样本）
+  kReverseSorted, // 非递增
+  kNearlySorted,  // 有序，但 disorder 比例的位置换成随机值
+  kFewUnique,     // 只有 unique_values 种取值
+  kOrganPipe,     // 先升后降
+  kZipf,          // Zipf 分布的秩，少数热点值占大多数
+  kPermutation    // lo, lo+1, ..., lo+n-1 的随机排列（互不相同）
+};
+
+// 各分布的参数
+struct DistributionParams {
+  double disorder = 0.01;      // kNearlySorted：随机位置的比例
+  uint64_t unique_values = 16; // kFewUnique：不同取值的个数
+  double zipf_exponent = 1.0;  // kZipf：指数 s
+  bool zipf_scramble = false;  // kZipf：把秩打乱到区间内，热点值不再集中在 lo 附近
+};
+
+// 生成图的公共参数
+struct GraphOptions {
+  bool directed = false;
+  bool simple = true; // 去掉自环与平行边
+  int max_weight = 1; // 边权在 [1, max_weight] 内均匀且由端点决定（无向图两个方向相同）
+};
+
+// R-MAT 的象限概率（Graph500 的默认值），d = 1 - a - b - c
+struct RmatParams {
+  double a = 0.57, b = 0.19, c = 0.19;
+  bool scramble_ids = true; // 打乱节点编号，使高度数节点不集中在小编号
+};
+
+/**
+ * @brief 可复现、可并行的基准测试输入生成器
+ *
+ * 每个元素（每条边）都是 (种子, 分布, 参数, 下标) 的纯函数：计数器式随机数
+ * 取代顺序的 std::mt19937，于是
+ * - 同一种子与参数总是得到同一份数据，与线程数、分块方式无关；
+ * - 任意区间可以独立生成，十亿级输入按块并行填充，不需要逐个推进的随机数状态。
+ *
+ * 数组分布：均匀、有序、逆序、近乎有序、少量取值、先升后降（organ pipe）、
+ * Zipf、随机排列；图：R-MAT/Kronecker、二维网格、Erdős–Rényi G(n, p)，
+ * 直接生成为 CSRGraph（节点编号即下标）。
+ */
+class WorkloadGenerator {
+public:
+  static constexpr uint64_t kDefaultSeed = 20250101;
+
+  explicit WorkloadGenerator(uint64_t seed = kDefaultSeed,
+                             size_t num_threads = 1)
+      : seed(seed), num_threads(std::max<size_t>(num_threads, 1)) {}
+
+  uint64_t get_seed() const { return seed; }
+
+  // 第 id 条独立的顺序随机数流，供需要逐个抽样的生成过程使用
+  RandomStream stream(uint64_t id) const {
+    return RandomStream(workload_detail::mix64(seed ^ workload_detail::mix64(id)));
+  }
+
+  /**
+   * @brief 生成 n 个取值在 [lo, hi] 内、服从给定分布的元素
+   *
+   * 整数类型按闭区间处理；浮点类型的 kUniform/kSorted 等落在 [lo, hi)。
+   */
+  template <typename T>
+  std::vector<T> generate(Distribution distribution, size_t n, T lo, T hi,
+                          const DistributionParams &params = {}) {
+    std::vector<T> data(n);
+    fill(distribution, data.data(), n, lo, hi, params);
+    return data;
+  }
+
+  template <typename T>
+  void fill(Distribution distribution, T *out, size_t n, T lo, T hi,
+            const DistributionParams &params = {}) {
+    static_assert(std::is_arithmetic_v<T>, "WorkloadGenerator needs arithmetic T");
+    if (hi < lo)
+      throw std::invalid_argument("WorkloadGenerator: hi < lo");
+    if (n == 0)
+      return;
+    uint64_t key = workload_detail::mix64(
+        seed ^ (0xD1B54A32D192ED03ULL * (static_cast<uint64_t>(distribution) + 1)));
+    Values<T> values(lo, hi, n, key);
+
+    switch (distribution) {
+    case Distribution::kUniform:
+      parallel_fill(out, n, [&](size_t i) { return values.uniform(i); });
+      break;
+    case Distribution::kSorted:
+      parallel_fill(out, n, [&](size_t i) { return values.sorted(i); });
+      break;
+    case Distribution::kReverseSorted:
+      parallel_fill(out, n, [&](size_t i) { return values.sorted(n - 1 - i); });
+      break;
+    case Distribution::kNearlySorted: {
+      uint64_t coin = workload_detail::mix64(key + 1);
+      parallel_fill(out, n, [&](size_t i) {
+        bool scattered = workload_detail::unit_double(
+                             workload_detail::random_at(coin, i)) <
+                         params.disorder;
+        return scattered ? values.uniform(i) : values.sorted(i);
+      });
+      break;
+    }
+    case Distribution::kFewUnique: {
+      uint64_t k = std::min(std::max<uint64_t>(params.unique_values, 1),
+                            values.universe());
+      auto step = values.few_unique_step(k);
+      parallel_fill(out, n, [&](size_t i) { return values.few_unique(i, k, step); });
+      break;
+    }
+    case Distribution::kOrganPipe:
+      parallel_fill(out, n, [&](size_t i) {
+        size_t j = i < (n + 1) / 2 ? i : n - 1 - i;
+        return values.sorted(std::min(2 * j, n - 1));
+      });
+      break;
+    case Distribution::kZipf: {
+      uint64_t universe = values.universe();
+      workload_detail::ZipfSampler sampler(universe, params.zipf_exponent);
+      workload_detail::FeistelPermutation scramble(universe, key + 2);
+      parallel_fill(out, n, [&](size_t i) {
+        uint64_t draw = 0, base = workload_detail::random_at(key, i);
+        uint64_t rank = sampler.sample([&] {
+          return workload_detail::unit_double(
+              workload_detail::random_at(base, draw++));
+        });
+        uint64_t offset = params.zipf_scramble ? scramble(rank - 1) : rank - 1;
+        return values.at_offset(offset);
+      });
+      break;
+    }
+    case Distribution::kPermutation: {
+      if (values.universe() < n)
+        throw std::invalid_argument(
+            "WorkloadGenerator: permutation needs hi - lo + 1 >= n");
+      workload_detail::FeistelPermutation permutation(n, key);
+      parallel_fill(out, n,
+                    [&](size_t i) { return values.at_offset(permutation(i)); });
+      break;
+    }
+    }
+  }
+
+  // 分布名与枚举互转（基准测试的 --distributions 参数使用这些名字）
+  static Distribution parse_distribution(const std::string &name) {
+    for (Distribution d : all_distributions())
+      if (name == distribution_name(d))
+        return d;
+    throw std::invalid_argument("unknown distribution: " + name);
+  }
+
+  static const char *distribution_name(Distribution distribution) {
+    switch (distribution) {
+    case Distribution::kUniform:
+      return "uniform";
+    case Distribution::kSorted:
+      return "sorted";
+    case Distribution::kReverseSorted:
+      return "reverse_sorted";
+    case Distribution::kNearlySorted:
+      return "nearly_sorted";
+    case Distribution::kFewUnique:
+      return "few_unique";
+    case Distribution::kOrganPipe:
+      return "organ_pipe";
+    case Distribution::kZipf:
+      return "zipf";
+    case Distribution::kPermutation:
+      return "permutation";
+    }
+    return "";
+  }
+
+  static std::vector<Distribution> all_distributions() {
+    return {Distribution::kUniform,      Distribution::kSorted,
+            Distribution::kReverseSorted, Distribution::kNearlySorted,
+            Distribution::kFewUnique,    Distribution::kOrganPipe,
+            Distribution::kZipf,         Distribution::kPermutation};
+  }
+
+  static std::vector<std::string> all_distribution_names() {
+    std::vector<std::string> names;
+    for (Distribution d : all_distributions())
+      names.push_back(distribution_name(d));
+    return names;
+  }
+
+  /**
+   * @brief R-MAT 图（Graph500 的 Kronecker 生成器）：2^scale 个节点，
+   * edge_factor × 2^scale 条生成边
+   *
+   * 每条边逐层按 a/b/c/d 概率选择邻接矩阵的象限，得到幂律度数分布与社区结构；
+   * scramble_ids 时再用伪随机置换重新编号。
+   */
+  CSRGraph rmat_graph(unsigned scale, size_t edge_factor,
+                      const GraphOptions &options = {},
+                      const RmatParams &rmat = {}) {
+    if (scale > 30)
+      throw std::invalid_argument("rmat_graph: scale must be at most 30");
+    if (rmat.a < 0 || rmat.b < 0 || rmat.c < 0 || rmat.a + rmat.b + rmat.c > 1)
+      throw std::invalid_argument("rmat_graph: invalid quadrant probabilities");
+    size_t n = size_t(1) << scale;
+    size_t m = edge_factor * n;
+    uint64_t key = workload_detail::mix64(seed ^ 0x52A7'4D41'5400'0001ULL);
+    workload_detail::FeistelPermutation relabel(n, key + 1);
+    // 象限边界换成32位整数阈值；每个64位随机数供两层使用，比较不产生分支
+    auto threshold = [](double p) {
+      return static_cast<uint32_t>(std::min(p, 1.0) * 4294967295.0);
+    };
+    uint32_t t_a = threshold(rmat.a), t_ab = threshold(rmat.a + rmat.b),
+             t_abc = threshold(rmat.a + rmat.b + rmat.c);
+
+    auto edge = [&](size_t e, int &u, int &v) {
+      uint64_t base = workload_detail::random_at(key, e);
+      uint64_t row = 0, col = 0, bits = 0;
+      for (unsigned level = 0; level < scale; level++) {
+        if (level % 2 == 0)
+          bits = workload_detail::random_at(base, level);
+        uint32_t r = static_cast<uint32_t>(bits >> (level % 2 ? 32 : 0));
+        row = row * 2 + (r >= t_ab);
+        col = col * 2 + ((r >= t_a) ^ (r >= t_ab) ^ (r >= t_abc));
+      }
+      if (rmat.scramble_ids) {
+        row = relabel(row);
+        col = relabel(col);
+      }
+      u = static_cast<int>(row);
+      v = static_cast<int>(col);
+    };
+    return build_graph(n, m, kEdgeBlock, options, [&](size_t lo, size_t hi,
+                                                       auto &&emit) {
+      for (size_t e = lo; e < hi; e++) {
+        int u, v;
+        edge(e, u, v);
+        emit(u, v);
+      }
+    });
+  }
+
+  /**
+   * @brief rows × cols 的二维网格，节点 r * cols + c 与右侧、下方相邻
+   *
+   * 无向图四邻接；有向图只生成向右与向下的弧（DAG）。
+   */
+  CSRGraph grid_graph(size_t rows, size_t cols, const GraphOptions &options = {}) {
+    size_t n = rows * cols;
+    if (rows != 0 && n / rows != cols)
+      throw std::invalid_argument("grid_graph: too many nodes");
+    return build_graph(n, rows, 64, options, [&](size_t lo, size_t hi,
+                                                 auto &&emit) {
+      for (size_t r = lo; r < hi; r++) {
+        for (size_t c = 0; c < cols; c++) {
+          int u = static_cast<int>(r * cols + c);
+          if (c + 1 < cols)
+            emit(u, u + 1);
+          if (r + 1 < rows)
+            emit(u, static_cast<int>(u + cols));
+        }
+      }
+    });
+  }
+
+  /**
+   * @brief Erdős–Rényi 随机图 G(n, p)：每个节点对（有向图为每个有序对）
+   * 独立以概率 p 相连
+   *
+   * 每行按几何分布跳过不相连的节点，期望时间 O(n + 边数)，稀疏大图不必枚举 n² 个节点对。
+   */
+  CSRGraph erdos_renyi_graph(size_t n, double p, const GraphOptions &options = {}) {
+    if (!(p >= 0 && p <= 1))
+      throw std::invalid_argument("erdos_renyi_graph: p must be in [0, 1]");
+    uint64_t key = workload_detail::mix64(seed ^ 0x4552'444F'5300'0001ULL);
+    double log_q = std::log1p(-p);
+    bool directed = options.directed;
+    return build_graph(n, n, 256, options, [&](size_t lo, size_t hi,
+                                               auto &&emit) {
+      for (size_t u = lo; u < hi; u++) {
+        if (p <= 0)
+          continue;
+        RandomStream rng(workload_detail::random_at(key, u));
+        // 候选终点：有向图为除 u 外的所有节点，无向图为 u 之后的节点
+        size_t v = directed ? 0 : u + 1;
+        while (v < n) {
+          if (p < 1) {
+            double skip = std::floor(std::log1p(-rng.uniform()) / log_q);
+            if (skip >= static_cast<double>(n - v))
+              break;
+            v += static_cast<size_t>(skip);
+          }
+          if (v != u)
+            emit(static_cast<int>(u), static_cast<int>(v));
+          v++;
+        }
+      }
+    });
+  }
+
+private:
+  static constexpr size_t kFillGrain = size_t(1) << 16;
+  static constexpr size_t kEdgeBlock = size_t(1) << 14;
+
+  uint64_t seed;
+  size_t num_threads;
+  std::unique_ptr<WorkStealingScheduler> scheduler;
+
+  // 把 [0, n) 按 grain 分块执行 body(lo, hi)；单线程或规模小时直接串行
+  template <typename Body> void parallel_blocks(size_t n, size_t grain, const Body &body) {
+    if (num_threads == 1 || n <= grain) {
+      body(0, n);
+      return;
+    }
+    if (!scheduler)
+      scheduler = std::make_unique<WorkStealingScheduler>(num_threads);
+    scheduler->parallel_for(0, n, grain, body);
+  }
+
+  template <typename T, typename F> void parallel_fill(T *out, size_t n, F value_at) {
+    parallel_blocks(n, kFillGrain, [&](size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; i++)
+        out[i] = value_at(i);
+    });
+  }
+
+  /**
+   * @brief 区间 [lo, hi] 上的取值映射
+   *
+   * 整数类型在偏移量 [0, span] 上计算（span 可达 2^64 - 1），浮点类型按比例缩放。
+   */
+  template <typename T, bool Integral = std::is_integral_v<T>> class Values;
+
+  template <typename T> class Values<T, true> {
+  public:
+    using U = std::make_unsigned_t<T>;
+
+    Values(T lo, T hi, size_t n, uint64_t key)
+        : lo(lo), span(static_cast<uint64_t>(static_cast<U>(hi) - static_cast<U>(lo))),
+          n(n), key(key) {
+      unsigned __int128 width = static_cast<unsigned __int128>(span) + 1;
+      quotient = static_cast<uint64_t>(width / n);
+      remainder = static_cast<uint64_t>(width % n);
+      ratio = static_cast<double>(remainder) / static_cast<double>(n);
+    }
+
+    // 不同取值的个数（上限 2^64 - 1）
+    uint64_t universe() const { return span == UINT64_MAX ? span : span + 1; }
+
+    T at_offset(uint64_t offset) const {
+      return static_cast<T>(static_cast<U>(static_cast<U>(lo) + static_cast<U>(offset)));
+    }
+
+    T uniform(size_t i) const {
+      uint64_t r = workload_detail::random_at(key, i);
+      return at_offset(span == UINT64_MAX ? r : workload_detail::bounded(r, span + 1));
+    }
+
+    // 第 i 个元素落在第 i 个等宽小区间内，小区间从左到右不重叠，故整体非递减
+    T sorted(size_t i) const {
+      uint64_t begin = boundary(i), end = boundary(i + 1);
+      return at_offset(begin + workload_detail::bounded(
+                                   workload_detail::random_at(key, i), end - begin));
+    }
+
+    // 第 j 种取值为 j · step，step 由 few_unique_step(k) 预先算好
+    T few_unique(size_t i, uint64_t k, uint64_t step) const {
+      return at_offset(
+          workload_detail::bounded(workload_detail::random_at(key, i), k) * step);
+    }
+
+    uint64_t few_unique_step(uint64_t k) const { return k > 1 ? span / (k - 1) : 0; }
+
+  private:
+    T lo;
+    uint64_t span;
+    size_t n;
+    uint64_t key;
+    uint64_t quotient, remainder; // 区间宽度 = quotient · n + remainder
+    double ratio;                 // remainder / n
+
+    // 第 i 个小区间的左端 i · quotient + ⌊i · remainder / n⌋。
+    // n ≤ 2^32 时第二项用 double 乘法代替除法：舍入单调，误差小于1，
+    // 左端仍随 i 单调且不超过区间宽度，只是小区间宽度可能差一
+    uint64_t boundary(size_t i) const {
+      uint64_t extra =
+          n <= (uint64_t(1) << 32)
+              ? static_cast<uint64_t>(static_cast<double>(i) * ratio)
+              : static_cast<uint64_t>(static_cast<unsigned __int128>(i) * remainder / n);
+      return i * quotient + extra;
+    }
+  };
+
+  template <typename T> class Values<T, false> {
+  public:
+    Values(T lo, T hi, size_t n, uint64_t key)
+        : lo(static_cast<double>(lo)), width(static_cast<double>(hi) - lo), n(n),
+          key(key) {}
+
+    uint64_t universe() const {
+      return static_cast<uint64_t>(std::min(std::floor(width), 9007199254740991.0)) + 1;
+    }
+
+    T at_offset(uint64_t offset) const { return static_cast<T>(lo + offset); }
+
+    T uniform(size_t i) const {
+      return static_cast<T>(
+          lo + width * workload_detail::unit_double(workload_detail::random_at(key, i)));
+    }
+
+    T sorted(size_t i) const {
+      double u = workload_detail::unit_double(workload_detail::random_at(key, i));
+      return static_cast<T>(lo + width * ((static_cast<double>(i) + u) / n));
+    }
+
+    T few_unique(size_t i, uint64_t k, double step) const {
+      uint64_t j = workload_detail::bounded(workload_detail::random_at(key, i), k);
+      return static_cast<T>(lo + step * j);
+    }
+
+    double few_unique_step(uint64_t k) const { return k > 1 ? width / (k - 1) : 0.0; }
+
+  private:
+    double lo, width;
+    size_t n;
+    uint64_t key;
+  };
+
+  /**
+   * @brief 把确定性的边流转成 CSR 图
+   *
+   * generate(lo, hi, emit) 对块 [lo, hi) 内的生成单元（边或行）调用 emit(u, v)，
+   * 同一块两次调用必须发出同样的边。
+   * 1. 并行生成一遍，原子地累加每个节点的出度，前缀和得到偏移；
+   * 2. 再生成一遍，用原子游标把终点写入各行；
+   * 3. 各行排序（行内容是确定的多重集，排序后与线程调度无关），
+   *    simple 时去掉自环与平行边并串行左移压紧；
+   * 4. 按端点计算边权，交给 CSRGraphBuilder::from_csr_arrays。
+   */
+  template <typename Generate>
+  CSRGraph build_graph(size_t n, size_t units, size_t grain,
+                       const GraphOptions &options, const Generate &generate) {
+    if (n > static_cast<size_t>(INT_MAX))
+      throw std::invalid_argument("WorkloadGenerator: graph has too many nodes");
+    if (options.max_weight < 1)
+      throw std::invalid_argument("WorkloadGenerator: max_weight must be >= 1");
+    bool directed = options.directed;
+
+    std::unique_ptr<std::atomic<size_t>[]> cursor(new std::atomic<size_t>[n + 1]);
+    parallel_blocks(n + 1, kFillGrain, [&](size_t lo, size_t hi) {
+      for (size_t i = lo; i < hi; i++)
+        cursor[i].store(0, std::memory_order_relaxed);
+    });
+    parallel_blocks(units, grain, [&](size_t lo, size_t hi) {
+      generate(lo, hi, [&](int u, int v) {
+        cursor[u].fetch_add(1, std::memory_order_relaxed);
+        if (!directed)
+          cursor[v].fetch_add(1, std::memory_order_relaxed);
+      });
+    });
+
+    std::vector<size_t> offsets(n + 1, 0);
+    for (size_t i = 0; i < n; i++) {
+      offsets[i + 1] = offsets[i] + cursor[i].load(std::memory_order_relaxed);
+      cursor[i].store(offsets[i], std::memory_order_relaxed);
+    }
+
+    std::vector<int> targets(offsets[n]);
+    parallel_blocks(units, grain, [&](size_t lo, size_t hi) {
+      generate(lo, hi, [&](int u, int v) {
+        targets[cursor[u].fetch_add(1, std::memory_order_relaxed)] = v;
+        if (!directed)
+          targets[cursor[v].fetch_add(1, std::memory_order_relaxed)] = u;
+      });
+    });
+    cursor.reset();
+
+    // 行排序；simple 时行内去重，新出度暂存在 degree 里
+    std::vector<size_t> degree(n);
+    parallel_blocks(n, 1024, [&](size_t lo, size_t hi) {
+      for (size_t u = lo; u < hi; u++) {
+        auto first = targets.begin() + offsets[u];
+        auto last = targets.begin() + offsets[u + 1];
+        std::sort(first, last);
+        if (options.simple) {
+          last = std::unique(first, last);
+          last = std::remove(first, last, static_cast<int>(u));
+        }
+        degree[u] = static_cast<size_t>(last - first);
+      }
+    });
+    if (options.simple) {
+      size_t write = 0;
+      for (size_t u = 0; u < n; u++) {
+        size_t read = offsets[u];
+        offsets[u] = write;
+        std::copy(targets.begin() + read, targets.begin() + read + degree[u],
+                  targets.begin() + write);
+        write += degree[u];
+      }
+      offsets[n] = write;
+      targets.resize(write);
+    }
+
+    std::vector<int> weights(targets.size(), 1);
+    if (options.max_weight > 1) {
+      uint64_t key = workload_detail::mix64(seed ^ 0x5745'4947'4854'0001ULL);
+      uint64_t range = static_cast<uint64_t>(options.max_weight);
+      parallel_blocks(n, 1024, [&](size_t lo, size_t hi) {
+        for (size_t u = lo; u < hi; u++) {
+          for (size_t e = offsets[u]; e < offsets[u + 1]; e++) {
+            uint64_t a = u, b = static_cast<uint64_t>(targets[e]);
+            if (!directed && b < a)
+              std::swap(a, b);
+            weights[e] = 1 + static_cast<int>(workload_detail::bounded(
+                                 workload_detail::random_at(key, (a << 32) | b),
+                                 range));
+          }
+        }
+      });
+    }
+    return CSRGraphBuilder::from_csr_arrays(std::move(offsets), std::move(targets),
+                                            std::move(weights), directed);
+  }
+};
+
+} // namespace algorithms
+
+#endif // WORKLOAD_GENERATOR_H
@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <utility>
 #include <vector>
 
 using namespace algorithms;
@@ -100,6 +101,52 @@ void test_merge_sort() {
   std::cout << std::endl;
 }
 
+/**
+ * @brief 测试自底向上的自然归并排序
+ */
+void test_natural_merge_sort() {
+  std::cout << "=== 测试自然归并排序算法 ===" << std::endl;
+
+  // 测试用例1：普通数组
+  std::vector<int> arr1 = {5, 2, 4, 6, 1, 3};
+  natural_merge_sort(arr1);
+  assert(arr1 == std::vector<int>({1, 2, 3, 4, 5, 6}));
+  std::cout << "✓ 测试用例1通过" << std::endl;
+
+  // 测试用例2：随机、有序、逆序、近乎有序的大规模数组
+  std::vector<int> random_data =
+      AlgorithmAnalyzer::generate_random_data<int>(5000, 1, 100000);
+  std::vector<int> sorted_data = random_data;
+  std::sort(sorted_data.begin(), sorted_data.end());
+  std::vector<int> reversed_data(sorted_data.rbegin(), sorted_data.rend());
+  std::vector<int> nearly_sorted = sorted_data;
+  for (size_t i = 0; i + 1 < nearly_sorted.size(); i += 97)
+    std::swap(nearly_sorted[i], nearly_sorted[i + 1]);
+  for (const auto &input :
+       {random_data, sorted_data, reversed_data, nearly_sorted}) {
+    std::vector<int> arr = input;
+    natural_merge_sort(arr);
+    assert(arr == sorted_data);
+  }
+  std::cout << "✓ 测试用例2通过（随机/有序/逆序/近乎有序）" << std::endl;
+
+  // 测试用例3：稳定性，按键排序后相同键保持原先的先后次序
+  std::vector<std::pair<int, int>> records;
+  for (int i = 0; i < 1000; i++)
+    records.push_back({(i * 7919) % 10, i});
+  natural_merge_sort(records, [](const auto &a, const auto &b) {
+    return a.first < b.first;
+  });
+  for (size_t i = 1; i < records.size(); i++) {
+    assert(records[i - 1].first < records[i].first ||
+           (records[i - 1].first == records[i].first &&
+            records[i - 1].second < records[i].second));
+  }
+  std::cout << "✓ 测试用例3通过（稳定性）" << std::endl;
+
+  std::cout << std::endl;
+}
+
 /**
  * @brief 测试线性查找算法
  */
@@ -327,6 +374,7 @@ int main() {
   try {
     test_insertion_sort();
     test_merge_sort();
+    test_natural_merge_sort();
     test_linear_search();
     test_binary_search();
     test_selection_sort();
@@ -340,6 +388,7 @@ int main() {
     std::cout << "实现内容：" << std::endl;
     std::cout << "- 插入排序算法（2.1节）" << std::endl;
     std::cout << "- 归并排序算法（2.3节）" << std::endl;
+    std::cout << "- 自底向上的自然归并排序（顺串检测、单缓冲区来回归并）" << std::endl;
     std::cout << "- 线性查找算法（练习2.1-3）" << std::endl;
     std::cout << "- 二分查找算法（练习2.3-5）" << std::endl;
     std::cout << "- 选择排序算法（练习2.2-2）" << std::endl;
@@ -0,0 +1,113 @@
+#include "external_sort.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+// 逐块读回输出文件，检查有序并计算校验和，不把整个文件读进内存
+bool verify(const std::string &path, uint64_t expected_sum, size_t count) {
+  std::ifstream in(path, std::ios::binary);
+  std::vector<uint64_t> block(1 << 16);
+  uint64_t previous = 0, sum = 0;
+  size_t seen = 0;
+  while (in.read(reinterpret_cast<char *>(block.data()),
+                 static_cast<std::streamsize>(block.size() * sizeof(uint64_t))) ||
+         in.gcount() > 0) {
+    size_t got = static_cast<size_t>(in.gcount()) / sizeof(uint64_t);
+    for (size_t i = 0; i < got; ++i) {
+      if (block[i] < previous) {
+        return false;
+      }
+      previous = block[i];
+      sum += block[i];
+    }
+    seen += got;
+  }
+  return seen == count && sum == expected_sum;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: external_sort_benchmark [64位整数个数] [内存预算MB] [工作线程数]
+  size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 32u << 20;
+  size_t budget_mb = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 32;
+  size_t threads = argc > 3 ? std::strtoull(argv[3], nullptr, 10)
+                            : std::max(1u, std::thread::hardware_concurrency());
+  std::string directory = std::filesystem::temp_directory_path().string();
+  std::string input = directory + "/external_sort_benchmark_input.bin";
+  std::string output = directory + "/external_sort_benchmark_output.bin";
+
+  // 分块生成输入文件
+  uint64_t sum = 0;
+  {
+    std::mt19937_64 gen(72);
+    std::ofstream out(input, std::ios::binary | std::ios::trunc);
+    std::vector<uint64_t> block(1 << 16);
+    for (size_t done = 0; done < count; done += block.size()) {
+      size_t n = std::min(block.size(), count - done);
+      for (size_t i = 0; i < n; ++i) {
+        block[i] = gen();
+        sum += block[i];
+      }
+      out.write(reinterpret_cast<const char *>(block.data()),
+                static_cast<std::streamsize>(n * sizeof(uint64_t)));
+    }
+  }
+  double file_mb = count * sizeof(uint64_t) / 1048576.0;
+  std::cout << "输入 " << count << " 个64位整数（" << std::fixed
+            << std::setprecision(0) << file_mb << " MB），" << threads
+            << " 个工作线程" << std::endl;
+
+  // 对照：整个文件读进内存排序再写回（内存预算不限）
+  double in_memory = time_ms([&] {
+    std::ifstream in(input, std::ios::binary);
+    std::vector<uint64_t> data(count);
+    in.read(reinterpret_cast<char *>(data.data()),
+            static_cast<std::streamsize>(count * sizeof(uint64_t)));
+    std::sort(data.begin(), data.end());
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(data.data()),
+              static_cast<std::streamsize>(count * sizeof(uint64_t)));
+  });
+  std::cout << "  读入内存 + std::sort + 写回: " << std::setprecision(0)
+            << in_memory << " ms" << std::endl;
+
+  for (size_t mb : {budget_mb, budget_mb / 4}) {
+    if (mb == 0) {
+      continue;
+    }
+    ExternalSortOptions options;
+    options.memory_budget = mb << 20;
+    options.num_threads = threads;
+    ExternalSorter<uint64_t> sorter(options);
+    ExternalSortStats stats;
+    double ms = time_ms([&] { stats = sorter.sort_file(input, output); });
+    std::cout << "  外部排序，预算 " << mb << " MB: " << ms << " ms（"
+              << std::setprecision(1) << file_mb * 1000 / ms << " MB/s），"
+              << stats.runs << " 个顺串，" << stats.fan_in << " 路 × "
+              << stats.merge_passes << " 趟，读写各 " << std::setprecision(0)
+              << stats.bytes_read / 1048576.0 << " MB"
+              << (verify(output, sum, count) ? "" : " （结果错误）")
+              << std::endl;
+  }
+  std::remove(input.c_str());
+  std::remove(output.c_str());
+  return 0;
+}
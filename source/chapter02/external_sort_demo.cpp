@@ -0,0 +1,168 @@
+#include "external_sort.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace algorithms;
+
+// 日志中的一条事件记录
+struct Event {
+  uint64_t timestamp;
+  uint32_t user;
+  uint32_t kind;
+};
+
+template <typename T>
+void write_file(const std::string &path, const std::vector<T> &data) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char *>(data.data()),
+            static_cast<std::streamsize>(data.size() * sizeof(T)));
+}
+
+template <typename T> std::vector<T> read_file(const std::string &path) {
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  std::vector<T> data(static_cast<size_t>(in.tellg()) / sizeof(T));
+  in.seekg(0);
+  in.read(reinterpret_cast<char *>(data.data()),
+          static_cast<std::streamsize>(data.size() * sizeof(T)));
+  return data;
+}
+
+void print_stats(const ExternalSortStats &stats) {
+  std::cout << "  记录 " << stats.elements << "，初始顺串 " << stats.runs
+            << "，归并路数 " << stats.fan_in << "，归并趟数 "
+            << stats.merge_passes << "，读 " << stats.bytes_read / 1024
+            << " KB，写 " << stats.bytes_written / 1024 << " KB" << std::endl;
+}
+
+void test_integers(const std::string &directory) {
+  std::cout << "=== 测试64位整数文件的外部排序 ===" << std::endl;
+  std::mt19937_64 gen(2025);
+  std::vector<uint64_t> data(1 << 20);
+  for (auto &x : data) {
+    x = gen();
+  }
+  std::string input = directory + "/external_sort_demo_input.bin";
+  std::string output = directory + "/external_sort_demo_output.bin";
+  write_file(input, data);
+  std::vector<uint64_t> expected = data;
+  std::sort(expected.begin(), expected.end());
+
+  struct Case {
+    const char *name;
+    size_t budget, block;
+  };
+  for (const Case &c : {Case{"整个文件放得进内存（8 MB 预算）", 8u << 20, 1u << 20},
+                        Case{"1 MB 预算，一趟归并", 1u << 20, 16u << 10},
+                        Case{"256 KB 预算，多趟归并", 256u << 10, 32u << 10}}) {
+    ExternalSortOptions options;
+    options.memory_budget = c.budget;
+    options.io_block_bytes = c.block;
+    options.num_threads = 4;
+    ExternalSorter<uint64_t> sorter(options);
+    ExternalSortStats stats = sorter.sort_file(input, output);
+    std::cout << c.name << ": "
+              << (read_file<uint64_t>(output) == expected ? "正确" : "错误")
+              << std::endl;
+    print_stats(stats);
+  }
+  std::remove(input.c_str());
+  std::remove(output.c_str());
+  std::cout << std::endl;
+}
+
+void test_records(const std::string &directory) {
+  std::cout << "=== 测试按时间戳排序事件记录 ===" << std::endl;
+  std::mt19937_64 gen(2026);
+  std::vector<Event> events(300000);
+  for (size_t i = 0; i < events.size(); ++i) {
+    // 时间戳只有 5000 种，大量相等
+    events[i] = {1700000000000ULL + gen() % 5000,
+                 static_cast<uint32_t>(gen() % 1000),
+                 static_cast<uint32_t>(i)};
+  }
+  std::string input = directory + "/external_sort_demo_events.bin";
+  std::string output = directory + "/external_sort_demo_events_sorted.bin";
+  write_file(input, events);
+
+  auto by_time = [](const Event &a, const Event &b) {
+    return a.timestamp < b.timestamp;
+  };
+  ExternalSortOptions options;
+  options.memory_budget = 512u << 10;
+  options.io_block_bytes = 8u << 10;
+  options.num_threads = 4;
+  ExternalSorter<Event, decltype(by_time)> sorter(options, by_time);
+  ExternalSortStats stats = sorter.sort_file(input, output);
+  std::vector<Event> sorted = read_file<Event>(output);
+
+  // 按时间戳有序，且与输入是同一批记录
+  auto by_kind = [](const Event &a, const Event &b) { return a.kind < b.kind; };
+  bool ordered = std::is_sorted(sorted.begin(), sorted.end(), by_time);
+  std::vector<Event> a = sorted, b = events;
+  std::sort(a.begin(), a.end(), by_kind);
+  std::sort(b.begin(), b.end(), by_kind);
+  bool same = a.size() == b.size() &&
+              std::equal(a.begin(), a.end(), b.begin(),
+                         [](const Event &x, const Event &y) {
+                           return x.timestamp == y.timestamp &&
+                                  x.user == y.user && x.kind == y.kind;
+                         });
+  std::cout << "16 字节事件记录 " << events.size() << " 条: "
+            << (ordered && same ? "正确" : "错误") << std::endl;
+  print_stats(stats);
+  std::remove(input.c_str());
+  std::remove(output.c_str());
+  std::cout << std::endl;
+}
+
+void test_edge_cases(const std::string &directory) {
+  std::cout << "=== 测试边界情况 ===" << std::endl;
+  std::string input = directory + "/external_sort_demo_edge.bin";
+  std::string output = directory + "/external_sort_demo_edge_sorted.bin";
+  ExternalSorter<uint64_t> sorter;
+
+  write_file(input, std::vector<uint64_t>());
+  ExternalSortStats stats = sorter.sort_file(input, output);
+  std::cout << "空文件: "
+            << (stats.elements == 0 && read_file<uint64_t>(output).empty()
+                    ? "正确"
+                    : "错误")
+            << std::endl;
+
+  write_file(input, std::vector<uint8_t>(13));
+  try {
+    sorter.sort_file(input, output);
+    std::cout << "长度不是记录大小整数倍: 未报错" << std::endl;
+  } catch (const std::invalid_argument &e) {
+    std::cout << "长度不是记录大小整数倍: " << e.what() << std::endl;
+  }
+  try {
+    sorter.sort_file(directory + "/external_sort_demo_missing.bin", output);
+  } catch (const std::runtime_error &e) {
+    std::cout << "输入文件不存在: 抛出 std::runtime_error" << std::endl;
+  }
+  std::remove(input.c_str());
+  std::remove(output.c_str());
+  std::cout << std::endl;
+}
+
+int main() {
+  std::cout << "外部归并排序演示程序" << std::endl;
+  std::cout << "===================" << std::endl;
+  std::string directory = std::filesystem::temp_directory_path().string();
+
+  test_integers(directory);
+  test_records(directory);
+  test_edge_cases(directory);
+
+  std::cout << "所有测试完成！" << std::endl;
+  return 0;
+}
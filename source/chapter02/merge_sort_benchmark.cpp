@@ -0,0 +1,66 @@
+#include "algorithm_basics.h"
+#include "benchmark_harness.h"
+#include "workload_generator.h"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace algorithms;
+
+// 按分布名生成输入；同一规模与分布总是得到相同的数据
+std::vector<int> make_input(size_t n, const std::string &distribution) {
+  WorkloadGenerator generator;
+  if (distribution != "sorted_chunks") {
+    return generator.generate(WorkloadGenerator::parse_distribution(distribution),
+                              n, 0, INT32_MAX);
+  }
+  // 16 段有序数据拼接，例如多个已排序文件
+  std::vector<int> data = generator.generate(Distribution::kUniform, n, 0, INT32_MAX);
+  size_t chunk = n / 16 + 1;
+  for (size_t i = 0; i < n; i += chunk) {
+    std::sort(data.begin() + i, data.begin() + std::min(n, i + chunk));
+  }
+  return data;
+}
+
+template <typename Sort> void bench_sort(BenchmarkState &state, Sort sort) {
+  std::vector<int> input = make_input(state.size(), state.distribution());
+  std::vector<int> arr;
+  state.run([&] { arr = input; }, [&] { sort(arr); });
+  if (!std::is_sorted(arr.begin(), arr.end())) {
+    throw std::runtime_error("result is not sorted");
+  }
+  state.set_items_processed(static_cast<double>(state.size()));
+}
+
+void std_stable_sort(BenchmarkState &state) {
+  bench_sort(state, [](std::vector<int> &arr) {
+    std::stable_sort(arr.begin(), arr.end());
+  });
+}
+
+// 2.3 节自顶向下的归并排序
+void top_down_merge_sort(BenchmarkState &state) {
+  bench_sort(state, [](std::vector<int> &arr) { merge_sort(arr); });
+}
+
+void bottom_up_natural_merge_sort(BenchmarkState &state) {
+  bench_sort(state, [](std::vector<int> &arr) { natural_merge_sort(arr); });
+}
+
+const std::vector<size_t> kSizes = {1 << 12, 1 << 16, 1 << 20};
+const std::vector<std::string> kDistributions = {
+    "uniform",    "sorted",     "reverse_sorted", "nearly_sorted",
+    "few_unique", "organ_pipe", "sorted_chunks"};
+
+ALGORITHMS_BENCHMARK(std_stable_sort).sizes(kSizes).distributions(kDistributions);
+ALGORITHMS_BENCHMARK(top_down_merge_sort)
+    .sizes(kSizes)
+    .distributions(kDistributions);
+ALGORITHMS_BENCHMARK(bottom_up_natural_merge_sort)
+    .sizes(kSizes)
+    .distributions(kDistributions);
+
+ALGORITHMS_BENCHMARK_MAIN()
@@ -1,5 +1,6 @@
 #include "divide_and_conquer.h"
 #include <chrono>
+#include <functional>
 #include <iostream>
 #include <random>
 #include <vector>
@@ -0,0 +1,107 @@
+#include "benchmark_harness.h"
+#include "probabilistic_analysis.h"
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace algorithms;
+
+WorkStealingScheduler &shared_scheduler() {
+  static WorkStealingScheduler scheduler(
+      std::max(1u, std::thread::hardware_concurrency()));
+  return scheduler;
+}
+
+MonteCarloOptions options_for(size_t trials, WorkStealingScheduler *scheduler) {
+  MonteCarloOptions options;
+  options.max_trials = trials;
+  options.seed = 1;
+  options.scheduler = scheduler;
+  return options;
+}
+
+// 生日悖论（23人）：原实现每次试验一个 unordered_map，单个 mt19937
+void birthday_sequential(BenchmarkState &state) {
+  state.run([&] {
+    BenchmarkState::do_not_optimize(
+        ProbabilisticAnalysis::birthday_paradox(23, static_cast<int>(state.size())));
+  });
+  state.set_items_processed(static_cast<double>(state.size()));
+}
+
+void birthday_engine_serial(BenchmarkState &state) {
+  MonteCarloOptions options = options_for(state.size(), nullptr);
+  state.run([&] {
+    BenchmarkState::do_not_optimize(
+        ProbabilisticAnalysis::birthday_paradox(23, options).estimate());
+  });
+  state.set_items_processed(static_cast<double>(state.size()));
+}
+
+void birthday_engine_parallel(BenchmarkState &state) {
+  MonteCarloOptions options = options_for(state.size(), &shared_scheduler());
+  state.run([&] {
+    BenchmarkState::do_not_optimize(
+        ProbabilisticAnalysis::birthday_paradox(23, options).estimate());
+  });
+  state.set_items_processed(static_cast<double>(state.size()));
+}
+
+// 雇佣问题（20个候选人）全部k值：原实现每个k各做一组试验
+void hiring_sequential(BenchmarkState &state) {
+  state.run([&] {
+    BenchmarkState::do_not_optimize(
+        ProbabilisticAnalysis::analyze_optimal_k(20, static_cast<int>(state.size()))
+            .size());
+  });
+  state.set_items_processed(static_cast<double>(state.size()));
+}
+
+void hiring_engine_parallel(BenchmarkState &state) {
+  MonteCarloOptions options = options_for(state.size(), &shared_scheduler());
+  state.run([&] {
+    BenchmarkState::do_not_optimize(
+        ProbabilisticAnalysis::analyze_optimal_k(20, options).estimate());
+  });
+  state.set_items_processed(static_cast<double>(state.size()));
+}
+
+// 洗牌：std::shuffle + mt19937 与嵌套分桶
+void shuffle_std(BenchmarkState &state) {
+  std::vector<uint32_t> data(state.size());
+  std::iota(data.begin(), data.end(), 0u);
+  std::mt19937_64 rng(1);
+  state.run([&] { std::shuffle(data.begin(), data.end(), rng); });
+  state.set_items_processed(static_cast<double>(state.size()));
+}
+
+void shuffle_nested_serial(BenchmarkState &state) {
+  std::vector<uint32_t> data(state.size());
+  std::iota(data.begin(), data.end(), 0u);
+  state.run([&] { ParallelShuffle::shuffle(data, 1); });
+  state.set_items_processed(static_cast<double>(state.size()));
+}
+
+void shuffle_nested_parallel(BenchmarkState &state) {
+  std::vector<uint32_t> data(state.size());
+  std::iota(data.begin(), data.end(), 0u);
+  state.run([&] { ParallelShuffle::shuffle(data, 1, &shared_scheduler()); });
+  state.set_items_processed(static_cast<double>(state.size()));
+}
+
+const std::vector<size_t> kTrials = {10000, 1000000};
+const std::vector<size_t> kElements = {1000000, 10000000, 100000000};
+
+ALGORITHMS_BENCHMARK(birthday_sequential).sizes(kTrials);
+ALGORITHMS_BENCHMARK(birthday_engine_serial).sizes(kTrials);
+ALGORITHMS_BENCHMARK(birthday_engine_parallel).sizes(kTrials);
+ALGORITHMS_BENCHMARK(hiring_sequential).sizes({10000, 100000});
+ALGORITHMS_BENCHMARK(hiring_engine_parallel).sizes({10000, 100000});
+ALGORITHMS_BENCHMARK(shuffle_std).sizes(kElements);
+ALGORITHMS_BENCHMARK(shuffle_nested_serial).sizes(kElements);
+ALGORITHMS_BENCHMARK(shuffle_nested_parallel).sizes(kElements);
+
+ALGORITHMS_BENCHMARK_MAIN()
@@ -0,0 +1,181 @@
+#include "probabilistic_analysis.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+using namespace algorithms;
+
+/**
+ * @brief 测试 Philox4x32-10 与 Random123 的已知答案
+ */
+void test_philox() {
+  std::cout << "=== Philox4x32-10 已知答案测试 ===" << std::endl;
+  auto zero = Philox4x32::generate({0, 0, 0, 0}, {0, 0});
+  auto ones = Philox4x32::generate({0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF},
+                                   {0xFFFFFFFF, 0xFFFFFFFF});
+  if (zero != Philox4x32::Counter{0x6627E8D5, 0xE169C58D, 0xBC57AC4C, 0x9B00DBD8} ||
+      ones != Philox4x32::Counter{0x408F276D, 0x41C83B0E, 0xA20BC7C6, 0x6D5451FD}) {
+    throw std::runtime_error("Philox known-answer mismatch");
+  }
+  std::cout << "全0与全1的计数器、密钥与参考实现一致" << std::endl;
+}
+
+/**
+ * @brief 测试生日悖论：与精确概率比较，并检查不同线程数下结果相同
+ */
+void test_birthday_paradox() {
+  std::cout << "\n=== 生日悖论并行模拟 ===" << std::endl;
+  WorkStealingScheduler one(1), four(4);
+  MonteCarloOptions options;
+  options.max_trials = 200000;
+  options.seed = 5;
+
+  std::cout << std::fixed << std::setprecision(4);
+  for (int n : {10, 23, 50}) {
+    double exact = 1.0, no_collision = 1.0;
+    for (int i = 0; i < n; ++i) {
+      no_collision *= (365.0 - i) / 365.0;
+    }
+    exact -= no_collision;
+
+    options.scheduler = nullptr;
+    MonteCarloResult serial = ProbabilisticAnalysis::birthday_paradox(n, options);
+    options.scheduler = &one;
+    MonteCarloResult single = ProbabilisticAnalysis::birthday_paradox(n, options);
+    options.scheduler = &four;
+    MonteCarloResult parallel = ProbabilisticAnalysis::birthday_paradox(n, options);
+    if (serial.mean != parallel.mean || single.mean != parallel.mean ||
+        serial.variance != parallel.variance) {
+      throw std::runtime_error("result depends on thread count");
+    }
+    std::cout << "n = " << n << ": 估计 " << parallel.estimate() << " ± "
+              << parallel.half_width[0] << "，精确值 " << exact
+              << "（串行、1线程、4线程结果逐位相同）" << std::endl;
+  }
+
+  // 置信区间半宽达到0.002即停止
+  options.max_trials = 100000000;
+  options.target_half_width = 0.002;
+  auto start = std::chrono::steady_clock::now();
+  MonteCarloResult early = ProbabilisticAnalysis::birthday_paradox(23, options);
+  auto elapsed = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start);
+  std::cout << "目标半宽0.002: " << early.trials << " 次试验后停止（上限 "
+            << options.max_trials << "），估计 " << early.estimate() << "，"
+            << std::setprecision(1) << elapsed.count() << " ms" << std::endl;
+}
+
+/**
+ * @brief 测试雇佣问题各k值的成功概率与球与箱子
+ */
+void test_hiring_and_bins() {
+  std::cout << "\n=== 雇佣问题最优k值与球与箱子 ===" << std::endl;
+  WorkStealingScheduler scheduler(4);
+  MonteCarloOptions options;
+  options.max_trials = 100000;
+  options.seed = 2;
+  options.scheduler = &scheduler;
+
+  // 策略k的精确成功概率：(k/n)·Σ_{i=k}^{n-1} 1/i，k = n 时为 1/n
+  int n = 10;
+  MonteCarloResult rates = ProbabilisticAnalysis::analyze_optimal_k(n, options);
+  std::cout << std::setprecision(4);
+  for (int k = 1; k <= n; ++k) {
+    double exact = 1.0 / n;
+    if (k < n) {
+      exact = 0.0;
+      for (int i = k; i < n; ++i) {
+        exact += 1.0 / i;
+      }
+      exact *= static_cast<double>(k) / n;
+    }
+    double error = std::abs(rates.mean[k - 1] - exact);
+    std::cout << "  k=" << k << ": " << rates.mean[k - 1] << " ± "
+              << rates.half_width[k - 1] << "（精确值 " << exact << "）" << std::endl;
+    if (error > 2 * rates.half_width[k - 1] + 1e-3) {
+      throw std::runtime_error("hiring estimate far from exact value");
+    }
+  }
+
+  for (int bins : {10, 100, 1000}) {
+    MonteCarloResult load = ProbabilisticAnalysis::balls_and_bins(bins, bins, options);
+    std::cout << bins << " 个球投入 " << bins << " 个箱子: 最大负载期望 "
+              << load.estimate() << " ± " << load.half_width[0] << std::endl;
+  }
+
+  try {
+    ProbabilisticAnalysis::balls_and_bins(10, 0, options);
+  } catch (const std::invalid_argument &e) {
+    std::cout << "没有箱子: " << e.what() << std::endl;
+  }
+}
+
+/**
+ * @brief 测试嵌套分桶并行洗牌
+ */
+void test_parallel_shuffle() {
+  std::cout << "\n=== 嵌套分桶并行洗牌 ===" << std::endl;
+  WorkStealingScheduler scheduler(4);
+
+  std::vector<int> small = ProbabilisticAnalysis::random_permutation(10, 7, &scheduler);
+  ProbabilisticAnalysis::print_array(small, "10个元素");
+
+  for (size_t n : {size_t(65536), size_t(65537), size_t(1000000), size_t(10000000)}) {
+    std::vector<uint32_t> serial(n), parallel;
+    std::iota(serial.begin(), serial.end(), 0u);
+    parallel = serial;
+    ParallelShuffle::shuffle(serial, 11);
+    ParallelShuffle::shuffle(parallel, 11, &scheduler);
+    if (serial != parallel) {
+      throw std::runtime_error("shuffle depends on thread count");
+    }
+    std::vector<uint32_t> sorted = parallel;
+    std::sort(sorted.begin(), sorted.end());
+    size_t fixed_points = 0;
+    for (size_t i = 0; i < n; ++i) {
+      if (sorted[i] != i) {
+        throw std::runtime_error("shuffle lost an element");
+      }
+      fixed_points += parallel[i] == i;
+    }
+    std::cout << "n = " << std::setw(8) << n << ": 是排列，与串行结果相同，不动点 "
+              << fixed_points << " 个（期望1个）" << std::endl;
+  }
+
+  // 元素0最终位置的分布：分成10段，每段期望 trials/10 次
+  const int trials = 2000;
+  const size_t n = 100000;
+  std::vector<int> histogram(10, 0);
+  std::vector<uint32_t> data(n);
+  for (int t = 0; t < trials; ++t) {
+    std::iota(data.begin(), data.end(), 0u);
+    ParallelShuffle::shuffle(data, static_cast<uint64_t>(t), &scheduler);
+    size_t position = std::find(data.begin(), data.end(), 0u) - data.begin();
+    histogram[position * 10 / n]++;
+  }
+  double chi_square = 0.0;
+  std::cout << "元素0的位置分布:";
+  for (int count : histogram) {
+    std::cout << " " << count;
+    chi_square += (count - trials / 10.0) * (count - trials / 10.0) / (trials / 10.0);
+  }
+  std::cout << "，卡方统计量 " << std::setprecision(2) << chi_square
+            << "（自由度9，1%临界值21.67）" << std::endl;
+}
+
+int main() {
+  std::cout << "蒙特卡罗模拟引擎演示程序" << std::endl;
+  std::cout << "========================" << std::endl;
+
+  test_philox();
+  test_birthday_paradox();
+  test_hiring_and_bins();
+  test_parallel_shuffle();
+
+  std::cout << "\n所有测试完成！" << std::endl;
+  return 0;
+}
@@ -0,0 +1,84 @@
+#include "benchmark_harness.h"
+#include "workload_generator.h"
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace algorithms;
+
+size_t hardware_threads() {
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// 对照：此前各模块的做法，顺序的 std::mt19937 + uniform_int_distribution
+void mt19937_uniform(BenchmarkState &state) {
+  std::vector<uint64_t> data(state.size());
+  state.run([&] {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<uint64_t> dis(0, 1000000000);
+    for (auto &x : data) {
+      x = dis(gen);
+    }
+    BenchmarkState::do_not_optimize(data.data());
+  });
+  state.set_items_processed(static_cast<double>(state.size()));
+}
+
+template <size_t Threads> void generate_array(BenchmarkState &state) {
+  std::vector<uint64_t> data(state.size());
+  WorkloadGenerator generator(42, Threads == 0 ? hardware_threads() : Threads);
+  Distribution distribution =
+      WorkloadGenerator::parse_distribution(state.distribution());
+  // permutation 要求区间不小于元素个数
+  uint64_t hi = std::max<uint64_t>(1000000000, state.size());
+  state.run([&] {
+    generator.fill<uint64_t>(distribution, data.data(), data.size(), 0, hi);
+    BenchmarkState::do_not_optimize(data.data());
+  });
+  state.set_items_processed(static_cast<double>(state.size()));
+}
+
+// 节点数为 size，R-MAT 每节点 16 条边，网格为 √size × √size，G(n,p) 平均度 16
+template <size_t Threads> void generate_graph(BenchmarkState &state) {
+  WorkloadGenerator generator(42, Threads == 0 ? hardware_threads() : Threads);
+  size_t n = state.size();
+  size_t edges = 0;
+  state.run([&] {
+    CSRGraph graph(false);
+    if (state.distribution() == "rmat") {
+      unsigned scale = 0;
+      while ((size_t(2) << scale) <= n) {
+        scale++;
+      }
+      graph = generator.rmat_graph(scale, 16);
+    } else if (state.distribution() == "grid") {
+      size_t side = static_cast<size_t>(std::sqrt(static_cast<double>(n)));
+      graph = generator.grid_graph(side, side);
+    } else {
+      graph = generator.erdos_renyi_graph(n, 16.0 / n);
+    }
+    edges = graph.get_targets().size();
+  });
+  state.set_items_processed(static_cast<double>(edges));
+}
+
+const std::vector<size_t> kArraySizes = {1 << 20, 1 << 24};
+
+ALGORITHMS_BENCHMARK(mt19937_uniform).sizes(kArraySizes);
+ALGORITHMS_BENCHMARK(generate_array<1>)
+    .sizes(kArraySizes)
+    .distributions(WorkloadGenerator::all_distribution_names());
+ALGORITHMS_BENCHMARK(generate_array<0>)
+    .sizes(kArraySizes)
+    .distributions(WorkloadGenerator::all_distribution_names());
+ALGORITHMS_BENCHMARK(generate_graph<1>)
+    .sizes({1 << 16, 1 << 20})
+    .distributions({"rmat", "grid", "erdos_renyi"});
+ALGORITHMS_BENCHMARK(generate_graph<0>)
+    .sizes({1 << 16, 1 << 20})
+    .distributions({"rmat", "grid", "erdos_renyi"});
+
+ALGORITHMS_BENCHMARK_MAIN()
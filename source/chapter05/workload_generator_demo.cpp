@@ -0,0 +1,127 @@
+#include "workload_generator.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename T> void print_prefix(const std::vector<T> &data, size_t count) {
+  for (size_t i = 0; i < std::min(count, data.size()); ++i) {
+    std::cout << data[i] << " ";
+  }
+  std::cout << (data.size() > count ? "..." : "") << std::endl;
+}
+
+void test_distributions() {
+  std::cout << "=== 测试数组分布 ===" << std::endl;
+  WorkloadGenerator generator(2025);
+  for (Distribution d : WorkloadGenerator::all_distributions()) {
+    std::vector<int> data = generator.generate(d, 20, 0, 99);
+    std::cout << WorkloadGenerator::distribution_name(d) << ": ";
+    print_prefix(data, 20);
+  }
+  std::cout << std::endl;
+}
+
+void test_reproducibility() {
+  std::cout << "=== 测试可复现性 ===" << std::endl;
+  // 同一种子：与线程数无关；不同种子：结果不同
+  bool same = true, differs = true;
+  for (Distribution d : WorkloadGenerator::all_distributions()) {
+    WorkloadGenerator serial(7, 1), parallel(7, 4), other(8, 1);
+    auto a = serial.generate<int64_t>(d, 500000, 0, 1 << 30);
+    auto b = parallel.generate<int64_t>(d, 500000, 0, 1 << 30);
+    auto c = other.generate<int64_t>(d, 500000, 0, 1 << 30);
+    same = same && a == b;
+    differs = differs && a != c;
+  }
+  std::cout << "1 线程与 4 线程生成的数据相同: " << (same ? "是" : "否")
+            << std::endl;
+  std::cout << "不同种子生成的数据不同: " << (differs ? "是" : "否") << std::endl;
+
+  // 随机排列是 0..n-1 的一个排列
+  WorkloadGenerator generator(7, 4);
+  auto permutation =
+      generator.generate<uint32_t>(Distribution::kPermutation, 1000000, 0, 999999);
+  std::vector<uint32_t> sorted = permutation;
+  std::sort(sorted.begin(), sorted.end());
+  bool is_permutation = true;
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    is_permutation = is_permutation && sorted[i] == i;
+  }
+  std::cout << "permutation 生成 0..999999 的排列: "
+            << (is_permutation ? "是" : "否") << std::endl;
+  std::cout << std::endl;
+}
+
+void test_zipf() {
+  std::cout << "=== 测试 Zipf 分布 ===" << std::endl;
+  WorkloadGenerator generator(2025, 4);
+  const int universe = 1000;
+  auto data = generator.generate(Distribution::kZipf, 1000000, 1, universe);
+  std::map<int, size_t> count;
+  for (int x : data) {
+    count[x]++;
+  }
+  // s = 1 时 P(k) = 1 / (k · H_N)
+  double harmonic = 0;
+  for (int k = 1; k <= universe; ++k) {
+    harmonic += 1.0 / k;
+  }
+  for (int k : {1, 2, 10, 100}) {
+    std::cout << "值 " << k << ": 频率 " << count[k] / 1e6 << "，理论 "
+              << 1.0 / (k * harmonic) << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+void test_graphs() {
+  std::cout << "=== 测试图生成器 ===" << std::endl;
+  WorkloadGenerator generator(2025, 4);
+
+  CSRGraph rmat = generator.rmat_graph(16, 16);
+  size_t max_degree = 0, isolated = 0;
+  for (size_t u = 0; u < rmat.get_node_count(); ++u) {
+    max_degree = std::max(max_degree, rmat.get_out_degree(u));
+    isolated += rmat.get_out_degree(u) == 0;
+  }
+  std::cout << "R-MAT scale 16: " << rmat.get_node_count() << " 个节点，"
+            << rmat.get_edge_count() << " 条边（去重后），最大度 " << max_degree
+            << "，孤立节点 " << isolated << std::endl;
+
+  CSRGraph grid = generator.grid_graph(300, 400);
+  std::cout << "300×400 网格: " << grid.get_edge_count()
+            << " 条边（应为 239300），从0出发BFS可达 " << grid.bfs(0).size()
+            << " 个节点" << std::endl;
+
+  GraphOptions options;
+  options.max_weight = 100;
+  CSRGraph er = generator.erdos_renyi_graph(100000, 8.0 / 100000, options);
+  int min_weight = 100, max_weight = 1;
+  for (int w : er.get_weights()) {
+    min_weight = std::min(min_weight, w);
+    max_weight = std::max(max_weight, w);
+  }
+  std::cout << "G(n=100000, p=8e-5): " << er.get_edge_count()
+            << " 条边（期望约 " << 8.0 / 100000 * 100000 * 99999 / 2
+            << "），边权范围 [" << min_weight << ", " << max_weight << "]"
+            << std::endl;
+
+  WorkloadGenerator serial(2025, 1);
+  bool same = serial.rmat_graph(16, 16).get_targets() == rmat.get_targets();
+  std::cout << "R-MAT 与线程数无关: " << (same ? "是" : "否") << std::endl;
+  std::cout << std::endl;
+}
+
+int main() {
+  std::cout << "基准测试输入生成器演示程序" << std::endl;
+  std::cout << "=========================" << std::endl;
+  test_distributions();
+  test_reproducibility();
+  test_zipf();
+  test_graphs();
+  std::cout << "所有测试完成！" << std::endl;
+  return 0;
+}
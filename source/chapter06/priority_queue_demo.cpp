@@ -1,5 +1,7 @@
 #include "priority_queue.h"
+#include <chrono>
 #include <iostream>
+#include <random>
 #include <vector>
 
 using namespace algorithms;
@@ -126,6 +128,79 @@ void test_edge_cases() {
   std::cout << std::endl;
 }
 
+void test_indexed_priority_queue() {
+  std::cout << "=== 测试模板化索引优先队列 ===" << std::endl;
+
+  // 最小优先队列：关键字是 (截止时间, 优先级)
+  IndexedPriorityQueue<std::pair<int, int>, std::greater<>> jobs;
+  jobs.insert(7, {30, 1});
+  jobs.insert(2, {10, 2});
+  jobs.insert(5, {20, 3});
+  jobs.update_key(7, {5, 1});  // 提前截止时间：上浮
+  jobs.update_key(2, {40, 2}); // 推迟截止时间：下沉
+  jobs.erase(5);
+  std::cout << "队首任务: " << jobs.top_id() << "（截止时间 "
+            << jobs.top_key().first << "）" << std::endl;
+  std::cout << "任务2的截止时间: " << jobs.key(2).first << std::endl;
+
+  try {
+    jobs.increase_key(2, {50, 2});
+  } catch (const std::runtime_error &e) {
+    std::cout << "INCREASE-KEY 方向错误: " << e.what() << std::endl;
+  }
+
+  // 与暴力扫描对拍
+  std::mt19937 rng(6);
+  const int ids = 1000;
+  IndexedPriorityQueue<int> pq;
+  std::vector<int> reference(ids, -1); // -1 表示不在队列中
+  bool consistent = true;
+  for (int step = 0; step < 200000 && consistent; step++) {
+    int id = rng() % ids;
+    int key = rng() % 100000;
+    switch (rng() % 4) {
+    case 0:
+    case 1:
+      pq.insert_or_update(id, key);
+      reference[id] = key;
+      break;
+    case 2:
+      consistent = pq.erase(id) == (reference[id] != -1);
+      reference[id] = -1;
+      break;
+    default:
+      if (!pq.empty()) {
+        int expected = *std::max_element(reference.begin(), reference.end());
+        auto top = pq.pop();
+        consistent = top.second == expected && reference[top.first] == expected;
+        reference[top.first] = -1;
+      }
+    }
+  }
+  std::cout << "与暴力扫描对拍: " << (consistent ? "通过" : "失败")
+            << std::endl;
+
+  // 调度器负载：10万个任务，100万次改优先级
+  const int tasks = 100000;
+  const int updates = 1000000;
+  IndexedPriorityQueue<int> scheduler;
+  scheduler.reserve(tasks, tasks);
+  for (int id = 0; id < tasks; id++) {
+    scheduler.insert(id, rng() % 1000000);
+  }
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < updates; i++) {
+    scheduler.update_key(rng() % tasks, rng() % 1000000);
+  }
+  double ms = std::chrono::duration<double, std::milli>(
+                  std::chrono::high_resolution_clock::now() - start)
+                  .count();
+  std::cout << tasks << " 个任务上 " << updates << " 次 update_key: " << ms
+            << " ms" << std::endl;
+
+  std::cout << std::endl;
+}
+
 int main() {
   std::cout << "=== 算法导论 6.4节 - 优先队列演示 ===" << std::endl;
   std::cout << std::endl;
@@ -134,6 +209,7 @@ int main() {
   test_enhanced_priority_queue();
   test_priority_queue_operations();
   test_edge_cases();
+  test_indexed_priority_queue();
 
   std::cout << "=== 演示结束 ===" << std::endl;
 
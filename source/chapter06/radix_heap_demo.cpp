@@ -0,0 +1,70 @@
+#include "radix_heap.h"
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace algorithms;
+
+int main() {
+  std::cout << "=== 单调基数堆演示 ===" << std::endl;
+  std::cout << std::endl;
+
+  // 测试1：基本操作
+  std::cout << "测试1：基本操作" << std::endl;
+  RadixHeap<std::string> heap;
+  heap.push(7, "g");
+  heap.push(3, "c");
+  heap.push(12, "l");
+  heap.push(3, "c'");
+  std::cout << "最小关键字: " << heap.top_key() << std::endl;
+
+  std::cout << "弹出: ";
+  auto first = heap.pop();
+  std::cout << first.first << "(" << first.second << ") ";
+  // 单调性：之后插入的关键字不得小于3
+  heap.push(5, "e");
+  while (!heap.empty()) {
+    auto top = heap.pop();
+    std::cout << top.first << "(" << top.second << ") ";
+  }
+  std::cout << std::endl;
+
+  // 测试2：违反单调性
+  std::cout << std::endl << "测试2：违反单调性" << std::endl;
+  try {
+    heap.push(1, "a");
+  } catch (const std::invalid_argument &e) {
+    std::cout << "插入关键字1失败: " << e.what() << "（上次弹出 "
+              << heap.last_key() << "）" << std::endl;
+  }
+
+  // 测试3：模拟Dijkstra的单调工作负载，与 std::priority_queue 对拍
+  std::cout << std::endl << "测试3：与std::priority_queue对拍" << std::endl;
+  std::mt19937 gen(3);
+  RadixHeap<int, std::uint64_t> radix;
+  std::priority_queue<std::uint64_t, std::vector<std::uint64_t>,
+                      std::greater<std::uint64_t>>
+      reference;
+  bool consistent = true;
+  std::uint64_t now = 0;
+  for (int step = 0; step < 100000 && consistent; step++) {
+    if (gen() % 3 != 0 || reference.empty()) {
+      std::uint64_t key = now + gen() % 1000;
+      radix.push(key, step);
+      reference.push(key);
+    } else {
+      now = radix.pop().first;
+      consistent = now == reference.top();
+      reference.pop();
+    }
+  }
+  consistent = consistent && radix.size() == reference.size();
+  std::cout << "对拍结果: " << (consistent ? "通过" : "失败") << std::endl;
+
+  std::cout << std::endl << "=== 演示结束 ===" << std::endl;
+  return 0;
+}
@@ -0,0 +1,97 @@
+#include "quick_sort_generic.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+void report(const char *name, double ms, double baseline, bool ok) {
+  std::cout << "  " << std::left << std::setw(34) << name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(10) << ms
+            << " ms  " << std::setprecision(2) << std::setw(6) << ms / baseline
+            << "× std::sort" << (ok ? "" : "  （结果错误）") << std::endl;
+}
+
+template <typename T>
+void run(const char *title, const std::vector<T> &input, bool textbook) {
+  std::cout << title << std::endl;
+  std::vector<T> expected = input;
+  double baseline =
+      time_ms([&] { std::sort(expected.begin(), expected.end()); });
+  report("std::sort", baseline, baseline, true);
+
+  std::vector<T> arr;
+  double ms;
+  if (textbook) {
+    // 7.1 节的 Lomuto 分区，比较函数为 std::function
+    arr = input;
+    ms = time_ms([&] {
+      QuickSortGeneric<T>::quick_sort(
+          arr, 0, static_cast<int>(arr.size()) - 1,
+          std::function<bool(const T &, const T &)>(
+              [](const T &a, const T &b) { return a <= b; }));
+    });
+    report("quick_sort（Lomuto，std::function）", ms, baseline,
+           arr == expected);
+  }
+  arr = input;
+  ms = time_ms([&] {
+    QuickSortGeneric<T>::introsort(
+        arr, std::function<bool(const T &, const T &)>(
+                 [](const T &a, const T &b) { return a <= b; }));
+  });
+  report("introsort（std::function）", ms, baseline, arr == expected);
+  arr = input;
+  ms = time_ms([&] {
+    QuickSortGeneric<T>::introsort(
+        arr, [](const T &a, const T &b) { return a <= b; });
+  });
+  report("introsort（lambda，块分区）", ms, baseline, arr == expected);
+  arr = input;
+  ms = time_ms([&] { QuickSortGeneric<T>::introsort(arr); });
+  report("introsort（默认比较，AVX2分区）", ms, baseline, arr == expected);
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: quick_sort_benchmark [元素个数]
+  size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+  std::mt19937_64 gen(707);
+
+  std::vector<double> doubles(n);
+  std::uniform_real_distribution<double> real(0.0, 1.0);
+  for (auto &x : doubles) {
+    x = real(gen);
+  }
+  std::cout << n << " 个元素" << std::endl;
+  run("随机 double", doubles, true);
+
+  std::vector<int32_t> ints(n);
+  for (auto &x : ints) {
+    x = static_cast<int32_t>(gen());
+  }
+  run("随机 int32", ints, true);
+
+  for (auto &x : ints) {
+    x = static_cast<int32_t>(gen() % 16);
+  }
+  run("16 种取值的 int32", ints, false);
+
+  std::sort(doubles.begin(), doubles.end());
+  std::reverse(doubles.begin(), doubles.begin() + n / 2);
+  run("前半降序、后半升序的 double", doubles, false);
+  return 0;
+}
@@ -1,5 +1,7 @@
 #include "quick_sort_generic.h"
+#include <algorithm>
 #include <chrono>
+#include <functional>
 #include <iostream>
 #include <random>
 #include <string>
@@ -35,6 +37,57 @@ std::vector<T> generate_random_array(int size, T min_val, T max_val) {
   return arr;
 }
 
+/**
+ * @brief 多种分布下与 std::sort 对照内省排序
+ * @return 结果一致的组数
+ */
+template <typename T, typename Make>
+int check_introsort(const char *name, Make make, std::mt19937 &gen,
+                    int &total) {
+  const std::vector<size_t> sizes = {0, 1, 2, 23, 25, 100, 129, 1000, 100000};
+  int passed = 0;
+  for (size_t n : sizes) {
+    for (int pattern = 0; pattern < 6; ++pattern) {
+      std::vector<T> arr(n);
+      for (size_t i = 0; i < n; ++i) {
+        switch (pattern) {
+        case 0: // 随机
+          arr[i] = make(gen() % 1000000000);
+          break;
+        case 1: // 大量重复
+          arr[i] = make(gen() % 4);
+          break;
+        case 2: // 升序
+          arr[i] = make(i);
+          break;
+        case 3: // 降序
+          arr[i] = make(n - i);
+          break;
+        case 4: // 先升后降
+          arr[i] = make(std::min(i, n - i));
+          break;
+        default: // 全部相等
+          arr[i] = make(7);
+        }
+      }
+      std::vector<T> expected = arr;
+      std::sort(expected.begin(), expected.end());
+      std::vector<T> simd = arr, inlined = arr, wrapped = arr;
+      QuickSortGeneric<T>::sort(simd);
+      QuickSortGeneric<T>::sort(
+          inlined, [](const T &a, const T &b) { return a <= b; });
+      QuickSortGeneric<T>::sort(
+          wrapped,
+          std::function<bool(const T &, const T &)>(
+              [](const T &a, const T &b) { return a <= b; }));
+      passed += simd == expected && inlined == expected && wrapped == expected;
+      ++total;
+    }
+  }
+  std::cout << "  " << name << ": " << passed << " 组一致" << std::endl;
+  return passed;
+}
+
 int main() {
   std::cout << "=== 算法导论 第7章 - 泛型快速排序算法演示 ===" << std::endl;
   std::cout << std::endl;
@@ -194,6 +247,31 @@ int main() {
             << (QuickSortGeneric<int>::is_sorted(reverse) ? "通过" : "失败")
             << std::endl;
 
+  // 测试9：内省排序与 std::sort 对照
+  std::cout << std::endl
+            << "测试9：内省排序与 std::sort 对照（默认比较函数 / lambda / "
+               "std::function）"
+            << std::endl;
+  std::mt19937 check_gen(707);
+  int total = 0, passed = 0;
+  passed += check_introsort<int>(
+      "int", [](size_t x) { return static_cast<int>(x) - 500000000; },
+      check_gen, total);
+  passed += check_introsort<long long>(
+      "long long",
+      [](size_t x) { return static_cast<long long>(x) * -3000000007LL; },
+      check_gen, total);
+  passed += check_introsort<float>(
+      "float", [](size_t x) { return static_cast<float>(x) * 0.5f - 3.0f; },
+      check_gen, total);
+  passed += check_introsort<double>(
+      "double", [](size_t x) { return static_cast<double>(x) / 7.0 - 1e5; },
+      check_gen, total);
+  passed += check_introsort<std::string>(
+      "string", [](size_t x) { return std::to_string(x); }, check_gen, total);
+  std::cout << "内省排序验证: " << passed << " / " << total << " 组通过"
+            << std::endl;
+
   std::cout << std::endl << "=== 泛型快速排序演示结束 ===" << std::endl;
 
   return 0;
@@ -0,0 +1,97 @@
+#include "benchmark_harness.h"
+#include "linear_time_sort.h"
+#include "linear_time_sort_generic.h"
+#include "quick_sort_generic.h"
+#include "workload_generator.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace algorithms;
+
+// 归一化到[0, 1)的输入，教材版桶排序也能处理
+// - uniform: 均匀分布
+// - lognormal: 对数正态的延迟分布（σ = 2），绝大多数元素挤在值域最前端
+// - quantized: 延迟按微秒取整，只有几千种取值
+std::vector<double> make_input(size_t n, const std::string &distribution) {
+  RandomStream random(WorkloadGenerator::kDefaultSeed + n);
+  std::vector<double> data(n);
+  for (double &x : data) {
+    if (distribution == "uniform") {
+      x = random.uniform();
+      continue;
+    }
+    double u1 = 1.0 - random.uniform(), u2 = random.uniform();
+    double normal = std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+    x = std::exp(2.0 * normal);
+    if (distribution == "quantized") {
+      x = std::round(x * 1000.0);
+    } else if (distribution != "lognormal") {
+      throw std::invalid_argument("unknown distribution " + distribution);
+    }
+  }
+  double max_value = *std::max_element(data.begin(), data.end());
+  for (double &x : data) {
+    x /= max_value * (1.0 + 1e-9);
+  }
+  return data;
+}
+
+template <typename Sort> void bench_sort(BenchmarkState &state, Sort sort) {
+  std::vector<double> input = make_input(state.size(), state.distribution());
+  std::vector<double> arr;
+  state.run([&] { arr = input; }, [&] { sort(arr); });
+  if (!std::is_sorted(arr.begin(), arr.end())) {
+    throw std::runtime_error("result is not sorted");
+  }
+  state.set_items_processed(static_cast<double>(state.size()));
+}
+
+void std_sort(BenchmarkState &state) {
+  bench_sort(state,
+             [](std::vector<double> &arr) { std::sort(arr.begin(), arr.end()); });
+}
+
+void introsort(BenchmarkState &state) {
+  bench_sort(state, [](std::vector<double> &arr) {
+    QuickSortGeneric<double>::introsort(arr);
+  });
+}
+
+void radix_sort(BenchmarkState &state) {
+  bench_sort(state, [](std::vector<double> &arr) {
+    RadixSort<double>::sort_in_place(arr);
+  });
+}
+
+// 8.4 节教材版：n 个等宽桶、桶内插入排序
+void textbook_bucket_sort(BenchmarkState &state) {
+  bench_sort(state, [](std::vector<double> &arr) {
+    arr = LinearTimeSort::bucket_sort(arr);
+  });
+}
+
+void adaptive_bucket_sort(BenchmarkState &state) {
+  bench_sort(state, [](std::vector<double> &arr) {
+    BucketSort<double>::adaptive_sort_in_place(arr);
+  });
+}
+
+const std::vector<size_t> kSizes = {1 << 12, 1 << 16, 1 << 20, 1 << 23};
+const std::vector<std::string> kDistributions = {"uniform", "lognormal",
+                                                 "quantized"};
+
+ALGORITHMS_BENCHMARK(std_sort).sizes(kSizes).distributions(kDistributions);
+ALGORITHMS_BENCHMARK(introsort).sizes(kSizes).distributions(kDistributions);
+ALGORITHMS_BENCHMARK(radix_sort).sizes(kSizes).distributions(kDistributions);
+// 偏斜输入上是平方时间，只测较小的规模
+ALGORITHMS_BENCHMARK(textbook_bucket_sort)
+    .sizes({1 << 12, 1 << 16})
+    .distributions(kDistributions);
+ALGORITHMS_BENCHMARK(adaptive_bucket_sort)
+    .sizes(kSizes)
+    .distributions(kDistributions);
+
+ALGORITHMS_BENCHMARK_MAIN()
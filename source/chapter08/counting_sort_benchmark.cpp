@@ -0,0 +1,127 @@
+#include "benchmark_harness.h"
+#include "linear_time_sort.h"
+#include "linear_time_sort_generic.h"
+#include "workload_generator.h"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace algorithms;
+
+// 一条事件记录，按一周中的小时编号（0..167）分桶
+struct Event {
+  uint64_t timestamp;
+  uint32_t user;
+  uint8_t hour_of_week;
+};
+
+constexpr uint8_t kMaxHour = 167;
+
+uint8_t hour_of(const Event &e) { return e.hour_of_week; }
+
+std::vector<Event> make_events(size_t n, const std::string &distribution) {
+  WorkloadGenerator generator;
+  std::vector<uint32_t> hours = generator.generate<uint32_t>(
+      WorkloadGenerator::parse_distribution(distribution), n, 0, kMaxHour);
+  RandomStream random = generator.stream(1);
+  std::vector<Event> events(n);
+  for (size_t i = 0; i < n; ++i) {
+    events[i] = {random(), static_cast<uint32_t>(random.bounded(1000000)),
+                 static_cast<uint8_t>(hours[i])};
+  }
+  return events;
+}
+
+void check_sorted(const std::vector<Event> &events) {
+  if (!std::is_sorted(events.begin(), events.end(),
+                      [](const Event &a, const Event &b) {
+                        return a.hour_of_week < b.hour_of_week;
+                      })) {
+    throw std::runtime_error("result is not sorted");
+  }
+}
+
+void std_stable_sort_events(BenchmarkState &state) {
+  std::vector<Event> input = make_events(state.size(), state.distribution());
+  std::vector<Event> events;
+  state.run([&] { events = input; }, [&] {
+    std::stable_sort(events.begin(), events.end(),
+                     [](const Event &a, const Event &b) {
+                       return a.hour_of_week < b.hour_of_week;
+                     });
+  });
+  check_sorted(events);
+  state.set_items_processed(static_cast<double>(state.size()));
+}
+
+// 输出数组与工作区在各次迭代间复用
+void counting_sort_events(BenchmarkState &state, size_t num_threads) {
+  std::vector<Event> input = make_events(state.size(), state.distribution());
+  std::vector<Event> events;
+  CountingSortWorkspace workspace;
+  WorkStealingScheduler scheduler(num_threads);
+  events.resize(input.size());
+  state.run([&] {
+    CountingSort<uint8_t>::sort_records(input.data(),
+                                        input.data() + input.size(),
+                                        events.data(), hour_of, kMaxHour,
+                                        workspace, scheduler);
+  });
+  check_sorted(events);
+  state.set_items_processed(static_cast<double>(state.size()));
+  state.set_label(std::to_string(num_threads) + " threads");
+}
+
+void counting_sort_events_serial(BenchmarkState &state) {
+  counting_sort_events(state, 1);
+}
+
+void counting_sort_events_parallel(BenchmarkState &state) {
+  counting_sort_events(state,
+                       std::max(1u, std::thread::hardware_concurrency()));
+}
+
+// 只有键的整数数组：教材版与并行版对比
+void textbook_counting_sort_keys(BenchmarkState &state) {
+  WorkloadGenerator generator;
+  std::vector<int> keys = generator.generate<int>(
+      WorkloadGenerator::parse_distribution(state.distribution()), state.size(),
+      0, kMaxHour);
+  std::vector<int> sorted;
+  state.run([&] { sorted = LinearTimeSort::counting_sort(keys, kMaxHour); });
+  state.set_items_processed(static_cast<double>(state.size()));
+}
+
+void generic_counting_sort_keys(BenchmarkState &state) {
+  WorkloadGenerator generator;
+  std::vector<int> keys = generator.generate<int>(
+      WorkloadGenerator::parse_distribution(state.distribution()), state.size(),
+      0, kMaxHour);
+  std::vector<int> sorted;
+  state.run([&] { sorted = CountingSort<int>::sort(keys, kMaxHour); });
+  state.set_items_processed(static_cast<double>(state.size()));
+}
+
+const std::vector<size_t> kSizes = {1 << 12, 1 << 16, 1 << 20, 1 << 22};
+const std::vector<std::string> kDistributions = {"uniform", "zipf", "sorted"};
+
+ALGORITHMS_BENCHMARK(std_stable_sort_events)
+    .sizes(kSizes)
+    .distributions(kDistributions);
+ALGORITHMS_BENCHMARK(counting_sort_events_serial)
+    .sizes(kSizes)
+    .distributions(kDistributions);
+ALGORITHMS_BENCHMARK(counting_sort_events_parallel)
+    .sizes(kSizes)
+    .distributions(kDistributions);
+ALGORITHMS_BENCHMARK(textbook_counting_sort_keys)
+    .sizes(kSizes)
+    .distributions(kDistributions);
+ALGORITHMS_BENCHMARK(generic_counting_sort_keys)
+    .sizes(kSizes)
+    .distributions(kDistributions);
+
+ALGORITHMS_BENCHMARK_MAIN()
@@ -1,8 +1,13 @@
 #include "linear_time_sort_generic.h"
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <numeric>
 #include <random>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 using namespace algorithms;
@@ -263,6 +268,253 @@ int main() {
 
   std::cout << "类型安全检查: 通过（不兼容的类型会在编译时报错）" << std::endl;
 
+  // 测试11：字节数位的并行基数排序
+  std::cout << std::endl << "测试11：字节数位的并行基数排序" << std::endl;
+
+  // 有符号整数（含负数）
+  std::vector<int> signed_test =
+      generate_random_int_array<int>(100000, -1000000, 1000000);
+  std::vector<int> signed_expected = signed_test;
+  std::sort(signed_expected.begin(), signed_expected.end());
+  std::cout << "有符号整数基数排序: "
+            << (RadixSort<int>::sort(signed_test, 4) == signed_expected ? "通过"
+                                                                       : "失败")
+            << std::endl;
+
+  // 浮点数（含负数、正负零和无穷）
+  std::vector<double> double_test =
+      generate_random_double_array<double>(100000, -1e6, 1e6);
+  double_test.push_back(-0.0);
+  double_test.push_back(0.0);
+  double_test.push_back(std::numeric_limits<double>::infinity());
+  double_test.push_back(-std::numeric_limits<double>::infinity());
+  std::vector<double> double_result = RadixSort<double>::sort(double_test, 4);
+  std::vector<double> double_expected = double_test;
+  std::sort(double_expected.begin(), double_expected.end());
+  std::cout << "浮点数基数排序: "
+            << (double_result == double_expected ? "通过" : "失败")
+            << std::endl;
+
+  // argsort：稳定，相等键保持原下标顺序
+  std::vector<long long> key_test =
+      generate_random_int_array<long long>(100000, -50, 50);
+  std::vector<size_t> order = RadixSort<long long>::argsort(key_test, 4);
+  std::vector<size_t> expected_order(key_test.size());
+  std::iota(expected_order.begin(), expected_order.end(), size_t(0));
+  std::stable_sort(expected_order.begin(), expected_order.end(),
+                   [&](size_t a, size_t b) { return key_test[a] < key_test[b]; });
+  std::cout << "argsort（稳定）: " << (order == expected_order ? "通过" : "失败")
+            << std::endl;
+
+  // 键值对排序
+  std::vector<uint32_t> pair_keys = {5, 3, 5, 1, 3};
+  std::vector<std::string> pair_values = {"a", "b", "c", "d", "e"};
+  RadixSort<uint32_t>::sort_by_key(pair_keys, pair_values, 2);
+  std::cout << "键值对排序: ";
+  for (size_t i = 0; i < pair_keys.size(); ++i) {
+    std::cout << pair_keys[i] << ":" << pair_values[i] << " ";
+  }
+  std::cout << std::endl;
+
+  // 64位键的性能
+  std::vector<uint64_t> large_test(2000000);
+  std::mt19937_64 gen64(42);
+  for (auto &x : large_test) {
+    x = gen64();
+  }
+  std::vector<uint64_t> std_large = large_test;
+  auto start_large = std::chrono::high_resolution_clock::now();
+  std::sort(std_large.begin(), std_large.end());
+  auto end_large = std::chrono::high_resolution_clock::now();
+  std::cout << "2e6个64位键 std::sort - 时间: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(
+                   end_large - start_large)
+                   .count()
+            << " 微秒" << std::endl;
+  start_large = std::chrono::high_resolution_clock::now();
+  RadixSort<uint64_t>::sort_in_place(large_test);
+  end_large = std::chrono::high_resolution_clock::now();
+  std::cout << "2e6个64位键 基数排序 - 时间: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(
+                   end_large - start_large)
+                   .count()
+            << " 微秒" << std::endl;
+  std::cout << "2e6个64位键 基数排序 - 排序验证: "
+            << (large_test == std_large ? "通过" : "失败") << std::endl;
+
+  // 测试12：并行计数排序与按键排序记录
+  std::cout << std::endl << "测试12：并行计数排序与按键排序记录" << std::endl;
+
+  // 事件按一周中的小时编号（0..167）分桶，记录整体随键移动且保持原顺序
+  struct Event {
+    uint64_t timestamp;
+    uint32_t user;
+    uint8_t hour_of_week;
+  };
+  std::vector<Event> events(300000);
+  for (size_t i = 0; i < events.size(); ++i) {
+    events[i] = {1700000000000ULL + i, static_cast<uint32_t>(gen64() % 1000),
+                 static_cast<uint8_t>(gen64() % 168)};
+  }
+  auto hour_of = [](const Event &e) { return e.hour_of_week; };
+  auto by_hour = [](const Event &a, const Event &b) {
+    return a.hour_of_week < b.hour_of_week;
+  };
+  auto same_events = [](const std::vector<Event> &a,
+                        const std::vector<Event> &b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                      [](const Event &x, const Event &y) {
+                        return x.timestamp == y.timestamp &&
+                               x.user == y.user &&
+                               x.hour_of_week == y.hour_of_week;
+                      });
+  };
+  std::vector<Event> expected_events = events;
+  std::stable_sort(expected_events.begin(), expected_events.end(), by_hour);
+
+  CountingSortWorkspace workspace;
+  std::vector<Event> sorted_events;
+  bool records_ok = true;
+  for (size_t threads : {1, 4}) {
+    CountingSort<uint8_t>::sort_records(events, sorted_events, hour_of, 167,
+                                        workspace, threads);
+    records_ok = records_ok && same_events(sorted_events, expected_events);
+  }
+  std::cout << "按小时稳定排序事件（1线程与4线程、复用工作区）: "
+            << (records_ok ? "通过" : "失败") << std::endl;
+
+  // 工作区给出每个小时在输出中的区间
+  bool buckets_ok = workspace.bucket_begin.size() == 169 &&
+                    workspace.bucket_begin[168] == events.size();
+  for (size_t h = 0; h < 168 && buckets_ok; ++h) {
+    for (size_t i = workspace.bucket_begin[h];
+         i < workspace.bucket_begin[h + 1]; ++i) {
+      buckets_ok = buckets_ok && size_t(sorted_events[i].hour_of_week) == h;
+    }
+  }
+  std::cout << "各小时的桶区间: " << (buckets_ok ? "通过" : "失败")
+            << "（第0小时 " << workspace.bucket_begin[1] - workspace.bucket_begin[0]
+            << " 条）" << std::endl;
+
+  // 使用调用者的调度器
+  WorkStealingScheduler scheduler(4);
+  std::vector<Event> scheduled_events(events.size());
+  CountingSort<uint8_t>::sort_records(events.data(),
+                                      events.data() + events.size(),
+                                      scheduled_events.data(), hour_of, 167,
+                                      workspace, scheduler);
+  std::cout << "使用外部调度器: "
+            << (same_events(scheduled_events, expected_events) ? "通过"
+                                                               : "失败")
+            << std::endl;
+
+  // 含负数与类型极值的通用版本
+  std::vector<int> wide_test =
+      generate_random_int_array<int>(200000, -500, 500);
+  std::vector<int> wide_expected = wide_test;
+  std::sort(wide_expected.begin(), wide_expected.end());
+  std::cout << "多线程通用计数排序（[-500, 500]）: "
+            << (CountingSort<int>::sort_general(wide_test, -500, 500, 4) ==
+                        wide_expected
+                    ? "通过"
+                    : "失败")
+            << std::endl;
+  std::vector<int8_t> byte_test = {127, -128, 0, -1, 1, -128, 127};
+  std::vector<int8_t> byte_result =
+      CountingSort<int8_t>::sort_general(byte_test, -128, 127);
+  std::cout << "int8_t全范围: "
+            << (std::is_sorted(byte_result.begin(), byte_result.end())
+                    ? "通过"
+                    : "失败")
+            << std::endl;
+
+  // 键值对排序
+  std::vector<int> count_keys = {3, 1, 3, 0, 1};
+  std::vector<std::string> count_values = {"a", "b", "c", "d", "e"};
+  CountingSort<int>::sort_by_key(count_keys, count_values, 3);
+  std::cout << "计数排序键值对: ";
+  for (size_t i = 0; i < count_keys.size(); ++i) {
+    std::cout << count_keys[i] << ":" << count_values[i] << " ";
+  }
+  std::cout << std::endl;
+
+  // 超出范围的键
+  try {
+    CountingSort<uint8_t>::sort_records(events, hour_of, 100, 4);
+    std::cout << "键超出范围: 未报错" << std::endl;
+  } catch (const std::invalid_argument &e) {
+    std::cout << "键超出范围: " << e.what() << std::endl;
+  }
+  try {
+    CountingSort<int>::sort_general(wide_test, 0, 500);
+    std::cout << "元素小于min_val: 未报错" << std::endl;
+  } catch (const std::invalid_argument &e) {
+    std::cout << "元素小于min_val: " << e.what() << std::endl;
+  }
+
+  // 测试13：按样本定桶的自适应桶排序
+  std::cout << std::endl << "测试13：按样本定桶的自适应桶排序" << std::endl;
+
+  // 对数正态的延迟分布：大部分元素挤在值域最前端，等宽桶会严重倾斜
+  std::lognormal_distribution<double> latency(0.0, 2.0);
+  std::vector<double> skewed(1 << 20);
+  for (auto &x : skewed) {
+    x = latency(gen64);
+  }
+  std::vector<double> skewed_expected = skewed;
+  std::sort(skewed_expected.begin(), skewed_expected.end());
+  bool skewed_ok = true;
+  for (size_t threads : {1, 4}) {
+    skewed_ok = skewed_ok && BucketSort<double>::adaptive_sort(skewed, threads) ==
+                                 skewed_expected;
+  }
+  std::cout << "偏斜的延迟数据（1线程与4线程）: "
+            << (skewed_ok ? "通过" : "失败") << std::endl;
+
+  // 按毫秒取整，大量重复值进入相等桶
+  std::vector<double> quantized = skewed;
+  for (auto &x : quantized) {
+    x = std::round(x);
+  }
+  std::vector<double> quantized_expected = quantized;
+  std::sort(quantized_expected.begin(), quantized_expected.end());
+  std::cout << "大量重复值: "
+            << (BucketSort<double>::adaptive_sort(quantized, 4) ==
+                        quantized_expected
+                    ? "通过"
+                    : "失败")
+            << std::endl;
+
+  std::vector<float> constant(100000, 2.5f);
+  std::cout << "全部相等: "
+            << (BucketSort<float>::adaptive_sort(constant) == constant ? "通过"
+                                                                        : "失败")
+            << std::endl;
+
+  // 负数、正负零与无穷
+  std::vector<float> mixed =
+      generate_random_double_array<float>(50000, -1e3f, 1e3f);
+  mixed.push_back(-0.0f);
+  mixed.push_back(0.0f);
+  mixed.push_back(std::numeric_limits<float>::infinity());
+  mixed.push_back(-std::numeric_limits<float>::infinity());
+  std::vector<float> mixed_result = BucketSort<float>::adaptive_sort(mixed, 4);
+  std::cout << "负数与无穷: "
+            << (std::is_sorted(mixed_result.begin(), mixed_result.end()) &&
+                        mixed_result.size() == mixed.size()
+                    ? "通过"
+                    : "失败")
+            << std::endl;
+
+  std::vector<double> with_nan = skewed;
+  with_nan[12345] = std::numeric_limits<double>::quiet_NaN();
+  try {
+    BucketSort<double>::adaptive_sort(with_nan);
+    std::cout << "含NaN: 未报错" << std::endl;
+  } catch (const std::invalid_argument &e) {
+    std::cout << "含NaN: " << e.what() << std::endl;
+  }
+
   std::cout << std::endl << "=== 泛型线性时间排序演示结束 ===" << std::endl;
 
   return 0;
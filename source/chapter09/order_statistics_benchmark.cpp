@@ -0,0 +1,138 @@
+#include "benchmark_harness.h"
+#include "order_statistics.h"
+#include "workload_generator.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace algorithms;
+
+// 指标聚合的典型查询：p50/p90/p99/p999
+const std::vector<double> kProbabilities = {0.5, 0.9, 0.99, 0.999};
+
+std::vector<double> make_input(size_t n, const std::string &distribution) {
+  WorkloadGenerator generator;
+  return generator.generate<double>(
+      WorkloadGenerator::parse_distribution(distribution), n, 0.0, 1e6);
+}
+
+std::vector<size_t> ranks_of(size_t n) {
+  std::vector<size_t> ranks;
+  for (double q : kProbabilities) {
+    size_t rank = static_cast<size_t>(std::ceil(q * static_cast<double>(n)));
+    ranks.push_back(std::max<size_t>(rank, 1) - 1);
+  }
+  return ranks;
+}
+
+// select(arr, ranks, out) 写出各秩的元素；结果与完全排序比对
+template <typename Select>
+void bench_quantiles(BenchmarkState &state, Select select) {
+  std::vector<double> input = make_input(state.size(), state.distribution());
+  std::vector<size_t> ranks = ranks_of(input.size());
+  std::vector<double> arr, values(ranks.size());
+  state.run([&] { arr = input; }, [&] { select(arr, ranks, values); });
+  std::vector<double> sorted = input;
+  std::sort(sorted.begin(), sorted.end());
+  for (size_t j = 0; j < ranks.size(); ++j) {
+    if (values[j] != sorted[ranks[j]]) {
+      throw std::runtime_error("wrong quantile");
+    }
+  }
+  state.set_items_processed(static_cast<double>(state.size()));
+}
+
+void quantiles_std_sort(BenchmarkState &state) {
+  bench_quantiles(state, [](std::vector<double> &arr,
+                            const std::vector<size_t> &ranks,
+                            std::vector<double> &values) {
+    std::sort(arr.begin(), arr.end());
+    for (size_t j = 0; j < ranks.size(); ++j)
+      values[j] = arr[ranks[j]];
+  });
+}
+
+void quantiles_std_nth_element(BenchmarkState &state) {
+  bench_quantiles(state, [](std::vector<double> &arr,
+                            const std::vector<size_t> &ranks,
+                            std::vector<double> &values) {
+    for (size_t j = 0; j < ranks.size(); ++j) {
+      std::nth_element(arr.begin(), arr.begin() + ranks[j], arr.end());
+      values[j] = arr[ranks[j]];
+    }
+  });
+}
+
+void quantiles_introselect(BenchmarkState &state) {
+  bench_quantiles(state, [](std::vector<double> &arr,
+                            const std::vector<size_t> &ranks,
+                            std::vector<double> &values) {
+    for (size_t j = 0; j < ranks.size(); ++j)
+      values[j] = OrderStatistics::introselect(arr, ranks[j]);
+  });
+}
+
+void quantiles_floyd_rivest(BenchmarkState &state) {
+  bench_quantiles(state, [](std::vector<double> &arr,
+                            const std::vector<size_t> &ranks,
+                            std::vector<double> &values) {
+    for (size_t j = 0; j < ranks.size(); ++j)
+      values[j] = OrderStatistics::floyd_rivest_select(arr, ranks[j]);
+  });
+}
+
+void quantiles_select_many(BenchmarkState &state) {
+  bench_quantiles(state, [](std::vector<double> &arr,
+                            const std::vector<size_t> &ranks,
+                            std::vector<double> &values) {
+    values = OrderStatistics::select_many(arr, ranks);
+  });
+}
+
+void min_max_std_minmax_element(BenchmarkState &state) {
+  std::vector<double> input = make_input(state.size(), state.distribution());
+  state.run([&] {
+    auto [lo, hi] = std::minmax_element(input.begin(), input.end());
+    BenchmarkState::do_not_optimize(*lo + *hi);
+  });
+  state.set_items_processed(static_cast<double>(state.size()));
+}
+
+void min_max_find_min_max(BenchmarkState &state) {
+  std::vector<double> input = make_input(state.size(), state.distribution());
+  state.run([&] {
+    auto [lo, hi] = OrderStatistics::find_min_max(input);
+    BenchmarkState::do_not_optimize(lo + hi);
+  });
+  state.set_items_processed(static_cast<double>(state.size()));
+}
+
+const std::vector<size_t> kSizes = {1 << 12, 1 << 16, 1 << 20, 1 << 23};
+const std::vector<std::string> kDistributions = {"uniform", "zipf",
+                                                 "few_unique", "sorted"};
+
+ALGORITHMS_BENCHMARK(quantiles_std_sort)
+    .sizes(kSizes)
+    .distributions(kDistributions);
+ALGORITHMS_BENCHMARK(quantiles_std_nth_element)
+    .sizes(kSizes)
+    .distributions(kDistributions);
+ALGORITHMS_BENCHMARK(quantiles_introselect)
+    .sizes(kSizes)
+    .distributions(kDistributions);
+ALGORITHMS_BENCHMARK(quantiles_floyd_rivest)
+    .sizes(kSizes)
+    .distributions(kDistributions);
+ALGORITHMS_BENCHMARK(quantiles_select_many)
+    .sizes(kSizes)
+    .distributions(kDistributions);
+ALGORITHMS_BENCHMARK(min_max_std_minmax_element)
+    .sizes(kSizes)
+    .distributions({"uniform"});
+ALGORITHMS_BENCHMARK(min_max_find_min_max)
+    .sizes(kSizes)
+    .distributions({"uniform"});
+
+ALGORITHMS_BENCHMARK_MAIN()
@@ -1,7 +1,9 @@
 #include "order_statistics.h"
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <random>
+#include <string>
 #include <vector>
 
 using namespace algorithms;
@@ -14,6 +16,7 @@ using namespace algorithms;
  * - 9.2节：期望线性时间的选择算法
  * - 9.3节：最坏情况线性时间的选择算法
  * - 中位数查找
+ * - 泛型原地选择：内省选择、Floyd–Rivest选择、一次求多个分位数
  */
 
 void test_min_max() {
@@ -221,6 +224,88 @@ void test_edge_cases() {
   std::cout << std::endl;
 }
 
+void test_generic_selection() {
+  std::cout << "=== 泛型原地选择测试 ===" << std::endl;
+
+  // 对数正态分布的延迟样本（毫秒）
+  std::mt19937_64 gen(2025);
+  std::lognormal_distribution<double> latency(1.0, 1.5);
+  std::vector<double> samples(200000);
+  for (double &x : samples) {
+    x = latency(gen);
+  }
+  std::vector<double> sorted = samples;
+  std::sort(sorted.begin(), sorted.end());
+
+  // 内省选择与Floyd–Rivest选择
+  bool select_ok = true;
+  for (size_t k : {size_t(0), size_t(1234), samples.size() / 2,
+                   samples.size() - 1}) {
+    std::vector<double> a = samples, b = samples;
+    select_ok = select_ok && OrderStatistics::introselect(a, k) == sorted[k] &&
+                OrderStatistics::floyd_rivest_select(b, k) == sorted[k];
+    select_ok = select_ok &&
+                std::all_of(a.begin(), a.begin() + k,
+                            [&](double x) { return x <= sorted[k]; }) &&
+                std::all_of(b.begin() + k, b.end(),
+                            [&](double x) { return x >= sorted[k]; });
+  }
+  std::cout << "内省选择与Floyd–Rivest选择: " << (select_ok ? "正确" : "错误")
+            << std::endl;
+
+  // 一次求出p50/p90/p99/p999
+  std::vector<double> data = samples;
+  std::vector<double> q =
+      OrderStatistics::quantiles(data, {0.5, 0.9, 0.99, 0.999});
+  bool quantiles_ok = true;
+  std::vector<double> probabilities = {0.5, 0.9, 0.99, 0.999};
+  for (size_t j = 0; j < probabilities.size(); ++j) {
+    size_t rank = static_cast<size_t>(
+        std::ceil(probabilities[j] * static_cast<double>(samples.size())));
+    quantiles_ok = quantiles_ok && q[j] == sorted[rank - 1];
+  }
+  std::cout << "p50/p90/p99/p999: " << q[0] << " / " << q[1] << " / " << q[2]
+            << " / " << q[3] << " ms (" << (quantiles_ok ? "正确" : "错误")
+            << ")" << std::endl;
+
+  // select_many：重复的秩、自定义比较函数与字符串
+  std::vector<std::string> words = {"pear",  "apple", "fig",   "kiwi",
+                                    "plum",  "date",  "lime",  "mango",
+                                    "grape", "peach", "lemon", "melon"};
+  std::vector<std::string> by_length =
+      OrderStatistics::select_many(words, {0, 5, 5, 11},
+                                   [](const std::string &a,
+                                      const std::string &b) {
+                                     return a.size() < b.size() ||
+                                            (a.size() == b.size() && a < b);
+                                   });
+  std::cout << "按长度第0、5、5、11名: ";
+  for (const std::string &w : by_length)
+    std::cout << w << " ";
+  std::cout << std::endl;
+
+  try {
+    std::vector<int> small = {3, 1, 2};
+    OrderStatistics::select_many(small, {2, 1});
+    std::cout << "错误：秩未按非降序应该抛出异常" << std::endl;
+  } catch (const std::invalid_argument &e) {
+    std::cout << "✓ 秩的顺序检查: " << e.what() << std::endl;
+  }
+
+  // 向量化的最小值和最大值
+  std::vector<float> floats(samples.begin(), samples.end());
+  auto [min_f, max_f] = OrderStatistics::find_min_max(floats);
+  auto [min_d, max_d] = OrderStatistics::find_min_max(samples);
+  std::cout << "float最小/最大: " << min_f << " / " << max_f << ", double: "
+            << ((min_d == sorted.front() && max_d == sorted.back() &&
+                 min_f == *std::min_element(floats.begin(), floats.end()) &&
+                 max_f == *std::max_element(floats.begin(), floats.end()))
+                    ? "正确"
+                    : "错误")
+            << std::endl;
+  std::cout << std::endl;
+}
+
 int main() {
   std::cout << "算法导论第9章 - 中位数和顺序统计量演示程序" << std::endl;
   std::cout << "==========================================" << std::endl;
@@ -231,6 +316,7 @@ int main() {
   test_linear_time_select();
   test_algorithm_comparison();
   test_edge_cases();
+  test_generic_selection();
 
   std::cout << "=== 所有测试完成 ===" << std::endl;
   std::cout << "第9章中位数和顺序统计量算法实现验证成功！" << std::endl;
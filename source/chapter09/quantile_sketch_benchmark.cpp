@@ -0,0 +1,83 @@
+#include "benchmark_harness.h"
+#include "order_statistics.h"
+#include "quantile_sketch.h"
+#include "workload_generator.h"
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace algorithms;
+
+// 指标聚合的典型查询：p50/p90/p99/p999
+const std::vector<double> kProbabilities = {0.5, 0.9, 0.99, 0.999};
+
+std::vector<double> make_input(size_t n, const std::string &distribution) {
+  WorkloadGenerator generator;
+  return generator.generate<double>(
+      WorkloadGenerator::parse_distribution(distribution), n, 0.0, 1e6);
+}
+
+// 精确做法：保存全部样本，再用 select_many 一次求出各分位数
+void exact_buffer_select_many(BenchmarkState &state) {
+  std::vector<double> input = make_input(state.size(), state.distribution());
+  std::vector<double> buffer;
+  state.run([&] {
+    buffer.clear();
+    for (double x : input)
+      buffer.push_back(x);
+    BenchmarkState::do_not_optimize(
+        OrderStatistics::quantiles(buffer, kProbabilities));
+  });
+  state.set_items_processed(static_cast<double>(state.size()));
+}
+
+// KLL 草图：逐个写入后查询
+void kll_update_query(BenchmarkState &state) {
+  std::vector<double> input = make_input(state.size(), state.distribution());
+  state.run([&] {
+    KllSketch<double> sketch;
+    for (double x : input)
+      sketch.update(x);
+    BenchmarkState::do_not_optimize(sketch.quantiles(kProbabilities));
+  });
+  state.set_items_processed(static_cast<double>(state.size()));
+}
+
+// 多个写线程各自写入私有缓冲区，无锁发布后汇总查询
+void kll_concurrent_update_query(BenchmarkState &state) {
+  std::vector<double> input = make_input(state.size(), state.distribution());
+  size_t threads = std::max(1u, std::thread::hardware_concurrency());
+  state.run([&] {
+    ConcurrentKllSketch<double> sketch;
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+      workers.emplace_back([&, t] {
+        auto writer = sketch.writer();
+        size_t begin = input.size() * t / threads;
+        size_t end = input.size() * (t + 1) / threads;
+        for (size_t i = begin; i < end; ++i)
+          writer.insert(input[i]);
+      });
+    }
+    for (std::thread &worker : workers)
+      worker.join();
+    BenchmarkState::do_not_optimize(sketch.quantiles(kProbabilities));
+  });
+  state.set_items_processed(static_cast<double>(state.size()));
+}
+
+const std::vector<size_t> kSizes = {1 << 16, 1 << 20, 1 << 23};
+const std::vector<std::string> kDistributions = {"uniform", "zipf", "sorted"};
+
+ALGORITHMS_BENCHMARK(exact_buffer_select_many)
+    .sizes(kSizes)
+    .distributions(kDistributions);
+ALGORITHMS_BENCHMARK(kll_update_query)
+    .sizes(kSizes)
+    .distributions(kDistributions);
+ALGORITHMS_BENCHMARK(kll_concurrent_update_query)
+    .sizes(kSizes)
+    .distributions(kDistributions);
+
+ALGORITHMS_BENCHMARK_MAIN()
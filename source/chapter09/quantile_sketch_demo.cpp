@@ -0,0 +1,212 @@
+#include "order_statistics.h"
+#include "quantile_sketch.h"
+#include "workload_generator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <vector>
+
+using namespace algorithms;
+
+/**
+ * @brief 流式近似分位数演示程序
+ *
+ * 演示 KllSketch 与 ConcurrentKllSketch：
+ * - 有界内存下的近似分位数，与 OrderStatistics::find_ith_smallest 的精确结果对照
+ * - 草图合并
+ * - 多线程写入与无锁发布
+ */
+
+// 估计值 estimate 在有序数组 sorted 中可取的秩区间与目标秩 target 的距离
+uint64_t rank_distance(const std::vector<int> &sorted, int estimate,
+                       uint64_t target) {
+  uint64_t lo = static_cast<uint64_t>(
+      std::lower_bound(sorted.begin(), sorted.end(), estimate) -
+      sorted.begin());
+  uint64_t hi = static_cast<uint64_t>(
+      std::upper_bound(sorted.begin(), sorted.end(), estimate) -
+      sorted.begin());
+  if (target <= lo) {
+    return lo + 1 - target;
+  }
+  if (target > hi) {
+    return target - hi;
+  }
+  return 0;
+}
+
+// 每个分位数的秩误差不超过 normalized_rank_error()·n 时返回 true
+bool check_against_exact(const KllSketch<int> &sketch,
+                         const std::vector<int> &data,
+                         const std::vector<double> &probabilities) {
+  std::vector<int> sorted = data;
+  std::sort(sorted.begin(), sorted.end());
+  double n = static_cast<double>(data.size());
+  uint64_t bound =
+      static_cast<uint64_t>(std::ceil(sketch.normalized_rank_error() * n));
+  std::vector<int> estimates = sketch.quantiles(probabilities);
+  bool ok = true;
+  for (size_t j = 0; j < probabilities.size(); ++j) {
+    uint64_t target = std::max<uint64_t>(
+        1, static_cast<uint64_t>(std::ceil(probabilities[j] * n)));
+    std::vector<int> copy = data;
+    int exact =
+        OrderStatistics::find_ith_smallest(copy, static_cast<int>(target));
+    uint64_t distance = rank_distance(sorted, estimates[j], target);
+    std::cout << "  p" << probabilities[j] * 100 << ": 近似 " << estimates[j]
+              << ", 精确 " << exact << ", 秩误差 " << distance << " / "
+              << bound << std::endl;
+    ok = ok && distance <= bound;
+  }
+  return ok;
+}
+
+void test_single_sketch() {
+  std::cout << "=== 单线程草图与精确选择对照 ===" << std::endl;
+
+  const std::vector<double> probabilities = {0.01, 0.25, 0.5,
+                                             0.9,  0.99, 0.999};
+  // 教材版 find_ith_smallest 在大量重复值上退化为平方时间，这里选用取值
+  // 基本互异的分布
+  WorkloadGenerator generator;
+  for (const char *name :
+       {"uniform", "sorted", "nearly_sorted", "organ_pipe", "permutation"}) {
+    std::vector<int> data = generator.generate<int>(
+        WorkloadGenerator::parse_distribution(name), 200000, 0, 1 << 24);
+    KllSketch<int> sketch;
+    for (int x : data) {
+      sketch.update(x);
+    }
+    std::cout << name << ": n = " << sketch.size()
+              << ", 保留样本 " << sketch.retained() << ", 层数 "
+              << sketch.num_levels() << ", 内存 " << sketch.memory_bytes()
+              << " 字节" << std::endl;
+    bool ok = check_against_exact(sketch, data, probabilities);
+    int exact_min = *std::min_element(data.begin(), data.end());
+    int exact_max = *std::max_element(data.begin(), data.end());
+    ok = ok && sketch.min() == exact_min && sketch.max() == exact_max &&
+         sketch.quantile(0.0) == exact_min && sketch.quantile(1.0) == exact_max;
+    std::cout << (ok ? "✓ 误差在界内" : "✗ 误差超出界限") << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+void test_merge() {
+  std::cout << "=== 草图合并 ===" << std::endl;
+
+  WorkloadGenerator generator(7);
+  std::vector<int> data = generator.generate<int>(Distribution::kUniform,
+                                                  300000, -500000, 500000);
+  std::vector<KllSketch<int>> parts;
+  for (size_t p = 0; p < 3; ++p) {
+    parts.emplace_back(KllSketch<int>::kDefaultK, 100 + p);
+  }
+  for (size_t i = 0; i < data.size(); ++i) {
+    parts[i % 3].update(data[i]);
+  }
+  KllSketch<int> merged;
+  for (const KllSketch<int> &part : parts) {
+    merged.merge(part);
+  }
+  std::cout << "三个草图合并后 n = " << merged.size() << ", 保留样本 "
+            << merged.retained() << std::endl;
+  bool ok = merged.size() == data.size() &&
+            check_against_exact(merged, data, {0.1, 0.5, 0.95});
+  std::cout << (ok ? "✓ 合并结果误差在界内" : "✗ 合并结果误差超出界限")
+            << std::endl;
+
+  try {
+    KllSketch<int> other(400);
+    merged.merge(other);
+    std::cout << "错误：k不同的草图合并应该抛出异常" << std::endl;
+  } catch (const std::invalid_argument &e) {
+    std::cout << "✓ k不同的草图合并: " << e.what() << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+void test_concurrent() {
+  std::cout << "=== 多线程写入 ===" << std::endl;
+
+  const size_t threads = 4;
+  const size_t per_thread = 250000;
+  WorkloadGenerator generator(11);
+  std::vector<int> data = generator.generate<int>(
+      Distribution::kPermutation, threads * per_thread, 0, 1 << 24);
+
+  ConcurrentKllSketch<int> sketch(KllSketch<int>::kDefaultK, 4096);
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      auto writer = sketch.writer();
+      for (size_t i = t * per_thread; i < (t + 1) * per_thread; ++i) {
+        writer.insert(data[i]);
+      }
+    });
+  }
+  // 写入期间读者也可以随时查询
+  uint64_t seen = sketch.size();
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+
+  KllSketch<int> snapshot = sketch.snapshot();
+  std::cout << threads << " 个线程共写入 " << snapshot.size()
+            << " 个观测值（写入期间读者看到 " << seen << " 个），保留样本 "
+            << snapshot.retained() << std::endl;
+  bool ok = snapshot.size() == data.size() &&
+            check_against_exact(snapshot, data, {0.5, 0.9, 0.99});
+  std::cout << (ok ? "✓ 并发写入结果误差在界内" : "✗ 并发写入结果误差超出界限")
+            << std::endl;
+  std::cout << std::endl;
+}
+
+void test_edge_cases() {
+  std::cout << "=== 边界情况 ===" << std::endl;
+
+  KllSketch<double> sketch;
+  try {
+    sketch.quantile(0.5);
+    std::cout << "错误：空草图应该抛出异常" << std::endl;
+  } catch (const std::runtime_error &e) {
+    std::cout << "✓ 空草图查询: " << e.what() << std::endl;
+  }
+
+  sketch.update(std::numeric_limits<double>::quiet_NaN());
+  sketch.update(2.5);
+  std::cout << "NaN被忽略，n = " << sketch.size() << ", 中位数 "
+            << sketch.quantile(0.5) << std::endl;
+
+  try {
+    sketch.quantile(1.5);
+    std::cout << "错误：分位数越界应该抛出异常" << std::endl;
+  } catch (const std::invalid_argument &e) {
+    std::cout << "✓ 分位数越界: " << e.what() << std::endl;
+  }
+
+  try {
+    KllSketch<int> tiny(4);
+    std::cout << "错误：k过小应该抛出异常" << std::endl;
+  } catch (const std::invalid_argument &e) {
+    std::cout << "✓ k过小: " << e.what() << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+int main() {
+  std::cout << "流式近似分位数（KLL草图）演示程序" << std::endl;
+  std::cout << "==================================" << std::endl;
+  std::cout << std::endl;
+
+  test_single_sketch();
+  test_merge();
+  test_concurrent();
+  test_edge_cases();
+
+  std::cout << "=== 所有测试完成 ===" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,206 @@
+#include "benchmark_harness.h"
+#include "linked_list.h"
+#include "workload_generator.h"
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace algorithms;
+
+// 搜索：n 个元素的链表上做 kSearches 次 LIST-SEARCH，一半命中一半不命中
+const size_t kSearches = 64;
+
+std::vector<int> search_keys(size_t n) {
+  std::vector<int> keys;
+  for (size_t i = 0; i < kSearches; ++i) {
+    keys.push_back(static_cast<int>(i % 2 == 0 ? (i * 7919) % n : n + i));
+  }
+  return keys;
+}
+
+void doubly_linked_list_search(BenchmarkState &state) {
+  size_t n = state.size();
+  DoublyLinkedList<int> list;
+  for (size_t i = 0; i < n; ++i)
+    list.insert_front(static_cast<int>(i));
+  std::vector<int> keys = search_keys(n);
+  state.run([&] {
+    size_t hits = 0;
+    for (int key : keys)
+      hits += list.search(key) != nullptr;
+    BenchmarkState::do_not_optimize(hits);
+  });
+  state.set_items_processed(static_cast<double>(kSearches));
+}
+
+void std_list_search(BenchmarkState &state) {
+  size_t n = state.size();
+  std::list<int> list;
+  for (size_t i = 0; i < n; ++i)
+    list.push_front(static_cast<int>(i));
+  std::vector<int> keys = search_keys(n);
+  state.run([&] {
+    size_t hits = 0;
+    for (int key : keys)
+      hits += std::find(list.begin(), list.end(), key) != list.end();
+    BenchmarkState::do_not_optimize(hits);
+  });
+  state.set_items_processed(static_cast<double>(kSearches));
+}
+
+void unrolled_list_search(BenchmarkState &state) {
+  size_t n = state.size();
+  UnrolledLinkedList<int> list;
+  for (size_t i = 0; i < n; ++i)
+    list.push_front(static_cast<int>(i));
+  std::vector<int> keys = search_keys(n);
+  state.run([&] {
+    size_t hits = 0;
+    for (int key : keys)
+      hits += list.search(key) != nullptr;
+    BenchmarkState::do_not_optimize(hits);
+  });
+  state.set_items_processed(static_cast<double>(kSearches));
+}
+
+// LRU 缓存：容量为 n/4，按 zipf 分布访问 n 次，未命中时插入并淘汰最久未用的键
+const size_t kAccesses = 1 << 18;
+
+std::vector<int> lru_trace(size_t n) {
+  WorkloadGenerator generator;
+  return generator.generate<int>(Distribution::kZipf, kAccesses, 0,
+                                 static_cast<int>(n));
+}
+
+template <typename Cache> void bench_lru(BenchmarkState &state) {
+  size_t capacity = std::max<size_t>(1, state.size() / 4);
+  std::vector<int> trace = lru_trace(state.size());
+  size_t hits = 0;
+  state.run([&] {
+    Cache cache(capacity);
+    hits = 0;
+    for (int key : trace)
+      hits += cache.access(key);
+  });
+  if (hits == 0) {
+    throw std::runtime_error("no cache hits");
+  }
+  state.set_items_processed(static_cast<double>(trace.size()));
+}
+
+// 对照组一：shared_ptr 节点的 DoublyLinkedList
+class SharedPtrLru {
+public:
+  explicit SharedPtrLru(size_t capacity) : capacity(capacity) {}
+
+  bool access(int key) {
+    auto it = index.find(key);
+    if (it != index.end()) {
+      // DoublyLinkedList 只能在表头插入新值，移到表头需要重新分配节点
+      order.remove(it->second);
+      order.insert_front(key);
+      it->second = order.get_head();
+      return true;
+    }
+    if (index.size() == capacity) {
+      auto victim = order.get_tail();
+      index.erase(victim->data);
+      order.remove(victim);
+    }
+    order.insert_front(key);
+    index.emplace(key, order.get_head());
+    return false;
+  }
+
+private:
+  size_t capacity;
+  DoublyLinkedList<int> order;
+  std::unordered_map<int, std::shared_ptr<ListNode<int>>> index;
+};
+
+// 对照组二：std::list + splice
+class StdListLru {
+public:
+  explicit StdListLru(size_t capacity) : capacity(capacity) {}
+
+  bool access(int key) {
+    auto it = index.find(key);
+    if (it != index.end()) {
+      order.splice(order.begin(), order, it->second);
+      return true;
+    }
+    if (index.size() == capacity) {
+      index.erase(order.back());
+      order.pop_back();
+    }
+    order.push_front(key);
+    index.emplace(key, order.begin());
+    return false;
+  }
+
+private:
+  size_t capacity;
+  std::list<int> order;
+  std::unordered_map<int, std::list<int>::iterator> index;
+};
+
+// 侵入式链表 + 节点池
+class IntrusiveLru {
+public:
+  explicit IntrusiveLru(size_t capacity) : capacity(capacity) {}
+
+  ~IntrusiveLru() {
+    while (!order.empty())
+      pool.destroy(&order.pop_front());
+  }
+
+  bool access(int key) {
+    auto it = index.find(key);
+    if (it != index.end()) {
+      order.move_to_front(*it->second);
+      return true;
+    }
+    if (index.size() == capacity) {
+      Entry &victim = order.pop_back();
+      index.erase(victim.key);
+      pool.destroy(&victim);
+    }
+    Entry *entry = pool.create(key);
+    order.push_front(*entry);
+    index.emplace(key, entry);
+    return false;
+  }
+
+private:
+  struct Entry : IntrusiveListHook<> {
+    explicit Entry(int key) : key(key) {}
+    int key;
+  };
+
+  size_t capacity;
+  NodePool<Entry> pool;
+  IntrusiveList<Entry> order;
+  std::unordered_map<int, Entry *> index;
+};
+
+void shared_ptr_list_lru(BenchmarkState &state) { bench_lru<SharedPtrLru>(state); }
+
+void std_list_lru(BenchmarkState &state) { bench_lru<StdListLru>(state); }
+
+void intrusive_list_lru(BenchmarkState &state) { bench_lru<IntrusiveLru>(state); }
+
+const std::vector<size_t> kListSizes = {1 << 10, 1 << 14, 1 << 18};
+const std::vector<size_t> kKeySpaces = {1 << 12, 1 << 16, 1 << 20};
+
+ALGORITHMS_BENCHMARK(doubly_linked_list_search).sizes(kListSizes);
+ALGORITHMS_BENCHMARK(std_list_search).sizes(kListSizes);
+ALGORITHMS_BENCHMARK(unrolled_list_search).sizes(kListSizes);
+ALGORITHMS_BENCHMARK(shared_ptr_list_lru).sizes(kKeySpaces);
+ALGORITHMS_BENCHMARK(std_list_lru).sizes(kKeySpaces);
+ALGORITHMS_BENCHMARK(intrusive_list_lru).sizes(kKeySpaces);
+
+ALGORITHMS_BENCHMARK_MAIN()
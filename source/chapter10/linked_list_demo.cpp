@@ -1,6 +1,13 @@
 #include "linked_list.h"
 #include <iostream>
+#include <list>
 #include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 using namespace algorithms;
 
@@ -275,6 +282,255 @@ void test_linked_list_applications() {
   std::cout << std::endl;
 }
 
+void test_unrolled_linked_list() {
+  std::cout << "=== 测试展开链表 ===" << std::endl;
+
+  UnrolledLinkedList<int> list;
+  std::cout << "每个64字节节点存放 " << UnrolledLinkedList<int>::kCapacity
+            << " 个int" << std::endl;
+
+  std::list<int> reference;
+  for (int i = 0; i < 30; ++i) {
+    list.push_back(i);
+    reference.push_back(i);
+  }
+  list.push_front(-1);
+  reference.push_front(-1);
+  list.insert(5, 100);
+  reference.insert(std::next(reference.begin(), 5), 100);
+  list.print();
+  std::cout << "元素数 " << list.size() << ", 节点数 " << list.node_count()
+            << std::endl;
+
+  int *found = list.search(100);
+  std::cout << "LIST-SEARCH(L, 100): " << (found ? "找到" : "未找到")
+            << ", at(5) = " << list.at(5) << std::endl;
+
+  for (int value : {100, 0, 7, 8, 9, 10, 11, 29, 42}) {
+    bool removed = list.remove_value(value);
+    if (removed) {
+      reference.remove(value);
+    }
+    std::cout << "删除 " << value << ": " << (removed ? "成功" : "不存在")
+              << std::endl;
+  }
+  list.pop_front();
+  reference.pop_front();
+  list.pop_back();
+  reference.pop_back();
+  list.print();
+
+  std::vector<int> contents;
+  list.for_each([&](int x) { contents.push_back(x); });
+  bool ok = contents == std::vector<int>(reference.begin(), reference.end());
+  std::cout << (ok ? "✓ 与 std::list 结果一致" : "✗ 与 std::list 结果不一致")
+            << std::endl;
+
+  list.clear();
+  std::cout << "清空后元素数 " << list.size() << ", 节点数 "
+            << list.node_count() << std::endl;
+  try {
+    list.pop_front();
+    std::cout << "错误：空链表应该抛出异常" << std::endl;
+  } catch (const std::underflow_error &e) {
+    std::cout << "✓ 空链表 pop_front: " << e.what() << std::endl;
+  }
+
+  std::cout << std::endl;
+}
+
+// 大元素：64字节的节点放不下两个 std::string 时按两个元素定节点大小
+void test_unrolled_large_elements() {
+  std::cout << "=== 测试展开链表（大元素）===" << std::endl;
+
+  UnrolledLinkedList<std::string> list;
+  std::cout << "sizeof(std::string) = " << sizeof(std::string)
+            << "，每个节点存放 " << UnrolledLinkedList<std::string>::kCapacity
+            << " 个" << std::endl;
+
+  // 随机插入删除，与 std::vector 对照；字符串足够长，不走短字符串优化
+  std::mt19937 gen(82);
+  std::vector<std::string> reference;
+  for (int step = 0; step < 20000; ++step) {
+    size_t size = reference.size();
+    if (size == 0 || gen() % 3 != 0) {
+      size_t index = gen() % (size + 1);
+      std::string value = "element-" + std::to_string(step) +
+                          std::string(24, static_cast<char>('a' + step % 26));
+      list.insert(index, value);
+      reference.insert(reference.begin() + index, value);
+    } else {
+      size_t index = gen() % size;
+      list.erase(index);
+      reference.erase(reference.begin() + index);
+    }
+  }
+  while (reference.size() > 100) {
+    list.pop_front();
+    reference.erase(reference.begin());
+  }
+  std::vector<std::string> contents;
+  list.for_each([&](const std::string &x) { contents.push_back(x); });
+  if (contents != reference || list.size() != reference.size()) {
+    throw std::runtime_error("展开链表存放 std::string 时与 std::vector 不一致");
+  }
+  std::cout << "✓ 20000 次随机插入删除后与 std::vector 结果一致，剩余 "
+            << list.size() << " 个元素、" << list.node_count() << " 个节点"
+            << std::endl;
+
+  std::cout << std::endl;
+}
+
+struct Task : IntrusiveListHook<> {
+  Task(int priority, std::string name)
+      : priority(priority), name(std::move(name)) {}
+
+  int priority;
+  std::string name;
+};
+
+void test_intrusive_list() {
+  std::cout << "=== 测试侵入式链表与节点池 ===" << std::endl;
+
+  NodePool<Task> pool;
+  IntrusiveList<Task> urgent, normal;
+  for (int p : {1, 4, 6, 9}) {
+    urgent.push_back(*pool.create(p, "u" + std::to_string(p)));
+  }
+  for (int p : {2, 3, 7, 8, 10}) {
+    normal.push_back(*pool.create(p, "n" + std::to_string(p)));
+  }
+
+  auto print = [](const char *label, const IntrusiveList<Task> &list) {
+    std::cout << label << ": ";
+    for (const Task &task : list) {
+      std::cout << task.name << " ";
+    }
+    std::cout << "(" << list.size() << " 个)" << std::endl;
+  };
+  print("urgent", urgent);
+  print("normal", normal);
+
+  urgent.merge(normal, [](const Task &a, const Task &b) {
+    return a.priority < b.priority;
+  });
+  print("归并后", urgent);
+  bool sorted = true;
+  int last = 0;
+  for (const Task &task : urgent) {
+    sorted = sorted && task.priority >= last;
+    last = task.priority;
+  }
+  std::cout << (sorted && normal.empty() ? "✓ 归并结果有序且 normal 已清空"
+                                         : "✗ 归并结果错误")
+            << std::endl;
+
+  // O(1) 删除任意元素：只需要元素本身，不需要先搜索
+  Task *seven = urgent.find_if([](const Task &t) { return t.priority == 7; });
+  urgent.remove(*seven);
+  pool.destroy(seven);
+
+  // O(1) 整条链表拼接
+  IntrusiveList<Task> later;
+  later.push_back(*pool.create(20, std::string("l20")));
+  later.push_back(*pool.create(30, std::string("l30")));
+  urgent.splice_back(later);
+  print("删除 n7 并拼接后", urgent);
+
+  try {
+    urgent.push_back(urgent.front());
+    std::cout << "错误：重复插入应该抛出异常" << std::endl;
+  } catch (const std::invalid_argument &e) {
+    std::cout << "✓ 重复插入: " << e.what() << std::endl;
+  }
+
+  while (!urgent.empty()) {
+    pool.destroy(&urgent.pop_front());
+  }
+  std::cout << "全部归还后池中存活节点 " << pool.live() << std::endl;
+
+  std::cout << std::endl;
+}
+
+// LRU 缓存：哈希表定位节点，侵入式链表维护使用顺序，节点来自节点池
+class LruCache {
+public:
+  explicit LruCache(size_t capacity) : capacity(capacity) {}
+
+  ~LruCache() {
+    while (!order.empty()) {
+      pool.destroy(&order.pop_front());
+    }
+  }
+
+  const std::string *get(int key) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+      return nullptr;
+    }
+    order.move_to_front(*it->second);
+    return &it->second->value;
+  }
+
+  void put(int key, const std::string &value) {
+    auto it = index.find(key);
+    if (it != index.end()) {
+      it->second->value = value;
+      order.move_to_front(*it->second);
+      return;
+    }
+    if (order.size() == capacity) {
+      Entry &victim = order.pop_back();
+      index.erase(victim.key);
+      pool.destroy(&victim);
+    }
+    Entry *entry = pool.create(key, value);
+    order.push_front(*entry);
+    index.emplace(key, entry);
+  }
+
+  void print() const {
+    std::cout << "LRU(最近 → 最久): ";
+    for (const Entry &entry : order) {
+      std::cout << entry.key << "=" << entry.value << " ";
+    }
+    std::cout << std::endl;
+  }
+
+private:
+  struct Entry : IntrusiveListHook<> {
+    Entry(int key, std::string value) : key(key), value(std::move(value)) {}
+
+    int key;
+    std::string value;
+  };
+
+  size_t capacity;
+  NodePool<Entry> pool;
+  IntrusiveList<Entry> order;
+  std::unordered_map<int, Entry *> index;
+};
+
+void test_lru_cache() {
+  std::cout << "=== 应用：LRU缓存 ===" << std::endl;
+
+  LruCache cache(3);
+  cache.put(1, "one");
+  cache.put(2, "two");
+  cache.put(3, "three");
+  cache.print();
+
+  std::cout << "get(1) = " << *cache.get(1) << std::endl;
+  cache.put(4, "four");
+  cache.print();
+  std::cout << "get(2) " << (cache.get(2) ? "命中" : "未命中（已被淘汰）")
+            << std::endl;
+  cache.put(3, "THREE");
+  cache.print();
+
+  std::cout << std::endl;
+}
+
 int main() {
   std::cout << "=== 算法导论 10.2节 - 链表演示 ===" << std::endl;
   std::cout << std::endl;
@@ -285,6 +541,10 @@ int main() {
   test_algorithm_operations();
   test_edge_cases();
   test_linked_list_applications();
+  test_unrolled_linked_list();
+  test_unrolled_large_elements();
+  test_intrusive_list();
+  test_lru_cache();
 
   std::cout << "=== 演示结束 ===" << std::endl;
 
@@ -0,0 +1,97 @@
+#include "benchmark_harness.h"
+#include "rooted_tree.h"
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace algorithms;
+
+// 随机查询的节点对数
+const size_t kQueries = 4096;
+
+// random: 父节点在已有节点中均匀选取，深度约 ln n
+// deep: 父节点取最近加入的几个节点之一，深度约 n/4
+struct TreeFixture {
+  RootedTree<int> tree{0};
+  std::vector<std::shared_ptr<TreeNode<int>>> nodes;
+  std::vector<std::pair<int, int>> queries;
+
+  TreeFixture(size_t n, const std::string &shape) {
+    std::mt19937 rng(12345);
+    nodes.push_back(tree.get_root());
+    for (size_t i = 1; i < n; ++i) {
+      size_t parent = shape == "deep" ? i - 1 - rng() % std::min<size_t>(i, 8)
+                                      : rng() % i;
+      nodes.push_back(tree.insert_child(nodes[parent], static_cast<int>(i)));
+    }
+    for (size_t q = 0; q < kQueries; ++q) {
+      queries.emplace_back(static_cast<int>(rng() % n),
+                           static_cast<int>(rng() % n));
+    }
+  }
+};
+
+// 指针式：沿父指针把两个节点上移到同一深度后一起上移
+void pointer_tree_lca(BenchmarkState &state) {
+  TreeFixture fixture(state.size(), state.distribution());
+  state.run([&] {
+    int64_t sum = 0;
+    for (auto [a, b] : fixture.queries) {
+      auto u = fixture.nodes[a], v = fixture.nodes[b];
+      int du = u->depth(), dv = v->depth();
+      for (; du > dv; --du)
+        u = u->parent;
+      for (; dv > du; --dv)
+        v = v->parent;
+      while (u != v) {
+        u = u->parent;
+        v = v->parent;
+      }
+      sum += u->data;
+    }
+    BenchmarkState::do_not_optimize(sum);
+  });
+  state.set_items_processed(static_cast<double>(kQueries));
+}
+
+// 数组式：欧拉序稀疏表 O(1) LCA；节点编号为先序编号，需先映射
+void packed_tree_lca(BenchmarkState &state) {
+  TreeFixture fixture(state.size(), state.distribution());
+  PackedRootedTree<int> packed(fixture.tree);
+  std::vector<int> id_of(state.size());
+  for (int v = 0; v < packed.size(); ++v)
+    id_of[packed.value(v)] = v;
+  state.run([&] {
+    int64_t sum = 0;
+    for (auto [a, b] : fixture.queries)
+      sum += packed.value(packed.lca(id_of[a], id_of[b]));
+    BenchmarkState::do_not_optimize(sum);
+  });
+  state.set_items_processed(static_cast<double>(kQueries));
+}
+
+// 构建数组式树（含稀疏表）的代价
+void packed_tree_build(BenchmarkState &state) {
+  TreeFixture fixture(state.size(), state.distribution());
+  state.run([&] {
+    PackedRootedTree<int> packed(fixture.tree);
+    BenchmarkState::do_not_optimize(packed.memory_bytes());
+  });
+  state.set_items_processed(static_cast<double>(state.size()));
+}
+
+const std::vector<size_t> kSizes = {1 << 10, 1 << 14, 1 << 18};
+// 深树上指针式查询每次Θ(n)，最大规模单次运行就要数秒
+const std::vector<size_t> kPointerSizes = {1 << 10, 1 << 14};
+const std::vector<std::string> kShapes = {"random", "deep"};
+
+ALGORITHMS_BENCHMARK(pointer_tree_lca)
+    .sizes(kPointerSizes)
+    .distributions(kShapes);
+ALGORITHMS_BENCHMARK(packed_tree_lca).sizes(kSizes).distributions(kShapes);
+ALGORITHMS_BENCHMARK(packed_tree_build).sizes(kSizes).distributions(kShapes);
+
+ALGORITHMS_BENCHMARK_MAIN()
@@ -1,5 +1,7 @@
 #include "rooted_tree.h"
 #include <iostream>
+#include <random>
+#include <string>
 #include <vector>
 
 using namespace algorithms;
@@ -280,6 +282,103 @@ void test_tree_applications() {
   std::cout << std::endl;
 }
 
+// 沿父指针求LCA：先把较深的节点上移到同一深度，再一起上移
+template <typename T>
+std::shared_ptr<TreeNode<T>> naive_lca(std::shared_ptr<TreeNode<T>> u,
+                                       std::shared_ptr<TreeNode<T>> v) {
+  int du = u->depth(), dv = v->depth();
+  for (; du > dv; --du)
+    u = u->parent;
+  for (; dv > du; --dv)
+    v = v->parent;
+  while (u != v) {
+    u = u->parent;
+    v = v->parent;
+  }
+  return u;
+}
+
+void test_packed_rooted_tree() {
+  std::cout << "=== 测试数组式有根树（欧拉序与LCA） ===" << std::endl;
+
+  RootedTree<std::string> org("CEO");
+  auto ceo = org.get_root();
+  auto cto = org.insert_child(ceo, "CTO");
+  auto cfo = org.insert_child(ceo, "CFO");
+  auto dev = org.insert_child(cto, "开发经理");
+  auto qa = org.insert_child(cto, "测试经理");
+  org.insert_child(dev, "开发工程师1");
+  org.insert_child(dev, "开发工程师2");
+  org.insert_child(qa, "测试工程师");
+  org.insert_child(cfo, "会计");
+
+  PackedRootedTree<std::string> packed(org);
+  std::cout << "节点数 " << packed.size() << ", 高度 " << packed.height()
+            << std::endl;
+  std::cout << "编号 值 父 左孩子 右兄弟 深度 子树大小 [进入,离开]" << std::endl;
+  for (int v = 0; v < packed.size(); ++v) {
+    std::cout << "  " << v << " " << packed.value(v) << " "
+              << packed.parent(v) << " " << packed.first_child(v) << " "
+              << packed.next_sibling(v) << " " << packed.depth(v) << " "
+              << packed.subtree_size(v) << " [" << packed.entry_time(v) << ","
+              << packed.exit_time(v) << "]" << std::endl;
+  }
+  std::cout << "欧拉序: ";
+  for (int v : packed.euler_tour()) {
+    std::cout << packed.value(v) << " ";
+  }
+  std::cout << std::endl;
+
+  int e1 = packed.find("开发工程师1");
+  int tester = packed.find("测试工程师");
+  int accountant = packed.find("会计");
+  std::cout << "LCA(开发工程师1, 测试工程师) = "
+            << packed.value(packed.lca(e1, tester)) << ", 距离 "
+            << packed.distance(e1, tester) << std::endl;
+  std::cout << "LCA(开发工程师1, 会计) = "
+            << packed.value(packed.lca(e1, accountant)) << std::endl;
+  std::cout << "CTO 是 测试工程师 的上级: "
+            << (packed.is_ancestor(packed.find("CTO"), tester) ? "是" : "否")
+            << std::endl;
+  std::cout << "CFO 是 测试工程师 的上级: "
+            << (packed.is_ancestor(packed.find("CFO"), tester) ? "是" : "否")
+            << std::endl;
+
+  // 随机树上与沿父指针的朴素算法对照
+  std::mt19937 rng(42);
+  RootedTree<int> random_tree(0);
+  std::vector<std::shared_ptr<TreeNode<int>>> nodes = {random_tree.get_root()};
+  for (int i = 1; i < 3000; ++i) {
+    // 一半节点接在最近加入的节点下面，使树既有宽的部分也有深的链
+    size_t parent = rng() % 2 ? nodes.size() - 1 : rng() % nodes.size();
+    nodes.push_back(random_tree.insert_child(nodes[parent], i));
+  }
+  PackedRootedTree<int> packed_random(random_tree);
+  bool ok = packed_random.height() == random_tree.height();
+  for (int q = 0; q < 2000 && ok; ++q) {
+    auto u = nodes[rng() % nodes.size()], v = nodes[rng() % nodes.size()];
+    int pu = packed_random.find(u->data), pv = packed_random.find(v->data);
+    auto expected = naive_lca(u, v);
+    ok = packed_random.value(packed_random.lca(pu, pv)) == expected->data &&
+         packed_random.depth(pu) == u->depth() &&
+         packed_random.height(pu) == u->height() &&
+         packed_random.is_ancestor(pu, pv) == (expected == u);
+  }
+  std::cout << "随机树（3000个节点，高度 " << packed_random.height()
+            << "）: " << (ok ? "✓ LCA、深度、高度、祖先判断与朴素算法一致"
+                            : "✗ 与朴素算法不一致")
+            << std::endl;
+
+  try {
+    packed.lca(0, packed.size());
+    std::cout << "错误：越界编号应该抛出异常" << std::endl;
+  } catch (const std::out_of_range &e) {
+    std::cout << "✓ 越界编号: " << e.what() << std::endl;
+  }
+
+  std::cout << std::endl;
+}
+
 int main() {
   std::cout << "=== 算法导论 10.4节 - 有根树表示演示 ===" << std::endl;
   std::cout << std::endl;
@@ -290,6 +389,7 @@ int main() {
   test_binary_tree();
   test_edge_cases();
   test_tree_applications();
+  test_packed_rooted_tree();
 
   std::cout << "=== 演示结束 ===" << std::endl;
 
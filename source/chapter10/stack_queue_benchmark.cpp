@@ -0,0 +1,238 @@
+#include "benchmark_harness.h"
+#include "stack_queue.h"
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace algorithms;
+
+// 流水线相邻阶段之间的典型缓冲区大小
+const size_t kCapacity = 1024;
+
+// 对照组：互斥锁保护的 std::queue，接口与无锁队列相同
+class MutexQueue {
+public:
+  explicit MutexQueue(size_t capacity) : capacity(capacity) {}
+
+  bool try_push(uint64_t value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (queue.size() == capacity) {
+      return false;
+    }
+    queue.push(value);
+    return true;
+  }
+
+  bool try_pop(uint64_t &out) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (queue.empty()) {
+      return false;
+    }
+    out = queue.front();
+    queue.pop();
+    return true;
+  }
+
+private:
+  std::mutex mutex;
+  std::queue<uint64_t> queue;
+  size_t capacity;
+};
+
+template <typename Q> void push_spin(Q &queue, uint64_t value) {
+  while (!queue.try_push(value)) {
+    std::this_thread::yield();
+  }
+}
+
+template <typename Q> uint64_t pop_spin(Q &queue) {
+  uint64_t value;
+  while (!queue.try_pop(value)) {
+    std::this_thread::yield();
+  }
+  return value;
+}
+
+// 吞吐量：producers 个线程共写入 n 个元素，consumers 个线程取出并求和
+template <typename Q>
+void bench_throughput(BenchmarkState &state, size_t producers,
+                      size_t consumers) {
+  size_t n = state.size();
+  uint64_t total = 0;
+  state.run([&] {
+    Q queue(kCapacity);
+    std::vector<uint64_t> sums(consumers, 0);
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p) {
+      threads.emplace_back([&, p] {
+        for (size_t i = n * p / producers; i < n * (p + 1) / producers; ++i)
+          push_spin(queue, i + 1);
+      });
+    }
+    for (size_t c = 0; c < consumers; ++c) {
+      threads.emplace_back([&, c] {
+        size_t count = n * (c + 1) / consumers - n * c / consumers;
+        uint64_t sum = 0;
+        for (size_t i = 0; i < count; ++i)
+          sum += pop_spin(queue);
+        sums[c] = sum;
+      });
+    }
+    for (std::thread &t : threads)
+      t.join();
+    total = 0;
+    for (uint64_t sum : sums)
+      total += sum;
+  });
+  if (total != uint64_t(n) * (n + 1) / 2) {
+    throw std::runtime_error("wrong checksum");
+  }
+  state.set_items_processed(static_cast<double>(n));
+}
+
+// 延迟：两个线程通过一对队列来回传递 n 次，每次往返的时间即单次延迟的两倍
+template <typename Q> void bench_ping_pong(BenchmarkState &state) {
+  size_t n = state.size();
+  state.run([&] {
+    Q ping(kCapacity), pong(kCapacity);
+    std::thread echo([&] {
+      for (size_t i = 0; i < n; ++i)
+        push_spin(pong, pop_spin(ping));
+    });
+    for (size_t i = 0; i < n; ++i) {
+      push_spin(ping, i);
+      if (pop_spin(pong) != i) {
+        throw std::runtime_error("wrong echo");
+      }
+    }
+    echo.join();
+  });
+  state.set_items_processed(static_cast<double>(n));
+}
+
+void spsc_throughput(BenchmarkState &state) {
+  bench_throughput<SpscRingQueue<uint64_t>>(state, 1, 1);
+}
+
+void mpmc_throughput_1p1c(BenchmarkState &state) {
+  bench_throughput<MpmcRingQueue<uint64_t>>(state, 1, 1);
+}
+
+void mpmc_throughput_4p4c(BenchmarkState &state) {
+  bench_throughput<MpmcRingQueue<uint64_t>>(state, 4, 4);
+}
+
+void mutex_queue_throughput_1p1c(BenchmarkState &state) {
+  bench_throughput<MutexQueue>(state, 1, 1);
+}
+
+void mutex_queue_throughput_4p4c(BenchmarkState &state) {
+  bench_throughput<MutexQueue>(state, 4, 4);
+}
+
+void spsc_ping_pong(BenchmarkState &state) {
+  bench_ping_pong<SpscRingQueue<uint64_t>>(state);
+}
+
+void mpmc_ping_pong(BenchmarkState &state) {
+  bench_ping_pong<MpmcRingQueue<uint64_t>>(state);
+}
+
+void mutex_queue_ping_pong(BenchmarkState &state) {
+  bench_ping_pong<MutexQueue>(state);
+}
+
+// 可增长容器：先压入 n 个元素再全部弹出
+void growable_stack_push_pop(BenchmarkState &state) {
+  size_t n = state.size();
+  state.run([&] {
+    GrowableStack<uint64_t> stack;
+    for (size_t i = 0; i < n; ++i)
+      stack.push(i);
+    uint64_t sum = 0;
+    while (!stack.empty())
+      sum += stack.pop();
+    BenchmarkState::do_not_optimize(sum);
+  });
+  state.set_items_processed(static_cast<double>(2 * n));
+}
+
+void std_vector_push_pop(BenchmarkState &state) {
+  size_t n = state.size();
+  state.run([&] {
+    std::vector<uint64_t> stack;
+    for (size_t i = 0; i < n; ++i)
+      stack.push_back(i);
+    uint64_t sum = 0;
+    while (!stack.empty()) {
+      sum += stack.back();
+      stack.pop_back();
+    }
+    BenchmarkState::do_not_optimize(sum);
+  });
+  state.set_items_processed(static_cast<double>(2 * n));
+}
+
+// 队列：先入队 n 个元素，再出队一个入队一个共 n 次，最后全部出队
+void growable_queue_fifo(BenchmarkState &state) {
+  size_t n = state.size();
+  state.run([&] {
+    GrowableQueue<uint64_t> queue;
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+      queue.enqueue(i);
+    for (size_t i = 0; i < n; ++i) {
+      sum += queue.dequeue();
+      queue.enqueue(i);
+    }
+    while (!queue.empty())
+      sum += queue.dequeue();
+    BenchmarkState::do_not_optimize(sum);
+  });
+  state.set_items_processed(static_cast<double>(4 * n));
+}
+
+void std_deque_fifo(BenchmarkState &state) {
+  size_t n = state.size();
+  state.run([&] {
+    std::deque<uint64_t> queue;
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i)
+      queue.push_back(i);
+    for (size_t i = 0; i < n; ++i) {
+      sum += queue.front();
+      queue.pop_front();
+      queue.push_back(i);
+    }
+    while (!queue.empty()) {
+      sum += queue.front();
+      queue.pop_front();
+    }
+    BenchmarkState::do_not_optimize(sum);
+  });
+  state.set_items_processed(static_cast<double>(4 * n));
+}
+
+const std::vector<size_t> kItems = {1 << 20};
+const std::vector<size_t> kContainerSizes = {1 << 10, 1 << 16, 1 << 22};
+const std::vector<size_t> kRoundTrips = {1 << 14};
+
+ALGORITHMS_BENCHMARK(spsc_throughput).sizes(kItems);
+ALGORITHMS_BENCHMARK(mpmc_throughput_1p1c).sizes(kItems);
+ALGORITHMS_BENCHMARK(mpmc_throughput_4p4c).sizes(kItems);
+ALGORITHMS_BENCHMARK(mutex_queue_throughput_1p1c).sizes(kItems);
+ALGORITHMS_BENCHMARK(mutex_queue_throughput_4p4c).sizes(kItems);
+ALGORITHMS_BENCHMARK(spsc_ping_pong).sizes(kRoundTrips);
+ALGORITHMS_BENCHMARK(mpmc_ping_pong).sizes(kRoundTrips);
+ALGORITHMS_BENCHMARK(mutex_queue_ping_pong).sizes(kRoundTrips);
+ALGORITHMS_BENCHMARK(growable_stack_push_pop).sizes(kContainerSizes);
+ALGORITHMS_BENCHMARK(std_vector_push_pop).sizes(kContainerSizes);
+ALGORITHMS_BENCHMARK(growable_queue_fifo).sizes(kContainerSizes);
+ALGORITHMS_BENCHMARK(std_deque_fifo).sizes(kContainerSizes);
+
+ALGORITHMS_BENCHMARK_MAIN()
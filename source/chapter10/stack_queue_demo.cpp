@@ -1,5 +1,8 @@
 #include "stack_queue.h"
 #include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace algorithms;
 
@@ -240,6 +243,140 @@ void test_algorithm_operations() {
   std::cout << std::endl;
 }
 
+void test_growable_containers() {
+  std::cout << "=== 测试可增长的栈和队列 ===" << std::endl;
+
+  // 可增长栈：超过初始容量后成倍扩张，元素变少后收缩
+  GrowableStack<std::string> stack(2);
+  for (int i = 1; i <= 9; ++i) {
+    stack.push("s" + std::to_string(i));
+    std::cout << "PUSH s" << i << ": 元素数=" << stack.size()
+              << ", 容量=" << stack.capacity() << std::endl;
+  }
+  std::cout << "MULTIPOP(6) 弹出 " << stack.multipop(6) << " 个, 栈顶 "
+            << stack.top() << ", 容量=" << stack.capacity() << std::endl;
+  std::cout << "扩张和收缩共 " << stack.resizes() << " 次，搬移元素 "
+            << stack.moved_elements() << " 个" << std::endl;
+
+  // 可增长队列：超过100个元素也不会溢出（Queue(100)此时会抛出异常）
+  GrowableQueue<int> queue;
+  for (int i = 0; i < 1000; ++i) {
+    queue.enqueue(i);
+  }
+  int &first = queue.front();
+  for (int i = 1000; i < 100000; ++i) {
+    queue.enqueue(i);
+  }
+  std::cout << "GrowableQueue 入队 " << queue.size() << " 个元素后, 队头引用仍为 "
+            << first << ", 块表容量 " << queue.storage().map_capacity()
+            << std::endl;
+  long long sum = 0;
+  while (!queue.empty()) {
+    sum += queue.dequeue();
+  }
+  std::cout << "全部出队, 校验和"
+            << (sum == 99999LL * 100000 / 2 ? "正确" : "错误") << std::endl;
+
+  // 分块双端队列：两端插入不搬移已有元素
+  ChunkedDeque<int> deque;
+  deque.push_back(0);
+  int *middle = &deque.front();
+  for (int i = 1; i <= 50000; ++i) {
+    deque.push_back(i);
+    deque.push_front(-i);
+  }
+  std::cout << "ChunkedDeque 两端各插入50000个元素后, 原元素地址不变: "
+            << (middle == &deque[50000] ? "是" : "否") << ", 队头 "
+            << deque.front() << ", 队尾 " << deque.back() << std::endl;
+
+  try {
+    GrowableStack<int> empty_stack;
+    empty_stack.pop();
+  } catch (const std::underflow_error &e) {
+    std::cout << "空栈弹出: " << e.what() << std::endl;
+  }
+
+  std::cout << std::endl;
+}
+
+void test_lock_free_queues() {
+  std::cout << "=== 测试无锁环形队列 ===" << std::endl;
+
+  // SPSC：容量向上取整为2的幂，满时try_push失败
+  SpscRingQueue<std::string> spsc(3);
+  std::cout << "SPSC队列容量: " << spsc.capacity() << std::endl;
+  for (const char *word : {"a", "b", "c", "d", "e"}) {
+    std::cout << "try_push(" << word << "): "
+              << (spsc.try_push(std::string(word)) ? "成功" : "队列已满")
+              << std::endl;
+  }
+  std::string word;
+  while (spsc.try_pop(word)) {
+    std::cout << "try_pop: " << word << std::endl;
+  }
+
+  // SPSC：一个生产者线程与一个消费者线程，检查顺序不变
+  const long long items = 200000;
+  SpscRingQueue<long long> pipe(1024);
+  std::thread producer([&] {
+    for (long long i = 1; i <= items; ++i) {
+      pipe.push(i);
+    }
+  });
+  bool in_order = true;
+  long long expected = 1;
+  for (long long i = 0; i < items; ++i) {
+    long long value = pipe.pop();
+    in_order = in_order && value == expected++;
+  }
+  producer.join();
+  std::cout << "SPSC跨线程传递 " << items << " 个元素: "
+            << (in_order ? "顺序正确" : "顺序错误") << std::endl;
+
+  // MPMC：4个生产者、4个消费者，检查每个元素恰好被取出一次
+  const int producers = 4, consumers = 4;
+  const long long per_producer = 50000;
+  MpmcRingQueue<long long> mpmc(256);
+  std::vector<long long> sums(consumers, 0), counts(consumers, 0);
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&, p] {
+      for (long long i = 0; i < per_producer; ++i) {
+        mpmc.push(p * per_producer + i + 1);
+      }
+    });
+  }
+  for (int c = 0; c < consumers; ++c) {
+    threads.emplace_back([&, c] {
+      for (long long i = 0; i < per_producer; ++i) {
+        sums[c] += mpmc.pop();
+        counts[c]++;
+      }
+    });
+  }
+  for (std::thread &t : threads) {
+    t.join();
+  }
+  long long total = producers * per_producer, sum = 0, count = 0;
+  for (int c = 0; c < consumers; ++c) {
+    sum += sums[c];
+    count += counts[c];
+  }
+  std::cout << "MPMC " << producers << "生产者/" << consumers << "消费者: 取出 "
+            << count << " 个元素, 校验和"
+            << (count == total && sum == total * (total + 1) / 2 ? "正确"
+                                                                 : "错误")
+            << std::endl;
+
+  try {
+    MpmcRingQueue<int> bad(0);
+  } catch (const std::invalid_argument &e) {
+    std::cout << "容量为0: " << e.what() << std::endl;
+  }
+
+  std::cout << std::endl;
+}
+
 int main() {
   std::cout << "=== 算法导论 10.1节 - 栈和队列演示 ===" << std::endl;
   std::cout << std::endl;
@@ -250,6 +387,8 @@ int main() {
   test_queue_with_two_stacks();
   test_edge_cases();
   test_algorithm_operations();
+  test_growable_containers();
+  test_lock_free_queues();
 
   std::cout << "=== 演示结束 ===" << std::endl;
 
@@ -0,0 +1,161 @@
+#include "concurrent_hash_map.h"
+#include "hash_table.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace algorithms;
+
+// 操作比例（百分比），其余为查找
+struct Workload {
+  const char *name;
+  int insert_percent;
+  int remove_percent;
+};
+
+// 线程私有的xorshift随机数，避免共享的随机数引擎成为瓶颈
+struct XorShift {
+  uint64_t state;
+  explicit XorShift(uint64_t seed) : state(seed * 0x9E3779B97F4A7C15ULL + 1) {}
+  uint64_t next() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+};
+
+// 现有做法：链接法散列表外包一把全局互斥锁
+class GlobalLockTable {
+public:
+  explicit GlobalLockTable(int buckets)
+      : table(buckets, [](int key) { return key; }) {}
+
+  void insert(int key, int value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    table.insert(key, value);
+  }
+  bool find(int key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return table.search(key) != nullptr;
+  }
+  void remove(int key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    table.remove(key);
+  }
+
+private:
+  std::mutex mutex;
+  ChainedHashTable<int, int> table;
+};
+
+class ShardedTable {
+public:
+  explicit ShardedTable(size_t capacity) : map(0, capacity) {}
+
+  void insert(int key, int value) { map.insert(key, value); }
+  bool find(int key) { return map.contains(key); }
+  void remove(int key) { map.remove(key); }
+
+private:
+  ConcurrentHashMap<int, int> map;
+};
+
+// 运行一次：返回每秒百万次操作数
+template <typename Table>
+double run(Table &table, const Workload &workload, size_t threads,
+           size_t ops_per_thread, int key_range) {
+  std::atomic<size_t> ready{0};
+  std::atomic<bool> go{false};
+  std::atomic<size_t> hits{0};
+  std::vector<std::thread> workers;
+
+  for (size_t t = 0; t < threads; t++) {
+    workers.emplace_back([&, t] {
+      XorShift rng(t + 1);
+      ready++;
+      while (!go.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+      size_t local_hits = 0;
+      for (size_t i = 0; i < ops_per_thread; i++) {
+        uint64_t r = rng.next();
+        int key = static_cast<int>((r >> 8) % key_range);
+        int op = static_cast<int>(r % 100);
+        if (op < workload.insert_percent) {
+          table.insert(key, static_cast<int>(i));
+        } else if (op < workload.insert_percent + workload.remove_percent) {
+          table.remove(key);
+        } else {
+          local_hits += table.find(key);
+        }
+      }
+      hits += local_hits;
+    });
+  }
+
+  while (ready.load() < threads) {
+    std::this_thread::yield();
+  }
+  auto start = std::chrono::high_resolution_clock::now();
+  go.store(true, std::memory_order_release);
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  double seconds = std::chrono::duration<double>(end - start).count();
+  return threads * ops_per_thread / seconds / 1e6;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: concurrent_hash_map_benchmark [最大线程数] [每线程操作数] [键范围]
+  // 例如在32核以上的机器上: concurrent_hash_map_benchmark 64 2000000 1000000
+  size_t max_threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10)
+                                : std::max(1u, std::thread::hardware_concurrency());
+  size_t ops_per_thread =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200000;
+  int key_range = argc > 3 ? std::atoi(argv[3]) : 1000000;
+
+  const Workload workloads[] = {{"读多写少 (90%查找/5%插入/5%删除)", 5, 5},
+                                {"写多读少 (50%查找/25%插入/25%删除)", 25, 25}};
+
+  std::vector<size_t> thread_counts;
+  for (size_t t = 1; t < max_threads; t *= 2) {
+    thread_counts.push_back(t);
+  }
+  thread_counts.push_back(max_threads);
+
+  std::cout << "并发散列表吞吐量测试" << std::endl;
+  std::cout << "每线程操作数: " << ops_per_thread << ", 键范围: " << key_range
+            << std::endl;
+
+  for (const auto &workload : workloads) {
+    std::cout << "\n" << workload.name << std::endl;
+    std::cout << std::setw(8) << "线程数" << std::setw(22) << "全局锁 (Mops/s)"
+              << std::setw(22) << "分片 (Mops/s)" << std::setw(10) << "加速比"
+              << std::endl;
+    for (size_t threads : thread_counts) {
+      // 两种表都预先填入一半的键
+      GlobalLockTable global(key_range);
+      ShardedTable sharded(key_range);
+      for (int key = 0; key < key_range; key += 2) {
+        global.insert(key, key);
+        sharded.insert(key, key);
+      }
+      double global_mops =
+          run(global, workload, threads, ops_per_thread, key_range);
+      double sharded_mops =
+          run(sharded, workload, threads, ops_per_thread, key_range);
+      std::cout << std::setw(8) << threads << std::setw(18) << std::fixed
+                << std::setprecision(2) << global_mops << std::setw(18)
+                << sharded_mops << std::setw(10) << sharded_mops / global_mops
+                << std::endl;
+    }
+  }
+  return 0;
+}
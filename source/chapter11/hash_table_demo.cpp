@@ -1,8 +1,16 @@
+#include "concurrent_hash_map.h"
+#include "flat_hash_map.h"
 #include "hash_table.h"
+#include "static_perfect_hash.h"
+#include <atomic>
 #include <chrono>
+#include <cstring>
 #include <iostream>
 #include <random>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 using namespace algorithms;
@@ -243,6 +251,137 @@ void test_performance_comparison() {
   std::cout << std::endl;
 }
 
+// 自动扩容（渐进式再散列）与Robin Hood置换测试
+void test_open_addressing_growth() {
+  std::cout << "=== 开放寻址法自动扩容与Robin Hood测试 ===" << std::endl;
+
+  struct ModeInfo {
+    ProbingMode mode;
+    const char *name;
+  };
+  const ModeInfo modes[] = {{ProbingMode::Linear, "线性探查"},
+                            {ProbingMode::Quadratic, "二次探查"},
+                            {ProbingMode::DoubleHashing, "双重散列"}};
+
+  // 随机插入/删除/查找与std::unordered_map对比，表从8个槽开始自动增长
+  for (const auto &info : modes) {
+    std::mt19937 gen(15);
+    std::uniform_int_distribution<int> key_dis(0, 50000);
+    OpenAddressingHashTable<int, int> table(info.mode, 8);
+    std::unordered_map<int, int> reference;
+    bool consistent = true;
+    for (int i = 0; i < 200000; i++) {
+      int key = key_dis(gen);
+      switch (gen() % 3) {
+      case 0:
+        table.insert(key, i);
+        reference[key] = i;
+        break;
+      case 1: {
+        int *found = table.find(key);
+        auto it = reference.find(key);
+        consistent = consistent && (found == nullptr) == (it == reference.end()) &&
+                     (found == nullptr || *found == it->second);
+        break;
+      }
+      default:
+        consistent =
+            consistent && table.remove(key) == (reference.erase(key) == 1);
+      }
+    }
+    consistent = consistent && table.size() == reference.size();
+    std::cout << info.name << ": 20万次随机操作与std::unordered_map一致: "
+              << (consistent ? "是" : "否") << ", 容量: " << table.capacity()
+              << std::endl;
+  }
+
+  // 拷贝是深拷贝：在渐进式再散列的各个阶段拷贝，之后修改原表不影响副本
+  {
+    OpenAddressingHashTable<int, std::string> original(ProbingMode::Quadratic, 8);
+    std::unordered_map<int, std::string> reference;
+    bool independent = true;
+    int rehashing_copies = 0;
+    for (int i = 0; i < 5000; i++) {
+      original.insert(i, std::to_string(i));
+      reference[i] = std::to_string(i);
+      if (i % 3 == 0) {
+        original.remove(i / 2);
+        reference.erase(i / 2);
+      }
+      if (i % 37 != 36) {
+        continue;
+      }
+      rehashing_copies += original.is_rehashing();
+      OpenAddressingHashTable<int, std::string> copy = original;
+      OpenAddressingHashTable<int, std::string> assigned(ProbingMode::Linear);
+      assigned = copy;
+      original.insert(i, "changed");
+      original.insert(-1 - i, "new");
+      for (auto *table : {&copy, &assigned}) {
+        independent = independent && table->size() == reference.size() &&
+                      table->find(-1 - i) == nullptr;
+        for (int k = 0; k <= i; k++) {
+          const std::string *value = table->find(k);
+          auto it = reference.find(k);
+          independent = independent &&
+                        (value == nullptr) == (it == reference.end()) &&
+                        (value == nullptr || *value == it->second);
+        }
+      }
+      original.insert(i, std::to_string(i));
+      original.remove(-1 - i);
+    }
+    std::cout << "再散列过程中拷贝的表与原表互相独立: "
+              << (independent ? "是" : "否") << "（其中 " << rehashing_copies
+              << " 次拷贝发生在迁移中途）" << std::endl;
+  }
+
+  // Robin Hood置换对探查长度方差的影响（负载因子0.9）
+  std::cout << "负载因子0.9时的探查长度（均值 / 方差 / 最大值）:" << std::endl;
+  for (const auto &info : modes) {
+    for (bool robin_hood : {false, true}) {
+      OpenAddressingHashTable<int, int> table(info.mode, 1 << 17, 0.95,
+                                              std::hash<int>(), robin_hood);
+      std::mt19937 gen(115);
+      while (table.size() < (1u << 17) * 9 / 10) {
+        table.insert(static_cast<int>(gen()), 0);
+      }
+      ProbeStats stats = table.probe_stats();
+      std::cout << "  " << info.name << (robin_hood ? " + Robin Hood: " : ":              ")
+                << stats.mean << " / " << stats.variance << " / " << stats.max
+                << std::endl;
+    }
+  }
+
+  // 单次插入的最大耗时：渐进式再散列 vs std::unordered_map一次性再散列
+  const int count = 2000000;
+  auto worst_insert_us = [&](auto &table) {
+    double worst = 0.0;
+    for (int i = 0; i < count; i++) {
+      auto start = std::chrono::high_resolution_clock::now();
+      table.insert({i, std::to_string(i)});
+      auto end = std::chrono::high_resolution_clock::now();
+      worst = std::max(
+          worst, std::chrono::duration<double, std::micro>(end - start).count());
+    }
+    return worst;
+  };
+  struct Incremental {
+    OpenAddressingHashTable<int, std::string> table{ProbingMode::Linear};
+    void insert(const std::pair<int, std::string> &kv) {
+      table.insert(kv.first, kv.second);
+    }
+  } incremental;
+  std::unordered_map<int, std::string> unordered;
+  double incremental_worst = worst_insert_us(incremental);
+  double unordered_worst = worst_insert_us(unordered);
+  std::cout << count << "次插入中单次插入的最大耗时: 渐进式再散列 "
+            << incremental_worst << " 微秒, std::unordered_map "
+            << unordered_worst << " 微秒" << std::endl;
+
+  std::cout << std::endl;
+}
+
 // 测试算法导论示例
 void test_clrs_examples() {
   std::cout << "=== 算法导论示例测试 ===" << std::endl;
@@ -289,6 +428,259 @@ void test_clrs_examples() {
   std::cout << std::endl;
 }
 
+// 扁平散列表测试（SIMD控制字节分组探查、后移删除）
+void test_flat_hash_map() {
+  std::cout << "=== 扁平散列表测试 (FlatHashMap) ===" << std::endl;
+
+  // 基本操作
+  FlatHashMap<std::string, int> words;
+  words.insert("apple", 1);
+  words.insert("banana", 2);
+  words["cherry"] = 3;
+  bool inserted = words.insert("apple", 10).second;
+  words.insert_or_assign("banana", 20);
+  const int *apple = words.find("apple");
+  std::cout << "apple = " << (apple ? *apple : -1)
+            << ", banana = " << *words.find("banana")
+            << ", 重复插入apple: " << (inserted ? "插入" : "保留原值")
+            << ", 大小: " << words.size() << std::endl;
+  words.erase("apple");
+  std::cout << "删除apple后查找: " << (words.contains("apple") ? "找到" : "未找到")
+            << ", 大小: " << words.size() << std::endl;
+
+  // 随机操作序列与std::unordered_map对比
+  std::mt19937 gen(14);
+  std::uniform_int_distribution<int> key_dis(0, 20000);
+  std::uniform_int_distribution<int> op_dis(0, 2);
+  FlatHashMap<int, int> flat;
+  std::unordered_map<int, int> reference;
+  bool consistent = true;
+  for (int i = 0; i < 300000; i++) {
+    int key = key_dis(gen);
+    switch (op_dis(gen)) {
+    case 0:
+      flat.insert_or_assign(key, i);
+      reference[key] = i;
+      break;
+    case 1: {
+      const int *found = flat.find(key);
+      auto it = reference.find(key);
+      consistent = consistent && (found == nullptr) == (it == reference.end()) &&
+                   (found == nullptr || *found == it->second);
+      break;
+    }
+    case 2:
+      consistent = consistent && flat.erase(key) == (reference.erase(key) == 1);
+      break;
+    }
+  }
+  size_t visited = 0;
+  flat.for_each([&](int key, int value) {
+    visited++;
+    consistent = consistent && reference.count(key) && reference[key] == value;
+  });
+  consistent = consistent && visited == reference.size() &&
+               flat.size() == reference.size();
+  std::cout << "30万次随机插入/查找/删除与std::unordered_map一致: "
+            << (consistent ? "是" : "否") << ", 容量: " << flat.capacity()
+            << ", 负载因子: " << flat.load_factor() << std::endl;
+
+  // 去重性能：链接法散列表、std::unordered_map与扁平散列表
+  const int count = 1000000;
+  std::vector<int> stream(count);
+  std::uniform_int_distribution<int> stream_dis(0, count / 2);
+  for (auto &x : stream) {
+    x = stream_dis(gen);
+  }
+
+  auto time_ms = [](auto &&work) {
+    auto start = std::chrono::high_resolution_clock::now();
+    size_t result = work();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::make_pair(
+        result,
+        std::chrono::duration<double, std::milli>(end - start).count());
+  };
+
+  auto chained = time_ms([&] {
+    ChainedHashTable<int, int> table(1 << 19, [](int key) { return key; });
+    size_t unique = 0;
+    for (int x : stream) {
+      if (!table.search(x)) {
+        table.insert(x, 1);
+        unique++;
+      }
+    }
+    return unique;
+  });
+  auto unordered = time_ms([&] {
+    std::unordered_map<int, int> table;
+    size_t unique = 0;
+    for (int x : stream) {
+      unique += table.emplace(x, 1).second;
+    }
+    return unique;
+  });
+  auto flat_time = time_ms([&] {
+    FlatHashMap<int, int> table;
+    size_t unique = 0;
+    for (int x : stream) {
+      unique += table.insert(x, 1).second;
+    }
+    return unique;
+  });
+  std::cout << count << "个键去重（不同键 " << flat_time.first << " 个）:"
+            << std::endl;
+  std::cout << "  ChainedHashTable:   " << chained.second << " ms" << std::endl;
+  std::cout << "  std::unordered_map: " << unordered.second << " ms"
+            << std::endl;
+  std::cout << "  FlatHashMap:        " << flat_time.second << " ms"
+            << (chained.first == flat_time.first &&
+                        unordered.first == flat_time.first
+                    ? ""
+                    : " (结果不一致!)")
+            << std::endl;
+
+  std::cout << std::endl;
+}
+
+// 分片并发散列表测试
+void test_concurrent_hash_map() {
+  std::cout << "=== 分片并发散列表测试 (ConcurrentHashMap) ===" << std::endl;
+
+  ConcurrentHashMap<int, int> map;
+  const int threads = 4, per_thread = 50000;
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; t++) {
+    workers.emplace_back([&, t] {
+      for (int i = 0; i < per_thread; i++) {
+        map.insert(t * per_thread + i, i);  // 各线程插入不相交的键
+        map.upsert(-1 - i % 100, 0, [](int &count) { count++; }); // 共享计数器
+        if (i % 2 == 0) {
+          map.remove(t * per_thread + i);
+        }
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  bool correct = map.size() == static_cast<size_t>(threads * per_thread / 2 + 100);
+  for (int k = 1; k <= 100; k++) {
+    correct = correct && map.find(-k) == threads * per_thread / 100;
+  }
+  for (int t = 0; t < threads; t++) {
+    correct = correct && !map.contains(t * per_thread) &&
+              map.find(t * per_thread + 1) == 1;
+  }
+  std::cout << threads << "个线程并发插入/更新/删除后结果正确: "
+            << (correct ? "是" : "否") << ", 分片数: " << map.shard_count()
+            << ", 元素数: " << map.size() << std::endl;
+
+  // 带状态的散列函数：分片内的表也必须使用构造时传入的对象，
+  // 每次插入先选分片再在表内定位，各调用一次
+  struct CountingHash {
+    std::atomic<size_t> *calls = nullptr;
+    size_t operator()(int key) const {
+      if (calls) {
+        calls->fetch_add(1, std::memory_order_relaxed);
+      }
+      return std::hash<int>()(key);
+    }
+  };
+  std::atomic<size_t> calls{0};
+  ConcurrentHashMap<int, int, CountingHash> counted(8, 1000,
+                                                    CountingHash{&calls});
+  for (int i = 0; i < 1000; i++) {
+    counted.insert(i, i);
+  }
+  std::cout << "自定义散列函数对象传到每个分片: "
+            << (counted.size() == 1000 && calls >= 2000 ? "是" : "否")
+            << "（调用 " << calls << " 次）" << std::endl;
+
+  std::cout << std::endl;
+}
+
+// 静态最小完美散列测试
+void test_static_perfect_hash() {
+  std::cout << "=== 静态最小完美散列测试 (StaticPerfectHash) ===" << std::endl;
+
+  auto is_bijection = [](const StaticPerfectHash &mphf, const auto &keys) {
+    std::vector<bool> seen(keys.size(), false);
+    for (const auto &key : keys) {
+      uint64_t index = mphf.lookup(key);
+      if (index >= keys.size() || seen[index])
+        return false;
+      seen[index] = true;
+    }
+    return true;
+  };
+
+  // 100万个整数键：奇数乘法在模2^64下是双射，保证键互不相同
+  const size_t count = 1000000;
+  std::vector<uint64_t> keys(count);
+  for (size_t i = 0; i < count; i++) {
+    keys[i] = (i + 1) * 0x9E3779B97F4A7C15ULL;
+  }
+  auto start = std::chrono::high_resolution_clock::now();
+  StaticPerfectHash mphf = StaticPerfectHash::build(keys);
+  auto end = std::chrono::high_resolution_clock::now();
+  double build_ms =
+      std::chrono::duration<double, std::milli>(end - start).count();
+
+  start = std::chrono::high_resolution_clock::now();
+  uint64_t checksum = 0;
+  for (uint64_t key : keys) {
+    checksum += mphf.lookup(key);
+  }
+  end = std::chrono::high_resolution_clock::now();
+  double lookup_ns =
+      std::chrono::duration<double, std::nano>(end - start).count() / count;
+  std::cout << count << "个整数键: 是否为到[0, n)的双射: "
+            << (is_bijection(mphf, keys) && checksum == count * (count - 1) / 2
+                    ? "是"
+                    : "否")
+            << ", 空间: " << mphf.bits_per_key() << " 比特/键"
+            << ", 构建: " << build_ms << " ms, 查询: " << lookup_ns << " ns/键"
+            << std::endl;
+
+  // 字符串键
+  std::vector<std::string> words;
+  for (int i = 0; i < 100000; i++) {
+    words.push_back("key_" + std::to_string(i));
+  }
+  StaticPerfectHash word_hash = StaticPerfectHash::build(words);
+  std::cout << words.size() << "个字符串键: 是否为双射: "
+            << (is_bijection(word_hash, words) ? "是" : "否") << ", 空间: "
+            << word_hash.bits_per_key() << " 比特/键" << std::endl;
+
+  // 序列化后零拷贝加载（实际使用时缓冲区来自mmap的文件）
+  std::ostringstream out;
+  mphf.save(out);
+  std::string bytes = out.str();
+  std::vector<uint64_t> buffer(bytes.size() / sizeof(uint64_t));
+  std::memcpy(buffer.data(), bytes.data(), bytes.size());
+  StaticPerfectHash loaded =
+      StaticPerfectHash::load(buffer.data(), bytes.size());
+  bool same = loaded.size() == mphf.size();
+  for (size_t i = 0; i < count && same; i += 97) {
+    same = loaded.lookup(keys[i]) == mphf.lookup(keys[i]);
+  }
+  std::cout << "序列化: " << bytes.size() << " 字节, 加载后查询结果一致: "
+            << (same ? "是" : "否") << std::endl;
+
+  // 重复键
+  try {
+    StaticPerfectHash::build(std::vector<int>{1, 2, 3, 2});
+    std::cout << "重复键: 未检测到" << std::endl;
+  } catch (const std::invalid_argument &e) {
+    std::cout << "重复键: 正确捕获异常: " << e.what() << std::endl;
+  }
+
+  std::cout << std::endl;
+}
+
 // 边界情况测试
 void test_edge_cases() {
   std::cout << "=== 边界情况测试 ===" << std::endl;
@@ -331,6 +723,10 @@ int main() {
   test_perfect_hashing();
   test_hash_distribution();
   test_performance_comparison();
+  test_flat_hash_map();
+  test_open_addressing_growth();
+  test_concurrent_hash_map();
+  test_static_perfect_hash();
   test_clrs_examples();
   test_edge_cases();
 
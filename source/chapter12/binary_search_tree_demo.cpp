@@ -212,6 +212,40 @@ void test_string_bst() {
   std::cout << std::endl;
 }
 
+void test_iterators_and_ranges() {
+  std::cout << "=== 测试迭代器与区间查询 ===" << std::endl;
+
+  BinarySearchTree<int> bst;
+  for (int key : {15, 6, 18, 3, 7, 17, 20, 2, 4, 13, 9}) {
+    bst.insert(key);
+  }
+
+  std::cout << "正向迭代: ";
+  for (int key : bst) {
+    std::cout << key << " ";
+  }
+  std::cout << std::endl;
+
+  std::cout << "反向迭代: ";
+  for (auto it = bst.end(); it != bst.begin();) {
+    --it;
+    std::cout << *it << " ";
+  }
+  std::cout << std::endl;
+
+  std::cout << "lower_bound(8): " << *bst.lower_bound(8)
+            << ", upper_bound(9): " << *bst.upper_bound(9) << std::endl;
+  std::cout << "upper_bound(20) 是否为 end: "
+            << (bst.upper_bound(20) == bst.end() ? "是" : "否") << std::endl;
+
+  std::cout << "区间 [5, 16): ";
+  for (int key : bst.range(5, 16)) {
+    std::cout << key << " ";
+  }
+  std::cout << std::endl;
+  std::cout << std::endl;
+}
+
 int main() {
   std::cout << "第12章 二叉搜索树演示程序" << std::endl;
   std::cout << "========================" << std::endl;
@@ -220,6 +254,7 @@ int main() {
   test_delete_operations();
   test_edge_cases();
   test_string_bst();
+  test_iterators_and_ranges();
 
   std::cout << "所有测试完成！" << std::endl;
 
@@ -1,6 +1,13 @@
 #include "red_black_tree.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <iterator>
+#include <random>
+#include <set>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace algorithms;
@@ -241,6 +248,232 @@ void test_complex_operations() {
   std::cout << std::endl;
 }
 
+void test_performance() {
+  std::cout << "=== 测试插入/查找吞吐量 ===" << std::endl;
+
+  const int n = 1000000;
+  std::mt19937 rng(42);
+  std::vector<int> keys(n);
+  for (int &key : keys) {
+    key = static_cast<int>(rng());
+  }
+
+  auto elapsed_ms = [](std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::high_resolution_clock::now() - start)
+        .count();
+  };
+
+  auto start = std::chrono::high_resolution_clock::now();
+  RedBlackTree<int> rbt;
+  for (int key : keys) {
+    rbt.insert(key);
+  }
+  double rbt_insert_ms = elapsed_ms(start);
+
+  start = std::chrono::high_resolution_clock::now();
+  std::multiset<int> set;
+  for (int key : keys) {
+    set.insert(key);
+  }
+  double set_insert_ms = elapsed_ms(start);
+
+  std::shuffle(keys.begin(), keys.end(), rng);
+  size_t found = 0;
+  start = std::chrono::high_resolution_clock::now();
+  for (int key : keys) {
+    found += rbt.search(key) != nullptr;
+  }
+  double rbt_search_ms = elapsed_ms(start);
+
+  start = std::chrono::high_resolution_clock::now();
+  for (int key : keys) {
+    found += set.find(key) != set.end();
+  }
+  double set_search_ms = elapsed_ms(start);
+
+  std::cout << "元素数: " << n << ", 命中: " << found << std::endl;
+  std::cout << "插入: 红黑树 " << rbt_insert_ms << " ms, std::multiset "
+            << set_insert_ms << " ms" << std::endl;
+  std::cout << "查找: 红黑树 " << rbt_search_ms << " ms, std::multiset "
+            << set_search_ms << " ms" << std::endl;
+  std::cout << "节点池内存: " << rbt.memory_bytes() / (1024 * 1024) << " MiB"
+            << std::endl;
+  std::cout << "是否有效红黑树: " << (rbt.is_valid() ? "是" : "否")
+            << std::endl;
+  std::cout << std::endl;
+}
+
+void test_join_based_operations() {
+  std::cout << "=== 测试批量建树与基于join的集合运算 ===" << std::endl;
+
+  RedBlackTree<int> evens, threes;
+  std::vector<int> even_keys, three_keys;
+  for (int i = 0; i <= 20; i += 2) {
+    even_keys.push_back(i);
+  }
+  for (int i = 0; i <= 20; i += 3) {
+    three_keys.push_back(i);
+  }
+  evens.build_from_sorted(even_keys);
+  threes.build_from_sorted(three_keys);
+  std::cout << "批量建树是否有效: "
+            << (evens.is_valid() && threes.is_valid() ? "是" : "否")
+            << std::endl;
+
+  auto print_keys = [](const char *label, const RedBlackTree<int> &tree) {
+    std::cout << label;
+    for (int key : tree.inorder_traversal()) {
+      std::cout << key << " ";
+    }
+    std::cout << "(有效: " << (tree.is_valid() ? "是" : "否") << ")"
+              << std::endl;
+  };
+
+  RedBlackTree<int> a, b;
+  a.build_from_sorted(even_keys);
+  b.build_from_sorted(three_keys);
+  print_keys("并集: ", RedBlackTree<int>::set_union(std::move(a), std::move(b)));
+  a.build_from_sorted(even_keys);
+  b.build_from_sorted(three_keys);
+  print_keys("交集: ",
+             RedBlackTree<int>::set_intersection(std::move(a), std::move(b)));
+  a.build_from_sorted(even_keys);
+  b.build_from_sorted(three_keys);
+  print_keys("差集(偶数-3的倍数): ",
+             RedBlackTree<int>::set_difference(std::move(a), std::move(b)));
+
+  RedBlackTree<int> upper = evens.split(10);
+  print_keys("split(10) 左半: ", evens);
+  print_keys("split(10) 右半: ", upper);
+  evens.join(std::move(upper));
+  print_keys("join 之后: ", evens);
+
+  try {
+    RedBlackTree<int> small;
+    small.build_from_sorted({1, 2, 3});
+    threes.join(std::move(small));
+  } catch (const std::invalid_argument &e) {
+    std::cout << "正确捕获join顺序异常: " << e.what() << std::endl;
+  }
+
+  // 合并两份快照：逐个插入 vs 基于join的并集
+  const int n = 1000000;
+  std::mt19937 rng(7);
+  std::vector<int> snapshot_a(n), snapshot_b(n);
+  for (int i = 0; i < n; i++) {
+    snapshot_a[i] = static_cast<int>(rng() >> 1);
+    snapshot_b[i] = static_cast<int>(rng() >> 1);
+  }
+  for (auto *snapshot : {&snapshot_a, &snapshot_b}) {
+    std::sort(snapshot->begin(), snapshot->end());
+    snapshot->erase(std::unique(snapshot->begin(), snapshot->end()),
+                    snapshot->end());
+  }
+
+  auto elapsed_ms = [](std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::high_resolution_clock::now() - start)
+        .count();
+  };
+
+  RedBlackTree<int> base;
+  base.build_from_sorted(snapshot_a);
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int key : snapshot_b) {
+    if (base.search(key) == nullptr) {
+      base.insert(key);
+    }
+  }
+  double insert_ms = elapsed_ms(start);
+
+  RedBlackTree<int> left, right;
+  start = std::chrono::high_resolution_clock::now();
+  left.build_from_sorted(snapshot_a);
+  right.build_from_sorted(snapshot_b);
+  double build_ms = elapsed_ms(start);
+
+  size_t threads = std::max(1u, std::thread::hardware_concurrency());
+  start = std::chrono::high_resolution_clock::now();
+  RedBlackTree<int> merged =
+      RedBlackTree<int>::set_union(std::move(left), std::move(right), threads);
+  double union_ms = elapsed_ms(start);
+
+  std::cout << "快照大小: " << snapshot_a.size() << " + " << snapshot_b.size()
+            << ", 并集大小: " << merged.size() << " (逐个插入得到 "
+            << base.size() << ")" << std::endl;
+  std::cout << "逐个插入合并: " << insert_ms << " ms, 批量建树: " << build_ms
+            << " ms, set_union(" << threads << "线程): " << union_ms << " ms"
+            << std::endl;
+  std::cout << "是否有效红黑树: " << (merged.is_valid() ? "是" : "否")
+            << std::endl;
+  std::cout << std::endl;
+}
+
+void test_iterators_and_ranges() {
+  std::cout << "=== 测试迭代器与区间查询 ===" << std::endl;
+
+  RedBlackTree<int> rbt;
+  for (int key : {41, 38, 31, 12, 19, 8, 45, 50, 3}) {
+    rbt.insert(key);
+  }
+
+  std::cout << "正向迭代: ";
+  for (int key : rbt) {
+    std::cout << key << " ";
+  }
+  std::cout << std::endl;
+
+  std::cout << "lower_bound(20): " << *rbt.lower_bound(20)
+            << ", upper_bound(41): " << *rbt.upper_bound(41) << std::endl;
+  std::cout << "最后一个元素(--end): " << *std::prev(rbt.end()) << std::endl;
+
+  std::cout << "区间 [10, 42): ";
+  for (int key : rbt.range(10, 42)) {
+    std::cout << key << " ";
+  }
+  std::cout << std::endl;
+
+  // 取某个界之上的前100个键：区间视图 vs 物化整棵树
+  const int n = 1000000;
+  RedBlackTree<int> big;
+  std::vector<int> keys(n);
+  for (int i = 0; i < n; i++) {
+    keys[i] = 2 * i;
+  }
+  big.build_from_sorted(keys);
+
+  auto elapsed_us = [](std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(
+               std::chrono::high_resolution_clock::now() - start)
+        .count();
+  };
+
+  const int bound = n;
+  auto start = std::chrono::high_resolution_clock::now();
+  long long lazy_sum = 0;
+  int taken = 0;
+  for (auto it = big.lower_bound(bound); it != big.end() && taken < 100;
+       ++it, ++taken) {
+    lazy_sum += *it;
+  }
+  double lazy_us = elapsed_us(start);
+
+  start = std::chrono::high_resolution_clock::now();
+  std::vector<int> all = big.inorder_traversal();
+  auto first = std::lower_bound(all.begin(), all.end(), bound);
+  long long eager_sum = 0;
+  for (int i = 0; i < 100 && first != all.end(); i++, ++first) {
+    eager_sum += *first;
+  }
+  double eager_us = elapsed_us(start);
+
+  std::cout << "界 " << bound << " 之上的前100个键之和: 迭代器 " << lazy_sum
+            << " (" << lazy_us << " us), 中序遍历 " << eager_sum << " ("
+            << eager_us << " us)" << std::endl;
+  std::cout << std::endl;
+}
+
 int main() {
   std::cout << "第13章 红黑树演示程序" << std::endl;
   std::cout << "======================" << std::endl;
@@ -250,6 +483,9 @@ int main() {
   test_edge_cases();
   test_string_rbt();
   test_complex_operations();
+  test_performance();
+  test_join_based_operations();
+  test_iterators_and_ranges();
 
   std::cout << "所有测试完成！" << std::endl;
 
@@ -0,0 +1,238 @@
+#include "fenwick_order_statistic.h"
+#include "order_statistic_tree.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace algorithms;
+
+void test_basic_operations() {
+  std::cout << "=== 测试基本操作 ===" << std::endl;
+
+  // 算法导论图14.1中的键
+  std::vector<int> values = {26, 17, 41, 14, 21, 30, 47, 10, 16, 19,
+                             21, 28, 38, 7,  12, 14, 20, 35, 39, 3};
+  FenwickOrderStatistic<int> fos(values);
+  for (int val : values) {
+    fos.insert(val);
+  }
+
+  std::cout << "元素数: " << fos.size() << ", 候选键数: "
+            << fos.universe_size() << std::endl;
+  std::cout << "按排名输出: ";
+  for (std::size_t i = 1; i <= fos.size(); ++i) {
+    std::cout << fos.select(i) << " ";
+  }
+  std::cout << std::endl;
+
+  std::cout << "元素14的排名: " << fos.rank(14) << ", 出现次数: "
+            << fos.count(14) << std::endl;
+  std::cout << "元素21的排名: " << fos.rank(21) << ", 出现次数: "
+            << fos.count(21) << std::endl;
+  std::cout << "小于25的元素个数: " << fos.count_less(25) << std::endl;
+  std::cout << "中位数: " << fos.quantile(0.5)
+            << ", 90分位数: " << fos.quantile(0.9) << std::endl;
+
+  fos.remove(21);
+  fos.remove(3);
+  std::cout << "删除21和3后，第1小: " << fos.select(1)
+            << ", 元素30的排名: " << fos.rank(30) << std::endl;
+
+  try {
+    fos.insert(100);
+  } catch (const std::invalid_argument &e) {
+    std::cout << "插入非候选键异常: " << e.what() << std::endl;
+  }
+  try {
+    fos.rank(3);
+  } catch (const std::runtime_error &e) {
+    std::cout << "查询已删除键异常: " << e.what() << std::endl;
+  }
+
+  fos.insert_batch({100, 1, 21, 100});
+  std::cout << "批量并入新键后，元素数: " << fos.size() << ", 最小: "
+            << fos.select(1) << ", 最大: " << fos.select(fos.size())
+            << ", 元素100的出现次数: " << fos.count(100) << std::endl;
+  std::cout << std::endl;
+}
+
+void test_consistency_with_tree() {
+  std::cout << "=== 与顺序统计树对比 ===" << std::endl;
+
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> dist(0, 999);
+  std::vector<int> universe(1000);
+  for (int i = 0; i < 1000; ++i) {
+    universe[i] = i;
+  }
+
+  FenwickOrderStatistic<int> fos(universe);
+  OrderStatisticTree<int> ost;
+  std::vector<int> inserted;
+  bool consistent = true;
+  for (int round = 0; round < 20000; ++round) {
+    int key = dist(rng);
+    if (!inserted.empty() && rng() % 4 == 0) {
+      std::size_t pos = rng() % inserted.size();
+      key = inserted[pos];
+      inserted[pos] = inserted.back();
+      inserted.pop_back();
+      consistent = consistent && fos.remove(key) && ost.remove(key);
+    } else {
+      fos.insert(key);
+      ost.insert(key);
+      inserted.push_back(key);
+    }
+  }
+
+  for (int i = 1; i <= ost.size(); ++i) {
+    consistent = consistent && fos.select(i) == ost.select(i);
+  }
+  std::sort(inserted.begin(), inserted.end());
+  for (std::size_t i = 0; i < inserted.size(); ++i) {
+    std::size_t first =
+        std::lower_bound(inserted.begin(), inserted.end(), inserted[i]) -
+        inserted.begin();
+    consistent = consistent && fos.rank(inserted[i]) == first + 1;
+  }
+
+  std::cout << "元素数: " << fos.size() << ", select/rank 与参照一致: "
+            << (consistent ? "是" : "否") << std::endl;
+  std::cout << std::endl;
+}
+
+void test_streaming_quantile() {
+  std::cout << "=== 测试流式分位数 ===" << std::endl;
+
+  StreamingQuantile<int> stream(1000);
+  std::atomic<bool> done(false);
+  std::atomic<bool> consistent(true);
+
+  // 读者线程：每个快照的大小都是批大小的整数倍，且分位数单调
+  std::thread reader([&]() {
+    while (!done.load()) {
+      auto snap = stream.snapshot();
+      if (snap->size() % 1000 != 0) {
+        consistent = false;
+      }
+      if (!snap->empty() && snap->quantile(0.5) > snap->quantile(0.99)) {
+        consistent = false;
+      }
+    }
+  });
+
+  std::mt19937 rng(11);
+  std::exponential_distribution<double> latency(1.0 / 20.0);
+  for (int i = 0; i < 100000; ++i) {
+    stream.insert(static_cast<int>(latency(rng)));
+  }
+  done = true;
+  reader.join();
+
+  std::cout << "已发布: " << stream.size()
+            << ", 待发布: " << stream.pending_size() << std::endl;
+  std::cout << "p50: " << stream.quantile(0.5)
+            << ", p99: " << stream.quantile(0.99)
+            << ", p999: " << stream.quantile(0.999) << std::endl;
+  std::cout << "读者看到的快照一致: " << (consistent ? "是" : "否")
+            << std::endl;
+  std::cout << std::endl;
+}
+
+void test_performance() {
+  std::cout << "=== 测试select/rank性能 ===" << std::endl;
+
+  // 键互不相同，使两种容器的 rank 定义一致
+  std::mt19937 rng(42);
+  std::vector<int> keys(1000000);
+  for (int &key : keys) {
+    key = static_cast<int>(rng() % 100000000);
+  }
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  std::shuffle(keys.begin(), keys.end(), rng);
+  const int n = static_cast<int>(keys.size());
+
+  auto elapsed_ms = [](std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::high_resolution_clock::now() - start)
+        .count();
+  };
+
+  auto start = std::chrono::high_resolution_clock::now();
+  OrderStatisticTree<int> ost;
+  ost.reserve(n);
+  for (int key : keys) {
+    ost.insert(key);
+  }
+  double ost_build_ms = elapsed_ms(start);
+
+  start = std::chrono::high_resolution_clock::now();
+  FenwickOrderStatistic<int> fos(keys);
+  for (int key : keys) {
+    fos.insert(key);
+  }
+  double fos_build_ms = elapsed_ms(start);
+
+  std::vector<int> ranks(n);
+  for (int &r : ranks) {
+    r = static_cast<int>(rng() % n) + 1;
+  }
+
+  long long checksum = 0;
+  start = std::chrono::high_resolution_clock::now();
+  for (int r : ranks) {
+    checksum += ost.select(r);
+  }
+  double ost_select_ms = elapsed_ms(start);
+
+  start = std::chrono::high_resolution_clock::now();
+  for (int r : ranks) {
+    checksum -= fos.select(r);
+  }
+  double fos_select_ms = elapsed_ms(start);
+
+  std::shuffle(keys.begin(), keys.end(), rng);
+  start = std::chrono::high_resolution_clock::now();
+  for (int key : keys) {
+    checksum += ost.rank(key);
+  }
+  double ost_rank_ms = elapsed_ms(start);
+
+  start = std::chrono::high_resolution_clock::now();
+  for (int key : keys) {
+    checksum -= static_cast<long long>(fos.rank(key));
+  }
+  double fos_rank_ms = elapsed_ms(start);
+
+  std::cout << "元素数: " << n
+            << ", 结果一致: " << (checksum == 0 ? "是" : "否") << std::endl;
+  std::cout << "建立: 顺序统计树 " << ost_build_ms << " ms, Fenwick "
+            << fos_build_ms << " ms" << std::endl;
+  std::cout << "select: 顺序统计树 " << ost_select_ms << " ms, Fenwick "
+            << fos_select_ms << " ms" << std::endl;
+  std::cout << "rank: 顺序统计树 " << ost_rank_ms << " ms, Fenwick "
+            << fos_rank_ms << " ms" << std::endl;
+  std::cout << "内存: 顺序统计树 " << ost.memory_bytes() / (1024 * 1024)
+            << " MiB, Fenwick " << fos.memory_bytes() / (1024 * 1024)
+            << " MiB" << std::endl;
+  std::cout << std::endl;
+}
+
+int main() {
+  std::cout << "第14.1章 Fenwick树顺序统计演示程序" << std::endl;
+  std::cout << "==================================" << std::endl;
+
+  test_basic_operations();
+  test_consistency_with_tree();
+  test_streaming_quantile();
+  test_performance();
+
+  std::cout << "所有测试完成！" << std::endl;
+
+  return 0;
+}
@@ -1,5 +1,7 @@
 #include "interval_tree.h"
+#include <chrono>
 #include <iostream>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -234,6 +236,121 @@ void test_complex_intervals() {
   std::cout << std::endl;
 }
 
+void test_overlap_queries() {
+  std::cout << "=== 测试全部重叠/点刺探/批量查询 ===" << std::endl;
+
+  std::vector<Interval> meetings = {
+      Interval(9, 10),  Interval(9, 12),  Interval(11, 13), Interval(14, 15),
+      Interval(10, 11), Interval(13, 17), Interval(16, 18), Interval(8, 9)};
+  IntervalTree<int> it;
+  for (const auto &m : meetings) {
+    it.insert(m);
+  }
+
+  std::cout << "与 [10, 13] 冲突的全部区间: ";
+  for (const auto &i : it.all_overlaps(Interval(10, 13))) {
+    std::cout << i << " ";
+  }
+  std::cout << std::endl;
+
+  std::cout << "包含时刻 9 的区间: ";
+  for (const auto &i : it.stab(9)) {
+    std::cout << i << " ";
+  }
+  std::cout << std::endl;
+
+  std::vector<Interval> queries = {Interval(17, 20), Interval(0, 7),
+                                   Interval(12, 14)};
+  auto batch = it.batch_overlaps(queries);
+  for (size_t q = 0; q < queries.size(); q++) {
+    std::cout << "批量查询 " << queries[q] << ": ";
+    for (const auto &i : batch[q]) {
+      std::cout << i << " ";
+    }
+    std::cout << "(" << batch[q].size() << "个)" << std::endl;
+  }
+
+  std::vector<std::pair<int, int>> raw;
+  for (const auto &m : meetings) {
+    raw.push_back({m.low, m.high});
+  }
+  StaticIntervalTree<int> static_tree(raw);
+  std::cout << "静态区间树中与 [10, 13] 冲突的区间: ";
+  for (auto id : static_tree.overlaps(10, 13)) {
+    std::cout << meetings[id] << " ";
+  }
+  std::cout << std::endl;
+
+  // 规模测试：随机短区间上的点刺探
+  const int n = 1000000;
+  const int universe = 100000000;
+  std::mt19937 rng(11);
+  std::vector<std::pair<int, int>> intervals(n);
+  for (auto &iv : intervals) {
+    int low = static_cast<int>(rng() % universe);
+    iv = {low, low + static_cast<int>(rng() % 1000)};
+  }
+
+  auto elapsed_ms = [](std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::high_resolution_clock::now() - start)
+        .count();
+  };
+
+  auto start = std::chrono::high_resolution_clock::now();
+  IntervalTree<int> dynamic_tree;
+  dynamic_tree.reserve(n);
+  for (const auto &iv : intervals) {
+    dynamic_tree.insert(Interval(iv.first, iv.second));
+  }
+  double dynamic_build_ms = elapsed_ms(start);
+
+  start = std::chrono::high_resolution_clock::now();
+  StaticIntervalTree<int> big(intervals);
+  double static_build_ms = elapsed_ms(start);
+
+  const int num_queries = 200000;
+  std::vector<Interval> points(num_queries);
+  std::vector<std::pair<int, int>> point_pairs(num_queries);
+  for (int i = 0; i < num_queries; i++) {
+    int p = static_cast<int>(rng() % universe);
+    points[i] = Interval(p, p);
+    point_pairs[i] = {p, p};
+  }
+
+  size_t dynamic_hits = 0;
+  start = std::chrono::high_resolution_clock::now();
+  for (const auto &p : points) {
+    dynamic_tree.for_each_overlap(p, [&](const Interval &) { dynamic_hits++; });
+  }
+  double dynamic_query_ms = elapsed_ms(start);
+
+  size_t batch_hits = 0;
+  start = std::chrono::high_resolution_clock::now();
+  for (const auto &r : dynamic_tree.batch_overlaps(points)) {
+    batch_hits += r.size();
+  }
+  double batch_query_ms = elapsed_ms(start);
+
+  size_t static_hits = 0;
+  start = std::chrono::high_resolution_clock::now();
+  for (const auto &p : point_pairs) {
+    static_hits += big.count_overlaps(p.first, p.second);
+  }
+  double static_query_ms = elapsed_ms(start);
+
+  std::cout << "区间数: " << n << ", 点查询: " << num_queries << std::endl;
+  std::cout << "建树: 区间树 " << dynamic_build_ms << " ms, 静态区间树 "
+            << static_build_ms << " ms" << std::endl;
+  std::cout << "点刺探: 区间树 " << dynamic_query_ms << " ms (命中 "
+            << dynamic_hits << "), 批量 " << batch_query_ms << " ms (命中 "
+            << batch_hits << "), 静态区间树 " << static_query_ms
+            << " ms (命中 " << static_hits << ")" << std::endl;
+  std::cout << "静态区间树内存: " << big.memory_bytes() / (1024 * 1024)
+            << " MiB" << std::endl;
+  std::cout << std::endl;
+}
+
 int main() {
   std::cout << "第14章 区间树演示程序" << std::endl;
   std::cout << "======================" << std::endl;
@@ -243,6 +360,7 @@ int main() {
   test_delete_operations();
   test_edge_cases();
   test_complex_intervals();
+  test_overlap_queries();
 
   std::cout << "所有测试完成！" << std::endl;
 
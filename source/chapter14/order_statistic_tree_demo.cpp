@@ -364,6 +364,35 @@ void test_string_ost() {
   std::cout << std::endl;
 }
 
+void test_iterators_and_ranges() {
+  std::cout << "=== 测试迭代器与区间查询 ===" << std::endl;
+
+  OrderStatisticTree<int> ost;
+  for (int key : {26, 17, 41, 14, 21, 30, 47, 10, 16, 19, 23, 28, 38}) {
+    ost.insert(key);
+  }
+
+  std::cout << "正向迭代: ";
+  for (int key : ost) {
+    std::cout << key << " ";
+  }
+  std::cout << std::endl;
+
+  // 区间视图配合rank：区间内元素个数可由两次rank直接得到
+  std::cout << "区间 [16, 30): ";
+  int count = 0;
+  for (int key : ost.range(16, 30)) {
+    std::cout << key << " ";
+    count++;
+  }
+  std::cout << "(共" << count << "个, rank(28) - rank(16) + 1 = "
+            << ost.rank(28) - ost.rank(16) + 1 << ")" << std::endl;
+  std::cout << "lower_bound(22): " << *ost.lower_bound(22)
+            << ", upper_bound(47) 是否为 end: "
+            << (ost.upper_bound(47) == ost.end() ? "是" : "否") << std::endl;
+  std::cout << std::endl;
+}
+
 int main() {
   std::cout << "第14.1章 动态顺序统计演示程序" << std::endl;
   std::cout << "==============================" << std::endl;
@@ -375,6 +404,7 @@ int main() {
   test_edge_cases();
   test_red_black_properties();
   test_string_ost();
+  test_iterators_and_ranges();
 
   std::cout << "所有测试完成！" << std::endl;
 
@@ -1,5 +1,7 @@
 #include "longest_common_subsequence.h"
+#include <chrono>
 #include <iostream>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -281,6 +283,56 @@ void test_large_sequences() {
   std::cout << std::endl;
 }
 
+bool is_subsequence(const std::string &sub, const std::string &seq) {
+  std::size_t j = 0;
+  for (char c : seq) {
+    if (j < sub.size() && sub[j] == c) {
+      j++;
+    }
+  }
+  return j == sub.size();
+}
+
+void test_linear_space() {
+  std::cout << "=== 线性空间与位并行 ===" << std::endl;
+
+  std::mt19937 gen(15);
+  const std::string alphabet = "ACGT";
+  std::string s1(8000, 'A'), s2(6000, 'A');
+  for (char &c : s1) {
+    c = alphabet[gen() % alphabet.size()];
+  }
+  for (char &c : s2) {
+    c = alphabet[gen() % alphabet.size()];
+  }
+  LongestCommonSubsequence lcs(s1, s2);
+
+  auto start = std::chrono::high_resolution_clock::now();
+  int two_rows = lcs.lcs_length_two_rows();
+  auto mid = std::chrono::high_resolution_clock::now();
+  int bit_parallel = lcs.lcs_length();
+  auto end = std::chrono::high_resolution_clock::now();
+  auto result = lcs.lcs_with_string();
+  auto done = std::chrono::high_resolution_clock::now();
+
+  auto ms = [](auto a, auto b) {
+    return std::chrono::duration<double, std::milli>(b - a).count();
+  };
+  std::cout << "序列长度: " << s1.size() << " 和 " << s2.size() << std::endl;
+  std::cout << "  两行DP: " << two_rows << " (" << ms(start, mid) << " ms)"
+            << std::endl;
+  std::cout << "  位并行: " << bit_parallel << " (" << ms(mid, end) << " ms)"
+            << std::endl;
+  std::cout << "  Hirschberg重构: " << result.length << " ("
+            << ms(end, done) << " ms)" << std::endl;
+
+  bool valid = two_rows == bit_parallel && result.length == bit_parallel &&
+               is_subsequence(result.lcs_string, s1) &&
+               is_subsequence(result.lcs_string, s2);
+  std::cout << "  验证: " << (valid ? "正确" : "错误") << std::endl;
+  std::cout << std::endl;
+}
+
 int main() {
   std::cout << "第15.4章 最长公共子序列演示程序" << std::endl;
   std::cout << "================================" << std::endl;
@@ -291,6 +343,7 @@ int main() {
   test_no_common_subsequence();
   test_algorithm_correctness();
   test_large_sequences();
+  test_linear_space();
 
   // 可选：DP表可视化（会输出较多内容）
   // test_dp_table_visualization();
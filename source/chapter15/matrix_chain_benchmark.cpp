@@ -0,0 +1,92 @@
+#include "matrix_chain_multiplication.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: matrix_chain_benchmark [求解的最长链长] [执行的链长]
+  int max_chain = argc > 1 ? std::atoi(argv[1]) : 800;
+  int exec_chain = argc > 2 ? std::atoi(argv[2]) : 16;
+
+  std::cout << "矩阵链乘法性能比较" << std::endl;
+  std::mt19937 rng(42);
+  bool consistent = true;
+
+  // 1. 求解：维度不超过30，int 版本的代价不会溢出
+  for (int n = max_chain / 4; n <= max_chain; n *= 2) {
+    std::vector<int> dimensions(n + 1);
+    for (int &d : dimensions) {
+      d = 1 + static_cast<int>(rng() % 30);
+    }
+    int classic_cost = 0;
+    double plan_cost = 0.0;
+    double classic_ms = time_ms([&] {
+      MatrixChainMultiplication mcm(dimensions);
+      classic_cost = mcm.get_minimum_scalar_multiplications();
+    });
+    double plan_ms = time_ms([&] {
+      MatrixChainPlan plan(dimensions);
+      plan_cost = plan.get_minimum_scalar_multiplications();
+    });
+    consistent = consistent && plan_cost == classic_cost;
+    std::cout << "n = " << n << ": 二维数组DP " << classic_ms
+              << " ms, 扁平表 MatrixChainPlan " << plan_ms << " ms"
+              << std::endl;
+  }
+
+  // 2. 执行：按最优顺序相乘（缓冲区复用）与从左到右逐个相乘
+  std::vector<int> dimensions(exec_chain + 1);
+  for (int &d : dimensions) {
+    d = 8 + static_cast<int>(rng() % 250);
+  }
+  std::uniform_real_distribution<double> value(-1.0, 1.0);
+  std::vector<Matrix> chain;
+  for (int t = 0; t < exec_chain; t++) {
+    Matrix m(dimensions[t], dimensions[t + 1]);
+    for (int i = 0; i < m.get_rows(); i++) {
+      for (int j = 0; j < m.get_cols(); j++) {
+        m(i, j) = value(rng);
+      }
+    }
+    chain.push_back(m);
+  }
+
+  Matrix naive(1, 1), planned(1, 1);
+  double naive_ms = time_ms([&] {
+    naive = chain[0];
+    for (int t = 1; t < exec_chain; t++) {
+      naive = naive.multiply(chain[t]);
+    }
+  });
+  MatrixChainPlan plan(dimensions);
+  plan.execute(chain); // 预热，分配缓冲区
+  double plan_ms = time_ms([&] { planned = plan.execute(chain); });
+
+  double max_error = 0.0, max_value = 0.0;
+  for (int i = 0; i < naive.get_rows(); i++) {
+    for (int j = 0; j < naive.get_cols(); j++) {
+      max_error = std::max(max_error, std::fabs(naive(i, j) - planned(i, j)));
+      max_value = std::max(max_value, std::fabs(naive(i, j)));
+    }
+  }
+  consistent = consistent && max_error <= 1e-9 * std::max(1.0, max_value);
+  std::cout << exec_chain << " 个矩阵: 从左到右相乘 " << naive_ms
+            << " ms, 按计划执行 " << plan_ms << " ms（缓冲区 "
+            << plan.arena_bytes() / 1024 << " KiB）" << std::endl;
+  std::cout << "结果一致: " << (consistent ? "是" : "否") << std::endl;
+
+  return consistent ? 0 : 1;
+}
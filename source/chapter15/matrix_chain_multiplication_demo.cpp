@@ -1,5 +1,7 @@
 #include "matrix_chain_multiplication.h"
+#include <cmath>
 #include <iostream>
+#include <random>
 #include <vector>
 
 using namespace algorithms;
@@ -211,6 +213,80 @@ void test_larger_chain() {
   std::cout << std::endl;
 }
 
+void test_execution_plan() {
+  std::cout << "=== 测试执行计划 MatrixChainPlan ===" << std::endl;
+
+  // 1. 随机维度下与教科书版本比较代价与括号化方案
+  std::mt19937 rng(15);
+  bool consistent = true;
+  for (int trial = 0; trial < 200; trial++) {
+    int n = 1 + static_cast<int>(rng() % 20);
+    std::vector<int> dimensions(n + 1);
+    for (int &d : dimensions) {
+      d = 1 + static_cast<int>(rng() % 40);
+    }
+    MatrixChainMultiplication mcm(dimensions);
+    MatrixChainPlan plan(dimensions);
+    consistent = consistent &&
+                 plan.get_minimum_scalar_multiplications() ==
+                     mcm.get_minimum_scalar_multiplications() &&
+                 plan.get_optimal_parenthesization() ==
+                     mcm.get_optimal_parenthesization();
+  }
+  std::cout << "200组随机维度与动态规划版本一致: "
+            << (consistent ? "是" : "否") << std::endl;
+
+  // 2. 按计划执行乘法，与从左到右逐个相乘比较
+  std::vector<int> dimensions = {30, 35, 15, 5, 10, 20, 25};
+  MatrixChainPlan plan(dimensions);
+  std::cout << "图15.3示例: " << plan.get_optimal_parenthesization()
+            << ", 乘法步骤 " << plan.get_steps().size() << " 步, 缓冲区 "
+            << plan.arena_bytes() << " 字节" << std::endl;
+
+  std::uniform_real_distribution<double> value(-1.0, 1.0);
+  std::vector<Matrix> chain;
+  for (std::size_t t = 0; t + 1 < dimensions.size(); t++) {
+    // 混入列主序矩阵，检验布局转换
+    Matrix m(dimensions[t], dimensions[t + 1],
+             t % 2 == 0 ? MatrixLayout::RowMajor : MatrixLayout::ColumnMajor);
+    for (int i = 0; i < m.get_rows(); i++) {
+      for (int j = 0; j < m.get_cols(); j++) {
+        m(i, j) = value(rng);
+      }
+    }
+    chain.push_back(m);
+  }
+  Matrix expected = chain[0];
+  for (std::size_t t = 1; t < chain.size(); t++) {
+    expected = expected.multiply(chain[t]);
+  }
+
+  bool close = true;
+  for (int round = 0; round < 2; round++) { // 第二次复用缓冲区
+    Matrix result = plan.execute(chain);
+    close = close && result.get_rows() == expected.get_rows() &&
+            result.get_cols() == expected.get_cols();
+    for (int i = 0; close && i < result.get_rows(); i++) {
+      for (int j = 0; j < result.get_cols(); j++) {
+        if (std::fabs(result(i, j) - expected(i, j)) > 1e-9) {
+          close = false;
+        }
+      }
+    }
+  }
+  std::cout << "执行结果与逐个相乘一致: " << (close ? "是" : "否")
+            << std::endl;
+
+  try {
+    chain.pop_back();
+    plan.execute(chain);
+  } catch (const std::exception &e) {
+    std::cout << "矩阵个数不符时捕获异常: " << e.what() << std::endl;
+  }
+
+  std::cout << std::endl;
+}
+
 int main() {
   std::cout << "第15.2章 矩阵链乘法演示程序" << std::endl;
   std::cout << "=============================" << std::endl;
@@ -223,6 +299,7 @@ int main() {
   test_chain_operations();
   test_comparison_both_versions();
   test_larger_chain();
+  test_execution_plan();
 
   std::cout << "所有测试完成！" << std::endl;
 
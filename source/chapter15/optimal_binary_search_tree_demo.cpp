@@ -1,7 +1,9 @@
 #include "optimal_binary_search_tree.h"
+#include <chrono>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -302,6 +304,52 @@ void test_comparison_with_normal_bst() {
   std::cout << std::endl;
 }
 
+void test_knuth_optimization() {
+  std::cout << "=== Knuth优化 ===" << std::endl;
+  using Tree = OptimalBinarySearchTree<int>;
+
+  // 随机实例上与三重循环比较期望成本
+  std::mt19937 gen(41);
+  bool same_cost = true;
+  for (int round = 0; round < 100; round++) {
+    int n = 1 + gen() % 80;
+    std::vector<int> keys(n);
+    std::vector<double> probabilities(n);
+    for (int i = 0; i < n; i++) {
+      keys[i] = i;
+      probabilities[i] = (gen() % 100) / 100.0 / n;
+    }
+    Tree cubic(keys, probabilities);
+    Tree knuth(keys, probabilities, Tree::BuildMode::Knuth);
+    same_cost = same_cost && std::fabs(cubic.get_expected_cost() -
+                                       knuth.get_expected_cost()) < 1e-9;
+  }
+  std::cout << "100个随机实例的期望成本: " << (same_cost ? "一致" : "不一致")
+            << std::endl;
+
+  int n = 500;
+  std::vector<int> keys(n);
+  std::vector<double> probabilities(n);
+  for (int i = 0; i < n; i++) {
+    keys[i] = i;
+    probabilities[i] = (1 + gen() % 1000) / 1000.0 / n;
+  }
+  auto start = std::chrono::high_resolution_clock::now();
+  Tree knuth(keys, probabilities, Tree::BuildMode::Knuth);
+  auto mid = std::chrono::high_resolution_clock::now();
+  Tree cubic(keys, probabilities);
+  auto end = std::chrono::high_resolution_clock::now();
+  std::cout << n << " 个键: Knuth O(n²) "
+            << std::chrono::duration<double, std::milli>(mid - start).count()
+            << " ms, 三重循环 O(n³) "
+            << std::chrono::duration<double, std::milli>(end - mid).count()
+            << " ms, 期望成本 " << std::fixed << std::setprecision(6)
+            << knuth.get_expected_cost() << " / " << cubic.get_expected_cost()
+            << std::endl;
+
+  std::cout << std::endl;
+}
+
 int main() {
   std::cout << "第15.5章 最优二叉搜索树演示程序" << std::endl;
   std::cout << "==================================" << std::endl;
@@ -311,6 +359,7 @@ int main() {
   test_different_probability_patterns();
   test_algorithm_correctness();
   test_comparison_with_normal_bst();
+  test_knuth_optimization();
 
   // 可选：DP表可视化（会输出较多内容）
   // test_dp_table_visualization();
@@ -0,0 +1,59 @@
+#include "rod_cutting.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: rod_cutting_benchmark [价格表长度] [大规模钢条长度]
+  int table_size = argc > 1 ? std::atoi(argv[1]) : 20000;
+  int long_rod = argc > 2 ? std::atoi(argv[2]) : 1000000;
+
+  std::cout << "钢条切割 / 完全背包性能比较" << std::endl;
+  std::mt19937 rng(7);
+  std::vector<int> prices(table_size + 1);
+  prices[0] = 0;
+  for (int i = 1; i <= table_size; i++) {
+    // 价格大致随长度线性增长，带随机波动
+    prices[i] = 3 * i + static_cast<int>(rng() % 50);
+  }
+  RodCutting rc(prices);
+  auto engine = UnboundedKnapsack<long long>::from_prices(prices);
+
+  int classic = 0;
+  long long fast = 0;
+  double classic_ms = time_ms([&] { classic = rc.cut_rod_bottom_up(table_size); });
+  double fast_ms = time_ms([&] { fast = engine.max_value(table_size); });
+  bool consistent = classic == fast;
+  std::cout << "n = " << table_size << "（价格表同长）: cut_rod_bottom_up "
+            << classic_ms << " ms, UnboundedKnapsack " << fast_ms << " ms"
+            << std::endl;
+
+  // 价格表只覆盖前 1000 个长度，钢条长度 long_rod
+  std::vector<int> short_table(prices.begin(),
+                               prices.begin() + std::min(table_size, 1000) + 1);
+  auto long_engine = UnboundedKnapsack<long long>::from_prices(short_table);
+  long long bottom_up = 0, top_down = 0;
+  double bottom_up_ms =
+      time_ms([&] { bottom_up = long_engine.max_value(long_rod); });
+  double top_down_ms =
+      time_ms([&] { top_down = long_engine.max_value_top_down(long_rod); });
+  consistent = consistent && bottom_up == top_down;
+  std::cout << "n = " << long_rod << ", " << short_table.size() - 1
+            << " 种长度: 自底向上 " << bottom_up_ms << " ms, 自顶向下（显式栈） "
+            << top_down_ms << " ms" << std::endl;
+  std::cout << "结果一致: " << (consistent ? "是" : "否") << std::endl;
+
+  return consistent ? 0 : 1;
+}
@@ -1,5 +1,7 @@
 #include "rod_cutting.h"
 #include <iostream>
+#include <numeric>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -220,6 +222,73 @@ void test_algorithm_correctness() {
   }
 }
 
+void test_unbounded_knapsack() {
+  std::cout << "=== 测试完全背包引擎 UnboundedKnapsack ===" << std::endl;
+
+  // 1. 随机价格表：与自底向上解法、备忘录解法比较
+  std::mt19937 rng(151);
+  bool consistent = true;
+  for (int trial = 0; trial < 100; trial++) {
+    int size = 2 + static_cast<int>(rng() % 60);
+    std::vector<int> prices(size);
+    prices[0] = 0;
+    for (int i = 1; i < size; i++) {
+      prices[i] = static_cast<int>(rng() % 100);
+    }
+    RodCutting rc(prices);
+    auto engine64 = UnboundedKnapsack<long long>::from_prices(prices);
+    auto engine32 = UnboundedKnapsack<int>::from_prices(prices);
+    int n = size - 1;
+    auto best = engine64.solve(n);
+    auto best32 = engine32.solve(n);
+    for (int length = 0; length <= n; length++) {
+      int expected = rc.cut_rod_bottom_up(length);
+      consistent = consistent && best[length] == expected &&
+                   best32[length] == expected;
+    }
+    consistent = consistent && engine64.max_value_top_down(n) == best[n] &&
+                 rc.cut_rod_memoized(n) == best[n];
+
+    long long total = 0;
+    for (int id : engine64.reconstruct(best, n)) {
+      total += engine64.get_items()[id].value;
+    }
+    consistent = consistent && total == best[n];
+  }
+  std::cout << "100组随机价格表与教科书解法一致: "
+            << (consistent ? "是" : "否") << std::endl;
+
+  // 2. 一般的完全背包：重量不连续的物品
+  UnboundedKnapsack<long long> knapsack({{5, 10}, {4, 40}, {6, 30}, {3, 50}});
+  auto best = knapsack.solve(10);
+  std::cout << "物品(重量,价值) = (5,10) (4,40) (6,30) (3,50), 容量10 的最大价值: "
+            << best[10] << "，自顶向下: " << knapsack.max_value_top_down(10)
+            << std::endl;
+
+  // 3. 长度远大于价格表：收益超出 int 范围，备忘录解法也不会栈溢出
+  auto price_table = get_example_price_table();
+  RodCutting rc(price_table);
+  int n = 1000000;
+  long long revenue = rc.cut_rod_unbounded(n);
+  auto engine = UnboundedKnapsack<long long>::from_prices(price_table);
+  std::cout << "图15-1价格表、长度 " << n << " 的最大收益: " << revenue
+            << "，自顶向下一致: "
+            << (engine.max_value_top_down(n) == revenue ? "是" : "否")
+            << std::endl;
+
+  UnboundedKnapsack<long long> expensive({{1, 3000000000LL}});
+  std::cout << "单价 3e9、长度 " << n
+            << " 的收益（64位）: " << expensive.max_value(n) << std::endl;
+
+  try {
+    UnboundedKnapsack<int> invalid({{0, 1}});
+  } catch (const std::invalid_argument &e) {
+    std::cout << "重量为0时捕获异常: " << e.what() << std::endl;
+  }
+
+  std::cout << std::endl;
+}
+
 int main() {
   std::cout << "第15章 钢条切割演示程序" << std::endl;
   std::cout << "========================" << std::endl;
@@ -228,6 +297,7 @@ int main() {
   test_edge_cases();
   test_different_price_patterns();
   test_algorithm_correctness();
+  test_unbounded_knapsack();
 
   // 注意：性能对比测试需要包含chrono头文件
   // test_performance_comparison();
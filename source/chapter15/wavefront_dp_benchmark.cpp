@@ -0,0 +1,112 @@
+#include "longest_common_subsequence.h"
+#include "matrix_chain_multiplication.h"
+#include "optimal_binary_search_tree.h"
+#include "work_stealing_scheduler.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace algorithms;
+
+double elapsed_ms(std::chrono::high_resolution_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+/**
+ * @brief 先串行计算一次作为基准，再用不同线程数的波前并行版本计算并比较结果
+ */
+template <typename Serial, typename Parallel>
+bool run(const std::string &name, const std::vector<std::size_t> &threads,
+         Serial serial, Parallel parallel) {
+  auto start = std::chrono::high_resolution_clock::now();
+  auto expected = serial();
+  double serial_ms = elapsed_ms(start);
+  std::cout << name << " 串行: " << serial_ms << " ms" << std::endl;
+
+  bool consistent = true;
+  for (std::size_t count : threads) {
+    WorkStealingScheduler scheduler(count);
+    start = std::chrono::high_resolution_clock::now();
+    auto actual = parallel(scheduler);
+    double ms = elapsed_ms(start);
+    consistent = consistent && actual == expected;
+    std::cout << "  " << count << " 线程: " << ms << " ms, 加速比 "
+              << serial_ms / ms << (actual == expected ? "" : " (不一致)")
+              << std::endl;
+  }
+  return consistent;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: wavefront_dp_benchmark [矩阵链长度] [OBST键数] [LCS序列长度]
+  int chain_length = argc > 1 ? std::atoi(argv[1]) : 600;
+  int key_count = argc > 2 ? std::atoi(argv[2]) : 600;
+  std::size_t lcs_length = argc > 3 ? std::atoi(argv[3]) : 200000;
+
+  std::vector<std::size_t> threads = {1, 2, 4};
+  std::size_t hardware = std::thread::hardware_concurrency();
+  if (hardware > 4) {
+    threads.push_back(hardware);
+  }
+  std::cout << "动态规划表的分块波前并行（硬件线程数 " << hardware << "）"
+            << std::endl;
+
+  std::mt19937 gen(40);
+  bool consistent = true;
+
+  std::vector<int> dims(chain_length + 1);
+  for (int &d : dims) {
+    d = 1 + gen() % 30;
+  }
+  consistent &= run(
+      "矩阵链乘法 n=" + std::to_string(chain_length), threads,
+      [&] {
+        MatrixChainMultiplication mcm(dims);
+        return mcm.get_optimal_parenthesization();
+      },
+      [&](WorkStealingScheduler &scheduler) {
+        MatrixChainMultiplication mcm(dims, scheduler);
+        return mcm.get_optimal_parenthesization();
+      });
+
+  std::vector<int> keys(key_count);
+  std::vector<double> probabilities(key_count);
+  for (int i = 0; i < key_count; i++) {
+    keys[i] = i;
+    probabilities[i] = (1 + gen() % 1000) / 1000.0 / key_count;
+  }
+  consistent &= run(
+      "最优二叉搜索树 n=" + std::to_string(key_count), threads,
+      [&] {
+        OptimalBinarySearchTree<int> obst(keys, probabilities);
+        return obst.preorder_traversal();
+      },
+      [&](WorkStealingScheduler &scheduler) {
+        OptimalBinarySearchTree<int> obst(keys, probabilities, scheduler);
+        return obst.preorder_traversal();
+      });
+
+  std::string s1(lcs_length, 'A'), s2(lcs_length, 'A');
+  for (char &c : s1) {
+    c = static_cast<char>('A' + gen() % 20);
+  }
+  for (char &c : s2) {
+    c = static_cast<char>('A' + gen() % 20);
+  }
+  LongestCommonSubsequence lcs(s1, s2);
+  consistent &= run(
+      "位并行LCS长度 n=" + std::to_string(lcs_length), threads,
+      [&] { return lcs.lcs_length(); },
+      [&](WorkStealingScheduler &scheduler) {
+        return lcs.lcs_length(scheduler);
+      });
+
+  std::cout << "结果一致: " << (consistent ? "是" : "否") << std::endl;
+  return consistent ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+#include "canonical_huffman.h"
+#include "greedy_algorithms.h"
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+// 类似日志的文本：固定的字段名、时间戳与随机数字
+std::string make_log(std::size_t bytes) {
+  static const char *levels[] = {"INFO", "WARN", "DEBUG", "ERROR"};
+  static const char *messages[] = {"request served", "cache miss",
+                                   "connection reset by peer",
+                                   "retrying upstream", "slow query"};
+  std::mt19937 rng(16);
+  std::string log;
+  log.reserve(bytes + 128);
+  while (log.size() < bytes) {
+    log += "2024-05-";
+    log += std::to_string(10 + rng() % 20);
+    log += " ";
+    log += levels[rng() % 4];
+    log += " worker=";
+    log += std::to_string(rng() % 64);
+    log += " latency_us=";
+    log += std::to_string(rng() % 100000);
+    log += " ";
+    log += messages[rng() % 5];
+    log += "\n";
+  }
+  log.resize(bytes);
+  return log;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: canonical_huffman_benchmark [数据MB数]
+  std::size_t megabytes = argc > 1 ? std::atoi(argv[1]) : 64;
+  std::string data = make_log(megabytes << 20);
+  double mb = static_cast<double>(data.size()) / (1 << 20);
+
+  std::cout << "范式赫夫曼编码性能测试（" << megabytes << " MB 日志文本）"
+            << std::endl;
+
+  std::vector<std::uint8_t> packed;
+  std::string restored;
+  double compress_ms =
+      time_ms([&] { packed = CanonicalHuffmanCodec::compress(data); });
+  double decompress_ms =
+      time_ms([&] { restored = CanonicalHuffmanCodec::decompress(packed); });
+  bool consistent = restored == data;
+  std::cout << "压缩 " << mb / compress_ms * 1000 << " MB/s，解压 "
+            << mb / decompress_ms * 1000 << " MB/s，压缩率 "
+            << 100.0 * packed.size() / data.size() << "%" << std::endl;
+
+  // 频率统计：std::map、单张计数表、4张交错子表
+  std::map<char, std::uint64_t> map_counts;
+  std::array<std::uint64_t, 256> single{}, interleaved{};
+  double map_ms = time_ms([&] {
+    for (char ch : data) {
+      map_counts[ch]++;
+    }
+  });
+  double single_ms = time_ms([&] {
+    for (char ch : data) {
+      single[static_cast<unsigned char>(ch)]++;
+    }
+  });
+  double interleaved_ms =
+      time_ms([&] { interleaved = LengthLimitedHuffman::histogram(data); });
+  consistent = consistent && single == interleaved;
+  for (const auto &pair : map_counts) {
+    consistent = consistent &&
+                 pair.second == single[static_cast<unsigned char>(pair.first)];
+  }
+  std::cout << "频率统计: std::map " << mb / map_ms * 1000 << " MB/s，单表 "
+            << mb / single_ms * 1000 << " MB/s，4张子表 "
+            << mb / interleaved_ms * 1000 << " MB/s" << std::endl;
+
+  // package-merge：2^16 个符号
+  std::mt19937 rng(45);
+  std::vector<std::uint64_t> wide(LengthLimitedHuffman::kMaxAlphabet);
+  for (auto &f : wide) {
+    f = 1 + rng() % 100000;
+  }
+  std::vector<std::uint8_t> wide_lengths;
+  double merge_ms = time_ms(
+      [&] { wide_lengths = LengthLimitedHuffman::code_lengths(wide, 20); });
+  std::cout << "package-merge（65536个符号，上限20位）: " << merge_ms << " ms"
+            << std::endl;
+
+  // 指针树版本：'0'/'1' 字符串编码、逐位遍历解码（只取前 1 MB）
+  std::string sample = data.substr(0, 1 << 20);
+  std::map<char, int> frequencies;
+  for (char ch : sample) {
+    frequencies[ch]++;
+  }
+  HuffmanCoding huffman;
+  huffman.build_huffman_tree(frequencies);
+  std::string bits, decoded;
+  double encode_ms = time_ms([&] { bits = huffman.encode(sample); });
+  double decode_ms = time_ms([&] { decoded = huffman.decode(bits); });
+  consistent = consistent && decoded == sample;
+  std::cout << "HuffmanCoding（1 MB）: 编码 " << 1000 / encode_ms
+            << " MB/s，解码 " << 1000 / decode_ms << " MB/s，输出 "
+            << bits.size() / (1 << 20) << " MB 的 '0'/'1' 字符串" << std::endl;
+  std::cout << "结果一致: " << (consistent ? "是" : "否") << std::endl;
+
+  return consistent ? 0 : 1;
+}
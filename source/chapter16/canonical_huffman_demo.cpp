@@ -0,0 +1,249 @@
+#include "canonical_huffman.h"
+#include "greedy_algorithms.h"
+#include <iostream>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace algorithms;
+
+void test_classic_example() {
+  std::cout << "=== 图16.5示例的范式编码 ===" << std::endl;
+
+  std::map<char, int> frequencies = {{'a', 45}, {'b', 13}, {'c', 12},
+                                     {'d', 16}, {'e', 9},  {'f', 5}};
+  CanonicalHuffmanCodec::Frequencies freq{};
+  for (const auto &pair : frequencies) {
+    freq[static_cast<unsigned char>(pair.first)] = pair.second;
+  }
+  CanonicalHuffmanCodec codec = CanonicalHuffmanCodec::from_frequencies(freq);
+
+  HuffmanCoding huffman;
+  huffman.build_huffman_tree(frequencies);
+
+  long long canonical_cost = 0, tree_cost = 0;
+  for (const auto &pair : frequencies) {
+    std::cout << "  " << pair.first << ": 范式编码 "
+              << codec.code_string(pair.first) << "，指针树编码 "
+              << huffman.get_code(pair.first) << std::endl;
+    canonical_cost += pair.second * codec.code_length(pair.first);
+    tree_cost += pair.second * huffman.get_code(pair.first).size();
+  }
+  std::cout << "加权码长: 范式 " << canonical_cost << "，指针树 " << tree_cost
+            << (canonical_cost == tree_cost ? "（相同）" : "（不同）")
+            << std::endl;
+
+  std::string text = "abacabfedcba";
+  auto packed = CanonicalHuffmanCodec::compress(text);
+  std::cout << "\"" << text << "\" 的位流: " << codec.encoded_bits(text)
+            << " 位，压缩数据 " << packed.size() << " 字节（含 "
+            << CanonicalHuffmanCodec::kHeaderBytes << " 字节头部），'0'/'1' 字符串 "
+            << huffman.encode(text).size() << " 字节" << std::endl;
+  std::cout << "解压结果: " << CanonicalHuffmanCodec::decompress(packed)
+            << std::endl;
+  std::cout << std::endl;
+}
+
+void test_round_trip() {
+  std::cout << "=== 随机数据往返与流式接口 ===" << std::endl;
+
+  std::mt19937 rng(163);
+  bool ok = true;
+  for (int trial = 0; trial < 200; trial++) {
+    // 偏斜分布：字母表大小与长度随机
+    int alphabet = 1 + static_cast<int>(rng() % 256);
+    std::geometric_distribution<int> skew(0.05 + 0.5 * (rng() % 100) / 100.0);
+    std::string data(rng() % 5000, '\0');
+    for (char &ch : data) {
+      ch = static_cast<char>(skew(rng) % alphabet);
+    }
+    ok = ok && CanonicalHuffmanCodec::decompress(
+                   CanonicalHuffmanCodec::compress(data)) == data;
+
+    // 分块编码、以不同的分块解码
+    CanonicalHuffmanCodec codec = CanonicalHuffmanCodec::from_data(data);
+    auto encoder = codec.encoder();
+    std::vector<std::uint8_t> stream;
+    for (std::size_t pos = 0; pos < data.size();) {
+      std::size_t len = std::min<std::size_t>(1 + rng() % 300, data.size() - pos);
+      encoder.write(std::string_view(data).substr(pos, len), stream);
+      pos += len;
+    }
+    encoder.finish(stream);
+
+    auto decoder = codec.decoder(data.size());
+    std::string decoded;
+    for (std::size_t pos = 0; pos < stream.size();) {
+      std::size_t len = std::min<std::size_t>(1 + rng() % 17, stream.size() - pos);
+      decoder.feed(stream.data() + pos, len, decoded);
+      pos += len;
+    }
+    ok = ok && decoder.finished() && decoded == data;
+  }
+  std::cout << "200组随机数据往返一致: " << (ok ? "是" : "否") << std::endl;
+
+  // 斐波那契频率使赫夫曼码长达到 n-1，验证码长上限
+  CanonicalHuffmanCodec::Frequencies freq{};
+  std::uint64_t a = 1, b = 1;
+  for (int s = 0; s < 30; s++) {
+    freq['A' + s] = a;
+    std::uint64_t next = a + b;
+    a = b;
+    b = next;
+  }
+  CanonicalHuffmanCodec limited = CanonicalHuffmanCodec::from_frequencies(freq);
+  int longest = 0;
+  std::string sample;
+  for (int s = 0; s < 30; s++) {
+    longest = std::max(longest, limited.code_length('A' + s));
+    sample += std::string(1 + s % 3, static_cast<char>('A' + s));
+  }
+  auto packed = CanonicalHuffmanCodec::compress(sample);
+  std::cout << "斐波那契频率（30个字节）的最长码: " << longest << " 位（上限 "
+            << CanonicalHuffmanCodec::kMaxCodeLength << "），往返一致: "
+            << (CanonicalHuffmanCodec::decompress(packed) == sample ? "是" : "否")
+            << std::endl;
+
+  try {
+    packed.resize(CanonicalHuffmanCodec::kHeaderBytes + 2);
+    CanonicalHuffmanCodec::decompress(packed);
+  } catch (const std::exception &e) {
+    std::cout << "截断的数据: " << e.what() << std::endl;
+  }
+  try {
+    limited.encoder().write("xyz", packed);
+  } catch (const std::invalid_argument &e) {
+    std::cout << "编码表外的字节: " << e.what() << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+// 不限码长的赫夫曼编码的加权码长：每次合并的权值之和
+std::uint64_t huffman_cost(const std::vector<std::uint64_t> &freq) {
+  std::priority_queue<std::uint64_t, std::vector<std::uint64_t>,
+                      std::greater<std::uint64_t>>
+      pq;
+  for (std::uint64_t f : freq) {
+    if (f > 0) {
+      pq.push(f);
+    }
+  }
+  std::uint64_t cost = 0;
+  while (pq.size() > 1) {
+    std::uint64_t a = pq.top();
+    pq.pop();
+    std::uint64_t b = pq.top();
+    pq.pop();
+    cost += a + b;
+    pq.push(a + b);
+  }
+  return cost;
+}
+
+std::uint64_t weighted_length(const std::vector<std::uint64_t> &freq,
+                              const std::vector<std::uint8_t> &lengths) {
+  std::uint64_t cost = 0;
+  for (std::size_t s = 0; s < freq.size(); s++) {
+    cost += freq[s] * lengths[s];
+  }
+  return cost;
+}
+
+void test_package_merge() {
+  std::cout << "=== package-merge 码长受限编码 ===" << std::endl;
+
+  // 1. 上限足够大时与不限码长的赫夫曼编码代价相同；上限收紧时Kraft和恰为1
+  std::mt19937 rng(45);
+  bool optimal = true, complete = true, monotone = true;
+  for (int trial = 0; trial < 100; trial++) {
+    std::vector<std::uint64_t> freq(2 + rng() % 300);
+    for (auto &f : freq) {
+      f = rng() % 4 == 0 ? 0 : 1 + (rng() % 1000) * (rng() % 1000);
+    }
+    freq[0] = freq[1] = 1;
+    auto unlimited = LengthLimitedHuffman::code_lengths(freq, 32);
+    optimal = optimal && weighted_length(freq, unlimited) == huffman_cost(freq);
+
+    std::uint64_t previous = 0;
+    for (int limit = 32; limit >= 9; limit--) {
+      auto lengths = LengthLimitedHuffman::code_lengths(freq, limit);
+      std::uint64_t kraft = 0;
+      for (std::uint8_t len : lengths) {
+        monotone = monotone && len <= limit;
+        kraft += len > 0 ? std::uint64_t(1) << (32 - len) : 0;
+      }
+      complete = complete && kraft == (std::uint64_t(1) << 32);
+      std::uint64_t cost = weighted_length(freq, lengths);
+      monotone = monotone && cost >= previous;
+      previous = cost;
+    }
+  }
+  std::cout << "上限充足时与赫夫曼编码代价相同: " << (optimal ? "是" : "否")
+            << "；各上限下Kraft和均为1: " << (complete ? "是" : "否")
+            << "；码长不超限且代价随上限收紧不减: " << (monotone ? "是" : "否")
+            << std::endl;
+
+  // 2. 2^16 个符号的Zipf分布，限制在20位以内
+  std::vector<std::uint16_t> symbols(1 << 20);
+  for (auto &sym : symbols) {
+    double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    sym = static_cast<std::uint16_t>(std::pow(65536.0, u) - 1);
+  }
+  auto freq = LengthLimitedHuffman::histogram(symbols.data(), symbols.size(),
+                                              LengthLimitedHuffman::kMaxAlphabet);
+  auto lengths = LengthLimitedHuffman::code_lengths(freq, 20);
+  auto codes = LengthLimitedHuffman::canonical_codes(lengths);
+  int used = 0, longest = 0;
+  for (std::size_t s = 0; s < lengths.size(); s++) {
+    used += lengths[s] > 0;
+    longest = std::max(longest, static_cast<int>(lengths[s]));
+  }
+  std::cout << "16位字母表: " << used << " 个符号出现，最长码 " << longest
+            << " 位，平均码长 "
+            << static_cast<double>(weighted_length(freq, lengths)) /
+                   symbols.size()
+            << " 位，符号0的码字 " << codes[0] << std::endl;
+
+  // 3. 字节直方图与逐字节计数一致；编码器可设更小的码长上限
+  std::string text(100003, '\0');
+  for (char &ch : text) {
+    ch = static_cast<char>(rng() % 7 == 0 ? rng() : rng() % 4);
+  }
+  auto hist = LengthLimitedHuffman::histogram(text);
+  bool counted = true;
+  std::array<std::uint64_t, 256> naive{};
+  for (char ch : text) {
+    naive[static_cast<unsigned char>(ch)]++;
+  }
+  counted = hist == naive;
+  CanonicalHuffmanCodec codec12 = CanonicalHuffmanCodec::from_data(text, 12);
+  int longest12 = 0;
+  for (int s = 0; s < 256; s++) {
+    longest12 = std::max(longest12, codec12.code_length(s));
+  }
+  std::cout << "字节直方图正确: " << (counted ? "是" : "否")
+            << "；上限12位时最长码 " << longest12 << " 位" << std::endl;
+
+  try {
+    LengthLimitedHuffman::code_lengths(std::vector<std::uint64_t>(300, 1), 8);
+  } catch (const std::invalid_argument &e) {
+    std::cout << "300个符号限制在8位: " << e.what() << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+int main() {
+  std::cout << "第16.3节 范式赫夫曼编码演示程序" << std::endl;
+  std::cout << "================================" << std::endl;
+
+  test_classic_example();
+  test_round_trip();
+  test_package_merge();
+
+  std::cout << "所有测试完成！" << std::endl;
+  return 0;
+}
@@ -1,6 +1,10 @@
 #include "amortized_analysis.h"
+#include "stack_queue.h"
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <random>
 #include <vector>
 
 using namespace algorithms;
@@ -13,6 +17,7 @@ using namespace algorithms;
  * - 17.2节 记账方法：支持MULTIPOP的栈
  * - 17.3节 势能方法：动态表
  * - 17.4节 动态表扩张和收缩
+ * - 17.4节 可配置扩张收缩策略的动态表：实测可增长栈和分块双端队列的摊还代价
  */
 
 void test_binary_counter_aggregate_analysis() {
@@ -173,6 +178,101 @@ void test_table_expansion_contraction() {
   std::cout << std::endl;
 }
 
+// 对可增长栈执行先增长、再随机混合、最后清空的操作序列，
+// 实际代价 = 1 + 本次扩张或收缩搬移的元素数
+void measure_growable_stack(const char *name, DynamicTablePolicy policy) {
+  GrowableStack<int> stack(1, policy);
+  PotentialMethodAnalyzer analyzer;
+  // 势能函数一般不是整数，四舍五入后交给分析器
+  analyzer.record_operation(0, static_cast<int>(std::lround(stack.potential())));
+  std::mt19937 gen(17);
+  int max_actual = 0, max_amortized = 0;
+  auto record = [&](size_t moved_before) {
+    int actual = 1 + static_cast<int>(stack.moved_elements() - moved_before);
+    int amortized = analyzer.record_operation(
+        actual, static_cast<int>(std::lround(stack.potential())));
+    max_actual = std::max(max_actual, actual);
+    max_amortized = std::max(max_amortized, amortized);
+  };
+
+  for (int i = 0; i < 60000; ++i) {
+    size_t moved = stack.moved_elements();
+    stack.push(i);
+    record(moved);
+  }
+  for (int i = 0; i < 60000; ++i) {
+    size_t moved = stack.moved_elements();
+    if (gen() % 2 == 0) {
+      stack.push(i);
+    } else {
+      stack.pop();
+    }
+    record(moved);
+  }
+  while (!stack.empty()) {
+    size_t moved = stack.moved_elements();
+    stack.pop();
+    record(moved);
+  }
+
+  int ops = analyzer.get_operation_count() - 1;
+  std::cout << std::setw(22) << name << std::setw(8) << ops << std::setw(8)
+            << stack.resizes() << std::setw(12) << std::fixed
+            << std::setprecision(3)
+            << static_cast<double>(analyzer.get_total_actual_cost()) / ops
+            << std::setw(10) << max_actual << std::setw(12) << max_amortized
+            << std::endl;
+}
+
+void test_growable_containers_measured_cost() {
+  std::cout << "=== 17.4节 可配置策略的动态表：实测摊还代价 ===" << std::endl;
+
+  std::cout << "可增长栈（GrowableStack），势能函数为17.4.2节的推广：" << std::endl;
+  std::cout << std::setw(22) << "策略" << std::setw(8) << "操作数"
+            << std::setw(8) << "调整数" << std::setw(12) << "平均实际代价"
+            << std::setw(10) << "最大实际" << std::setw(12) << "最大摊还"
+            << std::endl;
+  std::cout << std::string(72, '-') << std::endl;
+
+  measure_growable_stack("x2, 满时扩, 1/4时缩", DynamicTablePolicy{});
+  measure_growable_stack("x2, 3/4时扩, 1/4时缩",
+                         DynamicTablePolicy{2.0, 0.75, 0.25});
+  measure_growable_stack("x1.5, 满时扩, 1/3时缩",
+                         DynamicTablePolicy{1.5, 1.0, 1.0 / 3});
+  std::cout << "单次扩张的实际代价可达Θ(n)，但摊还代价有常数上界，"
+               "平均实际代价也是常数"
+            << std::endl;
+
+  try {
+    GrowableStack<int> bad(1, DynamicTablePolicy{2.0, 1.0, 0.5});
+  } catch (const std::invalid_argument &e) {
+    std::cout << "收缩阈值1/2、扩张倍数2: " << e.what() << std::endl;
+  }
+
+  // 分块双端队列：从不搬移元素，只在块表调整时搬移块指针
+  ChunkedDeque<int> deque;
+  const int n = 1 << 18;
+  for (int i = 0; i < n; ++i) {
+    if (i % 2 == 0) {
+      deque.push_back(i);
+    } else {
+      deque.push_front(i);
+    }
+  }
+  while (deque.size() > 1) {
+    deque.pop_front();
+  }
+  std::cout << "\n分块双端队列（ChunkedDeque，每块" << deque.chunk_size()
+            << "个元素）：" << std::endl;
+  std::cout << "- " << 2 * n - 1 << " 次操作共搬移块指针 "
+            << deque.moved_chunk_pointers() << " 次，搬移元素 0 次"
+            << std::endl;
+  std::cout << "- 每次操作平均搬移块指针 " << std::setprecision(4)
+            << static_cast<double>(deque.moved_chunk_pointers()) / (2 * n - 1)
+            << " 次" << std::endl;
+  std::cout << std::endl;
+}
+
 void test_amortized_analysis_comparison() {
   std::cout << "=== 三种摊还分析方法比较 ===" << std::endl;
 
@@ -209,6 +309,7 @@ int main() {
   test_multipop_stack_accounting_method();
   test_dynamic_table_potential_method();
   test_table_expansion_contraction();
+  test_growable_containers_measured_cost();
   test_amortized_analysis_comparison();
 
   std::cout << "=== 所有测试完成 ===" << std::endl;
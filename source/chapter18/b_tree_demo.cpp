@@ -1,6 +1,11 @@
+#include "b_plus_tree.h"
 #include "b_tree.h"
+#include "paged_b_tree.h"
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <iostream>
+#include <map>
 #include <random>
 #include <vector>
 
@@ -313,6 +318,266 @@ void test_clrs_example() {
   std::cout << std::endl;
 }
 
+// 测试B+树：随机插入/删除与std::map对照，范围扫描与批量构建
+void test_b_plus_tree() {
+  std::cout << "=== 测试B+树 ===" << std::endl;
+
+  BPlusTree<long long, int> tree;
+  std::map<long long, int> reference;
+  std::mt19937 rng(18);
+  std::uniform_int_distribution<long long> key_dist(-50000, 50000);
+
+  bool consistent = true;
+  for (int i = 0; i < 200000; i++) {
+    long long key = key_dist(rng);
+    if (rng() % 3 == 0) {
+      bool erased = tree.erase(key);
+      consistent &= erased == (reference.erase(key) == 1);
+    } else {
+      bool inserted = tree.insert(key, i);
+      consistent &= inserted == (reference.find(key) == reference.end());
+      reference[key] = i;
+    }
+    if (i % 50000 == 0) {
+      consistent &= tree.validate();
+    }
+  }
+  for (const auto &entry : reference) {
+    const int *value = tree.find(entry.first);
+    consistent &= value != nullptr && *value == entry.second;
+  }
+  std::cout << "随机插入/删除20万次后与std::map一致: "
+            << (consistent && tree.size() == reference.size() ? "是" : "否")
+            << std::endl;
+  std::cout << "B+树性质验证: " << (tree.validate() ? "通过" : "失败")
+            << ", 高度: " << tree.get_height() << ", 元素数: " << tree.size()
+            << std::endl;
+
+  // 范围扫描通过叶子链表顺序访问
+  std::vector<long long> scanned;
+  tree.range_scan(-1000, 1000, [&](long long key, int) { scanned.push_back(key); });
+  std::vector<long long> expected;
+  for (auto it = reference.lower_bound(-1000);
+       it != reference.end() && it->first <= 1000; ++it) {
+    expected.push_back(it->first);
+  }
+  std::cout << "范围扫描[-1000, 1000]: " << scanned.size() << " 个键, 与std::map"
+            << (scanned == expected ? "一致" : "不一致") << std::endl;
+
+  // 全部删除后树应当收缩为一个空叶子
+  for (const auto &entry : reference) {
+    tree.erase(entry.first);
+  }
+  std::cout << "全部删除后: 大小 " << tree.size() << ", 高度 "
+            << tree.get_height() << ", 验证 "
+            << (tree.validate() ? "通过" : "失败") << std::endl;
+
+  // 批量构建
+  std::vector<std::pair<long long, int>> sorted;
+  for (int i = 0; i < 100000; i++) {
+    sorted.push_back({3LL * i, i});
+  }
+  tree.bulk_load(sorted, 0.75);
+  bool bulk_ok = tree.validate() && tree.size() == sorted.size();
+  for (int i = 0; i < 100000; i += 7) {
+    bulk_ok &= tree.find(3LL * i) != nullptr && tree.find(3LL * i + 1) == nullptr;
+  }
+  // 批量构建后继续插入与删除
+  for (int i = 0; i < 100000; i += 2) {
+    tree.insert(3LL * i + 1, -i);
+    tree.erase(3LL * i);
+  }
+  bulk_ok &= tree.validate() && tree.size() == sorted.size();
+  std::cout << "批量构建10万个键（填充率0.75）并继续修改: "
+            << (bulk_ok ? "通过" : "失败") << std::endl;
+
+  try {
+    std::vector<std::pair<long long, int>> unsorted = {{2, 0}, {1, 0}};
+    tree.bulk_load(unsorted);
+    std::cout << "未排序输入没有被拒绝" << std::endl;
+  } catch (const std::invalid_argument &e) {
+    std::cout << "未排序输入被拒绝: " << e.what() << std::endl;
+  }
+
+  std::cout << std::endl;
+}
+
+// B+树与原B树、std::map的点查询对比
+void test_b_plus_tree_performance() {
+  std::cout << "=== B+树点查询性能对比 ===" << std::endl;
+
+  const int n = 1000000;
+  std::mt19937_64 rng(42);
+  std::vector<long long> keys(n);
+  for (int i = 0; i < n; i++) {
+    keys[i] = static_cast<long long>(rng() >> 1);
+  }
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+  std::vector<std::pair<long long, long long>> sorted;
+  sorted.reserve(keys.size());
+  for (long long key : keys) {
+    sorted.push_back({key, key});
+  }
+
+  auto elapsed_ms = [](std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::high_resolution_clock::now() - start)
+        .count();
+  };
+
+  auto start = std::chrono::high_resolution_clock::now();
+  BPlusTree<long long, long long> bulk_tree;
+  bulk_tree.bulk_load(sorted);
+  double bulk_ms = elapsed_ms(start);
+
+  std::vector<long long> shuffled = keys;
+  std::shuffle(shuffled.begin(), shuffled.end(), rng);
+
+  start = std::chrono::high_resolution_clock::now();
+  BPlusTree<long long, long long> insert_tree;
+  for (long long key : shuffled) {
+    insert_tree.insert(key, key);
+  }
+  double bplus_insert_ms = elapsed_ms(start);
+
+  start = std::chrono::high_resolution_clock::now();
+  BTree<long long> btree(16);
+  for (long long key : shuffled) {
+    btree.insert(key);
+  }
+  double btree_insert_ms = elapsed_ms(start);
+
+  start = std::chrono::high_resolution_clock::now();
+  std::map<long long, long long> map;
+  for (long long key : shuffled) {
+    map[key] = key;
+  }
+  double map_insert_ms = elapsed_ms(start);
+
+  std::cout << "键数: " << keys.size() << std::endl;
+  std::cout << "构建: B+树批量 " << bulk_ms << " ms, B+树随机插入 "
+            << bplus_insert_ms << " ms, B树(t=16) " << btree_insert_ms
+            << " ms, std::map " << map_insert_ms << " ms" << std::endl;
+
+  // 随机查询，一半命中一半不命中
+  std::vector<long long> queries(keys.size());
+  for (size_t i = 0; i < queries.size(); i++) {
+    queries[i] = i % 2 == 0 ? shuffled[i] : static_cast<long long>(rng() >> 1);
+  }
+
+  size_t found = 0;
+  start = std::chrono::high_resolution_clock::now();
+  for (long long key : queries) {
+    found += bulk_tree.find(key) != nullptr;
+  }
+  double bplus_ms = elapsed_ms(start);
+
+  size_t btree_found = 0;
+  start = std::chrono::high_resolution_clock::now();
+  for (long long key : queries) {
+    btree_found += btree.search(key) != nullptr;
+  }
+  double btree_ms = elapsed_ms(start);
+
+  size_t map_found = 0;
+  start = std::chrono::high_resolution_clock::now();
+  for (long long key : queries) {
+    map_found += map.count(key);
+  }
+  double map_ms = elapsed_ms(start);
+
+  double per_query = 1e6 / queries.size();
+  std::cout << "点查询(ns/次): B+树 " << bplus_ms * per_query << ", B树 "
+            << btree_ms * per_query << ", std::map " << map_ms * per_query
+            << std::endl;
+  std::cout << "命中数一致: "
+            << (found == btree_found && found == map_found ? "是" : "否")
+            << ", B+树高度 " << bulk_tree.get_height() << ", 占用 "
+            << bulk_tree.memory_bytes() / (1024 * 1024) << " MB" << std::endl;
+
+  std::cout << std::endl;
+}
+
+// 测试基于页文件的B树：小页面使分裂/合并频繁发生，并验证重新打开与mmap只读模式
+void test_paged_b_tree() {
+  std::cout << "=== 测试基于页文件的B树 ===" << std::endl;
+
+  const std::string path = "paged_b_tree_demo.db";
+  std::map<int, long long> reference;
+  {
+    // 256字节的页：t = 8，缓冲池只有16页，迫使频繁换页
+    PagedBTree<int, long long> tree(path, PagedBTree<int, long long>::OpenMode::Create,
+                                    16, 256);
+    std::cout << "页大小 " << tree.page_size() << " 字节, 最小度数 t = "
+              << tree.degree() << std::endl;
+
+    std::mt19937 rng(19);
+    bool consistent = true;
+    for (int i = 0; i < 30000; i++) {
+      int key = static_cast<int>(rng() % 5000);
+      if (rng() % 3 == 0) {
+        consistent &= tree.remove(key) == (reference.erase(key) == 1);
+      } else {
+        consistent &= tree.insert(key, i) == (reference.count(key) == 0);
+        reference[key] = i;
+      }
+    }
+    for (const auto &entry : reference) {
+      auto value = tree.search(entry.first);
+      consistent &= value.has_value() && *value == entry.second;
+    }
+    std::cout << "随机插入/删除3万次后与std::map一致: "
+              << (consistent && tree.size() == reference.size() ? "是" : "否")
+              << std::endl;
+    std::cout << "B树性质验证: " << (tree.validate() ? "通过" : "失败")
+              << ", 高度: " << tree.height() << ", 文件页数: "
+              << tree.page_count() << std::endl;
+
+    const IoStats &io = tree.io_stats();
+    std::cout << "累计页访问 " << io.page_accesses << ", 命中 "
+              << io.cache_hits << ", 读盘 " << io.page_reads << ", 写盘 "
+              << io.page_writes << std::endl;
+  }
+
+  {
+    // 重新打开：内容应当完整保存在文件中
+    PagedBTree<int, long long> tree(
+        path, PagedBTree<int, long long>::OpenMode::ReadWrite, 16);
+    std::vector<int> keys;
+    tree.traverse([&](int key, long long) { keys.push_back(key); });
+    bool same = keys.size() == reference.size() &&
+                std::equal(keys.begin(), keys.end(), reference.begin(),
+                           [](int key, const std::pair<const int, long long> &entry) {
+                             return key == entry.first;
+                           });
+    std::cout << "重新打开后遍历与std::map一致: " << (same ? "是" : "否")
+              << std::endl;
+  }
+
+  {
+    PagedBTree<int, long long> tree(
+        path, PagedBTree<int, long long>::OpenMode::ReadOnlyMmap);
+    bool found_all = true;
+    for (const auto &entry : reference) {
+      auto value = tree.search(entry.first);
+      found_all &= value.has_value() && *value == entry.second;
+    }
+    std::cout << "mmap只读模式查找全部键: " << (found_all ? "成功" : "失败")
+              << std::endl;
+    try {
+      tree.insert(1, 1);
+      std::cout << "只读模式允许了写入" << std::endl;
+    } catch (const std::logic_error &e) {
+      std::cout << "只读模式拒绝写入: " << e.what() << std::endl;
+    }
+  }
+  std::remove(path.c_str());
+
+  std::cout << std::endl;
+}
+
 int main() {
   std::cout << "算法导论第18章 B树演示程序" << std::endl;
   std::cout << "============================" << std::endl;
@@ -324,6 +589,9 @@ int main() {
   test_different_degrees();
   test_performance();
   test_clrs_example();
+  test_b_plus_tree();
+  test_b_plus_tree_performance();
+  test_paged_b_tree();
 
   std::cout << "所有测试完成!" << std::endl;
 
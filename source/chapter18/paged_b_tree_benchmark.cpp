@@ -0,0 +1,144 @@
+#include "paged_b_tree.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <sys/resource.h>
+#include <vector>
+
+using namespace algorithms;
+
+using Tree = PagedBTree<long long, long long>;
+
+static long major_faults() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_majflt;
+}
+
+// 打印一个阶段的每次操作I/O统计
+static void report(const char *phase, const IoStats &io, size_t ops,
+                   double seconds) {
+  double n = static_cast<double>(ops);
+  double hit_rate =
+      io.page_accesses ? 100.0 * io.cache_hits / io.page_accesses : 0.0;
+  std::cout << std::left << std::setw(16) << phase << std::right << std::fixed
+            << std::setprecision(3) << std::setw(12) << io.page_accesses / n
+            << std::setw(12) << io.page_reads / n << std::setw(12)
+            << io.page_writes / n << std::setw(10) << std::setprecision(1)
+            << hit_rate << "%" << std::setw(12) << std::setprecision(2)
+            << seconds * 1e6 / n << std::endl;
+}
+
+template <typename F> static double timed(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() -
+                                       start)
+      .count();
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: paged_b_tree_benchmark [键数] [缓冲池页数] [文件路径] [页大小]
+  // 例如模拟数据远大于内存: paged_b_tree_benchmark 50000000 65536 /data/index.db 4096
+  size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  size_t pool_pages = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 256;
+  std::string path = argc > 3 ? argv[3] : "paged_b_tree_benchmark.db";
+  size_t page_size = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 4096;
+
+  std::mt19937_64 rng(2024);
+  std::vector<long long> keys(n);
+  for (size_t i = 0; i < n; i++) {
+    keys[i] = static_cast<long long>(rng() >> 1);
+  }
+  size_t queries = std::min<size_t>(n, 200000);
+
+  std::cout << "基于页文件的B树I/O测试" << std::endl;
+  std::cout << "键数: " << n << ", 页大小: " << page_size
+            << ", 缓冲池: " << pool_pages << " 页 ("
+            << pool_pages * page_size / 1024 << " KB)" << std::endl;
+  std::cout << "\n" << std::left << std::setw(16) << "阶段" << std::right
+            << std::setw(12) << "访问页/次" << std::setw(12) << "读盘/次"
+            << std::setw(12) << "写盘/次" << std::setw(11) << "命中率"
+            << std::setw(12) << "us/次" << std::endl;
+
+  {
+    Tree tree(path, Tree::OpenMode::Create, pool_pages, page_size);
+    double seconds = timed([&] {
+      for (size_t i = 0; i < n; i++) {
+        tree.insert(keys[i], static_cast<long long>(i));
+      }
+      tree.flush();
+    });
+    report("随机插入", tree.io_stats(), n, seconds);
+
+    tree.reset_io_stats();
+    seconds = timed([&] {
+      for (size_t i = 0; i < queries; i++) {
+        tree.search(keys[rng() % n]);
+      }
+    });
+    report("命中查找", tree.io_stats(), queries, seconds);
+
+    tree.reset_io_stats();
+    seconds = timed([&] {
+      for (size_t i = 0; i < queries; i++) {
+        tree.search(static_cast<long long>(rng() >> 1));
+      }
+    });
+    report("未命中查找", tree.io_stats(), queries, seconds);
+
+    tree.reset_io_stats();
+    size_t removes = queries / 2;
+    seconds = timed([&] {
+      for (size_t i = 0; i < removes; i++) {
+        tree.remove(keys[i]);
+      }
+      tree.flush();
+    });
+    report("删除", tree.io_stats(), removes, seconds);
+
+    std::cout << "\n高度: " << tree.height() << ", 最小度数: " << tree.degree()
+              << ", 文件大小: " << tree.page_count() * page_size / (1024 * 1024)
+              << " MB" << std::endl;
+  }
+
+  // 不同缓冲池容量下的查找：容量越大，上层节点常驻内存，读盘次数越少
+  std::cout << "\n缓冲池容量对命中查找的影响" << std::endl;
+  for (size_t capacity : {16, 64, 256, 1024, 4096}) {
+    Tree tree(path, Tree::OpenMode::ReadWrite, capacity);
+    for (size_t i = 0; i < queries / 4; i++) {
+      tree.search(keys[rng() % n]); // 预热
+    }
+    tree.reset_io_stats();
+    double seconds = timed([&] {
+      for (size_t i = 0; i < queries; i++) {
+        tree.search(keys[queries / 2 + rng() % (n - queries / 2)]);
+      }
+    });
+    std::string label = std::to_string(capacity) + " 页";
+    report(label.c_str(), tree.io_stats(), queries, seconds);
+  }
+
+  {
+    // mmap只读模式：由操作系统页缓存负责换页，用主缺页次数近似读盘次数
+    Tree tree(path, Tree::OpenMode::ReadOnlyMmap);
+    long faults_before = major_faults();
+    double seconds = timed([&] {
+      for (size_t i = 0; i < queries; i++) {
+        tree.search(keys[queries / 2 + rng() % (n - queries / 2)]);
+      }
+    });
+    IoStats io = tree.io_stats();
+    io.page_reads = static_cast<uint64_t>(major_faults() - faults_before);
+    std::cout << "\nmmap只读模式（读盘列为主缺页次数）" << std::endl;
+    report("命中查找", io, queries, seconds);
+  }
+
+  std::remove(path.c_str());
+  return 0;
+}
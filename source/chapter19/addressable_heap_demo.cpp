@@ -0,0 +1,187 @@
+#include "addressable_heap.h"
+#include "graph_representation.h"
+#include "minimum_spanning_tree.h"
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace algorithms;
+
+using BinaryHeap = DaryHeap<int, std::less<int>, 2>;
+using FourAryHeap = DaryHeap<int, std::less<int>, 4>;
+
+/**
+ * @brief 演示统一接口：push、top、decrease_key、meld、pop
+ */
+template <typename Heap> void demo_interface(const std::string &name) {
+  std::cout << name << ": ";
+
+  Heap heap;
+  auto h5 = heap.push(5);
+  heap.push(3);
+  auto h8 = heap.push(8);
+  heap.push(1);
+  heap.decrease_key(h8, 0);
+  heap.decrease_key(h5, 2);
+
+  Heap other;
+  other.push(4);
+  auto h7 = other.push(7);
+  std::size_t offset = heap.meld(other);
+  heap.decrease_key(static_cast<typename Heap::handle_type>(h7 + offset), -1);
+
+  try {
+    heap.decrease_key(h5, 100);
+  } catch (const std::invalid_argument &) {
+    std::cout << "(增大关键字被拒绝) ";
+  }
+
+  std::cout << "依次弹出 ";
+  while (!heap.empty()) {
+    std::cout << heap.pop() << " ";
+  }
+  std::cout << "(应该是 -1 0 1 2 3 4)" << std::endl;
+}
+
+/**
+ * @brief 随机操作序列与 std::map 对拍
+ *
+ * 关键字低20位为插入序号，保证互不相同，因此 map 可以记录每个存活元素的句柄
+ */
+template <typename Heap> bool check_against_map(unsigned seed) {
+  std::mt19937 rng(seed);
+  Heap heap;
+  std::map<long long, typename Heap::handle_type> reference;
+
+  for (long long id = 0; id < 50000; id++) {
+    int op = rng() % 10;
+    if (op < 4 || reference.empty()) {
+      long long key = (static_cast<long long>(rng() % 100000) << 20) | id;
+      reference[key] = heap.push(key);
+    } else if (op < 7) {
+      // 随机挑一个存活元素减小关键字，低20位不变
+      auto it = reference.lower_bound(static_cast<long long>(rng() % 100000)
+                                      << 20);
+      if (it == reference.end()) {
+        it = reference.begin();
+      }
+      long long new_key =
+          it->first - (static_cast<long long>(rng() % 1000) << 20);
+      auto h = it->second;
+      if (heap.key(h) != it->first) {
+        return false;
+      }
+      heap.decrease_key(h, new_key);
+      reference.erase(it);
+      reference[new_key] = h;
+    } else {
+      if (heap.top() != reference.begin()->first ||
+          heap.pop() != reference.begin()->first) {
+        return false;
+      }
+      reference.erase(reference.begin());
+    }
+    if (heap.size() != reference.size()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+AdjacencyListGraph generate_random_graph(int node_count, long long edge_count,
+                                         int max_weight) {
+  AdjacencyListGraph graph(false);
+  graph.reserve(node_count);
+  for (int i = 0; i < node_count; i++) {
+    graph.add_node(i);
+  }
+
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> node_dis(0, node_count - 1);
+  std::uniform_int_distribution<int> weight_dis(1, max_weight);
+
+  std::vector<GraphEdge> edges;
+  edges.reserve(edge_count);
+  for (int i = 0; i + 1 < node_count; i++) {
+    edges.emplace_back(i, i + 1, weight_dis(gen));
+  }
+  while (static_cast<long long>(edges.size()) < edge_count) {
+    int u = node_dis(gen), v = node_dis(gen);
+    if (u != v) {
+      edges.emplace_back(u, v, weight_dis(gen));
+    }
+  }
+  graph.add_edges(edges);
+  return graph;
+}
+
+template <typename Heap>
+void benchmark_prim(const std::string &name, MinimumSpanningTree<> &mst,
+                    int expected_weight) {
+  auto start = std::chrono::high_resolution_clock::now();
+  auto edges = mst.template prim_with_heap<Heap>(0);
+  double ms = std::chrono::duration<double, std::milli>(
+                  std::chrono::high_resolution_clock::now() - start)
+                  .count();
+  int weight = mst.calculate_total_weight(edges);
+  std::cout << name << ": " << ms << " ms, 总权重 " << weight
+            << (weight == expected_weight ? " (一致)" : " (不一致)")
+            << std::endl;
+}
+
+int main() {
+  std::cout << "第19章 可寻址堆演示程序" << std::endl;
+  std::cout << "======================" << std::endl;
+
+  std::cout << "\n=== 统一接口演示 ===" << std::endl;
+  demo_interface<BinaryHeap>("二叉堆");
+  demo_interface<FourAryHeap>("4叉堆");
+  demo_interface<PairingHeap<int>>("配对堆");
+  demo_interface<FibonacciAddressableHeap<int>>("斐波那契堆");
+
+  std::cout << "\n=== 与std::map随机对拍 ===" << std::endl;
+  using Key = long long;
+  std::cout << "二叉堆: "
+            << (check_against_map<DaryHeap<Key, std::less<Key>, 2>>(1)
+                    ? "通过"
+                    : "失败")
+            << std::endl;
+  std::cout << "4叉堆: "
+            << (check_against_map<DaryHeap<Key, std::less<Key>, 4>>(2)
+                    ? "通过"
+                    : "失败")
+            << std::endl;
+  std::cout << "配对堆: "
+            << (check_against_map<PairingHeap<Key>>(3) ? "通过" : "失败")
+            << std::endl;
+  std::cout << "斐波那契堆: "
+            << (check_against_map<FibonacciAddressableHeap<Key>>(4) ? "通过"
+                                                                     : "失败")
+            << std::endl;
+
+  std::cout << "\n=== Prim算法替换不同的堆 ===" << std::endl;
+  auto graph = generate_random_graph(100000, 1000000, 1000);
+  MinimumSpanningTree<> mst(graph);
+
+  auto start = std::chrono::high_resolution_clock::now();
+  auto lazy_edges = mst.prim(0);
+  double lazy_ms = std::chrono::duration<double, std::milli>(
+                       std::chrono::high_resolution_clock::now() - start)
+                       .count();
+  int expected = mst.calculate_total_weight(lazy_edges);
+  std::cout << "std::priority_queue（重复插入）: " << lazy_ms << " ms, 总权重 "
+            << expected << std::endl;
+
+  using Entry = std::pair<int, int>;
+  benchmark_prim<DaryHeap<Entry, std::less<>, 2>>("二叉堆", mst, expected);
+  benchmark_prim<DaryHeap<Entry, std::less<>, 4>>("4叉堆", mst, expected);
+  benchmark_prim<PairingHeap<Entry>>("配对堆", mst, expected);
+  benchmark_prim<FibonacciAddressableHeap<Entry>>("斐波那契堆", mst,
+                                                 expected);
+
+  return 0;
+}
@@ -0,0 +1,128 @@
+#include "fibonacci_heap.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <vector>
+
+using namespace algorithms;
+
+struct Result {
+  double ms;
+  std::uint64_t checksum;
+};
+
+/**
+ * @brief 事件模拟器的一个 tick：插入 batch 个未来时间戳，再取出最早的 batch 个
+ *
+ * 堆中始终保留 backlog 个待处理事件，新事件的时间戳落在当前时刻之后。
+ */
+template <typename Step>
+Result run(int backlog, int batch, long long total_events, Step step) {
+  std::mt19937_64 rng(11);
+  std::vector<long long> keys(batch);
+  std::uint64_t checksum = 0;
+  long long now = 0;
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (long long done = 0; done < total_events; done += batch) {
+    for (long long &key : keys) {
+      key = now + static_cast<long long>(rng() % (4ULL * backlog + 1));
+    }
+    now = step(keys, checksum);
+  }
+  double ms = std::chrono::duration<double, std::milli>(
+                  std::chrono::high_resolution_clock::now() - start)
+                  .count();
+  return {ms, checksum};
+}
+
+Result run_single(int backlog, int batch, long long total_events) {
+  FibonacciHeap<long long> heap;
+  for (int i = 0; i < backlog; i++) {
+    heap.insert(i);
+  }
+  return run(backlog, batch, total_events,
+             [&](const std::vector<long long> &keys, std::uint64_t &checksum) {
+               for (long long key : keys) {
+                 heap.insert(key);
+               }
+               long long last = 0;
+               for (std::size_t i = 0; i < keys.size(); i++) {
+                 last = heap.extract_min();
+                 checksum += static_cast<std::uint64_t>(last);
+               }
+               return last;
+             });
+}
+
+Result run_batch(int backlog, int batch, long long total_events) {
+  FibonacciHeap<long long> heap;
+  std::vector<long long> initial(backlog);
+  for (int i = 0; i < backlog; i++) {
+    initial[i] = i;
+  }
+  heap.insert_batch(initial);
+  return run(backlog, batch, total_events,
+             [&](const std::vector<long long> &keys, std::uint64_t &checksum) {
+               heap.insert_batch(keys);
+               long long last = 0;
+               for (long long key : heap.extract_k_min(keys.size())) {
+                 checksum += static_cast<std::uint64_t>(key);
+                 last = key;
+               }
+               return last;
+             });
+}
+
+Result run_std(int backlog, int batch, long long total_events) {
+  std::priority_queue<long long, std::vector<long long>,
+                      std::greater<long long>>
+      heap;
+  for (int i = 0; i < backlog; i++) {
+    heap.push(i);
+  }
+  return run(backlog, batch, total_events,
+             [&](const std::vector<long long> &keys, std::uint64_t &checksum) {
+               for (long long key : keys) {
+                 heap.push(key);
+               }
+               long long last = 0;
+               for (std::size_t i = 0; i < keys.size(); i++) {
+                 last = heap.top();
+                 heap.pop();
+                 checksum += static_cast<std::uint64_t>(last);
+               }
+               return last;
+             });
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: fibonacci_heap_benchmark [待处理事件数] [总事件数]
+  int backlog = argc > 1 ? std::atoi(argv[1]) : 100000;
+  long long total_events = argc > 2 ? std::atoll(argv[2]) : 1000000;
+
+  std::cout << "斐波那契堆批量操作性能比较" << std::endl;
+  std::cout << "待处理事件数: " << backlog << ", 总事件数: " << total_events
+            << std::endl;
+
+  bool consistent = true;
+  for (int batch = 1; batch <= 10000; batch *= 10) {
+    Result single = run_single(backlog, batch, total_events);
+    Result batched = run_batch(backlog, batch, total_events);
+    Result baseline = run_std(backlog, batch, total_events);
+    consistent = consistent && single.checksum == batched.checksum &&
+                 single.checksum == baseline.checksum;
+
+    std::cout << "批大小 " << batch << ": 逐个 insert/extract_min "
+              << single.ms << " ms, insert_batch/extract_k_min " << batched.ms
+              << " ms, std::priority_queue " << baseline.ms << " ms"
+              << std::endl;
+  }
+  std::cout << "结果一致: " << (consistent ? "是" : "否") << std::endl;
+
+  return consistent ? 0 : 1;
+}
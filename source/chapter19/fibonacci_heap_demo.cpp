@@ -287,6 +287,56 @@ void demonstrate_graph_application() {
   std::cout << "Dijkstra算法完成，所有顶点距离已处理" << std::endl;
 }
 
+/**
+ * @brief 测试批量插入与批量提取
+ */
+void test_batch_operations() {
+  std::cout << "\n=== 测试批量操作 ===" << std::endl;
+
+  FibonacciHeap<int> heap;
+  heap.insert_batch({42, 7, 19, 3, 25});
+  auto handles = heap.insert_batch({11, 30, 5});
+  heap.decrease_key(handles[1], 1); // 30 -> 1
+  std::cout << "两批插入后大小: " << heap.size()
+            << ", 最小值: " << heap.get_min() << std::endl;
+
+  std::cout << "extract_k_min(4): ";
+  for (int key : heap.extract_k_min(4)) {
+    std::cout << key << " ";
+  }
+  std::cout << "(应该是 1 3 5 7)" << std::endl;
+
+  heap.insert(2);
+  std::cout << "再插入2后 extract_k_min(10): ";
+  for (int key : heap.extract_k_min(10)) {
+    std::cout << key << " ";
+  }
+  std::cout << "(应该是 2 11 19 25 42)" << std::endl;
+  std::cout << "堆是否为空: " << (heap.is_empty() ? "是" : "否") << std::endl;
+
+  // 与逐个提取对拍
+  std::mt19937 gen(5);
+  FibonacciHeap<int> single, batched;
+  bool consistent = true;
+  for (int tick = 0; tick < 200 && consistent; tick++) {
+    std::vector<int> keys(gen() % 300);
+    for (int &key : keys) {
+      key = gen() % 10000;
+    }
+    for (int key : keys) {
+      single.insert(key);
+    }
+    batched.insert_batch(keys);
+    std::size_t k = gen() % 300;
+    for (int key : batched.extract_k_min(k)) {
+      consistent = consistent && key == single.extract_min();
+    }
+    consistent = consistent && single.size() == batched.size();
+  }
+  std::cout << "与逐个 extract_min 对拍: " << (consistent ? "通过" : "失败")
+            << std::endl;
+}
+
 int main() {
   std::cout << "斐波那契堆演示程序" << std::endl;
   std::cout << "==================" << std::endl;
@@ -298,6 +348,7 @@ int main() {
     test_delete_operation();
     test_performance_characteristics();
     test_edge_cases();
+    test_batch_operations();
     demonstrate_graph_application();
 
     std::cout << "\n所有测试完成!" << std::endl;
@@ -0,0 +1,137 @@
+#include "red_black_tree.h"
+#include "van_emde_boas_tree.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace algorithms;
+
+/**
+ * @brief 定时器集合的三种实现，统一为 insert / erase / next_after 接口
+ */
+struct VebTimers {
+  VanEmdeBoasTree32 tree{32};
+
+  bool insert(std::uint32_t id) { return tree.insert(id); }
+  void erase(std::uint32_t id) { tree.remove(id); }
+  // 大于 now 的第一个定时器，不存在时回绕到最小的定时器
+  std::uint32_t next_after(std::uint32_t now) const {
+    auto next = tree.successor(now);
+    return next ? *next : *tree.minimum();
+  }
+};
+
+struct RedBlackTimers {
+  RedBlackTree<std::uint32_t> tree;
+
+  bool insert(std::uint32_t id) {
+    if (tree.search(id) != nullptr) {
+      return false;
+    }
+    tree.insert(id);
+    return true;
+  }
+  void erase(std::uint32_t id) { tree.remove(id); }
+  std::uint32_t next_after(std::uint32_t now) const {
+    auto it = tree.upper_bound(now);
+    return it != tree.end() ? *it : *tree.begin();
+  }
+};
+
+struct StdSetTimers {
+  std::set<std::uint32_t> tree;
+
+  bool insert(std::uint32_t id) { return tree.insert(id).second; }
+  void erase(std::uint32_t id) { tree.erase(id); }
+  std::uint32_t next_after(std::uint32_t now) const {
+    auto it = tree.upper_bound(now);
+    return it != tree.end() ? *it : *tree.begin();
+  }
+};
+
+struct Result {
+  double build_ms;
+  double query_ms;
+  double churn_ms;
+  std::uint64_t checksum;
+};
+
+/**
+ * @brief 以稀疏的32位定时器编号运行后继密集的工作负载
+ *
+ * 1. 插入 live 个随机编号；
+ * 2. 纯查询：ops 次随机时刻的 next_after；
+ * 3. 时间轮式更替：每步取 now 之后的第一个定时器，删除它，
+ *    再插入一个新的随机编号，集合大小保持不变。
+ */
+template <typename Timers>
+Result run(int live, int ops, std::uint32_t seed) {
+  auto elapsed_ms = [](std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::high_resolution_clock::now() - start)
+        .count();
+  };
+
+  std::mt19937 rng(seed);
+  Timers timers;
+  Result result{0, 0, 0, 0};
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int inserted = 0; inserted < live;) {
+    inserted += timers.insert(static_cast<std::uint32_t>(rng()));
+  }
+  result.build_ms = elapsed_ms(start);
+
+  start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < ops; i++) {
+    result.checksum += timers.next_after(static_cast<std::uint32_t>(rng()));
+  }
+  result.query_ms = elapsed_ms(start);
+
+  std::uint32_t now = 0;
+  start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < ops; i++) {
+    now = timers.next_after(now);
+    result.checksum += now;
+    timers.erase(now);
+    while (!timers.insert(static_cast<std::uint32_t>(rng()))) {
+    }
+  }
+  result.churn_ms = elapsed_ms(start);
+
+  return result;
+}
+
+void report(const std::string &name, const Result &r) {
+  std::cout << name << ": 建立 " << r.build_ms << " ms, 后继查询 "
+            << r.query_ms << " ms, 时间轮更替 " << r.churn_ms << " ms"
+            << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: van_emde_boas_benchmark [定时器数] [操作数]
+  int live = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  int ops = argc > 2 ? std::atoi(argv[2]) : 1000000;
+
+  std::cout << "van Emde Boas树后继查询性能比较（32位全域）" << std::endl;
+  std::cout << "定时器数: " << live << ", 操作数: " << ops << std::endl;
+
+  Result veb = run<VebTimers>(live, ops, 42);
+  Result rbt = run<RedBlackTimers>(live, ops, 42);
+  Result set = run<StdSetTimers>(live, ops, 42);
+
+  report("vEB树", veb);
+  report("红黑树", rbt);
+  report("std::set", set);
+
+  bool consistent =
+      veb.checksum == rbt.checksum && veb.checksum == set.checksum;
+  std::cout << "结果一致: " << (consistent ? "是" : "否") << std::endl;
+
+  return 0;
+}
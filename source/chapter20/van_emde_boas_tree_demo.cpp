@@ -1,6 +1,10 @@
 #include "van_emde_boas_tree.h"
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <random>
+#include <set>
 #include <vector>
 
 using namespace algorithms;
@@ -366,6 +370,86 @@ void test_algorithm_applications() {
             << std::endl;
 }
 
+/**
+ * @brief 测试簇惰性分配与32/64位全域
+ */
+void test_lazy_allocation_and_wide_universes() {
+  std::cout << "\n=== 测试簇惰性分配与32/64位全域 ===" << std::endl;
+
+  auto elapsed_ms = [](std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::high_resolution_clock::now() - start)
+        .count();
+  };
+
+  // 全域 2^24：构造只建立根结构
+  auto start = std::chrono::high_resolution_clock::now();
+  VanEmdeBoasTree big(1 << 24);
+  double construct_ms = elapsed_ms(start);
+  std::cout << "全域2^24构造耗时: " << construct_ms
+            << " ms, 已分配子结构: " << big.node_count() << std::endl;
+  big.insert(12345678);
+  big.insert(42);
+  std::cout << "插入2个元素后子结构: " << big.node_count()
+            << ", 42的后继: " << big.successor(42) << std::endl;
+
+  // 稀疏的32位定时器编号
+  const int n = 1000000;
+  std::mt19937 rng(2024);
+  std::vector<std::uint32_t> ids(n);
+  for (std::uint32_t &id : ids) {
+    id = static_cast<std::uint32_t>(rng());
+  }
+
+  start = std::chrono::high_resolution_clock::now();
+  VanEmdeBoasTree32 timers(32);
+  for (std::uint32_t id : ids) {
+    timers.insert(id);
+  }
+  double veb_insert_ms = elapsed_ms(start);
+
+  start = std::chrono::high_resolution_clock::now();
+  std::set<std::uint32_t> reference(ids.begin(), ids.end());
+  double set_insert_ms = elapsed_ms(start);
+
+  std::vector<std::uint32_t> queries(n);
+  for (std::uint32_t &q : queries) {
+    q = static_cast<std::uint32_t>(rng());
+  }
+
+  std::uint64_t veb_sum = 0, set_sum = 0;
+  start = std::chrono::high_resolution_clock::now();
+  for (std::uint32_t q : queries) {
+    auto next = timers.successor(q);
+    veb_sum += next ? *next : 0;
+  }
+  double veb_succ_ms = elapsed_ms(start);
+
+  start = std::chrono::high_resolution_clock::now();
+  for (std::uint32_t q : queries) {
+    auto it = reference.upper_bound(q);
+    set_sum += (it != reference.end()) ? *it : 0;
+  }
+  double set_succ_ms = elapsed_ms(start);
+
+  std::cout << "32位全域，" << timers.size() << " 个定时器编号，子结构 "
+            << timers.node_count() << " 个" << std::endl;
+  std::cout << "插入: vEB " << veb_insert_ms << " ms, std::set "
+            << set_insert_ms << " ms" << std::endl;
+  std::cout << "后继: vEB " << veb_succ_ms << " ms, std::set " << set_succ_ms
+            << " ms, 结果一致: " << (veb_sum == set_sum ? "是" : "否")
+            << std::endl;
+
+  // 64位全域
+  VanEmdeBoasTree64 wide(64);
+  wide.insert(0);
+  wide.insert(1ULL << 40);
+  wide.insert(~0ULL);
+  std::cout << "64位全域: 1的后继 = " << *wide.successor(1)
+            << ", 2^64-1的前驱 = " << *wide.predecessor(~0ULL)
+            << ", 最大值 = " << *wide.maximum() << std::endl;
+}
+
 /**
  * @brief 主函数
  */
@@ -386,6 +470,7 @@ int main() {
   test_edge_cases();
   test_performance_characteristics();
   test_algorithm_applications();
+  test_lazy_allocation_and_wide_universes();
 
   std::cout << "\n========== 所有测试完成 ==========" << std::endl;
 
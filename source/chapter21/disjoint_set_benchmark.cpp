@@ -0,0 +1,135 @@
+#include "disjoint_set.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace algorithms;
+
+/**
+ * @brief 对照组：父节点与秩分开存放、递归完全路径压缩的教科书写法
+ */
+class TextbookDisjointSet {
+private:
+  std::vector<int> parent;
+  std::vector<int> rank;
+
+public:
+  explicit TextbookDisjointSet(int n) : parent(n), rank(n, 0) {
+    for (int i = 0; i < n; i++) {
+      parent[i] = i;
+    }
+  }
+
+  int find(int x) {
+    if (parent[x] != x) {
+      parent[x] = find(parent[x]);
+    }
+    return parent[x];
+  }
+
+  void union_sets(int x, int y) {
+    x = find(x);
+    y = find(y);
+    if (x == y) {
+      return;
+    }
+    if (rank[x] < rank[y]) {
+      std::swap(x, y);
+    }
+    parent[y] = x;
+    if (rank[x] == rank[y]) {
+      rank[x]++;
+    }
+  }
+};
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: disjoint_set_benchmark [元素数] [合并次数]
+  int n = argc > 1 ? std::atoi(argv[1]) : 4000000;
+  int operations = argc > 2 ? std::atoi(argv[2]) : 8000000;
+
+  std::cout << "并查集性能比较: " << n << " 个元素, " << operations
+            << " 次随机合并与查询" << std::endl;
+  std::mt19937 gen(46);
+  std::uniform_int_distribution<int> dis(0, n - 1);
+  std::vector<std::pair<int, int>> pairs(operations);
+  for (auto &p : pairs) {
+    p = {dis(gen), dis(gen)};
+  }
+
+  // 前一半合并，后一半查询
+  long long textbook_hits = 0, packed_hits = 0;
+  double textbook_ms = time_ms([&] {
+    TextbookDisjointSet ds(n);
+    for (int k = 0; k < operations; k++) {
+      if (k < operations / 2) {
+        ds.union_sets(pairs[k].first, pairs[k].second);
+      } else {
+        textbook_hits += ds.find(pairs[k].first) == ds.find(pairs[k].second);
+      }
+    }
+  });
+  double packed_ms = time_ms([&] {
+    DisjointSet ds(n);
+    for (int k = 0; k < operations; k++) {
+      if (k < operations / 2) {
+        ds.union_sets(pairs[k].first, pairs[k].second);
+      } else {
+        packed_hits += ds.is_same_set(pairs[k].first, pairs[k].second);
+      }
+    }
+  });
+  bool consistent = textbook_hits == packed_hits;
+  std::cout << "分开存放 + 递归压缩: " << textbook_ms
+            << " ms；打包存放 + 路径减半: " << packed_ms << " ms" << std::endl;
+
+  unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+  for (unsigned int threads : {1u, cores}) {
+    ConcurrentDisjointSet ds(n);
+    std::vector<long long> hits(threads, 0);
+    double ms = time_ms([&] {
+      // 合并阶段与查询阶段之间等待所有线程，保证查询结果确定
+      for (int phase = 0; phase < 2; phase++) {
+        std::vector<std::thread> workers;
+        for (unsigned int t = 0; t < threads; t++) {
+          workers.emplace_back([&, t, phase] {
+            int begin = phase == 0 ? 0 : operations / 2;
+            int end = phase == 0 ? operations / 2 : operations;
+            for (int k = begin + t; k < end; k += threads) {
+              if (phase == 0) {
+                ds.unite(pairs[k].first, pairs[k].second);
+              } else {
+                hits[t] += ds.same_set(pairs[k].first, pairs[k].second);
+              }
+            }
+          });
+        }
+        for (auto &worker : workers) {
+          worker.join();
+        }
+      }
+    });
+    long long total = 0;
+    for (long long h : hits) {
+      total += h;
+    }
+    consistent = consistent && total == packed_hits;
+    std::cout << "无锁并发并查集（" << threads << " 线程）: " << ms << " ms"
+              << std::endl;
+  }
+  std::cout << "结果一致: " << (consistent ? "是" : "否") << std::endl;
+
+  return consistent ? 0 : 1;
+}
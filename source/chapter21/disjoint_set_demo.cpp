@@ -1,5 +1,8 @@
 #include "disjoint_set.h"
 #include <iostream>
+#include <random>
+#include <thread>
+#include <utility>
 #include <vector>
 
 using namespace algorithms;
@@ -304,6 +307,67 @@ void test_connectivity_application() {
             << std::endl;
 }
 
+/**
+ * @brief 测试无锁并发并查集：多线程合并后与串行并查集的划分一致
+ */
+void test_concurrent_disjoint_set() {
+  std::cout << "\n=== 测试无锁并发并查集 ===" << std::endl;
+
+  const int n = 200000;
+  const int edge_count = 150000;
+  std::mt19937 gen(21);
+  std::uniform_int_distribution<int> dis(0, n - 1);
+  std::vector<std::pair<int, int>> edges(edge_count);
+  for (auto &edge : edges) {
+    edge = {dis(gen), dis(gen)};
+  }
+
+  DisjointSet serial(n);
+  for (const auto &edge : edges) {
+    serial.union_sets(edge.first, edge.second);
+  }
+
+  ConcurrentDisjointSet concurrent(n);
+  const int thread_count = 4;
+  std::vector<int> merged(thread_count, 0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < thread_count; t++) {
+    threads.emplace_back([&, t] {
+      for (int k = t; k < edge_count; k += thread_count) {
+        merged[t] += concurrent.unite(edges[k].first, edges[k].second);
+        // 与合并交错的查询
+        concurrent.same_set(edges[k].first, edges[(k * 7) % edge_count].second);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  int total_merged = 0;
+  for (int m : merged) {
+    total_merged += m;
+  }
+  bool same_partition = true;
+  for (const auto &edge : edges) {
+    int a = edge.first, b = (edge.second * 31 + 7) % n;
+    same_partition = same_partition && serial.is_same_set(a, b) ==
+                                           concurrent.same_set(a, b);
+    same_partition = same_partition &&
+                     concurrent.same_set(edge.first, edge.second);
+  }
+
+  std::cout << thread_count << " 个线程合并 " << edge_count << " 条边" << std::endl;
+  std::cout << "集合数量: 串行 " << serial.get_set_count() << ", 并发 "
+            << concurrent.get_set_count() << ", 成功合并次数 " << total_merged
+            << std::endl;
+  bool valid = same_partition &&
+               serial.get_set_count() == concurrent.get_set_count() &&
+               n - total_merged == concurrent.get_set_count();
+  std::cout << "验证: 两种并查集划分一致 - " << (valid ? "通过" : "失败")
+            << std::endl;
+}
+
 /**
  * @brief 主函数
  */
@@ -323,6 +387,7 @@ int main() {
   test_performance();
   test_edge_cases();
   test_connectivity_application();
+  test_concurrent_disjoint_set();
 
   std::cout << "\n========== 所有测试完成 ==========" << std::endl;
 
@@ -0,0 +1,117 @@
+#include "bit_matrix_graph.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+void report(const char *name, double int_ms, double bit_ms, bool same) {
+  std::cout << "  " << std::left << std::setw(22) << name << std::right
+            << std::fixed << std::setprecision(1) << "int矩阵 " << std::setw(9)
+            << int_ms << " ms  位矩阵 " << std::setw(8) << bit_ms
+            << " ms  加速 " << std::setw(6) << int_ms / bit_ms
+            << "x  结果一致: " << (same ? "是" : "否") << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: bit_matrix_graph_benchmark [节点数] [边密度]
+  int n = argc > 1 ? std::atoi(argv[1]) : 2048;
+  double density = argc > 2 ? std::atof(argv[2]) : 0.05;
+
+  // 对照：与 AdjacencyMatrixGraph 相同的 int 矩阵布局（每个可能的边4字节）
+  std::mt19937 gen(2262);
+  std::bernoulli_distribution coin(density);
+  std::vector<int> matrix(static_cast<size_t>(n) * n, 0);
+  BitMatrixGraph graph(n);
+  for (int u = 0; u < n; u++) {
+    for (int v = u + 1; v < n; v++) {
+      if (coin(gen)) {
+        matrix[static_cast<size_t>(u) * n + v] = 1;
+        matrix[static_cast<size_t>(v) * n + u] = 1;
+        graph.add_edge(u, v);
+      }
+    }
+  }
+  auto has_edge = [&](int u, int v) {
+    return matrix[static_cast<size_t>(u) * n + v] != 0;
+  };
+  std::cout << "节点数 " << n << "，边数 " << graph.get_edge_count()
+            << "，int矩阵 " << 4.0 * n * n / (1 << 20) << " MiB，位矩阵 "
+            << 8.0 * n * graph.get_words_per_row() / (1 << 20) << " MiB"
+            << std::endl;
+
+  // 三角形计数
+  std::uint64_t int_triangles = 0, bit_triangles = 0;
+  double int_ms = time_ms([&] {
+    for (int u = 0; u < n; u++)
+      for (int v = u + 1; v < n; v++)
+        if (has_edge(u, v))
+          for (int w = v + 1; w < n; w++)
+            int_triangles += has_edge(u, w) & has_edge(v, w);
+  });
+  double bit_ms = time_ms([&] { bit_triangles = graph.count_triangles(); });
+  report("三角形计数", int_ms, bit_ms, int_triangles == bit_triangles);
+
+  // 共同邻居数查询
+  const int queries = 200000;
+  std::uniform_int_distribution<int> node(0, n - 1);
+  std::vector<std::pair<int, int>> pairs(queries);
+  for (auto &pair : pairs) {
+    pair = {node(gen), node(gen)};
+  }
+  long long int_common = 0, bit_common = 0;
+  int_ms = time_ms([&] {
+    for (const auto &[u, v] : pairs)
+      for (int w = 0; w < n; w++)
+        int_common += has_edge(u, w) & has_edge(v, w);
+  });
+  bit_ms = time_ms([&] {
+    for (const auto &[u, v] : pairs)
+      bit_common += graph.common_neighbor_count(u, v);
+  });
+  report("共同邻居数（20万次）", int_ms, bit_ms, int_common == bit_common);
+
+  // 团验证：植入一个64顶点的团，逐对检查与按行与运算对比
+  std::vector<int> clique;
+  for (int v = 0; v < 64 && v < n; v++) {
+    clique.push_back(v);
+    for (int u : clique) {
+      if (u != v && !graph.has_edge(u, v)) {
+        matrix[static_cast<size_t>(u) * n + v] = 1;
+        matrix[static_cast<size_t>(v) * n + u] = 1;
+        graph.add_edge(u, v);
+      }
+    }
+  }
+  const int rounds = 20000;
+  int int_cliques = 0, bit_cliques = 0;
+  int_ms = time_ms([&] {
+    for (int r = 0; r < rounds; r++) {
+      bool ok = true;
+      for (size_t i = 0; ok && i < clique.size(); i++)
+        for (size_t j = i + 1; ok && j < clique.size(); j++)
+          ok = has_edge(clique[i], clique[j]);
+      int_cliques += ok;
+    }
+  });
+  bit_ms = time_ms([&] {
+    for (int r = 0; r < rounds; r++)
+      bit_cliques += graph.is_clique(clique);
+  });
+  report("64顶点团验证（2万次）", int_ms, bit_ms,
+         int_cliques == bit_cliques && bit_cliques == rounds);
+  return 0;
+}
@@ -1,6 +1,9 @@
+#include "bit_matrix_graph.h"
 #include "graph_representation.h"
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -264,6 +267,175 @@ void test_comparison_between_representations() {
   std::cout << std::endl;
 }
 
+void test_csr_graph() {
+  std::cout << "=== 测试压缩稀疏行（CSR）表示 ===" << std::endl;
+
+  // 与邻接表相同的图
+  AdjacencyListGraph list_graph(false);
+  for (int i = 1; i <= 6; i++) {
+    list_graph.add_node(i);
+  }
+  list_graph.add_edge(1, 2);
+  list_graph.add_edge(1, 3);
+  list_graph.add_edge(2, 4);
+  list_graph.add_edge(2, 5);
+  list_graph.add_edge(3, 6);
+  list_graph.add_edge(4, 5);
+  list_graph.add_edge(5, 6);
+
+  // 从邻接表转换
+  CSRGraph csr_graph = CSRGraphBuilder::from_adjacency_list(list_graph);
+  std::cout << "CSR节点数量: " << csr_graph.get_node_count()
+            << ", 边数量: " << csr_graph.get_edge_count() << std::endl;
+
+  std::cout << "  偏移数组: ";
+  for (size_t offset : csr_graph.get_offsets()) {
+    std::cout << offset << " ";
+  }
+  std::cout << std::endl;
+
+  bool bfs_same = csr_graph.bfs(1) == list_graph.bfs(1);
+  bool dfs_same = csr_graph.dfs(1) == list_graph.dfs(1);
+  std::cout << "  BFS与邻接表一致: " << (bfs_same ? "是" : "否") << std::endl;
+  std::cout << "  DFS与邻接表一致: " << (dfs_same ? "是" : "否") << std::endl;
+
+  // 使用构建器直接构建有向图
+  CSRGraphBuilder builder(true);
+  for (int i = 10; i <= 14; i++) {
+    builder.add_node(i);
+  }
+  builder.add_edge(10, 11, 3);
+  builder.add_edge(10, 12, 1);
+  builder.add_edge(12, 13, 4);
+  builder.add_edge(13, 14, 2);
+  builder.add_edge(11, 14, 7);
+  CSRGraph directed_csr = builder.build();
+
+  auto bfs_result = directed_csr.bfs(10);
+  std::cout << "  构建器有向图从节点10开始的BFS: ";
+  for (int node : bfs_result) {
+    std::cout << node << " ";
+  }
+  std::cout << std::endl;
+  std::cout << "  节点10的出度: " << directed_csr.get_degree(10) << std::endl;
+
+  std::cout << std::endl;
+}
+
+void test_bulk_edge_loading() {
+  std::cout << "=== 测试批量加边 ===" << std::endl;
+
+  AdjacencyListGraph graph(true);
+  graph.reserve(5);
+  for (int i = 100; i < 105; i++) {
+    graph.add_node(i);
+  }
+
+  // 包含两条重复边（101->102、103->104）
+  std::vector<GraphEdge> edges = {{100, 101, 2}, {101, 102, 3}, {100, 102, 9},
+                                  {101, 102, 5}, {103, 104, 1}, {102, 103, 4},
+                                  {103, 104, 8}};
+  graph.add_edges(edges);
+
+  graph.print_adjacency_list();
+  std::cout << "去重后边数量: " << graph.get_edge_count() << " (输入 "
+            << edges.size() << " 条)" << std::endl;
+
+  try {
+    graph.add_edges({{100, 999, 1}});
+    std::cout << "错误：应该抛出异常" << std::endl;
+  } catch (const std::invalid_argument &e) {
+    std::cout << "批量加入不存在的节点: 正确抛出异常，边数仍为 "
+              << graph.get_edge_count() << std::endl;
+  }
+
+  std::cout << std::endl;
+}
+
+void test_bit_matrix_graph() {
+  std::cout << "=== 测试位矩阵图 ===" << std::endl;
+
+  // 随机稠密图：同时建立整数邻接矩阵图作为对照
+  const int n = 300;
+  std::mt19937 gen(221);
+  std::bernoulli_distribution coin(0.3);
+  BitMatrixGraph bit_graph(n);
+  AdjacencyMatrixGraph matrix_graph(false);
+  for (int i = 0; i < n; i++) {
+    matrix_graph.add_node(i);
+  }
+  for (int u = 0; u < n; u++) {
+    for (int v = u + 1; v < n; v++) {
+      if (coin(gen)) {
+        bit_graph.add_edge(u, v);
+        matrix_graph.add_edge(u, v);
+      }
+    }
+  }
+  std::cout << "节点数: " << n << ", 边数: " << bit_graph.get_edge_count()
+            << ", 每行 " << bit_graph.get_words_per_row() << " 个64位字"
+            << std::endl;
+
+  bool edges_match = true, degrees_match = true;
+  for (int u = 0; u < n; u++) {
+    degrees_match = degrees_match && static_cast<int>(bit_graph.get_degree(u)) ==
+                                         matrix_graph.get_degree(u);
+    for (int v = 0; v < n; v++) {
+      edges_match = edges_match &&
+                    bit_graph.has_edge(u, v) == matrix_graph.has_edge(u, v);
+    }
+  }
+  std::cout << "边与度数与整数矩阵一致: "
+            << (edges_match && degrees_match ? "是" : "否") << std::endl;
+
+  // 三角形与共同邻居：与三重循环暴力计算对比
+  std::uint64_t brute = 0;
+  for (int u = 0; u < n; u++)
+    for (int v = u + 1; v < n; v++)
+      if (matrix_graph.has_edge(u, v))
+        for (int w = v + 1; w < n; w++)
+          brute += matrix_graph.has_edge(u, w) && matrix_graph.has_edge(v, w);
+  std::cout << "三角形个数: " << bit_graph.count_triangles()
+            << ", 暴力计算: " << brute << std::endl;
+
+  int common = 0;
+  for (int w = 0; w < n; w++) {
+    common += matrix_graph.has_edge(0, w) && matrix_graph.has_edge(1, w);
+  }
+  std::cout << "节点0与1的共同邻居数: " << bit_graph.common_neighbor_count(0, 1)
+            << ", 暴力计算: " << common << ", 列出的个数: "
+            << bit_graph.common_neighbors(0, 1).size() << std::endl;
+
+  // 团：植入一个大小为20的团
+  std::vector<int> clique;
+  for (int v = 100; v < 120; v++) {
+    clique.push_back(v);
+  }
+  for (size_t i = 0; i < clique.size(); i++) {
+    for (size_t j = i + 1; j < clique.size(); j++) {
+      if (!bit_graph.has_edge(clique[i], clique[j])) {
+        bit_graph.add_edge(clique[i], clique[j]);
+      }
+    }
+  }
+  std::cout << "植入的20个顶点是团: " << (bit_graph.is_clique(clique) ? "是" : "否");
+  bit_graph.remove_edge(clique[3], clique[7]);
+  std::cout << ", 删去一条边后: " << (bit_graph.is_clique(clique) ? "是" : "否")
+            << std::endl;
+
+  // 满足图概念：可以直接使用通用BFS
+  BitMatrixGraph path(5);
+  path.add_edge(0, 1);
+  path.add_edge(1, 2);
+  path.add_edge(3, 4);
+  std::cout << "通用BFS（从0出发）: ";
+  for (int v : graph_bfs(path, 0)) {
+    std::cout << v << " ";
+  }
+  std::cout << std::endl;
+  std::cout << std::endl;
+}
+
 int main() {
   std::cout << "第22.1章 图的表示演示程序" << std::endl;
   std::cout << "============================" << std::endl;
@@ -274,6 +446,9 @@ int main() {
   test_edge_cases();
   test_error_handling();
   test_comparison_between_representations();
+  test_csr_graph();
+  test_bulk_edge_loading();
+  test_bit_matrix_graph();
 
   std::cout << "所有测试完成！" << std::endl;
 
@@ -0,0 +1,291 @@
+#include "graph_representation.h"
+#include "parallel_graph_algorithms.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace algorithms;
+
+/**
+ * @brief 串行BFS计算层数，用于验证并行结果
+ */
+std::vector<int> serial_bfs_distances(const CSRGraph &graph, int source) {
+  std::vector<int> distances(graph.get_node_count(), -1);
+  int source_index = graph.get_node_index(source);
+  std::queue<int> q;
+  distances[source_index] = 0;
+  q.push(source_index);
+
+  while (!q.empty()) {
+    int u = q.front();
+    q.pop();
+    graph.for_each_out_edge(u, [&](int v, int) {
+      if (distances[v] == -1) {
+        distances[v] = distances[u] + 1;
+        q.push(v);
+      }
+    });
+  }
+  return distances;
+}
+
+/**
+ * @brief 检查父节点构成合法的BFS树
+ */
+bool verify_parents(const CSRGraph &graph, const ParallelBFSResult &result) {
+  for (size_t v = 0; v < graph.get_node_count(); v++) {
+    int p = result.parents[v];
+    if (p == -1) {
+      continue;
+    }
+    if (result.distances[p] + 1 != result.distances[v]) {
+      return false;
+    }
+    bool has_edge = false;
+    graph.for_each_out_edge(p, [&](int target, int) {
+      if (target == static_cast<int>(v))
+        has_edge = true;
+    });
+    if (!has_edge) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void test_small_graph() {
+  std::cout << "=== 小规模图的方向优化BFS ===" << std::endl;
+
+  // 算法导论图22.3的无向图（r s t u v w x y -> 0..7）
+  CSRGraphBuilder builder(false);
+  for (int i = 0; i < 8; i++) {
+    builder.add_node(i);
+  }
+  builder.add_edge(0, 1); // r-s
+  builder.add_edge(0, 4); // r-v
+  builder.add_edge(1, 5); // s-w
+  builder.add_edge(5, 2); // w-t
+  builder.add_edge(5, 6); // w-x
+  builder.add_edge(2, 6); // t-x
+  builder.add_edge(2, 3); // t-u
+  builder.add_edge(6, 3); // x-u
+  builder.add_edge(6, 7); // x-y
+  builder.add_edge(3, 7); // u-y
+  CSRGraph graph = builder.build();
+
+  // alpha=1使得每一层都尝试自底向上
+  auto result = DirectionOptimizingBFS::search(graph, 1, 2, 1, 24);
+  const char *names = "rstuvwxy";
+  for (size_t v = 0; v < graph.get_node_count(); v++) {
+    std::cout << "  " << names[v] << ": 距离 = " << result.distances[v]
+              << ", 父节点 = "
+              << (result.parents[v] == -1 ? '-' : names[result.parents[v]])
+              << std::endl;
+  }
+  std::cout << "层数: " << result.levels
+            << ", 自底向上层数: " << result.bottom_up_levels << std::endl;
+  std::cout << "与串行BFS一致: "
+            << (result.distances == serial_bfs_distances(graph, 1) ? "是"
+                                                                   : "否")
+            << std::endl;
+  std::cout << std::endl;
+}
+
+void test_large_graph(bool directed) {
+  std::cout << "=== 随机" << (directed ? "有向" : "无向")
+            << "图（低直径、高度数）===" << std::endl;
+
+  const int node_count = 100000;
+  const int edges_per_node = 16;
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> node_dis(0, node_count - 1);
+
+  CSRGraphBuilder builder(directed);
+  for (int i = 0; i < node_count; i++) {
+    builder.add_node(i);
+  }
+  for (int u = 0; u < node_count; u++) {
+    for (int k = 0; k < edges_per_node; k++) {
+      builder.add_edge(u, node_dis(gen));
+    }
+  }
+  CSRGraph graph = builder.build();
+  std::cout << "节点数: " << graph.get_node_count()
+            << ", 边数: " << graph.get_edge_count() << std::endl;
+
+  auto start = std::chrono::high_resolution_clock::now();
+  auto expected = serial_bfs_distances(graph, 0);
+  auto end = std::chrono::high_resolution_clock::now();
+  std::cout << "串行BFS - 时间: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(end -
+                                                                     start)
+                   .count()
+            << " 微秒" << std::endl;
+
+  unsigned int num_cores = std::max(1u, std::thread::hardware_concurrency());
+  for (size_t threads : {size_t(1), size_t(num_cores)}) {
+    start = std::chrono::high_resolution_clock::now();
+    auto result = DirectionOptimizingBFS::search(graph, 0, threads);
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "方向优化BFS（" << threads << "线程） - 时间: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end -
+                                                                       start)
+                     .count()
+              << " 微秒" << std::endl;
+    std::cout << "  层数: " << result.levels
+              << ", 自底向上层数: " << result.bottom_up_levels << std::endl;
+    std::cout << "  距离正确: " << (result.distances == expected ? "是" : "否")
+              << ", BFS树合法: "
+              << (verify_parents(graph, result) ? "是" : "否") << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+/**
+ * @brief 串行BFS标记连通分量（标签为分量中最小的下标）
+ */
+std::vector<int> serial_component_labels(const CSRGraph &graph) {
+  std::vector<int> labels(graph.get_node_count(), -1);
+  for (size_t s = 0; s < labels.size(); s++) {
+    if (labels[s] != -1) {
+      continue;
+    }
+    std::queue<int> q;
+    labels[s] = static_cast<int>(s);
+    q.push(static_cast<int>(s));
+    while (!q.empty()) {
+      int u = q.front();
+      q.pop();
+      graph.for_each_out_edge(u, [&](int v, int) {
+        if (labels[v] == -1) {
+          labels[v] = static_cast<int>(s);
+          q.push(v);
+        }
+      });
+    }
+  }
+  return labels;
+}
+
+void test_connected_components() {
+  std::cout << "=== 基于无锁并查集的并行连通分量 ===" << std::endl;
+
+  // 边数少于节点数，图中有大量分量
+  const int node_count = 200000;
+  const int edge_count = 150000;
+  std::mt19937 gen(22);
+  std::uniform_int_distribution<int> node_dis(0, node_count - 1);
+  CSRGraphBuilder builder(false);
+  for (int i = 0; i < node_count; i++) {
+    builder.add_node(i);
+  }
+  for (int k = 0; k < edge_count; k++) {
+    builder.add_edge(node_dis(gen), node_dis(gen));
+  }
+  CSRGraph graph = builder.build();
+
+  auto expected = serial_component_labels(graph);
+  unsigned int num_cores = std::max(1u, std::thread::hardware_concurrency());
+  for (size_t threads : {size_t(1), size_t(num_cores)}) {
+    WorkStealingScheduler scheduler(threads);
+    auto start = std::chrono::high_resolution_clock::now();
+    auto labels = ParallelConnectedComponents::label(scheduler, graph);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "并行连通分量（" << threads << "线程） - 时间: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end -
+                                                                       start)
+                     .count()
+              << " 微秒, 分量数: " << ParallelConnectedComponents::count(labels)
+              << ", 与串行BFS一致: " << (labels == expected ? "是" : "否")
+              << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+void test_parallel_topological_sort() {
+  std::cout << "=== 层同步的并行Kahn拓扑排序 ===" << std::endl;
+
+  // 分层的随机DAG：边只从编号小的节点指向编号大的节点
+  const int node_count = 200000;
+  std::mt19937 gen(224);
+  std::uniform_int_distribution<int> span(1, 2000);
+  CSRGraphBuilder builder(true);
+  for (int i = 0; i < node_count; i++) {
+    builder.add_node(i);
+  }
+  for (int u = 0; u < node_count; u++) {
+    for (int k = 0; k < 3; k++) {
+      int v = u + span(gen);
+      if (v < node_count) {
+        builder.add_edge(u, v);
+      }
+    }
+  }
+  CSRGraph graph = builder.build();
+
+  unsigned int num_cores = std::max(1u, std::thread::hardware_concurrency());
+  for (size_t threads : {size_t(1), size_t(num_cores)}) {
+    WorkStealingScheduler scheduler(threads);
+    auto start = std::chrono::high_resolution_clock::now();
+    TopologicalLevels levels = ParallelTopologicalSort::levels(scheduler, graph);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    // 每条边的终点所在层必须严格靠后
+    std::vector<size_t> level_of(node_count);
+    for (size_t k = 0; k < levels.level_count(); k++) {
+      for (size_t i = levels.level_offsets[k]; i < levels.level_offsets[k + 1];
+           i++) {
+        level_of[levels.order[i]] = k;
+      }
+    }
+    bool valid = levels.order.size() == static_cast<size_t>(node_count);
+    for (int u = 0; valid && u < node_count; u++) {
+      graph.for_each_out_edge(u, [&](int v, int) {
+        valid = valid && level_of[u] < level_of[v];
+      });
+    }
+    std::cout << "并行拓扑排序（" << threads << "线程） - 时间: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end -
+                                                                       start)
+                     .count()
+              << " 微秒, 层数: " << levels.level_count()
+              << ", 分层有效: " << (valid ? "是" : "否") << std::endl;
+  }
+
+  // 有环时抛出异常
+  CSRGraphBuilder cyclic_builder(true);
+  for (int i = 0; i < 3; i++) {
+    cyclic_builder.add_node(i);
+  }
+  cyclic_builder.add_edge(0, 1);
+  cyclic_builder.add_edge(1, 2);
+  cyclic_builder.add_edge(2, 1);
+  WorkStealingScheduler scheduler(2);
+  try {
+    ParallelTopologicalSort::levels(scheduler, cyclic_builder.build());
+    std::cout << "错误: 应该检测到环并抛出异常" << std::endl;
+  } catch (const std::runtime_error &e) {
+    std::cout << "正确检测到环: " << e.what() << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+int main() {
+  std::cout << "第22章 并行图算法演示程序" << std::endl;
+  std::cout << "==========================" << std::endl;
+
+  test_small_graph();
+  test_large_graph(false);
+  test_large_graph(true);
+  test_connected_components();
+  test_parallel_topological_sort();
+
+  std::cout << "所有测试完成！" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,166 @@
+#include "graph_representation.h"
+#include "strongly_connected_components.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace algorithms;
+
+// 两个划分是否相同（允许编号不同）
+bool same_partition(const SCCResult &a, const SCCResult &b) {
+  if (a.count != b.count) {
+    return false;
+  }
+  std::vector<int> mapping(a.count, -1);
+  for (size_t v = 0; v < a.component.size(); v++) {
+    int &mapped = mapping[a.component[v]];
+    if (mapped == -1) {
+      mapped = b.component[v];
+    } else if (mapped != b.component[v]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// 分量编号是否构成分量图的拓扑序
+template <typename Graph>
+bool labels_are_topological(const Graph &graph, const SCCResult &scc) {
+  for (size_t u = 0; u < graph.get_node_count(); u++) {
+    bool ok = true;
+    graph.for_each_out_edge(u, [&](int v, int) {
+      ok = ok && scc.component[u] <= scc.component[v];
+    });
+    if (!ok) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void test_clrs_example() {
+  std::cout << "=== 算法导论图22.9的强连通分量 ===" << std::endl;
+
+  // 节点 a..h 编号为 1..8
+  AdjacencyListGraph graph(true);
+  std::string names = "abcdefgh";
+  for (int i = 1; i <= 8; i++) {
+    graph.add_node(i, std::string(1, names[i - 1]));
+  }
+  int edges[][2] = {{1, 2}, {2, 3}, {2, 5}, {2, 6}, {3, 4}, {3, 7},
+                    {4, 3}, {4, 8}, {5, 1}, {5, 6}, {6, 7}, {7, 6},
+                    {7, 8}, {8, 8}};
+  for (auto &edge : edges) {
+    graph.add_edge(edge[0], edge[1]);
+  }
+  graph.print_adjacency_list();
+
+  SCCResult kosaraju = StronglyConnectedComponents::kosaraju(graph);
+  SCCResult tarjan = StronglyConnectedComponents::tarjan(graph);
+  std::cout << "Kosaraju 分量（按分量图的拓扑序）:" << std::endl;
+  for (const auto &members : kosaraju.members()) {
+    std::cout << "  {";
+    for (size_t k = 0; k < members.size(); k++) {
+      std::cout << (k ? ", " : "") << names[members[k]];
+    }
+    std::cout << "}" << std::endl;
+  }
+  std::cout << "Tarjan 与 Kosaraju 的编号相同: "
+            << (tarjan.component == kosaraju.component ? "是" : "否")
+            << std::endl;
+
+  CSRGraph dag = StronglyConnectedComponents::component_graph(graph, kosaraju);
+  std::cout << "分量图: " << dag.get_node_count() << " 个节点, "
+            << dag.get_edge_count() << " 条边" << std::endl;
+  for (size_t c = 0; c < dag.get_node_count(); c++) {
+    for (int next : dag.get_neighbors(static_cast<int>(c))) {
+      std::cout << "  C" << c << " -> C" << next << std::endl;
+    }
+  }
+  std::cout << std::endl;
+}
+
+void test_deep_cycle() {
+  std::cout << "=== 长环与长链（显式栈，不会栈溢出） ===" << std::endl;
+
+  const int node_count = 2000000;
+  CSRGraphBuilder builder(true);
+  for (int i = 0; i < node_count; i++) {
+    builder.add_node(i);
+  }
+  // 前一半首尾相连成一个大环，后一半是一条链
+  int half = node_count / 2;
+  for (int i = 0; i + 1 < node_count; i++) {
+    builder.add_edge(i, i + 1);
+  }
+  builder.add_edge(half - 1, 0);
+  CSRGraph graph = builder.build();
+
+  SCCResult kosaraju = StronglyConnectedComponents::kosaraju(graph);
+  SCCResult tarjan = StronglyConnectedComponents::tarjan(graph);
+  std::cout << "节点数 " << node_count << "，分量数 " << kosaraju.count
+            << "（期望 " << 1 + node_count - half << "），两种算法一致: "
+            << (same_partition(kosaraju, tarjan) ? "是" : "否") << std::endl;
+  std::cout << std::endl;
+}
+
+void test_random_graphs() {
+  std::cout << "=== 随机有向图上两种算法对比 ===" << std::endl;
+
+  std::mt19937 gen(225);
+  for (int n : {1000, 100000, 1000000}) {
+    // 平均出度略大于1，处在巨型强连通分量出现的临界附近
+    std::uniform_int_distribution<int> node(0, n - 1);
+    CSRGraphBuilder builder(true);
+    for (int i = 0; i < n; i++) {
+      builder.add_node(i);
+    }
+    for (int e = 0; e < n + n / 2; e++) {
+      builder.add_edge(node(gen), node(gen));
+    }
+    CSRGraph graph = builder.build();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    SCCResult kosaraju = StronglyConnectedComponents::kosaraju(graph);
+    auto middle = std::chrono::high_resolution_clock::now();
+    SCCResult tarjan = StronglyConnectedComponents::tarjan(graph);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    size_t largest = 0;
+    for (const auto &members : kosaraju.members()) {
+      largest = std::max(largest, members.size());
+    }
+    std::cout << "n = " << n << "，分量数 " << kosaraju.count << "，最大分量 "
+              << largest << "，Kosaraju "
+              << std::chrono::duration<double, std::milli>(middle - start)
+                     .count()
+              << " ms，Tarjan "
+              << std::chrono::duration<double, std::milli>(end - middle)
+                     .count()
+              << " ms，划分一致: "
+              << (same_partition(kosaraju, tarjan) ? "是" : "否")
+              << "，编号为拓扑序: "
+              << (labels_are_topological(graph, kosaraju) &&
+                          labels_are_topological(graph, tarjan)
+                      ? "是"
+                      : "否")
+              << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+int main() {
+  std::cout << "第22.5章 强连通分量演示程序" << std::endl;
+  std::cout << "============================" << std::endl;
+
+  test_clrs_example();
+  test_deep_cycle();
+  test_random_graphs();
+
+  std::cout << "所有测试完成！" << std::endl;
+
+  return 0;
+}
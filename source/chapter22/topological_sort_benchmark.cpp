@@ -0,0 +1,153 @@
+#include "graph_representation.h"
+#include "parallel_graph_algorithms.h"
+#include "strongly_connected_components.h"
+#include "topological_sort.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+void report(const char *name, double ms) {
+  std::cout << "  " << std::left << std::setw(28) << name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(10) << ms
+            << " ms" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: topological_sort_benchmark [任务数] [线程数]
+  int n = argc > 1 ? std::atoi(argv[1]) : 10000000;
+  size_t threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10)
+                            : std::thread::hardware_concurrency();
+  WorkStealingScheduler scheduler(threads == 0 ? 1 : threads);
+
+  // 类似构建系统的任务依赖图：每个任务依赖若干个编号更小的任务，
+  // 依赖大多在附近（同一模块），少数跨得很远（公共库）
+  std::mt19937 gen(2204);
+  std::uniform_int_distribution<int> near(1, 5000), count(0, 4);
+  std::uniform_real_distribution<double> coin(0.0, 1.0);
+  CSRGraphBuilder builder(true);
+  for (int i = 0; i < n; i++) {
+    builder.add_node(i);
+  }
+  for (int v = 1; v < n; v++) {
+    for (int k = count(gen); k > 0; k--) {
+      int u = coin(gen) < 0.9
+                  ? v - near(gen)
+                  : std::uniform_int_distribution<int>(0, v - 1)(gen);
+      if (u >= 0) {
+        builder.add_edge(u, v);
+      }
+    }
+  }
+  CSRGraph graph = builder.build();
+  std::cout << "任务数 " << n << "，依赖边数 " << graph.get_edge_count()
+            << "，线程 " << scheduler.get_num_threads() << std::endl;
+
+  TopologicalSort<CSRGraph> ts(graph);
+  std::vector<int> order;
+  report("DFS（显式栈）", time_ms([&] { order = ts.topological_sort_dfs(); }));
+  report("Kahn（串行队列）",
+         time_ms([&] { order = ts.topological_sort_kahn(); }));
+  TopologicalLevels levels;
+  report("层同步并行Kahn", time_ms([&] {
+           levels = ParallelTopologicalSort::levels(scheduler, graph);
+         }));
+  std::cout << "  层数 " << levels.level_count() << "，平均每层 "
+            << static_cast<double>(n) / levels.level_count() << " 个任务"
+            << std::endl;
+  SCCResult scc(0);
+  report("Tarjan强连通分量", time_ms([&] {
+           scc = StronglyConnectedComponents::tarjan(graph);
+         }));
+  std::cout << "  分量数 " << scc.count << "（DAG中应等于任务数）" << std::endl;
+
+  // 在线插入：边的两端均匀随机，方向服从一个隐藏的随机顺序（与初始顺序无关，
+  // 需要不断重排）；其中 5% 的边方向反过来，可能成环而被拒绝
+  int online_n = std::min(n, 100000);
+  size_t online_edges = 3 * static_cast<size_t>(online_n);
+  std::vector<int> hidden(online_n);
+  for (int i = 0; i < online_n; i++) {
+    hidden[i] = i;
+  }
+  std::shuffle(hidden.begin(), hidden.end(), gen);
+  std::uniform_int_distribution<int> node(0, online_n - 1);
+  std::vector<std::pair<int, int>> inserts, acyclic;
+  while (inserts.size() < online_edges) {
+    int a = node(gen), b = node(gen);
+    if (a == b) {
+      continue;
+    }
+    if (a > b) {
+      std::swap(a, b);
+    }
+    acyclic.emplace_back(hidden[a], hidden[b]);
+    inserts.push_back(coin(gen) < 0.95 ? acyclic.back()
+                                       : std::make_pair(hidden[b], hidden[a]));
+  }
+  std::cout << "在线插入：节点数 " << online_n << "，尝试插入 " << online_edges
+            << " 条边" << std::endl;
+  DynamicTopologicalOrder dynamic(online_n);
+  size_t accepted = 0;
+  double ms = time_ms([&] {
+    for (const auto &[u, v] : inserts) {
+      accepted += dynamic.add_edge(u, v);
+    }
+  });
+  report("Pearce–Kelly逐条插入", ms);
+  std::cout << "  接受 " << accepted << " 条，平均 " << std::setprecision(2)
+            << 1000.0 * ms / online_edges << " us/条" << std::endl;
+
+  // 对照：每次插入后从头运行Kahn算法，只测100次
+  CSRGraphBuilder reference_builder(true);
+  for (int i = 0; i < online_n; i++) {
+    reference_builder.add_node(i);
+  }
+  for (int u = 0; u < online_n; u++) {
+    for (int v : dynamic.get_out_neighbors(u)) {
+      reference_builder.add_edge(u, v);
+    }
+  }
+  CSRGraph reference = reference_builder.build();
+  TopologicalSort<CSRGraph> rerun(reference);
+  ms = time_ms([&] {
+    for (int k = 0; k < 100; k++) {
+      rerun.topological_sort_kahn();
+    }
+  });
+  std::cout << "  对照：每次插入后重新运行Kahn " << std::setprecision(2)
+            << 1000.0 * ms / 100 << " us/条" << std::endl;
+
+  // 批量插入（不含反向边，每批都能提交）：较大的批次整体重排
+  for (size_t batch : {size_t(1), size_t(100), size_t(100000)}) {
+    DynamicTopologicalOrder batched(online_n);
+    size_t committed = 0;
+    ms = time_ms([&] {
+      for (size_t k = 0; k < online_edges; k += batch) {
+        std::vector<std::pair<int, int>> edges(
+            acyclic.begin() + k,
+            acyclic.begin() + std::min(k + batch, online_edges));
+        committed += batched.add_edges(edges) ? edges.size() : 0;
+      }
+    });
+    std::string name = "批量插入（每批 " + std::to_string(batch) + " 条）";
+    report(name.c_str(), ms);
+    std::cout << "  提交 " << committed << " 条边" << std::endl;
+  }
+  return 0;
+}
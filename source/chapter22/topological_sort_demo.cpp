@@ -1,6 +1,8 @@
+#include "graph_representation.h"
 #include "topological_sort.h"
 #include <iomanip>
 #include <iostream>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -41,7 +43,7 @@ void test_dfs_topological_sort() {
   // 测试DFS拓扑排序
   auto dfs_order = ts.topological_sort_dfs();
   std::cout << "DFS拓扑排序结果: ";
-  TopologicalSort::print_topological_order(dfs_order);
+  TopologicalSort<>::print_topological_order(dfs_order);
 
   // 验证拓扑排序的正确性
   std::cout << "\n验证拓扑排序正确性:" << std::endl;
@@ -93,7 +95,7 @@ void test_kahn_topological_sort() {
   // 测试Kahn拓扑排序
   auto kahn_order = ts.topological_sort_kahn();
   std::cout << "Kahn拓扑排序结果: ";
-  TopologicalSort::print_topological_order(kahn_order);
+  TopologicalSort<>::print_topological_order(kahn_order);
 
   // 验证拓扑排序的正确性
   std::cout << "\n验证拓扑排序正确性:" << std::endl;
@@ -184,12 +186,12 @@ void test_comparison_between_algorithms() {
   // 测试DFS算法
   auto dfs_order = ts.topological_sort_dfs();
   std::cout << "DFS算法结果: ";
-  TopologicalSort::print_topological_order(dfs_order);
+  TopologicalSort<>::print_topological_order(dfs_order);
 
   // 测试Kahn算法
   auto kahn_order = ts.topological_sort_kahn();
   std::cout << "Kahn算法结果: ";
-  TopologicalSort::print_topological_order(kahn_order);
+  TopologicalSort<>::print_topological_order(kahn_order);
 
   // 比较两种算法的结果
   std::cout << "\n算法对比:" << std::endl;
@@ -230,7 +232,7 @@ void test_edge_cases() {
   TopologicalSort ts_single(single_node_graph);
   auto single_order = ts_single.topological_sort_dfs();
   std::cout << "单节点图的拓扑排序: ";
-  TopologicalSort::print_topological_order(single_order);
+  TopologicalSort<>::print_topological_order(single_order);
 
   // 测试线性链
   AdjacencyListGraph linear_graph(true);
@@ -244,7 +246,7 @@ void test_edge_cases() {
   TopologicalSort ts_linear(linear_graph);
   auto linear_order = ts_linear.topological_sort_dfs();
   std::cout << "线性链的拓扑排序: ";
-  TopologicalSort::print_topological_order(linear_order);
+  TopologicalSort<>::print_topological_order(linear_order);
 
   std::cout << std::endl;
 }
@@ -284,10 +286,10 @@ void test_algorithm_correctness() {
   auto kahn_order = ts.topological_sort_kahn();
 
   std::cout << "DFS算法结果: ";
-  TopologicalSort::print_topological_order(dfs_order);
+  TopologicalSort<>::print_topological_order(dfs_order);
 
   std::cout << "Kahn算法结果: ";
-  TopologicalSort::print_topological_order(kahn_order);
+  TopologicalSort<>::print_topological_order(kahn_order);
 
   // 验证两种算法结果是否都是有效的拓扑排序
   bool dfs_valid = true;
@@ -326,6 +328,129 @@ void test_algorithm_correctness() {
   std::cout << std::endl;
 }
 
+void test_deep_graph() {
+  std::cout << "=== 深度很大的链状图 ===" << std::endl;
+
+  // 一条长链再加上跨越若干节点的前向边，递归DFS在这里会栈溢出
+  const int node_count = 1000000;
+  CSRGraphBuilder builder(true);
+  for (int i = 0; i < node_count; i++) {
+    builder.add_node(i);
+  }
+  for (int i = 0; i + 1 < node_count; i++) {
+    builder.add_edge(i, i + 1);
+    if (i + 7 < node_count) {
+      builder.add_edge(i, i + 7);
+    }
+  }
+  CSRGraph chain = builder.build();
+
+  TopologicalSort<CSRGraph> ts(chain);
+  auto dfs_order = ts.topological_sort_dfs();
+  auto kahn_order = ts.topological_sort_kahn();
+  bool dfs_valid = dfs_order.size() == static_cast<size_t>(node_count);
+  for (int i = 0; dfs_valid && i < node_count; i++) {
+    dfs_valid = dfs_order[i] == i;
+  }
+  std::cout << "节点数 " << node_count << "，DFS拓扑排序得到唯一的合法顺序: "
+            << (dfs_valid ? "是" : "否") << "，与Kahn算法一致: "
+            << (dfs_order == kahn_order ? "是" : "否") << std::endl;
+
+  // 链尾连回链首形成一个很长的环
+  builder.add_edge(node_count - 1, 0);
+  CSRGraph cycle = builder.build();
+  TopologicalSort<CSRGraph> cyclic(cycle);
+  std::cout << "首尾相连后检测到环: " << (cyclic.is_dag() ? "否" : "是")
+            << std::endl;
+  std::cout << std::endl;
+}
+
+void test_dynamic_topological_order() {
+  std::cout << "=== 动态DAG的在线拓扑序（Pearce–Kelly） ===" << std::endl;
+
+  DynamicTopologicalOrder dynamic(5);
+  std::cout << "插入 3 -> 1: " << (dynamic.add_edge(3, 1) ? "接受" : "拒绝")
+            << std::endl;
+  std::cout << "插入 1 -> 0: " << (dynamic.add_edge(1, 0) ? "接受" : "拒绝")
+            << std::endl;
+  std::cout << "插入 4 -> 3: " << (dynamic.add_edge(4, 3) ? "接受" : "拒绝")
+            << std::endl;
+  std::cout << "插入 0 -> 4（会形成环 0->4->3->1->0）: "
+            << (dynamic.add_edge(0, 4) ? "接受" : "拒绝") << std::endl;
+  std::cout << "批量插入 {2 -> 4, 0 -> 2}（整批成环）: "
+            << (dynamic.add_edges({{2, 4}, {0, 2}}) ? "接受" : "拒绝")
+            << "，边数仍为 " << dynamic.get_edge_count() << std::endl;
+  std::cout << "当前拓扑序: ";
+  for (int v : dynamic.order()) {
+    std::cout << v << " ";
+  }
+  std::cout << std::endl;
+
+  // 随机插入：与“终点能否到达起点”的暴力判断逐条对比
+  const int node_count = 300;
+  std::mt19937 gen(2241);
+  std::uniform_int_distribution<int> node(0, node_count - 1);
+  DynamicTopologicalOrder order(node_count);
+  std::vector<std::vector<int>> adjacency(node_count);
+  auto reaches = [&](int from, int to) {
+    std::vector<bool> seen(node_count, false);
+    std::vector<int> stack = {from};
+    seen[from] = true;
+    while (!stack.empty()) {
+      int x = stack.back();
+      stack.pop_back();
+      if (x == to) {
+        return true;
+      }
+      for (int y : adjacency[x]) {
+        if (!seen[y]) {
+          seen[y] = true;
+          stack.push_back(y);
+        }
+      }
+    }
+    return false;
+  };
+  bool decisions_match = true;
+  int accepted = 0;
+  for (int k = 0; k < 3000; k++) {
+    int u = node(gen), v = node(gen);
+    bool expected = u != v && !reaches(v, u);
+    bool got = order.add_edge(u, v);
+    decisions_match = decisions_match && expected == got;
+    if (got) {
+      adjacency[u].push_back(v);
+      accepted++;
+    }
+  }
+  auto order_is_valid = [&] {
+    for (int u = 0; u < node_count; u++) {
+      for (int v : order.get_out_neighbors(u)) {
+        if (order.get_position(u) >= order.get_position(v)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  };
+  std::cout << "随机插入 3000 条边，接受 " << accepted
+            << " 条，判断与暴力搜索一致: " << (decisions_match ? "是" : "否")
+            << "，顺序有效: " << (order_is_valid() ? "是" : "否") << std::endl;
+
+  // 从静态图初始化后继续插入
+  AdjacencyListGraph dag(true);
+  for (int i = 1; i <= 4; i++) {
+    dag.add_node(i);
+  }
+  dag.add_edge(1, 2);
+  dag.add_edge(2, 3);
+  dag.add_edge(3, 4);
+  auto from_graph = DynamicTopologicalOrder::from_graph(dag);
+  std::cout << "从链 1->2->3->4 初始化后插入 4 -> 1: "
+            << (from_graph.add_edge(3, 0) ? "接受" : "拒绝") << std::endl;
+  std::cout << std::endl;
+}
+
 int main() {
   std::cout << "第22.4章 拓扑排序演示程序" << std::endl;
   std::cout << "============================" << std::endl;
@@ -337,6 +462,8 @@ int main() {
   test_comparison_between_algorithms();
   test_edge_cases();
   test_algorithm_correctness();
+  test_deep_graph();
+  test_dynamic_topological_order();
 
   std::cout << "所有测试完成！" << std::endl;
 
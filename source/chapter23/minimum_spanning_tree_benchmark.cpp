@@ -0,0 +1,85 @@
+#include "minimum_spanning_tree.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: minimum_spanning_tree_benchmark [节点数] [平均度数]
+  int node_count = argc > 1 ? std::atoi(argv[1]) : 200000;
+  int degree = argc > 2 ? std::atoi(argv[2]) : 16;
+  if (node_count < 2 || degree < 1) {
+    std::cerr << "参数无效" << std::endl;
+    return 1;
+  }
+
+  std::mt19937 gen(2023);
+  std::uniform_int_distribution<int> node_dis(1, node_count);
+  std::uniform_int_distribution<int> weight_dis(1, 1000000);
+  CSRGraphBuilder builder(false);
+  for (int i = 1; i <= node_count; i++) {
+    builder.add_node(i);
+  }
+  for (int i = 1; i < node_count; i++) {
+    builder.add_edge(i, i + 1, weight_dis(gen));
+  }
+  long long extra = static_cast<long long>(node_count) * degree / 2;
+  for (long long k = 0; k < extra; k++) {
+    int u = node_dis(gen), v = node_dis(gen);
+    if (u != v) {
+      builder.add_edge(u, v, weight_dis(gen));
+    }
+  }
+  CSRGraph graph = builder.build();
+  MinimumSpanningTree<CSRGraph> mst(graph);
+  std::cout << "节点数: " << node_count
+            << ", 边数: " << graph.get_edge_count() << std::endl;
+
+  std::vector<GraphEdge> reference;
+  double serial = time_ms([&] { reference = mst.kruskal(); });
+  long long reference_weight = 0;
+  for (const GraphEdge &edge : reference) {
+    reference_weight += edge.weight;
+  }
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << "串行Kruskal: " << serial << " ms" << std::endl;
+
+  auto same_weight = [&](const std::vector<GraphEdge> &edges) {
+    long long weight = 0;
+    for (const GraphEdge &edge : edges) {
+      weight += edge.weight;
+    }
+    return edges.size() == reference.size() && weight == reference_weight;
+  };
+
+  unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+  std::cout << std::setw(8) << "线程数" << std::setw(16) << "并行Kruskal"
+            << std::setw(16) << "Filter-Kruskal" << std::setw(12) << "Borůvka"
+            << std::setw(10) << "结果" << std::endl;
+  for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+    WorkStealingScheduler scheduler(threads);
+    std::vector<GraphEdge> a, b, c;
+    double t_kruskal = time_ms([&] { a = mst.kruskal(scheduler); });
+    double t_filter = time_ms([&] { b = mst.filter_kruskal(scheduler); });
+    double t_boruvka = time_ms([&] { c = mst.boruvka(scheduler); });
+    bool ok = same_weight(a) && same_weight(b) && same_weight(c);
+    std::cout << std::setw(8) << threads << std::setw(13) << t_kruskal
+              << " ms" << std::setw(13) << t_filter << " ms" << std::setw(9)
+              << t_boruvka << " ms" << std::setw(10) << (ok ? "一致" : "不一致")
+              << std::endl;
+  }
+  return 0;
+}
@@ -1,6 +1,7 @@
 #include "minimum_spanning_tree.h"
 #include <iomanip>
 #include <iostream>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -41,7 +42,7 @@ void test_kruskal_algorithm() {
 
   // 测试Kruskal算法
   auto kruskal_edges = mst.kruskal();
-  MinimumSpanningTree::print_mst(kruskal_edges, "Kruskal算法");
+  MinimumSpanningTree<>::print_mst(kruskal_edges, "Kruskal算法");
 
   // 验证MST
   bool valid = mst.validate_mst(kruskal_edges);
@@ -84,7 +85,7 @@ void test_prim_algorithm() {
 
   // 测试Prim算法（从不同起始节点）
   auto prim_edges = mst.prim(1);
-  MinimumSpanningTree::print_mst(prim_edges, "Prim算法（从节点1开始）");
+  MinimumSpanningTree<>::print_mst(prim_edges, "Prim算法（从节点1开始）");
 
   // 验证MST
   bool valid = mst.validate_mst(prim_edges);
@@ -123,11 +124,11 @@ void test_comparison_between_algorithms() {
 
   // 测试Kruskal算法
   auto kruskal_edges = mst.kruskal();
-  MinimumSpanningTree::print_mst(kruskal_edges, "Kruskal算法");
+  MinimumSpanningTree<>::print_mst(kruskal_edges, "Kruskal算法");
 
   // 测试Prim算法
   auto prim_edges = mst.prim(1);
-  MinimumSpanningTree::print_mst(prim_edges, "Prim算法");
+  MinimumSpanningTree<>::print_mst(prim_edges, "Prim算法");
 
   // 比较两种算法的结果
   int kruskal_weight = mst.calculate_total_weight(kruskal_edges);
@@ -193,7 +194,7 @@ void test_edge_cases() {
 
   MinimumSpanningTree mst(complete_graph);
   auto edges = mst.kruskal();
-  MinimumSpanningTree::print_mst(edges, "完全图的MST");
+  MinimumSpanningTree<>::print_mst(edges, "完全图的MST");
 
   bool valid = mst.validate_mst(edges);
   std::cout << "MST验证: " << (valid ? "通过" : "失败") << std::endl;
@@ -287,8 +288,8 @@ void test_algorithm_correctness() {
   auto kruskal_edges = mst.kruskal();
   auto prim_edges = mst.prim(1);
 
-  MinimumSpanningTree::print_mst(kruskal_edges, "Kruskal算法");
-  MinimumSpanningTree::print_mst(prim_edges, "Prim算法");
+  MinimumSpanningTree<>::print_mst(kruskal_edges, "Kruskal算法");
+  MinimumSpanningTree<>::print_mst(prim_edges, "Prim算法");
 
   // 验证两种算法的结果
   bool kruskal_valid = mst.validate_mst(kruskal_edges);
@@ -313,6 +314,109 @@ void test_algorithm_correctness() {
   std::cout << std::endl;
 }
 
+void test_parallel_kruskal() {
+  std::cout << "=== 测试并行过滤的Kruskal算法 ===" << std::endl;
+
+  // 随机连通图：先连一条链保证连通，再加随机边
+  const int node_count = 5000;
+  const int extra_edges = 60000;
+  std::mt19937 gen(23);
+  std::uniform_int_distribution<int> node_dis(1, node_count);
+  std::uniform_int_distribution<int> weight_dis(1, 1000);
+  CSRGraphBuilder builder(false);
+  for (int i = 1; i <= node_count; i++) {
+    builder.add_node(i);
+  }
+  for (int i = 1; i < node_count; i++) {
+    builder.add_edge(i, i + 1, weight_dis(gen));
+  }
+  for (int k = 0; k < extra_edges; k++) {
+    int u = node_dis(gen), v = node_dis(gen);
+    if (u != v) {
+      builder.add_edge(u, v, weight_dis(gen));
+    }
+  }
+  CSRGraph graph = builder.build();
+  MinimumSpanningTree<CSRGraph> mst(graph);
+
+  auto serial_edges = mst.kruskal();
+  WorkStealingScheduler scheduler(4);
+  auto parallel_edges = mst.kruskal(scheduler, 4096);
+
+  bool identical = serial_edges.size() == parallel_edges.size();
+  for (size_t i = 0; identical && i < serial_edges.size(); i++) {
+    identical = serial_edges[i] == parallel_edges[i] &&
+                serial_edges[i].weight == parallel_edges[i].weight;
+  }
+  std::cout << "节点数: " << node_count
+            << ", 边数: " << graph.get_edge_count() << std::endl;
+  std::cout << "串行Kruskal总权重: " << mst.calculate_total_weight(serial_edges)
+            << ", 并行Kruskal总权重: "
+            << mst.calculate_total_weight(parallel_edges) << std::endl;
+  std::cout << "两种实现选出的边完全相同: " << (identical ? "是" : "否")
+            << ", MST验证: " << (mst.validate_mst(parallel_edges) ? "通过" : "失败")
+            << std::endl;
+  std::cout << std::endl;
+}
+
+// 两组边是否完全相同（端点与权重）
+bool same_edges(const std::vector<GraphEdge> &a,
+                const std::vector<GraphEdge> &b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); i++) {
+    if (!(a[i] == b[i]) || a[i].weight != b[i].weight) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void test_boruvka_and_filter_kruskal() {
+  std::cout << "=== 测试并行Borůvka与Filter-Kruskal算法 ===" << std::endl;
+
+  // 随机图：权重有大量重复，部分节点孤立，结果为最小生成森林
+  const int node_count = 6000;
+  const int edge_count = 80000;
+  std::mt19937 gen(47);
+  std::uniform_int_distribution<int> node_dis(1, node_count - 100);
+  std::uniform_int_distribution<int> weight_dis(-50, 200);
+  CSRGraphBuilder builder(false);
+  for (int i = 1; i <= node_count; i++) {
+    builder.add_node(i);
+  }
+  for (int k = 0; k < edge_count; k++) {
+    int u = node_dis(gen), v = node_dis(gen);
+    if (u != v) {
+      builder.add_edge(u, v, weight_dis(gen));
+    }
+  }
+  CSRGraph graph = builder.build();
+  MinimumSpanningTree<CSRGraph> mst(graph);
+
+  WorkStealingScheduler scheduler(4);
+  auto serial_edges = mst.kruskal();
+  auto boruvka_edges = mst.boruvka(scheduler, 1024);
+  auto filter_edges = mst.filter_kruskal(scheduler, 2048);
+
+  int serial_weight = mst.calculate_total_weight(serial_edges);
+  std::cout << "节点数: " << node_count
+            << ", 边数: " << graph.get_edge_count() << std::endl;
+  std::cout << "总权重 - 串行Kruskal: " << serial_weight
+            << ", Borůvka: " << mst.calculate_total_weight(boruvka_edges)
+            << ", Filter-Kruskal: " << mst.calculate_total_weight(filter_edges)
+            << std::endl;
+  std::cout << "森林边数 - 串行Kruskal: " << serial_edges.size()
+            << ", Borůvka: " << boruvka_edges.size()
+            << ", Filter-Kruskal: " << filter_edges.size() << std::endl;
+  // 两者按 (权重, 边编号) 的全序求解，同权边的取舍也一致
+  std::cout << "Borůvka与Filter-Kruskal选出的边完全相同: "
+            << (same_edges(boruvka_edges, filter_edges) ? "是" : "否")
+            << std::endl;
+  std::cout << std::endl;
+}
+
 int main() {
   std::cout << "第23章 最小生成树演示程序" << std::endl;
   std::cout << "============================" << std::endl;
@@ -324,6 +428,8 @@ int main() {
   test_edge_cases();
   test_error_handling();
   test_algorithm_correctness();
+  test_parallel_kruskal();
+  test_boruvka_and_filter_kruskal();
 
   std::cout << "所有测试完成！" << std::endl;
 
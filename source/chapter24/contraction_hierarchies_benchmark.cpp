@@ -0,0 +1,108 @@
+#include "contraction_hierarchies.h"
+#include "graph_representation.h"
+#include "point_to_point_shortest_path.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+void report(const char *name, double ms, size_t queries, size_t settled,
+            bool same) {
+  std::cout << "  " << std::left << std::setw(24) << name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(12)
+            << 1000.0 * ms / queries << " us/次" << std::setw(10)
+            << settled / queries << " 个出堆节点  结果一致: "
+            << (same ? "是" : "否") << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: contraction_hierarchies_benchmark [网格边长] [查询次数] [线程数]
+  int side = argc > 1 ? std::atoi(argv[1]) : 150;
+  size_t queries = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000;
+  size_t threads = argc > 3 ? std::strtoul(argv[3], nullptr, 10)
+                            : std::thread::hardware_concurrency();
+  WorkStealingScheduler scheduler(threads == 0 ? 1 : threads);
+
+  // 类似路网的网格图：相邻格子双向连通，两个方向的权重独立随机
+  int n = side * side;
+  std::mt19937 gen(2458);
+  std::uniform_int_distribution<int> weight(10, 100), node(0, n - 1);
+  CSRGraphBuilder builder(true);
+  for (int i = 0; i < n; i++)
+    builder.add_node(i);
+  for (int r = 0; r < side; r++) {
+    for (int c = 0; c < side; c++) {
+      int u = r * side + c;
+      if (c + 1 < side) {
+        builder.add_edge(u, u + 1, weight(gen));
+        builder.add_edge(u + 1, u, weight(gen));
+      }
+      if (r + 1 < side) {
+        builder.add_edge(u, u + side, weight(gen));
+        builder.add_edge(u + side, u, weight(gen));
+      }
+    }
+  }
+  CSRGraph graph = builder.build();
+  std::vector<std::pair<int, int>> pairs(queries);
+  for (auto &pair : pairs)
+    pair = {node(gen), node(gen)};
+  std::cout << "网格 " << side << " × " << side << "，节点数 " << n
+            << "，边数 " << graph.get_edge_count() << "，查询 " << queries
+            << " 次，线程 " << scheduler.get_num_threads() << std::endl;
+
+  ContractionHierarchy hierarchy;
+  double ms = time_ms([&] { hierarchy = ContractionHierarchy::build(graph); });
+  std::cout << "  预处理（串行）" << std::fixed << std::setprecision(1) << ms
+            << " ms" << std::endl;
+  ms = time_ms(
+      [&] { hierarchy = ContractionHierarchy::build(graph, scheduler); });
+  std::cout << "  预处理（并行）" << ms << " ms，向上边 "
+            << hierarchy.get_up_edge_count() << "，向下边 "
+            << hierarchy.get_down_edge_count() << "，缓冲区 "
+            << hierarchy.size_bytes() / double(1 << 20) << " MiB" << std::endl;
+
+  PointToPointSearch search(graph);
+  std::vector<int> expected(queries);
+  size_t settled = 0;
+  ms = time_ms([&] {
+    for (size_t q = 0; q < queries; q++) {
+      PathQueryResult result =
+          search.bidirectional_dijkstra(pairs[q].first, pairs[q].second);
+      expected[q] = result.distance;
+      settled += result.settled;
+    }
+  });
+  report("双向Dijkstra", ms, queries, settled, true);
+
+  ContractionHierarchyQuery query(hierarchy);
+  for (bool unpack : {false, true}) {
+    bool same = true;
+    settled = 0;
+    ms = time_ms([&] {
+      for (size_t q = 0; q < queries; q++) {
+        PathQueryResult result =
+            query.query(pairs[q].first, pairs[q].second, unpack);
+        same = same && result.distance == expected[q];
+        settled += result.settled;
+      }
+    });
+    report(unpack ? "收缩层次（展开路径）" : "收缩层次（仅距离）", ms,
+           queries, settled, same);
+  }
+  return 0;
+}
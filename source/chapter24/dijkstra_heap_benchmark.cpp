@@ -0,0 +1,97 @@
+#include "graph_representation.h"
+#include "shortest_path.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace algorithms;
+
+/**
+ * @brief 生成随机有向图
+ * @param node_count 节点数量
+ * @param edge_count 边数量（去重后略少）
+ * @param max_weight 最大边权
+ */
+AdjacencyListGraph generate_random_graph(int node_count, long long edge_count,
+                                         int max_weight) {
+  AdjacencyListGraph graph(true);
+  graph.reserve(node_count);
+  for (int i = 0; i < node_count; i++) {
+    graph.add_node(i);
+  }
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> node_dis(0, node_count - 1);
+  std::uniform_int_distribution<int> weight_dis(0, max_weight);
+
+  std::vector<GraphEdge> edges;
+  edges.reserve(edge_count);
+
+  // 先连成一条链，保证所有节点从0可达
+  for (int i = 0; i + 1 < node_count; i++) {
+    edges.emplace_back(i, i + 1, weight_dis(gen));
+  }
+
+  while (static_cast<long long>(edges.size()) < edge_count) {
+    edges.emplace_back(node_dis(gen), node_dis(gen), weight_dis(gen));
+  }
+
+  // 批量加入并一次性去重（重复边很少，实际边数略小于edge_count）
+  graph.add_edges(edges);
+  return graph;
+}
+
+/**
+ * @brief 对指定的优先队列运行Dijkstra并计时
+ */
+template <typename Queue>
+ShortestPathResult benchmark(const std::string &name,
+                             const AdjacencyListGraph &graph) {
+  auto start = std::chrono::high_resolution_clock::now();
+  auto result = Dijkstra::find_shortest_path<Queue>(graph, 0);
+  auto end = std::chrono::high_resolution_clock::now();
+  auto ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+  std::cout << name << ": " << ms << " ms" << std::endl;
+  return result;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: dijkstra_heap_benchmark [节点数] [边数] [最大权重]
+  int node_count = argc > 1 ? std::atoi(argv[1]) : 200000;
+  long long edge_count = argc > 2 ? std::atoll(argv[2]) : 2000000;
+  int max_weight = argc > 3 ? std::atoi(argv[3]) : 100;
+
+  std::cout << "Dijkstra优先队列性能比较" << std::endl;
+  std::cout << "节点数: " << node_count << ", 边数: " << edge_count
+            << ", 最大权重: " << max_weight << std::endl;
+
+  auto graph = generate_random_graph(node_count, edge_count, max_weight);
+
+  auto binary = benchmark<BinaryHeapDijkstraQueue>("二叉堆", graph);
+  auto fibonacci = benchmark<FibonacciHeapDijkstraQueue>("斐波那契堆", graph);
+  auto bucket = benchmark<BucketDijkstraQueue>("桶队列", graph);
+  auto radix = benchmark<RadixHeapDijkstraQueue>("基数堆", graph);
+  auto binary_addr =
+      benchmark<BinaryAddressableDijkstraQueue>("二叉堆（decrease-key）", graph);
+  auto four_ary =
+      benchmark<FourAryHeapDijkstraQueue>("4叉堆（decrease-key）", graph);
+  auto pairing =
+      benchmark<PairingHeapDijkstraQueue>("配对堆（decrease-key）", graph);
+  auto fibonacci_addr = benchmark<FibonacciAddressableDijkstraQueue>(
+      "斐波那契堆（句柄池）", graph);
+
+  bool consistent = binary.distances == fibonacci.distances &&
+                    binary.distances == bucket.distances &&
+                    binary.distances == radix.distances &&
+                    binary.distances == binary_addr.distances &&
+                    binary.distances == four_ary.distances &&
+                    binary.distances == pairing.distances &&
+                    binary.distances == fibonacci_addr.distances;
+  std::cout << "结果一致: " << (consistent ? "是" : "否") << std::endl;
+
+  return consistent ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+#include "graph_representation.h"
+#include "point_to_point_shortest_path.h"
+#include "shortest_path.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+void report(const char *name, double ms, size_t queries, size_t settled,
+            bool same) {
+  std::cout << "  " << std::left << std::setw(24) << name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(12)
+            << 1000.0 * ms / queries << " us/次" << std::setw(10)
+            << settled / queries << " 个出堆节点  结果一致: "
+            << (same ? "是" : "否") << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: point_to_point_benchmark [网格边长] [查询次数] [地标数]
+  int side = argc > 1 ? std::atoi(argv[1]) : 700;
+  size_t queries = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200;
+  size_t k = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 16;
+
+  // 类似路网的网格图：相邻格子双向连通，两个方向的权重独立随机
+  int n = side * side;
+  std::mt19937 gen(2458);
+  std::uniform_int_distribution<int> weight(10, 100), node(0, n - 1);
+  CSRGraphBuilder builder(true);
+  for (int i = 0; i < n; i++)
+    builder.add_node(i);
+  for (int r = 0; r < side; r++) {
+    for (int c = 0; c < side; c++) {
+      int u = r * side + c;
+      if (c + 1 < side) {
+        builder.add_edge(u, u + 1, weight(gen));
+        builder.add_edge(u + 1, u, weight(gen));
+      }
+      if (r + 1 < side) {
+        builder.add_edge(u, u + side, weight(gen));
+        builder.add_edge(u + side, u, weight(gen));
+      }
+    }
+  }
+  CSRGraph graph = builder.build();
+  std::vector<std::pair<int, int>> pairs(queries);
+  for (auto &pair : pairs)
+    pair = {node(gen), node(gen)};
+  std::cout << "网格 " << side << " × " << side << "，节点数 " << n
+            << "，边数 " << graph.get_edge_count() << "，查询 " << queries
+            << " 次" << std::endl;
+
+  // 完整单源Dijkstra只跑前20次查询
+  size_t full_queries = std::min<size_t>(queries, 20);
+  std::vector<int> expected(queries);
+  double ms = time_ms([&] {
+    for (size_t q = 0; q < full_queries; q++)
+      expected[q] = Dijkstra::find_shortest_path<RadixHeapDijkstraQueue>(
+                        graph, pairs[q].first)
+                        .distances[pairs[q].second];
+  });
+  report("完整单源Dijkstra", ms, full_queries, full_queries * n, true);
+
+  PointToPointSearch search(graph);
+  ms = time_ms([&] { search.build_landmarks(k); });
+  std::cout << "  ALT预处理（" << k << " 个地标）" << std::fixed
+            << std::setprecision(1) << ms << " ms，距离表 "
+            << 2.0 * n * k * sizeof(std::uint32_t) / (1 << 20) << " MiB"
+            << std::endl;
+  for (size_t q = full_queries; q < queries; q++)
+    expected[q] = search.dijkstra(pairs[q].first, pairs[q].second).distance;
+
+  auto run = [&](const char *name, auto query) {
+    size_t settled = 0;
+    bool same = true;
+    double elapsed = time_ms([&] {
+      for (size_t q = 0; q < queries; q++) {
+        PathQueryResult result = query(pairs[q].first, pairs[q].second);
+        settled += result.settled;
+        same = same && result.distance == expected[q];
+      }
+    });
+    report(name, elapsed, queries, settled, same);
+  };
+  run("提前终止的Dijkstra",
+      [&](int s, int t) { return search.dijkstra(s, t); });
+  run("双向Dijkstra",
+      [&](int s, int t) { return search.bidirectional_dijkstra(s, t); });
+  run("ALT（A*+地标）", [&](int s, int t) { return search.alt(s, t); });
+  return 0;
+}
@@ -1,6 +1,15 @@
+#include "contraction_hierarchies.h"
 #include "graph_representation.h"
+#include "point_to_point_shortest_path.h"
 #include "shortest_path.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -111,6 +120,18 @@ void test_dijkstra() {
   // 打印结果
   print_shortest_path_result(result, 0);
 
+  // 使用不同的优先队列，结果应一致
+  auto fib_result =
+      Dijkstra::find_shortest_path<FibonacciHeapDijkstraQueue>(graph, 0);
+  auto bucket_result =
+      Dijkstra::find_shortest_path<BucketDijkstraQueue>(graph, 0);
+  std::cout << "斐波那契堆结果一致: "
+            << (fib_result.distances == result.distances ? "是" : "否")
+            << std::endl;
+  std::cout << "桶队列结果一致: "
+            << (bucket_result.distances == result.distances ? "是" : "否")
+            << std::endl;
+
   std::cout << std::endl;
 }
 
@@ -238,6 +259,326 @@ void test_edge_cases() {
   std::cout << std::endl;
 }
 
+// SPFA与Δ-步进测试：与Bellman-Ford、Dijkstra对照
+void test_spfa_and_delta_stepping() {
+  std::cout << "=== 测试SPFA与Δ-步进 ===" << std::endl;
+
+  // 算法导论图24.4，含负权边
+  AdjacencyListGraph graph(true);
+  for (int i = 0; i < 5; i++) {
+    graph.add_node(i);
+  }
+  graph.add_edge(0, 1, 6);
+  graph.add_edge(0, 2, 7);
+  graph.add_edge(1, 2, 8);
+  graph.add_edge(1, 3, 5);
+  graph.add_edge(1, 4, -4);
+  graph.add_edge(2, 3, -3);
+  graph.add_edge(2, 4, 9);
+  graph.add_edge(3, 1, -2);
+  graph.add_edge(4, 0, 2);
+  graph.add_edge(4, 3, 7);
+  auto spfa = SPFA::find_shortest_path(graph, 0);
+  print_shortest_path_result(spfa, 0);
+  std::cout << "SPFA与Bellman-Ford一致: "
+            << (spfa.distances ==
+                        BellmanFord::find_shortest_path(graph, 0).distances
+                    ? "是"
+                    : "否")
+            << std::endl;
+
+  graph.add_edge(3, 2, -1); // x->y->x 构成负权环
+  std::cout << "SPFA检测到负权环: "
+            << (SPFA::find_shortest_path(graph, 0).has_negative_cycle ? "是"
+                                                                       : "否")
+            << std::endl;
+
+  // 随机稀疏图，不同Δ下与Dijkstra对照，并检查前驱给出的边都是紧边
+  const int n = 20000;
+  std::mt19937 gen(24);
+  std::uniform_int_distribution<int> node(0, n - 1), weight(0, 1000);
+  CSRGraphBuilder builder(true);
+  for (int i = 0; i < n; i++) {
+    builder.add_node(i);
+  }
+  for (int e = 0; e < 6 * n; e++) {
+    builder.add_edge(node(gen), node(gen), weight(gen));
+  }
+  CSRGraph random_graph = builder.build();
+  auto reference = Dijkstra::find_shortest_path(random_graph, 0);
+
+  WorkStealingScheduler scheduler(4);
+  for (int delta : {1, 50, 0, 1000, 100000}) {
+    auto result =
+        DeltaStepping::find_shortest_path(random_graph, 0, scheduler, delta);
+    bool tight = true;
+    for (int v = 0; v < n; v++) {
+      int p = result.predecessors[v];
+      if (p == -1) {
+        tight = tight && (v == 0 || result.distances[v] ==
+                                        std::numeric_limits<int>::max());
+        continue;
+      }
+      bool found = false;
+      random_graph.for_each_out_edge(p, [&](int to, int w) {
+        found = found ||
+                (to == v && result.distances[p] + w == result.distances[v]);
+      });
+      tight = tight && found;
+    }
+    std::cout << "Δ = " << (delta == 0 ? "自动" : std::to_string(delta))
+              << "：距离与Dijkstra一致: "
+              << (result.distances == reference.distances ? "是" : "否")
+              << "，前驱都是紧边: " << (tight ? "是" : "否") << std::endl;
+  }
+
+  std::cout << std::endl;
+}
+
+// 点对点查询测试：双向Dijkstra、A*与ALT与完整Dijkstra对照
+void test_point_to_point() {
+  std::cout << "=== 测试点对点最短路径查询 ===" << std::endl;
+
+  // 60 × 60 网格，双向道路权重不同，另加少量单向"快速路"
+  const int side = 60, n = side * side;
+  std::mt19937 gen(2458);
+  std::uniform_int_distribution<int> weight(10, 100), node(0, n - 1);
+  CSRGraphBuilder builder(true);
+  for (int i = 0; i < n; i++) {
+    builder.add_node(i);
+  }
+  for (int r = 0; r < side; r++) {
+    for (int c = 0; c < side; c++) {
+      int u = r * side + c;
+      if (c + 1 < side) {
+        builder.add_edge(u, u + 1, weight(gen));
+        builder.add_edge(u + 1, u, weight(gen));
+      }
+      if (r + 1 < side) {
+        builder.add_edge(u, u + side, weight(gen));
+        builder.add_edge(u + side, u, weight(gen));
+      }
+    }
+  }
+  for (int e = 0; e < 50; e++) {
+    builder.add_edge(node(gen), node(gen), 5 * weight(gen));
+  }
+  CSRGraph graph = builder.build();
+
+  PointToPointSearch search(graph);
+  search.build_landmarks(8);
+  std::cout << "地标: ";
+  for (int landmark : search.get_landmarks()) {
+    std::cout << landmark << " ";
+  }
+  std::cout << std::endl;
+
+  // 路径必须由图中的边组成，且权重之和等于报告的距离
+  auto path_weight = [&](const std::vector<int> &path) {
+    long long total = 0;
+    for (size_t k = 0; k + 1 < path.size(); k++) {
+      int best = std::numeric_limits<int>::max();
+      graph.for_each_out_edge(path[k], [&](int v, int w) {
+        if (v == path[k + 1]) {
+          best = std::min(best, w);
+        }
+      });
+      if (best == std::numeric_limits<int>::max()) {
+        return -1LL;
+      }
+      total += best;
+    }
+    return total;
+  };
+
+  bool same = true;
+  size_t settled[4] = {0, 0, 0, 0};
+  for (int q = 0; q < 200; q++) {
+    int s = node(gen), t = node(gen);
+    int expected = Dijkstra::find_shortest_path(graph, s).distances[t];
+    PathQueryResult results[4] = {search.dijkstra(s, t),
+                                  search.bidirectional_dijkstra(s, t),
+                                  search.astar(s, t, [](int) { return 0; }),
+                                  search.alt(s, t)};
+    for (int k = 0; k < 4; k++) {
+      same = same && results[k].distance == expected &&
+             results[k].path.front() == s && results[k].path.back() == t &&
+             path_weight(results[k].path) == expected;
+      settled[k] += results[k].settled;
+    }
+  }
+  std::cout << "200次查询与完整Dijkstra一致且路径有效: " << (same ? "是" : "否")
+            << std::endl;
+  std::cout << "平均出堆节点数  单向: " << settled[0] / 200
+            << "  双向: " << settled[1] / 200 << "  ALT: " << settled[3] / 200
+            << "（共 " << n << " 个节点）" << std::endl;
+
+  // 不可达与源点等于终点
+  CSRGraphBuilder small(true);
+  for (int i = 0; i < 3; i++) {
+    small.add_node(i);
+  }
+  small.add_edge(0, 1, 4);
+  PointToPointSearch small_search(small.build());
+  small_search.build_landmarks(2);
+  bool edge_ok =
+      small_search.bidirectional_dijkstra(0, 2).path.empty() &&
+      small_search.alt(0, 2).distance == std::numeric_limits<int>::max() &&
+      small_search.alt(1, 0).path.empty() &&
+      small_search.bidirectional_dijkstra(2, 2).distance == 0 &&
+      small_search.alt(0, 1).distance == 4;
+  std::cout << "不可达与源点即终点的边界情况: " << (edge_ok ? "是" : "否")
+            << std::endl;
+
+  std::cout << std::endl;
+}
+
+// 收缩层次测试：串行与并行预处理、查询与完整Dijkstra对照、序列化往返
+void test_contraction_hierarchies() {
+  std::cout << "=== 测试收缩层次 ===" << std::endl;
+
+  // 50 × 50 网格，两个方向权重不同，另加少量单向长边
+  const int side = 50, n = side * side;
+  std::mt19937 gen(2459);
+  std::uniform_int_distribution<int> weight(10, 100), node(0, n - 1);
+  CSRGraphBuilder builder(true);
+  for (int i = 0; i < n; i++) {
+    builder.add_node(i);
+  }
+  for (int r = 0; r < side; r++) {
+    for (int c = 0; c < side; c++) {
+      int u = r * side + c;
+      if (c + 1 < side) {
+        builder.add_edge(u, u + 1, weight(gen));
+        builder.add_edge(u + 1, u, weight(gen));
+      }
+      if (r + 1 < side) {
+        builder.add_edge(u, u + side, weight(gen));
+        builder.add_edge(u + side, u, weight(gen));
+      }
+    }
+  }
+  for (int e = 0; e < 40; e++) {
+    builder.add_edge(node(gen), node(gen), 5 * weight(gen));
+  }
+  CSRGraph graph = builder.build();
+
+  ContractionHierarchy serial = ContractionHierarchy::build(graph);
+  WorkStealingScheduler scheduler(4);
+  ContractionHierarchy parallel = ContractionHierarchy::build(graph, scheduler);
+  std::cout << "原图边数 " << graph.get_edge_count() << "，向上边 "
+            << serial.get_up_edge_count() << "，向下边 "
+            << serial.get_down_edge_count() << std::endl;
+  std::cout << "串行与并行预处理结果逐字节相同: "
+            << (serial.size_bytes() == parallel.size_bytes() &&
+                        std::memcmp(serial.data(), parallel.data(),
+                                    serial.size_bytes()) == 0
+                    ? "是"
+                    : "否")
+            << std::endl;
+
+  // 序列化后从8字节对齐的缓冲区零拷贝加载
+  std::ostringstream out;
+  parallel.save(out);
+  std::string bytes = out.str();
+  std::vector<std::uint64_t> buffer(bytes.size() / sizeof(std::uint64_t));
+  std::memcpy(buffer.data(), bytes.data(), bytes.size());
+  ContractionHierarchy loaded = ContractionHierarchy::load(
+      buffer.data(), buffer.size() * sizeof(std::uint64_t));
+
+  auto path_weight = [&](const std::vector<int> &path) {
+    long long total = 0;
+    for (size_t k = 0; k + 1 < path.size(); k++) {
+      int best = std::numeric_limits<int>::max();
+      graph.for_each_out_edge(path[k], [&](int v, int w) {
+        if (v == path[k + 1]) {
+          best = std::min(best, w);
+        }
+      });
+      if (best == std::numeric_limits<int>::max()) {
+        return -1LL;
+      }
+      total += best;
+    }
+    return total;
+  };
+
+  ContractionHierarchyQuery serial_query(serial), loaded_query(loaded);
+  bool same = true;
+  size_t settled = 0;
+  for (int q = 0; q < 200; q++) {
+    int s = node(gen), t = node(gen);
+    int expected = Dijkstra::find_shortest_path(graph, s).distances[t];
+    PathQueryResult a = serial_query.query(s, t);
+    PathQueryResult b = loaded_query.query(s, t);
+    same = same && a.distance == expected && b.distance == expected &&
+           a.path.front() == s && a.path.back() == t &&
+           path_weight(a.path) == expected && b.path == a.path &&
+           loaded_query.query(s, t, false).distance == expected;
+    settled += a.settled;
+  }
+  std::cout << "200次查询与完整Dijkstra一致、路径有效、加载后结果相同: "
+            << (same ? "是" : "否") << std::endl;
+  std::cout << "平均出堆节点数: " << settled / 200 << "（共 " << n
+            << " 个节点）" << std::endl;
+
+  // 头部正确但内容损坏的缓冲区必须被拒绝。布局（以32位为单位）：
+  // 12个头部 | 秩 | 向上图的偏移 | 终点 | 权重 | 中间节点 | 向下图 ...
+  auto padded = [](size_t count) { return (count + 1) / 2 * 2; };
+  size_t ranks_at = 12, up_offsets_at = ranks_at + padded(n);
+  size_t up_targets_at = up_offsets_at + padded(n + 1);
+  size_t up_middles_at =
+      up_targets_at + 2 * padded(loaded.get_up_edge_count());
+  size_t edge = 0; // 第一条中间节点不为 -1 的向上边（捷径）
+  while (edge < loaded.get_up_edge_count() &&
+         static_cast<std::int32_t>(
+             reinterpret_cast<const std::uint32_t *>(
+                 buffer.data())[up_middles_at + edge]) == -1) {
+    edge++;
+  }
+  const std::pair<size_t, std::uint32_t> corruptions[] = {
+      {ranks_at + 1, static_cast<std::uint32_t>(n)},      // 秩越界
+      {ranks_at + 1, loaded.rank(0)},                      // 秩重复
+      {up_offsets_at + 1, 0xFFFFFFFFu},                    // 偏移不单调
+      {up_offsets_at + n, 0},                              // 偏移不以边数结束
+      {up_targets_at, static_cast<std::uint32_t>(n)},      // 终点越界
+      {up_middles_at + edge, static_cast<std::uint32_t>(n)}}; // 中间节点越界
+  int rejected = 0;
+  for (const auto &[index, value] : corruptions) {
+    std::vector<std::uint64_t> corrupted = buffer;
+    reinterpret_cast<std::uint32_t *>(corrupted.data())[index] = value;
+    try {
+      ContractionHierarchy::load(corrupted.data(),
+                                 corrupted.size() * sizeof(std::uint64_t));
+    } catch (const std::invalid_argument &) {
+      rejected++;
+    }
+  }
+  std::cout << "秩、偏移、终点、中间节点损坏的 " << std::size(corruptions)
+            << " 个缓冲区全部被拒绝: "
+            << (rejected == static_cast<int>(std::size(corruptions)) ? "是"
+                                                                     : "否")
+            << std::endl;
+
+  // 不可达
+  CSRGraphBuilder small(true);
+  for (int i = 0; i < 3; i++) {
+    small.add_node(i);
+  }
+  small.add_edge(0, 1, 4);
+  small.add_edge(1, 2, 1);
+  ContractionHierarchy small_hierarchy =
+      ContractionHierarchy::build(small.build());
+  ContractionHierarchyQuery small_query(small_hierarchy);
+  bool edge_ok = small_query.query(2, 0).path.empty() &&
+                 small_query.query(0, 2).distance == 5 &&
+                 small_query.query(1, 1).distance == 0;
+  std::cout << "不可达与源点即终点的边界情况: " << (edge_ok ? "是" : "否")
+            << std::endl;
+
+  std::cout << std::endl;
+}
+
 // 性能比较测试
 void test_performance_comparison() {
   std::cout << "=== 性能比较测试 ===" << std::endl;
@@ -296,6 +637,9 @@ int main() {
   test_clrs_examples();
   test_edge_cases();
   test_performance_comparison();
+  test_spfa_and_delta_stepping();
+  test_point_to_point();
+  test_contraction_hierarchies();
 
   std::cout << "所有测试完成!" << std::endl;
 
@@ -0,0 +1,97 @@
+#include "graph_representation.h"
+#include "shortest_path.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+void report(const std::string &name, double ms, bool same) {
+  std::cout << "  " << std::left << std::setw(26) << name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(10) << ms
+            << " ms  结果一致: " << (same ? "是" : "否") << std::endl;
+}
+
+/**
+ * @brief 平均出度 degree 的随机有向图，先连一条链保证从0全部可达
+ * @param potential 非空时按势函数重新加权，产生负权边但没有负权环
+ */
+CSRGraph generate_graph(int n, int degree, int max_weight,
+                        const std::vector<int> &potential) {
+  std::mt19937 gen(24);
+  std::uniform_int_distribution<int> node(0, n - 1), weight(0, max_weight);
+  CSRGraphBuilder builder(true);
+  for (int i = 0; i < n; i++)
+    builder.add_node(i);
+  auto add = [&](int u, int v) {
+    int w = weight(gen);
+    if (!potential.empty())
+      w += potential[u] - potential[v];
+    builder.add_edge(u, v, w);
+  };
+  for (int i = 0; i + 1 < n; i++)
+    add(i, i + 1);
+  for (long long e = n - 1; e < static_cast<long long>(degree) * n; e++)
+    add(node(gen), node(gen));
+  return builder.build();
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: sssp_benchmark [节点数] [线程数]
+  int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  size_t threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10)
+                            : std::thread::hardware_concurrency();
+  WorkStealingScheduler scheduler(threads == 0 ? 1 : threads);
+
+  // 含负权边：Bellman-Ford（提前结束）与SPFA
+  {
+    int m = n / 10;
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> h(0, 250);
+    std::vector<int> potential(m);
+    for (int &p : potential)
+      p = h(gen);
+    CSRGraph graph = generate_graph(m, 8, 1000, potential);
+    std::cout << "负权图：节点数 " << m << "，边数 " << graph.get_edge_count()
+              << std::endl;
+    ShortestPathResult bellman(0), spfa(0);
+    double ms = time_ms(
+        [&] { bellman = BellmanFord::find_shortest_path(graph, 0); });
+    report("Bellman-Ford", ms, true);
+    ms = time_ms([&] { spfa = SPFA::find_shortest_path(graph, 0); });
+    report("SPFA", ms, spfa.distances == bellman.distances);
+  }
+
+  // 非负权图：Dijkstra与不同Δ的Δ-步进
+  CSRGraph graph = generate_graph(n, 8, 1000, {});
+  std::cout << "非负权图：节点数 " << n << "，边数 " << graph.get_edge_count()
+            << "，线程 " << scheduler.get_num_threads() << std::endl;
+  ShortestPathResult reference(0);
+  double ms = time_ms([&] {
+    reference = Dijkstra::find_shortest_path<RadixHeapDijkstraQueue>(graph, 0);
+  });
+  report("Dijkstra（基数堆）", ms, true);
+  for (int delta : {10, 0, 500, 2000}) {
+    ShortestPathResult result(0);
+    ms = time_ms([&] {
+      result = DeltaStepping::find_shortest_path(graph, 0, scheduler, delta);
+    });
+    report("Δ-步进 Δ=" + (delta == 0 ? std::string("自动")
+                                     : std::to_string(delta)),
+           ms, result.distances == reference.distances);
+  }
+  return 0;
+}
@@ -0,0 +1,108 @@
+#include "all_pairs_shortest_path.h"
+#include "graph_representation.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+void report(const char *name, double ms, size_t n) {
+  double relaxations = static_cast<double>(n) * n * n;
+  std::cout << "  " << std::left << std::setw(30) << name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(10) << ms
+            << " ms" << std::setw(10) << std::setprecision(2)
+            << relaxations / ms / 1e6 << " G次松弛/s" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: all_pairs_shortest_path_benchmark [最大节点数] [线程数]
+  size_t max_n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2048;
+  size_t threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10)
+                            : std::thread::hardware_concurrency();
+  WorkStealingScheduler scheduler(threads == 0 ? 1 : threads);
+
+  std::mt19937 gen(25);
+  for (size_t n = 512; n <= max_n; n *= 2) {
+    // 平均出度16的随机有向图，含负权边但没有负权环（按势函数重新加权）
+    std::uniform_int_distribution<int> node(0, static_cast<int>(n) - 1);
+    std::uniform_int_distribution<int> weight(1, 1000);
+    std::vector<int> potential(n);
+    for (int &h : potential)
+      h = weight(gen) / 4;
+    std::vector<GraphEdge> edges;
+    for (size_t e = 0; e < 16 * n; e++) {
+      int u = node(gen), v = node(gen);
+      if (u != v)
+        edges.emplace_back(u, v, weight(gen) + potential[u] - potential[v]);
+    }
+    AdjacencyListGraph graph(true);
+    graph.reserve(n);
+    for (size_t i = 0; i < n; i++)
+      graph.add_node(static_cast<int>(i));
+    graph.add_edges(edges);
+    std::cout << "n = " << n << "，边数 " << edges.size() << "，线程 "
+              << scheduler.get_num_threads() << std::endl;
+
+    AllPairsShortestPathResult reference(0);
+    if (n <= 2048) {
+      double ms = time_ms([&] {
+        reference = FloydWarshall::textbook_all_pairs_shortest_path(graph);
+      });
+      report("教科书三重循环（嵌套vector）", ms, n);
+    }
+
+    DenseAllPairsResult blocked;
+    double ms = time_ms([&] { blocked = BlockedFloydWarshall::solve(graph); });
+    report("分块（含前驱）", ms, n);
+    ms = time_ms(
+        [&] { blocked = BlockedFloydWarshall::solve(graph, false); });
+    report("分块（仅距离）", ms, n);
+    ms = time_ms([&] {
+      blocked = BlockedFloydWarshall::solve(graph, true, &scheduler);
+    });
+    report("分块并行（含前驱）", ms, n);
+
+    if (n <= 1024) {
+      AllPairsShortestPathResult slow(0);
+      ms = time_ms([&] {
+        slow = MatrixMultiplicationShortestPath::find_all_pairs_shortest_path(
+            graph);
+      });
+      report("矩阵方法（逐次，嵌套vector）", ms, n);
+    }
+    DenseAllPairsResult squared;
+    ms = time_ms([&] {
+      squared = MatrixMultiplicationShortestPath::repeated_squaring(graph);
+    });
+    report("重复平方（含前驱）", ms, n);
+    ms = time_ms([&] {
+      squared = MatrixMultiplicationShortestPath::repeated_squaring(
+          graph, true, &scheduler);
+    });
+    report("重复平方并行（含前驱）", ms, n);
+    std::cout << "  重复平方与Floyd-Warshall一致："
+              << (squared.distances == blocked.distances ? "是" : "否")
+              << std::endl;
+
+    if (!reference.distances.empty()) {
+      bool same = true;
+      for (size_t i = 0; i < n && same; i++)
+        for (size_t j = 0; j < n && same; j++)
+          same = reference.distances[i][j] == blocked.distance(i, j);
+      std::cout << "  与教科书版本一致：" << (same ? "是" : "否") << std::endl;
+    }
+  }
+  return 0;
+}
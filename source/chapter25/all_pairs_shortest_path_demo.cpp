@@ -1,6 +1,11 @@
 #include "all_pairs_shortest_path.h"
 #include "graph_representation.h"
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -48,6 +53,14 @@ void test_matrix_multiplication() {
     result.print_path(4, 0);
   }
 
+  // 重复平方法：⌈lg n⌉ 次 min-plus 平方
+  auto faster =
+      MatrixMultiplicationShortestPath::faster_all_pairs_shortest_path(graph);
+  std::cout << "\n重复平方法与逐次扩展结果一致: "
+            << (faster.distances == result.distances ? "是" : "否")
+            << std::endl;
+  faster.print_path(0, 3);
+
   std::cout << std::endl;
 }
 
@@ -192,6 +205,90 @@ void test_negative_cycle() {
   std::cout << std::endl;
 }
 
+// 并行与流式Johnson：逐行输出，不保存 n × n 结果
+void test_parallel_johnson() {
+  std::cout << "=== 测试并行与流式Johnson算法 ===" << std::endl;
+
+  // 平均出度4的随机稀疏图，含负权边但没有负权环
+  const int n = 2000;
+  std::mt19937 gen(253);
+  std::uniform_int_distribution<int> node(0, n - 1), weight(1, 100);
+  std::vector<int> potential(n);
+  for (int &h : potential) {
+    h = weight(gen);
+  }
+  CSRGraphBuilder builder(true);
+  for (int i = 0; i < n; i++) {
+    builder.add_node(i);
+  }
+  for (int e = 0; e < 4 * n; e++) {
+    int u = node(gen), v = node(gen);
+    builder.add_edge(u, v, weight(gen) + potential[u] - potential[v]);
+  }
+  CSRGraph graph = builder.build();
+
+  // 每行只保留可达节点数与距离之和
+  std::vector<long long> serial_sum(n), parallel_sum(n);
+  std::vector<int> serial_reached(n), parallel_reached(n);
+  auto summarize = [n](std::vector<long long> &sums,
+                       std::vector<int> &reached) {
+    return [n, &sums, &reached](int source, const std::vector<int> &dist,
+                                const std::vector<int> &) {
+      for (int j = 0; j < n; j++) {
+        if (dist[j] != std::numeric_limits<int>::max()) {
+          sums[source] += dist[j];
+          reached[source]++;
+        }
+      }
+    };
+  };
+  bool ok = Johnson::for_each_source(graph,
+                                     summarize(serial_sum, serial_reached));
+
+  WorkStealingScheduler scheduler(4);
+  ok = Johnson::for_each_source(graph, scheduler,
+                                summarize(parallel_sum, parallel_reached)) &&
+       ok;
+  std::cout << "节点数 " << n << "，边数 " << graph.get_edge_count()
+            << "，无负权环: " << (ok ? "是" : "否") << std::endl;
+  std::cout << "串行与并行逐行结果一致: "
+            << (serial_sum == parallel_sum &&
+                        serial_reached == parallel_reached
+                    ? "是"
+                    : "否")
+            << std::endl;
+
+  // 完整结果与Floyd-Warshall对照（取前200行）
+  auto full = Johnson::find_all_pairs_shortest_path(graph, scheduler);
+  DenseAllPairsResult reference = BlockedFloydWarshall::solve(graph, false);
+  bool same = true;
+  for (int i = 0; i < 200; i++) {
+    for (int j = 0; j < n; j++) {
+      same = same && full.distances[i][j] == reference.distance(i, j);
+    }
+  }
+  std::cout << "与Floyd-Warshall距离一致: " << (same ? "是" : "否")
+            << std::endl;
+
+  // 负权环：不输出任何行
+  CSRGraphBuilder cycle_builder(true);
+  for (int i = 0; i < 3; i++) {
+    cycle_builder.add_node(i);
+  }
+  cycle_builder.add_edge(0, 1, 1);
+  cycle_builder.add_edge(1, 2, -3);
+  cycle_builder.add_edge(2, 0, 1);
+  int rows = 0;
+  bool no_cycle =
+      Johnson::for_each_source(cycle_builder.build(), scheduler,
+                               [&](int, const std::vector<int> &,
+                                   const std::vector<int> &) { rows++; });
+  std::cout << "负权环被检测且未输出结果行: "
+            << (!no_cycle && rows == 0 ? "是" : "否") << std::endl;
+
+  std::cout << std::endl;
+}
+
 // 稀疏图测试（Johnson算法优势场景）
 void test_sparse_graph() {
   std::cout << "=== 测试稀疏图（Johnson算法优势场景） ===" << std::endl;
@@ -232,6 +329,171 @@ void test_sparse_graph() {
   std::cout << std::endl;
 }
 
+// 分块Floyd-Warshall测试：与教科书版本、Johnson算法对照
+void test_blocked_floyd_warshall() {
+  std::cout << "=== 测试分块Floyd-Warshall ===" << std::endl;
+
+  // 节点数不是块大小的整数倍，含负权边但没有负权环
+  const int n = 300;
+  std::mt19937 gen(25);
+  std::uniform_int_distribution<int> node(0, n - 1), weight(1, 100);
+  std::vector<int> potential(n);
+  for (int &h : potential) {
+    h = weight(gen);
+  }
+  AdjacencyListGraph graph(true);
+  for (int i = 0; i < n; i++) {
+    graph.add_node(i);
+  }
+  std::vector<GraphEdge> edges;
+  for (int e = 0; e < 8 * n; e++) {
+    int u = node(gen), v = node(gen);
+    if (u != v) {
+      edges.emplace_back(u, v, weight(gen) + potential[u] - potential[v]);
+    }
+  }
+  graph.add_edges(edges);
+
+  auto textbook = FloydWarshall::textbook_all_pairs_shortest_path(graph);
+  auto blocked = FloydWarshall::find_all_pairs_shortest_path(graph);
+  WorkStealingScheduler scheduler(4);
+  auto parallel = FloydWarshall::find_all_pairs_shortest_path(graph, scheduler);
+  auto johnson = Johnson::find_all_pairs_shortest_path(graph);
+
+  // 等长最短路径不止一条时，分块版本的松弛顺序不同，选出的前驱可能
+  // 与教科书版本不同；检查每条前驱路径的权重之和等于距离
+  std::vector<GraphEdge> graph_edges = graph.get_all_edges();
+  std::vector<int> weight_of(n * n, 0);
+  for (const auto &edge : graph_edges) {
+    weight_of[edge.from * n + edge.to] = edge.weight;
+  }
+  bool paths_valid = true;
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      if (i == j ||
+          blocked.distances[i][j] == BlockedFloydWarshall::kInfinity) {
+        continue;
+      }
+      long long length = 0;
+      int current = j;
+      for (int steps = 0; current != i && current != -1 && steps < n;
+           steps++) {
+        int previous = blocked.predecessors[i][current];
+        if (previous != -1) {
+          length += weight_of[previous * n + current];
+        }
+        current = previous;
+      }
+      paths_valid = paths_valid && current == i &&
+                    length == blocked.distances[i][j];
+    }
+  }
+
+  std::cout << n << " 个节点，" << graph_edges.size() << " 条边" << std::endl;
+  std::cout << "分块与教科书版本距离一致: "
+            << (blocked.distances == textbook.distances ? "是" : "否")
+            << std::endl;
+  std::cout << "前驱矩阵给出的路径都是最短路径: "
+            << (paths_valid ? "是" : "否") << std::endl;
+  std::cout << "并行与串行分块一致: "
+            << (parallel.distances == blocked.distances ? "是" : "否")
+            << std::endl;
+  auto squared =
+      MatrixMultiplicationShortestPath::faster_all_pairs_shortest_path(
+          graph, scheduler);
+  std::cout << "重复平方法距离一致: "
+            << (squared.distances == blocked.distances ? "是" : "否")
+            << std::endl;
+  std::cout << "与Johnson算法距离一致: "
+            << (johnson.distances == blocked.distances ? "是" : "否")
+            << std::endl;
+  blocked.print_path(0, n - 1);
+
+  // 饱和加法：不可达吸收，溢出截断而不回绕
+  AdjacencyListGraph far(true);
+  for (int i = 0; i < 3; i++) {
+    far.add_node(i);
+  }
+  far.add_edge(0, 1, 2000000000);
+  far.add_edge(1, 2, 2000000000);
+  DenseAllPairsResult saturated = BlockedFloydWarshall::solve(far);
+  std::cout << "0 -> 2 的距离超出int范围，按不可达处理: "
+            << (saturated.distance(0, 2) == BlockedFloydWarshall::kInfinity
+                    ? "是"
+                    : "否")
+            << std::endl;
+
+  std::cout << std::endl;
+}
+
+// 零权环且节点数超过块大小：前驱链必须在 n 步内回到源点
+void test_zero_weight_cycles() {
+  std::cout << "=== 测试零权环下的前驱矩阵 ===" << std::endl;
+
+  const int n = static_cast<int>(BlockedFloydWarshall::kTile) + 72;
+  std::mt19937 gen(54);
+  std::uniform_int_distribution<int> node(0, n - 1), weight(0, 3);
+  AdjacencyListGraph graph(false);
+  for (int i = 0; i < n; i++) {
+    graph.add_node(i);
+  }
+  // 跨块的零权环把两个块的节点连在一起，再加随机边（约一半权重为0）
+  for (int i = 0; i < n; i++) {
+    graph.add_edge(i, (i + 131) % n, 0);
+  }
+  std::vector<int> weight_of(n * n, -1);
+  for (const auto &edge : graph.get_all_edges()) {
+    weight_of[edge.from * n + edge.to] = weight_of[edge.to * n + edge.from] =
+        edge.weight;
+  }
+  for (int e = 0; e < 3 * n; e++) {
+    int u = node(gen), v = node(gen), w = std::max(0, weight(gen) - 1);
+    if (u != v && weight_of[u * n + v] == -1) {
+      graph.add_edge(u, v, w);
+      weight_of[u * n + v] = weight_of[v * n + u] = w;
+    }
+  }
+
+  auto textbook = FloydWarshall::textbook_all_pairs_shortest_path(graph);
+  WorkStealingScheduler scheduler(4);
+  auto check = [&](const AllPairsShortestPathResult &result,
+                   const char *name) {
+    if (result.distances != textbook.distances) {
+      throw std::runtime_error(std::string(name) + "距离与教科书版本不一致");
+    }
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        if (i == j || result.distances[i][j] == BlockedFloydWarshall::kInfinity) {
+          continue;
+        }
+        long long length = 0;
+        int current = j, steps = 0;
+        for (; current != i && current != -1 && steps < n; steps++) {
+          int previous = result.predecessors[i][current];
+          if (previous != -1) {
+            length += weight_of[previous * n + current];
+          }
+          current = previous;
+        }
+        if (current != i || length != result.distances[i][j]) {
+          throw std::runtime_error(std::string(name) + "前驱链不是最短路径: " +
+                                   std::to_string(i) + " -> " +
+                                   std::to_string(j));
+        }
+      }
+    }
+    std::cout << name << "的前驱链都在 " << n << " 步内回到源点" << std::endl;
+  };
+  check(FloydWarshall::find_all_pairs_shortest_path(graph), "分块串行");
+  check(FloydWarshall::find_all_pairs_shortest_path(graph, scheduler),
+        "分块并行");
+  check(MatrixMultiplicationShortestPath::faster_all_pairs_shortest_path(
+            graph, scheduler),
+        "重复平方法");
+
+  std::cout << std::endl;
+}
+
 // 边界情况测试
 void test_edge_cases() {
   std::cout << "=== 边界情况测试 ===" << std::endl;
@@ -275,6 +537,9 @@ int main() {
   test_johnson();
   test_negative_cycle();
   test_sparse_graph();
+  test_parallel_johnson();
+  test_blocked_floyd_warshall();
+  test_zero_weight_cycles();
   test_edge_cases();
 
   std::cout << "所有测试完成!" << std::endl;
@@ -0,0 +1,93 @@
+#include "all_pairs_shortest_path.h"
+#include "graph_representation.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+void report(const char *name, double ms, size_t sources, long long checksum) {
+  std::cout << "  " << std::left << std::setw(28) << name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(10) << ms
+            << " ms" << std::setw(10) << std::setprecision(3)
+            << ms / sources << " ms/源点  校验和 " << checksum << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: johnson_benchmark [最大节点数] [线程数]
+  size_t max_n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4096;
+  size_t threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10)
+                            : std::thread::hardware_concurrency();
+  WorkStealingScheduler scheduler(threads == 0 ? 1 : threads);
+
+  std::mt19937 gen(253);
+  for (size_t n = 1024; n <= max_n; n *= 4) {
+    // 平均出度8的随机有向图，含负权边但没有负权环（按势函数重新加权）
+    std::uniform_int_distribution<int> node(0, static_cast<int>(n) - 1);
+    std::uniform_int_distribution<int> weight(1, 1000);
+    std::vector<int> potential(n);
+    for (int &h : potential)
+      h = weight(gen) / 4;
+    CSRGraphBuilder builder(true);
+    for (size_t i = 0; i < n; i++)
+      builder.add_node(static_cast<int>(i));
+    for (size_t e = 0; e < 8 * n; e++) {
+      int u = node(gen), v = node(gen);
+      builder.add_edge(u, v, weight(gen) + potential[u] - potential[v]);
+    }
+    CSRGraph graph = builder.build();
+    std::cout << "n = " << n << "，边数 " << graph.get_edge_count()
+              << "，线程 " << scheduler.get_num_threads() << "，完整结果 "
+              << std::setprecision(1) << std::fixed
+              << 2.0 * n * n * sizeof(int) / (1 << 20) << " MiB" << std::endl;
+
+    // 每个源点的距离之和累加为校验和，各行只在 sink 中短暂存在
+    std::vector<long long> row_sum(n);
+    auto sink = [&](int source, const std::vector<int> &dist,
+                    const std::vector<int> &) {
+      long long sum = 0;
+      for (int d : dist)
+        if (d != std::numeric_limits<int>::max())
+          sum += d;
+      row_sum[source] = sum;
+    };
+    auto checksum = [&] {
+      long long total = 0;
+      for (long long v : row_sum)
+        total += v;
+      return total;
+    };
+
+    if (n <= 4096) {
+      AllPairsShortestPathResult full(0);
+      double ms = time_ms(
+          [&] { full = Johnson::find_all_pairs_shortest_path(graph); });
+      long long total = 0;
+      for (const auto &row : full.distances)
+        for (int d : row)
+          if (d != std::numeric_limits<int>::max())
+            total += d;
+      report("完整 n × n 结果（串行）", ms, n, total);
+    }
+
+    double ms = time_ms([&] { Johnson::for_each_source(graph, sink); });
+    report("流式逐行（串行）", ms, n, checksum());
+    ms = time_ms(
+        [&] { Johnson::for_each_source(graph, scheduler, sink); });
+    report("流式逐行（并行）", ms, n, checksum());
+  }
+  return 0;
+}
@@ -1,5 +1,8 @@
 #include "max_flow.h"
+#include <chrono>
 #include <iostream>
+#include <random>
+#include <sstream>
 #include <vector>
 
 using namespace algorithms;
@@ -72,6 +75,82 @@ void test_bipartite_matching() {
   std::cout << std::endl;
 }
 
+void test_hopcroft_karp() {
+  std::cout << "=== Hopcroft-Karp二分匹配测试 ===" << std::endl;
+
+  // 测试1：与二分图匹配测试2相同的图，最大匹配为4
+  BipartiteGraph clrs(5, 4,
+                      {{0, 0}, {0, 1}, {1, 2}, {2, 1}, {3, 2}, {3, 3}, {4, 3}});
+  auto result = BipartiteMatching::hopcroft_karp(clrs);
+  std::cout << "测试1: 最大匹配 = " << result.matching_size
+            << (result.matching_size == 4 ? " (正确)" : " (错误)")
+            << "，匹配: ";
+  for (int u = 0; u < clrs.left_size; u++) {
+    if (result.match_left[u] != -1) {
+      std::cout << "(" << u << ", " << result.match_left[u] << ") ";
+    }
+  }
+  std::cout << std::endl;
+
+  // 测试2：随机二分图与Ford-Fulkerson归约结果一致，且匹配合法
+  std::mt19937 gen(13);
+  bool all_match = true, all_valid = true;
+  for (int trial = 0; trial < 30; trial++) {
+    int left = 8 + trial % 5, right = 6 + trial % 7;
+    std::vector<std::vector<int>> matrix(left, std::vector<int>(right, 0));
+    std::vector<std::pair<int, int>> edges;
+    for (int u = 0; u < left; u++) {
+      for (int v = 0; v < right; v++) {
+        if (gen() % 4 == 0) {
+          matrix[u][v] = 1;
+          edges.emplace_back(u, v);
+        }
+      }
+    }
+    BipartiteGraph graph(left, right, edges);
+    auto hk = BipartiteMatching::hopcroft_karp(graph);
+    all_match = all_match && hk.matching_size ==
+                                 BipartiteMatching::find_max_matching(
+                                     matrix, left, right);
+    int counted = 0;
+    for (int u = 0; u < left; u++) {
+      int v = hk.match_left[u];
+      if (v == -1)
+        continue;
+      counted++;
+      all_valid = all_valid && matrix[u][v] == 1 && hk.match_right[v] == u;
+    }
+    all_valid = all_valid && counted == hk.matching_size;
+  }
+  std::cout << "测试2: 30个随机二分图与Ford-Fulkerson结果一致: "
+            << (all_match ? "是" : "否")
+            << "，匹配合法: " << (all_valid ? "是" : "否") << std::endl;
+
+  // 测试3：大规模稀疏二分图（工人-任务分配）
+  const int workers = 200000, tasks = 200000, degree = 3;
+  std::vector<std::pair<int, int>> edges;
+  edges.reserve(static_cast<size_t>(workers) * degree);
+  std::uniform_int_distribution<int> task_dis(0, tasks - 1);
+  for (int u = 0; u < workers; u++) {
+    for (int k = 0; k < degree; k++) {
+      edges.emplace_back(u, task_dis(gen));
+    }
+  }
+  BipartiteGraph large(workers, tasks, edges);
+  auto start = std::chrono::high_resolution_clock::now();
+  auto large_result = BipartiteMatching::hopcroft_karp(large);
+  auto end = std::chrono::high_resolution_clock::now();
+  std::cout << "测试3: " << workers << "个工人、" << tasks << "个任务、"
+            << large.get_edge_count()
+            << "条边 最大匹配 = " << large_result.matching_size << "，时间: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(end -
+                                                                     start)
+                   .count()
+            << " ms" << std::endl;
+
+  std::cout << std::endl;
+}
+
 void test_push_relabel() {
   std::cout << "=== 推送-重贴标签算法测试 ===" << std::endl;
 
@@ -150,6 +229,175 @@ void test_edge_cases() {
   std::cout << std::endl;
 }
 
+void test_dinic() {
+  std::cout << "=== Dinic算法测试（稀疏残量网络） ===" << std::endl;
+
+  // 测试1：算法导论图26.6，最大流23
+  ResidualGraph graph(6);
+  graph.add_edge(0, 1, 16);
+  graph.add_edge(0, 2, 13);
+  graph.add_edge(1, 3, 12);
+  graph.add_edge(2, 1, 4);
+  graph.add_edge(2, 4, 14);
+  graph.add_edge(3, 2, 9);
+  graph.add_edge(3, 5, 20);
+  graph.add_edge(4, 3, 7);
+  graph.add_edge(4, 5, 4);
+  long long flow = Dinic::max_flow(graph, 0, 5);
+  std::cout << "测试1: 算法导论图26.6 最大流 = " << flow
+            << (flow == 23 ? " (正确)" : " (错误)") << std::endl;
+  std::cout << "各边流量: ";
+  for (size_t e = 0; e < graph.get_arc_count(); e += 2) {
+    int arc = static_cast<int>(e);
+    std::cout << graph.get_tail(arc) << "->" << graph.get_head(arc) << ":"
+              << graph.get_flow(arc) << "/" << graph.get_capacity(arc) << " ";
+  }
+  std::cout << std::endl;
+
+  // 测试2：随机稠密网络上与Ford-Fulkerson对比
+  std::mt19937 gen(26);
+  bool all_match = true;
+  for (int trial = 0; trial < 20; trial++) {
+    int n = 12;
+    FlowNetwork network(n, 0, n - 1);
+    std::uniform_int_distribution<int> cap_dis(0, 20);
+    for (int u = 0; u < n; u++) {
+      for (int v = 0; v < n; v++) {
+        if (u != v && gen() % 3 == 0) {
+          network.add_edge(u, v, cap_dis(gen));
+        }
+      }
+    }
+    auto ff = FordFulkerson::compute_max_flow(network);
+    auto dinic = Dinic::compute_max_flow(network);
+    all_match = all_match && ff.max_flow_value == dinic.max_flow_value;
+  }
+  std::cout << "测试2: 20个随机网络与Ford-Fulkerson结果一致: "
+            << (all_match ? "是" : "否") << std::endl;
+
+  // 测试3：大规模稀疏网络（稠密矩阵表示放不下）
+  const int node_count = 200000;
+  const int out_degree = 5;
+  ResidualGraph large(node_count);
+  large.reserve_edges(static_cast<size_t>(node_count) * out_degree);
+  std::uniform_int_distribution<int> cap_dis(1, 100);
+  std::uniform_int_distribution<int> step_dis(1, 1000);
+  for (int u = 0; u < node_count - 1; u++) {
+    for (int k = 0; k < out_degree; k++) {
+      int v = std::min(node_count - 1, u + step_dis(gen));
+      large.add_edge(u, v, cap_dis(gen));
+    }
+  }
+  auto start = std::chrono::high_resolution_clock::now();
+  long long large_flow = Dinic::max_flow(large, 0, node_count - 1);
+  auto end = std::chrono::high_resolution_clock::now();
+  std::cout << "测试3: " << node_count << "个节点、" << large.get_edge_count()
+            << "条边的网络 最大流 = " << large_flow << "，流值校验: "
+            << (large.flow_value(0) == large_flow ? "通过" : "失败")
+            << "，时间: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(end -
+                                                                     start)
+                   .count()
+            << " ms" << std::endl;
+
+  std::cout << std::endl;
+}
+
+// 检查流的合法性：容量约束与除源汇外的流守恒
+bool is_valid_flow(const ResidualGraph &graph, int source, int sink) {
+  std::vector<long long> balance(graph.get_node_count(), 0);
+  for (size_t e = 0; e < graph.get_arc_count(); e += 2) {
+    int arc = static_cast<int>(e);
+    long long f = graph.get_flow(arc);
+    if (f < 0 || f > graph.get_capacity(arc))
+      return false;
+    balance[graph.get_tail(arc)] -= f;
+    balance[graph.get_head(arc)] += f;
+  }
+  for (int u = 0; u < graph.get_node_count(); u++) {
+    if (u != source && u != sink && balance[u] != 0)
+      return false;
+  }
+  return true;
+}
+
+void test_highest_label_push_relabel() {
+  std::cout << "=== 最高标号推送-重贴标签算法测试 ===" << std::endl;
+
+  // 测试1：算法导论图26.6，通过DIMACS格式读入
+  std::istringstream input("c CLRS Figure 26.6\n"
+                           "p max 6 9\n"
+                           "n 1 s\n"
+                           "n 6 t\n"
+                           "a 1 2 16\na 1 3 13\na 2 4 12\n"
+                           "a 3 2 4\na 3 5 14\na 4 3 9\n"
+                           "a 4 6 20\na 5 4 7\na 5 6 4\n");
+  DimacsFlowProblem problem = DimacsMaxFlow::read(input);
+  long long flow = HighestLabelPushRelabel::max_flow(
+      problem.graph, problem.source, problem.sink);
+  std::cout << "测试1: DIMACS读入的图26.6 最大流 = " << flow
+            << (flow == 23 ? " (正确)" : " (错误)") << "，流合法: "
+            << (is_valid_flow(problem.graph, problem.source, problem.sink)
+                    ? "是"
+                    : "否")
+            << std::endl;
+
+  // 测试2：随机网络上与Ford-Fulkerson、Dinic对比，并检查第二阶段得到合法流
+  std::mt19937 gen(12);
+  bool all_match = true, all_valid = true;
+  for (int trial = 0; trial < 50; trial++) {
+    int n = 15;
+    FlowNetwork network(n, 0, n - 1);
+    std::uniform_int_distribution<int> cap_dis(1, 30);
+    for (int u = 0; u < n; u++) {
+      for (int v = 0; v < n; v++) {
+        if (u != v && gen() % 4 == 0) {
+          network.add_edge(u, v, cap_dis(gen));
+        }
+      }
+    }
+    auto ff = FordFulkerson::compute_max_flow(network);
+    auto dinic = Dinic::compute_max_flow(network);
+    ResidualGraph graph = ResidualGraph::from_flow_network(network);
+    long long hl = HighestLabelPushRelabel::max_flow(graph, 0, n - 1);
+    all_match = all_match && ff.max_flow_value == hl &&
+                dinic.max_flow_value == hl;
+    all_valid = all_valid && is_valid_flow(graph, 0, n - 1) &&
+                graph.flow_value(0) == hl;
+  }
+  std::cout << "测试2: 50个随机网络与Ford-Fulkerson/Dinic结果一致: "
+            << (all_match ? "是" : "否")
+            << "，流合法: " << (all_valid ? "是" : "否") << std::endl;
+
+  // 测试3：DIMACS写出再读入后结果不变
+  ResidualGraph original(200);
+  std::uniform_int_distribution<int> node_dis(0, 199), cap_dis(1, 50);
+  for (int i = 0; i < 1000; i++) {
+    original.add_edge(node_dis(gen), node_dis(gen), cap_dis(gen));
+  }
+  std::ostringstream output;
+  DimacsMaxFlow::write(output, original, 0, 199);
+  std::istringstream reread(output.str());
+  DimacsFlowProblem copy = DimacsMaxFlow::read(reread);
+  long long expected = Dinic::max_flow(original, 0, 199);
+  long long actual =
+      HighestLabelPushRelabel::max_flow(copy.graph, copy.source, copy.sink);
+  std::cout << "测试3: DIMACS往返后最大流 = " << actual << "（Dinic: "
+            << expected << "）" << (actual == expected ? " (正确)" : " (错误)")
+            << std::endl;
+
+  // 测试4：非法DIMACS输入
+  try {
+    std::istringstream bad("p max 3 1\nn 1 s\na 1 x 5\n");
+    DimacsMaxFlow::read(bad);
+    std::cout << "测试4: 未检测到非法输入" << std::endl;
+  } catch (const std::invalid_argument &e) {
+    std::cout << "测试4: 正确捕获非法输入: " << e.what() << std::endl;
+  }
+
+  std::cout << std::endl;
+}
+
 void compare_algorithms() {
   std::cout << "=== 算法比较测试 ===" << std::endl;
 
@@ -171,9 +419,21 @@ void compare_algorithms() {
   auto result_pr = PushRelabel::compute_max_flow(network);
   print_max_flow_result(result_pr, 0, 3);
 
+  std::cout << "\nDinic算法结果:" << std::endl;
+  auto result_dinic = Dinic::compute_max_flow(network);
+  print_max_flow_result(result_dinic, 0, 3);
+
+  std::cout << "\n最高标号推送-重贴标签算法结果:" << std::endl;
+  auto result_hl = HighestLabelPushRelabel::compute_max_flow(network);
+  print_max_flow_result(result_hl, 0, 3);
+
   std::cout << "算法结果是否一致: "
-            << (result_ff.max_flow_value == result_pr.max_flow_value ? "是"
-                                                                     : "否")
+            << (result_ff.max_flow_value == result_pr.max_flow_value &&
+                        result_ff.max_flow_value ==
+                            result_dinic.max_flow_value &&
+                        result_ff.max_flow_value == result_hl.max_flow_value
+                    ? "是"
+                    : "否")
             << std::endl;
 
   std::cout << std::endl;
@@ -186,8 +446,11 @@ int main() {
   try {
     test_ford_fulkerson();
     test_bipartite_matching();
+    test_hopcroft_karp();
     test_push_relabel();
     test_edge_cases();
+    test_dinic();
+    test_highest_label_push_relabel();
     compare_algorithms();
 
     // 打印算法导论经典示例
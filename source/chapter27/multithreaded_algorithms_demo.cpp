@@ -1,7 +1,11 @@
 #include "multithreaded_algorithms.h"
+#include <algorithm>
 #include <chrono>
 #include <iomanip>
 #include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
 #include <random>
 #include <vector>
 
@@ -166,6 +170,17 @@ void test_quick_sort() {
   }
   std::cout << "排序正确性验证: " << (sort_correct ? "通过" : "失败")
             << std::endl;
+
+  // 超过串行阈值才会走并行样本排序：随机数据与大量重复元素各一组
+  for (int max_val : {1000000000, 15}) {
+    auto large = MultithreadedAlgorithms::generate_random_array(1000000, 0,
+                                                                max_val);
+    auto expected = large;
+    std::sort(expected.begin(), expected.end());
+    MultithreadedAlgorithms::multithreaded_quick_sort(large, 4);
+    std::cout << "1000000 个 [0, " << max_val << "] 内的整数，4线程样本排序: "
+              << (large == expected ? "通过" : "失败") << std::endl;
+  }
 }
 
 /**
@@ -217,6 +232,66 @@ void test_prefix_sum() {
             << std::endl;
 }
 
+/**
+ * @brief 测试原地并行扫描（任意结合运算）
+ */
+void test_generic_scan() {
+  std::cout << "\n=== 原地并行扫描测试 ===" << std::endl;
+
+  WorkStealingScheduler scheduler(4);
+  const size_t size = 1000003; // 不是块大小的整数倍
+
+  // 32位整数加法（AVX2块内扫描）
+  auto ints = MultithreadedAlgorithms::generate_random_array(size, -50, 50);
+  std::vector<int> expected(size);
+  std::inclusive_scan(ints.begin(), ints.end(), expected.begin());
+  std::vector<int> data = ints;
+  MultithreadedAlgorithms::parallel_inclusive_scan(scheduler, data.data(),
+                                                   data.size());
+  std::cout << "int 包含扫描(+): " << (data == expected ? "通过" : "失败")
+            << std::endl;
+
+  std::exclusive_scan(ints.begin(), ints.end(), expected.begin(), 0);
+  data = ints;
+  MultithreadedAlgorithms::parallel_exclusive_scan(scheduler, data.data(),
+                                                   data.size());
+  std::cout << "int 排除扫描(+): " << (data == expected ? "通过" : "失败")
+            << std::endl;
+
+  // 64位整数取最大值（通用路径）
+  std::vector<long long> values(ints.begin(), ints.end());
+  std::vector<long long> expected_max(size);
+  auto max_op = [](long long a, long long b) { return std::max(a, b); };
+  std::inclusive_scan(values.begin(), values.end(), expected_max.begin(),
+                      max_op);
+  MultithreadedAlgorithms::parallel_inclusive_scan(scheduler, values.data(),
+                                                   values.size(), max_op);
+  std::cout << "long long 包含扫描(max): "
+            << (values == expected_max ? "通过" : "失败") << std::endl;
+
+  // 排除扫描的单位元可自定义：模乘
+  const long long mod = 1000000007;
+  std::vector<long long> factors(size);
+  for (size_t i = 0; i < size; ++i)
+    factors[i] = static_cast<long long>(i % 97 + 1);
+  std::vector<long long> expected_prod(size);
+  auto mul_mod = [mod](long long a, long long b) { return a * b % mod; };
+  std::exclusive_scan(factors.begin(), factors.end(), expected_prod.begin(),
+                      1LL, mul_mod);
+  MultithreadedAlgorithms::parallel_exclusive_scan(
+      scheduler, factors.data(), factors.size(), 1LL, mul_mod);
+  std::cout << "long long 排除扫描(模乘): "
+            << (factors == expected_prod ? "通过" : "失败") << std::endl;
+
+  // 吞吐量
+  std::vector<int> big(20000000, 1);
+  performance_test("2e7个int原地包含扫描", [&]() {
+    MultithreadedAlgorithms::parallel_inclusive_scan(scheduler, big.data(),
+                                                     big.size());
+  });
+  std::cout << "最后一个元素: " << big.back() << std::endl;
+}
+
 /**
  * @brief 测试线程池功能
  */
@@ -270,6 +345,63 @@ void test_thread_pool() {
             << std::endl;
 }
 
+/**
+ * @brief 算法导论27.1节的P-FIB，用spawn/sync表达
+ */
+long long parallel_fib(int n) {
+  if (n < 20) {
+    return n < 2 ? n : parallel_fib(n - 1) + parallel_fib(n - 2);
+  }
+  long long x = 0;
+  WorkStealingScheduler::TaskGroup group;
+  group.spawn([&x, n] { x = parallel_fib(n - 1); });
+  long long y = parallel_fib(n - 2);
+  group.sync();
+  return x + y;
+}
+
+/**
+ * @brief 测试工作窃取调度器
+ */
+void test_work_stealing_scheduler() {
+  std::cout << "\n=== 工作窃取调度器测试 ===" << std::endl;
+
+  unsigned int num_cores = std::max(1u, std::thread::hardware_concurrency());
+  for (size_t threads : {size_t(1), size_t(num_cores), size_t(4)}) {
+    WorkStealingScheduler scheduler(threads);
+    long long fib = 0;
+    performance_test("P-FIB(32)，" + std::to_string(threads) + "线程",
+                     [&]() { scheduler.run([&] { fib = parallel_fib(32); }); });
+    std::cout << "fib(32) = " << fib << " (" << (fib == 2178309 ? "正确" : "错误")
+              << ")" << std::endl;
+  }
+
+  // parallel for：每个元素恰好被访问一次
+  WorkStealingScheduler scheduler(4);
+  std::vector<int> hits(100000, 0);
+  scheduler.parallel_for(0, hits.size(), 1000, [&](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i)
+      hits[i]++;
+  });
+  bool all_once = std::all_of(hits.begin(), hits.end(),
+                              [](int h) { return h == 1; });
+  std::cout << "parallel_for覆盖验证: " << (all_once ? "通过" : "失败")
+            << std::endl;
+
+  // 子任务中的异常在sync时重新抛出
+  bool caught = false;
+  try {
+    scheduler.run([] {
+      WorkStealingScheduler::TaskGroup group;
+      group.spawn([] { throw std::runtime_error("子任务失败"); });
+      group.sync();
+    });
+  } catch (const std::runtime_error &) {
+    caught = true;
+  }
+  std::cout << "异常传播验证: " << (caught ? "通过" : "失败") << std::endl;
+}
+
 /**
  * @brief 测试不同数据规模的性能
  */
@@ -334,6 +466,9 @@ int main() {
     // 测试线程池功能
     test_thread_pool();
 
+    // 测试工作窃取调度器
+    test_work_stealing_scheduler();
+
     // 测试多线程矩阵乘法
     test_matrix_multiplication();
 
@@ -346,6 +481,9 @@ int main() {
     // 测试并行前缀和
     test_prefix_sum();
 
+    // 测试原地并行扫描
+    test_generic_scan();
+
     // 测试可扩展性
     test_scalability();
 
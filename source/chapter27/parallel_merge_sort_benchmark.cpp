@@ -0,0 +1,76 @@
+#include "multithreaded_algorithms.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace algorithms;
+
+/**
+ * @brief 生成均匀分布的随机整数数组（固定种子，各轮输入相同）
+ */
+std::vector<int> generate_input(size_t size) {
+  std::vector<int> arr(size);
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> dis(0, 1 << 30);
+  for (auto &x : arr) {
+    x = dis(gen);
+  }
+  return arr;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: parallel_merge_sort_benchmark [元素个数] [最大线程数]
+  // 例如在64核机器上: parallel_merge_sort_benchmark 1000000000 64
+  size_t size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  size_t max_threads =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10)
+               : std::max(1u, std::thread::hardware_concurrency());
+
+  std::cout << "P-MERGE-SORT 可扩展性测试" << std::endl;
+  std::cout << "元素个数: " << size << ", 最大线程数: " << max_threads
+            << std::endl;
+
+  const std::vector<int> input = generate_input(size);
+  std::vector<int> expected = input;
+  auto start = std::chrono::high_resolution_clock::now();
+  std::sort(expected.begin(), expected.end());
+  auto end = std::chrono::high_resolution_clock::now();
+  std::cout << "std::sort: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(end -
+                                                                     start)
+                   .count()
+            << " ms" << std::endl;
+
+  bool all_correct = true;
+  double base_ms = 0.0;
+  std::vector<size_t> thread_counts;
+  for (size_t t = 1; t < max_threads; t *= 2) {
+    thread_counts.push_back(t);
+  }
+  thread_counts.push_back(max_threads);
+
+  for (size_t threads : thread_counts) {
+    std::vector<int> arr = input;
+    start = std::chrono::high_resolution_clock::now();
+    MultithreadedAlgorithms::multithreaded_merge_sort(arr, threads);
+    end = std::chrono::high_resolution_clock::now();
+    double ms =
+        std::chrono::duration<double, std::milli>(end - start).count();
+    if (threads == 1) {
+      base_ms = ms;
+    }
+
+    bool correct = arr == expected;
+    all_correct = all_correct && correct;
+    std::cout << std::setw(3) << threads << " 线程: " << std::fixed
+              << std::setprecision(0) << ms << " ms, 加速比 "
+              << std::setprecision(2) << base_ms / ms << "x"
+              << (correct ? "" : " （结果错误）") << std::endl;
+  }
+
+  return all_correct ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+#include "multithreaded_algorithms.h"
+#include "quick_sort_generic.h"
+#include "work_stealing_scheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+// 对照：顶层串行划分、两侧spawn的快速排序（此前 multithreaded_quick_sort 的做法）
+void fork_join_quick_sort(int *arr, size_t low, size_t high) {
+  if (high - low <= 1)
+    return;
+  int pivot = arr[high - 1];
+  size_t i = low;
+  for (size_t j = low; j < high - 1; ++j) {
+    if (arr[j] <= pivot) {
+      std::swap(arr[i], arr[j]);
+      ++i;
+    }
+  }
+  std::swap(arr[i], arr[high - 1]);
+  if (high - low > 5000) {
+    WorkStealingScheduler::TaskGroup group;
+    group.spawn([=] { fork_join_quick_sort(arr, low, i); });
+    fork_join_quick_sort(arr, i + 1, high);
+    group.sync();
+  } else {
+    fork_join_quick_sort(arr, low, i);
+    fork_join_quick_sort(arr, i + 1, high);
+  }
+}
+
+std::vector<int> generate_input(size_t size, int distinct) {
+  std::vector<int> arr(size);
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> dis(0, distinct - 1);
+  for (auto &x : arr) {
+    x = dis(gen);
+  }
+  return arr;
+}
+
+void run(const char *title, const std::vector<int> &input,
+         const std::vector<size_t> &thread_counts, bool fork_join_baseline) {
+  std::cout << title << std::endl;
+  std::vector<int> expected = input;
+  double base = time_ms([&] { std::sort(expected.begin(), expected.end()); });
+  std::cout << "  std::sort: " << std::fixed << std::setprecision(0) << base
+            << " ms" << std::endl;
+  std::vector<int> arr = input;
+  double ms = time_ms([&] { QuickSortGeneric<int>::introsort(arr); });
+  std::cout << "  串行内省排序: " << ms << " ms"
+            << (arr == expected ? "" : " （结果错误）") << std::endl;
+
+  for (size_t threads : thread_counts) {
+    bool correct = true;
+    double fork_join = 0;
+    if (fork_join_baseline) {
+      arr = input;
+      WorkStealingScheduler scheduler(threads);
+      fork_join = time_ms([&] {
+        scheduler.run([&] { fork_join_quick_sort(arr.data(), 0, arr.size()); });
+      });
+      correct = arr == expected;
+    }
+    arr = input;
+    double merge = time_ms(
+        [&] { MultithreadedAlgorithms::multithreaded_merge_sort(arr, threads); });
+    correct = correct && arr == expected;
+    arr = input;
+    double sample = time_ms(
+        [&] { MultithreadedAlgorithms::multithreaded_quick_sort(arr, threads); });
+    correct = correct && arr == expected;
+    std::cout << std::setw(5) << threads << " 线程: ";
+    if (fork_join_baseline) {
+      std::cout << "串行划分快排 " << fork_join << " ms, ";
+    }
+    std::cout << "P-MERGE-SORT " << merge << " ms, 样本排序 " << sample
+              << " ms（相对 std::sort " << std::setprecision(2) << sample / base
+              << "×）" << std::setprecision(0)
+              << (correct ? "" : " （结果错误）") << std::endl;
+  }
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: parallel_sample_sort_benchmark [元素个数] [最大线程数]
+  size_t size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  size_t max_threads =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10)
+               : std::max(1u, std::thread::hardware_concurrency());
+  std::vector<size_t> thread_counts;
+  for (size_t t = 1; t < max_threads; t *= 2) {
+    thread_counts.push_back(t);
+  }
+  thread_counts.push_back(max_threads);
+  if (max_threads == 1) {
+    // 单核机器上也走一遍并行路径（多个工作线程分时运行）
+    thread_counts.push_back(4);
+  }
+
+  std::cout << "元素个数: " << size << std::endl;
+  run("均匀随机 [0, 2^30)", generate_input(size, 1 << 30), thread_counts, true);
+  // Lomuto 划分遇到大量重复元素时递归深度接近 n，不跑串行划分快排
+  run("只有 100 种取值", generate_input(size, 100), thread_counts, false);
+  return 0;
+}
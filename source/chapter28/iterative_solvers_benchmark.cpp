@@ -0,0 +1,139 @@
+#include "linear_systems.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+// 单位正方形上 grid × grid 内点的五点差分：-Δu + convection · ∂u/∂x
+// convection = 0 时为对称正定的Poisson矩阵，否则为非对称的对流扩散矩阵
+SparseMatrixCSR five_point(size_t grid, double convection) {
+  size_t n = grid * grid;
+  double h = 1.0 / (grid + 1);
+  double west = -1.0 - convection * h / 2.0;
+  double east = -1.0 + convection * h / 2.0;
+  std::vector<size_t> row_start(n + 1, 0);
+  std::vector<int> col_index;
+  std::vector<double> values;
+  col_index.reserve(5 * n);
+  values.reserve(5 * n);
+  for (size_t r = 0; r < grid; r++) {
+    for (size_t c = 0; c < grid; c++) {
+      size_t i = r * grid + c;
+      if (r > 0) {
+        col_index.push_back(static_cast<int>(i - grid));
+        values.push_back(-1.0);
+      }
+      if (c > 0) {
+        col_index.push_back(static_cast<int>(i - 1));
+        values.push_back(west);
+      }
+      col_index.push_back(static_cast<int>(i));
+      values.push_back(4.0);
+      if (c + 1 < grid) {
+        col_index.push_back(static_cast<int>(i + 1));
+        values.push_back(east);
+      }
+      if (r + 1 < grid) {
+        col_index.push_back(static_cast<int>(i + grid));
+        values.push_back(-1.0);
+      }
+      row_start[i + 1] = col_index.size();
+    }
+  }
+  return SparseMatrixCSR(n, n, std::move(row_start), std::move(col_index),
+                         std::move(values));
+}
+
+void report(const char *name, double ms, const IterativeSolveResult &result) {
+  std::cout << "  " << std::left << std::setw(24) << name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(10) << ms
+            << " ms" << std::setw(7) << result.iterations << " 次迭代  "
+            << "相对残差 " << std::scientific << std::setprecision(2)
+            << result.relative_residual << (result.converged ? "" : "  未收敛")
+            << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: iterative_solvers_benchmark [网格边长] [线程数]
+  // 网格边长 3163 约为 10^7 个未知数（矩阵与CG工作向量约需 1.5 GB）
+  size_t grid = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 500;
+  size_t threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10)
+                            : std::thread::hardware_concurrency();
+  WorkStealingScheduler scheduler(threads == 0 ? 1 : threads);
+
+  SparseMatrixCSR A = five_point(grid, 0.0);
+  size_t n = A.get_rows();
+  std::vector<double> b(n, 1.0), y(n);
+  std::cout << "Poisson " << grid << " × " << grid << "，未知数 " << n
+            << "，非零元 " << A.get_nonzeros() << "，线程 "
+            << scheduler.get_num_threads() << std::endl;
+
+  const int repeats = 20;
+  double ms = time_ms([&] {
+    for (int k = 0; k < repeats; k++)
+      A.multiply(b, y);
+  });
+  std::cout << "  串行SpMV                " << std::fixed
+            << std::setprecision(2) << std::setw(8) << ms / repeats << " ms  "
+            << 2.0 * A.get_nonzeros() * repeats / ms / 1e6 << " GFLOP/s"
+            << std::endl;
+  ms = time_ms([&] {
+    for (int k = 0; k < repeats; k++)
+      A.multiply(scheduler, b, y);
+  });
+  std::cout << "  并行SpMV                " << std::setw(8) << ms / repeats
+            << " ms  " << 2.0 * A.get_nonzeros() * repeats / ms / 1e6
+            << " GFLOP/s" << std::endl;
+
+  KrylovSolver serial, parallel(&scheduler);
+  size_t max_iterations = 20000;
+  double tolerance = 1e-8;
+  IterativeSolveResult result;
+
+  ms = time_ms([&] {
+    result = serial.conjugate_gradient(A, b, IdentityPreconditioner(),
+                                       max_iterations, tolerance);
+  });
+  report("CG（串行）", ms, result);
+  ms = time_ms([&] {
+    result = parallel.conjugate_gradient(A, b, IdentityPreconditioner(),
+                                         max_iterations, tolerance);
+  });
+  report("CG（并行）", ms, result);
+  ms = time_ms([&] {
+    result = parallel.conjugate_gradient(A, b, JacobiPreconditioner(A),
+                                         max_iterations, tolerance);
+  });
+  report("Jacobi-CG（并行）", ms, result);
+  ms = time_ms([&] {
+    result = parallel.conjugate_gradient(A, b, ILU0Preconditioner(A),
+                                         max_iterations, tolerance);
+  });
+  report("ILU(0)-CG（并行）", ms, result);
+
+  SparseMatrixCSR C = five_point(grid, 100.0);
+  std::cout << "对流扩散（对流系数100），非对称" << std::endl;
+  ms = time_ms([&] {
+    result = parallel.gmres(C, b, JacobiPreconditioner(C), 30, max_iterations,
+                            tolerance);
+  });
+  report("Jacobi-GMRES(30)", ms, result);
+  ms = time_ms([&] {
+    result = parallel.gmres(C, b, ILU0Preconditioner(C), 30, max_iterations,
+                            tolerance);
+  });
+  report("ILU(0)-GMRES(30)", ms, result);
+  return 0;
+}
@@ -0,0 +1,107 @@
+#include "linear_systems.h"
+#include "matrix_inversion.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+void report(const char *name, double ms, double flops) {
+  std::cout << "  " << std::left << std::setw(26) << name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(10) << ms
+            << " ms";
+  if (flops > 0) {
+    std::cout << std::setw(8) << std::setprecision(2) << flops / ms / 1e6
+              << " GFLOP/s";
+  }
+  std::cout << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: linear_systems_benchmark [最大阶数] [右端项个数]
+  int max_n = argc > 1 ? std::atoi(argv[1]) : 1024;
+  int rhs = argc > 2 ? std::atoi(argv[2]) : 32;
+
+  std::mt19937 gen(28);
+  std::uniform_real_distribution<double> dis(-1.0, 1.0);
+  for (int n = 256; n <= max_n; n *= 2) {
+    Matrix A(n, n);
+    for (int i = 0; i < n; i++)
+      for (int j = 0; j < n; j++)
+        A.unchecked(i, j) = dis(gen);
+    Matrix S = A * A.transpose();
+    for (int i = 0; i < n; i++)
+      S.unchecked(i, i) += n;
+    Matrix B(n, rhs);
+    for (int i = 0; i < n; i++)
+      for (int j = 0; j < rhs; j++)
+        B.unchecked(i, j) = dis(gen);
+    std::vector<double> b(n);
+    for (double &v : b)
+      v = dis(gen);
+
+    double n3 = static_cast<double>(n) * n * n;
+    std::cout << "n = " << n << "，右端项 " << rhs << " 个" << std::endl;
+
+    std::vector<double> x;
+    if (n <= 1024) {
+      double ms =
+          time_ms([&] { x = LinearSystemSolver::gaussian_elimination(A, b); });
+      report("教科书高斯消元", ms, 2.0 * n3 / 3.0);
+    }
+
+    double ms = time_ms([&] { LUPFactorization lup(A); x = lup.solve(b); });
+    report("分块LUP分解+求解", ms, 2.0 * n3 / 3.0);
+
+    Matrix copy = A;
+    ms = time_ms([&] { LUPFactorization lup(std::move(copy)); });
+    report("分块LUP分解（就地）", ms, 2.0 * n3 / 3.0);
+
+    if (n <= 1024) {
+      ms = time_ms([&] {
+        for (int j = 0; j < rhs; j++) {
+          std::vector<double> column(n);
+          for (int i = 0; i < n; i++)
+            column[i] = B.unchecked(i, j);
+          x = LinearSystemSolver::lu_decomposition(A, column);
+        }
+      });
+      report("每个右端项重新分解", ms, rhs * 2.0 * n3 / 3.0);
+    }
+
+    LUPFactorization lup(A);
+    Matrix X(n, rhs);
+    ms = time_ms([&] { X = lup.solve(B); });
+    report("已分解后批量求解", ms, 2.0 * n * n * rhs);
+
+    ms = time_ms([&] { CholeskyFactorization chol(S); x = chol.solve(b); });
+    report("分块Cholesky分解+求解", ms, n3 / 3.0);
+
+    if (n <= 1024) {
+      ms = time_ms([&] { X = MatrixInverter::gauss_jordan_inversion(A); });
+      report("高斯-约当求逆", ms, 2.0 * n3);
+    }
+    ms = time_ms([&] { X = MatrixInverter::lu_inversion(A); });
+    report("LUP求逆（批量回代）", ms, 2.0 * n3);
+
+    double cond = 0.0;
+    ms = time_ms([&] { cond = MatrixInverter::condition_number(A); });
+    report("条件数（显式求逆）", ms, 0);
+    ms = time_ms([&] { cond = MatrixInverter::condition_estimate(A, lup); });
+    report("κ₁估计（复用分解）", ms, 0);
+    std::cout << "  κ₁估计值 " << std::scientific << std::setprecision(3)
+              << cond << std::endl;
+  }
+  return 0;
+}
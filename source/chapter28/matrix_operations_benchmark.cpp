@@ -0,0 +1,68 @@
+#include "matrix_operations.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+void report(const char *name, double ms, int sweeps, size_t elements) {
+  std::cout << "  " << std::left << std::setw(28) << name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(10) << ms
+            << " ms" << std::setw(10) << std::setprecision(2)
+            << sweeps * static_cast<double>(elements) / ms / 1e6
+            << " G元素/s" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: matrix_operations_benchmark [阶数] [迭代次数]
+  int n = argc > 1 ? std::atoi(argv[1]) : 2048;
+  int sweeps = argc > 2 ? std::atoi(argv[2]) : 20;
+  size_t elements = static_cast<size_t>(n) * n;
+
+  Matrix B = Matrix::random(n, n);
+  double omega = 0.8;
+  std::cout << n << " × " << n << "，阻尼Jacobi式更新 X ← X + ω(B - X/4)，"
+            << sweeps << " 次" << std::endl;
+
+  // 每个运算都物化成临时矩阵（惰性求值之前的行为）
+  Matrix X(n, n);
+  double ms = time_ms([&] {
+    for (int s = 0; s < sweeps; s++) {
+      Matrix t1 = X * 0.25;
+      Matrix t2 = B - t1;
+      Matrix t3 = t2 * omega;
+      X = Matrix(X + t3);
+    }
+  });
+  report("逐个运算生成临时矩阵", ms, sweeps, elements);
+
+  // 整条链融合为一趟循环，写回 X 的现有存储
+  Matrix Y(n, n);
+  ms = time_ms([&] {
+    for (int s = 0; s < sweeps; s++)
+      Y = Y + (B - Y * 0.25) * omega;
+  });
+  report("表达式模板（融合，无分配）", ms, sweeps, elements);
+
+  Matrix Z(n, n);
+  ms = time_ms([&] {
+    for (int s = 0; s < sweeps; s++)
+      Z += (B - Z * 0.25) * omega;
+  });
+  report("复合赋值 +=", ms, sweeps, elements);
+
+  double difference = MatrixUtils::norm(Matrix(X - Y)) +
+                      MatrixUtils::norm(Matrix(Y - Z));
+  std::cout << "  结果差异（Frobenius）：" << std::scientific
+            << difference << std::endl;
+  return 0;
+}
@@ -1,7 +1,9 @@
 #include "linear_systems.h"
 #include "matrix_inversion.h"
 #include "matrix_operations.h"
+#include "strassen_multiplication.h"
 #include <cassert>
+#include <chrono>
 #include <cmath>
 #include <iostream>
 #include <vector>
@@ -137,6 +139,128 @@ void test_matrix_operations() {
   assert(std::abs(norm - std::sqrt(30.0)) < 1e-10);
   std::cout << "✓ 矩阵工具函数测试通过" << std::endl;
 
+  // 测试用例7：列主序存储
+  std::cout << "\n7. 列主序存储测试：" << std::endl;
+  Matrix A_col = A.to_layout(MatrixLayout::ColumnMajor);
+  assert(A_col.get_layout() == MatrixLayout::ColumnMajor);
+  assert(A_col(1, 2) == 6.0);
+  assert(A_col.raw_data()[1] == 4.0); // 第0列为(1, 4)
+  Matrix P = A_col * A.transpose();
+  assert(P(0, 0) == 14.0 && P(1, 1) == 77.0);
+  std::cout << "✓ 列主序存储测试通过" << std::endl;
+
+  // 测试用例8：逐元素表达式的惰性求值
+  std::cout << "\n8. 惰性求值与复合赋值测试：" << std::endl;
+  Matrix fused = A + A_col * 2.0 - A / 2.0; // 混合存储顺序，一趟求值
+  for (int i = 0; i < fused.get_rows(); i++) {
+    for (int j = 0; j < fused.get_cols(); j++) {
+      assert(fused(i, j) == A(i, j) + A(i, j) * 2.0 - A(i, j) / 2.0);
+    }
+  }
+  const double *storage = fused.raw_data();
+  fused = fused + (A - fused) * 0.5; // 尺寸相同，直接写回原存储
+  fused += A;
+  fused *= 2.0;
+  assert(fused.raw_data() == storage);
+  assert(fused(0, 0) == 5.5); // ((2.5 + (1 - 2.5) / 2) + 1) * 2
+  Matrix product = (A + A) * A.transpose(); // 表达式先求值，再做GEMM
+  assert(product(0, 0) == 28.0);
+  std::cout << "A + 2A - A/2 融合求值，复合赋值未重新分配存储" << std::endl;
+  std::cout << "✓ 惰性求值与复合赋值测试通过" << std::endl;
+
+  std::cout << std::endl;
+}
+
+/**
+ * @brief 测试分块SIMD矩阵乘法内核
+ */
+void test_blocked_multiply() {
+  std::cout << "=== 测试分块矩阵乘法内核 ===" << std::endl;
+  std::cout << "检测到的微内核: "
+            << GemmKernel::isa_name(GemmKernel::detected_isa()) << std::endl;
+
+  // 非分块大小的整数倍，覆盖所有边缘情况
+  Matrix X = Matrix::random(131, 259, -1.0, 1.0);
+  Matrix Y = Matrix::random(259, 77, -1.0, 1.0);
+  Matrix reference = X.naive_multiply(Y);
+
+  for (auto isa : {GemmKernel::Isa::Scalar, GemmKernel::Isa::AVX2,
+                   GemmKernel::Isa::AVX512}) {
+    if (!GemmKernel::supported(isa)) {
+      std::cout << GemmKernel::isa_name(isa) << ": 不支持，跳过" << std::endl;
+      continue;
+    }
+    Matrix Z = X.multiply(Y, isa);
+    double max_error = 0.0;
+    for (int i = 0; i < Z.get_rows(); i++)
+      for (int j = 0; j < Z.get_cols(); j++)
+        max_error = std::max(max_error,
+                             std::abs(Z(i, j) - reference(i, j)));
+    std::cout << GemmKernel::isa_name(isa) << ": 最大误差 " << std::scientific
+              << max_error << std::fixed << std::endl;
+    assert(max_error < 1e-9);
+  }
+  std::cout << "✓ 分块矩阵乘法内核测试通过" << std::endl;
+  std::cout << std::endl;
+}
+
+/**
+ * @brief 测试Strassen-Winograd矩阵乘法
+ */
+void test_strassen_multiply() {
+  std::cout << "=== 测试Strassen-Winograd矩阵乘法 ===" << std::endl;
+
+  // 非方阵、非2的幂，较小的cutoff保证多层递归
+  Matrix X = Matrix::random(131, 259, -1.0, 1.0);
+  Matrix Y = Matrix::random(259, 77, -1.0, 1.0);
+  Matrix reference = X.naive_multiply(Y);
+
+  for (size_t threads : {size_t(1), size_t(4)}) {
+    for (size_t cutoff : {size_t(16), size_t(64), size_t(512)}) {
+      Matrix Z = StrassenMultiplication::multiply(X, Y, cutoff, threads);
+      double max_error = 0.0;
+      for (int i = 0; i < Z.get_rows(); i++)
+        for (int j = 0; j < Z.get_cols(); j++)
+          max_error = std::max(max_error,
+                               std::abs(Z(i, j) - reference(i, j)));
+      std::cout << "线程 " << threads << ", cutoff " << cutoff
+                << ": 最大误差 " << std::scientific << max_error << std::fixed
+                << std::endl;
+      assert(max_error < 1e-9);
+    }
+  }
+
+  // 与分块内核比较耗时
+  const int n = 1024;
+  Matrix P = Matrix::random(n, n, -1.0, 1.0);
+  Matrix Q = Matrix::random(n, n, -1.0, 1.0);
+  auto start = std::chrono::high_resolution_clock::now();
+  Matrix blocked = P * Q;
+  auto end = std::chrono::high_resolution_clock::now();
+  std::cout << n << "x" << n << " 分块内核耗时: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(end -
+                                                                     start)
+                   .count()
+            << " ms" << std::endl;
+
+  start = std::chrono::high_resolution_clock::now();
+  Matrix strassen = StrassenMultiplication::multiply(P, Q);
+  end = std::chrono::high_resolution_clock::now();
+  std::cout << n << "x" << n << " Strassen-Winograd耗时: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(end -
+                                                                     start)
+                   .count()
+            << " ms" << std::endl;
+
+  double max_error = 0.0;
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++)
+      max_error =
+          std::max(max_error, std::abs(strassen(i, j) - blocked(i, j)));
+  std::cout << "与分块内核的最大误差: " << std::scientific << max_error
+            << std::fixed << std::endl;
+  assert(max_error < 1e-8);
+  std::cout << "✓ Strassen-Winograd矩阵乘法测试通过" << std::endl;
   std::cout << std::endl;
 }
 
@@ -253,6 +377,129 @@ void test_linear_systems() {
     std::cout << "✓ 奇异矩阵检测成功：" << e.what() << std::endl;
   }
 
+  // 测试用例5：分解一次、批量求解多个右端项
+  std::cout << "\n5. 分块LUP与Cholesky分解测试：" << std::endl;
+  LUPFactorization lup(A);
+  Matrix rhs_batch(3, 2);
+  for (int i = 0; i < 3; i++) {
+    rhs_batch(i, 0) = b[i];
+    rhs_batch(i, 1) = A(i, 0);
+  }
+  Matrix x_batch = lup.solve(rhs_batch);
+  std::cout << "批量解第1列：[" << x_batch(0, 0) << ", " << x_batch(1, 0)
+            << ", " << x_batch(2, 0) << "]，第2列：[" << x_batch(0, 1)
+            << ", " << x_batch(1, 1) << ", " << x_batch(2, 1) << "]"
+            << std::endl;
+  std::cout << "det(A) = " << lup.determinant() << std::endl;
+  assert(std::abs(x_batch(0, 0) - 2.0) < 1e-10);
+  assert(std::abs(x_batch(1, 0) - 3.0) < 1e-10);
+  assert(std::abs(x_batch(2, 0) - -1.0) < 1e-10);
+  assert(std::abs(x_batch(0, 1) - 1.0) < 1e-10);
+  assert(std::abs(lup.determinant() - MatrixUtils::determinant(A)) < 1e-10);
+
+  Matrix spd = A * A.transpose();
+  std::vector<double> x_chol_dense =
+      LinearSystemSolver::cholesky_decomposition(spd, b);
+  assert(LinearSystemSolver::residual(spd, b, x_chol_dense) < 1e-10);
+  std::cout << "✓ 分块LUP与Cholesky分解测试通过" << std::endl;
+
+  // 测试用例6：稀疏Cholesky分解（二维网格上的离散Laplace算子）
+  std::cout << "\n6. 稀疏Cholesky分解测试：" << std::endl;
+  const int grid = 30;
+  const int size = grid * grid;
+  std::vector<SparseTriplet> entries;
+  for (int r = 0; r < grid; r++) {
+    for (int q = 0; q < grid; q++) {
+      int id = r * grid + q;
+      entries.push_back({id, id, 4.0});
+      if (q > 0) {
+        entries.push_back({id - 1, id, -1.0});
+      }
+      if (r > 0) {
+        entries.push_back({id - grid, id, -1.0});
+      }
+    }
+  }
+  SparseMatrixCSC laplace(size, size, entries);
+  std::vector<double> expected(size);
+  for (int i = 0; i < size; i++) {
+    expected[i] = std::sin(0.1 * i);
+  }
+  // 由上三角补全对称矩阵后计算右端项
+  std::vector<double> rhs = laplace.multiply(expected);
+  std::vector<double> lower = laplace.multiply_transpose(expected);
+  for (int i = 0; i < size; i++) {
+    rhs[i] += lower[i] - 4.0 * expected[i];
+  }
+
+  SparseCholesky factor(laplace);
+  factor.factorize(laplace);
+  std::vector<double> x_chol = factor.solve(rhs);
+  double max_error = 0.0;
+  for (int i = 0; i < size; i++) {
+    max_error = std::max(max_error, std::abs(x_chol[i] - expected[i]));
+  }
+  std::cout << size << "阶矩阵，上三角非零元 " << laplace.get_nonzeros()
+            << "，L的非零元 " << factor.factor_nonzeros()
+            << "（自然顺序为 " << size * (grid + 1) << " 左右）" << std::endl;
+  std::cout << "最大误差：" << max_error << std::endl;
+
+  assert(max_error < 1e-10);
+  assert(LinearSystemSolver::sparse_cholesky(laplace, rhs) == x_chol);
+  std::cout << "✓ 稀疏Cholesky分解测试通过" << std::endl;
+
+  // 测试用例7：稀疏迭代法（同一个Laplace矩阵的完整CSR形式）
+  std::cout << "\n7. 稀疏迭代法测试：" << std::endl;
+  std::vector<SparseTriplet> full;
+  for (const SparseTriplet &t : entries) {
+    full.push_back(t);
+    if (t.row != t.col) {
+      full.push_back({t.col, t.row, t.value});
+    }
+  }
+  SparseMatrixCSR laplace_csr(size, size, full);
+  assert(LinearSystemSolver::residual(laplace_csr, rhs, expected) < 1e-10);
+
+  KrylovSolver krylov;
+  IterativeSolveResult cg = krylov.conjugate_gradient(laplace_csr, rhs);
+  IterativeSolveResult jacobi_cg = krylov.conjugate_gradient(
+      laplace_csr, rhs, JacobiPreconditioner(laplace_csr));
+  IterativeSolveResult ilu_cg = krylov.conjugate_gradient(
+      laplace_csr, rhs, ILU0Preconditioner(laplace_csr));
+  std::cout << "CG迭代 " << cg.iterations << " 次，Jacobi-CG "
+            << jacobi_cg.iterations << " 次，ILU(0)-CG " << ilu_cg.iterations
+            << " 次" << std::endl;
+
+  // 加上一个反对称的对流项，得到非对称但正实的矩阵
+  std::vector<SparseTriplet> skewed = full;
+  for (SparseTriplet &t : skewed) {
+    if (t.row == t.col + grid) {
+      t.value -= 0.5;
+    } else if (t.col == t.row + grid) {
+      t.value += 0.5;
+    }
+  }
+  SparseMatrixCSR convection(size, size, skewed);
+  std::vector<double> convection_rhs = convection.multiply(expected);
+  IterativeSolveResult gm = krylov.gmres(
+      convection, convection_rhs, ILU0Preconditioner(convection), 20);
+  std::cout << "ILU(0)-GMRES(20)迭代 " << gm.iterations << " 次，残差 "
+            << gm.residual << std::endl;
+
+  max_error = 0.0;
+  for (int i = 0; i < size; i++) {
+    max_error = std::max({max_error, std::abs(cg.x[i] - expected[i]),
+                          std::abs(ilu_cg.x[i] - expected[i]),
+                          std::abs(gm.x[i] - expected[i])});
+  }
+  std::cout << "最大误差：" << max_error << std::endl;
+
+  assert(cg.converged && jacobi_cg.converged && ilu_cg.converged &&
+         gm.converged);
+  assert(ilu_cg.iterations < cg.iterations);
+  assert(max_error < 1e-7);
+  std::cout << "✓ 稀疏迭代法测试通过" << std::endl;
+
   std::cout << std::endl;
 }
 
@@ -347,6 +594,28 @@ void test_matrix_inversion() {
   assert(cond_A > 0);
   std::cout << "✓ 可逆性检查和条件数测试通过" << std::endl;
 
+  // 测试用例5：不求逆的1-范数条件数估计
+  std::cout << "\n5. 条件数估计测试：" << std::endl;
+  const int hilbert_size = 6;
+  Matrix H(hilbert_size, hilbert_size);
+  for (int i = 0; i < hilbert_size; i++) {
+    for (int j = 0; j < hilbert_size; j++) {
+      H(i, j) = 1.0 / (i + j + 1);
+    }
+  }
+  LUPFactorization hilbert_lup(H);
+  double estimate = MatrixInverter::condition_estimate(H, hilbert_lup);
+  double exact = MatrixUtils::norm_1(H) *
+                 MatrixUtils::norm_1(hilbert_lup.inverse());
+  std::cout << hilbert_size << "阶Hilbert矩阵 κ₁ 估计：" << estimate
+            << "，精确值：" << exact << std::endl;
+
+  // 估计值是下界，且一般在真值的数倍之内
+  assert(estimate <= exact * (1 + 1e-8));
+  assert(estimate >= exact / 3.0);
+  assert(MatrixInverter::condition_estimate(A) > 0);
+  std::cout << "✓ 条件数估计测试通过" << std::endl;
+
   std::cout << std::endl;
 }
 
@@ -360,6 +629,8 @@ int main() {
 
   try {
     test_matrix_operations();
+    test_blocked_multiply();
+    test_strassen_multiply();
     test_linear_systems();
     test_matrix_inversion();
 
@@ -0,0 +1,81 @@
+#include "linear_programming.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+// iterations 为0表示求解器不报告迭代次数
+void report(const char *name, double ms,
+            const LinearProgramming::LPResult &result, size_t iterations) {
+  std::cout << "  " << std::left << std::setw(14) << name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(10) << ms
+            << " ms" << std::setw(8)
+            << (iterations ? std::to_string(iterations) : "-") << " 次迭代  "
+            << result.status << "  目标值 " << std::setprecision(6)
+            << result.objective_value << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: interior_point_benchmark [最大约束数]
+  size_t max_m = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 800;
+
+  // generate_random_lp：稠密（密度0.7）问题，法方程是稠密的 m × m 矩阵
+  for (size_t m = 100; m <= max_m; m *= 2) {
+    size_t n = 2 * m;
+    auto problem = LinearProgramming::generate_random_lp(m, n);
+    const auto &A = std::get<0>(problem);
+    const auto &b = std::get<1>(problem);
+    const auto &c = std::get<2>(problem);
+    SparseMatrixCSC sparse = SparseMatrixCSC::from_dense(A);
+    std::cout << "稠密问题 " << m << " × " << n
+              << "，非零元: " << sparse.get_nonzeros() << std::endl;
+
+    LinearProgramming::LPResult result;
+    double ms = time_ms(
+        [&] { result = LinearProgramming::two_phase_simplex(A, b, c); });
+    report("两阶段单纯形", ms, result, 0);
+
+    RevisedSimplex simplex(sparse, b, c);
+    ms = time_ms([&] { result = simplex.solve(); });
+    report("修正单纯形", ms, result, simplex.get_iterations());
+
+    InteriorPointSolver ipm(sparse, b, c);
+    ms = time_ms([&] { result = ipm.solve(); });
+    report("内点法", ms, result, ipm.get_iterations());
+  }
+
+  // generate_random_sparse_lp：法方程稀疏，由 SparseCholesky 分解
+  for (size_t m = 1000; m <= 4 * max_m; m *= 2) {
+    auto problem =
+        LinearProgramming::generate_random_sparse_lp(m, m, 4.0 / m);
+    const SparseMatrixCSC &A = std::get<0>(problem);
+    const auto &b = std::get<1>(problem);
+    const auto &c = std::get<2>(problem);
+    std::cout << "稀疏问题 " << m << " × " << m
+              << "，非零元: " << A.get_nonzeros() << std::endl;
+
+    LinearProgramming::LPResult result;
+    RevisedSimplex simplex(A, b, c);
+    double ms = time_ms([&] { result = simplex.solve(); });
+    report("修正单纯形", ms, result, simplex.get_iterations());
+
+    InteriorPointSolver ipm(A, b, c);
+    ms = time_ms([&] { result = ipm.solve(); });
+    report("内点法", ms, result, ipm.get_iterations());
+    std::cout << "  Cholesky因子非零元: " << ipm.factor_nonzeros()
+              << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,108 @@
+#include "linear_programming.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+/**
+ * @brief 用对偶变量检查最优性：原始可行、对偶可行且对偶间隙为0
+ */
+double optimality_error(const SparseMatrixCSC &A, const std::vector<double> &b,
+                        const std::vector<double> &c,
+                        const LinearProgramming::LPResult &result,
+                        const std::vector<double> &y) {
+  double error = 0.0;
+  std::vector<double> ax = A.multiply(result.solution);
+  for (size_t i = 0; i < b.size(); i++) {
+    error = std::max(error, ax[i] - b[i]);
+    error = std::max(error, -y[i]);
+  }
+  std::vector<double> aty = A.multiply_transpose(y);
+  double dual_objective = 0.0;
+  for (size_t j = 0; j < c.size(); j++) {
+    error = std::max(error, c[j] - aty[j]);
+  }
+  for (size_t i = 0; i < b.size(); i++) {
+    dual_objective += b[i] * y[i];
+  }
+  return std::max(error, std::abs(dual_objective - result.objective_value) /
+                             (1.0 + std::abs(dual_objective)));
+}
+
+void report(const char *name, double ms, const RevisedSimplex &solver,
+            const LinearProgramming::LPResult &result, double error) {
+  std::cout << name << ": " << std::fixed << std::setprecision(1) << ms
+            << " ms"
+            << std::setw(8) << solver.get_iterations() << " 次迭代"
+            << std::setw(6) << solver.get_refactorizations() << " 次分解"
+            << "  目标值 " << std::setprecision(4) << result.objective_value
+            << "  误差 " << std::scientific << std::setprecision(1) << error
+            << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: linear_programming_benchmark [约束数] [变量数] [密度]
+  size_t m = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+  size_t n = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 20000;
+  double density = argc > 3 ? std::atof(argv[3]) : 0.0002;
+
+  auto problem = LinearProgramming::generate_random_sparse_lp(m, n, density);
+  SparseMatrixCSC &A = std::get<0>(problem);
+  std::vector<double> b = std::get<1>(problem);
+  std::vector<double> c = std::get<2>(problem);
+  std::cout << "约束数: " << m << ", 变量数: " << n
+            << ", 非零元: " << A.get_nonzeros() << std::endl;
+
+  for (auto pricing :
+       {RevisedSimplex::Pricing::Dantzig, RevisedSimplex::Pricing::Devex}) {
+    const char *name =
+        pricing == RevisedSimplex::Pricing::Devex ? "Devex定价" : "Dantzig定价";
+    RevisedSimplex solver(A, b, c, pricing);
+    LinearProgramming::LPResult result;
+    double ms = time_ms([&] { result = solver.solve(); });
+    report(name, ms, solver, result,
+           optimality_error(A, b, c, result, solver.get_duals()));
+  }
+
+  // 热启动：b 或 c 小幅扰动后，从上一次的最优基出发
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> noise(-0.05, 0.05);
+  RevisedSimplex solver(A, b, c);
+  solver.solve();
+  for (double &v : b) {
+    v *= 1.0 + noise(gen);
+  }
+  for (double &v : c) {
+    v *= 1.0 + noise(gen);
+  }
+
+  LinearProgramming::LPResult result;
+  solver.set_rhs(b);
+  double warm_b = time_ms([&] { result = solver.solve(); });
+  report("改b后热启动", warm_b, solver, result,
+         optimality_error(A, b, std::get<2>(problem), result,
+                          solver.get_duals()));
+
+  solver.set_objective(c);
+  double warm_c = time_ms([&] { result = solver.solve(); });
+  report("再改c后热启动", warm_c, solver, result,
+         optimality_error(A, b, c, result, solver.get_duals()));
+
+  RevisedSimplex cold(A, b, c);
+  double cold_ms = time_ms([&] { result = cold.solve(); });
+  report("同一问题冷启动", cold_ms, cold, result,
+         optimality_error(A, b, c, result, cold.get_duals()));
+  return 0;
+}
@@ -1,8 +1,10 @@
 #include "linear_programming.h"
 #include <chrono>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
 #include <random>
+#include <stdexcept>
 #include <vector>
 
 using namespace algorithms;
@@ -218,6 +220,214 @@ void test_dual_simplex() {
   }
 }
 
+/**
+ * @brief 测试稀疏修正单纯形法
+ */
+void test_revised_simplex() {
+  std::cout << "\n=== 稀疏修正单纯形法测试 ===" << std::endl;
+
+  // 与稠密单纯形法对照
+  std::vector<std::vector<double>> A = {{1, 1, 3}, {2, 2, 5}, {4, 1, 2}};
+  std::vector<double> b = {30, 24, 36};
+  std::vector<double> c = {3, 1, 2};
+
+  print_linear_program(A, b, c);
+  auto dense = LinearProgramming::simplex_method(A, b, c);
+  auto revised = LinearProgramming::revised_simplex(A, b, c);
+  std::cout << "稠密单纯形法:" << std::endl;
+  print_lp_result(dense);
+  std::cout << "修正单纯形法:" << std::endl;
+  print_lp_result(revised);
+
+  // 需要第一阶段（b 含负分量）与不可行问题
+  std::cout << "\n需要第一阶段的问题:" << std::endl;
+  std::vector<std::vector<double>> A2 = {{2, -1}, {1, -5}};
+  std::vector<double> b2 = {2, -4};
+  std::vector<double> c2 = {2, -1};
+  print_linear_program(A2, b2, c2);
+  print_lp_result(LinearProgramming::revised_simplex(A2, b2, c2));
+
+  std::cout << "\n不可行问题:" << std::endl;
+  print_lp_result(LinearProgramming::revised_simplex({{1, 1}, {-1, -1}},
+                                                     {1, -2}, {1, 1}));
+
+  // 稀疏随机问题：Dantzig vs Devex，再改右端项热启动
+  std::cout << "\n稀疏随机问题 (2000个约束, 2000个变量):" << std::endl;
+  auto sparse_lp =
+      LinearProgramming::generate_random_sparse_lp(2000, 2000, 0.002);
+  const SparseMatrixCSC &S = std::get<0>(sparse_lp);
+  std::vector<double> sb = std::get<1>(sparse_lp);
+  const std::vector<double> &sc = std::get<2>(sparse_lp);
+  std::cout << "  非零元: " << S.get_nonzeros() << std::endl;
+
+  for (auto pricing : {RevisedSimplex::Pricing::Dantzig,
+                       RevisedSimplex::Pricing::Devex}) {
+    RevisedSimplex solver(S, sb, sc, pricing);
+    performance_test(pricing == RevisedSimplex::Pricing::Devex ? "Devex定价"
+                                                               : "Dantzig定价",
+                     [&]() {
+                       auto result = solver.solve();
+                       std::cout << "  结果: " << result.status
+                                 << ", 最优值: " << std::fixed
+                                 << std::setprecision(4)
+                                 << result.objective_value
+                                 << ", 迭代: " << solver.get_iterations()
+                                 << std::endl;
+                     });
+  }
+
+  RevisedSimplex solver(S, sb, sc);
+  auto cold = solver.solve();
+  for (size_t i = 0; i < sb.size(); i += 7) {
+    sb[i] *= 0.9;
+  }
+  solver.set_rhs(sb);
+  auto warm = solver.solve();
+  std::cout << "  冷启动最优值: " << cold.objective_value
+            << ", 修改右端项后热启动: " << warm.objective_value << " ("
+            << solver.get_iterations() << "次迭代)" << std::endl;
+
+  // 第一阶段判定不可行后再热启动：x0 不能留在基中
+  RevisedSimplex infeasible(SparseMatrixCSC::from_dense({{0}, {2}, {0}}),
+                            {14, -8, 2}, {2});
+  infeasible.solve();
+  infeasible.set_rhs({14, -8, 2});
+  infeasible.set_objective({2});
+  auto again = infeasible.solve();
+  std::cout << "  不可行问题热启动再求解: " << again.status << std::endl;
+  if (again.feasible) {
+    throw std::runtime_error("不可行问题热启动后被判为可行");
+  }
+
+  // 随机小问题：每次改 b 与 c 后热启动，与冷启动的结果对照
+  std::mt19937 gen(48);
+  std::uniform_int_distribution<int> entry(-3, 3), rhs(-10, 20), gain(-3, 5);
+  int mismatches = 0, resolves = 0;
+  for (int trial = 0; trial < 3000; trial++) {
+    size_t rows = 1 + gen() % 4, cols = 1 + gen() % 3;
+    std::vector<std::vector<double>> small(rows, std::vector<double>(cols));
+    for (auto &row : small) {
+      for (double &x : row) {
+        x = entry(gen);
+      }
+    }
+    auto random_b = [&]() {
+      std::vector<double> v(rows);
+      for (double &x : v) {
+        x = rhs(gen);
+      }
+      return v;
+    };
+    auto random_c = [&]() {
+      std::vector<double> v(cols);
+      for (double &x : v) {
+        x = gain(gen);
+      }
+      return v;
+    };
+    SparseMatrixCSC small_sparse = SparseMatrixCSC::from_dense(small);
+    RevisedSimplex warm_solver(small_sparse, random_b(), random_c());
+    warm_solver.solve();
+    for (int k = 0; k < 3; k++) {
+      std::vector<double> new_b = random_b(), new_c = random_c();
+      warm_solver.set_rhs(new_b);
+      warm_solver.set_objective(new_c);
+      auto warm_result = warm_solver.solve();
+      auto cold_result = RevisedSimplex(small_sparse, new_b, new_c).solve();
+      resolves++;
+      bool optimal = cold_result.feasible && cold_result.bounded;
+      if (warm_result.status != cold_result.status ||
+          (optimal && std::abs(warm_result.objective_value -
+                               cold_result.objective_value) > 1e-6)) {
+        mismatches++;
+      }
+    }
+  }
+  std::cout << "  " << resolves << " 次随机热启动与冷启动结果不一致: "
+            << mismatches << " 次" << std::endl;
+  if (mismatches != 0) {
+    throw std::runtime_error("热启动结果与冷启动不一致");
+  }
+}
+
+/**
+ * @brief 测试内点法
+ */
+void test_interior_point() {
+  std::cout << "\n=== Mehrotra预测-校正内点法测试 ===" << std::endl;
+
+  std::vector<std::vector<double>> A = {{1, 1, 3}, {2, 2, 5}, {4, 1, 2}};
+  std::vector<double> b = {30, 24, 36};
+  std::vector<double> c = {3, 1, 2};
+  print_linear_program(A, b, c);
+  print_lp_result(LinearProgramming::interior_point_method(A, b, c));
+
+  std::cout << "\n无界问题:" << std::endl;
+  print_lp_result(LinearProgramming::interior_point_method(
+      {{-1, 1}, {1, -2}}, {1, 2}, {1, 1}));
+
+  std::cout << "\n不可行问题:" << std::endl;
+  print_lp_result(LinearProgramming::interior_point_method(
+      {{1, 1}, {-1, -1}}, {1, -2}, {1, 1}));
+
+  // 随机小整数问题中修正单纯形法判定不可行的，内点法也必须判定不可行，
+  // 且不能返回解
+  std::mt19937 gen(49);
+  std::uniform_int_distribution<int> entry(-5, 5), rhs(-10, 10);
+  int infeasible_count = 0, detected = 0;
+  while (infeasible_count < 2000) {
+    size_t rows = 2 + gen() % 8, cols = 1 + gen() % 8;
+    std::vector<std::vector<double>> small(rows, std::vector<double>(cols));
+    for (auto &row : small) {
+      for (double &x : row) {
+        x = entry(gen);
+      }
+    }
+    std::vector<double> small_b(rows), small_c(cols);
+    for (double &x : small_b) {
+      x = rhs(gen);
+    }
+    for (double &x : small_c) {
+      x = entry(gen);
+    }
+    if (LinearProgramming::revised_simplex(small, small_b, small_c).feasible) {
+      continue;
+    }
+    infeasible_count++;
+    auto result =
+        LinearProgramming::interior_point_method(small, small_b, small_c);
+    detected += !result.feasible && result.status == "问题不可行" &&
+                result.solution.empty();
+  }
+  std::cout << infeasible_count << " 个随机不可行问题，内点法判定不可行: "
+            << detected << " 个" << std::endl;
+  if (detected != infeasible_count) {
+    throw std::runtime_error("内点法未能判定不可行问题");
+  }
+
+  // 稠密随机问题：内点法的迭代次数几乎不随规模增长
+  std::cout << "\n随机问题 (60个约束, 120个变量):" << std::endl;
+  auto random_lp = LinearProgramming::generate_random_lp(60, 120);
+  SparseMatrixCSC S = SparseMatrixCSC::from_dense(std::get<0>(random_lp));
+  const std::vector<double> &rb = std::get<1>(random_lp);
+  const std::vector<double> &rc = std::get<2>(random_lp);
+
+  InteriorPointSolver ipm(S, rb, rc);
+  RevisedSimplex simplex(S, rb, rc);
+  performance_test("内点法", [&]() {
+    auto result = ipm.solve();
+    std::cout << "  结果: " << result.status << ", 最优值: " << std::fixed
+              << std::setprecision(6) << result.objective_value
+              << ", 迭代: " << ipm.get_iterations() << std::endl;
+  });
+  performance_test("修正单纯形法", [&]() {
+    auto result = simplex.solve();
+    std::cout << "  结果: " << result.status << ", 最优值: " << std::fixed
+              << std::setprecision(6) << result.objective_value
+              << ", 迭代: " << simplex.get_iterations() << std::endl;
+  });
+}
+
 /**
  * @brief 测试随机线性规划问题
  */
@@ -360,6 +570,12 @@ int main() {
     // 测试对偶单纯形法
     test_dual_simplex();
 
+    // 测试稀疏修正单纯形法
+    test_revised_simplex();
+
+    // 测试内点法
+    test_interior_point();
+
     // 测试随机问题
     test_random_problems();
 
@@ -0,0 +1,101 @@
+#include "polynomials_and_fft.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace algorithms;
+using Complex = PolynomialsAndFFT::Complex;
+
+// 重复执行f并返回每次的平均微秒数
+template <typename F> double time_per_call(size_t repeats, F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  for (size_t r = 0; r < repeats; r++) {
+    f();
+  }
+  std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::high_resolution_clock::now() - start;
+  return elapsed.count() / repeats;
+}
+
+// 相对于长双精度朴素DFT的最大误差
+double max_error(const std::vector<Complex> &input,
+                 const std::vector<Complex> &output) {
+  size_t n = input.size();
+  double error = 0.0;
+  for (size_t k = 0; k < n; k++) {
+    std::complex<long double> sum = 0;
+    for (size_t j = 0; j < n; j++) {
+      long double angle = 2.0L * M_PI * static_cast<long double>(j * k % n) / n;
+      sum += std::complex<long double>(input[j].real(), input[j].imag()) *
+             std::complex<long double>(std::cos(angle), std::sin(angle));
+    }
+    Complex expected(static_cast<double>(sum.real()),
+                     static_cast<double>(sum.imag()));
+    error = std::max(error, std::abs(output[k] - expected));
+  }
+  return error;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: fft_benchmark [长度] [重复次数]
+  size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4096;
+  size_t repeats = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2000;
+
+  std::mt19937 gen(2024);
+  std::uniform_real_distribution<double> dis(-1.0, 1.0);
+  std::vector<Complex> input(n);
+  for (auto &x : input) {
+    x = Complex(dis(gen), dis(gen));
+  }
+
+  std::cout << "FFT性能测试: n = " << n << ", 重复 " << repeats << " 次"
+            << std::endl;
+  std::cout << std::fixed << std::setprecision(2);
+
+  bool power_of_two = (n & (n - 1)) == 0;
+  std::vector<Complex> output;
+  if (power_of_two) {
+    double recursive_us = time_per_call(repeats / 10 + 1, [&] {
+      output = PolynomialsAndFFT::fft(input);
+    });
+    std::cout << "递归fft:        " << std::setw(10) << recursive_us
+              << " us/次" << std::endl;
+
+    double iterative_us = time_per_call(repeats, [&] {
+      output = PolynomialsAndFFT::iterative_fft(input);
+    });
+    std::cout << "iterative_fft:  " << std::setw(10) << iterative_us
+              << " us/次" << std::endl;
+    if (n <= 8192) {
+      std::cout << "  最大误差: " << std::scientific << max_error(input, output)
+                << std::fixed << std::endl;
+    }
+  }
+
+  double build_us = time_per_call(10, [&] { PolynomialsAndFFT::FFTPlan plan(n); });
+  PolynomialsAndFFT::FFTPlan plan(n);
+  std::vector<Complex> data = input;
+  double plan_us = time_per_call(repeats, [&] {
+    plan.forward(data);
+  });
+  std::cout << (plan.uses_bluestein() ? "FFTPlan(Bluestein): " : "FFTPlan(基4):   ")
+            << std::setw(10) << plan_us << " us/次 (构建计划 " << build_us
+            << " us)" << std::endl;
+
+  data = input;
+  plan.forward(data);
+  if (n <= 8192) {
+    std::cout << "  最大误差: " << std::scientific << max_error(input, data)
+              << std::fixed << std::endl;
+  }
+  plan.inverse(data);
+  double roundtrip = 0.0;
+  for (size_t i = 0; i < n; i++) {
+    roundtrip = std::max(roundtrip, std::abs(data[i] - input[i]));
+  }
+  std::cout << "  往返误差: " << std::scientific << roundtrip << std::endl;
+  return 0;
+}
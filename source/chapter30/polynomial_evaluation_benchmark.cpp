@@ -0,0 +1,145 @@
+#include "benchmark_harness.h"
+#include "polynomials_and_fft.h"
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace algorithms;
+using Polynomial = PolynomialsAndFFT::Polynomial;
+
+// 1001个系数的实多项式在 size 个 [-1, 1] 内的点上求值
+const size_t kCoefficients = 1001;
+
+Polynomial random_polynomial() {
+  std::mt19937 rng(30);
+  std::uniform_real_distribution<double> coefficient(-1.0, 1.0);
+  std::vector<double> coefficients(kCoefficients);
+  for (double &c : coefficients) {
+    c = coefficient(rng);
+  }
+  return Polynomial(coefficients);
+}
+
+std::vector<double> random_points(size_t n) {
+  std::mt19937 rng(static_cast<uint32_t>(n));
+  std::uniform_real_distribution<double> point(-1.0, 1.0);
+  std::vector<double> points(n);
+  for (double &x : points) {
+    x = point(rng);
+  }
+  return points;
+}
+
+void horner_per_point(BenchmarkState &state) {
+  Polynomial p = random_polynomial();
+  std::vector<double> points = random_points(state.size());
+  std::vector<double> values(points.size());
+  state.run([&] {
+    for (size_t i = 0; i < points.size(); ++i) {
+      values[i] = p.evaluate(points[i]);
+    }
+    BenchmarkState::do_not_optimize(values.data());
+  });
+  state.set_items_processed(static_cast<double>(points.size()));
+}
+
+void estrin_per_point(BenchmarkState &state) {
+  Polynomial p = random_polynomial();
+  std::vector<double> points = random_points(state.size());
+  std::vector<double> values(points.size());
+  state.run([&] {
+    for (size_t i = 0; i < points.size(); ++i) {
+      values[i] = p.evaluate_estrin(points[i]);
+    }
+    BenchmarkState::do_not_optimize(values.data());
+  });
+  state.set_items_processed(static_cast<double>(points.size()));
+}
+
+void horner_batch(BenchmarkState &state) {
+  Polynomial p = random_polynomial();
+  std::vector<double> points = random_points(state.size());
+  std::vector<double> values(points.size());
+  state.run([&] {
+    p.evaluate(points.data(), points.size(), values.data());
+    BenchmarkState::do_not_optimize(values.data());
+  });
+  state.set_items_processed(static_cast<double>(points.size()));
+}
+
+// 模P：n 个系数的多项式在 n 个点上求值
+std::vector<uint32_t> random_residues(size_t n, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::vector<uint32_t> values(n);
+  for (uint32_t &v : values) {
+    v = rng() % PolynomialsAndFFT::SubproductTree::modulus;
+  }
+  return values;
+}
+
+void mod_horner(BenchmarkState &state) {
+  const uint64_t p = PolynomialsAndFFT::SubproductTree::modulus;
+  auto coefficients = random_residues(state.size(), 1);
+  auto points = random_residues(state.size(), 2);
+  std::vector<uint32_t> values(points.size());
+  state.run([&] {
+    for (size_t i = 0; i < points.size(); ++i) {
+      uint64_t value = 0;
+      for (size_t k = coefficients.size(); k-- > 0;) {
+        value = (value * points[i] + coefficients[k]) % p;
+      }
+      values[i] = static_cast<uint32_t>(value);
+    }
+    BenchmarkState::do_not_optimize(values.data());
+  });
+}
+
+void mod_subproduct_tree(BenchmarkState &state) {
+  auto coefficients = random_residues(state.size(), 1);
+  auto points = random_residues(state.size(), 2);
+  std::vector<uint32_t> values;
+  state.run([&] {
+    values = PolynomialsAndFFT::multipoint_evaluate_mod(coefficients, points);
+  });
+  const uint64_t p = PolynomialsAndFFT::SubproductTree::modulus;
+  uint64_t expected = 0;
+  for (size_t k = coefficients.size(); k-- > 0;) {
+    expected = (expected * points.back() + coefficients[k]) % p;
+  }
+  if (values.back() != expected) {
+    throw std::runtime_error("multipoint evaluation mismatch");
+  }
+}
+
+// 建树一次、反复求值时只计求值部分
+void mod_subproduct_tree_reused(BenchmarkState &state) {
+  auto coefficients = random_residues(state.size(), 1);
+  PolynomialsAndFFT::SubproductTree tree(random_residues(state.size(), 2));
+  state.run([&] { BenchmarkState::do_not_optimize(tree.evaluate(coefficients).data()); });
+}
+
+void mod_interpolate(BenchmarkState &state) {
+  std::vector<uint32_t> points(state.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    points[i] = static_cast<uint32_t>(i);
+  }
+  auto values = random_residues(state.size(), 3);
+  state.run([&] {
+    BenchmarkState::do_not_optimize(
+        PolynomialsAndFFT::interpolate_mod(points, values).data());
+  });
+}
+
+const std::vector<size_t> kPoints = {1 << 10, 1 << 12, 1 << 14};
+const std::vector<size_t> kModSizes = {1 << 10, 1 << 12, 1 << 14};
+
+ALGORITHMS_BENCHMARK(horner_per_point).sizes(kPoints);
+ALGORITHMS_BENCHMARK(estrin_per_point).sizes(kPoints);
+ALGORITHMS_BENCHMARK(horner_batch).sizes(kPoints);
+ALGORITHMS_BENCHMARK(mod_horner).sizes({1 << 10, 1 << 12});
+ALGORITHMS_BENCHMARK(mod_subproduct_tree).sizes(kModSizes);
+ALGORITHMS_BENCHMARK(mod_subproduct_tree_reused).sizes(kModSizes);
+ALGORITHMS_BENCHMARK(mod_interpolate).sizes(kModSizes);
+
+ALGORITHMS_BENCHMARK_MAIN()
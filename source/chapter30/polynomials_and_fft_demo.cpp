@@ -1,8 +1,10 @@
 #include "polynomials_and_fft.h"
 #include <chrono>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <random>
+#include <stdexcept>
 #include <vector>
 
 using namespace algorithms;
@@ -314,6 +316,160 @@ void test_complex_operations() {
             << std::endl;
 }
 
+/**
+ * @brief 测试FFT计划：与iterative_fft和朴素DFT对照，包括非2的幂长度
+ */
+void test_fft_plan() {
+  std::cout << "\n=== FFT计划测试 ===" << std::endl;
+
+  std::mt19937 gen(30);
+  std::uniform_real_distribution<double> dis(-1.0, 1.0);
+  using Complex = PolynomialsAndFFT::Complex;
+
+  for (size_t n : {1, 2, 8, 32, 1024, 6, 12, 100, 1000}) {
+    std::vector<Complex> input(n);
+    for (auto &x : input) {
+      x = Complex(dis(gen), dis(gen));
+    }
+
+    // 朴素DFT（长双精度）作为参照
+    std::vector<Complex> expected(n);
+    for (size_t k = 0; k < n; ++k) {
+      std::complex<long double> sum = 0;
+      for (size_t j = 0; j < n; ++j) {
+        long double angle = 2.0L * M_PI * static_cast<long double>(j * k % n) / n;
+        sum += std::complex<long double>(input[j].real(), input[j].imag()) *
+               std::complex<long double>(std::cos(angle), std::sin(angle));
+      }
+      expected[k] = Complex(static_cast<double>(sum.real()),
+                            static_cast<double>(sum.imag()));
+    }
+
+    PolynomialsAndFFT::FFTPlan plan(n);
+    std::vector<Complex> data = input;
+    plan.forward(data);
+    double forward_error = 0.0;
+    for (size_t k = 0; k < n; ++k) {
+      forward_error = std::max(forward_error, std::abs(data[k] - expected[k]));
+    }
+    plan.inverse(data);
+    double roundtrip_error = 0.0;
+    for (size_t k = 0; k < n; ++k) {
+      roundtrip_error = std::max(roundtrip_error, std::abs(data[k] - input[k]));
+    }
+
+    std::cout << "n = " << std::setw(4) << n
+              << (plan.uses_bluestein() ? " (Bluestein)" : " (基4)      ")
+              << " 正变换最大误差: " << std::scientific << std::setprecision(2)
+              << forward_error << ", 往返误差: " << roundtrip_error
+              << std::fixed << std::endl;
+  }
+
+  // 与iterative_fft结果一致
+  std::vector<Complex> input(4096);
+  for (auto &x : input) {
+    x = Complex(dis(gen), dis(gen));
+  }
+  auto reference = PolynomialsAndFFT::iterative_fft(input);
+  PolynomialsAndFFT::FFTPlan plan(input.size());
+  std::vector<Complex> data = input;
+  plan.forward(data);
+  double difference = 0.0;
+  for (size_t k = 0; k < data.size(); ++k) {
+    difference = std::max(difference, std::abs(data[k] - reference[k]));
+  }
+  std::cout << "4096点结果与iterative_fft的最大差: " << std::scientific
+            << std::setprecision(2) << difference << std::fixed << std::endl;
+
+  try {
+    std::vector<Complex> wrong(10);
+    plan.forward(wrong);
+    std::cout << "长度不匹配没有被拒绝" << std::endl;
+  } catch (const std::invalid_argument &e) {
+    std::cout << "长度不匹配被拒绝: " << e.what() << std::endl;
+  }
+}
+
+/**
+ * @brief 测试批量求值与Estrin求值
+ */
+void test_batch_evaluation() {
+  std::cout << "\n=== 批量求值测试 ===" << std::endl;
+  std::mt19937 gen(30);
+  std::uniform_real_distribution<double> dis(-1.0, 1.0);
+
+  for (size_t m : {1, 5, 16, 17, 100, 1001}) {
+    std::vector<double> coefficients(m);
+    for (auto &c : coefficients) {
+      c = dis(gen);
+    }
+    PolynomialsAndFFT::Polynomial p(coefficients);
+    std::vector<double> points(1003);
+    for (auto &x : points) {
+      x = dis(gen);
+    }
+    std::vector<double> batch = p.evaluate(points);
+    double batch_error = 0.0, estrin_error = 0.0;
+    for (size_t i = 0; i < points.size(); ++i) {
+      double expected = p.evaluate(points[i]);
+      batch_error = std::max(batch_error, std::abs(batch[i] - expected));
+      estrin_error =
+          std::max(estrin_error, std::abs(p.evaluate_estrin(points[i]) - expected));
+    }
+    std::cout << std::setw(5) << m << " 个系数: 批量最大差 " << std::scientific
+              << std::setprecision(2) << batch_error << ", Estrin最大差 "
+              << estrin_error << std::fixed << std::endl;
+  }
+}
+
+/**
+ * @brief 测试模素数的多点求值与插值
+ */
+void test_multipoint_mod() {
+  std::cout << "\n=== 模P多点求值与插值测试 ===" << std::endl;
+  const uint64_t p = PolynomialsAndFFT::SubproductTree::modulus;
+  std::mt19937 gen(998);
+
+  // A(x) = 1 + 2x + 3x² 在 0..4 处的值
+  auto values = PolynomialsAndFFT::multipoint_evaluate_mod({1, 2, 3}, {0, 1, 2, 3, 4});
+  std::cout << "A(0..4) = ";
+  for (uint32_t v : values) {
+    std::cout << v << " ";
+  }
+  std::cout << std::endl;
+
+  for (size_t n : {1, 2, 33, 100, 1000, 4097}) {
+    std::vector<uint32_t> coefficients(n), points(n);
+    for (size_t i = 0; i < n; ++i) {
+      coefficients[i] = static_cast<uint32_t>(gen() % p);
+      points[i] = static_cast<uint32_t>(gen() % p);
+    }
+    PolynomialsAndFFT::SubproductTree tree(points);
+    std::vector<uint32_t> y = tree.evaluate(coefficients);
+    for (size_t i = 0; i < n; ++i) {
+      uint64_t expected = 0;
+      for (size_t k = n; k-- > 0;) {
+        expected = (expected * points[i] + coefficients[k]) % p;
+      }
+      if (expected != y[i]) {
+        throw std::runtime_error("multipoint evaluation mismatch");
+      }
+    }
+    if (tree.interpolate(y) != coefficients) {
+      throw std::runtime_error("interpolation mismatch");
+    }
+    std::cout << "n = " << std::setw(4) << n << ": 与Horner一致，插值还原系数"
+              << std::endl;
+  }
+
+  try {
+    PolynomialsAndFFT::interpolate_mod({1, 2, 1}, {4, 5, 6});
+    std::cout << "重复节点没有被拒绝" << std::endl;
+  } catch (const std::invalid_argument &e) {
+    std::cout << "重复节点被拒绝: " << e.what() << std::endl;
+  }
+}
+
 int main() {
   std::cout << "=== 算法导论 第30章 - 多项式与快速傅里叶变换算法演示 ==="
             << std::endl;
@@ -338,6 +494,15 @@ int main() {
     // 测试复数运算
     test_complex_operations();
 
+    // 测试FFT计划
+    test_fft_plan();
+
+    // 测试批量求值
+    test_batch_evaluation();
+
+    // 测试模P多点求值与插值
+    test_multipoint_mod();
+
     std::cout << "\n=== 测试完成 ===" << std::endl;
 
   } catch (const std::exception &e) {
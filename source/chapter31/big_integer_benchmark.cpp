@@ -0,0 +1,105 @@
+#include "big_integer.h"
+#include "number_theory_algorithms.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+// 重复执行直到总时间不少于 min_ms，返回单次平均毫秒数
+template <typename F> double average_ms(F f, double min_ms = 100) {
+  int runs = 0;
+  double total = 0;
+  while (total < min_ms) {
+    total += time_ms(f);
+    runs++;
+  }
+  return total / runs;
+}
+
+BigInteger::Magnitude random_limbs(size_t n, std::mt19937_64 &gen) {
+  BigInteger::Magnitude limbs(n);
+  for (auto &x : limbs) {
+    x = gen();
+  }
+  limbs.back() |= uint64_t(1) << 63;
+  return limbs;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: big_integer_benchmark [RSA 模数位数，默认 2048] [签名次数]
+  int modulus_bits = argc > 1 ? std::atoi(argv[1]) : 2048;
+  int signs = argc > 2 ? std::atoi(argv[2]) : 20;
+  std::mt19937_64 gen(3110);
+
+  // 乘法交叉点：同样长度的两数相乘
+  std::cout << "乘法（n 字 × n 字，单位 ms）" << std::endl;
+  std::cout << std::setw(8) << "n" << std::setw(12) << "逐字" << std::setw(14)
+            << "Karatsuba" << std::setw(12) << "NTT" << std::endl;
+  for (size_t n : {size_t(8), size_t(16), size_t(24), size_t(32), size_t(48),
+                   size_t(64), size_t(256), size_t(512), size_t(1024),
+                   size_t(2048), size_t(3072), size_t(4096), size_t(16384)}) {
+    BigInteger::Magnitude a = random_limbs(n, gen), b = random_limbs(n, gen);
+    BigInteger::Magnitude sink;
+    double school = n <= 4096 ? average_ms([&] {
+      sink = BigInteger::multiply_schoolbook(a, b);
+    })
+                              : 0;
+    double karatsuba =
+        average_ms([&] { sink = BigInteger::multiply_karatsuba(a, b); });
+    double ntt = average_ms([&] { sink = BigInteger::multiply_ntt(a, b); });
+    std::cout << std::setw(8) << n << std::fixed << std::setprecision(4)
+              << std::setw(12) << school << std::setw(12) << karatsuba
+              << std::setw(12) << ntt << std::endl;
+  }
+
+  // RSA：密钥生成、签名（常数时间与滑动窗口）、验证
+  std::cout << std::endl
+            << modulus_bits << " 位 RSA" << std::endl;
+  std::unique_ptr<NumberTheoryAlgorithms::RSA<BigInteger>> rsa;
+  double keygen_ms = time_ms([&] {
+    rsa = std::make_unique<NumberTheoryAlgorithms::RSA<BigInteger>>(
+        modulus_bits / 2);
+  });
+  std::cout << "  密钥生成 " << std::setprecision(1) << keygen_ms << " ms"
+            << std::endl;
+  BigInteger n = rsa->get_public_key().second;
+  std::vector<BigInteger> messages, signatures(signs);
+  for (int i = 0; i < signs; i++) {
+    messages.push_back(BigInteger::random_below(n, gen));
+  }
+  for (bool constant_time : {true, false}) {
+    rsa->set_constant_time(constant_time);
+    double ms = time_ms([&] {
+      for (int i = 0; i < signs; i++) {
+        signatures[i] = rsa->sign(messages[i]);
+      }
+    });
+    std::cout << "  签名（" << (constant_time ? "常数时间固定窗口" : "滑动窗口")
+              << "） " << std::setprecision(3) << ms / signs << " ms/次"
+              << std::endl;
+  }
+  int verified = 0;
+  double ms = time_ms([&] {
+    for (int i = 0; i < signs; i++) {
+      verified += rsa->verify(messages[i], signatures[i]);
+    }
+  });
+  std::cout << "  验证 " << std::setprecision(3) << ms / signs << " ms/次，通过 "
+            << verified << " / " << signs << std::endl;
+  return 0;
+}
@@ -0,0 +1,213 @@
+#include "big_integer.h"
+#include "number_theory_algorithms.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+using namespace algorithms;
+
+// 随机的 n 字整数，低位和高位交替出现全1字（容易暴露进位错误）
+BigInteger random_integer(size_t limbs, std::mt19937_64 &gen) {
+  BigInteger::Magnitude magnitude(limbs);
+  for (size_t i = 0; i < limbs; i++) {
+    magnitude[i] = gen() % 4 == 0 ? ~uint64_t(0) : gen();
+  }
+  return BigInteger::from_magnitude(magnitude, gen() % 2 == 0);
+}
+
+void test_arithmetic() {
+  std::cout << "=== 测试基本运算与字符串转换 ===" << std::endl;
+  BigInteger a("123456789012345678901234567890");
+  BigInteger b("-987654321098765432109876543210");
+  std::cout << "a = " << a << std::endl;
+  std::cout << "b = " << b << std::endl;
+  std::cout << "a + b = " << a + b << std::endl;
+  std::cout << "a * b = " << a * b << std::endl;
+  std::cout << "b / a = " << b / a << "，b % a = " << b % a << std::endl;
+  std::cout << "2^200 = " << (BigInteger(1) << 200) << std::endl;
+  std::cout << "2^200 (十六进制) = " << (BigInteger(1) << 200).to_string(16)
+            << std::endl;
+
+  std::mt19937_64 gen(3101);
+  int agreed = 0;
+  const int trials = 500;
+  for (int t = 0; t < trials; t++) {
+    BigInteger x = random_integer(1 + gen() % 40, gen);
+    BigInteger y = random_integer(1 + gen() % 20, gen);
+    if (t % 5 == 0)
+      y = BigInteger(static_cast<long long>(gen() % 1000) + 1);
+    BigInteger q, r;
+    BigInteger::divide(x, y, q, r);
+    bool ok = q * y + r == x && r.abs() < y.abs() &&
+              (r.is_zero() || r.is_negative() == x.is_negative());
+    ok = ok && BigInteger(x.to_string()) == x &&
+         BigInteger(x.to_string(16), 16) == x;
+    ok = ok && (x + y) - y == x && ((x << 77) >> 77) == x;
+    agreed += ok;
+  }
+  std::cout << trials << " 组随机数的除法恒等式、字符串往返、移位检查通过 "
+            << agreed << " 组" << std::endl;
+
+  // 与内置 long long 对照
+  std::uniform_int_distribution<long long> small(-3000000000LL, 3000000000LL);
+  int native = 0;
+  for (int t = 0; t < trials; t++) {
+    long long x = small(gen), y = small(gen);
+    if (y == 0)
+      y = 7;
+    native += BigInteger(x) * BigInteger(y) == BigInteger(x * y) &&
+              BigInteger(x) / BigInteger(y) == BigInteger(x / y) &&
+              BigInteger(x) % BigInteger(y) == BigInteger(x % y) &&
+              (BigInteger(x) < BigInteger(y)) == (x < y);
+  }
+  std::cout << trials << " 组与 long long 运算一致 " << native << " 组"
+            << std::endl
+            << std::endl;
+}
+
+void test_multiplication() {
+  std::cout << "=== 测试逐字乘法、Karatsuba与NTT乘法 ===" << std::endl;
+  std::mt19937_64 gen(3102);
+  for (size_t n : {size_t(1), size_t(31), size_t(33), size_t(100), size_t(257),
+                   size_t(2000), size_t(5000)}) {
+    for (size_t m : {n, n / 3 + 1, 2 * n + 5}) {
+      BigInteger::Magnitude a = random_integer(n, gen).limbs();
+      BigInteger::Magnitude b = random_integer(m, gen).limbs();
+      auto school = BigInteger::multiply_schoolbook(a, b);
+      auto karatsuba = BigInteger::multiply_karatsuba(a, b);
+      auto ntt = BigInteger::multiply_ntt(a, b);
+      std::cout << n << " 字 × " << m << " 字: Karatsuba "
+                << (karatsuba == school ? "一致" : "不一致") << "，NTT "
+                << (ntt == school ? "一致" : "不一致") << std::endl;
+    }
+  }
+
+  // 长度悬殊的全1操作数：分段叠加时进位会传出子积的范围
+  for (auto [n, m] : std::vector<std::pair<size_t, size_t>>{
+           {200, 500}, {1000, 3071}, {1000, 3072}, {1000, 3100}, {3100, 5000}}) {
+    BigInteger::Magnitude ones_a(n, ~0ULL), ones_b(m, ~0ULL);
+    BigInteger::Magnitude a = random_integer(n, gen).limbs();
+    BigInteger::Magnitude b = random_integer(m, gen).limbs();
+    if (BigInteger::multiply_karatsuba(ones_a, ones_b) !=
+            BigInteger::multiply_schoolbook(ones_a, ones_b) ||
+        BigInteger::multiply_karatsuba(a, b) != BigInteger::multiply_schoolbook(a, b)) {
+      throw std::runtime_error("unbalanced Karatsuba mismatch");
+    }
+  }
+  // (2^12800 − 1)(2^32000 − 1) = 2^44800 − 2^32000 − 2^12800 + 1
+  BigInteger x = (BigInteger(1) << 12800) - 1, y = (BigInteger(1) << 32000) - 1;
+  BigInteger product = x * y;
+  BigInteger expected =
+      (BigInteger(1) << 44800) - (BigInteger(1) << 32000) - (BigInteger(1) << 12800) + 1;
+  if (product != expected || product / y != x || product % y != BigInteger(0)) {
+    throw std::runtime_error("unbalanced product mismatch");
+  }
+  std::cout << "长度悬殊（200×500 到 3100×5000 字）的全1与随机操作数一致，"
+               "(2^12800−1)(2^32000−1) 正确"
+            << std::endl;
+  std::cout << std::endl;
+}
+
+void test_modular_exponentiation() {
+  std::cout << "=== 测试Montgomery模幂 ===" << std::endl;
+  std::mt19937_64 gen(3103);
+
+  // 与 NumberTheoryAlgorithms 的 long long 版本对照
+  int agreed = 0;
+  const int trials = 500;
+  for (int t = 0; t < trials; t++) {
+    long long n = static_cast<long long>(gen() % 4000000000000LL) + 2;
+    long long a = static_cast<long long>(gen() % 10000000000000LL);
+    long long e = static_cast<long long>(gen() % 1000000);
+    long long expected = NumberTheoryAlgorithms::mod_exponentiation(a, e, n);
+    agreed += BigInteger::pow_mod(a, e, n) == BigInteger(expected) &&
+              BigInteger::pow_mod(a, e, n, true) == BigInteger(expected);
+  }
+  std::cout << trials << " 组与 long long 模幂一致（奇偶模数，两种模式） "
+            << agreed << " 组" << std::endl;
+
+  // 大模数：滑动窗口、常数时间、逐位平方-乘法三者一致
+  int large = 0;
+  const int large_trials = 20;
+  for (int t = 0; t < large_trials; t++) {
+    BigInteger n = random_integer(16, gen).abs();
+    if (!n.is_odd())
+      n += 1;
+    BigInteger a = random_integer(16, gen), e = random_integer(1 + t % 16, gen).abs();
+    BigInteger reference = 1, x = BigInteger::mod(a, n);
+    for (size_t i = e.bit_length(); i-- > 0;) {
+      reference = reference * reference % n;
+      if (e.test_bit(i))
+        reference = reference * x % n;
+    }
+    large += BigInteger::pow_mod(a, e, n) == reference &&
+             BigInteger::pow_mod(a, e, n, true) == reference;
+  }
+  std::cout << large_trials << " 组 1024 位模数的模幂一致 " << large << " 组"
+            << std::endl;
+
+  // 费马小定理：已知素数 p = 2^127 - 1
+  BigInteger p = (BigInteger(1) << 127) - 1;
+  std::mt19937_64 prime_gen(3104);
+  std::cout << "2^127 - 1 是素数: "
+            << (BigInteger::is_probable_prime(p, 20, prime_gen) ? "是" : "否")
+            << "，2^128 + 1 是素数: "
+            << (BigInteger::is_probable_prime((BigInteger(1) << 128) + 1, 20,
+                                              prime_gen)
+                    ? "是"
+                    : "否")
+            << std::endl;
+  std::cout << "3^(p-1) mod p = " << BigInteger::pow_mod(3, p - 1, p)
+            << std::endl
+            << std::endl;
+}
+
+void test_rsa() {
+  std::cout << "=== 测试2048位RSA ===" << std::endl;
+  auto start = std::chrono::high_resolution_clock::now();
+  NumberTheoryAlgorithms::RSA<BigInteger> rsa(1024);
+  double ms = std::chrono::duration<double, std::milli>(
+                  std::chrono::high_resolution_clock::now() - start)
+                  .count();
+  auto key = rsa.get_public_key();
+  std::cout << "密钥生成 " << ms << " ms，模数 " << key.second.bit_length()
+            << " 位，e = " << key.first << std::endl;
+
+  std::mt19937_64 gen(3105);
+  int signed_ok = 0, forged = 0, decrypted = 0;
+  const int trials = 10;
+  for (int t = 0; t < trials; t++) {
+    BigInteger message = BigInteger::random_below(key.second, gen);
+    rsa.set_constant_time(t % 2 == 0);
+    BigInteger signature = rsa.sign(message);
+    signed_ok += rsa.verify(message, signature);
+    forged += rsa.verify(message + 1 < key.second ? message + 1 : message - 1,
+                         signature);
+    decrypted += NumberTheoryAlgorithms::verify_rsa(rsa, message);
+  }
+  std::cout << trials << " 条消息：签名验证通过 " << signed_ok
+            << "，篡改后仍通过 " << forged << "，加密后解密还原 " << decrypted
+            << std::endl;
+
+  NumberTheoryAlgorithms::RSA<> small(8);
+  std::cout << "int 版本（8位素数）: 加密解密 "
+            << (NumberTheoryAlgorithms::verify_rsa(small, 42) ? "正确" : "错误")
+            << std::endl
+            << std::endl;
+}
+
+int main() {
+  std::cout << "第31章 大整数与RSA演示程序" << std::endl;
+  std::cout << "=========================" << std::endl;
+
+  test_arithmetic();
+  test_multiplication();
+  test_modular_exponentiation();
+  test_rsa();
+
+  std::cout << "所有测试完成！" << std::endl;
+  return 0;
+}
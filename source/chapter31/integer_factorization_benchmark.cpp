@@ -0,0 +1,118 @@
+#include "integer_factorization.h"
+#include "number_theory_algorithms.h"
+#include "primality.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+void report(const char *name, double ms, size_t count, uint64_t checksum) {
+  std::cout << "  " << std::left << std::setw(30) << name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(10) << ms
+            << " ms  " << std::setprecision(1) << std::setw(8)
+            << 1e3 * ms / count << " μs/个  校验和 " << checksum << std::endl;
+}
+
+// 对照：算法导论中的 Floyd 版 rho，每步一次 % 取模和一次 gcd
+uint64_t floyd_rho(uint64_t n) {
+  for (uint64_t c = 1;; c++) {
+    auto f = [&](uint64_t x) {
+      return static_cast<uint64_t>(
+          (static_cast<unsigned __int128>(x) * x + c) % n);
+    };
+    uint64_t x = 2, y = 2, d = 1;
+    while (d == 1) {
+      x = f(x);
+      y = f(f(y));
+      d = NumberTheoryAlgorithms::binary_gcd(x > y ? x - y : y - x, n);
+    }
+    if (d != n)
+      return d;
+  }
+}
+
+uint64_t random_prime(int bits, std::mt19937_64 &gen) {
+  while (true) {
+    uint64_t x = (gen() >> (64 - bits)) | (uint64_t(1) << (bits - 1)) | 1;
+    if (MillerRabin::is_prime(x))
+      return x;
+  }
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: integer_factorization_benchmark [半素数个数] [线程数]
+  size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 5000;
+  size_t threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10)
+                            : std::thread::hardware_concurrency();
+  threads = threads == 0 ? 1 : threads;
+  std::mt19937_64 gen(3150);
+
+  // 最难的情形：两个32位素数之积
+  std::vector<uint64_t> moduli(n);
+  for (auto &m : moduli) {
+    m = random_prime(32, gen) * random_prime(32, gen);
+  }
+  std::cout << n << " 个64位半素数（两个32位素数之积），线程 " << threads
+            << std::endl;
+
+  uint64_t checksum = 0;
+  size_t floyd_count = std::min<size_t>(n, 500);
+  double ms = time_ms([&] {
+    for (size_t i = 0; i < floyd_count; i++) {
+      uint64_t d = floyd_rho(moduli[i]);
+      checksum += std::min(d, moduli[i] / d);
+    }
+  });
+  report("Floyd（% 取模，每步gcd）", ms, floyd_count, checksum);
+
+  checksum = 0;
+  ms = time_ms([&] {
+    for (size_t i = 0; i < floyd_count; i++) {
+      uint64_t d = 1;
+      for (uint64_t c = 1; d == 1 || d == moduli[i]; c++) {
+        d = PollardRho::brent(moduli[i], c);
+      }
+      checksum += std::min(d, moduli[i] / d);
+    }
+  });
+  report("Brent + Montgomery + 批量gcd", ms, floyd_count, checksum);
+
+  std::vector<std::vector<uint64_t>> serial, parallel;
+  ms = time_ms([&] { serial = PollardRho::factorize_all(moduli, 1); });
+  checksum = 0;
+  for (const auto &f : serial) {
+    checksum += f.empty() ? 0 : f[0];
+  }
+  report("factorize_all（单线程）", ms, n, checksum);
+  ms = time_ms([&] { parallel = PollardRho::factorize_all(moduli, threads); });
+  report("factorize_all（并行）", ms, n, checksum);
+  std::cout << "  结果一致: " << (serial == parallel ? "是" : "否") << std::endl;
+
+  // 随机64位数（多数有小因子）
+  std::vector<uint64_t> random(n * 10);
+  for (auto &x : random) {
+    x = gen() | 1;
+  }
+  ms = time_ms([&] { serial = PollardRho::factorize_all(random, threads); });
+  checksum = 0;
+  for (const auto &f : serial) {
+    checksum += f.size();
+  }
+  std::cout << random.size() << " 个随机64位奇数" << std::endl;
+  report("factorize_all（并行）", ms, random.size(), checksum);
+  return 0;
+}
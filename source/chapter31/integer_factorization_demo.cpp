@@ -0,0 +1,102 @@
+#include "integer_factorization.h"
+#include "primality.h"
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace algorithms;
+
+// 因子都是素数、升序且乘积等于 n
+bool valid_factorization(uint64_t n, const std::vector<uint64_t> &factors) {
+  unsigned __int128 product = 1;
+  for (size_t i = 0; i < factors.size(); i++) {
+    if (!MillerRabin::is_prime(factors[i]) ||
+        (i > 0 && factors[i] < factors[i - 1]))
+      return false;
+    product *= factors[i];
+  }
+  return product == n;
+}
+
+// 随机的 bits 位素数
+uint64_t random_prime(int bits, std::mt19937_64 &gen) {
+  while (true) {
+    uint64_t x = (gen() >> (64 - bits)) | (uint64_t(1) << (bits - 1)) | 1;
+    if (MillerRabin::is_prime(x))
+      return x;
+  }
+}
+
+void test_factorize() {
+  std::cout << "=== 测试Pollard rho分解 ===" << std::endl;
+  std::vector<uint64_t> examples = {1,
+                                    2,
+                                    561,
+                                    1001,
+                                    600851475143ULL,
+                                    3656158440062976ULL, // 6^20
+                                    18446744073709551615ULL,
+                                    18446744073709551557ULL,
+                                    4294967291ULL * 4294967291ULL,
+                                    4294967279ULL * 4294967291ULL};
+  for (uint64_t n : examples) {
+    std::vector<uint64_t> factors = PollardRho::factorize(n);
+    std::cout << "  " << n << " =";
+    for (size_t i = 0; i < factors.size(); i++) {
+      std::cout << (i ? " × " : " ") << factors[i];
+    }
+    std::cout << (valid_factorization(n, factors) ? "" : "（错误）")
+              << std::endl;
+  }
+
+  std::mt19937_64 gen(3140);
+  const int trials = 2000;
+  int random_ok = 0, semiprime_ok = 0;
+  for (int t = 0; t < trials; t++) {
+    uint64_t n = gen() | 1;
+    random_ok += valid_factorization(n, PollardRho::factorize(n));
+    uint64_t p = random_prime(32, gen), q = random_prime(32, gen);
+    std::vector<uint64_t> expected = {std::min(p, q), std::max(p, q)};
+    semiprime_ok += PollardRho::factorize(p * q) == expected;
+  }
+  std::cout << trials << " 个随机64位奇数分解正确 " << random_ok << " 个，"
+            << trials << " 个两个32位素数之积分解正确 " << semiprime_ok << " 个"
+            << std::endl
+            << std::endl;
+}
+
+void test_parallel() {
+  std::cout << "=== 测试并行分解 ===" << std::endl;
+  std::mt19937_64 gen(3141);
+  std::vector<uint64_t> numbers(5000);
+  for (size_t i = 0; i < numbers.size(); i++) {
+    numbers[i] = i % 2 ? random_prime(32, gen) * random_prime(31, gen) : gen();
+    numbers[i] = numbers[i] == 0 ? 1 : numbers[i];
+  }
+  auto serial = PollardRho::factorize_all(numbers, 1);
+  auto parallel = PollardRho::factorize_all(numbers, 4);
+  std::cout << numbers.size() << " 个数：4线程批量分解与单线程"
+            << (serial == parallel ? "一致" : "不一致") << std::endl;
+
+  int seeds_ok = 0;
+  for (int t = 0; t < 20; t++) {
+    uint64_t p = random_prime(32, gen), q = random_prime(32, gen);
+    uint64_t d = PollardRho::find_factor_parallel(p * q, 4);
+    seeds_ok += d == p || d == q;
+  }
+  std::cout << "20 个半素数：4个种子并行找到素因子 " << seeds_ok << " 次"
+            << std::endl
+            << std::endl;
+}
+
+int main() {
+  std::cout << "第31章 整数分解演示程序" << std::endl;
+  std::cout << "=====================" << std::endl;
+
+  test_factorize();
+  test_parallel();
+
+  std::cout << "所有测试完成！" << std::endl;
+  return 0;
+}
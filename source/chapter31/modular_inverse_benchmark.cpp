@@ -0,0 +1,121 @@
+#include "number_theory_algorithms.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+void report(const char *name, double ms, size_t count, uint64_t checksum) {
+  std::cout << "  " << std::left << std::setw(30) << name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(9) << ms
+            << " ms  " << std::setprecision(1) << std::setw(7)
+            << 1e6 * ms / count << " ns/个  校验和 " << checksum << std::endl;
+}
+
+// 对照：每步一次 % 的欧几里得算法
+template <typename T> T euclid_gcd(T a, T b) {
+  while (b != 0) {
+    T t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: modular_inverse_benchmark [GCD对数] [批量求逆元素数]
+  size_t pairs = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  size_t batch = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 50000;
+  std::mt19937_64 gen(3170);
+
+  std::vector<uint64_t> a(pairs), b(pairs);
+  for (size_t i = 0; i < pairs; i++) {
+    a[i] = gen();
+    b[i] = gen();
+  }
+  for (int width : {32, 64}) {
+    std::cout << pairs << " 对随机 " << width << " 位整数的GCD" << std::endl;
+    uint64_t checksum = 0;
+    double ms;
+    if (width == 32) {
+      ms = time_ms([&] {
+        for (size_t i = 0; i < pairs; i++)
+          checksum += euclid_gcd(uint32_t(a[i]), uint32_t(b[i]));
+      });
+      report("欧几里得（%）", ms, pairs, checksum);
+      checksum = 0;
+      ms = time_ms([&] {
+        for (size_t i = 0; i < pairs; i++)
+          checksum +=
+              NumberTheoryAlgorithms::binary_gcd(uint32_t(a[i]), uint32_t(b[i]));
+      });
+    } else {
+      ms = time_ms([&] {
+        for (size_t i = 0; i < pairs; i++)
+          checksum += euclid_gcd(a[i], b[i]);
+      });
+      report("欧几里得（%）", ms, pairs, checksum);
+      checksum = 0;
+      ms = time_ms([&] {
+        for (size_t i = 0; i < pairs; i++)
+          checksum += NumberTheoryAlgorithms::binary_gcd(a[i], b[i]);
+      });
+    }
+    report("二进制GCD（ctz）", ms, pairs, checksum);
+  }
+
+  // 模素数求逆：逐个扩展欧几里得、逐个二进制、批量Montgomery技巧
+  const long long p = (1LL << 61) - 1;
+  std::vector<uint64_t> values(batch);
+  for (auto &x : values) {
+    x = gen() % (p - 1) + 1;
+  }
+  std::cout << batch << " 个元素模 2^61-1 求逆" << std::endl;
+  uint64_t checksum = 0;
+  double ms = time_ms([&] {
+    for (uint64_t x : values)
+      checksum += NumberTheoryAlgorithms::mod_inverse(static_cast<long long>(x), p);
+  });
+  report("扩展欧几里得（逐个）", ms, batch, checksum);
+  checksum = 0;
+  ms = time_ms([&] {
+    for (uint64_t x : values)
+      checksum += NumberTheoryAlgorithms::binary_mod_inverse(
+          static_cast<long long>(x), p);
+  });
+  report("二进制扩展欧几里得（逐个）", ms, batch, checksum);
+  checksum = 0;
+  ms = time_ms([&] {
+    for (uint64_t x : NumberTheoryAlgorithms::batch_mod_inverse(values, p))
+      checksum += x;
+  });
+  report("Montgomery技巧（批量）", ms, batch, checksum);
+
+  const uint64_t q = 18446744073709551557ULL; // 小于 2^64 的最大素数
+  std::cout << batch << " 个元素模 2^64-59 求逆" << std::endl;
+  checksum = 0;
+  ms = time_ms([&] {
+    for (uint64_t x : values)
+      checksum += NumberTheoryAlgorithms::binary_mod_inverse(x, q);
+  });
+  report("二进制扩展欧几里得（逐个）", ms, batch, checksum);
+  checksum = 0;
+  ms = time_ms([&] {
+    for (uint64_t x : NumberTheoryAlgorithms::batch_mod_inverse(values, q))
+      checksum += x;
+  });
+  report("Montgomery技巧（批量）", ms, batch, checksum);
+  return 0;
+}
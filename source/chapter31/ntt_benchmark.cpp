@@ -0,0 +1,51 @@
+#include "number_theoretic_transform.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace algorithms;
+
+int main(int argc, char *argv[]) {
+  // 用法: ntt_benchmark [序列长度] [线程数] [系数位数]
+  size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  size_t threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10)
+                            : std::max(1u, std::thread::hardware_concurrency());
+  int bits = argc > 3 ? std::atoi(argv[3]) : 20;
+
+  std::mt19937_64 gen(2024);
+  std::vector<uint64_t> a(n), b(n);
+  for (auto &x : a) {
+    x = gen() >> (64 - bits);
+  }
+  for (auto &x : b) {
+    x = gen() >> (64 - bits);
+  }
+
+  std::cout << "精确整数卷积: 两个长度为 " << n << " 的序列, 系数 < 2^" << bits
+            << ", 线程数 " << threads << std::endl;
+
+  auto start = std::chrono::high_resolution_clock::now();
+  std::vector<uint64_t> c = ExactConvolution::convolve(a, b, threads);
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::high_resolution_clock::now() - start)
+                       .count();
+  std::cout << "耗时: " << seconds << " 秒" << std::endl;
+
+  // 抽查若干系数（每个O(n)）
+  bool correct = true;
+  for (int sample = 0; sample < 5; sample++) {
+    size_t k = gen() % c.size();
+    unsigned __int128 sum = 0;
+    size_t low = k >= n ? k - n + 1 : 0;
+    for (size_t i = low; i <= k && i < n; i++) {
+      sum += static_cast<unsigned __int128>(a[i]) * b[k - i];
+    }
+    correct &= static_cast<uint64_t>(sum) == c[k];
+  }
+  std::cout << "抽查5个系数: " << (correct ? "全部精确" : "存在错误")
+            << std::endl;
+  return correct ? 0 : 1;
+}
@@ -1,7 +1,12 @@
+#include "number_theoretic_transform.h"
 #include "number_theory_algorithms.h"
+#include "polynomials_and_fft.h"
 #include <chrono>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <random>
+#include <tuple>
 #include <vector>
 
 using namespace algorithms;
@@ -310,6 +315,163 @@ void test_textbook_examples() {
             << std::endl;
 }
 
+/**
+ * @brief 测试数论变换（NTT）与三素数中国剩余定理的精确卷积
+ */
+void test_number_theoretic_transform() {
+  std::cout << "\n=== 数论变换（NTT）精确卷积测试 ===" << std::endl;
+
+  // 64位模运算：int版本在模数超过46341时乘法会溢出
+  long long p = 998244353;
+  std::cout << "3^(p-1) mod p = "
+            << NumberTheoryAlgorithms::mod_exponentiation(3LL, p - 1, p)
+            << "（费马小定理，应为1）" << std::endl;
+  std::cout << "3的模逆元: " << NumberTheoryAlgorithms::mod_inverse(3LL, p)
+            << std::endl;
+
+  // 与朴素卷积对照
+  std::mt19937_64 gen(31);
+  std::vector<uint64_t> a(500), b(700);
+  for (auto &x : a) {
+    x = gen() >> 34;
+  }
+  for (auto &x : b) {
+    x = gen() >> 34;
+  }
+  auto exact = ExactConvolution::convolve(a, b);
+  bool match = exact.size() == a.size() + b.size() - 1;
+  for (size_t k = 0; k < exact.size() && match; k++) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+      if (k >= i && k - i < b.size()) {
+        sum += a[i] * b[k - i];
+      }
+    }
+    match = sum == exact[k];
+  }
+  std::cout << "30位系数的卷积与朴素算法一致: " << (match ? "是" : "否")
+            << std::endl;
+
+  // 复数FFT在系数×长度超过约2^53后不再精确
+  size_t n = 1 << 15;
+  std::vector<double> coefficients(n);
+  std::vector<uint64_t> integers(n);
+  for (size_t i = 0; i < n; i++) {
+    integers[i] = 1000000 + gen() % 1000;
+    coefficients[i] = static_cast<double>(integers[i]);
+  }
+  PolynomialsAndFFT::Polynomial polynomial(coefficients);
+  auto fft_product =
+      PolynomialsAndFFT::fft_polynomial_multiply(polynomial, polynomial);
+  auto ntt_product = ExactConvolution::convolve(integers, integers);
+  size_t mismatches = 0;
+  for (size_t k = 0; k < ntt_product.size(); k++) {
+    mismatches += static_cast<uint64_t>(fft_product[k]) != ntt_product[k];
+  }
+  std::cout << "长度" << n << "、系数约10^6的自乘: FFT结果中有 " << mismatches
+            << " 个系数与精确值不同" << std::endl;
+
+  // 模998244353卷积与任意模数卷积
+  std::vector<uint32_t> small = {1, 2, 3}, other = {4, 5, 6};
+  auto modular = NTT998244353::convolve(small, other);
+  std::cout << "(1+2x+3x^2)(4+5x+6x^2) mod 998244353 = ";
+  for (uint32_t c : modular) {
+    std::cout << c << " ";
+  }
+  std::cout << std::endl;
+  std::vector<uint32_t> large = {4294967295u, 4294967295u};
+  auto mod_result = ExactConvolution::convolve_mod(large, large, 1000000007);
+  std::cout << "(2^32-1)^2 mod 1e9+7 = " << mod_result[0] << "（应为"
+            << static_cast<uint64_t>(
+                   static_cast<unsigned __int128>(4294967295u) * 4294967295u %
+                   1000000007)
+            << "）" << std::endl;
+
+  // 大整数乘法：(10^k - 1)^2 = 99..9800..01
+  std::vector<uint32_t> nines(2500, 9999); // 10^10000 - 1，基数10^4
+  auto square = ExactConvolution::multiply_integers(nines, nines, 10000);
+  bool pattern = square.size() == 5000 && square[0] == 1 && square[2500] == 9998;
+  for (size_t i = 1; i < 2500 && pattern; i++) {
+    pattern = square[i] == 0 && square[2500 + i] == 9999;
+  }
+  std::cout << "(10^10000 - 1)^2 的各位: " << (pattern ? "正确" : "错误")
+            << std::endl;
+
+  // 性能：长度10^6的精确卷积
+  std::vector<uint64_t> big_a(1000000), big_b(1000000);
+  for (auto &x : big_a) {
+    x = gen() >> 32;
+  }
+  for (auto &x : big_b) {
+    x = gen() >> 40;
+  }
+  performance_test("长度10^6的精确卷积（3个素数）",
+                   [&]() { ExactConvolution::convolve(big_a, big_b); });
+}
+
+/**
+ * @brief 测试二进制GCD、二进制模逆元与批量模逆元
+ */
+void test_binary_gcd_and_batch_inverse() {
+  std::cout << "\n=== 二进制GCD与批量模逆元测试 ===" << std::endl;
+  std::mt19937_64 gen(3160);
+
+  int gcd32_ok = 0, gcd64_ok = 0;
+  const int trials = 100000;
+  for (int i = 0; i < trials; ++i) {
+    int a = static_cast<int>(gen()), b = static_cast<int>(gen() >> 40);
+    gcd32_ok += NumberTheoryAlgorithms::binary_gcd(a, b) ==
+                NumberTheoryAlgorithms::gcd_iterative(a, b);
+    // 带上公共的2的幂和公因子
+    uint64_t k = (gen() % 1000 + 1) << (gen() % 8);
+    uint64_t x = (gen() >> 12) * k, y = (gen() >> 20) * k, u = x, v = y;
+    while (v != 0) {
+      uint64_t t = u % v;
+      u = v;
+      v = t;
+    }
+    gcd64_ok += NumberTheoryAlgorithms::binary_gcd(x, y) == u;
+  }
+  std::cout << trials << " 组随机数：32位二进制GCD正确 " << gcd32_ok
+            << "，64位正确 " << gcd64_ok << std::endl;
+
+  const long long p = (1LL << 61) - 1;
+  int inverse_ok = 0;
+  for (int i = 0; i < 10000; ++i) {
+    long long a = static_cast<long long>(gen() % (p - 1)) + 1;
+    inverse_ok += NumberTheoryAlgorithms::binary_mod_inverse(a, p) ==
+                  NumberTheoryAlgorithms::mod_inverse(a, p);
+  }
+  std::cout << "模 2^61-1 的二进制模逆元与扩展欧几里得一致 " << inverse_ok
+            << " / 10000" << std::endl;
+
+  // 64位素数模数上的批量求逆：逐个验证 a·a^{-1} ≡ 1
+  for (uint64_t m : {uint64_t(18446744073709551557ULL), uint64_t(1000003),
+                     uint64_t(3) * 5 * 7 * 11 * 13 * 1009}) {
+    std::vector<uint64_t> values;
+    while (values.size() < 50000) {
+      uint64_t a = gen();
+      if (NumberTheoryAlgorithms::binary_gcd(a % m, m) == 1)
+        values.push_back(a);
+    }
+    std::vector<uint64_t> inverses =
+        NumberTheoryAlgorithms::batch_mod_inverse(values, m);
+    size_t ok = 0;
+    for (size_t i = 0; i < values.size(); ++i) {
+      ok += static_cast<uint64_t>(static_cast<unsigned __int128>(values[i] % m) *
+                                  inverses[i] % m) == 1 % m;
+    }
+    std::cout << "模 " << m << " 批量求逆 " << values.size() << " 个，正确 "
+              << ok << " 个" << std::endl;
+  }
+  try {
+    NumberTheoryAlgorithms::batch_mod_inverse({3, 5, 21}, 35);
+    std::cout << "与模数不互素的元素未被发现" << std::endl;
+  } catch (const std::invalid_argument &e) {
+    std::cout << "含与模数不互素的元素: " << e.what() << std::endl;
+  }
+}
+
 int main() {
   std::cout << "=== 算法导论 第31章 - 数论算法演示 ===" << std::endl;
   std::cout << std::endl;
@@ -324,6 +486,9 @@ int main() {
     // 测试扩展欧几里得算法
     test_extended_gcd();
 
+    // 测试二进制GCD与批量模逆元
+    test_binary_gcd_and_batch_inverse();
+
     // 测试模运算
     test_modular_arithmetic();
 
@@ -339,6 +504,9 @@ int main() {
     // 测试RSA加密算法
     test_rsa_algorithm();
 
+    // 测试数论变换与精确卷积
+    test_number_theoretic_transform();
+
     std::cout << "\n=== 测试完成 ===" << std::endl;
 
   } catch (const std::exception &e) {
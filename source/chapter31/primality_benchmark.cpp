@@ -0,0 +1,85 @@
+#include "primality.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+void report(const char *name, double ms, double per_second, uint64_t result) {
+  std::cout << "  " << std::left << std::setw(28) << name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(10) << ms
+            << " ms  " << std::setprecision(2) << std::setw(8)
+            << per_second / 1e6 << " 百万/秒  结果 " << result << std::endl;
+}
+
+// 只存奇数的普通（不分段）字节筛，作为对照
+uint64_t count_simple(uint64_t limit) {
+  std::vector<uint8_t> composite(limit / 2, 0);
+  uint64_t total = limit > 2;
+  for (uint64_t i = 3; i < limit; i += 2) {
+    if (composite[i / 2])
+      continue;
+    total++;
+    for (uint64_t j = i * i; j < limit; j += 2 * i) {
+      composite[j / 2] = 1;
+    }
+  }
+  return total;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: primality_benchmark [候选数个数] [筛法上界]
+  size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  uint64_t limit = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000000;
+  std::mt19937_64 gen(3130);
+
+  for (int width : {32, 64}) {
+    std::vector<uint64_t> candidates(n);
+    for (auto &x : candidates) {
+      x = (width == 32 ? gen() >> 32 : gen()) | 1;
+    }
+    std::cout << n << " 个随机 " << width << " 位奇数" << std::endl;
+    uint64_t scalar_primes = 0, batch_primes = 0;
+    double ms = time_ms([&] {
+      for (uint64_t x : candidates) {
+        scalar_primes += MillerRabin::is_prime(x);
+      }
+    });
+    report("逐个测试", ms, n / ms * 1e3, scalar_primes);
+    std::vector<uint8_t> result;
+    ms = time_ms([&] { result = MillerRabin::is_prime_batch(candidates); });
+    for (uint8_t r : result) {
+      batch_primes += r;
+    }
+    report("批量测试", ms, n / ms * 1e3, batch_primes);
+  }
+
+  std::cout << "统计 " << limit << " 以内的素数" << std::endl;
+  uint64_t count = 0;
+  double ms = time_ms([&] { count = count_simple(limit); });
+  report("普通筛（只存奇数）", ms, limit / ms * 1e3, count);
+  ms = time_ms([&] { count = SegmentedSieve::count(0, limit); });
+  report("分段筛（模30轮子）计数", ms, limit / ms * 1e3, count);
+  uint64_t checksum = 0;
+  ms = time_ms([&] {
+    SegmentedSieve::for_each_prime(0, limit, [&](uint64_t p) { checksum += p; });
+  });
+  report("分段筛逐个枚举（求和）", ms, limit / ms * 1e3, checksum);
+
+  const uint64_t base = 10000000000000000ULL;
+  ms = time_ms([&] { count = SegmentedSieve::count(base, base + limit / 10); });
+  report("分段筛 [10^16, 10^16 + 上界/10)", ms, limit / 10 / ms * 1e3, count);
+  return 0;
+}
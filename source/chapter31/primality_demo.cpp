@@ -0,0 +1,148 @@
+#include "number_theory_algorithms.h"
+#include "primality.h"
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace algorithms;
+
+// 普通埃氏筛，作为对照
+std::vector<uint8_t> simple_sieve(uint64_t limit) {
+  std::vector<uint8_t> prime(limit, 1);
+  prime[0] = 0;
+  if (limit > 1)
+    prime[1] = 0;
+  for (uint64_t i = 2; i * i < limit; i++) {
+    if (!prime[i])
+      continue;
+    for (uint64_t j = i * i; j < limit; j += i) {
+      prime[j] = 0;
+    }
+  }
+  return prime;
+}
+
+void test_miller_rabin() {
+  std::cout << "=== 测试确定性Miller-Rabin ===" << std::endl;
+  const uint64_t limit = 2000000;
+  std::vector<uint8_t> expected = simple_sieve(limit);
+  std::vector<uint64_t> all(limit);
+  for (uint64_t i = 0; i < limit; i++) {
+    all[i] = i;
+  }
+  std::vector<uint8_t> batch = MillerRabin::is_prime_batch(all);
+  size_t scalar_agreed = 0, batch_agreed = 0;
+  for (uint64_t i = 0; i < limit; i++) {
+    scalar_agreed += MillerRabin::is_prime(i) == (expected[i] == 1);
+    batch_agreed += batch[i] == expected[i];
+  }
+  std::cout << "0~" << limit << " 与埃氏筛一致：逐个 " << scalar_agreed
+            << "，批量 " << batch_agreed << std::endl;
+
+  // 容易误判的合数：Carmichael数与多个底数的强伪素数
+  std::vector<uint64_t> tricky = {561,
+                                  1105,
+                                  1729,
+                                  2047,
+                                  3215031751ULL,
+                                  4759123141ULL,
+                                  1122004669633ULL,
+                                  3825123056546413051ULL,
+                                  18446744073709551615ULL,
+                                  (1ULL << 61) - 1,
+                                  18446744073709551557ULL,
+                                  4294967291ULL,
+                                  4294967297ULL};
+  std::vector<uint8_t> tricky_batch = MillerRabin::is_prime_batch(tricky);
+  for (size_t i = 0; i < tricky.size(); i++) {
+    std::cout << "  " << tricky[i] << ": "
+              << (MillerRabin::is_prime(tricky[i]) ? "素数" : "合数")
+              << (tricky_batch[i] == MillerRabin::is_prime(tricky[i])
+                      ? ""
+                      : "（批量结果不一致）")
+              << std::endl;
+  }
+
+  // 随机64位奇数：批量与逐个一致
+  std::mt19937_64 gen(3120);
+  std::vector<uint64_t> random(100000);
+  for (auto &x : random) {
+    x = gen() | 1;
+    if (&x - random.data() < 50000)
+      x >>= 32; // 一半落在32位的向量路径上
+  }
+  std::vector<uint8_t> random_batch = MillerRabin::is_prime_batch(random);
+  size_t agreed = 0, primes = 0;
+  for (size_t i = 0; i < random.size(); i++) {
+    agreed += random_batch[i] == MillerRabin::is_prime(random[i]);
+    primes += random_batch[i];
+  }
+  std::cout << random.size() << " 个随机奇数：批量与逐个一致 " << agreed
+            << "，其中素数 " << primes << " 个" << std::endl;
+
+  int old_agreed = 0;
+  for (int n = -10; n < 100000; n++) {
+    old_agreed += NumberTheoryAlgorithms::is_prime(n) ==
+                  (n >= 0 && expected[static_cast<size_t>(n)] == 1);
+  }
+  std::cout << "NumberTheoryAlgorithms::is_prime 在 [-10, 100000) 上正确 "
+            << old_agreed << " 次" << std::endl;
+  std::cout << "generate_prime(31) = " << NumberTheoryAlgorithms::generate_prime(31)
+            << std::endl
+            << std::endl;
+}
+
+void test_segmented_sieve() {
+  std::cout << "=== 测试模30轮子的分段筛 ===" << std::endl;
+  const uint64_t limit = 10000000;
+  std::vector<uint8_t> expected = simple_sieve(limit);
+  std::mt19937_64 gen(3121);
+  int agreed = 0;
+  const int trials = 200;
+  for (int t = 0; t < trials; t++) {
+    uint64_t low = gen() % limit, high = gen() % limit;
+    if (t % 4 == 0)
+      high = low + gen() % 100; // 很短的区间
+    if (low > high)
+      std::swap(low, high);
+    std::vector<uint64_t> sieved = SegmentedSieve::primes(low, high);
+    std::vector<uint64_t> reference;
+    for (uint64_t i = low; i < high; i++) {
+      if (expected[i])
+        reference.push_back(i);
+    }
+    agreed += sieved == reference &&
+              SegmentedSieve::count(low, high) == reference.size();
+  }
+  std::cout << trials << " 个 [0, 10^7) 内的随机区间与埃氏筛一致 " << agreed
+            << " 个" << std::endl;
+  std::cout << "π(10^8) = " << SegmentedSieve::count(0, 100000000)
+            << "（应为 5761455）" << std::endl;
+
+  // 远离原点的区间（大素数走分桶路径）：与Miller-Rabin对照
+  for (uint64_t base : {1000000000000ULL, 1000000000000000ULL}) {
+    std::vector<uint64_t> far = SegmentedSieve::primes(base, base + 1000000);
+    std::vector<uint64_t> reference;
+    for (uint64_t n = base; n < base + 1000000; n++) {
+      if (MillerRabin::is_prime(n))
+        reference.push_back(n);
+    }
+    std::cout << "[" << base << ", +10^6) 中的素数：分段筛 " << far.size()
+              << " 个，与Miller-Rabin" << (far == reference ? "一致" : "不一致")
+              << "，最小的是 " << far.front() << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+int main() {
+  std::cout << "第31章 素性测试与分段筛演示程序" << std::endl;
+  std::cout << "=============================" << std::endl;
+
+  test_miller_rabin();
+  test_segmented_sieve();
+
+  std::cout << "所有测试完成！" << std::endl;
+  return 0;
+}
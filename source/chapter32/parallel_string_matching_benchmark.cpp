@@ -0,0 +1,96 @@
+#include "string_matching.h"
+#include "work_stealing_scheduler.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace algorithms;
+
+/**
+ * @brief 生成类似日志的文本，偶尔插入一行要查找的错误信息
+ */
+std::string generate_log(std::size_t bytes, std::mt19937 &gen) {
+  const std::vector<std::string> words = {
+      "request", "served", "user",    "session", "cache",  "miss",
+      "latency", "retry",  "timeout", "ok",      "worker", "queue"};
+  std::string log;
+  log.reserve(bytes + 256);
+  while (log.size() < bytes) {
+    log += "2024-05-17T12:" + std::to_string(10 + gen() % 50) + " INFO ";
+    int count = 4 + gen() % 8;
+    for (int i = 0; i < count; i++) {
+      log += words[gen() % words.size()];
+      log += i + 1 < count ? ' ' : '\n';
+    }
+    if (gen() % 1000 == 0) {
+      log += "ERROR connection reset by peer\n";
+    }
+  }
+  log.resize(bytes);
+  return log;
+}
+
+template <typename Matcher>
+void run_matcher(const std::string &name, const std::string &text,
+                 const std::string &pattern,
+                 const std::vector<std::size_t> &thread_counts,
+                 bool &consistent) {
+  std::vector<std::size_t> serial;
+  auto start = std::chrono::high_resolution_clock::now();
+  Matcher::scan(text, pattern,
+                [&serial](std::size_t pos) { serial.push_back(pos); });
+  double serial_ms = std::chrono::duration<double, std::milli>(
+                         std::chrono::high_resolution_clock::now() - start)
+                         .count();
+  std::cout << name << " 串行 scan: " << serial_ms << " ms ("
+            << text.size() / 1000.0 / serial_ms << " MB/s), 命中 "
+            << serial.size() << std::endl;
+
+  for (std::size_t threads : thread_counts) {
+    WorkStealingScheduler scheduler(threads);
+    start = std::chrono::high_resolution_clock::now();
+    auto parallel =
+        ParallelStringMatcher<Matcher>::search(scheduler, text, pattern);
+    double ms = std::chrono::duration<double, std::milli>(
+                    std::chrono::high_resolution_clock::now() - start)
+                    .count();
+    bool same = parallel == serial;
+    consistent = consistent && same;
+    std::cout << "  " << threads << " 线程: " << ms << " ms, 加速比 "
+              << serial_ms / ms << (same ? "" : " (不一致)") << std::endl;
+  }
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: parallel_string_matching_benchmark [文本MB数]
+  std::size_t megabytes = argc > 1 ? std::atoi(argv[1]) : 64;
+  std::mt19937 gen(37);
+  std::string text = generate_log(megabytes << 20, gen);
+  std::string pattern = "connection reset";
+
+  std::vector<std::size_t> thread_counts = {1, 2, 4};
+  std::size_t hardware = std::thread::hardware_concurrency();
+  if (hardware > 4) {
+    thread_counts.push_back(hardware);
+  }
+
+  std::cout << "分块并行字符串匹配（块大小 "
+            << (ParallelStringMatcher<KMPMatcher>::kDefaultChunkSize >> 20)
+            << "MB，重叠 m-1 字节）" << std::endl;
+  std::cout << "文本: " << megabytes << "MB 日志, 模式 \"" << pattern
+            << "\", 硬件线程数 " << hardware << std::endl;
+
+  bool consistent = true;
+  run_matcher<KMPMatcher>("KMP", text, pattern, thread_counts, consistent);
+  run_matcher<FiniteAutomatonMatcher>("有限自动机", text, pattern,
+                                      thread_counts, consistent);
+  run_matcher<SimdStringMatcher>("SIMD过滤", text, pattern, thread_counts,
+                                 consistent);
+  std::cout << "结果一致: " << (consistent ? "是" : "否") << std::endl;
+
+  return consistent ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+#include "string_matching.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace algorithms;
+
+/**
+ * @brief 生成类似日志的文本：时间戳、级别与由常见单词组成的消息
+ */
+std::string generate_log(std::size_t bytes, std::mt19937 &gen) {
+  const std::vector<std::string> levels = {"INFO", "DEBUG", "WARN", "ERROR"};
+  const std::vector<std::string> words = {
+      "request", "served",  "user",   "session", "cache", "miss",
+      "latency", "backend", "retry",  "timeout", "ok",    "connection",
+      "closed",  "opened",  "worker", "queue",   "job",   "done"};
+  std::string log;
+  log.reserve(bytes + 256);
+  while (log.size() < bytes) {
+    log += "2024-05-17T12:" + std::to_string(10 + gen() % 50) + ":" +
+           std::to_string(10 + gen() % 50) + " " + levels[gen() % 4] + " ";
+    int count = 4 + gen() % 8;
+    for (int i = 0; i < count; i++) {
+      log += words[gen() % words.size()];
+      log += i + 1 < count ? ' ' : '\n';
+    }
+    if (gen() % 5000 == 0) {
+      log += "fatal: segfault in worker_pool::dispatch\n";
+    }
+  }
+  log.resize(bytes);
+  return log;
+}
+
+template <typename Search>
+void measure(const std::string &name, const std::string &text,
+             const std::string &pattern, Search search,
+             std::size_t &expected) {
+  auto start = std::chrono::high_resolution_clock::now();
+  std::size_t hits = search(text, pattern);
+  double ms = std::chrono::duration<double, std::milli>(
+                  std::chrono::high_resolution_clock::now() - start)
+                  .count();
+  std::cout << "  " << name << ": " << ms << " ms ("
+            << text.size() / 1000.0 / ms << " MB/s), 命中 " << hits
+            << (expected == static_cast<std::size_t>(-1) || hits == expected
+                    ? ""
+                    : " (不一致)")
+            << std::endl;
+  expected = hits;
+}
+
+void run_case(const std::string &title, const std::string &text,
+              const std::string &pattern, bool include_naive) {
+  std::cout << title << "，模式 \"" << pattern.substr(0, 40)
+            << (pattern.size() > 40 ? "..." : "") << "\"" << std::endl;
+  std::size_t expected = static_cast<std::size_t>(-1);
+  if (include_naive) {
+    measure("朴素算法", text, pattern,
+            [](const std::string &t, const std::string &p) {
+              return NaiveStringMatcher::search(t, p).size();
+            },
+            expected);
+  }
+  measure("KMP", text, pattern,
+          [](const std::string &t, const std::string &p) {
+            return KMPMatcher::search(t, p).size();
+          },
+          expected);
+  measure("std::string::find", text, pattern,
+          [](const std::string &t, const std::string &p) {
+            std::size_t hits = 0;
+            for (std::size_t pos = t.find(p); pos != std::string::npos;
+                 pos = t.find(p, pos + 1)) {
+              hits++;
+            }
+            return hits;
+          },
+          expected);
+  measure("Two-Way", text, pattern,
+          [](const std::string &t, const std::string &p) {
+            std::size_t hits = 0;
+            TwoWayMatcher::scan(t, p, [&hits](std::size_t) { hits++; });
+            return hits;
+          },
+          expected);
+  measure("SIMD过滤", text, pattern,
+          [](const std::string &t, const std::string &p) {
+            return SimdStringMatcher::count(t, p);
+          },
+          expected);
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: simd_string_matching_benchmark [文本MB数]
+  std::size_t megabytes = argc > 1 ? std::atoi(argv[1]) : 128;
+
+  std::mt19937 gen(17);
+  std::string log = generate_log(megabytes << 20, gen);
+  std::cout << "单模式匹配性能比较，日志大小 " << megabytes << " MB"
+            << std::endl;
+
+  run_case("稀有模式", log, "segfault", true);
+  run_case("常见前缀", log, "request served", true);
+  run_case("长模式", log, "fatal: segfault in worker_pool::dispatch", true);
+
+  // 对抗性输入：过滤不起作用，匹配处处重叠
+  std::string uniform(megabytes << 20, 'a');
+  run_case("对抗性输入 a^n", uniform, std::string(32, 'a'), false);
+  run_case("对抗性输入 a^n / a^31 b", uniform, std::string(31, 'a') + "b",
+           false);
+
+  return 0;
+}
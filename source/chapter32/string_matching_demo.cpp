@@ -1,6 +1,14 @@
+#include "aho_corasick.h"
+#include "mapped_text.h"
 #include "string_matching.h"
+#include "work_stealing_scheduler.h"
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <random>
 #include <string>
 #include <vector>
@@ -293,6 +301,219 @@ void test_edge_cases() {
   std::cout << std::endl;
 }
 
+// 64位滚动哈希与多模式Rabin-Karp测试
+void test_rolling_hash() {
+  std::cout << "=== 64位滚动哈希与多模式Rabin-Karp ===" << std::endl;
+
+  // 多模式：与逐个模式的 search 对拍
+  std::mt19937 gen(61);
+  std::string text(50000, 'a');
+  for (char &ch : text) {
+    ch = static_cast<char>('a' + gen() % 3);
+  }
+  std::vector<std::string> patterns;
+  for (int i = 0; i < 100; i++) {
+    std::size_t length = 3 + gen() % 4;
+    patterns.push_back(text.substr(gen() % (text.size() - length), length));
+  }
+  patterns.push_back("zzz"); // 不出现的模式
+  auto all = RabinKarpMatcher::search_multiple(text, patterns);
+  bool consistent = true;
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < patterns.size(); i++) {
+    consistent = consistent &&
+                 all[i] == KMPMatcher::search(text, patterns[i]);
+    total += all[i].size();
+  }
+  std::cout << "101个模式（4种长度）一遍扫描，共 " << total
+            << " 处匹配，与KMP对拍: " << (consistent ? "一致" : "不一致")
+            << std::endl;
+
+  // shingle 哈希：两段近似重复文本的 Jaccard 相似度
+  std::string doc1 = "the quick brown fox jumps over the lazy dog near the "
+                     "river bank at dawn";
+  std::string doc2 = "the quick brown fox jumped over the lazy dog near the "
+                     "river bank at dusk";
+  RollingHash shingles(5);
+  auto h1 = shingles.shingle_hashes(doc1);
+  auto h2 = shingles.shingle_hashes(doc2);
+  std::sort(h1.begin(), h1.end());
+  h1.erase(std::unique(h1.begin(), h1.end()), h1.end());
+  std::sort(h2.begin(), h2.end());
+  h2.erase(std::unique(h2.begin(), h2.end()), h2.end());
+  std::vector<std::uint64_t> common;
+  std::set_intersection(h1.begin(), h1.end(), h2.begin(), h2.end(),
+                        std::back_inserter(common));
+  double jaccard = static_cast<double>(common.size()) /
+                   (h1.size() + h2.size() - common.size());
+  std::cout << "5-gram shingle Jaccard 相似度: " << jaccard << std::endl;
+
+  std::cout << std::endl;
+}
+
+// Aho-Corasick多模式匹配测试
+void test_aho_corasick() {
+  std::cout << "=== Aho-Corasick多模式匹配 ===" << std::endl;
+
+  std::vector<std::string> patterns = {"he", "she", "his", "hers"};
+  AhoCorasickMatcher matcher(patterns);
+  std::string text = "ushers and his sheep";
+  std::cout << "文本: " << text << std::endl;
+  std::cout << "状态数: " << matcher.get_state_count()
+            << ", 字节类数: " << matcher.alphabet_classes() << std::endl;
+  std::cout << "匹配 (模式, 位置): ";
+  for (const auto &match : matcher.search(text)) {
+    std::cout << "(" << patterns[match.pattern_id] << ", " << match.offset
+              << ") ";
+  }
+  std::cout << std::endl;
+
+  // 与逐个模式运行KMP对拍
+  std::mt19937 gen(32);
+  std::vector<std::string> random_patterns;
+  for (int i = 0; i < 200; i++) {
+    std::string pattern(1 + gen() % 6, 'a');
+    for (char &ch : pattern) {
+      ch = static_cast<char>('a' + gen() % 4);
+    }
+    random_patterns.push_back(pattern);
+  }
+  std::string random_text(20000, 'a');
+  for (char &ch : random_text) {
+    ch = static_cast<char>('a' + gen() % 5);
+  }
+
+  std::vector<std::pair<std::size_t, int>> expected, actual;
+  for (int id = 0; id < static_cast<int>(random_patterns.size()); id++) {
+    for (int pos : KMPMatcher::search(random_text, random_patterns[id])) {
+      expected.emplace_back(pos, id);
+    }
+  }
+  AhoCorasickMatcher random_matcher(random_patterns);
+  for (const auto &match : random_matcher.search(random_text)) {
+    actual.emplace_back(match.offset, match.pattern_id);
+  }
+  std::sort(expected.begin(), expected.end());
+  std::sort(actual.begin(), actual.end());
+  std::cout << "与KMP逐个模式对拍（200个模式，" << expected.size()
+            << " 处匹配）: " << (expected == actual ? "一致" : "不一致")
+            << std::endl;
+
+  // 流式输入：按随机长度切块，跨块的匹配也要报告
+  auto stream = random_matcher.stream();
+  std::vector<std::pair<std::size_t, int>> streamed;
+  for (std::size_t pos = 0; pos < random_text.size();) {
+    std::size_t len = std::min<std::size_t>(1 + gen() % 7,
+                                            random_text.size() - pos);
+    stream.feed(std::string_view(random_text).substr(pos, len),
+                [&streamed](const AhoCorasickMatch &match) {
+                  streamed.emplace_back(match.offset, match.pattern_id);
+                });
+    pos += len;
+  }
+  std::sort(streamed.begin(), streamed.end());
+  std::cout << "分块 feed 结果: " << (streamed == actual ? "一致" : "不一致")
+            << std::endl;
+
+  std::cout << std::endl;
+}
+
+void test_mapped_text() {
+  std::cout << "=== 内存映射文本与回调式匹配 ===" << std::endl;
+
+  std::mt19937 gen(36);
+  std::string content(1 << 20, 'a');
+  for (char &ch : content) {
+    ch = static_cast<char>('a' + gen() % 4);
+  }
+  std::string pattern = "abcab";
+
+  std::string path = "mapped_text_demo.tmp";
+  {
+    std::ofstream out(path, std::ios::binary);
+    out.write(content.data(), static_cast<std::streamsize>(content.size()));
+  }
+
+  {
+    MappedText text(path);
+    std::cout << "映射文件大小: " << text.size() << " 字节" << std::endl;
+
+    // scan 按位置回调，不分配结果数组，偏移量为 std::size_t
+    std::vector<std::size_t> kmp_positions;
+    KMPMatcher::scan(text, pattern, [&kmp_positions](std::size_t pos) {
+      kmp_positions.push_back(pos);
+    });
+    std::size_t simd_count = 0;
+    bool simd_same = true;
+    SimdStringMatcher::scan(text, pattern, [&](std::size_t pos) {
+      simd_same = simd_same && simd_count < kmp_positions.size() &&
+                  kmp_positions[simd_count] == pos;
+      simd_count++;
+    });
+    simd_same = simd_same && simd_count == kmp_positions.size();
+
+    std::size_t rk_count = 0;
+    RabinKarpMatcher::scan(text, pattern,
+                           [&rk_count](std::size_t) { rk_count++; });
+
+    AhoCorasickMatcher matcher({pattern});
+    std::size_t ac_count = matcher.count(text);
+
+    std::vector<int> expected = KMPMatcher::search(content, pattern);
+    std::cout << "KMP scan 匹配数: " << kmp_positions.size() << " (std::string"
+              << " 上的 search: " << expected.size() << ")" << std::endl;
+    std::cout << "SIMD scan 逐位置一致: " << (simd_same ? "是" : "否")
+              << std::endl;
+    std::cout << "Rabin-Karp / Aho-Corasick 匹配数: " << rk_count << " / "
+              << ac_count << std::endl;
+  }
+  std::remove(path.c_str());
+
+  try {
+    MappedText missing("no_such_file.txt");
+  } catch (const std::runtime_error &e) {
+    std::cout << "打开不存在的文件: " << e.what() << std::endl;
+  }
+
+  std::cout << std::endl;
+}
+
+void test_parallel_chunked_search() {
+  std::cout << "=== 分块并行匹配 ===" << std::endl;
+
+  // 周期性模式在小块上运行，大量匹配跨越块边界
+  std::mt19937 gen(37);
+  std::string text(100000, 'a');
+  for (char &ch : text) {
+    ch = gen() % 8 == 0 ? 'b' : 'a';
+  }
+  std::string pattern = "aabaa";
+  std::vector<int> expected = KMPMatcher::search(text, pattern);
+
+  WorkStealingScheduler scheduler(4);
+  bool all_same = true;
+  for (std::size_t chunk_size : {1, 3, 7, 64, 4096}) {
+    auto kmp = ParallelStringMatcher<KMPMatcher>::search(scheduler, text,
+                                                          pattern, chunk_size);
+    auto fa = ParallelStringMatcher<FiniteAutomatonMatcher>::search(
+        scheduler, text, pattern, chunk_size);
+    auto simd = ParallelStringMatcher<SimdStringMatcher>::search(
+        scheduler, text, pattern, chunk_size);
+    all_same = all_same &&
+               std::equal(kmp.begin(), kmp.end(), expected.begin(),
+                          expected.end()) &&
+               kmp == fa && fa == simd;
+  }
+  std::cout << "块大小 1/3/7/64/4096 与串行KMP对拍（" << expected.size()
+            << " 处匹配）: " << (all_same ? "一致" : "不一致") << std::endl;
+  std::cout << "空模式匹配数: "
+            << ParallelStringMatcher<NaiveStringMatcher>::count(scheduler,
+                                                                "abc", "", 2)
+            << " (应该是 4)" << std::endl;
+
+  std::cout << std::endl;
+}
+
 int main() {
   std::cout << "算法导论第32章 字符串匹配演示程序" << std::endl;
   std::cout << "==================================" << std::endl;
@@ -308,6 +529,10 @@ int main() {
   test_performance_comparison();
   test_clrs_examples();
   test_edge_cases();
+  test_rolling_hash();
+  test_aho_corasick();
+  test_mapped_text();
+  test_parallel_chunked_search();
 
   std::cout << "所有测试完成!" << std::endl;
 
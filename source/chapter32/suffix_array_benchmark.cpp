@@ -0,0 +1,89 @@
+#include "string_matching.h"
+#include "suffix_array.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace algorithms;
+
+/**
+ * @brief 由常见单词组成的语料，查询取自语料中的单词组合
+ */
+std::string generate_corpus(std::size_t bytes, std::mt19937 &gen,
+                            const std::vector<std::string> &words) {
+  std::string corpus;
+  corpus.reserve(bytes + 32);
+  while (corpus.size() < bytes) {
+    corpus += words[gen() % words.size()];
+    corpus += gen() % 10 == 0 ? '\n' : ' ';
+  }
+  corpus.resize(bytes);
+  return corpus;
+}
+
+double elapsed_ms(std::chrono::high_resolution_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: suffix_array_benchmark [语料MB数] [查询数]
+  std::size_t megabytes = argc > 1 ? std::atoi(argv[1]) : 32;
+  std::size_t query_count = argc > 2 ? std::atoi(argv[2]) : 1000000;
+
+  const std::vector<std::string> words = {
+      "suffix", "array", "index", "query",  "corpus", "pattern",
+      "string", "match", "text",  "search", "lookup", "server",
+      "disk",   "map",   "build", "once",   "linear", "time"};
+  std::mt19937 gen(38);
+  std::string corpus = generate_corpus(megabytes << 20, gen, words);
+
+  std::vector<std::string> queries(query_count);
+  for (std::string &query : queries) {
+    query = words[gen() % words.size()] + " " + words[gen() % words.size()];
+    if (gen() % 2) {
+      query += " " + words[gen() % words.size()];
+    }
+  }
+
+  std::cout << "后缀数组子串索引性能测试" << std::endl;
+  std::cout << "语料: " << megabytes << "MB, 查询数: " << query_count
+            << std::endl;
+
+  auto start = std::chrono::high_resolution_clock::now();
+  SuffixArray index = SuffixArray::build(corpus);
+  double build_ms = elapsed_ms(start);
+  std::cout << "SA-IS + Kasai 构建: " << build_ms << " ms ("
+            << corpus.size() / 1000.0 / build_ms << " MB/s), 索引 "
+            << index.size_bytes() / (1 << 20) << " MB" << std::endl;
+
+  start = std::chrono::high_resolution_clock::now();
+  std::size_t total_hits = 0;
+  for (const std::string &query : queries) {
+    total_hits += index.count(query);
+  }
+  double query_ms = elapsed_ms(start);
+  std::cout << "后缀数组 count: " << query_ms << " ms, "
+            << query_count / query_ms * 1000.0 << " 次/秒, 总命中 "
+            << total_hits << std::endl;
+
+  // 同样的查询逐次扫描全文，只测前几个
+  std::size_t scan_queries = std::min<std::size_t>(query_count, 20);
+  std::size_t scan_hits = 0, index_hits = 0;
+  start = std::chrono::high_resolution_clock::now();
+  for (std::size_t i = 0; i < scan_queries; i++) {
+    scan_hits += SimdStringMatcher::count(corpus, queries[i]);
+  }
+  double scan_ms = elapsed_ms(start);
+  for (std::size_t i = 0; i < scan_queries; i++) {
+    index_hits += index.count(queries[i]);
+  }
+  std::cout << "SIMD逐次扫描: " << scan_ms / scan_queries << " ms/次"
+            << (scan_hits == index_hits ? "" : " (不一致)") << std::endl;
+
+  return scan_hits == index_hits ? 0 : 1;
+}
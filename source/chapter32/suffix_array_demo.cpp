@@ -0,0 +1,155 @@
+#include "mapped_text.h"
+#include "string_matching.h"
+#include "suffix_array.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace algorithms;
+
+void demo_small() {
+  std::cout << "=== banana的后缀数组 ===" << std::endl;
+  SuffixArray index = SuffixArray::build("banana");
+  for (std::size_t i = 0; i < index.size(); i++) {
+    std::cout << "sa[" << i << "] = " << index.suffix(i) << ", lcp = "
+              << index.lcp(i) << ", 后缀 " << index.text().substr(index.suffix(i))
+              << std::endl;
+  }
+  std::cout << "\"ana\" 出现位置: ";
+  for (std::size_t pos : index.locate("ana")) {
+    std::cout << pos << " ";
+  }
+  std::cout << "(应该是 1 3)" << std::endl;
+  std::cout << "最长重复子串: " << index.longest_repeated_substring()
+            << " (应该是 ana)" << std::endl;
+}
+
+std::string random_text(std::size_t length, int alphabet, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::string text(length, 'a');
+  for (char &ch : text) {
+    ch = static_cast<char>('a' + gen() % alphabet);
+  }
+  return text;
+}
+
+void check_against_kmp() {
+  std::cout << "\n=== 与KMP对拍 ===" << std::endl;
+  std::mt19937 gen(38);
+  bool ok = true;
+  for (int round = 0; round < 200 && ok; round++) {
+    std::string text = random_text(1 + gen() % 2000, 1 + gen() % 4, gen());
+    SuffixArray index = SuffixArray::build(text);
+    for (int q = 0; q < 20; q++) {
+      std::string pattern =
+          text.substr(gen() % text.size(), 1 + gen() % 6) + (q % 3 ? "" : "a");
+      std::vector<int> expected = KMPMatcher::search(text, pattern);
+      std::vector<std::size_t> actual = index.locate(pattern);
+      ok = ok && std::equal(expected.begin(), expected.end(), actual.begin(),
+                            actual.end());
+    }
+  }
+  std::cout << "200段随机文本 × 20个模式: " << (ok ? "一致" : "不一致")
+            << std::endl;
+}
+
+void demo_persisted_index() {
+  std::cout << "\n=== 写入磁盘并mmap加载 ===" << std::endl;
+  std::string text = random_text(4 << 20, 4, 7);
+  auto start = std::chrono::high_resolution_clock::now();
+  SuffixArray built = SuffixArray::build(text);
+  double build_ms = std::chrono::duration<double, std::milli>(
+                        std::chrono::high_resolution_clock::now() - start)
+                        .count();
+  std::cout << "4MB文本 SA-IS + Kasai 构建: " << build_ms << " ms, 索引 "
+            << built.size_bytes() / (1 << 20) << " MB" << std::endl;
+
+  std::string path = "suffix_array_demo.idx";
+  {
+    std::ofstream out(path, std::ios::binary);
+    built.save(out);
+  }
+
+  {
+    MappedText file(path);
+    SuffixArray loaded = SuffixArray::load(file.data(), file.size());
+    std::mt19937 gen(1);
+    bool same = loaded.text() == text;
+    for (int q = 0; q < 1000; q++) {
+      std::string pattern = random_text(4 + gen() % 8, 4, gen());
+      same = same && loaded.count(pattern) == built.count(pattern);
+    }
+    std::cout << "加载后 1000 次查询结果: " << (same ? "一致" : "不一致")
+              << std::endl;
+  }
+  std::remove(path.c_str());
+
+  try {
+    char garbage[64] = {};
+    SuffixArray::load(garbage, sizeof(garbage));
+  } catch (const std::invalid_argument &e) {
+    std::cout << "加载无效缓冲区: " << e.what() << std::endl;
+  }
+
+  // 文本长度为 2^64 - 1 时字数计算回绕成只有头部的4个字，必须被拒绝
+  std::uint64_t forged[4];
+  std::memcpy(forged, built.data(), 2 * sizeof(std::uint64_t));
+  forged[2] = ~std::uint64_t(0);
+  forged[3] = 4;
+  try {
+    SuffixArray::load(forged, sizeof(forged));
+    throw std::runtime_error("文本长度溢出的缓冲区被接受");
+  } catch (const std::invalid_argument &e) {
+    std::cout << "加载文本长度溢出的缓冲区: " << e.what() << std::endl;
+  }
+
+  // 头部正确但SA重复、SA越界或LCP过大的缓冲区也必须被拒绝
+  SuffixArray small = SuffixArray::build("mississippi");
+  std::size_t words = small.size_bytes() / sizeof(std::uint64_t);
+  std::size_t n = small.size();
+  std::size_t sa_offset = 4 + (n + 7) / 8, lcp_offset = (n + 1) / 2 * 2;
+  struct Corruption {
+    const char *name;
+    std::size_t index; // 在SA（前n个）与LCP（后n个）拼接后的下标
+    std::uint32_t value;
+  };
+  const Corruption corruptions[] = {
+      {"SA有重复", 3, small.suffix(4)},
+      {"SA越界", 5, static_cast<std::uint32_t>(n)},
+      {"LCP[0]非0", n, 1},
+      {"LCP超出后缀长度", n + 1, static_cast<std::uint32_t>(n)}};
+  for (const auto &corruption : corruptions) {
+    std::vector<std::uint64_t> copy(words);
+    std::memcpy(copy.data(), small.data(), small.size_bytes());
+    auto *arrays = reinterpret_cast<std::uint32_t *>(copy.data() + sa_offset);
+    std::size_t index = corruption.index < n
+                            ? corruption.index
+                            : lcp_offset + (corruption.index - n);
+    arrays[index] = corruption.value;
+    try {
+      SuffixArray::load(copy.data(), small.size_bytes());
+      throw std::runtime_error(std::string(corruption.name) + "的缓冲区被接受");
+    } catch (const std::invalid_argument &e) {
+      std::cout << "加载" << corruption.name << "的缓冲区: " << e.what()
+                << std::endl;
+    }
+  }
+}
+
+int main() {
+  std::cout << "算法导论第32章 后缀数组演示程序" << std::endl;
+  std::cout << "================================" << std::endl;
+
+  demo_small();
+  check_against_kmp();
+  demo_persisted_index();
+
+  return 0;
+}
@@ -1,7 +1,10 @@
 #include "computational_geometry.h"
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <iostream>
 #include <random>
+#include <utility>
 #include <vector>
 
 using namespace algorithms;
@@ -149,6 +152,103 @@ void test_convex_hull() {
   std::cout << std::endl;
 }
 
+bool same_points(const std::vector<Point> &a, const std::vector<Point> &b) {
+  if (a.size() != b.size())
+    return false;
+  for (size_t i = 0; i < a.size(); i++) {
+    if (a[i] != b[i])
+      return false;
+  }
+  return true;
+}
+
+// 测试单调链与并行QuickHull
+void test_monotone_chain_and_quick_hull() {
+  std::cout << "=== 测试单调链与并行QuickHull (33.3) ===" << std::endl;
+
+  std::mt19937 gen(333);
+  std::uniform_real_distribution<> uniform(-1.0, 1.0);
+  std::uniform_int_distribution<int> lattice(0, 20);
+  std::normal_distribution<> step(0.0, 1.0);
+
+  struct Case {
+    const char *name;
+    std::vector<Point> points;
+  };
+  std::vector<Case> cases;
+  // 小规模点集上与Jarvis步进对照
+  std::vector<Point> small;
+  for (int i = 0; i < 200; i++) {
+    small.push_back(Point(uniform(gen), uniform(gen)));
+  }
+  cases.push_back({"200个随机点", small});
+  // 整数格点：大量共线点与重复点
+  std::vector<Point> grid;
+  for (int i = 0; i < 100000; i++) {
+    grid.push_back(Point(lattice(gen), lattice(gen)));
+  }
+  cases.push_back({"10万个格点（共线/重复）", grid});
+  // 所有点都在凸包上，预过滤不起作用
+  std::vector<Point> circle;
+  for (int i = 0; i < 10000; i++) {
+    double angle = 2 * M_PI * uniform(gen);
+    circle.push_back(Point(std::cos(angle), std::sin(angle)));
+  }
+  cases.push_back({"1万个圆周上的点", circle});
+  // 随机游走轨迹（类似GPS轨迹）
+  std::vector<Point> trace;
+  Point position(116.4, 39.9);
+  for (int i = 0; i < 1000000; i++) {
+    position.x += 1e-4 * step(gen);
+    position.y += 1e-4 * step(gen);
+    trace.push_back(position);
+  }
+  cases.push_back({"100万点随机游走轨迹", trace});
+  std::vector<Point> square;
+  for (int i = 0; i < 1000000; i++) {
+    square.push_back(Point(uniform(gen), uniform(gen)));
+  }
+  cases.push_back({"100万个正方形内均匀点", square});
+  // 退化情况
+  cases.push_back({"单点重复", std::vector<Point>(5, Point(1, 1))});
+  cases.push_back({"共线点", {Point(3, 3), Point(1, 1), Point(2, 2),
+                              Point(0, 0), Point(2, 2)}});
+
+  for (const auto &c : cases) {
+    PointSet set(c.points);
+    auto start = std::chrono::high_resolution_clock::now();
+    auto serial = ConvexHull::monotone_chain(c.points);
+    auto middle = std::chrono::high_resolution_clock::now();
+    auto filtered = ConvexHull::monotone_chain(set);
+    auto middle2 = std::chrono::high_resolution_clock::now();
+    auto quick = ConvexHull::quick_hull(set);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    std::cout << c.name << ": 凸包顶点 " << serial.size() << "，单调链 "
+              << std::chrono::duration<double, std::milli>(middle - start)
+                     .count()
+              << " ms，预过滤单调链 "
+              << std::chrono::duration<double, std::milli>(middle2 - middle)
+                     .count()
+              << " ms，QuickHull "
+              << std::chrono::duration<double, std::milli>(end - middle2)
+                     .count()
+              << " ms，结果一致: "
+              << (same_points(serial, filtered) && same_points(serial, quick)
+                      ? "是"
+                      : "否")
+              << std::endl;
+  }
+
+  // Jarvis步进返回从最左点开始的逆时针凸包，起点与单调链相同
+  auto jarvis = ConvexHull::jarvis_march(small);
+  std::cout << "200个随机点上与Jarvis步进一致: "
+            << (same_points(jarvis, ConvexHull::monotone_chain(small)) ? "是"
+                                                                       : "否")
+            << std::endl;
+  std::cout << std::endl;
+}
+
 // 测试最近点对算法
 void test_closest_pair() {
   std::cout << "=== 测试最近点对算法 (33.4) ===" << std::endl;
@@ -248,6 +348,97 @@ void test_segment_intersection() {
   std::cout << std::endl;
 }
 
+// 按下标排序的相交线段对
+std::vector<std::pair<size_t, size_t>>
+sorted_pairs(const std::vector<SegmentCrossing> &crossings) {
+  std::vector<std::pair<size_t, size_t>> pairs;
+  for (const auto &c : crossings) {
+    pairs.emplace_back(c.first, c.second);
+  }
+  std::sort(pairs.begin(), pairs.end());
+  return pairs;
+}
+
+// 用精确谓词逐对检查，作为对照
+std::vector<std::pair<size_t, size_t>>
+brute_force_pairs(const std::vector<Segment> &segments) {
+  std::vector<std::pair<size_t, size_t>> pairs;
+  for (size_t i = 0; i < segments.size(); i++) {
+    for (size_t j = i + 1; j < segments.size(); j++) {
+      if (RobustPredicates::segments_intersect(segments[i], segments[j])) {
+        pairs.emplace_back(i, j);
+      }
+    }
+  }
+  return pairs;
+}
+
+void test_bentley_ottmann() {
+  std::cout << "=== 测试Bentley–Ottmann扫描线 (33.2) ===" << std::endl;
+
+  // 几乎共线的三点：浮点叉积的符号随坐标的最后一位跳变
+  int wrong = 0;
+  const double ulp = std::ldexp(1.0, -53);
+  for (int i = 0; i < 256; i++) {
+    for (int j = 0; j < 256; j++) {
+      Point p(0.5 + i * ulp, 0.5 + j * ulp), q(12, 12), r(24, 24);
+      double naive = SegmentProperties::cross_product(q, r, p);
+      int sign = (naive > 0) - (naive < 0);
+      wrong += sign != RobustPredicates::orientation(q, r, p);
+    }
+  }
+  std::cout << "256×256 个几乎共线的点中，浮点叉积符号与精确结果不同的有 "
+            << wrong << " 个" << std::endl;
+
+  std::vector<Segment> segments = {
+      Segment(Point(0, 0), Point(4, 4)), Segment(Point(0, 4), Point(4, 0)),
+      Segment(Point(1, 1), Point(3, 3)), Segment(Point(5, 5), Point(7, 7)),
+      Segment(Point(0, 2), Point(4, 2)), Segment(Point(2, 0), Point(2, 4))};
+  auto crossings = SegmentIntersection::bentley_ottmann(segments);
+  std::cout << "上一节的线段集合，找到 " << crossings.size()
+            << " 对相交线段:" << std::endl;
+  for (const auto &c : crossings) {
+    std::cout << "  s" << c.first + 1 << " 与 s" << c.second + 1 << " 交于 ("
+              << c.point.x << "," << c.point.y << ")" << std::endl;
+  }
+
+  // 随机线段、整数网格（大量共线、重叠与公共端点）、几乎平行的线段
+  std::mt19937 gen(335);
+  std::uniform_real_distribution<> unit(0.0, 1.0);
+  std::uniform_int_distribution<int> grid(0, 8);
+  const char *names[] = {"随机线段", "整数网格", "几乎平行"};
+  for (int kind = 0; kind < 3; kind++) {
+    int trials = 0, agreed = 0;
+    size_t pairs = 0;
+    for (int trial = 0; trial < 100; trial++) {
+      std::vector<Segment> input;
+      int n = 20 + trial * 3;
+      for (int i = 0; i < n; i++) {
+        if (kind == 0) {
+          input.push_back(Segment(Point(unit(gen), unit(gen)),
+                                  Point(unit(gen), unit(gen))));
+        } else if (kind == 1) {
+          input.push_back(Segment(Point(grid(gen), grid(gen)),
+                                  Point(grid(gen), grid(gen))));
+        } else {
+          double a = unit(gen), b = unit(gen);
+          input.push_back(Segment(Point(a, 0.3 * a + 0.1),
+                                  Point(b, 0.3 * b + 0.1 + 1e-15 * unit(gen))));
+        }
+      }
+      auto expected = brute_force_pairs(input);
+      trials++;
+      agreed += sorted_pairs(SegmentIntersection::bentley_ottmann(input)) ==
+                expected;
+      pairs += expected.size();
+    }
+    std::cout << names[kind] << "：" << trials << " 组，与逐对检查一致 "
+              << agreed << " 组，共 " << pairs << " 对相交" << std::endl;
+  }
+
+  std::cout << std::endl;
+}
+
 // 性能测试
 void performance_test() {
   std::cout << "=== 性能测试 ===" << std::endl;
@@ -298,8 +489,10 @@ int main() {
     test_segment_properties();
     test_point_in_polygon();
     test_convex_hull();
+    test_monotone_chain_and_quick_hull();
     test_closest_pair();
     test_segment_intersection();
+    test_bentley_ottmann();
     performance_test();
 
     std::cout << "所有测试完成!" << std::endl;
@@ -0,0 +1,94 @@
+#include "computational_geometry.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+void report(const char *name, double ms, size_t hull_size) {
+  std::cout << "  " << std::left << std::setw(26) << name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(10) << ms
+            << " ms  凸包顶点 " << hull_size << std::endl;
+}
+
+bool same_points(const std::vector<Point> &a, const std::vector<Point> &b) {
+  if (a.size() != b.size())
+    return false;
+  for (size_t i = 0; i < a.size(); i++) {
+    if (a[i] != b[i])
+      return false;
+  }
+  return true;
+}
+
+void run(const std::string &name, const PointSet &set, size_t threads,
+         bool with_serial) {
+  std::cout << name << "（" << set.size() << " 个点，线程 " << threads << "）"
+            << std::endl;
+  std::vector<Point> graham, serial, filtered, quick;
+  double ms;
+  if (with_serial) {
+    std::vector<Point> points = set.to_points();
+    ms = time_ms([&] { graham = ConvexHull::graham_scan(points); });
+    report("Graham扫描（极角排序）", ms, graham.size());
+    ms = time_ms([&] { serial = ConvexHull::monotone_chain(points); });
+    report("单调链（std::sort）", ms, serial.size());
+  }
+  ms = time_ms([&] { filtered = ConvexHull::monotone_chain(set, threads); });
+  report("预过滤+并行排序单调链", ms, filtered.size());
+  ms = time_ms([&] { quick = ConvexHull::quick_hull(set, threads); });
+  report("并行QuickHull", ms, quick.size());
+  std::cout << "  结果一致: "
+            << (same_points(filtered, quick) &&
+                        (!with_serial || same_points(serial, quick))
+                    ? "是"
+                    : "否")
+            << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: convex_hull_benchmark [点数] [线程数]
+  size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  size_t threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10)
+                            : std::thread::hardware_concurrency();
+  threads = threads == 0 ? 1 : threads;
+  // 串行基线（Graham扫描与std::sort单调链）需要一份std::vector<Point>，
+  // 只在千万点以内运行
+  bool with_serial = n <= 10000000;
+
+  std::mt19937 gen(2333);
+  std::uniform_real_distribution<> uniform(0.0, 1.0);
+  PointSet square;
+  square.reserve(n);
+  for (size_t i = 0; i < n; i++) {
+    square.push_back(Point(uniform(gen), uniform(gen)));
+  }
+  run("正方形内均匀分布", square, threads, with_serial);
+  square = PointSet();
+
+  // GPS轨迹：经纬度上的随机游走，每步约十米
+  std::normal_distribution<> step(0.0, 1e-4);
+  PointSet trace;
+  trace.reserve(n);
+  Point position(116.4, 39.9);
+  for (size_t i = 0; i < n; i++) {
+    position.x += step(gen);
+    position.y += step(gen);
+    trace.push_back(position);
+  }
+  run("随机游走轨迹", trace, threads, with_serial);
+  return 0;
+}
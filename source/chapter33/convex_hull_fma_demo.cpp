@@ -0,0 +1,86 @@
+#include "computational_geometry.h"
+#include "cpu_features.h"
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace algorithms;
+
+// 本程序由CMake以 -mfma -ffp-contract=fast 编译：编译器会把 a·b + c·d 融合成FMA，
+// right_key(a, c, c) 与 cross_product(p, q, q) 不再恰好为0
+
+// 用精确方向判定的单调链，作为对照
+std::vector<Point> reference_hull(std::vector<Point> points) {
+  std::sort(points.begin(), points.end(), [](const Point &a, const Point &b) {
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+  });
+  points.erase(std::unique(points.begin(), points.end(),
+                           [](const Point &a, const Point &b) {
+                             return a.x == b.x && a.y == b.y;
+                           }),
+               points.end());
+  if (points.size() < 3)
+    return points;
+  std::vector<Point> hull(2 * points.size());
+  size_t k = 0;
+  for (size_t i = 0; i < points.size(); i++) {
+    while (k >= 2 && RobustPredicates::orientation(hull[k - 2], hull[k - 1],
+                                                   points[i]) <= 0)
+      k--;
+    hull[k++] = points[i];
+  }
+  for (size_t i = points.size() - 1, lower = k + 1; i-- > 0;) {
+    while (k >= lower && RobustPredicates::orientation(hull[k - 2], hull[k - 1],
+                                                       points[i]) <= 0)
+      k--;
+    hull[k++] = points[i];
+  }
+  hull.resize(k - 1);
+  return hull;
+}
+
+bool same_hull(const std::vector<Point> &a, const std::vector<Point> &b) {
+  if (a.size() != b.size())
+    return false;
+  for (size_t i = 0; i < a.size(); i++) {
+    if (a[i].x != b[i].x || a[i].y != b[i].y)
+      return false;
+  }
+  return true;
+}
+
+int main() {
+#if defined(__x86_64__) && defined(__FMA__)
+  if (!CpuFeatures::fma()) {
+    std::cout << "CPU不支持FMA，跳过" << std::endl;
+    return 0;
+  }
+#endif
+  std::cout << "融合乘加下的凸包测试" << std::endl;
+  std::cout << "====================" << std::endl;
+
+  std::mt19937 gen(33);
+  std::uniform_real_distribution<double> uniform(0, 1);
+  size_t checked = 0;
+  for (int trial = 0; trial < 2000; trial++) {
+    std::vector<Point> points;
+    for (int i = 0; i < 3 + trial % 200; i++) {
+      points.push_back(Point(uniform(gen), uniform(gen)));
+    }
+    // 一部分实例带重复点
+    if (trial % 3 == 0) {
+      points.insert(points.end(), points.begin(), points.begin() + points.size() / 2);
+    }
+    std::vector<Point> expected = reference_hull(points);
+    if (!same_hull(ConvexHull::quick_hull(points, 2), expected) ||
+        !same_hull(ConvexHull::monotone_chain(PointSet(points), 2), expected)) {
+      throw std::runtime_error("convex hull mismatch under FMA");
+    }
+    checked++;
+  }
+  std::cout << checked << " 个随机点集（3–202个点，部分含重复点）上QuickHull与"
+            << "预过滤单调链都与精确判定的单调链一致" << std::endl;
+  return 0;
+}
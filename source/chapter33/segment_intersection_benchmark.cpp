@@ -0,0 +1,116 @@
+#include "computational_geometry.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+void report(const char *name, double ms, size_t pairs) {
+  std::cout << "  " << std::left << std::setw(24) << name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(10) << ms
+            << " ms  相交线段对 " << pairs << std::endl;
+}
+
+// 一层地图：m×m 个抖动网格点，相邻点连成边，层内只在公共端点处相交。
+// 两层的网格旋转角度不同，叠加后边与边大量交叉
+void add_layer(std::vector<Segment> &segments, int m, double angle,
+               std::mt19937 &gen) {
+  std::uniform_real_distribution<double> jitter(-0.3, 0.3);
+  double c = std::cos(angle), s = std::sin(angle);
+  std::vector<Point> grid(static_cast<size_t>(m) * m);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < m; j++) {
+      double x = i + jitter(gen), y = j + jitter(gen);
+      grid[static_cast<size_t>(i) * m + j] = Point(c * x - s * y, s * x + c * y);
+    }
+  }
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < m; j++) {
+      const Point &p = grid[static_cast<size_t>(i) * m + j];
+      if (i + 1 < m)
+        segments.push_back(Segment(p, grid[static_cast<size_t>(i + 1) * m + j]));
+      if (j + 1 < m)
+        segments.push_back(Segment(p, grid[static_cast<size_t>(i) * m + j + 1]));
+    }
+  }
+}
+
+std::vector<std::pair<size_t, size_t>>
+sorted_pairs(const std::vector<SegmentCrossing> &crossings) {
+  std::vector<std::pair<size_t, size_t>> pairs;
+  for (const auto &c : crossings) {
+    pairs.emplace_back(c.first, c.second);
+  }
+  std::sort(pairs.begin(), pairs.end());
+  return pairs;
+}
+
+std::vector<std::pair<size_t, size_t>>
+brute_force_pairs(const std::vector<Segment> &segments) {
+  std::vector<std::pair<size_t, size_t>> pairs;
+  for (size_t i = 0; i < segments.size(); i++) {
+    for (size_t j = i + 1; j < segments.size(); j++) {
+      if (RobustPredicates::segments_intersect(segments[i], segments[j])) {
+        pairs.emplace_back(i, j);
+      }
+    }
+  }
+  return pairs;
+}
+
+std::vector<Segment> overlay(size_t n, std::mt19937 &gen) {
+  // 每层约 2m² 条边，两层合计约 n 条
+  int m = std::max(2, static_cast<int>(std::sqrt(n / 4.0)));
+  std::vector<Segment> segments;
+  segments.reserve(4 * static_cast<size_t>(m) * m);
+  add_layer(segments, m, 0.0, gen);
+  add_layer(segments, m, 0.37, gen);
+  return segments;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: segment_intersection_benchmark [线段数，例如 5000000]
+  size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  std::mt19937 gen(3352);
+
+  // 小规模时与逐对检查对照
+  std::cout << "小规模对照" << std::endl;
+  for (size_t small : {size_t(2000), size_t(20000)}) {
+    std::vector<Segment> segments = overlay(small, gen);
+    std::vector<std::pair<size_t, size_t>> sweep, brute;
+    double sweep_ms = time_ms([&] {
+      sweep = sorted_pairs(SegmentIntersection::bentley_ottmann(segments));
+    });
+    double brute_ms = time_ms([&] { brute = brute_force_pairs(segments); });
+    std::cout << " " << segments.size() << " 条线段" << std::endl;
+    report("逐对检查 O(n²)", brute_ms, brute.size());
+    report("Bentley–Ottmann", sweep_ms, sweep.size());
+    std::cout << "  结果一致: " << (sweep == brute ? "是" : "否") << std::endl;
+  }
+
+  std::vector<Segment> segments = overlay(n, gen);
+  std::cout << "地图叠加：两层旋转的抖动网格，共 " << segments.size()
+            << " 条线段" << std::endl;
+  std::vector<SegmentCrossing> crossings;
+  double ms = time_ms(
+      [&] { crossings = SegmentIntersection::bentley_ottmann(segments); });
+  report("Bentley–Ottmann", ms, crossings.size());
+  std::cout << "  每条线段 " << std::setprecision(2)
+            << 1e6 * ms / segments.size() << " ns，每个相交对 "
+            << 1e6 * ms / crossings.size() << " ns" << std::endl;
+  return 0;
+}
@@ -0,0 +1,155 @@
+#include "computational_geometry.h"
+#include "spatial_index.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace algorithms;
+
+template <typename F> double time_ms(F f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+void report(const char *name, double ms, double per_second) {
+  std::cout << "  " << std::left << std::setw(30) << name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(10) << ms
+            << " ms  " << std::setprecision(2) << std::setw(8)
+            << per_second / 1e6 << " 百万次/秒" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  // 用法: spatial_index_benchmark [查询点数] [多边形数] [线程数]
+  size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  size_t polygon_count = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 10000;
+  size_t threads = argc > 3 ? std::strtoul(argv[3], nullptr, 10)
+                            : std::thread::hardware_concurrency();
+  threads = threads == 0 ? 1 : threads;
+  std::mt19937 gen(3304);
+  std::uniform_real_distribution<double> unit(0.0, 1000.0), scale(0.4, 1.0);
+  std::uniform_int_distribution<int> vertex_count(8, 64);
+
+  // 地理围栏：1000×1000 区域内的星形多边形，半径 3~10，彼此偶有重叠
+  std::vector<std::vector<Point>> polygons(polygon_count);
+  size_t edge_total = 0;
+  for (auto &polygon : polygons) {
+    Point c(unit(gen), unit(gen));
+    double radius = 3 + unit(gen) / 140;
+    int m = vertex_count(gen);
+    for (int k = 0; k < m; k++) {
+      double angle = 2 * M_PI * k / m, r = radius * scale(gen);
+      polygon.push_back(
+          Point(c.x + r * std::cos(angle), c.y + r * std::sin(angle)));
+    }
+    edge_total += m;
+  }
+  std::vector<Point> points(n);
+  for (auto &p : points) {
+    p = Point(unit(gen), unit(gen));
+  }
+  std::cout << "地理围栏：" << polygon_count << " 个多边形（" << edge_total
+            << " 条边），" << n << " 个查询点，线程 " << threads << std::endl;
+
+  // 对照1：逐个多边形先比较外接矩形再用射线法，只测一小部分点
+  std::vector<Box> polygon_boxes(polygon_count);
+  for (size_t i = 0; i < polygon_count; i++) {
+    for (const Point &p : polygons[i]) {
+      polygon_boxes[i].expand(Box::of(p));
+    }
+  }
+  size_t sample = std::min<size_t>(n, 20000);
+  std::vector<int64_t> naive(sample, -1);
+  double ms = time_ms([&] {
+    for (size_t i = 0; i < sample; i++) {
+      for (size_t k = 0; k < polygon_count; k++) {
+        if (polygon_boxes[k].contains(points[i]) &&
+            PointInPolygon::is_point_in_polygon(points[i], polygons[k])) {
+          naive[i] = static_cast<int64_t>(k);
+          break;
+        }
+      }
+    }
+  });
+  report("外接矩形+射线法（逐个多边形）", ms, sample / ms * 1e3);
+
+  // 对照2：多边形外接矩形建R树（以对角线线段表示），候选再用射线法
+  std::vector<Segment> diagonals;
+  for (const Box &box : polygon_boxes) {
+    diagonals.push_back(
+        Segment(Point(box.min_x, box.min_y), Point(box.max_x, box.max_y)));
+  }
+  RTree<Segment> box_tree(diagonals);
+  std::vector<int64_t> via_tree(n, -1);
+  ms = time_ms([&] {
+    for (size_t i = 0; i < n; i++) {
+      int64_t best = -1;
+      for (size_t k : box_tree.in_box(Box::of(points[i]))) {
+        if ((best < 0 || static_cast<int64_t>(k) < best) &&
+            PointInPolygon::is_point_in_polygon(points[i], polygons[k]))
+          best = static_cast<int64_t>(k);
+      }
+      via_tree[i] = best;
+    }
+  });
+  report("R树（外接矩形）+射线法", ms, n / ms * 1e3);
+
+  std::vector<int64_t> located_serial, located;
+  std::unique_ptr<PolygonEdgeGrid> grid;
+  double build_ms =
+      time_ms([&] { grid = std::make_unique<PolygonEdgeGrid>(polygons); });
+  std::cout << "  边网格构建 " << std::setprecision(1) << build_ms << " ms，"
+            << grid->cell_count() << " 个格子" << std::endl;
+  ms = time_ms([&] { located_serial = grid->locate(points, 1); });
+  report("边网格（单线程）", ms, n / ms * 1e3);
+  ms = time_ms([&] { located = grid->locate(points, threads); });
+  report("边网格（并行）", ms, n / ms * 1e3);
+
+  size_t agree = 0, inside = 0;
+  for (size_t i = 0; i < n; i++) {
+    agree += located[i] == via_tree[i] && located_serial[i] == located[i] &&
+             (i >= sample || naive[i] == located[i]);
+    inside += located[i] >= 0;
+  }
+  std::cout << "  结果一致 " << agree << " / " << n << "，落在围栏内 " << inside
+            << " 个" << std::endl;
+
+  // k近邻：点数与查询点数相同，每次查询8个最近点
+  size_t queries = std::min<size_t>(n, 200000);
+  std::cout << "k近邻：" << n << " 个点，" << queries << " 次查询，k = 8"
+            << std::endl;
+  std::unique_ptr<KDTree> kd;
+  std::unique_ptr<RTree<Point>> rtree;
+  ms = time_ms([&] { kd = std::make_unique<KDTree>(points); });
+  std::cout << "  k-d树构建 " << std::setprecision(1) << ms << " ms";
+  ms = time_ms([&] { rtree = std::make_unique<RTree<Point>>(points); });
+  std::cout << "，R树构建 " << ms << " ms" << std::endl;
+  size_t checksum_kd = 0, checksum_rtree = 0;
+  ms = time_ms([&] {
+    for (size_t i = 0; i < queries; i++) {
+      for (size_t j : kd->nearest(Point(points[i].y, points[i].x), 8))
+        checksum_kd += j;
+    }
+  });
+  report("k-d树 nearest", ms, queries / ms * 1e3);
+  ms = time_ms([&] {
+    for (size_t i = 0; i < queries; i++) {
+      for (size_t j : rtree->nearest(Point(points[i].y, points[i].x), 8))
+        checksum_rtree += j;
+    }
+  });
+  report("R树 nearest", ms, queries / ms * 1e3);
+  std::cout << "  结果一致: " << (checksum_kd == checksum_rtree ? "是" : "否")
+            << std::endl;
+  return 0;
+}
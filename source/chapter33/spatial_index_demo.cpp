@@ -0,0 +1,251 @@
+#include "computational_geometry.h"
+#include "spatial_index.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace algorithms;
+
+// 暴力求解：按 (距离平方, 下标) 排序后的前 k 个
+template <typename Item>
+std::vector<size_t> brute_nearest(const std::vector<Item> &items,
+                                  const Point &q, size_t k) {
+  std::vector<std::pair<double, size_t>> all;
+  for (size_t i = 0; i < items.size(); i++) {
+    all.emplace_back(SpatialDistance::squared(q, items[i]), i);
+  }
+  std::sort(all.begin(), all.end());
+  std::vector<size_t> result;
+  for (size_t i = 0; i < k && i < all.size(); i++) {
+    result.push_back(all[i].second);
+  }
+  return result;
+}
+
+template <typename Item>
+std::vector<size_t> brute_radius(const std::vector<Item> &items,
+                                 const Point &q, double r) {
+  std::vector<size_t> result;
+  for (size_t i = 0; i < items.size(); i++) {
+    if (SpatialDistance::squared(q, items[i]) <= r * r)
+      result.push_back(i);
+  }
+  return result;
+}
+
+template <typename Item>
+std::vector<size_t> brute_box(const std::vector<Item> &items, const Box &box) {
+  std::vector<size_t> result;
+  for (size_t i = 0; i < items.size(); i++) {
+    if (box.intersects(Box::of(items[i])))
+      result.push_back(i);
+  }
+  return result;
+}
+
+std::vector<size_t> sorted(std::vector<size_t> v) {
+  std::sort(v.begin(), v.end());
+  return v;
+}
+
+// 均匀分布、聚集成团、整数网格（大量重复点和相等距离）三种点集
+std::vector<Point> make_points(int kind, size_t n, std::mt19937 &gen) {
+  std::uniform_real_distribution<double> unit(0.0, 100.0);
+  std::normal_distribution<double> spread(0.0, 1.5);
+  std::uniform_int_distribution<int> grid(0, 30);
+  std::vector<Point> points;
+  std::vector<Point> centers;
+  for (int i = 0; i < 20; i++) {
+    centers.push_back(Point(unit(gen), unit(gen)));
+  }
+  for (size_t i = 0; i < n; i++) {
+    if (kind == 0) {
+      points.push_back(Point(unit(gen), unit(gen)));
+    } else if (kind == 1) {
+      const Point &c = centers[i % centers.size()];
+      points.push_back(Point(c.x + spread(gen), c.y + spread(gen)));
+    } else {
+      points.push_back(Point(grid(gen), grid(gen)));
+    }
+  }
+  return points;
+}
+
+void test_kd_tree() {
+  std::cout << "=== 测试k-d树 ===" << std::endl;
+  std::mt19937 gen(3301);
+  std::uniform_real_distribution<double> unit(0.0, 100.0);
+  const char *names[] = {"均匀分布", "聚集成团", "整数网格"};
+  for (int kind = 0; kind < 3; kind++) {
+    std::vector<Point> points = make_points(kind, 20000, gen);
+    KDTree tree(points);
+    int agreed = 0;
+    const int queries = 200;
+    for (int t = 0; t < queries; t++) {
+      Point q(unit(gen) * 0.3, unit(gen) * 0.3);
+      if (kind == 2)
+        q = Point(std::round(q.x), std::round(q.y));
+      double r = 1 + unit(gen) / 20;
+      Box box(q.x, q.y, q.x + unit(gen) / 5, q.y + unit(gen) / 5);
+      agreed += tree.nearest(q, 10) == brute_nearest(points, q, 10) &&
+                sorted(tree.within_radius(q, r)) == brute_radius(points, q, r) &&
+                sorted(tree.in_box(box)) == brute_box(points, box);
+    }
+    std::cout << names[kind] << "：" << points.size() << " 个点，" << queries
+              << " 次 k近邻/半径/矩形查询与暴力求解一致 " << agreed << " 次"
+              << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+void test_r_tree() {
+  std::cout << "=== 测试STR装载的R树 ===" << std::endl;
+  std::mt19937 gen(3302);
+  std::uniform_real_distribution<double> unit(0.0, 100.0), step(-2.0, 2.0);
+
+  std::vector<Point> points = make_points(1, 20000, gen);
+  std::vector<Segment> segments;
+  for (int i = 0; i < 20000; i++) {
+    Point a(unit(gen), unit(gen));
+    segments.push_back(Segment(a, Point(a.x + step(gen), a.y + step(gen))));
+  }
+  RTree<Point> point_tree(points);
+  RTree<Segment> segment_tree(segments);
+  std::cout << "点: " << point_tree.size() << " 个，树高 " << point_tree.height()
+            << "；线段: " << segment_tree.size() << " 条，树高 "
+            << segment_tree.height() << std::endl;
+
+  int point_agreed = 0, segment_agreed = 0;
+  const int queries = 200;
+  for (int t = 0; t < queries; t++) {
+    Point q(unit(gen), unit(gen));
+    double r = 1 + unit(gen) / 20;
+    Box box(q.x, q.y, q.x + unit(gen) / 5, q.y + unit(gen) / 5);
+    point_agreed +=
+        point_tree.nearest(q, 10) == brute_nearest(points, q, 10) &&
+        sorted(point_tree.within_radius(q, r)) == brute_radius(points, q, r) &&
+        sorted(point_tree.in_box(box)) == brute_box(points, box);
+    segment_agreed +=
+        segment_tree.nearest(q, 10) == brute_nearest(segments, q, 10) &&
+        sorted(segment_tree.within_radius(q, r)) ==
+            brute_radius(segments, q, r) &&
+        sorted(segment_tree.in_box(box)) == brute_box(segments, box);
+  }
+  std::cout << queries << " 次查询与暴力求解一致：点 " << point_agreed
+            << " 次，线段 " << segment_agreed << " 次" << std::endl;
+
+  auto nearest = segment_tree.nearest(Point(50, 50), 3);
+  std::cout << "离 (50, 50) 最近的3条线段:";
+  for (size_t i : nearest) {
+    std::cout << " #" << i << "（距离 "
+              << std::sqrt(SpatialDistance::squared(Point(50, 50), segments[i]))
+              << "）";
+  }
+  std::cout << std::endl << std::endl;
+}
+
+// 精确的奇偶规则；p 在边界上时返回 -1
+int exact_inside(const Point &p, const std::vector<Point> &polygon) {
+  bool inside = false;
+  for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+    const Point &a = polygon[j], &b = polygon[i];
+    if (RobustPredicates::orientation(a, b, p) == 0 &&
+        RobustPredicates::in_box(p, Segment(a, b)))
+      return -1;
+    if ((a.y > p.y) != (b.y > p.y)) {
+      const Point &low = a.y > p.y ? b : a, &high = a.y > p.y ? a : b;
+      inside ^= RobustPredicates::orientation(low, high, p) > 0;
+    }
+  }
+  return inside;
+}
+
+// 以 c 为中心、顶点数和半径随机的星形多边形
+std::vector<Point> star_polygon(const Point &c, double radius, int vertices,
+                                std::mt19937 &gen) {
+  std::uniform_real_distribution<double> scale(0.3, 1.0);
+  std::vector<Point> polygon;
+  for (int k = 0; k < vertices; k++) {
+    double angle = 2 * M_PI * k / vertices;
+    double r = radius * scale(gen);
+    polygon.push_back(Point(c.x + r * std::cos(angle), c.y + r * std::sin(angle)));
+  }
+  return polygon;
+}
+
+void test_polygon_edge_grid() {
+  std::cout << "=== 测试多边形边网格上的批量点包含查询 ===" << std::endl;
+  std::mt19937 gen(3303);
+  std::uniform_real_distribution<double> unit(0.0, 100.0);
+  std::uniform_int_distribution<int> grid(0, 20), vertices(3, 40);
+
+  // 相互重叠的星形多边形，加上整数坐标的矩形和共享边的三角形（退化情况）
+  std::vector<std::vector<Point>> polygons;
+  for (int i = 0; i < 300; i++) {
+    polygons.push_back(star_polygon(Point(unit(gen), unit(gen)),
+                                    2 + unit(gen) / 10, vertices(gen), gen));
+  }
+  for (int i = 0; i < 100; i++) {
+    int x = grid(gen) * 5, y = grid(gen) * 5, w = grid(gen) + 1, h = grid(gen) + 1;
+    polygons.push_back(
+        {Point(x, y), Point(x + w, y), Point(x + w, y + h), Point(x, y + h)});
+  }
+  for (int x = 0; x < 100; x += 10) {
+    polygons.push_back({Point(x, 0), Point(x + 10, 0), Point(x + 10, 10)});
+    polygons.push_back({Point(x, 0), Point(x + 10, 10), Point(x, 10)});
+  }
+  PolygonEdgeGrid index(polygons);
+  std::cout << polygons.size() << " 个多边形，网格 " << index.cell_count()
+            << " 个格子" << std::endl;
+
+  // 随机点、整数点（常落在顶点连线、水平边和竖直边上）
+  std::vector<Point> queries;
+  for (int i = 0; i < 20000; i++) {
+    queries.push_back(i % 2 ? Point(unit(gen), unit(gen))
+                            : Point(grid(gen) * 5 + grid(gen) % 4,
+                                    grid(gen) * 5 + grid(gen) % 7));
+  }
+  size_t checked = 0, agreed = 0, boundary = 0, hits = 0;
+  std::vector<uint32_t> found;
+  std::vector<int64_t> first = index.locate(queries, 2);
+  for (size_t i = 0; i < queries.size(); i++) {
+    std::vector<uint32_t> expected;
+    bool on_boundary = false;
+    for (size_t p = 0; p < polygons.size(); p++) {
+      int inside = exact_inside(queries[i], polygons[p]);
+      on_boundary = on_boundary || inside < 0;
+      if (inside == 1)
+        expected.push_back(static_cast<uint32_t>(p));
+    }
+    if (on_boundary) {
+      boundary++;
+      continue;
+    }
+    index.containing(queries[i], found);
+    checked++;
+    hits += !expected.empty();
+    agreed += found == expected &&
+              first[i] == (expected.empty() ? -1 : int64_t(expected[0]));
+  }
+  std::cout << "查询 " << queries.size() << " 个点（" << boundary
+            << " 个在边界上，不比较），其余 " << checked
+            << " 个与逐个多边形的精确射线法一致 " << agreed << " 个，"
+            << hits << " 个落在至少一个多边形内" << std::endl;
+  std::cout << std::endl;
+}
+
+int main() {
+  std::cout << "第33章 空间索引演示程序" << std::endl;
+  std::cout << "======================" << std::endl;
+
+  test_kd_tree();
+  test_r_tree();
+  test_polygon_edge_grid();
+
+  std::cout << "所有测试完成！" << std::endl;
+  return 0;
+}
@@ -1,5 +1,7 @@
 #include "np_completeness.h"
+#include <chrono>
 #include <iostream>
+#include <random>
 #include <unordered_set>
 #include <vector>
 
@@ -104,6 +106,77 @@ void test_np_verifiers() {
 /**
  * @brief 测试NP完全问题
  */
+void test_bit_matrix_verifiers() {
+  std::cout << "\n=== 位矩阵图上的验证器 ===" << std::endl;
+
+  // 稠密随机图，植入一个大小为64的团
+  const int n = 2000;
+  std::mt19937 gen(34);
+  std::bernoulli_distribution coin(0.5);
+  Graph graph(n);
+  for (int u = 0; u < n; u++) {
+    for (int v = u + 1; v < n; v++) {
+      if ((u < 64 && v < 64) || coin(gen)) {
+        graph.add_edge(u, v);
+      }
+    }
+  }
+  BitMatrixGraph bits = graph.to_bit_matrix();
+  std::unordered_set<int> clique, not_clique;
+  for (int v = 0; v < 64; v++) {
+    clique.insert(v);
+    not_clique.insert(v + 1);
+  }
+  std::unordered_set<int> cover;
+  for (int v = 0; v < n - 1; v++) {
+    cover.insert(v);
+  }
+
+  auto time_us = [](auto f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    bool result = f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::make_pair(
+        result,
+        std::chrono::duration<double, std::micro>(end - start).count());
+  };
+  auto [list_clique, list_us] = time_us(
+      [&] { return NPCompleteness::verify_clique(graph, clique, 64); });
+  auto [bit_clique, bit_us] = time_us(
+      [&] { return NPCompleteness::verify_clique(bits, clique, 64); });
+  std::cout << "大小为64的团 — 邻接表: " << (list_clique ? "是" : "否") << " ("
+            << list_us << " 微秒), 位矩阵: " << (bit_clique ? "是" : "否")
+            << " (" << bit_us << " 微秒)" << std::endl;
+  std::cout << "错开一个顶点后 — 邻接表: "
+            << (NPCompleteness::verify_clique(graph, not_clique, 64) ? "是"
+                                                                     : "否")
+            << ", 位矩阵: "
+            << (NPCompleteness::verify_clique(bits, not_clique, 64) ? "是"
+                                                                    : "否")
+            << std::endl;
+
+  auto [list_cover, cover_list_us] = time_us(
+      [&] { return NPCompleteness::verify_vertex_cover(graph, cover, n - 1); });
+  auto [bit_cover, cover_bit_us] = time_us(
+      [&] { return NPCompleteness::verify_vertex_cover(bits, cover, n - 1); });
+  std::cout << "除最后一个顶点外的全部顶点构成覆盖 — 邻接表: "
+            << (list_cover ? "是" : "否") << " (" << cover_list_us
+            << " 微秒), 位矩阵: " << (bit_cover ? "是" : "否") << " ("
+            << cover_bit_us << " 微秒)" << std::endl;
+  // 再去掉顶点0的一个邻居，边 (0, neighbor) 不再被覆盖
+  int neighbor = graph.get_neighbors(0).front();
+  cover.erase(0);
+  cover.erase(neighbor);
+  cover.insert(n - 1);
+  std::cout << "去掉顶点0和它的邻居" << neighbor << " — 邻接表: "
+            << (NPCompleteness::verify_vertex_cover(graph, cover, n - 2) ? "是"
+                                                                         : "否")
+            << ", 位矩阵: "
+            << (NPCompleteness::verify_vertex_cover(bits, cover, n - 2) ? "是"
+                                                                        : "否")
+            << std::endl;
+}
+
 void test_np_complete_problems() {
   std::cout << "\n=== 测试NP完全问题 ===" << std::endl;
 
@@ -184,6 +257,121 @@ void test_np_complete_problems() {
             << std::endl;
 }
 
+// 鸽巢原理 PHP(n+1, n)：n+1 只鸽子放进 n 个巢且互不相同，必然不可满足
+std::vector<std::vector<int>> pigeonhole_formula(int holes) {
+  auto var = [holes](int pigeon, int hole) { return pigeon * holes + hole + 1; };
+  std::vector<std::vector<int>> formula;
+  for (int p = 0; p <= holes; p++) {
+    std::vector<int> clause;
+    for (int h = 0; h < holes; h++) {
+      clause.push_back(var(p, h));
+    }
+    formula.push_back(clause);
+  }
+  for (int h = 0; h < holes; h++) {
+    for (int p = 0; p <= holes; p++) {
+      for (int q = p + 1; q <= holes; q++) {
+        formula.push_back({-var(p, h), -var(q, h)});
+      }
+    }
+  }
+  return formula;
+}
+
+/**
+ * @brief 测试CDCL SAT求解器
+ */
+void test_sat_solver() {
+  std::cout << "\n=== 测试CDCL SAT求解器 ===" << std::endl;
+
+  // (x1 ∨ ¬x2 ∨ x3) ∧ (¬x1 ∨ x2 ∨ x3) ∧ (¬x3 ∨ x2 ∨ ¬x1) ∧ (x1 ∨ x2 ∨ ¬x3)
+  std::vector<std::vector<int>> formula = {
+      {1, -2, 3}, {-1, 2, 3}, {-3, 2, -1}, {1, 2, -3}};
+  std::vector<bool> assignment;
+  bool satisfiable = NPCompleteness::solve_3sat(formula, assignment);
+  std::cout << "小公式: " << (satisfiable ? "可满足" : "不可满足");
+  if (satisfiable) {
+    std::cout << "，赋值";
+    for (size_t i = 0; i < assignment.size(); i++) {
+      std::cout << " x" << i + 1 << "=" << assignment[i];
+    }
+    std::cout << "，verify_3sat: "
+              << (NPCompleteness::verify_3sat(formula, assignment) ? "通过"
+                                                                   : "失败");
+  }
+  std::cout << std::endl;
+
+  // 增量求解：每找到一个解就加入阻塞子句，枚举全部解
+  SatSolver enumerator(formula);
+  int solutions = 0;
+  while (enumerator.solve() == SatSolver::Result::kSatisfiable) {
+    solutions++;
+    std::vector<int> block;
+    for (int v = 1; v <= enumerator.num_variables(); v++) {
+      block.push_back(enumerator.value(v) ? -v : v);
+    }
+    enumerator.add_clause(block);
+  }
+  std::cout << "用阻塞子句枚举，共 " << solutions << " 个解" << std::endl;
+
+  // 相变点附近的随机3-SAT（子句数/变量数 ≈ 4.26）
+  std::mt19937 rng(2024);
+  int n = 150;
+  std::vector<std::vector<int>> random_formula;
+  std::uniform_int_distribution<int> pick(1, n);
+  for (int i = 0; i < n * 426 / 100; i++) {
+    std::vector<int> clause;
+    for (int j = 0; j < 3; j++) {
+      int v = pick(rng);
+      clause.push_back(rng() % 2 ? v : -v);
+    }
+    random_formula.push_back(clause);
+  }
+  auto start = std::chrono::high_resolution_clock::now();
+  SatSolver solver(random_formula);
+  SatSolver::Result result = solver.solve();
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::high_resolution_clock::now() - start);
+  const SatSolver::Statistics &stats = solver.statistics();
+  std::cout << "随机3-SAT（" << n << " 个变量，" << random_formula.size()
+            << " 个子句）: "
+            << (result == SatSolver::Result::kSatisfiable ? "可满足"
+                                                          : "不可满足")
+            << "，决策 " << stats.decisions << " 次，冲突 " << stats.conflicts
+            << " 次，重启 " << stats.restarts << " 次，用时 "
+            << elapsed.count() << " 微秒" << std::endl;
+  if (result == SatSolver::Result::kSatisfiable) {
+    std::cout << "verify_3sat: "
+              << (NPCompleteness::verify_3sat(random_formula,
+                                              solver.get_model())
+                      ? "通过"
+                      : "失败")
+              << std::endl;
+  }
+
+  std::vector<std::vector<int>> php = pigeonhole_formula(7);
+  SatSolver php_solver(php);
+  std::cout << "鸽巢原理 PHP(8, 7)（" << php.size() << " 个子句）: "
+            << (php_solver.solve() == SatSolver::Result::kUnsatisfiable
+                    ? "不可满足（正确）"
+                    : "错误")
+            << "，冲突 " << php_solver.statistics().conflicts << " 次"
+            << std::endl;
+
+  SatSolver limited(pigeonhole_formula(9));
+  std::cout << "PHP(10, 9) 限制100次冲突: "
+            << (limited.solve(100) == SatSolver::Result::kUnknown ? "未知"
+                                                                  : "已判定")
+            << std::endl;
+
+  try {
+    SatSolver invalid({{1, 0, 2}});
+    std::cout << "错误：文字0应该抛出异常" << std::endl;
+  } catch (const std::invalid_argument &e) {
+    std::cout << "文字0: " << e.what() << std::endl;
+  }
+}
+
 /**
  * @brief 测试问题归约
  */
@@ -272,7 +460,9 @@ int main() {
   try {
     test_p_class_problems();
     test_np_verifiers();
+    test_bit_matrix_verifiers();
     test_np_complete_problems();
+    test_sat_solver();
     test_problem_reductions();
     test_p_vs_np();
     demonstrate_real_world_applications();
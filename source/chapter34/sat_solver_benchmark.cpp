@@ -0,0 +1,155 @@
+#include "benchmark_harness.h"
+#include "np_completeness.h"
+#include "sat_solver.h"
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace algorithms;
+
+using Formula = std::vector<std::vector<int>>;
+
+// 相变点附近的随机3-SAT：子句数约为变量数的4.26倍，约一半可满足
+std::vector<Formula> random_3sat(size_t n, size_t count) {
+  std::mt19937 rng(static_cast<uint32_t>(n));
+  std::uniform_int_distribution<int> pick(1, static_cast<int>(n));
+  std::vector<Formula> formulas(count);
+  for (Formula &formula : formulas) {
+    for (size_t i = 0; i < n * 426 / 100; ++i) {
+      std::vector<int> clause;
+      for (int j = 0; j < 3; ++j) {
+        int v = pick(rng);
+        clause.push_back(rng() % 2 ? v : -v);
+      }
+      formula.push_back(clause);
+    }
+  }
+  return formulas;
+}
+
+// 对照组：不学习子句的DPLL，单位传播每轮扫描全部子句，按编号选变量分支
+class SimpleDpll {
+public:
+  SimpleDpll(const Formula &formula, size_t n) : formula(formula), value(n + 1, 0) {}
+
+  bool solve() { return search(); }
+
+  const std::vector<int8_t> &assignment() const { return value; }
+
+private:
+  const Formula &formula;
+  std::vector<int8_t> value; // 1 真，-1 假，0 未赋值
+
+  int8_t literal_value(int x) const {
+    int8_t v = value[std::abs(x)];
+    return x > 0 ? v : static_cast<int8_t>(-v);
+  }
+
+  // 返回false表示冲突；trail 记录本层赋值以便回溯
+  bool unit_propagate(std::vector<int> &trail) {
+    for (bool changed = true; changed;) {
+      changed = false;
+      for (const auto &clause : formula) {
+        int unassigned = 0, last = 0;
+        bool satisfied = false;
+        for (int x : clause) {
+          int8_t v = literal_value(x);
+          if (v > 0) {
+            satisfied = true;
+            break;
+          }
+          if (v == 0) {
+            ++unassigned;
+            last = x;
+          }
+        }
+        if (satisfied) {
+          continue;
+        }
+        if (unassigned == 0) {
+          return false;
+        }
+        if (unassigned == 1) {
+          value[std::abs(last)] = last > 0 ? 1 : -1;
+          trail.push_back(std::abs(last));
+          changed = true;
+        }
+      }
+    }
+    return true;
+  }
+
+  bool search() {
+    std::vector<int> trail;
+    if (unit_propagate(trail)) {
+      size_t v = 1;
+      while (v < value.size() && value[v] != 0) {
+        ++v;
+      }
+      if (v == value.size()) {
+        return true;
+      }
+      for (int8_t choice : {int8_t(-1), int8_t(1)}) {
+        value[v] = choice;
+        if (search()) {
+          return true;
+        }
+      }
+      value[v] = 0;
+    }
+    for (int u : trail) {
+      value[u] = 0;
+    }
+    return false;
+  }
+};
+
+// 每个规模求解同一组随机公式，可满足的解都用 verify_3sat 检查
+const size_t kFormulas = 8;
+
+void cdcl_random_3sat(BenchmarkState &state) {
+  std::vector<Formula> formulas = random_3sat(state.size(), kFormulas);
+  state.run([&] {
+    for (const Formula &formula : formulas) {
+      SatSolver solver(formula);
+      if (solver.solve() == SatSolver::Result::kSatisfiable &&
+          !NPCompleteness::verify_3sat(formula, solver.get_model())) {
+        throw std::runtime_error("invalid model");
+      }
+    }
+  });
+  state.set_items_processed(static_cast<double>(kFormulas));
+}
+
+void dpll_random_3sat(BenchmarkState &state) {
+  std::vector<Formula> formulas = random_3sat(state.size(), kFormulas);
+  state.run([&] {
+    for (const Formula &formula : formulas) {
+      SimpleDpll solver(formula, state.size());
+      BenchmarkState::do_not_optimize(solver.solve());
+    }
+  });
+  state.set_items_processed(static_cast<double>(kFormulas));
+}
+
+// 大量小实例：构造加求解的全部开销，对应逐个启动外部求解器进程的场景
+void cdcl_many_small(BenchmarkState &state) {
+  std::vector<Formula> formulas = random_3sat(20, state.size());
+  state.run([&] {
+    size_t satisfiable = 0;
+    for (const Formula &formula : formulas) {
+      std::vector<bool> assignment;
+      satisfiable += NPCompleteness::solve_3sat(formula, assignment);
+    }
+    BenchmarkState::do_not_optimize(satisfiable);
+  });
+  state.set_items_processed(static_cast<double>(state.size()));
+}
+
+ALGORITHMS_BENCHMARK(cdcl_random_3sat).sizes({50, 100, 150, 200});
+ALGORITHMS_BENCHMARK(dpll_random_3sat).sizes({50, 75, 100});
+ALGORITHMS_BENCHMARK(cdcl_many_small).sizes({1000});
+
+ALGORITHMS_BENCHMARK_MAIN()
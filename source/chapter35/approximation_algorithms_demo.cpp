@@ -1,5 +1,10 @@
 #include "approximation_algorithms.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
+#include <random>
+#include <stdexcept>
 #include <unordered_set>
 #include <vector>
 
@@ -221,6 +226,175 @@ void test_max_cut_approximation() {
   std::cout << "近似比: 2" << std::endl;
 }
 
+/**
+ * @brief 位矩阵图上的顶点覆盖与最大割，与邻接表版本对比
+ */
+void test_bit_matrix_approximations() {
+  std::cout << "\n=== 位矩阵图上的近似算法 ===" << std::endl;
+
+  const int n = 1500;
+  std::mt19937 gen(35);
+  std::bernoulli_distribution coin(0.3);
+  Graph graph(n);
+  for (int u = 0; u < n; u++) {
+    for (int v = u + 1; v < n; v++) {
+      if (coin(gen)) {
+        graph.add_edge(u, v);
+      }
+    }
+  }
+  BitMatrixGraph bits = graph.to_bit_matrix();
+  std::cout << "随机图: " << n << " 个顶点, " << bits.get_edge_count()
+            << " 条边（边权为1）" << std::endl;
+
+  auto elapsed_ms = [](auto start) {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::high_resolution_clock::now() - start)
+        .count();
+  };
+  auto start = std::chrono::high_resolution_clock::now();
+  auto list_cover = ApproximationAlgorithms::vertex_cover_2_approx(graph);
+  double list_ms = elapsed_ms(start);
+  start = std::chrono::high_resolution_clock::now();
+  auto bit_cover = ApproximationAlgorithms::vertex_cover_2_approx(bits);
+  double bit_ms = elapsed_ms(start);
+  std::cout << "顶点覆盖大小: " << bit_cover.size() << ", 邻接表 " << list_ms
+            << " ms, 位矩阵 " << bit_ms << " ms, 结果相同: "
+            << (list_cover == bit_cover ? "是" : "否") << std::endl;
+
+  start = std::chrono::high_resolution_clock::now();
+  auto list_cut = ApproximationAlgorithms::max_cut_2_approx(graph);
+  list_ms = elapsed_ms(start);
+  start = std::chrono::high_resolution_clock::now();
+  auto bit_cut = ApproximationAlgorithms::max_cut_2_approx(bits);
+  bit_ms = elapsed_ms(start);
+  long long cut_value = 0;
+  for (int u = 0; u < n; u++) {
+    for (int v : graph.get_neighbors(u)) {
+      cut_value += u < v && bit_cut.first.count(u) != bit_cut.first.count(v);
+    }
+  }
+  std::cout << "最大割: 割值 " << cut_value << ", 邻接表 " << list_ms
+            << " ms, 位矩阵 " << bit_ms << " ms, 结果相同: "
+            << (list_cut == bit_cut ? "是" : "否") << std::endl;
+}
+
+/**
+ * @brief 惰性贪心集合覆盖：与逐轮扫描的贪心算法对比
+ */
+void test_lazy_set_cover() {
+  std::cout << "\n=== 惰性贪心集合覆盖 ===" << std::endl;
+
+  // 全集 0..n-1，少数大子集加大量小子集
+  const int n = 20000, m = 2000;
+  std::mt19937 gen(86);
+  std::uniform_int_distribution<int> element(0, n - 1);
+  std::vector<std::vector<int>> lists(m);
+  std::vector<std::unordered_set<int>> sets(m);
+  for (int i = 0; i < m; i++) {
+    int size = i % 100 == 0 ? n / 10 : 5 + static_cast<int>(gen() % 40);
+    for (int k = 0; k < size; k++) {
+      lists[i].push_back(element(gen));
+    }
+    sets[i].insert(lists[i].begin(), lists[i].end());
+  }
+  std::unordered_set<int> universe;
+  for (int e = 0; e < n; e++) {
+    universe.insert(e);
+  }
+
+  auto elapsed_ms = [](auto start) {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::high_resolution_clock::now() - start)
+        .count();
+  };
+  auto start = std::chrono::high_resolution_clock::now();
+  auto eager = ApproximationAlgorithms::set_cover_greedy(universe, sets);
+  double eager_ms = elapsed_ms(start);
+  start = std::chrono::high_resolution_clock::now();
+  auto lazy = ApproximationAlgorithms::set_cover_lazy_greedy(n, lists);
+  double lazy_ms = elapsed_ms(start);
+
+  bool same = eager.size() == lazy.size();
+  for (size_t i = 0; same && i < lazy.size(); i++) {
+    same = eager[i] == sets[lazy[i]];
+  }
+  std::cout << n << " 个元素、" << m << " 个子集: 选中 " << lazy.size()
+            << " 个子集，逐轮扫描 " << eager_ms << " ms，惰性贪心 " << lazy_ms
+            << " ms，选择相同: " << (same ? "是" : "否") << std::endl;
+}
+
+/**
+ * @brief MST 2-近似路线上的 2-opt / Or-opt 局部搜索
+ */
+void test_tsp_local_search() {
+  std::cout << "\n=== 旅行商路线局部搜索 ===" << std::endl;
+
+  const int n = 1000;
+  std::mt19937 gen(2);
+  std::uniform_real_distribution<double> coordinate(0, 10000);
+  std::vector<std::pair<double, double>> points(n);
+  for (auto &p : points) {
+    p = {coordinate(gen), coordinate(gen)};
+  }
+  std::vector<std::vector<int>> distance(n, std::vector<int>(n));
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      distance[i][j] = static_cast<int>(std::lround(
+          std::hypot(points[i].first - points[j].first,
+                     points[i].second - points[j].second)));
+    }
+  }
+  auto cost = [&](const std::vector<int> &tour) {
+    long long total = 0;
+    for (size_t i = 0; i + 1 < tour.size(); i++) {
+      total += distance[tour[i]][tour[i + 1]];
+    }
+    return total;
+  };
+
+  auto start = std::chrono::high_resolution_clock::now();
+  auto mst_tour = ApproximationAlgorithms::tsp_2_approx(distance);
+  auto mid = std::chrono::high_resolution_clock::now();
+  auto improved = ApproximationAlgorithms::tsp_local_search(distance, mst_tour);
+  auto end = std::chrono::high_resolution_clock::now();
+
+  std::vector<bool> visited(n, false);
+  for (int i = 0; i < n; i++) {
+    visited[improved[i]] = true;
+  }
+  bool valid = improved.size() == static_cast<size_t>(n) + 1 &&
+               improved.front() == improved.back() &&
+               std::find(visited.begin(), visited.end(), false) == visited.end();
+  std::cout << n << " 个随机城市: MST路线 " << cost(mst_tour) << "（"
+            << std::chrono::duration<double, std::milli>(mid - start).count()
+            << " ms），局部搜索后 " << cost(improved) << "（"
+            << std::chrono::duration<double, std::milli>(end - mid).count()
+            << " ms），路线有效: " << (valid ? "是" : "否") << std::endl;
+
+  // 4个城市也有 2-opt 移动：正方形 (0,0)、(10,10)、(10,0)、(0,10) 上
+  // 路线 0 1 2 3 的两条对角线交叉，长 48，消除交叉后为 40
+  std::vector<std::vector<int>> square = {
+      {0, 14, 10, 10}, {14, 0, 10, 10}, {10, 10, 0, 14}, {10, 10, 14, 0}};
+  auto square_tour =
+      ApproximationAlgorithms::tsp_local_search(square, {0, 1, 2, 3, 0});
+  long long square_cost = 0;
+  for (size_t i = 0; i + 1 < square_tour.size(); i++) {
+    square_cost += square[square_tour[i]][square_tour[i + 1]];
+  }
+  std::cout << "正方形上交叉的4城市路线 48 -> " << square_cost << std::endl;
+  if (square_cost != 40) {
+    throw std::runtime_error("4个城市的局部搜索没有消除交叉");
+  }
+
+  try {
+    distance[0][1] += 1;
+    ApproximationAlgorithms::tsp_local_search(distance, mst_tour);
+  } catch (const std::invalid_argument &e) {
+    std::cout << "不对称距离: " << e.what() << std::endl;
+  }
+}
+
 /**
  * @brief 测试设施选址问题的近似算法
  */
@@ -339,6 +513,9 @@ int main() {
     test_set_cover_approximation();
     test_knapsack_approximation();
     test_max_cut_approximation();
+    test_bit_matrix_approximations();
+    test_lazy_set_cover();
+    test_tsp_local_search();
     test_facility_location_approximation();
     demonstrate_performance_analysis();
     demonstrate_real_world_applications();
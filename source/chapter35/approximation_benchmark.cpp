@@ -0,0 +1,106 @@
+#include "approximation_algorithms.h"
+#include "benchmark_harness.h"
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+using namespace algorithms;
+
+// 集合覆盖：全集 n 个元素，n/10 个子集；每100个子集中有一个含 n/100 个元素，
+// 其余含5–50个元素（对应覆盖规划中少数大区域与大量小区域）
+std::vector<std::vector<int>> random_subsets(size_t n) {
+  std::mt19937 rng(static_cast<uint32_t>(n));
+  std::uniform_int_distribution<int> element(0, static_cast<int>(n) - 1);
+  std::vector<std::vector<int>> subsets(n / 10);
+  for (size_t i = 0; i < subsets.size(); i++) {
+    size_t size = i % 100 == 0 ? n / 100 : 5 + rng() % 46;
+    for (size_t k = 0; k < size; k++) {
+      subsets[i].push_back(element(rng));
+    }
+  }
+  return subsets;
+}
+
+void set_cover_greedy(BenchmarkState &state) {
+  auto lists = random_subsets(state.size());
+  std::vector<std::unordered_set<int>> subsets;
+  for (const auto &list : lists) {
+    subsets.emplace_back(list.begin(), list.end());
+  }
+  std::unordered_set<int> universe;
+  for (size_t e = 0; e < state.size(); e++) {
+    universe.insert(static_cast<int>(e));
+  }
+  state.run([&] {
+    BenchmarkState::do_not_optimize(
+        ApproximationAlgorithms::set_cover_greedy(universe, subsets).size());
+  });
+}
+
+void set_cover_lazy_greedy(BenchmarkState &state) {
+  auto subsets = random_subsets(state.size());
+  state.run([&] {
+    BenchmarkState::do_not_optimize(
+        ApproximationAlgorithms::set_cover_lazy_greedy(state.size(), subsets)
+            .size());
+  });
+}
+
+// 旅行商：平面上随机点的欧氏距离（四舍五入为整数）
+std::vector<std::vector<int>> random_cities(size_t n) {
+  std::mt19937 rng(static_cast<uint32_t>(n));
+  std::uniform_real_distribution<double> coordinate(0, 100000);
+  std::vector<std::pair<double, double>> points(n);
+  for (auto &p : points) {
+    p = {coordinate(rng), coordinate(rng)};
+  }
+  std::vector<std::vector<int>> distance(n, std::vector<int>(n));
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < n; j++) {
+      distance[i][j] = static_cast<int>(
+          std::lround(std::hypot(points[i].first - points[j].first,
+                                 points[i].second - points[j].second)));
+    }
+  }
+  return distance;
+}
+
+long long tour_cost(const std::vector<std::vector<int>> &distance,
+                    const std::vector<int> &tour) {
+  long long cost = 0;
+  for (size_t i = 0; i + 1 < tour.size(); i++) {
+    cost += distance[tour[i]][tour[i + 1]];
+  }
+  return cost;
+}
+
+void tsp_mst_tour(BenchmarkState &state) {
+  auto distance = random_cities(state.size());
+  state.run([&] {
+    BenchmarkState::do_not_optimize(
+        ApproximationAlgorithms::tsp_2_approx(distance).size());
+  });
+}
+
+// 只计局部搜索本身（含候选表构造），起点为 MST 路线
+void tsp_local_search(BenchmarkState &state) {
+  auto distance = random_cities(state.size());
+  auto start = ApproximationAlgorithms::tsp_2_approx(distance);
+  std::vector<int> improved;
+  state.run([&] {
+    improved = ApproximationAlgorithms::tsp_local_search(distance, start);
+  });
+  if (tour_cost(distance, improved) >= tour_cost(distance, start)) {
+    throw std::runtime_error("local search did not improve the MST tour");
+  }
+}
+
+ALGORITHMS_BENCHMARK(set_cover_greedy).sizes({10000, 30000});
+ALGORITHMS_BENCHMARK(set_cover_lazy_greedy).sizes({10000, 30000, 1000000});
+ALGORITHMS_BENCHMARK(tsp_mst_tour).sizes({500, 1000, 2000});
+ALGORITHMS_BENCHMARK(tsp_local_search).sizes({500, 1000, 2000});
+
+ALGORITHMS_BENCHMARK_MAIN()
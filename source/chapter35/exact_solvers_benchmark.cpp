@@ -0,0 +1,217 @@
+#include "benchmark_harness.h"
+#include "exact_solvers.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace algorithms;
+
+WorkStealingScheduler &shared_scheduler() {
+  static WorkStealingScheduler scheduler(
+      std::max(1u, std::thread::hardware_concurrency()));
+  return scheduler;
+}
+
+BitMatrixGraph random_graph(size_t n, double density, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::bernoulli_distribution edge(density);
+  BitMatrixGraph graph(n);
+  for (size_t u = 0; u < n; u++) {
+    for (size_t v = u + 1; v < n; v++) {
+      if (edge(rng)) {
+        graph.add_edge(static_cast<int>(u), static_cast<int>(v));
+      }
+    }
+  }
+  return graph;
+}
+
+// 顶点覆盖：平均度数约4的稀疏随机图
+BitMatrixGraph sparse_graph(size_t n) {
+  return random_graph(n, 4.0 / static_cast<double>(n), static_cast<uint32_t>(n));
+}
+
+void vertex_cover_2_approx(BenchmarkState &state) {
+  BitMatrixGraph graph = sparse_graph(state.size());
+  state.run([&] {
+    BenchmarkState::do_not_optimize(
+        ApproximationAlgorithms::vertex_cover_2_approx(graph).size());
+  });
+}
+
+void vertex_cover_exact_serial(BenchmarkState &state) {
+  BitMatrixGraph graph = sparse_graph(state.size());
+  state.run([&] {
+    BenchmarkState::do_not_optimize(
+        ExactSolvers::minimum_vertex_cover(graph).size());
+  });
+}
+
+void vertex_cover_exact_parallel(BenchmarkState &state) {
+  BitMatrixGraph graph = sparse_graph(state.size());
+  state.run([&] {
+    BenchmarkState::do_not_optimize(
+        ExactSolvers::minimum_vertex_cover(graph, &shared_scheduler()).size());
+  });
+}
+
+// 最大团：密度0.5的随机图
+void max_clique_serial(BenchmarkState &state) {
+  BitMatrixGraph graph = random_graph(state.size(), 0.5, 35);
+  state.run([&] {
+    BenchmarkState::do_not_optimize(ExactSolvers::maximum_clique(graph).size());
+  });
+}
+
+void max_clique_parallel(BenchmarkState &state) {
+  BitMatrixGraph graph = random_graph(state.size(), 0.5, 35);
+  state.run([&] {
+    BenchmarkState::do_not_optimize(
+        ExactSolvers::maximum_clique(graph, &shared_scheduler()).size());
+  });
+}
+
+// 旅行商：平面上随机点的欧氏距离
+std::vector<std::vector<int>> random_cities(size_t n) {
+  std::mt19937 rng(static_cast<uint32_t>(n));
+  std::uniform_int_distribution<int> coordinate(0, 10000);
+  std::vector<std::pair<int, int>> points(n);
+  for (auto &p : points) {
+    p = {coordinate(rng), coordinate(rng)};
+  }
+  std::vector<std::vector<int>> distance(n, std::vector<int>(n));
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < n; j++) {
+      double dx = points[i].first - points[j].first;
+      double dy = points[i].second - points[j].second;
+      distance[i][j] = static_cast<int>(std::lround(std::sqrt(dx * dx + dy * dy)));
+    }
+  }
+  return distance;
+}
+
+// 对照组：教科书式Held–Karp，按子集逐个计算，dp 以子集为行，不剪枝
+int plain_held_karp(const std::vector<std::vector<int>> &d) {
+  size_t m = d.size() - 1;
+  const int inf = ExactSolvers::kInfinity;
+  std::vector<std::vector<int>> dp(size_t(1) << m, std::vector<int>(m, inf));
+  for (std::uint32_t s = 1; s < (1u << m); s++) {
+    for (size_t j = 0; j < m; j++) {
+      if (!(s >> j & 1)) {
+        continue;
+      }
+      std::uint32_t prev = s ^ (1u << j);
+      if (prev == 0) {
+        dp[s][j] = d[0][j + 1];
+        continue;
+      }
+      for (size_t k = 0; k < m; k++) {
+        if (prev >> k & 1) {
+          dp[s][j] = std::min(dp[s][j], dp[prev][k] + d[k + 1][j + 1]);
+        }
+      }
+    }
+  }
+  int best = inf;
+  for (size_t j = 0; j < m; j++) {
+    best = std::min(best, dp[(1u << m) - 1][j] + d[j + 1][0]);
+  }
+  return best;
+}
+
+void held_karp_plain(BenchmarkState &state) {
+  auto distance = random_cities(state.size());
+  state.run([&] { BenchmarkState::do_not_optimize(plain_held_karp(distance)); });
+}
+
+void held_karp_serial(BenchmarkState &state) {
+  auto distance = random_cities(state.size());
+  int expected = plain_held_karp(distance);
+  state.run([&] {
+    if (ExactSolvers::tsp_held_karp(distance).cost != expected) {
+      throw std::runtime_error("Held-Karp mismatch");
+    }
+  });
+}
+
+void held_karp_parallel(BenchmarkState &state) {
+  auto distance = random_cities(state.size());
+  state.run([&] {
+    BenchmarkState::do_not_optimize(
+        ExactSolvers::tsp_held_karp(distance, &shared_scheduler()).cost);
+  });
+}
+
+// 子集和：200个元素，目标和为 size
+std::vector<int> subset_values(size_t target) {
+  std::mt19937 rng(static_cast<uint32_t>(target));
+  std::uniform_int_distribution<int> value(1, static_cast<int>(target / 50));
+  std::vector<int> values(200);
+  for (int &x : values) {
+    x = value(rng);
+  }
+  return values;
+}
+
+// 对照组：一个 bool 数组的经典动态规划，每个元素从高到低更新一遍
+bool plain_subset_sum(const std::vector<int> &values, int target) {
+  std::vector<char> reach(static_cast<size_t>(target) + 1, 0);
+  reach[0] = 1;
+  for (int x : values) {
+    for (int s = target; s >= x; s--) {
+      reach[s] |= reach[s - x];
+    }
+  }
+  return reach[target];
+}
+
+void subset_sum_plain(BenchmarkState &state) {
+  auto values = subset_values(state.size());
+  int target = static_cast<int>(state.size()) - 1;
+  state.run([&] {
+    BenchmarkState::do_not_optimize(plain_subset_sum(values, target));
+  });
+  state.set_items_processed(static_cast<double>(values.size()));
+}
+
+void subset_sum_bitset(BenchmarkState &state) {
+  auto values = subset_values(state.size());
+  int target = static_cast<int>(state.size()) - 1;
+  state.run([&] {
+    BenchmarkState::do_not_optimize(ExactSolvers::subset_sum(values, target));
+  });
+  state.set_items_processed(static_cast<double>(values.size()));
+}
+
+void subset_sum_bitset_parallel(BenchmarkState &state) {
+  auto values = subset_values(state.size());
+  int target = static_cast<int>(state.size()) - 1;
+  state.run([&] {
+    BenchmarkState::do_not_optimize(
+        ExactSolvers::subset_sum(values, target, nullptr, &shared_scheduler()));
+  });
+  state.set_items_processed(static_cast<double>(values.size()));
+}
+
+const std::vector<size_t> kCoverSizes = {60, 120, 180};
+const std::vector<size_t> kCliqueSizes = {100, 200, 300};
+const std::vector<size_t> kCities = {12, 16, 20};
+const std::vector<size_t> kTargets = {1 << 16, 1 << 20, 1 << 24};
+
+ALGORITHMS_BENCHMARK(vertex_cover_2_approx).sizes(kCoverSizes);
+ALGORITHMS_BENCHMARK(vertex_cover_exact_serial).sizes(kCoverSizes);
+ALGORITHMS_BENCHMARK(vertex_cover_exact_parallel).sizes(kCoverSizes);
+ALGORITHMS_BENCHMARK(max_clique_serial).sizes(kCliqueSizes);
+ALGORITHMS_BENCHMARK(max_clique_parallel).sizes(kCliqueSizes);
+ALGORITHMS_BENCHMARK(held_karp_plain).sizes(kCities);
+ALGORITHMS_BENCHMARK(held_karp_serial).sizes(kCities);
+ALGORITHMS_BENCHMARK(held_karp_parallel).sizes(kCities);
+ALGORITHMS_BENCHMARK(subset_sum_plain).sizes({1 << 16, 1 << 20});
+ALGORITHMS_BENCHMARK(subset_sum_bitset).sizes(kTargets);
+ALGORITHMS_BENCHMARK(subset_sum_bitset_parallel).sizes(kTargets);
+
+ALGORITHMS_BENCHMARK_MAIN()
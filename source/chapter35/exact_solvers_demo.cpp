@@ -0,0 +1,308 @@
+#include "exact_solvers.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace algorithms;
+
+BitMatrixGraph random_graph(size_t n, double density, std::mt19937 &rng) {
+  std::bernoulli_distribution edge(density);
+  BitMatrixGraph graph(n);
+  for (size_t u = 0; u < n; u++) {
+    for (size_t v = u + 1; v < n; v++) {
+      if (edge(rng)) {
+        graph.add_edge(static_cast<int>(u), static_cast<int>(v));
+      }
+    }
+  }
+  return graph;
+}
+
+std::vector<std::vector<int>> random_distances(size_t n, std::mt19937 &rng) {
+  std::uniform_int_distribution<int> coordinate(0, 1000);
+  std::vector<std::pair<int, int>> points(n);
+  for (auto &p : points) {
+    p = {coordinate(rng), coordinate(rng)};
+  }
+  std::vector<std::vector<int>> distance(n, std::vector<int>(n));
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < n; j++) {
+      double dx = points[i].first - points[j].first;
+      double dy = points[i].second - points[j].second;
+      distance[i][j] = static_cast<int>(std::lround(std::sqrt(dx * dx + dy * dy)));
+    }
+  }
+  return distance;
+}
+
+bool is_vertex_cover(const BitMatrixGraph &graph, const std::vector<int> &cover) {
+  std::vector<bool> in_cover(graph.get_node_count(), false);
+  for (int v : cover) {
+    in_cover[v] = true;
+  }
+  for (size_t u = 0; u < graph.get_node_count(); u++) {
+    bool ok = true;
+    graph.for_each_out_edge(u, [&](int v, int) {
+      ok = ok && (in_cover[u] || in_cover[v]);
+    });
+    if (!ok) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// 枚举全部顶点子集：最小覆盖与最大团的大小
+std::pair<size_t, size_t> brute_force_cover_and_clique(const BitMatrixGraph &graph) {
+  size_t n = graph.get_node_count();
+  size_t cover = n, clique = 0;
+  for (std::uint32_t mask = 0; mask < (1u << n); mask++) {
+    std::vector<int> subset;
+    for (size_t v = 0; v < n; v++) {
+      if (mask >> v & 1) {
+        subset.push_back(static_cast<int>(v));
+      }
+    }
+    if (subset.size() < cover && is_vertex_cover(graph, subset)) {
+      cover = subset.size();
+    }
+    if (subset.size() > clique && graph.is_clique(subset)) {
+      clique = subset.size();
+    }
+  }
+  return {cover, clique};
+}
+
+long long brute_force_tsp(const std::vector<std::vector<int>> &distance) {
+  std::vector<int> tour(distance.size());
+  for (size_t i = 0; i < tour.size(); i++) {
+    tour[i] = static_cast<int>(i);
+  }
+  long long best = std::numeric_limits<long long>::max();
+  do {
+    std::vector<int> closed = tour;
+    closed.push_back(0);
+    best = std::min(best, ExactSolvers::tour_cost(distance, closed));
+  } while (std::next_permutation(tour.begin() + 1, tour.end()));
+  return best;
+}
+
+/**
+ * @brief 测试最小顶点覆盖与最大团
+ */
+void test_vertex_cover_and_clique() {
+  std::cout << "=== 最小顶点覆盖与最大团测试 ===" << std::endl;
+
+  // 与近似算法演示相同的6个顶点的图
+  BitMatrixGraph graph(6);
+  for (auto [u, v] : std::vector<std::pair<int, int>>{
+           {0, 1}, {0, 2}, {1, 2}, {1, 3}, {2, 4}, {3, 4}, {3, 5}, {4, 5}}) {
+    graph.add_edge(u, v);
+  }
+  auto approx = ApproximationAlgorithms::vertex_cover_2_approx(graph);
+  auto cover = ExactSolvers::minimum_vertex_cover(graph);
+  std::cout << "2-近似覆盖大小: " << approx.size() << std::endl;
+  std::cout << "最小顶点覆盖: ";
+  for (int v : cover) {
+    std::cout << v << " ";
+  }
+  std::cout << "（大小 " << cover.size() << "）" << std::endl;
+
+  auto clique = ExactSolvers::maximum_clique(graph);
+  std::cout << "最大团: ";
+  for (int v : clique) {
+    std::cout << v << " ";
+  }
+  std::cout << std::endl;
+
+  // 随机小图与穷举比较，串行与并行各一次
+  WorkStealingScheduler scheduler(4);
+  std::mt19937 rng(35);
+  size_t checked = 0;
+  for (int trial = 0; trial < 300; trial++) {
+    size_t n = 1 + trial % 16;
+    double density = 0.1 + 0.8 * (trial % 7) / 6.0;
+    BitMatrixGraph g = random_graph(n, density, rng);
+    auto [cover_size, clique_size] = brute_force_cover_and_clique(g);
+    for (WorkStealingScheduler *s : {static_cast<WorkStealingScheduler *>(nullptr),
+                                     &scheduler}) {
+      auto c = ExactSolvers::minimum_vertex_cover(g, s);
+      auto k = ExactSolvers::maximum_clique(g, s);
+      if (c.size() != cover_size || !is_vertex_cover(g, c) ||
+          k.size() != clique_size || !g.is_clique(k)) {
+        throw std::runtime_error("exact solver mismatch");
+      }
+    }
+    checked++;
+  }
+  std::cout << checked << " 个随机图与穷举结果一致" << std::endl;
+
+  try {
+    ExactSolvers::minimum_vertex_cover(BitMatrixGraph(3, true));
+  } catch (const std::invalid_argument &e) {
+    std::cout << "有向图: " << e.what() << std::endl;
+  }
+}
+
+/**
+ * @brief 测试较大的图：与2-近似比较，并计时串行与并行
+ */
+void test_larger_instances() {
+  std::cout << "\n=== 较大实例 ===" << std::endl;
+  WorkStealingScheduler scheduler(4);
+  std::mt19937 rng(2024);
+
+  BitMatrixGraph sparse = random_graph(60, 0.08, rng);
+  auto approx = ApproximationAlgorithms::vertex_cover_2_approx(sparse);
+  auto start = std::chrono::steady_clock::now();
+  auto cover = ExactSolvers::minimum_vertex_cover(sparse, &scheduler);
+  auto elapsed = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start);
+  std::cout << "60个顶点、" << sparse.get_edge_count() << " 条边: 2-近似 "
+            << approx.size() << "，最优 " << cover.size() << "（"
+            << (is_vertex_cover(sparse, cover) ? "有效" : "无效") << "，"
+            << elapsed.count() << " ms）" << std::endl;
+
+  BitMatrixGraph dense = random_graph(200, 0.5, rng);
+  start = std::chrono::steady_clock::now();
+  auto clique = ExactSolvers::maximum_clique(dense, &scheduler);
+  elapsed = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start);
+  std::cout << "200个顶点、密度0.5: 最大团大小 " << clique.size() << "（"
+            << (dense.is_clique(clique) ? "有效" : "无效") << "，"
+            << elapsed.count() << " ms）" << std::endl;
+}
+
+/**
+ * @brief 测试Held–Karp
+ */
+void test_held_karp() {
+  std::cout << "\n=== 旅行商问题Held-Karp测试 ===" << std::endl;
+  std::vector<std::vector<int>> distance = {{0, 10, 15, 20},
+                                            {10, 0, 35, 25},
+                                            {15, 35, 0, 30},
+                                            {20, 25, 30, 0}};
+  auto approx = ApproximationAlgorithms::tsp_2_approx(distance);
+  auto exact = ExactSolvers::tsp_held_karp(distance);
+  std::cout << "2-近似路线长度: " << ExactSolvers::tour_cost(distance, approx)
+            << std::endl;
+  std::cout << "最优路线: ";
+  for (int v : exact.tour) {
+    std::cout << v << " ";
+  }
+  std::cout << "（长度 " << exact.cost << "）" << std::endl;
+
+  WorkStealingScheduler scheduler(4);
+  std::mt19937 rng(7);
+  for (size_t n = 1; n <= 9; n++) {
+    for (int trial = 0; trial < 20; trial++) {
+      auto d = random_distances(n, rng);
+      if (trial % 2) {
+        // 不对称的距离
+        for (size_t i = 0; i < n; i++) {
+          for (size_t j = 0; j < n; j++) {
+            d[i][j] += i == j ? 0 : static_cast<int>(rng() % 50);
+          }
+        }
+      }
+      long long expected = brute_force_tsp(d);
+      for (WorkStealingScheduler *s : {static_cast<WorkStealingScheduler *>(nullptr),
+                                       &scheduler}) {
+        auto result = ExactSolvers::tsp_held_karp(d, s);
+        if (result.cost != expected || result.tour.size() != n + 1 ||
+            ExactSolvers::tour_cost(d, result.tour) != expected) {
+          throw std::runtime_error("Held-Karp mismatch");
+        }
+      }
+    }
+  }
+  std::cout << "1-9个城市的随机实例与枚举排列结果一致" << std::endl;
+
+  auto d = random_distances(18, rng);
+  auto start = std::chrono::steady_clock::now();
+  auto result = ExactSolvers::tsp_held_karp(d, &scheduler);
+  auto elapsed = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start);
+  std::cout << "18个城市: 2-近似 "
+            << ExactSolvers::tour_cost(d, ApproximationAlgorithms::tsp_2_approx(d))
+            << "，最优 " << result.cost << "（" << elapsed.count() << " ms）"
+            << std::endl;
+}
+
+/**
+ * @brief 测试子集和
+ */
+void test_subset_sum() {
+  std::cout << "\n=== 子集和测试 ===" << std::endl;
+  std::vector<int> set = {3, 34, 4, 12, 5, 2};
+  for (int target : {9, 30, 100}) {
+    std::vector<int> subset;
+    bool found = ExactSolvers::subset_sum(set, target, &subset);
+    std::cout << "目标 " << target << ": " << (found ? "存在" : "不存在");
+    if (found) {
+      std::cout << "，下标";
+      for (int i : subset) {
+        std::cout << " " << i << "(" << set[i] << ")";
+      }
+    }
+    std::cout << std::endl;
+  }
+
+  WorkStealingScheduler scheduler(4);
+  std::mt19937 rng(99);
+  for (int trial = 0; trial < 200; trial++) {
+    size_t n = 1 + trial % 14;
+    std::vector<int> values(n);
+    for (int &x : values) {
+      x = static_cast<int>(rng() % 300);
+    }
+    int target = static_cast<int>(rng() % 1500);
+    bool expected = false;
+    for (std::uint32_t mask = 0; mask < (1u << n) && !expected; mask++) {
+      long long sum = 0;
+      for (size_t i = 0; i < n; i++) {
+        sum += (mask >> i & 1) ? values[i] : 0;
+      }
+      expected = sum == target;
+    }
+    std::vector<int> subset;
+    bool found = ExactSolvers::subset_sum(values, target, &subset,
+                                          trial % 2 ? &scheduler : nullptr);
+    long long sum = 0;
+    for (int i : subset) {
+      sum += values[i];
+    }
+    if (found != expected || (found && sum != target)) {
+      throw std::runtime_error("subset sum mismatch");
+    }
+  }
+  std::cout << "200个随机实例与穷举结果一致" << std::endl;
+
+  // 目标和很大时按字并行
+  std::vector<int> large(200);
+  for (int &x : large) {
+    x = 10000 + static_cast<int>(rng() % 10000);
+  }
+  std::vector<int> subset;
+  bool found = ExactSolvers::subset_sum(large, 1234567, &subset, &scheduler);
+  std::cout << "200个元素、目标1234567: " << (found ? "存在" : "不存在")
+            << "，用了 " << subset.size() << " 个元素" << std::endl;
+}
+
+int main() {
+  std::cout << "NP完全问题精确求解演示程序" << std::endl;
+  std::cout << "==========================" << std::endl;
+
+  test_vertex_cover_and_clique();
+  test_larger_instances();
+  test_held_karp();
+  test_subset_sum();
+
+  std::cout << "\n所有测试完成！" << std::endl;
+  return 0;
+}